@@ -2,17 +2,20 @@
 //!
 //! Endpoints:
 //! - POST /tower.GenerationService/GenerateFloor
+//! - POST /tower.GenerationService/GenerateFloorChunk (binary tower.game.ChunkData)
 //! - POST /tower.GenerationService/GenerateLoot
 //! - POST /tower.GenerationService/SpawnMonsters
 //! - POST /tower.GenerationService/QuerySemanticTags
 
-use axum::{extract::State, routing::post, Json, Router};
+use axum::{extract::State, http::header, response::IntoResponse, routing::post, Json, Router};
+use prost::Message;
 use serde::{Deserialize, Serialize};
+use sha3::{Digest, Sha3_256};
 
 use super::ApiState;
 use crate::destruction::FloorDestructionManager;
 use crate::proto::tower::entities::{LootTable, MonsterTemplate};
-use crate::proto::tower::game::TagPair as ProtoTagPair;
+use crate::proto::tower::game::{ChunkData, FloorTileData, TagPair as ProtoTagPair};
 
 pub fn routes() -> Router<ApiState> {
     Router::new()
@@ -20,6 +23,10 @@ pub fn routes() -> Router<ApiState> {
             "/tower.GenerationService/GenerateFloor",
             post(generate_floor),
         )
+        .route(
+            "/tower.GenerationService/GenerateFloorChunk",
+            post(generate_floor_chunk),
+        )
         .route("/tower.GenerationService/GenerateLoot", post(generate_loot))
         .route(
             "/tower.GenerationService/SpawnMonsters",
@@ -47,6 +54,10 @@ pub fn routes() -> Router<ApiState> {
 pub struct FloorRequest {
     pub tower_seed: u64,
     pub floor_id: u32,
+    /// Hex SHA3-256 of the client's locally generated chunk; when it matches,
+    /// the tiles are left out of the response
+    #[serde(default)]
+    pub validation_hash: Option<String>,
 }
 
 #[derive(Serialize)]
@@ -58,6 +69,10 @@ pub struct FloorResponse {
     pub height: u32,
     pub tiles: Vec<TileData>,
     pub semantic_tags: Vec<TagPair>,
+    /// Hex SHA3-256 over seed and tiles, as in AsyncGenerator::compute_validation_hash
+    pub validation_hash: String,
+    /// The client's hash matched; `tiles` is empty and the client uses its own
+    pub hash_matched: bool,
 }
 
 #[derive(Serialize)]
@@ -151,6 +166,73 @@ async fn generate_floor(
     Json(req): Json<FloorRequest>,
 ) -> Json<FloorResponse> {
     let seed = req.tower_seed.wrapping_add(req.floor_id as u64);
+    let (size, mut tiles) = generate_floor_tiles(seed, req.floor_id);
+
+    let biome_id = determine_biome(req.floor_id);
+    let tags = generate_floor_tags(req.floor_id, biome_id, seed);
+
+    let validation_hash = to_hex(&floor_validation_hash(seed, &tiles));
+    let hash_matched = req
+        .validation_hash
+        .as_deref()
+        .is_some_and(|client| client.eq_ignore_ascii_case(&validation_hash));
+    if hash_matched {
+        tiles.clear();
+    }
+
+    Json(FloorResponse {
+        floor_id: req.floor_id,
+        seed,
+        biome_id,
+        width: size,
+        height: size,
+        tiles,
+        semantic_tags: tags,
+        validation_hash,
+        hash_matched,
+    })
+}
+
+/// Same floor as GenerateFloor, as a serialized ChunkData with tiles in row-major
+/// order, so the client's FChunkStreamDecoder can build it while it downloads
+async fn generate_floor_chunk(
+    State(_state): State<ApiState>,
+    Json(req): Json<FloorRequest>,
+) -> impl IntoResponse {
+    let seed = req.tower_seed.wrapping_add(req.floor_id as u64);
+    let (size, tiles) = generate_floor_tiles(seed, req.floor_id);
+
+    let chunk = ChunkData {
+        seed,
+        floor_id: req.floor_id,
+        validation_hash: floor_validation_hash(seed, &tiles).to_vec(),
+        tiles: tiles
+            .iter()
+            .map(|tile| FloorTileData {
+                tile_type: tile.tile_type,
+                grid_x: tile.grid_x,
+                grid_y: tile.grid_y,
+                biome_id: tile.biome_id,
+                is_walkable: tile.is_walkable,
+                has_collision: !tile.is_walkable,
+            })
+            .collect(),
+        biome_id: determine_biome(req.floor_id),
+        width: size,
+        height: size,
+        world_offset: None,
+        semantic_tags: None,
+        packed_tiles: vec![],
+    };
+
+    (
+        [(header::CONTENT_TYPE, "application/x-protobuf")],
+        chunk.encode_to_vec(),
+    )
+}
+
+/// Tiles of a floor from its seed, row-major; returns the side length with them
+fn generate_floor_tiles(seed: u64, floor_id: u32) -> (u32, Vec<TileData>) {
     let size = 50u32;
 
     // Generate tiles procedurally from seed
@@ -166,24 +248,30 @@ async fn generate_floor(
                 tile_type,
                 grid_x: x,
                 grid_y: y,
-                biome_id: determine_biome(req.floor_id),
+                biome_id: determine_biome(floor_id),
                 is_walkable: tile_type != 4, // type 4 = wall
             });
         }
     }
+    (size, tiles)
+}
 
-    let biome_id = determine_biome(req.floor_id);
-    let tags = generate_floor_tags(req.floor_id, biome_id, seed);
+/// Same digest as AsyncGenerator::compute_validation_hash and the client's
+/// UProtobufBridge::ComputeChunkHash
+fn floor_validation_hash(seed: u64, tiles: &[TileData]) -> [u8; 32] {
+    let mut hasher = Sha3_256::new();
+    hasher.update(seed.to_le_bytes());
+    for tile in tiles {
+        hasher.update(tile.tile_type.to_le_bytes());
+        hasher.update(tile.grid_x.to_le_bytes());
+        hasher.update(tile.grid_y.to_le_bytes());
+        hasher.update(tile.biome_id.to_le_bytes());
+    }
+    hasher.finalize().into()
+}
 
-    Json(FloorResponse {
-        floor_id: req.floor_id,
-        seed,
-        biome_id,
-        width: size,
-        height: size,
-        tiles,
-        semantic_tags: tags,
-    })
+fn to_hex(bytes: &[u8]) -> String {
+    bytes.iter().map(|b| format!("{:02x}", b)).collect()
 }
 
 async fn generate_loot(
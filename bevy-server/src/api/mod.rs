@@ -17,6 +17,9 @@
 //! ## Endpoint Convention
 //! All endpoints follow gRPC path pattern: `POST /tower.<Service>/<Method>`
 //! Example: `POST /tower.GenerationService/GenerateFloor`
+//!
+//! `GET /tower.Stream` upgrades to a WebSocket that multiplexes the same calls
+//! (see [`stream`]).
 
 pub mod combat;
 pub mod destruction;
@@ -24,6 +27,7 @@ pub mod economy;
 pub mod game_state;
 pub mod generation;
 pub mod mastery;
+pub mod stream;
 
 use axum::{middleware, routing::get, Json, Router};
 use serde::Serialize;
@@ -63,6 +67,12 @@ async fn health_check() -> Json<HealthResponse> {
 
 /// Build the full API router with all service endpoints
 pub fn build_router(state: ApiState) -> Router {
+    let services = build_service_router(state);
+    services.clone().merge(stream::routes(services))
+}
+
+/// HTTP endpoints only; `/tower.Stream` dispatches its calls through this
+fn build_service_router(state: ApiState) -> Router {
     Router::new()
         .route("/health", get(health_check))
         .route("/metrics", get(crate::metrics::prometheus_handler))
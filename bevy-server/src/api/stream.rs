@@ -0,0 +1,132 @@
+//! Multiplexed stream transport
+//!
+//! `GET /tower.Stream` upgrades to a WebSocket that carries the same service
+//! calls as the HTTP endpoints, many in flight at once. The UE5 client uses it
+//! in `Stream` transport mode to skip connection setup on every call.
+//!
+//! Frames are binary and little-endian, one call per frame:
+//! ```text
+//! request:  u64 request_id | u8 body_encoding | u16 path_len | path | body
+//! response: u64 request_id | u16 status | body
+//! ```
+//! Only body_encoding 0 (JSON) is accepted for now; the handlers all take
+//! `Json<_>`. Each call runs through the service router on its own task, so
+//! responses come back in completion order, not request order.
+
+use axum::{
+    body::{to_bytes, Body},
+    extract::ws::{Message, WebSocket, WebSocketUpgrade},
+    http::{header, Method, Request, StatusCode},
+    routing::get,
+    Router,
+};
+use tokio::sync::mpsc;
+use tower::ServiceExt;
+use tracing::{debug, warn};
+
+const BODY_ENCODING_JSON: u8 = 0;
+const REQUEST_HEADER_LEN: usize = 11;
+/// Largest response body forwarded over the stream (whole floors fit easily)
+const MAX_RESPONSE_BYTES: usize = 16 * 1024 * 1024;
+
+/// Stream endpoint; `services` is the finished service router calls are dispatched to
+pub fn routes(services: Router) -> Router {
+    Router::new().route(
+        "/tower.Stream",
+        get(move |ws: WebSocketUpgrade| {
+            let services = services.clone();
+            async move { ws.on_upgrade(move |socket| serve(socket, services)) }
+        }),
+    )
+}
+
+async fn serve(mut socket: WebSocket, services: Router) {
+    let (replies, mut pending) = mpsc::unbounded_channel::<Vec<u8>>();
+
+    loop {
+        tokio::select! {
+            incoming = socket.recv() => match incoming {
+                Some(Ok(Message::Binary(frame))) => {
+                    let services = services.clone();
+                    let replies = replies.clone();
+                    tokio::spawn(async move {
+                        if let Some(reply) = handle_frame(&frame, services).await {
+                            let _ = replies.send(reply);
+                        }
+                    });
+                }
+                Some(Ok(Message::Close(_))) | None => break,
+                Some(Ok(_)) => {}
+                Some(Err(e)) => {
+                    debug!("Stream socket error: {}", e);
+                    break;
+                }
+            },
+            Some(reply) = pending.recv() => {
+                if socket.send(Message::Binary(reply.into())).await.is_err() {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+async fn handle_frame(frame: &[u8], services: Router) -> Option<Vec<u8>> {
+    if frame.len() < REQUEST_HEADER_LEN {
+        warn!("Stream frame too short ({} bytes)", frame.len());
+        return None;
+    }
+
+    let request_id = u64::from_le_bytes(frame[0..8].try_into().ok()?);
+    let encoding = frame[8];
+    let path_len = u16::from_le_bytes([frame[9], frame[10]]) as usize;
+    let body_start = REQUEST_HEADER_LEN + path_len;
+
+    let Some(path) = frame
+        .get(REQUEST_HEADER_LEN..body_start)
+        .and_then(|p| std::str::from_utf8(p).ok())
+    else {
+        return Some(encode_response(request_id, StatusCode::BAD_REQUEST, br#"{"error":"bad_path"}"#));
+    };
+
+    if encoding != BODY_ENCODING_JSON {
+        return Some(encode_response(
+            request_id,
+            StatusCode::UNSUPPORTED_MEDIA_TYPE,
+            br#"{"error":"unsupported_body_encoding"}"#,
+        ));
+    }
+
+    let Ok(request) = Request::builder()
+        .method(Method::POST)
+        .uri(path)
+        .header(header::CONTENT_TYPE, "application/json")
+        .header("x-tower-request-id", request_id.to_string())
+        .body(Body::from(frame[body_start..].to_vec()))
+    else {
+        return Some(encode_response(request_id, StatusCode::BAD_REQUEST, br#"{"error":"bad_path"}"#));
+    };
+
+    let response = match services.oneshot(request).await {
+        Ok(response) => response,
+        Err(never) => match never {},
+    };
+    let status = response.status();
+
+    match to_bytes(response.into_body(), MAX_RESPONSE_BYTES).await {
+        Ok(body) => Some(encode_response(request_id, status, &body)),
+        Err(_) => Some(encode_response(
+            request_id,
+            StatusCode::INTERNAL_SERVER_ERROR,
+            br#"{"error":"response_too_large"}"#,
+        )),
+    }
+}
+
+fn encode_response(request_id: u64, status: StatusCode, body: &[u8]) -> Vec<u8> {
+    let mut frame = Vec::with_capacity(10 + body.len());
+    frame.extend_from_slice(&request_id.to_le_bytes());
+    frame.extend_from_slice(&status.as_u16().to_le_bytes());
+    frame.extend_from_slice(body);
+    frame
+}
@@ -27,6 +27,7 @@ use crate::proto::tower::game::{
     ChunkData, FloorTileData, SemanticTags as ProtoSemanticTags, TagPair, Vec3,
 };
 use crate::semantic_tags::SemanticTags;
+use crate::tile_grid::PackedTileGrid;
 use crate::wfc;
 use lru::LruCache;
 use parking_lot::Mutex;
@@ -229,13 +230,20 @@ impl FloorGenerator {
         // Compute validation hash
         let hash = Self::compute_validation_hash(&tiles, seed);
 
+        // Ship and cache the grid packed; the hash still covers every tile
+        let packed_tiles = Self::pack_tiles(&tiles, layout.width, layout.height);
+
         // Generate semantic tags for this floor
         let semantic_tags = Self::generate_floor_tags(floor_id, biome_id, seed);
 
         ChunkData {
             seed,
             floor_id,
-            tiles,
+            tiles: if packed_tiles.is_empty() {
+                tiles
+            } else {
+                Vec::new()
+            },
             validation_hash: hash,
             biome_id,
             width: layout.width as u32,
@@ -246,9 +254,32 @@ impl FloorGenerator {
                 z: 0.0,
             }),
             semantic_tags: Some(Self::to_proto_tags(&semantic_tags)),
+            packed_tiles,
         }
     }
 
+    /// `ChunkData.packed_tiles` for row-major `tiles`; empty if a tile type
+    /// does not fit the packed format, in which case the tiles go out as-is
+    fn pack_tiles(tiles: &[FloorTileData], width: usize, height: usize) -> Vec<u8> {
+        let types: Vec<u8> = tiles
+            .iter()
+            .map(|t| u8::try_from(t.tile_type).unwrap_or(u8::MAX))
+            .collect();
+        let (Ok(w), Ok(h)) = (u16::try_from(width), u16::try_from(height)) else {
+            return Vec::new();
+        };
+        let Some(mut grid) = PackedTileGrid::pack(&types, w, h) else {
+            return Vec::new();
+        };
+
+        let biomes: Vec<u16> = tiles
+            .iter()
+            .map(|t| u16::try_from(t.biome_id).unwrap_or(u16::MAX))
+            .collect();
+        grid.set_biomes(&biomes);
+        grid.to_bytes()
+    }
+
     /// Convert WFC FloorLayout into proto FloorTileData vec
     fn wfc_to_proto_tiles(layout: &wfc::FloorLayout, biome_id: u32) -> Vec<FloorTileData> {
         let mut tiles = Vec::with_capacity(layout.width * layout.height);
@@ -622,7 +653,9 @@ mod tests {
         // WFC generates 16x16 for Echelon1 (floors 1-100)
         assert_eq!(chunk.width, 16);
         assert_eq!(chunk.height, 16);
-        assert_eq!(chunk.tiles.len(), 256); // 16x16
+        let grid = PackedTileGrid::from_bytes(&chunk.packed_tiles).unwrap();
+        assert_eq!(grid.unpack().unwrap().len(), 256); // 16x16
+        assert!(chunk.tiles.is_empty());
         assert!(!chunk.validation_hash.is_empty());
     }
 
@@ -664,7 +697,7 @@ mod tests {
         let chunk2 = generator.get_or_generate(5, 0xABCDEF).await.unwrap();
 
         assert_eq!(chunk1.validation_hash, chunk2.validation_hash);
-        assert_eq!(chunk1.tiles.len(), chunk2.tiles.len());
+        assert_eq!(chunk1.packed_tiles, chunk2.packed_tiles);
     }
 
     #[tokio::test]
@@ -927,6 +927,105 @@ pub fn mastery_xp_for_action(action: ActionType, outcome: DamageOutcome) -> (Str
     }
 }
 
+// ============================================================================
+// Lag Compensation
+// ============================================================================
+
+/// How far back hits may be validated (seconds); matches the client's MaxRewindSeconds
+pub const MAX_REWIND_SECS: f64 = 0.5;
+/// Extra reach allowed when validating a rewound hit (world units)
+pub const HIT_TOLERANCE: f32 = 0.5;
+/// Samples kept per entity: 500ms at the 20 Hz tick, with headroom for hitches
+pub const POSITION_HISTORY_LEN: usize = 16;
+
+/// Recent positions of an entity, one sample per server tick, so a hit can be
+/// checked against where the attacker saw the target rather than where it is now
+#[derive(Component, Debug, Clone)]
+pub struct PositionHistory {
+    samples: [(f64, Vec3); POSITION_HISTORY_LEN],
+    /// Next slot to write
+    head: usize,
+    len: usize,
+}
+
+impl Default for PositionHistory {
+    fn default() -> Self {
+        Self {
+            samples: [(0.0, Vec3::ZERO); POSITION_HISTORY_LEN],
+            head: 0,
+            len: 0,
+        }
+    }
+}
+
+impl PositionHistory {
+    /// Append a sample; times must not go backwards
+    pub fn record(&mut self, time: f64, position: Vec3) {
+        self.samples[self.head] = (time, position);
+        self.head = (self.head + 1) % POSITION_HISTORY_LEN;
+        self.len = (self.len + 1).min(POSITION_HISTORY_LEN);
+    }
+
+    /// i-th sample, oldest first
+    fn sample(&self, i: usize) -> (f64, Vec3) {
+        let oldest = (self.head + POSITION_HISTORY_LEN - self.len) % POSITION_HISTORY_LEN;
+        self.samples[(oldest + i) % POSITION_HISTORY_LEN]
+    }
+
+    /// Position at `time`, interpolated between the bracketing samples.
+    /// Times after the newest sample clamp to it; `None` if there are no samples,
+    /// or `time` is older than the history or more than MAX_REWIND_SECS back.
+    pub fn rewind(&self, time: f64) -> Option<Vec3> {
+        if self.len == 0 {
+            return None;
+        }
+        let (newest_time, newest_pos) = self.sample(self.len - 1);
+        if time >= newest_time {
+            return Some(newest_pos);
+        }
+        if newest_time - time > MAX_REWIND_SECS {
+            return None;
+        }
+        for i in (0..self.len - 1).rev() {
+            let (from_time, from_pos) = self.sample(i);
+            if from_time <= time {
+                let (to_time, to_pos) = self.sample(i + 1);
+                let span = to_time - from_time;
+                let alpha = if span > 0.0 {
+                    ((time - from_time) / span) as f32
+                } else {
+                    1.0
+                };
+                return Some(from_pos.lerp(to_pos, alpha));
+            }
+        }
+        None
+    }
+}
+
+/// Would a hit of `range` from `attacker_pos` have reached the target as the
+/// attacker saw it at `render_time`? Unknown times (too old, no history) fail.
+pub fn validate_hit(
+    attacker_pos: Vec3,
+    range: f32,
+    target_history: &PositionHistory,
+    render_time: f64,
+) -> bool {
+    target_history
+        .rewind(render_time)
+        .is_some_and(|target_pos| attacker_pos.distance(target_pos) <= range + HIT_TOLERANCE)
+}
+
+/// Sample every tracked entity's position for this tick
+pub fn record_position_history(
+    uptime: Res<crate::ecs_bridge::ServerUptime>,
+    mut tracked: Query<(&Transform, &mut PositionHistory)>,
+) {
+    for (transform, mut history) in &mut tracked {
+        history.record(uptime.total_time, transform.translation);
+    }
+}
+
 // ============================================================================
 // Tests
 // ============================================================================
@@ -1293,4 +1392,43 @@ mod tests {
         assert!(result.success);
         assert_eq!(state.phase, CombatPhase::Parrying);
     }
+
+    #[test]
+    fn test_position_history_rewind_interpolates() {
+        let mut history = PositionHistory::default();
+        history.record(1.0, Vec3::ZERO);
+        history.record(1.1, Vec3::new(10.0, 0.0, 0.0));
+
+        let rewound = history.rewind(1.05).unwrap();
+        assert!((rewound.x - 5.0).abs() < 1e-4);
+        // Past the newest sample clamps to it
+        assert_eq!(history.rewind(2.0), Some(Vec3::new(10.0, 0.0, 0.0)));
+        // Older than the history
+        assert_eq!(history.rewind(0.9), None);
+    }
+
+    #[test]
+    fn test_position_history_wraps_and_limits_rewind() {
+        let mut history = PositionHistory::default();
+        for tick in 0..(POSITION_HISTORY_LEN * 2) {
+            history.record(tick as f64 * 0.05, Vec3::new(tick as f32, 0.0, 0.0));
+        }
+        let newest = (POSITION_HISTORY_LEN * 2 - 1) as f64 * 0.05;
+
+        let rewound = history.rewind(newest - 0.25).unwrap();
+        assert!((rewound.x - (POSITION_HISTORY_LEN * 2 - 6) as f32).abs() < 1e-3);
+        assert_eq!(history.rewind(newest - MAX_REWIND_SECS - 0.05), None);
+    }
+
+    #[test]
+    fn test_validate_hit_uses_rewound_pose() {
+        let mut history = PositionHistory::default();
+        history.record(1.0, Vec3::new(2.0, 0.0, 0.0));
+        history.record(1.05, Vec3::new(6.0, 0.0, 0.0));
+
+        // In reach where the attacker saw it, out of reach where it is now
+        assert!(validate_hit(Vec3::ZERO, 2.0, &history, 1.0));
+        assert!(!validate_hit(Vec3::ZERO, 2.0, &history, 1.05));
+        assert!(!validate_hit(Vec3::ZERO, 2.0, &PositionHistory::default(), 1.0));
+    }
 }
@@ -3,6 +3,7 @@
 //! Provides C-compatible functions for Protobuf deserialization.
 //! UE5 calls these functions via DLL, avoiding the need for libprotobuf.lib in UE5.
 use crate::proto::tower::game::ChunkData;
+use crate::tile_grid::PackedTileGrid;
 use prost::Message;
 use std::ffi::{CStr, CString};
 use std::os::raw::c_char;
@@ -92,7 +93,11 @@ pub unsafe extern "C" fn get_chunk_field(
         "biome_id" => format!("{}", chunk_data.biome_id),
         "width" => format!("{}", chunk_data.width),
         "height" => format!("{}", chunk_data.height),
-        "tiles_count" => format!("{}", chunk_data.tiles.len()),
+        "tiles_count" => {
+            let packed =
+                PackedTileGrid::from_bytes(&chunk_data.packed_tiles).map_or(0, |g| g.len());
+            format!("{}", chunk_data.tiles.len().max(packed))
+        }
         _ => return ptr::null_mut(),
     };
 
@@ -130,6 +135,7 @@ mod tests {
                 z: 0.0,
             }),
             semantic_tags: None,
+            packed_tiles: vec![],
         };
 
         // Serialize to Protobuf
@@ -161,6 +167,7 @@ mod tests {
             height: 100,
             world_offset: None,
             semantic_tags: None,
+            packed_tiles: vec![],
         };
 
         let mut protobuf_bytes = Vec::new();
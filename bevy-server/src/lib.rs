@@ -23,10 +23,13 @@ pub mod loot; // Semantic loot generation with rarity and equipment effects
 pub mod metrics; // Server metrics (Prometheus + JSON export)
 pub mod monster_gen; // Grammar-based monster generation with FSM AI
 pub mod physics; // Physics integration (bevy_rapier3d collision, knockback)
+pub mod ping; // UDP ping echo for client server selection
 pub mod proto;
+pub mod quantize; // Fixed-point positions / rotations / health for snapshots
 #[allow(dead_code)]
 pub mod semantic_tags; // Semantic tag system
 pub mod storage; // Unified data storage (LMDB + PostgreSQL)
+pub mod tile_grid; // Run-length encoded tile grids (ChunkData.packed_tiles)
 pub mod wfc; // Wave Function Collapse floor generation
 
 // Re-export commonly used types
@@ -286,6 +286,7 @@ mod tests {
                 z: 0.0,
             }),
             semantic_tags: None,
+            packed_tiles: vec![],
         }
     }
 
@@ -17,7 +17,7 @@ use tower_bevy_server::{
     components::{FloorTile, Monster, Player},
     destruction,
     ecs_bridge::{self, ServerUptime, WorldSnapshotResource},
-    input, monster_gen, physics, storage,
+    input, monster_gen, physics, ping, storage,
 };
 
 // Binary-only modules (not shared with library)
@@ -32,6 +32,7 @@ mod lmdb_cache; // LMDB embedded database caching (Tier 2)
 mod proto; // Auto-generated Protobuf types
 #[allow(dead_code)]
 mod semantic_tags; // Semantic tag system
+mod tile_grid; // Packed tile grids (shared with library)
 mod wfc; // WFC floor generation (shared with library)
 
 #[cfg(test)]
@@ -187,6 +188,10 @@ fn main() {
         )
         // Combat systems
         .add_systems(Update, combat::update_combat_timers)
+        .add_systems(
+            Update,
+            combat::record_position_history.after(ecs_bridge::update_uptime),
+        )
         // Monster AI systems
         .add_systems(Update, monster_gen::update_monster_ai)
         // Destruction systems
@@ -263,6 +268,14 @@ fn setup_server(mut commands: Commands) {
     commands.insert_resource(transport);
 
     info!("✅ Server listening on 0.0.0.0:5000 (UDP/renet)");
+
+    // Latency probes for client server selection, next to the netcode port
+    let ping_load = ping::PingLoad::new(max_clients as u32);
+    let ping_addr = format!("0.0.0.0:{}", addr.port() + ping::PING_PORT_OFFSET);
+    if let Err(e) = ping::spawn_ping_echo(&ping_addr, ping_load.clone()) {
+        error!("Ping echo unavailable on {}: {}", ping_addr, e);
+    }
+    commands.insert_resource(ping::PingLoadResource(ping_load));
     info!("✅ HTTP API server running on port 50051 (LMDB + PostgreSQL)");
 }
 
@@ -270,7 +283,12 @@ fn handle_player_connections(
     mut commands: Commands,
     server: Res<RenetServer>,
     existing_players: Query<&Player>,
+    ping_load: Option<Res<ping::PingLoadResource>>,
 ) {
+    if let Some(ping_load) = ping_load {
+        ping_load.0.set_players(server.connected_clients() as u32);
+    }
+
     // Handle new player connections
     for client_id in server.clients_id() {
         if !server.is_connected(client_id) {
@@ -303,6 +321,7 @@ fn handle_player_connections(
                     range: 2.0,
                 },
                 combat::CombatEnergy::default(),
+                combat::PositionHistory::default(),
                 Replicated, // Mark for replication
             ))
             .id();
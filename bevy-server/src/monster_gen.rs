@@ -17,7 +17,7 @@ use bevy::prelude::*;
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 
-use crate::combat::{CombatEnergy, CombatState, EquippedWeapon, WeaponType};
+use crate::combat::{CombatEnergy, CombatState, EquippedWeapon, PositionHistory, WeaponType};
 use crate::components::{Monster, Player};
 use crate::physics;
 
@@ -759,6 +759,7 @@ pub fn spawn_monster_from_blueprint(
                 range: 2.5,
             },
             CombatEnergy::default(),
+            PositionHistory::default(),
             MonsterSemanticTags {
                 tags: blueprint.semantic_tags.clone(),
             },
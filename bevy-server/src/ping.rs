@@ -0,0 +1,171 @@
+//! Ping echo — cheap UDP latency probes for client server selection
+//!
+//! The netcode port is owned by `NetcodeServerTransport`, which drops anything
+//! that isn't a netcode packet, so probes go to the port next to it
+//! (`netcode port + PING_PORT_OFFSET`). A probe is answered with itself, its
+//! padding replaced by the server's current load, so the client reads RTT and
+//! load from one datagram and needs no clock sync:
+//!
+//! ```text
+//! probe  u32 magic 'TPNG', u32 sequence, u64 client timestamp, 4 bytes 0 (20 bytes)
+//! reply  the probe, its last 4 bytes u16 connected players, u16 max players (20 bytes)
+//! ```
+//!
+//! All little-endian. Probes must carry the padding: shorter ones, like
+//! anything else, are ignored, so a reply is never larger than what was sent
+//! and the port can't be used to amplify traffic.
+
+use bevy::prelude::Resource;
+use std::io;
+use std::net::UdpSocket;
+use std::sync::atomic::{AtomicU32, Ordering};
+use std::sync::Arc;
+use std::time::Duration;
+use tracing::{info, warn};
+
+/// "TPNG", little-endian
+pub const PING_MAGIC: u32 = 0x474E_5054;
+pub const PING_PORT_OFFSET: u16 = 1;
+/// Where the load goes: magic, sequence and timestamp come before it
+pub const LOAD_OFFSET: usize = 16;
+pub const PROBE_LEN: usize = LOAD_OFFSET + 4;
+pub const REPLY_LEN: usize = PROBE_LEN;
+
+const _: () = assert!(REPLY_LEN <= PROBE_LEN, "a reply must not be larger than its probe");
+
+/// Load the echo reports; written by the game loop, read by the echo thread
+#[derive(Debug, Default)]
+pub struct PingLoad {
+    players: AtomicU32,
+    max_players: AtomicU32,
+}
+
+impl PingLoad {
+    pub fn new(max_players: u32) -> Arc<Self> {
+        let load = Self::default();
+        load.max_players.store(max_players, Ordering::Relaxed);
+        Arc::new(load)
+    }
+
+    pub fn set_players(&self, players: u32) {
+        self.players.store(players, Ordering::Relaxed);
+    }
+
+    pub fn players(&self) -> u32 {
+        self.players.load(Ordering::Relaxed)
+    }
+
+    pub fn max_players(&self) -> u32 {
+        self.max_players.load(Ordering::Relaxed)
+    }
+}
+
+/// ECS handle on the load the echo thread reports
+#[derive(Resource, Clone)]
+pub struct PingLoadResource(pub Arc<PingLoad>);
+
+/// The reply to `probe`, or `None` when it isn't a probe
+pub fn build_reply(probe: &[u8], load: &PingLoad) -> Option<[u8; REPLY_LEN]> {
+    if probe.len() != PROBE_LEN || probe[0..4] != PING_MAGIC.to_le_bytes() {
+        return None;
+    }
+
+    let mut reply = [0u8; REPLY_LEN];
+    reply[..PROBE_LEN].copy_from_slice(probe);
+    let players = load.players().min(u16::MAX as u32) as u16;
+    let max_players = load.max_players().min(u16::MAX as u32) as u16;
+    reply[LOAD_OFFSET..LOAD_OFFSET + 2].copy_from_slice(&players.to_le_bytes());
+    reply[LOAD_OFFSET + 2..].copy_from_slice(&max_players.to_le_bytes());
+    Some(reply)
+}
+
+/// Bind `bind_addr` and answer probes on a background thread for the life of the process
+pub fn spawn_ping_echo(bind_addr: &str, load: Arc<PingLoad>) -> io::Result<()> {
+    let socket = UdpSocket::bind(bind_addr)?;
+    info!("✅ Ping echo listening on {}", socket.local_addr()?);
+
+    std::thread::Builder::new()
+        .name("ping-echo".into())
+        .spawn(move || run_ping_echo(socket, load))?;
+    Ok(())
+}
+
+fn run_ping_echo(socket: UdpSocket, load: Arc<PingLoad>) {
+    // One byte over a probe, so oversized datagrams are seen as such instead of truncated to a match
+    let mut buf = [0u8; PROBE_LEN + 1];
+    loop {
+        match socket.recv_from(&mut buf) {
+            Ok((len, from)) => {
+                if let Some(reply) = build_reply(&buf[..len], &load) {
+                    let _ = socket.send_to(&reply, from);
+                }
+            }
+            Err(e) => {
+                // ICMP port unreachable from a client that went away surfaces here on some platforms
+                warn!("Ping echo receive failed: {}", e);
+                std::thread::sleep(Duration::from_millis(10));
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn probe(sequence: u32, timestamp: u64) -> [u8; PROBE_LEN] {
+        let mut probe = [0u8; PROBE_LEN];
+        probe[0..4].copy_from_slice(&PING_MAGIC.to_le_bytes());
+        probe[4..8].copy_from_slice(&sequence.to_le_bytes());
+        probe[8..16].copy_from_slice(&timestamp.to_le_bytes());
+        probe
+    }
+
+    #[test]
+    fn test_reply_echoes_probe_and_appends_load() {
+        let load = PingLoad::new(100);
+        load.set_players(7);
+
+        let reply = build_reply(&probe(3, 123_456), &load).unwrap();
+        assert_eq!(reply.len(), PROBE_LEN);
+        assert_eq!(&reply[..LOAD_OFFSET], &probe(3, 123_456)[..LOAD_OFFSET]);
+        assert_eq!(u16::from_le_bytes([reply[16], reply[17]]), 7);
+        assert_eq!(u16::from_le_bytes([reply[18], reply[19]]), 100);
+    }
+
+    #[test]
+    fn test_non_probes_are_ignored() {
+        let load = PingLoad::new(100);
+        let mut bad_magic = probe(1, 1);
+        bad_magic[0] ^= 0xFF;
+
+        assert!(build_reply(&bad_magic, &load).is_none());
+        assert!(build_reply(&probe(1, 1)[..PROBE_LEN - 1], &load).is_none());
+        assert!(build_reply(&[0u8; PROBE_LEN + 1], &load).is_none());
+        // Unpadded probes would get a reply larger than themselves
+        assert!(build_reply(&probe(1, 1)[..LOAD_OFFSET], &load).is_none());
+    }
+
+    #[test]
+    fn test_echo_round_trip_over_loopback() {
+        let load = PingLoad::new(50);
+        load.set_players(2);
+
+        let server = UdpSocket::bind("127.0.0.1:0").unwrap();
+        let server_addr = server.local_addr().unwrap();
+        let server_load = load.clone();
+        std::thread::spawn(move || run_ping_echo(server, server_load));
+
+        let client = UdpSocket::bind("127.0.0.1:0").unwrap();
+        client
+            .set_read_timeout(Some(Duration::from_secs(2)))
+            .unwrap();
+        client.send_to(&probe(9, 42), server_addr).unwrap();
+
+        let mut reply = [0u8; 64];
+        let (len, _) = client.recv_from(&mut reply).unwrap();
+        assert_eq!(len, REPLY_LEN);
+        assert_eq!(&reply[..LOAD_OFFSET], &probe(9, 42)[..LOAD_OFFSET]);
+        assert_eq!(u16::from_le_bytes([reply[16], reply[17]]), 2);
+    }
+}
@@ -79,8 +79,12 @@ mod tests {
                 rotation: None,
                 health: Some(85.5),
                 state: None,
+                position_q: None,
+                yaw_q: None,
+                health_q: None,
             }],
             monsters: vec![],
+            bounds: None,
         };
 
         // Serialize
@@ -131,6 +135,7 @@ mod tests {
                 z: 0.0,
             }),
             semantic_tags: None,
+            packed_tiles: vec![],
         };
 
         // Serialize
@@ -165,6 +170,7 @@ mod tests {
             height: 50,
             world_offset: Some(Vec3::default()),
             semantic_tags: None,
+            packed_tiles: vec![],
         };
 
         let mut buf = Vec::new();
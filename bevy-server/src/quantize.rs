@@ -0,0 +1,367 @@
+//! Network quantization — fixed-point entity state for snapshots
+//!
+//! Positions are u16 steps per axis inside the current floor's bounds,
+//! yaw is a u16 fraction of a full turn, rotations are smallest-three
+//! quaternions in 32 bits and health is a u8 fraction of max health.
+//!
+//! Used by both wire formats:
+//! 1. **Bincode packets** — `PlayerUpdateQuantized` (0x06), `MonsterUpdateQuantized` (0x07)
+//!    and `FloorBounds` (0x08), decoded by the client's `AReplicationManager`
+//! 2. **Protobuf** — the `*_q` fields of `EntitySnapshot` plus `WorldSnapshot.bounds`
+//!
+//! Mirrors `ue5-client/Source/TowerGame/Network/NetQuantize.h`; keep the two in
+//! step.
+
+use bevy::prelude::*;
+
+use crate::proto::tower::game::{
+    EntitySnapshot, FloorBounds as ProtoFloorBounds, Vec3 as ProtoVec3,
+};
+
+/// Bincode packet types (client `AReplicationManager::EPacketType`)
+pub const PACKET_PLAYER_UPDATE_QUANTIZED: u8 = 0x06;
+pub const PACKET_MONSTER_UPDATE_QUANTIZED: u8 = 0x07;
+pub const PACKET_FLOOR_BOUNDS: u8 = 0x08;
+
+const STEPS: f32 = 65535.0;
+const ROTATION_BITS: u32 = 10;
+const ROTATION_MAX: u32 = (1 << ROTATION_BITS) - 1;
+
+/// Player health is out of 100 on the bincode protocol
+pub const PLAYER_MAX_HEALTH: f32 = 100.0;
+
+/// Floor volume positions are quantized against (Bevy space, meters)
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct FloorBounds {
+    pub min: Vec3,
+    pub max: Vec3,
+}
+
+impl FloorBounds {
+    pub fn new(min: Vec3, max: Vec3) -> Self {
+        Self { min, max }
+    }
+
+    /// Every axis has some extent
+    pub fn is_valid(&self) -> bool {
+        self.max.cmpgt(self.min).all()
+    }
+
+    /// Distance between neighbouring values, per axis
+    pub fn step(&self) -> Vec3 {
+        (self.max - self.min) / STEPS
+    }
+
+    /// Clamps to the bounds; all zero if they are not valid
+    pub fn quantize(&self, position: Vec3) -> [u16; 3] {
+        if !self.is_valid() {
+            return [0; 3];
+        }
+        let unit = ((position - self.min) / (self.max - self.min)).clamp(Vec3::ZERO, Vec3::ONE);
+        [
+            (unit.x * STEPS).round() as u16,
+            (unit.y * STEPS).round() as u16,
+            (unit.z * STEPS).round() as u16,
+        ]
+    }
+
+    pub fn dequantize(&self, steps: [u16; 3]) -> Vec3 {
+        let unit = Vec3::new(steps[0] as f32, steps[1] as f32, steps[2] as f32) / STEPS;
+        self.min + (self.max - self.min) * unit
+    }
+
+    pub fn to_proto(&self) -> ProtoFloorBounds {
+        let vec = |v: Vec3| ProtoVec3 {
+            x: v.x,
+            y: v.y,
+            z: v.z,
+        };
+        ProtoFloorBounds {
+            min: Some(vec(self.min)),
+            max: Some(vec(self.max)),
+        }
+    }
+}
+
+/// Three position steps in one integer (x | y << 16 | z << 32), for a protobuf varint
+pub fn pack_position(steps: [u16; 3]) -> u64 {
+    steps[0] as u64 | (steps[1] as u64) << 16 | (steps[2] as u64) << 32
+}
+
+pub fn unpack_position(packed: u64) -> [u16; 3] {
+    [packed as u16, (packed >> 16) as u16, (packed >> 32) as u16]
+}
+
+/// Yaw in radians as a u16 fraction of a full turn; wraps
+pub fn quantize_yaw(radians: f32) -> u16 {
+    (radians / std::f32::consts::TAU * 65536.0).round() as i64 as u16
+}
+
+/// [0, 2π)
+pub fn dequantize_yaw(value: u16) -> f32 {
+    value as f32 / 65536.0 * std::f32::consts::TAU
+}
+
+/// value / max in 1/255 steps; 0 when max is not positive
+pub fn quantize_fraction8(value: f32, max: f32) -> u8 {
+    if max > 0.0 {
+        ((value / max).clamp(0.0, 1.0) * 255.0).round() as u8
+    } else {
+        0
+    }
+}
+
+pub fn dequantize_fraction8(value: u8) -> f32 {
+    value as f32 / 255.0
+}
+
+/// Smallest-three quaternion: index of the largest component in the top two
+/// bits, the other three in 10 bits each over ±1/√2. The largest is rebuilt
+/// from unit length with its sign forced positive (q and -q are one rotation).
+pub fn quantize_rotation(rotation: Quat) -> u32 {
+    let q = rotation.normalize().to_array();
+    let largest = (1..4).fold(
+        0,
+        |best, i| if q[i].abs() > q[best].abs() { i } else { best },
+    );
+    let sign = if q[largest] < 0.0 { -1.0 } else { 1.0 };
+
+    let mut packed = (largest as u32) << (ROTATION_BITS * 3);
+    let mut shift = ROTATION_BITS * 2;
+    for (i, &component) in q.iter().enumerate() {
+        if i == largest {
+            continue;
+        }
+        let unit = ((component * sign * std::f32::consts::SQRT_2 + 1.0) * 0.5).clamp(0.0, 1.0);
+        packed |= ((unit * ROTATION_MAX as f32).round() as u32) << shift;
+        shift = shift.saturating_sub(ROTATION_BITS);
+    }
+    packed
+}
+
+pub fn dequantize_rotation(packed: u32) -> Quat {
+    let largest = ((packed >> (ROTATION_BITS * 3)) & 0x3) as usize;
+    let mut q = [0.0f32; 4];
+    let mut sum_squares = 0.0;
+    let mut shift = ROTATION_BITS * 2;
+    for (i, component) in q.iter_mut().enumerate() {
+        if i == largest {
+            continue;
+        }
+        let unit = ((packed >> shift) & ROTATION_MAX) as f32 / ROTATION_MAX as f32;
+        *component = (unit * 2.0 - 1.0) * std::f32::consts::FRAC_1_SQRT_2;
+        sum_squares += *component * *component;
+        shift = shift.saturating_sub(ROTATION_BITS);
+    }
+    q[largest] = (1.0 - sum_squares).max(0.0).sqrt();
+    Quat::from_array(q).normalize()
+}
+
+// ============================================================================
+// Bincode packets
+// ============================================================================
+
+/// `FloorBounds` packet: sent once per floor, before any quantized update
+pub fn encode_floor_bounds(bounds: &FloorBounds, out: &mut Vec<u8>) {
+    out.push(PACKET_FLOOR_BOUNDS);
+    for v in [bounds.min, bounds.max] {
+        for c in v.to_array() {
+            out.extend_from_slice(&c.to_le_bytes());
+        }
+    }
+}
+
+fn write_position(bounds: &FloorBounds, position: Vec3, out: &mut Vec<u8>) {
+    for step in bounds.quantize(position) {
+        out.extend_from_slice(&step.to_le_bytes());
+    }
+}
+
+/// `PlayerUpdateQuantized`: u64 id, [u16; 3] position, u8 health / 100, u32 floor (20 bytes with the type)
+pub fn encode_player_update(
+    bounds: &FloorBounds,
+    id: u64,
+    position: Vec3,
+    health: f32,
+    floor: u32,
+    out: &mut Vec<u8>,
+) {
+    out.push(PACKET_PLAYER_UPDATE_QUANTIZED);
+    out.extend_from_slice(&id.to_le_bytes());
+    write_position(bounds, position, out);
+    out.push(quantize_fraction8(health, PLAYER_MAX_HEALTH));
+    out.extend_from_slice(&floor.to_le_bytes());
+}
+
+/// `MonsterUpdateQuantized`: string type, [u16; 3] position, f32 max health, u8 health fraction
+pub fn encode_monster_update(
+    bounds: &FloorBounds,
+    monster_type: &str,
+    position: Vec3,
+    health: f32,
+    max_health: f32,
+    out: &mut Vec<u8>,
+) {
+    out.push(PACKET_MONSTER_UPDATE_QUANTIZED);
+    out.extend_from_slice(&(monster_type.len() as u64).to_le_bytes());
+    out.extend_from_slice(monster_type.as_bytes());
+    write_position(bounds, position, out);
+    out.extend_from_slice(&max_health.to_le_bytes());
+    out.push(quantize_fraction8(health, max_health));
+}
+
+// ============================================================================
+// Protobuf
+// ============================================================================
+
+/// Fill the quantized fields of a snapshot, clearing their full-precision twins
+pub fn quantize_snapshot(
+    snapshot: &mut EntitySnapshot,
+    bounds: &FloorBounds,
+    position: Vec3,
+    yaw: f32,
+    health: f32,
+    max_health: f32,
+) {
+    snapshot.position = None;
+    snapshot.rotation = None;
+    snapshot.health = None;
+    snapshot.position_q = Some(pack_position(bounds.quantize(position)));
+    snapshot.yaw_q = Some(quantize_yaw(yaw) as u32);
+    snapshot.health_q = Some(quantize_fraction8(health, max_health) as u32);
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use prost::Message;
+
+    fn test_bounds() -> FloorBounds {
+        FloorBounds::new(
+            Vec3::new(-100.0, -10.0, -100.0),
+            Vec3::new(100.0, 40.0, 100.0),
+        )
+    }
+
+    #[test]
+    fn test_position_round_trip_within_half_step() {
+        let bounds = test_bounds();
+        let half_step = bounds.step() * 0.5 + Vec3::splat(1e-4);
+        for position in [
+            Vec3::new(0.0, 0.0, 0.0),
+            Vec3::new(12.345, 1.8, -87.6),
+            Vec3::new(-100.0, 40.0, 100.0),
+        ] {
+            let decoded = bounds.dequantize(bounds.quantize(position));
+            assert!(
+                (decoded - position).abs().cmple(half_step).all(),
+                "{position} -> {decoded}"
+            );
+        }
+    }
+
+    #[test]
+    fn test_position_clamps_and_packs() {
+        let bounds = test_bounds();
+        assert_eq!(bounds.quantize(Vec3::splat(1000.0)), [65535; 3]);
+        assert_eq!(bounds.quantize(Vec3::splat(-1000.0)), [0; 3]);
+
+        let steps = [1, 2, 65535];
+        assert_eq!(unpack_position(pack_position(steps)), steps);
+        assert_eq!(
+            FloorBounds::new(Vec3::ZERO, Vec3::ZERO).quantize(Vec3::ONE),
+            [0; 3]
+        );
+    }
+
+    #[test]
+    fn test_yaw_wraps() {
+        assert_eq!(quantize_yaw(0.0), 0);
+        assert_eq!(quantize_yaw(std::f32::consts::TAU), 0);
+        assert_eq!(quantize_yaw(-std::f32::consts::FRAC_PI_2), 49152);
+        assert!((dequantize_yaw(quantize_yaw(1.0)) - 1.0).abs() < 1e-3);
+    }
+
+    #[test]
+    fn test_health_fraction() {
+        assert_eq!(quantize_fraction8(50.0, 100.0), 128);
+        assert_eq!(quantize_fraction8(150.0, 100.0), 255);
+        assert_eq!(quantize_fraction8(10.0, 0.0), 0);
+        assert!((dequantize_fraction8(quantize_fraction8(37.0, 120.0)) * 120.0 - 37.0).abs() < 0.5);
+    }
+
+    #[test]
+    fn test_rotation_round_trip() {
+        for rotation in [
+            Quat::IDENTITY,
+            Quat::from_rotation_y(2.5),
+            Quat::from_euler(EulerRot::YXZ, -1.2, 0.4, 0.1),
+            -Quat::from_rotation_x(0.7),
+        ] {
+            let decoded = dequantize_rotation(quantize_rotation(rotation));
+            // |dot| ~ 1 means the same rotation regardless of sign
+            assert!(
+                decoded.dot(rotation).abs() > 0.9999,
+                "{rotation} -> {decoded}"
+            );
+        }
+    }
+
+    #[test]
+    fn test_bincode_packet_sizes() {
+        let bounds = test_bounds();
+        let mut bytes = Vec::new();
+        encode_player_update(&bounds, 7, Vec3::new(1.0, 2.0, 3.0), 80.0, 4, &mut bytes);
+        assert_eq!(bytes.len(), 20); // 29 unquantized
+
+        bytes.clear();
+        encode_monster_update(&bounds, "Goblin", Vec3::ZERO, 30.0, 60.0, &mut bytes);
+        assert_eq!(bytes.len(), 1 + 8 + 6 + 6 + 4 + 1);
+        assert_eq!(*bytes.last().unwrap(), 128);
+
+        bytes.clear();
+        encode_floor_bounds(&bounds, &mut bytes);
+        assert_eq!(bytes.len(), 25);
+    }
+
+    #[test]
+    fn test_quantized_snapshot_is_smaller() {
+        let bounds = test_bounds();
+        let full = EntitySnapshot {
+            entity_id: 1,
+            changed_fields: 0xFF,
+            position: Some(ProtoVec3 {
+                x: 12.3,
+                y: 1.8,
+                z: -45.6,
+            }),
+            rotation: Some(crate::proto::tower::game::Rotation {
+                pitch: 0.1,
+                yaw: 1.2,
+                roll: 0.0,
+            }),
+            health: Some(85.5),
+            ..Default::default()
+        };
+        let mut quantized = full.clone();
+        quantize_snapshot(
+            &mut quantized,
+            &bounds,
+            Vec3::new(12.3, 1.8, -45.6),
+            1.2,
+            85.5,
+            100.0,
+        );
+
+        let full_len = full.encoded_len();
+        let quantized_len = quantized.encoded_len();
+        assert!(
+            quantized_len * 2 <= full_len + 4,
+            "{quantized_len} vs {full_len}"
+        );
+
+        let decoded = EntitySnapshot::decode(&quantized.encode_to_vec()[..]).unwrap();
+        let position = bounds.dequantize(unpack_position(decoded.position_q.unwrap()));
+        assert!((position - Vec3::new(12.3, 1.8, -45.6)).length() < 0.01);
+    }
+}
@@ -0,0 +1,406 @@
+//! Packed tile grids — run-length encoded floors for transfer and storage
+//!
+//! A floor's tiles as one row-major stream of 4-bit tile types with implicit
+//! coordinates, plus a base biome and per-room biome rectangles, instead of a
+//! `FloorTileData` message per tile. A 50x50 floor drops from ~30 KB to a few
+//! hundred bytes. Run tokens are one byte:
+//!
+//! - `TTTT nnnn`, `T < 15`: a run of tile type `T`, `n + 1` tiles long; `n = 15`
+//!   means the length is `16 +` a LEB128 varint that follows
+//! - `1111 nnnn`: literal, the next `n + 1` bytes hold two tiles each (low
+//!   nibble first), for stretches of short runs
+//!
+//! Carried in `ChunkData.packed_tiles` and stored that way in the LRU / LMDB
+//! caches. Mirrors `ue5-client/Source/TowerGame/Core/PackedTileGrid.h`; keep
+//! the two in step.
+
+use std::collections::HashMap;
+
+/// Tile types must be below this; 15 marks a literal
+pub const MAX_TILE_TYPE: u8 = 15;
+
+const MAX_SHORT_RUN: usize = 15;
+const MAX_LITERAL_TILES: usize = 32;
+/// Runs shorter than this go into literals, which pack two tiles a byte
+const MIN_RUN: usize = 3;
+
+/// Biome override for a rectangle of the grid, normally one per room
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct BiomeRegion {
+    pub x: u16,
+    pub y: u16,
+    pub width: u16,
+    pub height: u16,
+    pub biome_id: u16,
+}
+
+impl BiomeRegion {
+    fn contains(&self, x: usize, y: usize) -> bool {
+        let (rx, ry) = (self.x as usize, self.y as usize);
+        x >= rx && x < rx + self.width as usize && y >= ry && y < ry + self.height as usize
+    }
+}
+
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct PackedTileGrid {
+    pub width: u16,
+    pub height: u16,
+    pub base_biome: u16,
+    /// Later regions win where they overlap
+    pub regions: Vec<BiomeRegion>,
+    pub runs: Vec<u8>,
+}
+
+fn run_length(types: &[u8], start: usize, limit: usize) -> usize {
+    let mut end = start + 1;
+    while end < types.len() && end - start < limit && types[end] == types[start] {
+        end += 1;
+    }
+    end - start
+}
+
+impl PackedTileGrid {
+    pub fn len(&self) -> usize {
+        self.width as usize * self.height as usize
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Encode `width * height` row-major tile types; `None` if the sizes
+    /// disagree or a type is `MAX_TILE_TYPE` or above
+    pub fn pack(types: &[u8], width: u16, height: u16) -> Option<Self> {
+        if types.len() != width as usize * height as usize
+            || types.iter().any(|&t| t >= MAX_TILE_TYPE)
+        {
+            return None;
+        }
+
+        let mut runs = Vec::new();
+        let mut index = 0;
+        while index < types.len() {
+            let run = run_length(types, index, usize::MAX);
+            if run >= MIN_RUN || index + 1 == types.len() {
+                let tile = types[index] << 4;
+                if run <= MAX_SHORT_RUN {
+                    runs.push(tile | (run - 1) as u8);
+                } else {
+                    runs.push(tile | MAX_SHORT_RUN as u8);
+                    let mut extra = (run - (MAX_SHORT_RUN + 1)) as u32;
+                    while extra >= 0x80 {
+                        runs.push((extra as u8) | 0x80);
+                        extra >>= 7;
+                    }
+                    runs.push(extra as u8);
+                }
+                index += run;
+                continue;
+            }
+
+            // Gather short runs until a long one starts; literals hold an even count
+            let mut end = index;
+            while end < types.len()
+                && end - index < MAX_LITERAL_TILES
+                && run_length(types, end, MIN_RUN) < MIN_RUN
+            {
+                end += 1;
+            }
+            let count = (end - index) & !1;
+            if count < 2 {
+                runs.push(types[index] << 4);
+                index += 1;
+                continue;
+            }
+
+            runs.push((MAX_TILE_TYPE << 4) | (count / 2 - 1) as u8);
+            for pair in types[index..index + count].chunks_exact(2) {
+                runs.push(pair[0] | (pair[1] << 4));
+            }
+            index += count;
+        }
+
+        Some(Self {
+            width,
+            height,
+            base_biome: 0,
+            regions: Vec::new(),
+            runs,
+        })
+    }
+
+    /// Expand to row-major tile types; `None` if the runs are malformed or do
+    /// not cover exactly `width * height` tiles
+    pub fn unpack(&self) -> Option<Vec<u8>> {
+        let total = self.len();
+        let mut out = Vec::with_capacity(total);
+        let mut cursor = 0;
+        while cursor < self.runs.len() {
+            let token = self.runs[cursor];
+            cursor += 1;
+            let (tile, low) = (token >> 4, (token & 0x0F) as usize);
+
+            if tile == MAX_TILE_TYPE {
+                let bytes = self.runs.get(cursor..cursor + low + 1)?;
+                for &byte in bytes {
+                    let (a, b) = (byte & 0x0F, byte >> 4);
+                    if a == MAX_TILE_TYPE || b == MAX_TILE_TYPE {
+                        return None;
+                    }
+                    out.push(a);
+                    out.push(b);
+                }
+                cursor += low + 1;
+            } else {
+                let count = if low < MAX_SHORT_RUN {
+                    low + 1
+                } else {
+                    let mut extra = 0u64;
+                    let mut shift = 0;
+                    loop {
+                        let byte = *self.runs.get(cursor)?;
+                        cursor += 1;
+                        extra |= ((byte & 0x7F) as u64) << shift;
+                        if byte & 0x80 == 0 {
+                            break;
+                        }
+                        shift += 7;
+                        if shift >= 35 {
+                            return None;
+                        }
+                    }
+                    extra as usize + MAX_SHORT_RUN + 1
+                };
+                if count > total - out.len() {
+                    return None;
+                }
+                out.resize(out.len() + count, tile);
+            }
+
+            if out.len() > total {
+                return None;
+            }
+        }
+
+        (out.len() == total).then_some(out)
+    }
+
+    pub fn biome_at(&self, x: usize, y: usize) -> u16 {
+        self.regions
+            .iter()
+            .rev()
+            .find(|r| r.contains(x, y))
+            .map_or(self.base_biome, |r| r.biome_id)
+    }
+
+    /// Set the base biome and regions from one biome id per tile: the most
+    /// common id (lowest on a tie) becomes the base, each other stretch of a
+    /// row a one-row region
+    pub fn set_biomes(&mut self, tile_biomes: &[u16]) {
+        self.regions.clear();
+        self.base_biome = 0;
+        if tile_biomes.is_empty() || tile_biomes.len() != self.len() {
+            return;
+        }
+
+        let mut counts: HashMap<u16, usize> = HashMap::new();
+        for &biome in tile_biomes {
+            *counts.entry(biome).or_default() += 1;
+        }
+        let (&base, _) = counts
+            .iter()
+            .max_by(|a, b| a.1.cmp(b.1).then(b.0.cmp(a.0)))
+            .unwrap();
+        self.base_biome = base;
+        if counts.len() == 1 {
+            return;
+        }
+
+        let width = self.width as usize;
+        for (y, row) in tile_biomes.chunks_exact(width).enumerate() {
+            let mut x = 0;
+            while x < width {
+                let mut end = x + 1;
+                while end < width && row[end] == row[x] {
+                    end += 1;
+                }
+                if row[x] != base {
+                    self.regions.push(BiomeRegion {
+                        x: x as u16,
+                        y: y as u16,
+                        width: (end - x) as u16,
+                        height: 1,
+                        biome_id: row[x],
+                    });
+                }
+                x = end;
+            }
+        }
+    }
+
+    /// Little-endian blob: u16 width, u16 height, u16 base biome, u16 region
+    /// count, regions (5 x u16 each), u32 run bytes, runs
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let regions = &self.regions[..self.regions.len().min(u16::MAX as usize)];
+        let mut out = Vec::with_capacity(12 + regions.len() * 10 + self.runs.len());
+        out.extend_from_slice(&self.width.to_le_bytes());
+        out.extend_from_slice(&self.height.to_le_bytes());
+        out.extend_from_slice(&self.base_biome.to_le_bytes());
+        out.extend_from_slice(&(regions.len() as u16).to_le_bytes());
+        for r in regions {
+            for v in [r.x, r.y, r.width, r.height, r.biome_id] {
+                out.extend_from_slice(&v.to_le_bytes());
+            }
+        }
+        out.extend_from_slice(&(self.runs.len() as u32).to_le_bytes());
+        out.extend_from_slice(&self.runs);
+        out
+    }
+
+    /// Parse a blob from `to_bytes`; `None` if truncated. Trailing bytes are ignored.
+    pub fn from_bytes(bytes: &[u8]) -> Option<Self> {
+        let u16_at = |at: usize| -> Option<u16> {
+            bytes
+                .get(at..at + 2)
+                .map(|b| u16::from_le_bytes([b[0], b[1]]))
+        };
+
+        let width = u16_at(0)?;
+        let height = u16_at(2)?;
+        let base_biome = u16_at(4)?;
+        let region_count = u16_at(6)? as usize;
+
+        let mut cursor = 8;
+        let mut regions = Vec::with_capacity(region_count);
+        for _ in 0..region_count {
+            regions.push(BiomeRegion {
+                x: u16_at(cursor)?,
+                y: u16_at(cursor + 2)?,
+                width: u16_at(cursor + 4)?,
+                height: u16_at(cursor + 6)?,
+                biome_id: u16_at(cursor + 8)?,
+            });
+            cursor += 10;
+        }
+
+        let len = bytes.get(cursor..cursor + 4)?;
+        let run_bytes = u32::from_le_bytes([len[0], len[1], len[2], len[3]]) as usize;
+        cursor += 4;
+        let runs = bytes.get(cursor..cursor.checked_add(run_bytes)?)?.to_vec();
+
+        Some(Self {
+            width,
+            height,
+            base_biome,
+            regions,
+            runs,
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn sample_floor() -> Vec<u8> {
+        // 20x6: wall border, floor interior, a few scattered props
+        let (w, h) = (20, 6);
+        let mut tiles = vec![1u8; w * h];
+        for y in 0..h {
+            for x in 0..w {
+                if x == 0 || y == 0 || x == w - 1 || y == h - 1 {
+                    tiles[y * w + x] = 2;
+                }
+            }
+        }
+        tiles[2 * w + 3] = 6;
+        tiles[2 * w + 4] = 7;
+        tiles[3 * w + 10] = 3;
+        tiles[3 * w + 12] = 9;
+        tiles
+    }
+
+    #[test]
+    fn test_round_trip() {
+        let tiles = sample_floor();
+        let grid = PackedTileGrid::pack(&tiles, 20, 6).unwrap();
+        assert_eq!(grid.unpack().unwrap(), tiles);
+        assert!(grid.runs.len() < tiles.len() / 2);
+    }
+
+    #[test]
+    fn test_long_runs_use_varint() {
+        let tiles = vec![2u8; 5000];
+        let grid = PackedTileGrid::pack(&tiles, 100, 50).unwrap();
+        assert_eq!(grid.runs.len(), 3);
+        assert_eq!(grid.unpack().unwrap(), tiles);
+    }
+
+    #[test]
+    fn test_noise_uses_literals() {
+        let tiles: Vec<u8> = (0..64).map(|i| (i * 7 % 12) as u8).collect();
+        let grid = PackedTileGrid::pack(&tiles, 8, 8).unwrap();
+        assert_eq!(grid.runs.len(), 2 * (1 + 16));
+        assert_eq!(grid.unpack().unwrap(), tiles);
+    }
+
+    #[test]
+    fn test_odd_sizes() {
+        for len in 1..40usize {
+            let tiles: Vec<u8> = (0..len).map(|i| ((i / 2) % 3) as u8).collect();
+            let grid = PackedTileGrid::pack(&tiles, len as u16, 1).unwrap();
+            assert_eq!(grid.unpack().unwrap(), tiles, "len {}", len);
+        }
+    }
+
+    #[test]
+    fn test_rejects_bad_input() {
+        assert!(PackedTileGrid::pack(&[15], 1, 1).is_none());
+        assert!(PackedTileGrid::pack(&[1, 2], 3, 1).is_none());
+
+        let mut grid = PackedTileGrid::pack(&[1; 10], 10, 1).unwrap();
+        grid.runs.push(0x10);
+        assert!(grid.unpack().is_none());
+        grid.runs = vec![0xF3, 0x11];
+        assert!(grid.unpack().is_none());
+    }
+
+    #[test]
+    fn test_biomes() {
+        let tiles = sample_floor();
+        let mut grid = PackedTileGrid::pack(&tiles, 20, 6).unwrap();
+        let mut biomes = vec![3u16; 120];
+        for y in 1..4 {
+            for x in 5..9 {
+                biomes[y * 20 + x] = 7;
+            }
+        }
+        grid.set_biomes(&biomes);
+        assert_eq!(grid.base_biome, 3);
+        assert_eq!(grid.regions.len(), 3);
+        for y in 0..6 {
+            for x in 0..20 {
+                assert_eq!(grid.biome_at(x, y), biomes[y * 20 + x]);
+            }
+        }
+
+        grid.set_biomes(&vec![4; 120]);
+        assert_eq!((grid.base_biome, grid.regions.len()), (4, 0));
+    }
+
+    #[test]
+    fn test_bytes_round_trip() {
+        let mut grid = PackedTileGrid::pack(&sample_floor(), 20, 6).unwrap();
+        grid.base_biome = 2;
+        grid.regions.push(BiomeRegion {
+            x: 1,
+            y: 1,
+            width: 4,
+            height: 2,
+            biome_id: 5,
+        });
+        let bytes = grid.to_bytes();
+        assert_eq!(PackedTileGrid::from_bytes(&bytes).unwrap(), grid);
+        assert!(PackedTileGrid::from_bytes(&bytes[..bytes.len() - 1]).is_none());
+    }
+}
@@ -6,6 +6,7 @@
 //!
 //! Each test mirrors the parsing logic in GRPCClientManager.cpp:
 //! - GenerateFloor (line 496): broadcasts raw JSON
+//! - GenerateFloorChunk: FChunkStreamDecoder reads the binary ChunkData
 //! - CalculateDamage (lines 514-534): reads damage fields + modifiers
 //! - TrackProgress (lines 554-567): reads mastery fields
 //! - GetWallet (lines 587-589): reads gold, premium_currency, seasonal_currency
@@ -15,12 +16,14 @@
 
 use axum::body::Body;
 use http::Request;
+use prost::Message;
 use serde_json::Value;
 use std::sync::Arc;
 use tower::ServiceExt;
 use tower_bevy_server::api;
 use tower_bevy_server::ecs_bridge;
 use tower_bevy_server::metrics::ServerMetrics;
+use tower_bevy_server::proto::tower::game::ChunkData;
 use tower_bevy_server::storage::lmdb_templates::LmdbTemplateStore;
 use tower_bevy_server::storage::seed_data;
 
@@ -113,6 +116,56 @@ async fn contract_generate_floor_has_expected_fields() {
     assert!(tile["is_walkable"].is_boolean(), "Tile missing is_walkable");
 }
 
+// ============================================================================
+// Contract: GenerateFloorChunk
+// UE5 ProceduralFloorRenderer::StreamFloorChunk decodes row-major ChunkData tiles
+// ============================================================================
+
+#[tokio::test]
+async fn contract_generate_floor_chunk_matches_floor() {
+    let (router, _tmp) = create_test_router().await;
+    let body = r#"{"tower_seed": 42, "floor_id": 1}"#;
+
+    let json = post_json(
+        router.clone(),
+        "/tower.GenerationService/GenerateFloor",
+        body,
+    )
+    .await;
+
+    let req = Request::builder()
+        .method("POST")
+        .uri("/tower.GenerationService/GenerateFloorChunk")
+        .header("content-type", "application/json")
+        .body(Body::from(body))
+        .unwrap();
+    let resp = router.oneshot(req).await.unwrap();
+    assert_eq!(resp.status(), 200);
+    assert_eq!(resp.headers()["content-type"], "application/x-protobuf");
+
+    let bytes = axum::body::to_bytes(resp.into_body(), usize::MAX)
+        .await
+        .unwrap();
+    let chunk = ChunkData::decode(bytes).expect("GenerateFloorChunk is not a ChunkData");
+
+    assert_eq!(chunk.floor_id, 1);
+    assert_eq!(chunk.seed, json["seed"].as_u64().unwrap());
+    assert_eq!(chunk.tiles.len(), json["tiles"].as_array().unwrap().len());
+
+    // The decoder splits batches where grid_y changes
+    assert!(chunk
+        .tiles
+        .windows(2)
+        .all(|pair| pair[0].grid_y <= pair[1].grid_y));
+
+    let hex: String = chunk
+        .validation_hash
+        .iter()
+        .map(|b| format!("{:02x}", b))
+        .collect();
+    assert_eq!(hex, json["validation_hash"].as_str().unwrap());
+}
+
 // ============================================================================
 // Contract: CalculateDamage
 // UE5 (lines 514-534): reads base_damage, modified_damage, crit_chance,
@@ -19,6 +19,8 @@ local PLAYER_STATE_COLLECTION = "tower_player_state"
 local GLOBAL_STATE_COLLECTION = "tower_global"
 local MAX_PLAYERS_PER_FLOOR = 50
 local MATCH_MODULE = "tower_match"
+local ECHO_LIST_PAGE_SIZE = 100
+local ECHO_LIST_MAX_PAGES = 10
 
 -- ============ Tower Seed Management ============
 
@@ -96,9 +98,53 @@ local function load_player_state(user_id)
     }
 end
 
+-- ============ RPC Registry ============
+
+-- Every tower RPC, by id, so "batch" can call them in-process
+local RPC_HANDLERS = {}
+local MAX_BATCH_CALLS = 16
+
+local function register_rpc(handler, id)
+    RPC_HANDLERS[id] = handler
+    nk.register_rpc(handler, id)
+end
+
+-- ============ Game Servers ============
+
+-- Where floor matches run their netcode, from the runtime env
+-- (local.yml runtime.env): tower_game_servers = "region=host:port,...".
+-- Clients ping these (UDP echo on port + 1) to pick the closest region.
+local DEFAULT_GAME_SERVER = { region = "local", host = "127.0.0.1", port = 5000 }
+
+local function get_game_servers(context)
+    local servers = {}
+    local spec = context.env and context.env["tower_game_servers"] or ""
+    for entry in string.gmatch(spec, "[^,%s]+") do
+        local region, host, port = string.match(entry, "^([%w_%-]+)=([^:]+):(%d+)$")
+        if region then
+            table.insert(servers, { region = region, host = host, port = tonumber(port) })
+        else
+            nk.logger_warn(string.format("Ignoring malformed tower_game_servers entry '%s'", entry))
+        end
+    end
+    if #servers == 0 then
+        table.insert(servers, DEFAULT_GAME_SERVER)
+    end
+    return servers
+end
+
+local function find_game_server(servers, region)
+    for _, server in ipairs(servers) do
+        if server.region == region then
+            return server
+        end
+    end
+    return servers[1]
+end
+
 -- ============ RPC: Get Tower Seed ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local seed, epoch = get_tower_seed()
     return nk.json_encode({
         seed = seed,
@@ -109,7 +155,7 @@ end, "get_tower_seed")
 
 -- ============ RPC: Request Floor ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local data = nk.json_decode(payload)
     local floor_id = data.floor_id or 1
     local seed, _ = get_tower_seed()
@@ -142,7 +188,7 @@ end, "request_floor")
 
 -- ============ RPC: Report Floor Clear ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local data = nk.json_decode(payload)
     local floor_id = data.floor_id or 1
     local kills = data.kills or 0
@@ -182,7 +228,7 @@ end, "report_floor_clear")
 
 -- ============ RPC: Report Death ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local data = nk.json_decode(payload)
     local floor_id = data.floor_id or 1
     local echo_type = data.echo_type or "Lingering"
@@ -225,25 +271,40 @@ end, "report_death")
 
 -- ============ RPC: Get Echoes for Floor ============
 
-nk.register_rpc(function(context, payload)
+-- Clients cache a floor's echoes and pass back the returned cursor as "since":
+-- only echoes created at or after it are sent (the cursor's own second again,
+-- which the client dedupes by id), so a revisit downloads just what is new.
+register_rpc(function(context, payload)
     local data = nk.json_decode(payload)
     local floor_id = data.floor_id or 1
-
-    -- Query echoes for this floor
-    local query = string.format("+value.floor_id:%d +value.expires_at:>%d", floor_id, os.time())
-    local result = nk.storage_list(nil, "tower_echoes", 20, "")
+    local since = data.since or 0
+    local now = os.time()
 
     local echoes = {}
-    for _, obj in ipairs(result) do
-        local echo = obj.value
-        if echo.floor_id == floor_id and echo.expires_at > os.time() then
-            table.insert(echoes, {
-                player_name = echo.player_name,
-                echo_type = echo.echo_type,
-                position = echo.position,
-                semantic_tags = echo.semantic_tags,
-            })
+    local cursor = since
+    local page_cursor = ""
+    for _ = 1, ECHO_LIST_MAX_PAGES do
+        local result, next_cursor = nk.storage_list(nil, "tower_echoes", ECHO_LIST_PAGE_SIZE, page_cursor)
+        for _, obj in ipairs(result) do
+            local echo = obj.value
+            local created_at = echo.created_at or 0
+            if echo.floor_id == floor_id and echo.expires_at > now and created_at >= since then
+                table.insert(echoes, {
+                    id = obj.key,
+                    player_name = echo.player_name,
+                    echo_type = echo.echo_type,
+                    position = echo.position,
+                    semantic_tags = echo.semantic_tags,
+                    created_at = created_at,
+                    expires_at = echo.expires_at,
+                })
+                cursor = math.max(cursor, created_at)
+            end
         end
+        if next_cursor == nil or next_cursor == "" then
+            break
+        end
+        page_cursor = next_cursor
     end
 
     return nk.json_encode({
@@ -251,12 +312,13 @@ nk.register_rpc(function(context, payload)
         floor_id = floor_id,
         echoes = echoes,
         count = #echoes,
+        cursor = cursor,
     })
 end, "get_floor_echoes")
 
 -- ============ RPC: Update Faction Standing ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local data = nk.json_decode(payload)
     local faction = data.faction
     local delta = data.delta or 0
@@ -280,7 +342,7 @@ end, "update_faction")
 
 -- ============ RPC: Get Player State ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local state = load_player_state(context.user_id)
     return nk.json_encode({
         status = "ok",
@@ -290,7 +352,7 @@ end, "get_player_state")
 
 -- ============ RPC: Health Check ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local seed, epoch = get_tower_seed()
     return nk.json_encode({
         status = "healthy",
@@ -302,7 +364,7 @@ end, "health_check")
 
 -- ============ RPC: Join Floor Match ============
 
-nk.register_rpc(function(context, payload)
+register_rpc(function(context, payload)
     local data = nk.json_decode(payload)
     local floor_id = data.floor_id or 1
     local seed, _ = get_tower_seed()
@@ -316,14 +378,35 @@ nk.register_rpc(function(context, payload)
         })
     end
 
-    -- Search for existing match on this floor with space
-    local query = string.format('+label.floor_id:%d +label.cleared:false', floor_id)
-    local matches = nk.match_list(1, true, "", nil, 1, query)
-
+    -- A match the client ranked by latency, if it is still open for this floor
     local match_id
-    if #matches > 0 then
-        -- Join existing match
-        match_id = matches[1].match_id
+    local servers = get_game_servers(context)
+    local server = find_game_server(servers, data.region)
+    if type(data.match_id) == "string" and data.match_id ~= "" then
+        local match = nk.match_get(data.match_id)
+        local label = match and match.label and nk.json_decode(match.label)
+        if label and label.floor_id == floor_id and not label.cleared
+            and (label.player_count or 0) < (label.max_players or MAX_PLAYERS_PER_FLOOR) then
+            match_id = data.match_id
+            server = { region = label.region, host = label.host, port = label.port }
+        end
+    end
+
+    -- Otherwise an existing match on this floor with space, in the preferred region when given
+    if not match_id then
+        local query = string.format('+label.floor_id:%d +label.cleared:false', floor_id)
+        if data.region then
+            query = query .. string.format(' +label.region:%s', server.region)
+        end
+        local matches = nk.match_list(1, true, "", nil, MAX_PLAYERS_PER_FLOOR - 1, query)
+        if #matches > 0 then
+            match_id = matches[1].match_id
+            local label = nk.json_decode(matches[1].label)
+            server = { region = label.region, host = label.host, port = label.port }
+        end
+    end
+
+    if match_id then
         nk.logger_info(string.format("Player %s joining existing floor %d match: %s",
             context.user_id, floor_id, match_id))
     else
@@ -331,9 +414,12 @@ nk.register_rpc(function(context, payload)
         match_id = nk.match_create("tower_match", {
             floor_id = floor_id,
             seed = seed,
+            host = server.host,
+            port = server.port,
+            region = server.region,
         })
-        nk.logger_info(string.format("Player %s created new floor %d match: %s",
-            context.user_id, floor_id, match_id))
+        nk.logger_info(string.format("Player %s created new floor %d match in %s: %s",
+            context.user_id, floor_id, server.region, match_id))
     end
 
     -- Update player state
@@ -346,13 +432,23 @@ nk.register_rpc(function(context, payload)
         match_id = match_id,
         floor_id = floor_id,
         seed = seed,
+        host = server.host,
+        port = server.port,
+        region = server.region,
     })
 end, "join_floor_match")
 
 -- ============ RPC: Get Active Matches ============
 
-nk.register_rpc(function(context, payload)
-    local matches = nk.match_list(20, true, "", nil, nil, "+label.cleared:false")
+-- Optional { floor_id } narrows the list to one floor. servers lists every
+-- game server region, so clients can probe regions with no match yet.
+register_rpc(function(context, payload)
+    local data = payload ~= "" and nk.json_decode(payload) or {}
+    local query = "+label.cleared:false"
+    if data.floor_id then
+        query = query .. string.format(" +label.floor_id:%d", data.floor_id)
+    end
+    local matches = nk.match_list(20, true, "", nil, nil, query)
 
     local result = {}
     for _, match in ipairs(matches) do
@@ -362,6 +458,9 @@ nk.register_rpc(function(context, payload)
             floor_id = label.floor_id,
             player_count = label.player_count,
             max_players = label.max_players,
+            host = label.host,
+            port = label.port,
+            region = label.region,
         })
     end
 
@@ -369,9 +468,50 @@ nk.register_rpc(function(context, payload)
         status = "ok",
         matches = result,
         count = #result,
+        servers = get_game_servers(context),
     })
 end, "list_active_matches")
 
+-- ============ RPC: Batch ============
+
+-- Several RPCs in one round trip: { calls = [{ id, payload }] } ->
+-- { results = [{ id, ok, payload }] }, in call order. Each call runs on its
+-- own (one failing doesn't stop the rest), with the caller's context.
+register_rpc(function(context, payload)
+    local data = nk.json_decode(payload)
+    local calls = data.calls or {}
+
+    if #calls > MAX_BATCH_CALLS then
+        return nk.json_encode({
+            status = "error",
+            message = string.format("Batch of %d calls (max %d)", #calls, MAX_BATCH_CALLS),
+        })
+    end
+
+    local results = {}
+    for i, call in ipairs(calls) do
+        local handler = RPC_HANDLERS[call.id]
+        local ok, response
+        if handler == nil or call.id == "batch" then
+            ok, response = false, string.format("Unknown RPC '%s'", tostring(call.id))
+        else
+            ok, response = pcall(handler, context, call.payload or "{}")
+        end
+
+        if not ok then
+            nk.logger_warn(string.format("Batched RPC %s failed: %s", tostring(call.id), tostring(response)))
+            response = nk.json_encode({ status = "error", message = tostring(response) })
+        end
+
+        results[i] = { id = call.id, ok = ok, payload = response or "" }
+    end
+
+    return nk.json_encode({
+        status = "ok",
+        results = results,
+    })
+end, "batch")
+
 -- ============ Leaderboard Setup ============
 
 -- Create leaderboards on module load
@@ -394,4 +534,4 @@ pcall(setup_leaderboards)
 -- ============ Module Load ============
 
 nk.logger_info("Tower Game server module loaded (v0.6.0)")
-nk.logger_info("RPC endpoints: get_tower_seed, request_floor, report_floor_clear, report_death, get_floor_echoes, update_faction, get_player_state, health_check, join_floor_match, list_active_matches")
+nk.logger_info("RPC endpoints: get_tower_seed, request_floor, report_floor_clear, report_death, get_floor_echoes, update_faction, get_player_state, health_check, join_floor_match, list_active_matches, batch")
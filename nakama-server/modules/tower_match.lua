@@ -23,12 +23,58 @@
 --  10 = Chat message
 --  11 = Loot dropped
 --  12 = Player interact (shrine, chest, NPC)
+--  13 = World snapshot, bincode payload (server -> client). Client-side
+--       contract only: the client decodes it when a BreathSync poll asked for
+--       snapshot_format = "bincode", but this module never encodes one. State
+--       goes out as JSON (op 7 on join, op 1 broadcasts every other tick), and
+--       polls are not answered here.
+--       Also client-side contracts with no server implementation yet:
+--       - polls may carry accept_compression = "lz4,oodle", allowing any
+--         payload as a compressed frame: u8 0xFE, u8 codec (1 = lz4,
+--         2 = oodle), u8 dictionary (0), varint raw size, compressed bytes
+--       - a poll with subscribe = true asks for one snapshot per tick
+--         (deltas against the previous push) until the client sends
+--         subscribe = false or disconnects; clients refresh it about once a
+--         second and when their AOI cell changes
+--       Nothing here produces 0xFE frames or pushes; subscribed clients get
+--       the op 1 broadcasts like everyone else.
+--  14 = Batch (client -> server): JSON array of {"op": <op code>, "d": <payload>}
+--       holding every message a client queued during one frame
+--  15 = Lockstep (client <-> client): binary lockstep session traffic (start,
+--       per-tick input, state hash, stop). Relayed as-is to every player; the
+--       payload carries its sender's entity id, so clients skip their own
+--  16 = Leave (client -> server): the player is leaving for good, so the
+--       disconnect that follows frees the slot at once instead of holding it
+--
+-- Joins may carry metadata session = <client session token>. A player whose
+-- socket drops keeps their slot and state for RESUME_GRACE_SECONDS; joining
+-- again with the same token in that window resumes them (op 7 with
+-- resumed = true, no op 8), and nobody else sees them leave. A same-token join
+-- resumes even when it beats the old socket's leave; that late leave is then
+-- ignored, since it isn't from the presence (session_id) now holding the slot.
 
 local nk = require("nakama")
 
 local MAX_PLAYERS = 50
 local TICK_RATE = 10 -- 10 updates/second
 local EMPTY_TIMEOUT = 300 -- 5 minutes before empty match closes
+local RESUME_GRACE_SECONDS = 15 -- a dropped player's slot is held this long
+
+-- ============ Label ============
+
+-- What match_list queries and list_active_matches reports. host / port / region
+-- are the game server the match runs its netcode on, so clients can probe it.
+local function build_label(state)
+    return nk.json_encode({
+        floor_id = state.floor_id,
+        player_count = state.player_count,
+        max_players = MAX_PLAYERS,
+        cleared = state.floor_cleared,
+        host = state.host,
+        port = state.port,
+        region = state.region,
+    })
+end
 
 -- ============ Match Init ============
 
@@ -38,10 +84,18 @@ local function match_init(context, setupstate)
         floor_id = setupstate.floor_id or 1,
         seed = setupstate.seed or 42,
 
+        -- Game server hosting the floor (see tower_main.lua game_servers)
+        host = setupstate.host or "",
+        port = setupstate.port or 0,
+        region = setupstate.region or "",
+
         -- Players: { [user_id] = { position, hp, name, ... } }
         players = {},
         player_count = 0,
 
+        -- Session tokens from join attempts, until match_join takes them: { [user_id] = token }
+        pending_sessions = {},
+
         -- Monsters: { [monster_id] = { hp, max_hp, position, alive } }
         monsters = {},
         monsters_alive = 0,
@@ -76,12 +130,7 @@ local function match_init(context, setupstate)
     state.monsters_alive = monster_count
     state.monsters_total = monster_count
 
-    local label = nk.json_encode({
-        floor_id = state.floor_id,
-        player_count = 0,
-        max_players = MAX_PLAYERS,
-        cleared = false,
-    })
+    local label = build_label(state)
 
     nk.logger_info(string.format("Match created for floor %d (seed: %d, %d monsters)",
         state.floor_id, state.seed, monster_count))
@@ -92,6 +141,16 @@ end
 -- ============ Match Join Attempt ============
 
 local function match_join_attempt(context, dispatcher, tick, state, presence, metadata)
+    local session = metadata and metadata.session or nil
+    local existing = state.players[presence.user_id]
+
+    -- A dropped player coming back into their held slot, even when full or cleared.
+    -- The old presence's leave may not have arrived yet, so disconnected_at isn't required.
+    if existing and session and session == existing.session then
+        state.pending_sessions[presence.user_id] = session
+        return state, true
+    end
+
     -- Reject if full
     if state.player_count >= MAX_PLAYERS then
         return state, false, "Floor instance full (max " .. MAX_PLAYERS .. " players)"
@@ -102,94 +161,143 @@ local function match_join_attempt(context, dispatcher, tick, state, presence, me
         return state, false, "Floor already cleared"
     end
 
+    state.pending_sessions[presence.user_id] = session
     return state, true
 end
 
 -- ============ Match Join ============
 
+-- What a joining (or resuming) player is sent about the floor
+local function build_sync(state, resumed)
+    return nk.json_encode({
+        floor_id = state.floor_id,
+        seed = state.seed,
+        monsters = state.monsters,
+        monsters_alive = state.monsters_alive,
+        breath_phase = state.breath_phase,
+        breath_progress = state.breath_progress,
+        floor_cleared = state.floor_cleared,
+        player_count = state.player_count,
+        resumed = resumed,
+    })
+end
+
 local function match_join(context, dispatcher, tick, state, presences)
     for _, presence in ipairs(presences) do
-        state.players[presence.user_id] = {
-            user_id = presence.user_id,
-            username = presence.username,
-            position = { x = 0, y = 0, z = 0 },
-            hp = 100,
-            max_hp = 100,
-            alive = true,
-            joined_at = os.time(),
-            kills = 0,
-            damage_dealt = 0,
-        }
-        state.player_count = state.player_count + 1
+        local session = state.pending_sessions[presence.user_id]
+        state.pending_sessions[presence.user_id] = nil
+
+        local existing = state.players[presence.user_id]
+        if existing and session and session == existing.session then
+            -- Resume: same slot, same state; the others never saw them leave. The
+            -- new presence takes the slot over, so the old one's leave, if it is
+            -- still to come, no longer applies (see match_leave)
+            nk.logger_info(string.format("Player %s resumed on floor %d after %ds",
+                presence.username, state.floor_id, os.time() - (existing.disconnected_at or os.time())))
+            existing.disconnected_at = nil
+            existing.leaving = nil
+            existing.session_id = presence.session_id
+            dispatcher.broadcast_message(7, build_sync(state, true), { presence })
+        else
+            if existing then
+                -- A stale slot of the same user (another session): replace it
+                state.player_count = state.player_count - 1
+            end
+            state.players[presence.user_id] = {
+                user_id = presence.user_id,
+                username = presence.username,
+                position = { x = 0, y = 0, z = 0 },
+                hp = 100,
+                max_hp = 100,
+                alive = true,
+                joined_at = os.time(),
+                kills = 0,
+                damage_dealt = 0,
+                session = session,
+                -- The presence holding the slot; leaves of earlier ones are ignored
+                session_id = presence.session_id,
+            }
+            state.player_count = state.player_count + 1
 
-        nk.logger_info(string.format("Player %s joined floor %d (%d/%d)",
-            presence.username, state.floor_id, state.player_count, MAX_PLAYERS))
+            nk.logger_info(string.format("Player %s joined floor %d (%d/%d)",
+                presence.username, state.floor_id, state.player_count, MAX_PLAYERS))
 
-        -- Notify all players about new join
-        local join_data = nk.json_encode({
-            user_id = presence.user_id,
-            username = presence.username,
-            player_count = state.player_count,
-        })
-        dispatcher.broadcast_message(8, join_data)
+            -- Notify all players about new join
+            local join_data = nk.json_encode({
+                user_id = presence.user_id,
+                username = presence.username,
+                player_count = state.player_count,
+            })
+            dispatcher.broadcast_message(8, join_data)
 
-        -- Send current state to joining player
-        local sync_data = nk.json_encode({
-            floor_id = state.floor_id,
-            seed = state.seed,
-            monsters = state.monsters,
-            monsters_alive = state.monsters_alive,
-            breath_phase = state.breath_phase,
-            breath_progress = state.breath_progress,
-            floor_cleared = state.floor_cleared,
-            player_count = state.player_count,
-        })
-        dispatcher.broadcast_message(7, sync_data, { presence })
+            -- Send current state to joining player
+            dispatcher.broadcast_message(7, build_sync(state, false), { presence })
+        end
     end
 
     -- Update label
-    local label = nk.json_encode({
-        floor_id = state.floor_id,
-        player_count = state.player_count,
-        max_players = MAX_PLAYERS,
-        cleared = state.floor_cleared,
-    })
-    dispatcher.match_label_update(label)
+    dispatcher.match_label_update(build_label(state))
 
     return state
 end
 
 -- ============ Match Leave ============
 
-local function match_leave(context, dispatcher, tick, state, presences)
-    for _, presence in ipairs(presences) do
-        state.players[presence.user_id] = nil
-        state.player_count = state.player_count - 1
+-- Free a player's slot and tell everyone still here
+local function remove_player(state, dispatcher, user_id, username)
+    state.players[user_id] = nil
+    state.player_count = state.player_count - 1
 
-        nk.logger_info(string.format("Player %s left floor %d (%d remaining)",
-            presence.username, state.floor_id, state.player_count))
+    nk.logger_info(string.format("Player %s left floor %d (%d remaining)",
+        username, state.floor_id, state.player_count))
 
-        -- Notify remaining players
-        local leave_data = nk.json_encode({
-            user_id = presence.user_id,
-            username = presence.username,
-            player_count = state.player_count,
-        })
-        dispatcher.broadcast_message(9, leave_data)
+    -- Notify remaining players
+    local leave_data = nk.json_encode({
+        user_id = user_id,
+        username = username,
+        player_count = state.player_count,
+    })
+    dispatcher.broadcast_message(9, leave_data)
+end
+
+local function match_leave(context, dispatcher, tick, state, presences)
+    for _, presence in ipairs(presences) do
+        local player = state.players[presence.user_id]
+        if player and player.session_id ~= presence.session_id then
+            -- A presence the player already rejoined over: the slot is the new one's
+            nk.logger_info(string.format("Ignoring leave of a superseded session of %s on floor %d",
+                presence.username, state.floor_id))
+        elseif player and player.session and not player.leaving then
+            -- Dropped, not left: hold the slot for a resume (match_loop frees it)
+            player.disconnected_at = os.time()
+            nk.logger_info(string.format("Player %s dropped from floor %d, holding slot for %ds",
+                presence.username, state.floor_id, RESUME_GRACE_SECONDS))
+        elseif player then
+            remove_player(state, dispatcher, presence.user_id, presence.username)
+        end
     end
 
     -- Update label
-    local label = nk.json_encode({
-        floor_id = state.floor_id,
-        player_count = state.player_count,
-        max_players = MAX_PLAYERS,
-        cleared = state.floor_cleared,
-    })
-    dispatcher.match_label_update(label)
+    dispatcher.match_label_update(build_label(state))
 
     return state
 end
 
+-- Slots held for dropped players whose grace ran out
+local function expire_held_slots(state, dispatcher)
+    local now = os.time()
+    local expired = false
+    for user_id, player in pairs(state.players) do
+        if player.disconnected_at and now - player.disconnected_at >= RESUME_GRACE_SECONDS then
+            remove_player(state, dispatcher, user_id, player.username)
+            expired = true
+        end
+    end
+    if expired then
+        dispatcher.match_label_update(build_label(state))
+    end
+end
+
 -- ============ Match Loop (Tick) ============
 
 local function match_loop(context, dispatcher, tick, state, messages)
@@ -207,41 +315,36 @@ local function match_loop(context, dispatcher, tick, state, messages)
     state.tick_count = tick
     state.elapsed_time = tick / TICK_RATE
 
+    -- Once a second is plenty for a grace counted in seconds
+    if tick % TICK_RATE == 0 then
+        expire_held_slots(state, dispatcher)
+    end
+
     -- Update Breath of Tower
     update_breath(state)
 
     -- Process incoming messages
     for _, message in ipairs(messages) do
         local op_code = message.op_code
-        local data = {}
-        if message.data and #message.data > 0 then
-            data = nk.json_decode(message.data)
-        end
         local sender = message.sender
 
-        if op_code == 1 then
-            -- Player position update
-            handle_position_update(state, sender, data)
-
-        elseif op_code == 2 then
-            -- Player attack
-            handle_player_attack(state, dispatcher, sender, data)
-
-        elseif op_code == 3 then
-            -- Direct monster damage (validated server-side)
-            handle_monster_damage(state, dispatcher, sender, data)
-
-        elseif op_code == 5 then
-            -- Player death
-            handle_player_death(state, dispatcher, sender, data)
-
-        elseif op_code == 10 then
-            -- Chat message (relay to all)
-            dispatcher.broadcast_message(10, message.data)
-
-        elseif op_code == 12 then
-            -- Player interact
-            handle_interact(state, dispatcher, sender, data)
+        if op_code == 15 then
+            -- Lockstep: binary, never decoded here
+            dispatcher.broadcast_message(15, message.data, nil, sender)
+        else
+            local data = {}
+            if message.data and #message.data > 0 then
+                data = nk.json_decode(message.data)
+            end
+
+            if op_code == 14 then
+                -- Batch: one frame's worth of client messages, in send order
+                for _, entry in ipairs(data) do
+                    dispatch_message(state, dispatcher, sender, entry.op, entry.d or {}, nil)
+                end
+            else
+                dispatch_message(state, dispatcher, sender, op_code, data, message.data)
+            end
         end
     end
 
@@ -270,6 +373,40 @@ end
 
 -- ============ Helper Functions ============
 
+function dispatch_message(state, dispatcher, sender, op_code, data, raw)
+    if op_code == 1 then
+        -- Player position update
+        handle_position_update(state, sender, data)
+
+    elseif op_code == 2 then
+        -- Player attack
+        handle_player_attack(state, dispatcher, sender, data)
+
+    elseif op_code == 3 then
+        -- Direct monster damage (validated server-side)
+        handle_monster_damage(state, dispatcher, sender, data)
+
+    elseif op_code == 5 then
+        -- Player death
+        handle_player_death(state, dispatcher, sender, data)
+
+    elseif op_code == 10 then
+        -- Chat message (relay to all; batched messages were decoded, re-encode them)
+        dispatcher.broadcast_message(10, raw or nk.json_encode(data))
+
+    elseif op_code == 12 then
+        -- Player interact
+        handle_interact(state, dispatcher, sender, data)
+
+    elseif op_code == 16 then
+        -- Leaving for good: don't hold the slot when the socket closes
+        local player = state.players[sender.user_id]
+        if player then
+            player.leaving = true
+        end
+    end
+end
+
 function update_breath(state)
     -- Breath of Tower cycle: 4 phases
     -- Inhale (0-300s), Hold (300-420s), Exhale (420-600s), Pause (600-720s)
@@ -301,6 +438,14 @@ function handle_position_update(state, sender, data)
     local player = state.players[sender.user_id]
     if not player then return end
 
+    -- Compact form: p = whole-centimetre [x, y, z], r = yaw in 1/65536 turns
+    if data.p then
+        data.position = { x = data.p[1], y = data.p[2], z = data.p[3] }
+        if data.r then
+            player.yaw = data.r * 360 / 65536
+        end
+    end
+
     -- Anti-cheat: validate movement speed
     if data.position then
         local dx = data.position.x - player.position.x
@@ -218,6 +218,21 @@ impl AchievementTracker {
         }
     }
 
+    /// Mark the exploration achievements for reaching a floor that `current_floor`
+    /// has reached; floor gates of other categories need their event as well
+    pub fn reach_floor(&mut self, current_floor: u32) {
+        for ach in &mut self.achievements {
+            if ach.category != AchievementCategory::Exploration {
+                continue;
+            }
+            if let AchievementCondition::FloorGated { min_floor, met } = &mut ach.condition {
+                if current_floor >= *min_floor {
+                    *met = true;
+                }
+            }
+        }
+    }
+
     /// Check all achievements and return newly unlocked ones
     pub fn check_all(&mut self, timestamp: u64) -> Vec<Achievement> {
         let mut newly_unlocked = Vec::new();
@@ -596,6 +611,17 @@ mod tests {
         assert!(unlocked.iter().any(|a| a.id == "explore_floor_10"));
     }
 
+    #[test]
+    fn test_reach_floor_only_exploration() {
+        let mut tracker = AchievementTracker::new();
+        tracker.reach_floor(60);
+        let unlocked = tracker.check_all(1000);
+        assert!(unlocked.iter().any(|a| a.id == "explore_floor_10"));
+        assert!(unlocked.iter().any(|a| a.id == "explore_floor_50"));
+        assert!(unlocked.iter().all(|a| a.id != "explore_floor_100"));
+        assert!(unlocked.iter().all(|a| a.id != "survival_corruption_surge"));
+    }
+
     #[test]
     fn test_composite_achievement() {
         let mut tracker = AchievementTracker::new();
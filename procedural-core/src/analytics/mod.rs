@@ -16,6 +16,7 @@
 use bevy::prelude::*;
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
+use std::sync::atomic::{AtomicU64, Ordering};
 
 pub struct AnalyticsPlugin;
 
@@ -323,6 +324,113 @@ impl AnalyticsSnapshot {
     }
 }
 
+/// Layout version of `AnalyticsCounters`; bumped whenever its fields change
+pub const ANALYTICS_COUNTERS_VERSION: u32 = 1;
+
+/// Running totals kept process-wide for the C-ABI record calls, readable by
+/// pointer (`analytics_get_counters`) without a call or any JSON. Every field
+/// after the header is a u64 written with relaxed atomics, so a reader sees
+/// each total whole but not the set as of one instant.
+///
+/// The layout is fixed: fields are only ever appended, with `version` bumped
+/// and `size` grown, so a client built against an older layout still reads
+/// the prefix it knows.
+#[repr(C)]
+pub struct AnalyticsCounters {
+    pub version: u32,
+    /// `size_of::<AnalyticsCounters>()`
+    pub size: u32,
+    pub damage_hits: AtomicU64,
+    pub total_damage_dealt: AtomicU64,
+    pub max_hit: AtomicU64,
+    pub floors_cleared: AtomicU64,
+    pub highest_floor: AtomicU64,
+    /// Sum of the clear times, in milliseconds
+    pub floor_clear_millis: AtomicU64,
+    pub gold_earned: AtomicU64,
+    pub gold_spent: AtomicU64,
+}
+
+impl AnalyticsCounters {
+    pub const fn new() -> Self {
+        Self {
+            version: ANALYTICS_COUNTERS_VERSION,
+            size: std::mem::size_of::<Self>() as u32,
+            damage_hits: AtomicU64::new(0),
+            total_damage_dealt: AtomicU64::new(0),
+            max_hit: AtomicU64::new(0),
+            floors_cleared: AtomicU64::new(0),
+            highest_floor: AtomicU64::new(0),
+            floor_clear_millis: AtomicU64::new(0),
+            gold_earned: AtomicU64::new(0),
+            gold_spent: AtomicU64::new(0),
+        }
+    }
+
+    pub fn record_damage(&self, hits: u64, total: u64, max_hit: u64) {
+        self.damage_hits.fetch_add(hits, Ordering::Relaxed);
+        self.total_damage_dealt.fetch_add(total, Ordering::Relaxed);
+        self.max_hit.fetch_max(max_hit, Ordering::Relaxed);
+    }
+
+    pub fn record_floor_cleared(&self, floor_id: u32, time_secs: f32) {
+        self.floors_cleared.fetch_add(1, Ordering::Relaxed);
+        self.highest_floor
+            .fetch_max(floor_id as u64, Ordering::Relaxed);
+        self.floor_clear_millis
+            .fetch_add((time_secs.max(0.0) * 1000.0) as u64, Ordering::Relaxed);
+    }
+
+    pub fn record_gold(&self, amount: u64, earned: bool) {
+        let total = if earned {
+            &self.gold_earned
+        } else {
+            &self.gold_spent
+        };
+        total.fetch_add(amount, Ordering::Relaxed);
+    }
+
+    pub fn reset(&self) {
+        for counter in [
+            &self.damage_hits,
+            &self.total_damage_dealt,
+            &self.max_hit,
+            &self.floors_cleared,
+            &self.highest_floor,
+            &self.floor_clear_millis,
+            &self.gold_earned,
+            &self.gold_spent,
+        ] {
+            counter.store(0, Ordering::Relaxed);
+        }
+    }
+
+    /// Copy the totals into the matching fields of an export snapshot
+    pub fn fill_snapshot(&self, snapshot: &mut AnalyticsSnapshot) {
+        snapshot.combat.total_damage_dealt = self.total_damage_dealt.load(Ordering::Relaxed);
+        let floors_cleared = self.floors_cleared.load(Ordering::Relaxed);
+        snapshot.progression.floors_cleared = floors_cleared as u32;
+        snapshot.progression.highest_floor = self.highest_floor.load(Ordering::Relaxed) as u32;
+        if floors_cleared > 0 {
+            snapshot.progression.average_floor_clear_time =
+                self.floor_clear_millis.load(Ordering::Relaxed) as f64
+                    / 1000.0
+                    / floors_cleared as f64;
+        }
+        snapshot.economy.gold_earned = self.gold_earned.load(Ordering::Relaxed);
+        snapshot.economy.gold_spent = self.gold_spent.load(Ordering::Relaxed);
+    }
+}
+
+impl Default for AnalyticsCounters {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// The counters behind the analytics C-ABI
+pub static COUNTERS: AnalyticsCounters = AnalyticsCounters::new();
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -559,4 +667,39 @@ mod tests {
         assert_eq!(collector.progression_stats.floors_by_tier.get(&2), Some(&1));
         assert_eq!(collector.progression_stats.floors_by_tier.get(&3), Some(&1));
     }
+
+    #[test]
+    fn test_counters_layout() {
+        let counters = AnalyticsCounters::new();
+        assert_eq!(counters.version, ANALYTICS_COUNTERS_VERSION);
+        assert_eq!(counters.size, 72);
+        assert_eq!(std::mem::align_of::<AnalyticsCounters>(), 8);
+    }
+
+    #[test]
+    fn test_counters_record_and_snapshot() {
+        let counters = AnalyticsCounters::new();
+        counters.record_damage(3, 300, 150);
+        counters.record_damage(1, 90, 90);
+        counters.record_floor_cleared(4, 120.0);
+        counters.record_floor_cleared(2, 60.0);
+        counters.record_gold(500, true);
+        counters.record_gold(200, false);
+
+        assert_eq!(counters.damage_hits.load(Ordering::Relaxed), 4);
+        assert_eq!(counters.max_hit.load(Ordering::Relaxed), 150);
+
+        let mut snapshot = AnalyticsSnapshot::capture(&AnalyticsCollector::default());
+        counters.fill_snapshot(&mut snapshot);
+        assert_eq!(snapshot.combat.total_damage_dealt, 390);
+        assert_eq!(snapshot.progression.floors_cleared, 2);
+        assert_eq!(snapshot.progression.highest_floor, 4);
+        assert!((snapshot.progression.average_floor_clear_time - 90.0).abs() < 0.01);
+        assert_eq!(snapshot.economy.gold_earned, 500);
+        assert_eq!(snapshot.economy.gold_spent, 200);
+
+        counters.reset();
+        assert_eq!(counters.total_damage_dealt.load(Ordering::Relaxed), 0);
+        assert_eq!(counters.version, ANALYTICS_COUNTERS_VERSION);
+    }
 }
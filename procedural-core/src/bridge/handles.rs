@@ -0,0 +1,135 @@
+//! Resident profile storage behind opaque FFI handles.
+//!
+//! A handle packs a slot index (low 32 bits) and the slot's generation (high
+//! 32 bits), so a released handle never aliases a later profile in the same
+//! slot. 0 is never a valid handle.
+
+use std::sync::{Mutex, MutexGuard};
+
+struct Slot<T> {
+    generation: u32,
+    value: Option<T>,
+}
+
+/// Generational slot map of profiles owned by the Rust side
+pub struct HandleStore<T> {
+    slots: Vec<Slot<T>>,
+    free: Vec<u32>,
+}
+
+impl<T> HandleStore<T> {
+    pub const fn new() -> Self {
+        Self {
+            slots: Vec::new(),
+            free: Vec::new(),
+        }
+    }
+
+    /// Take ownership of `value`, returning its handle
+    pub fn insert(&mut self, value: T) -> u64 {
+        let index = match self.free.pop() {
+            Some(index) => index,
+            None => {
+                self.slots.push(Slot {
+                    generation: 0,
+                    value: None,
+                });
+                (self.slots.len() - 1) as u32
+            }
+        };
+
+        let slot = &mut self.slots[index as usize];
+        // Generations start at 1 so no handle is 0
+        slot.generation = slot.generation.wrapping_add(1).max(1);
+        slot.value = Some(value);
+        ((slot.generation as u64) << 32) | index as u64
+    }
+
+    fn slot_index(&self, handle: u64) -> Option<usize> {
+        let index = (handle & 0xFFFF_FFFF) as usize;
+        let generation = (handle >> 32) as u32;
+        match self.slots.get(index) {
+            Some(slot) if slot.generation == generation && slot.value.is_some() => Some(index),
+            _ => None,
+        }
+    }
+
+    pub fn get(&self, handle: u64) -> Option<&T> {
+        self.slot_index(handle)
+            .and_then(|i| self.slots[i].value.as_ref())
+    }
+
+    pub fn get_mut(&mut self, handle: u64) -> Option<&mut T> {
+        self.slot_index(handle)
+            .and_then(move |i| self.slots[i].value.as_mut())
+    }
+
+    /// Drop the profile; false if the handle was already stale
+    pub fn remove(&mut self, handle: u64) -> bool {
+        match self.slot_index(handle) {
+            Some(i) => {
+                self.slots[i].value = None;
+                self.free.push(i as u32);
+                true
+            }
+            None => false,
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        self.slots.len() - self.free.len()
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+}
+
+impl<T> Default for HandleStore<T> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+/// Lock a store, recovering from a panic in an earlier holder (profiles stay usable)
+pub fn lock<T>(store: &Mutex<HandleStore<T>>) -> MutexGuard<'_, HandleStore<T>> {
+    store
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_handle_store_insert_get_remove() {
+        let mut store = HandleStore::new();
+        let a = store.insert(1);
+        let b = store.insert(2);
+        assert_ne!(a, 0);
+        assert_ne!(a, b);
+        assert_eq!(store.get(a), Some(&1));
+
+        *store.get_mut(b).unwrap() = 20;
+        assert_eq!(store.get(b), Some(&20));
+
+        assert!(store.remove(a));
+        assert!(!store.remove(a));
+        assert_eq!(store.get(a), None);
+        assert_eq!(store.len(), 1);
+    }
+
+    #[test]
+    fn test_handle_store_stale_handle_after_reuse() {
+        let mut store = HandleStore::new();
+        let old = store.insert("old");
+        store.remove(old);
+        let new = store.insert("new");
+
+        // Same slot, different generation
+        assert_eq!(old & 0xFFFF_FFFF, new & 0xFFFF_FFFF);
+        assert_eq!(store.get(old), None);
+        assert_eq!(store.get(new), Some(&"new"));
+    }
+}
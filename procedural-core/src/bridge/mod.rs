@@ -5,13 +5,14 @@
 //! All *_json functions return heap-allocated strings — caller must free with `free_string`.
 
 use serde::{Deserialize, Serialize};
+use std::collections::HashMap;
 use std::ffi::{CStr, CString};
 use std::os::raw::c_char;
 
 use crate::combat::AttackAngle;
 use crate::constants::*;
 use crate::events::{self, EventTriggerType, TriggerContext};
-use crate::generation::wfc::TileType;
+use crate::generation::wfc::{RoomType, TileType};
 use crate::generation::{FloorSpec, FloorTier, TowerSeed};
 use crate::loot;
 use crate::monster::MonsterTemplate;
@@ -22,7 +23,9 @@ use crate::semantic::SemanticTags;
 use crate::abilities::{default_abilities, AbilityLoadout};
 use crate::achievements::AchievementTracker;
 use crate::cosmetics::{tower_cosmetics, tower_dyes, CosmeticProfile, CosmeticSlot, DyeChannel};
-use crate::mastery::{xp_for_action, MasteryDomain, MasteryProfile, MasteryTier};
+use crate::mastery::{
+    xp_for_action, MasteryDomain, MasteryProfile, MasteryTier, ACTION_XP, DEFAULT_ACTION_XP,
+};
 use crate::seasons::{
     generate_daily_quests, generate_season_rewards, generate_weekly_quests, SeasonPass,
 };
@@ -50,6 +53,10 @@ use crate::towermap;
 use crate::analytics;
 use crate::hotreload;
 
+mod handles;
+use handles::HandleStore;
+use std::sync::Mutex;
+
 // ========================
 // Data transfer types
 // ========================
@@ -122,6 +129,14 @@ pub struct LootInfo {
     pub semantic_tags: Vec<(String, f32)>,
 }
 
+/// Item catalog entry for UE5 (loot::ItemDefinition, category by name)
+#[derive(Debug, Serialize, Deserialize)]
+pub struct ItemCatalogEntry {
+    pub name: String,
+    pub category: String,
+    pub tags: Vec<(String, f32)>,
+}
+
 /// Combat calculation request
 #[derive(Debug, Serialize, Deserialize)]
 pub struct CombatCalcRequest {
@@ -151,6 +166,23 @@ pub struct BreathState {
     pub semantic_intensity: f32,
 }
 
+/// One phase of the Breath of Tower cycle, as `breath_state` evaluates it
+#[derive(Debug, Serialize, Deserialize)]
+pub struct BreathPhaseDef {
+    pub phase: String,
+    pub duration_secs: f32,
+    pub monster_spawn_mult: f32,
+    pub resource_mult: f32,
+    pub semantic_intensity: f32,
+}
+
+/// The whole Breath of Tower cycle, phases in order from cycle start
+#[derive(Debug, Serialize, Deserialize)]
+pub struct BreathCycle {
+    pub phases: Vec<BreathPhaseDef>,
+    pub total_secs: f32,
+}
+
 // ========================
 // Helper: safe JSON return
 // ========================
@@ -162,6 +194,44 @@ fn json_to_cstring<T: Serialize>(value: &T) -> *mut c_char {
     }
 }
 
+/// Counts every byte it is given but only stores those that fit
+struct BoundedWriter<'a> {
+    out: &'a mut [u8],
+    len: usize,
+}
+
+impl std::io::Write for BoundedWriter<'_> {
+    fn write(&mut self, bytes: &[u8]) -> std::io::Result<usize> {
+        if let Some(room) = self.out.get_mut(self.len..) {
+            let n = room.len().min(bytes.len());
+            room[..n].copy_from_slice(&bytes[..n]);
+        }
+        self.len += bytes.len();
+        Ok(bytes.len())
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        Ok(())
+    }
+}
+
+/// Serialize `value` as JSON into a caller-provided buffer (UTF-8, no terminator).
+///
+/// Returns the JSON length; the buffer holds the full JSON only if that is at most
+/// `out_capacity`, otherwise the caller grows it and calls again. 0 on failure.
+fn json_into_buffer<T: Serialize>(value: &T, out_buf: *mut u8, out_capacity: usize) -> usize {
+    let out: &mut [u8] = if out_buf.is_null() || out_capacity == 0 {
+        &mut []
+    } else {
+        unsafe { std::slice::from_raw_parts_mut(out_buf, out_capacity) }
+    };
+    let mut writer = BoundedWriter { out, len: 0 };
+    match serde_json::to_writer(&mut writer, value) {
+        Ok(()) => writer.len,
+        Err(_) => 0,
+    }
+}
+
 fn parse_cstr(ptr: *const c_char) -> Option<String> {
     if ptr.is_null() {
         return None;
@@ -241,6 +311,91 @@ pub extern "C" fn generate_floor_layout(seed: u64, floor_id: u32) -> *mut c_char
     json_to_cstring(&response)
 }
 
+/// `generate_floor_layout_binary` format tag: "TFL" + format version 1, little-endian
+pub const FLOOR_LAYOUT_BINARY_MAGIC: u32 = 0x314C_4654;
+
+const FLOOR_LAYOUT_HEADER_SIZE: usize = 16;
+const FLOOR_LAYOUT_ROOM_SIZE: usize = 10;
+const FLOOR_LAYOUT_POINT_SIZE: usize = 4;
+
+/// Generate the full floor layout into a caller-provided buffer, packed.
+///
+/// Layout (integers little-endian):
+///   header  u32 magic, u16 width, u16 height, u16 room_count, u16 spawn_count, u16 exit_x, u16 exit_y
+///   rooms   room_count x (u16 x, u16 y, u16 width, u16 height, u8 room_type, u8 reserved)
+///   spawns  spawn_count x (u16 x, u16 y)
+///   tiles   width * height x u8 (TileType as in generate_floor_layout), row-major: tiles[y * width + x]
+///
+/// Returns the size the layout needs. Nothing is written unless `out_capacity`
+/// is at least that, so a caller with a small buffer grows it and calls again.
+/// Returns 0 if the layout doesn't fit the format.
+#[no_mangle]
+#[allow(clippy::not_unsafe_ptr_arg_deref)]
+pub extern "C" fn generate_floor_layout_binary(
+    seed: u64,
+    floor_id: u32,
+    out_buf: *mut u8,
+    out_capacity: usize,
+) -> usize {
+    let tower_seed = TowerSeed { seed };
+    let spec = FloorSpec::generate(&tower_seed, floor_id);
+    let layout = crate::generation::wfc::generate_layout(&spec);
+
+    let fits_u16 = |v: usize| v <= u16::MAX as usize;
+    if !fits_u16(layout.width)
+        || !fits_u16(layout.height)
+        || !fits_u16(layout.rooms.len())
+        || !fits_u16(layout.spawn_points.len())
+    {
+        return 0;
+    }
+
+    let required = FLOOR_LAYOUT_HEADER_SIZE
+        + layout.rooms.len() * FLOOR_LAYOUT_ROOM_SIZE
+        + layout.spawn_points.len() * FLOOR_LAYOUT_POINT_SIZE
+        + layout.width * layout.height;
+    if out_buf.is_null() || out_capacity < required {
+        return required;
+    }
+
+    let out = unsafe { std::slice::from_raw_parts_mut(out_buf, required) };
+    let mut pos = 0;
+    let mut put = |bytes: &[u8]| {
+        out[pos..pos + bytes.len()].copy_from_slice(bytes);
+        pos += bytes.len();
+    };
+    let u16_le = |v: usize| (v as u16).to_le_bytes();
+
+    put(&FLOOR_LAYOUT_BINARY_MAGIC.to_le_bytes());
+    put(&u16_le(layout.width));
+    put(&u16_le(layout.height));
+    put(&u16_le(layout.rooms.len()));
+    put(&u16_le(layout.spawn_points.len()));
+    put(&u16_le(layout.exit_point.0));
+    put(&u16_le(layout.exit_point.1));
+
+    for room in &layout.rooms {
+        put(&u16_le(room.x));
+        put(&u16_le(room.y));
+        put(&u16_le(room.width));
+        put(&u16_le(room.height));
+        put(&[room_type_to_u8(room.room_type), 0]);
+    }
+
+    for &(x, y) in &layout.spawn_points {
+        put(&u16_le(x));
+        put(&u16_le(y));
+    }
+
+    for row in &layout.tiles {
+        for tile in row.iter().take(layout.width) {
+            put(&[tile_to_u8(tile)]);
+        }
+    }
+
+    required
+}
+
 /// Get deterministic floor hash
 #[no_mangle]
 pub extern "C" fn get_floor_hash(seed: u64, floor_id: u32) -> u64 {
@@ -291,6 +446,26 @@ pub extern "C" fn generate_monster(hash: u64, floor_level: u32) -> *mut c_char {
 /// Generate multiple monsters for a floor, return JSON array
 #[no_mangle]
 pub extern "C" fn generate_floor_monsters(seed: u64, floor_id: u32, count: u32) -> *mut c_char {
+    json_to_cstring(&floor_monsters(seed, floor_id, count))
+}
+
+/// `generate_floor_monsters` into a caller buffer; see `json_into_buffer`
+#[no_mangle]
+pub extern "C" fn generate_floor_monsters_into(
+    seed: u64,
+    floor_id: u32,
+    count: u32,
+    out_buf: *mut u8,
+    out_capacity: usize,
+) -> usize {
+    json_into_buffer(
+        &floor_monsters(seed, floor_id, count),
+        out_buf,
+        out_capacity,
+    )
+}
+
+fn floor_monsters(seed: u64, floor_id: u32, count: u32) -> Vec<MonsterInfo> {
     let tower_seed = TowerSeed { seed };
     let base_hash = tower_seed.floor_hash(floor_id);
     let mut monsters = Vec::new();
@@ -318,7 +493,7 @@ pub extern "C" fn generate_floor_monsters(seed: u64, floor_id: u32, count: u32)
         });
     }
 
-    json_to_cstring(&monsters)
+    monsters
 }
 
 // ========================
@@ -336,25 +511,59 @@ pub extern "C" fn get_angle_multiplier(angle_id: u32) -> f32 {
     }
 }
 
+/// Damage for one hit given the two sides' tag similarity (shared by the single and batch calls)
+fn resolve_combat(
+    base_damage: f32,
+    angle_id: u32,
+    combo_step: u32,
+    similarity: f32,
+) -> CombatCalcResult {
+    let angle_mult = get_angle_multiplier(angle_id);
+
+    let semantic_bonus = if similarity > SEMANTIC_HIGH_THRESHOLD {
+        SEMANTIC_SYNERGY_BONUS
+    } else if similarity < SEMANTIC_LOW_THRESHOLD {
+        SEMANTIC_CONFLICT_PENALTY
+    } else {
+        0.0
+    };
+
+    let combo_mult = 1.0 + combo_step as f32 * COMBO_STEP_MULT;
+    let final_damage = base_damage * angle_mult * combo_mult * (1.0 + semantic_bonus);
+
+    CombatCalcResult {
+        final_damage,
+        angle_multiplier: angle_mult,
+        semantic_bonus,
+        is_synergy: similarity > SEMANTIC_HIGH_THRESHOLD,
+    }
+}
+
 /// Calculate combat damage with semantic bonuses
 #[no_mangle]
 pub extern "C" fn calculate_combat(request_json: *const c_char) -> *mut c_char {
-    let json_str = match parse_cstr(request_json) {
-        Some(s) => s,
-        None => return std::ptr::null_mut(),
-    };
+    match combat_from_json(request_json) {
+        Some(result) => json_to_cstring(&result),
+        None => std::ptr::null_mut(),
+    }
+}
 
-    let request: CombatCalcRequest = match serde_json::from_str(&json_str) {
-        Ok(r) => r,
-        Err(_) => return std::ptr::null_mut(),
-    };
+/// `calculate_combat` into a caller buffer; see `json_into_buffer` (0 for a bad request)
+#[no_mangle]
+pub extern "C" fn calculate_combat_into(
+    request_json: *const c_char,
+    out_buf: *mut u8,
+    out_capacity: usize,
+) -> usize {
+    match combat_from_json(request_json) {
+        Some(result) => json_into_buffer(&result, out_buf, out_capacity),
+        None => 0,
+    }
+}
 
-    let angle_mult = match request.angle_id {
-        0 => AttackAngle::Front.multiplier(),
-        1 => AttackAngle::Side.multiplier(),
-        2 => AttackAngle::Back.multiplier(),
-        _ => 1.0,
-    };
+fn combat_from_json(request_json: *const c_char) -> Option<CombatCalcResult> {
+    let json_str = parse_cstr(request_json)?;
+    let request: CombatCalcRequest = serde_json::from_str(&json_str).ok()?;
 
     // Semantic bonus from tag similarity
     let attacker_tags: Vec<(String, f32)> =
@@ -370,25 +579,106 @@ pub extern "C" fn calculate_combat(request_json: *const c_char) -> *mut c_char {
     };
     let similarity = sem_a.similarity(&sem_b);
 
-    let semantic_bonus = if similarity > SEMANTIC_HIGH_THRESHOLD {
-        SEMANTIC_SYNERGY_BONUS
-    } else if similarity < SEMANTIC_LOW_THRESHOLD {
-        SEMANTIC_CONFLICT_PENALTY
-    } else {
-        0.0
-    };
+    Some(resolve_combat(
+        request.base_damage,
+        request.angle_id,
+        request.combo_step,
+        similarity,
+    ))
+}
 
-    let combo_mult = 1.0 + request.combo_step as f32 * COMBO_STEP_MULT;
-    let final_damage = request.base_damage * angle_mult * combo_mult * (1.0 + semantic_bonus);
+/// `CombatBatchRequest` tag set index meaning "no tags" (similarity 0)
+pub const COMBAT_BATCH_NO_TAGS: u32 = u32::MAX;
 
-    let result = CombatCalcResult {
-        final_damage,
-        angle_multiplier: angle_mult,
-        semantic_bonus,
-        is_synergy: similarity > SEMANTIC_HIGH_THRESHOLD,
+/// One hit of `calculate_combat_batch`. Tags are indices into the batch's tag set
+/// table, so an AoE sends the attacker's tags once instead of once per target.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct CombatBatchRequest {
+    pub base_damage: f32,
+    pub angle_id: u32, // 0=Front, 1=Side, 2=Back
+    pub combo_step: u32,
+    pub attacker_tag_set: u32,
+    pub defender_tag_set: u32,
+}
+
+/// `calculate_combat_batch` output, one per request, in request order
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default)]
+pub struct CombatBatchResult {
+    pub final_damage: f32,
+    pub angle_multiplier: f32,
+    pub semantic_bonus: f32,
+    pub is_synergy: u8,
+    pub reserved: [u8; 3],
+}
+
+/// Parse a batch tag set table (JSON array of tag arrays); null is an empty table
+fn parse_tag_sets(tag_sets_json: *const c_char) -> Option<Vec<SemanticTags>> {
+    if tag_sets_json.is_null() {
+        return Some(Vec::new());
+    }
+    let json_str = parse_cstr(tag_sets_json)?;
+    serde_json::from_str::<Vec<Vec<(String, f32)>>>(&json_str)
+        .ok()
+        .map(|sets| sets.into_iter().map(|tags| SemanticTags { tags }).collect())
+}
+
+/// Resolve many hits in one call.
+///
+/// `tag_sets_json` is a JSON array of tag arrays (`[[["fire", 0.8]], [["water", 0.9]]]`),
+/// may be null when no request references a tag set. Similarity is computed once
+/// per distinct (attacker, defender) pair in the batch.
+///
+/// Writes `count` results to `out_results` and returns `count`; returns 0 and
+/// writes nothing if a pointer is null or the tag table doesn't parse. An
+/// out-of-range tag set index is treated as no tags.
+#[no_mangle]
+#[allow(clippy::not_unsafe_ptr_arg_deref)]
+pub extern "C" fn calculate_combat_batch(
+    tag_sets_json: *const c_char,
+    requests: *const CombatBatchRequest,
+    count: u32,
+    out_results: *mut CombatBatchResult,
+) -> u32 {
+    if count == 0 || requests.is_null() || out_results.is_null() {
+        return 0;
+    }
+
+    let tag_sets = match parse_tag_sets(tag_sets_json) {
+        Some(sets) => sets,
+        None => return 0,
     };
 
-    json_to_cstring(&result)
+    let requests = unsafe { std::slice::from_raw_parts(requests, count as usize) };
+    let out = unsafe { std::slice::from_raw_parts_mut(out_results, count as usize) };
+
+    let mut similarities: HashMap<(u32, u32), f32> = HashMap::new();
+    for (request, result) in requests.iter().zip(out.iter_mut()) {
+        let pair = (request.attacker_tag_set, request.defender_tag_set);
+        let similarity = *similarities.entry(pair).or_insert_with(|| {
+            match (tag_sets.get(pair.0 as usize), tag_sets.get(pair.1 as usize)) {
+                (Some(a), Some(b)) => a.similarity(b),
+                _ => 0.0,
+            }
+        });
+
+        let resolved = resolve_combat(
+            request.base_damage,
+            request.angle_id,
+            request.combo_step,
+            similarity,
+        );
+        *result = CombatBatchResult {
+            final_damage: resolved.final_damage,
+            angle_multiplier: resolved.angle_multiplier,
+            semantic_bonus: resolved.semantic_bonus,
+            is_synergy: resolved.is_synergy as u8,
+            reserved: [0; 3],
+        };
+    }
+
+    count
 }
 
 // ========================
@@ -452,6 +742,161 @@ pub extern "C" fn generate_loot(
     json_to_cstring(&loot_infos)
 }
 
+/// Every item `generate_loot` can drop, as a JSON array of ItemCatalogEntry.
+/// The order is stable for a core version; clients index items by position.
+#[no_mangle]
+pub extern "C" fn get_item_catalog() -> *mut c_char {
+    let entries: Vec<ItemCatalogEntry> = loot::item_catalog()
+        .into_iter()
+        .map(|definition| ItemCatalogEntry {
+            name: definition.name,
+            category: format!("{:?}", definition.category),
+            tags: definition.tags,
+        })
+        .collect();
+
+    json_to_cstring(&entries)
+}
+
+/// `generate_loot_batch` format tag: "TLB" + format version 1, little-endian
+pub const LOOT_BATCH_BINARY_MAGIC: u32 = 0x3142_4C54;
+
+const LOOT_BATCH_HEADER_SIZE: usize = 12;
+const LOOT_BATCH_RECORD_SIZE: usize = 24;
+
+/// One drop source (dead monster, opened chest) of `generate_loot_batch`
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct LootBatchSource {
+    /// Index into the batch's tag set table; out of range means no tags
+    pub tag_set: u32,
+    pub floor_level: u32,
+    pub drop_hash: u64,
+}
+
+fn loot_category_to_u8(category: loot::LootCategory) -> u8 {
+    match category {
+        loot::LootCategory::CombatResource => 0,
+        loot::LootCategory::Material => 1,
+        loot::LootCategory::Consumable => 2,
+        loot::LootCategory::Equipment => 3,
+        loot::LootCategory::Currency => 4,
+        loot::LootCategory::EchoFragment => 5,
+    }
+}
+
+fn item_rarity_to_u8(rarity: crate::economy::ItemRarity) -> u8 {
+    use crate::economy::ItemRarity;
+    match rarity {
+        ItemRarity::Common => 0,
+        ItemRarity::Uncommon => 1,
+        ItemRarity::Rare => 2,
+        ItemRarity::Epic => 3,
+        ItemRarity::Legendary => 4,
+        ItemRarity::Mythic => 5,
+    }
+}
+
+/// Generate the drops of many sources in one call, packed into a caller-provided buffer.
+///
+/// `tag_sets_json` is a tag set table as for `calculate_combat_batch` (may be null).
+///
+/// Layout (integers little-endian):
+///   header   u32 magic, u32 record_count, u32 strings_size
+///   records  record_count x (u32 source_index, u32 quantity, u32 name_offset, u32 tags_offset,
+///            u16 name_len, u16 tags_len, u8 category, u8 rarity, u16 reserved)
+///   strings  strings_size bytes of UTF-8, offsets relative to the start of this block
+///
+/// Records come in source order, each source's drops as `generate_loot` returns them.
+/// A record's tags are the item's semantic tags as JSON. Names and tags shared by several
+/// drops are stored once. category and rarity count LootCategory / ItemRarity variants
+/// in declaration order.
+///
+/// Returns the size the batch needs. Nothing is written unless `out_capacity` is at
+/// least that, so a caller with a small buffer grows it and calls again. Returns 0 if a
+/// pointer is null, the tag table doesn't parse, or a string is too long for the format.
+#[no_mangle]
+#[allow(clippy::not_unsafe_ptr_arg_deref)]
+pub extern "C" fn generate_loot_batch(
+    tag_sets_json: *const c_char,
+    sources: *const LootBatchSource,
+    count: u32,
+    out_buf: *mut u8,
+    out_capacity: usize,
+) -> usize {
+    if count > 0 && sources.is_null() {
+        return 0;
+    }
+    let tag_sets = match parse_tag_sets(tag_sets_json) {
+        Some(sets) => sets,
+        None => return 0,
+    };
+    let sources: &[LootBatchSource] = if count == 0 {
+        &[]
+    } else {
+        unsafe { std::slice::from_raw_parts(sources, count as usize) }
+    };
+
+    let no_tags = SemanticTags { tags: Vec::new() };
+    let mut strings: Vec<u8> = Vec::new();
+    let mut interned: HashMap<String, (u32, u16)> = HashMap::new();
+    let mut intern = |text: String, strings: &mut Vec<u8>| -> Option<(u32, u16)> {
+        if let Some(found) = interned.get(&text) {
+            return Some(*found);
+        }
+        let offset = u32::try_from(strings.len()).ok()?;
+        let len = u16::try_from(text.len()).ok()?;
+        strings.extend_from_slice(text.as_bytes());
+        interned.insert(text, (offset, len));
+        Some((offset, len))
+    };
+
+    let mut records: Vec<[u8; LOOT_BATCH_RECORD_SIZE]> = Vec::new();
+    for (source_index, source) in sources.iter().enumerate() {
+        let source_tags = tag_sets.get(source.tag_set as usize).unwrap_or(&no_tags);
+        for item in loot::generate_loot(source_tags, source.floor_level, source.drop_hash) {
+            let tags_json = serde_json::to_string(&item.semantic_tags).unwrap_or_default();
+            let (name_offset, name_len) = match intern(item.name, &mut strings) {
+                Some(entry) => entry,
+                None => return 0,
+            };
+            let (tags_offset, tags_len) = match intern(tags_json, &mut strings) {
+                Some(entry) => entry,
+                None => return 0,
+            };
+
+            let mut record = [0u8; LOOT_BATCH_RECORD_SIZE];
+            record[0..4].copy_from_slice(&(source_index as u32).to_le_bytes());
+            record[4..8].copy_from_slice(&item.quantity.to_le_bytes());
+            record[8..12].copy_from_slice(&name_offset.to_le_bytes());
+            record[12..16].copy_from_slice(&tags_offset.to_le_bytes());
+            record[16..18].copy_from_slice(&name_len.to_le_bytes());
+            record[18..20].copy_from_slice(&tags_len.to_le_bytes());
+            record[20] = loot_category_to_u8(item.category);
+            record[21] = item_rarity_to_u8(item.rarity);
+            records.push(record);
+        }
+    }
+
+    let required = LOOT_BATCH_HEADER_SIZE + records.len() * LOOT_BATCH_RECORD_SIZE + strings.len();
+    if out_buf.is_null() || out_capacity < required {
+        return required;
+    }
+
+    let out = unsafe { std::slice::from_raw_parts_mut(out_buf, required) };
+    out[0..4].copy_from_slice(&LOOT_BATCH_BINARY_MAGIC.to_le_bytes());
+    out[4..8].copy_from_slice(&(records.len() as u32).to_le_bytes());
+    out[8..12].copy_from_slice(&(strings.len() as u32).to_le_bytes());
+    let mut pos = LOOT_BATCH_HEADER_SIZE;
+    for record in &records {
+        out[pos..pos + LOOT_BATCH_RECORD_SIZE].copy_from_slice(record);
+        pos += LOOT_BATCH_RECORD_SIZE;
+    }
+    out[pos..].copy_from_slice(&strings);
+
+    required
+}
+
 // ========================
 // C-ABI: World
 // ========================
@@ -459,6 +904,53 @@ pub extern "C" fn generate_loot(
 /// Get current Breath of Tower phase based on elapsed seconds
 #[no_mangle]
 pub extern "C" fn get_breath_state(elapsed_seconds: f32) -> *mut c_char {
+    json_to_cstring(&breath_state(elapsed_seconds))
+}
+
+/// `get_breath_state` into a caller buffer; see `json_into_buffer`
+#[no_mangle]
+pub extern "C" fn get_breath_state_into(
+    elapsed_seconds: f32,
+    out_buf: *mut u8,
+    out_capacity: usize,
+) -> usize {
+    json_into_buffer(&breath_state(elapsed_seconds), out_buf, out_capacity)
+}
+
+/// The breath cycle definition, so a client can evaluate `get_breath_state`
+/// locally: phase is the one whose span holds `elapsed % total_secs`, and
+/// phase_progress the fraction of that span elapsed.
+#[no_mangle]
+pub extern "C" fn get_breath_cycle() -> *mut c_char {
+    json_to_cstring(&breath_cycle())
+}
+
+fn breath_cycle() -> BreathCycle {
+    use crate::world::BreathPhase;
+
+    let phases = [
+        (BreathPhase::Inhale, BREATH_INHALE_SECS),
+        (BreathPhase::Hold, BREATH_HOLD_SECS),
+        (BreathPhase::Exhale, BREATH_EXHALE_SECS),
+        (BreathPhase::Pause, BREATH_PAUSE_SECS),
+    ];
+
+    BreathCycle {
+        phases: phases
+            .iter()
+            .map(|(phase, duration_secs)| BreathPhaseDef {
+                phase: format!("{:?}", phase),
+                duration_secs: *duration_secs,
+                monster_spawn_mult: phase.monster_spawn_multiplier(),
+                resource_mult: phase.resource_multiplier(),
+                semantic_intensity: phase.semantic_intensity(),
+            })
+            .collect(),
+        total_secs: BREATH_CYCLE_TOTAL,
+    }
+}
+
+fn breath_state(elapsed_seconds: f32) -> BreathState {
     use crate::world::BreathPhase;
 
     let cycle_pos = elapsed_seconds % BREATH_CYCLE_TOTAL;
@@ -486,15 +978,13 @@ pub extern "C" fn get_breath_state(elapsed_seconds: f32) -> *mut c_char {
         )
     };
 
-    let state = BreathState {
+    BreathState {
         phase: format!("{:?}", phase),
         phase_progress,
         monster_spawn_mult: phase.monster_spawn_multiplier(),
         resource_mult: phase.resource_multiplier(),
         semantic_intensity: phase.semantic_intensity(),
-    };
-
-    json_to_cstring(&state)
+    }
 }
 
 // ========================
@@ -649,14 +1139,7 @@ pub extern "C" fn mastery_get_tier(profile_json: *const c_char, domain_id: u32)
         None => return -1,
     };
 
-    match profile.tier(domain) {
-        MasteryTier::Novice => 0,
-        MasteryTier::Apprentice => 1,
-        MasteryTier::Journeyman => 2,
-        MasteryTier::Expert => 3,
-        MasteryTier::Master => 4,
-        MasteryTier::Grandmaster => 5,
-    }
+    mastery_tier_to_i32(profile.tier(domain))
 }
 
 /// Get XP amount for a game action by name
@@ -668,6 +1151,20 @@ pub extern "C" fn mastery_xp_for_action(action_name: *const c_char) -> u64 {
     }
 }
 
+/// The whole `mastery_xp_for_action` table as JSON: `{"actions": {"attack_hit": 2, ...}, "default": 1}`,
+/// so callers can cache it instead of crossing the FFI per action
+#[no_mangle]
+pub extern "C" fn mastery_get_action_xp_table() -> *mut c_char {
+    let actions: serde_json::Map<String, serde_json::Value> = ACTION_XP
+        .iter()
+        .map(|(name, xp)| (name.to_string(), serde_json::Value::from(*xp)))
+        .collect();
+    json_to_cstring(&serde_json::json!({
+        "actions": actions,
+        "default": DEFAULT_ACTION_XP,
+    }))
+}
+
 /// Get all mastery domain names as JSON array
 #[no_mangle]
 pub extern "C" fn mastery_get_all_domains() -> *mut c_char {
@@ -1139,6 +1636,386 @@ pub extern "C" fn cosmetic_apply_dye(
     json_to_cstring(&profile)
 }
 
+// ========================
+// C-ABI: Profile Handles
+// ========================
+//
+// Resident alternatives to the JSON-in/JSON-out profile calls above: a profile
+// is created or loaded once, mutated through small calls on its handle, and
+// only serialized by *_to_json (saves, UI refresh). Handles are u64, 0 on
+// failure; a released or unknown handle makes every call fail harmlessly.
+// Mutators return 1 if the profile changed, 0 if not, -1 for a bad handle or
+// argument. Stores are mutex-guarded, so any thread may call these.
+
+static MASTERY_PROFILES: Mutex<HandleStore<MasteryProfile>> = Mutex::new(HandleStore::new());
+static SPEC_PROFILES: Mutex<HandleStore<SpecializationProfile>> = Mutex::new(HandleStore::new());
+static ABILITY_LOADOUTS: Mutex<HandleStore<AbilityLoadout>> = Mutex::new(HandleStore::new());
+static COSMETIC_PROFILES: Mutex<HandleStore<CosmeticProfile>> = Mutex::new(HandleStore::new());
+static ACHIEVEMENT_TRACKERS: Mutex<HandleStore<AchievementTracker>> =
+    Mutex::new(HandleStore::new());
+
+/// Parse `json` into a new resident profile; 0 if it doesn't parse
+fn load_handle<T: serde::de::DeserializeOwned>(
+    store: &Mutex<HandleStore<T>>,
+    json: *const c_char,
+) -> u64 {
+    let json_str = match parse_cstr(json) {
+        Some(s) => s,
+        None => return 0,
+    };
+    match serde_json::from_str::<T>(&json_str) {
+        Ok(value) => handles::lock(store).insert(value),
+        Err(_) => 0,
+    }
+}
+
+fn handle_to_json<T: Serialize>(store: &Mutex<HandleStore<T>>, handle: u64) -> *mut c_char {
+    match handles::lock(store).get(handle) {
+        Some(value) => json_to_cstring(value),
+        None => std::ptr::null_mut(),
+    }
+}
+
+/// Run `mutate` on a resident profile: 1 changed, 0 unchanged, -1 stale handle
+fn mutate_handle<T>(
+    store: &Mutex<HandleStore<T>>,
+    handle: u64,
+    mutate: impl FnOnce(&mut T) -> bool,
+) -> i32 {
+    match handles::lock(store).get_mut(handle) {
+        Some(value) => mutate(value) as i32,
+        None => -1,
+    }
+}
+
+/// Create an empty resident mastery profile
+#[no_mangle]
+pub extern "C" fn mastery_handle_create() -> u64 {
+    handles::lock(&MASTERY_PROFILES).insert(MasteryProfile::new())
+}
+
+/// Load a mastery profile from JSON (e.g. a save) into a new handle
+#[no_mangle]
+pub extern "C" fn mastery_handle_load(profile_json: *const c_char) -> u64 {
+    load_handle(&MASTERY_PROFILES, profile_json)
+}
+
+/// Release a mastery handle; returns 1 if it was live
+#[no_mangle]
+pub extern "C" fn mastery_handle_release(handle: u64) -> u32 {
+    handles::lock(&MASTERY_PROFILES).remove(handle) as u32
+}
+
+/// Full mastery profile JSON, or null for a stale handle
+#[no_mangle]
+pub extern "C" fn mastery_handle_to_json(handle: u64) -> *mut c_char {
+    handle_to_json(&MASTERY_PROFILES, handle)
+}
+
+/// Gain XP in place. Returns the domain's tier after the gain (0-5), -1 on a bad handle or domain
+#[no_mangle]
+pub extern "C" fn mastery_handle_gain_xp(handle: u64, domain_id: u32, amount: u64) -> i32 {
+    let domain = match domain_from_id(domain_id) {
+        Some(d) => d,
+        None => return -1,
+    };
+    match handles::lock(&MASTERY_PROFILES).get_mut(handle) {
+        Some(profile) => {
+            profile.gain_xp(domain, amount);
+            mastery_tier_to_i32(profile.tier(domain))
+        }
+        None => -1,
+    }
+}
+
+/// Mastery tier for a domain (0=Novice..5=Grandmaster), -1 on a bad handle or domain
+#[no_mangle]
+pub extern "C" fn mastery_handle_get_tier(handle: u64, domain_id: u32) -> i32 {
+    let domain = match domain_from_id(domain_id) {
+        Some(d) => d,
+        None => return -1,
+    };
+    match handles::lock(&MASTERY_PROFILES).get(handle) {
+        Some(profile) => mastery_tier_to_i32(profile.tier(domain)),
+        None => -1,
+    }
+}
+
+/// XP accumulated in a domain (0 on a bad handle or domain)
+#[no_mangle]
+pub extern "C" fn mastery_handle_get_xp(handle: u64, domain_id: u32) -> u64 {
+    let domain = match domain_from_id(domain_id) {
+        Some(d) => d,
+        None => return 0,
+    };
+    handles::lock(&MASTERY_PROFILES)
+        .get(handle)
+        .and_then(|profile| profile.get(domain))
+        .map(|progress| progress.xp)
+        .unwrap_or(0)
+}
+
+/// Create an empty resident specialization profile
+#[no_mangle]
+pub extern "C" fn spec_handle_create() -> u64 {
+    handles::lock(&SPEC_PROFILES).insert(SpecializationProfile::new())
+}
+
+/// Load a specialization profile from JSON into a new handle
+#[no_mangle]
+pub extern "C" fn spec_handle_load(profile_json: *const c_char) -> u64 {
+    load_handle(&SPEC_PROFILES, profile_json)
+}
+
+/// Release a specialization handle; returns 1 if it was live
+#[no_mangle]
+pub extern "C" fn spec_handle_release(handle: u64) -> u32 {
+    handles::lock(&SPEC_PROFILES).remove(handle) as u32
+}
+
+/// Full specialization profile JSON, or null for a stale handle
+#[no_mangle]
+pub extern "C" fn spec_handle_to_json(handle: u64) -> *mut c_char {
+    handle_to_json(&SPEC_PROFILES, handle)
+}
+
+/// Choose a branch, checked against a resident mastery profile.
+/// Returns 1 if chosen, 0 if the requirements aren't met, -1 on a bad handle or branch id.
+#[no_mangle]
+pub extern "C" fn spec_handle_choose_branch(
+    handle: u64,
+    mastery_handle: u64,
+    branch_id: *const c_char,
+) -> i32 {
+    let bid_str = match parse_cstr(branch_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    let branches = all_specialization_branches();
+    let branch = match branches.iter().find(|b| b.id == bid_str) {
+        Some(b) => b,
+        None => return -1,
+    };
+
+    // Mastery before spec, the only order both stores are ever held in
+    let masteries = handles::lock(&MASTERY_PROFILES);
+    let mastery = match masteries.get(mastery_handle) {
+        Some(m) => m,
+        None => return -1,
+    };
+    mutate_handle(&SPEC_PROFILES, handle, |profile| {
+        profile.choose_branch(branch, mastery).is_ok()
+    })
+}
+
+/// Create an empty resident ability loadout
+#[no_mangle]
+pub extern "C" fn ability_handle_create() -> u64 {
+    handles::lock(&ABILITY_LOADOUTS).insert(AbilityLoadout::new())
+}
+
+/// Load an ability loadout from JSON into a new handle
+#[no_mangle]
+pub extern "C" fn ability_handle_load(loadout_json: *const c_char) -> u64 {
+    load_handle(&ABILITY_LOADOUTS, loadout_json)
+}
+
+/// Release an ability handle; returns 1 if it was live
+#[no_mangle]
+pub extern "C" fn ability_handle_release(handle: u64) -> u32 {
+    handles::lock(&ABILITY_LOADOUTS).remove(handle) as u32
+}
+
+/// Full ability loadout JSON, or null for a stale handle
+#[no_mangle]
+pub extern "C" fn ability_handle_to_json(handle: u64) -> *mut c_char {
+    handle_to_json(&ABILITY_LOADOUTS, handle)
+}
+
+/// Learn a default ability by id: 1 learned, 0 already known, -1 on a bad handle or id
+#[no_mangle]
+pub extern "C" fn ability_handle_learn(handle: u64, ability_id: *const c_char) -> i32 {
+    let aid_str = match parse_cstr(ability_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    let ability = match default_abilities().into_iter().find(|a| a.id == aid_str) {
+        Some(a) => a,
+        None => return -1,
+    };
+    mutate_handle(&ABILITY_LOADOUTS, handle, |loadout| loadout.learn(ability))
+}
+
+/// Equip a known ability to a hotbar slot (0-5): 1 equipped, 0 rejected, -1 on a bad handle
+#[no_mangle]
+pub extern "C" fn ability_handle_equip(handle: u64, slot: u32, ability_id: *const c_char) -> i32 {
+    let aid_str = match parse_cstr(ability_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    mutate_handle(&ABILITY_LOADOUTS, handle, |loadout| {
+        loadout.equip(slot as usize, &aid_str)
+    })
+}
+
+/// Create an empty resident cosmetic profile
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_create() -> u64 {
+    handles::lock(&COSMETIC_PROFILES).insert(CosmeticProfile::new())
+}
+
+/// Load a cosmetic profile from JSON into a new handle
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_load(profile_json: *const c_char) -> u64 {
+    load_handle(&COSMETIC_PROFILES, profile_json)
+}
+
+/// Release a cosmetic handle; returns 1 if it was live
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_release(handle: u64) -> u32 {
+    handles::lock(&COSMETIC_PROFILES).remove(handle) as u32
+}
+
+/// Full cosmetic profile JSON, or null for a stale handle
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_to_json(handle: u64) -> *mut c_char {
+    handle_to_json(&COSMETIC_PROFILES, handle)
+}
+
+/// Unlock a cosmetic: 1 unlocked, 0 already unlocked or unknown, -1 on a bad handle
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_unlock(handle: u64, cosmetic_id: *const c_char) -> i32 {
+    let cid_str = match parse_cstr(cosmetic_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    mutate_handle(&COSMETIC_PROFILES, handle, |profile| {
+        profile.unlock_cosmetic(&cid_str)
+    })
+}
+
+/// Apply a transmog override (slot_id 0-11): 1 applied, 0 rejected, -1 on a bad handle or slot
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_apply_transmog(
+    handle: u64,
+    slot_id: u32,
+    cosmetic_id: *const c_char,
+) -> i32 {
+    let cid_str = match parse_cstr(cosmetic_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    let slot = match cosmetic_slot_from_id(slot_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    mutate_handle(&COSMETIC_PROFILES, handle, |profile| {
+        profile.apply_transmog(slot, &cid_str)
+    })
+}
+
+/// Apply a dye (channel 0=Primary, 1=Secondary, 2=Accent): 1 applied, 0 rejected, -1 on a bad argument
+#[no_mangle]
+pub extern "C" fn cosmetic_handle_apply_dye(
+    handle: u64,
+    slot_id: u32,
+    channel_id: u32,
+    dye_id: *const c_char,
+) -> i32 {
+    let did_str = match parse_cstr(dye_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    let slot = match cosmetic_slot_from_id(slot_id) {
+        Some(s) => s,
+        None => return -1,
+    };
+    let channel = match channel_id {
+        0 => DyeChannel::Primary,
+        1 => DyeChannel::Secondary,
+        2 => DyeChannel::Accent,
+        _ => return -1,
+    };
+    mutate_handle(&COSMETIC_PROFILES, handle, |profile| {
+        profile.apply_dye(slot, channel, &did_str)
+    })
+}
+
+/// Create a resident achievement tracker with all predefined achievements
+#[no_mangle]
+pub extern "C" fn achievement_handle_create() -> u64 {
+    handles::lock(&ACHIEVEMENT_TRACKERS).insert(AchievementTracker::new())
+}
+
+/// Load an achievement tracker from JSON (e.g. from Nakama storage) into a new handle
+#[no_mangle]
+pub extern "C" fn achievement_handle_load(tracker_json: *const c_char) -> u64 {
+    load_handle(&ACHIEVEMENT_TRACKERS, tracker_json)
+}
+
+/// Release an achievement tracker handle; returns 1 if it was live
+#[no_mangle]
+pub extern "C" fn achievement_handle_release(handle: u64) -> u32 {
+    handles::lock(&ACHIEVEMENT_TRACKERS).remove(handle) as u32
+}
+
+/// Full tracker JSON, or null for a stale handle
+#[no_mangle]
+pub extern "C" fn achievement_handle_to_json(handle: u64) -> *mut c_char {
+    handle_to_json(&ACHIEVEMENT_TRACKERS, handle)
+}
+
+/// Apply what a client accumulated since its last call in one go: counter
+/// increments by achievement id (`{"combat_first_kill": 20}`, null for none),
+/// then the exploration floors `current_floor` reaches (0 skips them), then unlock
+/// whatever is now complete. Returns the ids this call unlocked as a JSON
+/// array (usually `[]`), null on a stale handle or increments that don't parse.
+#[no_mangle]
+pub extern "C" fn achievement_handle_apply(
+    handle: u64,
+    increments_json: *const c_char,
+    current_floor: u32,
+    current_tick: u64,
+) -> *mut c_char {
+    let increments: HashMap<String, u64> = if increments_json.is_null() {
+        HashMap::new()
+    } else {
+        match parse_cstr(increments_json).and_then(|s| serde_json::from_str(&s).ok()) {
+            Some(map) => map,
+            None => return std::ptr::null_mut(),
+        }
+    };
+
+    let unlocked: Vec<String> = {
+        let mut store = handles::lock(&ACHIEVEMENT_TRACKERS);
+        let tracker = match store.get_mut(handle) {
+            Some(tracker) => tracker,
+            None => return std::ptr::null_mut(),
+        };
+        for (id, amount) in &increments {
+            tracker.increment_counter(id, *amount);
+        }
+        if current_floor > 0 {
+            tracker.reach_floor(current_floor);
+        }
+        tracker
+            .check_all(current_tick)
+            .into_iter()
+            .map(|achievement| achievement.id)
+            .collect()
+    };
+    json_to_cstring(&unlocked)
+}
+
+/// Achievement completion (0.0 - 1.0), 0 for a stale handle
+#[no_mangle]
+pub extern "C" fn achievement_handle_completion_percent(handle: u64) -> f32 {
+    handles::lock(&ACHIEVEMENT_TRACKERS)
+        .get(handle)
+        .map(|tracker| tracker.completion_percent())
+        .unwrap_or(0.0)
+}
+
 // ========================
 // C-ABI: Tutorial
 // ========================
@@ -1622,6 +2499,17 @@ fn domain_from_id(id: u32) -> Option<MasteryDomain> {
     }
 }
 
+fn mastery_tier_to_i32(tier: MasteryTier) -> i32 {
+    match tier {
+        MasteryTier::Novice => 0,
+        MasteryTier::Apprentice => 1,
+        MasteryTier::Journeyman => 2,
+        MasteryTier::Expert => 3,
+        MasteryTier::Master => 4,
+        MasteryTier::Grandmaster => 5,
+    }
+}
+
 fn socket_color_from_id(id: u32) -> SocketColor {
     match id {
         0 => SocketColor::Red,
@@ -1667,6 +2555,18 @@ fn tile_to_u8(tile: &TileType) -> u8 {
     }
 }
 
+fn room_type_to_u8(room_type: RoomType) -> u8 {
+    match room_type {
+        RoomType::Combat => 0,
+        RoomType::Treasure => 1,
+        RoomType::Puzzle => 2,
+        RoomType::Rest => 3,
+        RoomType::Boss => 4,
+        RoomType::Entrance => 5,
+        RoomType::Exit => 6,
+    }
+}
+
 // ========================
 // C-ABI: Floor Mutators (Session 20)
 // ========================
@@ -2120,64 +3020,123 @@ pub extern "C" fn hotreload_get_status() -> *mut c_char {
     json_to_cstring(&status)
 }
 
-/// Trigger manual config reload
+/// Trigger manual config reload: re-read config/engine.json, bumping the
+/// generation of every domain it changed. Returns 1 on success, 0 if the
+/// config couldn't be read or parsed (generations are then unchanged).
 #[no_mangle]
 pub extern "C" fn hotreload_trigger_reload() -> u32 {
-    // In a real implementation, this would post an event to Bevy
-    // For now, just return success
-    1
+    match hotreload::reload_config() {
+        Ok(_) => 1,
+        Err(_) => 0,
+    }
+}
+
+/// Reload generation of each config domain (`hotreload::ConfigDomain` order:
+/// monsters, loot, abilities, cosmetics). A client cache built from a domain is
+/// stale once its generation moves. Writes up to `count` values to `out` and
+/// returns how many were written.
+#[no_mangle]
+#[allow(clippy::not_unsafe_ptr_arg_deref)]
+pub extern "C" fn hotreload_get_domain_generations(out: *mut u64, count: u32) -> u32 {
+    if out.is_null() {
+        return 0;
+    }
+    let domains =
+        &hotreload::ConfigDomain::ALL[..(count as usize).min(hotreload::ConfigDomain::ALL.len())];
+    let out = unsafe { std::slice::from_raw_parts_mut(out, domains.len()) };
+    for (slot, domain) in out.iter_mut().zip(domains) {
+        *slot = hotreload::domain_generation(*domain);
+    }
+    domains.len() as u32
 }
 
 // ========================
 // C-ABI: Analytics (Session 22)
 // ========================
 
-/// Get analytics snapshot
+/// Get analytics snapshot, for export; the running totals come from
+/// `analytics_get_counters`, which overlays should read instead
 #[no_mangle]
 pub extern "C" fn analytics_get_snapshot() -> *mut c_char {
-    // Create an empty snapshot
-    let snapshot = analytics::AnalyticsSnapshot {
+    let mut snapshot = analytics::AnalyticsSnapshot {
         combat: analytics::CombatStats::default(),
         progression: analytics::ProgressionStats::default(),
         equipment: analytics::EquipmentStats::default(),
         economy: analytics::EconomyStats::default(),
         behavior: analytics::BehaviorStats::default(),
     };
+    analytics::COUNTERS.fill_snapshot(&mut snapshot);
     json_to_cstring(&snapshot)
 }
 
+/// The process-wide `AnalyticsCounters` block. The pointer stays valid for
+/// the life of the library; read the fields as relaxed atomic u64s and check
+/// `version`/`size` before reading past the ones the client knows.
+#[no_mangle]
+pub extern "C" fn analytics_get_counters() -> *const analytics::AnalyticsCounters {
+    &analytics::COUNTERS
+}
+
 /// Reset analytics
 #[no_mangle]
 pub extern "C" fn analytics_reset() {
-    // In a real implementation, this would post an event to Bevy
-    // For now, this is a no-op
+    analytics::COUNTERS.reset();
 }
 
 /// Record combat event
 #[no_mangle]
-pub extern "C" fn analytics_record_damage(weapon: *const c_char, _amount: u32) {
-    let _weapon_name = match parse_cstr(weapon) {
-        Some(w) => w,
-        None => return,
-    };
-    // In a real implementation, this would send an AnalyticsEvent
-    // For now, this is a no-op
+pub extern "C" fn analytics_record_damage(weapon: *const c_char, amount: u32) {
+    if parse_cstr(weapon).is_none() {
+        return;
+    }
+    analytics::COUNTERS.record_damage(1, amount as u64, amount as u64);
 }
 
 /// Record floor cleared
 #[no_mangle]
 pub extern "C" fn analytics_record_floor_cleared(floor_id: u32, tier: u8, time_secs: f32) {
-    // In a real implementation, this would send an AnalyticsEvent
-    // For now, this is a no-op
-    let _ = (floor_id, tier, time_secs);
+    let _ = tier;
+    analytics::COUNTERS.record_floor_cleared(floor_id, time_secs);
 }
 
 /// Record gold transaction
 #[no_mangle]
 pub extern "C" fn analytics_record_gold(amount: u64, earned: u32) {
     // earned: 1 = earned, 0 = spent
-    // In a real implementation, this would send an AnalyticsEvent
-    let _ = (amount, earned);
+    analytics::COUNTERS.record_gold(amount, earned != 0);
+}
+
+/// One (weapon, floor) entry of `analytics_record_damage_batch`
+#[derive(Debug, Serialize, Deserialize)]
+pub struct DamageAggregate {
+    pub weapon: String,
+    pub floor_id: u32,
+    pub hits: u32,
+    pub total_damage: u64,
+    pub max_hit: u32,
+}
+
+/// Record the damage a client buffered since its last flush, aggregated per
+/// (weapon, floor): `[{"weapon": "Sword", "floor_id": 3, "hits": 12, "total_damage": 1500, "max_hit": 210}]`.
+/// Returns the number of hits recorded, 0 if the JSON doesn't parse.
+#[no_mangle]
+pub extern "C" fn analytics_record_damage_batch(aggregates_json: *const c_char) -> u32 {
+    let json_str = match parse_cstr(aggregates_json) {
+        Some(s) => s,
+        None => return 0,
+    };
+    let aggregates: Vec<DamageAggregate> = match serde_json::from_str(&json_str) {
+        Ok(a) => a,
+        Err(_) => return 0,
+    };
+    aggregates.iter().fold(0u32, |hits, aggregate| {
+        analytics::COUNTERS.record_damage(
+            aggregate.hits as u64,
+            aggregate.total_damage,
+            aggregate.max_hit as u64,
+        );
+        hits.saturating_add(aggregate.hits)
+    })
 }
 
 /// Get analytics event types
@@ -2212,6 +3171,7 @@ pub extern "C" fn analytics_get_event_types() -> *mut c_char {
 mod tests {
     use super::*;
     use std::ffi::CStr;
+    use std::sync::atomic::Ordering;
 
     #[test]
     fn test_generate_floor_ffi() {
@@ -2236,6 +3196,40 @@ mod tests {
         free_string(result_ptr);
     }
 
+    #[test]
+    fn test_generate_floor_layout_binary_ffi() {
+        let required = generate_floor_layout_binary(42, 1, std::ptr::null_mut(), 0);
+        assert!(required > FLOOR_LAYOUT_HEADER_SIZE);
+
+        let mut buf = vec![0u8; required];
+        let written = generate_floor_layout_binary(42, 1, buf.as_mut_ptr(), buf.len());
+        assert_eq!(written, required);
+
+        let rd = |at: usize| u16::from_le_bytes([buf[at], buf[at + 1]]) as usize;
+        assert_eq!(
+            u32::from_le_bytes([buf[0], buf[1], buf[2], buf[3]]),
+            FLOOR_LAYOUT_BINARY_MAGIC
+        );
+
+        // Same floor as the JSON path
+        let json_ptr = generate_floor_layout(42, 1);
+        let json_str = unsafe { CStr::from_ptr(json_ptr).to_str().unwrap() };
+        let response: FloorLayoutResponse = serde_json::from_str(json_str).unwrap();
+        free_string(json_ptr);
+
+        let (width, height, rooms, spawns) = (rd(4), rd(6), rd(8), rd(10));
+        assert_eq!(width, response.width);
+        assert_eq!(height, response.height);
+        assert_eq!(rooms, response.rooms.len());
+        assert_eq!(spawns, response.spawn_points.len());
+
+        let tiles_at = FLOOR_LAYOUT_HEADER_SIZE
+            + rooms * FLOOR_LAYOUT_ROOM_SIZE
+            + spawns * FLOOR_LAYOUT_POINT_SIZE;
+        let flat: Vec<u8> = response.tiles.concat();
+        assert_eq!(&buf[tiles_at..], flat.as_slice());
+    }
+
     #[test]
     fn test_generate_monster_ffi() {
         let result_ptr = generate_monster(12345, 10);
@@ -2301,6 +3295,19 @@ mod tests {
         free_string(result_ptr);
     }
 
+    #[test]
+    fn test_item_catalog_ffi() {
+        let ptr = get_item_catalog();
+        assert!(!ptr.is_null());
+        let json_str = unsafe { CStr::from_ptr(ptr).to_str().unwrap() };
+        let entries: Vec<ItemCatalogEntry> = serde_json::from_str(json_str).unwrap();
+        assert_eq!(entries.len(), loot::item_catalog().len());
+        assert!(entries
+            .iter()
+            .any(|e| e.name == "Ember Thermal Core" && e.category == "CombatResource"));
+        free_string(ptr);
+    }
+
     #[test]
     fn test_breath_state_ffi() {
         let ptr = get_breath_state(100.0); // early in Inhale phase
@@ -2312,6 +3319,30 @@ mod tests {
         free_string(ptr);
     }
 
+    #[test]
+    fn test_breath_cycle_matches_breath_state() {
+        let ptr = get_breath_cycle();
+        assert!(!ptr.is_null());
+        let json_str = unsafe { CStr::from_ptr(ptr).to_str().unwrap() };
+        let cycle: BreathCycle = serde_json::from_str(json_str).unwrap();
+        free_string(ptr);
+
+        assert_eq!(cycle.phases.len(), 4);
+        let sum: f32 = cycle.phases.iter().map(|p| p.duration_secs).sum();
+        assert!((sum - cycle.total_secs).abs() < 1e-3);
+
+        // Midpoint of each phase evaluates to that phase with its multipliers
+        let mut start = 0.0;
+        for def in &cycle.phases {
+            let state = breath_state(start + def.duration_secs * 0.5);
+            assert_eq!(state.phase, def.phase);
+            assert!((state.phase_progress - 0.5).abs() < 1e-3);
+            assert_eq!(state.monster_spawn_mult, def.monster_spawn_mult);
+            assert_eq!(state.semantic_intensity, def.semantic_intensity);
+            start += def.duration_secs;
+        }
+    }
+
     #[test]
     fn test_record_delta_ffi() {
         let player = CString::new("player1").unwrap();
@@ -2382,6 +3413,195 @@ mod tests {
         free_string(result_ptr);
     }
 
+    #[test]
+    fn test_generate_floor_monsters_into_matches_json() {
+        let ptr = generate_floor_monsters(42, 3, 4);
+        let expected = unsafe { CStr::from_ptr(ptr).to_bytes().to_vec() };
+        free_string(ptr);
+
+        let required = generate_floor_monsters_into(42, 3, 4, std::ptr::null_mut(), 0);
+        assert_eq!(required, expected.len());
+
+        let mut small = vec![0u8; required / 2];
+        assert_eq!(
+            generate_floor_monsters_into(42, 3, 4, small.as_mut_ptr(), small.len()),
+            required
+        );
+
+        let mut buf = vec![0u8; required];
+        let written = generate_floor_monsters_into(42, 3, 4, buf.as_mut_ptr(), buf.len());
+        assert_eq!(written, required);
+        assert_eq!(buf, expected);
+    }
+
+    #[test]
+    fn test_hotreload_get_domain_generations() {
+        let mut generations = [u64::MAX; 5];
+        assert_eq!(
+            hotreload_get_domain_generations(generations.as_mut_ptr(), 5),
+            4
+        );
+        // Only the four domains are written
+        assert!(generations[..4].iter().all(|&g| g != u64::MAX));
+        assert_eq!(generations[4], u64::MAX);
+        assert_eq!(hotreload_get_domain_generations(std::ptr::null_mut(), 4), 0);
+    }
+
+    #[test]
+    fn test_analytics_record_damage_batch() {
+        let batch = CString::new(
+            r#"[{"weapon": "Sword", "floor_id": 3, "hits": 12, "total_damage": 1500, "max_hit": 210},
+                {"weapon": "Bow", "floor_id": 3, "hits": 4, "total_damage": 300, "max_hit": 90}]"#,
+        )
+        .unwrap();
+        let counters = unsafe { &*analytics_get_counters() };
+        let hits_before = counters.damage_hits.load(Ordering::Relaxed);
+        assert_eq!(analytics_record_damage_batch(batch.as_ptr()), 16);
+        assert!(counters.damage_hits.load(Ordering::Relaxed) >= hits_before + 16);
+        assert!(counters.max_hit.load(Ordering::Relaxed) >= 210);
+
+        let bad = CString::new("not json").unwrap();
+        assert_eq!(analytics_record_damage_batch(bad.as_ptr()), 0);
+        assert_eq!(analytics_record_damage_batch(std::ptr::null()), 0);
+    }
+
+    #[test]
+    fn test_loot_batch_matches_single_ffi() {
+        let tag_sets =
+            CString::new(r#"[[["fire", 0.8], ["earth", 0.4]], [["void", 0.9]]]"#).unwrap();
+        let sources = [
+            LootBatchSource {
+                tag_set: 0,
+                floor_level: 12,
+                drop_hash: 0xDEAD_BEEF,
+            },
+            LootBatchSource {
+                tag_set: 1,
+                floor_level: 250,
+                drop_hash: 77,
+            },
+            LootBatchSource {
+                tag_set: 0,
+                floor_level: 12,
+                drop_hash: 0xDEAD_BEEF,
+            },
+        ];
+
+        let required = generate_loot_batch(
+            tag_sets.as_ptr(),
+            sources.as_ptr(),
+            3,
+            std::ptr::null_mut(),
+            0,
+        );
+        assert!(required >= LOOT_BATCH_HEADER_SIZE);
+        let mut buf = vec![0u8; required];
+        let written = generate_loot_batch(
+            tag_sets.as_ptr(),
+            sources.as_ptr(),
+            3,
+            buf.as_mut_ptr(),
+            buf.len(),
+        );
+        assert_eq!(written, required);
+
+        let u16_at = |pos: usize| u16::from_le_bytes([buf[pos], buf[pos + 1]]) as usize;
+        let u32_at =
+            |pos: usize| u32::from_le_bytes(buf[pos..pos + 4].try_into().unwrap()) as usize;
+        assert_eq!(u32_at(0) as u32, LOOT_BATCH_BINARY_MAGIC);
+        let record_count = u32_at(4);
+        let strings = &buf[LOOT_BATCH_HEADER_SIZE + record_count * LOOT_BATCH_RECORD_SIZE..];
+        assert_eq!(strings.len(), u32_at(8));
+
+        let mut expected = Vec::new();
+        for (i, tags) in [
+            r#"[["fire", 0.8], ["earth", 0.4]]"#,
+            r#"[["void", 0.9]]"#,
+            r#"[["fire", 0.8], ["earth", 0.4]]"#,
+        ]
+        .iter()
+        .enumerate()
+        {
+            let tags_c = CString::new(*tags).unwrap();
+            let ptr = generate_loot(
+                tags_c.as_ptr(),
+                sources[i].floor_level,
+                sources[i].drop_hash,
+            );
+            let items: Vec<LootInfo> =
+                serde_json::from_str(unsafe { CStr::from_ptr(ptr).to_str().unwrap() }).unwrap();
+            free_string(ptr);
+            expected.extend(items.into_iter().map(|item| (i, item)));
+        }
+        assert_eq!(record_count, expected.len());
+
+        for (r, (source_index, item)) in expected.iter().enumerate() {
+            let rec = LOOT_BATCH_HEADER_SIZE + r * LOOT_BATCH_RECORD_SIZE;
+            assert_eq!(u32_at(rec), *source_index);
+            assert_eq!(u32_at(rec + 4) as u32, item.quantity);
+            let name = &strings[u32_at(rec + 8)..u32_at(rec + 8) + u16_at(rec + 16)];
+            assert_eq!(std::str::from_utf8(name).unwrap(), item.name);
+            let tags = &strings[u32_at(rec + 12)..u32_at(rec + 12) + u16_at(rec + 18)];
+            let tags: Vec<(String, f32)> = serde_json::from_slice(tags).unwrap();
+            assert_eq!(tags, item.semantic_tags);
+        }
+    }
+
+    #[test]
+    fn test_combat_batch_matches_single_ffi() {
+        let tag_sets = CString::new(r#"[[["fire", 0.8]], [["water", 0.9]]]"#).unwrap();
+        let requests = [
+            CombatBatchRequest {
+                base_damage: 100.0,
+                angle_id: 2,
+                combo_step: 1,
+                attacker_tag_set: 0,
+                defender_tag_set: 1,
+            },
+            CombatBatchRequest {
+                base_damage: 50.0,
+                angle_id: 0,
+                combo_step: 0,
+                attacker_tag_set: 0,
+                defender_tag_set: COMBAT_BATCH_NO_TAGS,
+            },
+        ];
+        let mut results = [CombatBatchResult::default(); 2];
+        let written = calculate_combat_batch(
+            tag_sets.as_ptr(),
+            requests.as_ptr(),
+            requests.len() as u32,
+            results.as_mut_ptr(),
+        );
+        assert_eq!(written, 2);
+
+        let single = CombatCalcRequest {
+            base_damage: 100.0,
+            angle_id: 2,
+            combo_step: 1,
+            attacker_tags_json: r#"[["fire", 0.8]]"#.into(),
+            defender_tags_json: r#"[["water", 0.9]]"#.into(),
+        };
+        let single_json = CString::new(serde_json::to_string(&single).unwrap()).unwrap();
+        let ptr = calculate_combat(single_json.as_ptr());
+        let expected: CombatCalcResult =
+            serde_json::from_str(unsafe { CStr::from_ptr(ptr).to_str().unwrap() }).unwrap();
+        free_string(ptr);
+
+        assert!((results[0].final_damage - expected.final_damage).abs() < f32::EPSILON);
+        assert!((results[1].angle_multiplier - 1.0).abs() < f32::EPSILON);
+
+        assert_eq!(
+            calculate_combat_batch(
+                tag_sets.as_ptr(),
+                requests.as_ptr(),
+                2,
+                std::ptr::null_mut()
+            ),
+            0
+        );
+    }
+
     // ========================
     // Mastery FFI Tests
     // ========================
@@ -2410,6 +3630,73 @@ mod tests {
         free_string(updated);
     }
 
+    #[test]
+    fn test_mastery_handle_gain_xp() {
+        let handle = mastery_handle_create();
+        assert_ne!(handle, 0);
+
+        let tier = mastery_handle_gain_xp(handle, 0, 500); // SwordMastery + 500 XP
+        assert!(tier >= 0);
+        assert_eq!(mastery_handle_get_tier(handle, 0), tier);
+        assert_eq!(mastery_handle_get_xp(handle, 0), 500);
+
+        // Round-trips through JSON like a save
+        let json_ptr = mastery_handle_to_json(handle);
+        assert!(!json_ptr.is_null());
+        let reloaded = mastery_handle_load(json_ptr);
+        free_string(json_ptr);
+        assert_eq!(mastery_handle_get_xp(reloaded, 0), 500);
+
+        assert_eq!(mastery_handle_release(handle), 1);
+        assert_eq!(mastery_handle_release(handle), 0);
+        assert_eq!(mastery_handle_gain_xp(handle, 0, 10), -1);
+        assert!(mastery_handle_to_json(handle).is_null());
+        mastery_handle_release(reloaded);
+    }
+
+    #[test]
+    fn test_achievement_handle_apply_returns_new_unlocks() {
+        let handle = achievement_handle_create();
+        assert_ne!(handle, 0);
+
+        let kills = CString::new(r#"{"combat_first_kill": 20, "combat_100_kills": 20}"#).unwrap();
+        let unlocked_ptr = achievement_handle_apply(handle, kills.as_ptr(), 0, 100);
+        assert!(!unlocked_ptr.is_null());
+        let unlocked: Vec<String> =
+            serde_json::from_str(unsafe { CStr::from_ptr(unlocked_ptr).to_str().unwrap() })
+                .unwrap();
+        free_string(unlocked_ptr);
+        assert_eq!(unlocked, vec!["combat_first_kill".to_string()]);
+
+        // Already unlocked: nothing new comes back
+        let again_ptr = achievement_handle_apply(handle, kills.as_ptr(), 0, 200);
+        let again = unsafe { CStr::from_ptr(again_ptr).to_str().unwrap().to_string() };
+        free_string(again_ptr);
+        assert_eq!(again, "[]");
+        assert!(achievement_handle_completion_percent(handle) > 0.0);
+
+        let bad = CString::new("not json").unwrap();
+        assert!(achievement_handle_apply(handle, bad.as_ptr(), 0, 300).is_null());
+
+        assert_eq!(achievement_handle_release(handle), 1);
+        assert!(achievement_handle_apply(handle, std::ptr::null(), 0, 0).is_null());
+    }
+
+    #[test]
+    fn test_ability_handle_learn_equip() {
+        let handle = ability_handle_create();
+        let defaults = default_abilities();
+        let id = CString::new(defaults[0].id.clone()).unwrap();
+
+        assert_eq!(ability_handle_learn(handle, id.as_ptr()), 1);
+        assert_eq!(ability_handle_learn(handle, id.as_ptr()), 0);
+        assert_eq!(ability_handle_equip(handle, 0, id.as_ptr()), 1);
+
+        let unknown = CString::new("no_such_ability").unwrap();
+        assert_eq!(ability_handle_learn(handle, unknown.as_ptr()), -1);
+        ability_handle_release(handle);
+    }
+
     #[test]
     fn test_mastery_xp_for_action() {
         let action = CString::new("sword_attack").unwrap();
@@ -2417,6 +3704,25 @@ mod tests {
         assert!(xp > 0, "sword_attack should give XP");
     }
 
+    #[test]
+    fn test_mastery_action_xp_table_matches_lookup() {
+        let ptr = mastery_get_action_xp_table();
+        assert!(!ptr.is_null());
+        let json: serde_json::Value =
+            serde_json::from_str(unsafe { CStr::from_ptr(ptr).to_str().unwrap() }).unwrap();
+        free_string(ptr);
+
+        let actions = json["actions"].as_object().unwrap();
+        assert_eq!(actions.len(), ACTION_XP.len());
+        for (name, xp) in actions {
+            assert_eq!(xp.as_u64().unwrap(), xp_for_action(name));
+        }
+        assert_eq!(
+            json["default"].as_u64().unwrap(),
+            xp_for_action("unknown_action")
+        );
+    }
+
     #[test]
     fn test_mastery_get_all_domains() {
         let ptr = mastery_get_all_domains();
@@ -6,11 +6,13 @@
 //! - Validation before applying
 //! - Rollback on invalid config
 //! - FFI interface for reload status
+//! - Per-domain reload generations, so clients only drop the caches a reload touched
 
 use bevy::prelude::*;
 use notify::{Event, RecommendedWatcher, RecursiveMode, Watcher};
 use serde::{Deserialize, Serialize};
 use std::path::PathBuf;
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::mpsc::{channel, Receiver, Sender};
 use std::sync::{Arc, Mutex};
 
@@ -164,8 +166,87 @@ fn is_config_modify_event(event: &Event, watched_file: &Option<PathBuf>) -> bool
     }
 }
 
+/// Config sections clients cache data from, each with its own reload generation
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum ConfigDomain {
+    Monsters = 0,
+    Loot = 1,
+    Abilities = 2,
+    Cosmetics = 3,
+}
+
+impl ConfigDomain {
+    pub const ALL: [ConfigDomain; 4] = [
+        ConfigDomain::Monsters,
+        ConfigDomain::Loot,
+        ConfigDomain::Abilities,
+        ConfigDomain::Cosmetics,
+    ];
+
+    /// Section under `procedural_core.modules` in engine.json
+    pub fn module_key(self) -> &'static str {
+        match self {
+            ConfigDomain::Monsters => "monster",
+            ConfigDomain::Loot => "loot",
+            ConfigDomain::Abilities => "abilities",
+            ConfigDomain::Cosmetics => "cosmetics",
+        }
+    }
+
+    pub fn mask(self) -> u32 {
+        1 << self as u32
+    }
+}
+
+/// Bumped once per reload that changed the domain's section (0 = never reloaded)
+static DOMAIN_GENERATIONS: [AtomicU64; 4] = [
+    AtomicU64::new(0),
+    AtomicU64::new(0),
+    AtomicU64::new(0),
+    AtomicU64::new(0),
+];
+
+/// The config of the last successful reload, to diff the next one against
+static LAST_CONFIG: Mutex<Option<serde_json::Value>> = Mutex::new(None);
+
+pub fn domain_generation(domain: ConfigDomain) -> u64 {
+    DOMAIN_GENERATIONS[domain as usize].load(Ordering::Acquire)
+}
+
+/// Mask (`ConfigDomain::mask`) of the domains whose module section differs; everything if there is no `old`
+pub fn changed_domains(old: Option<&serde_json::Value>, new: &serde_json::Value) -> u32 {
+    let section = |config: &serde_json::Value, domain: ConfigDomain| {
+        config
+            .pointer(&format!("/procedural_core/modules/{}", domain.module_key()))
+            .cloned()
+    };
+
+    ConfigDomain::ALL
+        .iter()
+        .filter(|&&domain| match old {
+            Some(old) => section(old, domain) != section(new, domain),
+            None => true,
+        })
+        .fold(0, |mask, domain| mask | domain.mask())
+}
+
+/// Make `config` the current one, bumping the generation of every domain it changed; returns their mask
+pub fn apply_config(config: serde_json::Value) -> u32 {
+    let mut last = LAST_CONFIG
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner());
+    let changed = changed_domains(last.as_ref(), &config);
+    for domain in ConfigDomain::ALL {
+        if changed & domain.mask() != 0 {
+            DOMAIN_GENERATIONS[domain as usize].fetch_add(1, Ordering::AcqRel);
+        }
+    }
+    *last = Some(config);
+    changed
+}
+
 /// Reload configuration from disk
-fn reload_config() -> Result<ConfigSnapshot, String> {
+pub fn reload_config() -> Result<ConfigSnapshot, String> {
     let config_path = PathBuf::from("config/engine.json");
 
     // Read file
@@ -173,8 +254,9 @@ fn reload_config() -> Result<ConfigSnapshot, String> {
         std::fs::read_to_string(&config_path).map_err(|e| format!("Read error: {}", e))?;
 
     // Validate JSON
-    let _config: serde_json::Value =
+    let config: serde_json::Value =
         serde_json::from_str(&content).map_err(|e| format!("JSON parse error: {}", e))?;
+    apply_config(config);
 
     // Create snapshot
     let snapshot = ConfigSnapshot {
@@ -234,6 +316,34 @@ mod tests {
     use std::io::Write;
     use tempfile::NamedTempFile;
 
+    #[test]
+    fn test_changed_domains() {
+        let old = serde_json::json!({"procedural_core": {"modules": {
+            "monster": {"grammar_depth": 5}, "loot": {"base_drop_chance": 0.15},
+            "abilities": {"hotbar_slots": 6}, "cosmetics": {"enabled": true}}}});
+        let mut new = old.clone();
+        new["procedural_core"]["modules"]["loot"]["base_drop_chance"] = serde_json::json!(0.2);
+
+        assert_eq!(changed_domains(Some(&old), &old), 0);
+        assert_eq!(changed_domains(Some(&old), &new), ConfigDomain::Loot.mask());
+        assert_eq!(changed_domains(None, &new), 0b1111);
+    }
+
+    #[test]
+    fn test_apply_config_bumps_changed_domains() {
+        let base =
+            serde_json::json!({"procedural_core": {"modules": {"monster": {"grammar_depth": 5}}}});
+        apply_config(base.clone());
+        let monsters = domain_generation(ConfigDomain::Monsters);
+        let loot = domain_generation(ConfigDomain::Loot);
+
+        let mut tuned = base;
+        tuned["procedural_core"]["modules"]["monster"]["grammar_depth"] = serde_json::json!(6);
+        assert_eq!(apply_config(tuned), ConfigDomain::Monsters.mask());
+        assert_eq!(domain_generation(ConfigDomain::Monsters), monsters + 1);
+        assert_eq!(domain_generation(ConfigDomain::Loot), loot);
+    }
+
     #[test]
     fn test_config_snapshot() {
         let snapshot = ConfigSnapshot {
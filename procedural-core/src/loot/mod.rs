@@ -48,6 +48,53 @@ pub struct LootItem {
     pub semantic_tags: Vec<(String, f32)>,
 }
 
+/// One kind of item loot can produce: what every drop of that name shares.
+/// Rarity, quantity and semantic tags are rolled per drop.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct ItemDefinition {
+    pub name: String,
+    pub category: LootCategory,
+    /// The element the name stands for, at full strength; empty for "Tower" items
+    pub tags: Vec<(String, f32)>,
+}
+
+/// Source tag that names a drop, and the name it gives
+const ELEMENT_NAMES: [(&str, &str); 6] = [
+    ("fire", "Ember"),
+    ("water", "Tide"),
+    ("earth", "Stone"),
+    ("wind", "Gale"),
+    ("void", "Void"),
+    ("corruption", "Shadow"),
+];
+
+/// Name of drops from sources without an element
+const NEUTRAL_ELEMENT_NAME: &str = "Tower";
+
+/// Every item `generate_loot` can produce, in a stable order (element, then
+/// loot table order), so clients can build a catalog once per core version
+/// and refer to items by index.
+pub fn item_catalog() -> Vec<ItemDefinition> {
+    // Tags that switch on every conditional table entry
+    let all_sources = SemanticTags::new(vec![("fire", 1.0), ("void", 1.0)]);
+    let table = build_loot_table(&all_sources, 1);
+
+    let elements = std::iter::once((None, NEUTRAL_ELEMENT_NAME))
+        .chain(ELEMENT_NAMES.iter().map(|(tag, name)| (Some(*tag), *name)));
+
+    let mut catalog = Vec::new();
+    for (tag, element_name) in elements {
+        for entry in &table {
+            catalog.push(ItemDefinition {
+                name: format!("{} {}", element_name, entry.name_prefix),
+                category: entry.category,
+                tags: tag.map(|t| vec![(t.to_string(), 1.0)]).unwrap_or_default(),
+            });
+        }
+    }
+    catalog
+}
+
 /// Loot table entry
 #[derive(Debug, Clone)]
 struct LootTableEntry {
@@ -213,28 +260,19 @@ fn roll_rarity(floor_level: u32, hash: u64) -> ItemRarity {
 }
 
 fn dominant_element_name(tags: &SemanticTags) -> &'static str {
-    let elements = [
-        ("fire", "Ember"),
-        ("water", "Tide"),
-        ("earth", "Stone"),
-        ("wind", "Gale"),
-        ("void", "Void"),
-        ("corruption", "Shadow"),
-    ];
-
     let mut best = ("", 0.0_f32);
-    for (tag, _name) in &elements {
+    for (tag, _name) in &ELEMENT_NAMES {
         let val = tags.get(tag);
         if val > best.1 {
             best = (tag, val);
         }
     }
 
-    elements
+    ELEMENT_NAMES
         .iter()
         .find(|(tag, _)| *tag == best.0)
         .map(|(_, name)| *name)
-        .unwrap_or("Tower")
+        .unwrap_or(NEUTRAL_ELEMENT_NAME)
 }
 
 fn xorshift(mut x: u64) -> u64 {
@@ -321,6 +359,39 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_item_catalog_covers_every_drop() {
+        let catalog = item_catalog();
+        let sources = [
+            SemanticTags::new(vec![("neutral", 0.5)]),
+            SemanticTags::new(vec![("fire", 0.9)]),
+            SemanticTags::new(vec![("water", 0.6), ("earth", 0.4)]),
+            SemanticTags::new(vec![("void", 0.8), ("corruption", 0.9)]),
+            SemanticTags::new(vec![("wind", 0.7)]),
+        ];
+
+        for tags in &sources {
+            for drop_hash in 0..200u64 {
+                for item in generate_loot(tags, 30, drop_hash * 7919 + 1) {
+                    let definition = catalog.iter().find(|d| d.name == item.name);
+                    assert!(definition.is_some(), "{} is not in the catalog", item.name);
+                    assert_eq!(definition.unwrap().category, item.category);
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_item_catalog_names_are_unique_and_stable() {
+        let catalog = item_catalog();
+        let mut names: Vec<&str> = catalog.iter().map(|d| d.name.as_str()).collect();
+        names.sort_unstable();
+        names.dedup();
+        assert_eq!(names.len(), catalog.len());
+        assert_eq!(catalog, item_catalog());
+        assert_eq!(catalog[0].name, "Tower Tower Shards");
+    }
+
     #[test]
     fn test_xorshift_nonzero() {
         let mut val = 1u64;
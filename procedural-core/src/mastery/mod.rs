@@ -573,29 +573,38 @@ impl SkillTree {
     }
 }
 
+/// XP amounts for common actions
+pub const ACTION_XP: &[(&str, u64)] = &[
+    ("attack_hit", 2),
+    ("combo_complete", 5),
+    ("parry_success", 8),
+    ("perfect_parry", 15),
+    ("dodge_success", 3),
+    ("block_success", 2),
+    ("aerial_kill", 10),
+    ("dive_attack_hit", 8),
+    ("craft_item", 10),
+    ("craft_rare", 25),
+    ("craft_legendary", 50),
+    ("gather_resource", 3),
+    ("gather_rare", 10),
+    ("trade_complete", 5),
+    ("explore_new_room", 5),
+    ("explore_secret", 20),
+    ("semantic_interaction", 4),
+    ("floor_clear", 15),
+];
+
+/// XP for an action not in `ACTION_XP`
+pub const DEFAULT_ACTION_XP: u64 = 1;
+
 /// XP amounts for common actions
 pub fn xp_for_action(action: &str) -> u64 {
-    match action {
-        "attack_hit" => 2,
-        "combo_complete" => 5,
-        "parry_success" => 8,
-        "perfect_parry" => 15,
-        "dodge_success" => 3,
-        "block_success" => 2,
-        "aerial_kill" => 10,
-        "dive_attack_hit" => 8,
-        "craft_item" => 10,
-        "craft_rare" => 25,
-        "craft_legendary" => 50,
-        "gather_resource" => 3,
-        "gather_rare" => 10,
-        "trade_complete" => 5,
-        "explore_new_room" => 5,
-        "explore_secret" => 20,
-        "semantic_interaction" => 4,
-        "floor_clear" => 15,
-        _ => 1,
-    }
+    ACTION_XP
+        .iter()
+        .find(|(name, _)| *name == action)
+        .map(|(_, xp)| *xp)
+        .unwrap_or(DEFAULT_ACTION_XP)
 }
 
 #[cfg(test)]
@@ -2,41 +2,153 @@
 #include "Sound/SoundCue.h"
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
 
 UTowerSoundManager::UTowerSoundManager()
 {
     PrimaryComponentTick.bCanEverTick = false;
+
+    auto AddLimit = [this](ESoundCategory Category, int32 MaxVoices, int32 Priority)
+    {
+        FTowerSoundVoiceLimit& Limit = VoiceLimits.Add(Category);
+        Limit.MaxVoices = MaxVoices;
+        Limit.Priority = Priority;
+    };
+
+    // Footsteps yield to anything; one-off stingers are rare and shouldn't be stolen
+    AddLimit(ESoundCategory::Footstep, 2, -1);
+    AddLimit(ESoundCategory::HitFlesh, 6, 0);
+    AddLimit(ESoundCategory::HitArmor, 6, 0);
+    AddLimit(ESoundCategory::CriticalHit, 2, 1);
+    AddLimit(ESoundCategory::Death, 1, 2);
+    AddLimit(ESoundCategory::LevelUp, 1, 2);
+    AddLimit(ESoundCategory::QuestComplete, 1, 2);
 }
 
 void UTowerSoundManager::BeginPlay()
 {
     Super::BeginPlay();
+
+    for (int32 i = 0; i < NumCategories; i++)
+    {
+        const FTowerSoundVoiceLimit* Limit = VoiceLimits.Find(static_cast<ESoundCategory>(i));
+        CategoryLimits[i] = Limit ? *Limit : DefaultVoiceLimit;
+        LastPlayTimes[i] = TNumericLimits<float>::Lowest();
+        LoadedCues[i] = nullptr;
+        bCueRequested[i] = false;
+    }
+
+    TArray<ESoundCategory> Categories;
+    SoundCues.GetKeys(Categories);
+    PreloadCues(Categories);
 }
 
 void UTowerSoundManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     StopFloorAmbience();
+
+    for (TSharedPtr<FStreamableHandle>& Handle : LoadHandles)
+    {
+        if (Handle.IsValid())
+        {
+            Handle->CancelHandle();
+        }
+    }
+    LoadHandles.Empty();
+
+    for (UAudioComponent* Voice : Voices)
+    {
+        if (IsValid(Voice))
+        {
+            Voice->Stop();
+            Voice->DestroyComponent();
+        }
+    }
+    Voices.Empty();
+    VoiceCategories.Empty();
+
     Super::EndPlay(EndPlayReason);
 }
 
-void UTowerSoundManager::PlaySound2D(ESoundCategory Category)
+// ============ Loading ============
+
+void UTowerSoundManager::PreloadCues(const TArray<ESoundCategory>& Categories)
 {
-    USoundCue** CuePtr = SoundCues.Find(Category);
-    if (!CuePtr || !*CuePtr) return;
+    TArray<FSoftObjectPath> ToLoad;
+    for (ESoundCategory Category : Categories)
+    {
+        const int32 Index = static_cast<int32>(Category);
+        if (Index >= NumCategories || LoadedCues[Index]) continue;
+
+        const TSoftObjectPtr<USoundCue>* Cue = SoundCues.Find(Category);
+        if (!Cue || Cue->IsNull()) continue;
 
-    // Anti-spam check
-    float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
-    float* LastTime = LastPlayTimes.Find(Category);
-    if (LastTime && (CurrentTime - *LastTime) < MinRepeatInterval)
+        bCueRequested[Index] = true;
+        ToLoad.AddUnique(Cue->ToSoftObjectPath());
+    }
+    if (ToLoad.Num() == 0) return;
+
+    TSharedPtr<FStreamableHandle> Handle = Streamable.RequestAsyncLoad(ToLoad,
+        FStreamableDelegate::CreateUObject(this, &UTowerSoundManager::ResolveLoadedCues));
+    if (Handle.IsValid())
     {
-        return;
+        LoadHandles.Add(Handle);
     }
-    LastPlayTimes.Add(Category, CurrentTime);
+
+    // Cues another asset already holds are in memory now
+    ResolveLoadedCues();
+}
+
+void UTowerSoundManager::ResolveLoadedCues()
+{
+    for (int32 i = 0; i < NumCategories; i++)
+    {
+        if (LoadedCues[i] || !bCueRequested[i]) continue;
+
+        if (const TSoftObjectPtr<USoundCue>* Cue = SoundCues.Find(static_cast<ESoundCategory>(i)))
+        {
+            LoadedCues[i] = Cue->Get();
+        }
+    }
+}
+
+USoundCue* UTowerSoundManager::FindCue(ESoundCategory Category)
+{
+    const int32 Index = static_cast<int32>(Category);
+    if (Index >= NumCategories) return nullptr;
+
+    if (!LoadedCues[Index] && !bCueRequested[Index])
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Sound cue for %s wasn't preloaded, loading it now"), *UEnum::GetValueAsString(Category));
+        PreloadCues({ Category });
+    }
+    return LoadedCues[Index];
+}
+
+// ============ Playback ============
+
+bool UTowerSoundManager::PassesRepeatInterval(ESoundCategory Category)
+{
+    const float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    float& LastTime = LastPlayTimes[static_cast<int32>(Category)];
+    if ((CurrentTime - LastTime) < MinRepeatInterval)
+    {
+        return false;
+    }
+    LastTime = CurrentTime;
+    return true;
+}
+
+void UTowerSoundManager::PlaySound2D(ESoundCategory Category)
+{
+    USoundCue* Cue = FindCue(Category);
+    if (!Cue || !PassesRepeatInterval(Category)) return;
 
     float Vol = GetEffectiveVolume(Category);
     float Pitch = 1.0f + FMath::FRandRange(-PitchVariation, PitchVariation);
 
-    UGameplayStatics::PlaySound2D(GetOwner(), *CuePtr, Vol, Pitch);
+    PlayOnVoice(Category, Cue, false, FVector::ZeroVector, Vol, Pitch);
 }
 
 void UTowerSoundManager::PlaySoundAtLocation(ESoundCategory Category, FVector Location)
@@ -47,26 +159,141 @@ void UTowerSoundManager::PlaySoundAtLocation(ESoundCategory Category, FVector Lo
 void UTowerSoundManager::PlaySoundWithParams(ESoundCategory Category, FVector Location,
     float PitchMultiplier, float VolumeMultiplier)
 {
-    USoundCue** CuePtr = SoundCues.Find(Category);
-    if (!CuePtr || !*CuePtr) return;
+    USoundCue* Cue = FindCue(Category);
+    if (!Cue || !PassesRepeatInterval(Category)) return;
 
-    // Anti-spam check
-    float CurrentTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
-    float* LastTime = LastPlayTimes.Find(Category);
-    if (LastTime && (CurrentTime - *LastTime) < MinRepeatInterval)
+    float Vol = GetEffectiveVolume(Category) * VolumeMultiplier;
+    Vol *= (1.0f + FMath::FRandRange(-VolumeVariation, VolumeVariation));
+
+    float Pitch = PitchMultiplier + FMath::FRandRange(-PitchVariation, PitchVariation);
+
+    PlayOnVoice(Category, Cue, true, Location, Vol, Pitch);
+}
+
+// ============ Voice Pool ============
+
+void UTowerSoundManager::PlayOnVoice(ESoundCategory Category, USoundCue* Cue, bool bSpatial,
+    const FVector& Location, float Volume, float Pitch)
+{
+    const int32 Index = AcquireVoice(Category, bSpatial, Location);
+    if (Index == INDEX_NONE)
     {
+        NumDropped++;
         return;
     }
-    LastPlayTimes.Add(Category, CurrentTime);
 
-    float Vol = GetEffectiveVolume(Category) * VolumeMultiplier;
-    Vol *= (1.0f + FMath::FRandRange(-VolumeVariation, VolumeVariation));
+    UAudioComponent* Voice = Voices[Index];
+    if (Voice->IsPlaying())
+    {
+        Voice->Stop();
+    }
 
-    float Pitch = PitchMultiplier + FMath::FRandRange(-PitchVariation, PitchVariation);
+    VoiceCategories[Index] = Category;
+    Voice->bAllowSpatialization = bSpatial;
+    Voice->bIsUISound = !bSpatial;
+    if (bSpatial)
+    {
+        Voice->SetWorldLocation(Location);
+    }
+    Voice->SetSound(Cue);
+    Voice->SetVolumeMultiplier(Volume);
+    Voice->SetPitchMultiplier(Pitch);
+    Voice->Play();
+}
+
+int32 UTowerSoundManager::AcquireVoice(ESoundCategory Category, bool bSpatial, const FVector& Location)
+{
+    FVector ListenerLocation = FVector::ZeroVector;
+    if (const APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr)
+    {
+        FVector Front, Right;
+        PC->GetAudioListenerPosition(ListenerLocation, Front, Right);
+    }
+
+    // 2D voices count as at the listener
+    auto GetDistSq = [&ListenerLocation](const UAudioComponent* Voice)
+    {
+        return Voice->bAllowSpatialization ? FVector::DistSquared(ListenerLocation, Voice->GetComponentLocation()) : 0.0;
+    };
+    const double NewDistSq = bSpatial ? FVector::DistSquared(ListenerLocation, Location) : 0.0;
 
-    UGameplayStatics::PlaySoundAtLocation(GetOwner(), *CuePtr, Location, Vol, Pitch);
+    int32 Free = INDEX_NONE;
+    int32 InCategory = 0;
+    int32 FurthestInCategory = INDEX_NONE;
+    double FurthestInCategoryDistSq = NewDistSq;
+    for (int32 i = 0; i < Voices.Num(); i++)
+    {
+        if (!Voices[i]->IsPlaying())
+        {
+            Free = i;
+            continue;
+        }
+        if (VoiceCategories[i] != Category) continue;
+
+        InCategory++;
+        const double DistSq = GetDistSq(Voices[i]);
+        if (DistSq > FurthestInCategoryDistSq)
+        {
+            FurthestInCategory = i;
+            FurthestInCategoryDistSq = DistSq;
+        }
+    }
+
+    // At the category's cap, whichever of the new sound and its furthest voice is further goes
+    const FTowerSoundVoiceLimit& Limit = CategoryLimits[static_cast<int32>(Category)];
+    if (Limit.MaxVoices > 0 && InCategory >= Limit.MaxVoices)
+    {
+        return FurthestInCategory;
+    }
+
+    if (Free != INDEX_NONE)
+    {
+        return Free;
+    }
+
+    if (Voices.Num() < MaxPooledVoices && GetOwner())
+    {
+        UAudioComponent* Voice = NewObject<UAudioComponent>(GetOwner());
+        Voice->bAutoActivate = false;
+        Voice->bAutoDestroy = false;
+        Voice->bStopWhenOwnerDestroyed = true;
+        Voice->SetUsingAbsoluteLocation(true);
+        Voice->RegisterComponent();
+
+        VoiceCategories.Add(Category);
+        return Voices.Add(Voice);
+    }
+
+    // Pool full: the furthest voice of the lowest priority not above ours
+    int32 Victim = INDEX_NONE;
+    int32 VictimPriority = Limit.Priority;
+    double VictimDistSq = NewDistSq;
+    for (int32 i = 0; i < Voices.Num(); i++)
+    {
+        const int32 Priority = CategoryLimits[static_cast<int32>(VoiceCategories[i])].Priority;
+        const double DistSq = GetDistSq(Voices[i]);
+        if (Priority < VictimPriority || (Priority == VictimPriority && DistSq > VictimDistSq))
+        {
+            Victim = i;
+            VictimPriority = Priority;
+            VictimDistSq = DistSq;
+        }
+    }
+    return Victim;
 }
 
+int32 UTowerSoundManager::GetNumActiveVoices() const
+{
+    int32 Active = 0;
+    for (const UAudioComponent* Voice : Voices)
+    {
+        Active += Voice->IsPlaying() ? 1 : 0;
+    }
+    return Active;
+}
+
+// ============ Ambient ============
+
 void UTowerSoundManager::StartFloorAmbience(int32 FloorLevel)
 {
     StopFloorAmbience();
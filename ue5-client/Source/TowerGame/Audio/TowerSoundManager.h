@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Containers/StaticArray.h"
+#include "Engine/StreamableManager.h"
 #include "TowerSoundManager.generated.h"
 
 class USoundCue;
@@ -58,6 +60,23 @@ enum class ESoundCategory : uint8
     MenuClose       UMETA(DisplayName = "Menu Close"),
     ButtonClick     UMETA(DisplayName = "Button Click"),
     QuestComplete   UMETA(DisplayName = "Quest Complete"),
+
+    Count           UMETA(Hidden),
+};
+
+/** How many voices one sound category may hold, and who wins when the pool is full */
+USTRUCT(BlueprintType)
+struct FTowerSoundVoiceLimit
+{
+    GENERATED_BODY()
+
+    /** Voices of the category playing at once; 0 for no cap below the pool size */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+    int32 MaxVoices = 4;
+
+    /** With every pooled voice busy, a sound may take the voice of a lower-or-equal priority one */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound")
+    int32 Priority = 0;
 };
 
 /**
@@ -73,6 +92,16 @@ enum class ESoundCategory : uint8
  * Sounds are played via SoundCue references set in Blueprint or
  * loaded at runtime. If no SoundCue is assigned for a category,
  * playback silently skips.
+ *
+ * Cues are soft references loaded asynchronously: BeginPlay requests all of
+ * them, and PreloadCues lets the floor ask for its set ahead of combat. A cue
+ * still loading is skipped, never loaded synchronously.
+ *
+ * One-shots play on a pool of at most MaxPooledVoices audio components rather
+ * than one spawned per event. Each category has a VoiceLimits budget: at its
+ * cap the new sound replaces the category's furthest voice from the listener
+ * if it is nearer, and is dropped otherwise. With the whole pool busy, it
+ * takes the furthest voice of the lowest priority no higher than its own.
  */
 UCLASS(ClassGroup = (Audio), meta = (BlueprintSpawnableComponent))
 class TOWERGAME_API UTowerSoundManager : public UActorComponent
@@ -99,6 +128,18 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Sound")
     void PlaySoundWithParams(ESoundCategory Category, FVector Location, float PitchMultiplier, float VolumeMultiplier);
 
+    /** Start loading the cues of Categories (the floor's set), so their first play isn't skipped */
+    UFUNCTION(BlueprintCallable, Category = "Sound")
+    void PreloadCues(const TArray<ESoundCategory>& Categories);
+
+    /** Pooled voices playing right now */
+    UFUNCTION(BlueprintPure, Category = "Sound")
+    int32 GetNumActiveVoices() const;
+
+    /** Sounds dropped by voice limits or the pool since BeginPlay */
+    UFUNCTION(BlueprintPure, Category = "Sound")
+    int32 GetNumDroppedSounds() const { return NumDropped; }
+
     // ============ Ambient ============
 
     /** Start ambient loop for the current floor */
@@ -129,9 +170,9 @@ public:
 
     // ============ Sound Cue Assignments ============
 
-    /** Map of sound categories to sound cues */
+    /** Map of sound categories to sound cues; read into a per-category table as they load */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound|Cues")
-    TMap<ESoundCategory, USoundCue*> SoundCues;
+    TMap<ESoundCategory, TSoftObjectPtr<USoundCue>> SoundCues;
 
     /** Ambient loop cue (per floor tier) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound|Cues")
@@ -155,6 +196,19 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound|Config")
     float MinRepeatInterval = 0.05f;
 
+    /** Audio components shared by every one-shot */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound|Config")
+    int32 MaxPooledVoices = 24;
+
+    /** Per-category voice budgets; categories not listed get DefaultVoiceLimit. Read at BeginPlay. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound|Config")
+    TMap<ESoundCategory, FTowerSoundVoiceLimit> VoiceLimits;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sound|Config")
+    FTowerSoundVoiceLimit DefaultVoiceLimit;
+
+    static constexpr int32 NumCategories = static_cast<int32>(ESoundCategory::Count);
+
 private:
     UPROPERTY()
     UAudioComponent* AmbientComponent;
@@ -163,8 +217,38 @@ private:
     float SFXVol = 0.8f;
     float MusicVol = 0.6f;
 
-    /** Last play time for each category (anti-spam) */
-    TMap<ESoundCategory, float> LastPlayTimes;
+    // Per category, indexed by ESoundCategory
+    TStaticArray<float, NumCategories> LastPlayTimes;
+    TStaticArray<FTowerSoundVoiceLimit, NumCategories> CategoryLimits;
+
+    /** Loaded cues; kept alive by LoadHandles */
+    TStaticArray<USoundCue*, NumCategories> LoadedCues;
+    TStaticArray<bool, NumCategories> bCueRequested;
+
+    // Per pooled voice
+    UPROPERTY()
+    TArray<UAudioComponent*> Voices;
+    TArray<ESoundCategory> VoiceCategories;
+
+    int32 NumDropped = 0;
+
+    FStreamableManager Streamable;
+    TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+
+    /** The category's cue if loaded; otherwise null, with a load started */
+    USoundCue* FindCue(ESoundCategory Category);
+
+    /** Copy newly loaded cues into LoadedCues */
+    void ResolveLoadedCues();
+
+    /** Anti-spam check; records the play when it passes */
+    bool PassesRepeatInterval(ESoundCategory Category);
+
+    /** Start Cue on a pooled voice, or drop it if the category's limit or the pool says no */
+    void PlayOnVoice(ESoundCategory Category, USoundCue* Cue, bool bSpatial, const FVector& Location, float Volume, float Pitch);
+
+    /** Index into Voices to play on, or INDEX_NONE to drop the sound */
+    int32 AcquireVoice(ESoundCategory Category, bool bSpatial, const FVector& Location);
 
     /** Get effective volume for a category */
     float GetEffectiveVolume(ESoundCategory Category) const;
@@ -0,0 +1,143 @@
+#include "FFIMarshalling.h"
+#include "FFIProfiler.h"
+#include "Core/TowerMemory.h"
+
+namespace
+{
+    constexpr int32 OutputBufferInitialSize = 4 * 1024;
+    constexpr int32 OutputBufferTrimSize = 64 * 1024;
+
+    thread_local TowerFFI::FArgArena GArgArena;
+    thread_local TArray<UTF8CHAR> GOutputBuffer;
+    thread_local FTowerMemoryReport GScratchMemory(ETowerMemoryBucket::FFI);
+
+    /** Re-measure this thread's scratch after it grew or was trimmed */
+    void ReportScratchMemory()
+    {
+        GScratchMemory.Set(GArgArena.GetAllocatedSize() + GOutputBuffer.GetAllocatedSize());
+    }
+}
+
+// ============ Arg Arena ============
+
+TowerFFI::FArgArena& TowerFFI::FArgArena::Get()
+{
+    return GArgArena;
+}
+
+UTF8CHAR* TowerFFI::FArgArena::Alloc(int32 Bytes)
+{
+    // Move on to the next block (or a dedicated one for an oversized arg) when this one is full
+    while (!Blocks.IsValidIndex(CurrentBlock) || CurrentOffset + Bytes > Blocks[CurrentBlock].Size)
+    {
+        if (Blocks.IsValidIndex(CurrentBlock))
+        {
+            ++CurrentBlock;
+            CurrentOffset = 0;
+        }
+
+        if (!Blocks.IsValidIndex(CurrentBlock))
+        {
+            LLM_SCOPE_BYTAG(Tower_FFI);
+            FBlock& Block = Blocks.AddDefaulted_GetRef();
+            Block.Size = FMath::Max(BlockSize, Bytes);
+            Block.Data = MakeUnique<UTF8CHAR[]>(Block.Size);
+            ReportScratchMemory();
+        }
+        else if (Blocks[CurrentBlock].Size < Bytes)
+        {
+            // Too small for this arg and nothing lives in it; enlarge in place
+            LLM_SCOPE_BYTAG(Tower_FFI);
+            FBlock& Block = Blocks[CurrentBlock];
+            Block.Size = Bytes;
+            Block.Data = MakeUnique<UTF8CHAR[]>(Block.Size);
+            ReportScratchMemory();
+        }
+    }
+
+    UTF8CHAR* Result = Blocks[CurrentBlock].Data.Get() + CurrentOffset;
+    CurrentOffset += Bytes;
+    return Result;
+}
+
+void TowerFFI::FArgArena::Trim()
+{
+    check(CurrentBlock == 0 && CurrentOffset == 0);
+    if (Blocks.Num() > 1)
+    {
+        Blocks.SetNum(1);
+    }
+    if (Blocks.Num() == 1 && Blocks[0].Size > BlockSize)
+    {
+        Blocks.Reset();
+    }
+}
+
+int64 TowerFFI::FArgArena::GetAllocatedSize() const
+{
+    int64 Bytes = Blocks.GetAllocatedSize();
+    for (const FBlock& Block : Blocks)
+    {
+        Bytes += Block.Size * sizeof(UTF8CHAR);
+    }
+    return Bytes;
+}
+
+// ============ Output Buffer ============
+
+TArray<UTF8CHAR>& TowerFFI::GetOutputBuffer(int32 MinSize)
+{
+    const int32 Wanted = FMath::Max(MinSize, OutputBufferInitialSize);
+    if (GOutputBuffer.Num() < Wanted)
+    {
+        LLM_SCOPE_BYTAG(Tower_FFI);
+        GOutputBuffer.SetNumUninitialized(Wanted);
+        ReportScratchMemory();
+    }
+    return GOutputBuffer;
+}
+
+void TowerFFI::TrimThreadScratch()
+{
+    GArgArena.Trim();
+    if (GOutputBuffer.Num() > OutputBufferTrimSize)
+    {
+        GOutputBuffer.Empty();
+    }
+    ReportScratchMemory();
+}
+
+// ============ FRustArg ============
+
+FRustArg::FRustArg(const TCHAR* Str)
+    : Mark(TowerFFI::FArgArena::Get().GetMark())
+{
+    const int32 SrcLen = FCString::Strlen(Str);
+    Len = FPlatformString::ConvertedLength<UTF8CHAR>(Str, SrcLen);
+    Data = TowerFFI::FArgArena::Get().Alloc(Len + 1);
+    FPlatformString::Convert(Data, Len, Str, SrcLen);
+    Data[Len] = UTF8CHAR('\0');
+
+    if (FTowerFFIProfiler::IsEnabled())
+    {
+        FTowerFFIProfiler::AddBytesIn(Len);
+    }
+}
+
+// ============ FRustStringView ============
+
+FRustStringView::FRustStringView(char* InStr, FFreeFunc InFree)
+    : Str(InStr)
+    , FreeFn(InFree)
+{
+    if (Str)
+    {
+        const int32 Len = FCStringAnsi::Strlen(Str);
+        View = FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Str), Len);
+
+        if (FTowerFFIProfiler::IsEnabled())
+        {
+            FTowerFFIProfiler::AddRustString(Len);
+        }
+    }
+}
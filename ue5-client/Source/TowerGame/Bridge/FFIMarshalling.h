@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Scratch memory for FProceduralCoreBridge marshalling, one set per thread.
+ *
+ * Arguments (FRustArg) are encoded into a LIFO arena of fixed blocks that are kept
+ * between calls, so a steady state bridge call allocates nothing for its inputs.
+ * Results of the *_into exports are written by Rust straight into a reusable
+ * output buffer and handed out as a UTF-8 view. A view is only valid until the
+ * next bridge call on the same thread; callers that keep the text copy it.
+ */
+namespace TowerFFI
+{
+    /** Stack-style allocator behind FRustArg; blocks never move, so earlier args stay valid */
+    class FArgArena
+    {
+    public:
+        struct FMark
+        {
+            int32 Block = 0;
+            int32 Offset = 0;
+        };
+
+        FMark GetMark() const { return FMark{ CurrentBlock, CurrentOffset }; }
+        void PopTo(const FMark& Mark)
+        {
+            CurrentBlock = Mark.Block;
+            CurrentOffset = Mark.Offset;
+        }
+
+        UTF8CHAR* Alloc(int32 Bytes);
+
+        /** Free blocks beyond the first once a burst has passed; nothing may be allocated */
+        void Trim();
+
+        /** Bytes held in blocks */
+        int64 GetAllocatedSize() const;
+
+        static FArgArena& Get();
+
+    private:
+        static constexpr int32 BlockSize = 16 * 1024;
+
+        struct FBlock
+        {
+            TUniquePtr<UTF8CHAR[]> Data;
+            int32 Size = 0;
+        };
+
+        TArray<FBlock> Blocks;
+        int32 CurrentBlock = 0;
+        int32 CurrentOffset = 0;
+    };
+
+    /**
+     * Call Export(Buffer, Capacity) -> required length against this thread's output
+     * buffer, growing it and calling again if the result didn't fit. Empty view on
+     * failure (0 returned).
+     */
+    template <typename ExportType>
+    FUtf8StringView CallInto(ExportType&& Export);
+
+    /** This thread's output buffer, grown to at least MinSize */
+    TArray<UTF8CHAR>& GetOutputBuffer(int32 MinSize);
+
+    /**
+     * Give back memory the calling thread's scratch grew to during a burst (e.g. a
+     * floor load). Must not run inside a bridge call; the bridge does it for the
+     * game thread at the end of every frame.
+     */
+    void TrimThreadScratch();
+}
+
+/** UTF-8 argument for a Rust call, encoded into the thread's arg arena; counted as marshalled-in bytes */
+class FRustArg
+{
+public:
+    explicit FRustArg(const TCHAR* Str);
+    ~FRustArg() { TowerFFI::FArgArena::Get().PopTo(Mark); }
+
+    FRustArg(const FRustArg&) = delete;
+    FRustArg& operator=(const FRustArg&) = delete;
+
+    const ANSICHAR* Get() const { return reinterpret_cast<const ANSICHAR*>(Data); }
+    int32 Length() const { return Len; }
+
+private:
+    TowerFFI::FArgArena::FMark Mark;
+    UTF8CHAR* Data = nullptr;
+    int32 Len = 0;
+};
+
+/** Owns a Rust-allocated string (freed on destruction) and exposes it without converting to FString */
+class FRustStringView
+{
+public:
+    typedef void (*FFreeFunc)(char*);
+
+    FRustStringView(char* InStr, FFreeFunc InFree);
+    ~FRustStringView()
+    {
+        if (Str && FreeFn) FreeFn(Str);
+    }
+
+    FRustStringView(const FRustStringView&) = delete;
+    FRustStringView& operator=(const FRustStringView&) = delete;
+
+    bool IsValid() const { return Str != nullptr; }
+    FUtf8StringView GetView() const { return View; }
+
+private:
+    char* Str = nullptr;
+    FFreeFunc FreeFn = nullptr;
+    FUtf8StringView View;
+};
+
+template <typename ExportType>
+FUtf8StringView TowerFFI::CallInto(ExportType&& Export)
+{
+    TArray<UTF8CHAR>& Buffer = GetOutputBuffer(0);
+    SIZE_T Required = Export(reinterpret_cast<uint8*>(Buffer.GetData()), static_cast<SIZE_T>(Buffer.Num()));
+    if (Required > static_cast<SIZE_T>(Buffer.Num()) && Required <= MAX_int32)
+    {
+        GetOutputBuffer(static_cast<int32>(Required));
+        Required = Export(reinterpret_cast<uint8*>(Buffer.GetData()), static_cast<SIZE_T>(Buffer.Num()));
+    }
+
+    if (Required == 0 || Required > static_cast<SIZE_T>(Buffer.Num()))
+    {
+        return FUtf8StringView();
+    }
+    return FUtf8StringView(Buffer.GetData(), static_cast<int32>(Required));
+}
@@ -0,0 +1,184 @@
+#include "FFIProfiler.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+
+std::atomic<bool> FTowerFFIProfiler::bEnabled{ false };
+std::atomic<FTowerFFIFunctionStats*> FTowerFFIProfiler::Head{ nullptr };
+
+static thread_local FTowerFFIFunctionStats* GCurrentFFIStats = nullptr;
+
+static TAutoConsoleVariable<int32> CVarFFIProfile(
+    TEXT("tower.FFIProfile"),
+    0,
+    TEXT("Count calls, time and marshalled bytes per tower_core.dll wrapper (see tower.FFIProfile.Dump).\n")
+    TEXT("0 = off, 1 = on"),
+    FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Var)
+    {
+        FTowerFFIProfiler::SetEnabled(Var->GetInt() != 0);
+    }),
+    ECVF_Default);
+
+namespace
+{
+    FAutoConsoleCommand DumpFFIProfileCommand(
+        TEXT("tower.FFIProfile.Dump"),
+        TEXT("Log the FFI profile as JSON and write it to Saved/Profiling/TowerFFI-<time>.json"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            const FString Json = FTowerFFIProfiler::ToJson();
+            const FString Path = FPaths::Combine(FPaths::ProfilingDir(),
+                FString::Printf(TEXT("TowerFFI-%s.json"), *FDateTime::Now().ToString()));
+
+            UE_LOG(LogTemp, Log, TEXT("TowerFFI profile:\n%s"), *Json);
+            if (FFileHelper::SaveStringToFile(Json, *Path))
+            {
+                UE_LOG(LogTemp, Log, TEXT("TowerFFI profile written to %s"), *Path);
+            }
+        }));
+
+    FAutoConsoleCommand ResetFFIProfileCommand(
+        TEXT("tower.FFIProfile.Reset"),
+        TEXT("Zero the FFI profile counters"),
+        FConsoleCommandDelegate::CreateStatic(&FTowerFFIProfiler::Reset));
+
+    void AtomicMax(std::atomic<uint64>& Target, uint64 Value)
+    {
+        uint64 Current = Target.load(std::memory_order_relaxed);
+        while (Value > Current && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+// ============ Registration ============
+
+FTowerFFIFunctionStats::FTowerFFIFunctionStats(const TCHAR* InName)
+    : Name(InName)
+{
+    FTowerFFIFunctionStats* OldHead = FTowerFFIProfiler::Head.load(std::memory_order_relaxed);
+    do
+    {
+        Next = OldHead;
+    }
+    while (!FTowerFFIProfiler::Head.compare_exchange_weak(OldHead, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// ============ Scope ============
+
+void FTowerFFIScope::Begin(FTowerFFIFunctionStats& InStats)
+{
+    Stats = &InStats;
+    Outer = GCurrentFFIStats;
+    GCurrentFFIStats = Stats;
+    StartCycles = FPlatformTime::Cycles64();
+}
+
+void FTowerFFIScope::End()
+{
+    const uint64 Elapsed = FPlatformTime::Cycles64() - StartCycles;
+    Stats->Calls.fetch_add(1, std::memory_order_relaxed);
+    Stats->TotalCycles.fetch_add(Elapsed, std::memory_order_relaxed);
+    AtomicMax(Stats->MaxCycles, Elapsed);
+    GCurrentFFIStats = Outer;
+}
+
+FTowerFFIFunctionStats* FTowerFFIScope::GetCurrent()
+{
+    return GCurrentFFIStats;
+}
+
+// ============ Profiler ============
+
+void FTowerFFIProfiler::SetEnabled(bool bInEnabled)
+{
+    bEnabled.store(bInEnabled, std::memory_order_relaxed);
+}
+
+void FTowerFFIProfiler::AddBytesIn(int64 Bytes)
+{
+    if (FTowerFFIFunctionStats* Current = GCurrentFFIStats)
+    {
+        Current->BytesIn.fetch_add(static_cast<uint64>(Bytes), std::memory_order_relaxed);
+    }
+}
+
+void FTowerFFIProfiler::AddBytesOut(int64 Bytes)
+{
+    if (FTowerFFIFunctionStats* Current = GCurrentFFIStats)
+    {
+        Current->BytesOut.fetch_add(static_cast<uint64>(Bytes), std::memory_order_relaxed);
+    }
+}
+
+void FTowerFFIProfiler::AddRustString(int64 Bytes)
+{
+    if (FTowerFFIFunctionStats* Current = GCurrentFFIStats)
+    {
+        Current->RustStrings.fetch_add(1, std::memory_order_relaxed);
+        Current->BytesOut.fetch_add(static_cast<uint64>(Bytes), std::memory_order_relaxed);
+    }
+}
+
+void FTowerFFIProfiler::Reset()
+{
+    for (FTowerFFIFunctionStats* Stats = GetHead(); Stats; Stats = Stats->Next)
+    {
+        Stats->Calls.store(0, std::memory_order_relaxed);
+        Stats->TotalCycles.store(0, std::memory_order_relaxed);
+        Stats->MaxCycles.store(0, std::memory_order_relaxed);
+        Stats->BytesIn.store(0, std::memory_order_relaxed);
+        Stats->BytesOut.store(0, std::memory_order_relaxed);
+        Stats->RustStrings.store(0, std::memory_order_relaxed);
+    }
+}
+
+FString FTowerFFIProfiler::ToJson()
+{
+    TArray<const FTowerFFIFunctionStats*> Called;
+    for (const FTowerFFIFunctionStats* Stats = GetHead(); Stats; Stats = Stats->Next)
+    {
+        if (Stats->Calls.load(std::memory_order_relaxed) > 0)
+        {
+            Called.Add(Stats);
+        }
+    }
+    Called.Sort([](const FTowerFFIFunctionStats& A, const FTowerFFIFunctionStats& B)
+    {
+        return A.TotalCycles.load(std::memory_order_relaxed) > B.TotalCycles.load(std::memory_order_relaxed);
+    });
+
+    TArray<TSharedPtr<FJsonValue>> Functions;
+    double TotalMs = 0.0;
+    for (const FTowerFFIFunctionStats* Stats : Called)
+    {
+        const uint64 Calls = Stats->Calls.load(std::memory_order_relaxed);
+        const double FuncTotalMs = FPlatformTime::ToMilliseconds64(Stats->TotalCycles.load(std::memory_order_relaxed));
+        TotalMs += FuncTotalMs;
+
+        TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+        Obj->SetStringField(TEXT("name"), Stats->Name);
+        Obj->SetNumberField(TEXT("calls"), static_cast<double>(Calls));
+        Obj->SetNumberField(TEXT("total_ms"), FuncTotalMs);
+        Obj->SetNumberField(TEXT("avg_us"), FuncTotalMs * 1000.0 / static_cast<double>(Calls));
+        Obj->SetNumberField(TEXT("max_us"), FPlatformTime::ToMilliseconds64(Stats->MaxCycles.load(std::memory_order_relaxed)) * 1000.0);
+        Obj->SetNumberField(TEXT("bytes_in"), static_cast<double>(Stats->BytesIn.load(std::memory_order_relaxed)));
+        Obj->SetNumberField(TEXT("bytes_out"), static_cast<double>(Stats->BytesOut.load(std::memory_order_relaxed)));
+        Obj->SetNumberField(TEXT("rust_strings"), static_cast<double>(Stats->RustStrings.load(std::memory_order_relaxed)));
+        Functions.Add(MakeShared<FJsonValueObject>(Obj));
+    }
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetBoolField(TEXT("enabled"), IsEnabled());
+    Root->SetNumberField(TEXT("total_ms"), TotalMs);
+    Root->SetArrayField(TEXT("functions"), Functions);
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+    return Json;
+}
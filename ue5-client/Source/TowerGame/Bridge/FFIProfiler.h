@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Core/PerfCounters.h"
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("TowerFFI"), STATGROUP_TowerFFI, STATCAT_Advanced);
+
+/**
+ * Counters for one FProceduralCoreBridge wrapper. Instances are function-local
+ * statics created by TOWER_FFI_SCOPE and chained into a global list on first use;
+ * they are never destroyed before shutdown. Updated with relaxed atomics, so
+ * wrappers may be profiled from any thread.
+ */
+struct TOWERGAME_API FTowerFFIFunctionStats
+{
+    explicit FTowerFFIFunctionStats(const TCHAR* InName);
+
+    const TCHAR* Name;
+    std::atomic<uint64> Calls{ 0 };
+    std::atomic<uint64> TotalCycles{ 0 };
+    std::atomic<uint64> MaxCycles{ 0 };
+    std::atomic<uint64> BytesIn{ 0 };
+    std::atomic<uint64> BytesOut{ 0 };
+    std::atomic<uint64> RustStrings{ 0 };
+
+    FTowerFFIFunctionStats* Next = nullptr;
+};
+
+/**
+ * Process-wide FFI profiling switch and report.
+ *
+ * Counting is off unless tower.FFIProfile is 1; when off a wrapper pays one relaxed
+ * load. The stat TowerFFI group and the Insights CPU scopes are independent of it
+ * and cost whatever stats / trace cost when their channel is off.
+ */
+class TOWERGAME_API FTowerFFIProfiler
+{
+public:
+    static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool bInEnabled);
+
+    /** Attribute marshalled bytes / a freed Rust string to the innermost active scope on this thread */
+    static void AddBytesIn(int64 Bytes);
+    static void AddBytesOut(int64 Bytes);
+    static void AddRustString(int64 Bytes);
+
+    /** Zero every counter */
+    static void Reset();
+
+    /** Every function called at least once, sorted by total time */
+    static FString ToJson();
+
+    static FTowerFFIFunctionStats* GetHead() { return Head.load(std::memory_order_acquire); }
+
+private:
+    friend struct FTowerFFIFunctionStats;
+    friend class FTowerFFIScope;
+
+    static std::atomic<bool> bEnabled;
+    static std::atomic<FTowerFFIFunctionStats*> Head;
+};
+
+/** RAII timer behind TOWER_FFI_SCOPE; nests (inner wrappers count separately and inside the outer) */
+class TOWERGAME_API FTowerFFIScope
+{
+public:
+    explicit FTowerFFIScope(FTowerFFIFunctionStats& InStats)
+    {
+        if (FTowerFFIProfiler::IsEnabled())
+        {
+            Begin(InStats);
+        }
+    }
+
+    ~FTowerFFIScope()
+    {
+        if (Stats)
+        {
+            End();
+        }
+    }
+
+    /** Innermost active scope on this thread's stats, or null */
+    static FTowerFFIFunctionStats* GetCurrent();
+
+private:
+    void Begin(FTowerFFIFunctionStats& InStats);
+    void End();
+
+    FTowerFFIFunctionStats* Stats = nullptr;
+    FTowerFFIFunctionStats* Outer = nullptr;
+    uint64 StartCycles = 0;
+};
+
+/**
+ * First statement of every bridge wrapper: stat TowerFFI cycle counter, Insights
+ * CPU scope and the FTowerFFIProfiler counters, all named after the wrapper, and
+ * the perf capture's per-frame FFI time.
+ */
+#define TOWER_FFI_SCOPE(FuncName) \
+    DECLARE_SCOPE_CYCLE_COUNTER(TEXT(#FuncName), STAT_TowerFFI_##FuncName, STATGROUP_TowerFFI); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFFI_##FuncName); \
+    static FTowerFFIFunctionStats TowerFFIStats_##FuncName(TEXT(#FuncName)); \
+    FTowerFFIScope TowerFFIScope_##FuncName(TowerFFIStats_##FuncName); \
+    TOWER_PERF_SCOPE(FFI)
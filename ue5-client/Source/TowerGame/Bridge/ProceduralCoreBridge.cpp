@@ -1,10 +1,38 @@
 #include "ProceduralCoreBridge.h"
+#include "FFIProfiler.h"
+#include "FFIMarshalling.h"
+#include "Misc/CoreDelegates.h"
+#include "HAL/IConsoleManager.h"
 #include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 
 #define LOAD_DLL_FUNC(FuncName, FuncType, ExportName) \
     Fn_##FuncName = (FuncType)FPlatformProcess::GetDllExport(DllHandle, TEXT(ExportName)); \
     if (!Fn_##FuncName) { UE_LOG(LogTemp, Warning, TEXT("Failed to load: %s"), TEXT(ExportName)); }
 
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<int32> CVarVerifyLookupTables(
+    TEXT("tower.FFI.VerifyLookupTables"),
+    UE_BUILD_DEBUG ? 1 : 0,
+    TEXT("Also ask Rust for every angle multiplier, floor tier and action XP answered from the\n")
+    TEXT("bridge's lookup tables, and ensure the two agree. 0 = off, 1 = on"),
+    ECVF_Default);
+
+static bool ShouldVerifyLookupTables()
+{
+    return CVarVerifyLookupTables.GetValueOnAnyThread() != 0;
+}
+#else
+static constexpr bool ShouldVerifyLookupTables()
+{
+    return false;
+}
+#endif
+
 FProceduralCoreBridge::FProceduralCoreBridge()
 {
 }
@@ -36,25 +64,33 @@ bool FProceduralCoreBridge::Initialize(const FString& DllPath)
     // ---- Floor Generation ----
     LOAD_DLL_FUNC(GenerateFloor, FnGenerateFloor, "generate_floor");
     LOAD_DLL_FUNC(GenerateFloorLayout, FnGenerateFloorLayout, "generate_floor_layout");
+    LOAD_DLL_FUNC(GenerateFloorLayoutBinary, FnGenerateFloorLayoutBinary, "generate_floor_layout_binary");
     LOAD_DLL_FUNC(GetFloorHash, FnGetFloorHash, "get_floor_hash");
     LOAD_DLL_FUNC(GetFloorTier, FnGetFloorTier, "get_floor_tier");
 
     // ---- Monster Generation ----
     LOAD_DLL_FUNC(GenerateMonster, FnGenerateMonster, "generate_monster");
     LOAD_DLL_FUNC(GenerateFloorMonsters, FnGenerateFloorMonsters, "generate_floor_monsters");
+    LOAD_DLL_FUNC(GenerateFloorMonstersInto, FnGenerateFloorMonstersInto, "generate_floor_monsters_into");
 
     // ---- Combat ----
     LOAD_DLL_FUNC(GetAngleMultiplier, FnGetAngleMultiplier, "get_angle_multiplier");
     LOAD_DLL_FUNC(CalculateCombat, FnCalculateCombat, "calculate_combat");
+    LOAD_DLL_FUNC(CalculateCombatInto, FnCalculateCombatInto, "calculate_combat_into");
+    LOAD_DLL_FUNC(CalculateCombatBatch, FnCalculateCombatBatch, "calculate_combat_batch");
 
     // ---- Semantic ----
     LOAD_DLL_FUNC(SemanticSimilarity, FnSemanticSimilarity, "semantic_similarity");
 
     // ---- Loot ----
     LOAD_DLL_FUNC(GenerateLoot, FnGenerateLoot, "generate_loot");
+    LOAD_DLL_FUNC(GenerateLootBatch, FnGenerateLootBatch, "generate_loot_batch");
+    LOAD_DLL_FUNC(GetItemCatalog, FnGetItemCatalog, "get_item_catalog");
 
     // ---- World ----
     LOAD_DLL_FUNC(GetBreathState, FnGetBreathState, "get_breath_state");
+    LOAD_DLL_FUNC(GetBreathStateInto, FnGetBreathStateInto, "get_breath_state_into");
+    LOAD_DLL_FUNC(GetBreathCycle, FnGetBreathCycle, "get_breath_cycle");
 
     // ---- Replication ----
     LOAD_DLL_FUNC(RecordDelta, FnRecordDelta, "record_delta");
@@ -68,6 +104,7 @@ bool FProceduralCoreBridge::Initialize(const FString& DllPath)
     LOAD_DLL_FUNC(MasteryGainXp, FnMasteryGainXp, "mastery_gain_xp");
     LOAD_DLL_FUNC(MasteryGetTier, FnMasteryGetTier, "mastery_get_tier");
     LOAD_DLL_FUNC(MasteryXpForAction, FnMasteryXpForAction, "mastery_xp_for_action");
+    LOAD_DLL_FUNC(MasteryGetActionXpTable, FnMasteryGetActionXpTable, "mastery_get_action_xp_table");
     LOAD_DLL_FUNC(MasteryGetAllDomains, FnMasteryGetAllDomains, "mastery_get_all_domains");
 
     // ---- Specialization ----
@@ -98,6 +135,39 @@ bool FProceduralCoreBridge::Initialize(const FString& DllPath)
     LOAD_DLL_FUNC(CosmeticApplyTransmog, FnCosmeticApplyTransmog, "cosmetic_apply_transmog");
     LOAD_DLL_FUNC(CosmeticApplyDye, FnCosmeticApplyDye, "cosmetic_apply_dye");
 
+    // ---- Profile Handles ----
+    LOAD_DLL_FUNC(MasteryHandleCreate, FnMasteryHandleCreate, "mastery_handle_create");
+    LOAD_DLL_FUNC(MasteryHandleLoad, FnMasteryHandleLoad, "mastery_handle_load");
+    LOAD_DLL_FUNC(MasteryHandleRelease, FnMasteryHandleRelease, "mastery_handle_release");
+    LOAD_DLL_FUNC(MasteryHandleToJson, FnMasteryHandleToJson, "mastery_handle_to_json");
+    LOAD_DLL_FUNC(MasteryHandleGainXp, FnMasteryHandleGainXp, "mastery_handle_gain_xp");
+    LOAD_DLL_FUNC(MasteryHandleGetTier, FnMasteryHandleGetTier, "mastery_handle_get_tier");
+    LOAD_DLL_FUNC(MasteryHandleGetXp, FnMasteryHandleGetXp, "mastery_handle_get_xp");
+    LOAD_DLL_FUNC(SpecHandleCreate, FnSpecHandleCreate, "spec_handle_create");
+    LOAD_DLL_FUNC(SpecHandleLoad, FnSpecHandleLoad, "spec_handle_load");
+    LOAD_DLL_FUNC(SpecHandleRelease, FnSpecHandleRelease, "spec_handle_release");
+    LOAD_DLL_FUNC(SpecHandleToJson, FnSpecHandleToJson, "spec_handle_to_json");
+    LOAD_DLL_FUNC(SpecHandleChooseBranch, FnSpecHandleChooseBranch, "spec_handle_choose_branch");
+    LOAD_DLL_FUNC(AbilityHandleCreate, FnAbilityHandleCreate, "ability_handle_create");
+    LOAD_DLL_FUNC(AbilityHandleLoad, FnAbilityHandleLoad, "ability_handle_load");
+    LOAD_DLL_FUNC(AbilityHandleRelease, FnAbilityHandleRelease, "ability_handle_release");
+    LOAD_DLL_FUNC(AbilityHandleToJson, FnAbilityHandleToJson, "ability_handle_to_json");
+    LOAD_DLL_FUNC(AbilityHandleLearn, FnAbilityHandleLearn, "ability_handle_learn");
+    LOAD_DLL_FUNC(AbilityHandleEquip, FnAbilityHandleEquip, "ability_handle_equip");
+    LOAD_DLL_FUNC(CosmeticHandleCreate, FnCosmeticHandleCreate, "cosmetic_handle_create");
+    LOAD_DLL_FUNC(CosmeticHandleLoad, FnCosmeticHandleLoad, "cosmetic_handle_load");
+    LOAD_DLL_FUNC(CosmeticHandleRelease, FnCosmeticHandleRelease, "cosmetic_handle_release");
+    LOAD_DLL_FUNC(CosmeticHandleToJson, FnCosmeticHandleToJson, "cosmetic_handle_to_json");
+    LOAD_DLL_FUNC(CosmeticHandleUnlock, FnCosmeticHandleUnlock, "cosmetic_handle_unlock");
+    LOAD_DLL_FUNC(CosmeticHandleApplyTransmog, FnCosmeticHandleApplyTransmog, "cosmetic_handle_apply_transmog");
+    LOAD_DLL_FUNC(CosmeticHandleApplyDye, FnCosmeticHandleApplyDye, "cosmetic_handle_apply_dye");
+    LOAD_DLL_FUNC(AchievementHandleCreate, FnAchievementHandleCreate, "achievement_handle_create");
+    LOAD_DLL_FUNC(AchievementHandleLoad, FnAchievementHandleLoad, "achievement_handle_load");
+    LOAD_DLL_FUNC(AchievementHandleRelease, FnAchievementHandleRelease, "achievement_handle_release");
+    LOAD_DLL_FUNC(AchievementHandleToJson, FnAchievementHandleToJson, "achievement_handle_to_json");
+    LOAD_DLL_FUNC(AchievementHandleApply, FnAchievementHandleApply, "achievement_handle_apply");
+    LOAD_DLL_FUNC(AchievementHandleCompletionPercent, FnAchievementHandleCompletionPercent, "achievement_handle_completion_percent");
+
     // ---- Tutorial ----
     LOAD_DLL_FUNC(TutorialGetSteps, FnTutorialGetSteps, "tutorial_get_steps");
     LOAD_DLL_FUNC(TutorialGetHints, FnTutorialGetHints, "tutorial_get_hints");
@@ -136,14 +206,17 @@ bool FProceduralCoreBridge::Initialize(const FString& DllPath)
     // ---- Hot-Reload (v0.6.0) ----
     LOAD_DLL_FUNC(HotReloadGetStatus, FnHotReloadGetStatus, "hotreload_get_status");
     LOAD_DLL_FUNC(HotReloadTriggerReload, FnHotReloadTriggerReload, "hotreload_trigger_reload");
+    LOAD_DLL_FUNC(HotReloadGetDomainGenerations, FnHotReloadGetDomainGenerations, "hotreload_get_domain_generations");
 
     // ---- Analytics (v0.6.0) ----
     LOAD_DLL_FUNC(AnalyticsGetSnapshot, FnAnalyticsGetSnapshot, "analytics_get_snapshot");
     LOAD_DLL_FUNC(AnalyticsReset, FnAnalyticsReset, "analytics_reset");
     LOAD_DLL_FUNC(AnalyticsRecordDamage, FnAnalyticsRecordDamage, "analytics_record_damage");
+    LOAD_DLL_FUNC(AnalyticsRecordDamageBatch, FnAnalyticsRecordDamageBatch, "analytics_record_damage_batch");
     LOAD_DLL_FUNC(AnalyticsRecordFloorCleared, FnAnalyticsRecordFloorCleared, "analytics_record_floor_cleared");
     LOAD_DLL_FUNC(AnalyticsRecordGold, FnAnalyticsRecordGold, "analytics_record_gold");
     LOAD_DLL_FUNC(AnalyticsGetEventTypes, FnAnalyticsGetEventTypes, "analytics_get_event_types");
+    LOAD_DLL_FUNC(AnalyticsGetCounters, FnAnalyticsGetCounters, "analytics_get_counters");
 
     // Verify critical functions
     if (!Fn_GenerateFloor || !Fn_FreeString || !Fn_GetVersion)
@@ -153,6 +226,21 @@ bool FProceduralCoreBridge::Initialize(const FString& DllPath)
         return false;
     }
 
+    // Marshalling scratch grows during bursts (floor loads); hand it back once the frame is over
+    TrimScratchHandle = FCoreDelegates::OnEndFrame.AddStatic(&TowerFFI::TrimThreadScratch);
+
+    RefreshLookupTables();
+
+    if (Fn_AnalyticsGetCounters)
+    {
+        const FTowerAnalyticsCounters* Counters = Fn_AnalyticsGetCounters();
+        // An older layout is missing fields we'd read; leave it alone
+        if (Counters && Counters->Version >= TowerAnalyticsCountersVersion && Counters->Size >= sizeof(FTowerAnalyticsCounters))
+        {
+            AnalyticsCounters = Counters;
+        }
+    }
+
     // Log version
     FString Version = GetVersion();
     UE_LOG(LogTemp, Log, TEXT("ProceduralCore DLL loaded successfully. Version: %s"), *Version);
@@ -162,6 +250,16 @@ bool FProceduralCoreBridge::Initialize(const FString& DllPath)
 
 void FProceduralCoreBridge::Shutdown()
 {
+    FCoreDelegates::OnEndFrame.Remove(TrimScratchHandle);
+    TrimScratchHandle.Reset();
+
+    LookupTables[0].Reset();
+    LookupTables[1].Reset();
+    ActiveLookupTables.store(0, std::memory_order_release);
+
+    // Lives in the DLL's statics
+    AnalyticsCounters = nullptr;
+
     if (DllHandle)
     {
         FPlatformProcess::FreeDllHandle(DllHandle);
@@ -176,25 +274,33 @@ void FProceduralCoreBridge::Shutdown()
     // Floor Generation
     Fn_GenerateFloor = nullptr;
     Fn_GenerateFloorLayout = nullptr;
+    Fn_GenerateFloorLayoutBinary = nullptr;
     Fn_GetFloorHash = nullptr;
     Fn_GetFloorTier = nullptr;
 
     // Monster
     Fn_GenerateMonster = nullptr;
     Fn_GenerateFloorMonsters = nullptr;
+    Fn_GenerateFloorMonstersInto = nullptr;
 
     // Combat
     Fn_GetAngleMultiplier = nullptr;
     Fn_CalculateCombat = nullptr;
+    Fn_CalculateCombatInto = nullptr;
+    Fn_CalculateCombatBatch = nullptr;
 
     // Semantic
     Fn_SemanticSimilarity = nullptr;
 
     // Loot
     Fn_GenerateLoot = nullptr;
+    Fn_GenerateLootBatch = nullptr;
+    Fn_GetItemCatalog = nullptr;
 
     // World
     Fn_GetBreathState = nullptr;
+    Fn_GetBreathStateInto = nullptr;
+    Fn_GetBreathCycle = nullptr;
 
     // Replication
     Fn_RecordDelta = nullptr;
@@ -208,6 +314,7 @@ void FProceduralCoreBridge::Shutdown()
     Fn_MasteryGainXp = nullptr;
     Fn_MasteryGetTier = nullptr;
     Fn_MasteryXpForAction = nullptr;
+    Fn_MasteryGetActionXpTable = nullptr;
     Fn_MasteryGetAllDomains = nullptr;
 
     // Specialization
@@ -238,6 +345,39 @@ void FProceduralCoreBridge::Shutdown()
     Fn_CosmeticApplyTransmog = nullptr;
     Fn_CosmeticApplyDye = nullptr;
 
+    // Profile Handles
+    Fn_MasteryHandleCreate = nullptr;
+    Fn_MasteryHandleLoad = nullptr;
+    Fn_MasteryHandleRelease = nullptr;
+    Fn_MasteryHandleToJson = nullptr;
+    Fn_MasteryHandleGainXp = nullptr;
+    Fn_MasteryHandleGetTier = nullptr;
+    Fn_MasteryHandleGetXp = nullptr;
+    Fn_SpecHandleCreate = nullptr;
+    Fn_SpecHandleLoad = nullptr;
+    Fn_SpecHandleRelease = nullptr;
+    Fn_SpecHandleToJson = nullptr;
+    Fn_SpecHandleChooseBranch = nullptr;
+    Fn_AbilityHandleCreate = nullptr;
+    Fn_AbilityHandleLoad = nullptr;
+    Fn_AbilityHandleRelease = nullptr;
+    Fn_AbilityHandleToJson = nullptr;
+    Fn_AbilityHandleLearn = nullptr;
+    Fn_AbilityHandleEquip = nullptr;
+    Fn_CosmeticHandleCreate = nullptr;
+    Fn_CosmeticHandleLoad = nullptr;
+    Fn_CosmeticHandleRelease = nullptr;
+    Fn_CosmeticHandleToJson = nullptr;
+    Fn_CosmeticHandleUnlock = nullptr;
+    Fn_CosmeticHandleApplyTransmog = nullptr;
+    Fn_CosmeticHandleApplyDye = nullptr;
+    Fn_AchievementHandleCreate = nullptr;
+    Fn_AchievementHandleLoad = nullptr;
+    Fn_AchievementHandleRelease = nullptr;
+    Fn_AchievementHandleToJson = nullptr;
+    Fn_AchievementHandleApply = nullptr;
+    Fn_AchievementHandleCompletionPercent = nullptr;
+
     // Tutorial
     Fn_TutorialGetSteps = nullptr;
     Fn_TutorialGetHints = nullptr;
@@ -279,21 +419,38 @@ void FProceduralCoreBridge::Shutdown()
 static FString RustStringToFString(char* RustStr, FnFreeString FreeFn)
 {
     if (!RustStr) return FString();
+    if (FTowerFFIProfiler::IsEnabled())
+    {
+        FTowerFFIProfiler::AddRustString(FCStringAnsi::Strlen(RustStr));
+    }
     FString Result = UTF8_TO_TCHAR(RustStr);
     if (FreeFn) FreeFn(RustStr);
     return Result;
 }
 
+/** Text a *_into export wrote into the thread's output buffer, as an FString */
+static FString ScratchToFString(FUtf8StringView View)
+{
+    if (View.IsEmpty()) return FString();
+    if (FTowerFFIProfiler::IsEnabled())
+    {
+        FTowerFFIProfiler::AddBytesOut(View.Len());
+    }
+    return FString(View);
+}
+
 // ============ Core ============
 
 FString FProceduralCoreBridge::GetVersion()
 {
+    TOWER_FFI_SCOPE(GetVersion);
     if (!Fn_GetVersion) return TEXT("unknown");
     return RustStringToFString(Fn_GetVersion(), Fn_FreeString);
 }
 
 void FProceduralCoreBridge::FreeRustString(char* Ptr)
 {
+    TOWER_FFI_SCOPE(FreeRustString);
     if (Fn_FreeString && Ptr)
     {
         Fn_FreeString(Ptr);
@@ -304,24 +461,69 @@ void FProceduralCoreBridge::FreeRustString(char* Ptr)
 
 FString FProceduralCoreBridge::GenerateFloor(uint64 Seed, uint32 FloorId)
 {
+    TOWER_FFI_SCOPE(GenerateFloor);
     if (!Fn_GenerateFloor) return FString();
     return RustStringToFString(Fn_GenerateFloor(Seed, FloorId), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::GenerateFloorLayout(uint64 Seed, uint32 FloorId)
 {
+    TOWER_FFI_SCOPE(GenerateFloorLayout);
     if (!Fn_GenerateFloorLayout) return FString();
     return RustStringToFString(Fn_GenerateFloorLayout(Seed, FloorId), Fn_FreeString);
 }
 
+bool FProceduralCoreBridge::GenerateFloorLayoutData(uint64 Seed, uint32 FloorId, FFloorLayoutData& OutLayout)
+{
+    TOWER_FFI_SCOPE(GenerateFloorLayoutData);
+    if (!Fn_GenerateFloorLayoutBinary)
+    {
+        return OutLayout.ParseJson(GenerateFloorLayout(Seed, FloorId));
+    }
+
+    // Big enough for the largest tier (48x48 tiles plus rooms), so one call is the norm
+    TArray<uint8, TInlineAllocator<4096>> Buffer;
+    Buffer.SetNumUninitialized(Buffer.Max());
+
+    SIZE_T Required = Fn_GenerateFloorLayoutBinary(Seed, FloorId, Buffer.GetData(), Buffer.Num());
+    if (Required > static_cast<SIZE_T>(Buffer.Num()) && Required <= MAX_int32)
+    {
+        Buffer.SetNumUninitialized(static_cast<int32>(Required));
+        Required = Fn_GenerateFloorLayoutBinary(Seed, FloorId, Buffer.GetData(), Buffer.Num());
+    }
+
+    if (Required == 0 || Required > static_cast<SIZE_T>(Buffer.Num()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("generate_floor_layout_binary failed for floor %u"), FloorId);
+        return false;
+    }
+
+    if (FTowerFFIProfiler::IsEnabled())
+    {
+        FTowerFFIProfiler::AddBytesOut(static_cast<int64>(Required));
+    }
+    return OutLayout.ParseBinary(TArrayView<const uint8>(Buffer.GetData(), static_cast<int32>(Required)));
+}
+
 uint64 FProceduralCoreBridge::GetFloorHash(uint64 Seed, uint32 FloorId)
 {
+    TOWER_FFI_SCOPE(GetFloorHash);
     if (!Fn_GetFloorHash) return 0;
     return Fn_GetFloorHash(Seed, FloorId);
 }
 
 uint32 FProceduralCoreBridge::GetFloorTier(uint32 FloorId)
 {
+    const FBridgeLookupTables& Tables = GetLookupTables();
+    if (Tables.FloorTiers.IsValidIndex(static_cast<int32>(FloorId)))
+    {
+        const uint32 Tier = Tables.FloorTiers[FloorId];
+        ensureMsgf(!ShouldVerifyLookupTables() || Tier == Fn_GetFloorTier(FloorId),
+            TEXT("Floor tier table disagrees with Rust for floor %u"), FloorId);
+        return Tier;
+    }
+
+    TOWER_FFI_SCOPE(GetFloorTier);
     if (!Fn_GetFloorTier) return 0;
     return Fn_GetFloorTier(FloorId);
 }
@@ -330,38 +532,165 @@ uint32 FProceduralCoreBridge::GetFloorTier(uint32 FloorId)
 
 FString FProceduralCoreBridge::GenerateMonster(uint64 Hash, uint32 FloorLevel)
 {
+    TOWER_FFI_SCOPE(GenerateMonster);
     if (!Fn_GenerateMonster) return FString();
     return RustStringToFString(Fn_GenerateMonster(Hash, FloorLevel), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::GenerateFloorMonsters(uint64 Seed, uint32 FloorId, uint32 Count)
 {
+    TOWER_FFI_SCOPE(GenerateFloorMonsters);
+    if (Fn_GenerateFloorMonstersInto)
+    {
+        return ScratchToFString(TowerFFI::CallInto([&](uint8* Buffer, SIZE_T Capacity)
+        {
+            return Fn_GenerateFloorMonstersInto(Seed, FloorId, Count, Buffer, Capacity);
+        }));
+    }
     if (!Fn_GenerateFloorMonsters) return FString();
     return RustStringToFString(Fn_GenerateFloorMonsters(Seed, FloorId, Count), Fn_FreeString);
 }
 
+bool FProceduralCoreBridge::GenerateFloorMonsterData(uint64 Seed, uint32 FloorId, uint32 Count,
+    TArray<FFloorMonsterData>& OutMonsters)
+{
+    TOWER_FFI_SCOPE(GenerateFloorMonsterData);
+
+    // Parsed straight from UTF-8; no FString copy of the JSON
+    if (Fn_GenerateFloorMonstersInto)
+    {
+        const FUtf8StringView Json = TowerFFI::CallInto([&](uint8* Buffer, SIZE_T Capacity)
+        {
+            return Fn_GenerateFloorMonstersInto(Seed, FloorId, Count, Buffer, Capacity);
+        });
+        if (FTowerFFIProfiler::IsEnabled())
+        {
+            FTowerFFIProfiler::AddBytesOut(Json.Len());
+        }
+        return FFloorMonsterData::ParseJsonArray(Json, OutMonsters);
+    }
+
+    if (!Fn_GenerateFloorMonsters) return false;
+    const FRustStringView Json(Fn_GenerateFloorMonsters(Seed, FloorId, Count), Fn_FreeString);
+    return FFloorMonsterData::ParseJsonArray(Json.GetView(), OutMonsters);
+}
+
 // ============ Combat ============
 
 float FProceduralCoreBridge::GetAngleMultiplier(uint32 AngleId)
 {
+    const FBridgeLookupTables& Tables = GetLookupTables();
+    if (Tables.bAngles)
+    {
+        const float Multiplier = AngleId < FBridgeLookupTables::NumAngles ? Tables.AngleMultipliers[AngleId] : Tables.AngleDefault;
+        ensureMsgf(!ShouldVerifyLookupTables() || Multiplier == Fn_GetAngleMultiplier(AngleId),
+            TEXT("Angle multiplier table disagrees with Rust for angle %u"), AngleId);
+        return Multiplier;
+    }
+
+    TOWER_FFI_SCOPE(GetAngleMultiplier);
     if (!Fn_GetAngleMultiplier) return 1.0f;
     return Fn_GetAngleMultiplier(AngleId);
 }
 
 FString FProceduralCoreBridge::CalculateCombat(const FString& RequestJson)
 {
+    TOWER_FFI_SCOPE(CalculateCombat);
+    FRustArg Utf8(*RequestJson);
+    if (Fn_CalculateCombatInto)
+    {
+        return ScratchToFString(TowerFFI::CallInto([&](uint8* Buffer, SIZE_T Capacity)
+        {
+            return Fn_CalculateCombatInto(Utf8.Get(), Buffer, Capacity);
+        }));
+    }
     if (!Fn_CalculateCombat) return FString();
-    FTCHARToUTF8 Utf8(*RequestJson);
     return RustStringToFString(Fn_CalculateCombat(Utf8.Get()), Fn_FreeString);
 }
 
+/** Tag set Index of a batch table, "[]" when missing or empty */
+static FString TagSetJsonAt(TConstArrayView<FString> TagSetsJson, uint32 Index)
+{
+    return TagSetsJson.IsValidIndex(static_cast<int32>(Index)) && !TagSetsJson[Index].IsEmpty()
+        ? TagSetsJson[static_cast<int32>(Index)] : FString(TEXT("[]"));
+}
+
+/** The batch exports' tag set table: a JSON array of the tag arrays */
+static FString TagSetTableJson(TConstArrayView<FString> TagSetsJson)
+{
+    FString TableJson = TEXT("[");
+    for (int32 i = 0; i < TagSetsJson.Num(); i++)
+    {
+        if (i > 0) TableJson += TEXT(",");
+        TableJson += TagSetJsonAt(TagSetsJson, i);
+    }
+    TableJson += TEXT("]");
+    return TableJson;
+}
+
+bool FProceduralCoreBridge::CalculateCombatBatch(TConstArrayView<FCombatBatchRequest> Requests,
+    TConstArrayView<FString> TagSetsJson, TArray<FCombatBatchResult>& OutResults)
+{
+    TOWER_FFI_SCOPE(CalculateCombatBatch);
+    OutResults.SetNum(Requests.Num());
+    if (Requests.Num() == 0) return true;
+
+    auto TagSetAt = [&TagSetsJson](uint32 Index) { return TagSetJsonAt(TagSetsJson, Index); };
+
+    if (Fn_CalculateCombatBatch)
+    {
+        FRustArg Utf8(*TagSetTableJson(TagSetsJson));
+        const uint32 Written = Fn_CalculateCombatBatch(Utf8.Get(), Requests.GetData(),
+            static_cast<uint32>(Requests.Num()), OutResults.GetData());
+        if (FTowerFFIProfiler::IsEnabled())
+        {
+            FTowerFFIProfiler::AddBytesIn(Requests.Num() * sizeof(FCombatBatchRequest));
+            FTowerFFIProfiler::AddBytesOut(Written * sizeof(FCombatBatchResult));
+        }
+        return Written == static_cast<uint32>(Requests.Num());
+    }
+
+    if (!Fn_CalculateCombat) return false;
+
+    for (int32 i = 0; i < Requests.Num(); i++)
+    {
+        const FCombatBatchRequest& Request = Requests[i];
+
+        TSharedRef<FJsonObject> RequestObj = MakeShared<FJsonObject>();
+        RequestObj->SetNumberField(TEXT("base_damage"), Request.BaseDamage);
+        RequestObj->SetNumberField(TEXT("angle_id"), Request.AngleId);
+        RequestObj->SetNumberField(TEXT("combo_step"), Request.ComboStep);
+        RequestObj->SetStringField(TEXT("attacker_tags_json"), TagSetAt(Request.AttackerTagSet));
+        RequestObj->SetStringField(TEXT("defender_tags_json"), TagSetAt(Request.DefenderTagSet));
+
+        FString RequestJson;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestJson);
+        FJsonSerializer::Serialize(RequestObj, Writer);
+
+        TSharedPtr<FJsonObject> ResultObj;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CalculateCombat(RequestJson));
+        if (!FJsonSerializer::Deserialize(Reader, ResultObj) || !ResultObj.IsValid())
+        {
+            return false;
+        }
+
+        FCombatBatchResult& Result = OutResults[i];
+        Result.FinalDamage = static_cast<float>(ResultObj->GetNumberField(TEXT("final_damage")));
+        Result.AngleMultiplier = static_cast<float>(ResultObj->GetNumberField(TEXT("angle_multiplier")));
+        Result.SemanticBonus = static_cast<float>(ResultObj->GetNumberField(TEXT("semantic_bonus")));
+        Result.bIsSynergy = ResultObj->GetBoolField(TEXT("is_synergy")) ? 1 : 0;
+    }
+    return true;
+}
+
 // ============ Semantic ============
 
 float FProceduralCoreBridge::SemanticSimilarity(const FString& TagsA, const FString& TagsB)
 {
+    TOWER_FFI_SCOPE(SemanticSimilarity);
     if (!Fn_SemanticSimilarity) return 0.0f;
-    FTCHARToUTF8 Utf8A(*TagsA);
-    FTCHARToUTF8 Utf8B(*TagsB);
+    FRustArg Utf8A(*TagsA);
+    FRustArg Utf8B(*TagsB);
     return Fn_SemanticSimilarity(Utf8A.Get(), Utf8B.Get());
 }
 
@@ -369,27 +698,94 @@ float FProceduralCoreBridge::SemanticSimilarity(const FString& TagsA, const FStr
 
 FString FProceduralCoreBridge::GenerateLoot(const FString& SourceTagsJson, uint32 FloorLevel, uint64 DropHash)
 {
+    TOWER_FFI_SCOPE(GenerateLoot);
     if (!Fn_GenerateLoot) return FString();
-    FTCHARToUTF8 Utf8(*SourceTagsJson);
+    FRustArg Utf8(*SourceTagsJson);
     return RustStringToFString(Fn_GenerateLoot(Utf8.Get(), FloorLevel, DropHash), Fn_FreeString);
 }
 
+bool FProceduralCoreBridge::GenerateLootBatch(TConstArrayView<FLootBatchSource> Sources,
+    TConstArrayView<FString> TagSetsJson, TArray<FLootDropData>& OutDrops)
+{
+    TOWER_FFI_SCOPE(GenerateLootBatch);
+    OutDrops.Reset();
+    if (Sources.Num() == 0) return true;
+
+    if (Fn_GenerateLootBatch)
+    {
+        FRustArg Utf8(*TagSetTableJson(TagSetsJson));
+        const FUtf8StringView Packed = TowerFFI::CallInto([&](uint8* Buffer, SIZE_T Capacity)
+        {
+            return Fn_GenerateLootBatch(Utf8.Get(), Sources.GetData(), static_cast<uint32>(Sources.Num()), Buffer, Capacity);
+        });
+        if (Packed.IsEmpty())
+        {
+            UE_LOG(LogTemp, Error, TEXT("generate_loot_batch failed for %d sources"), Sources.Num());
+            return false;
+        }
+
+        if (FTowerFFIProfiler::IsEnabled())
+        {
+            FTowerFFIProfiler::AddBytesIn(Sources.Num() * sizeof(FLootBatchSource));
+            FTowerFFIProfiler::AddBytesOut(Packed.Len());
+        }
+        return FLootDropData::ParseBinary(
+            TArrayView<const uint8>(reinterpret_cast<const uint8*>(Packed.GetData()), Packed.Len()), OutDrops);
+    }
+
+    if (!Fn_GenerateLoot) return false;
+
+    for (int32 i = 0; i < Sources.Num(); i++)
+    {
+        const FLootBatchSource& Source = Sources[i];
+        if (!FLootDropData::ParseJsonArray(
+            GenerateLoot(TagSetJsonAt(TagSetsJson, Source.TagSet), Source.FloorLevel, Source.DropHash), i, OutDrops))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 // ============ World ============
 
 FString FProceduralCoreBridge::GetBreathState(float ElapsedSeconds)
 {
+    TOWER_FFI_SCOPE(GetBreathState);
+    if (Fn_GetBreathStateInto)
+    {
+        return ScratchToFString(TowerFFI::CallInto([&](uint8* Buffer, SIZE_T Capacity)
+        {
+            return Fn_GetBreathStateInto(ElapsedSeconds, Buffer, Capacity);
+        }));
+    }
     if (!Fn_GetBreathState) return FString();
     return RustStringToFString(Fn_GetBreathState(ElapsedSeconds), Fn_FreeString);
 }
 
+FString FProceduralCoreBridge::GetItemCatalog()
+{
+    TOWER_FFI_SCOPE(GetItemCatalog);
+    if (!Fn_GetItemCatalog) return FString();
+    return RustStringToFString(Fn_GetItemCatalog(), Fn_FreeString);
+}
+
+FString FProceduralCoreBridge::GetBreathCycle()
+{
+    TOWER_FFI_SCOPE(GetBreathCycle);
+    if (!Fn_GetBreathCycle) return FString();
+    return RustStringToFString(Fn_GetBreathCycle(), Fn_FreeString);
+}
+
 // ============ Replication ============
 
 FString FProceduralCoreBridge::RecordDelta(uint32 DeltaTypeId, uint32 FloorId, uint64 EntityHash,
                                            const FString& PlayerId, const FString& Payload, uint64 Tick)
 {
+    TOWER_FFI_SCOPE(RecordDelta);
     if (!Fn_RecordDelta) return FString();
-    FTCHARToUTF8 Utf8Player(*PlayerId);
-    FTCHARToUTF8 Utf8Payload(*Payload);
+    FRustArg Utf8Player(*PlayerId);
+    FRustArg Utf8Payload(*Payload);
     return RustStringToFString(
         Fn_RecordDelta(DeltaTypeId, FloorId, EntityHash, Utf8Player.Get(), Utf8Payload.Get(), Tick),
         Fn_FreeString);
@@ -397,8 +793,9 @@ FString FProceduralCoreBridge::RecordDelta(uint32 DeltaTypeId, uint32 FloorId, u
 
 FString FProceduralCoreBridge::CreateFloorSnapshot(uint64 Seed, uint32 FloorId, const FString& DeltasJson)
 {
+    TOWER_FFI_SCOPE(CreateFloorSnapshot);
     if (!Fn_CreateFloorSnapshot) return FString();
-    FTCHARToUTF8 Utf8(*DeltasJson);
+    FRustArg Utf8(*DeltasJson);
     return RustStringToFString(Fn_CreateFloorSnapshot(Seed, FloorId, Utf8.Get()), Fn_FreeString);
 }
 
@@ -406,8 +803,9 @@ FString FProceduralCoreBridge::CreateFloorSnapshot(uint64 Seed, uint32 FloorId,
 
 FString FProceduralCoreBridge::EvaluateEventTrigger(uint32 TriggerTypeId, const FString& ContextJson)
 {
+    TOWER_FFI_SCOPE(EvaluateEventTrigger);
     if (!Fn_EvaluateEventTrigger) return FString();
-    FTCHARToUTF8 Utf8(*ContextJson);
+    FRustArg Utf8(*ContextJson);
     return RustStringToFString(Fn_EvaluateEventTrigger(TriggerTypeId, Utf8.Get()), Fn_FreeString);
 }
 
@@ -415,33 +813,48 @@ FString FProceduralCoreBridge::EvaluateEventTrigger(uint32 TriggerTypeId, const
 
 FString FProceduralCoreBridge::MasteryCreateProfile()
 {
+    TOWER_FFI_SCOPE(MasteryCreateProfile);
     if (!Fn_MasteryCreateProfile) return FString();
     return RustStringToFString(Fn_MasteryCreateProfile(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::MasteryGainXp(const FString& ProfileJson, uint32 DomainId, uint64 Amount)
 {
+    TOWER_FFI_SCOPE(MasteryGainXp);
     if (!Fn_MasteryGainXp) return FString();
-    FTCHARToUTF8 Utf8(*ProfileJson);
+    FRustArg Utf8(*ProfileJson);
     return RustStringToFString(Fn_MasteryGainXp(Utf8.Get(), DomainId, Amount), Fn_FreeString);
 }
 
 int32 FProceduralCoreBridge::MasteryGetTier(const FString& ProfileJson, uint32 DomainId)
 {
+    TOWER_FFI_SCOPE(MasteryGetTier);
     if (!Fn_MasteryGetTier) return -1;
-    FTCHARToUTF8 Utf8(*ProfileJson);
+    FRustArg Utf8(*ProfileJson);
     return Fn_MasteryGetTier(Utf8.Get(), DomainId);
 }
 
 uint64 FProceduralCoreBridge::MasteryXpForAction(const FString& ActionName)
 {
+    const FBridgeLookupTables& Tables = GetLookupTables();
+    if (Tables.bActionXp)
+    {
+        const uint64* Found = Tables.ActionXp.Find(ActionName);
+        const uint64 Xp = Found ? *Found : Tables.DefaultActionXp;
+        ensureMsgf(!ShouldVerifyLookupTables() || Xp == Fn_MasteryXpForAction(FRustArg(*ActionName).Get()),
+            TEXT("Action XP table disagrees with Rust for '%s'"), *ActionName);
+        return Xp;
+    }
+
+    TOWER_FFI_SCOPE(MasteryXpForAction);
     if (!Fn_MasteryXpForAction) return 0;
-    FTCHARToUTF8 Utf8(*ActionName);
+    FRustArg Utf8(*ActionName);
     return Fn_MasteryXpForAction(Utf8.Get());
 }
 
 FString FProceduralCoreBridge::MasteryGetAllDomains()
 {
+    TOWER_FFI_SCOPE(MasteryGetAllDomains);
     if (!Fn_MasteryGetAllDomains) return FString();
     return RustStringToFString(Fn_MasteryGetAllDomains(), Fn_FreeString);
 }
@@ -450,22 +863,25 @@ FString FProceduralCoreBridge::MasteryGetAllDomains()
 
 FString FProceduralCoreBridge::SpecGetAllBranches()
 {
+    TOWER_FFI_SCOPE(SpecGetAllBranches);
     if (!Fn_SpecGetAllBranches) return FString();
     return RustStringToFString(Fn_SpecGetAllBranches(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SpecCreateProfile()
 {
+    TOWER_FFI_SCOPE(SpecCreateProfile);
     if (!Fn_SpecCreateProfile) return FString();
     return RustStringToFString(Fn_SpecCreateProfile(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SpecChooseBranch(const FString& ProfileJson, const FString& MasteryJson, const FString& BranchId)
 {
+    TOWER_FFI_SCOPE(SpecChooseBranch);
     if (!Fn_SpecChooseBranch) return FString();
-    FTCHARToUTF8 Utf8Profile(*ProfileJson);
-    FTCHARToUTF8 Utf8Mastery(*MasteryJson);
-    FTCHARToUTF8 Utf8Branch(*BranchId);
+    FRustArg Utf8Profile(*ProfileJson);
+    FRustArg Utf8Mastery(*MasteryJson);
+    FRustArg Utf8Branch(*BranchId);
     return RustStringToFString(
         Fn_SpecChooseBranch(Utf8Profile.Get(), Utf8Mastery.Get(), Utf8Branch.Get()),
         Fn_FreeString);
@@ -473,8 +889,9 @@ FString FProceduralCoreBridge::SpecChooseBranch(const FString& ProfileJson, cons
 
 FString FProceduralCoreBridge::SpecFindSynergies(const FString& BranchIdsJson)
 {
+    TOWER_FFI_SCOPE(SpecFindSynergies);
     if (!Fn_SpecFindSynergies) return FString();
-    FTCHARToUTF8 Utf8(*BranchIdsJson);
+    FRustArg Utf8(*BranchIdsJson);
     return RustStringToFString(Fn_SpecFindSynergies(Utf8.Get()), Fn_FreeString);
 }
 
@@ -482,29 +899,33 @@ FString FProceduralCoreBridge::SpecFindSynergies(const FString& BranchIdsJson)
 
 FString FProceduralCoreBridge::AbilityGetDefaults()
 {
+    TOWER_FFI_SCOPE(AbilityGetDefaults);
     if (!Fn_AbilityGetDefaults) return FString();
     return RustStringToFString(Fn_AbilityGetDefaults(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::AbilityCreateLoadout()
 {
+    TOWER_FFI_SCOPE(AbilityCreateLoadout);
     if (!Fn_AbilityCreateLoadout) return FString();
     return RustStringToFString(Fn_AbilityCreateLoadout(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::AbilityLearn(const FString& LoadoutJson, const FString& AbilityId)
 {
+    TOWER_FFI_SCOPE(AbilityLearn);
     if (!Fn_AbilityLearn) return FString();
-    FTCHARToUTF8 Utf8Loadout(*LoadoutJson);
-    FTCHARToUTF8 Utf8Id(*AbilityId);
+    FRustArg Utf8Loadout(*LoadoutJson);
+    FRustArg Utf8Id(*AbilityId);
     return RustStringToFString(Fn_AbilityLearn(Utf8Loadout.Get(), Utf8Id.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::AbilityEquip(const FString& LoadoutJson, uint32 Slot, const FString& AbilityId)
 {
+    TOWER_FFI_SCOPE(AbilityEquip);
     if (!Fn_AbilityEquip) return FString();
-    FTCHARToUTF8 Utf8Loadout(*LoadoutJson);
-    FTCHARToUTF8 Utf8Id(*AbilityId);
+    FRustArg Utf8Loadout(*LoadoutJson);
+    FRustArg Utf8Id(*AbilityId);
     return RustStringToFString(Fn_AbilityEquip(Utf8Loadout.Get(), Slot, Utf8Id.Get()), Fn_FreeString);
 }
 
@@ -512,44 +933,50 @@ FString FProceduralCoreBridge::AbilityEquip(const FString& LoadoutJson, uint32 S
 
 FString FProceduralCoreBridge::SocketGetStarterGems()
 {
+    TOWER_FFI_SCOPE(SocketGetStarterGems);
     if (!Fn_SocketGetStarterGems) return FString();
     return RustStringToFString(Fn_SocketGetStarterGems(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocketGetStarterRunes()
 {
+    TOWER_FFI_SCOPE(SocketGetStarterRunes);
     if (!Fn_SocketGetStarterRunes) return FString();
     return RustStringToFString(Fn_SocketGetStarterRunes(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocketCreateEquipment(const FString& Name, const FString& ColorsJson)
 {
+    TOWER_FFI_SCOPE(SocketCreateEquipment);
     if (!Fn_SocketCreateEquipment) return FString();
-    FTCHARToUTF8 Utf8Name(*Name);
-    FTCHARToUTF8 Utf8Colors(*ColorsJson);
+    FRustArg Utf8Name(*Name);
+    FRustArg Utf8Colors(*ColorsJson);
     return RustStringToFString(Fn_SocketCreateEquipment(Utf8Name.Get(), Utf8Colors.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocketInsertGem(const FString& EquipmentJson, uint32 Slot, const FString& GemJson)
 {
+    TOWER_FFI_SCOPE(SocketInsertGem);
     if (!Fn_SocketInsertGem) return FString();
-    FTCHARToUTF8 Utf8Equip(*EquipmentJson);
-    FTCHARToUTF8 Utf8Gem(*GemJson);
+    FRustArg Utf8Equip(*EquipmentJson);
+    FRustArg Utf8Gem(*GemJson);
     return RustStringToFString(Fn_SocketInsertGem(Utf8Equip.Get(), Slot, Utf8Gem.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocketInsertRune(const FString& EquipmentJson, uint32 Slot, const FString& RuneJson)
 {
+    TOWER_FFI_SCOPE(SocketInsertRune);
     if (!Fn_SocketInsertRune) return FString();
-    FTCHARToUTF8 Utf8Equip(*EquipmentJson);
-    FTCHARToUTF8 Utf8Rune(*RuneJson);
+    FRustArg Utf8Equip(*EquipmentJson);
+    FRustArg Utf8Rune(*RuneJson);
     return RustStringToFString(Fn_SocketInsertRune(Utf8Equip.Get(), Slot, Utf8Rune.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocketCombineGems(const FString& GemsJson)
 {
+    TOWER_FFI_SCOPE(SocketCombineGems);
     if (!Fn_SocketCombineGems) return FString();
-    FTCHARToUTF8 Utf8(*GemsJson);
+    FRustArg Utf8(*GemsJson);
     return RustStringToFString(Fn_SocketCombineGems(Utf8.Get()), Fn_FreeString);
 }
 
@@ -557,35 +984,40 @@ FString FProceduralCoreBridge::SocketCombineGems(const FString& GemsJson)
 
 FString FProceduralCoreBridge::CosmeticGetAll()
 {
+    TOWER_FFI_SCOPE(CosmeticGetAll);
     if (!Fn_CosmeticGetAll) return FString();
     return RustStringToFString(Fn_CosmeticGetAll(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::CosmeticGetAllDyes()
 {
+    TOWER_FFI_SCOPE(CosmeticGetAllDyes);
     if (!Fn_CosmeticGetAllDyes) return FString();
     return RustStringToFString(Fn_CosmeticGetAllDyes(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::CosmeticCreateProfile()
 {
+    TOWER_FFI_SCOPE(CosmeticCreateProfile);
     if (!Fn_CosmeticCreateProfile) return FString();
     return RustStringToFString(Fn_CosmeticCreateProfile(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::CosmeticUnlock(const FString& ProfileJson, const FString& CosmeticId)
 {
+    TOWER_FFI_SCOPE(CosmeticUnlock);
     if (!Fn_CosmeticUnlock) return FString();
-    FTCHARToUTF8 Utf8Profile(*ProfileJson);
-    FTCHARToUTF8 Utf8Id(*CosmeticId);
+    FRustArg Utf8Profile(*ProfileJson);
+    FRustArg Utf8Id(*CosmeticId);
     return RustStringToFString(Fn_CosmeticUnlock(Utf8Profile.Get(), Utf8Id.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::CosmeticApplyTransmog(const FString& ProfileJson, uint32 SlotId, const FString& CosmeticId)
 {
+    TOWER_FFI_SCOPE(CosmeticApplyTransmog);
     if (!Fn_CosmeticApplyTransmog) return FString();
-    FTCHARToUTF8 Utf8Profile(*ProfileJson);
-    FTCHARToUTF8 Utf8Id(*CosmeticId);
+    FRustArg Utf8Profile(*ProfileJson);
+    FRustArg Utf8Id(*CosmeticId);
     return RustStringToFString(
         Fn_CosmeticApplyTransmog(Utf8Profile.Get(), SlotId, Utf8Id.Get()),
         Fn_FreeString);
@@ -593,46 +1025,286 @@ FString FProceduralCoreBridge::CosmeticApplyTransmog(const FString& ProfileJson,
 
 FString FProceduralCoreBridge::CosmeticApplyDye(const FString& ProfileJson, uint32 SlotId, uint32 ChannelId, const FString& DyeId)
 {
+    TOWER_FFI_SCOPE(CosmeticApplyDye);
     if (!Fn_CosmeticApplyDye) return FString();
-    FTCHARToUTF8 Utf8Profile(*ProfileJson);
-    FTCHARToUTF8 Utf8Dye(*DyeId);
+    FRustArg Utf8Profile(*ProfileJson);
+    FRustArg Utf8Dye(*DyeId);
     return RustStringToFString(
         Fn_CosmeticApplyDye(Utf8Profile.Get(), SlotId, ChannelId, Utf8Dye.Get()),
         Fn_FreeString);
 }
 
+// ============ Profile Handles ============
+
+uint64 FProceduralCoreBridge::MasteryHandleCreate()
+{
+    TOWER_FFI_SCOPE(MasteryHandleCreate);
+    if (!Fn_MasteryHandleCreate) return 0;
+    return Fn_MasteryHandleCreate();
+}
+
+uint64 FProceduralCoreBridge::MasteryHandleLoad(const FString& ProfileJson)
+{
+    TOWER_FFI_SCOPE(MasteryHandleLoad);
+    if (!Fn_MasteryHandleLoad) return 0;
+    FRustArg Utf8Profile(*ProfileJson);
+    return Fn_MasteryHandleLoad(Utf8Profile.Get());
+}
+
+uint32 FProceduralCoreBridge::MasteryHandleRelease(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(MasteryHandleRelease);
+    if (!Fn_MasteryHandleRelease) return 0;
+    return Fn_MasteryHandleRelease(Handle);
+}
+
+FString FProceduralCoreBridge::MasteryHandleToJson(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(MasteryHandleToJson);
+    if (!Fn_MasteryHandleToJson) return FString();
+    return RustStringToFString(Fn_MasteryHandleToJson(Handle), Fn_FreeString);
+}
+
+int32 FProceduralCoreBridge::MasteryHandleGainXp(uint64 Handle, uint32 DomainId, uint64 Amount)
+{
+    TOWER_FFI_SCOPE(MasteryHandleGainXp);
+    if (!Fn_MasteryHandleGainXp) return -1;
+    return Fn_MasteryHandleGainXp(Handle, DomainId, Amount);
+}
+
+int32 FProceduralCoreBridge::MasteryHandleGetTier(uint64 Handle, uint32 DomainId)
+{
+    TOWER_FFI_SCOPE(MasteryHandleGetTier);
+    if (!Fn_MasteryHandleGetTier) return -1;
+    return Fn_MasteryHandleGetTier(Handle, DomainId);
+}
+
+uint64 FProceduralCoreBridge::MasteryHandleGetXp(uint64 Handle, uint32 DomainId)
+{
+    TOWER_FFI_SCOPE(MasteryHandleGetXp);
+    if (!Fn_MasteryHandleGetXp) return 0;
+    return Fn_MasteryHandleGetXp(Handle, DomainId);
+}
+
+uint64 FProceduralCoreBridge::SpecHandleCreate()
+{
+    TOWER_FFI_SCOPE(SpecHandleCreate);
+    if (!Fn_SpecHandleCreate) return 0;
+    return Fn_SpecHandleCreate();
+}
+
+uint64 FProceduralCoreBridge::SpecHandleLoad(const FString& ProfileJson)
+{
+    TOWER_FFI_SCOPE(SpecHandleLoad);
+    if (!Fn_SpecHandleLoad) return 0;
+    FRustArg Utf8Profile(*ProfileJson);
+    return Fn_SpecHandleLoad(Utf8Profile.Get());
+}
+
+uint32 FProceduralCoreBridge::SpecHandleRelease(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(SpecHandleRelease);
+    if (!Fn_SpecHandleRelease) return 0;
+    return Fn_SpecHandleRelease(Handle);
+}
+
+FString FProceduralCoreBridge::SpecHandleToJson(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(SpecHandleToJson);
+    if (!Fn_SpecHandleToJson) return FString();
+    return RustStringToFString(Fn_SpecHandleToJson(Handle), Fn_FreeString);
+}
+
+int32 FProceduralCoreBridge::SpecHandleChooseBranch(uint64 Handle, uint64 MasteryHandle, const FString& BranchId)
+{
+    TOWER_FFI_SCOPE(SpecHandleChooseBranch);
+    if (!Fn_SpecHandleChooseBranch) return -1;
+    FRustArg Utf8BranchId(*BranchId);
+    return Fn_SpecHandleChooseBranch(Handle, MasteryHandle, Utf8BranchId.Get());
+}
+
+uint64 FProceduralCoreBridge::AbilityHandleCreate()
+{
+    TOWER_FFI_SCOPE(AbilityHandleCreate);
+    if (!Fn_AbilityHandleCreate) return 0;
+    return Fn_AbilityHandleCreate();
+}
+
+uint64 FProceduralCoreBridge::AbilityHandleLoad(const FString& LoadoutJson)
+{
+    TOWER_FFI_SCOPE(AbilityHandleLoad);
+    if (!Fn_AbilityHandleLoad) return 0;
+    FRustArg Utf8Loadout(*LoadoutJson);
+    return Fn_AbilityHandleLoad(Utf8Loadout.Get());
+}
+
+uint32 FProceduralCoreBridge::AbilityHandleRelease(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(AbilityHandleRelease);
+    if (!Fn_AbilityHandleRelease) return 0;
+    return Fn_AbilityHandleRelease(Handle);
+}
+
+FString FProceduralCoreBridge::AbilityHandleToJson(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(AbilityHandleToJson);
+    if (!Fn_AbilityHandleToJson) return FString();
+    return RustStringToFString(Fn_AbilityHandleToJson(Handle), Fn_FreeString);
+}
+
+int32 FProceduralCoreBridge::AbilityHandleLearn(uint64 Handle, const FString& AbilityId)
+{
+    TOWER_FFI_SCOPE(AbilityHandleLearn);
+    if (!Fn_AbilityHandleLearn) return -1;
+    FRustArg Utf8AbilityId(*AbilityId);
+    return Fn_AbilityHandleLearn(Handle, Utf8AbilityId.Get());
+}
+
+int32 FProceduralCoreBridge::AbilityHandleEquip(uint64 Handle, uint32 Slot, const FString& AbilityId)
+{
+    TOWER_FFI_SCOPE(AbilityHandleEquip);
+    if (!Fn_AbilityHandleEquip) return -1;
+    FRustArg Utf8AbilityId(*AbilityId);
+    return Fn_AbilityHandleEquip(Handle, Slot, Utf8AbilityId.Get());
+}
+
+uint64 FProceduralCoreBridge::CosmeticHandleCreate()
+{
+    TOWER_FFI_SCOPE(CosmeticHandleCreate);
+    if (!Fn_CosmeticHandleCreate) return 0;
+    return Fn_CosmeticHandleCreate();
+}
+
+uint64 FProceduralCoreBridge::CosmeticHandleLoad(const FString& ProfileJson)
+{
+    TOWER_FFI_SCOPE(CosmeticHandleLoad);
+    if (!Fn_CosmeticHandleLoad) return 0;
+    FRustArg Utf8Profile(*ProfileJson);
+    return Fn_CosmeticHandleLoad(Utf8Profile.Get());
+}
+
+uint32 FProceduralCoreBridge::CosmeticHandleRelease(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(CosmeticHandleRelease);
+    if (!Fn_CosmeticHandleRelease) return 0;
+    return Fn_CosmeticHandleRelease(Handle);
+}
+
+FString FProceduralCoreBridge::CosmeticHandleToJson(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(CosmeticHandleToJson);
+    if (!Fn_CosmeticHandleToJson) return FString();
+    return RustStringToFString(Fn_CosmeticHandleToJson(Handle), Fn_FreeString);
+}
+
+int32 FProceduralCoreBridge::CosmeticHandleUnlock(uint64 Handle, const FString& CosmeticId)
+{
+    TOWER_FFI_SCOPE(CosmeticHandleUnlock);
+    if (!Fn_CosmeticHandleUnlock) return -1;
+    FRustArg Utf8CosmeticId(*CosmeticId);
+    return Fn_CosmeticHandleUnlock(Handle, Utf8CosmeticId.Get());
+}
+
+int32 FProceduralCoreBridge::CosmeticHandleApplyTransmog(uint64 Handle, uint32 SlotId, const FString& CosmeticId)
+{
+    TOWER_FFI_SCOPE(CosmeticHandleApplyTransmog);
+    if (!Fn_CosmeticHandleApplyTransmog) return -1;
+    FRustArg Utf8CosmeticId(*CosmeticId);
+    return Fn_CosmeticHandleApplyTransmog(Handle, SlotId, Utf8CosmeticId.Get());
+}
+
+int32 FProceduralCoreBridge::CosmeticHandleApplyDye(uint64 Handle, uint32 SlotId, uint32 ChannelId, const FString& DyeId)
+{
+    TOWER_FFI_SCOPE(CosmeticHandleApplyDye);
+    if (!Fn_CosmeticHandleApplyDye) return -1;
+    FRustArg Utf8DyeId(*DyeId);
+    return Fn_CosmeticHandleApplyDye(Handle, SlotId, ChannelId, Utf8DyeId.Get());
+}
+
+uint64 FProceduralCoreBridge::AchievementHandleCreate()
+{
+    TOWER_FFI_SCOPE(AchievementHandleCreate);
+    if (!Fn_AchievementHandleCreate) return 0;
+    return Fn_AchievementHandleCreate();
+}
+
+uint64 FProceduralCoreBridge::AchievementHandleLoad(const FString& TrackerJson)
+{
+    TOWER_FFI_SCOPE(AchievementHandleLoad);
+    if (!Fn_AchievementHandleLoad) return 0;
+    FRustArg Utf8Tracker(*TrackerJson);
+    return Fn_AchievementHandleLoad(Utf8Tracker.Get());
+}
+
+uint32 FProceduralCoreBridge::AchievementHandleRelease(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(AchievementHandleRelease);
+    if (!Fn_AchievementHandleRelease) return 0;
+    return Fn_AchievementHandleRelease(Handle);
+}
+
+FString FProceduralCoreBridge::AchievementHandleToJson(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(AchievementHandleToJson);
+    if (!Fn_AchievementHandleToJson) return FString();
+    return RustStringToFString(Fn_AchievementHandleToJson(Handle), Fn_FreeString);
+}
+
+FString FProceduralCoreBridge::AchievementHandleApply(uint64 Handle, const FString& IncrementsJson, uint32 CurrentFloor, uint64 CurrentTick)
+{
+    TOWER_FFI_SCOPE(AchievementHandleApply);
+    if (!Fn_AchievementHandleApply) return FString();
+    if (IncrementsJson.IsEmpty())
+    {
+        return RustStringToFString(Fn_AchievementHandleApply(Handle, nullptr, CurrentFloor, CurrentTick), Fn_FreeString);
+    }
+    FRustArg Utf8Increments(*IncrementsJson);
+    return RustStringToFString(Fn_AchievementHandleApply(Handle, Utf8Increments.Get(), CurrentFloor, CurrentTick), Fn_FreeString);
+}
+
+float FProceduralCoreBridge::AchievementHandleCompletionPercent(uint64 Handle)
+{
+    TOWER_FFI_SCOPE(AchievementHandleCompletionPercent);
+    if (!Fn_AchievementHandleCompletionPercent) return 0.0f;
+    return Fn_AchievementHandleCompletionPercent(Handle);
+}
 // ============ Tutorial ============
 
 FString FProceduralCoreBridge::TutorialGetSteps()
 {
+    TOWER_FFI_SCOPE(TutorialGetSteps);
     if (!Fn_TutorialGetSteps) return FString();
     return RustStringToFString(Fn_TutorialGetSteps(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::TutorialGetHints()
 {
+    TOWER_FFI_SCOPE(TutorialGetHints);
     if (!Fn_TutorialGetHints) return FString();
     return RustStringToFString(Fn_TutorialGetHints(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::TutorialCreateProgress()
 {
+    TOWER_FFI_SCOPE(TutorialCreateProgress);
     if (!Fn_TutorialCreateProgress) return FString();
     return RustStringToFString(Fn_TutorialCreateProgress(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::TutorialCompleteStep(const FString& ProgressJson, const FString& StepId)
 {
+    TOWER_FFI_SCOPE(TutorialCompleteStep);
     if (!Fn_TutorialCompleteStep) return FString();
-    FTCHARToUTF8 Utf8Progress(*ProgressJson);
-    FTCHARToUTF8 Utf8Step(*StepId);
+    FRustArg Utf8Progress(*ProgressJson);
+    FRustArg Utf8Step(*StepId);
     return RustStringToFString(Fn_TutorialCompleteStep(Utf8Progress.Get(), Utf8Step.Get()), Fn_FreeString);
 }
 
 float FProceduralCoreBridge::TutorialCompletionPercent(const FString& ProgressJson)
 {
+    TOWER_FFI_SCOPE(TutorialCompletionPercent);
     if (!Fn_TutorialCompletionPercent) return 0.0f;
-    FTCHARToUTF8 Utf8(*ProgressJson);
+    FRustArg Utf8(*ProgressJson);
     return Fn_TutorialCompletionPercent(Utf8.Get());
 }
 
@@ -640,29 +1312,33 @@ float FProceduralCoreBridge::TutorialCompletionPercent(const FString& ProgressJs
 
 FString FProceduralCoreBridge::AchievementCreateTracker()
 {
+    TOWER_FFI_SCOPE(AchievementCreateTracker);
     if (!Fn_AchievementCreateTracker) return FString();
     return RustStringToFString(Fn_AchievementCreateTracker(), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::AchievementIncrement(const FString& TrackerJson, const FString& AchievementId, uint64 Amount)
 {
+    TOWER_FFI_SCOPE(AchievementIncrement);
     if (!Fn_AchievementIncrement) return FString();
-    FTCHARToUTF8 Utf8Tracker(*TrackerJson);
-    FTCHARToUTF8 Utf8Id(*AchievementId);
+    FRustArg Utf8Tracker(*TrackerJson);
+    FRustArg Utf8Id(*AchievementId);
     return RustStringToFString(Fn_AchievementIncrement(Utf8Tracker.Get(), Utf8Id.Get(), Amount), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::AchievementCheckAll(const FString& TrackerJson, uint64 CurrentTick)
 {
+    TOWER_FFI_SCOPE(AchievementCheckAll);
     if (!Fn_AchievementCheckAll) return FString();
-    FTCHARToUTF8 Utf8(*TrackerJson);
+    FRustArg Utf8(*TrackerJson);
     return RustStringToFString(Fn_AchievementCheckAll(Utf8.Get(), CurrentTick), Fn_FreeString);
 }
 
 float FProceduralCoreBridge::AchievementCompletionPercent(const FString& TrackerJson)
 {
+    TOWER_FFI_SCOPE(AchievementCompletionPercent);
     if (!Fn_AchievementCompletionPercent) return 0.0f;
-    FTCHARToUTF8 Utf8(*TrackerJson);
+    FRustArg Utf8(*TrackerJson);
     return Fn_AchievementCompletionPercent(Utf8.Get());
 }
 
@@ -670,32 +1346,37 @@ float FProceduralCoreBridge::AchievementCompletionPercent(const FString& Tracker
 
 FString FProceduralCoreBridge::SeasonCreatePass(uint32 SeasonNumber, const FString& Name)
 {
+    TOWER_FFI_SCOPE(SeasonCreatePass);
     if (!Fn_SeasonCreatePass) return FString();
-    FTCHARToUTF8 Utf8(*Name);
+    FRustArg Utf8(*Name);
     return RustStringToFString(Fn_SeasonCreatePass(SeasonNumber, Utf8.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SeasonAddXp(const FString& PassJson, uint64 Amount)
 {
+    TOWER_FFI_SCOPE(SeasonAddXp);
     if (!Fn_SeasonAddXp) return FString();
-    FTCHARToUTF8 Utf8(*PassJson);
+    FRustArg Utf8(*PassJson);
     return RustStringToFString(Fn_SeasonAddXp(Utf8.Get(), Amount), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SeasonGenerateDailies(uint64 DaySeed)
 {
+    TOWER_FFI_SCOPE(SeasonGenerateDailies);
     if (!Fn_SeasonGenerateDailies) return FString();
     return RustStringToFString(Fn_SeasonGenerateDailies(DaySeed), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SeasonGenerateWeeklies(uint64 WeekSeed)
 {
+    TOWER_FFI_SCOPE(SeasonGenerateWeeklies);
     if (!Fn_SeasonGenerateWeeklies) return FString();
     return RustStringToFString(Fn_SeasonGenerateWeeklies(WeekSeed), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SeasonGetRewards(uint32 SeasonNumber)
 {
+    TOWER_FFI_SCOPE(SeasonGetRewards);
     if (!Fn_SeasonGetRewards) return FString();
     return RustStringToFString(Fn_SeasonGetRewards(SeasonNumber), Fn_FreeString);
 }
@@ -705,12 +1386,13 @@ FString FProceduralCoreBridge::SeasonGetRewards(uint32 SeasonNumber)
 FString FProceduralCoreBridge::SocialCreateGuild(const FString& Name, const FString& Tag,
                                                   const FString& LeaderId, const FString& LeaderName, const FString& Faction)
 {
+    TOWER_FFI_SCOPE(SocialCreateGuild);
     if (!Fn_SocialCreateGuild) return FString();
-    FTCHARToUTF8 Utf8Name(*Name);
-    FTCHARToUTF8 Utf8Tag(*Tag);
-    FTCHARToUTF8 Utf8LeaderId(*LeaderId);
-    FTCHARToUTF8 Utf8LeaderName(*LeaderName);
-    FTCHARToUTF8 Utf8Faction(*Faction);
+    FRustArg Utf8Name(*Name);
+    FRustArg Utf8Tag(*Tag);
+    FRustArg Utf8LeaderId(*LeaderId);
+    FRustArg Utf8LeaderName(*LeaderName);
+    FRustArg Utf8Faction(*Faction);
     return RustStringToFString(
         Fn_SocialCreateGuild(Utf8Name.Get(), Utf8Tag.Get(), Utf8LeaderId.Get(), Utf8LeaderName.Get(), Utf8Faction.Get()),
         Fn_FreeString);
@@ -718,10 +1400,11 @@ FString FProceduralCoreBridge::SocialCreateGuild(const FString& Name, const FStr
 
 FString FProceduralCoreBridge::SocialGuildAddMember(const FString& GuildJson, const FString& UserId, const FString& UserName)
 {
+    TOWER_FFI_SCOPE(SocialGuildAddMember);
     if (!Fn_SocialGuildAddMember) return FString();
-    FTCHARToUTF8 Utf8Guild(*GuildJson);
-    FTCHARToUTF8 Utf8Id(*UserId);
-    FTCHARToUTF8 Utf8Name(*UserName);
+    FRustArg Utf8Guild(*GuildJson);
+    FRustArg Utf8Id(*UserId);
+    FRustArg Utf8Name(*UserName);
     return RustStringToFString(
         Fn_SocialGuildAddMember(Utf8Guild.Get(), Utf8Id.Get(), Utf8Name.Get()),
         Fn_FreeString);
@@ -731,19 +1414,21 @@ FString FProceduralCoreBridge::SocialGuildAddMember(const FString& GuildJson, co
 
 FString FProceduralCoreBridge::SocialCreateParty(const FString& LeaderId, const FString& LeaderName)
 {
+    TOWER_FFI_SCOPE(SocialCreateParty);
     if (!Fn_SocialCreateParty) return FString();
-    FTCHARToUTF8 Utf8Id(*LeaderId);
-    FTCHARToUTF8 Utf8Name(*LeaderName);
+    FRustArg Utf8Id(*LeaderId);
+    FRustArg Utf8Name(*LeaderName);
     return RustStringToFString(Fn_SocialCreateParty(Utf8Id.Get(), Utf8Name.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocialPartyAddMember(const FString& PartyJson, const FString& UserId,
                                                      const FString& UserName, uint32 RoleId)
 {
+    TOWER_FFI_SCOPE(SocialPartyAddMember);
     if (!Fn_SocialPartyAddMember) return FString();
-    FTCHARToUTF8 Utf8Party(*PartyJson);
-    FTCHARToUTF8 Utf8Id(*UserId);
-    FTCHARToUTF8 Utf8Name(*UserName);
+    FRustArg Utf8Party(*PartyJson);
+    FRustArg Utf8Id(*UserId);
+    FRustArg Utf8Name(*UserName);
     return RustStringToFString(
         Fn_SocialPartyAddMember(Utf8Party.Get(), Utf8Id.Get(), Utf8Name.Get(), RoleId),
         Fn_FreeString);
@@ -753,20 +1438,22 @@ FString FProceduralCoreBridge::SocialPartyAddMember(const FString& PartyJson, co
 
 FString FProceduralCoreBridge::SocialCreateTrade(const FString& PlayerA, const FString& PlayerB)
 {
+    TOWER_FFI_SCOPE(SocialCreateTrade);
     if (!Fn_SocialCreateTrade) return FString();
-    FTCHARToUTF8 Utf8A(*PlayerA);
-    FTCHARToUTF8 Utf8B(*PlayerB);
+    FRustArg Utf8A(*PlayerA);
+    FRustArg Utf8B(*PlayerB);
     return RustStringToFString(Fn_SocialCreateTrade(Utf8A.Get(), Utf8B.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocialTradeAddItem(const FString& TradeJson, const FString& PlayerId,
                                                    const FString& ItemName, uint32 Quantity, const FString& Rarity)
 {
+    TOWER_FFI_SCOPE(SocialTradeAddItem);
     if (!Fn_SocialTradeAddItem) return FString();
-    FTCHARToUTF8 Utf8Trade(*TradeJson);
-    FTCHARToUTF8 Utf8Player(*PlayerId);
-    FTCHARToUTF8 Utf8Item(*ItemName);
-    FTCHARToUTF8 Utf8Rarity(*Rarity);
+    FRustArg Utf8Trade(*TradeJson);
+    FRustArg Utf8Player(*PlayerId);
+    FRustArg Utf8Item(*ItemName);
+    FRustArg Utf8Rarity(*Rarity);
     return RustStringToFString(
         Fn_SocialTradeAddItem(Utf8Trade.Get(), Utf8Player.Get(), Utf8Item.Get(), Quantity, Utf8Rarity.Get()),
         Fn_FreeString);
@@ -774,24 +1461,27 @@ FString FProceduralCoreBridge::SocialTradeAddItem(const FString& TradeJson, cons
 
 FString FProceduralCoreBridge::SocialTradeLock(const FString& TradeJson, const FString& PlayerId)
 {
+    TOWER_FFI_SCOPE(SocialTradeLock);
     if (!Fn_SocialTradeLock) return FString();
-    FTCHARToUTF8 Utf8Trade(*TradeJson);
-    FTCHARToUTF8 Utf8Player(*PlayerId);
+    FRustArg Utf8Trade(*TradeJson);
+    FRustArg Utf8Player(*PlayerId);
     return RustStringToFString(Fn_SocialTradeLock(Utf8Trade.Get(), Utf8Player.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocialTradeConfirm(const FString& TradeJson, const FString& PlayerId)
 {
+    TOWER_FFI_SCOPE(SocialTradeConfirm);
     if (!Fn_SocialTradeConfirm) return FString();
-    FTCHARToUTF8 Utf8Trade(*TradeJson);
-    FTCHARToUTF8 Utf8Player(*PlayerId);
+    FRustArg Utf8Trade(*TradeJson);
+    FRustArg Utf8Player(*PlayerId);
     return RustStringToFString(Fn_SocialTradeConfirm(Utf8Trade.Get(), Utf8Player.Get()), Fn_FreeString);
 }
 
 FString FProceduralCoreBridge::SocialTradeExecute(const FString& TradeJson)
 {
+    TOWER_FFI_SCOPE(SocialTradeExecute);
     if (!Fn_SocialTradeExecute) return FString();
-    FTCHARToUTF8 Utf8(*TradeJson);
+    FRustArg Utf8(*TradeJson);
     return RustStringToFString(Fn_SocialTradeExecute(Utf8.Get()), Fn_FreeString);
 }
 
@@ -799,26 +1489,103 @@ FString FProceduralCoreBridge::SocialTradeExecute(const FString& TradeJson)
 
 FString FProceduralCoreBridge::HotReloadGetStatus()
 {
+    TOWER_FFI_SCOPE(HotReloadGetStatus);
+    FScopeLock Lock(&StatefulCallsLock);
     if (!Fn_HotReloadGetStatus) return FString();
     return RustStringToFString(Fn_HotReloadGetStatus(), Fn_FreeString);
 }
 
 uint32 FProceduralCoreBridge::HotReloadTriggerReload()
 {
-    if (!Fn_HotReloadTriggerReload) return 0;
-    return Fn_HotReloadTriggerReload();
+    // Held across the table refresh, so concurrent reloads can't flip the buffers under each other
+    FScopeLock Lock(&StatefulCallsLock);
+    uint32 Reloaded = 0;
+    {
+        TOWER_FFI_SCOPE(HotReloadTriggerReload);
+        if (!Fn_HotReloadTriggerReload) return 0;
+        Reloaded = Fn_HotReloadTriggerReload();
+    }
+
+    if (Reloaded > 0)
+    {
+        RefreshLookupTables();
+    }
+    return Reloaded;
+}
+
+bool FProceduralCoreBridge::HotReloadGetDomainGenerations(uint64 (&OutGenerations)[TowerConfigDomainCount])
+{
+    TOWER_FFI_SCOPE(HotReloadGetDomainGenerations);
+    FMemory::Memzero(OutGenerations);
+    if (!Fn_HotReloadGetDomainGenerations) return false;
+    return Fn_HotReloadGetDomainGenerations(OutGenerations, TowerConfigDomainCount) == static_cast<uint32>(TowerConfigDomainCount);
+}
+
+void FProceduralCoreBridge::RefreshLookupTables()
+{
+    FScopeLock Lock(&StatefulCallsLock);
+
+    const int32 Next = 1 - ActiveLookupTables.load(std::memory_order_relaxed);
+    FBridgeLookupTables& Tables = LookupTables[Next];
+    Tables.Reset();
+
+    if (Fn_GetAngleMultiplier)
+    {
+        for (uint32 AngleId = 0; AngleId < FBridgeLookupTables::NumAngles; AngleId++)
+        {
+            Tables.AngleMultipliers[AngleId] = Fn_GetAngleMultiplier(AngleId);
+        }
+        Tables.AngleDefault = Fn_GetAngleMultiplier(MAX_uint32);
+        Tables.bAngles = true;
+    }
+
+    if (Fn_GetFloorTier)
+    {
+        Tables.FloorTiers.SetNumUninitialized(FBridgeLookupTables::NumFloorTiers);
+        for (uint32 FloorId = 0; FloorId < FBridgeLookupTables::NumFloorTiers; FloorId++)
+        {
+            Tables.FloorTiers[FloorId] = static_cast<uint8>(Fn_GetFloorTier(FloorId));
+        }
+    }
+
+    if (Fn_MasteryGetActionXpTable)
+    {
+        TSharedPtr<FJsonObject> Root;
+        const FString Json = RustStringToFString(Fn_MasteryGetActionXpTable(), Fn_FreeString);
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        const TSharedPtr<FJsonObject>* Actions = nullptr;
+        if (FJsonSerializer::Deserialize(Reader, Root) && Root.IsValid() && Root->TryGetObjectField(TEXT("actions"), Actions))
+        {
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Action : (*Actions)->Values)
+            {
+                Tables.ActionXp.Add(Action.Key, static_cast<uint64>(Action.Value->AsNumber()));
+            }
+            Tables.DefaultActionXp = static_cast<uint64>(Root->GetNumberField(TEXT("default")));
+            Tables.bActionXp = true;
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("mastery_get_action_xp_table returned unreadable JSON; action XP stays on the FFI"));
+        }
+    }
+
+    ActiveLookupTables.store(Next, std::memory_order_release);
 }
 
 // ============ Analytics (v0.6.0) ============
 
 FString FProceduralCoreBridge::AnalyticsGetSnapshot()
 {
+    TOWER_FFI_SCOPE(AnalyticsGetSnapshot);
+    FScopeLock Lock(&StatefulCallsLock);
     if (!Fn_AnalyticsGetSnapshot) return FString();
     return RustStringToFString(Fn_AnalyticsGetSnapshot(), Fn_FreeString);
 }
 
 void FProceduralCoreBridge::AnalyticsReset()
 {
+    TOWER_FFI_SCOPE(AnalyticsReset);
+    FScopeLock Lock(&StatefulCallsLock);
     if (Fn_AnalyticsReset)
     {
         Fn_AnalyticsReset();
@@ -827,13 +1594,26 @@ void FProceduralCoreBridge::AnalyticsReset()
 
 void FProceduralCoreBridge::AnalyticsRecordDamage(const FString& WeaponName, uint32 Amount)
 {
+    TOWER_FFI_SCOPE(AnalyticsRecordDamage);
+    FScopeLock Lock(&StatefulCallsLock);
     if (!Fn_AnalyticsRecordDamage) return;
-    FTCHARToUTF8 Utf8Weapon(*WeaponName);
+    FRustArg Utf8Weapon(*WeaponName);
     Fn_AnalyticsRecordDamage(Utf8Weapon.Get(), Amount);
 }
 
+uint32 FProceduralCoreBridge::AnalyticsRecordDamageBatch(const FString& AggregatesJson)
+{
+    TOWER_FFI_SCOPE(AnalyticsRecordDamageBatch);
+    FScopeLock Lock(&StatefulCallsLock);
+    if (!Fn_AnalyticsRecordDamageBatch) return 0;
+    FRustArg Utf8(*AggregatesJson);
+    return Fn_AnalyticsRecordDamageBatch(Utf8.Get());
+}
+
 void FProceduralCoreBridge::AnalyticsRecordFloorCleared(uint32 FloorId, uint32 Tier, float TimeSecs)
 {
+    TOWER_FFI_SCOPE(AnalyticsRecordFloorCleared);
+    FScopeLock Lock(&StatefulCallsLock);
     if (Fn_AnalyticsRecordFloorCleared)
     {
         Fn_AnalyticsRecordFloorCleared(FloorId, Tier, TimeSecs);
@@ -842,14 +1622,406 @@ void FProceduralCoreBridge::AnalyticsRecordFloorCleared(uint32 FloorId, uint32 T
 
 void FProceduralCoreBridge::AnalyticsRecordGold(uint64 Amount)
 {
+    TOWER_FFI_SCOPE(AnalyticsRecordGold);
+    FScopeLock Lock(&StatefulCallsLock);
     if (Fn_AnalyticsRecordGold)
     {
-        Fn_AnalyticsRecordGold(Amount);
+        Fn_AnalyticsRecordGold(Amount, 1);
     }
 }
 
 FString FProceduralCoreBridge::AnalyticsGetEventTypes()
 {
+    TOWER_FFI_SCOPE(AnalyticsGetEventTypes);
     if (!Fn_AnalyticsGetEventTypes) return FString();
     return RustStringToFString(Fn_AnalyticsGetEventTypes(), Fn_FreeString);
 }
+
+// ============ Floor Layout Decoding ============
+
+namespace
+{
+    constexpr uint32 FloorLayoutMagic = 0x314C4654; // "TFL1"
+
+    // Wire structs of generate_floor_layout_binary; naturally aligned, so no packing needed
+    struct FFloorLayoutWireHeader
+    {
+        uint32 Magic;
+        uint16 Width;
+        uint16 Height;
+        uint16 RoomCount;
+        uint16 SpawnCount;
+        uint16 ExitX;
+        uint16 ExitY;
+    };
+
+    struct FFloorLayoutWireRoom
+    {
+        uint16 X;
+        uint16 Y;
+        uint16 Width;
+        uint16 Height;
+        uint8 RoomType;
+        uint8 Reserved;
+    };
+
+    struct FFloorLayoutWirePoint
+    {
+        uint16 X;
+        uint16 Y;
+    };
+
+    static_assert(sizeof(FFloorLayoutWireHeader) == 16, "Floor layout header must match the Rust writer");
+    static_assert(sizeof(FFloorLayoutWireRoom) == 10, "Floor layout room must match the Rust writer");
+    static_assert(sizeof(FFloorLayoutWirePoint) == 4, "Floor layout point must match the Rust writer");
+    static_assert(PLATFORM_LITTLE_ENDIAN, "Floor layout is decoded by memcpy of little-endian fields");
+
+    EFloorRoomType RoomTypeFromName(const FString& Name)
+    {
+        if (Name == TEXT("Treasure")) return EFloorRoomType::Treasure;
+        if (Name == TEXT("Puzzle"))   return EFloorRoomType::Puzzle;
+        if (Name == TEXT("Rest"))     return EFloorRoomType::Rest;
+        if (Name == TEXT("Boss"))     return EFloorRoomType::Boss;
+        if (Name == TEXT("Entrance")) return EFloorRoomType::Entrance;
+        if (Name == TEXT("Exit"))     return EFloorRoomType::Exit;
+        return EFloorRoomType::Combat;
+    }
+}
+
+bool FFloorLayoutData::ParseBinary(TArrayView<const uint8> Buffer)
+{
+    FFloorLayoutWireHeader Header;
+    if (Buffer.Num() < static_cast<int32>(sizeof(Header)))
+    {
+        return false;
+    }
+    FMemory::Memcpy(&Header, Buffer.GetData(), sizeof(Header));
+
+    const int32 RoomsOffset = sizeof(Header);
+    const int32 SpawnsOffset = RoomsOffset + Header.RoomCount * static_cast<int32>(sizeof(FFloorLayoutWireRoom));
+    const int32 TilesOffset = SpawnsOffset + Header.SpawnCount * static_cast<int32>(sizeof(FFloorLayoutWirePoint));
+    const int32 TileCount = Header.Width * Header.Height;
+
+    if (Header.Magic != FloorLayoutMagic || Buffer.Num() != TilesOffset + TileCount)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Binary floor layout rejected (magic 0x%08x, %d bytes)"), Header.Magic, Buffer.Num());
+        return false;
+    }
+
+    Width = Header.Width;
+    Height = Header.Height;
+    ExitPoint = FIntPoint(Header.ExitX, Header.ExitY);
+
+    Rooms.SetNum(Header.RoomCount, false);
+    for (int32 i = 0; i < Header.RoomCount; i++)
+    {
+        FFloorLayoutWireRoom Wire;
+        FMemory::Memcpy(&Wire, Buffer.GetData() + RoomsOffset + i * sizeof(Wire), sizeof(Wire));
+        Rooms[i].X = Wire.X;
+        Rooms[i].Y = Wire.Y;
+        Rooms[i].Width = Wire.Width;
+        Rooms[i].Height = Wire.Height;
+        Rooms[i].RoomType = Wire.RoomType <= static_cast<uint8>(EFloorRoomType::Exit)
+            ? static_cast<EFloorRoomType>(Wire.RoomType) : EFloorRoomType::Combat;
+    }
+
+    SpawnPoints.SetNum(Header.SpawnCount, false);
+    for (int32 i = 0; i < Header.SpawnCount; i++)
+    {
+        FFloorLayoutWirePoint Wire;
+        FMemory::Memcpy(&Wire, Buffer.GetData() + SpawnsOffset + i * sizeof(Wire), sizeof(Wire));
+        SpawnPoints[i] = FIntPoint(Wire.X, Wire.Y);
+    }
+
+    Tiles.SetNumUninitialized(TileCount, false);
+    FMemory::Memcpy(Tiles.GetData(), Buffer.GetData() + TilesOffset, TileCount);
+    return true;
+}
+
+bool FFloorLayoutData::ParseJson(const FString& LayoutJson)
+{
+    TSharedPtr<FJsonObject> LayoutObj;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LayoutJson);
+    if (LayoutJson.IsEmpty() || !FJsonSerializer::Deserialize(Reader, LayoutObj) || !LayoutObj.IsValid())
+    {
+        return false;
+    }
+
+    Width = LayoutObj->GetIntegerField(TEXT("width"));
+    Height = LayoutObj->GetIntegerField(TEXT("height"));
+    Tiles.SetNumZeroed(FMath::Max(Width * Height, 0));
+
+    // tiles[y][x]
+    const TArray<TSharedPtr<FJsonValue>>* TileRows;
+    if (LayoutObj->TryGetArrayField(TEXT("tiles"), TileRows))
+    {
+        for (int32 y = 0; y < Height && y < TileRows->Num(); y++)
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Row = (*TileRows)[y]->AsArray();
+            for (int32 x = 0; x < Width && x < Row.Num(); x++)
+            {
+                Tiles[y * Width + x] = static_cast<uint8>(Row[x]->AsNumber());
+            }
+        }
+    }
+
+    Rooms.Reset();
+    const TArray<TSharedPtr<FJsonValue>>* RoomsArray;
+    if (LayoutObj->TryGetArrayField(TEXT("rooms"), RoomsArray))
+    {
+        for (const TSharedPtr<FJsonValue>& RoomVal : *RoomsArray)
+        {
+            TSharedPtr<FJsonObject> Room = RoomVal->AsObject();
+            if (!Room.IsValid()) continue;
+
+            FFloorLayoutRoom& Out = Rooms.AddDefaulted_GetRef();
+            Out.X = Room->GetIntegerField(TEXT("x"));
+            Out.Y = Room->GetIntegerField(TEXT("y"));
+            Out.Width = Room->GetIntegerField(TEXT("width"));
+            Out.Height = Room->GetIntegerField(TEXT("height"));
+            Out.RoomType = RoomTypeFromName(Room->GetStringField(TEXT("room_type")));
+        }
+    }
+
+    // Points are serialized as [x, y] pairs
+    auto ReadPoint = [](const TSharedPtr<FJsonValue>& Value, FIntPoint& OutPoint)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Pair;
+        if (Value.IsValid() && Value->TryGetArray(Pair) && Pair->Num() == 2)
+        {
+            OutPoint = FIntPoint(static_cast<int32>((*Pair)[0]->AsNumber()), static_cast<int32>((*Pair)[1]->AsNumber()));
+            return true;
+        }
+        return false;
+    };
+
+    SpawnPoints.Reset();
+    const TArray<TSharedPtr<FJsonValue>>* SpawnArray;
+    if (LayoutObj->TryGetArrayField(TEXT("spawn_points"), SpawnArray))
+    {
+        for (const TSharedPtr<FJsonValue>& SpawnVal : *SpawnArray)
+        {
+            FIntPoint Point;
+            if (ReadPoint(SpawnVal, Point))
+            {
+                SpawnPoints.Add(Point);
+            }
+        }
+    }
+
+    ExitPoint = FIntPoint::ZeroValue;
+    ReadPoint(LayoutObj->TryGetField(TEXT("exit_point")), ExitPoint);
+
+    return IsValid();
+}
+
+namespace
+{
+    template <typename CharType>
+    bool ParseMonsterValues(const TSharedRef<TJsonReader<CharType>>& Reader, TArray<FFloorMonsterData>& OutMonsters)
+    {
+        TArray<TSharedPtr<FJsonValue>> MonstersArray;
+        if (!FJsonSerializer::Deserialize(Reader, MonstersArray))
+        {
+            return false;
+        }
+
+        OutMonsters.Reserve(MonstersArray.Num());
+        for (const TSharedPtr<FJsonValue>& MonsterVal : MonstersArray)
+        {
+            TSharedPtr<FJsonObject> MonsterObj = MonsterVal->AsObject();
+            if (!MonsterObj.IsValid()) continue;
+
+            // Flat Rust MonsterInfo
+            FFloorMonsterData& Monster = OutMonsters.AddDefaulted_GetRef();
+            Monster.Name = MonsterObj->GetStringField(TEXT("name"));
+            Monster.Size = TowerMonsterTags::ParseSize(MonsterObj->GetStringField(TEXT("size")));
+            Monster.Element = TowerMonsterTags::ParseElement(MonsterObj->GetStringField(TEXT("element")));
+            Monster.MaxHp = MonsterObj->GetNumberField(TEXT("max_hp"));
+            Monster.Damage = MonsterObj->GetNumberField(TEXT("damage"));
+            Monster.Armor = MonsterObj->GetNumberField(TEXT("armor"));
+            Monster.Speed = MonsterObj->GetNumberField(TEXT("speed"));
+        }
+        return true;
+    }
+}
+
+bool FFloorMonsterData::ParseJsonArray(const FString& MonstersJson, TArray<FFloorMonsterData>& OutMonsters)
+{
+    OutMonsters.Reset();
+    if (MonstersJson.IsEmpty()) return false;
+    return ParseMonsterValues(TJsonReaderFactory<>::Create(MonstersJson), OutMonsters);
+}
+
+bool FFloorMonsterData::ParseJsonArray(FUtf8StringView MonstersJson, TArray<FFloorMonsterData>& OutMonsters)
+{
+    OutMonsters.Reset();
+    if (MonstersJson.IsEmpty()) return false;
+    return ParseMonsterValues(TJsonReaderFactory<UTF8CHAR>::CreateFromView(MonstersJson), OutMonsters);
+}
+
+// ============ Loot Batch Decoding ============
+
+namespace
+{
+    constexpr uint32 LootBatchMagic = 0x31424C54; // "TLB1"
+
+    // Wire structs of generate_loot_batch; naturally aligned, so no packing needed
+    struct FLootBatchWireHeader
+    {
+        uint32 Magic;
+        uint32 RecordCount;
+        uint32 StringsSize;
+    };
+
+    struct FLootBatchWireRecord
+    {
+        uint32 SourceIndex;
+        uint32 Quantity;
+        uint32 NameOffset;
+        uint32 TagsOffset;
+        uint16 NameLen;
+        uint16 TagsLen;
+        uint8 Category;
+        uint8 Rarity;
+        uint16 Reserved;
+    };
+
+    static_assert(sizeof(FLootBatchWireHeader) == 12, "Loot batch header must match the Rust writer");
+    static_assert(sizeof(FLootBatchWireRecord) == 24, "Loot batch record must match the Rust writer");
+
+    const TCHAR* const LootCategoryNames[] = {
+        TEXT("CombatResource"), TEXT("Material"), TEXT("Consumable"), TEXT("Equipment"), TEXT("Currency"), TEXT("EchoFragment") };
+    const TCHAR* const ItemRarityNames[] = {
+        TEXT("Common"), TEXT("Uncommon"), TEXT("Rare"), TEXT("Epic"), TEXT("Legendary"), TEXT("Mythic") };
+
+    template <int32 N>
+    uint8 IndexOfName(const TCHAR* const (&Names)[N], const FString& Name)
+    {
+        for (int32 i = 0; i < N; i++)
+        {
+            if (Name == Names[i]) return static_cast<uint8>(i);
+        }
+        return 0;
+    }
+}
+
+const TCHAR* FLootDropData::GetCategoryName() const
+{
+    return CategoryNameOf(Category);
+}
+
+const TCHAR* FLootDropData::GetRarityName() const
+{
+    return RarityNameOf(Rarity);
+}
+
+const TCHAR* FLootDropData::CategoryNameOf(uint8 InCategory)
+{
+    return InCategory < UE_ARRAY_COUNT(LootCategoryNames) ? LootCategoryNames[InCategory] : LootCategoryNames[0];
+}
+
+const TCHAR* FLootDropData::RarityNameOf(uint8 InRarity)
+{
+    return InRarity < UE_ARRAY_COUNT(ItemRarityNames) ? ItemRarityNames[InRarity] : ItemRarityNames[0];
+}
+
+uint8 FLootDropData::CategoryFromName(const FString& InName)
+{
+    return IndexOfName(LootCategoryNames, InName);
+}
+
+uint8 FLootDropData::RarityFromName(const FString& InName)
+{
+    return IndexOfName(ItemRarityNames, InName);
+}
+
+FString FLootDropData::ToJson() const
+{
+    // Tags are already JSON, so this is assembled rather than serialized
+    const FString EscapedName = Name.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\""));
+    return FString::Printf(TEXT("{\"name\":\"%s\",\"category\":\"%s\",\"rarity\":\"%s\",\"quantity\":%d,\"semantic_tags\":%s}"),
+        *EscapedName, GetCategoryName(), GetRarityName(), Quantity, TagsJson.IsEmpty() ? TEXT("[]") : *TagsJson);
+}
+
+bool FLootDropData::ParseBinary(TArrayView<const uint8> Buffer, TArray<FLootDropData>& OutDrops)
+{
+    OutDrops.Reset();
+
+    FLootBatchWireHeader Header;
+    if (Buffer.Num() < static_cast<int32>(sizeof(Header)))
+    {
+        return false;
+    }
+    FMemory::Memcpy(&Header, Buffer.GetData(), sizeof(Header));
+
+    const int64 StringsOffset = sizeof(Header) + static_cast<int64>(Header.RecordCount) * sizeof(FLootBatchWireRecord);
+    if (Header.Magic != LootBatchMagic || Buffer.Num() != StringsOffset + Header.StringsSize)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Loot batch rejected (magic 0x%08x, %d bytes)"), Header.Magic, Buffer.Num());
+        return false;
+    }
+
+    const uint8* Strings = Buffer.GetData() + StringsOffset;
+    auto ReadString = [Strings, &Header](uint32 Offset, uint16 Len, FString& Out)
+    {
+        if (static_cast<uint64>(Offset) + Len > Header.StringsSize)
+        {
+            return false;
+        }
+        Out = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Strings + Offset), Len));
+        return true;
+    };
+
+    OutDrops.SetNum(Header.RecordCount);
+    for (uint32 i = 0; i < Header.RecordCount; i++)
+    {
+        FLootBatchWireRecord Wire;
+        FMemory::Memcpy(&Wire, Buffer.GetData() + sizeof(Header) + i * sizeof(Wire), sizeof(Wire));
+
+        FLootDropData& Drop = OutDrops[i];
+        Drop.SourceIndex = static_cast<int32>(Wire.SourceIndex);
+        Drop.Quantity = static_cast<int32>(Wire.Quantity);
+        Drop.Category = Wire.Category;
+        Drop.Rarity = Wire.Rarity;
+        if (!ReadString(Wire.NameOffset, Wire.NameLen, Drop.Name) || !ReadString(Wire.TagsOffset, Wire.TagsLen, Drop.TagsJson))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Loot batch record %u points outside the string block"), i);
+            OutDrops.Reset();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FLootDropData::ParseJsonArray(const FString& LootJson, int32 SourceIndex, TArray<FLootDropData>& OutDrops)
+{
+    TArray<TSharedPtr<FJsonValue>> Items;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LootJson);
+    if (LootJson.IsEmpty() || !FJsonSerializer::Deserialize(Reader, Items))
+    {
+        return false;
+    }
+
+    for (const TSharedPtr<FJsonValue>& ItemVal : Items)
+    {
+        TSharedPtr<FJsonObject> Item = ItemVal->AsObject();
+        if (!Item.IsValid()) continue;
+
+        FLootDropData& Drop = OutDrops.AddDefaulted_GetRef();
+        Drop.SourceIndex = SourceIndex;
+        Drop.Name = Item->GetStringField(TEXT("name"));
+        Drop.Category = IndexOfName(LootCategoryNames, Item->GetStringField(TEXT("category")));
+        Drop.Rarity = IndexOfName(ItemRarityNames, Item->GetStringField(TEXT("rarity")));
+        Drop.Quantity = Item->GetIntegerField(TEXT("quantity"));
+
+        const TArray<TSharedPtr<FJsonValue>>* Tags = nullptr;
+        if (Item->TryGetArrayField(TEXT("semantic_tags"), Tags))
+        {
+            TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+                TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Drop.TagsJson);
+            FJsonSerializer::Serialize(*Tags, Writer);
+        }
+    }
+    return true;
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Core/MonsterTags.h"
+#include <atomic>
 
 /**
  * C++ bridge for loading the Rust Procedural Core DLL (tower_core.dll).
@@ -25,7 +28,251 @@
  * - Social (guild, party, trade)
  *
  * All returned strings must be freed with FreeRustString().
+ *
+ * Thread safety (every wrapper below falls in exactly one group):
+ * - Initialize() and Shutdown() must not overlap any other call. Shutdown() is
+ *   game thread only (UTowerGameSubsystem waits for its generation tasks first);
+ *   Initialize() runs on a boot worker, and the subsystem hands the bridge out
+ *   only once it has returned.
+ * - Pure, any thread, concurrently: floor, monster, combat, loot, semantic,
+ *   world, event, replication and the JSON-in/JSON-out profile functions (the
+ *   profile is passed in and returned; nothing is kept on the Rust side).
+ *   RecordDelta belongs here too: it records into a fresh log per call, so
+ *   ordering deltas is up to the caller. The function pointers don't change
+ *   between Initialize() and Shutdown(), and marshalling scratch is per thread,
+ *   so these need no lock on the C++ side either.
+ * - Profile handles (*Handle*): any thread. The Rust stores are behind mutexes,
+ *   but a single handle's calls are applied in whatever order threads arrive.
+ * - Hot-reload and analytics touch process-wide Rust state. They may be called
+ *   from any thread and are serialized by StatefulCallsLock; it never wraps a
+ *   call from the pure group, so workers generating floors don't wait on it.
+ * - GetAngleMultiplier, GetFloorTier and MasteryXpForAction answer from tables
+ *   copied out of the DLL at Initialize() and after each hot reload. The tables
+ *   are double-buffered, so readers on other threads see either the old or the
+ *   new set, never a half-built one (a reader would have to stall across two
+ *   reloads to see otherwise).
+ *
+ * Marshalling: string arguments go through FRustArg (FFIMarshalling.h), encoded into
+ * a per-thread scratch arena. Where the DLL has a *_into export, Rust writes its JSON
+ * into a reusable per-thread buffer instead of allocating, and parse-only wrappers
+ * read it as UTF-8 without building an FString.
+ *
+ * Profiling: every wrapper opens a TOWER_FFI_SCOPE (FFIProfiler.h), visible as
+ * `stat TowerFFI`, as Insights CPU scopes, and (with tower.FFIProfile 1) as call /
+ * time / byte counters dumped by tower.FFIProfile.Dump.
+ */
+
+// ============================================================
+// Binary floor layout (generate_floor_layout_binary)
+// ============================================================
+
+/** Room purpose — mirrors Rust RoomType (values are the binary layout's room_type byte) */
+enum class EFloorRoomType : uint8
+{
+    Combat = 0,
+    Treasure,
+    Puzzle,
+    Rest,
+    Boss,
+    Entrance,
+    Exit,
+};
+
+struct FFloorLayoutRoom
+{
+    int32 X = 0;
+    int32 Y = 0;
+    int32 Width = 0;
+    int32 Height = 0;
+    EFloorRoomType RoomType = EFloorRoomType::Combat;
+};
+
+/** Decoded floor layout; tiles are Rust TileType values, row-major */
+struct TOWERGAME_API FFloorLayoutData
+{
+    int32 Width = 0;
+    int32 Height = 0;
+    TArray<uint8> Tiles;
+    TArray<FFloorLayoutRoom> Rooms;
+    TArray<FIntPoint> SpawnPoints;
+    FIntPoint ExitPoint = FIntPoint::ZeroValue;
+
+    bool IsValid() const { return Width > 0 && Height > 0 && Tiles.Num() == Width * Height; }
+    uint8 GetTile(int32 X, int32 Y) const { return Tiles[Y * Width + X]; }
+
+    /**
+     * Decode a generate_floor_layout_binary buffer (format documented in the
+     * Rust bridge). Array allocations already held by this struct are reused.
+     */
+    bool ParseBinary(TArrayView<const uint8> Buffer);
+
+    /** Fill from the generate_floor_layout JSON (for DLLs without the binary export) */
+    bool ParseJson(const FString& LayoutJson);
+};
+
+/** One monster from generate_floor_monsters (Rust MonsterInfo, the fields the client uses) */
+struct TOWERGAME_API FFloorMonsterData
+{
+    FString Name;
+
+    /** Interned from Rust's size / element strings when parsed */
+    EMonsterSize Size = EMonsterSize::Unknown;
+    EMonsterElement Element = EMonsterElement::Neutral;
+
+    float MaxHp = 100.0f;
+    float Damage = 10.0f;
+    float Armor = 5.0f;
+    float Speed = 3.0f;
+
+    /** Parse the generate_floor_monsters JSON array; safe off the game thread */
+    static bool ParseJsonArray(const FString& MonstersJson, TArray<FFloorMonsterData>& OutMonsters);
+    static bool ParseJsonArray(FUtf8StringView MonstersJson, TArray<FFloorMonsterData>& OutMonsters);
+};
+
+/** Tag set index meaning "no tags" in FCombatBatchRequest */
+constexpr uint32 CombatBatchNoTags = MAX_uint32;
+
+/**
+ * One hit for CalculateCombatBatch (Rust CombatBatchRequest, same layout).
+ * Tags are indices into the batch's tag set table, so an AoE lists the
+ * attacker's tags once for every target.
+ */
+struct FCombatBatchRequest
+{
+    float BaseDamage = 0.0f;
+    uint32 AngleId = 0;         // 0=Front, 1=Side, 2=Back
+    uint32 ComboStep = 0;
+    uint32 AttackerTagSet = CombatBatchNoTags;
+    uint32 DefenderTagSet = CombatBatchNoTags;
+};
+
+/** CalculateCombatBatch output (Rust CombatBatchResult, same layout) */
+struct FCombatBatchResult
+{
+    float FinalDamage = 0.0f;
+    float AngleMultiplier = 1.0f;
+    float SemanticBonus = 0.0f;
+    uint8 bIsSynergy = 0;
+    uint8 Reserved[3] = {};
+};
+
+static_assert(sizeof(FCombatBatchRequest) == 20, "FCombatBatchRequest must match the Rust CombatBatchRequest");
+static_assert(sizeof(FCombatBatchResult) == 16, "FCombatBatchResult must match the Rust CombatBatchResult");
+
+/** One drop source (dead monster, opened chest) for GenerateLootBatch (Rust LootBatchSource, same layout) */
+struct FLootBatchSource
+{
+    uint32 TagSet = MAX_uint32;     // index into the batch's tag set table; out of range = no tags
+    uint32 FloorLevel = 1;
+    uint64 DropHash = 0;
+};
+
+static_assert(sizeof(FLootBatchSource) == 16, "FLootBatchSource must match the Rust LootBatchSource");
+
+/** Layout version of FTowerAnalyticsCounters this client reads (Rust ANALYTICS_COUNTERS_VERSION) */
+constexpr uint32 TowerAnalyticsCountersVersion = 1;
+
+/**
+ * The DLL's running analytics totals (Rust AnalyticsCounters, same layout),
+ * read in place through the pointer from GetAnalyticsCounters(). Rust bumps
+ * the counters with relaxed atomics from whichever thread records; load them
+ * the same way. Fields are only appended: a newer DLL's block is larger and
+ * starts with these.
+ */
+struct FTowerAnalyticsCounters
+{
+    uint32 Version;
+    uint32 Size;
+    std::atomic<uint64> DamageHits;
+    std::atomic<uint64> TotalDamageDealt;
+    std::atomic<uint64> MaxHit;
+    std::atomic<uint64> FloorsCleared;
+    std::atomic<uint64> HighestFloor;
+    std::atomic<uint64> FloorClearMillis;   // sum of the clear times
+    std::atomic<uint64> GoldEarned;
+    std::atomic<uint64> GoldSpent;
+};
+
+static_assert(std::atomic<uint64>::is_always_lock_free && sizeof(std::atomic<uint64>) == sizeof(uint64),
+    "FTowerAnalyticsCounters reads Rust AtomicU64s in place");
+static_assert(sizeof(FTowerAnalyticsCounters) == 72, "FTowerAnalyticsCounters must match the Rust AnalyticsCounters");
+
+/** One generated drop (Rust LootInfo), decoded from generate_loot_batch without JSON */
+struct TOWERGAME_API FLootDropData
+{
+    /** Index of the FLootBatchSource that dropped it */
+    int32 SourceIndex = 0;
+    FString Name;
+    uint8 Category = 0;         // Rust LootCategory order: CombatResource, Material, Consumable, Equipment, Currency, EchoFragment
+    uint8 Rarity = 0;           // Rust ItemRarity order: Common .. Mythic
+    int32 Quantity = 0;
+
+    /** The item's semantic tags as JSON */
+    FString TagsJson;
+
+    /** Variant names as generate_loot spells them */
+    const TCHAR* GetCategoryName() const;
+    const TCHAR* GetRarityName() const;
+
+    static const TCHAR* CategoryNameOf(uint8 InCategory);
+    static const TCHAR* RarityNameOf(uint8 InRarity);
+
+    /** Variant index of a generate_loot spelling; 0 for unknown names */
+    static uint8 CategoryFromName(const FString& InName);
+    static uint8 RarityFromName(const FString& InName);
+
+    /** The generate_loot JSON object for this drop */
+    FString ToJson() const;
+
+    /** Decode a generate_loot_batch buffer, replacing OutDrops */
+    static bool ParseBinary(TArrayView<const uint8> Buffer, TArray<FLootDropData>& OutDrops);
+
+    /** Append the items of one generate_loot JSON array, attributed to SourceIndex */
+    static bool ParseJsonArray(const FString& LootJson, int32 SourceIndex, TArray<FLootDropData>& OutDrops);
+};
+
+/** Config sections with their own hot-reload generation (Rust hotreload::ConfigDomain, same order) */
+enum class ETowerConfigDomain : uint8
+{
+    Monsters,
+    Loot,
+    Abilities,
+    Cosmetics,
+};
+
+constexpr int32 TowerConfigDomainCount = 4;
+
+/**
+ * Small, static Rust tables mirrored on the C++ side so the per-hit and per-action
+ * lookups don't cross the FFI. Floors past NumFloorTiers (and actions when the DLL
+ * lacks mastery_get_action_xp_table) still go to Rust.
  */
+struct FBridgeLookupTables
+{
+    static constexpr uint32 NumAngles = 3;
+    static constexpr uint32 NumFloorTiers = 1024;
+
+    bool bAngles = false;
+    float AngleMultipliers[NumAngles] = { 1.0f, 1.0f, 1.0f };
+    float AngleDefault = 1.0f;
+
+    /** Tier for floor ids [0, NumFloorTiers), empty if get_floor_tier is missing */
+    TArray<uint8> FloorTiers;
+
+    bool bActionXp = false;
+    uint64 DefaultActionXp = 0;
+
+    /** Action names compare byte-for-byte like the Rust match */
+    struct FCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, uint64>, FString>
+    {
+        static const FString& GetSetKey(const TPair<FString, uint64>& Element) { return Element.Key; }
+        static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static uint32 GetKeyHash(const FString& Key) { return GetTypeHash(Key); }
+    };
+    TMap<FString, uint64, FDefaultSetAllocator, FCaseSensitiveKeyFuncs> ActionXp;
+
+    void Reset() { *this = FBridgeLookupTables(); }
+};
 
 // ============================================================
 // Function pointer types matching Rust extern "C" exports
@@ -38,25 +285,33 @@ typedef void  (*FnFreeString)(char*);
 // Floor Generation
 typedef char*  (*FnGenerateFloor)(uint64, uint32);
 typedef char*  (*FnGenerateFloorLayout)(uint64, uint32);
+typedef SIZE_T (*FnGenerateFloorLayoutBinary)(uint64, uint32, uint8*, SIZE_T);
 typedef uint64 (*FnGetFloorHash)(uint64, uint32);
 typedef uint32 (*FnGetFloorTier)(uint32);
 
 // Monster Generation
 typedef char* (*FnGenerateMonster)(uint64, uint32);
 typedef char* (*FnGenerateFloorMonsters)(uint64, uint32, uint32);
+typedef SIZE_T (*FnGenerateFloorMonstersInto)(uint64, uint32, uint32, uint8*, SIZE_T);
 
 // Combat
 typedef float (*FnGetAngleMultiplier)(uint32);
 typedef char* (*FnCalculateCombat)(const char*);
+typedef SIZE_T (*FnCalculateCombatInto)(const char*, uint8*, SIZE_T);
+typedef uint32 (*FnCalculateCombatBatch)(const char*, const FCombatBatchRequest*, uint32, FCombatBatchResult*);
 
 // Semantic
 typedef float (*FnSemanticSimilarity)(const char*, const char*);
 
 // Loot
 typedef char* (*FnGenerateLoot)(const char*, uint32, uint64);
+typedef SIZE_T (*FnGenerateLootBatch)(const char*, const FLootBatchSource*, uint32, uint8*, SIZE_T);
+typedef char* (*FnGetItemCatalog)();
 
 // World
 typedef char* (*FnGetBreathState)(float);
+typedef SIZE_T (*FnGetBreathStateInto)(float, uint8*, SIZE_T);
+typedef char* (*FnGetBreathCycle)();
 
 // Replication
 typedef char* (*FnRecordDelta)(uint32, uint32, uint64, const char*, const char*, uint64);
@@ -70,6 +325,7 @@ typedef char*  (*FnMasteryCreateProfile)();
 typedef char*  (*FnMasteryGainXp)(const char*, uint32, uint64);
 typedef int32  (*FnMasteryGetTier)(const char*, uint32);
 typedef uint64 (*FnMasteryXpForAction)(const char*);
+typedef char*  (*FnMasteryGetActionXpTable)();
 typedef char*  (*FnMasteryGetAllDomains)();
 
 // Specialization
@@ -100,6 +356,39 @@ typedef char* (*FnCosmeticUnlock)(const char*, const char*);
 typedef char* (*FnCosmeticApplyTransmog)(const char*, uint32, const char*);
 typedef char* (*FnCosmeticApplyDye)(const char*, uint32, uint32, const char*);
 
+// Profile Handles
+typedef uint64 (*FnMasteryHandleCreate)();
+typedef uint64 (*FnMasteryHandleLoad)(const char*);
+typedef uint32 (*FnMasteryHandleRelease)(uint64);
+typedef char*  (*FnMasteryHandleToJson)(uint64);
+typedef int32  (*FnMasteryHandleGainXp)(uint64, uint32, uint64);
+typedef int32  (*FnMasteryHandleGetTier)(uint64, uint32);
+typedef uint64 (*FnMasteryHandleGetXp)(uint64, uint32);
+typedef uint64 (*FnSpecHandleCreate)();
+typedef uint64 (*FnSpecHandleLoad)(const char*);
+typedef uint32 (*FnSpecHandleRelease)(uint64);
+typedef char*  (*FnSpecHandleToJson)(uint64);
+typedef int32  (*FnSpecHandleChooseBranch)(uint64, uint64, const char*);
+typedef uint64 (*FnAbilityHandleCreate)();
+typedef uint64 (*FnAbilityHandleLoad)(const char*);
+typedef uint32 (*FnAbilityHandleRelease)(uint64);
+typedef char*  (*FnAbilityHandleToJson)(uint64);
+typedef int32  (*FnAbilityHandleLearn)(uint64, const char*);
+typedef int32  (*FnAbilityHandleEquip)(uint64, uint32, const char*);
+typedef uint64 (*FnCosmeticHandleCreate)();
+typedef uint64 (*FnCosmeticHandleLoad)(const char*);
+typedef uint32 (*FnCosmeticHandleRelease)(uint64);
+typedef char*  (*FnCosmeticHandleToJson)(uint64);
+typedef int32  (*FnCosmeticHandleUnlock)(uint64, const char*);
+typedef int32  (*FnCosmeticHandleApplyTransmog)(uint64, uint32, const char*);
+typedef int32  (*FnCosmeticHandleApplyDye)(uint64, uint32, uint32, const char*);
+typedef uint64 (*FnAchievementHandleCreate)();
+typedef uint64 (*FnAchievementHandleLoad)(const char*);
+typedef uint32 (*FnAchievementHandleRelease)(uint64);
+typedef char*  (*FnAchievementHandleToJson)(uint64);
+typedef char*  (*FnAchievementHandleApply)(uint64, const char*, uint32, uint64);
+typedef float  (*FnAchievementHandleCompletionPercent)(uint64);
+
 // Tutorial
 typedef char* (*FnTutorialGetSteps)();
 typedef char* (*FnTutorialGetHints)();
@@ -138,13 +427,16 @@ typedef char* (*FnSocialTradeExecute)(const char*);
 // Hot-Reload (v0.6.0 - Session 22)
 typedef char* (*FnHotReloadGetStatus)();
 typedef uint32 (*FnHotReloadTriggerReload)();
+typedef uint32 (*FnHotReloadGetDomainGenerations)(uint64*, uint32);
 
 // Analytics (v0.6.0 - Session 22)
 typedef char* (*FnAnalyticsGetSnapshot)();
 typedef void  (*FnAnalyticsReset)();
 typedef void  (*FnAnalyticsRecordDamage)(const char*, uint32);
+typedef uint32 (*FnAnalyticsRecordDamageBatch)(const char*);
 typedef void  (*FnAnalyticsRecordFloorCleared)(uint32, uint32, float);
-typedef void  (*FnAnalyticsRecordGold)(uint64);
+typedef void  (*FnAnalyticsRecordGold)(uint64, uint32);
+typedef const FTowerAnalyticsCounters* (*FnAnalyticsGetCounters)();
 typedef char* (*FnAnalyticsGetEventTypes)();
 
 // ============================================================
@@ -168,6 +460,13 @@ public:
     // ============ Floor Generation ============
     FString GenerateFloor(uint64 Seed, uint32 FloorId);
     FString GenerateFloorLayout(uint64 Seed, uint32 FloorId);
+
+    /**
+     * Generate the layout straight into OutLayout through the binary export: one
+     * buffer fill and a memcpy of the tile grid, no JSON. Falls back to parsing
+     * GenerateFloorLayout() when the DLL predates the binary export.
+     */
+    bool GenerateFloorLayoutData(uint64 Seed, uint32 FloorId, FFloorLayoutData& OutLayout);
     uint64 GetFloorHash(uint64 Seed, uint32 FloorId);
     uint32 GetFloorTier(uint32 FloorId);
 
@@ -175,19 +474,46 @@ public:
     FString GenerateMonster(uint64 Hash, uint32 FloorLevel);
     FString GenerateFloorMonsters(uint64 Seed, uint32 FloorId, uint32 Count);
 
+    /** GenerateFloorMonsters() parsed into OutMonsters */
+    bool GenerateFloorMonsterData(uint64 Seed, uint32 FloorId, uint32 Count, TArray<FFloorMonsterData>& OutMonsters);
+
     // ============ Combat ============
     float GetAngleMultiplier(uint32 AngleId);
     FString CalculateCombat(const FString& RequestJson);
 
+    /**
+     * Resolve every request in one FFI call. TagSetsJson holds one tag array JSON
+     * per set (e.g. [["fire", 0.8]]), referenced by index from the requests.
+     * OutResults is resized to match Requests. Falls back to one CalculateCombat()
+     * per request for DLLs without the batch export.
+     */
+    bool CalculateCombatBatch(TConstArrayView<FCombatBatchRequest> Requests, TConstArrayView<FString> TagSetsJson,
+        TArray<FCombatBatchResult>& OutResults);
+
     // ============ Semantic ============
     float SemanticSimilarity(const FString& TagsA, const FString& TagsB);
 
     // ============ Loot ============
     FString GenerateLoot(const FString& SourceTagsJson, uint32 FloorLevel, uint64 DropHash);
 
+    /**
+     * Generate the drops of every source in one FFI call (a pack dying together),
+     * decoded into OutDrops in source order. TagSetsJson is a tag set table as for
+     * CalculateCombatBatch. Falls back to one GenerateLoot() per source for DLLs
+     * without the batch export.
+     */
+    bool GenerateLootBatch(TConstArrayView<FLootBatchSource> Sources, TConstArrayView<FString> TagSetsJson,
+        TArray<FLootDropData>& OutDrops);
+
+    /** Every item loot can drop (FTowerItemCatalog source JSON); empty for DLLs without the export */
+    FString GetItemCatalog();
+
     // ============ World ============
     FString GetBreathState(float ElapsedSeconds);
 
+    /** The breath cycle definition (FTowerBreathCycle JSON); empty for DLLs without the export */
+    FString GetBreathCycle();
+
     // ============ Replication ============
     FString RecordDelta(uint32 DeltaTypeId, uint32 FloorId, uint64 EntityHash,
                         const FString& PlayerId, const FString& Payload, uint64 Tick);
@@ -231,6 +557,43 @@ public:
     FString CosmeticApplyTransmog(const FString& ProfileJson, uint32 SlotId, const FString& CosmeticId);
     FString CosmeticApplyDye(const FString& ProfileJson, uint32 SlotId, uint32 ChannelId, const FString& DyeId);
 
+    // ============ Profile Handles ============
+    // Resident profiles; see the Rust "Profile Handles" section. Handles are 0 on failure,
+    // mutators return 1 changed / 0 unchanged / -1 bad handle or argument.
+    uint64 MasteryHandleCreate();
+    uint64 MasteryHandleLoad(const FString& ProfileJson);
+    uint32 MasteryHandleRelease(uint64 Handle);
+    FString MasteryHandleToJson(uint64 Handle);
+    int32 MasteryHandleGainXp(uint64 Handle, uint32 DomainId, uint64 Amount);
+    int32 MasteryHandleGetTier(uint64 Handle, uint32 DomainId);
+    uint64 MasteryHandleGetXp(uint64 Handle, uint32 DomainId);
+    uint64 SpecHandleCreate();
+    uint64 SpecHandleLoad(const FString& ProfileJson);
+    uint32 SpecHandleRelease(uint64 Handle);
+    FString SpecHandleToJson(uint64 Handle);
+    int32 SpecHandleChooseBranch(uint64 Handle, uint64 MasteryHandle, const FString& BranchId);
+    uint64 AbilityHandleCreate();
+    uint64 AbilityHandleLoad(const FString& LoadoutJson);
+    uint32 AbilityHandleRelease(uint64 Handle);
+    FString AbilityHandleToJson(uint64 Handle);
+    int32 AbilityHandleLearn(uint64 Handle, const FString& AbilityId);
+    int32 AbilityHandleEquip(uint64 Handle, uint32 Slot, const FString& AbilityId);
+    uint64 CosmeticHandleCreate();
+    uint64 CosmeticHandleLoad(const FString& ProfileJson);
+    uint32 CosmeticHandleRelease(uint64 Handle);
+    FString CosmeticHandleToJson(uint64 Handle);
+    int32 CosmeticHandleUnlock(uint64 Handle, const FString& CosmeticId);
+    int32 CosmeticHandleApplyTransmog(uint64 Handle, uint32 SlotId, const FString& CosmeticId);
+    int32 CosmeticHandleApplyDye(uint64 Handle, uint32 SlotId, uint32 ChannelId, const FString& DyeId);
+    uint64 AchievementHandleCreate();
+    uint64 AchievementHandleLoad(const FString& TrackerJson);
+    uint32 AchievementHandleRelease(uint64 Handle);
+    FString AchievementHandleToJson(uint64 Handle);
+    /** Apply {"id": amount} increments (empty for none) and the floor reached (0 skips);
+     *  returns the ids this call unlocked as a JSON array, empty on a bad handle */
+    FString AchievementHandleApply(uint64 Handle, const FString& IncrementsJson, uint32 CurrentFloor, uint64 CurrentTick);
+    float AchievementHandleCompletionPercent(uint64 Handle);
+
     // ============ Tutorial ============
     FString TutorialGetSteps();
     FString TutorialGetHints();
@@ -273,16 +636,48 @@ public:
     FString HotReloadGetStatus();
     uint32 HotReloadTriggerReload();
 
+    /**
+     * Reload generation of every ETowerConfigDomain, indexed by domain; a cache built
+     * from a domain is stale once its generation moves. False (and zeros) for DLLs
+     * without hotreload_get_domain_generations.
+     */
+    bool HotReloadGetDomainGenerations(uint64 (&OutGenerations)[TowerConfigDomainCount]);
+
+    /** Re-read the lookup tables from the DLL; done by Initialize() and HotReloadTriggerReload(). Any thread */
+    void RefreshLookupTables();
+
     // ============ Analytics (v0.6.0) ============
     FString AnalyticsGetSnapshot();
     void AnalyticsReset();
     void AnalyticsRecordDamage(const FString& WeaponName, uint32 Amount);
+
+    /** Record buffered per (weapon, floor) damage in one call (see analytics_record_damage_batch); returns hits recorded */
+    uint32 AnalyticsRecordDamageBatch(const FString& AggregatesJson);
+    bool HasAnalyticsRecordDamageBatch() const { return Fn_AnalyticsRecordDamageBatch != nullptr; }
+
     void AnalyticsRecordFloorCleared(uint32 FloorId, uint32 Tier, float TimeSecs);
     void AnalyticsRecordGold(uint64 Amount);
     FString AnalyticsGetEventTypes();
 
+    /**
+     * The DLL's analytics counter block, valid until Shutdown(); null if the
+     * DLL predates it or lays it out differently. Reading it takes no call and
+     * no lock, so overlays can poll it every frame. Any thread
+     */
+    const FTowerAnalyticsCounters* GetAnalyticsCounters() const { return AnalyticsCounters; }
+
 private:
     void* DllHandle = nullptr;
+    FDelegateHandle TrimScratchHandle;
+
+    /** Serializes the hot-reload and analytics calls and the lookup table refresh */
+    FCriticalSection StatefulCallsLock;
+
+    /** Readers use LookupTables[ActiveLookupTables]; RefreshLookupTables() fills the other and flips */
+    FBridgeLookupTables LookupTables[2];
+    std::atomic<int32> ActiveLookupTables{ 0 };
+
+    const FBridgeLookupTables& GetLookupTables() const { return LookupTables[ActiveLookupTables.load(std::memory_order_acquire)]; }
 
     // Core
     FnGetVersion Fn_GetVersion = nullptr;
@@ -291,25 +686,33 @@ private:
     // Floor Generation
     FnGenerateFloor Fn_GenerateFloor = nullptr;
     FnGenerateFloorLayout Fn_GenerateFloorLayout = nullptr;
+    FnGenerateFloorLayoutBinary Fn_GenerateFloorLayoutBinary = nullptr;
     FnGetFloorHash Fn_GetFloorHash = nullptr;
     FnGetFloorTier Fn_GetFloorTier = nullptr;
 
     // Monster
     FnGenerateMonster Fn_GenerateMonster = nullptr;
     FnGenerateFloorMonsters Fn_GenerateFloorMonsters = nullptr;
+    FnGenerateFloorMonstersInto Fn_GenerateFloorMonstersInto = nullptr;
 
     // Combat
     FnGetAngleMultiplier Fn_GetAngleMultiplier = nullptr;
     FnCalculateCombat Fn_CalculateCombat = nullptr;
+    FnCalculateCombatInto Fn_CalculateCombatInto = nullptr;
+    FnCalculateCombatBatch Fn_CalculateCombatBatch = nullptr;
 
     // Semantic
     FnSemanticSimilarity Fn_SemanticSimilarity = nullptr;
 
     // Loot
     FnGenerateLoot Fn_GenerateLoot = nullptr;
+    FnGenerateLootBatch Fn_GenerateLootBatch = nullptr;
+    FnGetItemCatalog Fn_GetItemCatalog = nullptr;
 
     // World
     FnGetBreathState Fn_GetBreathState = nullptr;
+    FnGetBreathStateInto Fn_GetBreathStateInto = nullptr;
+    FnGetBreathCycle Fn_GetBreathCycle = nullptr;
 
     // Replication
     FnRecordDelta Fn_RecordDelta = nullptr;
@@ -323,6 +726,7 @@ private:
     FnMasteryGainXp Fn_MasteryGainXp = nullptr;
     FnMasteryGetTier Fn_MasteryGetTier = nullptr;
     FnMasteryXpForAction Fn_MasteryXpForAction = nullptr;
+    FnMasteryGetActionXpTable Fn_MasteryGetActionXpTable = nullptr;
     FnMasteryGetAllDomains Fn_MasteryGetAllDomains = nullptr;
 
     // Specialization
@@ -353,6 +757,39 @@ private:
     FnCosmeticApplyTransmog Fn_CosmeticApplyTransmog = nullptr;
     FnCosmeticApplyDye Fn_CosmeticApplyDye = nullptr;
 
+    // Profile Handles
+    FnMasteryHandleCreate Fn_MasteryHandleCreate = nullptr;
+    FnMasteryHandleLoad Fn_MasteryHandleLoad = nullptr;
+    FnMasteryHandleRelease Fn_MasteryHandleRelease = nullptr;
+    FnMasteryHandleToJson Fn_MasteryHandleToJson = nullptr;
+    FnMasteryHandleGainXp Fn_MasteryHandleGainXp = nullptr;
+    FnMasteryHandleGetTier Fn_MasteryHandleGetTier = nullptr;
+    FnMasteryHandleGetXp Fn_MasteryHandleGetXp = nullptr;
+    FnSpecHandleCreate Fn_SpecHandleCreate = nullptr;
+    FnSpecHandleLoad Fn_SpecHandleLoad = nullptr;
+    FnSpecHandleRelease Fn_SpecHandleRelease = nullptr;
+    FnSpecHandleToJson Fn_SpecHandleToJson = nullptr;
+    FnSpecHandleChooseBranch Fn_SpecHandleChooseBranch = nullptr;
+    FnAbilityHandleCreate Fn_AbilityHandleCreate = nullptr;
+    FnAbilityHandleLoad Fn_AbilityHandleLoad = nullptr;
+    FnAbilityHandleRelease Fn_AbilityHandleRelease = nullptr;
+    FnAbilityHandleToJson Fn_AbilityHandleToJson = nullptr;
+    FnAbilityHandleLearn Fn_AbilityHandleLearn = nullptr;
+    FnAbilityHandleEquip Fn_AbilityHandleEquip = nullptr;
+    FnCosmeticHandleCreate Fn_CosmeticHandleCreate = nullptr;
+    FnCosmeticHandleLoad Fn_CosmeticHandleLoad = nullptr;
+    FnCosmeticHandleRelease Fn_CosmeticHandleRelease = nullptr;
+    FnCosmeticHandleToJson Fn_CosmeticHandleToJson = nullptr;
+    FnCosmeticHandleUnlock Fn_CosmeticHandleUnlock = nullptr;
+    FnCosmeticHandleApplyTransmog Fn_CosmeticHandleApplyTransmog = nullptr;
+    FnCosmeticHandleApplyDye Fn_CosmeticHandleApplyDye = nullptr;
+    FnAchievementHandleCreate Fn_AchievementHandleCreate = nullptr;
+    FnAchievementHandleLoad Fn_AchievementHandleLoad = nullptr;
+    FnAchievementHandleRelease Fn_AchievementHandleRelease = nullptr;
+    FnAchievementHandleToJson Fn_AchievementHandleToJson = nullptr;
+    FnAchievementHandleApply Fn_AchievementHandleApply = nullptr;
+    FnAchievementHandleCompletionPercent Fn_AchievementHandleCompletionPercent = nullptr;
+
     // Tutorial
     FnTutorialGetSteps Fn_TutorialGetSteps = nullptr;
     FnTutorialGetHints Fn_TutorialGetHints = nullptr;
@@ -391,12 +828,18 @@ private:
     // Hot-Reload (v0.6.0)
     FnHotReloadGetStatus Fn_HotReloadGetStatus = nullptr;
     FnHotReloadTriggerReload Fn_HotReloadTriggerReload = nullptr;
+    FnHotReloadGetDomainGenerations Fn_HotReloadGetDomainGenerations = nullptr;
 
     // Analytics (v0.6.0)
     FnAnalyticsGetSnapshot Fn_AnalyticsGetSnapshot = nullptr;
     FnAnalyticsReset Fn_AnalyticsReset = nullptr;
     FnAnalyticsRecordDamage Fn_AnalyticsRecordDamage = nullptr;
+    FnAnalyticsRecordDamageBatch Fn_AnalyticsRecordDamageBatch = nullptr;
     FnAnalyticsRecordFloorCleared Fn_AnalyticsRecordFloorCleared = nullptr;
     FnAnalyticsRecordGold Fn_AnalyticsRecordGold = nullptr;
     FnAnalyticsGetEventTypes Fn_AnalyticsGetEventTypes = nullptr;
+    FnAnalyticsGetCounters Fn_AnalyticsGetCounters = nullptr;
+
+    /** Fetched once at Initialize(); the block lives as long as the DLL */
+    const FTowerAnalyticsCounters* AnalyticsCounters = nullptr;
 };
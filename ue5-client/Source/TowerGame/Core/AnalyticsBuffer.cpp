@@ -0,0 +1,82 @@
+#include "AnalyticsBuffer.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+void FTowerAnalyticsBuffer::RecordDamage(FName Weapon, int32 FloorId, uint32 Amount)
+{
+    if (IsInGameThread())
+    {
+        Accumulate(Weapon, FloorId, Amount);
+    }
+    else
+    {
+        OffThreadHits.Enqueue(FDamageHit{ Weapon, FloorId, Amount });
+    }
+}
+
+bool FTowerAnalyticsBuffer::TakeDamage(TArray<FDamageAggregate>& OutAggregates)
+{
+    check(IsInGameThread());
+    DrainOffThreadHits();
+
+    OutAggregates.Reset(Damage.Num());
+    for (TPair<FDamageKey, FDamageAggregate>& Entry : Damage)
+    {
+        OutAggregates.Add(Entry.Value);
+    }
+    // Keep the buckets; the same weapons keep hitting on the same floor
+    Damage.Reset();
+    return OutAggregates.Num() > 0;
+}
+
+void FTowerAnalyticsBuffer::Reset()
+{
+    check(IsInGameThread());
+    DrainOffThreadHits();
+    Damage.Reset();
+}
+
+void FTowerAnalyticsBuffer::Accumulate(FName Weapon, int32 FloorId, uint32 Amount)
+{
+    FDamageAggregate& Aggregate = Damage.FindOrAdd(FDamageKey{ Weapon, FloorId });
+    if (Aggregate.Hits == 0)
+    {
+        Aggregate.Weapon = Weapon;
+        Aggregate.FloorId = FloorId;
+    }
+    Aggregate.Hits++;
+    Aggregate.TotalDamage += Amount;
+    Aggregate.MaxHit = FMath::Max(Aggregate.MaxHit, Amount);
+}
+
+void FTowerAnalyticsBuffer::DrainOffThreadHits()
+{
+    FDamageHit Hit;
+    while (OffThreadHits.Dequeue(Hit))
+    {
+        Accumulate(Hit.Weapon, Hit.FloorId, Hit.Amount);
+    }
+}
+
+FString FTowerAnalyticsBuffer::ToJson(TConstArrayView<FDamageAggregate> Aggregates)
+{
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    Entries.Reserve(Aggregates.Num());
+    for (const FDamageAggregate& Aggregate : Aggregates)
+    {
+        TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+        Obj->SetStringField(TEXT("weapon"), Aggregate.Weapon.ToString());
+        Obj->SetNumberField(TEXT("floor_id"), FMath::Max(Aggregate.FloorId, 0));
+        Obj->SetNumberField(TEXT("hits"), Aggregate.Hits);
+        Obj->SetNumberField(TEXT("total_damage"), static_cast<double>(Aggregate.TotalDamage));
+        Obj->SetNumberField(TEXT("max_hit"), Aggregate.MaxHit);
+        Entries.Add(MakeShared<FJsonValueObject>(Obj));
+    }
+
+    FString Json;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+    FJsonSerializer::Serialize(Entries, Writer);
+    return Json;
+}
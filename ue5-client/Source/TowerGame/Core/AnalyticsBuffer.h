@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/MpscQueue.h"
+
+/** Damage dealt with one weapon on one floor since the last flush */
+struct FDamageAggregate
+{
+    FName Weapon;
+    int32 FloorId = 0;
+    uint32 Hits = 0;
+    uint64 TotalDamage = 0;
+    uint32 MaxHit = 0;
+};
+
+/**
+ * Client-side telemetry buffer, so recording a hit costs a map update instead of an
+ * FFI call. Hits are summed per (weapon, floor) and taken out in one batch by the
+ * owner on its flush schedule.
+ *
+ * Lock-free: the game thread aggregates directly; other threads push raw hits onto
+ * an MPSC queue that the game thread folds in when it takes the batch.
+ */
+class TOWERGAME_API FTowerAnalyticsBuffer
+{
+public:
+    /** Any thread */
+    void RecordDamage(FName Weapon, int32 FloorId, uint32 Amount);
+
+    /** Move everything recorded so far into OutAggregates (game thread); false if there was nothing */
+    bool TakeDamage(TArray<FDamageAggregate>& OutAggregates);
+
+    /** Drop everything recorded so far (game thread) */
+    void Reset();
+
+    /** (weapon, floor) pairs waiting for the next flush; game thread, excludes hits still queued */
+    int32 GetNumPending() const { return Damage.Num(); }
+
+    /** The JSON analytics_record_damage_batch takes */
+    static FString ToJson(TConstArrayView<FDamageAggregate> Aggregates);
+
+private:
+    struct FDamageKey
+    {
+        FName Weapon;
+        int32 FloorId = 0;
+
+        bool operator==(const FDamageKey& Other) const { return Weapon == Other.Weapon && FloorId == Other.FloorId; }
+        friend uint32 GetTypeHash(const FDamageKey& Key) { return HashCombine(GetTypeHash(Key.Weapon), ::GetTypeHash(Key.FloorId)); }
+    };
+
+    struct FDamageHit
+    {
+        FName Weapon;
+        int32 FloorId = 0;
+        uint32 Amount = 0;
+    };
+
+    void Accumulate(FName Weapon, int32 FloorId, uint32 Amount);
+    void DrainOffThreadHits();
+
+    TMap<FDamageKey, FDamageAggregate> Damage;
+    TMpscQueue<FDamageHit> OffThreadHits;
+};
@@ -0,0 +1,93 @@
+#include "BreathCycle.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+bool FTowerBreathCycle::ParseJson(const FString& CycleJson)
+{
+    Reset();
+    if (CycleJson.IsEmpty()) return false;
+
+    TSharedPtr<FJsonObject> JsonObj;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CycleJson);
+    if (!FJsonSerializer::Deserialize(Reader, JsonObj) || !JsonObj.IsValid()) return false;
+
+    const TArray<TSharedPtr<FJsonValue>>* PhasesJson = nullptr;
+    if (!JsonObj->TryGetArrayField(TEXT("phases"), PhasesJson)) return false;
+
+    // Field names match Rust BreathPhaseDef; starts are the running sum, as breath_state computes them
+    float Start = 0.0f;
+    for (const TSharedPtr<FJsonValue>& Value : *PhasesJson)
+    {
+        const TSharedPtr<FJsonObject>* PhaseObj = nullptr;
+        if (!Value->TryGetObject(PhaseObj)) continue;
+
+        FTowerBreathPhase& Phase = Phases.AddDefaulted_GetRef();
+        Phase.Phase = (*PhaseObj)->GetStringField(TEXT("phase"));
+        Phase.StartSecs = Start;
+        Phase.DurationSecs = (*PhaseObj)->GetNumberField(TEXT("duration_secs"));
+        Phase.MonsterSpawnMult = (*PhaseObj)->GetNumberField(TEXT("monster_spawn_mult"));
+        Phase.ResourceMult = (*PhaseObj)->GetNumberField(TEXT("resource_mult"));
+        Phase.SemanticIntensity = (*PhaseObj)->GetNumberField(TEXT("semantic_intensity"));
+        Start += Phase.DurationSecs;
+
+        if (Phase.DurationSecs <= 0.0f)
+        {
+            Reset();
+            return false;
+        }
+    }
+
+    TotalSecs = JsonObj->HasField(TEXT("total_secs")) ? JsonObj->GetNumberField(TEXT("total_secs")) : Start;
+    if (!IsValid())
+    {
+        Reset();
+        return false;
+    }
+    return true;
+}
+
+void FTowerBreathCycle::Reset()
+{
+    Phases.Reset();
+    TotalSecs = 0.0f;
+}
+
+float FTowerBreathCycle::GetCyclePosition(float ElapsedSeconds) const
+{
+    const float Position = FMath::Fmod(ElapsedSeconds, TotalSecs);
+    return Position < 0.0f ? Position + TotalSecs : Position;
+}
+
+int32 FTowerBreathCycle::Evaluate(float ElapsedSeconds, float& OutProgress) const
+{
+    OutProgress = 0.0f;
+    if (!IsValid()) return INDEX_NONE;
+
+    const float Position = GetCyclePosition(ElapsedSeconds);
+
+    // The last phase takes whatever is left, like the else branch in breath_state
+    int32 Index = Phases.Num() - 1;
+    for (int32 i = 0; i < Phases.Num() - 1; i++)
+    {
+        if (Position < Phases[i + 1].StartSecs)
+        {
+            Index = i;
+            break;
+        }
+    }
+
+    const FTowerBreathPhase& Phase = Phases[Index];
+    OutProgress = (Position - Phase.StartSecs) / Phase.DurationSecs;
+    return Index;
+}
+
+float FTowerBreathCycle::GetSecondsToNextPhase(float ElapsedSeconds) const
+{
+    float Progress = 0.0f;
+    const int32 Index = Evaluate(ElapsedSeconds, Progress);
+    if (Index == INDEX_NONE) return TNumericLimits<float>::Max();
+
+    const float End = Index + 1 < Phases.Num() ? Phases[Index + 1].StartSecs : TotalSecs;
+    return FMath::Max(End - GetCyclePosition(ElapsedSeconds), 0.0f);
+}
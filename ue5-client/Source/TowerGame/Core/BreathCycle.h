@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One phase of the Breath of Tower cycle (Rust BreathPhaseDef) */
+struct FTowerBreathPhase
+{
+    FString Phase;
+    float StartSecs = 0.0f;
+    float DurationSecs = 0.0f;
+    float MonsterSpawnMult = 1.0f;
+    float ResourceMult = 1.0f;
+    float SemanticIntensity = 1.0f;
+};
+
+/**
+ * The Breath of Tower cycle definition, fetched once from get_breath_cycle and
+ * evaluated locally the way Rust breath_state does: the phase is the one whose
+ * span holds elapsed % TotalSecs, its progress the fraction of the span gone.
+ * Replaces a get_breath_state call (and its JSON) per update.
+ */
+struct TOWERGAME_API FTowerBreathCycle
+{
+    /** In cycle order, StartSecs ascending from 0 */
+    TArray<FTowerBreathPhase> Phases;
+    float TotalSecs = 0.0f;
+
+    /** From Rust BreathCycle JSON; false (and left empty) if it isn't one */
+    bool ParseJson(const FString& CycleJson);
+
+    bool IsValid() const { return Phases.Num() > 0 && TotalSecs > 0.0f; }
+    void Reset();
+
+    /** Index into Phases at ElapsedSeconds, with OutProgress in [0, 1); INDEX_NONE if not valid */
+    int32 Evaluate(float ElapsedSeconds, float& OutProgress) const;
+
+    /** Seconds from ElapsedSeconds until the phase it is in ends */
+    float GetSecondsToNextPhase(float ElapsedSeconds) const;
+
+private:
+    float GetCyclePosition(float ElapsedSeconds) const;
+};
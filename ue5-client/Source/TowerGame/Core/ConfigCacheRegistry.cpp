@@ -0,0 +1,52 @@
+#include "ConfigCacheRegistry.h"
+
+namespace
+{
+    const TCHAR* const ConfigDomainNames[TowerConfigDomainCount] = {
+        TEXT("Monsters"), TEXT("Loot"), TEXT("Abilities"), TEXT("Cosmetics") };
+}
+
+FDelegateHandle FTowerConfigCacheRegistry::Subscribe(ETowerConfigDomain Domain, FSimpleDelegate OnInvalidate)
+{
+    check(IsInGameThread());
+    return Subscribers[static_cast<int32>(Domain)].Add(MoveTemp(OnInvalidate));
+}
+
+void FTowerConfigCacheRegistry::Unsubscribe(ETowerConfigDomain Domain, FDelegateHandle Handle)
+{
+    check(IsInGameThread());
+    Subscribers[static_cast<int32>(Domain)].Remove(Handle);
+}
+
+uint32 FTowerConfigCacheRegistry::Update(const uint64 (&InGenerations)[TowerConfigDomainCount])
+{
+    check(IsInGameThread());
+
+    uint32 Changed = 0;
+    for (int32 i = 0; i < TowerConfigDomainCount; i++)
+    {
+        if (InGenerations[i] != Generations[i])
+        {
+            Generations[i] = InGenerations[i];
+            Changed |= 1u << i;
+            Invalidate(i);
+        }
+    }
+    return Changed;
+}
+
+void FTowerConfigCacheRegistry::InvalidateAll()
+{
+    check(IsInGameThread());
+    for (int32 i = 0; i < TowerConfigDomainCount; i++)
+    {
+        Invalidate(i);
+    }
+}
+
+void FTowerConfigCacheRegistry::Invalidate(int32 DomainIndex)
+{
+    UE_LOG(LogTemp, Log, TEXT("Config domain %s reloaded (generation %llu), invalidating its caches"),
+        ConfigDomainNames[DomainIndex], Generations[DomainIndex]);
+    Subscribers[DomainIndex].Broadcast();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Bridge/ProceduralCoreBridge.h"
+
+/**
+ * Client caches keyed by the config domain they were built from. After a hot reload
+ * the owner passes the bridge's per-domain generations to Update(), and only the
+ * subscribers of domains whose generation moved are told to drop their data, so
+ * tuning loot doesn't throw away monster caches (and the reparse hitch with them).
+ * Game thread only.
+ */
+class TOWERGAME_API FTowerConfigCacheRegistry
+{
+public:
+    /** Call OnInvalidate each time Domain changes in a reload */
+    FDelegateHandle Subscribe(ETowerConfigDomain Domain, FSimpleDelegate OnInvalidate);
+    void Unsubscribe(ETowerConfigDomain Domain, FDelegateHandle Handle);
+
+    /**
+     * Adopt new generations and invalidate the subscribers of every domain whose
+     * generation differs from the last one seen. Returns the invalidated domains as
+     * a mask of 1 << domain.
+     */
+    uint32 Update(const uint64 (&Generations)[TowerConfigDomainCount]);
+
+    /** Invalidate every domain regardless of generation (e.g. the DLL was reloaded) */
+    void InvalidateAll();
+
+    uint64 GetGeneration(ETowerConfigDomain Domain) const { return Generations[static_cast<int32>(Domain)]; }
+
+private:
+    void Invalidate(int32 DomainIndex);
+
+    uint64 Generations[TowerConfigDomainCount] = {};
+    FSimpleMulticastDelegate Subscribers[TowerConfigDomainCount];
+};
@@ -0,0 +1,157 @@
+#include "FloorDeltaJournal.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+// ============ Recording ============
+
+bool FTowerFloorDeltaJournal::FitsCell(int32 X, int32 Y)
+{
+    return X >= MIN_int16 && X <= MAX_int16 && Y >= MIN_int16 && Y <= MAX_int16;
+}
+
+void FTowerFloorDeltaJournal::RecordTile(int32 FloorId, int32 X, int32 Y, uint8 TileType)
+{
+    if (!ensure(FitsCell(X, Y))) return;
+    WriteTile(Floors.FindOrAdd(FloorId).Bytes, FIntPoint(X, Y), TileType);
+}
+
+void FTowerFloorDeltaJournal::RecordFragments(int32 FloorId, uint64 EntityId, TConstArrayView<uint8> Mask, bool bCollapsed)
+{
+    if (!ensure(Mask.Num() <= MAX_uint8)) return;
+    WriteFragments(Floors.FindOrAdd(FloorId).Bytes, EntityId, Mask, bCollapsed);
+}
+
+void FTowerFloorDeltaJournal::RecordChestOpened(int32 FloorId, int32 X, int32 Y)
+{
+    if (!ensure(FitsCell(X, Y))) return;
+    WriteChest(Floors.FindOrAdd(FloorId).Bytes, FIntPoint(X, Y));
+}
+
+void FTowerFloorDeltaJournal::WriteTile(TArray<uint8>& Bytes, FIntPoint Cell, uint8 TileType)
+{
+    FMemoryWriter Writer(Bytes, /*bIsPersistent=*/false, /*bSetOffset=*/true);
+    uint8 Kind = static_cast<uint8>(ERecordKind::Tile);
+    int16 X = static_cast<int16>(Cell.X);
+    int16 Y = static_cast<int16>(Cell.Y);
+    Writer << Kind << X << Y << TileType;
+}
+
+void FTowerFloorDeltaJournal::WriteFragments(TArray<uint8>& Bytes, uint64 EntityId, TConstArrayView<uint8> Mask, bool bCollapsed)
+{
+    FMemoryWriter Writer(Bytes, /*bIsPersistent=*/false, /*bSetOffset=*/true);
+    uint8 Kind = static_cast<uint8>(ERecordKind::Fragments);
+    uint8 Collapsed = bCollapsed ? 1 : 0;
+    uint8 MaskBytes = static_cast<uint8>(Mask.Num());
+    Writer << Kind << EntityId << Collapsed << MaskBytes;
+    Writer.Serialize(const_cast<uint8*>(Mask.GetData()), MaskBytes);
+}
+
+void FTowerFloorDeltaJournal::WriteChest(TArray<uint8>& Bytes, FIntPoint Cell)
+{
+    FMemoryWriter Writer(Bytes, /*bIsPersistent=*/false, /*bSetOffset=*/true);
+    uint8 Kind = static_cast<uint8>(ERecordKind::Chest);
+    int16 X = static_cast<int16>(Cell.X);
+    int16 Y = static_cast<int16>(Cell.Y);
+    Writer << Kind << X << Y;
+}
+
+// ============ Reading ============
+
+const FTowerFloorDeltaJournal::FFloorState* FTowerFloorDeltaJournal::Find(int32 FloorId)
+{
+    FFloorJournal* Journal = Floors.Find(FloorId);
+    if (!Journal) return nullptr;
+
+    if (Journal->NumFolded < Journal->Bytes.Num())
+    {
+        if (!Decode(Journal->Bytes, Journal->NumFolded, Journal->State))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Delta journal for floor %d is corrupt, dropping it"), FloorId);
+            Floors.Remove(FloorId);
+            return nullptr;
+        }
+        Journal->NumFolded = Journal->Bytes.Num();
+    }
+    return Journal->State.IsEmpty() ? nullptr : &Journal->State;
+}
+
+void FTowerFloorDeltaJournal::Compact(int32 FloorId)
+{
+    if (!Find(FloorId)) return;
+
+    FFloorJournal& Journal = Floors[FloorId];
+    Encode(Journal.State, Journal.Bytes);
+    Journal.NumFolded = Journal.Bytes.Num();
+}
+
+int32 FTowerFloorDeltaJournal::GetNumBytes(int32 FloorId) const
+{
+    const FFloorJournal* Journal = Floors.Find(FloorId);
+    return Journal ? Journal->Bytes.Num() : 0;
+}
+
+bool FTowerFloorDeltaJournal::Decode(TConstArrayView<uint8> Bytes, int32 Offset, FFloorState& OutState)
+{
+    FMemoryReaderView Reader(Bytes);
+    Reader.Seek(Offset);
+
+    while (!Reader.AtEnd())
+    {
+        uint8 Kind = 0;
+        Reader << Kind;
+
+        switch (static_cast<ERecordKind>(Kind))
+        {
+        case ERecordKind::Tile:
+        {
+            int16 X = 0, Y = 0;
+            uint8 TileType = 0;
+            Reader << X << Y << TileType;
+            OutState.Tiles.Add(FIntPoint(X, Y), TileType);
+            break;
+        }
+        case ERecordKind::Fragments:
+        {
+            uint64 EntityId = 0;
+            uint8 Collapsed = 0, MaskBytes = 0;
+            Reader << EntityId << Collapsed << MaskBytes;
+            if (Reader.Tell() + MaskBytes > Reader.TotalSize()) return false;
+
+            FFragmentState& Fragments = OutState.Fragments.FindOrAdd(EntityId);
+            Fragments.Mask.SetNumUninitialized(MaskBytes);
+            Reader.Serialize(Fragments.Mask.GetData(), MaskBytes);
+            Fragments.bCollapsed = Collapsed != 0;
+            break;
+        }
+        case ERecordKind::Chest:
+        {
+            int16 X = 0, Y = 0;
+            Reader << X << Y;
+            OutState.OpenedChests.Add(FIntPoint(X, Y));
+            break;
+        }
+        default:
+            return false;
+        }
+
+        if (Reader.IsError()) return false;
+    }
+    return true;
+}
+
+void FTowerFloorDeltaJournal::Encode(const FFloorState& State, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+    for (const TPair<FIntPoint, uint8>& Tile : State.Tiles)
+    {
+        WriteTile(OutBytes, Tile.Key, Tile.Value);
+    }
+    for (const TPair<uint64, FFragmentState>& Fragments : State.Fragments)
+    {
+        WriteFragments(OutBytes, Fragments.Key, Fragments.Value.Mask, Fragments.Value.bCollapsed);
+    }
+    for (const FIntPoint& Chest : State.OpenedChests)
+    {
+        WriteChest(OutBytes, Chest);
+    }
+}
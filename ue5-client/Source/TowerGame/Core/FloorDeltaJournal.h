@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Client-side record of what changed on each floor after it was generated: tile
+ * mutations, destructible fragment masks and opened chests. Revisiting a floor
+ * rebuilds the base layout (usually from the floor cache) and plays the journal
+ * straight onto the renderer's grid and the floor's actors, with no deltas JSON
+ * and no snapshot trip through the Rust core.
+ *
+ * Each floor is an append-only stream of little-endian records:
+ *
+ *   Tile       uint8 Kind=0, int16 X, int16 Y, uint8 TileType
+ *   Fragments  uint8 Kind=1, uint64 EntityId, uint8 bCollapsed, uint8 MaskBytes, MaskBytes x uint8
+ *   Chest      uint8 Kind=2, int16 X, int16 Y
+ *
+ * Later records win. Compacting a floor rewrites its stream as one record per cell
+ * or entity. Game thread only.
+ */
+class TOWERGAME_API FTowerFloorDeltaJournal
+{
+public:
+    struct FFragmentState
+    {
+        TArray<uint8> Mask;
+        bool bCollapsed = false;
+    };
+
+    /** A floor's journal folded down to its latest state */
+    struct FFloorState
+    {
+        TMap<FIntPoint, uint8> Tiles;
+        TMap<uint64, FFragmentState> Fragments;
+        TSet<FIntPoint> OpenedChests;
+
+        bool IsEmpty() const { return Tiles.Num() == 0 && Fragments.Num() == 0 && OpenedChests.Num() == 0; }
+    };
+
+    void RecordTile(int32 FloorId, int32 X, int32 Y, uint8 TileType);
+    void RecordFragments(int32 FloorId, uint64 EntityId, TConstArrayView<uint8> Mask, bool bCollapsed);
+    void RecordChestOpened(int32 FloorId, int32 X, int32 Y);
+
+    /**
+     * FloorId's latest state, null if nothing was recorded there. Only records added since
+     * the last call are decoded. The pointer is invalidated by the next Record* call.
+     */
+    const FFloorState* Find(int32 FloorId);
+
+    /** Rewrite FloorId's stream as one record per cell or entity (call on revisit) */
+    void Compact(int32 FloorId);
+
+    void Forget(int32 FloorId) { Floors.Remove(FloorId); }
+    void Reset() { Floors.Reset(); }
+
+    int32 GetNumBytes(int32 FloorId) const;
+
+private:
+    enum class ERecordKind : uint8
+    {
+        Tile = 0,
+        Fragments = 1,
+        Chest = 2,
+    };
+
+    struct FFloorJournal
+    {
+        TArray<uint8> Bytes;
+
+        /** Bytes[0, NumFolded) folded down */
+        FFloorState State;
+        int32 NumFolded = 0;
+    };
+
+    /** Fold Bytes from Offset on into OutState; false on an unknown kind or a truncated record */
+    static bool Decode(TConstArrayView<uint8> Bytes, int32 Offset, FFloorState& OutState);
+    static void Encode(const FFloorState& State, TArray<uint8>& OutBytes);
+
+    static void WriteTile(TArray<uint8>& Bytes, FIntPoint Cell, uint8 TileType);
+    static void WriteFragments(TArray<uint8>& Bytes, uint64 EntityId, TConstArrayView<uint8> Mask, bool bCollapsed);
+    static void WriteChest(TArray<uint8>& Bytes, FIntPoint Cell);
+
+    static bool FitsCell(int32 X, int32 Y);
+
+    TMap<int32, FFloorJournal> Floors;
+};
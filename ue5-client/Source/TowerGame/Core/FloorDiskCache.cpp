@@ -0,0 +1,540 @@
+#include "FloorDiskCache.h"
+#include "TowerGameSubsystem.h"
+#include "PackedTileGrid.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTLS.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    constexpr uint32 CacheMagic = 0x31434654; // "TFC1"
+    constexpr uint32 CacheFormatVersion = 3;
+    const TCHAR* CacheExtension = TEXT(".tfc");
+
+    constexpr uint32 PreviewMagic = 0x31504654; // "TFP1"
+    constexpr uint32 PreviewFormatVersion = 1;
+    const TCHAR* PreviewExtension = TEXT(".tfp");
+
+    struct FCacheHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+        uint64 FloorHash;
+        uint32 CoreVersionHash;
+        int32 FloorId;
+        int64 Seed;
+        uint16 Width;
+        uint16 Height;
+        uint16 RoomCount;
+        uint16 SpawnCount;
+        uint16 MonsterCount;
+        uint16 ExitX;
+        uint16 ExitY;
+        uint16 Reserved;
+    };
+
+    struct FCacheRoom
+    {
+        int32 X;
+        int32 Y;
+        int32 Width;
+        int32 Height;
+        uint8 RoomType;
+        uint8 Reserved[3];
+    };
+
+    struct FCachePoint
+    {
+        int32 X;
+        int32 Y;
+    };
+
+    struct FCacheMonster
+    {
+        UTF8CHAR Name[64];
+        float MaxHp;
+        float Damage;
+        float Armor;
+        float Speed;
+        uint8 Size;         // EMonsterSize
+        uint8 Element;      // EMonsterElement
+        uint8 Reserved[2];
+    };
+
+    struct FPreviewHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+        uint64 FloorHash;
+        uint32 CoreVersionHash;
+        uint16 Size;
+        uint16 Reserved;
+    };
+
+    static_assert(sizeof(FCacheHeader) == 48, "Cache header layout changed; bump CacheFormatVersion");
+    static_assert(sizeof(FCacheRoom) == 20, "Cache room layout changed; bump CacheFormatVersion");
+    static_assert(sizeof(FCachePoint) == 8, "Cache point layout changed; bump CacheFormatVersion");
+    static_assert(sizeof(FCacheMonster) == 84, "Cache monster layout changed; bump CacheFormatVersion");
+    static_assert(sizeof(FPreviewHeader) == 24, "Preview header layout changed; bump PreviewFormatVersion");
+
+    template <int32 N>
+    void WriteFixedString(UTF8CHAR (&Dest)[N], const FString& Value)
+    {
+        // Truncated to fit, always null terminated
+        FMemory::Memzero(Dest, N);
+        const FTCHARToUTF8 Utf8(*Value);
+        FMemory::Memcpy(Dest, Utf8.Get(), FMath::Min(Utf8.Length(), N - 1));
+    }
+
+    template <int32 N>
+    FString ReadFixedString(const UTF8CHAR (&Src)[N])
+    {
+        int32 Length = 0;
+        while (Length < N && Src[Length] != 0)
+        {
+            ++Length;
+        }
+        return FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Src), Length));
+    }
+
+    template <typename RecordType>
+    const RecordType* RecordAt(TArrayView<const uint8> Bytes, int64 Offset)
+    {
+        return reinterpret_cast<const RecordType*>(Bytes.GetData() + Offset);
+    }
+}
+
+// ============================================================================
+// FFloorDiskCache
+// ============================================================================
+
+FFloorDiskCache::FFloorDiskCache(const FString& InDirectory, const FString& CoreVersion, int64 InMaxBytes)
+    : Directory(InDirectory)
+    , CoreVersionHash(GetTypeHash(CoreVersion))
+    , MaxBytes(InMaxBytes)
+{
+    IFileManager::Get().MakeDirectory(*Directory, true);
+    ScanDirectory();
+
+    UE_LOG(LogTemp, Log, TEXT("FloorDiskCache: %d entries, %.1f / %.1f MB in %s"),
+        Entries.Num(), TotalBytes / (1024.0 * 1024.0), MaxBytes / (1024.0 * 1024.0), *Directory);
+}
+
+FString FFloorDiskCache::GetEntryPath(uint64 FloorHash, int32 MonsterCount) const
+{
+    return Directory / FString::Printf(TEXT("%016llx_%08x_%d%s"), FloorHash, CoreVersionHash, MonsterCount, CacheExtension);
+}
+
+FString FFloorDiskCache::GetPreviewPath(uint64 FloorHash, int32 Size) const
+{
+    return Directory / FString::Printf(TEXT("%016llx_%08x_%d%s"), FloorHash, CoreVersionHash, Size, PreviewExtension);
+}
+
+void FFloorDiskCache::ScanDirectory()
+{
+    const FString VersionTag = FString::Printf(TEXT("_%08x_"), CoreVersionHash);
+    TArray<FString> Stale;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.IterateDirectoryStat(*Directory, [&](const TCHAR* Path, const FFileStatData& Stat)
+    {
+        const FString FilePath(Path);
+        if (Stat.bIsDirectory || !(FilePath.EndsWith(CacheExtension) || FilePath.EndsWith(PreviewExtension)))
+        {
+            return true;
+        }
+
+        if (!FPaths::GetCleanFilename(FilePath).Contains(VersionTag))
+        {
+            Stale.Add(FilePath);
+            return true;
+        }
+
+        FEntry& Entry = Entries.Add(FilePath);
+        Entry.Size = Stat.FileSize;
+        Entry.LastUsed = Stat.ModificationTime;
+        TotalBytes += Stat.FileSize;
+        return true;
+    });
+
+    for (const FString& Path : Stale)
+    {
+        IFileManager::Get().Delete(*Path, false, true, true);
+    }
+    if (Stale.Num() > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("FloorDiskCache: removed %d entries from other core versions"), Stale.Num());
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    EvictLocked();
+}
+
+bool FFloorDiskCache::Load(uint64 FloorHash, int32 MonsterCount, FGeneratedFloorData& OutFloor)
+{
+    const FString Path = GetEntryPath(FloorHash, MonsterCount);
+    {
+        FScopeLock ScopeLock(&Lock);
+        FEntry* Entry = Entries.Find(Path);
+        if (!Entry)
+        {
+            Misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        Entry->LastUsed = FDateTime::UtcNow();
+    }
+
+    bool bDecoded = false;
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Path));
+    if (MappedFile)
+    {
+        // Region before handle on the way out (declaration order)
+        TUniquePtr<IMappedFileRegion> Region(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (Region)
+        {
+            bDecoded = Decode(TArrayView<const uint8>(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize())),
+                FloorHash, CoreVersionHash, OutFloor);
+        }
+    }
+    else
+    {
+        // Platforms without file mapping
+        TArray<uint8> Bytes;
+        bDecoded = FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent)
+            && Decode(Bytes, FloorHash, CoreVersionHash, OutFloor);
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    if (!bDecoded)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FloorDiskCache: dropping unreadable entry %s"), *Path);
+        RemoveEntryLocked(Path);
+        Misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // LRU order survives restarts through the file timestamp
+    IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+    Hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FFloorDiskCache::Store(uint64 FloorHash, int32 MonsterCount, const FGeneratedFloorData& Floor)
+{
+    TArray<uint8> Bytes;
+    if (!Floor.bSucceeded || !Encode(FloorHash, CoreVersionHash, Floor, Bytes))
+    {
+        return;
+    }
+
+    WriteEntry(GetEntryPath(FloorHash, MonsterCount), Bytes);
+}
+
+bool FFloorDiskCache::WriteEntry(const FString& Path, const TArray<uint8>& Bytes)
+{
+    // Write aside and move into place so a concurrent Load never maps a partial file
+    const FString TempPath = Path + FString::Printf(TEXT(".%u.tmp"), FPlatformTLS::GetCurrentThreadId());
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+    {
+        IFileManager::Get().Delete(*TempPath, false, true, true);
+        UE_LOG(LogTemp, Warning, TEXT("FloorDiskCache: failed to write %s"), *Path);
+        return false;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    if (const FEntry* Previous = Entries.Find(Path))
+    {
+        TotalBytes -= Previous->Size;
+    }
+    FEntry& Entry = Entries.Add(Path);
+    Entry.Size = Bytes.Num();
+    Entry.LastUsed = FDateTime::UtcNow();
+    TotalBytes += Entry.Size;
+
+    EvictLocked();
+    return true;
+}
+
+// ============ Previews ============
+
+bool FFloorDiskCache::LoadPreview(uint64 FloorHash, int32 Size, TArray<FColor>& OutPixels)
+{
+    const FString Path = GetPreviewPath(FloorHash, Size);
+    {
+        FScopeLock ScopeLock(&Lock);
+        FEntry* Entry = Entries.Find(Path);
+        if (!Entry)
+        {
+            return false;
+        }
+        Entry->LastUsed = FDateTime::UtcNow();
+    }
+
+    // Small enough that mapping buys nothing
+    TArray<uint8> Bytes;
+    const int64 PixelBytes = static_cast<int64>(Size) * Size * sizeof(FColor);
+    bool bDecoded = FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent)
+        && Bytes.Num() == static_cast<int64>(sizeof(FPreviewHeader)) + PixelBytes;
+    if (bDecoded)
+    {
+        const FPreviewHeader& Header = *RecordAt<FPreviewHeader>(Bytes, 0);
+        bDecoded = Header.Magic == PreviewMagic && Header.FormatVersion == PreviewFormatVersion
+            && Header.FloorHash == FloorHash && Header.CoreVersionHash == CoreVersionHash && Header.Size == Size;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    if (!bDecoded)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FloorDiskCache: dropping unreadable preview %s"), *Path);
+        RemoveEntryLocked(Path);
+        return false;
+    }
+
+    OutPixels.SetNumUninitialized(Size * Size);
+    FMemory::Memcpy(OutPixels.GetData(), Bytes.GetData() + sizeof(FPreviewHeader), PixelBytes);
+    IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow());
+    return true;
+}
+
+void FFloorDiskCache::StorePreview(uint64 FloorHash, int32 Size, TConstArrayView<FColor> Pixels)
+{
+    if (Size <= 0 || Size > MAX_uint16 || Pixels.Num() != Size * Size)
+    {
+        return;
+    }
+
+    FPreviewHeader Header = {};
+    Header.Magic = PreviewMagic;
+    Header.FormatVersion = PreviewFormatVersion;
+    Header.FloorHash = FloorHash;
+    Header.CoreVersionHash = CoreVersionHash;
+    Header.Size = static_cast<uint16>(Size);
+
+    TArray<uint8> Bytes;
+    Bytes.Reset(sizeof(Header) + Pixels.Num() * sizeof(FColor));
+    Bytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    Bytes.Append(reinterpret_cast<const uint8*>(Pixels.GetData()), Pixels.Num() * sizeof(FColor));
+    WriteEntry(GetPreviewPath(FloorHash, Size), Bytes);
+}
+
+void FFloorDiskCache::Clear()
+{
+    FScopeLock ScopeLock(&Lock);
+    for (const TPair<FString, FEntry>& Pair : Entries)
+    {
+        IFileManager::Get().Delete(*Pair.Key, false, true, true);
+    }
+    Entries.Reset();
+    TotalBytes = 0;
+}
+
+int64 FFloorDiskCache::GetTotalBytes() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return TotalBytes;
+}
+
+int32 FFloorDiskCache::GetEntryCount() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Entries.Num();
+}
+
+void FFloorDiskCache::EvictLocked()
+{
+    if (TotalBytes <= MaxBytes)
+    {
+        return;
+    }
+
+    TArray<TPair<FDateTime, FString>> ByAge;
+    ByAge.Reserve(Entries.Num());
+    for (const TPair<FString, FEntry>& Pair : Entries)
+    {
+        ByAge.Emplace(Pair.Value.LastUsed, Pair.Key);
+    }
+    ByAge.Sort([](const TPair<FDateTime, FString>& A, const TPair<FDateTime, FString>& B) { return A.Key < B.Key; });
+
+    int32 Evicted = 0;
+    for (const TPair<FDateTime, FString>& Oldest : ByAge)
+    {
+        if (TotalBytes <= MaxBytes)
+        {
+            break;
+        }
+        RemoveEntryLocked(Oldest.Value);
+        ++Evicted;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("FloorDiskCache: evicted %d entries, %.1f MB left"), Evicted, TotalBytes / (1024.0 * 1024.0));
+}
+
+void FFloorDiskCache::RemoveEntryLocked(const FString& Path)
+{
+    FEntry Removed;
+    if (Entries.RemoveAndCopyValue(Path, Removed))
+    {
+        TotalBytes -= Removed.Size;
+    }
+    IFileManager::Get().Delete(*Path, false, true, true);
+}
+
+// ============================================================================
+// Format
+// ============================================================================
+
+bool FFloorDiskCache::Encode(uint64 FloorHash, uint32 CoreVersionHash, const FGeneratedFloorData& Floor, TArray<uint8>& OutBytes)
+{
+    const FFloorLayoutData& Layout = Floor.Layout;
+    if (!Layout.IsValid() || Layout.Width > MAX_uint16 || Layout.Height > MAX_uint16
+        || Layout.Rooms.Num() > MAX_uint16 || Layout.SpawnPoints.Num() > MAX_uint16 || Floor.Monsters.Num() > MAX_uint16)
+    {
+        return false;
+    }
+
+    FCacheHeader Header = {};
+    Header.Magic = CacheMagic;
+    Header.FormatVersion = CacheFormatVersion;
+    Header.FloorHash = FloorHash;
+    Header.CoreVersionHash = CoreVersionHash;
+    Header.FloorId = Floor.FloorId;
+    Header.Seed = Floor.Seed;
+    Header.Width = static_cast<uint16>(Layout.Width);
+    Header.Height = static_cast<uint16>(Layout.Height);
+    Header.RoomCount = static_cast<uint16>(Layout.Rooms.Num());
+    Header.SpawnCount = static_cast<uint16>(Layout.SpawnPoints.Num());
+    Header.MonsterCount = static_cast<uint16>(Floor.Monsters.Num());
+    Header.ExitX = static_cast<uint16>(Layout.ExitPoint.X);
+    Header.ExitY = static_cast<uint16>(Layout.ExitPoint.Y);
+
+    FPackedTileGrid Grid;
+    if (!Grid.Pack(Layout.Tiles, Layout.Width, Layout.Height))
+    {
+        return false;
+    }
+
+    OutBytes.Reset(sizeof(Header) + Header.RoomCount * sizeof(FCacheRoom) + Header.SpawnCount * sizeof(FCachePoint)
+        + Header.MonsterCount * sizeof(FCacheMonster) + 12 + Grid.Runs.Num()); // grid header without biome regions
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+    for (const FFloorLayoutRoom& Room : Layout.Rooms)
+    {
+        FCacheRoom Record = {};
+        Record.X = Room.X;
+        Record.Y = Room.Y;
+        Record.Width = Room.Width;
+        Record.Height = Room.Height;
+        Record.RoomType = static_cast<uint8>(Room.RoomType);
+        OutBytes.Append(reinterpret_cast<const uint8*>(&Record), sizeof(Record));
+    }
+
+    for (const FIntPoint& Point : Layout.SpawnPoints)
+    {
+        const FCachePoint Record = { Point.X, Point.Y };
+        OutBytes.Append(reinterpret_cast<const uint8*>(&Record), sizeof(Record));
+    }
+
+    for (const FFloorMonsterData& Monster : Floor.Monsters)
+    {
+        FCacheMonster Record = {};
+        WriteFixedString(Record.Name, Monster.Name);
+        Record.MaxHp = Monster.MaxHp;
+        Record.Damage = Monster.Damage;
+        Record.Armor = Monster.Armor;
+        Record.Speed = Monster.Speed;
+        Record.Size = static_cast<uint8>(Monster.Size);
+        Record.Element = static_cast<uint8>(Monster.Element);
+        OutBytes.Append(reinterpret_cast<const uint8*>(&Record), sizeof(Record));
+    }
+
+    Grid.Serialize(OutBytes);
+    return true;
+}
+
+bool FFloorDiskCache::Decode(TArrayView<const uint8> Bytes, uint64 FloorHash, uint32 CoreVersionHash, FGeneratedFloorData& OutFloor)
+{
+    if (Bytes.Num() < static_cast<int32>(sizeof(FCacheHeader)))
+    {
+        return false;
+    }
+
+    const FCacheHeader& Header = *RecordAt<FCacheHeader>(Bytes, 0);
+    if (Header.Magic != CacheMagic || Header.FormatVersion != CacheFormatVersion
+        || Header.FloorHash != FloorHash || Header.CoreVersionHash != CoreVersionHash)
+    {
+        return false;
+    }
+
+    const int64 RoomsOffset = sizeof(FCacheHeader);
+    const int64 SpawnsOffset = RoomsOffset + Header.RoomCount * sizeof(FCacheRoom);
+    const int64 MonstersOffset = SpawnsOffset + Header.SpawnCount * sizeof(FCachePoint);
+    const int64 TilesOffset = MonstersOffset + Header.MonsterCount * sizeof(FCacheMonster);
+    if (Bytes.Num() < TilesOffset)
+    {
+        return false;
+    }
+
+    FPackedTileGrid Grid;
+    int32 GridEnd = static_cast<int32>(TilesOffset);
+    if (!Grid.Deserialize(Bytes, GridEnd) || GridEnd != Bytes.Num()
+        || Grid.Width != Header.Width || Grid.Height != Header.Height)
+    {
+        return false;
+    }
+
+    OutFloor.Seed = Header.Seed;
+    OutFloor.FloorId = Header.FloorId;
+
+    FFloorLayoutData& Layout = OutFloor.Layout;
+    Layout.Width = Header.Width;
+    Layout.Height = Header.Height;
+    Layout.ExitPoint = FIntPoint(Header.ExitX, Header.ExitY);
+
+    const FCacheRoom* Rooms = RecordAt<FCacheRoom>(Bytes, RoomsOffset);
+    Layout.Rooms.SetNum(Header.RoomCount, false);
+    for (int32 i = 0; i < Header.RoomCount; i++)
+    {
+        FFloorLayoutRoom& Room = Layout.Rooms[i];
+        Room.X = Rooms[i].X;
+        Room.Y = Rooms[i].Y;
+        Room.Width = Rooms[i].Width;
+        Room.Height = Rooms[i].Height;
+        Room.RoomType = Rooms[i].RoomType <= static_cast<uint8>(EFloorRoomType::Exit)
+            ? static_cast<EFloorRoomType>(Rooms[i].RoomType) : EFloorRoomType::Combat;
+    }
+
+    const FCachePoint* Spawns = RecordAt<FCachePoint>(Bytes, SpawnsOffset);
+    Layout.SpawnPoints.SetNum(Header.SpawnCount, false);
+    for (int32 i = 0; i < Header.SpawnCount; i++)
+    {
+        Layout.SpawnPoints[i] = FIntPoint(Spawns[i].X, Spawns[i].Y);
+    }
+
+    const FCacheMonster* Monsters = RecordAt<FCacheMonster>(Bytes, MonstersOffset);
+    OutFloor.Monsters.SetNum(Header.MonsterCount, false);
+    for (int32 i = 0; i < Header.MonsterCount; i++)
+    {
+        FFloorMonsterData& Monster = OutFloor.Monsters[i];
+        Monster.Name = ReadFixedString(Monsters[i].Name);
+        Monster.Size = TowerMonsterTags::SanitizeSize(Monsters[i].Size);
+        Monster.Element = TowerMonsterTags::SanitizeElement(Monsters[i].Element);
+        Monster.MaxHp = Monsters[i].MaxHp;
+        Monster.Damage = Monsters[i].Damage;
+        Monster.Armor = Monsters[i].Armor;
+        Monster.Speed = Monsters[i].Speed;
+    }
+
+    if (!Grid.Unpack(Layout.Tiles))
+    {
+        return false;
+    }
+
+    OutFloor.bSucceeded = true;
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+struct FGeneratedFloorData;
+
+/**
+ * On-disk cache of generated floors (layout + monster roster), one file per floor.
+ *
+ * Entries are keyed by FProceduralCoreBridge::GetFloorHash(), the monster count and a
+ * hash of the Rust core version, so a DLL update invalidates everything (stale files
+ * are deleted on startup). A file is a fixed sequence of fixed-size records:
+ *
+ *   header    magic, format version, floor hash, core version hash, seed, floor id,
+ *             width, height, room / spawn / monster counts, exit point
+ *   rooms     RoomCount x { int32 X, Y, Width, Height; uint8 RoomType }
+ *   spawns    SpawnCount x { int32 X, Y }
+ *   monsters  MonsterCount x { UTF-8 Name[64], Size[16], Element[16]; float stats }
+ *   tiles     FPackedTileGrid blob (run-length encoded, 4-bit types)
+ *
+ * A hit memory-maps the file, copies the records out and expands the tile runs. Every hit
+ * touches the file's timestamp, and once the directory grows past the size cap the
+ * least recently used files are deleted.
+ *
+ * A floor's map preview (UTowerFloorPreviewSubsystem) is kept next to it, keyed by floor
+ * hash, core version and size, and counts toward the same cap:
+ *
+ *   header    magic, format version, floor hash, core version hash, size
+ *   pixels    Size x Size FColor, row-major
+ *
+ * Thread-safe: Load and Store are called from floor generation workers.
+ */
+class TOWERGAME_API FFloorDiskCache
+{
+public:
+    FFloorDiskCache(const FString& InDirectory, const FString& CoreVersion, int64 InMaxBytes);
+
+    /** Fill OutFloor from the cache; false on a miss or a corrupt entry (which is deleted) */
+    bool Load(uint64 FloorHash, int32 MonsterCount, FGeneratedFloorData& OutFloor);
+
+    /** Write a successfully generated floor, evicting old entries if over the cap */
+    void Store(uint64 FloorHash, int32 MonsterCount, const FGeneratedFloorData& Floor);
+
+    /** Fill OutPixels (Size x Size) with the floor's stored preview; false on a miss */
+    bool LoadPreview(uint64 FloorHash, int32 Size, TArray<FColor>& OutPixels);
+
+    void StorePreview(uint64 FloorHash, int32 Size, TConstArrayView<FColor> Pixels);
+
+    /** Delete every entry */
+    void Clear();
+
+    int64 GetTotalBytes() const;
+    int32 GetEntryCount() const;
+    int32 GetHitCount() const { return Hits.load(std::memory_order_relaxed); }
+    int32 GetMissCount() const { return Misses.load(std::memory_order_relaxed); }
+
+private:
+    struct FEntry
+    {
+        int64 Size = 0;
+        FDateTime LastUsed;
+    };
+
+    FString GetEntryPath(uint64 FloorHash, int32 MonsterCount) const;
+    FString GetPreviewPath(uint64 FloorHash, int32 Size) const;
+
+    /** Write Bytes to Path and index it, evicting if over the cap; false if the write failed */
+    bool WriteEntry(const FString& Path, const TArray<uint8>& Bytes);
+
+    /** Index existing files, deleting those written by a different core version */
+    void ScanDirectory();
+
+    /** Delete least recently used entries until under MaxBytes; Lock must be held */
+    void EvictLocked();
+
+    void RemoveEntryLocked(const FString& Path);
+
+    static bool Encode(uint64 FloorHash, uint32 CoreVersionHash, const FGeneratedFloorData& Floor, TArray<uint8>& OutBytes);
+    static bool Decode(TArrayView<const uint8> Bytes, uint64 FloorHash, uint32 CoreVersionHash, FGeneratedFloorData& OutFloor);
+
+    FString Directory;
+    uint32 CoreVersionHash = 0;
+    int64 MaxBytes = 0;
+
+    mutable FCriticalSection Lock;
+    TMap<FString, FEntry> Entries;
+    int64 TotalBytes = 0;
+
+    std::atomic<int32> Hits{ 0 };
+    std::atomic<int32> Misses{ 0 };
+};
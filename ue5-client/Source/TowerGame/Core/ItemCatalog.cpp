@@ -0,0 +1,486 @@
+#include "ItemCatalog.h"
+#include "Bridge/ProceduralCoreBridge.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    constexpr uint32 CatalogMagic = 0x31434954; // "TIC1"
+    constexpr uint16 CatalogFormatVersion = 1;
+    const TCHAR* CatalogExtension = TEXT(".tic");
+
+    uint32 HashName(const UTF8CHAR* Name, int32 Length)
+    {
+        // FNV-1a: the file's hash, so it can't follow GetTypeHash across engine versions
+        uint32 Hash = 2166136261u;
+        for (int32 i = 0; i < Length; i++)
+        {
+            Hash = (Hash ^ static_cast<uint8>(Name[i])) * 16777619u;
+        }
+        return Hash;
+    }
+}
+
+struct FTowerItemCatalog::FHeader
+{
+    uint32 Magic;
+    uint16 FormatVersion;
+    uint16 Reserved;
+    uint32 CoreVersionHash;
+    uint32 ItemCount;
+    uint32 TagCount;
+    uint32 BucketCount;
+    uint32 StringBytes;
+    uint32 Reserved2;
+};
+
+struct FTowerItemCatalog::FItemRecord
+{
+    uint32 NameOffset;
+    uint16 NameLength;
+    uint8 Category;
+    uint8 Reserved;
+    uint32 FirstTag;
+    uint16 TagCount;
+    uint16 Reserved2;
+};
+
+struct FTowerItemCatalog::FTagRecord
+{
+    uint32 NameOffset;
+    uint16 NameLength;
+    uint16 Reserved;
+    float Value;
+};
+
+// ============================================================================
+// FTowerItemDefinition
+// ============================================================================
+
+bool FTowerItemDefinition::ParseJsonArray(const FString& Json, TArray<FTowerItemDefinition>& OutDefinitions)
+{
+    OutDefinitions.Reset();
+
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    if (!FJsonSerializer::Deserialize(Reader, Entries))
+    {
+        return false;
+    }
+
+    OutDefinitions.Reserve(Entries.Num());
+    for (const TSharedPtr<FJsonValue>& Value : Entries)
+    {
+        const TSharedPtr<FJsonObject>* Entry = nullptr;
+        if (!Value.IsValid() || !Value->TryGetObject(Entry))
+        {
+            return false;
+        }
+
+        FTowerItemDefinition& Definition = OutDefinitions.AddDefaulted_GetRef();
+        Definition.Name = (*Entry)->GetStringField(TEXT("name"));
+        Definition.Category = FLootDropData::CategoryFromName((*Entry)->GetStringField(TEXT("category")));
+
+        const TArray<TSharedPtr<FJsonValue>>* Tags = nullptr;
+        if ((*Entry)->TryGetArrayField(TEXT("tags"), Tags))
+        {
+            for (const TSharedPtr<FJsonValue>& Tag : *Tags)
+            {
+                const TArray<TSharedPtr<FJsonValue>>& Pair = Tag->AsArray();
+                if (Pair.Num() >= 2)
+                {
+                    Definition.Tags.Emplace(Pair[0]->AsString(), static_cast<float>(Pair[1]->AsNumber()));
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// FTowerItemCatalog
+// ============================================================================
+
+FTowerItemCatalog::FTowerItemCatalog() = default;
+
+FTowerItemCatalog::~FTowerItemCatalog()
+{
+    Close();
+}
+
+FTowerItemCatalog& FTowerItemCatalog::Get()
+{
+    static FTowerItemCatalog Catalog;
+    return Catalog;
+}
+
+bool FTowerItemCatalog::Open(const FString& Directory, const FString& CoreVersion, TFunctionRef<FString()> GetDefinitionsJson)
+{
+    Close();
+
+    const uint32 CoreVersionHash = GetTypeHash(CoreVersion);
+    const FString FileName = FString::Printf(TEXT("ItemCatalog-%08x%s"), CoreVersionHash, CatalogExtension);
+    const FString Path = Directory / FileName;
+
+    IFileManager::Get().MakeDirectory(*Directory, true);
+
+    // One catalog per core version; the others can't be read by this build
+    TArray<FString> Found;
+    IFileManager::Get().FindFiles(Found, *(Directory / (FString(TEXT("*")) + CatalogExtension)), true, false);
+    for (const FString& Other : Found)
+    {
+        if (Other != FileName)
+        {
+            IFileManager::Get().Delete(*(Directory / Other), false, true, true);
+        }
+    }
+
+    if (OpenFile(Path, CoreVersionHash))
+    {
+        return true;
+    }
+
+    const FString Json = GetDefinitionsJson();
+    TArray<FTowerItemDefinition> Definitions;
+    if (Json.IsEmpty() || !FTowerItemDefinition::ParseJsonArray(Json, Definitions) || Definitions.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ItemCatalog: the core has no item catalog; inventory keeps full item data"));
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    if (!Encode(Definitions, CoreVersionHash, Bytes))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ItemCatalog: %d definitions don't fit the file format"), Definitions.Num());
+        return false;
+    }
+
+    // Write aside and move into place so a crash never leaves a partial catalog
+    const FString TempPath = Path + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+    {
+        IFileManager::Get().Delete(*TempPath, false, true, true);
+        UE_LOG(LogTemp, Warning, TEXT("ItemCatalog: failed to write %s"), *Path);
+        return false;
+    }
+
+    return OpenFile(Path, CoreVersionHash);
+}
+
+bool FTowerItemCatalog::OpenFile(const FString& Path, uint32 CoreVersionHash)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    if (!PlatformFile.FileExists(*Path))
+    {
+        return false;
+    }
+
+    MappedFile.Reset(PlatformFile.OpenMapped(*Path));
+    if (MappedFile)
+    {
+        MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+    }
+
+    bool bAttached = false;
+    if (MappedRegion)
+    {
+        bAttached = Attach(TArrayView<const uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize())),
+            CoreVersionHash);
+    }
+    else
+    {
+        // Platforms without file mapping
+        MappedFile.Reset();
+        bAttached = FFileHelper::LoadFileToArray(LoadedFile, *Path, FILEREAD_Silent)
+            && Attach(LoadedFile, CoreVersionHash);
+    }
+
+    if (!bAttached)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ItemCatalog: dropping unreadable %s"), *Path);
+        Close();
+        IFileManager::Get().Delete(*Path, false, true, true);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ItemCatalog: %d items, %d tags, %.1f KB %s"), NumItems, NumTags,
+        Bytes.Num() / 1024.0, MappedRegion ? TEXT("mapped") : TEXT("loaded"));
+    return true;
+}
+
+void FTowerItemCatalog::Close()
+{
+    Bytes = TArrayView<const uint8>();
+    Items = nullptr;
+    Tags = nullptr;
+    Buckets = nullptr;
+    Strings = nullptr;
+    NumItems = 0;
+    NumTags = 0;
+    BucketMask = 0;
+    StringBytes = 0;
+
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    LoadedFile.Empty();
+}
+
+bool FTowerItemCatalog::Attach(TArrayView<const uint8> InBytes, uint32 CoreVersionHash)
+{
+    static_assert(sizeof(FHeader) == 32, "Catalog header layout changed; bump CatalogFormatVersion");
+    static_assert(sizeof(FItemRecord) == 16, "Catalog item layout changed; bump CatalogFormatVersion");
+    static_assert(sizeof(FTagRecord) == 12, "Catalog tag layout changed; bump CatalogFormatVersion");
+
+    if (InBytes.Num() < static_cast<int32>(sizeof(FHeader)))
+    {
+        return false;
+    }
+
+    const FHeader& Header = *reinterpret_cast<const FHeader*>(InBytes.GetData());
+    if (Header.Magic != CatalogMagic || Header.FormatVersion != CatalogFormatVersion || Header.CoreVersionHash != CoreVersionHash
+        || Header.BucketCount == 0 || !FMath::IsPowerOfTwo(Header.BucketCount) || Header.BucketCount < Header.ItemCount)
+    {
+        return false;
+    }
+
+    const int64 ItemsOffset = sizeof(FHeader);
+    const int64 TagsOffset = ItemsOffset + int64(Header.ItemCount) * sizeof(FItemRecord);
+    const int64 BucketsOffset = TagsOffset + int64(Header.TagCount) * sizeof(FTagRecord);
+    const int64 StringsOffset = BucketsOffset + int64(Header.BucketCount) * sizeof(uint32);
+    if (InBytes.Num() != StringsOffset + Header.StringBytes)
+    {
+        return false;
+    }
+
+    // Validate every record once, so lookups can trust the mapping
+    const FItemRecord* InItems = reinterpret_cast<const FItemRecord*>(InBytes.GetData() + ItemsOffset);
+    const FTagRecord* InTags = reinterpret_cast<const FTagRecord*>(InBytes.GetData() + TagsOffset);
+    for (uint32 i = 0; i < Header.ItemCount; i++)
+    {
+        const FItemRecord& Item = InItems[i];
+        if (int64(Item.NameOffset) + Item.NameLength > Header.StringBytes || int64(Item.FirstTag) + Item.TagCount > Header.TagCount)
+        {
+            return false;
+        }
+    }
+    for (uint32 i = 0; i < Header.TagCount; i++)
+    {
+        if (int64(InTags[i].NameOffset) + InTags[i].NameLength > Header.StringBytes)
+        {
+            return false;
+        }
+    }
+
+    Bytes = InBytes;
+    Items = InItems;
+    Tags = InTags;
+    Buckets = reinterpret_cast<const uint32*>(InBytes.GetData() + BucketsOffset);
+    Strings = reinterpret_cast<const UTF8CHAR*>(InBytes.GetData() + StringsOffset);
+    NumItems = static_cast<int32>(Header.ItemCount);
+    NumTags = static_cast<int32>(Header.TagCount);
+    BucketMask = Header.BucketCount - 1;
+    StringBytes = Header.StringBytes;
+    return true;
+}
+
+// ============ Lookups ============
+
+const FTowerItemCatalog::FItemRecord& FTowerItemCatalog::GetItem(int32 Id) const
+{
+    check(IsValidId(Id));
+    return Items[Id];
+}
+
+FString FTowerItemCatalog::GetString(uint32 Offset, uint16 Length) const
+{
+    return FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Strings + Offset), Length));
+}
+
+int32 FTowerItemCatalog::FindId(const FString& Name) const
+{
+    if (NumItems == 0 || Name.IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+
+    const FTCHARToUTF8 Utf8(*Name);
+    const UTF8CHAR* Key = reinterpret_cast<const UTF8CHAR*>(Utf8.Get());
+    const int32 KeyLength = Utf8.Length();
+
+    for (uint32 Probe = HashName(Key, KeyLength), Tries = 0; Tries <= BucketMask; ++Probe, ++Tries)
+    {
+        const uint32 Entry = Buckets[Probe & BucketMask];
+        if (Entry == 0 || Entry > static_cast<uint32>(NumItems))
+        {
+            return INDEX_NONE;
+        }
+
+        const FItemRecord& Item = Items[Entry - 1];
+        if (Item.NameLength == KeyLength && FMemory::Memcmp(Strings + Item.NameOffset, Key, KeyLength) == 0)
+        {
+            return static_cast<int32>(Entry - 1);
+        }
+    }
+    return INDEX_NONE;
+}
+
+FString FTowerItemCatalog::GetName(int32 Id) const
+{
+    if (!IsValidId(Id))
+    {
+        return FString();
+    }
+    const FItemRecord& Item = GetItem(Id);
+    return GetString(Item.NameOffset, Item.NameLength);
+}
+
+uint8 FTowerItemCatalog::GetCategory(int32 Id) const
+{
+    return IsValidId(Id) ? GetItem(Id).Category : 0;
+}
+
+const TCHAR* FTowerItemCatalog::GetCategoryName(int32 Id) const
+{
+    return FLootDropData::CategoryNameOf(GetCategory(Id));
+}
+
+void FTowerItemCatalog::GetTags(int32 Id, TArray<TPair<FString, float>>& OutTags) const
+{
+    if (!IsValidId(Id))
+    {
+        return;
+    }
+
+    const FItemRecord& Item = GetItem(Id);
+    OutTags.Reserve(OutTags.Num() + Item.TagCount);
+    for (uint32 i = Item.FirstTag; i < uint32(Item.FirstTag) + Item.TagCount; i++)
+    {
+        OutTags.Emplace(GetString(Tags[i].NameOffset, Tags[i].NameLength), Tags[i].Value);
+    }
+}
+
+// ============================================================================
+// Format
+// ============================================================================
+
+bool FTowerItemCatalog::Encode(TConstArrayView<FTowerItemDefinition> Definitions, uint32 CoreVersionHash, TArray<uint8>& OutBytes)
+{
+    if (Definitions.Num() == 0 || Definitions.Num() > (1 << 24))
+    {
+        return false;
+    }
+
+    TArray<FItemRecord> ItemRecords;
+    TArray<FTagRecord> TagRecords;
+    TArray<uint8> StringTable;
+    TMap<FString, TPair<uint32, uint16>> Interned;
+
+    // Tag names repeat across items, so every string is stored once
+    auto Intern = [&](const FString& Value, uint32& OutOffset, uint16& OutLength)
+    {
+        if (const TPair<uint32, uint16>* Existing = Interned.Find(Value))
+        {
+            OutOffset = Existing->Key;
+            OutLength = Existing->Value;
+            return true;
+        }
+
+        const FTCHARToUTF8 Utf8(*Value);
+        if (Utf8.Length() > MAX_uint16)
+        {
+            return false;
+        }
+        OutOffset = static_cast<uint32>(StringTable.Num());
+        OutLength = static_cast<uint16>(Utf8.Length());
+        StringTable.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        Interned.Add(Value, { OutOffset, OutLength });
+        return true;
+    };
+
+    ItemRecords.Reserve(Definitions.Num());
+    for (const FTowerItemDefinition& Definition : Definitions)
+    {
+        if (Definition.Tags.Num() > MAX_uint16)
+        {
+            return false;
+        }
+
+        FItemRecord& Item = ItemRecords.AddZeroed_GetRef();
+        if (!Intern(Definition.Name, Item.NameOffset, Item.NameLength))
+        {
+            return false;
+        }
+        Item.Category = Definition.Category;
+        Item.FirstTag = static_cast<uint32>(TagRecords.Num());
+        Item.TagCount = static_cast<uint16>(Definition.Tags.Num());
+
+        for (const TPair<FString, float>& Tag : Definition.Tags)
+        {
+            FTagRecord& Record = TagRecords.AddZeroed_GetRef();
+            if (!Intern(Tag.Key, Record.NameOffset, Record.NameLength))
+            {
+                return false;
+            }
+            Record.Value = Tag.Value;
+        }
+    }
+
+    // Half full at most, so a miss stops at an empty bucket after a probe or two
+    const uint32 BucketCount = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(Definitions.Num()) * 2);
+    TArray<uint32> BucketTable;
+    BucketTable.SetNumZeroed(BucketCount);
+    for (int32 Id = 0; Id < ItemRecords.Num(); Id++)
+    {
+        const FItemRecord& Item = ItemRecords[Id];
+        const UTF8CHAR* Name = reinterpret_cast<const UTF8CHAR*>(StringTable.GetData() + Item.NameOffset);
+
+        uint32 Probe = HashName(Name, Item.NameLength);
+        for (;; ++Probe)
+        {
+            uint32& Entry = BucketTable[Probe & (BucketCount - 1)];
+            if (Entry == 0)
+            {
+                Entry = static_cast<uint32>(Id) + 1;
+                break;
+            }
+
+            // The first of duplicate names wins, as FindId would find it
+            const FItemRecord& Other = ItemRecords[Entry - 1];
+            if (Other.NameOffset == Item.NameOffset)
+            {
+                break;
+            }
+        }
+    }
+
+    // Keep the string table 4-byte aligned with the rest of the file
+    StringTable.AddZeroed(Align(StringTable.Num(), 4) - StringTable.Num());
+
+    FHeader Header = {};
+    Header.Magic = CatalogMagic;
+    Header.FormatVersion = CatalogFormatVersion;
+    Header.CoreVersionHash = CoreVersionHash;
+    Header.ItemCount = static_cast<uint32>(ItemRecords.Num());
+    Header.TagCount = static_cast<uint32>(TagRecords.Num());
+    Header.BucketCount = BucketCount;
+    Header.StringBytes = static_cast<uint32>(StringTable.Num());
+
+    OutBytes.Reset(sizeof(Header) + ItemRecords.Num() * sizeof(FItemRecord) + TagRecords.Num() * sizeof(FTagRecord)
+        + BucketTable.Num() * sizeof(uint32) + StringTable.Num());
+    OutBytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    OutBytes.Append(reinterpret_cast<const uint8*>(ItemRecords.GetData()), ItemRecords.Num() * sizeof(FItemRecord));
+    OutBytes.Append(reinterpret_cast<const uint8*>(TagRecords.GetData()), TagRecords.Num() * sizeof(FTagRecord));
+    OutBytes.Append(reinterpret_cast<const uint8*>(BucketTable.GetData()), BucketTable.Num() * sizeof(uint32));
+    OutBytes.Append(StringTable);
+    return true;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** One item a catalog is built from: an entry of the core's get_item_catalog */
+struct FTowerItemDefinition
+{
+    FString Name;
+    uint8 Category = 0;     // Rust LootCategory order, as FLootDropData
+    TArray<TPair<FString, float>> Tags;
+
+    /** Parse the get_item_catalog JSON array, replacing OutDefinitions */
+    static bool ParseJsonArray(const FString& Json, TArray<FTowerItemDefinition>& OutDefinitions);
+};
+
+/**
+ * Every item loot can drop, read-only, from a memory-mapped file built once per
+ * Rust core version. Inventory entries refer to items by catalog id (the core's
+ * catalog order) and keep only what is rolled per drop; names, categories and
+ * base tags are read from the mapping. A file (little-endian, 4-byte aligned):
+ *
+ *   header   u32 magic 'TIC1', u16 format version, u16 reserved, u32 core version
+ *            hash, u32 item count, u32 tag count, u32 bucket count, u32 string
+ *            bytes, u32 reserved
+ *   items    ItemCount x { u32 name offset, u16 name length, u8 category,
+ *            u8 reserved, u32 first tag, u16 tag count, u16 reserved }
+ *   tags     TagCount x { u32 name offset, u16 name length, u16 reserved, f32 value }
+ *   buckets  BucketCount (a power of two) x u32: item id + 1 by FNV-1a of the
+ *            UTF-8 name, linear probing, 0 = empty
+ *   strings  UTF-8, not terminated
+ *
+ * Lookups by id are an index into the mapping; by name, a hash probe. Files of
+ * other core versions are deleted when a catalog is opened. Immutable once
+ * open, so any thread may read it.
+ */
+class TOWERGAME_API FTowerItemCatalog
+{
+public:
+    FTowerItemCatalog();
+    ~FTowerItemCatalog();
+
+    /** The process's catalog, opened by UTowerGameSubsystem once the core has booted */
+    static FTowerItemCatalog& Get();
+
+    /**
+     * Map the catalog of CoreVersion under Directory, building the file from
+     * GetDefinitionsJson first if there is none. False (and the catalog stays
+     * empty) when the core has no catalog export or the file can't be written.
+     */
+    bool Open(const FString& Directory, const FString& CoreVersion, TFunctionRef<FString()> GetDefinitionsJson);
+
+    /** Map a catalog file; false if it isn't one for CoreVersionHash */
+    bool OpenFile(const FString& Path, uint32 CoreVersionHash);
+
+    void Close();
+
+    bool IsOpen() const { return Bytes.Num() > 0; }
+    int32 Num() const { return NumItems; }
+    bool IsValidId(int32 Id) const { return Id >= 0 && Id < NumItems; }
+
+    /** Id of the item named Name, or INDEX_NONE */
+    int32 FindId(const FString& Name) const;
+
+    FString GetName(int32 Id) const;
+    uint8 GetCategory(int32 Id) const;
+    const TCHAR* GetCategoryName(int32 Id) const;
+
+    /** The item's base tags, appended to OutTags */
+    void GetTags(int32 Id, TArray<TPair<FString, float>>& OutTags) const;
+
+    int64 GetFileSize() const { return Bytes.Num(); }
+
+    static bool Encode(TConstArrayView<FTowerItemDefinition> Definitions, uint32 CoreVersionHash, TArray<uint8>& OutBytes);
+
+private:
+    struct FHeader;
+    struct FItemRecord;
+    struct FTagRecord;
+
+    bool Attach(TArrayView<const uint8> InBytes, uint32 CoreVersionHash);
+    FString GetString(uint32 Offset, uint16 Length) const;
+    const FItemRecord& GetItem(int32 Id) const;
+
+    /** Region before handle on the way out (declaration order) */
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** Platforms without file mapping read the file into here */
+    TArray<uint8> LoadedFile;
+
+    TArrayView<const uint8> Bytes;
+    const FItemRecord* Items = nullptr;
+    const FTagRecord* Tags = nullptr;
+    const uint32* Buckets = nullptr;
+    const UTF8CHAR* Strings = nullptr;
+    int32 NumItems = 0;
+    int32 NumTags = 0;
+    uint32 BucketMask = 0;
+    uint32 StringBytes = 0;
+};
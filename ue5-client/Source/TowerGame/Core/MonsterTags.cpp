@@ -0,0 +1,68 @@
+#include "MonsterTags.h"
+
+namespace
+{
+    // Indexed by enum value
+    const TCHAR* const ElementNames[] =
+    {
+        TEXT("Neutral"), TEXT("Fire"), TEXT("Ice"), TEXT("Lightning"), TEXT("Poison"),
+        TEXT("Void"), TEXT("Stone"), TEXT("Wind"), TEXT("Arcane"),
+    };
+
+    const TCHAR* const SizeNames[] =
+    {
+        TEXT("Unknown"), TEXT("Tiny"), TEXT("Small"), TEXT("Medium"), TEXT("Large"), TEXT("Huge"), TEXT("Colossal"),
+    };
+
+    static_assert(UE_ARRAY_COUNT(ElementNames) == static_cast<int32>(EMonsterElement::Count), "One name per EMonsterElement");
+    static_assert(UE_ARRAY_COUNT(SizeNames) == static_cast<int32>(EMonsterSize::Count), "One name per EMonsterSize");
+
+    template <int32 N>
+    int32 FindName(const TCHAR* const (&Names)[N], FStringView Name)
+    {
+        // A handful of entries, and only at decode time
+        for (int32 Index = 1; Index < N; ++Index)
+        {
+            if (Name.Equals(Names[Index], ESearchCase::CaseSensitive))
+            {
+                return Index;
+            }
+        }
+        return 0;
+    }
+}
+
+EMonsterElement TowerMonsterTags::ParseElement(FStringView Name)
+{
+    return static_cast<EMonsterElement>(FindName(ElementNames, Name));
+}
+
+EMonsterSize TowerMonsterTags::ParseSize(FStringView Name)
+{
+    return static_cast<EMonsterSize>(FindName(SizeNames, Name));
+}
+
+const TCHAR* TowerMonsterTags::ToString(EMonsterElement Element)
+{
+    return ElementNames[static_cast<uint8>(SanitizeElement(static_cast<uint8>(Element)))];
+}
+
+const TCHAR* TowerMonsterTags::ToString(EMonsterSize Size)
+{
+    return SizeNames[static_cast<uint8>(SanitizeSize(static_cast<uint8>(Size)))];
+}
+
+FName TowerMonsterTags::GetElementName(EMonsterElement Element)
+{
+    static const TArray<FName> Names = []()
+    {
+        TArray<FName> Result;
+        for (const TCHAR* Name : ElementNames)
+        {
+            Result.Add(FName(Name));
+        }
+        return Result;
+    }();
+
+    return Names[static_cast<uint8>(SanitizeElement(static_cast<uint8>(Element)))];
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MonsterTags.generated.h"
+
+/** Monster element as the client tints it; anything else Rust sends is Neutral */
+UENUM(BlueprintType)
+enum class EMonsterElement : uint8
+{
+    Neutral,
+    Fire,
+    Ice,
+    Lightning,
+    Poison,
+    Void,
+    Stone,
+    Wind,
+    Arcane,
+
+    Count UMETA(Hidden)
+};
+
+/** Rust MonsterSize; Unknown keeps the unscaled mesh */
+UENUM(BlueprintType)
+enum class EMonsterSize : uint8
+{
+    Unknown,
+    Tiny,
+    Small,
+    Medium,
+    Large,
+    Huge,
+    Colossal,
+
+    Count UMETA(Hidden)
+};
+
+/**
+ * Monster strings from Rust, interned once where they are decoded so spawning
+ * and rendering index tables by enum instead of comparing strings. Names match
+ * the Rust variants exactly (case-sensitive, as serde writes them).
+ */
+namespace TowerMonsterTags
+{
+    TOWERGAME_API EMonsterElement ParseElement(FStringView Name);
+    TOWERGAME_API EMonsterSize ParseSize(FStringView Name);
+
+    /** The Rust variant name; "Neutral" / "Unknown" for the fallbacks */
+    TOWERGAME_API const TCHAR* ToString(EMonsterElement Element);
+    TOWERGAME_API const TCHAR* ToString(EMonsterSize Size);
+
+    /** ToString(Element) as an FName, made once per element (material variant keys) */
+    TOWERGAME_API FName GetElementName(EMonsterElement Element);
+
+    /** Out of range values (old cache files, bad casts) fall back to the default */
+    inline EMonsterElement SanitizeElement(uint8 Value)
+    {
+        return Value < static_cast<uint8>(EMonsterElement::Count) ? static_cast<EMonsterElement>(Value) : EMonsterElement::Neutral;
+    }
+
+    inline EMonsterSize SanitizeSize(uint8 Value)
+    {
+        return Value < static_cast<uint8>(EMonsterSize::Count) ? static_cast<EMonsterSize>(Value) : EMonsterSize::Unknown;
+    }
+}
@@ -0,0 +1,322 @@
+#include "PackedTileGrid.h"
+
+namespace
+{
+    constexpr uint8 LiteralMarker = FPackedTileGrid::MaxTileType;
+    constexpr int32 MaxShortRun = 15;
+    constexpr int32 MaxLiteralTiles = 32;
+
+    /** Runs shorter than this go into literals, which pack two tiles a byte */
+    constexpr int32 MinRun = 3;
+
+    // Header: width, height, base biome, region count; then 5 x u16 per region and the u32 run length
+    constexpr int32 HeaderBytes = 4 * sizeof(uint16);
+    constexpr int32 RegionBytes = 5 * sizeof(uint16);
+
+    int32 RunLength(TConstArrayView<uint8> Types, int32 Start, int32 Limit)
+    {
+        int32 End = Start + 1;
+        while (End < Types.Num() && End - Start < Limit && Types[End] == Types[Start])
+        {
+            ++End;
+        }
+        return End - Start;
+    }
+
+    void AppendU16(TArray<uint8>& Out, uint16 Value)
+    {
+        Out.Add(static_cast<uint8>(Value));
+        Out.Add(static_cast<uint8>(Value >> 8));
+    }
+
+    uint16 ReadU16(const uint8* Src)
+    {
+        return static_cast<uint16>(Src[0] | (Src[1] << 8));
+    }
+}
+
+void FPackedTileGrid::Reset()
+{
+    Width = 0;
+    Height = 0;
+    BaseBiome = 0;
+    BiomeRegions.Reset();
+    Runs.Reset();
+}
+
+bool FPackedTileGrid::Pack(TConstArrayView<uint8> Types, int32 InWidth, int32 InHeight)
+{
+    Runs.Reset();
+    Width = 0;
+    Height = 0;
+    if (InWidth < 0 || InHeight < 0 || InWidth > MAX_uint16 || InHeight > MAX_uint16 || Types.Num() != InWidth * InHeight)
+    {
+        return false;
+    }
+    for (const uint8 Type : Types)
+    {
+        if (Type >= MaxTileType)
+        {
+            return false;
+        }
+    }
+
+    Width = InWidth;
+    Height = InHeight;
+
+    int32 Index = 0;
+    while (Index < Types.Num())
+    {
+        const int32 Run = RunLength(Types, Index, MAX_int32);
+        if (Run >= MinRun || Index + 1 == Types.Num())
+        {
+            const uint8 Type = Types[Index];
+            if (Run <= MaxShortRun)
+            {
+                Runs.Add(static_cast<uint8>((Type << 4) | (Run - 1)));
+            }
+            else
+            {
+                Runs.Add(static_cast<uint8>((Type << 4) | MaxShortRun));
+                for (uint32 Extra = static_cast<uint32>(Run - (MaxShortRun + 1));; Extra >>= 7)
+                {
+                    if (Extra < 0x80)
+                    {
+                        Runs.Add(static_cast<uint8>(Extra));
+                        break;
+                    }
+                    Runs.Add(static_cast<uint8>(Extra | 0x80));
+                }
+            }
+            Index += Run;
+            continue;
+        }
+
+        // Gather short runs until a long one starts; literals hold an even count
+        int32 End = Index;
+        while (End < Types.Num() && End - Index < MaxLiteralTiles && RunLength(Types, End, MinRun) < MinRun)
+        {
+            ++End;
+        }
+        const int32 Count = (End - Index) & ~1;
+        if (Count < 2)
+        {
+            Runs.Add(static_cast<uint8>(Types[Index] << 4));
+            ++Index;
+            continue;
+        }
+
+        Runs.Add(static_cast<uint8>((LiteralMarker << 4) | (Count / 2 - 1)));
+        for (int32 Pair = Index; Pair < Index + Count; Pair += 2)
+        {
+            Runs.Add(static_cast<uint8>(Types[Pair] | (Types[Pair + 1] << 4)));
+        }
+        Index += Count;
+    }
+
+    return true;
+}
+
+bool FPackedTileGrid::ReadToken(int32& Cursor, uint8& OutType, int32& OutCount, bool& bOutLiteral) const
+{
+    const uint8 Token = Runs[Cursor++];
+    OutType = Token >> 4;
+    const int32 Low = Token & 0x0F;
+
+    if (OutType == LiteralMarker)
+    {
+        bOutLiteral = true;
+        OutCount = (Low + 1) * 2;
+        if (Runs.Num() - Cursor < Low + 1)
+        {
+            return false;
+        }
+        Cursor += Low + 1;
+        return true;
+    }
+
+    bOutLiteral = false;
+    if (Low < MaxShortRun)
+    {
+        OutCount = Low + 1;
+        return true;
+    }
+
+    // LEB128 extension; a grid has at most 2^32 tiles, so five bytes is the most it needs
+    uint64 Extra = 0;
+    for (int32 Shift = 0; Shift < 35; Shift += 7)
+    {
+        if (Cursor >= Runs.Num())
+        {
+            return false;
+        }
+        const uint8 Byte = Runs[Cursor++];
+        Extra |= static_cast<uint64>(Byte & 0x7F) << Shift;
+        if ((Byte & 0x80) == 0)
+        {
+            if (Extra > static_cast<uint64>(MAX_int32 - (MaxShortRun + 1)))
+            {
+                return false;
+            }
+            OutCount = static_cast<int32>(Extra) + MaxShortRun + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FPackedTileGrid::Unpack(TArray<uint8>& OutTypes) const
+{
+    OutTypes.SetNumUninitialized(Num(), false);
+    uint8* Dest = OutTypes.GetData();
+    const bool bOk = ForEachRun([Dest](int32 Start, int32 Count, uint8 Type)
+    {
+        FMemory::Memset(Dest + Start, Type, Count);
+    });
+
+    if (!bOk)
+    {
+        OutTypes.Reset();
+    }
+    return bOk;
+}
+
+uint16 FPackedTileGrid::GetBiome(int32 X, int32 Y) const
+{
+    for (int32 Index = BiomeRegions.Num() - 1; Index >= 0; --Index)
+    {
+        if (BiomeRegions[Index].Contains(X, Y))
+        {
+            return BiomeRegions[Index].BiomeId;
+        }
+    }
+    return BaseBiome;
+}
+
+void FPackedTileGrid::SetBiomes(TConstArrayView<uint16> TileBiomes)
+{
+    BiomeRegions.Reset();
+    BaseBiome = 0;
+    if (TileBiomes.Num() != Num() || TileBiomes.Num() == 0)
+    {
+        return;
+    }
+
+    // Floors have a handful of biomes at most
+    TMap<uint16, int32, TInlineSetAllocator<8>> Counts;
+    for (const uint16 Biome : TileBiomes)
+    {
+        ++Counts.FindOrAdd(Biome);
+    }
+    int32 BestCount = 0;
+    for (const TPair<uint16, int32>& Pair : Counts)
+    {
+        // Ties go to the lower id, so both ends pick the same base
+        if (Pair.Value > BestCount || (Pair.Value == BestCount && Pair.Key < BaseBiome))
+        {
+            BaseBiome = Pair.Key;
+            BestCount = Pair.Value;
+        }
+    }
+    if (Counts.Num() == 1)
+    {
+        return;
+    }
+
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        const uint16* Row = TileBiomes.GetData() + Y * Width;
+        for (int32 X = 0; X < Width;)
+        {
+            int32 End = X + 1;
+            while (End < Width && Row[End] == Row[X])
+            {
+                ++End;
+            }
+            if (Row[X] != BaseBiome)
+            {
+                FTileBiomeRegion& Region = BiomeRegions.AddDefaulted_GetRef();
+                Region.X = static_cast<uint16>(X);
+                Region.Y = static_cast<uint16>(Y);
+                Region.Width = static_cast<uint16>(End - X);
+                Region.Height = 1;
+                Region.BiomeId = Row[X];
+            }
+            X = End;
+        }
+    }
+}
+
+void FPackedTileGrid::Serialize(TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reserve(OutBytes.Num() + HeaderBytes + BiomeRegions.Num() * RegionBytes + sizeof(uint32) + Runs.Num());
+
+    AppendU16(OutBytes, static_cast<uint16>(Width));
+    AppendU16(OutBytes, static_cast<uint16>(Height));
+    AppendU16(OutBytes, BaseBiome);
+    const int32 RegionCount = FMath::Min(BiomeRegions.Num(), static_cast<int32>(MAX_uint16));
+    AppendU16(OutBytes, static_cast<uint16>(RegionCount));
+    for (int32 Index = 0; Index < RegionCount; ++Index)
+    {
+        const FTileBiomeRegion& Region = BiomeRegions[Index];
+        AppendU16(OutBytes, Region.X);
+        AppendU16(OutBytes, Region.Y);
+        AppendU16(OutBytes, Region.Width);
+        AppendU16(OutBytes, Region.Height);
+        AppendU16(OutBytes, Region.BiomeId);
+    }
+
+    const uint32 RunBytes = static_cast<uint32>(Runs.Num());
+    AppendU16(OutBytes, static_cast<uint16>(RunBytes));
+    AppendU16(OutBytes, static_cast<uint16>(RunBytes >> 16));
+    OutBytes.Append(Runs);
+}
+
+bool FPackedTileGrid::Deserialize(TArrayView<const uint8> Bytes, int32& Offset)
+{
+    Reset();
+    if (Offset < 0 || Bytes.Num() - Offset < HeaderBytes)
+    {
+        return false;
+    }
+
+    const uint8* Src = Bytes.GetData() + Offset;
+    const int32 InWidth = ReadU16(Src);
+    const int32 InHeight = ReadU16(Src + 2);
+    const uint16 InBaseBiome = ReadU16(Src + 4);
+    const int32 RegionCount = ReadU16(Src + 6);
+
+    int32 Cursor = Offset + HeaderBytes;
+    if (Bytes.Num() - Cursor < RegionCount * RegionBytes + static_cast<int32>(sizeof(uint32)))
+    {
+        return false;
+    }
+
+    BiomeRegions.SetNum(RegionCount);
+    for (FTileBiomeRegion& Region : BiomeRegions)
+    {
+        const uint8* R = Bytes.GetData() + Cursor;
+        Region.X = ReadU16(R);
+        Region.Y = ReadU16(R + 2);
+        Region.Width = ReadU16(R + 4);
+        Region.Height = ReadU16(R + 6);
+        Region.BiomeId = ReadU16(R + 8);
+        Cursor += RegionBytes;
+    }
+
+    const uint8* LenSrc = Bytes.GetData() + Cursor;
+    const uint32 RunBytes = ReadU16(LenSrc) | (static_cast<uint32>(ReadU16(LenSrc + 2)) << 16);
+    Cursor += sizeof(uint32);
+    if (static_cast<uint64>(Bytes.Num() - Cursor) < RunBytes)
+    {
+        Reset();
+        return false;
+    }
+
+    Width = InWidth;
+    Height = InHeight;
+    BaseBiome = InBaseBiome;
+    Runs.Append(Bytes.GetData() + Cursor, static_cast<int32>(RunBytes));
+    Offset = Cursor + static_cast<int32>(RunBytes);
+    return true;
+}
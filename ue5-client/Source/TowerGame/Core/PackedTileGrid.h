@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Biome override for a rectangle of the grid, normally one per room */
+struct FTileBiomeRegion
+{
+    uint16 X = 0;
+    uint16 Y = 0;
+    uint16 Width = 0;
+    uint16 Height = 0;
+    uint16 BiomeId = 0;
+
+    bool Contains(int32 InX, int32 InY) const
+    {
+        return InX >= X && InX < X + Width && InY >= Y && InY < Y + Height;
+    }
+};
+
+/**
+ * A floor's tile grid, run-length encoded with 4-bit tile types.
+ *
+ * Coordinates are implicit (row-major from 0,0) and biomes come from a base biome
+ * plus per-room regions, so a 50x50 floor that takes ~30 KB as ChunkData tiles
+ * is usually a few hundred bytes. Runs is a stream of one-byte tokens:
+ *
+ *   TTTT nnnn   T < 15: a run of tile type T, n + 1 tiles long (1-15); n = 15
+ *               means the length is 16 + a LEB128 varint that follows
+ *   1111 nnnn   literal: the next n + 1 bytes hold two tiles each, low nibble
+ *               first (2-32 tiles), for stretches too short to be worth a run
+ *
+ * Used for ChunkData.packed_tiles, the floor disk cache and chunks held in memory.
+ * ForEachRun expands straight into a dense grid without materializing tiles.
+ * Mirrors bevy-server/src/tile_grid.rs.
+ */
+struct TOWERGAME_API FPackedTileGrid
+{
+    /** Tile types must be below this; 15 is the literal marker */
+    static constexpr uint8 MaxTileType = 15;
+
+    int32 Width = 0;
+    int32 Height = 0;
+    uint16 BaseBiome = 0;
+
+    /** Later regions win where they overlap */
+    TArray<FTileBiomeRegion> BiomeRegions;
+
+    TArray<uint8> Runs;
+
+    int32 Num() const { return Width * Height; }
+    bool IsEmpty() const { return Num() == 0; }
+
+    void Reset();
+
+    /**
+     * Encode Width * Height row-major tile types (each below MaxTileType).
+     * Biome fields are left alone. False if the sizes disagree or a type is out of range.
+     */
+    bool Pack(TConstArrayView<uint8> Types, int32 InWidth, int32 InHeight);
+
+    /** Expand to Width * Height row-major types (Out's allocation is reused); false if Runs is malformed */
+    bool Unpack(TArray<uint8>& OutTypes) const;
+
+    /**
+     * Call Visit(StartIndex, Count, TileType) for each run in row-major order; runs
+     * may cross rows. Returns false (having stopped) if Runs is malformed or does
+     * not cover exactly Width * Height tiles.
+     */
+    template <typename FuncType>
+    bool ForEachRun(FuncType&& Visit) const;
+
+    uint16 GetBiome(int32 X, int32 Y) const;
+
+    /**
+     * Set BaseBiome and BiomeRegions from one biome id per tile: the most common
+     * id becomes the base, each other stretch of a row becomes a one-row region.
+     */
+    void SetBiomes(TConstArrayView<uint16> TileBiomes);
+
+    /**
+     * Blob used on the wire and on disk, little-endian:
+     * u16 width, u16 height, u16 base biome, u16 region count,
+     * regions (5 x u16 each), u32 run bytes, runs.
+     */
+    void Serialize(TArray<uint8>& OutBytes) const;
+
+    /** Parse a blob written by Serialize; Offset is advanced past it. False if truncated or malformed. */
+    bool Deserialize(TArrayView<const uint8> Bytes, int32& Offset);
+
+    int64 GetAllocatedSize() const { return BiomeRegions.GetAllocatedSize() + Runs.GetAllocatedSize(); }
+
+private:
+    /** Decode the token at Runs[Cursor]; false at a malformed one */
+    bool ReadToken(int32& Cursor, uint8& OutType, int32& OutCount, bool& bOutLiteral) const;
+};
+
+template <typename FuncType>
+bool FPackedTileGrid::ForEachRun(FuncType&& Visit) const
+{
+    const int32 Total = Num();
+    int32 Index = 0;
+    int32 Cursor = 0;
+    while (Cursor < Runs.Num())
+    {
+        const int32 TokenStart = Cursor;
+        uint8 Type = 0;
+        int32 Count = 0;
+        bool bLiteral = false;
+        if (!ReadToken(Cursor, Type, Count, bLiteral) || Count > Total - Index)
+        {
+            return false;
+        }
+
+        if (!bLiteral)
+        {
+            Visit(Index, Count, Type);
+            Index += Count;
+            continue;
+        }
+
+        for (int32 Byte = TokenStart + 1; Byte < Cursor; ++Byte)
+        {
+            const uint8 Low = Runs[Byte] & 0x0F;
+            const uint8 High = Runs[Byte] >> 4;
+            if (Low == MaxTileType || High == MaxTileType)
+            {
+                return false;
+            }
+            Visit(Index++, 1, Low);
+            Visit(Index++, 1, High);
+        }
+    }
+
+    return Index == Total;
+}
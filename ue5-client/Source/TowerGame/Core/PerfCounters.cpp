@@ -0,0 +1,36 @@
+#include "PerfCounters.h"
+
+std::atomic<bool> FTowerPerfCounters::bCapturing{ false };
+std::atomic<uint64> FTowerPerfCounters::Values[static_cast<int32>(ETowerPerfCounter::MAX)];
+
+static thread_local uint8 GPerfScopeDepth[static_cast<int32>(ETowerPerfCounter::MAX)] = {};
+
+void FTowerPerfCounters::SetCapturing(bool bInCapturing)
+{
+    // A capture starts from empty counters rather than whatever piled up while off
+    for (std::atomic<uint64>& Value : Values)
+    {
+        Value.store(0, std::memory_order_relaxed);
+    }
+    bCapturing.store(bInCapturing, std::memory_order_relaxed);
+}
+
+void FTowerPerfScope::Begin(ETowerPerfCounter InCounter)
+{
+    Counter = InCounter;
+    bOutermost = GPerfScopeDepth[static_cast<int32>(Counter)]++ == 0;
+    if (bOutermost)
+    {
+        StartCycles = FPlatformTime::Cycles64();
+    }
+    else
+    {
+        GPerfScopeDepth[static_cast<int32>(Counter)]--;
+    }
+}
+
+void FTowerPerfScope::End()
+{
+    FTowerPerfCounters::Add(Counter, FPlatformTime::Cycles64() - StartCycles);
+    GPerfScopeDepth[static_cast<int32>(Counter)]--;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include <atomic>
+
+/** Game-side costs UTowerPerfCaptureSubsystem records per frame next to the engine's thread times */
+enum class ETowerPerfCounter : uint8
+{
+    NetDecode,      // Cycles: datagrams and snapshots decoded and applied
+    FFI,            // Cycles: inside tower_core.dll wrappers
+    FloorBuild,     // Cycles: floor renderer building instances, collision, lights, navigation
+    UIRebuilds,     // Count: widget display rebuilds
+
+    MAX
+};
+
+/**
+ * Per-frame accumulators for ETowerPerfCounter, drained once a frame by the
+ * capture subsystem. Off unless a capture is running; then a scope costs two
+ * cycle reads and a relaxed add. Any thread.
+ */
+class TOWERGAME_API FTowerPerfCounters
+{
+public:
+    static bool IsCapturing() { return bCapturing.load(std::memory_order_relaxed); }
+    static void SetCapturing(bool bInCapturing);
+
+    static void Add(ETowerPerfCounter Counter, uint64 Amount = 1)
+    {
+        if (IsCapturing())
+        {
+            Values[static_cast<int32>(Counter)].fetch_add(Amount, std::memory_order_relaxed);
+        }
+    }
+
+    /** Everything added since the last call, then zero */
+    static uint64 Consume(ETowerPerfCounter Counter)
+    {
+        return Values[static_cast<int32>(Counter)].exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<bool> bCapturing;
+    static std::atomic<uint64> Values[static_cast<int32>(ETowerPerfCounter::MAX)];
+};
+
+/**
+ * RAII timer behind TOWER_PERF_SCOPE. Only the outermost scope of a counter on
+ * a thread adds its time, so nested wrappers (an FFI call inside another) count once.
+ */
+class TOWERGAME_API FTowerPerfScope
+{
+public:
+    explicit FTowerPerfScope(ETowerPerfCounter InCounter)
+    {
+        if (FTowerPerfCounters::IsCapturing())
+        {
+            Begin(InCounter);
+        }
+    }
+
+    ~FTowerPerfScope()
+    {
+        if (bOutermost)
+        {
+            End();
+        }
+    }
+
+private:
+    void Begin(ETowerPerfCounter InCounter);
+    void End();
+
+    ETowerPerfCounter Counter = ETowerPerfCounter::MAX;
+    bool bOutermost = false;
+    uint64 StartCycles = 0;
+};
+
+/** Time the rest of the enclosing block under ETowerPerfCounter::CounterName while a capture runs */
+#define TOWER_PERF_SCOPE(CounterName) \
+    FTowerPerfScope TowerPerfScope_##CounterName(ETowerPerfCounter::CounterName)
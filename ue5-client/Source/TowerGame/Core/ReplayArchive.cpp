@@ -0,0 +1,504 @@
+#include "ReplayArchive.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/Archive.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    constexpr uint32 ReplayMagic = 0x31505254; // "TRP1"
+    constexpr uint32 ReplayFormatVersion = 1;
+
+    enum class EReplayRecordKind : uint8
+    {
+        Input = 0,
+        Keyframe = 1,
+    };
+
+    struct FReplayFileHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+        uint64 Seed;
+        int64 DurationTicks;
+        int32 FloorId;
+        int32 FrameCount;
+        int32 KeyframeInterval;
+        int32 KeyframeCount;
+        int64 IndexOffset;
+    };
+
+    struct FReplayRecordHeader
+    {
+        int64 Tick;
+        uint8 Kind;
+        uint8 InputType;
+        uint16 Reserved;
+        uint32 Size;
+    };
+
+    struct FReplayIndexEntry
+    {
+        int32 FrameIndex;
+        uint32 Reserved;
+        int64 Offset;
+        int64 Tick;
+    };
+
+    static_assert(sizeof(FReplayFileHeader) == 48, "Replay header layout changed; bump ReplayFormatVersion");
+    static_assert(sizeof(FReplayRecordHeader) == 16, "Replay record layout changed; bump ReplayFormatVersion");
+    static_assert(sizeof(FReplayIndexEntry) == 24, "Replay index layout changed; bump ReplayFormatVersion");
+
+    constexpr int64 RecordHeaderSize = sizeof(FReplayRecordHeader);
+
+    FString PayloadToString(TConstArrayView<uint8> Payload)
+    {
+        return FString(Payload.Num(), reinterpret_cast<const UTF8CHAR*>(Payload.GetData()));
+    }
+
+    const TCHAR* const InputTypeNames[TowerReplay::NumInputTypes] = {
+        TEXT("Move"), TEXT("Attack"), TEXT("Parry"), TEXT("Dodge"),
+        TEXT("UseAbility"), TEXT("Interact"), TEXT("Jump"), TEXT("ChangeWeapon"),
+    };
+}
+
+const TCHAR* TowerReplay::GetInputTypeName(int32 InputType)
+{
+    return InputType >= 0 && InputType < NumInputTypes ? InputTypeNames[InputType] : TEXT("");
+}
+
+int32 TowerReplay::FindInputType(const FString& Name)
+{
+    for (int32 i = 0; i < NumInputTypes; i++)
+    {
+        if (Name == InputTypeNames[i]) return i;
+    }
+    return INDEX_NONE;
+}
+
+// ============================================================================
+// FTowerReplayState
+// ============================================================================
+
+void FTowerReplayState::Reset()
+{
+    for (int32 i = 0; i < TowerReplay::NumInputTypes; i++)
+    {
+        bHas[i] = false;
+        Latest[i].Payload.Reset();
+    }
+}
+
+void FTowerReplayState::Apply(const FTowerReplayInput& Input)
+{
+    if (Input.InputType < 0 || Input.InputType >= TowerReplay::NumInputTypes) return;
+    Latest[Input.InputType] = Input;
+    bHas[Input.InputType] = true;
+}
+
+// ============================================================================
+// FTowerReplayWriter
+// ============================================================================
+
+FTowerReplayWriter::~FTowerReplayWriter()
+{
+    if (Archive.IsValid())
+    {
+        Close(0);
+    }
+}
+
+bool FTowerReplayWriter::Open(const FString& InPath, uint64 InSeed, int32 InFloorId, int32 InKeyframeInterval)
+{
+    Archive.Reset(IFileManager::Get().CreateFileWriter(*InPath));
+    if (!Archive.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ReplayArchive: cannot open %s for writing"), *InPath);
+        return false;
+    }
+
+    Path = InPath;
+    Seed = InSeed;
+    FloorId = InFloorId;
+    KeyframeInterval = FMath::Max(InKeyframeInterval, 1);
+    NumFrames = 0;
+    State.Reset();
+    Index.Reset();
+
+    // Placeholder; Close() rewrites it with the counts and the index offset
+    FReplayFileHeader Header = {};
+    Archive->Serialize(&Header, sizeof(Header));
+    return true;
+}
+
+void FTowerReplayWriter::WriteRecord(int64 Tick, uint8 Kind, int32 InputType, const FTCHARToUTF8& Payload)
+{
+    FReplayRecordHeader Record = {};
+    Record.Tick = Tick;
+    Record.Kind = Kind;
+    Record.InputType = static_cast<uint8>(InputType);
+    Record.Size = static_cast<uint32>(Payload.Length());
+    Archive->Serialize(&Record, sizeof(Record));
+    Archive->Serialize(const_cast<void*>(static_cast<const void*>(Payload.Get())), Payload.Length());
+}
+
+void FTowerReplayWriter::WriteKeyframe(int64 Tick)
+{
+    FIndexEntry& Entry = Index.AddDefaulted_GetRef();
+    Entry.FrameIndex = NumFrames;
+    Entry.Offset = Archive->Tell();
+    Entry.Tick = Tick;
+
+    TArray<uint8> Body;
+    for (int32 i = 0; i < TowerReplay::NumInputTypes; i++)
+    {
+        if (!State.bHas[i]) continue;
+
+        const FTCHARToUTF8 Payload(*State.Latest[i].Payload);
+        FReplayRecordHeader Record = {};
+        Record.Tick = State.Latest[i].Tick;
+        Record.Kind = static_cast<uint8>(EReplayRecordKind::Input);
+        Record.InputType = static_cast<uint8>(i);
+        Record.Size = static_cast<uint32>(Payload.Length());
+        Body.Append(reinterpret_cast<const uint8*>(&Record), sizeof(Record));
+        Body.Append(reinterpret_cast<const uint8*>(Payload.Get()), Payload.Length());
+    }
+
+    FReplayRecordHeader Record = {};
+    Record.Tick = Tick;
+    Record.Kind = static_cast<uint8>(EReplayRecordKind::Keyframe);
+    Record.Size = static_cast<uint32>(Body.Num());
+    Archive->Serialize(&Record, sizeof(Record));
+    Archive->Serialize(Body.GetData(), Body.Num());
+}
+
+void FTowerReplayWriter::Add(int64 Tick, int32 InputType, const FString& Payload)
+{
+    if (!Archive.IsValid() || InputType < 0 || InputType >= TowerReplay::NumInputTypes) return;
+
+    // The keyframe holds the state before this frame
+    if (NumFrames % KeyframeInterval == 0)
+    {
+        WriteKeyframe(Tick);
+    }
+
+    WriteRecord(Tick, static_cast<uint8>(EReplayRecordKind::Input), InputType, FTCHARToUTF8(*Payload));
+
+    FTowerReplayInput Input;
+    Input.Tick = Tick;
+    Input.InputType = InputType;
+    Input.Payload = Payload;
+    State.Apply(Input);
+    NumFrames++;
+}
+
+bool FTowerReplayWriter::Close(int64 DurationTicks)
+{
+    if (!Archive.IsValid()) return false;
+
+    // An empty replay still gets a keyframe, so Seek() always has one to start from
+    if (Index.Num() == 0)
+    {
+        WriteKeyframe(0);
+    }
+
+    FReplayFileHeader Header = {};
+    Header.Magic = ReplayMagic;
+    Header.FormatVersion = ReplayFormatVersion;
+    Header.Seed = Seed;
+    Header.DurationTicks = DurationTicks;
+    Header.FloorId = FloorId;
+    Header.FrameCount = NumFrames;
+    Header.KeyframeInterval = KeyframeInterval;
+    Header.KeyframeCount = Index.Num();
+    Header.IndexOffset = Archive->Tell();
+
+    for (const FIndexEntry& Entry : Index)
+    {
+        FReplayIndexEntry Out = {};
+        Out.FrameIndex = Entry.FrameIndex;
+        Out.Offset = Entry.Offset;
+        Out.Tick = Entry.Tick;
+        Archive->Serialize(&Out, sizeof(Out));
+    }
+
+    Archive->Seek(0);
+    Archive->Serialize(&Header, sizeof(Header));
+
+    const bool bOk = !Archive->IsError();
+    Archive->Close();
+    Archive.Reset();
+
+    UE_LOG(LogTemp, Log, TEXT("ReplayArchive: wrote %d frames, %d keyframes to %s"), NumFrames, Index.Num(), *Path);
+    return bOk;
+}
+
+bool FTowerReplayWriter::ConvertRecordingJson(const FString& RecordingJson, const FString& OutPath,
+    int32 KeyframeInterval, FString* OutReplayId)
+{
+    TSharedPtr<FJsonObject> Root;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RecordingJson);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ReplayArchive: recording JSON doesn't parse"));
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* Header = nullptr;
+    Root->TryGetObjectField(TEXT("header"), Header);
+
+    uint64 Seed = 0;
+    int32 FloorId = 0;
+    int64 DurationTicks = 0;
+    if (Header)
+    {
+        (*Header)->TryGetNumberField(TEXT("seed"), Seed);
+        (*Header)->TryGetNumberField(TEXT("floor_id"), FloorId);
+        (*Header)->TryGetNumberField(TEXT("duration_ticks"), DurationTicks);
+        if (OutReplayId)
+        {
+            (*Header)->TryGetStringField(TEXT("replay_id"), *OutReplayId);
+        }
+    }
+
+    FTowerReplayWriter Writer;
+    if (!Writer.Open(OutPath, Seed, FloorId, KeyframeInterval)) return false;
+
+    const TArray<TSharedPtr<FJsonValue>>* Frames = nullptr;
+    int64 LastTick = 0;
+    if (Root->TryGetArrayField(TEXT("frames"), Frames))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *Frames)
+        {
+            const TSharedPtr<FJsonObject>& Frame = Value->AsObject();
+            if (!Frame) continue;
+
+            const int32 InputType = TowerReplay::FindInputType(Frame->GetStringField(TEXT("input_type")));
+            if (InputType == INDEX_NONE) continue;
+
+            int64 Tick = 0;
+            Frame->TryGetNumberField(TEXT("tick"), Tick);
+            LastTick = FMath::Max(LastTick, Tick);
+            Writer.Add(Tick, InputType, Frame->GetStringField(TEXT("payload")));
+        }
+    }
+
+    return Writer.Close(DurationTicks > 0 ? DurationTicks : LastTick);
+}
+
+// ============================================================================
+// FTowerReplayReader
+// ============================================================================
+
+FTowerReplayReader::~FTowerReplayReader()
+{
+    Close();
+}
+
+bool FTowerReplayReader::Open(const FString& Path)
+{
+    Close();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedFile.Reset(PlatformFile.OpenMapped(*Path));
+    if (MappedFile)
+    {
+        Region.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (Region)
+        {
+            Data = TConstArrayView<uint8>(Region->GetMappedPtr(), static_cast<int32>(Region->GetMappedSize()));
+        }
+    }
+    if (Data.Num() == 0)
+    {
+        // Platforms without file mapping
+        Region.Reset();
+        MappedFile.Reset();
+        if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+        {
+            UE_LOG(LogTemp, Error, TEXT("ReplayArchive: cannot read %s"), *Path);
+            return false;
+        }
+        Data = Bytes;
+    }
+
+    if (!ParseHeader())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ReplayArchive: %s is not a readable replay"), *Path);
+        Close();
+        return false;
+    }
+
+    FTowerReplayState Unused;
+    return LoadKeyframe(0, Unused);
+}
+
+void FTowerReplayReader::Close()
+{
+    Data = TConstArrayView<uint8>();
+    Region.Reset();
+    MappedFile.Reset();
+    Bytes.Empty();
+    Index.Empty();
+    NumFrames = 0;
+    Cursor = 0;
+    FrameIndex = 0;
+}
+
+bool FTowerReplayReader::ParseHeader()
+{
+    if (Data.Num() < static_cast<int32>(sizeof(FReplayFileHeader))) return false;
+
+    FReplayFileHeader Header;
+    FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+    if (Header.Magic != ReplayMagic || Header.FormatVersion != ReplayFormatVersion) return false;
+
+    const int64 IndexBytes = static_cast<int64>(Header.KeyframeCount) * sizeof(FReplayIndexEntry);
+    if (Header.KeyframeCount <= 0 || Header.FrameCount < 0 || Header.IndexOffset < static_cast<int64>(sizeof(Header))
+        || Header.IndexOffset + IndexBytes > Data.Num())
+    {
+        return false;
+    }
+
+    Seed = Header.Seed;
+    DurationTicks = Header.DurationTicks;
+    FloorId = Header.FloorId;
+    NumFrames = Header.FrameCount;
+    KeyframeInterval = FMath::Max(Header.KeyframeInterval, 1);
+    RecordsEnd = Header.IndexOffset;
+
+    Index.SetNum(Header.KeyframeCount);
+    const uint8* In = Data.GetData() + Header.IndexOffset;
+    for (int32 i = 0; i < Header.KeyframeCount; i++, In += sizeof(FReplayIndexEntry))
+    {
+        FReplayIndexEntry Entry;
+        FMemory::Memcpy(&Entry, In, sizeof(Entry));
+        if (Entry.Offset < static_cast<int64>(sizeof(Header)) || Entry.Offset >= RecordsEnd) return false;
+        Index[i].FrameIndex = Entry.FrameIndex;
+        Index[i].Offset = Entry.Offset;
+        Index[i].Tick = Entry.Tick;
+    }
+    return true;
+}
+
+bool FTowerReplayReader::ReadRecord(int64 Offset, int64& OutTick, uint8& OutKind, int32& OutInputType,
+    TConstArrayView<uint8>& OutPayload) const
+{
+    if (Offset + RecordHeaderSize > RecordsEnd) return false;
+
+    FReplayRecordHeader Record;
+    FMemory::Memcpy(&Record, Data.GetData() + Offset, sizeof(Record));
+    const int64 PayloadOffset = Offset + RecordHeaderSize;
+    if (PayloadOffset + Record.Size > RecordsEnd) return false;
+
+    OutTick = Record.Tick;
+    OutKind = Record.Kind;
+    OutInputType = Record.InputType;
+    OutPayload = TConstArrayView<uint8>(Data.GetData() + PayloadOffset, static_cast<int32>(Record.Size));
+    return true;
+}
+
+bool FTowerReplayReader::LoadKeyframe(int32 Entry, FTowerReplayState& OutState)
+{
+    int64 Tick = 0;
+    uint8 Kind = 0;
+    int32 InputType = 0;
+    TConstArrayView<uint8> Body;
+    if (!ReadRecord(Index[Entry].Offset, Tick, Kind, InputType, Body)
+        || Kind != static_cast<uint8>(EReplayRecordKind::Keyframe))
+    {
+        return false;
+    }
+
+    // The body is Input records laid out like the top level
+    OutState.Reset();
+    const int64 BodyStart = Body.GetData() - Data.GetData();
+    const int64 BodyEnd = BodyStart + Body.Num();
+    for (int64 Offset = BodyStart; Offset < BodyEnd; )
+    {
+        FTowerReplayInput Input;
+        TConstArrayView<uint8> Payload;
+        uint8 SlotKind = 0;
+        if (!ReadRecord(Offset, Input.Tick, SlotKind, Input.InputType, Payload) || Offset + RecordHeaderSize + Payload.Num() > BodyEnd)
+        {
+            return false;
+        }
+        Input.Payload = PayloadToString(Payload);
+        OutState.Apply(Input);
+        Offset += RecordHeaderSize + Payload.Num();
+    }
+
+    Cursor = BodyEnd;
+    FrameIndex = Index[Entry].FrameIndex;
+    return true;
+}
+
+bool FTowerReplayReader::Next(FTowerReplayInput& OutInput)
+{
+    while (FrameIndex < NumFrames)
+    {
+        uint8 Kind = 0;
+        TConstArrayView<uint8> Payload;
+        if (!ReadRecord(Cursor, OutInput.Tick, Kind, OutInput.InputType, Payload)) return false;
+        Cursor += RecordHeaderSize + Payload.Num();
+
+        // Keyframes are only for seeking
+        if (Kind != static_cast<uint8>(EReplayRecordKind::Input)) continue;
+
+        OutInput.Payload = PayloadToString(Payload);
+        FrameIndex++;
+        return true;
+    }
+    return false;
+}
+
+bool FTowerReplayReader::Seek(int32 TargetFrame, FTowerReplayState& OutState)
+{
+    if (!IsOpen()) return false;
+    TargetFrame = FMath::Clamp(TargetFrame, 0, NumFrames);
+
+    // Keyframes are evenly spaced; clamp for the tail after the last one
+    const int32 Entry = FMath::Clamp(TargetFrame / KeyframeInterval, 0, Index.Num() - 1);
+    if (!LoadKeyframe(Entry, OutState)) return false;
+
+    FTowerReplayInput Input;
+    while (FrameIndex < TargetFrame && Next(Input))
+    {
+        OutState.Apply(Input);
+    }
+    return FrameIndex == TargetFrame;
+}
+
+bool FTowerReplayReader::SeekToTick(int64 Tick, FTowerReplayState& OutState)
+{
+    if (!IsOpen()) return false;
+
+    // Last keyframe whose frame starts at or before Tick
+    int32 Entry = Algo::UpperBoundBy(Index, Tick, &FIndexEntry::Tick) - 1;
+    Entry = FMath::Clamp(Entry, 0, Index.Num() - 1);
+    if (!LoadKeyframe(Entry, OutState)) return false;
+
+    // Apply frames before Tick, stopping in front of the first one at or after it
+    FTowerReplayInput Input;
+    while (FrameIndex < NumFrames)
+    {
+        const int64 SavedCursor = Cursor;
+        const int32 SavedFrame = FrameIndex;
+        if (!Next(Input)) return false;
+        if (Input.Tick >= Tick)
+        {
+            Cursor = SavedCursor;
+            FrameIndex = SavedFrame;
+            break;
+        }
+        OutState.Apply(Input);
+    }
+    return true;
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Binary replay container, converted from the Rust ReplayRecording JSON so
+ * playback never holds or reparses the recording.
+ *
+ * A replay's state is the latest input of each input type (the Rust
+ * InputType order: Move, Attack, Parry, Dodge, UseAbility, Interact, Jump,
+ * ChangeWeapon). Every input frame is a delta on that state, and every
+ * KeyframeInterval frames a keyframe holds the whole state as it stood
+ * before that frame. Layout (little-endian, fixed-size structs):
+ *
+ *   header    magic, format version, seed, duration ticks, floor id,
+ *             frame count, keyframe interval, keyframe count, index offset
+ *   records   { uint64 Tick; uint8 Kind, InputType; uint32 Size } + Size bytes
+ *             Input:    the UTF-8 payload JSON
+ *             Keyframe: one Input record per input type seen so far
+ *   index     KeyframeCount x { uint32 FrameIndex; uint64 Offset, Tick }
+ *
+ * The index is written last, so a recording can be streamed to disk as it
+ * is played and finished in one seek back to the header.
+ */
+namespace TowerReplay
+{
+    constexpr int32 NumInputTypes = 8;
+    constexpr int32 DefaultKeyframeInterval = 128;
+
+    /** Rust InputType name of an index, "" past the end */
+    const TCHAR* GetInputTypeName(int32 InputType);
+
+    /** Index of a Rust InputType name, INDEX_NONE if unknown */
+    int32 FindInputType(const FString& Name);
+}
+
+/** One input frame of a replay */
+struct FTowerReplayInput
+{
+    int64 Tick = 0;
+    int32 InputType = 0;
+    FString Payload;
+};
+
+/** The latest input of each type at some point in a replay */
+struct FTowerReplayState
+{
+    FTowerReplayInput Latest[TowerReplay::NumInputTypes];
+    bool bHas[TowerReplay::NumInputTypes] = {};
+
+    void Reset();
+    void Apply(const FTowerReplayInput& Input);
+};
+
+/** Writes a replay container frame by frame */
+class TOWERGAME_API FTowerReplayWriter
+{
+public:
+    ~FTowerReplayWriter();
+
+    bool Open(const FString& Path, uint64 Seed, int32 FloorId, int32 KeyframeInterval = TowerReplay::DefaultKeyframeInterval);
+
+    /** Append an input frame; ticks must not go backwards */
+    void Add(int64 Tick, int32 InputType, const FString& Payload);
+
+    /** Write the keyframe index and the final header; false if any write failed */
+    bool Close(int64 DurationTicks);
+
+    bool IsOpen() const { return Archive.IsValid(); }
+    int32 GetNumFrames() const { return NumFrames; }
+
+    /** Convert a Rust ReplayRecording JSON ({ header, frames }) to a container at Path */
+    static bool ConvertRecordingJson(const FString& RecordingJson, const FString& Path,
+        int32 KeyframeInterval = TowerReplay::DefaultKeyframeInterval, FString* OutReplayId = nullptr);
+
+private:
+    struct FIndexEntry
+    {
+        int32 FrameIndex = 0;
+        int64 Offset = 0;
+        int64 Tick = 0;
+    };
+
+    void WriteRecord(int64 Tick, uint8 Kind, int32 InputType, const FTCHARToUTF8& Payload);
+    void WriteKeyframe(int64 Tick);
+
+    TUniquePtr<FArchive> Archive;
+    FString Path;
+    uint64 Seed = 0;
+    int32 FloorId = 0;
+    int32 KeyframeInterval = TowerReplay::DefaultKeyframeInterval;
+    int32 NumFrames = 0;
+
+    FTowerReplayState State;
+    TArray<FIndexEntry> Index;
+};
+
+/**
+ * Plays a replay container back from a memory-mapped file (or a loaded copy
+ * where mapping isn't available). Next() streams input frames in order;
+ * Seek() starts from the nearest keyframe at or before the target and
+ * applies at most KeyframeInterval deltas, so a seek costs the same at the
+ * end of a long run as at its start.
+ */
+class TOWERGAME_API FTowerReplayReader
+{
+public:
+    ~FTowerReplayReader();
+
+    bool Open(const FString& Path);
+    void Close();
+
+    bool IsOpen() const { return Data.Num() > 0; }
+
+    int32 GetNumFrames() const { return NumFrames; }
+    int64 GetDurationTicks() const { return DurationTicks; }
+    uint64 GetSeed() const { return Seed; }
+    int32 GetFloorId() const { return FloorId; }
+    int32 GetKeyframeInterval() const { return KeyframeInterval; }
+
+    /** Frames read since the start; the index of the frame Next() returns */
+    int32 GetFrameIndex() const { return FrameIndex; }
+
+    /** The next input frame; false at the end or on a truncated record */
+    bool Next(FTowerReplayInput& OutInput);
+
+    /** Position before frame TargetFrame, filling OutState with the state there */
+    bool Seek(int32 TargetFrame, FTowerReplayState& OutState);
+
+    /** Position before the first frame at or after Tick, filling OutState with the state there */
+    bool SeekToTick(int64 Tick, FTowerReplayState& OutState);
+
+private:
+    struct FIndexEntry
+    {
+        int32 FrameIndex = 0;
+        int64 Offset = 0;
+        int64 Tick = 0;
+    };
+
+    /** Decode the record at Offset; false if it runs past the data */
+    bool ReadRecord(int64 Offset, int64& OutTick, uint8& OutKind, int32& OutInputType, TConstArrayView<uint8>& OutPayload) const;
+
+    /** Load the keyframe of Index[Entry] into OutState and position after it */
+    bool LoadKeyframe(int32 Entry, FTowerReplayState& OutState);
+
+    bool ParseHeader();
+
+    // Region before handle on the way out (declaration order)
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> Region;
+    TArray<uint8> Bytes;
+    TConstArrayView<uint8> Data;
+
+    uint64 Seed = 0;
+    int64 DurationTicks = 0;
+    int32 FloorId = 0;
+    int32 NumFrames = 0;
+    int32 KeyframeInterval = TowerReplay::DefaultKeyframeInterval;
+    int64 RecordsEnd = 0;
+    TArray<FIndexEntry> Index;
+
+    int64 Cursor = 0;
+    int32 FrameIndex = 0;
+};
@@ -0,0 +1,168 @@
+#include "SemanticTagCache.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+// All arithmetic below mirrors SemanticTags::similarity() in procedural-core/src/semantic.
+// Products and sums are separate statements so the compiler can't contract them into
+// an FMA, which Rust never does; that would change the last bit.
+
+// ============ Batch ============
+
+void FSemanticTagBatch::Reset(int32 InNum)
+{
+    Num = InNum;
+    const int32 Padded = GetPaddedNum();
+    Columns.SetNumZeroed(FSemanticTagVector::MaxDims * Padded);
+    Norms.SetNumZeroed(Padded);
+}
+
+void FSemanticTagBatch::Set(int32 Index, const FSemanticTagVector& Vector)
+{
+    const int32 Padded = GetPaddedNum();
+    for (int32 Dim = 0; Dim < FSemanticTagVector::MaxDims; Dim++)
+    {
+        Columns[Dim * Padded + Index] = Vector.Dense[Dim];
+    }
+    Norms[Index] = Vector.Norm;
+}
+
+// ============ Cache ============
+
+const FSemanticTagVector& FSemanticTagCache::Find(const FString& TagsJson)
+{
+    if (const FSemanticTagVector* Existing = Vectors.Find(TagsJson))
+    {
+        return *Existing;
+    }
+
+    FSemanticTagVector& Vector = Vectors.Add(TagsJson);
+    Parse(TagsJson, Vector);
+    return Vector;
+}
+
+void FSemanticTagCache::Reset()
+{
+    DimsByName.Reset();
+    Vectors.Reset();
+}
+
+int32 FSemanticTagCache::Intern(const FString& Name)
+{
+    if (const int32* Dim = DimsByName.Find(Name))
+    {
+        return *Dim;
+    }
+    if (DimsByName.Num() >= FSemanticTagVector::MaxDims)
+    {
+        return INDEX_NONE;
+    }
+    return DimsByName.Add(Name, DimsByName.Num());
+}
+
+void FSemanticTagCache::Parse(const FString& TagsJson, FSemanticTagVector& Out)
+{
+    // Vec<(String, f32)>: any element that isn't [string, number] fails the whole parse,
+    // and a failed parse is no tags at all
+    TArray<TSharedPtr<FJsonValue>> Entries;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(TagsJson);
+    if (!FJsonSerializer::Deserialize(Reader, Entries))
+    {
+        return;
+    }
+
+    TArray<TPair<FString, float>, TInlineAllocator<8>> Tags;
+    for (const TSharedPtr<FJsonValue>& Entry : Entries)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Pair = nullptr;
+        if (!Entry.IsValid() || !Entry->TryGetArray(Pair) || Pair->Num() != 2
+            || (*Pair)[0]->Type != EJson::String || (*Pair)[1]->Type != EJson::Number)
+        {
+            return;
+        }
+        // serde reads f32 through f64 as well
+        Tags.Emplace((*Pair)[0]->AsString(), static_cast<float>((*Pair)[1]->AsNumber()));
+    }
+
+    float SumSquares = 0.0f;
+    for (const TPair<FString, float>& Tag : Tags)
+    {
+        const int32 Dim = Intern(Tag.Key);
+        if (Dim == INDEX_NONE)
+        {
+            Out.bInterned = false;
+            return;
+        }
+
+        const bool bFirst = !Out.OrderDims.Contains(static_cast<uint8>(Dim));
+        Out.OrderDims.Add(static_cast<uint8>(Dim));
+        Out.OrderValues.Add(Tag.Value);
+        if (bFirst)
+        {
+            Out.Dense[Dim] = Tag.Value;
+        }
+
+        const float Square = Tag.Value * Tag.Value;
+        SumSquares += Square;
+    }
+    Out.Norm = FMath::Sqrt(SumSquares);
+}
+
+bool FSemanticTagCache::BuildBatch(TConstArrayView<FString> TagsJson, FSemanticTagBatch& OutBatch)
+{
+    OutBatch.Reset(TagsJson.Num());
+    for (int32 i = 0; i < TagsJson.Num(); i++)
+    {
+        const FSemanticTagVector& Vector = Find(TagsJson[i]);
+        if (!Vector.bInterned)
+        {
+            return false;
+        }
+        OutBatch.Set(i, Vector);
+    }
+    return true;
+}
+
+float FSemanticTagCache::Similarity(const FSemanticTagVector& A, const FSemanticTagVector& B)
+{
+    float Dot = 0.0f;
+    for (int32 i = 0; i < A.OrderDims.Num(); i++)
+    {
+        const float Product = A.OrderValues[i] * B.Dense[A.OrderDims[i]];
+        Dot += Product;
+    }
+
+    const float Magnitude = A.Norm * B.Norm;
+    if (Magnitude < FLT_EPSILON)
+    {
+        return 0.0f;
+    }
+    return Dot / Magnitude;
+}
+
+void FSemanticTagCache::Score(const FSemanticTagVector& Query, const FSemanticTagBatch& Batch, TArray<float>& OutScores)
+{
+    const int32 Padded = Batch.GetPaddedNum();
+    OutScores.SetNumUninitialized(Padded);
+
+    const VectorRegister4Float QueryNorm = VectorSetFloat1(Query.Norm);
+    const VectorRegister4Float Epsilon = VectorSetFloat1(FLT_EPSILON);
+    const VectorRegister4Float Zero = VectorZeroFloat();
+
+    for (int32 Lane = 0; Lane < Padded; Lane += 4)
+    {
+        VectorRegister4Float Dot = Zero;
+        for (int32 i = 0; i < Query.OrderDims.Num(); i++)
+        {
+            const VectorRegister4Float Values = VectorLoad(&Batch.Columns[Query.OrderDims[i] * Padded + Lane]);
+            const VectorRegister4Float Product = VectorMultiply(VectorSetFloat1(Query.OrderValues[i]), Values);
+            Dot = VectorAdd(Dot, Product);
+        }
+
+        const VectorRegister4Float Magnitude = VectorMultiply(QueryNorm, VectorLoad(&Batch.Norms[Lane]));
+        const VectorRegister4Float Result = VectorSelect(VectorCompareLT(Magnitude, Epsilon), Zero, VectorDivide(Dot, Magnitude));
+        VectorStore(Result, &OutScores[Lane]);
+    }
+
+    OutScores.SetNum(Batch.Num, false);
+}
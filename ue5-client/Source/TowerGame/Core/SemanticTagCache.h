@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Semantic tags ([["fire", 0.8], ...]) interned into a fixed-dimension vector.
+ *
+ * Keeps the tags in their original order as well as densely by dimension, because
+ * Rust's SemanticTags::similarity() sums in the first vector's tag order and looks the
+ * other's value up by name (first match). Reproducing that order exactly is what makes
+ * the C++ result bit-identical to semantic_similarity().
+ */
+struct TOWERGAME_API FSemanticTagVector
+{
+    static constexpr int32 MaxDims = 64;
+
+    /** Tags in JSON order (duplicates included, as Rust iterates them) */
+    TArray<uint8, TInlineAllocator<8>> OrderDims;
+    TArray<float, TInlineAllocator<8>> OrderValues;
+
+    /** Value per dimension (first occurrence of the tag), 0 elsewhere */
+    float Dense[MaxDims] = {};
+
+    /** sqrt of the sum of squares in tag order, as Rust computes mag.sqrt() */
+    float Norm = 0.0f;
+
+    /** False if the cache ran out of dimensions; similarity must then go through Rust */
+    bool bInterned = true;
+};
+
+/**
+ * Candidates laid out dimension-major for one-vs-many scoring: the value of every
+ * candidate for dimension D is contiguous, so a query tag scores four candidates per
+ * vector op. Each lane does exactly the scalar operation sequence, so results match
+ * FSemanticTagCache::Similarity() (and Rust) bit for bit.
+ */
+struct TOWERGAME_API FSemanticTagBatch
+{
+    int32 Num = 0;
+
+    /** MaxDims rows of PaddedNum floats */
+    TArray<float> Columns;
+    TArray<float> Norms;
+
+    int32 GetPaddedNum() const { return Align(Num, 4); }
+    void Reset(int32 InNum);
+    void Set(int32 Index, const FSemanticTagVector& Vector);
+};
+
+/**
+ * Interns tag names into dimensions and caches parsed vectors by their JSON, so items
+ * and monsters that share tag strings are parsed once. Not thread-safe; vectors are
+ * only comparable with others from the same cache.
+ */
+class TOWERGAME_API FSemanticTagCache
+{
+public:
+    /**
+     * Parsed vector for TagsJson (malformed JSON is an empty vector, as in Rust).
+     * The reference is invalidated by the next Find() / BuildBatch(); copy to keep it.
+     */
+    const FSemanticTagVector& Find(const FString& TagsJson);
+
+    /** Cosine similarity, bit-identical to Rust semantic_similarity(); both must be bInterned */
+    static float Similarity(const FSemanticTagVector& A, const FSemanticTagVector& B);
+
+    /** Similarity of Query against every candidate in Batch, SIMD over candidates; OutScores is resized */
+    static void Score(const FSemanticTagVector& Query, const FSemanticTagBatch& Batch, TArray<float>& OutScores);
+
+    /** Build a batch from tag JSON strings; false if any of them didn't intern */
+    bool BuildBatch(TConstArrayView<FString> TagsJson, FSemanticTagBatch& OutBatch);
+
+    int32 GetNumDims() const { return DimsByName.Num(); }
+    int32 GetNumCached() const { return Vectors.Num(); }
+
+    /** Forget every vector and dimension */
+    void Reset();
+
+private:
+    void Parse(const FString& TagsJson, FSemanticTagVector& Out);
+
+    /** Dimension for a tag name, INDEX_NONE once MaxDims are taken; names compare case-sensitively like Rust */
+    int32 Intern(const FString& Name);
+
+    template <typename ValueType>
+    struct TCaseSensitiveKeyFuncs : BaseKeyFuncs<TPair<FString, ValueType>, FString>
+    {
+        static const FString& GetSetKey(const TPair<FString, ValueType>& Element) { return Element.Key; }
+        static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+        static uint32 GetKeyHash(const FString& Key) { return GetTypeHash(Key); }
+    };
+
+    TMap<FString, int32, FDefaultSetAllocator, TCaseSensitiveKeyFuncs<int32>> DimsByName;
+    TMap<FString, FSemanticTagVector, FDefaultSetAllocator, TCaseSensitiveKeyFuncs<FSemanticTagVector>> Vectors;
+};
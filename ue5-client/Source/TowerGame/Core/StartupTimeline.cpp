@@ -0,0 +1,78 @@
+#include "StartupTimeline.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FCriticalSection FTowerStartupTimeline::Lock;
+TArray<FTowerStartupTimeline::FSpan> FTowerStartupTimeline::Spans;
+double FTowerStartupTimeline::ReadySeconds = 0.0;
+const TCHAR* FTowerStartupTimeline::ReadyMilestone = nullptr;
+
+namespace
+{
+    FAutoConsoleCommand DumpStartupCommand(
+        TEXT("tower.Startup.Dump"),
+        TEXT("Log the cold-start timeline: each startup step, when it ran and for how long"),
+        FConsoleCommandDelegate::CreateStatic(&FTowerStartupTimeline::Dump));
+}
+
+void FTowerStartupTimeline::AddSpan(const TCHAR* Name, double StartSeconds)
+{
+    FSpan Span;
+    Span.Name = Name;
+    Span.StartSeconds = StartSeconds;
+    Span.EndSeconds = FPlatformTime::Seconds();
+    Span.bGameThread = IsInGameThread();
+
+    FScopeLock ScopeLock(&Lock);
+    Spans.Add(Span);
+}
+
+void FTowerStartupTimeline::MarkReady(const TCHAR* Milestone)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (ReadyMilestone) return;
+        ReadyMilestone = Milestone;
+        ReadySeconds = FPlatformTime::Seconds();
+    }
+    Dump();
+}
+
+void FTowerStartupTimeline::Dump()
+{
+    TArray<FSpan> Sorted;
+    double Ready = 0.0;
+    const TCHAR* Milestone = nullptr;
+    {
+        FScopeLock ScopeLock(&Lock);
+        Sorted = Spans;
+        Ready = ReadySeconds;
+        Milestone = ReadyMilestone;
+    }
+    Sorted.Sort([](const FSpan& A, const FSpan& B) { return A.StartSeconds < B.StartSeconds; });
+
+    // GStartTime is when the engine started counting; everything is relative to it
+    const double Origin = GStartTime;
+    FString Report;
+    if (Milestone)
+    {
+        Report += FString::Printf(TEXT("Startup: %s after %.0f ms\n"), Milestone, (Ready - Origin) * 1000.0);
+    }
+    else
+    {
+        Report += TEXT("Startup: no menu yet\n");
+    }
+
+    // Start, duration, thread; a step that started after the milestone is marked with '*'
+    for (const FSpan& Span : Sorted)
+    {
+        Report += FString::Printf(TEXT("  %8.1f ms  +%7.1f ms  %-6s %s%s\n"),
+            (Span.StartSeconds - Origin) * 1000.0, (Span.EndSeconds - Span.StartSeconds) * 1000.0,
+            Span.bGameThread ? TEXT("game") : TEXT("worker"), Span.Name,
+            Milestone && Span.StartSeconds > Ready ? TEXT(" *") : TEXT(""));
+    }
+
+    Report.RemoveFromEnd(TEXT("\n"));
+    UE_LOG(LogTemp, Log, TEXT("%s"), *Report);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Cold-start timeline: when each startup step (subsystem Initialize, DLL load,
+ * catalog warm-up) ran and for how long, relative to process start, and when
+ * the first menu came up. Logged once at that milestone and again by
+ * tower.Startup.Dump; steps on workers show up overlapping the game thread
+ * ones, which is the point of moving them there. Any thread.
+ */
+class TOWERGAME_API FTowerStartupTimeline
+{
+public:
+    struct FSpan
+    {
+        const TCHAR* Name = nullptr;
+        double StartSeconds = 0.0;
+        double EndSeconds = 0.0;
+        bool bGameThread = false;
+    };
+
+    /** Record a step that ran from StartSeconds (FPlatformTime::Seconds) until now */
+    static void AddSpan(const TCHAR* Name, double StartSeconds);
+
+    /** The first call logs the timeline as of now, with Milestone as its end; later calls do nothing */
+    static void MarkReady(const TCHAR* Milestone);
+
+    static void Dump();
+
+private:
+    static FCriticalSection Lock;
+    static TArray<FSpan> Spans;
+    static double ReadySeconds;
+    static const TCHAR* ReadyMilestone;
+};
+
+/** RAII step behind TOWER_STARTUP_SCOPE */
+class FTowerStartupScope
+{
+public:
+    explicit FTowerStartupScope(const TCHAR* InName)
+        : Name(InName), StartSeconds(FPlatformTime::Seconds())
+    {
+    }
+
+    ~FTowerStartupScope()
+    {
+        FTowerStartupTimeline::AddSpan(Name, StartSeconds);
+    }
+
+private:
+    const TCHAR* Name;
+    double StartSeconds;
+};
+
+/** Time the rest of the enclosing block as startup step StepName, also as an Insights CPU scope */
+#define TOWER_STARTUP_SCOPE(StepName) \
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerStartup_##StepName); \
+    FTowerStartupScope TowerStartupScope_##StepName(TEXT(#StepName))
@@ -0,0 +1,210 @@
+#include "TowerAchievementSubsystem.h"
+#include "TowerGameSubsystem.h"
+#include "TowerGame/Bridge/ProceduralCoreBridge.h"
+#include "TowerGame/World/GameplayEventSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTowerAchievements, Log, All);
+
+namespace
+{
+    TAutoConsoleVariable<float> CVarAchievementsFlushInterval(
+        TEXT("tower.Achievements.FlushInterval"),
+        1.0f,
+        TEXT("Seconds between sends of accumulated achievement progress to the Rust core.\n")
+        TEXT("0 = send every frame that changed anything"),
+        ECVF_Default);
+
+    const FName FirstKillId(TEXT("combat_first_kill"));
+    const FName HundredKillsId(TEXT("combat_100_kills"));
+    const FName FirstDeathId(TEXT("survival_first_death"));
+}
+
+void UTowerAchievementSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UTowerGameSubsystem* Game = Collection.InitializeDependency<UTowerGameSubsystem>();
+    if (!Game) return;
+    TowerGame = Game;
+
+    // Progress made before the core has booted waits in PendingIncrements
+    Game->WhenRustCoreBooted(FSimpleDelegate::CreateWeakLambda(this, [this]()
+    {
+        UTowerGameSubsystem* Booted = TowerGame.Get();
+        if (!Booted || !Booted->IsRustCoreReady()) return;
+
+        FProceduralCoreBridge* Bridge = Booted->GetBridge();
+        if (!PendingTrackerJson.IsEmpty())
+        {
+            TrackerHandle = Bridge->AchievementHandleLoad(PendingTrackerJson);
+            PendingTrackerJson.Empty();
+        }
+        if (TrackerHandle == 0)
+        {
+            TrackerHandle = Bridge->AchievementHandleCreate();
+        }
+    }));
+
+    WorldActorsHandle = FWorldDelegates::OnWorldInitializedActors.AddUObject(
+        this, &UTowerAchievementSubsystem::HandleWorldActorsInitialized);
+
+    LastFlushTime = FPlatformTime::Seconds();
+    FlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UTowerAchievementSubsystem::TickFlush));
+}
+
+void UTowerAchievementSubsystem::Deinitialize()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(FlushHandle);
+    FWorldDelegates::OnWorldInitializedActors.Remove(WorldActorsHandle);
+
+    // UTowerGameSubsystem shuts the bridge down after us
+    Flush();
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (TrackerHandle != 0 && Game && Game->IsRustCoreReady())
+    {
+        Game->GetBridge()->AchievementHandleRelease(TrackerHandle);
+    }
+    TrackerHandle = 0;
+    PendingIncrements.Empty();
+    OnAchievementsUnlocked.Clear();
+    Super::Deinitialize();
+}
+
+void UTowerAchievementSubsystem::Increment(FName AchievementId, uint64 Amount)
+{
+    if (Amount == 0) return;
+    PendingIncrements.FindOrAdd(AchievementId) += Amount;
+}
+
+void UTowerAchievementSubsystem::Flush()
+{
+    LastFlushTime = FPlatformTime::Seconds();
+
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || TrackerHandle == 0) return;
+
+    const int32 Floor = Game->CurrentFloor > SubmittedFloor ? Game->CurrentFloor : 0;
+    if (PendingIncrements.Num() == 0 && Floor == 0) return;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerAchievements_Flush);
+
+    FString IncrementsJson;
+    if (PendingIncrements.Num() > 0)
+    {
+        TSharedRef<FJsonObject> Increments = MakeShared<FJsonObject>();
+        for (const TPair<FName, uint64>& Pending : PendingIncrements)
+        {
+            Increments->SetNumberField(Pending.Key.ToString(), static_cast<double>(Pending.Value));
+        }
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&IncrementsJson);
+        FJsonSerializer::Serialize(Increments, Writer);
+        PendingIncrements.Reset();
+    }
+
+    const uint64 Now = static_cast<uint64>(FDateTime::UtcNow().ToUnixTimestamp());
+    const FString UnlockedJson = Game->GetBridge()->AchievementHandleApply(
+        TrackerHandle, IncrementsJson, static_cast<uint32>(Floor), Now);
+    if (Floor > 0) SubmittedFloor = Floor;
+
+    TArray<TSharedPtr<FJsonValue>> Unlocked;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(UnlockedJson);
+    if (!FJsonSerializer::Deserialize(Reader, Unlocked))
+    {
+        UE_LOG(LogTowerAchievements, Warning, TEXT("Achievement tracker rejected an update (handle %llu)"), TrackerHandle);
+        return;
+    }
+    if (Unlocked.Num() == 0) return;
+
+    TArray<FString> Ids;
+    Ids.Reserve(Unlocked.Num());
+    for (const TSharedPtr<FJsonValue>& Id : Unlocked)
+    {
+        Ids.Add(Id->AsString());
+    }
+    OnAchievementsUnlocked.Broadcast(Ids);
+}
+
+bool UTowerAchievementSubsystem::LoadTracker(const FString& TrackerJson)
+{
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game) return false;
+
+    if (TrackerHandle == 0)
+    {
+        // Not booted yet: the boot callback loads it
+        PendingTrackerJson = TrackerJson;
+        return true;
+    }
+
+    const uint64 Loaded = Game->GetBridge()->AchievementHandleLoad(TrackerJson);
+    if (Loaded == 0) return false;
+
+    Game->GetBridge()->AchievementHandleRelease(TrackerHandle);
+    TrackerHandle = Loaded;
+    SubmittedFloor = 0;
+    return true;
+}
+
+FString UTowerAchievementSubsystem::SaveTracker()
+{
+    Flush();
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || TrackerHandle == 0) return FString();
+    return Game->GetBridge()->AchievementHandleToJson(TrackerHandle);
+}
+
+float UTowerAchievementSubsystem::GetCompletionPercent() const
+{
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || TrackerHandle == 0) return 0.0f;
+    return Game->GetBridge()->AchievementHandleCompletionPercent(TrackerHandle);
+}
+
+bool UTowerAchievementSubsystem::TickFlush(float DeltaTime)
+{
+    const float Interval = CVarAchievementsFlushInterval.GetValueOnGameThread();
+    if (FPlatformTime::Seconds() - LastFlushTime >= Interval)
+    {
+        Flush();
+    }
+    return true;
+}
+
+void UTowerAchievementSubsystem::HandleWorldActorsInitialized(const UWorld::FActorsInitializedParams& Params)
+{
+    UWorld* World = Params.World;
+    if (!World || World->GetGameInstance() != GetGameInstance()) return;
+
+    // The world's bus drops its bindings when the world goes away
+    if (UTowerGameplayEventSubsystem* Events = World->GetSubsystem<UTowerGameplayEventSubsystem>())
+    {
+        Events->OnEvents.AddUObject(this, &UTowerAchievementSubsystem::HandleGameplayEvents);
+    }
+}
+
+void UTowerAchievementSubsystem::HandleGameplayEvents(const FTowerGameplayEventBatch& Batch)
+{
+    if (const int32 Kills = Batch.Kills.Num())
+    {
+        Increment(FirstKillId, Kills);
+        Increment(HundredKillsId, Kills);
+    }
+    for (const FTowerFloorProgressEvent& Progress : Batch.FloorProgress)
+    {
+        if (Progress.Kind == ETowerFloorProgress::PlayerDied)
+        {
+            Increment(FirstDeathId);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "TowerAchievementSubsystem.generated.h"
+
+class UTowerGameSubsystem;
+struct FTowerGameplayEventBatch;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAchievementsUnlocked, const TArray<FString>& /*AchievementIds*/);
+
+/**
+ * The player's achievement progress, held by the Rust core as a resident
+ * tracker handle. Increment adds to a local counter table; the table and the
+ * floor the player has reached go to the core together in one
+ * AchievementHandleApply call every tower.Achievements.FlushInterval seconds,
+ * and only the achievements that call unlocked come back
+ * (OnAchievementsUnlocked). Nothing is sent while nothing has changed.
+ *
+ * Kills and deaths are counted from each game world's
+ * UTowerGameplayEventSubsystem batch; other counters (crafting, parries, ...)
+ * call Increment with the achievement's id. Game thread only.
+ */
+UCLASS()
+class TOWERGAME_API UTowerAchievementSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Add Amount to a counter achievement; sent with the next flush */
+    void Increment(FName AchievementId, uint64 Amount = 1);
+
+    /** Send the pending counters and floor now */
+    void Flush();
+
+    /** Replace the tracker with a saved one (AchievementHandleToJson's form); pending counters apply on top */
+    bool LoadTracker(const FString& TrackerJson);
+
+    /** The tracker as JSON for saving, after a flush; empty before the core has booted */
+    FString SaveTracker();
+
+    /** 0.0 - 1.0 of all achievements unlocked, as of the last flush */
+    float GetCompletionPercent() const;
+
+    /** Broadcast after a flush that unlocked anything, with the ids it unlocked */
+    FOnAchievementsUnlocked OnAchievementsUnlocked;
+
+private:
+    bool TickFlush(float DeltaTime);
+
+    void HandleWorldActorsInitialized(const UWorld::FActorsInitializedParams& Params);
+    void HandleGameplayEvents(const FTowerGameplayEventBatch& Batch);
+
+    TWeakObjectPtr<UTowerGameSubsystem> TowerGame;
+
+    /** Rust tracker handle; 0 until the core has booted */
+    uint64 TrackerHandle = 0;
+
+    /** Counter increments since the last flush, by achievement id */
+    TMap<FName, uint64> PendingIncrements;
+
+    /** Highest floor already sent; a flush only sends a higher one */
+    int32 SubmittedFloor = 0;
+
+    /** A tracker loaded before the core booted, created from on boot instead of a fresh one */
+    FString PendingTrackerJson;
+
+    double LastFlushTime = 0.0;
+    FTSTicker::FDelegateHandle FlushHandle;
+    FDelegateHandle WorldActorsHandle;
+};
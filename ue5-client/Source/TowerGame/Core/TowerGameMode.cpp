@@ -1,14 +1,56 @@
 #include "TowerGameMode.h"
 #include "TowerGameSubsystem.h"
+#include "TowerGameState.h"
 #include "TowerGame/World/FloorBuilder.h"
 #include "TowerGame/World/MonsterSpawner.h"
+#include "TowerGame/World/MonsterPool.h"
+#include "TowerGame/World/MonsterHordeSubsystem.h"
+#include "TowerGame/World/FloorTeardownSubsystem.h"
+#include "TowerGame/World/ProximityQuerySubsystem.h"
+#include "TowerGame/World/GameplayEventSubsystem.h"
+#include "TowerGame/World/DestructibleComponent.h"
+#include "TowerGame/Rendering/VFXPoolSubsystem.h"
+#include "TowerGame/Rendering/PSOWarmupSubsystem.h"
+#include "TowerGame/Network/TowerNetworkSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "NiagaraSystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Kismet/GameplayStatics.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+static TAutoConsoleVariable<int32> CVarFloorActorTiles(
+    TEXT("tower.Floor.ActorTiles"),
+    0,
+    TEXT("Debug: spawn one actor per floor tile (AFloorBuilder) instead of the instanced floor renderer.\n")
+    TEXT("Costs one actor and draw call per tile; applies from the next floor load"),
+    ECVF_Cheat);
+
+namespace
+{
+    /** Room type names ATowerProceduralFloorRenderer keys its lighting on */
+    const TCHAR* GetRoomTypeName(EFloorRoomType RoomType)
+    {
+        switch (RoomType)
+        {
+        case EFloorRoomType::Combat:   return TEXT("combat");
+        case EFloorRoomType::Treasure: return TEXT("treasure");
+        case EFloorRoomType::Puzzle:   return TEXT("puzzle");
+        case EFloorRoomType::Rest:     return TEXT("rest");
+        case EFloorRoomType::Boss:     return TEXT("boss");
+        case EFloorRoomType::Entrance: return TEXT("entrance");
+        case EFloorRoomType::Exit:     return TEXT("exit");
+        default:                       return TEXT("combat");
+        }
+    }
+}
 
 ATowerGameMode::ATowerGameMode()
 {
+    FloorRendererClass = ATowerProceduralFloorRenderer::StaticClass();
 }
 
 void ATowerGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
@@ -22,6 +64,17 @@ void ATowerGameMode::StartPlay()
 {
     Super::StartPlay();
 
+    // Proximity cells match floor tiles
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->SetCellSize(TileSize);
+    }
+
+    if (UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>())
+    {
+        Events->OnEvents.AddUObject(this, &ATowerGameMode::HandleGameplayEvents);
+    }
+
     UTowerGameSubsystem* Sub = GetTowerSubsystem();
     if (Sub && Sub->IsRustCoreReady())
     {
@@ -43,115 +96,566 @@ UTowerGameSubsystem* ATowerGameMode::GetTowerSubsystem() const
 
 void ATowerGameMode::LoadFloor(int32 FloorId)
 {
-    ClearCurrentFloor();
-
     UTowerGameSubsystem* Sub = GetTowerSubsystem();
     if (!Sub || !Sub->IsRustCoreReady())
     {
+        ClearCurrentFloor();
         UE_LOG(LogTemp, Error, TEXT("Cannot load floor %d — Rust core not ready"), FloorId);
         return;
     }
 
-    CurrentFloorId = FloorId;
-    Sub->CurrentFloor = FloorId;
-    if (FloorId > Sub->HighestFloor)
+    if (ActivateResidentFloor(FloorId))
     {
-        Sub->HighestFloor = FloorId;
+        return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("=== Loading Floor %d ==="), FloorId);
+    // Synchronous: generation blocks this frame. UFloorTransitionComponent uses
+    // RequestFloorAsync and hands the result to BuildFloor instead.
+    FGeneratedFloorData Floor;
+    Sub->GenerateFloorData(Sub->TowerSeed, FloorId, GetMonsterCountForFloor(FloorId), Floor);
+    BuildFloor(Floor);
+}
 
-    // 1. Generate floor layout from Rust
-    FString LayoutJson = Sub->RequestFloorLayout(Sub->TowerSeed, FloorId);
-    if (LayoutJson.IsEmpty())
+bool ATowerGameMode::PrewarmMonsters(int32 FloorId, int32 MaxSpawns)
+{
+    UTowerMonsterPool* MonsterPool = GetWorld() ? GetWorld()->GetSubsystem<UTowerMonsterPool>() : nullptr;
+    return !MonsterPool || MonsterPool->Prewarm(GetMonsterCountForFloor(FloorId), MaxSpawns) == 0;
+}
+
+int32 ATowerGameMode::GetMonsterCountForFloor(int32 FloorId) const
+{
+    return BaseMonstersPerFloor + (FloorId / 5);
+}
+
+void ATowerGameMode::BuildFloor(const FGeneratedFloorData& Floor)
+{
+    BeginBuildFloor(Floor);
+    TickFloorBuild(0.0);
+}
+
+void ATowerGameMode::BeginBuildFloor(const FGeneratedFloorData& Floor)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_BeginBuild);
+    const int32 FloorId = Floor.FloorId;
+
+    // A parked copy of the floor being rebuilt is stale now
+    const int32 ResidentIndex = FindResidentFloor(FloorId);
+    if (ResidentIndex != INDEX_NONE)
+    {
+        EvictResidentFloor(ResidentIndex);
+    }
+    ParkCurrentFloor();
+    ClearCurrentFloor();
+
+    const FFloorLayoutData& Layout = Floor.Layout;
+    if (!Floor.bSucceeded || !Layout.IsValid())
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to generate floor layout"));
         return;
     }
 
-    // 2. Parse layout JSON
-    TSharedPtr<FJsonObject> LayoutObj;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LayoutJson);
-    if (!FJsonSerializer::Deserialize(Reader, LayoutObj) || !LayoutObj.IsValid())
+    UTowerGameSubsystem* Sub = GetTowerSubsystem();
+    CurrentFloorId = FloorId;
+    if (Sub)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to parse floor layout JSON"));
-        return;
+        Sub->CurrentFloor = FloorId;
+        if (FloorId > Sub->HighestFloor)
+        {
+            Sub->HighestFloor = FloorId;
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("=== Loading Floor %d ==="), FloorId);
+
+    PreloadFloorVFX();
+    AcquireFloorAssets(Floor);
+
+    // 1. Start the floor geometry; the renderer finishes it in TickFloorBuild
+    BuildingFloorId = FloorId;
+    BuildingTileCount = INDEX_NONE;
+    if (CVarFloorActorTiles.GetValueOnGameThread() != 0 || !BeginFloorGeometry(Layout))
+    {
+        BuildingTileCount = BuildFloorGeometryAsActors(Layout);
+    }
+
+    // 2. Find monster spawn points from the room table
+    PendingSpawnPoints.Reset();
+    for (const FFloorLayoutRoom& Room : Layout.Rooms)
+    {
+        // Monsters spawn in Combat and Boss rooms
+        if (Room.RoomType == EFloorRoomType::Combat || Room.RoomType == EFloorRoomType::Boss)
+        {
+            FVector Center(
+                (Room.X + Room.Width * 0.5f) * TileSize,
+                (Room.Y + Room.Height * 0.5f) * TileSize,
+                50.0f
+            );
+            PendingSpawnPoints.Add(Center);
+        }
+    }
+    PendingMonsters = Floor.Monsters;
+}
+
+bool ATowerGameMode::TickFloorBuild(double BudgetSeconds)
+{
+    if (!IsBuildingFloor())
+    {
+        return true;
+    }
+    if (IsValid(FloorRenderer) && FloorRenderer->IsBuildingTimeSliced() && !FloorRenderer->TickTimeSlicedFloor(BudgetSeconds))
+    {
+        return false;
+    }
+    FinishBuildFloor();
+    return true;
+}
+
+float ATowerGameMode::GetFloorBuildProgress() const
+{
+    if (!IsBuildingFloor() || !IsValid(FloorRenderer))
+    {
+        return 1.0f;
+    }
+    return FloorRenderer->GetTimeSlicedProgress();
+}
+
+void ATowerGameMode::FinishBuildFloor()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_FinishBuild);
+    const int32 FloorId = BuildingFloorId;
+    const int32 NumTiles = BuildingTileCount != INDEX_NONE ? BuildingTileCount
+        : (IsValid(FloorRenderer) ? FloorRenderer->TotalRenderedTiles : 0);
+    BuildingFloorId = INDEX_NONE;
+
+    // 3. Spawn monsters, now that there is floor collision to stand on
+    UTowerMonsterHordeSubsystem* Horde = bUseHordeRendering ? GetWorld()->GetSubsystem<UTowerMonsterHordeSubsystem>() : nullptr;
+    if (Horde)
+    {
+        // Records only; the horde spawns actors for the ones near a player itself
+        Horde->Configure(HordeMesh, HordeMaterial);
+        Horde->AddMonsters(PendingMonsters, PendingSpawnPoints, FloorId);
+        MonstersAlive = Horde->GetNumAlive();
+    }
+    else
+    {
+        TArray<AActor*> MonsterActors = AMonsterSpawner::SpawnMonsters(GetWorld(), PendingMonsters, PendingSpawnPoints, FloorId);
+        ApplyMonsterMeshes(MonsterActors);
+        for (AActor* M : MonsterActors)
+        {
+            SpawnedFloorActors.Add(M);
+        }
+        MonstersAlive = MonsterActors.Num();
+    }
+    PendingMonsters.Reset();
+    PendingSpawnPoints.Reset();
+
+    ReplayFloorJournal(FloorId);
+
+    UE_LOG(LogTemp, Log, TEXT("Floor %d loaded: %d tiles, %d monsters"), FloorId, NumTiles, MonstersAlive);
+    FinishLoadFloor(FloorId);
+}
+
+void ATowerGameMode::FinishLoadFloor(int32 FloorId)
+{
+    bFloorLoaded = true;
+    FloorLoadedTime = GetWorld()->GetTimeSeconds();
+    TRACE_BOOKMARK(TEXT("Floor %d loaded"), FloorId);
+
+    if (ATowerGameState* GS = GetGameState<ATowerGameState>())
+    {
+        GS->ActiveFloor = FloorId;
+        GS->MonstersRemaining = MonstersAlive;
+        GS->bStairsUnlocked = MonstersAlive == 0;
+        GS->NotifyTowerStateChanged();
+    }
+    OnFloorLoaded.Broadcast(FloorId);
+
+    if (IsValid(FloorRenderer) && FloorRenderer->CachedRooms.ContainsByPredicate(
+        [](const FRoomRenderData& Room) { return Room.RoomType == TEXT("boss"); }))
+    {
+        GetWorldTimerManager().SetTimer(BossRoomTimer, this, &ATowerGameMode::PollBossRoom, 0.25f, true);
+    }
+
+    // Stairs lead one floor up or down; have both ready before the player gets there
+    if (UTowerGameSubsystem* Sub = GetTowerSubsystem())
+    {
+        Sub->TrimPrefetchedFloors(FloorId, 1);
+    }
+    if (bPrefetchAdjacentFloors)
+    {
+        for (const int32 Adjacent : { FloorId + 1, FloorId - 1 })
+        {
+            if (!IsFloorResident(Adjacent))
+            {
+                PrefetchFloor(Adjacent);
+            }
+        }
+    }
+}
+
+void ATowerGameMode::HandleGameplayEvents(const FTowerGameplayEventBatch& Batch)
+{
+    const int32 Kills = bFloorLoaded ? FMath::Min(Batch.GetNumKills(CurrentFloorId), MonstersAlive) : 0;
+    if (Kills > 0)
+    {
+        MonstersAlive -= Kills;
+        if (ATowerGameState* GS = GetGameState<ATowerGameState>())
+        {
+            GS->OnMonstersDefeated(Kills);
+        }
+
+        if (MonstersAlive == 0)
+        {
+            OnAllMonstersDefeated.Broadcast(CurrentFloorId);
+            // Consumers hear of it with next frame's batch
+            if (UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>())
+            {
+                Events->PostFloorProgress({ CurrentFloorId, ETowerFloorProgress::Cleared,
+                    static_cast<float>(GetWorld()->GetTimeSeconds() - FloorLoadedTime) });
+            }
+        }
+    }
+
+    UTowerGameSubsystem* Sub = nullptr;
+    for (const FTowerFloorProgressEvent& Progress : Batch.FloorProgress)
+    {
+        if (Progress.Kind != ETowerFloorProgress::Cleared) continue;
+
+        Sub = Sub ? Sub : GetTowerSubsystem();
+        if (Sub && Sub->IsRustCoreReady())
+        {
+            Sub->RecordFloorCleared(Progress.FloorId,
+                static_cast<int32>(Sub->GetBridge()->GetFloorTier(static_cast<uint32>(Progress.FloorId))), Progress.Seconds);
+        }
+    }
+}
+
+ATowerProceduralFloorRenderer* ATowerGameMode::GetOrSpawnFloorRenderer()
+{
+    if (IsValid(FloorRenderer))
+    {
+        return FloorRenderer;
     }
 
-    // 3. Build floor geometry
     UWorld* World = GetWorld();
-    int32 Width = LayoutObj->GetIntegerField(TEXT("width"));
-    int32 Height = LayoutObj->GetIntegerField(TEXT("height"));
+    if (!World) return nullptr;
+
+    UClass* RendererClass = FloorRendererClass ? FloorRendererClass.Get() : ATowerProceduralFloorRenderer::StaticClass();
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = this;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    FloorRenderer = World->SpawnActor<ATowerProceduralFloorRenderer>(RendererClass, FTransform::Identity, SpawnParams);
+    if (FloorRenderer)
+    {
+        FloorRenderer->OnTileMutated.AddDynamic(this, &ATowerGameMode::HandleTileMutated);
+    }
+    return FloorRenderer;
+}
+
+void ATowerGameMode::ReplayFloorJournal(int32 FloorId)
+{
+    UTowerGameSubsystem* Sub = GetTowerSubsystem();
+    if (!Sub) return;
 
-    // Tiles from Rust are a 2D array: tiles[y][x] (each element is a u8 tile type)
-    const TArray<TSharedPtr<FJsonValue>>* TilesRows;
-    if (LayoutObj->TryGetArrayField(TEXT("tiles"), TilesRows))
+    // Revisits replay a compacted stream; destructibles and chests read it as they spawn
+    FTowerFloorDeltaJournal& Journal = Sub->GetDeltaJournal();
+    Journal.Compact(FloorId);
+    const FTowerFloorDeltaJournal::FFloorState* State = Journal.Find(FloorId);
+    if (!State || State->Tiles.Num() == 0 || !IsValid(FloorRenderer) || BuildingTileCount != INDEX_NONE)
     {
-        for (int32 y = 0; y < Height && y < TilesRows->Num(); y++)
+        return;
+    }
+
+    TArray<FIntPoint> Cells;
+    TArray<ETowerTileType> Types;
+    Cells.Reserve(State->Tiles.Num());
+    Types.Reserve(State->Tiles.Num());
+    for (const TPair<FIntPoint, uint8>& Tile : State->Tiles)
+    {
+        if (Tile.Value >= static_cast<uint8>(ETowerTileType::MAX)) continue;
+        Cells.Add(Tile.Key);
+        Types.Add(static_cast<ETowerTileType>(Tile.Value));
+    }
+
+    TGuardValue<bool> Replaying(bReplayingJournal, true);
+    FloorRenderer->UpdateTileStates(Cells, Types);
+    UE_LOG(LogTemp, Log, TEXT("Floor %d: replayed %d journaled tiles (%d bytes)"),
+        FloorId, Cells.Num(), Journal.GetNumBytes(FloorId));
+}
+
+void ATowerGameMode::HandleTileMutated(int32 X, int32 Y, ETowerTileType NewType)
+{
+    if (bReplayingJournal) return;
+    if (UTowerGameSubsystem* Sub = GetTowerSubsystem())
+    {
+        Sub->GetDeltaJournal().RecordTile(CurrentFloorId, X, Y, static_cast<uint8>(NewType));
+    }
+}
+
+void ATowerGameMode::PollBossRoom()
+{
+    const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    const APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+    if (!Pawn || !IsValid(FloorRenderer)) return;
+
+    int32 X, Y;
+    FloorRenderer->WorldToGrid(Pawn->GetActorLocation(), X, Y);
+    const int32 RoomIdx = FloorRenderer->GetRoomIndexAt(X, Y);
+    if (FloorRenderer->CachedRooms.IsValidIndex(RoomIdx) && FloorRenderer->CachedRooms[RoomIdx].RoomType == TEXT("boss"))
+    {
+        TRACE_BOOKMARK(TEXT("Boss fight: floor %d"), CurrentFloorId);
+        GetWorldTimerManager().ClearTimer(BossRoomTimer);
+
+        UTowerGameSubsystem* Sub = GetTowerSubsystem();
+        if (UTowerNetworkSubsystem* Network = GetGameInstance()->GetSubsystem<UTowerNetworkSubsystem>())
+        {
+            Network->NoteBossAttempt(Sub ? Sub->TowerSeed : 0, CurrentFloorId);
+        }
+    }
+}
+
+FIntPoint ATowerGameMode::GetCellAt(const FVector& Location) const
+{
+    // Same cells as ATowerProceduralFloorRenderer::WorldToGrid: tile centres sit on multiples of TileSize
+    return FIntPoint(FMath::RoundToInt32(Location.X / TileSize), FMath::RoundToInt32(Location.Y / TileSize));
+}
+
+void ATowerGameMode::RecordChestOpened(const FVector& Location)
+{
+    if (UTowerGameSubsystem* Sub = GetTowerSubsystem())
+    {
+        const FIntPoint Cell = GetCellAt(Location);
+        Sub->GetDeltaJournal().RecordChestOpened(CurrentFloorId, Cell.X, Cell.Y);
+    }
+}
+
+bool ATowerGameMode::WasChestOpened(const FVector& Location)
+{
+    UTowerGameSubsystem* Sub = GetTowerSubsystem();
+    const FTowerFloorDeltaJournal::FFloorState* State = Sub ? Sub->GetDeltaJournal().Find(CurrentFloorId) : nullptr;
+    return State && State->OpenedChests.Contains(GetCellAt(Location));
+}
+
+bool ATowerGameMode::BeginFloorGeometry(const FFloorLayoutData& Layout)
+{
+    ATowerProceduralFloorRenderer* Renderer = GetOrSpawnFloorRenderer();
+    if (!Renderer)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Floor renderer unavailable, spawning tile actors"));
+        return false;
+    }
+
+    Renderer->RenderConfig.TileSize = TileSize;
+    Renderer->RenderConfig.WallHeight = WallHeight;
+
+    TileScratch.Reset(Layout.Tiles.Num());
+    for (int32 y = 0; y < Layout.Height; y++)
+    {
+        for (int32 x = 0; x < Layout.Width; x++)
         {
-            const TArray<TSharedPtr<FJsonValue>>& Row = (*TilesRows)[y]->AsArray();
-            for (int32 x = 0; x < Width && x < Row.Num(); x++)
+            const uint8 TileType = Layout.GetTile(x, y);
+            if (TileType == 0 || TileType >= static_cast<uint8>(ETowerTileType::MAX))
             {
-                int32 TileType = static_cast<int32>(Row[x]->AsNumber());
-                FVector TileLocation(x * TileSize, y * TileSize, 0.0f);
-
-                AActor* TileActor = AFloorBuilder::SpawnTile(World, TileType, TileLocation, TileSize, WallHeight);
-                if (TileActor)
-                {
-                    SpawnedFloorActors.Add(TileActor);
-                }
+                continue;
             }
+
+            FTileRenderData& Tile = TileScratch.AddDefaulted_GetRef();
+            Tile.X = x;
+            Tile.Y = y;
+            Tile.TileType = static_cast<ETowerTileType>(TileType);
         }
     }
 
-    // 4. Parse rooms and find spawn points
-    TArray<FVector> SpawnPoints;
-    const TArray<TSharedPtr<FJsonValue>>* RoomsArray;
-    if (LayoutObj->TryGetArrayField(TEXT("rooms"), RoomsArray))
+    RoomScratch.Reset(Layout.Rooms.Num());
+    for (int32 i = 0; i < Layout.Rooms.Num(); i++)
     {
-        for (const auto& RoomVal : *RoomsArray)
+        const FFloorLayoutRoom& Source = Layout.Rooms[i];
+        FRoomRenderData& Room = RoomScratch.AddDefaulted_GetRef();
+        Room.RoomId = i;
+        Room.X = Source.X;
+        Room.Y = Source.Y;
+        Room.Width = Source.Width;
+        Room.Height = Source.Height;
+        Room.RoomType = GetRoomTypeName(Source.RoomType);
+    }
+
+    Renderer->BeginTimeSlicedFloor(TileScratch, RoomScratch);
+    return true;
+}
+
+int32 ATowerGameMode::BuildFloorGeometryAsActors(const FFloorLayoutData& Layout)
+{
+    // Tiles are row-major: Tiles[y * Width + x]
+    UWorld* World = GetWorld();
+    int32 NumTiles = 0;
+    for (int32 y = 0; y < Layout.Height; y++)
+    {
+        for (int32 x = 0; x < Layout.Width; x++)
         {
-            TSharedPtr<FJsonObject> Room = RoomVal->AsObject();
-            if (!Room.IsValid()) continue;
+            int32 TileType = Layout.GetTile(x, y);
+            FVector TileLocation(x * TileSize, y * TileSize, 0.0f);
+
+            AActor* TileActor = AFloorBuilder::SpawnTile(World, TileType, TileLocation, TileSize, WallHeight);
+            if (TileActor)
+            {
+                SpawnedFloorActors.Add(TileActor);
+                NumTiles++;
+            }
+        }
+    }
+    return NumTiles;
+}
 
-            FString RoomType = Room->GetStringField(TEXT("room_type"));
-            int32 RoomX = Room->GetIntegerField(TEXT("x"));
-            int32 RoomY = Room->GetIntegerField(TEXT("y"));
-            int32 RoomW = Room->GetIntegerField(TEXT("width"));
-            int32 RoomH = Room->GetIntegerField(TEXT("height"));
+void ATowerGameMode::PreloadFloorVFX()
+{
+    UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>();
+    if (!VFXPool) return;
 
-            // Monsters spawn in Combat, Treasure, and Boss rooms
-            if (RoomType == TEXT("Combat") || RoomType == TEXT("Boss"))
+    TArray<FSoftObjectPath> Systems;
+    for (int32 Mat = 0; Mat <= static_cast<int32>(ETowerDestructionMaterial::Organic); Mat++)
+    {
+        Systems.Add(UTowerDestructibleComponent::GetDestructionVFXPath(static_cast<ETowerDestructionMaterial>(Mat)));
+    }
+    for (const TSoftObjectPtr<UNiagaraSystem>& System : FloorPreloadVFX)
+    {
+        Systems.Add(System.ToSoftObjectPath());
+    }
+
+    // Already-loaded systems finish immediately
+    VFXPool->PreloadSystems(Systems);
+}
+
+void ATowerGameMode::PrefetchFloorAssets(const FGeneratedFloorData& Floor)
+{
+    if (NextFloorAssetsId == Floor.FloorId && NextFloorAssetHandle.IsValid())
+    {
+        return;
+    }
+    if (NextFloorAssetHandle.IsValid())
+    {
+        NextFloorAssetHandle->ReleaseHandle();
+        NextFloorAssetHandle.Reset();
+    }
+    NextFloorAssetsId = Floor.FloorId;
+
+    TArray<FSoftObjectPath> Paths;
+    for (const FFloorMonsterData& Monster : Floor.Monsters)
+    {
+        if (const TSoftObjectPtr<UStaticMesh>* Mesh = MonsterElementMeshes.Find(Monster.Element))
+        {
+            if (!Mesh->IsNull())
             {
-                FVector Center(
-                    (RoomX + RoomW * 0.5f) * TileSize,
-                    (RoomY + RoomH * 0.5f) * TileSize,
-                    50.0f
-                );
-                SpawnPoints.Add(Center);
+                Paths.AddUnique(Mesh->ToSoftObjectPath());
             }
         }
     }
+    if (Paths.Num() > 0)
+    {
+        NextFloorAssetHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths));
+    }
+}
 
-    // 5. Generate and spawn monsters
-    int32 MonsterCount = BaseMonstersPerFloor + (FloorId / 5);
-    FString MonstersJson = Sub->RequestFloorMonsters(Sub->TowerSeed, FloorId, MonsterCount);
+void ATowerGameMode::AcquireFloorAssets(const FGeneratedFloorData& Floor)
+{
+    // Requested now if nothing prefetched this floor; the last floor's meshes go once this holds its own
+    PrefetchFloorAssets(Floor);
+    if (FloorAssetHandle.IsValid())
+    {
+        FloorAssetHandle->ReleaseHandle();
+    }
+    FloorAssetHandle = MoveTemp(NextFloorAssetHandle);
+    NextFloorAssetHandle.Reset();
+    NextFloorAssetsId = INDEX_NONE;
+}
 
-    if (!MonstersJson.IsEmpty())
+void ATowerGameMode::ApplyMonsterMeshes(TConstArrayView<AActor*> Monsters)
+{
+    if (MonsterElementMeshes.Num() == 0)
+    {
+        return;
+    }
+    if (FloorAssetHandle.IsValid() && FloorAssetHandle->IsLoadingInProgress())
     {
-        TArray<AActor*> MonsterActors = AMonsterSpawner::SpawnMonstersFromJson(
-            World, MonstersJson, SpawnPoints, FloorId);
+        UE_LOG(LogTemp, Log, TEXT("Monster meshes still streaming at spawn; waiting"));
+        FloorAssetHandle->WaitUntilComplete();
+    }
 
-        for (AActor* M : MonsterActors)
+    // Pooled monsters may carry another element's mesh from an earlier floor
+    const UStaticMeshComponent* DefaultMesh = GetDefault<ATowerMonster>()->MeshComponent;
+    for (AActor* Actor : Monsters)
+    {
+        ATowerMonster* Monster = Cast<ATowerMonster>(Actor);
+        if (!Monster || !Monster->MeshComponent)
         {
-            SpawnedFloorActors.Add(M);
+            continue;
         }
-        MonstersAlive = MonsterActors.Num();
+        const TSoftObjectPtr<UStaticMesh>* Mesh = MonsterElementMeshes.Find(Monster->Element);
+        UStaticMesh* Wanted = Mesh ? Mesh->Get() : nullptr;
+        Monster->MeshComponent->SetStaticMesh(Wanted ? Wanted : (DefaultMesh ? DefaultMesh->GetStaticMesh() : nullptr));
     }
+}
 
-    bFloorLoaded = true;
-    OnFloorLoaded.Broadcast(FloorId);
-    UE_LOG(LogTemp, Log, TEXT("Floor %d loaded: %d tiles, %d monsters"), FloorId, SpawnedFloorActors.Num() - MonstersAlive, MonstersAlive);
+void ATowerGameMode::WarmupFloorPSOs(const FGeneratedFloorData& Floor)
+{
+    UTowerPSOWarmupSubsystem* Warmup = GetWorld()->GetSubsystem<UTowerPSOWarmupSubsystem>();
+    if (!Warmup || !Floor.bSucceeded || !Warmup->IsWarmingUp()) return;
+
+    PreloadFloorVFX();
+
+    // Tile types the layout actually uses
+    TBitArray<> SeenTypes(false, static_cast<int32>(ETowerTileType::MAX));
+    TArray<ETowerTileType, TInlineAllocator<16>> TileTypes;
+    for (uint8 TileType : Floor.Layout.Tiles)
+    {
+        if (TileType < static_cast<uint8>(ETowerTileType::MAX) && !SeenTypes[TileType])
+        {
+            SeenTypes[TileType] = true;
+            TileTypes.Add(static_cast<ETowerTileType>(TileType));
+        }
+    }
+    if (ATowerProceduralFloorRenderer* Renderer = GetOrSpawnFloorRenderer())
+    {
+        Renderer->AddTileWarmup(*Warmup, TileTypes);
+    }
+
+    // Element tints are parameters of one shared material, so one monster mesh covers the set
+    if (Floor.Monsters.Num() > 0)
+    {
+        const UStaticMeshComponent* MonsterMesh = GetDefault<ATowerMonster>()->MeshComponent;
+        if (MonsterMesh)
+        {
+            Warmup->AddMesh(MonsterMesh->GetStaticMesh(), MonsterMesh->GetMaterial(0), /*bInstanced=*/false);
+            if (bUseHordeRendering)
+            {
+                Warmup->AddMesh(HordeMesh ? HordeMesh : MonsterMesh->GetStaticMesh(),
+                    HordeMaterial ? HordeMaterial : MonsterMesh->GetMaterial(0), /*bInstanced=*/true);
+            }
+        }
+    }
+
+    // Systems PreloadFloorVFX has already brought in
+    UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>();
+    if (VFXPool)
+    {
+        for (int32 Mat = 0; Mat <= static_cast<int32>(ETowerDestructionMaterial::Organic); Mat++)
+        {
+            const TSoftObjectPtr<UNiagaraSystem> System(UTowerDestructibleComponent::GetDestructionVFXPath(static_cast<ETowerDestructionMaterial>(Mat)));
+            Warmup->AddNiagaraSystem(VFXPool->FindSystem(System));
+        }
+        for (const TSoftObjectPtr<UNiagaraSystem>& System : FloorPreloadVFX)
+        {
+            Warmup->AddNiagaraSystem(VFXPool->FindSystem(System));
+        }
+    }
+}
+
+void ATowerGameMode::PrefetchFloor(int32 FloorId)
+{
+    UTowerGameSubsystem* Sub = GetTowerSubsystem();
+    if (Sub && FloorId >= 1)
+    {
+        Sub->PrefetchFloor(Sub->TowerSeed, FloorId, GetMonsterCountForFloor(FloorId));
+    }
 }
 
 void ATowerGameMode::GoToNextFloor()
@@ -169,15 +673,206 @@ void ATowerGameMode::GoToPreviousFloor()
 
 void ATowerGameMode::ClearCurrentFloor()
 {
-    for (AActor* Actor : SpawnedFloorActors)
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_ClearCurrent);
+    GetWorldTimerManager().ClearTimer(BossRoomTimer);
+
+    RetireFloorActors(SpawnedFloorActors);
+    if (UTowerMonsterHordeSubsystem* Horde = GetWorld() ? GetWorld()->GetSubsystem<UTowerMonsterHordeSubsystem>() : nullptr)
     {
-        if (Actor && IsValid(Actor))
-        {
-            Actor->Destroy();
-        }
+        Horde->Clear();
     }
-    SpawnedFloorActors.Empty();
+    if (IsValid(FloorRenderer))
+    {
+        FloorRenderer->ClearFloor();
+    }
+    BuildingFloorId = INDEX_NONE;
+    PendingMonsters.Reset();
+    PendingSpawnPoints.Reset();
     MonstersAlive = 0;
     bFloorLoaded = false;
     OnFloorCleared.Broadcast();
 }
+
+void ATowerGameMode::RetireFloorActors(TArray<AActor*>& Actors)
+{
+    UWorld* World = GetWorld();
+    UTowerMonsterPool* MonsterPool = World ? World->GetSubsystem<UTowerMonsterPool>() : nullptr;
+    UTowerFloorTeardownSubsystem* Teardown = World ? World->GetSubsystem<UTowerFloorTeardownSubsystem>() : nullptr;
+    for (AActor* Actor : Actors)
+    {
+        if (!IsValid(Actor))
+        {
+            continue;
+        }
+
+        // Monsters go back to the pool for the next floor
+        ATowerMonster* Monster = Cast<ATowerMonster>(Actor);
+        if (Monster && MonsterPool)
+        {
+            MonsterPool->Release(Monster);
+        }
+        else if (Teardown)
+        {
+            Teardown->RetireActor(Actor);
+        }
+        else
+        {
+            Actor->Destroy();
+        }
+    }
+    Actors.Empty();
+}
+
+int32 ATowerGameMode::FindResidentFloor(int32 FloorId) const
+{
+    return ResidentFloors.IndexOfByPredicate([FloorId](const FTowerResidentFloor& Resident) { return Resident.FloorId == FloorId; });
+}
+
+bool ATowerGameMode::IsFloorResident(int32 FloorId) const
+{
+    return FindResidentFloor(FloorId) != INDEX_NONE;
+}
+
+bool ATowerGameMode::ParkCurrentFloor()
+{
+    // Only floors on the instanced renderer (not the actor-tile debug path), and never
+    // with the horde, which keeps no per-floor state to park
+    if (MaxResidentFloors <= 0 || bUseHordeRendering || !bFloorLoaded || IsBuildingFloor()
+        || !IsValid(FloorRenderer) || BuildingTileCount != INDEX_NONE)
+    {
+        return false;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_Park);
+    GetWorldTimerManager().ClearTimer(BossRoomTimer);
+
+    const UTowerGameSubsystem* Sub = GetTowerSubsystem();
+    FTowerResidentFloor& Resident = ResidentFloors.AddDefaulted_GetRef();
+    Resident.FloorId = CurrentFloorId;
+    Resident.Seed = Sub ? Sub->TowerSeed : 0;
+    Resident.MonstersAlive = MonstersAlive;
+    Resident.Renderer = FloorRenderer;
+    Resident.Actors = MoveTemp(SpawnedFloorActors);
+    SpawnedFloorActors.Reset();
+
+    FloorRenderer->SetFloorDormant(true);
+    Resident.Bytes = FloorRenderer->EstimateFloorBytes();
+    for (AActor* Actor : Resident.Actors)
+    {
+        ATowerMonster* Monster = Cast<ATowerMonster>(Actor);
+        if (IsValid(Monster))
+        {
+            Monster->SetDormant(true);
+        }
+    }
+
+    // The next floor gets a renderer of its own
+    FloorRenderer = nullptr;
+
+    UE_LOG(LogTemp, Log, TEXT("Floor %d parked (%d actors, ~%lld KB); %d floors resident"),
+        Resident.FloorId, Resident.Actors.Num(), Resident.Bytes / 1024, ResidentFloors.Num());
+
+    TrimResidentFloors();
+    return true;
+}
+
+bool ATowerGameMode::ActivateResidentFloor(int32 FloorId)
+{
+    const int32 Index = FindResidentFloor(FloorId);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    UTowerGameSubsystem* Sub = GetTowerSubsystem();
+    if (!IsValid(ResidentFloors[Index].Renderer) || (Sub && Sub->TowerSeed != ResidentFloors[Index].Seed))
+    {
+        // Gone, or a new run: with another seed it's a different floor
+        EvictResidentFloor(Index);
+        return false;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_ActivateResident);
+    FTowerResidentFloor Resident = MoveTemp(ResidentFloors[Index]);
+    ResidentFloors.RemoveAt(Index);
+
+    ParkCurrentFloor();
+    ClearCurrentFloor();
+    if (IsValid(FloorRenderer))
+    {
+        // Cleared rather than parked; the resident floor brings its own
+        if (UTowerFloorTeardownSubsystem* Teardown = GetWorld()->GetSubsystem<UTowerFloorTeardownSubsystem>())
+        {
+            Teardown->RetireActor(FloorRenderer);
+        }
+        else
+        {
+            FloorRenderer->Destroy();
+        }
+    }
+
+    FloorRenderer = Resident.Renderer;
+    FloorRenderer->SetFloorDormant(false);
+    SpawnedFloorActors = MoveTemp(Resident.Actors);
+    SpawnedFloorActors.RemoveAll([](const AActor* Actor) { return !IsValid(Actor); });
+    for (AActor* Actor : SpawnedFloorActors)
+    {
+        if (ATowerMonster* Monster = Cast<ATowerMonster>(Actor))
+        {
+            Monster->SetDormant(false);
+        }
+    }
+
+    // HighestFloor already counts it: the player has been here
+    CurrentFloorId = FloorId;
+    if (Sub)
+    {
+        Sub->CurrentFloor = FloorId;
+    }
+    MonstersAlive = Resident.MonstersAlive;
+
+    UE_LOG(LogTemp, Log, TEXT("Floor %d resumed from residency: %d monsters"), FloorId, MonstersAlive);
+    FinishLoadFloor(FloorId);
+    return true;
+}
+
+void ATowerGameMode::TrimResidentFloors()
+{
+    const int64 Budget = static_cast<int64>(ResidentFloorBudgetMB) * 1024 * 1024;
+    int64 TotalBytes = 0;
+    for (const FTowerResidentFloor& Resident : ResidentFloors)
+    {
+        TotalBytes += Resident.Bytes;
+    }
+
+    while (ResidentFloors.Num() > 0
+        && (ResidentFloors.Num() > MaxResidentFloors || (Budget > 0 && TotalBytes > Budget)))
+    {
+        TotalBytes -= ResidentFloors[0].Bytes;
+        EvictResidentFloor(0);
+    }
+}
+
+void ATowerGameMode::EvictResidentFloor(int32 Index)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_EvictResident);
+    FTowerResidentFloor Resident = MoveTemp(ResidentFloors[Index]);
+    ResidentFloors.RemoveAt(Index);
+
+    // Its Renderer's EndPlay clears the geometry whenever the teardown gets to it
+    if (IsValid(Resident.Renderer))
+    {
+        Resident.Actors.Add(Resident.Renderer);
+    }
+    RetireFloorActors(Resident.Actors);
+
+    UE_LOG(LogTemp, Log, TEXT("Floor %d evicted from residency"), Resident.FloorId);
+}
+
+void ATowerGameMode::ClearResidentFloors()
+{
+    while (ResidentFloors.Num() > 0)
+    {
+        EvictResidentFloor(ResidentFloors.Num() - 1);
+    }
+}
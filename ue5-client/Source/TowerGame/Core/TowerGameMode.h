@@ -2,9 +2,36 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "Bridge/ProceduralCoreBridge.h"
+#include "Rendering/ProceduralFloorRenderer.h"
 #include "TowerGameMode.generated.h"
 
 class UTowerGameSubsystem;
+class UNiagaraSystem;
+struct FTowerGameplayEventBatch;
+struct FGeneratedFloorData;
+struct FStreamableHandle;
+
+/** A floor the player left, kept built but dormant (see ATowerGameMode::MaxResidentFloors) */
+USTRUCT()
+struct FTowerResidentFloor
+{
+    GENERATED_BODY()
+
+    int32 FloorId = INDEX_NONE;
+    int64 Seed = 0;
+    int32 MonstersAlive = 0;
+
+    /** EstimateFloorBytes when it was parked */
+    int64 Bytes = 0;
+
+    UPROPERTY()
+    ATowerProceduralFloorRenderer* Renderer = nullptr;
+
+    /** Its monsters, parked with ATowerMonster::SetDormant */
+    UPROPERTY()
+    TArray<AActor*> Actors;
+};
 
 /**
  * Tower Game Mode — manages floor lifecycle, monster spawning, and game state.
@@ -27,6 +54,54 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
     void LoadFloor(int32 FloorId);
 
+    /** Replace the current floor with one generated by UTowerGameSubsystem, all in this frame */
+    void BuildFloor(const FGeneratedFloorData& Floor);
+
+    /**
+     * Replace the current floor with Floor over several frames: clears the old one and
+     * starts the geometry; call TickFloorBuild each frame until it returns true.
+     * Monsters spawn and OnFloorLoaded fires when the geometry is done.
+     */
+    void BeginBuildFloor(const FGeneratedFloorData& Floor);
+
+    /** Spend about BudgetSeconds (<= 0 = no limit) on the build in progress; true once the floor is loaded */
+    bool TickFloorBuild(double BudgetSeconds);
+
+    /** 0-1 through the build in progress */
+    float GetFloorBuildProgress() const;
+
+    bool IsBuildingFloor() const { return BuildingFloorId != INDEX_NONE; }
+
+    /** The floor renderer, if one has been spawned */
+    ATowerProceduralFloorRenderer* GetFloorRenderer() const { return FloorRenderer; }
+
+    /**
+     * Top up the monster pool for floor FloorId, spawning at most MaxSpawns parked
+     * monsters. Call each frame of a loading fade; returns true once it's full.
+     */
+    bool PrewarmMonsters(int32 FloorId, int32 MaxSpawns = 2);
+
+    /**
+     * Start PSO precaches for what Floor will draw: its tile meshes and materials, the
+     * monster mesh and the floor's VFX set. Call while the screen is faded out; the
+     * floor transition collects the misses at fade-in.
+     */
+    void WarmupFloorPSOs(const FGeneratedFloorData& Floor);
+
+    /**
+     * Start streaming the MonsterElementMeshes Floor's monsters use. Call as soon as the
+     * floor is generated; BeginBuildFloor takes the request over and releases the last
+     * floor's set, so only the current floor's meshes stay loaded.
+     */
+    void PrefetchFloorAssets(const FGeneratedFloorData& Floor);
+
+    /** How many monsters floor FloorId gets (base, scales with floor tier) */
+    int32 GetMonsterCountForFloor(int32 FloorId) const;
+
+    /** Generate FloorId in the background so a transition to it skips generation */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
+    void PrefetchFloor(int32 FloorId);
+
     /** Advance to next floor */
     UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
     void GoToNextFloor();
@@ -39,6 +114,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
     void ClearCurrentFloor();
 
+    /** Whether FloorId is parked and ActivateResidentFloor would bring it back without a rebuild */
+    UFUNCTION(BlueprintPure, Category = "Tower|Floor")
+    bool IsFloorResident(int32 FloorId) const;
+
+    /**
+     * Swap the parked FloorId in for the current floor, which is parked in turn (or
+     * cleared). Geometry, monsters and tile changes are as the player left them;
+     * OnFloorLoaded fires as for a build. False if FloorId isn't resident.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
+    bool ActivateResidentFloor(int32 FloorId);
+
+    /** Destroy every parked floor */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
+    void ClearResidentFloors();
+
+    /** Journal a chest opened at Location on the current floor, so it stays open on revisit */
+    void RecordChestOpened(const FVector& Location);
+
+    /** Whether the chest at Location on the current floor was opened on an earlier visit */
+    bool WasChestOpened(const FVector& Location);
+
     // ============ State ============
 
     UPROPERTY(BlueprintReadOnly, Category = "Tower|State")
@@ -64,6 +161,54 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config")
     float WallHeight = 400.0f;
 
+    /**
+     * Floors the player left that stay built but dormant (hidden, no tick, collision
+     * or navigation), so going back to one is a visibility toggle instead of a
+     * rebuild. The least recently left go first. 0 = every floor change rebuilds.
+     * Not used with bUseHordeRendering: the horde only holds the current floor.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config|Residency", meta = (ClampMin = "0", ClampMax = "8"))
+    int32 MaxResidentFloors = 0;
+
+    /** Estimated MB the parked floors may hold together (0 = only MaxResidentFloors limits them) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config|Residency", meta = (ClampMin = "0"))
+    int32 ResidentFloorBudgetMB = 256;
+
+    /** Once a floor is loaded, generate the floors above and below it in the background */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config")
+    bool bPrefetchAdjacentFloors = true;
+
+    /**
+     * Renders floor geometry as one instanced mesh per tile type. Subclass it to
+     * assign tile meshes and biome materials. tower.Floor.ActorTiles=1 spawns an
+     * AFloorBuilder actor per tile instead (debugging only).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config")
+    TSubclassOf<ATowerProceduralFloorRenderer> FloorRendererClass;
+
+    /**
+     * Draw monsters away from the players as GPU-animated instances (UTowerMonsterHordeSubsystem)
+     * and only spawn actors for those near a player or in a fight
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config|Horde")
+    bool bUseHordeRendering = false;
+
+    /** Horde instance mesh; the ATowerMonster mesh when unset */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config|Horde")
+    UStaticMesh* HordeMesh = nullptr;
+
+    /** Vertex animation material reading HordeCustomData; the ATowerMonster material when unset */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config|Horde")
+    UMaterialInterface* HordeMaterial = nullptr;
+
+    /** Monster mesh per element, streamed in with the floors that spawn it; the ATowerMonster mesh otherwise */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config")
+    TMap<EMonsterElement, TSoftObjectPtr<UStaticMesh>> MonsterElementMeshes;
+
+    /** Niagara systems (elemental hits, deaths, ...) loaded with every floor, next to the destruction set */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Config")
+    TArray<TSoftObjectPtr<UNiagaraSystem>> FloorPreloadVFX;
+
     // ============ Delegates ============
 
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFloorLoaded, int32, FloorId);
@@ -82,7 +227,103 @@ public:
 private:
     UTowerGameSubsystem* GetTowerSubsystem() const;
 
+    /** Start async loads of the VFX a floor plays, so none load on first use */
+    void PreloadFloorVFX();
+
+    /** The renderer for this mode's floors, spawned on first use; null if it couldn't be spawned */
+    ATowerProceduralFloorRenderer* GetOrSpawnFloorRenderer();
+
+    /** Start a time-sliced build of the floor geometry in the renderer; false if there is no renderer */
+    bool BeginFloorGeometry(const FFloorLayoutData& Layout);
+
+    /** Spawn the monsters and announce the floor once its geometry is built */
+    void FinishBuildFloor();
+
+    /** Mark FloorId loaded, announce it and queue what comes after (boss watch, prefetch) */
+    void FinishLoadFloor(int32 FloorId);
+
+    /**
+     * A frame's events from UTowerGameplayEventSubsystem: the current floor's kills come off
+     * MonstersAlive and go to the game state together, and floor clears go to analytics
+     */
+    void HandleGameplayEvents(const FTowerGameplayEventBatch& Batch);
+
+    /** World time FinishLoadFloor last ran, for the clear time */
+    double FloorLoadedTime = 0.0;
+
+    /** Park the current floor in ResidentFloors if residency allows it; false if it should be cleared */
+    bool ParkCurrentFloor();
+
+    /** Drop parked floors beyond MaxResidentFloors or ResidentFloorBudgetMB, least recently left first */
+    void TrimResidentFloors();
+
+    /**
+     * Monsters back to the pool, everything else to UTowerFloorTeardownSubsystem to be
+     * destroyed over the next frames. Actors is emptied.
+     */
+    void RetireFloorActors(TArray<AActor*>& Actors);
+
+    /** Destroy ResidentFloors[Index]: monsters back to the pool, the renderer with its geometry */
+    void EvictResidentFloor(int32 Index);
+
+    int32 FindResidentFloor(int32 FloorId) const;
+
+    /** Re-apply the tile changes journaled on earlier visits to FloorId's fresh geometry */
+    void ReplayFloorJournal(int32 FloorId);
+
+    /** Journals runtime tile mutations on the current floor */
+    UFUNCTION()
+    void HandleTileMutated(int32 X, int32 Y, ETowerTileType NewType);
+
+    FIntPoint GetCellAt(const FVector& Location) const;
+
+    /**
+     * Insights bookmark and replay mark (UTowerNetworkSubsystem::NoteBossAttempt)
+     * for the first player stepping into the floor's boss room, the nearest thing
+     * to a boss fight starting the client can see. Polled on BossRoomTimer from
+     * floor load until it fires once.
+     */
+    void PollBossRoom();
+    FTimerHandle BossRoomTimer;
+
+    /** Set while the journal is being replayed so its own mutations aren't recorded again */
+    bool bReplayingJournal = false;
+
+    /** Take over (or start) the asset request for Floor and release the previous floor's */
+    void AcquireFloorAssets(const FGeneratedFloorData& Floor);
+
+    /** Give freshly spawned monsters their element's mesh, waiting on the floor's request if it is still loading */
+    void ApplyMonsterMeshes(TConstArrayView<AActor*> Monsters);
+
+    /** Keeps the current floor's monster meshes loaded */
+    TSharedPtr<FStreamableHandle> FloorAssetHandle;
+
+    /** PrefetchFloorAssets for NextFloorAssetsId, not yet taken over by a build */
+    TSharedPtr<FStreamableHandle> NextFloorAssetHandle;
+    int32 NextFloorAssetsId = INDEX_NONE;
+
+    /** Debug fallback: one ATowerTile actor per tile, added to SpawnedFloorActors */
+    int32 BuildFloorGeometryAsActors(const FFloorLayoutData& Layout);
+
     /** All actors spawned for the current floor (tiles, walls, monsters) */
     UPROPERTY()
     TArray<AActor*> SpawnedFloorActors;
+
+    /** Reused across floors; cleared, not destroyed, when a floor unloads (parked instead with residency) */
+    UPROPERTY()
+    ATowerProceduralFloorRenderer* FloorRenderer = nullptr;
+
+    /** Parked floors, least recently left first */
+    UPROPERTY()
+    TArray<FTowerResidentFloor> ResidentFloors;
+
+    /** Floor under construction (INDEX_NONE when idle) and what gets spawned once it's built */
+    int32 BuildingFloorId = INDEX_NONE;
+    int32 BuildingTileCount = INDEX_NONE;
+    TArray<FFloorMonsterData> PendingMonsters;
+    TArray<FVector> PendingSpawnPoints;
+
+    /** Conversion scratch for the renderer, kept to avoid reallocating per floor */
+    TArray<FTileRenderData> TileScratch;
+    TArray<FRoomRenderData> RoomScratch;
 };
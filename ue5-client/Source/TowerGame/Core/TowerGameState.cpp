@@ -2,6 +2,7 @@
 #include "TowerGameSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
@@ -9,30 +10,134 @@
 ATowerGameState::ATowerGameState()
 {
     PrimaryActorTick.bCanEverTick = true;
-    PrimaryActorTick.TickInterval = 1.0f; // Update breath once per second
+    PrimaryActorTick.TickInterval = 1.0f; // Breath progress once per second; phase changes have their own timer
 }
 
-void ATowerGameState::Tick(float DeltaSeconds)
+void ATowerGameState::BeginPlay()
 {
-    Super::Tick(DeltaSeconds);
+    Super::BeginPlay();
 
-    TotalGameTime += DeltaSeconds;
+    GameTimeAnchor = GetWorld()->GetTimeSeconds();
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(this))
+    {
+        if (UTowerGameSubsystem* Sub = GI->GetSubsystem<UTowerGameSubsystem>())
+        {
+            ConfigReloadedHandle = Sub->OnConfigReloaded.AddUObject(this, &ATowerGameState::SyncBreathCycle);
+        }
+    }
+    SyncBreathCycle();
+}
 
-    // Update breath state from Rust
-    if (HasAuthority())
+void ATowerGameState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    GetWorldTimerManager().ClearTimer(BreathBoundaryTimer);
+    if (UGameInstance* GI = UGameplayStatics::GetGameInstance(this))
     {
-        UGameInstance* GI = UGameplayStatics::GetGameInstance(this);
-        if (GI)
+        if (UTowerGameSubsystem* Sub = GI->GetSubsystem<UTowerGameSubsystem>())
         {
-            UTowerGameSubsystem* Sub = GI->GetSubsystem<UTowerGameSubsystem>();
-            if (Sub && Sub->IsRustCoreReady())
-            {
-                Sub->GameElapsedTime = TotalGameTime;
-                FString BreathJson = Sub->GetBreathState(TotalGameTime);
-                UpdateBreathFromJson(BreathJson);
-            }
+            Sub->OnConfigReloaded.Remove(ConfigReloadedHandle);
         }
     }
+    ConfigReloadedHandle.Reset();
+    Super::EndPlay(EndPlayReason);
+}
+
+void ATowerGameState::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    AdvanceGameTime();
+
+    UGameInstance* GI = UGameplayStatics::GetGameInstance(this);
+    UTowerGameSubsystem* Sub = GI ? GI->GetSubsystem<UTowerGameSubsystem>() : nullptr;
+    if (HasAuthority() && Sub)
+    {
+        Sub->GameElapsedTime = TotalGameTime;
+    }
+
+    if (BreathCycle.IsValid())
+    {
+        EvaluateBreath();
+    }
+    else if (HasAuthority() && Sub && Sub->IsRustCoreReady())
+    {
+        // No cycle definition from this DLL: ask Rust for the state itself
+        FString BreathJson = Sub->GetBreathState(TotalGameTime);
+        UpdateBreathFromJson(BreathJson);
+    }
+}
+
+// ============ Breath Cycle ============
+
+void ATowerGameState::SyncBreathCycle()
+{
+    UGameInstance* GI = UGameplayStatics::GetGameInstance(this);
+    UTowerGameSubsystem* Sub = GI ? GI->GetSubsystem<UTowerGameSubsystem>() : nullptr;
+    if (!Sub || !Sub->IsRustCoreReady() || !BreathCycle.ParseJson(Sub->GetBreathCycle()))
+    {
+        // Clients without the core keep following the replicated fields
+        BreathCycle.Reset();
+        BreathPhaseIndex = INDEX_NONE;
+        GetWorldTimerManager().ClearTimer(BreathBoundaryTimer);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Breath cycle: %d phases over %.0fs, evaluated locally"),
+        BreathCycle.Phases.Num(), BreathCycle.TotalSecs);
+    BreathPhaseIndex = INDEX_NONE;
+    AdvanceGameTime();
+    EvaluateBreath();
+}
+
+void ATowerGameState::AdvanceGameTime()
+{
+    // World time stops with the game, as the old per-tick DeltaSeconds sum did
+    const double Now = GetWorld()->GetTimeSeconds();
+    TotalGameTime += static_cast<float>(Now - GameTimeAnchor);
+    GameTimeAnchor = Now;
+}
+
+void ATowerGameState::EvaluateBreath()
+{
+    float Progress = 0.0f;
+    const int32 Index = BreathCycle.Evaluate(TotalGameTime, Progress);
+    if (Index == INDEX_NONE) return;
+
+    const FTowerBreathPhase& Phase = BreathCycle.Phases[Index];
+    MonsterSpawnMultiplier = Phase.MonsterSpawnMult;
+    SemanticFieldStrength = Phase.SemanticIntensity;
+
+    const bool bPhaseChanged = BreathPhaseIndex != INDEX_NONE && BreathPhaseIndex != Index;
+    BreathPhaseIndex = Index;
+
+    if (Phase.Phase != BreathPhase || Progress != BreathProgress)
+    {
+        BreathPhase = Phase.Phase;
+        BreathProgress = Progress;
+        NotifyTowerStateChanged();
+    }
+    if (bPhaseChanged)
+    {
+        OnBreathPhaseChanged.Broadcast(BreathPhase);
+    }
+
+    // Re-armed every evaluation, so a correction moves it too
+    const float ToBoundary = BreathCycle.GetSecondsToNextPhase(TotalGameTime);
+    GetWorldTimerManager().SetTimer(BreathBoundaryTimer, this, &ATowerGameState::OnBreathBoundary,
+        FMath::Max(ToBoundary, KINDA_SMALL_NUMBER), false);
+}
+
+void ATowerGameState::OnBreathBoundary()
+{
+    AdvanceGameTime();
+
+    // The timer only fires at a boundary; if float time lands a hair short of it, step over
+    float Progress = 0.0f;
+    if (BreathCycle.Evaluate(TotalGameTime, Progress) == BreathPhaseIndex)
+    {
+        TotalGameTime += BreathCycle.GetSecondsToNextPhase(TotalGameTime) + TotalGameTime * FLT_EPSILON;
+    }
+    EvaluateBreath();
 }
 
 void ATowerGameState::UpdateBreathFromJson(const FString& BreathJson)
@@ -44,21 +149,57 @@ void ATowerGameState::UpdateBreathFromJson(const FString& BreathJson)
     if (!FJsonSerializer::Deserialize(Reader, JsonObj) || !JsonObj.IsValid()) return;
 
     // Field names match Rust BreathState struct
-    BreathPhase = JsonObj->GetStringField(TEXT("phase"));
-    BreathProgress = JsonObj->GetNumberField(TEXT("phase_progress"));
+    const FString NewPhase = JsonObj->GetStringField(TEXT("phase"));
+    const float NewProgress = JsonObj->GetNumberField(TEXT("phase_progress"));
     MonsterSpawnMultiplier = JsonObj->GetNumberField(TEXT("monster_spawn_mult"));
     SemanticFieldStrength = JsonObj->GetNumberField(TEXT("semantic_intensity"));
+
+    const bool bPhaseChanged = NewPhase != BreathPhase;
+    if (bPhaseChanged || NewProgress != BreathProgress)
+    {
+        BreathPhase = NewPhase;
+        BreathProgress = NewProgress;
+        NotifyTowerStateChanged();
+    }
+    if (bPhaseChanged)
+    {
+        OnBreathPhaseChanged.Broadcast(BreathPhase);
+    }
 }
 
 void ATowerGameState::OnMonsterDefeated()
 {
-    MonstersRemaining = FMath::Max(0, MonstersRemaining - 1);
+    OnMonstersDefeated(1);
+}
+
+void ATowerGameState::OnMonstersDefeated(int32 Count)
+{
+    if (Count <= 0) return;
+
+    MonstersRemaining = FMath::Max(0, MonstersRemaining - Count);
 
-    if (MonstersRemaining <= 0)
+    if (MonstersRemaining <= 0 && !bStairsUnlocked)
     {
         bStairsUnlocked = true;
         UE_LOG(LogTemp, Log, TEXT("All monsters defeated! Stairs unlocked on floor %d"), ActiveFloor);
     }
+    NotifyTowerStateChanged();
+}
+
+void ATowerGameState::OnRep_TowerState()
+{
+    // Several of these can arrive in one bunch; listeners just reread them all
+    NotifyTowerStateChanged();
+}
+
+void ATowerGameState::OnRep_TotalGameTime()
+{
+    // The server's clock wins; evaluate from it and re-aim the boundary timer
+    GameTimeAnchor = GetWorld()->GetTimeSeconds();
+    if (BreathCycle.IsValid())
+    {
+        EvaluateBreath();
+    }
 }
 
 void ATowerGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -2,11 +2,25 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameStateBase.h"
+#include "Core/BreathCycle.h"
 #include "TowerGameState.generated.h"
 
+/** Native: the breath or floor fields below changed (server write or replication) */
+DECLARE_MULTICAST_DELEGATE(FOnTowerStateChanged);
+
+/** Native: the breath phase changed, fired at the boundary itself */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBreathPhaseChanged, const FString& /*NewPhase*/);
+
 /**
  * Tower Game State — replicated state visible to all players.
  * Tracks Breath of Tower cycle, floor progress, and global events.
+ *
+ * The breath cycle definition is fetched from the Rust core once (and again
+ * after a config reload) and evaluated locally from TotalGameTime, on the
+ * server and on clients with the core loaded; a replicated TotalGameTime is
+ * the server's correction. A timer lands on each phase boundary so phase
+ * changes don't wait for the next tick. A DLL without get_breath_cycle falls
+ * back to asking get_breath_state on the server each tick.
  */
 UCLASS()
 class TOWERGAME_API ATowerGameState : public AGameStateBase
@@ -17,15 +31,17 @@ public:
     ATowerGameState();
 
     virtual void Tick(float DeltaSeconds) override;
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // ============ Breath of Tower ============
 
     /** Current breath phase name (Inhale/Hold/Exhale/Pause) */
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "Tower|World")
+    UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_TowerState, Category = "Tower|World")
     FString BreathPhase = TEXT("Inhale");
 
     /** Phase progress 0.0 — 1.0 */
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "Tower|World")
+    UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_TowerState, Category = "Tower|World")
     float BreathProgress = 0.0f;
 
     /** Monster spawn multiplier from breath cycle */
@@ -37,21 +53,21 @@ public:
     float SemanticFieldStrength = 1.0f;
 
     /** Total game time in seconds */
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "Tower|World")
+    UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_TotalGameTime, Category = "Tower|World")
     float TotalGameTime = 0.0f;
 
     // ============ Floor State ============
 
     /** Current floor all players are on */
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "Tower|State")
+    UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_TowerState, Category = "Tower|State")
     int32 ActiveFloor = 1;
 
     /** Number of monsters remaining on current floor */
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "Tower|State")
+    UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_TowerState, Category = "Tower|State")
     int32 MonstersRemaining = 0;
 
     /** Is the stairs unlocked (all monsters defeated)? */
-    UPROPERTY(BlueprintReadOnly, Replicated, Category = "Tower|State")
+    UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_TowerState, Category = "Tower|State")
     bool bStairsUnlocked = false;
 
     // ============ API ============
@@ -60,8 +76,49 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Tower|State")
     void OnMonsterDefeated();
 
+    /** Count several deaths at once (a frame's batch from the GameMode), with one state change */
+    void OnMonstersDefeated(int32 Count);
+
     /** Update breath state from Rust core JSON */
     void UpdateBreathFromJson(const FString& BreathJson);
 
+    /**
+     * Fires when BreathPhase, BreathProgress, ActiveFloor, MonstersRemaining
+     * or bStairsUnlocked change, so the HUD needn't poll them. Code that
+     * writes those fields directly calls NotifyTowerStateChanged.
+     */
+    FOnTowerStateChanged OnTowerStateChanged;
+
+    void NotifyTowerStateChanged() { OnTowerStateChanged.Broadcast(); }
+
+    FOnBreathPhaseChanged OnBreathPhaseChanged;
+
+    /** Refetch the breath cycle definition and re-evaluate (called on config reload) */
+    void SyncBreathCycle();
+
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+    UFUNCTION()
+    void OnRep_TowerState();
+
+    UFUNCTION()
+    void OnRep_TotalGameTime();
+
+private:
+    /** Bring TotalGameTime up to the world clock */
+    void AdvanceGameTime();
+
+    /** Set the breath fields for TotalGameTime and arm the boundary timer */
+    void EvaluateBreath();
+
+    void OnBreathBoundary();
+
+    FTowerBreathCycle BreathCycle;
+    int32 BreathPhaseIndex = INDEX_NONE;
+    FTimerHandle BreathBoundaryTimer;
+    FDelegateHandle ConfigReloadedHandle;
+
+    /** World time TotalGameTime was last advanced to */
+    double GameTimeAnchor = 0.0;
 };
@@ -1,27 +1,140 @@
 #include "TowerGameSubsystem.h"
+#include "StartupTimeline.h"
+#include "TowerMemory.h"
+#include "ItemCatalog.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "TowerGame/Bridge/ProceduralCoreBridge.h"
 #include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarFloorCache(
+    TEXT("tower.FloorCache"),
+    1,
+    TEXT("Keep generated floors on disk (Saved/FloorCache) and reuse them across sessions. Read at startup.\n")
+    TEXT("0 = off, 1 = on"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarFloorCacheMaxMB(
+    TEXT("tower.FloorCache.MaxMB"),
+    64,
+    TEXT("Size cap of the on-disk floor cache in MB; least recently used floors are deleted past it"),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarAnalyticsFlushInterval(
+    TEXT("tower.Analytics.FlushInterval"),
+    5.0f,
+    TEXT("Seconds between sends of buffered damage analytics to the Rust core (floor clears also flush).\n")
+    TEXT("0 = send every hit immediately"),
+    ECVF_Default);
 
 void UTowerGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+    TOWER_STARTUP_SCOPE(TowerGameSubsystem);
     Super::Initialize(Collection);
 
     Bridge = MakeUnique<FProceduralCoreBridge>();
 
-    FString DllPath = FindDllPath();
-    if (Bridge->Initialize(DllPath))
+    // Loading the DLL and resolving every export is most of this subsystem's startup;
+    // nothing else touches the bridge until FinishBoot has joined the worker
+    FProceduralCoreBridge* BridgePtr = Bridge.Get();
+    TWeakObjectPtr<UTowerGameSubsystem> WeakThis(this);
+    BootTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, BridgePtr, WeakThis]()
+    {
+        bool bLoaded = false;
+        {
+            TOWER_STARTUP_SCOPE(RustCoreLoad);
+            const FString DllPath = FindDllPath();
+            bLoaded = BridgePtr->Initialize(DllPath);
+            if (!bLoaded)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Failed to initialize Tower Rust Core from: %s"), *DllPath);
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+        {
+            if (UTowerGameSubsystem* This = WeakThis.Get())
+            {
+                This->FinishBoot();
+            }
+        });
+        return bLoaded;
+    });
+
+    LastAnalyticsFlushTime = FPlatformTime::Seconds();
+    AnalyticsFlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UTowerGameSubsystem::TickAnalyticsFlush), 1.0f);
+}
+
+void UTowerGameSubsystem::FinishBoot()
+{
+    check(IsInGameThread());
+    if (bBootFinished.load(std::memory_order_relaxed)) return;
+
+    TOWER_STARTUP_SCOPE(RustCoreFinishBoot);
+    const bool bLoaded = BootTask.GetResult();
+    bBootFinished.store(true, std::memory_order_release);
+    if (bLoaded)
+    {
+        const FString CoreVersion = Bridge->GetVersion();
+        UE_LOG(LogTemp, Log, TEXT("Tower Rust Core initialized. Version: %s"), *CoreVersion);
+
+        if (CVarFloorCache.GetValueOnGameThread() != 0)
+        {
+            FloorCache = MakeUnique<FFloorDiskCache>(
+                FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("FloorCache")),
+                CoreVersion,
+                static_cast<int64>(FMath::Max(CVarFloorCacheMaxMB.GetValueOnGameThread(), 1)) * 1024 * 1024);
+        }
+
+        // Built from the core on the first boot of each core version, mapped after that
+        FProceduralCoreBridge* BridgePtr = Bridge.Get();
+        FTowerItemCatalog::Get().Open(
+            FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ItemCatalog")),
+            CoreVersion,
+            [BridgePtr]() { return BridgePtr->GetItemCatalog(); });
+
+        // Start from the current generations; nothing is cached yet
+        RefreshConfigGenerations();
+        ConfigCaches.Subscribe(ETowerConfigDomain::Monsters,
+            FSimpleDelegate::CreateUObject(this, &UTowerGameSubsystem::InvalidateMonsterCaches));
+    }
+
+    TArray<FSimpleDelegate> Callbacks = MoveTemp(BootCallbacks);
+    for (FSimpleDelegate& Callback : Callbacks)
     {
-        UE_LOG(LogTemp, Log, TEXT("Tower Rust Core initialized. Version: %s"),
-            *Bridge->GetVersion());
+        Callback.ExecuteIfBound();
     }
-    else
+}
+
+void UTowerGameSubsystem::WhenRustCoreBooted(FSimpleDelegate Callback)
+{
+    check(IsInGameThread());
+    if (bBootFinished.load(std::memory_order_relaxed))
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to initialize Tower Rust Core from: %s"), *DllPath);
+        Callback.ExecuteIfBound();
+        return;
     }
+    BootCallbacks.Add(MoveTemp(Callback));
 }
 
 void UTowerGameSubsystem::Deinitialize()
 {
+    // Shutting down before the boot worker is done: join it so Shutdown can't overlap Initialize
+    BootCallbacks.Empty();
+    FinishBoot();
+
+    FTSTicker::GetCoreTicker().RemoveTicker(AnalyticsFlushHandle);
+    FlushAnalytics();
+
+    // Workers call into the DLL; let them finish before it is unloaded
+    UE::Tasks::Wait(GenerationTasks);
+    GenerationTasks.Empty();
+    PrefetchedFloors.Empty();
+    FloorCache.Reset();
+    FTowerItemCatalog::Get().Close();
+
     if (Bridge)
     {
         Bridge->Shutdown();
@@ -31,9 +144,29 @@ void UTowerGameSubsystem::Deinitialize()
     Super::Deinitialize();
 }
 
+FProceduralCoreBridge* UTowerGameSubsystem::GetBridge() const
+{
+    if (!bBootFinished.load(std::memory_order_acquire))
+    {
+        // Needed before the boot worker reported back: wait for it here. Finishing
+        // initialization doesn't change what the subsystem is, hence the cast.
+        if (IsInGameThread())
+        {
+            const_cast<UTowerGameSubsystem*>(this)->FinishBoot();
+        }
+        else
+        {
+            // The bridge is bound once the worker is done; the game thread half can come later
+            BootTask.Wait();
+        }
+    }
+    return Bridge.Get();
+}
+
 bool UTowerGameSubsystem::IsRustCoreReady() const
 {
-    return Bridge.IsValid() && Bridge->IsInitialized();
+    FProceduralCoreBridge* ReadyBridge = GetBridge();
+    return ReadyBridge && ReadyBridge->IsInitialized();
 }
 
 FString UTowerGameSubsystem::FindDllPath() const
@@ -71,6 +204,193 @@ FString UTowerGameSubsystem::RequestFloorLayout(int64 Seed, int32 FloorId)
     return Bridge->GenerateFloorLayout(static_cast<uint64>(Seed), static_cast<uint32>(FloorId));
 }
 
+bool UTowerGameSubsystem::RequestFloorLayoutData(int64 Seed, int32 FloorId, FFloorLayoutData& OutLayout)
+{
+    LLM_SCOPE_BYTAG(Tower_Floor);
+    if (!IsRustCoreReady()) return false;
+    return Bridge->GenerateFloorLayoutData(static_cast<uint64>(Seed), static_cast<uint32>(FloorId), OutLayout);
+}
+
+bool UTowerGameSubsystem::GenerateFloorData(int64 Seed, int32 FloorId, int32 MonsterCount, FGeneratedFloorData& OutFloor)
+{
+    LLM_SCOPE_BYTAG(Tower_Floor);
+    if (!IsRustCoreReady()) return false;
+
+    FFloorGenerationRequest Request;
+    Request.Seed = Seed;
+    Request.FloorId = FloorId;
+    Request.MonsterCount = MonsterCount;
+    RunFloorGeneration(*Bridge, FloorCache.Get(), Request);
+
+    OutFloor = MoveTemp(Request.Result);
+    return OutFloor.bSucceeded;
+}
+
+FFloorGenerationRequestRef UTowerGameSubsystem::RequestFloorAsync(int64 Seed, int32 FloorId, int32 MonsterCount,
+    FOnFloorGenerated OnComplete)
+{
+    check(IsInGameThread());
+
+    FFloorGenerationRequestRef Request = MakeShared<FFloorGenerationRequest, ESPMode::ThreadSafe>();
+    Request->Seed = Seed;
+    Request->FloorId = FloorId;
+    Request->MonsterCount = MonsterCount;
+
+    if (!IsRustCoreReady())
+    {
+        Request->Progress.store(1.0f, std::memory_order_relaxed);
+        Request->bComplete.store(true, std::memory_order_release);
+        OnComplete.ExecuteIfBound(Request->Result);
+        return Request;
+    }
+
+    GenerationTasks.RemoveAll([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+    FProceduralCoreBridge* BridgePtr = Bridge.Get();
+    FFloorDiskCache* CachePtr = FloorCache.Get();
+    TWeakObjectPtr<UTowerGameSubsystem> WeakThis(this);
+    GenerationTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [BridgePtr, CachePtr, Request, WeakThis, OnComplete = MoveTemp(OnComplete)]() mutable
+        {
+            RunFloorGeneration(*BridgePtr, CachePtr, *Request);
+
+            AsyncTask(ENamedThreads::GameThread, [Request, WeakThis, OnComplete = MoveTemp(OnComplete)]()
+            {
+                if (WeakThis.IsValid())
+                {
+                    OnComplete.ExecuteIfBound(Request->Result);
+                }
+            });
+        }));
+
+    return Request;
+}
+
+void UTowerGameSubsystem::RequestLootAsync(TArray<FLootBatchSource> Sources, TArray<FString> TagSetsJson,
+    FOnLootGenerated OnComplete)
+{
+    check(IsInGameThread());
+
+    if (!IsRustCoreReady() || Sources.Num() == 0)
+    {
+        OnComplete.ExecuteIfBound(TArray<FLootDropData>());
+        return;
+    }
+
+    GenerationTasks.RemoveAll([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+    // Loot generation is in the bridge's pure group, so any number of these may run at once
+    FProceduralCoreBridge* BridgePtr = Bridge.Get();
+    TWeakObjectPtr<UTowerGameSubsystem> WeakThis(this);
+    GenerationTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [BridgePtr, WeakThis, Sources = MoveTemp(Sources), TagSetsJson = MoveTemp(TagSetsJson),
+         OnComplete = MoveTemp(OnComplete)]() mutable
+        {
+            TArray<FLootDropData> Drops;
+            BridgePtr->GenerateLootBatch(Sources, TagSetsJson, Drops);
+
+            AsyncTask(ENamedThreads::GameThread,
+                [WeakThis, Drops = MoveTemp(Drops), OnComplete = MoveTemp(OnComplete)]()
+                {
+                    if (WeakThis.IsValid())
+                    {
+                        OnComplete.ExecuteIfBound(Drops);
+                    }
+                });
+        }));
+}
+
+void UTowerGameSubsystem::PrefetchFloor(int64 Seed, int32 FloorId, int32 MonsterCount)
+{
+    if (FloorId < 1 || !IsRustCoreReady()) return;
+
+    if (const FFloorGenerationRequestRef* Existing = PrefetchedFloors.Find(FloorId))
+    {
+        const FFloorGenerationRequest& Request = **Existing;
+        const bool bFailed = Request.IsComplete() && !Request.GetResult().bSucceeded;
+        if (Request.GetSeed() == Seed && Request.GetMonsterCount() == MonsterCount && !bFailed)
+        {
+            return;
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("Prefetching floor %d"), FloorId);
+    PrefetchedFloors.Add(FloorId, RequestFloorAsync(Seed, FloorId, MonsterCount));
+}
+
+TSharedPtr<FFloorGenerationRequest, ESPMode::ThreadSafe> UTowerGameSubsystem::TakePrefetchedFloor(
+    int64 Seed, int32 FloorId, int32 MonsterCount)
+{
+    TSharedPtr<FFloorGenerationRequest, ESPMode::ThreadSafe> Request;
+    if (FFloorGenerationRequestRef* Found = PrefetchedFloors.Find(FloorId))
+    {
+        Request = *Found;
+        PrefetchedFloors.Remove(FloorId);
+    }
+
+    if (!Request.IsValid() || Request->GetSeed() != Seed || Request->GetMonsterCount() != MonsterCount)
+    {
+        return nullptr;
+    }
+    if (Request->IsComplete() && !Request->GetResult().bSucceeded)
+    {
+        return nullptr;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Floor %d served from prefetch (%s)"), FloorId,
+        Request->IsComplete() ? TEXT("ready") : TEXT("still generating"));
+    return Request;
+}
+
+void UTowerGameSubsystem::TrimPrefetchedFloors(int32 CenterFloor, int32 Radius)
+{
+    // Generating entries are dropped too; their worker finishes and frees the result
+    for (auto It = PrefetchedFloors.CreateIterator(); It; ++It)
+    {
+        if (FMath::Abs(It.Key() - CenterFloor) > Radius)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void UTowerGameSubsystem::RunFloorGeneration(FProceduralCoreBridge& InBridge, FFloorDiskCache* Cache, FFloorGenerationRequest& Request)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_Generation);
+    FGeneratedFloorData& Result = Request.Result;
+    Result.Seed = Request.Seed;
+    Result.FloorId = Request.FloorId;
+
+    const uint64 Seed = static_cast<uint64>(Request.Seed);
+    const uint32 FloorId = static_cast<uint32>(Request.FloorId);
+
+    // Hash 0 means the DLL lacks get_floor_hash; don't key a cache on it
+    const uint64 FloorHash = Cache ? InBridge.GetFloorHash(Seed, FloorId) : 0;
+    if (FloorHash != 0 && Cache->Load(FloorHash, Request.MonsterCount, Result))
+    {
+        Request.Progress.store(1.0f, std::memory_order_relaxed);
+        Request.bComplete.store(true, std::memory_order_release);
+        return;
+    }
+
+    // Layout is the bulk of the work; monsters are a short JSON array
+    const bool bLayout = InBridge.GenerateFloorLayoutData(Seed, FloorId, Result.Layout) && Result.Layout.IsValid();
+    Request.Progress.store(0.7f, std::memory_order_relaxed);
+
+    if (bLayout && Request.MonsterCount > 0)
+    {
+        InBridge.GenerateFloorMonsterData(Seed, FloorId, static_cast<uint32>(Request.MonsterCount), Result.Monsters);
+    }
+
+    Result.bSucceeded = bLayout;
+    if (bLayout && FloorHash != 0)
+    {
+        Cache->Store(FloorHash, Request.MonsterCount, Result);
+    }
+    Request.Progress.store(1.0f, std::memory_order_relaxed);
+    Request.bComplete.store(true, std::memory_order_release);
+}
+
 FString UTowerGameSubsystem::RequestFloorMonsters(int64 Seed, int32 FloorId, int32 Count)
 {
     if (!IsRustCoreReady()) return FString();
@@ -90,16 +410,54 @@ float UTowerGameSubsystem::CalculateDamage(float BaseDamage, int32 AngleId, int3
 
 float UTowerGameSubsystem::GetSemanticSimilarity(const FString& TagsA, const FString& TagsB)
 {
+    // Copy: the second Find may rehash the cache
+    const FSemanticTagVector A = SemanticTags.Find(TagsA);
+    const FSemanticTagVector& B = SemanticTags.Find(TagsB);
+    if (A.bInterned && B.bInterned)
+    {
+        return FSemanticTagCache::Similarity(A, B);
+    }
+
+    // More distinct tags than vector dimensions
     if (!IsRustCoreReady()) return 0.0f;
     return Bridge->SemanticSimilarity(TagsA, TagsB);
 }
 
+TArray<float> UTowerGameSubsystem::ScoreSemanticSimilarity(const FString& QueryTags, const TArray<FString>& CandidateTags)
+{
+    TArray<float> Scores;
+
+    FSemanticTagBatch Batch;
+    if (SemanticTags.BuildBatch(CandidateTags, Batch))
+    {
+        const FSemanticTagVector& Query = SemanticTags.Find(QueryTags);
+        if (Query.bInterned)
+        {
+            FSemanticTagCache::Score(Query, Batch, Scores);
+            return Scores;
+        }
+    }
+
+    Scores.Reserve(CandidateTags.Num());
+    for (const FString& Candidate : CandidateTags)
+    {
+        Scores.Add(GetSemanticSimilarity(QueryTags, Candidate));
+    }
+    return Scores;
+}
+
 FString UTowerGameSubsystem::GetBreathState(float ElapsedSeconds)
 {
     if (!IsRustCoreReady()) return FString();
     return Bridge->GetBreathState(ElapsedSeconds);
 }
 
+FString UTowerGameSubsystem::GetBreathCycle()
+{
+    if (!IsRustCoreReady()) return FString();
+    return Bridge->GetBreathCycle();
+}
+
 FString UTowerGameSubsystem::GetCoreVersion()
 {
     if (!IsRustCoreReady()) return TEXT("not loaded");
@@ -117,7 +475,38 @@ FString UTowerGameSubsystem::GetHotReloadStatus()
 int32 UTowerGameSubsystem::TriggerConfigReload()
 {
     if (!IsRustCoreReady()) return 0;
-    return static_cast<int32>(Bridge->HotReloadTriggerReload());
+    const uint32 Reloaded = Bridge->HotReloadTriggerReload();
+    if (Reloaded > 0 && !RefreshConfigGenerations())
+    {
+        // No per-domain generations in this DLL; anything may have changed
+        ConfigCaches.InvalidateAll();
+    }
+    if (Reloaded > 0)
+    {
+        OnConfigReloaded.Broadcast();
+    }
+    return static_cast<int32>(Reloaded);
+}
+
+bool UTowerGameSubsystem::RefreshConfigGenerations()
+{
+    uint64 Generations[TowerConfigDomainCount];
+    if (!Bridge->HotReloadGetDomainGenerations(Generations))
+    {
+        return false;
+    }
+    ConfigCaches.Update(Generations);
+    return true;
+}
+
+void UTowerGameSubsystem::InvalidateMonsterCaches()
+{
+    // In-flight workers keep their own reference; only the results are forgotten
+    PrefetchedFloors.Empty();
+    if (FloorCache)
+    {
+        FloorCache->Clear();
+    }
 }
 
 // ============ Analytics (v0.6.0) ============
@@ -125,11 +514,41 @@ int32 UTowerGameSubsystem::TriggerConfigReload()
 FString UTowerGameSubsystem::GetAnalyticsSnapshot()
 {
     if (!IsRustCoreReady()) return TEXT("{}");
+    FlushAnalytics();
     return Bridge->AnalyticsGetSnapshot();
 }
 
+bool UTowerGameSubsystem::GetAnalyticsTotals(FTowerAnalyticsTotals& OutTotals) const
+{
+    OutTotals = FTowerAnalyticsTotals();
+
+    // Never waits for the boot load, unlike IsRustCoreReady
+    if (!bBootFinished.load(std::memory_order_acquire) || !Bridge) return false;
+    const FTowerAnalyticsCounters* Counters = Bridge->GetAnalyticsCounters();
+    if (!Counters) return false;
+
+    auto Read = [](const std::atomic<uint64>& Counter)
+    {
+        return static_cast<int64>(FMath::Min<uint64>(Counter.load(std::memory_order_relaxed), MAX_int64));
+    };
+    OutTotals.DamageHits = Read(Counters->DamageHits);
+    OutTotals.TotalDamageDealt = Read(Counters->TotalDamageDealt);
+    OutTotals.MaxHit = Read(Counters->MaxHit);
+    OutTotals.FloorsCleared = static_cast<int32>(FMath::Min<int64>(Read(Counters->FloorsCleared), MAX_int32));
+    OutTotals.HighestFloor = static_cast<int32>(FMath::Min<int64>(Read(Counters->HighestFloor), MAX_int32));
+    if (OutTotals.FloorsCleared > 0)
+    {
+        OutTotals.AverageFloorClearTime = static_cast<float>(
+            Read(Counters->FloorClearMillis) / 1000.0 / OutTotals.FloorsCleared);
+    }
+    OutTotals.GoldEarned = Read(Counters->GoldEarned);
+    OutTotals.GoldSpent = Read(Counters->GoldSpent);
+    return true;
+}
+
 void UTowerGameSubsystem::ResetAnalytics()
 {
+    AnalyticsBuffer.Reset();
     if (IsRustCoreReady())
     {
         Bridge->AnalyticsReset();
@@ -138,14 +557,52 @@ void UTowerGameSubsystem::ResetAnalytics()
 
 void UTowerGameSubsystem::RecordDamageDealt(const FString& WeaponName, int32 Amount)
 {
-    if (IsRustCoreReady())
+    if (!IsRustCoreReady()) return;
+
+    if (CVarAnalyticsFlushInterval.GetValueOnAnyThread() <= 0.0f)
     {
         Bridge->AnalyticsRecordDamage(WeaponName, static_cast<uint32>(Amount));
+        return;
+    }
+    AnalyticsBuffer.RecordDamage(FName(*WeaponName), CurrentFloor, static_cast<uint32>(FMath::Max(Amount, 0)));
+}
+
+void UTowerGameSubsystem::FlushAnalytics()
+{
+    LastAnalyticsFlushTime = FPlatformTime::Seconds();
+
+    TArray<FDamageAggregate> Damage;
+    if (!AnalyticsBuffer.TakeDamage(Damage) || !IsRustCoreReady()) return;
+
+    if (Bridge->HasAnalyticsRecordDamageBatch())
+    {
+        Bridge->AnalyticsRecordDamageBatch(FTowerAnalyticsBuffer::ToJson(Damage));
+        return;
+    }
+
+    // Older DLLs: still one call per (weapon, floor) rather than per hit
+    for (const FDamageAggregate& Aggregate : Damage)
+    {
+        Bridge->AnalyticsRecordDamage(Aggregate.Weapon.ToString(),
+            static_cast<uint32>(FMath::Min<uint64>(Aggregate.TotalDamage, MAX_uint32)));
+    }
+}
+
+bool UTowerGameSubsystem::TickAnalyticsFlush(float DeltaTime)
+{
+    const float Interval = CVarAnalyticsFlushInterval.GetValueOnGameThread();
+    if (Interval > 0.0f && FPlatformTime::Seconds() - LastAnalyticsFlushTime >= Interval)
+    {
+        FlushAnalytics();
     }
+    return true;
 }
 
 void UTowerGameSubsystem::RecordFloorCleared(int32 FloorId, int32 Tier, float TimeSecs)
 {
+    // The floor's damage lands before its clear event
+    FlushAnalytics();
+
     if (IsRustCoreReady())
     {
         Bridge->AnalyticsRecordFloorCleared(
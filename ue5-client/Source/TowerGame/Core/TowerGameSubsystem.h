@@ -3,8 +3,81 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Bridge/ProceduralCoreBridge.h"
+#include "Core/FloorDiskCache.h"
+#include "Core/SemanticTagCache.h"
+#include "Core/AnalyticsBuffer.h"
+#include "Core/ConfigCacheRegistry.h"
+#include "Core/FloorDeltaJournal.h"
+#include "Containers/Ticker.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "TowerGameSubsystem.generated.h"
 
+/** Everything needed to build one floor, generated and parsed off the game thread */
+struct FGeneratedFloorData
+{
+    int64 Seed = 0;
+    int32 FloorId = 0;
+    FFloorLayoutData Layout;
+    TArray<FFloorMonsterData> Monsters;
+    bool bSucceeded = false;
+};
+
+/**
+ * Handle to an async floor generation. Progress (0-1) is written by the worker
+ * and readable from any thread; the result may only be read once IsComplete().
+ */
+class FFloorGenerationRequest
+{
+public:
+    int64 GetSeed() const { return Seed; }
+    int32 GetFloorId() const { return FloorId; }
+    int32 GetMonsterCount() const { return MonsterCount; }
+
+    float GetProgress() const { return Progress.load(std::memory_order_relaxed); }
+    bool IsComplete() const { return bComplete.load(std::memory_order_acquire); }
+
+    const FGeneratedFloorData& GetResult() const
+    {
+        check(IsComplete());
+        return Result;
+    }
+
+private:
+    friend class UTowerGameSubsystem;
+
+    int64 Seed = 0;
+    int32 FloorId = 0;
+    int32 MonsterCount = 0;
+    std::atomic<float> Progress{ 0.0f };
+    std::atomic<bool> bComplete{ false };
+    FGeneratedFloorData Result;
+};
+
+using FFloorGenerationRequestRef = TSharedRef<FFloorGenerationRequest, ESPMode::ThreadSafe>;
+
+/** The Rust core's running analytics totals, copied out of its counter block (see GetAnalyticsTotals) */
+USTRUCT(BlueprintType)
+struct FTowerAnalyticsTotals
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly) int64 DamageHits = 0;
+    UPROPERTY(BlueprintReadOnly) int64 TotalDamageDealt = 0;
+    UPROPERTY(BlueprintReadOnly) int64 MaxHit = 0;
+    UPROPERTY(BlueprintReadOnly) int32 FloorsCleared = 0;
+    UPROPERTY(BlueprintReadOnly) int32 HighestFloor = 0;
+    UPROPERTY(BlueprintReadOnly) float AverageFloorClearTime = 0.0f;
+    UPROPERTY(BlueprintReadOnly) int64 GoldEarned = 0;
+    UPROPERTY(BlueprintReadOnly) int64 GoldSpent = 0;
+};
+
+/** Game thread callback for RequestFloorAsync */
+DECLARE_DELEGATE_OneParam(FOnFloorGenerated, const FGeneratedFloorData&);
+
+/** Game thread callback for RequestLootAsync; drops are in source order */
+DECLARE_DELEGATE_OneParam(FOnLootGenerated, const TArray<FLootDropData>&);
+
 /**
  * Game Instance Subsystem — owns the Rust DLL bridge.
  * Lives for the entire game session. All gameplay code accesses Rust
@@ -19,18 +92,74 @@ public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
     virtual void Deinitialize() override;
 
-    /** Get the Rust bridge (null if DLL failed to load) */
-    FProceduralCoreBridge* GetBridge() const { return Bridge.Get(); }
+    /**
+     * Get the Rust bridge (unusable if the DLL failed to load; check IsRustCoreReady). Waits for
+     * the boot load if it hasn't finished; see the bridge header for which calls are safe off
+     * the game thread.
+     */
+    FProceduralCoreBridge* GetBridge() const;
 
-    /** Is the Rust core loaded and ready? */
+    /** Is the Rust core loaded and ready? Waits for the boot load like GetBridge. */
     bool IsRustCoreReady() const;
 
+    /** Run Callback on the game thread once the boot load has finished, loaded or not (now, if it has) */
+    void WhenRustCoreBooted(FSimpleDelegate Callback);
+
     // ============ High-Level API ============
 
     /** Generate floor layout JSON for a given seed and floor number */
     UFUNCTION(BlueprintCallable, Category = "Tower|Generation")
     FString RequestFloorLayout(int64 Seed, int32 FloorId);
 
+    /** Generate a floor layout as packed tiles + room table (no JSON); false if unavailable */
+    bool RequestFloorLayoutData(int64 Seed, int32 FloorId, FFloorLayoutData& OutLayout);
+
+    /** Generate layout and monsters on the calling thread (blocks for the whole FFI + parse) */
+    bool GenerateFloorData(int64 Seed, int32 FloorId, int32 MonsterCount, FGeneratedFloorData& OutFloor);
+
+    /**
+     * Generate layout and monsters on a worker task. Poll the returned handle for
+     * progress; OnComplete runs on the game thread once the result is ready (not at
+     * all if the subsystem is deinitialized first, which waits for the worker).
+     */
+    FFloorGenerationRequestRef RequestFloorAsync(int64 Seed, int32 FloorId, int32 MonsterCount,
+        FOnFloorGenerated OnComplete = FOnFloorGenerated());
+
+    /**
+     * Generate the drops of many sources (a pack dying together) on a worker task;
+     * OnComplete runs on the game thread, with the same lifetime rules as RequestFloorAsync.
+     */
+    void RequestLootAsync(TArray<FLootBatchSource> Sources, TArray<FString> TagSetsJson, FOnLootGenerated OnComplete);
+
+    // ============ Prefetch ============
+
+    /**
+     * Start generating a floor in the background and keep the result, so a later
+     * transition to it finds it ready (floors are deterministic from the seed).
+     * No-op if that floor is already prefetched or generating.
+     */
+    void PrefetchFloor(int64 Seed, int32 FloorId, int32 MonsterCount);
+
+    /**
+     * Hand over a prefetched floor, finished or still generating, and forget it.
+     * Null if there is none for these arguments or its generation failed.
+     */
+    TSharedPtr<FFloorGenerationRequest, ESPMode::ThreadSafe> TakePrefetchedFloor(int64 Seed, int32 FloorId, int32 MonsterCount);
+
+    /** Drop prefetched floors more than Radius floors away from CenterFloor */
+    void TrimPrefetchedFloors(int32 CenterFloor, int32 Radius);
+
+    int32 GetPrefetchedFloorCount() const { return PrefetchedFloors.Num(); }
+
+    /** Persistent floor cache under Saved/FloorCache (null if disabled via tower.FloorCache) */
+    FFloorDiskCache* GetFloorCache() const { return FloorCache.Get(); }
+
+    /** Subscribe client caches here to be invalidated when their config domain is hot-reloaded */
+    FTowerConfigCacheRegistry& GetConfigCaches() { return ConfigCaches; }
+
+    /** What players changed on each visited floor this session, replayed when the floor is rebuilt */
+    FTowerFloorDeltaJournal& GetDeltaJournal() { return DeltaJournal; }
+
     /** Generate monsters for current floor */
     UFUNCTION(BlueprintCallable, Category = "Tower|Monster")
     FString RequestFloorMonsters(int64 Seed, int32 FloorId, int32 Count);
@@ -39,14 +168,23 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Tower|Combat")
     float CalculateDamage(float BaseDamage, int32 AngleId, int32 ComboStep);
 
-    /** Get semantic similarity between two tag sets */
+    /** Get semantic similarity between two tag sets (computed locally from cached tag vectors) */
     UFUNCTION(BlueprintCallable, Category = "Tower|Semantic")
     float GetSemanticSimilarity(const FString& TagsA, const FString& TagsB);
 
+    /** Similarity of one tag set against many, e.g. ranking loot or crafting candidates */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Semantic")
+    TArray<float> ScoreSemanticSimilarity(const FString& QueryTags, const TArray<FString>& CandidateTags);
+
+    FSemanticTagCache& GetSemanticTagCache() { return SemanticTags; }
+
     /** Get current Breath of Tower state */
     UFUNCTION(BlueprintCallable, Category = "Tower|World")
     FString GetBreathState(float ElapsedSeconds);
 
+    /** Breath cycle definition to evaluate locally (see FTowerBreathCycle) */
+    FString GetBreathCycle();
+
     /** Get Rust core version */
     UFUNCTION(BlueprintCallable, Category = "Tower|Core")
     FString GetCoreVersion();
@@ -57,25 +195,43 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Tower|HotReload")
     FString GetHotReloadStatus();
 
-    /** Trigger manual config reload (returns 1 on success, 0 on failure) */
+    /** Trigger manual config reload (returns 1 on success, 0 on failure); invalidates the caches of changed domains */
     UFUNCTION(BlueprintCallable, Category = "Tower|HotReload")
     int32 TriggerConfigReload();
 
+    /** A reload succeeded; for state derived from config outside the cache domains */
+    FSimpleMulticastDelegate OnConfigReloaded;
+
     // ============ Analytics (v0.6.0) ============
 
-    /** Get analytics snapshot (combat stats, progression, economy, etc.) */
+    /** Get analytics snapshot (combat stats, progression, economy, etc.) as JSON, for export */
     UFUNCTION(BlueprintCallable, Category = "Tower|Analytics")
     FString GetAnalyticsSnapshot();
 
+    /**
+     * The running totals, read straight from the core's counter block: no FFI call, no JSON
+     * and no flush, so overlays can call it every frame from any thread. Buffered damage shows
+     * once flushed. False (and zeroes) until the core has booted, or if its DLL has no block.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Analytics")
+    bool GetAnalyticsTotals(FTowerAnalyticsTotals& OutTotals) const;
+
     /** Reset all analytics counters */
     UFUNCTION(BlueprintCallable, Category = "Tower|Analytics")
     void ResetAnalytics();
 
-    /** Record damage dealt for balancing */
+    /**
+     * Record damage dealt for balancing; any thread. Buffered per (weapon, CurrentFloor) and sent
+     * to Rust every tower.Analytics.FlushInterval seconds, on floor clear and on snapshot.
+     */
     UFUNCTION(BlueprintCallable, Category = "Tower|Analytics")
     void RecordDamageDealt(const FString& WeaponName, int32 Amount);
 
-    /** Record floor cleared for progression tracking */
+    /** Send buffered damage to Rust now */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Analytics")
+    void FlushAnalytics();
+
+    /** Record floor cleared for progression tracking (flushes buffered damage first) */
     UFUNCTION(BlueprintCallable, Category = "Tower|Analytics")
     void RecordFloorCleared(int32 FloorId, int32 Tier, float TimeSecs);
 
@@ -108,5 +264,51 @@ public:
 private:
     TUniquePtr<FProceduralCoreBridge> Bridge;
 
+    /**
+     * tower_core.dll is found, loaded and bound on a worker launched by Initialize, so the
+     * rest of startup doesn't wait on it. FinishBoot joins it on the game thread, either
+     * when it completes or when something needs the core first, whichever comes first.
+     */
+    UE::Tasks::TTask<bool> BootTask;
+    std::atomic<bool> bBootFinished{ false };
+    TArray<FSimpleDelegate> BootCallbacks;
+
+    void FinishBoot();
+
+    /** In-flight RequestFloorAsync / RequestLootAsync workers; waited on before the bridge shuts down */
+    TArray<UE::Tasks::FTask> GenerationTasks;
+
+    /** Tag vectors of every tag string scored so far (game thread) */
+    FSemanticTagCache SemanticTags;
+
+    /** PrefetchFloor results by floor id (seed and monster count are checked on take) */
+    TMap<int32, FFloorGenerationRequestRef> PrefetchedFloors;
+
+    /** Generated floors from previous sessions; shared with the workers, reset after they finish */
+    TUniquePtr<FFloorDiskCache> FloorCache;
+
+    FTowerConfigCacheRegistry ConfigCaches;
+
+    FTowerFloorDeltaJournal DeltaJournal;
+
+    /** Generated floors embed monsters, so a monster config change makes them stale */
+    void InvalidateMonsterCaches();
+
+    /** Feed the bridge's domain generations to ConfigCaches; false if the DLL has none */
+    bool RefreshConfigGenerations();
+
+    /** Damage recorded since the last FlushAnalytics() */
+    FTowerAnalyticsBuffer AnalyticsBuffer;
+    FTSTicker::FDelegateHandle AnalyticsFlushHandle;
+    double LastAnalyticsFlushTime = 0.0;
+
+    bool TickAnalyticsFlush(float DeltaTime);
+
+    /**
+     * Worker body of GenerateFloorData / RequestFloorAsync; only touches the thread-safe
+     * part of the bridge. Reads through Cache first and stores new floors in it.
+     */
+    static void RunFloorGeneration(FProceduralCoreBridge& InBridge, FFloorDiskCache* Cache, FFloorGenerationRequest& Request);
+
     FString FindDllPath() const;
 };
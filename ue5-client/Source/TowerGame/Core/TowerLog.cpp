@@ -0,0 +1,548 @@
+#include "TowerLog.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/OutputDeviceRedirector.h"
+#include "Misc/Paths.h"
+
+static_assert(static_cast<int32>(ETowerLogCategory::MAX) == 6, "Add the new category's default level, limits and name");
+
+std::atomic<uint8> FTowerLog::MinLevel[static_cast<int32>(ETowerLogCategory::MAX)] =
+{
+    static_cast<uint8>(ETowerLogLevel::Info),
+    static_cast<uint8>(ETowerLogLevel::Info),
+    static_cast<uint8>(ETowerLogLevel::Info),
+    static_cast<uint8>(ETowerLogLevel::Info),
+    static_cast<uint8>(ETowerLogLevel::Info),
+    static_cast<uint8>(ETowerLogLevel::Info),
+};
+
+namespace
+{
+    constexpr int32 NumCategories = static_cast<int32>(ETowerLogCategory::MAX);
+
+    /** Power of two; ~400 bytes a slot */
+    constexpr uint64 RingSize = 1024;
+    constexpr uint64 RingMask = RingSize - 1;
+
+    /** How often the writer wakes on its own; producers also wake it once the ring is half full */
+    constexpr uint32 WriterIntervalMs = 10;
+
+    struct FCategoryDefaults
+    {
+        const TCHAR* Name;
+        int32 PerSecond;
+        int32 SampleEvery;
+    };
+
+    const FCategoryDefaults CategoryDefaults[NumCategories] =
+    {
+        { TEXT("Replication"), 30, 1 },
+        { TEXT("Protobuf"), 30, 1 },
+        { TEXT("StateSync"), 30, 1 },
+        { TEXT("Floor"), 60, 1 },
+        { TEXT("FFI"), 60, 1 },
+        { TEXT("UI"), 30, 1 },
+    };
+
+    struct FCategoryState
+    {
+        std::atomic<int32> PerSecond{ 0 };
+        std::atomic<int32> SampleEvery{ 1 };
+
+        // Rate limit window: whole seconds of FPlatformTime::Seconds()
+        std::atomic<int64> WindowSecond{ 0 };
+        std::atomic<int32> WindowCount{ 0 };
+        std::atomic<int32> WindowSuppressed{ 0 };
+        std::atomic<uint32> SampleCounter{ 0 };
+
+        std::atomic<uint64> Written{ 0 };
+        std::atomic<uint64> Suppressed{ 0 };
+        std::atomic<uint64> SampledOut{ 0 };
+    };
+
+    struct FSlot
+    {
+        /** Vyukov bounded queue: == position when free for it, position + 1 once written */
+        std::atomic<uint64> Sequence;
+        FTowerLogRecord Record;
+    };
+
+    class FTowerLogWriter : public FRunnable
+    {
+    public:
+        virtual uint32 Run() override;
+        virtual void Stop() override { bStopRequested = true; }
+
+        std::atomic<bool> bStopRequested{ false };
+    };
+
+    struct FTowerLogState
+    {
+        FTowerLogState()
+        {
+            for (uint64 Index = 0; Index < RingSize; Index++)
+            {
+                Ring[Index].Sequence.store(Index, std::memory_order_relaxed);
+            }
+            for (int32 Index = 0; Index < NumCategories; Index++)
+            {
+                Categories[Index].PerSecond.store(CategoryDefaults[Index].PerSecond, std::memory_order_relaxed);
+                Categories[Index].SampleEvery.store(CategoryDefaults[Index].SampleEvery, std::memory_order_relaxed);
+            }
+        }
+
+        FSlot Ring[RingSize];
+        std::atomic<uint64> EnqueuePos{ 0 };
+        std::atomic<uint64> DequeuePos{ 0 };
+        std::atomic<uint64> Dropped{ 0 };
+
+        FCategoryState Categories[NumCategories];
+
+        // Output format, from the logging config
+        std::atomic<bool> bShowTimestamps{ true };
+        std::atomic<bool> bShowThreadIds{ false };
+        std::atomic<bool> bShowTargets{ true };
+        std::atomic<bool> bShowFileLine{ false };
+
+        /** LogTower<Category>, and LogTower for when targets are hidden */
+        FName CategoryNames[NumCategories];
+        FName UntargetedName;
+
+        /** Held by whoever is draining the ring: the writer thread or a Flush */
+        FCriticalSection DrainLock;
+        FString LineScratch;
+
+        FTowerLogWriter Writer;
+        FRunnableThread* WriterThread = nullptr;
+        FEvent* WakeEvent = nullptr;
+    };
+
+    FTowerLogState& GetState()
+    {
+        static FTowerLogState State;
+        return State;
+    }
+
+    ELogVerbosity::Type GetVerbosity(ETowerLogLevel Level)
+    {
+        switch (Level)
+        {
+        case ETowerLogLevel::Trace: return ELogVerbosity::VeryVerbose;
+        case ETowerLogLevel::Debug: return ELogVerbosity::Verbose;
+        case ETowerLogLevel::Warn:  return ELogVerbosity::Warning;
+        case ETowerLogLevel::Error: return ELogVerbosity::Error;
+        default:                    return ELogVerbosity::Log;
+        }
+    }
+
+    void AppendValue(FString& Out, const FTowerLogRecord& Record, const FTowerLogRecord::FField& Field)
+    {
+        using EFieldType = FTowerLogRecord::EFieldType;
+        switch (Field.Type)
+        {
+        case EFieldType::Int:       Out.Appendf(TEXT("%lld"), Field.Int); break;
+        case EFieldType::UInt:      Out.Appendf(TEXT("%llu"), Field.UInt); break;
+        case EFieldType::Double:    Out.Appendf(TEXT("%g"), Field.Double); break;
+        case EFieldType::Bool:      Out += Field.Bool ? TEXT("true") : TEXT("false"); break;
+        case EFieldType::Vector:
+            Out.Appendf(TEXT("(%.1f,%.1f,%.1f)"), Field.Vector[0], Field.Vector[1], Field.Vector[2]);
+            break;
+        case EFieldType::String:
+        {
+            const FStringView Value(Record.Text + Field.Str.Offset, Field.Str.Len);
+            int32 Unused;
+            const bool bQuote = Value.IsEmpty() || Value.FindChar(TEXT(' '), Unused) || Value.FindChar(TEXT('='), Unused);
+            if (bQuote) Out += TEXT('"');
+            Out += Value;
+            if (bQuote) Out += TEXT('"');
+            break;
+        }
+        }
+    }
+
+    /** "[time] [tid] Event Key=Value ... (File:Line)" to the engine log */
+    void WriteRecord(FTowerLogState& State, const FTowerLogRecord& Record)
+    {
+        FString& Line = State.LineScratch;
+        Line.Reset();
+
+        // The engine's own timestamp is when the writer got to it, not when it happened
+        if (State.bShowTimestamps.load(std::memory_order_relaxed))
+        {
+            Line.Appendf(TEXT("[%.3f] "), Record.Time - GStartTime);
+        }
+        if (State.bShowThreadIds.load(std::memory_order_relaxed))
+        {
+            Line.Appendf(TEXT("[tid %u] "), Record.ThreadId);
+        }
+        Line += Record.Event;
+        for (int32 Index = 0; Index < Record.NumFields; Index++)
+        {
+            Line += TEXT(' ');
+            Line += Record.Fields[Index].Key;
+            Line += TEXT('=');
+            AppendValue(Line, Record, Record.Fields[Index]);
+        }
+        if (State.bShowFileLine.load(std::memory_order_relaxed) && Record.File)
+        {
+            Line.Appendf(TEXT(" (%s:%d)"), *FPaths::GetCleanFilename(FString(Record.File)), Record.Line);
+        }
+
+        const int32 Category = static_cast<int32>(Record.Category);
+        const FName& Name = State.bShowTargets.load(std::memory_order_relaxed) && !State.CategoryNames[Category].IsNone()
+            ? State.CategoryNames[Category] : State.UntargetedName;
+        GLog->Serialize(*Line, GetVerbosity(Record.Level), Name.IsNone() ? FName(TEXT("LogTower")) : Name);
+    }
+
+    /** Single consumer, under DrainLock */
+    void DrainRing(FTowerLogState& State)
+    {
+        uint64 Pos = State.DequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FSlot& Slot = State.Ring[Pos & RingMask];
+            if (Slot.Sequence.load(std::memory_order_acquire) != Pos + 1)
+            {
+                break;
+            }
+            WriteRecord(State, Slot.Record);
+            Slot.Sequence.store(Pos + RingSize, std::memory_order_release);
+            Pos++;
+            State.DequeuePos.store(Pos, std::memory_order_relaxed);
+        }
+    }
+
+    uint32 FTowerLogWriter::Run()
+    {
+        FTowerLogState& State = GetState();
+        while (!bStopRequested.load(std::memory_order_relaxed))
+        {
+            {
+                FScopeLock Lock(&State.DrainLock);
+                DrainRing(State);
+            }
+            State.WakeEvent->Wait(WriterIntervalMs);
+        }
+        return 0;
+    }
+
+    /** Claim a ring slot and fill in the record header; null if the ring is full */
+    FTowerLogRecord* ClaimRecord(FTowerLogState& State, ETowerLogCategory Category, ETowerLogLevel Level,
+        const TCHAR* Event, const ANSICHAR* File, int32 Line, uint64& OutSlot)
+    {
+        uint64 Pos = State.EnqueuePos.load(std::memory_order_relaxed);
+        FSlot* Slot = nullptr;
+        for (;;)
+        {
+            Slot = &State.Ring[Pos & RingMask];
+            const int64 Diff = static_cast<int64>(Slot->Sequence.load(std::memory_order_acquire)) - static_cast<int64>(Pos);
+            if (Diff == 0)
+            {
+                if (State.EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (Diff < 0)
+            {
+                State.Dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            else
+            {
+                Pos = State.EnqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        FTowerLogRecord& Record = Slot->Record;
+        Record.Time = FPlatformTime::Seconds();
+        Record.Event = Event;
+        Record.File = File;
+        Record.Line = Line;
+        Record.ThreadId = FPlatformTLS::GetCurrentThreadId();
+        Record.Category = Category;
+        Record.Level = Level;
+        Record.NumFields = 0;
+        Record.TextUsed = 0;
+        OutSlot = Pos;
+        return &Record;
+    }
+
+    FAutoConsoleCommand FilterCommand(
+        TEXT("tower.Log.Filter"),
+        TEXT("Set client structured-log levels: [default level] [Category[=level] ...], e.g. 'info Replication=debug Protobuf=off'.\n")
+        TEXT("Levels: trace, debug, info, warn, error, off. Same directives as the logging config widget's module filters"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            FTowerLogState& State = GetState();
+            ETowerLogLevel DefaultLevel = ETowerLogLevel::Info;
+            TArray<FString> Directives;
+            for (const FString& Arg : Args)
+            {
+                ETowerLogLevel Level;
+                if (!Arg.Contains(TEXT("=")) && FTowerLog::ParseLevel(Arg, Level))
+                {
+                    DefaultLevel = Level;
+                }
+                else
+                {
+                    Directives.Add(Arg);
+                }
+            }
+            FTowerLog::Configure(DefaultLevel, Directives, State.bShowTimestamps, State.bShowThreadIds,
+                State.bShowTargets, State.bShowFileLine);
+        }));
+
+    FAutoConsoleCommand LimitCommand(
+        TEXT("tower.Log.Limit"),
+        TEXT("tower.Log.Limit <Category> <PerSecond> [SampleEvery]: rate limit a client log category below Error (0 = unlimited)\n")
+        TEXT("and keep 1 in SampleEvery of its Trace / Debug / Info events"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            ETowerLogCategory Category;
+            if (Args.Num() < 2 || !FTowerLog::FindCategory(Args[0], Category))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Usage: tower.Log.Limit <Category> <PerSecond> [SampleEvery]"));
+                return;
+            }
+            const int32 SampleEvery = Args.Num() > 2 ? FCString::Atoi(*Args[2])
+                : GetState().Categories[static_cast<int32>(Category)].SampleEvery.load(std::memory_order_relaxed);
+            FTowerLog::SetLimits(Category, FCString::Atoi(*Args[1]), SampleEvery);
+        }));
+
+    FAutoConsoleCommand StatsCommand(
+        TEXT("tower.Log.Stats"),
+        TEXT("Log each client log category's level, limits and written / suppressed / sampled-out counts"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            FTowerLog::DumpStats(*GLog);
+        }));
+}
+
+FTowerLogRecord* FTowerLog::BeginRecord(ETowerLogCategory Category, ETowerLogLevel Level, const TCHAR* Event,
+    const ANSICHAR* File, int32 Line, uint64& OutSlot)
+{
+    FTowerLogState& State = GetState();
+    FCategoryState& Cat = State.Categories[static_cast<int32>(Category)];
+
+    if (Level < ETowerLogLevel::Warn)
+    {
+        const int32 SampleEvery = Cat.SampleEvery.load(std::memory_order_relaxed);
+        if (SampleEvery > 1 && Cat.SampleCounter.fetch_add(1, std::memory_order_relaxed) % SampleEvery != 0)
+        {
+            Cat.SampledOut.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    const int32 PerSecond = Cat.PerSecond.load(std::memory_order_relaxed);
+    if (Level < ETowerLogLevel::Error && PerSecond > 0)
+    {
+        const int64 Second = static_cast<int64>(FPlatformTime::Seconds());
+        int64 Window = Cat.WindowSecond.load(std::memory_order_relaxed);
+        if (Window != Second && Cat.WindowSecond.compare_exchange_strong(Window, Second, std::memory_order_relaxed))
+        {
+            // First event of a new second: say what the last one swallowed
+            Cat.WindowCount.store(0, std::memory_order_relaxed);
+            const int32 Suppressed = Cat.WindowSuppressed.exchange(0, std::memory_order_relaxed);
+            uint64 SummarySlot = 0;
+            if (Suppressed > 0)
+            {
+                if (FTowerLogRecord* Summary = ClaimRecord(State, Category, ETowerLogLevel::Warn, TEXT("RateLimited"), File, Line, SummarySlot))
+                {
+                    Summary->AddFields(TEXT("Suppressed"), Suppressed, TEXT("PerSecond"), PerSecond);
+                    CommitRecord(SummarySlot);
+                }
+            }
+        }
+        if (Cat.WindowCount.fetch_add(1, std::memory_order_relaxed) >= PerSecond)
+        {
+            Cat.WindowSuppressed.fetch_add(1, std::memory_order_relaxed);
+            Cat.Suppressed.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    FTowerLogRecord* Record = ClaimRecord(State, Category, Level, Event, File, Line, OutSlot);
+    if (Record)
+    {
+        Cat.Written.fetch_add(1, std::memory_order_relaxed);
+    }
+    return Record;
+}
+
+void FTowerLog::CommitRecord(uint64 Slot)
+{
+    FTowerLogState& State = GetState();
+    State.Ring[Slot & RingMask].Sequence.store(Slot + 1, std::memory_order_release);
+
+    if (!State.WriterThread)
+    {
+        // Before Startup / after Shutdown, or no threads on this platform
+        Flush();
+    }
+    else if (Slot - State.DequeuePos.load(std::memory_order_relaxed) >= RingSize / 2)
+    {
+        State.WakeEvent->Trigger();
+    }
+}
+
+void FTowerLog::Startup()
+{
+    FTowerLogState& State = GetState();
+    for (int32 Index = 0; Index < NumCategories; Index++)
+    {
+        State.CategoryNames[Index] = FName(*FString::Printf(TEXT("LogTower%s"), CategoryDefaults[Index].Name));
+    }
+    State.UntargetedName = FName(TEXT("LogTower"));
+
+    if (State.WriterThread || !FPlatformProcess::SupportsMultithreading())
+    {
+        return;
+    }
+    State.Writer.bStopRequested = false;
+    State.WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    State.WriterThread = FRunnableThread::Create(&State.Writer, TEXT("TowerLogWriter"), 0, TPri_BelowNormal);
+    if (!State.WriterThread)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(State.WakeEvent);
+        State.WakeEvent = nullptr;
+    }
+}
+
+void FTowerLog::Shutdown()
+{
+    FTowerLogState& State = GetState();
+    if (FRunnableThread* Thread = State.WriterThread)
+    {
+        State.Writer.Stop();
+        State.WakeEvent->Trigger();
+        Thread->WaitForCompletion();
+        State.WriterThread = nullptr;
+        delete Thread;
+        FPlatformProcess::ReturnSynchEventToPool(State.WakeEvent);
+        State.WakeEvent = nullptr;
+    }
+    Flush();
+}
+
+void FTowerLog::Flush()
+{
+    FTowerLogState& State = GetState();
+    FScopeLock Lock(&State.DrainLock);
+    DrainRing(State);
+}
+
+void FTowerLog::Configure(ETowerLogLevel DefaultLevel, TConstArrayView<FString> Directives,
+    bool bShowTimestamps, bool bShowThreadIds, bool bShowTargets, bool bShowFileLine)
+{
+    uint8 Levels[NumCategories];
+    for (uint8& Level : Levels)
+    {
+        Level = static_cast<uint8>(DefaultLevel);
+    }
+
+    for (const FString& Directive : Directives)
+    {
+        FString Name = Directive.TrimStartAndEnd();
+        FString LevelName;
+        Directive.Split(TEXT("="), &Name, &LevelName);
+        Name.TrimStartAndEndInline();
+        LevelName.TrimStartAndEndInline();
+
+        ETowerLogCategory Category;
+        if (!FindCategory(Name, Category))
+        {
+            continue;   // a Rust target
+        }
+        ETowerLogLevel Level = ETowerLogLevel::Trace;
+        if (!LevelName.IsEmpty() && !ParseLevel(LevelName, Level))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TowerLog: unknown level '%s' in '%s'"), *LevelName, *Directive);
+            continue;
+        }
+        Levels[static_cast<int32>(Category)] = static_cast<uint8>(Level);
+    }
+
+    for (int32 Index = 0; Index < NumCategories; Index++)
+    {
+        MinLevel[Index].store(Levels[Index], std::memory_order_relaxed);
+    }
+
+    FTowerLogState& State = GetState();
+    State.bShowTimestamps = bShowTimestamps;
+    State.bShowThreadIds = bShowThreadIds;
+    State.bShowTargets = bShowTargets;
+    State.bShowFileLine = bShowFileLine;
+}
+
+void FTowerLog::SetLimits(ETowerLogCategory Category, int32 PerSecond, int32 SampleEvery)
+{
+    FCategoryState& Cat = GetState().Categories[static_cast<int32>(Category)];
+    Cat.PerSecond.store(FMath::Max(PerSecond, 0), std::memory_order_relaxed);
+    Cat.SampleEvery.store(FMath::Max(SampleEvery, 1), std::memory_order_relaxed);
+}
+
+const TCHAR* FTowerLog::GetCategoryName(ETowerLogCategory Category)
+{
+    const int32 Index = static_cast<int32>(Category);
+    return Index < NumCategories ? CategoryDefaults[Index].Name : TEXT("Unknown");
+}
+
+bool FTowerLog::FindCategory(FStringView Name, ETowerLogCategory& OutCategory)
+{
+    for (int32 Index = 0; Index < NumCategories; Index++)
+    {
+        if (Name.Equals(CategoryDefaults[Index].Name, ESearchCase::IgnoreCase))
+        {
+            OutCategory = static_cast<ETowerLogCategory>(Index);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FTowerLog::ParseLevel(FStringView Name, ETowerLogLevel& OutLevel)
+{
+    static const TPair<const TCHAR*, ETowerLogLevel> Levels[] =
+    {
+        { TEXT("trace"), ETowerLogLevel::Trace },
+        { TEXT("debug"), ETowerLogLevel::Debug },
+        { TEXT("info"), ETowerLogLevel::Info },
+        { TEXT("warn"), ETowerLogLevel::Warn },
+        { TEXT("warning"), ETowerLogLevel::Warn },
+        { TEXT("error"), ETowerLogLevel::Error },
+        { TEXT("off"), ETowerLogLevel::Off },
+    };
+    for (const TPair<const TCHAR*, ETowerLogLevel>& Level : Levels)
+    {
+        if (Name.Equals(Level.Key, ESearchCase::IgnoreCase))
+        {
+            OutLevel = Level.Value;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FTowerLog::DumpStats(FOutputDevice& Ar)
+{
+    static const TCHAR* LevelNames[] = { TEXT("trace"), TEXT("debug"), TEXT("info"), TEXT("warn"), TEXT("error"), TEXT("off") };
+
+    FTowerLogState& State = GetState();
+    Ar.Logf(TEXT("=== TowerLog (%s, %llu dropped on a full ring) ==="),
+        State.WriterThread ? TEXT("async") : TEXT("inline"), State.Dropped.load(std::memory_order_relaxed));
+    for (int32 Index = 0; Index < NumCategories; Index++)
+    {
+        const FCategoryState& Cat = State.Categories[Index];
+        Ar.Logf(TEXT("  %-12s %-5s %4d/s 1:%-3d written %llu, suppressed %llu, sampled out %llu"),
+            CategoryDefaults[Index].Name, LevelNames[FMath::Min<int32>(MinLevel[Index].load(std::memory_order_relaxed), UE_ARRAY_COUNT(LevelNames) - 1)],
+            Cat.PerSecond.load(std::memory_order_relaxed), Cat.SampleEvery.load(std::memory_order_relaxed),
+            Cat.Written.load(std::memory_order_relaxed), Cat.Suppressed.load(std::memory_order_relaxed),
+            Cat.SampledOut.load(std::memory_order_relaxed));
+    }
+}
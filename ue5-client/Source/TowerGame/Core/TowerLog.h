@@ -0,0 +1,223 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include <type_traits>
+
+/** Severity of a structured log event; same order as the logging config widget's ELogLevel */
+enum class ETowerLogLevel : uint8
+{
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error,
+
+    /** Above every event: the category is off */
+    Off
+};
+
+/** Client structured-log categories; the names are what config directives match */
+enum class ETowerLogCategory : uint8
+{
+    Replication,    // AReplicationManager spawns / updates / interest
+    Protobuf,       // UProtobufBridge chunk decode and validation
+    StateSync,      // UTowerStateSynchronizer
+    Floor,          // Floor generation and rendering
+    FFI,            // Procedural core bridge
+    UI,
+
+    MAX
+};
+
+/**
+ * One event waiting in the ring. Keys and the event name must be string
+ * literals (or otherwise outlive the process); string values are copied into
+ * Text, truncated if they don't fit.
+ */
+struct FTowerLogRecord
+{
+    static constexpr int32 MaxFields = 6;
+    static constexpr int32 MaxText = 96;
+
+    enum class EFieldType : uint8 { Int, UInt, Double, Bool, String, Vector };
+
+    struct FField
+    {
+        const TCHAR* Key;
+        union
+        {
+            int64 Int;
+            uint64 UInt;
+            double Double;
+            bool Bool;
+            float Vector[3];
+            struct { uint8 Offset; uint8 Len; } Str;
+        };
+        EFieldType Type;
+    };
+
+    double Time;
+    const TCHAR* Event;
+    const ANSICHAR* File;
+    int32 Line;
+    uint32 ThreadId;
+    ETowerLogCategory Category;
+    ETowerLogLevel Level;
+    uint8 NumFields;
+    uint8 TextUsed;
+    FField Fields[MaxFields];
+    TCHAR Text[MaxText];
+
+    template <typename T>
+    void Add(const TCHAR* Key, const T& Value)
+    {
+        FField& Field = Fields[NumFields++];
+        Field.Key = Key;
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            Field.Type = EFieldType::Bool;
+            Field.Bool = Value;
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            Field.Type = EFieldType::Double;
+            Field.Double = Value;
+        }
+        else if constexpr (std::is_enum_v<T> || std::is_signed_v<T>)
+        {
+            Field.Type = EFieldType::Int;
+            Field.Int = static_cast<int64>(Value);
+        }
+        else if constexpr (std::is_unsigned_v<T>)
+        {
+            Field.Type = EFieldType::UInt;
+            Field.UInt = static_cast<uint64>(Value);
+        }
+        else if constexpr (std::is_same_v<T, FVector>)
+        {
+            Field.Type = EFieldType::Vector;
+            Field.Vector[0] = static_cast<float>(Value.X);
+            Field.Vector[1] = static_cast<float>(Value.Y);
+            Field.Vector[2] = static_cast<float>(Value.Z);
+        }
+        else if constexpr (std::is_same_v<T, FString>)
+        {
+            AddText(Field, FStringView(Value));
+        }
+        else if constexpr (std::is_same_v<T, FName>)
+        {
+            AddText(Field, FStringView(Value.ToString()));
+        }
+        else
+        {
+            // TCHAR strings and views
+            AddText(Field, FStringView(Value));
+        }
+    }
+
+    void AddText(FField& Field, FStringView Value)
+    {
+        const int32 Len = FMath::Min(Value.Len(), MaxText - static_cast<int32>(TextUsed));
+        Field.Type = EFieldType::String;
+        Field.Str.Offset = TextUsed;
+        Field.Str.Len = static_cast<uint8>(Len);
+        FMemory::Memcpy(Text + TextUsed, Value.GetData(), Len * sizeof(TCHAR));
+        TextUsed += static_cast<uint8>(Len);
+    }
+
+    void AddFields() {}
+
+    template <typename ValueType, typename... RestTypes>
+    void AddFields(const TCHAR* Key, const ValueType& Value, const RestTypes&... Rest)
+    {
+        Add(Key, Value);
+        AddFields(Rest...);
+    }
+};
+
+/**
+ * Client structured logging for hot paths.
+ *
+ * TOWER_SLOG(Category, Level, TEXT("Event"), TEXT("Key"), Value, ...) checks
+ * the category's level inline, then copies the event into a fixed-size
+ * lock-free ring. A writer thread formats it as "Event Key=Value ..." and
+ * passes it on to the engine log as LogTower<Category>. The producing thread
+ * only claims a slot and copies its fields.
+ *
+ * Per category there's a sampling rate (1 in N of Trace/Debug/Info events)
+ * and a rate limit (events a second below Error, the rest suppressed and
+ * counted in a summary line). Levels come from the logging config widget's
+ * default level and its module filters, read as "Category[=level]"
+ * directives, the way the Rust side reads its own. Events are dropped and
+ * counted when the ring is full. Any thread.
+ *
+ * Console: tower.Log.Filter, tower.Log.Limit, tower.Log.Stats.
+ */
+class TOWERGAME_API FTowerLog
+{
+public:
+    static bool IsEnabled(ETowerLogCategory Category, ETowerLogLevel Level)
+    {
+        return static_cast<uint8>(Level) >= MinLevel[static_cast<int32>(Category)].load(std::memory_order_relaxed);
+    }
+
+    template <typename... FieldTypes>
+    static void Write(ETowerLogCategory Category, ETowerLogLevel Level, const TCHAR* Event,
+        const ANSICHAR* File, int32 Line, const FieldTypes&... Fields)
+    {
+        static_assert(sizeof...(FieldTypes) % 2 == 0, "TOWER_SLOG fields are key, value pairs");
+        static_assert(sizeof...(FieldTypes) / 2 <= FTowerLogRecord::MaxFields, "Too many TOWER_SLOG fields");
+
+        uint64 Slot = 0;
+        if (FTowerLogRecord* Record = BeginRecord(Category, Level, Event, File, Line, Slot))
+        {
+            Record->AddFields(Fields...);
+            CommitRecord(Slot);
+        }
+    }
+
+    /** Start the writer thread; until then (and after Shutdown) events are formatted inline */
+    static void Startup();
+
+    /** Write out what's queued and stop the writer thread */
+    static void Shutdown();
+
+    /** Format everything queued so far on this thread */
+    static void Flush();
+
+    /**
+     * Apply the logging config: DefaultLevel for every category, then each
+     * "Category[=level]" directive (a bare category means Trace). Directives
+     * naming no client category are left for the Rust side.
+     */
+    static void Configure(ETowerLogLevel DefaultLevel, TConstArrayView<FString> Directives,
+        bool bShowTimestamps, bool bShowThreadIds, bool bShowTargets, bool bShowFileLine);
+
+    /** Events a second a category may log below Error (0 = unlimited) and the 1-in-N sampling below Warn */
+    static void SetLimits(ETowerLogCategory Category, int32 PerSecond, int32 SampleEvery);
+
+    static const TCHAR* GetCategoryName(ETowerLogCategory Category);
+    static bool FindCategory(FStringView Name, ETowerLogCategory& OutCategory);
+    static bool ParseLevel(FStringView Name, ETowerLogLevel& OutLevel);
+
+    /** Per category: events written, suppressed by the rate limit, sampled out; and dropped on a full ring */
+    static void DumpStats(FOutputDevice& Ar);
+
+private:
+    static FTowerLogRecord* BeginRecord(ETowerLogCategory Category, ETowerLogLevel Level, const TCHAR* Event,
+        const ANSICHAR* File, int32 Line, uint64& OutSlot);
+    static void CommitRecord(uint64 Slot);
+
+    static std::atomic<uint8> MinLevel[static_cast<int32>(ETowerLogCategory::MAX)];
+};
+
+/** Structured log event; fields are (TEXT("Key"), Value) pairs, evaluated only if Level is enabled */
+#define TOWER_SLOG(Category, Level, Event, ...) \
+    do \
+    { \
+        if (FTowerLog::IsEnabled(ETowerLogCategory::Category, ETowerLogLevel::Level)) \
+        { \
+            FTowerLog::Write(ETowerLogCategory::Category, ETowerLogLevel::Level, Event, __FILE__, __LINE__, ##__VA_ARGS__); \
+        } \
+    } while (0)
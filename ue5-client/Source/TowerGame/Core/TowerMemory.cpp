@@ -0,0 +1,111 @@
+#include "TowerMemory.h"
+#include "HAL/IConsoleManager.h"
+#include "Stats/Stats.h"
+
+LLM_DEFINE_TAG(Tower);
+LLM_DEFINE_TAG(Tower_Floor);
+LLM_DEFINE_TAG(Tower_Net);
+LLM_DEFINE_TAG(Tower_FFI);
+LLM_DEFINE_TAG(Tower_UI);
+LLM_DEFINE_TAG(Tower_Destruction);
+
+DECLARE_STATS_GROUP(TEXT("TowerMemory"), STATGROUP_TowerMemory, STATCAT_Advanced);
+
+DECLARE_MEMORY_STAT(TEXT("Floor"), STAT_TowerMemory_Floor, STATGROUP_TowerMemory);
+DECLARE_MEMORY_STAT(TEXT("Net"), STAT_TowerMemory_Net, STATGROUP_TowerMemory);
+DECLARE_MEMORY_STAT(TEXT("FFI"), STAT_TowerMemory_FFI, STATGROUP_TowerMemory);
+DECLARE_MEMORY_STAT(TEXT("UI"), STAT_TowerMemory_UI, STATGROUP_TowerMemory);
+DECLARE_MEMORY_STAT(TEXT("Destruction"), STAT_TowerMemory_Destruction, STATGROUP_TowerMemory);
+
+std::atomic<int64> FTowerMemoryStats::Bytes[static_cast<int32>(ETowerMemoryBucket::MAX)];
+std::atomic<bool> FTowerMemoryStats::bOverBudget[static_cast<int32>(ETowerMemoryBucket::MAX)];
+
+namespace
+{
+    constexpr int32 NumBuckets = static_cast<int32>(ETowerMemoryBucket::MAX);
+
+    TAutoConsoleVariable<float> CVarMemBudgets[NumBuckets] =
+    {
+        { TEXT("tower.MemBudget.Floor"), 64.0f, TEXT("MB the floor renderer's floor state may hold before warning (0 = no budget)") },
+        { TEXT("tower.MemBudget.Net"), 16.0f, TEXT("MB the state sync snapshot and prediction rings may hold before warning (0 = no budget)") },
+        { TEXT("tower.MemBudget.FFI"), 4.0f, TEXT("MB of bridge marshalling scratch across threads before warning (0 = no budget)") },
+        { TEXT("tower.MemBudget.UI"), 8.0f, TEXT("MB the UI catalogs may hold before warning (0 = no budget)") },
+        { TEXT("tower.MemBudget.Destruction"), 8.0f, TEXT("MB of destructible fragment state before warning (0 = no budget)") },
+    };
+
+    FAutoConsoleCommand DumpMemoryCommand(
+        TEXT("tower.Memory.Dump"),
+        TEXT("Log the retained bytes of each TowerGame memory bucket against its tower.MemBudget.*"),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            FTowerMemoryStats::Dump(*GLog);
+        }));
+}
+
+int64 FTowerMemoryStats::GetBudget(ETowerMemoryBucket Bucket)
+{
+    const int32 Index = static_cast<int32>(Bucket);
+    return Index < NumBuckets ? static_cast<int64>(CVarMemBudgets[Index].GetValueOnAnyThread() * 1024.0 * 1024.0) : 0;
+}
+
+const TCHAR* FTowerMemoryStats::GetBucketName(ETowerMemoryBucket Bucket)
+{
+    switch (Bucket)
+    {
+    case ETowerMemoryBucket::Floor:         return TEXT("Floor");
+    case ETowerMemoryBucket::Net:           return TEXT("Net");
+    case ETowerMemoryBucket::FFI:           return TEXT("FFI");
+    case ETowerMemoryBucket::UI:            return TEXT("UI");
+    case ETowerMemoryBucket::Destruction:   return TEXT("Destruction");
+    default:                                return TEXT("Unknown");
+    }
+}
+
+void FTowerMemoryStats::Add(ETowerMemoryBucket Bucket, int64 Delta)
+{
+    const int32 Index = static_cast<int32>(Bucket);
+    const int64 Total = Bytes[Index].fetch_add(Delta, std::memory_order_relaxed) + Delta;
+
+    // Owners outlive the stats system at exit (thread_local scratch); only the totals matter by then
+    if (IsEngineExitRequested())
+    {
+        return;
+    }
+
+#define TOWER_ADJUST_MEMORY_STAT(Stat) \
+    if (Delta >= 0) { INC_MEMORY_STAT_BY(Stat, Delta); } else { DEC_MEMORY_STAT_BY(Stat, -Delta); }
+
+    switch (Bucket)
+    {
+    case ETowerMemoryBucket::Floor:         TOWER_ADJUST_MEMORY_STAT(STAT_TowerMemory_Floor); break;
+    case ETowerMemoryBucket::Net:           TOWER_ADJUST_MEMORY_STAT(STAT_TowerMemory_Net); break;
+    case ETowerMemoryBucket::FFI:           TOWER_ADJUST_MEMORY_STAT(STAT_TowerMemory_FFI); break;
+    case ETowerMemoryBucket::UI:            TOWER_ADJUST_MEMORY_STAT(STAT_TowerMemory_UI); break;
+    case ETowerMemoryBucket::Destruction:   TOWER_ADJUST_MEMORY_STAT(STAT_TowerMemory_Destruction); break;
+    default: break;
+    }
+
+#undef TOWER_ADJUST_MEMORY_STAT
+
+    // Warn on crossing the budget, not on every growth past it
+    const int64 Budget = GetBudget(Bucket);
+    const bool bOver = Budget > 0 && Total > Budget;
+    if (bOverBudget[Index].exchange(bOver, std::memory_order_relaxed) != bOver && bOver)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TowerMemory: %s holds %.2f MB, over its %.2f MB budget (tower.MemBudget.%s)"),
+            GetBucketName(Bucket), Total / (1024.0 * 1024.0), Budget / (1024.0 * 1024.0), GetBucketName(Bucket));
+    }
+}
+
+void FTowerMemoryStats::Dump(FOutputDevice& Ar)
+{
+    Ar.Logf(TEXT("=== TowerMemory ==="));
+    for (int32 Index = 0; Index < NumBuckets; Index++)
+    {
+        const ETowerMemoryBucket Bucket = static_cast<ETowerMemoryBucket>(Index);
+        const int64 Budget = GetBudget(Bucket);
+        Ar.Logf(TEXT("  %-12s %9.2f MB / %s%s"), GetBucketName(Bucket), GetBytes(Bucket) / (1024.0 * 1024.0),
+            Budget > 0 ? *FString::Printf(TEXT("%.2f MB"), Budget / (1024.0 * 1024.0)) : TEXT("no budget"),
+            IsOverBudget(Bucket) ? TEXT("  OVER") : TEXT(""));
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include <atomic>
+
+// LLM tags for our allocations, under Tower/ in -llm captures and 'stat LLMFULL'.
+// Scope allocation sites with LLM_SCOPE_BYTAG(Tower_Floor) etc.; frees follow the pointer.
+LLM_DECLARE_TAG_API(Tower_Floor, TOWERGAME_API);        // Floor data, renderer grid / chunks / instances
+LLM_DECLARE_TAG_API(Tower_Net, TOWERGAME_API);          // Packet decode, replication, state sync snapshots
+LLM_DECLARE_TAG_API(Tower_FFI, TOWERGAME_API);          // Bridge marshalling scratch (results go to the caller's tag)
+LLM_DECLARE_TAG_API(Tower_UI, TOWERGAME_API);           // Catalogs and widget data
+LLM_DECLARE_TAG_API(Tower_Destruction, TOWERGAME_API);  // Fracture state, debris, recorded collapses
+
+/** Retained-memory buckets behind 'stat TowerMemory' and the tower.MemBudget.* budgets */
+enum class ETowerMemoryBucket : uint8
+{
+    Floor,          // ATowerProceduralFloorRenderer's floor state
+    Net,            // UTowerStateSynchronizer snapshot and prediction rings
+    FFI,            // Per-thread marshalling scratch
+    UI,             // UTowerCatalogSubsystem catalogs
+    Destruction,    // UTowerDestructibleComponent fragment state
+
+    MAX
+};
+
+/**
+ * Bytes our long-lived containers hold, per bucket, as reported by their owners
+ * through FTowerMemoryReport. Unlike LLM this is on in every configuration, so
+ * budgets can be checked on test and shipping builds: a bucket growing past
+ * tower.MemBudget.<Bucket> (MB, 0 = none; set per platform in its Engine.ini
+ * [ConsoleVariables]) logs a warning once until it drops back under.
+ * 'stat TowerMemory' shows the same figures where stats are compiled in. Any thread.
+ */
+class TOWERGAME_API FTowerMemoryStats
+{
+public:
+    static int64 GetBytes(ETowerMemoryBucket Bucket)
+    {
+        return Bytes[static_cast<int32>(Bucket)].load(std::memory_order_relaxed);
+    }
+
+    /** Budget in bytes; 0 if unbudgeted */
+    static int64 GetBudget(ETowerMemoryBucket Bucket);
+
+    static bool IsOverBudget(ETowerMemoryBucket Bucket)
+    {
+        return bOverBudget[static_cast<int32>(Bucket)].load(std::memory_order_relaxed);
+    }
+
+    static const TCHAR* GetBucketName(ETowerMemoryBucket Bucket);
+
+    static void Dump(FOutputDevice& Ar);
+
+private:
+    friend class FTowerMemoryReport;
+
+    static void Add(ETowerMemoryBucket Bucket, int64 Delta);
+
+    static std::atomic<int64> Bytes[static_cast<int32>(ETowerMemoryBucket::MAX)];
+    static std::atomic<bool> bOverBudget[static_cast<int32>(ETowerMemoryBucket::MAX)];
+};
+
+/**
+ * What one owner holds in a bucket. Set replaces the owner's previous figure,
+ * so owners re-measure after they grow or shrink; destruction reports zero.
+ */
+class TOWERGAME_API FTowerMemoryReport
+{
+public:
+    explicit FTowerMemoryReport(ETowerMemoryBucket InBucket)
+        : Bucket(InBucket)
+    {
+    }
+
+    ~FTowerMemoryReport() { Set(0); }
+
+    FTowerMemoryReport(const FTowerMemoryReport&) = delete;
+    FTowerMemoryReport& operator=(const FTowerMemoryReport&) = delete;
+
+    void Set(int64 InBytes)
+    {
+        if (InBytes != Reported)
+        {
+            FTowerMemoryStats::Add(Bucket, InBytes - Reported);
+            Reported = InBytes;
+        }
+    }
+
+    int64 Get() const { return Reported; }
+
+private:
+    ETowerMemoryBucket Bucket;
+    int64 Reported = 0;
+};
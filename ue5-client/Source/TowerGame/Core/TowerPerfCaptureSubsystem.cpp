@@ -0,0 +1,329 @@
+#include "TowerPerfCaptureSubsystem.h"
+#include "TowerGame/World/DestructionBudgetSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTowerPerf, Log, All);
+
+namespace
+{
+    constexpr int32 NumChannels = static_cast<int32>(ETowerPerfChannel::MAX);
+
+    /** CSV column per ETowerPerfChannel */
+    const TCHAR* const ChannelColumns[NumChannels] =
+    {
+        TEXT("frame_ms"),
+        TEXT("game_ms"),
+        TEXT("render_ms"),
+        TEXT("rhi_ms"),
+        TEXT("gpu_ms"),
+        TEXT("net_decode_ms"),
+        TEXT("ffi_ms"),
+        TEXT("floor_build_ms"),
+        TEXT("ui_rebuilds"),
+        TEXT("physics_fragments"),
+    };
+
+    /** Budget per ETowerPerfChannel; the defaults split a 60 fps frame */
+    TAutoConsoleVariable<float> CVarPerfBudgets[NumChannels] =
+    {
+        { TEXT("tower.PerfBudget.Frame"), 16.7f, TEXT("Frame time budget in ms for tower.PerfCapture (0 = none)") },
+        { TEXT("tower.PerfBudget.GameThread"), 12.0f, TEXT("Game thread budget in ms for tower.PerfCapture (0 = none)") },
+        { TEXT("tower.PerfBudget.RenderThread"), 12.0f, TEXT("Render thread budget in ms for tower.PerfCapture (0 = none)") },
+        { TEXT("tower.PerfBudget.RHIThread"), 0.0f, TEXT("RHI thread budget in ms for tower.PerfCapture (0 = none)") },
+        { TEXT("tower.PerfBudget.GPU"), 14.0f, TEXT("GPU budget in ms for tower.PerfCapture (0 = none)") },
+        { TEXT("tower.PerfBudget.NetDecode"), 1.0f, TEXT("Packet and snapshot decode budget in ms a frame (0 = none)") },
+        { TEXT("tower.PerfBudget.FFI"), 1.0f, TEXT("Time inside tower_core.dll calls in ms a frame (0 = none)") },
+        { TEXT("tower.PerfBudget.FloorBuild"), 4.0f, TEXT("Floor renderer build time in ms a frame (0 = none)") },
+        { TEXT("tower.PerfBudget.UIRebuilds"), 20.0f, TEXT("Widget display rebuilds a frame (0 = none)") },
+        { TEXT("tower.PerfBudget.PhysicsFragments"), 300.0f, TEXT("Simulated debris fragment cost (0 = none)") },
+    };
+
+    TAutoConsoleVariable<int32> CVarPerfCaptureFrames(
+        TEXT("tower.PerfCapture.Frames"),
+        18000,
+        TEXT("Frames kept by tower.PerfCapture; older ones are overwritten. Read when a capture starts."),
+        ECVF_Default);
+
+    FAutoConsoleCommandWithWorldAndArgs PerfCaptureCommand(
+        TEXT("tower.PerfCapture"),
+        TEXT("tower.PerfCapture start [seconds] | stop | dump - per-frame thread times and subsystem costs to Saved/Profiling/TowerPerf-<time>.csv"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+            UTowerPerfCaptureSubsystem* Capture = GameInstance ? GameInstance->GetSubsystem<UTowerPerfCaptureSubsystem>() : nullptr;
+            if (!Capture)
+            {
+                return;
+            }
+
+            const FString Verb = Args.Num() > 0 ? Args[0] : TEXT("start");
+            if (Verb == TEXT("stop"))
+            {
+                Capture->StopCapture();
+            }
+            else if (Verb == TEXT("dump"))
+            {
+                Capture->DumpCsv();
+            }
+            else
+            {
+                Capture->StartCapture(Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.0f);
+            }
+        }));
+}
+
+void UTowerPerfCaptureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // Automated runs: -TowerPerfCapture for the whole session, -TowerPerfCapture=<seconds> for a window
+    FString Seconds;
+    if (FParse::Value(FCommandLine::Get(), TEXT("-TowerPerfCapture="), Seconds))
+    {
+        StartCapture(FCString::Atof(*Seconds));
+    }
+    else if (FParse::Param(FCommandLine::Get(), TEXT("TowerPerfCapture")))
+    {
+        StartCapture();
+    }
+}
+
+void UTowerPerfCaptureSubsystem::Deinitialize()
+{
+    StopCapture();
+    Super::Deinitialize();
+}
+
+// ============ Capture ============
+
+void UTowerPerfCaptureSubsystem::StartCapture(float Seconds)
+{
+    Ring.SetNum(FMath::Max(CVarPerfCaptureFrames.GetValueOnGameThread(), 60));
+    RingHead = 0;
+    NumFrames = 0;
+    FMemory::Memzero(OverBudgetFrames);
+
+    CaptureStartSeconds = FPlatformTime::Seconds();
+    CaptureEndSeconds = Seconds > 0.0f ? CaptureStartSeconds + Seconds : 0.0;
+
+    FTowerPerfCounters::SetCapturing(true);
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UTowerPerfCaptureSubsystem::TickCapture));
+    }
+
+    UE_LOG(LogTowerPerf, Display, TEXT("Perf capture started (%s, %d frame ring)"),
+        Seconds > 0.0f ? *FString::Printf(TEXT("%.0f s"), Seconds) : TEXT("until stopped"), Ring.Num());
+}
+
+FString UTowerPerfCaptureSubsystem::StopCapture()
+{
+    if (!IsCapturing())
+    {
+        return FString();
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    FTowerPerfCounters::SetCapturing(false);
+
+    return NumFrames > 0 ? DumpCsv() : FString();
+}
+
+bool UTowerPerfCaptureSubsystem::TickCapture(float DeltaTime)
+{
+    FTowerPerfFrame& Frame = Ring[RingHead];
+    SampleFrame(Frame);
+    RingHead = (RingHead + 1) % Ring.Num();
+    NumFrames = FMath::Min(NumFrames + 1, Ring.Num());
+
+    if (Frame.OverBudgetMask != 0)
+    {
+        FString Over;
+        for (int32 Channel = 0; Channel < NumChannels; Channel++)
+        {
+            if (Frame.OverBudgetMask & (1u << Channel))
+            {
+                OverBudgetFrames[Channel]++;
+                Over += FString::Printf(TEXT(" %s=%.2f"), ChannelColumns[Channel], Frame.Values[Channel]);
+            }
+        }
+        UE_LOG(LogTowerPerf, Verbose, TEXT("Frame %llu over budget:%s"), Frame.FrameNumber, *Over);
+    }
+
+    if (CaptureEndSeconds > 0.0 && FPlatformTime::Seconds() >= CaptureEndSeconds)
+    {
+        StopCapture();
+        return false;
+    }
+    return true;
+}
+
+void UTowerPerfCaptureSubsystem::SampleFrame(FTowerPerfFrame& Frame) const
+{
+    auto Set = [&Frame](ETowerPerfChannel Channel, double Value)
+    {
+        Frame.Values[static_cast<int32>(Channel)] = static_cast<float>(Value);
+    };
+    auto ConsumeMs = [](ETowerPerfCounter Counter)
+    {
+        return FPlatformTime::ToMilliseconds64(FTowerPerfCounters::Consume(Counter));
+    };
+
+    Frame.FrameNumber = GFrameCounter;
+    Frame.Time = FPlatformTime::Seconds() - CaptureStartSeconds;
+
+    Set(ETowerPerfChannel::Frame, FApp::GetDeltaTime() * 1000.0);
+    Set(ETowerPerfChannel::GameThread, FPlatformTime::ToMilliseconds(GGameThreadTime));
+    Set(ETowerPerfChannel::RenderThread, FPlatformTime::ToMilliseconds(GRenderThreadTime));
+    Set(ETowerPerfChannel::RHIThread, FPlatformTime::ToMilliseconds(GRHIThreadTime));
+    Set(ETowerPerfChannel::GPU, FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()));
+
+    Set(ETowerPerfChannel::NetDecode, ConsumeMs(ETowerPerfCounter::NetDecode));
+    Set(ETowerPerfChannel::FFI, ConsumeMs(ETowerPerfCounter::FFI));
+    Set(ETowerPerfChannel::FloorBuild, ConsumeMs(ETowerPerfCounter::FloorBuild));
+    Set(ETowerPerfChannel::UIRebuilds, FTowerPerfCounters::Consume(ETowerPerfCounter::UIRebuilds));
+
+    const UWorld* World = GetGameInstance()->GetWorld();
+    const UTowerDestructionBudgetSubsystem* Destruction = World ? World->GetSubsystem<UTowerDestructionBudgetSubsystem>() : nullptr;
+    Set(ETowerPerfChannel::PhysicsFragments, Destruction ? Destruction->GetActiveFragmentCost() : 0.0f);
+
+    Frame.OverBudgetMask = 0;
+    for (int32 Channel = 0; Channel < NumChannels; Channel++)
+    {
+        const float Budget = GetBudget(static_cast<ETowerPerfChannel>(Channel));
+        if (Budget > 0.0f && Frame.Values[Channel] > Budget)
+        {
+            Frame.OverBudgetMask |= 1u << Channel;
+        }
+    }
+}
+
+// ============ Results ============
+
+float UTowerPerfCaptureSubsystem::GetBudget(ETowerPerfChannel Channel)
+{
+    const int32 Index = static_cast<int32>(Channel);
+    return Index < NumChannels ? CVarPerfBudgets[Index].GetValueOnGameThread() : 0.0f;
+}
+
+int32 UTowerPerfCaptureSubsystem::GetOverBudgetFrames(ETowerPerfChannel Channel) const
+{
+    const int32 Index = static_cast<int32>(Channel);
+    return Index < NumChannels ? OverBudgetFrames[Index] : 0;
+}
+
+const FTowerPerfFrame& UTowerPerfCaptureSubsystem::GetFrame(int32 Index) const
+{
+    return Ring[(RingHead - NumFrames + Index + Ring.Num()) % Ring.Num()];
+}
+
+FString UTowerPerfCaptureSubsystem::DumpCsv() const
+{
+    if (NumFrames == 0)
+    {
+        UE_LOG(LogTowerPerf, Warning, TEXT("Perf capture: no frames to dump"));
+        return FString();
+    }
+
+    FString Csv = TEXT("frame,time_s");
+    for (const TCHAR* Column : ChannelColumns)
+    {
+        Csv += TEXT(",");
+        Csv += Column;
+    }
+    Csv += TEXT(",over_budget\n");
+
+    for (int32 i = 0; i < NumFrames; i++)
+    {
+        const FTowerPerfFrame& Frame = GetFrame(i);
+        Csv += FString::Printf(TEXT("%llu,%.4f"), Frame.FrameNumber, Frame.Time);
+        for (int32 Channel = 0; Channel < NumChannels; Channel++)
+        {
+            Csv += FString::Printf(TEXT(",%.3f"), Frame.Values[Channel]);
+        }
+
+        // Which budgets this frame blew, '|' separated so the column stays one cell
+        Csv += TEXT(",");
+        bool bFirst = true;
+        for (int32 Channel = 0; Channel < NumChannels; Channel++)
+        {
+            if (Frame.OverBudgetMask & (1u << Channel))
+            {
+                if (!bFirst) Csv += TEXT("|");
+                Csv += ChannelColumns[Channel];
+                bFirst = false;
+            }
+        }
+        Csv += TEXT("\n");
+    }
+
+    LogSummary(*GLog);
+
+    const FString Path = FPaths::Combine(FPaths::ProfilingDir(),
+        FString::Printf(TEXT("TowerPerf-%s.csv"), *FDateTime::Now().ToString()));
+    if (!FFileHelper::SaveStringToFile(Csv, *Path))
+    {
+        UE_LOG(LogTowerPerf, Error, TEXT("Perf capture: could not write %s"), *Path);
+        return FString();
+    }
+
+    UE_LOG(LogTowerPerf, Display, TEXT("Perf capture: %d frames written to %s"), NumFrames, *Path);
+    return Path;
+}
+
+void UTowerPerfCaptureSubsystem::LogSummary(FOutputDevice& Ar) const
+{
+    Ar.Logf(TEXT("=== Perf capture: %d frames ==="), NumFrames);
+    Ar.Logf(TEXT("  %-18s %9s %9s %9s %9s %8s"), TEXT("channel"), TEXT("mean"), TEXT("p99"), TEXT("max"), TEXT("budget"), TEXT("over"));
+
+    TArray<float> Values;
+    Values.SetNumUninitialized(NumFrames);
+    for (int32 Channel = 0; Channel < NumChannels; Channel++)
+    {
+        double Sum = 0.0;
+        for (int32 i = 0; i < NumFrames; i++)
+        {
+            Values[i] = GetFrame(i).Values[Channel];
+            Sum += Values[i];
+        }
+        Values.Sort();
+
+        const float P99 = Values[FMath::Min(NumFrames - 1, FMath::FloorToInt(0.99 * NumFrames))];
+        Ar.Logf(TEXT("  %-18s %9.2f %9.2f %9.2f %9.2f %8d"), ChannelColumns[Channel],
+            Sum / NumFrames, P99, Values.Last(), GetBudget(static_cast<ETowerPerfChannel>(Channel)), OverBudgetFrames[Channel]);
+    }
+
+    // The slowest frame and what was over budget in it
+    int32 Worst = 0;
+    for (int32 i = 1; i < NumFrames; i++)
+    {
+        if (GetFrame(i).Values[0] > GetFrame(Worst).Values[0])
+        {
+            Worst = i;
+        }
+    }
+    const FTowerPerfFrame& WorstFrame = GetFrame(Worst);
+    FString Over;
+    for (int32 Channel = 1; Channel < NumChannels; Channel++)
+    {
+        if (WorstFrame.OverBudgetMask & (1u << Channel))
+        {
+            Over += FString::Printf(TEXT(" %s=%.2f"), ChannelColumns[Channel], WorstFrame.Values[Channel]);
+        }
+    }
+    Ar.Logf(TEXT("  Worst frame %llu at %.2f s: %.2f ms, over budget:%s"), WorstFrame.FrameNumber, WorstFrame.Time,
+        WorstFrame.Values[0], Over.IsEmpty() ? TEXT(" none") : *Over);
+}
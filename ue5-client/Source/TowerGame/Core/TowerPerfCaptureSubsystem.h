@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Core/PerfCounters.h"
+#include "TowerPerfCaptureSubsystem.generated.h"
+
+/** One column of a perf capture: an engine thread time or one of our ETowerPerfCounter costs */
+UENUM(BlueprintType)
+enum class ETowerPerfChannel : uint8
+{
+    Frame            UMETA(DisplayName = "Frame (ms)"),
+    GameThread       UMETA(DisplayName = "Game Thread (ms)"),
+    RenderThread     UMETA(DisplayName = "Render Thread (ms)"),
+    RHIThread        UMETA(DisplayName = "RHI Thread (ms)"),
+    GPU              UMETA(DisplayName = "GPU (ms)"),
+    NetDecode        UMETA(DisplayName = "Net Decode (ms)"),
+    FFI              UMETA(DisplayName = "FFI (ms)"),
+    FloorBuild       UMETA(DisplayName = "Floor Build (ms)"),
+    UIRebuilds       UMETA(DisplayName = "UI Rebuilds"),
+    PhysicsFragments UMETA(DisplayName = "Active Physics Fragments"),
+
+    MAX              UMETA(Hidden)
+};
+
+/** One captured frame */
+struct FTowerPerfFrame
+{
+    uint64 FrameNumber = 0;
+
+    /** Seconds since the capture started */
+    double Time = 0.0;
+
+    float Values[static_cast<int32>(ETowerPerfChannel::MAX)] = {};
+
+    /** Bit per ETowerPerfChannel that was over its tower.PerfBudget.* */
+    uint32 OverBudgetMask = 0;
+};
+
+/**
+ * Game Instance Subsystem — per-frame performance capture for playtests.
+ *
+ * While capturing, every frame's time, game / render / RHI / GPU thread times
+ * and our FTowerPerfCounters (net decode, FFI, floor build, UI rebuilds) plus
+ * the active physics fragment cost go into a ring buffer of the last
+ * tower.PerfCapture.Frames frames. A channel over its tower.PerfBudget.<Channel>
+ * (0 = unbudgeted) flags the frame, so the CSV says which subsystem blew it.
+ *
+ * Engine thread times are the previous frame's, as stat unit shows them; the
+ * counters cover everything since the last sample, which is one frame.
+ *
+ * Start on demand with 'tower.PerfCapture start [seconds]', or for automated
+ * runs with -TowerPerfCapture[=seconds] on the command line; the capture is
+ * written to Saved/Profiling/TowerPerf-<time>.csv when it stops or the game exits.
+ */
+UCLASS()
+class TOWERGAME_API UTowerPerfCaptureSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Clear the ring and start sampling; Seconds <= 0 runs until StopCapture */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Perf")
+    void StartCapture(float Seconds = 0.0f);
+
+    /** Stop sampling and write the CSV; returns its path, empty if nothing was captured */
+    UFUNCTION(BlueprintCallable, Category = "Tower|Perf")
+    FString StopCapture();
+
+    UFUNCTION(BlueprintPure, Category = "Tower|Perf")
+    bool IsCapturing() const { return TickerHandle.IsValid(); }
+
+    /** Write the frames in the ring, oldest first, and log the summary; returns the path */
+    FString DumpCsv() const;
+
+    /** Per channel: mean, p99, max and frames over budget */
+    void LogSummary(FOutputDevice& Ar) const;
+
+    int32 GetNumFrames() const { return NumFrames; }
+
+    /** Captured frames over budget on Channel */
+    UFUNCTION(BlueprintPure, Category = "Tower|Perf")
+    int32 GetOverBudgetFrames(ETowerPerfChannel Channel) const;
+
+    /** Frame budget of Channel from tower.PerfBudget.*; 0 if unbudgeted */
+    static float GetBudget(ETowerPerfChannel Channel);
+
+private:
+    bool TickCapture(float DeltaTime);
+    void SampleFrame(FTowerPerfFrame& Frame) const;
+
+    /** Index-th frame of the ring, oldest first */
+    const FTowerPerfFrame& GetFrame(int32 Index) const;
+
+    TArray<FTowerPerfFrame> Ring;
+    int32 RingHead = 0;
+    int32 NumFrames = 0;
+
+    int32 OverBudgetFrames[static_cast<int32>(ETowerPerfChannel::MAX)] = {};
+
+    double CaptureStartSeconds = 0.0;
+    double CaptureEndSeconds = 0.0;     // 0 = until stopped
+
+    FTSTicker::FDelegateHandle TickerHandle;
+};
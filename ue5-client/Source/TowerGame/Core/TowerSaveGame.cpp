@@ -1,5 +1,211 @@
 #include "TowerSaveGame.h"
+#include "StartupTimeline.h"
+#include "Bridge/ProceduralCoreBridge.h"
 #include "Kismet/GameplayStatics.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Field by field, for SerializeCompact; found by TArray<T>::operator<< through ADL
+static FArchive& operator<<(FArchive& Ar, FPlayerSaveStats& Stats)
+{
+    Ar << Stats.HighestFloor << Stats.TotalDeaths << Stats.MonstersSlain << Stats.TotalPlayTime
+       << Stats.ChestsOpened << Stats.QuestsCompleted << Stats.ItemsCrafted << Stats.EchoesEncountered;
+    return Ar;
+}
+
+static FArchive& operator<<(FArchive& Ar, FPlayerSaveSettings& Settings)
+{
+    Ar << Settings.MasterVolume << Settings.SFXVolume << Settings.MusicVolume << Settings.MouseSensitivity
+       << Settings.bInvertY << Settings.bShowDamageNumbers << Settings.bRotateMinimap << Settings.bShowTimestamps;
+    return Ar;
+}
+
+static FArchive& operator<<(FArchive& Ar, FFactionRepSave& Rep)
+{
+    Ar << Rep.FactionName << Rep.Reputation << Rep.Tier;
+    return Ar;
+}
+
+static FArchive& operator<<(FArchive& Ar, FInventoryItemSave& Item)
+{
+    Ar << Item.ItemName << Item.Category << Item.Rarity << Item.Quantity << Item.LootJson;
+    return Ar;
+}
+
+// Format 3: cataloged items as name, rarity index, quantity and rolled tags; the rest as before
+static void SerializeInventoryItem(FArchive& Ar, FInventoryItemSave& Item)
+{
+    bool bCataloged = Item.IsCataloged();
+    Ar << bCataloged << Item.ItemName;
+    if (!bCataloged)
+    {
+        Ar << Item.Category << Item.Rarity << Item.Quantity << Item.LootJson;
+        return;
+    }
+
+    uint8 Rarity = FLootDropData::RarityFromName(Item.Rarity);
+    Ar << Rarity << Item.Quantity << Item.TagNames << Item.TagValues;
+    if (Ar.IsLoading())
+    {
+        Item.Rarity = FLootDropData::RarityNameOf(Rarity);
+        Item.Category.Reset();
+        Item.LootJson.Reset();
+    }
+}
+
+namespace
+{
+    constexpr uint32 SaveMagic = 0x31565354; // "TSV1"
+    constexpr uint16 SaveFormatVersion = 3; // 2: JournalSequence, 3: cataloged inventory items
+    constexpr uint32 MaxRawSize = 64 * 1024 * 1024;
+    const TCHAR* SaveExtension = TEXT(".tsav");
+
+    enum class ESaveCodec : uint8
+    {
+        None = 0,
+        Oodle = 1,
+    };
+
+    struct FSaveFileHeader
+    {
+        uint32 Magic;
+        uint16 FormatVersion;
+        uint8 Codec;
+        uint8 Reserved;
+        uint32 RawSize;
+        uint32 PayloadSize;
+        uint32 RawCrc;
+    };
+
+    static_assert(sizeof(FSaveFileHeader) == 20, "Save header layout changed; bump SaveFormatVersion");
+
+    constexpr uint32 JournalMagic = 0x31524A54; // "TJR1"
+    constexpr uint32 JournalFormatVersion = 1;
+    const TCHAR* JournalExtension = TEXT(".tjr");
+
+    struct FJournalHeader
+    {
+        uint32 Magic;
+        uint32 FormatVersion;
+    };
+
+    static_assert(sizeof(FJournalHeader) == 8, "Journal header layout changed; bump JournalFormatVersion");
+
+    // IncrementStat names, indexed by the stat id journaled for them
+    const TCHAR* JournalStatNames[] = { nullptr, TEXT("Deaths"), TEXT("Monsters"), TEXT("Chests"),
+        TEXT("Quests"), TEXT("Crafts"), TEXT("Echoes") };
+
+    uint8 FindStatId(const FString& StatName)
+    {
+        for (uint8 Id = 1; Id < UE_ARRAY_COUNT(JournalStatNames); Id++)
+        {
+            if (StatName == JournalStatNames[Id]) return Id;
+        }
+        return 0;
+    }
+
+    int32* FindStat(FPlayerSaveStats& Stats, uint8 StatId)
+    {
+        switch (StatId)
+        {
+            case 1: return &Stats.TotalDeaths;
+            case 2: return &Stats.MonstersSlain;
+            case 3: return &Stats.ChestsOpened;
+            case 4: return &Stats.QuestsCompleted;
+            case 5: return &Stats.ItemsCrafted;
+            case 6: return &Stats.EchoesEncountered;
+            default: return nullptr;
+        }
+    }
+
+    /** Worker side of a save: compress Raw behind a header and move it over Path */
+    bool WriteSaveFile(const FString& Path, const TArray<uint8>& Raw)
+    {
+        FSaveFileHeader Header;
+        Header.Magic = SaveMagic;
+        Header.FormatVersion = SaveFormatVersion;
+        Header.Codec = static_cast<uint8>(ESaveCodec::Oodle);
+        Header.Reserved = 0;
+        Header.RawSize = static_cast<uint32>(Raw.Num());
+        Header.RawCrc = FCrc::MemCrc32(Raw.GetData(), Raw.Num());
+
+        const int32 HeaderSize = sizeof(FSaveFileHeader);
+        int32 PayloadSize = FCompression::CompressMemoryBound(NAME_Oodle, Raw.Num());
+        TArray<uint8> Bytes;
+        Bytes.SetNumUninitialized(HeaderSize + PayloadSize);
+        if (!FCompression::CompressMemory(NAME_Oodle, Bytes.GetData() + HeaderSize, PayloadSize, Raw.GetData(), Raw.Num()))
+        {
+            // Still a valid save, just a bigger one
+            Header.Codec = static_cast<uint8>(ESaveCodec::None);
+            PayloadSize = Raw.Num();
+            FMemory::Memcpy(Bytes.GetData() + HeaderSize, Raw.GetData(), PayloadSize);
+        }
+        Bytes.SetNum(HeaderSize + PayloadSize);
+        Header.PayloadSize = static_cast<uint32>(PayloadSize);
+        FMemory::Memcpy(Bytes.GetData(), &Header, HeaderSize);
+
+        // Write aside and move into place so a crash mid-write leaves the previous save intact
+        const FString TempPath = Path + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+        {
+            IFileManager::Get().Delete(*TempPath, false, true, true);
+            return false;
+        }
+        return true;
+    }
+
+    /** Worker side of a load: the decompressed, CRC-checked payload of Path */
+    bool ReadSaveFile(const FString& Path, TArray<uint8>& OutRaw, uint16& OutFormatVersion,
+        TFunctionRef<void(float, const TCHAR*)> Progress)
+    {
+        Progress(0.1f, TEXT("Reading"));
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent)) return false;
+
+        const int32 HeaderSize = sizeof(FSaveFileHeader);
+        if (Bytes.Num() < HeaderSize) return false;
+
+        FSaveFileHeader Header;
+        FMemory::Memcpy(&Header, Bytes.GetData(), HeaderSize);
+        if (Header.Magic != SaveMagic || Header.FormatVersion == 0 || Header.FormatVersion > SaveFormatVersion
+            || Header.RawSize > MaxRawSize || Header.PayloadSize != static_cast<uint32>(Bytes.Num() - HeaderSize))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TowerSave: %s is not a version 1-%d save"), *Path, SaveFormatVersion);
+            return false;
+        }
+
+        Progress(0.5f, TEXT("Decompressing"));
+        OutRaw.SetNumUninitialized(Header.RawSize);
+        const uint8* Payload = Bytes.GetData() + HeaderSize;
+        bool bDecoded = false;
+        switch (static_cast<ESaveCodec>(Header.Codec))
+        {
+            case ESaveCodec::None:
+                bDecoded = Header.PayloadSize == Header.RawSize;
+                if (bDecoded) FMemory::Memcpy(OutRaw.GetData(), Payload, Header.RawSize);
+                break;
+            case ESaveCodec::Oodle:
+                bDecoded = FCompression::UncompressMemory(NAME_Oodle, OutRaw.GetData(), Header.RawSize, Payload, Header.PayloadSize);
+                break;
+        }
+
+        if (!bDecoded || FCrc::MemCrc32(OutRaw.GetData(), OutRaw.Num()) != Header.RawCrc)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TowerSave: %s is corrupt"), *Path);
+            OutRaw.Reset();
+            return false;
+        }
+        OutFormatVersion = Header.FormatVersion;
+        return true;
+    }
+}
 
 UTowerSaveGame::UTowerSaveGame()
 {
@@ -7,52 +213,237 @@ UTowerSaveGame::UTowerSaveGame()
     LastSaveTime = FDateTime::Now();
 }
 
+void UTowerSaveGame::SerializeCompact(FArchive& Ar, uint16 FormatVersion)
+{
+    Ar << PlayerName << NakamaUserId << NakamaAuthToken;
+    Ar << CurrentFloor << TowerSeed << Stats;
+    if (FormatVersion >= 3)
+    {
+        int32 NumItems = InventoryItems.Num();
+        Ar << NumItems;
+        if (Ar.IsLoading())
+        {
+            if (NumItems < 0 || NumItems > MaxRawSize / 8)
+            {
+                Ar.SetError();
+                return;
+            }
+            InventoryItems.SetNum(NumItems);
+        }
+        for (FInventoryItemSave& Item : InventoryItems)
+        {
+            SerializeInventoryItem(Ar, Item);
+        }
+    }
+    else
+    {
+        Ar << InventoryItems;
+    }
+    Ar << TowerShards << EchoFragments;
+    Ar << FactionReps;
+    Ar << Settings;
+    Ar << LastSaveTime << SaveVersion << GameVersion;
+
+    if (FormatVersion >= 2)
+    {
+        Ar << JournalSequence;
+    }
+}
+
 // ===========================
 // UTowerSaveSubsystem
 // ===========================
 
 void UTowerSaveSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+    TOWER_STARTUP_SCOPE(TowerSaveSubsystem);
     Super::Initialize(Collection);
 
-    // Try loading default slot
-    if (HasSaveGame(0))
+    // Try loading default slot; blocking is fine before anything is on screen
+    if (HasSaveGame(0) && LoadGame(0))
     {
-        LoadGame(0);
         UE_LOG(LogTemp, Log, TEXT("Loaded save game from slot 0"));
     }
     else
     {
-        CurrentSave = Cast<UTowerSaveGame>(
-            UGameplayStatics::CreateSaveGameObject(UTowerSaveGame::StaticClass()));
+        SetCurrentSave(Cast<UTowerSaveGame>(
+            UGameplayStatics::CreateSaveGameObject(UTowerSaveGame::StaticClass())), 0);
         UE_LOG(LogTemp, Log, TEXT("Created new save game"));
     }
 }
 
+void UTowerSaveSubsystem::Deinitialize()
+{
+    if (UnjournaledPlayTime > 0.0f)
+    {
+        RecordChange(EJournalOp::PlayTime, 0, 0, UnjournaledPlayTime, /*bApply=*/false);
+    }
+
+    // Nothing queued is dropped on exit: finish the writes, then the snapshots behind them
+    for (TPair<int32, FSlotWrite>& Pair : SlotWrites)
+    {
+        Pair.Value.Task.Wait();
+        if (Pair.Value.bPending && !WriteSaveFile(GetSlotPath(Pair.Key), Pair.Value.PendingBytes))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to save game to slot %d"), Pair.Key);
+        }
+    }
+    SlotWrites.Empty();
+    SlotLoads.Empty();
+
+    JournalPipe.WaitUntilEmpty();
+    JournalFile.Reset();
+    Super::Deinitialize();
+}
+
 bool UTowerSaveSubsystem::SaveGame(int32 SlotIndex)
 {
     if (!CurrentSave) return false;
+    if (SlotLoads.Num() > 0)
+    {
+        // CurrentSave is about to be replaced; saving it now would overwrite what is being loaded
+        UE_LOG(LogTemp, Warning, TEXT("Skipped save to slot %d: a load is in progress"), SlotIndex);
+        return false;
+    }
 
     CurrentSave->LastSaveTime = FDateTime::Now();
     CurrentSave->SaveVersion = 1;
 
-    FString SlotName = GetSlotName(SlotIndex);
-    bool bSuccess = UGameplayStatics::SaveGameToSlot(CurrentSave, SlotName, 0);
+    // The snapshot holds every journaled change, and the play time not journaled yet
+    CurrentSave->JournalSequence = NextJournalSequence - 1;
+    UnjournaledPlayTime = 0.0f;
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    CurrentSave->SerializeCompact(Writer, SaveFormatVersion);
+
+    FSlotWrite& Write = SlotWrites.FindOrAdd(SlotIndex);
+    if (Write.bInFlight)
+    {
+        Write.PendingBytes = MoveTemp(Bytes);
+        Write.PendingSequence = CurrentSave->JournalSequence;
+        Write.bPending = true;
+        return true;
+    }
+
+    LaunchWrite(SlotIndex, MoveTemp(Bytes), CurrentSave->JournalSequence);
+    return true;
+}
+
+void UTowerSaveSubsystem::LaunchWrite(int32 SlotIndex, TArray<uint8>&& Bytes, int64 JournalSequence)
+{
+    FSlotWrite& Write = SlotWrites.FindOrAdd(SlotIndex);
+    Write.bInFlight = true;
+    Write.InFlightSequence = JournalSequence;
+
+    TWeakObjectPtr<UTowerSaveSubsystem> WeakThis(this);
+    Write.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [WeakThis, SlotIndex, Path = GetSlotPath(SlotIndex), Raw = MoveTemp(Bytes)]()
+        {
+            const bool bSuccess = WriteSaveFile(Path, Raw);
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotIndex, bSuccess]()
+            {
+                if (UTowerSaveSubsystem* This = WeakThis.Get())
+                {
+                    This->OnWriteFinished(SlotIndex, bSuccess);
+                }
+            });
+        });
+}
+
+void UTowerSaveSubsystem::OnWriteFinished(int32 SlotIndex, bool bSuccess)
+{
+    FSlotWrite* Write = SlotWrites.Find(SlotIndex);
+    if (!Write) return; // Deinitialized or deleted meanwhile
 
     if (bSuccess)
     {
-        UE_LOG(LogTemp, Log, TEXT("Saved game to slot %d (%s)"), SlotIndex, *SlotName);
+        UE_LOG(LogTemp, Log, TEXT("Saved game to slot %d (%s)"), SlotIndex, *GetSlotName(SlotIndex));
+
+        // The binary file supersedes a slot written by an earlier build
+        const FString SlotName = GetSlotName(SlotIndex);
+        if (UGameplayStatics::DoesSaveGameExist(SlotName, 0))
+        {
+            UGameplayStatics::DeleteGameInSlot(SlotName, 0);
+        }
+
+        // Compact: what the save now holds leaves the journal. Another slot's journal
+        // belongs to the save just overwritten, so none of it applies any more.
+        if (SlotIndex == CurrentSlot)
+        {
+            const int64 Applied = Write->InFlightSequence;
+            JournalRecords.RemoveAll([Applied](const FJournalRecord& Record) { return Record.Sequence <= Applied; });
+            RewriteJournal(SlotIndex);
+        }
+        else
+        {
+            JournalPipe.Launch(UE_SOURCE_LOCATION, [Path = GetJournalPath(SlotIndex)]()
+            {
+                IFileManager::Get().Delete(*Path, false, true, true);
+            });
+        }
     }
     else
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to save game to slot %d"), SlotIndex);
     }
 
-    return bSuccess;
+    Write->bInFlight = false;
+    if (Write->bPending)
+    {
+        Write->bPending = false;
+        LaunchWrite(SlotIndex, MoveTemp(Write->PendingBytes), Write->PendingSequence);
+    }
+
+    OnSaveCompleted.Broadcast(SlotIndex, bSuccess);
+}
+
+void UTowerSaveSubsystem::WaitForWrite(int32 SlotIndex)
+{
+    if (FSlotWrite* Write = SlotWrites.Find(SlotIndex))
+    {
+        Write->Task.Wait();
+    }
+}
+
+bool UTowerSaveSubsystem::RestoreFromBytes(int32 SlotIndex, const TArray<uint8>& Bytes, uint16 FormatVersion)
+{
+    UTowerSaveGame* Loaded = NewObject<UTowerSaveGame>(this);
+    FMemoryReader Reader(Bytes);
+    Loaded->SerializeCompact(Reader, FormatVersion);
+    if (Reader.IsError() || !Reader.AtEnd())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Save slot %d has an unreadable payload"), SlotIndex);
+        return false;
+    }
+
+    SetCurrentSave(Loaded, SlotIndex);
+    UE_LOG(LogTemp, Log, TEXT("Loaded game from slot %d: floor %d, %d items"),
+        SlotIndex, CurrentSave->CurrentFloor, CurrentSave->InventoryItems.Num());
+    return true;
+}
+
+void UTowerSaveSubsystem::SetCurrentSave(UTowerSaveGame* Save, int32 SlotIndex)
+{
+    CurrentSave = Save;
+    CurrentSlot = SlotIndex;
+    ReplayJournal(SlotIndex);
 }
 
 bool UTowerSaveSubsystem::LoadGame(int32 SlotIndex)
 {
+    // A write still in flight is newer than the file on disk
+    WaitForWrite(SlotIndex);
+
+    const FString Path = GetSlotPath(SlotIndex);
+    if (FPaths::FileExists(Path))
+    {
+        TArray<uint8> Bytes;
+        uint16 FormatVersion = 0;
+        return ReadSaveFile(Path, Bytes, FormatVersion, [](float, const TCHAR*) {})
+            && RestoreFromBytes(SlotIndex, Bytes, FormatVersion);
+    }
+
     FString SlotName = GetSlotName(SlotIndex);
 
     USaveGame* Loaded = UGameplayStatics::LoadGameFromSlot(SlotName, 0);
@@ -61,24 +452,119 @@ bool UTowerSaveSubsystem::LoadGame(int32 SlotIndex)
     UTowerSaveGame* TowerSave = Cast<UTowerSaveGame>(Loaded);
     if (!TowerSave) return false;
 
-    CurrentSave = TowerSave;
+    SetCurrentSave(TowerSave, SlotIndex);
     UE_LOG(LogTemp, Log, TEXT("Loaded game from slot %d: floor %d, %d items"),
         SlotIndex, CurrentSave->CurrentFloor, CurrentSave->InventoryItems.Num());
 
     return true;
 }
 
+bool UTowerSaveSubsystem::LoadGameAsync(int32 SlotIndex)
+{
+    if (SlotLoads.Contains(SlotIndex) || !HasSaveGame(SlotIndex)) return false;
+    SlotLoads.Add(SlotIndex);
+    WaitForWrite(SlotIndex);
+
+    OnLoadProgress.Broadcast(SlotIndex, 0.0f, TEXT("Queued"));
+
+    const FString Path = GetSlotPath(SlotIndex);
+    if (!FPaths::FileExists(Path))
+    {
+        // Slot from an earlier build: the engine's own async path, without stages
+        UGameplayStatics::AsyncLoadGameFromSlot(GetSlotName(SlotIndex), 0,
+            FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &UTowerSaveSubsystem::OnLegacyLoaded, SlotIndex));
+        return true;
+    }
+
+    TWeakObjectPtr<UTowerSaveSubsystem> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, SlotIndex, Path]()
+    {
+        auto Progress = [WeakThis, SlotIndex](float Value, const TCHAR* Stage)
+        {
+            AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotIndex, Value, StageName = FString(Stage)]()
+            {
+                if (UTowerSaveSubsystem* This = WeakThis.Get())
+                {
+                    This->OnLoadProgress.Broadcast(SlotIndex, Value, StageName);
+                }
+            });
+        };
+
+        TArray<uint8> Raw;
+        uint16 FormatVersion = 0;
+        const bool bRead = ReadSaveFile(Path, Raw, FormatVersion, Progress);
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotIndex, Raw = MoveTemp(Raw), FormatVersion, bRead]() mutable
+        {
+            if (UTowerSaveSubsystem* This = WeakThis.Get())
+            {
+                This->OnReadFinished(SlotIndex, MoveTemp(Raw), FormatVersion, bRead);
+            }
+        });
+    });
+    return true;
+}
+
+void UTowerSaveSubsystem::OnReadFinished(int32 SlotIndex, TArray<uint8>&& Bytes, uint16 FormatVersion, bool bRead)
+{
+    if (!SlotLoads.Remove(SlotIndex)) return;
+
+    OnLoadProgress.Broadcast(SlotIndex, 0.9f, TEXT("Restoring"));
+    const bool bSuccess = bRead && RestoreFromBytes(SlotIndex, Bytes, FormatVersion);
+    OnLoadProgress.Broadcast(SlotIndex, 1.0f, bSuccess ? TEXT("Done") : TEXT("Failed"));
+    OnLoadCompleted.Broadcast(SlotIndex, bSuccess);
+}
+
+void UTowerSaveSubsystem::OnLegacyLoaded(const FString& SlotName, int32 UserIndex, USaveGame* Loaded, int32 SlotIndex)
+{
+    if (!SlotLoads.Remove(SlotIndex)) return;
+
+    UTowerSaveGame* TowerSave = Cast<UTowerSaveGame>(Loaded);
+    if (TowerSave)
+    {
+        SetCurrentSave(TowerSave, SlotIndex);
+        UE_LOG(LogTemp, Log, TEXT("Loaded game from slot %d: floor %d, %d items"),
+            SlotIndex, CurrentSave->CurrentFloor, CurrentSave->InventoryItems.Num());
+    }
+    OnLoadProgress.Broadcast(SlotIndex, 1.0f, TowerSave ? TEXT("Done") : TEXT("Failed"));
+    OnLoadCompleted.Broadcast(SlotIndex, TowerSave != nullptr);
+}
+
 bool UTowerSaveSubsystem::HasSaveGame(int32 SlotIndex) const
 {
-    return UGameplayStatics::DoesSaveGameExist(GetSlotName(SlotIndex), 0);
+    return FPaths::FileExists(GetSlotPath(SlotIndex))
+        || UGameplayStatics::DoesSaveGameExist(GetSlotName(SlotIndex), 0);
 }
 
 bool UTowerSaveSubsystem::DeleteSaveGame(int32 SlotIndex)
 {
+    if (!HasSaveGame(SlotIndex)) return false;
+
+    // Let the in-flight write land first so it can't recreate the file, and drop the one behind it
+    WaitForWrite(SlotIndex);
+    SlotWrites.Remove(SlotIndex);
+
     FString SlotName = GetSlotName(SlotIndex);
-    if (!UGameplayStatics::DoesSaveGameExist(SlotName, 0)) return false;
+    const FString Path = GetSlotPath(SlotIndex);
+    bool bDeleted = !FPaths::FileExists(Path) || IFileManager::Get().Delete(*Path, false, true, true);
+    if (UGameplayStatics::DoesSaveGameExist(SlotName, 0))
+    {
+        bDeleted &= UGameplayStatics::DeleteGameInSlot(SlotName, 0);
+    }
+
+    // The journal goes with it; the current slot keeps one, emptied, for changes from here on
+    if (SlotIndex == CurrentSlot)
+    {
+        JournalRecords.Reset();
+        RewriteJournal(SlotIndex);
+    }
+    else
+    {
+        JournalPipe.Launch(UE_SOURCE_LOCATION, [Path = GetJournalPath(SlotIndex)]()
+        {
+            IFileManager::Get().Delete(*Path, false, true, true);
+        });
+    }
 
-    bool bDeleted = UGameplayStatics::DeleteGameInSlot(SlotName, 0);
     if (bDeleted)
     {
         UE_LOG(LogTemp, Log, TEXT("Deleted save slot %d"), SlotIndex);
@@ -116,12 +602,12 @@ void UTowerSaveSubsystem::IncrementStat(const FString& StatName, int32 Value)
 {
     if (!CurrentSave) return;
 
-    if (StatName == TEXT("Deaths")) CurrentSave->Stats.TotalDeaths += Value;
-    else if (StatName == TEXT("Monsters")) CurrentSave->Stats.MonstersSlain += Value;
-    else if (StatName == TEXT("Chests")) CurrentSave->Stats.ChestsOpened += Value;
-    else if (StatName == TEXT("Quests")) CurrentSave->Stats.QuestsCompleted += Value;
-    else if (StatName == TEXT("Crafts")) CurrentSave->Stats.ItemsCrafted += Value;
-    else if (StatName == TEXT("Echoes")) CurrentSave->Stats.EchoesEncountered += Value;
+    // Deaths, Monsters, Chests, Quests, Crafts, Echoes
+    const uint8 StatId = FindStatId(StatName);
+    if (StatId != 0)
+    {
+        RecordChange(EJournalOp::IncrementStat, StatId, Value, 0.0f);
+    }
 }
 
 void UTowerSaveSubsystem::UpdateHighestFloor(int32 Floor)
@@ -130,8 +616,7 @@ void UTowerSaveSubsystem::UpdateHighestFloor(int32 Floor)
 
     if (Floor > CurrentSave->Stats.HighestFloor)
     {
-        CurrentSave->Stats.HighestFloor = Floor;
-        CurrentSave->CurrentFloor = Floor;
+        RecordChange(EJournalOp::HighestFloor, 0, Floor, 0.0f);
     }
 }
 
@@ -139,6 +624,14 @@ void UTowerSaveSubsystem::AddPlayTime(float Seconds)
 {
     if (!CurrentSave) return;
     CurrentSave->Stats.TotalPlayTime += Seconds;
+
+    // Called often with small deltas; journal the sum now and then rather than every call
+    UnjournaledPlayTime += Seconds;
+    if (UnjournaledPlayTime >= PlayTimeJournalStep)
+    {
+        RecordChange(EJournalOp::PlayTime, 0, 0, UnjournaledPlayTime, /*bApply=*/false);
+        UnjournaledPlayTime = 0.0f;
+    }
 }
 
 FPlayerSaveSettings UTowerSaveSubsystem::GetSettings() const
@@ -172,3 +665,144 @@ FString UTowerSaveSubsystem::GetSlotName(int32 SlotIndex) const
 {
     return FString::Printf(TEXT("TowerSave_%d"), SlotIndex);
 }
+
+FString UTowerSaveSubsystem::GetSlotPath(int32 SlotIndex) const
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / GetSlotName(SlotIndex) + SaveExtension;
+}
+
+FString UTowerSaveSubsystem::GetJournalPath(int32 SlotIndex) const
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / GetSlotName(SlotIndex) + JournalExtension;
+}
+
+// ===========================
+// Journal
+// ===========================
+
+void UTowerSaveSubsystem::RecordChange(EJournalOp Op, uint8 Stat, int32 IntValue, float FloatValue, bool bApply)
+{
+    static_assert(sizeof(FJournalRecord) == 24, "Journal record layout changed; bump JournalFormatVersion");
+
+    FJournalRecord Record;
+    Record.Sequence = NextJournalSequence++;
+    Record.Op = Op;
+    Record.Stat = Stat;
+    Record.IntValue = IntValue;
+    Record.FloatValue = FloatValue;
+    Record.Crc = FCrc::MemCrc32(&Record, STRUCT_OFFSET(FJournalRecord, Crc));
+
+    if (bApply)
+    {
+        ApplyJournalRecord(Record);
+    }
+    JournalRecords.Add(Record);
+
+    // One record and a flush to the device: all it takes to make the change durable
+    JournalPipe.Launch(UE_SOURCE_LOCATION, [this, Record]()
+    {
+        if (JournalFile && JournalFile->Write(reinterpret_cast<const uint8*>(&Record), sizeof(Record)))
+        {
+            JournalFile->Flush(/*bFullFlush=*/true);
+        }
+    });
+
+    // Keep replay short; on failure the next multiple tries again
+    if (JournalRecords.Num() % JournalCompactRecords == 0)
+    {
+        SaveGame(CurrentSlot);
+    }
+}
+
+void UTowerSaveSubsystem::ApplyJournalRecord(const FJournalRecord& Record)
+{
+    FPlayerSaveStats& Stats = CurrentSave->Stats;
+    switch (Record.Op)
+    {
+        case EJournalOp::IncrementStat:
+            if (int32* Stat = FindStat(Stats, Record.Stat))
+            {
+                *Stat += Record.IntValue;
+            }
+            break;
+        case EJournalOp::HighestFloor:
+            if (Record.IntValue > Stats.HighestFloor)
+            {
+                Stats.HighestFloor = Record.IntValue;
+                CurrentSave->CurrentFloor = Record.IntValue;
+            }
+            break;
+        case EJournalOp::PlayTime:
+            Stats.TotalPlayTime += Record.FloatValue;
+            break;
+    }
+}
+
+void UTowerSaveSubsystem::ReplayJournal(int32 SlotIndex)
+{
+    if (!CurrentSave) return;
+
+    // Appends still queued belong to the journal being replaced; let them land first
+    JournalPipe.WaitUntilEmpty();
+
+    JournalRecords.Reset();
+    UnjournaledPlayTime = 0.0f;
+    NextJournalSequence = CurrentSave->JournalSequence + 1;
+
+    TArray<uint8> Bytes;
+    const int32 HeaderSize = sizeof(FJournalHeader);
+    const int32 RecordSize = sizeof(FJournalRecord);
+    if (FFileHelper::LoadFileToArray(Bytes, *GetJournalPath(SlotIndex), FILEREAD_Silent) && Bytes.Num() >= HeaderSize)
+    {
+        FJournalHeader Header;
+        FMemory::Memcpy(&Header, Bytes.GetData(), HeaderSize);
+        if (Header.Magic == JournalMagic && Header.FormatVersion == JournalFormatVersion)
+        {
+            // Whole, intact records only: a crash mid-append leaves a torn tail, which is dropped
+            for (int32 Offset = HeaderSize; Offset + RecordSize <= Bytes.Num(); Offset += RecordSize)
+            {
+                FJournalRecord Record;
+                FMemory::Memcpy(&Record, Bytes.GetData() + Offset, RecordSize);
+                if (Record.Crc != FCrc::MemCrc32(&Record, STRUCT_OFFSET(FJournalRecord, Crc))) break;
+
+                // Already in the save: compaction wrote it but didn't get to trim the journal
+                if (Record.Sequence <= CurrentSave->JournalSequence) continue;
+
+                ApplyJournalRecord(Record);
+                JournalRecords.Add(Record);
+                NextJournalSequence = FMath::Max(NextJournalSequence, Record.Sequence + 1);
+            }
+        }
+    }
+
+    if (JournalRecords.Num() > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Replayed %d journaled changes onto slot %d"), JournalRecords.Num(), SlotIndex);
+    }
+
+    RewriteJournal(SlotIndex);
+}
+
+void UTowerSaveSubsystem::RewriteJournal(int32 SlotIndex)
+{
+    const FJournalHeader Header = { JournalMagic, JournalFormatVersion };
+    TArray<uint8> Bytes;
+    Bytes.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+    Bytes.Append(reinterpret_cast<const uint8*>(JournalRecords.GetData()), JournalRecords.Num() * sizeof(FJournalRecord));
+
+    // On the pipe, behind any append still queued, and swapping the handle only there
+    JournalPipe.Launch(UE_SOURCE_LOCATION, [this, Path = GetJournalPath(SlotIndex), Bytes = MoveTemp(Bytes)]()
+    {
+        JournalFile.Reset();
+
+        const FString TempPath = Path + TEXT(".tmp");
+        if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true, true))
+        {
+            // The old journal stays; replay skips what a save already holds
+            IFileManager::Get().Delete(*TempPath, false, true, true);
+            UE_LOG(LogTemp, Warning, TEXT("TowerSave: failed to rewrite journal %s"), *Path);
+        }
+
+        JournalFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, /*bAppend=*/true));
+    });
+}
@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/SaveGame.h"
+#include "Tasks/Task.h"
+#include "Tasks/Pipe.h"
+#include "GenericPlatform/GenericPlatformFile.h"
 #include "TowerSaveGame.generated.h"
 
 /// Saved player statistics
@@ -47,7 +50,9 @@ struct FFactionRepSave
     UPROPERTY(BlueprintReadWrite) FString Tier; // Hostile, Unfriendly, Neutral, Friendly, Honored, Exalted
 };
 
-/// Saved inventory item
+/// Saved inventory item. A cataloged item (FTowerItemCatalog) leaves Category and
+/// LootJson empty and keeps its rolled tags in TagNames/TagValues; it is saved by
+/// name, which unlike the catalog id holds across core versions.
 USTRUCT(BlueprintType)
 struct FInventoryItemSave
 {
@@ -58,10 +63,16 @@ struct FInventoryItemSave
     UPROPERTY(BlueprintReadWrite) FString Rarity;
     UPROPERTY(BlueprintReadWrite) int32 Quantity = 1;
     UPROPERTY(BlueprintReadWrite) FString LootJson; // Full loot data for tooltip
+    UPROPERTY(BlueprintReadWrite) TArray<FName> TagNames;
+    UPROPERTY(BlueprintReadWrite) TArray<float> TagValues;
+
+    bool IsCataloged() const { return Category.IsEmpty() && LootJson.IsEmpty(); }
 };
 
 /**
- * Local save game. Persisted via UGameplayStatics::SaveGameToSlot.
+ * Local save game. Persisted by UTowerSaveSubsystem as a compressed binary
+ * file (SerializeCompact); slots written by UGameplayStatics::SaveGameToSlot
+ * in earlier builds still load.
  * Server (Nakama) is authoritative; this is for offline/fast-resume.
  */
 UCLASS()
@@ -97,11 +108,41 @@ public:
     UPROPERTY(BlueprintReadWrite) FDateTime LastSaveTime;
     UPROPERTY(BlueprintReadWrite) int32 SaveVersion = 1;
     UPROPERTY(BlueprintReadWrite) FString GameVersion;
+
+    /** Last stat journal record folded into this save; replay starts after it */
+    UPROPERTY() int64 JournalSequence = 0;
+
+    /**
+     * Every field above, in declaration order, with no property tags: the
+     * payload of a .tsav file. Reads and writes through the same function, so
+     * a new field goes at the end, behind a check of FormatVersion (the
+     * file's), and bumps the file format version.
+     */
+    void SerializeCompact(FArchive& Ar, uint16 FormatVersion);
 };
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTowerSaveCompleted, int32, SlotIndex, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTowerLoadCompleted, int32, SlotIndex, bool, bSuccess);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnTowerLoadProgress, int32, SlotIndex, float, Progress, const FString&, Stage);
+
 /**
  * Save game manager subsystem.
  * Handles auto-save, manual save/load, slot management.
+ *
+ * SaveGame snapshots CurrentSave into a binary buffer on the game thread
+ * (a linear copy, no reflection), then compresses it and writes it on a
+ * worker, replacing the slot file atomically; OnSaveCompleted reports the
+ * result. A save to a slot that is still being written waits and replaces
+ * any save already waiting, so only the newest snapshot is written next.
+ * LoadGameAsync reads and decompresses on a worker, reporting OnLoadProgress
+ * along the way, and restores on the game thread.
+ *
+ * Stat changes (IncrementStat, UpdateHighestFloor, AddPlayTime) don't wait
+ * for the next full save: each is appended to the slot's journal
+ * (TowerSave_N.tjr), a few bytes flushed to disk in order on a pipe. Saving
+ * compacts the journal, dropping the records the save now holds, and
+ * loading replays whatever the save doesn't hold yet, so a crash loses
+ * nothing already journaled while full writes stay at the auto-save rate.
  */
 UCLASS()
 class TOWERGAME_API UTowerSaveSubsystem : public UGameInstanceSubsystem
@@ -110,10 +151,15 @@ class TOWERGAME_API UTowerSaveSubsystem : public UGameInstanceSubsystem
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
 
     // --- Save/Load ---
+    /** Snapshot and queue the write; false if there was nothing to save. The outcome arrives on OnSaveCompleted. */
     UFUNCTION(BlueprintCallable) bool SaveGame(int32 SlotIndex = 0);
+    /** Blocking load, for startup; prefer LoadGameAsync once the game is running */
     UFUNCTION(BlueprintCallable) bool LoadGame(int32 SlotIndex = 0);
+    /** Read on a worker; false if the slot is empty or already loading. The outcome arrives on OnLoadCompleted. */
+    UFUNCTION(BlueprintCallable) bool LoadGameAsync(int32 SlotIndex = 0);
     UFUNCTION(BlueprintCallable) bool HasSaveGame(int32 SlotIndex = 0) const;
     UFUNCTION(BlueprintCallable) bool DeleteSaveGame(int32 SlotIndex = 0);
 
@@ -138,10 +184,82 @@ public:
     UFUNCTION(BlueprintCallable) FString GetCachedAuthToken() const;
     UFUNCTION(BlueprintCallable) void CacheAuthToken(const FString& UserId, const FString& Token);
 
+    // --- Events (game thread) ---
+    UPROPERTY(BlueprintAssignable) FOnTowerSaveCompleted OnSaveCompleted;
+    UPROPERTY(BlueprintAssignable) FOnTowerLoadCompleted OnLoadCompleted;
+    UPROPERTY(BlueprintAssignable) FOnTowerLoadProgress OnLoadProgress;
+
 private:
     UPROPERTY() UTowerSaveGame* CurrentSave = nullptr;
 
     FString GetSlotName(int32 SlotIndex) const;
+    FString GetSlotPath(int32 SlotIndex) const;
+    FString GetJournalPath(int32 SlotIndex) const;
+
+    /** Per-slot write state: at most one write in flight, and the newest snapshot waiting behind it */
+    struct FSlotWrite
+    {
+        UE::Tasks::FTask Task;
+        bool bInFlight = false;
+        bool bPending = false;
+        TArray<uint8> PendingBytes;
+        int64 InFlightSequence = 0;
+        int64 PendingSequence = 0;
+    };
+
+    TMap<int32, FSlotWrite> SlotWrites;
+    TSet<int32> SlotLoads;
+
+    void LaunchWrite(int32 SlotIndex, TArray<uint8>&& Bytes, int64 JournalSequence);
+    void OnWriteFinished(int32 SlotIndex, bool bSuccess);
+    void OnReadFinished(int32 SlotIndex, TArray<uint8>&& Bytes, uint16 FormatVersion, bool bRead);
+    void OnLegacyLoaded(const FString& SlotName, int32 UserIndex, USaveGame* Loaded, int32 SlotIndex);
+    bool RestoreFromBytes(int32 SlotIndex, const TArray<uint8>& Bytes, uint16 FormatVersion);
+    void SetCurrentSave(UTowerSaveGame* Save, int32 SlotIndex);
+    void WaitForWrite(int32 SlotIndex);
+
+    // --- Journal ---
+    enum class EJournalOp : uint8
+    {
+        IncrementStat = 1,
+        HighestFloor = 2,
+        PlayTime = 3,
+    };
+
+    /** One record in a .tjr file, as written */
+    struct FJournalRecord
+    {
+        int64 Sequence = 0;
+        EJournalOp Op = EJournalOp::IncrementStat;
+        uint8 Stat = 0;
+        uint16 Reserved = 0;
+        int32 IntValue = 0;
+        float FloatValue = 0.0f;
+        uint32 Crc = 0;
+    };
+
+    /** Records appended to CurrentSlot's journal are compacted once this many are outstanding */
+    static constexpr int32 JournalCompactRecords = 256;
+
+    /** Play time is journaled in steps of this many seconds, not per call */
+    static constexpr float PlayTimeJournalStep = 5.0f;
+
+    int32 CurrentSlot = 0;
+    int64 NextJournalSequence = 1;
+    float UnjournaledPlayTime = 0.0f;
+
+    /** Journaled but not yet in a save on disk; what a compaction rewrites the journal with */
+    TArray<FJournalRecord> JournalRecords;
+
+    /** Open for append on CurrentSlot's journal; touched only by tasks on JournalPipe */
+    TUniquePtr<IFileHandle> JournalFile;
+    UE::Tasks::FPipe JournalPipe{ TEXT("TowerSaveJournal") };
+
+    /** Journal a change, applying it to CurrentSave first unless the caller already has */
+    void RecordChange(EJournalOp Op, uint8 Stat, int32 IntValue, float FloatValue, bool bApply = true);
+    void ApplyJournalRecord(const FJournalRecord& Record);
+    void ReplayJournal(int32 SlotIndex);
+    void RewriteJournal(int32 SlotIndex);
 
     bool bAutoSaveEnabled = false;
     float AutoSaveInterval = 60.0f;
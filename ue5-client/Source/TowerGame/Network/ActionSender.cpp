@@ -1,10 +1,16 @@
 #include "ActionSender.h"
+#include "BincodeSerializer.h"
+#include "NetcodeClient.h"
+#include "ReplicationManager.h"
+#include "TowerNetworkSubsystem.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonSerializer.h"
 #include "Engine/World.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/Pawn.h"
+#include "Algo/BinarySearch.h"
 
 // Forward-declared; include when the gRPC module is integrated
 // #include "GRPCClient/TowerGRPCClientManager.h"
@@ -18,7 +24,7 @@ DEFINE_LOG_CATEGORY_STATIC(LogActionSender, Log, All);
 UTowerActionSender::UTowerActionSender()
 {
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.TickInterval = 0.1f; // 10 Hz for timeout checks
+	PrimaryComponentTick.TickInterval = 0.05f; // 20 Hz, the netcode send tick: flushes the outbound queue and checks timeouts
 }
 
 void UTowerActionSender::BeginPlay()
@@ -27,8 +33,15 @@ void UTowerActionSender::BeginPlay()
 
 	SequenceCounter = 0;
 	PendingActions.Empty();
+	OutboundActions.Empty();
+	TimeoutWheel.Reset();
 	LastActionTime.Empty();
 	CachedClientManager = nullptr;
+	CachedNetcodeClient.Reset();
+	RedundantActionsSent = 0;
+	TimedOutActionCount = 0;
+	CoalescedMoveCount = 0;
+	DeferredActionCount = 0;
 
 	UE_LOG(LogActionSender, Log, TEXT("ActionSender initialized on %s"), *GetOwner()->GetName());
 }
@@ -42,6 +55,8 @@ void UTowerActionSender::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	}
 
 	PendingActions.Empty();
+	OutboundActions.Empty();
+	TimeoutWheel.Reset();
 	LastActionTime.Empty();
 	CachedClientManager = nullptr;
 
@@ -53,6 +68,7 @@ void UTowerActionSender::TickComponent(float DeltaTime, ELevelTick TickType,
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	FlushOutbound();
 	PurgeTimedOutActions();
 }
 
@@ -68,15 +84,23 @@ bool UTowerActionSender::SendMoveAction(FVector Direction, bool bSprinting)
 		return false;
 	}
 
-	if (!CheckRateLimit(EPlayerActionType::Move)) return false;
-	if (!CanEnqueueAction()) return false;
+	// No per-type rate limit: a queued move is replaced by the newest one, and moves leave at most once a tick
+	if (!CanEnqueueAction(EPlayerActionType::Move)) return false;
 
 	FMoveActionData Data;
 	Data.Direction = Direction.GetSafeNormal();
 	Data.bSprinting = bSprinting;
 
+	if (GetNetcodeClient())
+	{
+		FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Move);
+		FBincodeWriter Writer = BeginBinaryAction();
+		WriteMoveData(Writer, Data);
+		return QueueBinaryAction(Packet);
+	}
+
 	FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Move, SerializeMoveData(Data));
-	return EnqueueAndSend(Packet);
+	return QueueAction(Packet);
 }
 
 bool UTowerActionSender::SendAttackAction(const FString& WeaponId, int32 ComboStep, FVector Direction)
@@ -101,15 +125,23 @@ bool UTowerActionSender::SendAttackAction(const FString& WeaponId, int32 ComboSt
 	}
 
 	if (!CheckRateLimit(EPlayerActionType::Attack)) return false;
-	if (!CanEnqueueAction()) return false;
+	if (!CanEnqueueAction(EPlayerActionType::Attack)) return false;
 
 	FAttackActionData Data;
 	Data.WeaponId = WeaponId;
 	Data.ComboStep = ComboStep;
 	Data.Direction = Direction.GetSafeNormal();
 
+	if (GetNetcodeClient())
+	{
+		FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Attack);
+		FBincodeWriter Writer = BeginBinaryAction();
+		WriteAttackData(Writer, Data);
+		return QueueBinaryAction(Packet);
+	}
+
 	FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Attack, SerializeAttackData(Data));
-	return EnqueueAndSend(Packet);
+	return QueueAction(Packet);
 }
 
 bool UTowerActionSender::SendParryAction(int64 TimingMs)
@@ -121,13 +153,21 @@ bool UTowerActionSender::SendParryAction(int64 TimingMs)
 	}
 
 	if (!CheckRateLimit(EPlayerActionType::Parry)) return false;
-	if (!CanEnqueueAction()) return false;
+	if (!CanEnqueueAction(EPlayerActionType::Parry)) return false;
 
 	FParryActionData Data;
 	Data.TimingMs = TimingMs;
 
+	if (GetNetcodeClient())
+	{
+		FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Parry);
+		FBincodeWriter Writer = BeginBinaryAction();
+		WriteParryData(Writer, Data);
+		return QueueBinaryAction(Packet);
+	}
+
 	FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Parry, SerializeParryData(Data));
-	return EnqueueAndSend(Packet);
+	return QueueAction(Packet);
 }
 
 bool UTowerActionSender::SendDodgeAction(FVector Direction)
@@ -139,13 +179,21 @@ bool UTowerActionSender::SendDodgeAction(FVector Direction)
 	}
 
 	if (!CheckRateLimit(EPlayerActionType::Dodge)) return false;
-	if (!CanEnqueueAction()) return false;
+	if (!CanEnqueueAction(EPlayerActionType::Dodge)) return false;
 
 	FDodgeActionData Data;
 	Data.Direction = Direction.GetSafeNormal();
 
+	if (GetNetcodeClient())
+	{
+		FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Dodge);
+		FBincodeWriter Writer = BeginBinaryAction();
+		WriteDodgeData(Writer, Data);
+		return QueueBinaryAction(Packet);
+	}
+
 	FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Dodge, SerializeDodgeData(Data));
-	return EnqueueAndSend(Packet);
+	return QueueAction(Packet);
 }
 
 bool UTowerActionSender::SendAbilityAction(const FString& AbilityId, FVector TargetPos, int64 TargetEntity)
@@ -157,15 +205,23 @@ bool UTowerActionSender::SendAbilityAction(const FString& AbilityId, FVector Tar
 	}
 
 	if (!CheckRateLimit(EPlayerActionType::UseAbility)) return false;
-	if (!CanEnqueueAction()) return false;
+	if (!CanEnqueueAction(EPlayerActionType::UseAbility)) return false;
 
 	FAbilityActionData Data;
 	Data.AbilityId = AbilityId;
 	Data.TargetPosition = TargetPos;
 	Data.TargetEntity = TargetEntity;
 
+	if (GetNetcodeClient())
+	{
+		FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::UseAbility);
+		FBincodeWriter Writer = BeginBinaryAction();
+		WriteAbilityData(Writer, Data);
+		return QueueBinaryAction(Packet);
+	}
+
 	FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::UseAbility, SerializeAbilityData(Data));
-	return EnqueueAndSend(Packet);
+	return QueueAction(Packet);
 }
 
 bool UTowerActionSender::SendInteractAction(int64 TargetEntity, const FString& InteractionType)
@@ -185,14 +241,22 @@ bool UTowerActionSender::SendInteractAction(int64 TargetEntity, const FString& I
 	}
 
 	if (!CheckRateLimit(EPlayerActionType::Interact)) return false;
-	if (!CanEnqueueAction()) return false;
+	if (!CanEnqueueAction(EPlayerActionType::Interact)) return false;
 
 	FInteractActionData Data;
 	Data.TargetEntity = TargetEntity;
 	Data.InteractionType = InteractionType;
 
+	if (GetNetcodeClient())
+	{
+		FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Interact);
+		FBincodeWriter Writer = BeginBinaryAction();
+		WriteInteractData(Writer, Data);
+		return QueueBinaryAction(Packet);
+	}
+
 	FPlayerActionPacket Packet = CreatePacket(EPlayerActionType::Interact, SerializeInteractData(Data));
-	return EnqueueAndSend(Packet);
+	return QueueAction(Packet);
 }
 
 // ============================================================================
@@ -202,11 +266,7 @@ bool UTowerActionSender::SendInteractAction(int64 TargetEntity, const FString& I
 void UTowerActionSender::ProcessActionResult(const FActionResult& Result)
 {
 	// Remove from pending queue
-	int32 RemovedIndex = PendingActions.IndexOfByPredicate(
-		[&Result](const FPlayerActionPacket& Packet)
-		{
-			return Packet.SequenceNumber == Result.SequenceNumber;
-		});
+	const int32 RemovedIndex = FindPendingAction(Result.SequenceNumber);
 
 	if (RemovedIndex == INDEX_NONE)
 	{
@@ -236,16 +296,21 @@ void UTowerActionSender::ProcessActionResult(const FActionResult& Result)
 		OnActionRejected.Broadcast(Result.SequenceNumber, Result.RejectionReason);
 	}
 
+	TimeoutWheel.Cancel(PendingActions[RemovedIndex].TimeoutTimer);
 	PendingActions.RemoveAt(RemovedIndex);
 }
 
 bool UTowerActionSender::IsActionPending(int64 SequenceNumber) const
 {
-	return PendingActions.ContainsByPredicate(
-		[SequenceNumber](const FPlayerActionPacket& Packet)
-		{
-			return Packet.SequenceNumber == SequenceNumber;
-		});
+	return FindPendingAction(SequenceNumber) != INDEX_NONE;
+}
+
+int32 UTowerActionSender::FindPendingAction(int64 SequenceNumber) const
+{
+	// Appended as they are flushed, and flushing assigns sequence numbers in order
+	const int32 Index = Algo::LowerBoundBy(PendingActions, SequenceNumber, &FPlayerActionPacket::SequenceNumber);
+	return PendingActions.IsValidIndex(Index) && PendingActions[Index].SequenceNumber == SequenceNumber
+		? Index : INDEX_NONE;
 }
 
 // ============================================================================
@@ -269,18 +334,156 @@ bool UTowerActionSender::CheckRateLimit(EPlayerActionType ActionType)
 	return true;
 }
 
-bool UTowerActionSender::CanEnqueueAction() const
+bool UTowerActionSender::CanEnqueueAction(EPlayerActionType ActionType) const
 {
-	if (PendingActions.Num() >= MaxPendingActions)
+	// A move replaces the one already queued, so it takes no new slot
+	if (ActionType == EPlayerActionType::Move && OutboundActions.ContainsByPredicate(
+		[](const FQueuedAction& Queued) { return Queued.Packet.ActionType == EPlayerActionType::Move; }))
+	{
+		return true;
+	}
+
+	const int32 Used = PendingActions.Num() + OutboundActions.Num();
+	const int32 Limit = GetActionPriority(ActionType) == EActionPriority::Critical
+		? MaxPendingActions
+		: FMath::Max(MaxPendingActions - CriticalReserveSlots, 1);
+
+	if (Used >= Limit)
 	{
 		UE_LOG(LogActionSender, Warning,
-			TEXT("Pending action queue full (%d/%d). Dropping action."),
-			PendingActions.Num(), MaxPendingActions);
+			TEXT("Pending action queue full (%d/%d) for %s. Dropping action."),
+			Used, Limit, *UEnum::GetValueAsString(ActionType));
 		return false;
 	}
 	return true;
 }
 
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+EActionPriority UTowerActionSender::GetActionPriority(EPlayerActionType ActionType)
+{
+	switch (ActionType)
+	{
+	case EPlayerActionType::Attack:
+	case EPlayerActionType::Parry:
+	case EPlayerActionType::Dodge:
+		return EActionPriority::Critical;
+	case EPlayerActionType::UseAbility:
+		return EActionPriority::Ability;
+	case EPlayerActionType::Interact:
+		return EActionPriority::Interaction;
+	default:
+		return EActionPriority::Movement;
+	}
+}
+
+int32 UTowerActionSender::GetScheduledRank(const FQueuedAction& Queued, double Now) const
+{
+	const int32 Rank = static_cast<int32>(Queued.Priority);
+	if (ActionAgingSeconds <= 0.0f)
+	{
+		return Rank;
+	}
+
+	const int32 Promotions = FMath::FloorToInt32((Now - Queued.QueuedTime) / ActionAgingSeconds);
+	return FMath::Max(Rank - Promotions, 0);
+}
+
+int32 UTowerActionSender::GetWireBytes(const FPlayerActionPacket& Packet)
+{
+	return Packet.bBinaryTransport
+		? ACTION_ENTRY_HEADER_BYTES + Packet.BinaryPayload.Num()
+		: JSON_ENVELOPE_BYTES + Packet.ActionDataJson.Len();
+}
+
+bool UTowerActionSender::QueueAction(FPlayerActionPacket& Packet)
+{
+	if (Packet.ActionType == EPlayerActionType::Move)
+	{
+		// Only the latest heading matters; the server would apply a stale one and then correct it
+		for (FQueuedAction& Queued : OutboundActions)
+		{
+			if (Queued.Packet.ActionType == EPlayerActionType::Move)
+			{
+				Queued.Packet = MoveTemp(Packet);
+				++CoalescedMoveCount;
+				return true;
+			}
+		}
+	}
+
+	FQueuedAction& Queued = OutboundActions.AddDefaulted_GetRef();
+	Queued.Priority = GetActionPriority(Packet.ActionType);
+	Queued.QueuedTime = FPlatformTime::Seconds();
+	Queued.Packet = MoveTemp(Packet);
+	return true;
+}
+
+void UTowerActionSender::FlushOutbound()
+{
+	if (OutboundActions.Num() == 0) return;
+
+	const double Now = FPlatformTime::Seconds();
+
+	// Stable, so actions of one rank keep their arrival order
+	OutboundActions.StableSort([this, Now](const FQueuedAction& A, const FQueuedAction& B)
+		{
+			return GetScheduledRank(A, Now) < GetScheduledRank(B, Now);
+		});
+
+	const int32 FirstNew = PendingActions.Num();
+	int32 BytesUsed = 0;
+	bool bAnyBinary = false;
+
+	for (int32 i = 0; i < OutboundActions.Num();)
+	{
+		const FQueuedAction& Queued = OutboundActions[i];
+		const int32 Cost = GetWireBytes(Queued.Packet);
+
+		// The first action always fits, so one bigger than the budget can't wedge the queue
+		if (Queued.Priority != EActionPriority::Critical && BytesUsed > 0 && BytesUsed + Cost > MaxBytesPerTick)
+		{
+			++DeferredActionCount;
+			++i;
+			continue;
+		}
+
+		BytesUsed += Cost;
+		FPlayerActionPacket& Packet = PendingActions.Add_GetRef(MoveTemp(OutboundActions[i].Packet));
+		OutboundActions.RemoveAt(i);
+
+		Packet.SequenceNumber = ++SequenceCounter;
+		Packet.LocalSendTime = Now;
+		Packet.TimeoutTimer = TimeoutWheel.Add(Now, PendingActionTimeout, Packet.SequenceNumber);
+
+		if (Packet.bBinaryTransport)
+		{
+			bAnyBinary = true;
+		}
+		else
+		{
+			SendJsonAction(Packet);
+		}
+	}
+
+	if (bAnyBinary)
+	{
+		if (UNetcodeClient* Netcode = GetNetcodeClient())
+		{
+			SendBinaryActions(FirstNew, Netcode);
+		}
+		else
+		{
+			// Stays pending; a later datagram repeats it within the window, or the timeout reports it
+			UE_LOG(LogActionSender, Warning,
+				TEXT("Netcode connection lost before flush; %d binary actions left pending"),
+				PendingActions.Num() - FirstNew);
+		}
+	}
+}
+
 // ============================================================================
 // Validation
 // ============================================================================
@@ -315,22 +518,18 @@ FPlayerActionPacket UTowerActionSender::CreatePacket(EPlayerActionType ActionTyp
 	Packet.ActionDataJson = ActionDataJson;
 	Packet.Timestamp = FDateTime::UtcNow().ToUnixTimestamp() * 1000
 		+ FDateTime::UtcNow().GetMillisecond();
-	Packet.SequenceNumber = ++SequenceCounter;
-	Packet.LocalSendTime = FPlatformTime::Seconds();
 	return Packet;
 }
 
-bool UTowerActionSender::EnqueueAndSend(FPlayerActionPacket& Packet)
+void UTowerActionSender::SendJsonAction(const FPlayerActionPacket& Packet)
 {
-	PendingActions.Add(Packet);
-
 	UTowerGRPCClientManager* Manager = GetClientManager();
 	if (!Manager)
 	{
 		UE_LOG(LogActionSender, Warning,
 			TEXT("No gRPC client manager available. Action seq=%llu queued locally."),
 			Packet.SequenceNumber);
-		return true; // Queued, will send when connection is available
+		return; // Stays pending, will send when connection is available
 	}
 
 	// Build the wire-format JSON envelope for gRPC transmission
@@ -351,8 +550,160 @@ bool UTowerActionSender::EnqueueAndSend(FPlayerActionPacket& Packet)
 	UE_LOG(LogActionSender, Verbose,
 		TEXT("Sent action: seq=%llu type=%s"),
 		Packet.SequenceNumber, *UEnum::GetValueAsString(Packet.ActionType));
+}
 
-	return true;
+FBincodeWriter UTowerActionSender::BeginBinaryAction()
+{
+	ActionPayloadBuffer.Reset();
+	return FBincodeWriter(ActionPayloadBuffer);
+}
+
+void UTowerActionSender::WriteActionEntry(FBincodeWriter& Writer, const FPlayerActionPacket& Packet)
+{
+	// Entry: action, sequence (wraps at u32), client send time (ms, low 32 bits), payload length, payload
+	Writer.WriteU8(static_cast<uint8>(Packet.ActionType));
+	Writer.WriteU32(static_cast<uint32>(Packet.SequenceNumber));
+	Writer.WriteU32(static_cast<uint32>(Packet.Timestamp));
+	Writer.WriteU16(static_cast<uint16>(Packet.BinaryPayload.Num()));
+	Writer.WriteBytes(Packet.BinaryPayload.GetData(), Packet.BinaryPayload.Num());
+}
+
+bool UTowerActionSender::QueueBinaryAction(FPlayerActionPacket& Packet)
+{
+	Packet.BinaryPayload = ActionPayloadBuffer;
+	Packet.bBinaryTransport = true;
+	return QueueAction(Packet);
+}
+
+int32 UTowerActionSender::BeginActionDatagram(FBincodeWriter& Writer)
+{
+	BinarySendBuffer.Reset();
+	Writer.WriteU8(ACTION_PACKET_TYPE);
+	const int32 CountOffset = BinarySendBuffer.Num();
+	Writer.WriteU8(0);
+	return CountOffset;
+}
+
+void UTowerActionSender::SendBinaryActions(int32 FirstNew, UNetcodeClient* Netcode)
+{
+	// Datagram: type, entry count, then entries newest first. The server applies each
+	// sequence number once, so repeats of actions it already has are discarded there.
+	FBincodeWriter Writer(BinarySendBuffer);
+	int32 CountOffset = BeginActionDatagram(Writer);
+	uint8 EntryCount = 0;
+	int32 Datagrams = 0;
+
+	auto SendDatagram = [&]()
+	{
+		BinarySendBuffer[CountOffset] = EntryCount;
+		++Datagrams;
+		if (!Netcode->SendPacket(BinarySendBuffer, ETowerNetChannel::Action))
+		{
+			// Stays pending; the next datagram repeats it, and the timeout path reports it if it never lands
+			UE_LOG(LogActionSender, Warning,
+				TEXT("Binary send failed for %d actions (%d bytes)"), EntryCount, BinarySendBuffer.Num());
+		}
+	};
+
+	// Everything flushed this tick goes, in as many datagrams as it takes
+	int32 i = PendingActions.Num() - 1;
+	for (; i >= FirstNew; --i)
+	{
+		const FPlayerActionPacket& Packet = PendingActions[i];
+		if (!Packet.bBinaryTransport)
+		{
+			continue;
+		}
+		if (EntryCount > 0 && BinarySendBuffer.Num() + ACTION_ENTRY_HEADER_BYTES + Packet.BinaryPayload.Num() > MAX_ACTION_DATAGRAM_BYTES)
+		{
+			SendDatagram();
+			CountOffset = BeginActionDatagram(Writer);
+			EntryCount = 0;
+		}
+
+		WriteActionEntry(Writer, Packet);
+		++EntryCount;
+	}
+
+	// Then earlier unacked actions ride along in whatever room the last datagram has
+	const double OldestRepeat = FPlatformTime::Seconds() - static_cast<double>(RedundantActionWindow);
+	int32 Repeated = 0;
+
+	for (; i >= 0 && EntryCount < RedundantActionCount; --i)
+	{
+		const FPlayerActionPacket& Earlier = PendingActions[i];
+		if (Earlier.LocalSendTime < OldestRepeat)
+		{
+			break;
+		}
+		if (!Earlier.bBinaryTransport)
+		{
+			continue;
+		}
+		if (BinarySendBuffer.Num() + ACTION_ENTRY_HEADER_BYTES + Earlier.BinaryPayload.Num() > MAX_ACTION_DATAGRAM_BYTES)
+		{
+			break;
+		}
+
+		WriteActionEntry(Writer, Earlier);
+		++EntryCount;
+		++Repeated;
+	}
+
+	SendDatagram();
+	RedundantActionsSent += Repeated;
+
+	UE_LOG(LogActionSender, Verbose,
+		TEXT("Sent binary actions: seq=%llu..%llu repeated=%d datagrams=%d"),
+		PendingActions[FirstNew].SequenceNumber, PendingActions.Last().SequenceNumber, Repeated, Datagrams);
+}
+
+// ============================================================================
+// Binary Serialization
+// ============================================================================
+
+void UTowerActionSender::WriteGroundDirection(FBincodeWriter& Writer, const FVector& Direction)
+{
+	// UE5 X-forward/Y-right -> Bevy Z-forward/X-right; vertical is dropped
+	const FVector2D Ground = FVector2D(Direction.Y, Direction.X).GetSafeNormal();
+	Writer.WriteSNorm16(static_cast<float>(Ground.X));
+	Writer.WriteSNorm16(static_cast<float>(Ground.Y));
+}
+
+void UTowerActionSender::WriteMoveData(FBincodeWriter& Writer, const FMoveActionData& Data)
+{
+	WriteGroundDirection(Writer, Data.Direction);
+	Writer.WriteU8(Data.bSprinting ? 0x01 : 0x00); // Flags
+}
+
+void UTowerActionSender::WriteAttackData(FBincodeWriter& Writer, const FAttackActionData& Data)
+{
+	Writer.WriteString(Data.WeaponId);
+	Writer.WriteU8(static_cast<uint8>(FMath::Clamp(Data.ComboStep, 0, 255)));
+	WriteGroundDirection(Writer, Data.Direction);
+}
+
+void UTowerActionSender::WriteParryData(FBincodeWriter& Writer, const FParryActionData& Data)
+{
+	Writer.WriteU16(static_cast<uint16>(FMath::Clamp<int64>(Data.TimingMs, 0, MAX_uint16)));
+}
+
+void UTowerActionSender::WriteDodgeData(FBincodeWriter& Writer, const FDodgeActionData& Data)
+{
+	WriteGroundDirection(Writer, Data.Direction);
+}
+
+void UTowerActionSender::WriteAbilityData(FBincodeWriter& Writer, const FAbilityActionData& Data)
+{
+	Writer.WriteString(Data.AbilityId);
+	Writer.WriteBevyVec3(Data.TargetPosition);
+	Writer.WriteU64(static_cast<uint64>(Data.TargetEntity));
+}
+
+void UTowerActionSender::WriteInteractData(FBincodeWriter& Writer, const FInteractActionData& Data)
+{
+	Writer.WriteU64(static_cast<uint64>(Data.TargetEntity));
+	Writer.WriteString(Data.InteractionType);
 }
 
 // ============================================================================
@@ -445,28 +796,27 @@ FString UTowerActionSender::SerializeInteractData(const FInteractActionData& Dat
 
 void UTowerActionSender::PurgeTimedOutActions()
 {
-	if (PendingActions.Num() == 0) return;
-
 	const double Now = FPlatformTime::Seconds();
-	const double TimeoutThreshold = static_cast<double>(PendingActionTimeout);
-
-	for (int32 i = PendingActions.Num() - 1; i >= 0; --i)
-	{
-		const FPlayerActionPacket& Packet = PendingActions[i];
-		const double Age = Now - Packet.LocalSendTime;
 
-		if (Age >= TimeoutThreshold)
+	TimeoutWheel.Advance(Now, [this, Now](int64 SequenceNumber)
 		{
+			const int32 Index = FindPendingAction(SequenceNumber);
+			if (Index == INDEX_NONE)
+			{
+				return;
+			}
+
+			const FPlayerActionPacket& Packet = PendingActions[Index];
 			UE_LOG(LogActionSender, Warning,
 				TEXT("Action timed out: seq=%llu type=%s age=%.1fs"),
 				Packet.SequenceNumber,
 				*UEnum::GetValueAsString(Packet.ActionType),
-				Age);
+				Now - Packet.LocalSendTime);
 
-			OnActionRejected.Broadcast(Packet.SequenceNumber, TEXT("Timeout"));
-			PendingActions.RemoveAt(i);
-		}
-	}
+			PendingActions.RemoveAt(Index);
+			++TimedOutActionCount;
+			OnActionRejected.Broadcast(SequenceNumber, TEXT("Timeout"));
+		});
 }
 
 // ============================================================================
@@ -491,8 +841,35 @@ UTowerGRPCClientManager* UTowerActionSender::GetClientManager()
 	return CachedClientManager;
 }
 
+UNetcodeClient* UTowerActionSender::GetNetcodeClient()
+{
+	if (!bUseBinaryTransport)
+	{
+		return nullptr;
+	}
+
+	if (!CachedNetcodeClient.IsValid())
+	{
+		UGameInstance* GI = GetOwner() ? GetOwner()->GetGameInstance() : nullptr;
+		UTowerNetworkSubsystem* Network = GI ? GI->GetSubsystem<UTowerNetworkSubsystem>() : nullptr;
+		AReplicationManager* Replication = Network ? Network->GetReplicationManager() : nullptr;
+		CachedNetcodeClient = Replication ? Replication->GetNetcodeClient() : nullptr;
+	}
+
+	UNetcodeClient* Netcode = CachedNetcodeClient.Get();
+	return (Netcode && Netcode->IsConnected()) ? Netcode : nullptr;
+}
+
+void UTowerActionSender::SetNetcodeClient(UNetcodeClient* InNetcode, int64 InPlayerId)
+{
+	CachedNetcodeClient = InNetcode;
+	PlayerIdOverride = InPlayerId;
+}
+
 int64 UTowerActionSender::GetLocalPlayerId() const
 {
+	if (PlayerIdOverride != 0) return PlayerIdOverride;
+
 	APawn* OwnerPawn = Cast<APawn>(GetOwner());
 	if (!OwnerPawn) return 0;
 
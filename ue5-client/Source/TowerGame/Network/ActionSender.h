@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "NetTimerWheel.h"
 #include "ActionSender.generated.h"
 
 class UTowerGRPCClientManager;
+class UNetcodeClient;
+class FBincodeWriter;
 
 // ============ Action Type Enum ============
 
@@ -19,6 +22,19 @@ enum class EPlayerActionType : uint8
 	Interact    UMETA(DisplayName = "Interact"),
 };
 
+/**
+ * Outbound scheduling class, first to leave first. Combat inputs whose outcome
+ * depends on when they land are Critical and go out on the next tick whatever
+ * else is queued.
+ */
+enum class EActionPriority : uint8
+{
+	Critical,       // Attack, Parry, Dodge
+	Ability,
+	Interaction,
+	Movement,
+};
+
 // ============ Action Data Structs ============
 
 USTRUCT(BlueprintType)
@@ -104,7 +120,7 @@ struct FPlayerActionPacket
 	UPROPERTY(BlueprintReadOnly)
 	EPlayerActionType ActionType = EPlayerActionType::Move;
 
-	/** Action-specific payload serialized as JSON */
+	/** Action-specific payload serialized as JSON (empty when sent over the binary path) */
 	UPROPERTY(BlueprintReadOnly)
 	FString ActionDataJson;
 
@@ -117,6 +133,15 @@ struct FPlayerActionPacket
 
 	/** Local time when this packet was created (for timeout tracking) */
 	double LocalSendTime = 0.0;
+
+	/** Encoded bincode payload, kept so the action can ride along in later datagrams */
+	TArray<uint8> BinaryPayload;
+
+	/** Sent over the netcode connection rather than gRPC */
+	bool bBinaryTransport = false;
+
+	/** PendingActionTimeout timer, armed when the action is flushed */
+	FNetTimerHandle TimeoutTimer;
 };
 
 USTRUCT(BlueprintType)
@@ -150,7 +175,9 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnActionRejected, int64, SequenceN
  * - Validates player input before sending
  * - Assigns monotonic sequence numbers for prediction rollback
  * - Rate-limits each action type to prevent spam
- * - Queues actions and transmits via UTowerGRPCClientManager
+ * - Queues actions by EActionPriority and flushes them once per network tick
+ *   under a byte budget, coalescing queued moves into the newest one
+ * - Transmits via the netcode connection or UTowerGRPCClientManager
  * - Tracks pending (unacknowledged) actions for client prediction
  * - Times out stale actions that never received a server response
  *
@@ -174,10 +201,25 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "1", ClampMax = "128"))
 	int32 MaxPendingActions = 32;
 
-	/** Minimum interval between actions of the same type (seconds) */
+	/** Minimum interval between actions of the same type (seconds); moves coalesce instead */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "0.0"))
 	float MinActionInterval = 0.05f;
 
+	/** Slots of MaxPendingActions only Critical actions may fill, so a move backlog can't lock out a parry */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "0", ClampMax = "32"))
+	int32 CriticalReserveSlots = 4;
+
+	/**
+	 * Bytes a flush may spend on non-Critical actions; the rest wait for the next
+	 * tick. Critical actions always go and count against it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "64"))
+	int32 MaxBytesPerTick = 512;
+
+	/** Seconds a queued action waits before it is ranked one class higher (0 = no aging) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "0.0"))
+	float ActionAgingSeconds = 0.25f;
+
 	/** Enable input validation before sending */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config")
 	bool bEnableInputValidation = true;
@@ -186,6 +228,32 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "0.5"))
 	float PendingActionTimeout = 5.0f;
 
+	/**
+	 * Send actions as compact bincode datagrams (0x10) over the UDP netcode
+	 * connection when it is up; otherwise, or when off, they take the JSON/gRPC
+	 * path. Off by default: bevy-server has no 0x10 decoder yet and would drop them.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config")
+	bool bUseBinaryTransport = false;
+
+	/**
+	 * Unacknowledged binary actions repeated in every datagram, newest first, including
+	 * the one being sent. The server drops sequence numbers it has already applied, so
+	 * a single lost datagram costs nothing as long as another follows within the window.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "1", ClampMax = "8"))
+	int32 RedundantActionCount = 4;
+
+	/** Actions older than this (seconds) stop being repeated and are left to the timeout */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActionSender|Config", meta = (ClampMin = "0.0"))
+	float RedundantActionWindow = 0.5f;
+
+	/** Upper bound on an action datagram (netcode MTU); older redundant entries are dropped to stay under it */
+	static constexpr int32 MAX_ACTION_DATAGRAM_BYTES = 1200;
+
+	/** Netcode packet type for client -> server actions (server -> client types are EPacketType) */
+	static constexpr uint8 ACTION_PACKET_TYPE = 0x10;
+
 	// ============ Send Actions ============
 
 	UFUNCTION(BlueprintCallable, Category = "ActionSender")
@@ -216,10 +284,54 @@ public:
 	UFUNCTION(BlueprintPure, Category = "ActionSender")
 	int32 GetPendingActionCount() const { return PendingActions.Num(); }
 
+	/** Actions accepted but not yet sent (waiting for the next flush or for byte budget) */
+	UFUNCTION(BlueprintPure, Category = "ActionSender")
+	int32 GetQueuedActionCount() const { return OutboundActions.Num(); }
+
+	/** Queued moves replaced by a newer one before they were sent */
+	UFUNCTION(BlueprintPure, Category = "ActionSender")
+	int32 GetCoalescedMoveCount() const { return CoalescedMoveCount; }
+
+	/** Times a queued action was held back a tick by MaxBytesPerTick */
+	UFUNCTION(BlueprintPure, Category = "ActionSender")
+	int32 GetDeferredActionCount() const { return DeferredActionCount; }
+
+	/** Copies of earlier actions sent alongside newer ones (redundancy overhead) */
+	UFUNCTION(BlueprintPure, Category = "ActionSender")
+	int32 GetRedundantActionsSent() const { return RedundantActionsSent; }
+
 	/** Check if a specific sequence number is still pending */
 	UFUNCTION(BlueprintPure, Category = "ActionSender")
 	bool IsActionPending(int64 SequenceNumber) const;
 
+	/** Actions dropped from the pending queue after PendingActionTimeout */
+	UFUNCTION(BlueprintPure, Category = "ActionSender")
+	int32 GetTimedOutActionCount() const { return TimedOutActionCount; }
+
+	// ============ Headless Use ============
+
+	/**
+	 * Send on InNetcode as InPlayerId instead of looking both up through the
+	 * owning pawn, so a sender with no owner or world can drive the binary
+	 * path (FNetBotSwarm). Call FlushOutbound and PurgeTimedOutActions
+	 * yourself in that case.
+	 */
+	void SetNetcodeClient(UNetcodeClient* InNetcode, int64 InPlayerId);
+
+	/**
+	 * Send queued actions in priority order (aged by ActionAgingSeconds), Critical
+	 * ones unconditionally and the rest while MaxBytesPerTick lasts. Sequence
+	 * numbers are assigned here, so they follow the order actions leave in.
+	 * TickComponent does this when registered.
+	 */
+	void FlushOutbound();
+
+	/**
+	 * Remove timed-out actions from the pending queue (TickComponent does this
+	 * when registered). Only actions whose timer is due are touched.
+	 */
+	void PurgeTimedOutActions();
+
 	// ============ Events ============
 
 	UPROPERTY(BlueprintAssignable, Category = "ActionSender|Events")
@@ -229,13 +341,29 @@ public:
 	FOnActionRejected OnActionRejected;
 
 private:
+	/** An action waiting in the outbound queue; Packet has no sequence number yet */
+	struct FQueuedAction
+	{
+		FPlayerActionPacket Packet;
+		EActionPriority Priority = EActionPriority::Movement;
+
+		/** When it was first queued; kept when a newer move replaces the packet, so moves still age */
+		double QueuedTime = 0.0;
+	};
+
 	/** Monotonically increasing sequence counter */
 	int64 SequenceCounter = 0;
 
-	/** Actions sent but not yet acknowledged by the server */
+	/** Accepted actions waiting for FlushOutbound, in arrival order */
+	TArray<FQueuedAction> OutboundActions;
+
+	/** Actions sent but not yet acknowledged by the server, in sequence order */
 	UPROPERTY()
 	TArray<FPlayerActionPacket> PendingActions;
 
+	/** PendingActionTimeout per pending action, keyed by sequence number */
+	FNetTimerWheel TimeoutWheel{ 0.05 };
+
 	/** Last send time per action type for rate limiting */
 	TMap<EPlayerActionType, double> LastActionTime;
 
@@ -243,6 +371,29 @@ private:
 	UPROPERTY()
 	TObjectPtr<UTowerGRPCClientManager> CachedClientManager;
 
+	/** UDP client owned by the replication manager; weak since it goes away on disconnect */
+	TWeakObjectPtr<UNetcodeClient> CachedNetcodeClient;
+
+	/** Scratch buffer reused for every binary action datagram */
+	TArray<uint8> BinarySendBuffer;
+
+	/** Scratch buffer the Write*Data helpers encode the newest action into */
+	TArray<uint8> ActionPayloadBuffer;
+
+	int32 RedundantActionsSent = 0;
+	int32 TimedOutActionCount = 0;
+	int32 CoalescedMoveCount = 0;
+	int32 DeferredActionCount = 0;
+
+	/** Action entry header on the wire: type, sequence, timestamp, payload length */
+	static constexpr int32 ACTION_ENTRY_HEADER_BYTES = 11;
+
+	/** Rough size of the gRPC JSON envelope around ActionDataJson, for the byte budget */
+	static constexpr int32 JSON_ENVELOPE_BYTES = 128;
+
+	/** Set by SetNetcodeClient; 0 means read it from the owning player state */
+	int64 PlayerIdOverride = 0;
+
 	// ============ Internal Helpers ============
 
 	/** Find the gRPC client manager subsystem */
@@ -251,8 +402,16 @@ private:
 	/** Check rate limit for the given action type. Returns true if allowed. */
 	bool CheckRateLimit(EPlayerActionType ActionType);
 
-	/** Check if we can accept another pending action */
-	bool CanEnqueueAction() const;
+	/** Check if we can accept another action of this type (pending + queued, less the Critical reserve) */
+	bool CanEnqueueAction(EPlayerActionType ActionType) const;
+
+	static EActionPriority GetActionPriority(EPlayerActionType ActionType);
+
+	/** Priority class after aging; lower leaves first */
+	int32 GetScheduledRank(const FQueuedAction& Queued, double Now) const;
+
+	/** Budget cost of sending Packet as a fresh entry */
+	static int32 GetWireBytes(const FPlayerActionPacket& Packet);
 
 	/** Validate a direction vector (non-zero, finite) */
 	bool ValidateDirection(const FVector& Direction) const;
@@ -260,11 +419,35 @@ private:
 	/** Validate a string ID is non-empty */
 	bool ValidateStringId(const FString& Id) const;
 
-	/** Create a packet, assign sequence number, set timestamp */
-	FPlayerActionPacket CreatePacket(EPlayerActionType ActionType, const FString& ActionDataJson);
+	/** Find a connected netcode client, or nullptr if the binary path is unavailable */
+	UNetcodeClient* GetNetcodeClient();
+
+	/** Create a packet and set its timestamp; the sequence number is assigned when it is flushed */
+	FPlayerActionPacket CreatePacket(EPlayerActionType ActionType, const FString& ActionDataJson = FString());
+
+	/** Add packet to the outbound queue, replacing a queued move if it is one */
+	bool QueueAction(FPlayerActionPacket& Packet);
 
-	/** Enqueue packet and transmit via gRPC */
-	bool EnqueueAndSend(FPlayerActionPacket& Packet);
+	/** Transmit an already-pending packet via gRPC */
+	void SendJsonAction(const FPlayerActionPacket& Packet);
+
+	/** Reset ActionPayloadBuffer and return a writer for Packet's payload */
+	FBincodeWriter BeginBinaryAction();
+
+	/** Append one action entry (header + payload) to Writer */
+	static void WriteActionEntry(FBincodeWriter& Writer, const FPlayerActionPacket& Packet);
+
+	/** Take the payload from ActionPayloadBuffer, then queue packet for the netcode connection */
+	bool QueueBinaryAction(FPlayerActionPacket& Packet);
+
+	/**
+	 * Send PendingActions[FirstNew..] over the netcode connection with recent
+	 * unacked actions repeated behind them, splitting at the datagram MTU
+	 */
+	void SendBinaryActions(int32 FirstNew, UNetcodeClient* Netcode);
+
+	/** Write the datagram header with a zero entry count; returns the count's offset */
+	int32 BeginActionDatagram(FBincodeWriter& Writer);
 
 	/** Serialize action data structs to JSON */
 	static FString SerializeMoveData(const FMoveActionData& Data);
@@ -274,8 +457,20 @@ private:
 	static FString SerializeAbilityData(const FAbilityActionData& Data);
 	static FString SerializeInteractData(const FInteractActionData& Data);
 
-	/** Remove timed-out actions from the pending queue */
-	void PurgeTimedOutActions();
+	/**
+	 * Bincode payloads. Directions are ground-plane unit vectors in Bevy space,
+	 * quantized to 2x i16; combo step is a u8.
+	 */
+	static void WriteMoveData(FBincodeWriter& Writer, const FMoveActionData& Data);
+	static void WriteAttackData(FBincodeWriter& Writer, const FAttackActionData& Data);
+	static void WriteParryData(FBincodeWriter& Writer, const FParryActionData& Data);
+	static void WriteDodgeData(FBincodeWriter& Writer, const FDodgeActionData& Data);
+	static void WriteAbilityData(FBincodeWriter& Writer, const FAbilityActionData& Data);
+	static void WriteInteractData(FBincodeWriter& Writer, const FInteractActionData& Data);
+	static void WriteGroundDirection(FBincodeWriter& Writer, const FVector& Direction);
+
+	/** Index into PendingActions (sorted by sequence), or INDEX_NONE */
+	int32 FindPendingAction(int64 SequenceNumber) const;
 
 	/** Get current player ID from the owning player state */
 	int64 GetLocalPlayerId() const;
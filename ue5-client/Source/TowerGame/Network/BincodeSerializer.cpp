@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BincodeSerializer.h"
+#include "Misc/ByteSwap.h"
 
 FBincodeReader::FBincodeReader(const TArray<uint8>& InData)
     : Data(InData.GetData())
@@ -29,6 +30,16 @@ bool FBincodeReader::CanRead(int32 Bytes) const
     return bIsValid && (Position + Bytes <= DataSize);
 }
 
+bool FBincodeReader::Require(int32 Bytes)
+{
+    if (!CanRead(Bytes))
+    {
+        SetError();
+        return false;
+    }
+    return true;
+}
+
 uint8 FBincodeReader::ReadU8()
 {
     if (!CanRead(1))
@@ -150,26 +161,30 @@ bool FBincodeReader::ReadBool()
 }
 
 FString FBincodeReader::ReadString()
+{
+    return ReadStringView().ToString();
+}
+
+FBincodeStringView FBincodeReader::ReadStringView()
 {
     // Bincode strings: length (u64) + UTF-8 bytes
     int64 Length = ReadU64();
 
-    if (Length > static_cast<int64>(INT32_MAX))
+    FBincodeStringView Result;
+    if (HasError() || Length < 0 || Length > static_cast<int64>(INT32_MAX))
     {
         SetError();
-        return FString();
+        return Result;
     }
 
     int32 StringLength = static_cast<int32>(Length);
-    if (!CanRead(StringLength))
+    if (!Require(StringLength))
     {
-        SetError();
-        return FString();
+        return Result;
     }
 
-    // Convert UTF-8 to FString
-    FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(&Data[Position]), StringLength);
-    FString Result(Converter.Length(), Converter.Get());
+    Result.Data = reinterpret_cast<const ANSICHAR*>(&Data[Position]);
+    Result.Len = StringLength;
 
     Position += StringLength;
     return Result;
@@ -192,17 +207,166 @@ FVector FBincodeReader::ReadBevyVec3()
     return BevyToUE5(BevyPos);
 }
 
-// Player data deserialization
+float FBincodeReader::ReadSNorm16()
+{
+    return static_cast<float>(ReadI16()) / 32767.0f;
+}
+
+const FNetQuantizeFrame& FBincodeReader::GetQuantizeFrame() const
+{
+    static const FNetQuantizeFrame EmptyFrame;
+    return QuantizeFrame ? *QuantizeFrame : EmptyFrame;
+}
+
+FVector FBincodeReader::ReadQuantizedBevyVec3()
+{
+    const uint16 X = static_cast<uint16>(ReadU16());
+    const uint16 Y = static_cast<uint16>(ReadU16());
+    const uint16 Z = static_cast<uint16>(ReadU16());
+    return BevyToUE5(GetQuantizeFrame().Dequantize(X, Y, Z));
+}
+
+float FBincodeReader::ReadYaw16()
+{
+    return NetQuantize::DequantizeYaw(static_cast<uint16>(ReadU16()));
+}
+
+float FBincodeReader::ReadFraction8()
+{
+    return NetQuantize::DequantizeFraction8(ReadU8());
+}
+
+// ============================================================================
+// FBincodeWriter
+// ============================================================================
+
+FBincodeWriter::FBincodeWriter(TArray<uint8>& InBuffer)
+    : Buffer(InBuffer)
+{
+}
+
+void FBincodeWriter::WriteBytes(const void* Src, int32 Bytes)
+{
+    const int32 Offset = Buffer.AddUninitialized(Bytes);
+    FMemory::Memcpy(Buffer.GetData() + Offset, Src, Bytes);
+}
+
+void FBincodeWriter::WriteU8(uint8 Value)
+{
+    Buffer.Add(Value);
+}
+
+void FBincodeWriter::WriteU16(uint16 Value)
+{
+    #if !PLATFORM_LITTLE_ENDIAN
+        Value = ByteSwap(Value);
+    #endif
+    WriteBytes(&Value, 2);
+}
+
+void FBincodeWriter::WriteU32(uint32 Value)
+{
+    #if !PLATFORM_LITTLE_ENDIAN
+        Value = ByteSwap(Value);
+    #endif
+    WriteBytes(&Value, 4);
+}
+
+void FBincodeWriter::WriteU64(uint64 Value)
+{
+    #if !PLATFORM_LITTLE_ENDIAN
+        Value = ByteSwap(Value);
+    #endif
+    WriteBytes(&Value, 8);
+}
+
+void FBincodeWriter::WriteF32(float Value)
+{
+    uint32 IntValue;
+    FMemory::Memcpy(&IntValue, &Value, 4);
+    WriteU32(IntValue);
+}
+
+void FBincodeWriter::WriteF64(double Value)
+{
+    uint64 IntValue;
+    FMemory::Memcpy(&IntValue, &Value, 8);
+    WriteU64(IntValue);
+}
+
+void FBincodeWriter::WriteString(const FString& Value)
+{
+    // Bincode strings: length (u64) + UTF-8 bytes
+    FTCHARToUTF8 Converter(*Value, Value.Len());
+    WriteU64(static_cast<uint64>(Converter.Length()));
+    WriteBytes(Converter.Get(), Converter.Length());
+}
+
+void FBincodeWriter::WriteVec3(const FVector& Value)
+{
+    WriteF32(static_cast<float>(Value.X));
+    WriteF32(static_cast<float>(Value.Y));
+    WriteF32(static_cast<float>(Value.Z));
+}
+
+void FBincodeWriter::WriteBevyVec3(const FVector& UE5Pos)
+{
+    WriteVec3(FBincodeReader::UE5ToBevy(UE5Pos));
+}
+
+void FBincodeWriter::WriteSNorm16(float Value)
+{
+    WriteI16(static_cast<int16>(FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 32767.0f)));
+}
+
+void FBincodeWriter::WriteQuantizedBevyVec3(const FVector& UE5Pos, const FNetQuantizeFrame& Frame)
+{
+    uint16 Steps[3];
+    Frame.Quantize(FBincodeReader::UE5ToBevy(UE5Pos), Steps);
+    WriteU16(Steps[0]);
+    WriteU16(Steps[1]);
+    WriteU16(Steps[2]);
+}
+
+// ============================================================================
+// FBincodeStringView
+// ============================================================================
+
+bool FBincodeStringView::Equals(const FString& Other) const
+{
+    // Converter uses an inline buffer, so short names never hit the heap
+    FUTF8ToTCHAR Converter(Data, Len);
+    return Converter.Length() == Other.Len()
+        && FCString::Strncmp(Converter.Get(), *Other, Converter.Length()) == 0;
+}
+
+FString FBincodeStringView::ToString() const
+{
+    if (Len == 0)
+    {
+        return FString();
+    }
+
+    // Convert UTF-8 to FString
+    FUTF8ToTCHAR Converter(Data, Len);
+    return FString(Converter.Length(), Converter.Get());
+}
+
+FName FBincodeStringView::ToName() const
+{
+    return Len == 0 ? NAME_None : FName(Len, reinterpret_cast<const UTF8CHAR*>(Data));
+}
+
+// ============================================================================
+// Struct decoders (layouts live in the TBincodeSchema specializations)
+// ============================================================================
+
+// Player data deserialization (Bevy Y-up positions are converted to UE5 Z-up by the schema)
 FPlayerData FPlayerData::FromBincode(FBincodeReader& Reader)
 {
     FPlayerData Result;
 
-    Result.Id = Reader.ReadU64();
-    Result.Position = Reader.ReadBevyVec3();  // Convert Bevy Y-up → UE5 Z-up
-    Result.Health = Reader.ReadF32();
-    Result.CurrentFloor = Reader.ReadU32();
-
-    if (!Reader.IsValid())
+    if (!TBincodeSchema<FPlayerData>::Decode(Reader, Result))
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to deserialize PlayerData"));
     }
@@ -210,17 +374,24 @@ FPlayerData FPlayerData::FromBincode(FBincodeReader& Reader)
     return Result;
 }
 
+FPlayerData FPlayerData::FromQuantizedBincode(FBincodeReader& Reader)
+{
+    FPlayerData Result;
+
+    if (!TBincodeQuantizedSchema<FPlayerData>::Decode(Reader, Result))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to deserialize quantized PlayerData"));
+    }
+
+    return Result;
+}
+
 // Monster data deserialization
 FMonsterData FMonsterData::FromBincode(FBincodeReader& Reader)
 {
     FMonsterData Result;
 
-    Result.MonsterType = Reader.ReadString();
-    Result.Position = Reader.ReadBevyVec3();  // Convert Bevy Y-up → UE5 Z-up
-    Result.Health = Reader.ReadF32();
-    Result.MaxHealth = Reader.ReadF32();
-
-    if (!Reader.IsValid())
+    if (!TBincodeSchema<FMonsterData>::Decode(Reader, Result))
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to deserialize MonsterData"));
     }
@@ -228,16 +399,24 @@ FMonsterData FMonsterData::FromBincode(FBincodeReader& Reader)
     return Result;
 }
 
+FMonsterData FMonsterData::FromQuantizedBincode(FBincodeReader& Reader)
+{
+    FMonsterData Result;
+
+    if (!TBincodeQuantizedSchema<FMonsterData>::Decode(Reader, Result))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to deserialize quantized MonsterData"));
+    }
+
+    return Result;
+}
+
 // Floor tile data deserialization
 FFloorTileData FFloorTileData::FromBincode(FBincodeReader& Reader)
 {
     FFloorTileData Result;
 
-    Result.TileType = Reader.ReadU8();
-    Result.GridX = Reader.ReadI32();
-    Result.GridY = Reader.ReadI32();
-
-    if (!Reader.IsValid())
+    if (!TBincodeSchema<FFloorTileData>::Decode(Reader, Result))
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to deserialize FloorTileData"));
     }
@@ -3,8 +3,41 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "NetQuantize.h"
 #include "BincodeSerializer.generated.h"
 
+/**
+ * Non-owning view of a bincode string inside a packet buffer.
+ * Valid only as long as the buffer it was read from; call ToString() to keep it.
+ */
+struct TOWERGAME_API FBincodeStringView
+{
+    const ANSICHAR* Data = nullptr;  // UTF-8, not null-terminated
+    int32 Len = 0;
+
+    bool IsEmpty() const { return Len == 0; }
+
+    bool Equals(const FBincodeStringView& Other) const
+    {
+        return Len == Other.Len && (Len == 0 || FMemory::Memcmp(Data, Other.Data, Len) == 0);
+    }
+
+    /** Compares against a TCHAR string without allocating for ASCII-length names */
+    bool Equals(const FString& Other) const;
+
+    FString ToString() const;
+
+    /** Interned; allocates nothing once the name is in the name table */
+    FName ToName() const;
+
+    friend uint32 GetTypeHash(const FBincodeStringView& View)
+    {
+        return FCrc::MemCrc32(View.Data, View.Len);
+    }
+
+    friend bool operator==(const FBincodeStringView& A, const FBincodeStringView& B) { return A.Equals(B); }
+};
+
 /**
  * Simplified Bincode deserializer for Rust data structures
  * Supports: u8, u16, u32, u64, f32, f64, Vec3, arrays, strings
@@ -39,14 +72,37 @@ public:
 
     // Compound types
     FString ReadString();
+    FBincodeStringView ReadStringView();  // No allocation; points into the packet
     FVector ReadVec3();  // Reads [f32; 3] in Bevy coordinates
     FVector ReadBevyVec3();  // Reads [f32; 3] and converts Bevy → UE5
+    float ReadSNorm16();  // i16 quantized value in [-1, 1]
+    FVector ReadQuantizedBevyVec3();  // [u16; 3] steps in the quantize frame (Bevy space), converted to UE5
+    float ReadYaw16();  // u16 yaw in degrees, [0, 360)
+    float ReadFraction8();  // u8 fraction in [0, 1]
 
+    /** Length-prefixed array, each element read by a callable taking FBincodeReader& */
+    template<typename T, typename ReadFn>
+    bool ReadArray(TArray<T>& OutArray, ReadFn&& ReadElement);
+
+    /** Length-prefixed array of a type with a TBincodeSchema (see below) */
     template<typename T>
-    TArray<T> ReadArray(TFunction<T(FBincodeReader&)> ReadElement);
+    bool ReadArray(TArray<T>& OutArray);
+
+    /**
+     * Bounds ReadQuantizedBevyVec3 and quantized schema fields decode against.
+     * Not owned; must outlive the reader. Without one they decode to the origin.
+     */
+    void SetQuantizeFrame(const FNetQuantizeFrame* InFrame) { QuantizeFrame = InFrame; }
+    const FNetQuantizeFrame& GetQuantizeFrame() const;
+
+    // Schema decoder access: validate once, then read through the cursor unchecked
+    bool Require(int32 Bytes);
+    const uint8* GetCursor() const { return Data + Position; }
+    void Advance(int32 Bytes) { Position += Bytes; }
 
     // State
-    bool IsValid() const { return bIsValid && Position < DataSize; }
+    bool IsValid() const { return bIsValid; }
+    bool IsAtEnd() const { return Position >= DataSize; }
     bool HasError() const { return !bIsValid; }
     int32 GetPosition() const { return Position; }
     int32 GetRemainingBytes() const { return DataSize - Position; }
@@ -72,11 +128,55 @@ private:
     int32 DataSize;
     int32 Position;
     bool bIsValid;
+    const FNetQuantizeFrame* QuantizeFrame = nullptr;
 
     void SetError();
     bool CanRead(int32 Bytes) const;
 };
 
+/**
+ * Bincode serializer, the counterpart of FBincodeReader.
+ * Appends to a caller-owned buffer so one scratch array can be reused for
+ * every outgoing packet without reallocating.
+ */
+class TOWERGAME_API FBincodeWriter
+{
+public:
+    explicit FBincodeWriter(TArray<uint8>& InBuffer);
+
+    // Primitive types
+    void WriteU8(uint8 Value);
+    void WriteU16(uint16 Value);
+    void WriteU32(uint32 Value);
+    void WriteU64(uint64 Value);
+
+    void WriteI8(int8 Value) { WriteU8(static_cast<uint8>(Value)); }
+    void WriteI16(int16 Value) { WriteU16(static_cast<uint16>(Value)); }
+    void WriteI32(int32 Value) { WriteU32(static_cast<uint32>(Value)); }
+    void WriteI64(int64 Value) { WriteU64(static_cast<uint64>(Value)); }
+
+    void WriteF32(float Value);
+    void WriteF64(double Value);
+
+    void WriteBool(bool bValue) { WriteU8(bValue ? 1 : 0); }
+
+    // Compound types
+    void WriteString(const FString& Value);
+    void WriteVec3(const FVector& Value);  // Writes [f32; 3] as-is
+    void WriteBevyVec3(const FVector& UE5Pos);  // Converts UE5 → Bevy, writes [f32; 3]
+    void WriteSNorm16(float Value);  // Clamps to [-1, 1], writes as i16
+    void WriteQuantizedBevyVec3(const FVector& UE5Pos, const FNetQuantizeFrame& Frame);  // Converts UE5 → Bevy, writes [u16; 3]
+    void WriteYaw16(float Degrees) { WriteU16(NetQuantize::QuantizeYaw(Degrees)); }
+    void WriteFraction8(float Value, float Max) { WriteU8(NetQuantize::QuantizeFraction8(Value, Max)); }
+
+    void WriteBytes(const void* Src, int32 Bytes);  // Raw copy, e.g. a pre-encoded payload
+
+    int32 Num() const { return Buffer.Num(); }
+
+private:
+    TArray<uint8>& Buffer;
+};
+
 /**
  * Helper structs matching Rust types
  */
@@ -99,6 +199,9 @@ struct TOWERGAME_API FPlayerData
 
     // Deserialize from bincode
     static FPlayerData FromBincode(FBincodeReader& Reader);
+
+    // Quantized layout (PlayerUpdateQuantized); positions use the reader's quantize frame
+    static FPlayerData FromQuantizedBincode(FBincodeReader& Reader);
 };
 
 USTRUCT(BlueprintType)
@@ -119,6 +222,16 @@ struct TOWERGAME_API FMonsterData
     float MaxHealth = 0.0f;
 
     static FMonsterData FromBincode(FBincodeReader& Reader);
+    static FMonsterData FromQuantizedBincode(FBincodeReader& Reader);
+};
+
+/** Allocation-free MonsterUpdate payload; MonsterType points into the packet */
+struct FMonsterDataView
+{
+    FBincodeStringView MonsterType;
+    FVector Position = FVector::ZeroVector;
+    float Health = 0.0f;
+    float MaxHealth = 0.0f;
 };
 
 USTRUCT(BlueprintType)
@@ -137,3 +250,358 @@ struct TOWERGAME_API FFloorTileData
 
     static FFloorTileData FromBincode(FBincodeReader& Reader);
 };
+
+// ============================================================================
+// Schema layer
+//
+// A struct declares its wire layout once as a TBincodeSchema specialization:
+//
+//     template<>
+//     struct TBincodeSchema<FFoo> : TBincodeFields<FFoo,
+//         TBincodeField<&FFoo::Id,   Bincode::TRaw<uint64>>,
+//         TBincodeField<&FFoo::Name, Bincode::FStringWire>>
+//     {};
+//
+// and TBincodeSchema<FFoo>::Decode(Reader, Out) is generated from it. Each run
+// of consecutive fixed-size fields is bounds-checked once and then copied out
+// with memcpy at compile-time offsets; only variable-length fields (strings)
+// need their own check.
+//
+// TBincodeQuantizedSchema<T> declares the same structs' quantized layouts
+// (positions as u16 steps in the reader's quantize frame, health as a u8
+// fraction); see NetQuantize.h.
+// ============================================================================
+
+namespace Bincode
+{
+    template<typename WireT>
+    FORCEINLINE WireT LoadLittleEndian(const uint8* Src)
+    {
+        WireT Value;
+        FMemory::Memcpy(&Value, Src, sizeof(WireT));
+        #if !PLATFORM_LITTLE_ENDIAN
+            uint8* Bytes = reinterpret_cast<uint8*>(&Value);
+            for (int32 i = 0; i < static_cast<int32>(sizeof(WireT)) / 2; ++i)
+            {
+                Swap(Bytes[i], Bytes[sizeof(WireT) - 1 - i]);
+            }
+        #endif
+        return Value;
+    }
+
+    /** Fixed-size scalar stored as WireT, converted to the member's type */
+    template<typename WireT>
+    struct TRaw
+    {
+        static constexpr bool bFixed = true;
+        static constexpr int32 Size = sizeof(WireT);
+
+        template<typename MemberT>
+        static FORCEINLINE void Decode(const uint8* Src, MemberT& Out)
+        {
+            Out = static_cast<MemberT>(LoadLittleEndian<WireT>(Src));
+        }
+    };
+
+    /** [f32; 3] copied as-is, no coordinate conversion */
+    struct FVec3
+    {
+        static constexpr bool bFixed = true;
+        static constexpr int32 Size = 12;
+
+        static FORCEINLINE void Decode(const uint8* Src, FVector& Out)
+        {
+            Out = FVector(
+                LoadLittleEndian<float>(Src),
+                LoadLittleEndian<float>(Src + 4),
+                LoadLittleEndian<float>(Src + 8));
+        }
+    };
+
+    /** [f32; 3] in Bevy space, converted to a UE5 position */
+    struct FBevyVec3
+    {
+        static constexpr bool bFixed = true;
+        static constexpr int32 Size = 12;
+
+        static FORCEINLINE void Decode(const uint8* Src, FVector& Out)
+        {
+            Out = FBincodeReader::BevyToUE5(FVector(
+                LoadLittleEndian<float>(Src),
+                LoadLittleEndian<float>(Src + 4),
+                LoadLittleEndian<float>(Src + 8)));
+        }
+    };
+
+    /** [u16; 3] steps in the reader's quantize frame, Bevy space, converted to a UE5 position */
+    struct FQuantizedBevyVec3
+    {
+        static constexpr bool bFixed = true;
+        static constexpr bool bUsesFrame = true;
+        static constexpr int32 Size = 6;
+
+        static FORCEINLINE void Decode(const FNetQuantizeFrame& Frame, const uint8* Src, FVector& Out)
+        {
+            Out = FBincodeReader::BevyToUE5(Frame.Dequantize(
+                LoadLittleEndian<uint16>(Src),
+                LoadLittleEndian<uint16>(Src + 2),
+                LoadLittleEndian<uint16>(Src + 4)));
+        }
+    };
+
+    /** u8 fraction of Scale (health out of its maximum) */
+    template<int32 Scale>
+    struct TFraction8
+    {
+        static constexpr bool bFixed = true;
+        static constexpr int32 Size = 1;
+
+        static FORCEINLINE void Decode(const uint8* Src, float& Out)
+        {
+            Out = NetQuantize::DequantizeFraction8(Src[0]) * Scale;
+        }
+    };
+
+    /** Fixed-size wire types that decode against the reader's quantize frame declare bUsesFrame */
+    template<typename WireT, typename = void>
+    struct TUsesFrame
+    {
+        static constexpr bool Value = false;
+    };
+
+    template<typename WireT>
+    struct TUsesFrame<WireT, std::void_t<decltype(WireT::bUsesFrame)>>
+    {
+        static constexpr bool Value = WireT::bUsesFrame;
+    };
+
+    /** u64 length + UTF-8 bytes; decodes into FString or FBincodeStringView */
+    struct FStringWire
+    {
+        static constexpr bool bFixed = false;
+        static constexpr int32 Size = 8;  // Minimum (length prefix)
+
+        static FORCEINLINE void Decode(FBincodeReader& Reader, FString& Out) { Out = Reader.ReadString(); }
+        static FORCEINLINE void Decode(FBincodeReader& Reader, FBincodeStringView& Out) { Out = Reader.ReadStringView(); }
+    };
+
+    template<typename... Fields>
+    struct TFieldList;
+
+    template<>
+    struct TFieldList<>
+    {
+        static constexpr bool bAllFixed = true;
+        static constexpr int32 LeadingFixedSize = 0;
+        static constexpr int32 MinSize = 0;
+
+        template<bool bRunChecked, typename T>
+        static FORCEINLINE bool Decode(FBincodeReader& Reader, T& Out) { return true; }
+    };
+
+    template<typename Field, typename... Rest>
+    struct TFieldList<Field, Rest...>
+    {
+        using Wire = typename Field::Wire;
+        using Tail = TFieldList<Rest...>;
+
+        static constexpr bool bAllFixed = Wire::bFixed && Tail::bAllFixed;
+
+        // Bytes of consecutive fixed-size fields starting at this one
+        static constexpr int32 LeadingFixedSize = Wire::bFixed ? Wire::Size + Tail::LeadingFixedSize : 0;
+        static constexpr int32 MinSize = Wire::Size + Tail::MinSize;
+
+        template<bool bRunChecked, typename T>
+        static FORCEINLINE bool Decode(FBincodeReader& Reader, T& Out)
+        {
+            if constexpr (Wire::bFixed)
+            {
+                if constexpr (!bRunChecked)
+                {
+                    if (!Reader.Require(LeadingFixedSize))
+                    {
+                        return false;
+                    }
+                }
+                if constexpr (TUsesFrame<Wire>::Value)
+                {
+                    Wire::Decode(Reader.GetQuantizeFrame(), Reader.GetCursor(), Out.*(Field::Member));
+                }
+                else
+                {
+                    Wire::Decode(Reader.GetCursor(), Out.*(Field::Member));
+                }
+                Reader.Advance(Wire::Size);
+                return Tail::template Decode<true>(Reader, Out);
+            }
+            else
+            {
+                Wire::Decode(Reader, Out.*(Field::Member));
+                return Reader.IsValid() && Tail::template Decode<false>(Reader, Out);
+            }
+        }
+    };
+}
+
+/** One field of a schema: the member it fills and its wire encoding */
+template<auto MemberPtr, typename WireT>
+struct TBincodeField
+{
+    static constexpr auto Member = MemberPtr;
+    using Wire = WireT;
+};
+
+/** Base for TBincodeSchema specializations */
+template<typename T, typename... Fields>
+struct TBincodeFields
+{
+    using FieldList = Bincode::TFieldList<Fields...>;
+
+    static constexpr bool bFixedSize = FieldList::bAllFixed;
+    static constexpr int32 MinWireSize = FieldList::MinSize;
+
+    static FORCEINLINE bool Decode(FBincodeReader& Reader, T& Out)
+    {
+        return FieldList::template Decode<false>(Reader, Out);
+    }
+
+    /** For fixed-size schemas whose bytes the caller has already validated */
+    static FORCEINLINE void DecodeUnchecked(FBincodeReader& Reader, T& Out)
+    {
+        static_assert(bFixedSize, "DecodeUnchecked requires a fixed-size schema");
+        FieldList::template Decode<true>(Reader, Out);
+    }
+};
+
+template<typename T>
+struct TBincodeSchema;
+
+template<>
+struct TBincodeSchema<FPlayerData> : TBincodeFields<FPlayerData,
+    TBincodeField<&FPlayerData::Id,           Bincode::TRaw<uint64>>,
+    TBincodeField<&FPlayerData::Position,     Bincode::FBevyVec3>,
+    TBincodeField<&FPlayerData::Health,       Bincode::TRaw<float>>,
+    TBincodeField<&FPlayerData::CurrentFloor, Bincode::TRaw<uint32>>>
+{};
+
+template<>
+struct TBincodeSchema<FMonsterData> : TBincodeFields<FMonsterData,
+    TBincodeField<&FMonsterData::MonsterType, Bincode::FStringWire>,
+    TBincodeField<&FMonsterData::Position,    Bincode::FBevyVec3>,
+    TBincodeField<&FMonsterData::Health,      Bincode::TRaw<float>>,
+    TBincodeField<&FMonsterData::MaxHealth,   Bincode::TRaw<float>>>
+{};
+
+template<>
+struct TBincodeSchema<FMonsterDataView> : TBincodeFields<FMonsterDataView,
+    TBincodeField<&FMonsterDataView::MonsterType, Bincode::FStringWire>,
+    TBincodeField<&FMonsterDataView::Position,    Bincode::FBevyVec3>,
+    TBincodeField<&FMonsterDataView::Health,      Bincode::TRaw<float>>,
+    TBincodeField<&FMonsterDataView::MaxHealth,   Bincode::TRaw<float>>>
+{};
+
+template<typename T>
+struct TBincodeQuantizedSchema;
+
+// 19 bytes against 28. Player health is out of 100 on this protocol (see AReplicatedPlayerActor).
+template<>
+struct TBincodeQuantizedSchema<FPlayerData> : TBincodeFields<FPlayerData,
+    TBincodeField<&FPlayerData::Id,           Bincode::TRaw<uint64>>,
+    TBincodeField<&FPlayerData::Position,     Bincode::FQuantizedBevyVec3>,
+    TBincodeField<&FPlayerData::Health,       Bincode::TFraction8<100>>,
+    TBincodeField<&FPlayerData::CurrentFloor, Bincode::TRaw<uint32>>>
+{};
+
+// MaxHealth stays f32 and comes first; Health is a fraction of it, scaled after decoding
+template<typename T>
+using TBincodeQuantizedMonsterLayout = TBincodeFields<T,
+    TBincodeField<&T::MonsterType, Bincode::FStringWire>,
+    TBincodeField<&T::Position,    Bincode::FQuantizedBevyVec3>,
+    TBincodeField<&T::MaxHealth,   Bincode::TRaw<float>>,
+    TBincodeField<&T::Health,      Bincode::TFraction8<1>>>;
+
+template<typename T>
+struct TBincodeQuantizedMonsterFields : TBincodeQuantizedMonsterLayout<T>
+{
+    static FORCEINLINE bool Decode(FBincodeReader& Reader, T& Out)
+    {
+        const bool bOk = TBincodeQuantizedMonsterLayout<T>::Decode(Reader, Out);
+        Out.Health *= Out.MaxHealth;
+        return bOk;
+    }
+};
+
+template<>
+struct TBincodeQuantizedSchema<FMonsterData> : TBincodeQuantizedMonsterFields<FMonsterData> {};
+
+template<>
+struct TBincodeQuantizedSchema<FMonsterDataView> : TBincodeQuantizedMonsterFields<FMonsterDataView> {};
+
+template<>
+struct TBincodeSchema<FFloorTileData> : TBincodeFields<FFloorTileData,
+    TBincodeField<&FFloorTileData::TileType, Bincode::TRaw<uint8>>,
+    TBincodeField<&FFloorTileData::GridX,    Bincode::TRaw<int32>>,
+    TBincodeField<&FFloorTileData::GridY,    Bincode::TRaw<int32>>>
+{};
+
+// ============================================================================
+// FBincodeReader array templates
+// ============================================================================
+
+template<typename T, typename ReadFn>
+bool FBincodeReader::ReadArray(TArray<T>& OutArray, ReadFn&& ReadElement)
+{
+    const int64 Count = ReadU64();
+
+    // Every element takes at least one byte, so this also rejects absurd lengths
+    if (HasError() || Count < 0 || Count > GetRemainingBytes())
+    {
+        SetError();
+        return false;
+    }
+
+    OutArray.Reset(static_cast<int32>(Count));
+    for (int64 i = 0; i < Count && IsValid(); ++i)
+    {
+        OutArray.Add(ReadElement(*this));
+    }
+
+    return IsValid();
+}
+
+template<typename T>
+bool FBincodeReader::ReadArray(TArray<T>& OutArray)
+{
+    using Schema = TBincodeSchema<T>;
+
+    const int64 Count = ReadU64();
+    if (HasError() || Count < 0 || Count * Schema::MinWireSize > GetRemainingBytes())
+    {
+        SetError();
+        return false;
+    }
+
+    // Decode over existing elements so any inner allocations they own are reused
+    OutArray.SetNum(static_cast<int32>(Count), /*bAllowShrinking*/ false);
+
+    if constexpr (Schema::bFixedSize)
+    {
+        // Exact size is known up front: one check for the whole array
+        for (T& Element : OutArray)
+        {
+            Schema::DecodeUnchecked(*this, Element);
+        }
+        return true;
+    }
+    else
+    {
+        for (T& Element : OutArray)
+        {
+            if (!Schema::Decode(*this, Element))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "EntityRegistry.h"
+
+int32 FReplicatedEntityRegistry::FindOrAdd(EReplicatedEntityKind Kind, int64 Id, bool* bOutAdded)
+{
+    TMap<int64, int32>& Map = SlotsById[static_cast<int32>(Kind)];
+    if (const int32* Existing = Map.Find(Id))
+    {
+        if (bOutAdded)
+        {
+            *bOutAdded = false;
+        }
+        return *Existing;
+    }
+
+    const int32 Slot = Ids.Add(Id);
+    Kinds.Add(Kind);
+    Positions.Add(FVector::ZeroVector);
+    Healths.Add(0.0f);
+    StateHashes.Add(0);
+    HasStateHashes.Add(false);
+    ReportedPositions.Add(FVector::ZeroVector);
+    StatusMasks.Add(0);
+    LastSeen.Add(0);
+    Actors.AddDefaulted();
+    Map.Add(Id, Slot);
+
+    if (bOutAdded)
+    {
+        *bOutAdded = true;
+    }
+    return Slot;
+}
+
+void FReplicatedEntityRegistry::Remove(int32 Slot)
+{
+    if (!Ids.IsValidIndex(Slot))
+    {
+        return;
+    }
+
+    SlotsById[static_cast<int32>(Kinds[Slot])].Remove(Ids[Slot]);
+
+    const int32 Last = Ids.Num() - 1;
+    if (Slot != Last)
+    {
+        SlotsById[static_cast<int32>(Kinds[Last])][Ids[Last]] = Slot;
+    }
+
+    Ids.RemoveAtSwap(Slot, 1, false);
+    Kinds.RemoveAtSwap(Slot, 1, false);
+    Positions.RemoveAtSwap(Slot, 1, false);
+    Healths.RemoveAtSwap(Slot, 1, false);
+    StateHashes.RemoveAtSwap(Slot, 1, false);
+    HasStateHashes.RemoveAtSwap(Slot, 1, false);
+    ReportedPositions.RemoveAtSwap(Slot, 1, false);
+    StatusMasks.RemoveAtSwap(Slot, 1, false);
+    LastSeen.RemoveAtSwap(Slot, 1, false);
+    Actors.RemoveAtSwap(Slot, 1, false);
+}
+
+bool FReplicatedEntityRegistry::Remove(EReplicatedEntityKind Kind, int64 Id)
+{
+    const int32 Slot = Find(Kind, Id);
+    if (Slot == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Remove(Slot);
+    return true;
+}
+
+void FReplicatedEntityRegistry::Reset()
+{
+    for (TMap<int64, int32>& Map : SlotsById)
+    {
+        Map.Reset();
+    }
+
+    Ids.Reset();
+    Kinds.Reset();
+    Positions.Reset();
+    Healths.Reset();
+    StateHashes.Reset();
+    HasStateHashes.Reset();
+    ReportedPositions.Reset();
+    StatusMasks.Reset();
+    LastSeen.Reset();
+    Actors.Reset();
+}
+
+bool FReplicatedEntityRegistry::UpdateStateHash(int32 Slot, int32 Hash)
+{
+    const bool bChanged = !HasStateHashes[Slot] || StateHashes[Slot] != Hash;
+    StateHashes[Slot] = Hash;
+    HasStateHashes[Slot] = true;
+    return bChanged;
+}
+
+void FReplicatedEntityRegistry::ClearStateHashes()
+{
+    for (bool& bHas : HasStateHashes)
+    {
+        bHas = false;
+    }
+}
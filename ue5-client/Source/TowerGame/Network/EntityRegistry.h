@@ -0,0 +1,149 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EntityRegistry.generated.h"
+
+/** What a registry slot tracks; ids are only unique within one kind */
+UENUM(BlueprintType)
+enum class EReplicatedEntityKind : uint8
+{
+    Player  UMETA(DisplayName = "Player"),
+    Monster UMETA(DisplayName = "Monster"),
+
+    MAX     UMETA(Hidden)
+};
+
+/**
+ * Every replicated entity the client knows about, in dense slots.
+ *
+ * Server entity ids map to a slot index once per packet; after that position,
+ * health, the last state hash and the spawned actor are plain column reads.
+ * Removal swaps the last slot into the hole, so slot indices are only stable
+ * until the next Remove(). Columns are struct-of-arrays so a pass over one
+ * field (e.g. the change hashes) stays in cache.
+ *
+ * Shared through UTowerNetworkSubsystem by AReplicationManager (actors) and
+ * UTowerStateSynchronizer (snapshot state). Game thread only.
+ */
+class TOWERGAME_API FReplicatedEntityRegistry
+{
+public:
+    /** Slot for the entity, or INDEX_NONE */
+    int32 Find(EReplicatedEntityKind Kind, int64 Id) const
+    {
+        const int32* Slot = SlotsById[static_cast<int32>(Kind)].Find(Id);
+        return Slot ? *Slot : INDEX_NONE;
+    }
+
+    /** Slot for the entity, appending an empty one if it is new */
+    int32 FindOrAdd(EReplicatedEntityKind Kind, int64 Id, bool* bOutAdded = nullptr);
+
+    /** Swap-remove; the entity that was in the last slot now lives in Slot */
+    void Remove(int32 Slot);
+    bool Remove(EReplicatedEntityKind Kind, int64 Id);
+
+    void Reset();
+
+    int32 Num() const { return Ids.Num(); }
+    int32 Num(EReplicatedEntityKind Kind) const { return SlotsById[static_cast<int32>(Kind)].Num(); }
+
+    // ============ Columns ============
+
+    int64 GetId(int32 Slot) const { return Ids[Slot]; }
+    EReplicatedEntityKind GetKind(int32 Slot) const { return Kinds[Slot]; }
+
+    FVector& Position(int32 Slot) { return Positions[Slot]; }
+    const FVector& Position(int32 Slot) const { return Positions[Slot]; }
+
+    float& Health(int32 Slot) { return Healths[Slot]; }
+    float Health(int32 Slot) const { return Healths[Slot]; }
+
+    /** Position last reported to state listeners (moves below a threshold aren't) */
+    FVector& ReportedPosition(int32 Slot) { return ReportedPositions[Slot]; }
+
+    /** Active status effects, as FMonsterStateSnapshot::StatusMask */
+    uint32& StatusMask(int32 Slot) { return StatusMasks[Slot]; }
+
+    AActor* GetActor(int32 Slot) const { return Actors[Slot].Get(); }
+    void SetActor(int32 Slot, AActor* Actor) { Actors[Slot] = Actor; }
+
+    /** Store Hash for the slot; true if it differs from the previous one (always for a fresh slot) */
+    bool UpdateStateHash(int32 Slot, int32 Hash);
+
+    /** False until the slot's first UpdateStateHash, i.e. state sync hasn't seen it yet */
+    bool HasStateHash(int32 Slot) const { return HasStateHashes[Slot]; }
+
+    /** Forget every stored hash so the next update of each entity counts as a change */
+    void ClearStateHashes();
+
+    /** Stamp the slot as present in the snapshot numbered Stamp */
+    void MarkSeen(int32 Slot, uint32 Stamp) { LastSeen[Slot] = Stamp; }
+
+    /**
+     * Forget state-sync tracking of every slot of Kind not stamped with Stamp:
+     * OnRemoved(Id) runs for those that had a state hash, then slots without an
+     * actor are removed and the others lose their hash.
+     */
+    template <typename FuncType>
+    void RemoveUnseen(EReplicatedEntityKind Kind, uint32 Stamp, FuncType&& OnRemoved)
+    {
+        // Backwards so a swapped-in slot has already been visited
+        for (int32 Slot = Ids.Num() - 1; Slot >= 0; --Slot)
+        {
+            if (Kinds[Slot] != Kind || LastSeen[Slot] == Stamp)
+            {
+                continue;
+            }
+
+            if (HasStateHashes[Slot])
+            {
+                OnRemoved(Ids[Slot]);
+                HasStateHashes[Slot] = false;
+            }
+            if (!Actors[Slot].IsValid())
+            {
+                Remove(Slot);
+            }
+        }
+    }
+
+    void RemoveUnseen(EReplicatedEntityKind Kind, uint32 Stamp)
+    {
+        RemoveUnseen(Kind, Stamp, [](int64) {});
+    }
+
+    /** Visit every live actor of one kind */
+    template <typename FuncType>
+    void ForEachActor(EReplicatedEntityKind Kind, FuncType&& Func) const
+    {
+        for (int32 Slot = 0; Slot < Ids.Num(); ++Slot)
+        {
+            if (Kinds[Slot] == Kind)
+            {
+                if (AActor* Actor = Actors[Slot].Get())
+                {
+                    Func(Ids[Slot], Actor);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr int32 NumKinds = static_cast<int32>(EReplicatedEntityKind::MAX);
+
+    TMap<int64, int32> SlotsById[NumKinds];
+
+    TArray<int64> Ids;
+    TArray<EReplicatedEntityKind> Kinds;
+    TArray<FVector> Positions;
+    TArray<float> Healths;
+    TArray<int32> StateHashes;
+    TArray<bool> HasStateHashes;
+    TArray<FVector> ReportedPositions;
+    TArray<uint32> StatusMasks;
+    TArray<uint32> LastSeen;
+    TArray<TWeakObjectPtr<AActor>> Actors;
+};
@@ -1,5 +1,12 @@
 #include "GRPCClientManager.h"
+#include "Core/StartupTimeline.h"
+#include "BincodeSerializer.h"
+#include "ProtobufBridge.h"
+#include "Core/TowerGameSubsystem.h"
+#include "TowerNetworkSubsystem.h"
 #include "HttpModule.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Dom/JsonObject.h"
@@ -10,15 +17,106 @@
 #include "Engine/GameInstance.h"
 #include "HAL/PlatformProcess.h"
 #include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogGRPCClient, Log, All);
 
+// Stream transport framing (little-endian, one call per WebSocket binary frame):
+//   request:  u64 request_id, u8 body_encoding, u16 path_len, path (UTF-8), body
+//   response: u64 request_id, u16 status, body
+// The server runs each request through the same router as the HTTP endpoints,
+// so responses can come back in any order.
+namespace
+{
+	constexpr TCHAR StreamPath[] = TEXT("/tower.Stream");
+	constexpr uint8 StreamBodyJson = 0;
+	constexpr int32 StreamResponseHeaderBytes = 10;
+	constexpr float TimeoutSweepSeconds = 0.25f;
+
+	/** How long past Config.TimeoutSeconds an HTTP request may go before we stop waiting for its callback */
+	constexpr float HttpTimeoutGraceSeconds = 2.0f;
+
+	/** Response body sink for a streamed download: the HTTP thread appends, the game thread drains */
+	class FStreamedBodyArchive : public FArchive
+	{
+	public:
+		FStreamedBodyArchive()
+		{
+			SetIsSaving(true);
+		}
+
+		virtual void Serialize(void* Data, int64 Num) override
+		{
+			FScopeLock Lock(&Mutex);
+			Pending.Append(static_cast<const uint8*>(Data), static_cast<int32>(Num));
+		}
+
+		/** Everything received since the last call */
+		void Drain(TArray<uint8>& Out)
+		{
+			Out.Reset();
+			FScopeLock Lock(&Mutex);
+			Swap(Out, Pending);
+		}
+
+	private:
+		FCriticalSection Mutex;
+		TArray<uint8> Pending;
+	};
+
+	const TCHAR* TransportName(ETransportMode Mode)
+	{
+		switch (Mode)
+		{
+		case ETransportMode::GRPC:   return TEXT("grpc-json");
+		case ETransportMode::JSON:   return TEXT("json");
+		case ETransportMode::FFI:    return TEXT("ffi");
+		case ETransportMode::Stream: return TEXT("stream");
+		}
+		return TEXT("?");
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs RPCStatsCommand(
+		TEXT("tower.RPCStats"),
+		TEXT("Print per-RPC latency percentiles, failures and timeouts. 'tower.RPCStats reset' clears them."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+			UTowerGRPCClientManager* Manager = GI ? GI->GetSubsystem<UTowerGRPCClientManager>() : nullptr;
+			if (!Manager)
+			{
+				return;
+			}
+
+			if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+			{
+				Manager->ResetRPCLatencyStats();
+				return;
+			}
+
+			UE_LOG(LogGRPCClient, Display, TEXT("%-48s %-9s %7s %5s %5s %8s %8s %8s %8s"),
+				TEXT("Service"), TEXT("Transport"), TEXT("Count"), TEXT("Fail"), TEXT("T/O"),
+				TEXT("p50 ms"), TEXT("p95 ms"), TEXT("p99 ms"), TEXT("max ms"));
+
+			for (const FRPCLatencyStats& Stats : Manager->GetRPCLatencyStats())
+			{
+				UE_LOG(LogGRPCClient, Display, TEXT("%-48s %-9s %7d %5d %5d %8.2f %8.2f %8.2f %8.2f"),
+					*Stats.ServicePath, TransportName(Stats.Transport), Stats.Count, Stats.Failures, Stats.Timeouts,
+					Stats.P50Ms, Stats.P95Ms, Stats.P99Ms, Stats.MaxMs);
+			}
+
+			UE_LOG(LogGRPCClient, Display, TEXT("Sent %d, failed %d, reconnect attempts %d"),
+				Manager->TotalRequestsSent, Manager->TotalRequestsFailed, Manager->TotalRetries);
+		}));
+}
+
 // ============================================================
 // Subsystem lifecycle
 // ============================================================
 
 void UTowerGRPCClientManager::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TOWER_STARTUP_SCOPE(GRPCClientManager);
 	Super::Initialize(Collection);
 
 	ConnectionState = EGRPCConnectionState::Disconnected;
@@ -29,6 +127,20 @@ void UTowerGRPCClientManager::Initialize(FSubsystemCollectionBase& Collection)
 	TotalRequestsFailed = 0;
 	ConsecutiveFailures = 0;
 	AverageLatencyMs = 0.0f;
+	CacheHits = 0;
+	CoalescedRequests = 0;
+	LocalFloorHits = 0;
+	TotalRetries = 0;
+
+	if (UTowerNetworkSubsystem* Network = Collection.InitializeDependency<UTowerNetworkSubsystem>())
+	{
+		NetStats = &Network->GetNetStats();
+	}
+
+	if (Config.TransportMode == ETransportMode::Stream)
+	{
+		FModuleManager::Get().LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets"));
+	}
 
 	UE_LOG(LogGRPCClient, Log,
 		TEXT("GRPCClientManager initialized. Target: %s:%d  Transport: %d"),
@@ -71,10 +183,15 @@ void UTowerGRPCClientManager::Disconnect()
 		{
 			World->GetTimerManager().ClearTimer(HealthCheckTimerHandle);
 			World->GetTimerManager().ClearTimer(ReconnectTimerHandle);
+			World->GetTimerManager().ClearTimer(TimeoutSweepTimerHandle);
 		}
 	}
 
+	CloseStream(TEXT("Disconnected"));
 	InFlightRequests.Empty();
+	RequestTimeouts.Reset();
+	CoalescedCalls.Empty();
+	ResponseCache.Empty();
 	SetConnectionState(EGRPCConnectionState::Disconnected);
 
 	UE_LOG(LogGRPCClient, Log, TEXT("Disconnected from Rust procedural core"));
@@ -96,6 +213,7 @@ void UTowerGRPCClientManager::Reconnect()
 
 	SetConnectionState(EGRPCConnectionState::Reconnecting);
 	ReconnectAttempts++;
+	TotalRetries++;
 
 	float Delay = GetReconnectDelay();
 	UE_LOG(LogGRPCClient, Log, TEXT("Reconnecting in %.1f seconds (attempt %d)"), Delay, ReconnectAttempts);
@@ -177,6 +295,12 @@ void UTowerGRPCClientManager::OnHealthCheckResponse(bool bSuccess, const FString
 		ConsecutiveFailures = 0;
 		ReconnectAttempts = 0;
 
+		// The stream can drop while HTTP stays healthy; bring it back on the next check
+		if (ConnectionState == EGRPCConnectionState::Connected && ActiveTransport == ETransportMode::Stream)
+		{
+			OpenStream();
+		}
+
 		if (ConnectionState != EGRPCConnectionState::Connected)
 		{
 			SetConnectionState(EGRPCConnectionState::Connected);
@@ -185,7 +309,13 @@ void UTowerGRPCClientManager::OnHealthCheckResponse(bool bSuccess, const FString
 				TEXT("Connected to Rust core at %s:%d via %s"),
 				*Config.Host, Config.Port,
 				ActiveTransport == ETransportMode::GRPC ? TEXT("gRPC-JSON") :
-				ActiveTransport == ETransportMode::JSON ? TEXT("JSON") : TEXT("FFI"));
+				ActiveTransport == ETransportMode::JSON ? TEXT("JSON") :
+				ActiveTransport == ETransportMode::Stream ? TEXT("stream") : TEXT("FFI"));
+
+			if (ActiveTransport == ETransportMode::Stream)
+			{
+				OpenStream();
+			}
 
 			// Start periodic health checks
 			if (UGameInstance* GI = GetGameInstance())
@@ -257,18 +387,136 @@ int64 UTowerGRPCClientManager::RequestFloor(int64 TowerSeed, int32 FloorId)
 	Payload->SetNumberField(TEXT("tower_seed"), static_cast<double>(TowerSeed));
 	Payload->SetNumberField(TEXT("floor_id"), static_cast<double>(FloorId));
 
-	SendRequest(
+	// The server answers hash_matched instead of tiles when our copy is identical
+	TSharedPtr<FProtoChunkData> LocalChunk;
+	if (Config.bVerifyLocalFloors)
+	{
+		LocalChunk = MakeShared<FProtoChunkData>();
+		if (GenerateLocalChunk(TowerSeed, FloorId, *LocalChunk))
+		{
+			LocalChunk->ValidationHash = UProtobufBridge::ComputeChunkHash(*LocalChunk);
+			Payload->SetStringField(TEXT("validation_hash"),
+				FString::BytesToHex(LocalChunk->ValidationHash.GetData(), LocalChunk->ValidationHash.Num()).ToLower());
+		}
+		else
+		{
+			LocalChunk.Reset();
+		}
+	}
+
+	SendCoalescedRequest(
 		TEXT("/tower.GenerationService/GenerateFloor"),
 		SerializeJson(Payload),
 		ReqId,
-		[this, ReqId](bool bSuccess, const FString& Body)
+		Config.FloorCacheTTLSeconds,
+		[this, ReqId, LocalChunk = TSharedPtr<const FProtoChunkData>(LocalChunk)](bool bSuccess, const FString& Body)
 		{
-			ProcessFloorResponse(ReqId, bSuccess, Body);
+			ProcessFloorResponse(ReqId, bSuccess, Body, LocalChunk);
 		});
 
 	return ReqId;
 }
 
+int64 UTowerGRPCClientManager::RequestFloorChunk(int64 TowerSeed, int32 FloorId, FOnGRPCBytesReceived OnBytes, FOnGRPCStreamComplete OnComplete)
+{
+	int64 ReqId = AllocateRequestId();
+	const FString ServicePath = TEXT("/tower.GenerationService/GenerateFloorChunk");
+
+	if (ConnectionState != EGRPCConnectionState::Connected && ConnectionState != EGRPCConnectionState::Connecting)
+	{
+		UE_LOG(LogGRPCClient, Warning, TEXT("RequestFloorChunk(%d) dropped — not connected"), FloorId);
+		HandleRequestFailure(ReqId, -1, TEXT("Not connected"));
+		OnComplete.ExecuteIfBound(false);
+		return ReqId;
+	}
+
+	TSharedPtr<FJsonObject> Payload = MakeShareable(new FJsonObject());
+	Payload->SetNumberField(TEXT("tower_seed"), static_cast<double>(TowerSeed));
+	Payload->SetNumberField(TEXT("floor_id"), static_cast<double>(FloorId));
+
+	TotalRequestsSent++;
+	FInFlightRequest& InFlight = InFlightRequests.Add(ReqId);
+	InFlight.StartTime = FPlatformTime::Seconds();
+	InFlight.StatsIndex = FindOrAddRPCStats(ServicePath, ETransportMode::GRPC);
+	ArmRequestTimeout(ReqId, Config.TimeoutSeconds + HttpTimeoutGraceSeconds);
+
+	FString Url = GetBaseUrl() + ServicePath;
+	UE_LOG(LogGRPCClient, Verbose, TEXT(">> [%lld] POST %s (streamed)"), ReqId, *Url);
+
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Url);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("Accept"), TEXT("application/x-protobuf"));
+	Request->SetHeader(TEXT("X-Tower-Request-Id"), FString::Printf(TEXT("%lld"), ReqId));
+	Request->SetTimeout(Config.TimeoutSeconds);
+	Request->SetContentAsString(SerializeJson(Payload));
+
+	// Where the platform can't stream a body, it all arrives with the completion instead
+	TSharedRef<FStreamedBodyArchive> Body = MakeShared<FStreamedBodyArchive>();
+	const bool bStreamed = Request->SetResponseBodyReceiveStream(Body);
+
+	if (bStreamed)
+	{
+		TSharedRef<TArray<uint8>> Slice = MakeShared<TArray<uint8>>();
+		Request->OnRequestProgress().BindLambda(
+			[Body, Slice, OnBytes](FHttpRequestPtr Req, int32 BytesSent, int32 BytesReceived)
+			{
+				// An error body isn't ChunkData; leave it to the completion
+				FHttpResponsePtr Resp = Req.IsValid() ? Req->GetResponse() : nullptr;
+				if (!Resp.IsValid() || !EHttpResponseCodes::IsOk(Resp->GetResponseCode()))
+				{
+					return;
+				}
+
+				Body->Drain(*Slice);
+				if (Slice->Num() > 0)
+				{
+					OnBytes.ExecuteIfBound(*Slice);
+				}
+			});
+	}
+
+	Request->OnProcessRequestComplete().BindLambda(
+		[this, ReqId, Body, bStreamed, OnBytes, OnComplete](FHttpRequestPtr Req, FHttpResponsePtr Resp, bool bConnected)
+		{
+			const int32 Code = bConnected && Resp.IsValid() ? Resp->GetResponseCode() : -1;
+			const bool bOk = EHttpResponseCodes::IsOk(Code);
+
+			if (bOk)
+			{
+				TArray<uint8> Rest;
+				if (bStreamed)
+				{
+					Body->Drain(Rest);
+				}
+				else
+				{
+					Rest = Resp->GetContent();
+				}
+				if (Rest.Num() > 0)
+				{
+					OnBytes.ExecuteIfBound(Rest);
+				}
+
+				ConsecutiveFailures = 0;
+				RecordLatency(ReqId, ERequestOutcome::Succeeded);
+				UE_LOG(LogGRPCClient, Verbose, TEXT("<< [%lld] %d OK (streamed)"), ReqId, Code);
+			}
+			else
+			{
+				RecordLatency(ReqId, Code < 0 ? ERequestOutcome::Failed : ERequestOutcome::Rejected);
+				UE_LOG(LogGRPCClient, Warning, TEXT("<< [%lld] Floor chunk download failed (HTTP %d)"), ReqId, Code);
+				HandleRequestFailure(ReqId, Code, Code < 0 ? TEXT("Connection failed") : TEXT("Floor chunk rejected"));
+			}
+
+			OnComplete.ExecuteIfBound(bOk);
+		});
+
+	Request->ProcessRequest();
+	return ReqId;
+}
+
 int64 UTowerGRPCClientManager::RequestCombatCalc(int64 AttackerId, int64 DefenderId, const FString& WeaponId, const FString& AbilityId)
 {
 	int64 ReqId = AllocateRequestId();
@@ -320,10 +568,11 @@ int64 UTowerGRPCClientManager::RequestWallet(int64 PlayerId)
 	TSharedPtr<FJsonObject> Payload = MakeShareable(new FJsonObject());
 	Payload->SetNumberField(TEXT("player_id"), static_cast<double>(PlayerId));
 
-	SendRequest(
+	SendCoalescedRequest(
 		TEXT("/tower.EconomyService/GetWallet"),
 		SerializeJson(Payload),
 		ReqId,
+		Config.WalletCacheTTLSeconds,
 		[this, ReqId](bool bSuccess, const FString& Body)
 		{
 			ProcessWalletResponse(ReqId, bSuccess, Body);
@@ -347,6 +596,11 @@ int64 UTowerGRPCClientManager::RequestLoot(int64 SourceEntityId, int64 PlayerId,
 		ReqId,
 		[this, ReqId](bool bSuccess, const FString& Body)
 		{
+			// Loot can carry gold, so the cached balance is no longer trustworthy
+			if (bSuccess)
+			{
+				InvalidateCachedService(TEXT("/tower.EconomyService/GetWallet"));
+			}
 			ProcessLootResponse(ReqId, bSuccess, Body);
 		});
 
@@ -379,11 +633,26 @@ void UTowerGRPCClientManager::SendRequest(
 			TEXT("SendRequest(%s) dropped — not connected (state: %d)"),
 			*ServicePath, static_cast<int32>(ConnectionState));
 		HandleRequestFailure(RequestId, -1, TEXT("Not connected"));
+		OnResponse(false, TEXT("{\"error\":\"not_connected\"}"));
 		return;
 	}
 
+	const bool bUseStream = ActiveTransport == ETransportMode::Stream && StreamSocket.IsValid() && StreamSocket->IsConnected();
+
 	TotalRequestsSent++;
-	InFlightRequests.Add(RequestId, FPlatformTime::Seconds());
+	FInFlightRequest& InFlight = InFlightRequests.Add(RequestId);
+	InFlight.StartTime = FPlatformTime::Seconds();
+	InFlight.StatsIndex = FindOrAddRPCStats(ServicePath,
+		bUseStream ? ETransportMode::Stream
+		: ActiveTransport == ETransportMode::Stream ? ETransportMode::GRPC : ActiveTransport);
+
+	if (bUseStream && SendStreamRequest(ServicePath, PayloadJson, RequestId, OnResponse))
+	{
+		ArmRequestTimeout(RequestId, Config.TimeoutSeconds);
+		return;
+	}
+
+	ArmRequestTimeout(RequestId, Config.TimeoutSeconds + HttpTimeoutGraceSeconds);
 
 	FString Url = GetBaseUrl() + ServicePath;
 
@@ -397,6 +666,10 @@ void UTowerGRPCClientManager::SendRequest(
 	// gRPC-Web style header so the Rust server knows this is a proto-JSON call
 	Request->SetHeader(TEXT("X-Tower-Transport"), TEXT("grpc-json"));
 	Request->SetHeader(TEXT("X-Tower-Request-Id"), FString::Printf(TEXT("%lld"), RequestId));
+	if (Config.bAcceptCompressedResponses)
+	{
+		Request->SetHeader(TEXT("X-Tower-Accept-Compression"), PayloadCompression::GetAcceptedCodecs());
+	}
 	Request->SetTimeout(Config.TimeoutSeconds);
 
 	if (!PayloadJson.IsEmpty())
@@ -410,32 +683,21 @@ void UTowerGRPCClientManager::SendRequest(
 		{
 			if (bConnected && Resp.IsValid())
 			{
-				int32 Code = Resp->GetResponseCode();
-				FString Body = Resp->GetContentAsString();
-				bool bOk = (Code >= 200 && Code < 300);
-
-				RecordLatency(RequestId);
-				InFlightRequests.Remove(RequestId);
-
-				if (bOk)
+				FString Body;
+				if (DecodeResponseBody(Resp->GetContent(), Body))
 				{
-					ConsecutiveFailures = 0;
-					UE_LOG(LogGRPCClient, Verbose, TEXT("<< [%lld] %d OK (%d bytes)"),
-						RequestId, Code, Body.Len());
-					OnRequestCompleted.Broadcast(RequestId, Body);
-					OnResponse(true, Body);
+					CompleteRequest(RequestId, Resp->GetResponseCode(), Body, OnResponse);
 				}
 				else
 				{
-					UE_LOG(LogGRPCClient, Warning, TEXT("<< [%lld] HTTP %d: %s"),
-						RequestId, Code, *Body.Left(512));
-					HandleRequestFailure(RequestId, Code, Body);
-					OnResponse(false, Body);
+					RecordLatency(RequestId, ERequestOutcome::Failed);
+					HandleRequestFailure(RequestId, -1, TEXT("Corrupt compressed response"));
+					OnResponse(false, TEXT("{\"error\":\"decompression_failed\"}"));
 				}
 			}
 			else
 			{
-				InFlightRequests.Remove(RequestId);
+				RecordLatency(RequestId, ERequestOutcome::Failed);
 
 				UE_LOG(LogGRPCClient, Error,
 					TEXT("<< [%lld] Connection failed (no response)"), RequestId);
@@ -453,6 +715,390 @@ void UTowerGRPCClientManager::SendRequest(
 	Request->ProcessRequest();
 }
 
+void UTowerGRPCClientManager::CompleteRequest(int64 RequestId, int32 Code, const FString& Body,
+	const TFunction<void(bool bSuccess, const FString& ResponseBody)>& OnResponse)
+{
+	bool bOk = (Code >= 200 && Code < 300);
+
+	RecordLatency(RequestId, bOk ? ERequestOutcome::Succeeded : ERequestOutcome::Rejected);
+
+	if (bOk)
+	{
+		ConsecutiveFailures = 0;
+		UE_LOG(LogGRPCClient, Verbose, TEXT("<< [%lld] %d OK (%d bytes)"),
+			RequestId, Code, Body.Len());
+		OnRequestCompleted.Broadcast(RequestId, Body);
+		OnResponse(true, Body);
+	}
+	else
+	{
+		UE_LOG(LogGRPCClient, Warning, TEXT("<< [%lld] HTTP %d: %s"),
+			RequestId, Code, *Body.Left(512));
+		HandleRequestFailure(RequestId, Code, Body);
+		OnResponse(false, Body);
+	}
+}
+
+// ============================================================
+// Stream transport
+// ============================================================
+
+void UTowerGRPCClientManager::OpenStream()
+{
+	if (StreamSocket.IsValid() && StreamSocket->IsConnected())
+	{
+		return;
+	}
+
+	// A socket that dropped is only released here, never from inside its own callbacks
+	CloseStream(TEXT("Reopening"));
+
+	FString Url = FString::Printf(TEXT("ws://%s:%d%s"), *Config.Host, Config.Port, StreamPath);
+	if (Config.bAcceptCompressedResponses)
+	{
+		// Negotiated once per socket; every response body on it may then be a compressed frame
+		Url += FString::Printf(TEXT("?accept_compression=%s"), *PayloadCompression::GetAcceptedCodecs());
+	}
+	StreamSocket = FWebSocketsModule::Get().CreateWebSocket(Url, TEXT(""));
+
+	StreamSocket->OnConnected().AddLambda([this]()
+	{
+		UE_LOG(LogGRPCClient, Log, TEXT("Stream transport open"));
+	});
+
+	StreamSocket->OnConnectionError().AddLambda([this](const FString& Error)
+	{
+		UE_LOG(LogGRPCClient, Warning, TEXT("Stream transport unavailable (%s), using HTTP"), *Error);
+		FailStreamCalls(Error);
+	});
+
+	StreamSocket->OnClosed().AddLambda([this](int32 StatusCode, const FString& Reason, bool bWasClean)
+	{
+		UE_LOG(LogGRPCClient, Warning, TEXT("Stream transport closed (%d: %s), using HTTP"), StatusCode, *Reason);
+		FailStreamCalls(Reason);
+	});
+
+	StreamSocket->OnRawMessage().AddUObject(this, &UTowerGRPCClientManager::OnStreamRawMessage);
+
+	StreamSocket->Connect();
+}
+
+void UTowerGRPCClientManager::CloseStream(const FString& Reason)
+{
+	if (StreamSocket.IsValid())
+	{
+		TSharedPtr<IWebSocket> Socket = MoveTemp(StreamSocket);
+		Socket->OnConnected().Clear();
+		Socket->OnConnectionError().Clear();
+		Socket->OnClosed().Clear();
+		Socket->OnRawMessage().Clear();
+		if (Socket->IsConnected())
+		{
+			Socket->Close();
+		}
+	}
+
+	FailStreamCalls(Reason);
+}
+
+void UTowerGRPCClientManager::FailStreamCalls(const FString& Reason)
+{
+	StreamReceiveBuffer.Reset();
+
+	// Calls on a dead stream never complete; fail them so callers can retry
+	TMap<int64, FStreamCall> Orphaned = MoveTemp(StreamCalls);
+	StreamCalls.Reset();
+	for (TPair<int64, FStreamCall>& Pair : Orphaned)
+	{
+		RecordLatency(Pair.Key, ERequestOutcome::Failed);
+		HandleRequestFailure(Pair.Key, -1, FString::Printf(TEXT("Stream closed: %s"), *Reason));
+		Pair.Value.OnResponse(false, TEXT("{\"error\":\"stream_closed\"}"));
+	}
+}
+
+bool UTowerGRPCClientManager::SendStreamRequest(const FString& ServicePath, const FString& PayloadJson, int64 RequestId,
+	TFunction<void(bool bSuccess, const FString& ResponseBody)>& OnResponse)
+{
+	if (!StreamSocket.IsValid() || !StreamSocket->IsConnected())
+	{
+		return false;
+	}
+
+	FTCHARToUTF8 PathUtf8(*ServicePath, ServicePath.Len());
+	FTCHARToUTF8 BodyUtf8(*PayloadJson, PayloadJson.Len());
+
+	StreamSendBuffer.Reset();
+	FBincodeWriter Writer(StreamSendBuffer);
+	Writer.WriteU64(static_cast<uint64>(RequestId));
+	Writer.WriteU8(StreamBodyJson);
+	Writer.WriteU16(static_cast<uint16>(PathUtf8.Length()));
+	Writer.WriteBytes(PathUtf8.Get(), PathUtf8.Length());
+	Writer.WriteBytes(BodyUtf8.Get(), BodyUtf8.Length());
+
+	FStreamCall& Call = StreamCalls.Add(RequestId);
+	Call.OnResponse = MoveTemp(OnResponse);
+
+	UE_LOG(LogGRPCClient, Verbose, TEXT(">> [%lld] STREAM %s (%d bytes)"), RequestId, *ServicePath, StreamSendBuffer.Num());
+
+	StreamSocket->Send(StreamSendBuffer.GetData(), StreamSendBuffer.Num(), true);
+	return true;
+}
+
+void UTowerGRPCClientManager::OnStreamRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+{
+	const uint8* Bytes = static_cast<const uint8*>(Data);
+
+	// Common case: a whole frame in one callback, decoded straight from the socket buffer
+	if (BytesRemaining == 0 && StreamReceiveBuffer.Num() == 0)
+	{
+		DispatchStreamFrame(TArrayView<const uint8>(Bytes, static_cast<int32>(Size)));
+		return;
+	}
+
+	StreamReceiveBuffer.Append(Bytes, static_cast<int32>(Size));
+	if (BytesRemaining == 0)
+	{
+		DispatchStreamFrame(StreamReceiveBuffer);
+		StreamReceiveBuffer.Reset();
+	}
+}
+
+void UTowerGRPCClientManager::DispatchStreamFrame(TArrayView<const uint8> Frame)
+{
+	if (Frame.Num() < StreamResponseHeaderBytes)
+	{
+		UE_LOG(LogGRPCClient, Warning, TEXT("Stream frame too short (%d bytes)"), Frame.Num());
+		return;
+	}
+
+	FBincodeReader Reader(Frame.GetData(), Frame.Num());
+	const int64 RequestId = Reader.ReadU64();
+	const int32 Code = static_cast<uint16>(Reader.ReadU16());
+
+	FStreamCall Call;
+	if (!StreamCalls.RemoveAndCopyValue(RequestId, Call))
+	{
+		// Already expired on our side
+		UE_LOG(LogGRPCClient, Verbose, TEXT("<< [%lld] late stream response dropped"), RequestId);
+		return;
+	}
+
+	FString Body;
+	if (!DecodeResponseBody(TArrayView<const uint8>(Reader.GetCursor(), Reader.GetRemainingBytes()), Body))
+	{
+		RecordLatency(RequestId, ERequestOutcome::Failed);
+		HandleRequestFailure(RequestId, -1, TEXT("Corrupt compressed response"));
+		Call.OnResponse(false, TEXT("{\"error\":\"decompression_failed\"}"));
+		return;
+	}
+
+	CompleteRequest(RequestId, Code, Body, Call.OnResponse);
+}
+
+bool UTowerGRPCClientManager::DecodeResponseBody(TArrayView<const uint8> Bytes, FString& OutBody)
+{
+	const uint64 DecodeStart = FPlatformTime::Cycles64();
+
+	TArrayView<const uint8> Raw;
+	if (!ResponseDecompressor.Decode(Bytes, Raw))
+	{
+		UE_LOG(LogGRPCClient, Warning, TEXT("Dropped %d byte response: compressed body is corrupt"), Bytes.Num());
+		return false;
+	}
+
+	FUTF8ToTCHAR BodyConverter(reinterpret_cast<const ANSICHAR*>(Raw.GetData()), Raw.Num());
+	OutBody = FString(BodyConverter.Length(), BodyConverter.Get());
+
+	if (NetStats)
+	{
+		if (Raw.GetData() != Bytes.GetData())
+		{
+			NetStats->RecordDecompressed(ETowerNetChannel::ServiceCall, Bytes.Num(), Raw.Num());
+		}
+		NetStats->RecordIncoming(ETowerNetChannel::ServiceCall, Bytes.Num(), FPlatformTime::Cycles64() - DecodeStart);
+	}
+
+	// Floor responses can inflate to megabytes; don't pin that for the rest of the session
+	if (Raw.Num() > 1024 * 1024)
+	{
+		ResponseDecompressor.Trim();
+	}
+
+	return true;
+}
+
+void UTowerGRPCClientManager::ArmRequestTimeout(int64 RequestId, float Seconds)
+{
+	FInFlightRequest* InFlight = InFlightRequests.Find(RequestId);
+	if (!InFlight)
+	{
+		return;
+	}
+
+	InFlight->TimeoutTimer = RequestTimeouts.Add(FPlatformTime::Seconds(), Seconds, RequestId);
+
+	UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+	if (World && !World->GetTimerManager().IsTimerActive(TimeoutSweepTimerHandle))
+	{
+		World->GetTimerManager().SetTimer(
+			TimeoutSweepTimerHandle,
+			[this]() { ExpireRequests(); },
+			TimeoutSweepSeconds,
+			true  // looping
+		);
+	}
+}
+
+void UTowerGRPCClientManager::ExpireRequests()
+{
+	RequestTimeouts.Advance(FPlatformTime::Seconds(), [this](int64 RequestId)
+		{
+			FStreamCall Call;
+			if (StreamCalls.RemoveAndCopyValue(RequestId, Call))
+			{
+				RecordLatency(RequestId, ERequestOutcome::TimedOut);
+				UE_LOG(LogGRPCClient, Warning, TEXT("<< [%lld] Stream request timed out"), RequestId);
+				HandleRequestFailure(RequestId, -1, TEXT("Timeout"));
+				Call.OnResponse(false, TEXT("{\"error\":\"timeout\"}"));
+				return;
+			}
+
+			// The HTTP module should have reported its own timeout well before this
+			UE_LOG(LogGRPCClient, Warning, TEXT("<< [%lld] HTTP request never completed, retired as timed out"), RequestId);
+			RecordLatency(RequestId, ERequestOutcome::TimedOut);
+		});
+
+	if (RequestTimeouts.Num() == 0)
+	{
+		if (UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr)
+		{
+			World->GetTimerManager().ClearTimer(TimeoutSweepTimerHandle);
+		}
+	}
+}
+
+// ============================================================
+// Coalescing & response cache
+// ============================================================
+
+void UTowerGRPCClientManager::SendCoalescedRequest(
+	const FString& ServicePath,
+	const FString& PayloadJson,
+	int64 RequestId,
+	float TTLSeconds,
+	TFunction<void(bool bSuccess, const FString& ResponseBody)> OnResponse)
+{
+	const FString Key = ServicePath + TEXT("|") + PayloadJson;
+
+	if (const FCachedResponse* Cached = ResponseCache.Find(Key))
+	{
+		UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+		if (Cached->ExpiresAt > FPlatformTime::Seconds() && World)
+		{
+			CacheHits++;
+			UE_LOG(LogGRPCClient, Verbose, TEXT("== [%lld] %s served from cache"), RequestId, *ServicePath);
+
+			World->GetTimerManager().SetTimerForNextTick(
+				[this, RequestId, Body = Cached->Body, OnResponse = MoveTemp(OnResponse)]()
+				{
+					OnRequestCompleted.Broadcast(RequestId, Body);
+					OnResponse(true, Body);
+				});
+			return;
+		}
+		ResponseCache.Remove(Key);
+	}
+
+	if (TArray<FCoalescedWaiter>* Waiters = CoalescedCalls.Find(Key))
+	{
+		CoalescedRequests++;
+		UE_LOG(LogGRPCClient, Verbose, TEXT("== [%lld] %s joined request [%lld]"),
+			RequestId, *ServicePath, (*Waiters)[0].RequestId);
+		Waiters->Add({ RequestId, MoveTemp(OnResponse) });
+		return;
+	}
+
+	CoalescedCalls.Add(Key).Add({ RequestId, MoveTemp(OnResponse) });
+
+	SendRequest(ServicePath, PayloadJson, RequestId,
+		[this, Key, ServicePath, TTLSeconds](bool bSuccess, const FString& Body)
+		{
+			TArray<FCoalescedWaiter> Waiters;
+			if (!CoalescedCalls.RemoveAndCopyValue(Key, Waiters))
+			{
+				return;  // Disconnected meanwhile
+			}
+
+			if (bSuccess && TTLSeconds > 0.0f)
+			{
+				CacheResponse(Key, ServicePath, Body, TTLSeconds);
+			}
+
+			// The owner's RequestId already went through CompleteRequest; joiners get their own events
+			for (int32 i = 0; i < Waiters.Num(); ++i)
+			{
+				if (i > 0)
+				{
+					if (bSuccess)
+					{
+						OnRequestCompleted.Broadcast(Waiters[i].RequestId, Body);
+					}
+					else
+					{
+						OnRequestFailed.Broadcast(Waiters[i].RequestId, -1, Body);
+					}
+				}
+				Waiters[i].OnResponse(bSuccess, Body);
+			}
+		});
+}
+
+void UTowerGRPCClientManager::CacheResponse(const FString& Key, const FString& ServicePath, const FString& Body, float TTLSeconds)
+{
+	if (!ResponseCache.Contains(Key) && ResponseCache.Num() >= Config.MaxCachedResponses)
+	{
+		const FString* Victim = nullptr;
+		double SoonestExpiry = TNumericLimits<double>::Max();
+		for (const TPair<FString, FCachedResponse>& Pair : ResponseCache)
+		{
+			if (Pair.Value.ExpiresAt < SoonestExpiry)
+			{
+				SoonestExpiry = Pair.Value.ExpiresAt;
+				Victim = &Pair.Key;
+			}
+		}
+		if (Victim)
+		{
+			ResponseCache.Remove(FString(*Victim));
+		}
+	}
+
+	FCachedResponse& Entry = ResponseCache.Add(Key);
+	Entry.ServicePath = ServicePath;
+	Entry.Body = Body;
+	Entry.ExpiresAt = FPlatformTime::Seconds() + TTLSeconds;
+}
+
+void UTowerGRPCClientManager::InvalidateCachedService(const FString& ServicePath)
+{
+	const int32 Removed = ResponseCache.Num();
+	for (auto It = ResponseCache.CreateIterator(); It; ++It)
+	{
+		if (It->Value.ServicePath == ServicePath)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	UE_LOG(LogGRPCClient, Verbose, TEXT("Invalidated %d cached %s responses"),
+		Removed - ResponseCache.Num(), *ServicePath);
+}
+
+void UTowerGRPCClientManager::InvalidateResponseCache()
+{
+	ResponseCache.Empty();
+}
+
 void UTowerGRPCClientManager::HandleRequestFailure(int64 RequestId, int32 ErrorCode, const FString& ErrorMessage)
 {
 	TotalRequestsFailed++;
@@ -461,41 +1107,196 @@ void UTowerGRPCClientManager::HandleRequestFailure(int64 RequestId, int32 ErrorC
 	OnRequestFailed.Broadcast(RequestId, ErrorCode, ErrorMessage);
 }
 
-void UTowerGRPCClientManager::RecordLatency(int64 RequestId)
+void UTowerGRPCClientManager::RecordLatency(int64 RequestId, ERequestOutcome Outcome)
 {
-	if (const double* StartTime = InFlightRequests.Find(RequestId))
+	FInFlightRequest InFlight;
+	if (!InFlightRequests.RemoveAndCopyValue(RequestId, InFlight))
 	{
-		double ElapsedMs = (FPlatformTime::Seconds() - *StartTime) * 1000.0;
+		return;
+	}
+	RequestTimeouts.Cancel(InFlight.TimeoutTimer);
 
-		// Exponential moving average (alpha = 0.2)
-		if (AverageLatencyMs <= 0.0f)
-		{
-			AverageLatencyMs = static_cast<float>(ElapsedMs);
-		}
-		else
+	double ElapsedMs = (FPlatformTime::Seconds() - InFlight.StartTime) * 1000.0;
+
+	// HTTP reports a timeout as "no response"; tell them apart by how long it took
+	if (Outcome == ERequestOutcome::Failed && ElapsedMs >= Config.TimeoutSeconds * 1000.0)
+	{
+		Outcome = ERequestOutcome::TimedOut;
+	}
+
+	if (RPCStatsSlots.IsValidIndex(InFlight.StatsIndex))
+	{
+		FRPCStatsSlot& Slot = RPCStatsSlots[InFlight.StatsIndex];
+		switch (Outcome)
 		{
-			AverageLatencyMs = AverageLatencyMs * 0.8f + static_cast<float>(ElapsedMs) * 0.2f;
+		case ERequestOutcome::Succeeded:
+			Slot.Histogram.Record(ElapsedMs);
+			break;
+		case ERequestOutcome::Rejected:
+			Slot.Histogram.Record(ElapsedMs);
+			Slot.Failures++;
+			break;
+		case ERequestOutcome::Failed:
+			Slot.Failures++;
+			break;
+		case ERequestOutcome::TimedOut:
+			Slot.Failures++;
+			Slot.Timeouts++;
+			break;
 		}
 	}
+
+	if (Outcome != ERequestOutcome::Succeeded && Outcome != ERequestOutcome::Rejected)
+	{
+		return;
+	}
+
+	// Exponential moving average (alpha = 0.2)
+	if (AverageLatencyMs <= 0.0f)
+	{
+		AverageLatencyMs = static_cast<float>(ElapsedMs);
+	}
+	else
+	{
+		AverageLatencyMs = AverageLatencyMs * 0.8f + static_cast<float>(ElapsedMs) * 0.2f;
+	}
+}
+
+int32 UTowerGRPCClientManager::FindOrAddRPCStats(const FString& ServicePath, ETransportMode Transport)
+{
+	const FString Key = FString::Printf(TEXT("%s#%d"), *ServicePath, static_cast<int32>(Transport));
+	if (const int32* Existing = RPCStatsIndex.Find(Key))
+	{
+		return *Existing;
+	}
+
+	const int32 Index = RPCStatsSlots.AddDefaulted();
+	RPCStatsSlots[Index].ServicePath = ServicePath;
+	RPCStatsSlots[Index].Transport = Transport;
+	RPCStatsIndex.Add(Key, Index);
+	return Index;
+}
+
+TArray<FRPCLatencyStats> UTowerGRPCClientManager::GetRPCLatencyStats() const
+{
+	TArray<FRPCLatencyStats> Result;
+	Result.Reserve(RPCStatsSlots.Num());
+
+	for (const FRPCStatsSlot& Slot : RPCStatsSlots)
+	{
+		FRPCLatencyStats& Stats = Result.AddDefaulted_GetRef();
+		Stats.ServicePath = Slot.ServicePath;
+		Stats.Transport = Slot.Transport;
+		Stats.Count = static_cast<int32>(Slot.Histogram.GetCount());
+		Stats.Failures = Slot.Failures;
+		Stats.Timeouts = Slot.Timeouts;
+		Stats.MeanMs = static_cast<float>(Slot.Histogram.GetMeanMs());
+		Stats.P50Ms = static_cast<float>(Slot.Histogram.GetPercentile(50.0));
+		Stats.P95Ms = static_cast<float>(Slot.Histogram.GetPercentile(95.0));
+		Stats.P99Ms = static_cast<float>(Slot.Histogram.GetPercentile(99.0));
+		Stats.MaxMs = static_cast<float>(Slot.Histogram.GetMaxMs());
+	}
+
+	return Result;
+}
+
+void UTowerGRPCClientManager::ResetRPCLatencyStats()
+{
+	// Keep the slots so in-flight requests still land somewhere
+	for (FRPCStatsSlot& Slot : RPCStatsSlots)
+	{
+		Slot.Histogram.Reset();
+		Slot.Failures = 0;
+		Slot.Timeouts = 0;
+	}
+	TotalRetries = 0;
 }
 
 // ============================================================
 // Response processors
 // ============================================================
 
-void UTowerGRPCClientManager::ProcessFloorResponse(int64 RequestId, bool bSuccess, const FString& ResponseBody)
+void UTowerGRPCClientManager::ProcessFloorResponse(int64 RequestId, bool bSuccess, const FString& ResponseBody,
+	const TSharedPtr<const FProtoChunkData>& LocalChunk)
 {
 	if (!bSuccess)
 	{
 		return;
 	}
 
+	if (LocalChunk.IsValid())
+	{
+		TSharedPtr<FJsonObject> Json = ParseJson(ResponseBody);
+		bool bHashMatched = false;
+		if (Json.IsValid() && Json->TryGetBoolField(TEXT("hash_matched"), bHashMatched) && bHashMatched)
+		{
+			// Same response shape as a download, with the tiles we generated
+			TArray<TSharedPtr<FJsonValue>> Tiles;
+			Tiles.Reserve(LocalChunk->Tiles.Num());
+			for (const FProtoFloorTileData& Tile : LocalChunk->Tiles)
+			{
+				TSharedPtr<FJsonObject> TileJson = MakeShared<FJsonObject>();
+				TileJson->SetNumberField(TEXT("tile_type"), Tile.TileType);
+				TileJson->SetNumberField(TEXT("grid_x"), Tile.GridX);
+				TileJson->SetNumberField(TEXT("grid_y"), Tile.GridY);
+				TileJson->SetNumberField(TEXT("biome_id"), Tile.BiomeId);
+				TileJson->SetBoolField(TEXT("is_walkable"), Tile.bIsWalkable);
+				Tiles.Add(MakeShared<FJsonValueObject>(TileJson));
+			}
+			Json->SetArrayField(TEXT("tiles"), Tiles);
+
+			LocalFloorHits++;
+			UE_LOG(LogGRPCClient, Verbose, TEXT("== [%lld] Floor %d verified locally, %d tiles not downloaded"),
+				RequestId, LocalChunk->FloorId, LocalChunk->Tiles.Num());
+			OnFloorGenerated.Broadcast(RequestId, SerializeJson(Json));
+			return;
+		}
+
+		UE_LOG(LogGRPCClient, Log, TEXT("Floor %d hash mismatch, using server tiles"), LocalChunk->FloorId);
+	}
+
 	// Broadcast raw JSON — the floor layout is complex and callers (FloorManager, etc.)
 	// will parse it according to their own needs. We also broadcast the typed delegate
 	// with the full JSON for Blueprint consumers.
 	OnFloorGenerated.Broadcast(RequestId, ResponseBody);
 }
 
+bool UTowerGRPCClientManager::GenerateLocalChunk(int64 TowerSeed, int32 FloorId, FProtoChunkData& OutChunk) const
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	UTowerGameSubsystem* Game = GameInstance ? GameInstance->GetSubsystem<UTowerGameSubsystem>() : nullptr;
+
+	FFloorLayoutData Layout;
+	if (!Game || !Game->RequestFloorLayoutData(TowerSeed, FloorId, Layout) || !Layout.IsValid())
+	{
+		return false;
+	}
+
+	// Seed and biome as generate_floor in bevy-server/src/api/generation.rs derives them
+	OutChunk.Seed = static_cast<int64>(static_cast<uint64>(TowerSeed) + static_cast<uint64>(FloorId));
+	OutChunk.FloorId = FloorId;
+	OutChunk.BiomeId = 1 + FloorId % 5;
+	OutChunk.Width = Layout.Width;
+	OutChunk.Height = Layout.Height;
+
+	// Row-major, the order the server emits and hashes tiles in
+	OutChunk.Tiles.Reset(Layout.Tiles.Num());
+	for (int32 Y = 0; Y < Layout.Height; ++Y)
+	{
+		for (int32 X = 0; X < Layout.Width; ++X)
+		{
+			FProtoFloorTileData& Tile = OutChunk.Tiles.AddDefaulted_GetRef();
+			Tile.TileType = Layout.GetTile(X, Y);
+			Tile.GridX = X;
+			Tile.GridY = Y;
+			Tile.BiomeId = OutChunk.BiomeId;
+			// Not hashed; everything but Empty (0), Wall (2) and VoidPit (11)
+			Tile.bIsWalkable = Tile.TileType != 0 && Tile.TileType != 2 && Tile.TileType != 11;
+		}
+	}
+	return true;
+}
+
 void UTowerGRPCClientManager::ProcessDamageCalcResponse(int64 RequestId, bool bSuccess, const FString& ResponseBody)
 {
 	if (!bSuccess)
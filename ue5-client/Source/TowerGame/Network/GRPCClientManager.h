@@ -4,8 +4,14 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
+#include "LatencyHistogram.h"
+#include "NetTimerWheel.h"
+#include "PayloadCompression.h"
 #include "GRPCClientManager.generated.h"
 
+class IWebSocket;
+struct FProtoChunkData;
+
 // ============================================================
 // Enums
 // ============================================================
@@ -30,7 +36,9 @@ enum class ETransportMode : uint8
 	/** Plain JSON over HTTP without gRPC framing */
 	JSON    UMETA(DisplayName = "JSON"),
 	/** Foreign Function Interface via DLL bridge (tower_core.dll) */
-	FFI     UMETA(DisplayName = "FFI/DLL")
+	FFI     UMETA(DisplayName = "FFI/DLL"),
+	/** Same services multiplexed over one long-lived WebSocket; falls back to GRPC while it is down */
+	Stream  UMETA(DisplayName = "Multiplexed Stream")
 };
 
 // ============================================================
@@ -64,6 +72,29 @@ struct FGRPCConfig
 	/** Path to the Rust DLL for FFI fallback (relative to Binaries/) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "gRPC|Config")
 	FString FFIDllPath = TEXT("tower_core.dll");
+
+	/** How long a GetWallet response is reused (0 = never cached, identical calls still coalesce) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "gRPC|Config", meta = (ClampMin = "0.0"))
+	float WalletCacheTTLSeconds = 5.0f;
+
+	/** Floors are deterministic per (seed, floor), so they can be reused for a long time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "gRPC|Config", meta = (ClampMin = "0.0"))
+	float FloorCacheTTLSeconds = 600.0f;
+
+	/** Upper bound on cached responses; the entry closest to expiry is evicted first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "gRPC|Config", meta = (ClampMin = "1"))
+	int32 MaxCachedResponses = 32;
+
+	/** Let the server compress large responses (floors, catalogs) with a codec from PayloadCompression */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "gRPC|Config")
+	bool bAcceptCompressedResponses = true;
+
+	/**
+	 * Generate requested floors with the local Rust core first and send their validation
+	 * hash; the server only returns tiles when its chunk hashes differently
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "gRPC|Config")
+	bool bVerifyLocalFloors = true;
 };
 
 // ============================================================
@@ -201,6 +232,46 @@ struct FLootItemResult
 	int32 SocketCount = 0;
 };
 
+/** Latency distribution of one service path over one transport */
+USTRUCT(BlueprintType)
+struct FRPCLatencyStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	FString ServicePath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	ETransportMode Transport = ETransportMode::GRPC;
+
+	/** Calls that got a response (any status) */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 Count = 0;
+
+	/** Non-2xx responses plus calls that never got one */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 Failures = 0;
+
+	/** Calls that ran into Config.TimeoutSeconds */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 Timeouts = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	float MeanMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	float P50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	float P95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	float P99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	float MaxMs = 0.0f;
+};
+
 // ============================================================
 // Delegates
 // ============================================================
@@ -262,6 +333,12 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
 	const TArray<FLootItemResult>&, Items
 );
 
+/** Slice of a streamed binary response as it arrives; the view is valid for the duration of the call */
+DECLARE_DELEGATE_OneParam(FOnGRPCBytesReceived, TArrayView<const uint8>);
+
+/** A streamed binary response ended; false if it failed or was rejected */
+DECLARE_DELEGATE_OneParam(FOnGRPCStreamComplete, bool);
+
 // ============================================================
 // UTowerGRPCClientManager
 // ============================================================
@@ -270,8 +347,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
  * Manages the connection between UE5 and the Rust procedural core over
  * a JSON-over-HTTP transport that mirrors the proto service definitions.
  *
- * Service endpoints (27 POST + 3 GET = 30 total):
- *   GenerationService:  GenerateFloor, GenerateLoot, SpawnMonsters, GenerateMonsters, GenerateDestructibles, QuerySemanticTags
+ * Service endpoints (28 POST + 3 GET = 31 total):
+ *   GenerationService:  GenerateFloor, GenerateFloorChunk, GenerateLoot, SpawnMonsters, GenerateMonsters, GenerateDestructibles, QuerySemanticTags
  *   GameStateService:   GetState, GetWorldCycle, GetPlayerProfile, GetLiveStatus, GetLivePlayer
  *   CombatService:      CalculateDamage, GetCombatState, ProcessAction
  *   MasteryService:     TrackProgress, GetMasteryProfile, ChooseSpecialization, UpdateAbilityLoadout
@@ -281,6 +358,10 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
  *
  * Falls back to FFI/DLL bridge (tower_core.dll) when the gRPC server
  * is unreachable and the TransportMode allows it.
+ *
+ * TransportMode Stream keeps one WebSocket to /tower.Stream open and
+ * multiplexes calls over it by request id, skipping per-call connection
+ * setup. Calls go over plain HTTP whenever the stream is down.
  */
 UCLASS()
 class TOWERGAME_API UTowerGRPCClientManager : public UGameInstanceSubsystem
@@ -328,6 +409,9 @@ public:
 	/**
 	 * Request a procedurally generated floor layout.
 	 * Maps to: tower.GenerationService/GenerateFloor
+	 * With Config.bVerifyLocalFloors and the Rust core loaded, the floor is generated
+	 * locally and only its hash is checked against the server; the tiles are downloaded
+	 * only on a mismatch. OnFloorGenerated gets the same JSON either way.
 	 * @param TowerSeed  Shared tower seed
 	 * @param FloorId    Floor index to generate
 	 * @return RequestId for correlating the async response
@@ -335,6 +419,16 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "gRPC|Generation")
 	int64 RequestFloor(int64 TowerSeed, int32 FloorId);
 
+	/**
+	 * Download a floor as a serialized tower.game.ChunkData, handing each slice to
+	 * OnBytes on the game thread as it comes off the wire, e.g. into
+	 * ATowerProceduralFloorRenderer::ReceiveChunkBytes. Always plain HTTP: the
+	 * stream transport delivers whole responses only.
+	 * Maps to: tower.GenerationService/GenerateFloorChunk
+	 * @return RequestId; a failure is also broadcast through OnRequestFailed
+	 */
+	int64 RequestFloorChunk(int64 TowerSeed, int32 FloorId, FOnGRPCBytesReceived OnBytes, FOnGRPCStreamComplete OnComplete);
+
 	// ============ CombatService ============
 
 	/**
@@ -509,6 +603,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "gRPC|Destruction")
 	int64 RequestDestructionTemplates();
 
+	// ============ Response cache ============
+
+	/**
+	 * Drop cached responses for a service, e.g. "/tower.EconomyService/GetWallet"
+	 * after a server push or a local change that makes them stale.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "gRPC|Cache")
+	void InvalidateCachedService(const FString& ServicePath);
+
+	UFUNCTION(BlueprintCallable, Category = "gRPC|Cache")
+	void InvalidateResponseCache();
+
 	// ============ Delegates ============
 
 	UPROPERTY(BlueprintAssignable, Category = "gRPC|Events")
@@ -549,6 +655,29 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
 	float AverageLatencyMs = 0.0f;
 
+	/** Reconnect attempts (the manager retries the connection, not individual calls) */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 TotalRetries = 0;
+
+	/** Per service path and transport percentiles; also printed by the tower.RPCStats console command */
+	UFUNCTION(BlueprintPure, Category = "gRPC|Stats")
+	TArray<FRPCLatencyStats> GetRPCLatencyStats() const;
+
+	UFUNCTION(BlueprintCallable, Category = "gRPC|Stats")
+	void ResetRPCLatencyStats();
+
+	/** Calls answered from the response cache */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 CacheHits = 0;
+
+	/** Calls that joined an identical request already in flight */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 CoalescedRequests = 0;
+
+	/** Floors whose tiles came from local generation because the server's hash matched */
+	UPROPERTY(BlueprintReadOnly, Category = "gRPC|Stats")
+	int32 LocalFloorHits = 0;
+
 private:
 	// ============ Internal state ============
 
@@ -567,8 +696,95 @@ private:
 	/** Timer handle for reconnect backoff */
 	FTimerHandle ReconnectTimerHandle;
 
-	/** Tracks in-flight requests: RequestId -> send timestamp (for latency) */
-	TMap<int64, double> InFlightRequests;
+	struct FInFlightRequest
+	{
+		double StartTime = 0.0;
+		int32 StatsIndex = INDEX_NONE;
+		FNetTimerHandle TimeoutTimer;
+	};
+
+	/** Tracks in-flight requests: RequestId -> send timestamp and stats slot */
+	TMap<int64, FInFlightRequest> InFlightRequests;
+
+	/** One timer per in-flight request, keyed by RequestId; a completed request cancels its own */
+	FNetTimerWheel RequestTimeouts{ 0.05 };
+
+	/** Timer handle for advancing RequestTimeouts; runs only while requests are in flight */
+	FTimerHandle TimeoutSweepTimerHandle;
+
+	/** How an in-flight request ended, for the per-RPC counters */
+	enum class ERequestOutcome : uint8
+	{
+		Succeeded,
+		Rejected,   // Got a non-2xx response
+		Failed,     // No response
+		TimedOut,
+	};
+
+	struct FRPCStatsSlot
+	{
+		FString ServicePath;
+		ETransportMode Transport = ETransportMode::GRPC;
+		FLatencyHistogram Histogram;
+		int32 Failures = 0;
+		int32 Timeouts = 0;
+	};
+
+	TArray<FRPCStatsSlot> RPCStatsSlots;
+
+	/** "Path#Transport" -> index into RPCStatsSlots */
+	TMap<FString, int32> RPCStatsIndex;
+
+	// ============ Stream transport ============
+
+	/** A call sent over the stream, waiting for the frame with its request id */
+	struct FStreamCall
+	{
+		TFunction<void(bool bSuccess, const FString& ResponseBody)> OnResponse;
+	};
+
+	/** Long-lived socket to /tower.Stream (TransportMode == Stream only) */
+	TSharedPtr<IWebSocket> StreamSocket;
+
+	/** Calls in flight on StreamSocket, keyed by request id */
+	TMap<int64, FStreamCall> StreamCalls;
+
+	/** Reused frame buffers */
+	TArray<uint8> StreamSendBuffer;
+	TArray<uint8> StreamReceiveBuffer;
+
+	// ============ Compression ============
+
+	/** Inflates compressed response bodies (both transports) */
+	FPayloadDecompressor ResponseDecompressor;
+
+	/** UTowerNetworkSubsystem's traffic stats, for ServiceCall bytes and compression ratio */
+	class FTowerNetStatsCollector* NetStats = nullptr;
+
+	/** Decompress (if framed) and UTF-8 decode a response body; false on a corrupt frame */
+	bool DecodeResponseBody(TArrayView<const uint8> Bytes, FString& OutBody);
+
+	// ============ Coalescing & cache ============
+
+	/** A caller waiting on a shared request; each keeps its own RequestId */
+	struct FCoalescedWaiter
+	{
+		int64 RequestId = 0;
+		TFunction<void(bool bSuccess, const FString& ResponseBody)> OnResponse;
+	};
+
+	struct FCachedResponse
+	{
+		FString ServicePath;
+		FString Body;
+		double ExpiresAt = 0.0;
+	};
+
+	/** Identical requests in flight, keyed by path + payload. The first waiter owns the wire request. */
+	TMap<FString, TArray<FCoalescedWaiter>> CoalescedCalls;
+
+	/** Successful responses, keyed by path + payload */
+	TMap<FString, FCachedResponse> ResponseCache;
 
 	/** Handle to the loaded FFI DLL */
 	void* FFIDllHandle = nullptr;
@@ -609,8 +825,63 @@ private:
 		TFunction<void(bool bSuccess, const FString& ResponseBody)> OnResponse
 	);
 
-	/** Process a raw JSON response into the typed delegate for floors */
-	void ProcessFloorResponse(int64 RequestId, bool bSuccess, const FString& ResponseBody);
+	/**
+	 * SendRequest for idempotent reads: served from the cache when fresh, otherwise
+	 * joined to an identical request in flight, otherwise sent and cached for TTLSeconds.
+	 * Cached answers are delivered next tick so the caller always sees its RequestId first.
+	 */
+	void SendCoalescedRequest(
+		const FString& ServicePath,
+		const FString& PayloadJson,
+		int64 RequestId,
+		float TTLSeconds,
+		TFunction<void(bool bSuccess, const FString& ResponseBody)> OnResponse
+	);
+
+	/** Store a response, evicting the entry closest to expiry when full */
+	void CacheResponse(const FString& Key, const FString& ServicePath, const FString& Body, float TTLSeconds);
+
+	/** Shared completion for a response that arrived (HTTP status or stream frame status) */
+	void CompleteRequest(int64 RequestId, int32 Code, const FString& Body,
+		const TFunction<void(bool bSuccess, const FString& ResponseBody)>& OnResponse);
+
+	/** Open the multiplexed stream; requests use plain HTTP until it is up */
+	void OpenStream();
+
+	/** Release the stream socket and fail every call still waiting on it */
+	void CloseStream(const FString& Reason);
+
+	/** Fail every call waiting on the stream (socket dropped or closed) */
+	void FailStreamCalls(const FString& Reason);
+
+	/** Frame and send one call on the stream. Returns false if the stream is not usable. */
+	bool SendStreamRequest(const FString& ServicePath, const FString& PayloadJson, int64 RequestId,
+		TFunction<void(bool bSuccess, const FString& ResponseBody)>& OnResponse);
+
+	void OnStreamRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining);
+
+	/** Decode a response frame and complete the matching call */
+	void DispatchStreamFrame(TArrayView<const uint8> Frame);
+
+	/**
+	 * Start RequestId's timeout, and the sweep if it isn't running. Stream calls
+	 * are failed when it fires; HTTP requests carry their own timeout, so theirs
+	 * is a later backstop that only retires a request that never completed.
+	 */
+	void ArmRequestTimeout(int64 RequestId, float Seconds);
+
+	/** Fire the request timeouts that are due */
+	void ExpireRequests();
+
+	/**
+	 * Process a raw JSON response into the typed delegate for floors. When the server
+	 * confirmed LocalChunk's hash, its tiles are filled in from LocalChunk.
+	 */
+	void ProcessFloorResponse(int64 RequestId, bool bSuccess, const FString& ResponseBody,
+		const TSharedPtr<const FProtoChunkData>& LocalChunk);
+
+	/** Build the chunk GenerateFloor would return from the local Rust core; false if it isn't loaded */
+	bool GenerateLocalChunk(int64 TowerSeed, int32 FloorId, FProtoChunkData& OutChunk) const;
 
 	/** Process a raw JSON response into the typed delegate for damage calc */
 	void ProcessDamageCalcResponse(int64 RequestId, bool bSuccess, const FString& ResponseBody);
@@ -630,8 +901,11 @@ private:
 	/** Called when a health check response arrives */
 	void OnHealthCheckResponse(bool bSuccess, const FString& ResponseBody);
 
-	/** Update rolling average latency */
-	void RecordLatency(int64 RequestId);
+	/** Slot for ServicePath over Transport, created on first use */
+	int32 FindOrAddRPCStats(const FString& ServicePath, ETransportMode Transport);
+
+	/** Retire an in-flight request: rolling average, per-RPC histogram and failure counters */
+	void RecordLatency(int64 RequestId, ERequestOutcome Outcome);
 
 	/** Broadcast a generic failure and update stats */
 	void HandleRequestFailure(int64 RequestId, int32 ErrorCode, const FString& ErrorMessage);
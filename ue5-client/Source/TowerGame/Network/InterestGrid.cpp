@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "InterestGrid.h"
+
+bool FInterestGrid::SetViewerPosition(const FVector& Position)
+{
+    const FIntPoint NewCell = WorldToCell(Position);
+    const bool bChanged = !bHasViewer || NewCell != ViewerCell;
+
+    ViewerCell = NewCell;
+    bHasViewer = true;
+    return bChanged;
+}
+
+FIntPoint FInterestGrid::WorldToCell(const FVector& Position) const
+{
+    const float InvCellSize = 1.0f / FMath::Max(Settings.CellSize, 1.0f);
+    return FIntPoint(
+        FMath::FloorToInt(Position.X * InvCellSize),
+        FMath::FloorToInt(Position.Y * InvCellSize));
+}
+
+int32 FInterestGrid::GetCellDistance(const FVector& Position) const
+{
+    const FIntPoint Cell = WorldToCell(Position);
+    return FMath::Max(FMath::Abs(Cell.X - ViewerCell.X), FMath::Abs(Cell.Y - ViewerCell.Y));
+}
+
+float FInterestGrid::ComputePriority(const FVector& Position, bool bInCombat) const
+{
+    if (!bHasViewer)
+    {
+        return 1.0f;
+    }
+
+    const int32 Distance = GetCellDistance(Position);
+    if (Distance > Settings.FarRadiusCells)
+    {
+        return 0.0f;
+    }
+
+    // Linear falloff over the relevancy area; combat counts as one cell closer
+    const int32 Effective = FMath::Max(Distance - (bInCombat ? 1 : 0), 0);
+    return 1.0f - static_cast<float>(Effective) / static_cast<float>(Settings.FarRadiusCells + 1);
+}
+
+EInterestTier FInterestGrid::GetTier(const FVector& Position, bool bInCombat) const
+{
+    if (!bHasViewer)
+    {
+        return EInterestTier::Near;
+    }
+
+    const int32 Distance = GetCellDistance(Position);
+    if (Distance > Settings.FarRadiusCells)
+    {
+        return EInterestTier::Culled;
+    }
+
+    EInterestTier Tier = EInterestTier::Far;
+    if (Distance <= Settings.NearRadiusCells)
+    {
+        Tier = EInterestTier::Near;
+    }
+    else if (Distance <= Settings.MidRadiusCells)
+    {
+        Tier = EInterestTier::Mid;
+    }
+
+    // Fights in view are promoted one tier
+    if (bInCombat && Tier != EInterestTier::Near)
+    {
+        Tier = static_cast<EInterestTier>(static_cast<uint8>(Tier) - 1);
+    }
+    return Tier;
+}
+
+bool FInterestGrid::ShouldApplyUpdate(int64 EntityKey, EInterestTier Tier)
+{
+    if (Tier == EInterestTier::Culled)
+    {
+        ++Culled;
+        return false;
+    }
+
+    uint8* Counter = UpdateCounters.Find(EntityKey);
+    if (!Counter)
+    {
+        UpdateCounters.Add(EntityKey, 0);
+        return true;
+    }
+
+    int32 Interval = 1;
+    switch (Tier)
+    {
+        case EInterestTier::Mid: Interval = Settings.MidUpdateInterval; break;
+        case EInterestTier::Far: Interval = Settings.FarUpdateInterval; break;
+        default: break;
+    }
+
+    if (++(*Counter) >= Interval)
+    {
+        *Counter = 0;
+        return true;
+    }
+
+    ++Skipped;
+    return false;
+}
+
+bool FInterestGrid::ShouldApplyUntrackedUpdate(EInterestTier Tier)
+{
+    if (Tier == EInterestTier::Culled)
+    {
+        ++Culled;
+        return false;
+    }
+    return true;
+}
+
+void FInterestGrid::Reset()
+{
+    bHasViewer = false;
+    ViewerCell = FIntPoint::ZeroValue;
+    UpdateCounters.Reset();
+    ResetStats();
+}
@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InterestGrid.generated.h"
+
+/** How relevant a replicated entity is to the local viewer */
+UENUM(BlueprintType)
+enum class EInterestTier : uint8
+{
+    Near,       // Every update is applied
+    Mid,        // Every MidUpdateInterval-th update
+    Far,        // Every FarUpdateInterval-th update
+    Culled,     // Outside the relevancy area, not decoded into actors
+};
+
+/** Tunables for area-of-interest filtering */
+USTRUCT(BlueprintType)
+struct FInterestSettings
+{
+    GENERATED_BODY()
+
+    /** Edge length of one relevancy cell in world units (16 floor tiles of 100 units) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interest", meta = (ClampMin = "100.0"))
+    float CellSize = 1600.0f;
+
+    /** Chebyshev cell distance up to which entities are Near */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interest", meta = (ClampMin = "0"))
+    int32 NearRadiusCells = 1;
+
+    /** Chebyshev cell distance up to which entities are Mid */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interest", meta = (ClampMin = "0"))
+    int32 MidRadiusCells = 2;
+
+    /** Chebyshev cell distance up to which entities are Far; beyond this they are culled */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interest", meta = (ClampMin = "0"))
+    int32 FarRadiusCells = 4;
+
+    /** Apply one in N updates for Mid entities */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interest", meta = (ClampMin = "1", ClampMax = "16"))
+    int32 MidUpdateInterval = 2;
+
+    /** Apply one in N updates for Far entities */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interest", meta = (ClampMin = "1", ClampMax = "16"))
+    int32 FarUpdateInterval = 4;
+};
+
+/**
+ * Client-side spatial grid over the floor used for interest management.
+ *
+ * The floor is split into square cells of CellSize. The viewer's cell is
+ * reported to the server so it can filter what it sends, and every entity
+ * update is assigned a tier from its cell distance to the viewer. Entities
+ * in combat are promoted one tier so fights never look choppy. Mid and Far
+ * tiers are decimated per entity; Culled updates are skipped entirely.
+ *
+ * Not thread-safe; owned and used on the game thread.
+ */
+class TOWERGAME_API FInterestGrid
+{
+public:
+    void Configure(const FInterestSettings& InSettings) { Settings = InSettings; }
+    const FInterestSettings& GetSettings() const { return Settings; }
+
+    /** Move the viewer. Returns true when it entered a different cell. */
+    bool SetViewerPosition(const FVector& Position);
+
+    bool HasViewer() const { return bHasViewer; }
+    FIntPoint GetViewerCell() const { return ViewerCell; }
+
+    FIntPoint WorldToCell(const FVector& Position) const;
+
+    /** 0 (culled) .. 1 (same cell, or fighting nearby). Everything is 1 until a viewer is set. */
+    float ComputePriority(const FVector& Position, bool bInCombat) const;
+
+    EInterestTier GetTier(const FVector& Position, bool bInCombat) const;
+
+    /**
+     * Per-entity decimation: call once per received update. The first update
+     * for an entity is always accepted so it can spawn.
+     */
+    bool ShouldApplyUpdate(int64 EntityKey, EInterestTier Tier);
+
+    /**
+     * For entities without a stable key: only culling applies and nothing is
+     * remembered, so keys that change every update can't pile up.
+     */
+    bool ShouldApplyUntrackedUpdate(EInterestTier Tier);
+
+    /** Drop decimation state for a despawned entity */
+    void Forget(int64 EntityKey) { UpdateCounters.Remove(EntityKey); }
+
+    void Reset();
+
+    /** Updates skipped by decimation / culling since the last ResetStats */
+    int32 GetSkippedCount() const { return Skipped; }
+    int32 GetCulledCount() const { return Culled; }
+    void ResetStats() { Skipped = 0; Culled = 0; }
+
+private:
+    int32 GetCellDistance(const FVector& Position) const;
+
+    FInterestSettings Settings;
+    FIntPoint ViewerCell = FIntPoint::ZeroValue;
+    bool bHasViewer = false;
+
+    /** Updates seen since the last applied one, per entity */
+    TMap<int64, uint8> UpdateCounters;
+
+    int32 Skipped = 0;
+    int32 Culled = 0;
+};
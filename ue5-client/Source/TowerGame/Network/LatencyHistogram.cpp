@@ -0,0 +1,69 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LatencyHistogram.h"
+
+void FLatencyHistogram::Reset()
+{
+    FMemory::Memzero(Buckets, sizeof(Buckets));
+    Count = 0;
+    TotalMicros = 0;
+    MaxMicros = 0;
+}
+
+int32 FLatencyHistogram::BucketIndex(uint64 Micros)
+{
+    if (Micros < LinearBuckets)
+    {
+        return static_cast<int32>(Micros);
+    }
+
+    // Magnitude 1 covers [32, 64) in 2 us steps, magnitude 2 covers [64, 128) in 4 us steps, ...
+    const int32 Magnitude = FMath::Min<int32>(static_cast<int32>(FMath::FloorLog2_64(Micros)) - SubBucketBits, Magnitudes);
+    const int32 SubBucket = FMath::Min<int32>(static_cast<int32>(Micros >> Magnitude) - SubBuckets, SubBuckets - 1);
+    return LinearBuckets + (Magnitude - 1) * SubBuckets + SubBucket;
+}
+
+uint64 FLatencyHistogram::BucketUpperBound(int32 Index)
+{
+    if (Index < LinearBuckets)
+    {
+        return static_cast<uint64>(Index) + 1;
+    }
+
+    const int32 Magnitude = (Index - LinearBuckets) / SubBuckets + 1;
+    const int32 SubBucket = (Index - LinearBuckets) % SubBuckets;
+    return static_cast<uint64>(SubBuckets + SubBucket + 1) << Magnitude;
+}
+
+void FLatencyHistogram::Record(double Milliseconds)
+{
+    const uint64 Micros = static_cast<uint64>(FMath::Max(Milliseconds, 0.0) * 1000.0);
+
+    Buckets[BucketIndex(Micros)]++;
+    Count++;
+    TotalMicros += Micros;
+    MaxMicros = FMath::Max(MaxMicros, Micros);
+}
+
+double FLatencyHistogram::GetPercentile(double Percentile) const
+{
+    if (Count == 0)
+    {
+        return 0.0;
+    }
+
+    const int64 Target = FMath::Max<int64>(1, FMath::CeilToInt64(Count * FMath::Clamp(Percentile, 0.0, 100.0) / 100.0));
+
+    int64 Seen = 0;
+    for (int32 i = 0; i < NumBuckets; ++i)
+    {
+        Seen += Buckets[i];
+        if (Seen >= Target)
+        {
+            // Never report more than was actually observed
+            return static_cast<double>(FMath::Min(BucketUpperBound(i), MaxMicros)) / 1000.0;
+        }
+    }
+
+    return GetMaxMs();
+}
@@ -0,0 +1,47 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-bucket latency histogram in the style of HdrHistogram.
+ *
+ * Values are recorded in microseconds. Below 32 us every microsecond has its own
+ * bucket; above that each power of two is split into 16 linear sub-buckets, so
+ * any percentile is within ~6% of the true value. Recording is a couple of
+ * shifts and an increment, and the whole thing is a flat ~1.8 KB array.
+ */
+class TOWERGAME_API FLatencyHistogram
+{
+public:
+    FLatencyHistogram() { Reset(); }
+
+    void Record(double Milliseconds);
+
+    /** Latency at or below which Percentile (0-100) of the samples fall, in ms */
+    double GetPercentile(double Percentile) const;
+
+    double GetMaxMs() const { return static_cast<double>(MaxMicros) / 1000.0; }
+    double GetMeanMs() const { return Count > 0 ? static_cast<double>(TotalMicros) / Count / 1000.0 : 0.0; }
+    int64 GetCount() const { return Count; }
+
+    void Reset();
+
+private:
+    static constexpr int32 SubBucketBits = 4;
+    static constexpr int32 SubBuckets = 1 << SubBucketBits;
+    static constexpr int32 LinearBuckets = SubBuckets * 2;  // 0..31 us, 1 us each
+    static constexpr int32 Magnitudes = 26;                 // up to ~18 minutes
+    static constexpr int32 NumBuckets = LinearBuckets + Magnitudes * SubBuckets;
+
+    static int32 BucketIndex(uint64 Micros);
+
+    /** Upper edge of a bucket in microseconds */
+    static uint64 BucketUpperBound(int32 Index);
+
+    uint32 Buckets[NumBuckets];
+    int64 Count;
+    uint64 TotalMicros;
+    uint64 MaxMicros;
+};
@@ -0,0 +1,503 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LockstepSim.h"
+#include "StateSynchronizer.h"
+#include "BincodeSerializer.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+
+namespace
+{
+    /** bevy-server MonsterAi timings and distances, in ticks and world units */
+    constexpr int32 IdleToPatrolTicks = 3 * FLockstepSim::TickRate;
+    constexpr double PatrolReachDistance = 100.0;
+    constexpr double RetreatArriveDistance = 200.0;
+    constexpr double HomeArriveDistance = 100.0;
+
+    /** MonsterAi::default() patrol offsets from home, Bevy x/z mapped onto X/Y */
+    const FVector PatrolOffsets[] =
+    {
+        FVector(0.0, 500.0, 0.0),
+        FVector(500.0, 500.0, 0.0),
+        FVector(500.0, 0.0, 0.0),
+        FVector(0.0, 0.0, 0.0),
+    };
+
+    /** Upper bound on entities in a start message, against corrupt counts */
+    constexpr int64 MaxSerializedEntities = 4096;
+
+    void WriteVector(FBincodeWriter& Writer, const FVector& Value)
+    {
+        Writer.WriteF64(Value.X);
+        Writer.WriteF64(Value.Y);
+        Writer.WriteF64(Value.Z);
+    }
+
+    FVector ReadVector(FBincodeReader& Reader)
+    {
+        const double X = Reader.ReadF64();
+        const double Y = Reader.ReadF64();
+        const double Z = Reader.ReadF64();
+        return FVector(X, Y, Z);
+    }
+}
+
+void FLockstepSim::Reset(const FWorldStateBuffer& State, const FLockstepTuning& InTuning, const FTowerMovementSim& InMovement)
+{
+    // Clamped where the tuning is accepted, so the leader sends what it simulates
+    Tuning = InTuning;
+    Tuning.MonsterAttackTicks = FMath::Max(Tuning.MonsterAttackTicks, 1);
+    Tuning.PlayerAttackTicks = FMath::Max(Tuning.PlayerAttackTicks, 1);
+    Movement = InMovement;
+    WorldPhase = static_cast<uint8>(State.WorldCyclePhase);
+    Tick = 0;
+
+    Players.Reset(State.PlayerSnapshots.Num());
+    for (const FPlayerStateSnapshot& Snap : State.PlayerSnapshots)
+    {
+        FPlayer& Player = Players.AddDefaulted_GetRef();
+        Player.EntityId = Snap.EntityId;
+        Player.Move.Position = Snap.Position;
+        Player.Move.Yaw = Snap.Rotation.Yaw;
+        Player.Health = Snap.Health;
+        Player.Resources = Snap.Resources;
+    }
+
+    // Wherever a monster stands when the session starts is its home from then on
+    Monsters.Reset(State.MonsterSnapshots.Num());
+    for (const FMonsterStateSnapshot& Snap : State.MonsterSnapshots)
+    {
+        FMonster& Monster = Monsters.AddDefaulted_GetRef();
+        Monster.EntityId = Snap.EntityId;
+        Monster.Position = Snap.Position;
+        Monster.Home = Snap.Position;
+        Monster.Health = Snap.Health;
+        Monster.MaxHealth = FMath::Max(Snap.Health, 1.0f);
+        Monster.State = Snap.Health > 0.0f ? EMonsterAi::Idle : EMonsterAi::Dead;
+        Monster.StatusMask = static_cast<uint32>(Snap.StatusMask);
+    }
+}
+
+int32 FLockstepSim::FindPlayer(int64 EntityId) const
+{
+    return Algo::BinarySearchBy(Players, EntityId, &FPlayer::EntityId);
+}
+
+void FLockstepSim::Step(TConstArrayView<FLockstepInput> Inputs)
+{
+    check(Inputs.Num() == Players.Num());
+
+    for (int32 i = 0; i < Players.Num(); ++i)
+    {
+        FPlayer& Player = Players[i];
+        const FLockstepInput& Input = Inputs[i];
+        if (Player.Health <= 0.0f)
+        {
+            continue;
+        }
+
+        for (int32 Substep = 0; Substep < MoveSubsteps; ++Substep)
+        {
+            Player.Move = Movement.Step(Player.Move, Input.Move);
+        }
+
+        if (Player.AttackCooldown > 0)
+        {
+            --Player.AttackCooldown;
+        }
+        else if (Input.Buttons & LockstepButton_Attack)
+        {
+            // Nearest living monster in reach; ties go to the lower id
+            FMonster* Target = nullptr;
+            double TargetDistance = Tuning.PlayerAttackRange;
+            for (FMonster& Monster : Monsters)
+            {
+                const double Distance = FVector::Dist2D(Player.Move.Position, Monster.Position);
+                if (Monster.State != EMonsterAi::Dead && Distance <= TargetDistance && (!Target || Distance < TargetDistance))
+                {
+                    Target = &Monster;
+                    TargetDistance = Distance;
+                }
+            }
+
+            if (Target)
+            {
+                Target->Health = FMath::Max(Target->Health - Tuning.PlayerDamage, 0.0f);
+            }
+            Player.AttackCooldown = Tuning.PlayerAttackTicks;
+        }
+    }
+
+    for (FMonster& Monster : Monsters)
+    {
+        StepMonster(Monster);
+    }
+
+    ++Tick;
+}
+
+void FLockstepSim::StepMonster(FMonster& Monster)
+{
+    if (Monster.State == EMonsterAi::Dead)
+    {
+        return;
+    }
+
+    ++Monster.StateTicks;
+    if (Monster.AttackCooldown > 0)
+    {
+        --Monster.AttackCooldown;
+    }
+
+    if (Monster.Health <= 0.0f)
+    {
+        Monster.State = EMonsterAi::Dead;
+        Monster.StateTicks = 0;
+        return;
+    }
+
+    const double HealthFraction = Monster.Health / Monster.MaxHealth;
+    const double HomeDistance = FVector::Dist2D(Monster.Position, Monster.Home);
+
+    double NearestDistance = 0.0;
+    const int32 Nearest = FindNearestPlayer(Monster.Position, NearestDistance);
+
+    EMonsterAi NewState = Monster.State;
+    switch (Monster.State)
+    {
+    case EMonsterAi::Idle:
+    case EMonsterAi::Patrol:
+        if (Nearest != INDEX_NONE && NearestDistance <= Tuning.AggroRange)
+        {
+            Monster.TargetPlayer = Players[Nearest].EntityId;
+            NewState = EMonsterAi::Chase;
+        }
+        else if (Monster.State == EMonsterAi::Idle)
+        {
+            if (Monster.StateTicks > IdleToPatrolTicks)
+            {
+                NewState = EMonsterAi::Patrol;
+            }
+        }
+        else
+        {
+            const FVector Waypoint = Monster.Home + PatrolOffsets[Monster.PatrolIndex % UE_ARRAY_COUNT(PatrolOffsets)];
+            MoveToward(Monster.Position, Waypoint, Tuning.MonsterSpeed * 0.5);
+            if (FVector::Dist2D(Monster.Position, Waypoint) < PatrolReachDistance)
+            {
+                Monster.PatrolIndex = static_cast<uint8>((Monster.PatrolIndex + 1) % UE_ARRAY_COUNT(PatrolOffsets));
+            }
+        }
+        break;
+
+    case EMonsterAi::Chase:
+    case EMonsterAi::Attack:
+        if (HealthFraction <= Tuning.RetreatThreshold)
+        {
+            NewState = EMonsterAi::Retreat;
+        }
+        else if (HomeDistance > Tuning.LeashRange || Nearest == INDEX_NONE)
+        {
+            Monster.TargetPlayer = 0;
+            NewState = EMonsterAi::ReturnHome;
+        }
+        else if (Monster.State == EMonsterAi::Chase)
+        {
+            if (NearestDistance <= Tuning.MonsterAttackRange)
+            {
+                NewState = EMonsterAi::Attack;
+            }
+            else if (NearestDistance > Tuning.AggroRange * 1.5)
+            {
+                Monster.TargetPlayer = 0;
+                NewState = EMonsterAi::ReturnHome;
+            }
+            else
+            {
+                const int32 Target = FindPlayer(Monster.TargetPlayer);
+                if (Target != INDEX_NONE)
+                {
+                    MoveToward(Monster.Position, Players[Target].Move.Position, Tuning.MonsterSpeed);
+                }
+            }
+        }
+        else if (NearestDistance > Tuning.MonsterAttackRange * 1.2)
+        {
+            NewState = EMonsterAi::Chase;
+        }
+        else if (Monster.AttackCooldown == 0)
+        {
+            // The server leaves damage to its combat systems; here the nearest player takes a fixed hit
+            FPlayer& Player = Players[Nearest];
+            Player.Health = FMath::Max(Player.Health - Tuning.MonsterDamage, 0.0f);
+            Monster.TargetPlayer = Player.EntityId;
+            Monster.AttackCooldown = Tuning.MonsterAttackTicks;
+        }
+        break;
+
+    case EMonsterAi::Retreat:
+        MoveToward(Monster.Position, Monster.Home, Tuning.MonsterSpeed * 1.5);
+        if (FVector::Dist2D(Monster.Position, Monster.Home) < RetreatArriveDistance)
+        {
+            NewState = EMonsterAi::Idle;
+        }
+        else if (HealthFraction > Tuning.RetreatThreshold * 1.5)
+        {
+            NewState = EMonsterAi::Chase;
+        }
+        break;
+
+    case EMonsterAi::ReturnHome:
+        MoveToward(Monster.Position, Monster.Home, Tuning.MonsterSpeed);
+        if (FVector::Dist2D(Monster.Position, Monster.Home) < HomeArriveDistance)
+        {
+            // Heal on return home
+            Monster.Health = Monster.MaxHealth;
+            NewState = EMonsterAi::Idle;
+        }
+        break;
+
+    case EMonsterAi::Dead:
+        break;
+    }
+
+    if (NewState != Monster.State)
+    {
+        Monster.State = NewState;
+        Monster.StateTicks = 0;
+    }
+}
+
+int32 FLockstepSim::FindNearestPlayer(const FVector& Position, double& OutDistance) const
+{
+    int32 Nearest = INDEX_NONE;
+    OutDistance = TNumericLimits<double>::Max();
+    for (int32 i = 0; i < Players.Num(); ++i)
+    {
+        if (Players[i].Health <= 0.0f)
+        {
+            continue;
+        }
+
+        const double Distance = FVector::Dist2D(Position, Players[i].Move.Position);
+        if (Distance < OutDistance)
+        {
+            Nearest = i;
+            OutDistance = Distance;
+        }
+    }
+    return Nearest;
+}
+
+void FLockstepSim::MoveToward(FVector& Position, const FVector& Target, double Speed)
+{
+    const FVector ToTarget(Target.X - Position.X, Target.Y - Position.Y, 0.0);
+    const double Distance = ToTarget.Size();
+    const double StepLength = Speed * TickSeconds;
+    if (Distance <= StepLength)
+    {
+        Position.X = Target.X;
+        Position.Y = Target.Y;
+    }
+    else if (Distance > 0.0)
+    {
+        Position += ToTarget * (StepLength / Distance);
+    }
+}
+
+void FLockstepSim::WriteState(FWorldStateBuffer& Out, double StartTime) const
+{
+    Out.WorldCyclePhase = static_cast<EWorldCyclePhase>(WorldPhase);
+    Out.ServerTimestamp = StartTime + Tick * TickSeconds;
+
+    Out.PlayerSnapshots.SetNum(Players.Num(), EAllowShrinking::No);
+    for (int32 i = 0; i < Players.Num(); ++i)
+    {
+        const FPlayer& Player = Players[i];
+        FPlayerStateSnapshot& Snap = Out.PlayerSnapshots[i];
+        Snap.EntityId = Player.EntityId;
+        Snap.Position = Player.Move.Position;
+        Snap.Rotation = FRotator(0.0, Player.Move.Yaw, 0.0);
+        Snap.Health = Player.Health;
+        Snap.Resources = Player.Resources;
+        Snap.Timestamp = Out.ServerTimestamp;
+    }
+
+    int32 NumLiving = 0;
+    for (const FMonster& Monster : Monsters)
+    {
+        NumLiving += Monster.State != EMonsterAi::Dead ? 1 : 0;
+    }
+
+    Out.MonsterSnapshots.SetNum(NumLiving, EAllowShrinking::No);
+    int32 OutIndex = 0;
+    for (const FMonster& Monster : Monsters)
+    {
+        if (Monster.State == EMonsterAi::Dead)
+        {
+            continue;
+        }
+
+        FMonsterStateSnapshot& Snap = Out.MonsterSnapshots[OutIndex++];
+        Snap.EntityId = Monster.EntityId;
+        Snap.Position = Monster.Position;
+        Snap.Velocity = FVector::ZeroVector;     // Every tick is simulated; nothing to extrapolate
+        Snap.SampleTime = Out.ServerTimestamp;
+        Snap.Health = Monster.Health;
+
+        // Windup just before a hit, Active on the tick it lands, Recovery after
+        Snap.CombatPhase = EMonsterCombatPhase::Idle;
+        if (Monster.State == EMonsterAi::Attack)
+        {
+            const int32 Cooldown = Monster.AttackCooldown;
+            Snap.CombatPhase = Cooldown == Tuning.MonsterAttackTicks ? EMonsterCombatPhase::Active
+                : Cooldown <= Tuning.MonsterAttackTicks / 4 ? EMonsterCombatPhase::Windup
+                : EMonsterCombatPhase::Recovery;
+        }
+
+        Snap.StatusMask = static_cast<int32>(Monster.StatusMask);
+    }
+}
+
+// Start message body, bincode little-endian. Doubles are written as f64 so
+// the reader resumes from exactly the writer's bits.
+//
+//   i64  tick
+//   u8   world_phase
+//   tuning          f32 aggro, leash, monster_attack_range, monster_speed,
+//                   retreat_threshold, monster_damage; i32 monster_attack_ticks;
+//                   f32 player_damage, player_attack_range; i32 player_attack_ticks
+//   movement        f64 max_speed, acceleration, braking, rotation_rate
+//   Vec<Player>     i64 id, [f64; 3] position, [f64; 3] velocity, f64 yaw,
+//                   f32 health, [f32; 4] resources, i32 attack_cooldown
+//   Vec<Monster>    i64 id, [f64; 3] position, [f64; 3] home, f32 health,
+//                   f32 max_health, u8 state, i32 state_ticks, i64 target,
+//                   i32 attack_cooldown, u8 patrol_index, u32 status_mask
+
+void FLockstepSim::Serialize(FBincodeWriter& Writer) const
+{
+    Writer.WriteI64(Tick);
+    Writer.WriteU8(WorldPhase);
+
+    Writer.WriteF32(Tuning.AggroRange);
+    Writer.WriteF32(Tuning.LeashRange);
+    Writer.WriteF32(Tuning.MonsterAttackRange);
+    Writer.WriteF32(Tuning.MonsterSpeed);
+    Writer.WriteF32(Tuning.RetreatThreshold);
+    Writer.WriteF32(Tuning.MonsterDamage);
+    Writer.WriteI32(Tuning.MonsterAttackTicks);
+    Writer.WriteF32(Tuning.PlayerDamage);
+    Writer.WriteF32(Tuning.PlayerAttackRange);
+    Writer.WriteI32(Tuning.PlayerAttackTicks);
+
+    Writer.WriteF64(Movement.MaxSpeed);
+    Writer.WriteF64(Movement.Acceleration);
+    Writer.WriteF64(Movement.BrakingDeceleration);
+    Writer.WriteF64(Movement.RotationRate);
+
+    Writer.WriteU64(Players.Num());
+    for (const FPlayer& Player : Players)
+    {
+        Writer.WriteI64(Player.EntityId);
+        WriteVector(Writer, Player.Move.Position);
+        WriteVector(Writer, Player.Move.Velocity);
+        Writer.WriteF64(Player.Move.Yaw);
+        Writer.WriteF32(Player.Health);
+        Writer.WriteF32(static_cast<float>(Player.Resources.X));
+        Writer.WriteF32(static_cast<float>(Player.Resources.Y));
+        Writer.WriteF32(static_cast<float>(Player.Resources.Z));
+        Writer.WriteF32(static_cast<float>(Player.Resources.W));
+        Writer.WriteI32(Player.AttackCooldown);
+    }
+
+    Writer.WriteU64(Monsters.Num());
+    for (const FMonster& Monster : Monsters)
+    {
+        Writer.WriteI64(Monster.EntityId);
+        WriteVector(Writer, Monster.Position);
+        WriteVector(Writer, Monster.Home);
+        Writer.WriteF32(Monster.Health);
+        Writer.WriteF32(Monster.MaxHealth);
+        Writer.WriteU8(static_cast<uint8>(Monster.State));
+        Writer.WriteI32(Monster.StateTicks);
+        Writer.WriteI64(Monster.TargetPlayer);
+        Writer.WriteI32(Monster.AttackCooldown);
+        Writer.WriteU8(Monster.PatrolIndex);
+        Writer.WriteU32(Monster.StatusMask);
+    }
+}
+
+bool FLockstepSim::Deserialize(FBincodeReader& Reader)
+{
+    Tick = Reader.ReadI64();
+    WorldPhase = Reader.ReadU8();
+
+    Tuning.AggroRange = Reader.ReadF32();
+    Tuning.LeashRange = Reader.ReadF32();
+    Tuning.MonsterAttackRange = Reader.ReadF32();
+    Tuning.MonsterSpeed = Reader.ReadF32();
+    Tuning.RetreatThreshold = Reader.ReadF32();
+    Tuning.MonsterDamage = Reader.ReadF32();
+    Tuning.MonsterAttackTicks = Reader.ReadI32();
+    Tuning.PlayerDamage = Reader.ReadF32();
+    Tuning.PlayerAttackRange = Reader.ReadF32();
+    Tuning.PlayerAttackTicks = Reader.ReadI32();
+
+    // Reset never sends less than 1; clamping instead would simulate other values than the leader
+    if (Tuning.MonsterAttackTicks < 1 || Tuning.PlayerAttackTicks < 1)
+    {
+        return false;
+    }
+
+    Movement.MaxSpeed = Reader.ReadF64();
+    Movement.Acceleration = Reader.ReadF64();
+    Movement.BrakingDeceleration = Reader.ReadF64();
+    Movement.RotationRate = Reader.ReadF64();
+
+    const int64 NumPlayers = Reader.ReadU64();
+    if (Reader.HasError() || NumPlayers < 0 || NumPlayers > MaxSerializedEntities)
+    {
+        return false;
+    }
+
+    Players.SetNum(static_cast<int32>(NumPlayers));
+    for (FPlayer& Player : Players)
+    {
+        Player.EntityId = Reader.ReadI64();
+        Player.Move.Position = ReadVector(Reader);
+        Player.Move.Velocity = ReadVector(Reader);
+        Player.Move.Yaw = Reader.ReadF64();
+        Player.Health = Reader.ReadF32();
+        Player.Resources.X = Reader.ReadF32();
+        Player.Resources.Y = Reader.ReadF32();
+        Player.Resources.Z = Reader.ReadF32();
+        Player.Resources.W = Reader.ReadF32();
+        Player.AttackCooldown = Reader.ReadI32();
+    }
+
+    const int64 NumMonsters = Reader.ReadU64();
+    if (Reader.HasError() || NumMonsters < 0 || NumMonsters > MaxSerializedEntities)
+    {
+        return false;
+    }
+
+    Monsters.SetNum(static_cast<int32>(NumMonsters));
+    for (FMonster& Monster : Monsters)
+    {
+        Monster.EntityId = Reader.ReadI64();
+        Monster.Position = ReadVector(Reader);
+        Monster.Home = ReadVector(Reader);
+        Monster.Health = Reader.ReadF32();
+        Monster.MaxHealth = FMath::Max(Reader.ReadF32(), 1.0f);
+        Monster.State = static_cast<EMonsterAi>(FMath::Min<uint8>(Reader.ReadU8(), static_cast<uint8>(EMonsterAi::Dead)));
+        Monster.StateTicks = Reader.ReadI32();
+        Monster.TargetPlayer = Reader.ReadI64();
+        Monster.AttackCooldown = Reader.ReadI32();
+        Monster.PatrolIndex = Reader.ReadU8();
+        Monster.StatusMask = Reader.ReadU32();
+    }
+
+    return !Reader.HasError()
+        && Algo::IsSortedBy(Players, &FPlayer::EntityId)
+        && Algo::IsSortedBy(Monsters, &FMonster::EntityId);
+}
@@ -0,0 +1,205 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Player/TowerMovementSim.h"
+#include "LockstepSim.generated.h"
+
+struct FWorldStateBuffer;
+class FBincodeReader;
+class FBincodeWriter;
+
+/**
+ * What the lockstep sim steps with. Sent with every session start, so the
+ * whole party uses the leader's values. Monster values mirror the bevy-server
+ * MonsterAi defaults, in world units.
+ */
+USTRUCT(BlueprintType)
+struct FLockstepTuning
+{
+    GENERATED_BODY()
+
+    /** Distance at which an idle or patrolling monster starts chasing the nearest player */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float AggroRange = 1000.0f;
+
+    /** Distance from home past which a monster gives up and returns */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float LeashRange = 2000.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float MonsterAttackRange = 200.0f;
+
+    /** World units per second */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float MonsterSpeed = 300.0f;
+
+    /** Health fraction below which a monster retreats home */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float RetreatThreshold = 0.2f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float MonsterDamage = 10.0f;
+
+    /** Ticks between a monster's hits while in range */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "1"))
+    int32 MonsterAttackTicks = 20;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float PlayerDamage = 25.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float PlayerAttackRange = 250.0f;
+
+    /** Ticks between a player's hits while the attack button is held */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "1"))
+    int32 PlayerAttackTicks = 10;
+};
+
+/** Lockstep mode tunables that stay local to each client */
+USTRUCT(BlueprintType)
+struct FLockstepSettings
+{
+    GENERATED_BODY()
+
+    /** Largest party that runs in lockstep; bigger ones keep streaming state */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "1", ClampMax = "8"))
+    int32 MaxPartySize = 4;
+
+    /** Ticks between sampling local input and simulating it; covers the party's one-way latency */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "1", ClampMax = "20"))
+    int32 InputDelayTicks = 3;
+
+    /** Ticks between state hash exchanges */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "1"))
+    int32 HashIntervalTicks = 20;
+
+    /** Seconds spent waiting on a peer's input before the party falls back to streaming */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.1"))
+    float MaxStallSeconds = 1.0f;
+
+    /** Seconds the leader streams after a fallback before starting a new session */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (ClampMin = "0.0"))
+    float RestartDelaySeconds = 5.0f;
+
+    /** Used when this client leads a session */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep")
+    FLockstepTuning Tuning;
+};
+
+/** FLockstepInput::Buttons bits */
+enum ELockstepButton : uint8
+{
+    LockstepButton_Attack = 1 << 0,
+};
+
+/** One player's input for one lockstep tick */
+struct FLockstepInput
+{
+    FTowerMoveInput Move;
+    uint8 Buttons = 0;
+
+    bool operator==(const FLockstepInput& Other) const
+    {
+        return Move.Forward == Other.Move.Forward && Move.Right == Other.Move.Right
+            && Move.Yaw == Other.Move.Yaw && Buttons == Other.Buttons;
+    }
+};
+
+/**
+ * Deterministic co-op floor simulation for lockstep mode: players are stepped
+ * from their inputs through FTowerMovementSim, monsters through a port of the
+ * bevy-server MonsterAi state machine, and hits resolve with fixed damage.
+ * The same state and inputs always step to the same bits on the same build,
+ * so a party only needs to exchange inputs.
+ *
+ * Positions are in snapshot space, like FWorldStateBuffer. Only horizontal
+ * movement is simulated and there is no collision; the game-side character
+ * still drives its own actor. Not thread-safe.
+ */
+class TOWERGAME_API FLockstepSim
+{
+public:
+    static constexpr int32 TickRate = 20;
+    static constexpr double TickSeconds = 1.0 / TickRate;
+
+    /** Movement sim steps per lockstep tick, each with the tick's input */
+    static constexpr int32 MoveSubsteps = FTowerMovementSim::TickRate / TickRate;
+    static_assert(FTowerMovementSim::TickRate % TickRate == 0, "Lockstep ticks must span whole movement ticks");
+
+    /** Seed from an authoritative snapshot (entity arrays sorted by EntityId); the tick restarts at 0 */
+    void Reset(const FWorldStateBuffer& State, const FLockstepTuning& InTuning, const FTowerMovementSim& InMovement);
+
+    /** Advance one tick; Inputs[i] is GetPlayerId(i)'s input */
+    void Step(TConstArrayView<FLockstepInput> Inputs);
+
+    /**
+     * Fill Out's entities (sorted by EntityId, dead monsters left out), world phase
+     * and timestamp, StartTime plus the ticks stepped, keeping its allocations
+     */
+    void WriteState(FWorldStateBuffer& Out, double StartTime) const;
+
+    /** Exact state, tuning included; a peer reading it steps to the same bits */
+    void Serialize(FBincodeWriter& Writer) const;
+    bool Deserialize(FBincodeReader& Reader);
+
+    int64 GetTick() const { return Tick; }
+    int32 GetNumPlayers() const { return Players.Num(); }
+    int64 GetPlayerId(int32 Index) const { return Players[Index].EntityId; }
+
+    /** Index of the player, or INDEX_NONE */
+    int32 FindPlayer(int64 EntityId) const;
+
+private:
+    /** bevy-server AiState */
+    enum class EMonsterAi : uint8
+    {
+        Idle,
+        Patrol,
+        Chase,
+        Attack,
+        Retreat,
+        ReturnHome,
+        Dead,
+    };
+
+    struct FPlayer
+    {
+        int64 EntityId = 0;
+        FTowerMoveState Move;
+        float Health = 0.0f;
+        FVector4 Resources = FVector4(0.0, 0.0, 0.0, 0.0);
+        int32 AttackCooldown = 0;
+    };
+
+    struct FMonster
+    {
+        int64 EntityId = 0;
+        FVector Position = FVector::ZeroVector;
+        FVector Home = FVector::ZeroVector;
+        float Health = 0.0f;
+        float MaxHealth = 0.0f;
+        EMonsterAi State = EMonsterAi::Idle;
+        int32 StateTicks = 0;
+        int64 TargetPlayer = 0;         // 0 = none
+        int32 AttackCooldown = 0;
+        uint8 PatrolIndex = 0;
+        uint32 StatusMask = 0;          // Carried unchanged
+    };
+
+    void StepMonster(FMonster& Monster);
+
+    /** Nearest living player and its distance, or INDEX_NONE */
+    int32 FindNearestPlayer(const FVector& Position, double& OutDistance) const;
+
+    /** Move toward Target by Speed * TickSeconds, stopping on it */
+    static void MoveToward(FVector& Position, const FVector& Target, double Speed);
+
+    TArray<FPlayer> Players;        // Sorted by EntityId
+    TArray<FMonster> Monsters;      // Sorted by EntityId
+    FLockstepTuning Tuning;
+    FTowerMovementSim Movement;
+    uint8 WorldPhase = 0;
+    int64 Tick = 0;
+};
@@ -1,24 +1,103 @@
 #include "MatchConnection.h"
+#include "Core/StartupTimeline.h"
+#include "Core/TowerMemory.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "NetQuantize.h"
+#include "ProtoWire.h"
+#include "TowerNetworkSubsystem.h"
 #include "WebSocketsModule.h"
 #include "IWebSocket.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Guid.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Misc/Base64.h"
+#include "Misc/CoreDelegates.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Engine/World.h"
+
+// ============ Protobuf Envelope ============
+//
+// Nakama's realtime Envelope (nakama-common rtapi/realtime.proto), decoded with
+// the ProtoWire helpers. Field numbers used:
+//
+//   Envelope       1 cid, 11 error, 14 match_data, 15 match_data_send, 16 match_join, 24 rpc
+//   MatchDataSend  1 match_id, 2 op_code (int64), 3 data (bytes)
+//   MatchData      1 match_id, 2 presence, 3 op_code (int64), 4 data (bytes)
+//   MatchJoin      1 match_id
+//   Error          1 code, 2 message
+//   Rpc            1 id, 2 payload
+
+namespace NakamaProto
+{
+    using namespace ProtoWire;
+
+    constexpr uint32 EnvelopeCid           = 1;
+    constexpr uint32 EnvelopeError         = 11;
+    constexpr uint32 EnvelopeMatchData     = 14;
+    constexpr uint32 EnvelopeMatchDataSend = 15;
+    constexpr uint32 EnvelopeMatchJoin     = 16;
+    constexpr uint32 EnvelopeRpc           = 24;
+}
+
+namespace
+{
+    /** The failure payload SendRpc callers get, shaped like Nakama's HTTP error body */
+    FString MakeRpcError(const FString& Message, int32 Code)
+    {
+        TSharedPtr<FJsonObject> Error = MakeShareable(new FJsonObject());
+        Error->SetStringField(TEXT("message"), Message);
+        Error->SetNumberField(TEXT("code"), Code);
+
+        FString ErrorJson;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ErrorJson);
+        FJsonSerializer::Serialize(Error.ToSharedRef(), Writer);
+        return ErrorJson;
+    }
+
+    FString Utf8ToString(TArrayView<const uint8> Bytes)
+    {
+        FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        return FString(Converter.Length(), Converter.Get());
+    }
+}
 
 void UMatchConnection::Initialize(FSubsystemCollectionBase& Collection)
 {
+    TOWER_STARTUP_SCOPE(MatchConnection);
     Super::Initialize(Collection);
 
     // Ensure WebSockets module is loaded
     FModuleManager::Get().LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets"));
 
+    if (UTowerNetworkSubsystem* Network = Collection.InitializeDependency<UTowerNetworkSubsystem>())
+    {
+        NetStats = &Network->GetNetStats();
+        Capture = &Network->GetNetCapture();
+    }
+
+    InlineDecoder.Dispatcher = &Dispatcher;
+
+    // Coalesced messages go out once per frame
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UMatchConnection::OnEndFrame);
+
+    // Frames arrive during the core ticker, before the world ticks; pick up what the worker has decoded by then
+    WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddWeakLambda(this, [this](UWorld*, ELevelTick, float)
+        {
+            DrainReceived();
+        });
+
     UE_LOG(LogTemp, Log, TEXT("MatchConnection subsystem initialized"));
 }
 
 void UMatchConnection::Deinitialize()
 {
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
     Disconnect();
     Super::Deinitialize();
 }
@@ -27,19 +106,43 @@ void UMatchConnection::Deinitialize()
 
 FString UMatchConnection::GetWebSocketUrl() const
 {
-    return FString::Printf(TEXT("ws://%s:%d/ws?token=%s"),
-        *ServerHost, ServerPort, *CurrentToken);
+    return FString::Printf(TEXT("ws://%s:%d/ws?token=%s%s"),
+        *ServerHost, ServerPort, *CurrentToken,
+        bUseProtobufEnvelope ? TEXT("&format=protobuf") : TEXT(""));
 }
 
 void UMatchConnection::Connect(const FString& MatchId, const FString& AuthToken)
 {
-    if (bConnected)
+    if (bConnected || bResuming)
     {
         Disconnect();
     }
 
     CurrentMatchId = MatchId;
     CurrentToken = AuthToken;
+    SessionToken = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphensLower);
+    bResuming = false;
+    ResumeAttempts = 0;
+
+    FTCHARToUTF8 MatchIdConverter(*CurrentMatchId, CurrentMatchId.Len());
+    MatchIdUtf8.Reset();
+    MatchIdUtf8.Append(reinterpret_cast<const uint8*>(MatchIdConverter.Get()), MatchIdConverter.Length());
+
+    UE_LOG(LogTemp, Log, TEXT("Connecting to match %s..."), *MatchId);
+    OpenSocket();
+}
+
+void UMatchConnection::OpenSocket()
+{
+    bProtobufSession = bUseProtobufEnvelope;
+
+    // A failed earlier attempt may have left its worker running
+    StopReceiveWorker();
+    ReceiveFrameBuffer.Reset();
+    if (bDecodeOnWorkerThread)
+    {
+        StartReceiveWorker();
+    }
 
     FString Url = GetWebSocketUrl();
     TArray<FString> Protocols;
@@ -53,24 +156,110 @@ void UMatchConnection::Connect(const FString& MatchId, const FString& AuthToken)
     WebSocket->OnConnectionError().AddUObject(this, &UMatchConnection::OnWebSocketConnectionError);
     WebSocket->OnClosed().AddUObject(this, &UMatchConnection::OnWebSocketClosed);
     WebSocket->OnMessage().AddUObject(this, &UMatchConnection::OnWebSocketMessage);
+    WebSocket->OnRawMessage().AddUObject(this, &UMatchConnection::OnWebSocketRawMessage);
 
-    UE_LOG(LogTemp, Log, TEXT("Connecting to match %s..."), *MatchId);
     WebSocket->Connect();
 }
 
-void UMatchConnection::Disconnect()
+void UMatchConnection::CloseSocket()
 {
     if (WebSocket.IsValid())
     {
+        // Whatever this socket reports from here on is about a connection we're done with
+        WebSocket->OnConnected().RemoveAll(this);
+        WebSocket->OnConnectionError().RemoveAll(this);
+        WebSocket->OnClosed().RemoveAll(this);
+        WebSocket->OnMessage().RemoveAll(this);
+        WebSocket->OnRawMessage().RemoveAll(this);
         if (WebSocket->IsConnected())
         {
             WebSocket->Close();
         }
         WebSocket.Reset();
     }
+}
+
+void UMatchConnection::Disconnect()
+{
+    // Don't lose the last frame's messages
+    FlushOutgoing();
+    OutgoingQueue.Reset();
+    OutgoingPayloads.Reset();
+
+    // Leaving for good: the match needn't hold our slot for a resume
+    if (bConnected && WebSocket.IsValid() && WebSocket->IsConnected())
+    {
+        static const uint8 EmptyJson[] = { '{', '}' };
+        SendImmediate(EMatchOpCode::LeaveMatch, MakeArrayView(EmptyJson, UE_ARRAY_COUNT(EmptyJson)));
+    }
+
+    CloseSocket();
+
+    // Whatever is still being decoded belongs to the match being left
+    StopReceiveWorker();
+    ReceiveFrameBuffer.Reset();
 
     bConnected = false;
+    bResuming = false;
     CurrentMatchId.Empty();
+    FailPendingRpcs(TEXT("Disconnected"));
+}
+
+void UMatchConnection::HandleSocketLost(const FString& Reason)
+{
+    const bool bWasInMatch = bConnected || bResuming;
+    bConnected = false;
+    FailPendingRpcs(Reason);
+
+    if (!bWasInMatch || CurrentMatchId.IsEmpty() || ResumeGraceSeconds <= 0.0f)
+    {
+        bResuming = false;
+        OnDisconnected.Broadcast(Reason);
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (!bResuming)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Match %s connection lost (%s), resuming for up to %.0fs"),
+            *CurrentMatchId, *Reason, ResumeGraceSeconds);
+        bResuming = true;
+        InterruptedAt = Now;
+        ResumeAttempts = 0;
+        OnInterrupted.Broadcast(Reason);
+    }
+
+    // 0.25s, 0.5s, 1s, then every 2s: a blip is over by the first or second try
+    NextResumeAttemptAt = Now + FMath::Min(0.25 * (1 << FMath::Min(ResumeAttempts, 3)), 2.0);
+}
+
+void UMatchConnection::TickResume()
+{
+    if (!bResuming || bConnected)
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - InterruptedAt >= ResumeGraceSeconds)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Match %s not resumed after %d attempt(s) in %.0fs"),
+            *CurrentMatchId, ResumeAttempts, ResumeGraceSeconds);
+        Disconnect();
+        OnDisconnected.Broadcast(TEXT("Resume timed out"));
+        return;
+    }
+
+    if (Now < NextResumeAttemptAt)
+    {
+        return;
+    }
+
+    // Not again until this attempt connects or fails
+    ++ResumeAttempts;
+    NextResumeAttemptAt = TNumericLimits<double>::Max();
+    CloseSocket();
+    OpenSocket();
 }
 
 // ============ WebSocket Callbacks ============
@@ -80,39 +269,259 @@ void UMatchConnection::OnWebSocketConnected()
     bConnected = true;
     UE_LOG(LogTemp, Log, TEXT("WebSocket connected to match %s"), *CurrentMatchId);
 
-    // Send match join message
-    TSharedPtr<FJsonObject> JoinMsg = MakeShareable(new FJsonObject());
-    TSharedPtr<FJsonObject> MatchJoin = MakeShareable(new FJsonObject());
-    MatchJoin->SetStringField(TEXT("match_id"), CurrentMatchId);
-    JoinMsg->SetObjectField(TEXT("match_join"), MatchJoin);
+    if (bProtobufSession)
+    {
+        // Envelope { match_join { match_id, metadata { "session": token } } }
+        FTCHARToUTF8 TokenConverter(*SessionToken, SessionToken.Len());
+        TArray<uint8> Entry;
+        NakamaProto::WriteBytes(Entry, 1, TArrayView<const uint8>(reinterpret_cast<const uint8*>("session"), 7));
+        NakamaProto::WriteBytes(Entry, 2, TArrayView<const uint8>(reinterpret_cast<const uint8*>(TokenConverter.Get()), TokenConverter.Length()));
 
-    FString JoinJson;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JoinJson);
-    FJsonSerializer::Serialize(JoinMsg.ToSharedRef(), Writer);
+        TArray<uint8> Join;
+        NakamaProto::WriteBytes(Join, 1, MatchIdUtf8);
+        NakamaProto::WriteBytes(Join, 3, Entry);
 
-    WebSocket->Send(JoinJson);
+        SendFrameBuffer.Reset();
+        NakamaProto::WriteBytes(SendFrameBuffer, NakamaProto::EnvelopeMatchJoin, Join);
 
+        WebSocket->Send(SendFrameBuffer.GetData(), SendFrameBuffer.Num(), true);
+    }
+    else
+    {
+        // Send match join message
+        TSharedPtr<FJsonObject> JoinMsg = MakeShareable(new FJsonObject());
+        TSharedPtr<FJsonObject> MatchJoin = MakeShareable(new FJsonObject());
+        TSharedPtr<FJsonObject> Metadata = MakeShareable(new FJsonObject());
+        Metadata->SetStringField(TEXT("session"), SessionToken);
+        MatchJoin->SetStringField(TEXT("match_id"), CurrentMatchId);
+        MatchJoin->SetObjectField(TEXT("metadata"), Metadata);
+        JoinMsg->SetObjectField(TEXT("match_join"), MatchJoin);
+
+        FString JoinJson;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JoinJson);
+        FJsonSerializer::Serialize(JoinMsg.ToSharedRef(), Writer);
+
+        WebSocket->Send(JoinJson);
+    }
+
+    if (bResuming)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Match %s resumed after %.2fs (%d attempt(s))"),
+            *CurrentMatchId, FPlatformTime::Seconds() - InterruptedAt, ResumeAttempts);
+        bResuming = false;
+        OnResumed.Broadcast();
+        return;
+    }
     OnConnected.Broadcast();
 }
 
 void UMatchConnection::OnWebSocketConnectionError(const FString& Error)
 {
     UE_LOG(LogTemp, Error, TEXT("WebSocket connection error: %s"), *Error);
-    bConnected = false;
-    OnDisconnected.Broadcast(Error);
+    HandleSocketLost(Error);
 }
 
 void UMatchConnection::OnWebSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
 {
     UE_LOG(LogTemp, Log, TEXT("WebSocket closed: %d %s (clean: %s)"),
         StatusCode, *Reason, bWasClean ? TEXT("yes") : TEXT("no"));
-    bConnected = false;
-    OnDisconnected.Broadcast(Reason);
+    HandleSocketLost(Reason);
 }
 
 void UMatchConnection::OnWebSocketMessage(const FString& Message)
 {
-    ParseMatchMessage(Message);
+    LLM_SCOPE_BYTAG(Tower_Net);
+
+    if (ReceiveWorker.IsValid())
+    {
+        ReceiveWorker->EnqueueText(Message);
+        return;
+    }
+
+    DecodeInline(&Message, TArrayView<const uint8>());
+}
+
+void UMatchConnection::OnWebSocketRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+{
+    LLM_SCOPE_BYTAG(Tower_Net);
+
+    // Only binary frames matter here; text frames also arrive via OnMessage
+    if (!bProtobufSession)
+    {
+        return;
+    }
+
+    const uint8* Bytes = static_cast<const uint8*>(Data);
+
+    // Common case without a worker: a whole frame in one callback, parsed straight from the socket buffer
+    if (!ReceiveWorker.IsValid() && BytesRemaining == 0 && ReceiveFrameBuffer.Num() == 0)
+    {
+        DecodeInline(nullptr, TArrayView<const uint8>(Bytes, static_cast<int32>(Size)));
+        return;
+    }
+
+    ReceiveFrameBuffer.Append(Bytes, static_cast<int32>(Size));
+    if (BytesRemaining != 0)
+    {
+        return;
+    }
+
+    if (ReceiveWorker.IsValid())
+    {
+        // The worker owns the frame from here; the next one starts a fresh buffer
+        ReceiveWorker->EnqueueBinary(MoveTemp(ReceiveFrameBuffer));
+        ReceiveFrameBuffer.Reset();
+    }
+    else
+    {
+        DecodeInline(nullptr, ReceiveFrameBuffer);
+        ReceiveFrameBuffer.Reset();
+    }
+}
+
+// ============ Receive ============
+
+void UMatchConnection::StartReceiveWorker()
+{
+    if (ReceiveThread)
+    {
+        return;
+    }
+
+    ReceiveWorker = MakeUnique<FMatchReceiveWorker>(&Dispatcher);
+    ReceiveThread = FRunnableThread::Create(ReceiveWorker.Get(), TEXT("MatchReceive"), 0, TPri_AboveNormal);
+
+    if (!ReceiveThread)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MatchConnection: couldn't start receive thread, decoding on the game thread"));
+        ReceiveWorker.Reset();
+    }
+}
+
+void UMatchConnection::StopReceiveWorker()
+{
+    if (ReceiveThread)
+    {
+        // Kill(true) calls Stop() and waits for Run() to return
+        ReceiveThread->Kill(true);
+        delete ReceiveThread;
+        ReceiveThread = nullptr;
+    }
+
+    ReceiveWorker.Reset();
+}
+
+void UMatchConnection::DecodeInline(const FString* Text, TArrayView<const uint8> Bytes)
+{
+    InlineDecoder.bKeepWirePayload = Capture && Capture->IsOpen();
+
+    const double ArrivalTime = FPlatformTime::Seconds();
+    if (Text)
+    {
+        InlineDecoder.DecodeText(*Text, ArrivalTime, InlineDecoded);
+    }
+    else
+    {
+        InlineDecoder.DecodeEnvelope(Bytes, ArrivalTime, InlineDecoded);
+    }
+
+    // Moved out first: a listener may disconnect, or inject, from its handler
+    TArray<FMatchInboundMessage> Messages = MoveTemp(InlineDecoded);
+    InlineDecoded.Reset();
+    for (const FMatchInboundMessage& Message : Messages)
+    {
+        DispatchInbound(Message);
+    }
+}
+
+void UMatchConnection::InjectMatchPayload(EMatchOpCode OpCode, TArrayView<const uint8> Payload)
+{
+    InlineDecoder.bKeepWirePayload = Capture && Capture->IsOpen();
+
+    FMatchInboundMessage Message;
+    if (InlineDecoder.DecodePayload(OpCode, Payload, FPlatformTime::Seconds(), Message))
+    {
+        DispatchInbound(Message);
+    }
+}
+
+void UMatchConnection::DrainReceived()
+{
+    if (!ReceiveWorker.IsValid())
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_DrainReceived);
+    LLM_SCOPE_BYTAG(Tower_Net);
+    ReceiveWorker->SetKeepWirePayload(Capture && Capture->IsOpen());
+
+    // Re-checked per message: a listener may disconnect, which stops the worker
+    FMatchInboundMessage Message;
+    while (ReceiveWorker.IsValid() && ReceiveWorker->Dequeue(Message))
+    {
+        DispatchInbound(Message);
+    }
+}
+
+void UMatchConnection::DispatchInbound(const FMatchInboundMessage& Message)
+{
+    switch (Message.Kind)
+    {
+    case FMatchInboundMessage::EKind::RpcResult:
+        CompleteRpc(Message.Cid, true, Message.Text);
+        return;
+
+    case FMatchInboundMessage::EKind::Error:
+        if (Message.Cid.IsEmpty() || !CompleteRpc(Message.Cid, false, MakeRpcError(Message.Text, Message.ErrorCode)))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Match error: %s"), *Message.Text);
+        }
+        return;
+
+    default:
+        break;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_DispatchMatchPayload);
+    const uint64 DispatchStart = FPlatformTime::Cycles64();
+    const EMatchOpCode OpCode = Message.OpCode;
+    const ETowerNetChannel Channel = GetStatsChannel(OpCode);
+
+    // Captured as received, so replays exercise decompression too. Messages
+    // decoded before the capture opened have no wire bytes and are left out.
+    if (Capture && Capture->IsOpen() && Message.WirePayload.Num() == Message.WireBytes)
+    {
+        Capture->Write(ENetCaptureSource::Match, static_cast<uint8>(OpCode), Message.ArrivalTime, Message.WirePayload);
+    }
+
+    if (IsBinaryOpCode(OpCode))
+    {
+        Dispatcher.Dispatch(OpCode, Message.Payload);
+    }
+    else
+    {
+        // Decoded before anyone subscribed to this op code: parse it here instead
+        TSharedPtr<FJsonObject> LateJson;
+        if (!Message.Json.IsValid() && Dispatcher.HasSubscribers(OpCode))
+        {
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message.Text);
+            FJsonSerializer::Deserialize(Reader, LateJson);
+        }
+
+        const TSharedPtr<FJsonObject>& Json = Message.Json.IsValid() ? Message.Json : LateJson;
+        Dispatcher.Dispatch(OpCode, Json.Get());
+        OnMatchData.Broadcast(OpCode, Message.Text);
+    }
+
+    if (NetStats)
+    {
+        if (Message.bDecompressed)
+        {
+            NetStats->RecordDecompressed(Channel, Message.WireBytes, Message.RawBytes);
+        }
+        NetStats->RecordIncoming(Channel, Message.WireBytes, Message.DecodeCycles + (FPlatformTime::Cycles64() - DispatchStart));
+    }
 }
 
 // ============ Send Data ============
@@ -121,23 +530,166 @@ void UMatchConnection::SendMatchData(EMatchOpCode OpCode, const FString& DataJso
 {
     if (!bConnected || !WebSocket.IsValid()) return;
 
-    FString Encoded = EncodeMatchData(OpCode, DataJson);
-    WebSocket->Send(Encoded);
+    // Payload is handled as UTF-8 bytes from here on: no base64, no outer JSON pass
+    FTCHARToUTF8 Converter(*DataJson, DataJson.Len());
+    SendMatchDataRaw(OpCode, TArrayView<const uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length()));
+}
+
+void UMatchConnection::SendMatchDataRaw(EMatchOpCode OpCode, TArrayView<const uint8> Payload)
+{
+    if (!bConnected || !WebSocket.IsValid()) return;
+
+    // Binary payloads can't be embedded in a JSON batch; they always go out on their own
+    if (bCoalesceOutgoing && !IsBinaryOpCode(OpCode) && !IsUrgentOpCode(OpCode))
+    {
+        QueueOutgoing(OpCode, Payload);
+        return;
+    }
+
+    // Urgent ops must not overtake what was queued before them
+    FlushOutgoing();
+    SendImmediate(OpCode, Payload);
+}
+
+void UMatchConnection::QueueOutgoing(EMatchOpCode OpCode, TArrayView<const uint8> Payload)
+{
+    // Positions are absolute, so an older one queued this frame is redundant
+    if (OpCode == EMatchOpCode::PlayerPosition)
+    {
+        for (FQueuedMatchMessage& Queued : OutgoingQueue)
+        {
+            if (Queued.OpCode == EMatchOpCode::PlayerPosition)
+            {
+                Queued.OpCode = EMatchOpCode::None;
+                ++CoalescedMessages;
+            }
+        }
+    }
+
+    FQueuedMatchMessage& Entry = OutgoingQueue.AddDefaulted_GetRef();
+    Entry.OpCode = OpCode;
+    Entry.Offset = OutgoingPayloads.Num();
+    Entry.Length = Payload.Num();
+    OutgoingPayloads.Append(Payload.GetData(), Payload.Num());
+}
+
+void UMatchConnection::FlushOutgoing()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_FlushOutgoing);
+    if (OutgoingQueue.Num() == 0)
+    {
+        return;
+    }
+
+    if (!bConnected || !WebSocket.IsValid())
+    {
+        OutgoingQueue.Reset();
+        OutgoingPayloads.Reset();
+        return;
+    }
+
+    int32 LiveCount = 0;
+    const FQueuedMatchMessage* Single = nullptr;
+    for (const FQueuedMatchMessage& Queued : OutgoingQueue)
+    {
+        if (Queued.OpCode != EMatchOpCode::None)
+        {
+            ++LiveCount;
+            Single = &Queued;
+        }
+    }
+
+    if (LiveCount == 1)
+    {
+        // Nothing to merge: send with its own op code and no batch wrapper
+        SendImmediate(Single->OpCode, TArrayView<const uint8>(OutgoingPayloads.GetData() + Single->Offset, Single->Length));
+    }
+    else if (LiveCount > 1)
+    {
+        // [{"op":N,"d":<payload>},...] — payloads are spliced in verbatim
+        BatchBuffer.Reset();
+        BatchBuffer.Add('[');
+        bool bFirst = true;
+        for (const FQueuedMatchMessage& Queued : OutgoingQueue)
+        {
+            if (Queued.OpCode == EMatchOpCode::None)
+            {
+                continue;
+            }
+
+            ANSICHAR Header[24];
+            const int32 HeaderLen = FCStringAnsi::Snprintf(Header, UE_ARRAY_COUNT(Header), "%s{\"op\":%d,\"d\":",
+                bFirst ? "" : ",", static_cast<int32>(Queued.OpCode));
+            BatchBuffer.Append(reinterpret_cast<const uint8*>(Header), HeaderLen);
+
+            if (Queued.Length > 0)
+            {
+                BatchBuffer.Append(OutgoingPayloads.GetData() + Queued.Offset, Queued.Length);
+            }
+            else
+            {
+                BatchBuffer.Append(reinterpret_cast<const uint8*>("null"), 4);
+            }
+            BatchBuffer.Add('}');
+            bFirst = false;
+        }
+        BatchBuffer.Add(']');
+
+        CoalescedMessages += LiveCount - 1;
+        SendImmediate(EMatchOpCode::Batch, BatchBuffer);
+    }
+
+    OutgoingQueue.Reset();
+    OutgoingPayloads.Reset();
+}
+
+void UMatchConnection::SendImmediate(EMatchOpCode OpCode, TArrayView<const uint8> Payload)
+{
+    if (!bProtobufSession)
+    {
+        // JSON envelope needs a string payload; binary op codes go through base64 as before
+        if (IsBinaryOpCode(OpCode))
+        {
+            WebSocket->Send(EncodeMatchData(OpCode, FBase64::Encode(Payload.GetData(), Payload.Num())));
+        }
+        else
+        {
+            FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+            WebSocket->Send(EncodeMatchData(OpCode, FString(Converter.Length(), Converter.Get())));
+        }
+
+        if (NetStats)
+        {
+            // Payload size; the JSON envelope overhead isn't worth re-encoding to measure
+            NetStats->RecordOutgoing(GetStatsChannel(OpCode), Payload.Num());
+        }
+        return;
+    }
+
+    EncodeMatchDataProtobuf(OpCode, Payload);
+    WebSocket->Send(SendFrameBuffer.GetData(), SendFrameBuffer.Num(), true);
+
+    if (NetStats)
+    {
+        NetStats->RecordOutgoing(GetStatsChannel(OpCode), SendFrameBuffer.Num());
+    }
 }
 
 void UMatchConnection::SendPosition(FVector Position, FRotator Rotation)
 {
-    FString Json = FString::Printf(
-        TEXT("{\"position\":{\"x\":%.1f,\"y\":%.1f,\"z\":%.1f},\"rotation\":{\"yaw\":%.1f}}"),
-        Position.X, Position.Y, Position.Z, Rotation.Yaw);
+    // Whole centimetres and a u16 yaw (NetQuantize): the server validates absolute
+    // positions without knowing the floor bounds, so no floor-local offsets here
+    FString Json = FString::Printf(TEXT("{\"p\":[%d,%d,%d],\"r\":%u}"),
+        FMath::RoundToInt32(Position.X), FMath::RoundToInt32(Position.Y), FMath::RoundToInt32(Position.Z),
+        static_cast<uint32>(NetQuantize::QuantizeYaw(Rotation.Yaw)));
     SendMatchData(EMatchOpCode::PlayerPosition, Json);
 }
 
-void UMatchConnection::SendAttack(int32 TargetMonsterId, float Damage, int32 AngleId, int32 ComboStep)
+void UMatchConnection::SendAttack(int32 TargetMonsterId, float Damage, int32 AngleId, int32 ComboStep, double RenderTime)
 {
     FString Json = FString::Printf(
-        TEXT("{\"target_id\":%d,\"damage\":%.1f,\"angle_id\":%d,\"combo_step\":%d}"),
-        TargetMonsterId, Damage, AngleId, ComboStep);
+        TEXT("{\"target_id\":%d,\"damage\":%.1f,\"angle_id\":%d,\"combo_step\":%d,\"render_time\":%.4f}"),
+        TargetMonsterId, Damage, AngleId, ComboStep, RenderTime);
     SendMatchData(EMatchOpCode::PlayerAttack, Json);
 }
 
@@ -188,10 +740,147 @@ FString UMatchConnection::EncodeMatchData(EMatchOpCode OpCode, const FString& Da
     return Result;
 }
 
-void UMatchConnection::ParseMatchMessage(const FString& Message)
+void UMatchConnection::EncodeMatchDataProtobuf(EMatchOpCode OpCode, TArrayView<const uint8> Payload)
+{
+    // Envelope { match_data_send { match_id, op_code, data } }
+    const uint64 OpCodeValue = static_cast<uint64>(OpCode);
+    const int32 BodySize =
+        1 + NakamaProto::VarintSize(MatchIdUtf8.Num()) + MatchIdUtf8.Num() +
+        1 + NakamaProto::VarintSize(OpCodeValue) +
+        1 + NakamaProto::VarintSize(Payload.Num()) + Payload.Num();
+
+    SendFrameBuffer.Reset();
+    NakamaProto::WriteTag(SendFrameBuffer, NakamaProto::EnvelopeMatchDataSend, NakamaProto::LengthDelimited);
+    NakamaProto::WriteVarint(SendFrameBuffer, BodySize);
+    NakamaProto::WriteBytes(SendFrameBuffer, 1, MatchIdUtf8);
+    NakamaProto::WriteTag(SendFrameBuffer, 2, NakamaProto::Varint);
+    NakamaProto::WriteVarint(SendFrameBuffer, OpCodeValue);
+    NakamaProto::WriteBytes(SendFrameBuffer, 3, Payload);
+}
+
+// ============ Decode ============
+
+void FMatchMessageDecoder::DecodeEnvelope(TArrayView<const uint8> Frame, double ArrivalTime, TArray<FMatchInboundMessage>& Out)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_ParseEnvelope);
+    NakamaProto::FReader Envelope(Frame);
+    uint32 Field = 0;
+    uint32 WireType = 0;
+
+    // cid is field 1, so it is read before the message it tags
+    TArrayView<const uint8> Cid;
+
+    while (!Envelope.AtEnd() && Envelope.ReadTag(Field, WireType))
+    {
+        if (Field == NakamaProto::EnvelopeCid && WireType == NakamaProto::LengthDelimited)
+        {
+            Cid = Envelope.ReadLengthDelimited();
+            continue;
+        }
+
+        if (WireType != NakamaProto::LengthDelimited ||
+            (Field != NakamaProto::EnvelopeMatchData && Field != NakamaProto::EnvelopeError && Field != NakamaProto::EnvelopeRpc))
+        {
+            // Presence events, etc. — nothing we act on
+            Envelope.Skip(WireType);
+            continue;
+        }
+
+        NakamaProto::FReader Message(Envelope.ReadLengthDelimited());
+
+        if (Field == NakamaProto::EnvelopeMatchData)
+        {
+            EMatchOpCode OpCode = EMatchOpCode::None;
+            TArrayView<const uint8> Payload;
+
+            while (!Message.AtEnd() && Message.ReadTag(Field, WireType))
+            {
+                if (Field == 3 && WireType == NakamaProto::Varint)
+                {
+                    OpCode = static_cast<EMatchOpCode>(Message.ReadVarint());
+                }
+                else if (Field == 4 && WireType == NakamaProto::LengthDelimited)
+                {
+                    Payload = Message.ReadLengthDelimited();
+                }
+                else
+                {
+                    Message.Skip(WireType);
+                }
+            }
+
+            if (!Message.bError)
+            {
+                FMatchInboundMessage Decoded;
+                if (DecodePayload(OpCode, Payload, ArrivalTime, Decoded))
+                {
+                    Out.Add(MoveTemp(Decoded));
+                }
+            }
+        }
+        else if (Field == NakamaProto::EnvelopeRpc)
+        {
+            TArrayView<const uint8> Payload;
+            while (!Message.AtEnd() && Message.ReadTag(Field, WireType))
+            {
+                if (Field == 2 && WireType == NakamaProto::LengthDelimited)
+                {
+                    Payload = Message.ReadLengthDelimited();
+                }
+                else
+                {
+                    Message.Skip(WireType);
+                }
+            }
+
+            if (!Message.bError)
+            {
+                FMatchInboundMessage& Reply = Out.AddDefaulted_GetRef();
+                Reply.Kind = FMatchInboundMessage::EKind::RpcResult;
+                Reply.Cid = Utf8ToString(Cid);
+                Reply.Text = Utf8ToString(Payload);
+                Reply.ArrivalTime = ArrivalTime;
+            }
+        }
+        else
+        {
+            FMatchInboundMessage& Error = Out.AddDefaulted_GetRef();
+            Error.Kind = FMatchInboundMessage::EKind::Error;
+            Error.ArrivalTime = ArrivalTime;
+
+            TArrayView<const uint8> ErrorText;
+            while (!Message.AtEnd() && Message.ReadTag(Field, WireType))
+            {
+                if (Field == 1 && WireType == NakamaProto::Varint)
+                {
+                    Error.ErrorCode = static_cast<int32>(Message.ReadVarint());
+                }
+                else if (Field == 2 && WireType == NakamaProto::LengthDelimited)
+                {
+                    ErrorText = Message.ReadLengthDelimited();
+                }
+                else
+                {
+                    Message.Skip(WireType);
+                }
+            }
+
+            Error.Text = Utf8ToString(ErrorText);
+            Error.Cid = Utf8ToString(Cid);
+        }
+    }
+
+    if (Envelope.bError)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MatchConnection: malformed protobuf envelope (%d bytes)"), Frame.Num());
+    }
+}
+
+void FMatchMessageDecoder::DecodeText(const FString& Frame, double ArrivalTime, TArray<FMatchInboundMessage>& Out)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_ParseMatchMessage);
     TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Frame);
     if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
     {
         return;
@@ -206,27 +895,348 @@ void UMatchConnection::ParseMatchMessage(const FString& Message)
         int32 OpCodeInt = static_cast<int32>(MatchData->GetNumberField(TEXT("op_code")));
         EMatchOpCode OpCode = static_cast<EMatchOpCode>(OpCodeInt);
 
-        // Decode base64 data
-        FString DataBase64 = MatchData->GetStringField(TEXT("data"));
-        FString DataJson;
-        FBase64::Decode(DataBase64, DataJson);
-
-        // Broadcast to listeners
-        OnMatchData.Broadcast(OpCode, DataJson);
+        // Decode base64 data; from here it's the same payload the protobuf path carries
+        Base64Buffer.Reset();
+        FMatchInboundMessage Decoded;
+        if (FBase64::Decode(MatchData->GetStringField(TEXT("data")), Base64Buffer) &&
+            DecodePayload(OpCode, Base64Buffer, ArrivalTime, Decoded))
+        {
+            Out.Add(MoveTemp(Decoded));
+        }
     }
 
-    // Check for match_presence_event (join/leave)
-    const TSharedPtr<FJsonObject>* PresencePtr;
-    if (Json->TryGetObjectField(TEXT("match_presence_event"), PresencePtr))
+    // match_presence_event (join/leave) is already handled by the match handler sending OpCode 8/9
+
+    // Reply to SendRpc
+    FString Cid;
+    Json->TryGetStringField(TEXT("cid"), Cid);
+
+    const TSharedPtr<FJsonObject>* RpcPtr;
+    if (Json->TryGetObjectField(TEXT("rpc"), RpcPtr))
     {
-        // Already handled by match handler sending OpCode 8/9
+        FMatchInboundMessage& Reply = Out.AddDefaulted_GetRef();
+        Reply.Kind = FMatchInboundMessage::EKind::RpcResult;
+        Reply.Cid = Cid;
+        Reply.Text = (*RpcPtr)->GetStringField(TEXT("payload"));
+        Reply.ArrivalTime = ArrivalTime;
     }
 
     // Check for match error
     const TSharedPtr<FJsonObject>* ErrorPtr;
     if (Json->TryGetObjectField(TEXT("error"), ErrorPtr))
     {
-        FString ErrorMsg = (*ErrorPtr)->GetStringField(TEXT("message"));
-        UE_LOG(LogTemp, Error, TEXT("Match error: %s"), *ErrorMsg);
+        FMatchInboundMessage& Error = Out.AddDefaulted_GetRef();
+        Error.Kind = FMatchInboundMessage::EKind::Error;
+        Error.Cid = Cid;
+        Error.Text = (*ErrorPtr)->GetStringField(TEXT("message"));
+        Error.ErrorCode = static_cast<int32>((*ErrorPtr)->GetNumberField(TEXT("code")));
+        Error.ArrivalTime = ArrivalTime;
     }
 }
+
+bool FMatchMessageDecoder::DecodePayload(EMatchOpCode OpCode, TArrayView<const uint8> Payload, double ArrivalTime, FMatchInboundMessage& Out)
+{
+    const uint64 DecodeStart = FPlatformTime::Cycles64();
+
+    Out.Kind = FMatchInboundMessage::EKind::MatchData;
+    Out.OpCode = OpCode;
+    Out.ArrivalTime = ArrivalTime;
+    Out.WireBytes = Payload.Num();
+
+    if (bKeepWirePayload)
+    {
+        Out.WirePayload = TArray<uint8>(Payload.GetData(), Payload.Num());
+    }
+
+    TArrayView<const uint8> Raw;
+    if (!Decompressor.Decode(Payload, Raw))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MatchConnection: dropped op %d, payload failed to decompress"), static_cast<int32>(OpCode));
+        return false;
+    }
+
+    Out.RawBytes = Raw.Num();
+    Out.bDecompressed = Raw.GetData() != Payload.GetData();
+
+    // Copied out: Raw points into the frame or the decompressor's reused buffer
+    if (UMatchConnection::IsBinaryOpCode(OpCode))
+    {
+        Out.Payload = TArray<uint8>(Raw.GetData(), Raw.Num());
+    }
+    else
+    {
+        Out.Text = Utf8ToString(Raw);
+
+        // Not every JSON op code carries an object; those only reach OnMatchData
+        if (!Dispatcher || Dispatcher->WantsJson(OpCode))
+        {
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Out.Text);
+            if (!FJsonSerializer::Deserialize(Reader, Out.Json))
+            {
+                Out.Json.Reset();
+            }
+        }
+    }
+
+    Out.DecodeCycles = FPlatformTime::Cycles64() - DecodeStart;
+    return true;
+}
+
+// ============ Dispatcher ============
+
+void FMatchDispatcher::Unsubscribe(const void* Object)
+{
+    for (FRoute& Route : Routes)
+    {
+        Route.Json.RemoveAll(Object);
+        Route.Binary.RemoveAll(Object);
+    }
+    UpdateJsonMask();
+}
+
+bool FMatchDispatcher::HasSubscribers(EMatchOpCode OpCode) const
+{
+    const FRoute& Route = GetRoute(OpCode);
+    return Route.Json.IsBound() || Route.Binary.IsBound();
+}
+
+void FMatchDispatcher::Dispatch(EMatchOpCode OpCode, const FJsonObject* Json)
+{
+    FRoute& Route = GetRoute(OpCode);
+    ++Route.Stats.Received;
+
+    if (!Json || !Route.Json.IsBound())
+    {
+        ++Route.Stats.Unhandled;
+        return;
+    }
+
+    const uint64 Start = FPlatformTime::Cycles64();
+    Route.Json.Broadcast(OpCode, *Json);
+    Route.Stats.HandlerCycles += FPlatformTime::Cycles64() - Start;
+}
+
+void FMatchDispatcher::Dispatch(EMatchOpCode OpCode, TArrayView<const uint8> Payload)
+{
+    FRoute& Route = GetRoute(OpCode);
+    ++Route.Stats.Received;
+
+    if (!Route.Binary.IsBound())
+    {
+        ++Route.Stats.Unhandled;
+        return;
+    }
+
+    const uint64 Start = FPlatformTime::Cycles64();
+    Route.Binary.Broadcast(OpCode, Payload);
+    Route.Stats.HandlerCycles += FPlatformTime::Cycles64() - Start;
+}
+
+const FMatchOpStats& FMatchDispatcher::GetStats(EMatchOpCode OpCode) const
+{
+    return GetRoute(OpCode).Stats;
+}
+
+void FMatchDispatcher::ResetStats()
+{
+    for (FRoute& Route : Routes)
+    {
+        Route.Stats = FMatchOpStats();
+    }
+}
+
+void FMatchDispatcher::UpdateJsonMask()
+{
+    uint32 Mask = 0;
+    for (int32 Index = 0; Index < NumMatchOpCodes; ++Index)
+    {
+        if (Routes[Index].Json.IsBound())
+        {
+            Mask |= 1u << Index;
+        }
+    }
+    JsonMask.store(Mask, std::memory_order_relaxed);
+}
+
+FMatchDispatcher::FRoute& FMatchDispatcher::GetInvalidRoute()
+{
+    // Op codes from a newer server land here: counted, never delivered
+    static FRoute InvalidRoute;
+    return InvalidRoute;
+}
+
+FMatchDispatcher::FRoute& FMatchDispatcher::GetRoute(EMatchOpCode OpCode)
+{
+    const int32 Index = static_cast<int32>(OpCode);
+    return Index < NumMatchOpCodes ? Routes[Index] : GetInvalidRoute();
+}
+
+const FMatchDispatcher::FRoute& FMatchDispatcher::GetRoute(EMatchOpCode OpCode) const
+{
+    const int32 Index = static_cast<int32>(OpCode);
+    return Index < NumMatchOpCodes ? Routes[Index] : GetInvalidRoute();
+}
+
+// ============ Receive Worker ============
+
+FMatchReceiveWorker::FMatchReceiveWorker(const FMatchDispatcher* InDispatcher)
+    : WorkEvent(FPlatformProcess::GetSynchEventFromPool(false))
+{
+    Decoder.Dispatcher = InDispatcher;
+}
+
+FMatchReceiveWorker::~FMatchReceiveWorker()
+{
+    FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+    WorkEvent = nullptr;
+}
+
+uint32 FMatchReceiveWorker::Run()
+{
+    FFrame Frame;
+
+    while (!bStopRequested)
+    {
+        // The timeout only bounds how long a missed wake-up could stall; Stop() triggers the event
+        WorkEvent->Wait(50);
+
+        while (!bStopRequested && Frames.Dequeue(Frame))
+        {
+            LLM_SCOPE_BYTAG(Tower_Net);
+            Decoder.bKeepWirePayload = bKeepWirePayload;
+
+            if (Frame.bText)
+            {
+                Decoder.DecodeText(Frame.Text, Frame.ArrivalTime, Scratch);
+            }
+            else
+            {
+                Decoder.DecodeEnvelope(Frame.Bytes, Frame.ArrivalTime, Scratch);
+            }
+
+            for (FMatchInboundMessage& Message : Scratch)
+            {
+                Decoded.Enqueue(MoveTemp(Message));
+            }
+            Scratch.Reset();
+        }
+    }
+
+    return 0;
+}
+
+void FMatchReceiveWorker::Stop()
+{
+    bStopRequested = true;
+    WorkEvent->Trigger();
+}
+
+void FMatchReceiveWorker::EnqueueText(const FString& Frame)
+{
+    FFrame Entry;
+    Entry.Text = Frame;
+    Entry.ArrivalTime = FPlatformTime::Seconds();
+    Entry.bText = true;
+    Frames.Enqueue(MoveTemp(Entry));
+    WorkEvent->Trigger();
+}
+
+void FMatchReceiveWorker::EnqueueBinary(TArray<uint8>&& Frame)
+{
+    FFrame Entry;
+    Entry.Bytes = MoveTemp(Frame);
+    Entry.ArrivalTime = FPlatformTime::Seconds();
+    Frames.Enqueue(MoveTemp(Entry));
+    WorkEvent->Trigger();
+}
+
+// ============ RPC ============
+
+bool UMatchConnection::SendRpc(const FString& RpcId, const FString& PayloadJson, FOnMatchRpcResponse OnResponse)
+{
+    if (!bConnected || !WebSocket.IsValid()) return false;
+
+    const FString Cid = FString::FromInt(++LastRpcCid);
+    FPendingRpc& Pending = PendingRpcs.Add(Cid);
+    Pending.OnResponse = MoveTemp(OnResponse);
+    Pending.Timeout = RpcTimeouts.Add(FPlatformTime::Seconds(), RpcTimeoutSeconds, LastRpcCid);
+
+    if (bProtobufSession)
+    {
+        // Envelope { cid, rpc { id, payload } }
+        FTCHARToUTF8 CidUtf8(*Cid, Cid.Len());
+        FTCHARToUTF8 IdUtf8(*RpcId, RpcId.Len());
+        FTCHARToUTF8 PayloadUtf8(*PayloadJson, PayloadJson.Len());
+        const TArrayView<const uint8> CidBytes(reinterpret_cast<const uint8*>(CidUtf8.Get()), CidUtf8.Length());
+        const TArrayView<const uint8> IdBytes(reinterpret_cast<const uint8*>(IdUtf8.Get()), IdUtf8.Length());
+        const TArrayView<const uint8> PayloadBytes(reinterpret_cast<const uint8*>(PayloadUtf8.Get()), PayloadUtf8.Length());
+
+        const int32 RpcSize = 1 + NakamaProto::VarintSize(IdBytes.Num()) + IdBytes.Num()
+            + 1 + NakamaProto::VarintSize(PayloadBytes.Num()) + PayloadBytes.Num();
+
+        SendFrameBuffer.Reset();
+        NakamaProto::WriteBytes(SendFrameBuffer, NakamaProto::EnvelopeCid, CidBytes);
+        NakamaProto::WriteTag(SendFrameBuffer, NakamaProto::EnvelopeRpc, NakamaProto::LengthDelimited);
+        NakamaProto::WriteVarint(SendFrameBuffer, RpcSize);
+        NakamaProto::WriteBytes(SendFrameBuffer, 1, IdBytes);
+        NakamaProto::WriteBytes(SendFrameBuffer, 2, PayloadBytes);
+
+        WebSocket->Send(SendFrameBuffer.GetData(), SendFrameBuffer.Num(), true);
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> RpcMsg = MakeShareable(new FJsonObject());
+    TSharedPtr<FJsonObject> Rpc = MakeShareable(new FJsonObject());
+    Rpc->SetStringField(TEXT("id"), RpcId);
+    Rpc->SetStringField(TEXT("payload"), PayloadJson);
+    RpcMsg->SetStringField(TEXT("cid"), Cid);
+    RpcMsg->SetObjectField(TEXT("rpc"), Rpc);
+
+    FString RpcJson;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RpcJson);
+    FJsonSerializer::Serialize(RpcMsg.ToSharedRef(), Writer);
+
+    WebSocket->Send(RpcJson);
+    return true;
+}
+
+bool UMatchConnection::CompleteRpc(const FString& Cid, bool bSuccess, const FString& Payload)
+{
+    FPendingRpc Pending;
+    if (!PendingRpcs.RemoveAndCopyValue(Cid, Pending)) return false;
+
+    RpcTimeouts.Cancel(Pending.Timeout);
+    Pending.OnResponse.ExecuteIfBound(bSuccess, Payload);
+    return true;
+}
+
+void UMatchConnection::FailPendingRpcs(const FString& Reason)
+{
+    // Moved out first: a callback may retry over HTTP, or send another RPC here
+    TMap<FString, FPendingRpc> Failed = MoveTemp(PendingRpcs);
+    PendingRpcs.Reset();
+    RpcTimeouts.Reset();
+
+    const FString ErrorJson = MakeRpcError(Reason, 0);
+    for (TPair<FString, FPendingRpc>& Pending : Failed)
+    {
+        Pending.Value.OnResponse.ExecuteIfBound(false, ErrorJson);
+    }
+}
+
+void UMatchConnection::OnEndFrame()
+{
+    TickResume();
+
+    // Before the timeouts, so a reply decoded this frame isn't failed as late
+    DrainReceived();
+
+    RpcTimeouts.Advance(FPlatformTime::Seconds(), [this](int64 Cid)
+        {
+            // gRPC DEADLINE_EXCEEDED, as Nakama reports its own timeouts
+            UE_LOG(LogTemp, Warning, TEXT("Match RPC cid=%lld timed out after %.1fs"), Cid, RpcTimeoutSeconds);
+            CompleteRpc(FString::Printf(TEXT("%lld"), Cid), false, MakeRpcError(TEXT("Timeout"), 4));
+        });
+
+    FlushOutgoing();
+}
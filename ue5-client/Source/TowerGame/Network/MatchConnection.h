@@ -3,8 +3,20 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "IWebSocket.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "Dom/JsonObject.h"
+#include "NetStats.h"
+#include "NetCapture.h"
+#include "PayloadCompression.h"
+#include "NetTimerWheel.h"
+#include <atomic>
 #include "MatchConnection.generated.h"
 
+class FEvent;
+class FRunnableThread;
+
 /**
  * Match OpCodes — must match tower_match.lua
  */
@@ -24,11 +36,239 @@ enum class EMatchOpCode : uint8
     ChatMessage     = 10,
     LootDropped     = 11,
     PlayerInteract  = 12,
+    WorldSnapshot   = 13,   // Binary (bincode) world state, see StateSynchronizer.cpp
+    Batch           = 14,   // Client -> server: one frame of coalesced messages
+    Lockstep        = 15,   // Binary lockstep session traffic, relayed to the party (see StateSynchronizer.cpp)
+    LeaveMatch      = 16,   // Client -> server: leaving for good, so the server keeps no resume slot
 };
 
+/** Op code slots; EMatchOpCode values are dense from None */
+constexpr int32 NumMatchOpCodes = static_cast<int32>(EMatchOpCode::LeaveMatch) + 1;
+
+constexpr bool IsBinaryMatchOpCode(EMatchOpCode OpCode)
+{
+    return OpCode == EMatchOpCode::WorldSnapshot || OpCode == EMatchOpCode::Lockstep;
+}
+
+/** What a native subscriber to Op receives: the parsed JSON object, or the payload bytes for binary op codes */
+template<EMatchOpCode Op>
+using TMatchOpPayload = std::conditional_t<IsBinaryMatchOpCode(Op), TArrayView<const uint8>, const FJsonObject&>;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMatchData, EMatchOpCode, OpCode, const FString&, DataJson);
+
+/** One op code's traffic since the last FMatchDispatcher::ResetStats */
+struct FMatchOpStats
+{
+    uint32 Received = 0;
+    uint32 Unhandled = 0;       // No native subscriber (or a JSON payload that isn't an object)
+    uint64 HandlerCycles = 0;   // Time spent in the op code's native handlers
+};
+
+/**
+ * Native per-op code routing for match data, in place of one delegate every
+ * listener filters.
+ *
+ * Each op code has its own handler list. Subscribe takes the op codes as
+ * template arguments and checks at compile time that the handler takes what
+ * they carry (TMatchOpPayload), so a handler only ever sees the op codes it
+ * asked for. JSON op codes nobody subscribes to are never parsed: decoders
+ * ask WantsJson from the receive thread. Blueprint OnMatchData still gets
+ * every JSON op code's text.
+ *
+ * Game thread only, except WantsJson.
+ */
+class TOWERGAME_API FMatchDispatcher
+{
+public:
+    /**
+     * Bind a UObject's handler to each op code listed, e.g.
+     *     Dispatcher.Subscribe<EMatchOpCode::PlayerJoined, EMatchOpCode::PlayerLeft>(this, &UFoo::OnPartyChanged);
+     */
+    template<EMatchOpCode FirstOp, EMatchOpCode... Ops, typename UserClass>
+    void Subscribe(UserClass* Object, void (UserClass::*Handler)(EMatchOpCode, TMatchOpPayload<FirstOp>))
+    {
+        static_assert(((IsBinaryMatchOpCode(Ops) == IsBinaryMatchOpCode(FirstOp)) && ...),
+            "One handler can't take both JSON and binary op codes");
+
+        AddHandler<FirstOp>(Object, Handler);
+        (AddHandler<Ops>(Object, Handler), ...);
+        UpdateJsonMask();
+    }
+
+    /** Drop every handler bound to Object */
+    void Unsubscribe(const void* Object);
+
+    bool HasSubscribers(EMatchOpCode OpCode) const;
+
+    /** Any thread: parse this JSON op code's payload? */
+    bool WantsJson(EMatchOpCode OpCode) const
+    {
+        return ((JsonMask.load(std::memory_order_relaxed) >> static_cast<uint32>(OpCode)) & 1u) != 0;
+    }
+
+    /** Deliver to Op's handlers; a null Json (payload not an object) only counts it */
+    void Dispatch(EMatchOpCode OpCode, const FJsonObject* Json);
+    void Dispatch(EMatchOpCode OpCode, TArrayView<const uint8> Payload);
+
+    const FMatchOpStats& GetStats(EMatchOpCode OpCode) const;
+    void ResetStats();
+
+private:
+    using FJsonHandlers = TMulticastDelegate<void(EMatchOpCode, const FJsonObject&)>;
+    using FBinaryHandlers = TMulticastDelegate<void(EMatchOpCode, TArrayView<const uint8>)>;
+
+    struct FRoute
+    {
+        FJsonHandlers Json;         // JSON op codes
+        FBinaryHandlers Binary;     // Binary op codes
+        FMatchOpStats Stats;
+    };
+
+    template<EMatchOpCode Op, typename UserClass, typename HandlerT>
+    void AddHandler(UserClass* Object, HandlerT Handler)
+    {
+        static_assert(Op != EMatchOpCode::None && static_cast<int32>(Op) < NumMatchOpCodes, "Not a match op code");
+
+        FRoute& Route = Routes[static_cast<int32>(Op)];
+        if constexpr (IsBinaryMatchOpCode(Op))
+        {
+            Route.Binary.AddUObject(Object, Handler);
+        }
+        else
+        {
+            Route.Json.AddUObject(Object, Handler);
+        }
+    }
+
+    void UpdateJsonMask();
+
+    static FRoute& GetInvalidRoute();
+    FRoute& GetRoute(EMatchOpCode OpCode);
+    const FRoute& GetRoute(EMatchOpCode OpCode) const;
+
+    FRoute Routes[NumMatchOpCodes];
+
+    /** Bit per JSON op code with a subscriber */
+    std::atomic<uint32> JsonMask{ 0 };
+};
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMatchConnected);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMatchDisconnected, const FString&, Reason);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMatchInterrupted, const FString&, Reason);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMatchResumed);
+
+/** Native-only: reply to SendRpc; Payload is the RPC's response, or {"message":..,"code":..} on failure */
+DECLARE_DELEGATE_TwoParams(FOnMatchRpcResponse, bool /*bSuccess*/, const FString& /*Payload*/);
+
+/** One incoming envelope message, decoded and ready to dispatch on the game thread */
+struct FMatchInboundMessage
+{
+    enum class EKind : uint8
+    {
+        MatchData,
+        RpcResult,
+        Error,
+    };
+
+    EKind Kind = EKind::MatchData;
+    EMatchOpCode OpCode = EMatchOpCode::None;
+
+    /** Binary op codes: the decompressed payload */
+    TArray<uint8> Payload;
+
+    /** The payload as received; only kept while a capture is open */
+    TArray<uint8> WirePayload;
+
+    /** JSON op codes: the payload text. RpcResult: the reply. Error: the message. */
+    FString Text;
+
+    /** JSON op codes whose payload parsed as an object */
+    TSharedPtr<FJsonObject> Json;
+
+    /** Envelope cid, for RPC replies and errors */
+    FString Cid;
+    int32 ErrorCode = 0;
+
+    int32 WireBytes = 0;
+    int32 RawBytes = 0;
+    bool bDecompressed = false;
+    uint64 DecodeCycles = 0;
+    double ArrivalTime = 0.0;
+};
+
+/**
+ * Turns Nakama envelopes (JSON text or protobuf) into FMatchInboundMessages:
+ * envelope parse, base64, decompression and, for JSON op codes, the payload's
+ * own JSON parse. Touches no UObject, so it can run on any thread; one
+ * instance per thread.
+ */
+class FMatchMessageDecoder
+{
+public:
+    void DecodeText(const FString& Frame, double ArrivalTime, TArray<FMatchInboundMessage>& Out);
+    void DecodeEnvelope(TArrayView<const uint8> Frame, double ArrivalTime, TArray<FMatchInboundMessage>& Out);
+
+    /** One match_data payload; false if it failed to decompress */
+    bool DecodePayload(EMatchOpCode OpCode, TArrayView<const uint8> Payload, double ArrivalTime, FMatchInboundMessage& Out);
+
+    /** Copy each payload's wire bytes into WirePayload */
+    bool bKeepWirePayload = false;
+
+    /** Skip parsing JSON op codes it has no subscriber for; without one every object is parsed */
+    const FMatchDispatcher* Dispatcher = nullptr;
+
+private:
+    FPayloadDecompressor Decompressor;
+
+    /** Reused base64 decode buffer for JSON envelopes */
+    TArray<uint8> Base64Buffer;
+};
+
+/**
+ * Decodes match frames off the game thread. The game thread hands over each
+ * complete WebSocket frame and drains decoded messages, both through lock-free
+ * single-producer / single-consumer queues (TQueue); frames are decoded one at
+ * a time, so messages come out in the order they arrived.
+ */
+class FMatchReceiveWorker : public FRunnable
+{
+public:
+    explicit FMatchReceiveWorker(const FMatchDispatcher* InDispatcher);
+    virtual ~FMatchReceiveWorker();
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    /** Game thread only: queue a complete frame for decoding */
+    void EnqueueText(const FString& Frame);
+    void EnqueueBinary(TArray<uint8>&& Frame);
+
+    /** Game thread only: pop the next decoded message. Returns false if none is ready. */
+    bool Dequeue(FMatchInboundMessage& OutMessage) { return Decoded.Dequeue(OutMessage); }
+
+    /** Picked up from the next frame decoded */
+    void SetKeepWirePayload(bool bKeep) { bKeepWirePayload = bKeep; }
+
+private:
+    struct FFrame
+    {
+        TArray<uint8> Bytes;
+        FString Text;
+        double ArrivalTime = 0.0;
+        bool bText = false;
+    };
+
+    TQueue<FFrame, EQueueMode::Spsc> Frames;
+    TQueue<FMatchInboundMessage, EQueueMode::Spsc> Decoded;
+
+    FMatchMessageDecoder Decoder;
+    TArray<FMatchInboundMessage> Scratch;
+
+    /** Signalled per frame queued */
+    FEvent* WorkEvent = nullptr;
+    FThreadSafeBool bStopRequested;
+    FThreadSafeBool bKeepWirePayload;
+};
 
 /**
  * WebSocket connection to a Nakama match instance.
@@ -46,6 +286,17 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMatchDisconnected, const FString&
  * 2. Bind to OnMatchData for incoming events
  * 3. Call SendMatchData() to broadcast player actions
  * 4. Call Disconnect() when leaving the floor
+ *
+ * A socket that drops without Disconnect() is resumed: OnInterrupted fires,
+ * the socket is reopened with backoff for ResumeGraceSeconds and the match
+ * rejoined with the session token of the original join, which the match
+ * keeps the player's slot for, then OnResumed fires. Listeners keep their
+ * state through it (UTowerStateSynchronizer asks for a delta from its last
+ * confirmed tick); only when the grace runs out does OnDisconnected fire.
+ *
+ * Incoming frames are decoded on FMatchReceiveWorker; the game thread only
+ * routes the results to listeners, at the start of each world tick and at end
+ * of frame.
  */
 UCLASS()
 class TOWERGAME_API UMatchConnection : public UGameInstanceSubsystem
@@ -70,6 +321,13 @@ public:
     UFUNCTION(BlueprintPure, Category = "Match")
     bool IsConnected() const { return bConnected; }
 
+    /** The socket dropped and is being reopened within ResumeGraceSeconds */
+    UFUNCTION(BlueprintPure, Category = "Match")
+    bool IsResuming() const { return bResuming; }
+
+    /** Sent as join metadata; a rejoin with the same one takes the player's slot back */
+    const FString& GetSessionToken() const { return SessionToken; }
+
     /** Get current match ID */
     UFUNCTION(BlueprintPure, Category = "Match")
     FString GetMatchId() const { return CurrentMatchId; }
@@ -80,13 +338,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Match")
     void SendMatchData(EMatchOpCode OpCode, const FString& DataJson);
 
+    /** Send an already-encoded payload (UTF-8 JSON or binary) without re-encoding it */
+    void SendMatchDataRaw(EMatchOpCode OpCode, TArrayView<const uint8> Payload);
+
+    /** Send everything queued this frame now instead of at end of frame */
+    UFUNCTION(BlueprintCallable, Category = "Match")
+    void FlushOutgoing();
+
     /** Send player position update */
     UFUNCTION(BlueprintCallable, Category = "Match")
     void SendPosition(FVector Position, FRotator Rotation);
 
-    /** Send attack event */
+    /**
+     * Send attack event. RenderTime is the synchronizer's GetRenderTime() when the
+     * hit landed, so the server validates it against the poses the player saw;
+     * check it first with UTowerStateSynchronizer::ValidateHit.
+     */
     UFUNCTION(BlueprintCallable, Category = "Match")
-    void SendAttack(int32 TargetMonsterId, float Damage, int32 AngleId, int32 ComboStep);
+    void SendAttack(int32 TargetMonsterId, float Damage, int32 AngleId, int32 ComboStep, double RenderTime);
 
     /** Send death event */
     UFUNCTION(BlueprintCallable, Category = "Match")
@@ -100,6 +369,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Match")
     void SendInteract(const FString& InteractType, const FString& TargetId);
 
+    /**
+     * Call a server RPC over this socket instead of an HTTP request; the reply is
+     * matched back by envelope cid. False (and OnResponse not called) if not connected.
+     * Fails with code 4 (deadline exceeded) after RpcTimeoutSeconds without a reply.
+     */
+    bool SendRpc(const FString& RpcId, const FString& PayloadJson, FOnMatchRpcResponse OnResponse);
+
     // ============ Events ============
 
     UPROPERTY(BlueprintAssignable, Category = "Match|Events")
@@ -108,9 +384,48 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Match|Events")
     FOnMatchDisconnected OnDisconnected;
 
+    /** The socket dropped; a resume is under way and OnResumed or OnDisconnected follows */
+    UPROPERTY(BlueprintAssignable, Category = "Match|Events")
+    FOnMatchInterrupted OnInterrupted;
+
+    /** Back in the match after an interruption, in the same player slot */
+    UPROPERTY(BlueprintAssignable, Category = "Match|Events")
+    FOnMatchResumed OnResumed;
+
     UPROPERTY(BlueprintAssignable, Category = "Match|Events")
     FOnMatchData OnMatchData;
 
+    /**
+     * Native listeners subscribe here per op code; JSON handlers run before
+     * OnMatchData. Binary op codes only reach these.
+     */
+    FMatchDispatcher& GetDispatcher() { return Dispatcher; }
+    const FMatchDispatcher& GetDispatcher() const { return Dispatcher; }
+
+    static constexpr bool IsBinaryOpCode(EMatchOpCode OpCode) { return IsBinaryMatchOpCode(OpCode); }
+
+    /** Traffic stats bucket for an op code */
+    static ETowerNetChannel GetStatsChannel(EMatchOpCode OpCode)
+    {
+        switch (OpCode)
+        {
+        case EMatchOpCode::WorldSnapshot:   return ETowerNetChannel::WorldSnapshot;
+        case EMatchOpCode::Lockstep:        return ETowerNetChannel::Lockstep;
+        default:                            return ETowerNetChannel::MatchData;
+        }
+    }
+
+    /** Deliver a payload to listeners as if it had arrived from the server (capture replay); decoded inline */
+    void InjectMatchPayload(EMatchOpCode OpCode, TArrayView<const uint8> Payload);
+
+    /** Ops that bypass coalescing: queued messages are flushed first, then these go out at once */
+    static bool IsUrgentOpCode(EMatchOpCode OpCode)
+    {
+        return OpCode == EMatchOpCode::PlayerDeath
+            || OpCode == EMatchOpCode::MonsterDefeated
+            || OpCode == EMatchOpCode::FloorClear;
+    }
+
     // ============ Config ============
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config")
@@ -123,6 +438,46 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config")
     float PositionSendRate = 5.0f;
 
+    /**
+     * Use Nakama's protobuf realtime envelope over binary frames (ws?format=protobuf)
+     * instead of JSON envelopes with base64 payloads. Takes effect on the next Connect().
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config")
+    bool bUseProtobufEnvelope = true;
+
+    /**
+     * Queue outgoing messages and send them as one Batch frame at end of frame.
+     * Only the newest PlayerPosition of a frame is kept.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config")
+    bool bCoalesceOutgoing = true;
+
+    /** Decode incoming frames on a worker thread. Takes effect on the next Connect(). */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config")
+    bool bDecodeOnWorkerThread = true;
+
+    UFUNCTION(BlueprintPure, Category = "Match")
+    bool IsDecodingOnWorkerThread() const { return ReceiveWorker.IsValid(); }
+
+    /**
+     * How long a dropped socket is retried before the match counts as left;
+     * tower_match.lua holds the slot for RESUME_GRACE_SECONDS. 0 = no resume.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config", meta = (ClampMin = "0"))
+    float ResumeGraceSeconds = 10.0f;
+
+    /** Seconds a SendRpc call waits for its reply before failing */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Match|Config", meta = (ClampMin = "0.5"))
+    float RpcTimeoutSeconds = 10.0f;
+
+    /** Messages that were merged into a batch or superseded instead of getting their own frame */
+    UFUNCTION(BlueprintPure, Category = "Match")
+    int32 GetCoalescedMessageCount() const { return CoalescedMessages; }
+
+    /** Messages waiting for this frame's flush */
+    UFUNCTION(BlueprintPure, Category = "Match")
+    int32 GetQueuedMessageCount() const { return OutgoingQueue.Num(); }
+
 private:
     TSharedPtr<IWebSocket> WebSocket;
     FString CurrentMatchId;
@@ -130,10 +485,90 @@ private:
     bool bConnected = false;
     float PositionSendTimer = 0.0f;
 
+    /** Per Connect(); survives resumes */
+    FString SessionToken;
+
+    bool bResuming = false;
+    double InterruptedAt = 0.0;
+    double NextResumeAttemptAt = 0.0;
+    int32 ResumeAttempts = 0;
+
+    FMatchDispatcher Dispatcher;
+
+    /** Decodes frames on the game thread when there is no worker, and injected payloads */
+    FMatchMessageDecoder InlineDecoder;
+    TArray<FMatchInboundMessage> InlineDecoded;
+
+    /** Receive thread (only when bDecodeOnWorkerThread) */
+    TUniquePtr<FMatchReceiveWorker> ReceiveWorker;
+    FRunnableThread* ReceiveThread = nullptr;
+    FDelegateHandle WorldTickStartHandle;
+
+    /** Whether the current socket speaks the protobuf envelope */
+    bool bProtobufSession = false;
+
+    /** Reused protobuf envelope for outgoing frames */
+    TArray<uint8> SendFrameBuffer;
+
+    /** Accumulates fragmented incoming binary frames */
+    TArray<uint8> ReceiveFrameBuffer;
+
+    /** CurrentMatchId as UTF-8, encoded once per match */
+    TArray<uint8> MatchIdUtf8;
+
+    /** A message waiting for the end-of-frame flush; payload bytes live in OutgoingPayloads */
+    struct FQueuedMatchMessage
+    {
+        EMatchOpCode OpCode;    // None once superseded
+        int32 Offset;
+        int32 Length;
+    };
+
+    TArray<FQueuedMatchMessage> OutgoingQueue;
+    TArray<uint8> OutgoingPayloads;
+    TArray<uint8> BatchBuffer;
+    FDelegateHandle EndFrameHandle;
+    int32 CoalescedMessages = 0;
+
+    struct FPendingRpc
+    {
+        FOnMatchRpcResponse OnResponse;
+        FNetTimerHandle Timeout;
+    };
+
+    /** SendRpc calls awaiting their reply, by envelope cid */
+    TMap<FString, FPendingRpc> PendingRpcs;
+    int32 LastRpcCid = 0;
+
+    /** RpcTimeoutSeconds per pending call, keyed by cid; advanced at end of frame */
+    FNetTimerWheel RpcTimeouts{ 0.05 };
+
+    /** UTowerNetworkSubsystem's traffic stats and capture file */
+    FTowerNetStatsCollector* NetStats = nullptr;
+    FNetCaptureWriter* Capture = nullptr;
+
+    /** Create the socket for CurrentMatchId / CurrentToken and start connecting */
+    void OpenSocket();
+
+    /** Close and forget the socket, without the end-of-match cleanup */
+    void CloseSocket();
+
+    /** The socket went away without Disconnect(): resume, or give up and report Reason */
+    void HandleSocketLost(const FString& Reason);
+
+    /** Retry the socket when due; give up once the grace is spent */
+    void TickResume();
+
     void OnWebSocketConnected();
     void OnWebSocketConnectionError(const FString& Error);
     void OnWebSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
     void OnWebSocketMessage(const FString& Message);
+    void OnWebSocketRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining);
+
+    /** Put one frame on the wire, bypassing the queue */
+    void SendImmediate(EMatchOpCode OpCode, TArrayView<const uint8> Payload);
+
+    void QueueOutgoing(EMatchOpCode OpCode, TArrayView<const uint8> Payload);
 
     /** Build WebSocket URL */
     FString GetWebSocketUrl() const;
@@ -141,6 +576,27 @@ private:
     /** Encode match data for Nakama wire format */
     FString EncodeMatchData(EMatchOpCode OpCode, const FString& DataJson);
 
-    /** Parse incoming Nakama match data */
-    void ParseMatchMessage(const FString& Message);
+    /** Build a protobuf Envelope{match_data_send} into SendFrameBuffer */
+    void EncodeMatchDataProtobuf(EMatchOpCode OpCode, TArrayView<const uint8> Payload);
+
+    /** Resolve the SendRpc call tagged Cid; false if none is waiting on it */
+    bool CompleteRpc(const FString& Cid, bool bSuccess, const FString& Payload);
+
+    /** Fail every outstanding SendRpc call (socket gone) */
+    void FailPendingRpcs(const FString& Reason);
+
+    /** End of frame: dispatch decoded messages, fail RPCs past their timeout, then flush the outgoing queue */
+    void OnEndFrame();
+
+    void StartReceiveWorker();
+    void StopReceiveWorker();
+
+    /** Decode a frame on the game thread and dispatch it straight away */
+    void DecodeInline(const FString* Text, TArrayView<const uint8> Bytes);
+
+    /** Dispatch everything the worker has decoded so far */
+    void DrainReceived();
+
+    /** Resolve an RPC reply or error, or route match data to the dispatcher and OnMatchData */
+    void DispatchInbound(const FMatchInboundMessage& Message);
 };
@@ -1,4 +1,7 @@
 #include "NakamaSubsystem.h"
+#include "MatchConnection.h"
+#include "TowerNetworkSubsystem.h"
+#include "Core/StartupTimeline.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
@@ -7,15 +10,25 @@
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Misc/Base64.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "Misc/CoreDelegates.h"
+#include "Engine/GameInstance.h"
 
 void UNakamaSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+    TOWER_STARTUP_SCOPE(NakamaSubsystem);
     Super::Initialize(Collection);
+
+    // Batched RPCs go out once per frame
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UNakamaSubsystem::FlushRpcs);
+
     UE_LOG(LogTemp, Log, TEXT("NakamaSubsystem initialized. Server: %s:%d"), *ServerHost, ServerPort);
 }
 
 void UNakamaSubsystem::Deinitialize()
 {
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    QueuedRpcs.Reset();
     AuthToken.Empty();
     Super::Deinitialize();
 }
@@ -130,9 +143,29 @@ void UNakamaSubsystem::ProcessAuthResponse(bool bSuccess, const FString& Respons
         if (FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid())
         {
             AuthToken = Json->GetStringField(TEXT("token"));
-            // Decode token to get user_id (JWT payload)
-            // For simplicity, we fetch account info separately
-            UE_LOG(LogTemp, Log, TEXT("Nakama authenticated successfully"));
+
+            // The session token is a JWT; its payload names the user (uid, usn)
+            TArray<FString> TokenParts;
+            AuthToken.ParseIntoArray(TokenParts, TEXT("."));
+            FString ClaimsJson;
+            if (TokenParts.Num() == 3)
+            {
+                FString Encoded = TokenParts[1];
+                while (Encoded.Len() % 4 != 0)
+                {
+                    Encoded.AppendChar(TEXT('='));
+                }
+                FBase64::Decode(Encoded, ClaimsJson, EBase64Mode::UrlSafe);
+            }
+
+            TSharedPtr<FJsonObject> Claims;
+            TSharedRef<TJsonReader<>> ClaimsReader = TJsonReaderFactory<>::Create(ClaimsJson);
+            if (FJsonSerializer::Deserialize(ClaimsReader, Claims) && Claims.IsValid())
+            {
+                Claims->TryGetStringField(TEXT("uid"), UserId);
+                Claims->TryGetStringField(TEXT("usn"), Username);
+            }
+            UE_LOG(LogTemp, Log, TEXT("Nakama authenticated successfully (%s)"), *Username);
         }
     }
     else
@@ -146,11 +179,40 @@ void UNakamaSubsystem::ProcessAuthResponse(bool bSuccess, const FString& Respons
 // ============ RPC Calls ============
 
 void UNakamaSubsystem::CallRpc(const FString& RpcId, const FString& PayloadJson, FOnNakamaResponse& ResponseDelegate)
+{
+    CallRpc(RpcId, PayloadJson, [&ResponseDelegate](bool bSuccess, const FString& Payload)
+    {
+        ResponseDelegate.Broadcast(bSuccess, Payload);
+    });
+}
+
+void UNakamaSubsystem::CallRpc(const FString& RpcId, const FString& PayloadJson, TFunction<void(bool, const FString&)> OnResponse)
 {
     if (!IsAuthenticated())
     {
         UE_LOG(LogTemp, Warning, TEXT("Cannot call RPC '%s': not authenticated"), *RpcId);
-        ResponseDelegate.Broadcast(false, TEXT("{\"error\":\"not_authenticated\"}"));
+        OnResponse(false, TEXT("{\"error\":\"not_authenticated\"}"));
+        return;
+    }
+
+    if (bBatchRpcs && bServerSupportsBatch)
+    {
+        QueuedRpcs.Add({ RpcId, PayloadJson, MoveTemp(OnResponse) });
+        return;
+    }
+
+    SendRpcNow(RpcId, PayloadJson, MoveTemp(OnResponse));
+}
+
+void UNakamaSubsystem::SendRpcNow(const FString& RpcId, const FString& PayloadJson, TFunction<void(bool, const FString&)> Callback)
+{
+    // The match socket is already open and authenticated: no HTTP connection or headers per call
+    UGameInstance* GameInstance = GetGameInstance();
+    UMatchConnection* Match = GameInstance ? GameInstance->GetSubsystem<UMatchConnection>() : nullptr;
+    if (bRouteRpcsOverSocket && Match && Match->IsConnected() &&
+        Match->SendRpc(RpcId, PayloadJson, FOnMatchRpcResponse::CreateLambda(
+            [Callback](bool bSuccess, const FString& Payload) { Callback(bSuccess, Payload); })))
+    {
         return;
     }
 
@@ -165,7 +227,7 @@ void UNakamaSubsystem::CallRpc(const FString& RpcId, const FString& PayloadJson,
     FJsonSerializer::Serialize(RpcBody.ToSharedRef(), Writer);
 
     SendHttpRequest(Url, TEXT("POST"), BodyJson,
-        [&ResponseDelegate](bool bSuccess, const FString& Response)
+        [Callback = MoveTemp(Callback)](bool bSuccess, const FString& Response)
         {
             // Extract payload from Nakama RPC response
             FString ResultPayload = Response;
@@ -178,10 +240,108 @@ void UNakamaSubsystem::CallRpc(const FString& RpcId, const FString& PayloadJson,
                     ResultPayload = Json->GetStringField(TEXT("payload"));
                 }
             }
-            ResponseDelegate.Broadcast(bSuccess, ResultPayload);
+            Callback(bSuccess, ResultPayload);
         });
 }
 
+void UNakamaSubsystem::FlushRpcs()
+{
+    if (QueuedRpcs.Num() == 0) return;
+
+    TArray<FQueuedRpc> Calls = MoveTemp(QueuedRpcs);
+    QueuedRpcs.Reset();
+
+    // A lone call gains nothing from the envelope
+    if (Calls.Num() == 1)
+    {
+        SendRpcNow(Calls[0].RpcId, Calls[0].PayloadJson, MoveTemp(Calls[0].OnResponse));
+        return;
+    }
+
+    for (int32 Start = 0; Start < Calls.Num(); Start += MaxBatchCalls)
+    {
+        TArray<FQueuedRpc> Batch;
+        for (int32 i = Start; i < FMath::Min(Start + MaxBatchCalls, Calls.Num()); i++)
+        {
+            Batch.Add(MoveTemp(Calls[i]));
+        }
+        SendBatch(MoveTemp(Batch));
+    }
+}
+
+void UNakamaSubsystem::SendBatch(TArray<FQueuedRpc> Calls)
+{
+    // { "calls": [{ "id", "payload" }] } -> { "results": [{ "id", "ok", "payload" }] }, in call order
+    TArray<TSharedPtr<FJsonValue>> CallsJson;
+    for (const FQueuedRpc& Call : Calls)
+    {
+        TSharedPtr<FJsonObject> CallJson = MakeShareable(new FJsonObject());
+        CallJson->SetStringField(TEXT("id"), Call.RpcId);
+        CallJson->SetStringField(TEXT("payload"), Call.PayloadJson);
+        CallsJson.Add(MakeShareable(new FJsonValueObject(CallJson)));
+    }
+
+    TSharedPtr<FJsonObject> BatchJson = MakeShareable(new FJsonObject());
+    BatchJson->SetArrayField(TEXT("calls"), CallsJson);
+
+    FString PayloadJson;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadJson);
+    FJsonSerializer::Serialize(BatchJson.ToSharedRef(), Writer);
+
+    BatchedRpcs += Calls.Num();
+
+    SendRpcNow(TEXT("batch"), PayloadJson, [this, Calls = MoveTemp(Calls)](bool bSuccess, const FString& Response)
+    {
+        TSharedPtr<FJsonObject> Json;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        const bool bParsed = FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid();
+
+        if (!bSuccess)
+        {
+            // NOT_FOUND: a server without the batch RPC. Nothing ran, so send the calls one by one
+            if (bParsed && Json->HasTypedField<EJson::Number>(TEXT("code")) && Json->GetIntegerField(TEXT("code")) == 5)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Nakama server has no batch RPC; sending RPCs individually"));
+                bServerSupportsBatch = false;
+                for (const FQueuedRpc& Call : Calls)
+                {
+                    SendRpcNow(Call.RpcId, Call.PayloadJson, Call.OnResponse);
+                }
+                return;
+            }
+
+            // Any of them may have run: don't resend, fail them all
+            for (const FQueuedRpc& Call : Calls)
+            {
+                Call.OnResponse(false, Response);
+            }
+            return;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Results = nullptr;
+        if (!bParsed || !Json->TryGetArrayField(TEXT("results"), Results) || Results->Num() != Calls.Num())
+        {
+            UE_LOG(LogTemp, Error, TEXT("Nakama batch RPC: malformed response for %d calls"), Calls.Num());
+            for (const FQueuedRpc& Call : Calls)
+            {
+                Call.OnResponse(false, Response);
+            }
+            return;
+        }
+
+        for (int32 i = 0; i < Calls.Num(); i++)
+        {
+            const TSharedPtr<FJsonObject>* Result = nullptr;
+            if (!(*Results)[i]->TryGetObject(Result))
+            {
+                Calls[i].OnResponse(false, Response);
+                continue;
+            }
+            Calls[i].OnResponse((*Result)->GetBoolField(TEXT("ok")), (*Result)->GetStringField(TEXT("payload")));
+        }
+    });
+}
+
 void UNakamaSubsystem::FetchTowerSeed()
 {
     CallRpc(TEXT("get_tower_seed"), TEXT("{}"), OnTowerSeedReceived);
@@ -210,8 +370,73 @@ void UNakamaSubsystem::ReportDeath(int32 FloorId, const FString& EchoType, FVect
 
 void UNakamaSubsystem::FetchFloorEchoes(int32 FloorId)
 {
-    FString Payload = FString::Printf(TEXT("{\"floor_id\":%d}"), FloorId);
-    CallRpc(TEXT("get_floor_echoes"), Payload, OnEchoesReceived);
+    const FTowerFloorEchoCache* Cache = EchoCache.Find(FloorId);
+    FString Payload = FString::Printf(TEXT("{\"floor_id\":%d,\"since\":%lld}"), FloorId, Cache ? Cache->Cursor : 0);
+    CallRpc(TEXT("get_floor_echoes"), Payload, [this, FloorId](bool bSuccess, const FString& Response)
+    {
+        if (bSuccess)
+        {
+            MergeFloorEchoes(FloorId, Response);
+        }
+        OnEchoesReceived.Broadcast(bSuccess, Response);
+    });
+}
+
+void UNakamaSubsystem::MergeFloorEchoes(int32 FloorId, const FString& ResponseJson)
+{
+    TSharedPtr<FJsonObject> Json;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJson);
+    const TArray<TSharedPtr<FJsonValue>>* EchoesJson = nullptr;
+    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid() || !Json->TryGetArrayField(TEXT("echoes"), EchoesJson))
+    {
+        return;
+    }
+
+    FTowerFloorEchoCache& Cache = EchoCache.FindOrAdd(FloorId);
+
+    // Expired ones go first, so they don't count against the id check below
+    const int64 Now = FDateTime::UtcNow().ToUnixTimestamp();
+    Cache.Echoes.RemoveAllSwap([Now](const FTowerEchoRecord& Echo) { return Echo.ExpiresAt <= Now; });
+
+    // The server resends echoes from the cursor's own second; the id tells them apart
+    TSet<FString> Known;
+    Known.Reserve(Cache.Echoes.Num());
+    for (const FTowerEchoRecord& Echo : Cache.Echoes)
+    {
+        Known.Add(Echo.Id);
+    }
+
+    for (const TSharedPtr<FJsonValue>& Value : *EchoesJson)
+    {
+        const TSharedPtr<FJsonObject>* EchoObj = nullptr;
+        if (!Value->TryGetObject(EchoObj)) continue;
+
+        FString Id;
+        if (!(*EchoObj)->TryGetStringField(TEXT("id"), Id) || Known.Contains(Id)) continue;
+        Known.Add(Id);
+
+        FTowerEchoRecord& Echo = Cache.Echoes.AddDefaulted_GetRef();
+        Echo.Id = MoveTemp(Id);
+        Echo.PlayerName = (*EchoObj)->GetStringField(TEXT("player_name"));
+        Echo.EchoType = (*EchoObj)->GetStringField(TEXT("echo_type"));
+        Echo.CreatedAt = static_cast<int64>((*EchoObj)->GetNumberField(TEXT("created_at")));
+        Echo.ExpiresAt = static_cast<int64>((*EchoObj)->GetNumberField(TEXT("expires_at")));
+
+        const TSharedPtr<FJsonObject>* PositionObj = nullptr;
+        if ((*EchoObj)->TryGetObjectField(TEXT("position"), PositionObj))
+        {
+            Echo.Position = FVector(
+                (*PositionObj)->GetNumberField(TEXT("x")),
+                (*PositionObj)->GetNumberField(TEXT("y")),
+                (*PositionObj)->GetNumberField(TEXT("z")));
+        }
+    }
+
+    double Cursor = 0.0;
+    if (Json->TryGetNumberField(TEXT("cursor"), Cursor))
+    {
+        Cache.Cursor = FMath::Max(Cache.Cursor, static_cast<int64>(Cursor));
+    }
 }
 
 void UNakamaSubsystem::UpdateFaction(const FString& Faction, int32 Delta)
@@ -230,13 +455,241 @@ void UNakamaSubsystem::HealthCheck()
     CallRpc(TEXT("health_check"), TEXT("{}"), OnHealthCheckReceived);
 }
 
+namespace
+{
+    /** "host:port" of a list_active_matches match or server; empty for matches labelled before servers had hosts */
+    FString GetGameServerEndpoint(const TSharedPtr<FJsonValue>& Entry)
+    {
+        const TSharedPtr<FJsonObject>* Object = nullptr;
+        FString Host;
+        if (!Entry.IsValid() || !Entry->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("host"), Host) || Host.IsEmpty())
+        {
+            return FString();
+        }
+        int32 Port = 0;
+        (*Object)->TryGetNumberField(TEXT("port"), Port);
+        return FTowerPingProber::MakeEndpoint(Host, Port);
+    }
+
+    FString SerializeJson(const TSharedPtr<FJsonObject>& Json)
+    {
+        FString Out;
+        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Out);
+        FJsonSerializer::Serialize(Json.ToSharedRef(), Writer);
+        return Out;
+    }
+}
+
 void UNakamaSubsystem::JoinFloorMatch(int32 FloorId)
 {
     FString Payload = FString::Printf(TEXT("{\"floor_id\":%d}"), FloorId);
-    CallRpc(TEXT("join_floor_match"), Payload, OnFloorMatchJoined);
+    if (!bLatencyAwareMatches)
+    {
+        CallRpc(TEXT("join_floor_match"), Payload, OnFloorMatchJoined);
+        return;
+    }
+
+    // The floor's open matches and every region, probed, then the closest asked for by id or region
+    CallRpc(TEXT("list_active_matches"), Payload, [this, FloorId, Payload](bool bSuccess, const FString& Response)
+    {
+        TSharedPtr<FJsonObject> Json;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        if (!bSuccess || !FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+        {
+            CallRpc(TEXT("join_floor_match"), Payload, OnFloorMatchJoined);
+            return;
+        }
+
+        RankMatches(Json, [this, FloorId](TSharedPtr<FJsonObject> Ranked)
+        {
+            UGameInstance* GameInstance = GetGameInstance();
+            UTowerNetworkSubsystem* Network = GameInstance ? GameInstance->GetSubsystem<UTowerNetworkSubsystem>() : nullptr;
+
+            TSharedPtr<FJsonObject> Request = MakeShareable(new FJsonObject());
+            Request->SetNumberField(TEXT("floor_id"), FloorId);
+
+            FString MatchId;
+            float MatchScore = -1.0f;
+            const TArray<TSharedPtr<FJsonValue>>* Matches = nullptr;
+            if (Network && Ranked->TryGetArrayField(TEXT("matches"), Matches) && Matches->Num() > 0)
+            {
+                // Ranked best first; unreachable and full servers sort last with negative scores
+                MatchScore = Network->GetServerScore(GetGameServerEndpoint((*Matches)[0]));
+                if (MatchScore >= 0.0f)
+                {
+                    (*Matches)[0]->AsObject()->TryGetStringField(TEXT("match_id"), MatchId);
+                }
+            }
+
+            FString Region;
+            float RegionScore = -1.0f;
+            const TArray<TSharedPtr<FJsonValue>>* Servers = nullptr;
+            if (Network && Ranked->TryGetArrayField(TEXT("servers"), Servers))
+            {
+                for (const TSharedPtr<FJsonValue>& Server : *Servers)
+                {
+                    const float Score = Network->GetServerScore(GetGameServerEndpoint(Server));
+                    if (Score >= 0.0f && (RegionScore < 0.0f || Score < RegionScore))
+                    {
+                        RegionScore = Score;
+                        Server->AsObject()->TryGetStringField(TEXT("region"), Region);
+                    }
+                }
+            }
+
+            if (!MatchId.IsEmpty() && (Region.IsEmpty() || MatchScore <= RegionScore + NewMatchPenaltyMs))
+            {
+                Request->SetStringField(TEXT("match_id"), MatchId);
+            }
+            else if (!Region.IsEmpty())
+            {
+                Request->SetStringField(TEXT("region"), Region);
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("Nakama: Joining floor %d, match %s (%.0f) / region %s (%.0f)"),
+                FloorId, MatchId.IsEmpty() ? TEXT("-") : *MatchId, MatchScore, Region.IsEmpty() ? TEXT("-") : *Region, RegionScore);
+            CallRpc(TEXT("join_floor_match"), SerializeJson(Request), OnFloorMatchJoined);
+        });
+    });
 }
 
 void UNakamaSubsystem::ListActiveMatches()
 {
-    CallRpc(TEXT("list_active_matches"), TEXT("{}"), OnActiveMatchesReceived);
+    if (!bLatencyAwareMatches)
+    {
+        CallRpc(TEXT("list_active_matches"), TEXT("{}"), OnActiveMatchesReceived);
+        return;
+    }
+
+    CallRpc(TEXT("list_active_matches"), TEXT("{}"), [this](bool bSuccess, const FString& Response)
+    {
+        TSharedPtr<FJsonObject> Json;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        if (!bSuccess || !FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+        {
+            OnActiveMatchesReceived.Broadcast(bSuccess, Response);
+            return;
+        }
+
+        RankMatches(Json, [this](TSharedPtr<FJsonObject> Ranked)
+        {
+            OnActiveMatchesReceived.Broadcast(true, SerializeJson(Ranked));
+        });
+    });
+}
+
+void UNakamaSubsystem::RankMatches(TSharedPtr<FJsonObject> Json, TFunction<void(TSharedPtr<FJsonObject>)> OnRanked)
+{
+    UGameInstance* GameInstance = GetGameInstance();
+    UTowerNetworkSubsystem* Network = GameInstance ? GameInstance->GetSubsystem<UTowerNetworkSubsystem>() : nullptr;
+    if (!Network)
+    {
+        OnRanked(Json);
+        return;
+    }
+
+    TArray<FString> Endpoints;
+    static const TCHAR* const EndpointFields[] = { TEXT("matches"), TEXT("servers") };
+    for (const TCHAR* Field : EndpointFields)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+        if (Json->TryGetArrayField(Field, Entries))
+        {
+            for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+            {
+                const FString Endpoint = GetGameServerEndpoint(Entry);
+                if (!Endpoint.IsEmpty())
+                {
+                    Endpoints.AddUnique(Endpoint);
+                }
+            }
+        }
+    }
+
+    // Cached endpoints answer at once, so listing again within the session costs no probes
+    Network->ProbeServersThen(Endpoints, [Network, Json, OnRanked = MoveTemp(OnRanked)]()
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Matches = nullptr;
+        if (Json->TryGetArrayField(TEXT("matches"), Matches))
+        {
+            TArray<TSharedPtr<FJsonValue>> Sorted = *Matches;
+            TMap<const FJsonValue*, float> Scores;
+            for (const TSharedPtr<FJsonValue>& Match : Sorted)
+            {
+                const FString Endpoint = GetGameServerEndpoint(Match);
+                const float Score = Network->GetServerScore(Endpoint);
+                Scores.Add(Match.Get(), Score >= 0.0f ? Score : TNumericLimits<float>::Max());
+
+                const TSharedPtr<FJsonObject>* Object = nullptr;
+                if (Match->TryGetObject(Object))
+                {
+                    (*Object)->SetNumberField(TEXT("rtt_ms"), Network->GetServerRtt(Endpoint));
+                }
+            }
+            Sorted.StableSort([&Scores](const TSharedPtr<FJsonValue>& A, const TSharedPtr<FJsonValue>& B)
+            {
+                return Scores[A.Get()] < Scores[B.Get()];
+            });
+            Json->SetArrayField(TEXT("matches"), Sorted);
+        }
+        OnRanked(Json);
+    });
+}
+
+void UNakamaSubsystem::EnterFloor(int32 FloorId)
+{
+    // Queued together and flushed now, so they leave as one batch even with bBatchRpcs off
+    const bool bWasBatching = bBatchRpcs;
+    bBatchRpcs = true;
+
+    FetchTowerSeed();
+    RequestFloor(FloorId);
+    FetchFloorEchoes(FloorId);
+    FetchPlayerState();
+
+    bBatchRpcs = bWasBatching;
+    FlushRpcs();
+}
+
+// ============ Leaderboards ============
+
+void UNakamaSubsystem::FetchLeaderboardPage(const FString& LeaderboardId, int32 Limit, const FString& Cursor)
+{
+    FString Url = FString::Printf(TEXT("%s/v2/leaderboard/%s?limit=%d"),
+        *GetBaseUrl(), *LeaderboardId, FMath::Clamp(Limit, 1, 100));
+    if (!Cursor.IsEmpty())
+    {
+        Url += TEXT("&cursor=") + FGenericPlatformHttp::UrlEncode(Cursor);
+    }
+    FetchLeaderboard(Url);
+}
+
+void UNakamaSubsystem::FetchLeaderboardAroundPlayer(const FString& LeaderboardId, int32 Limit)
+{
+    if (UserId.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot fetch leaderboard '%s' around player: no user id"), *LeaderboardId);
+        OnLeaderboardReceived.Broadcast(false, TEXT("{\"error\":\"not_authenticated\"}"));
+        return;
+    }
+
+    FString Url = FString::Printf(TEXT("%s/v2/leaderboard/%s/owner/%s?limit=%d"),
+        *GetBaseUrl(), *LeaderboardId, *UserId, FMath::Clamp(Limit, 1, 100));
+    FetchLeaderboard(Url);
+}
+
+void UNakamaSubsystem::FetchLeaderboard(const FString& Url)
+{
+    if (!IsAuthenticated())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Cannot fetch leaderboard: not authenticated"));
+        OnLeaderboardReceived.Broadcast(false, TEXT("{\"error\":\"not_authenticated\"}"));
+        return;
+    }
+
+    SendHttpRequest(Url, TEXT("GET"), FString(),
+        [this](bool bSuccess, const FString& Response)
+        {
+            OnLeaderboardReceived.Broadcast(bSuccess, Response);
+        });
 }
@@ -6,9 +6,29 @@
 #include "Interfaces/IHttpResponse.h"
 #include "NakamaSubsystem.generated.h"
 
+class FJsonObject;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnNakamaResponse, bool, bSuccess, const FString&, ResponseJson);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNakamaAuthenticated, bool, bSuccess);
 
+/** One death echo as get_floor_echoes returns it */
+struct FTowerEchoRecord
+{
+    FString Id;             // Storage key, unique per echo
+    FString PlayerName;
+    FString EchoType;       // EEchoType name
+    FVector Position = FVector::ZeroVector;
+    int64 CreatedAt = 0;    // Unix seconds
+    int64 ExpiresAt = 0;
+};
+
+/** A floor's echoes seen so far, and the cursor to fetch only newer ones */
+struct FTowerFloorEchoCache
+{
+    TArray<FTowerEchoRecord> Echoes;
+    int64 Cursor = 0;
+};
+
 /**
  * Nakama Server communication subsystem.
  * Handles authentication, RPC calls, and state sync with the Nakama backend.
@@ -22,6 +42,13 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNakamaAuthenticated, bool, bSucce
  * - update_faction: Update faction standing
  * - get_player_state: Fetch full player state
  * - health_check: Server health/version check
+ * - batch: Several of the above in one round trip
+ *
+ * RPCs issued in the same frame go out together as one batch call, and over
+ * UMatchConnection's open socket rather than HTTP while it is connected.
+ *
+ * Leaderboards are read through Nakama's REST API a window at a time
+ * (a cursor page, or the records around the player), never whole.
  */
 UCLASS()
 class TOWERGAME_API UNakamaSubsystem : public UGameInstanceSubsystem
@@ -43,6 +70,29 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nakama|Config")
     FString ServerKey = TEXT("defaultkey");
 
+    /**
+     * Queue RPCs and send the ones issued in a frame as one "batch" RPC at end of frame.
+     * Each call's response still arrives on its own delegate, in call order.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nakama|Config")
+    bool bBatchRpcs = true;
+
+    /** Send RPCs over the match socket while UMatchConnection is connected, instead of HTTP */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nakama|Config")
+    bool bRouteRpcsOverSocket = true;
+
+    /**
+     * Rank floor matches by the RTT and load UDP probes measure to their game
+     * servers before joining, and sort ListActiveMatches by it (each match gains
+     * rtt_ms). Off: the server picks the first open match, as before.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nakama|Config")
+    bool bLatencyAwareMatches = true;
+
+    /** Extra ms a new match in an empty region needs to beat an existing match by */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Nakama|Config")
+    float NewMatchPenaltyMs = 20.0f;
+
     // ============ Authentication ============
 
     /** Authenticate with device ID (anonymous login) */
@@ -82,10 +132,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Nakama|Tower")
     void ReportDeath(int32 FloorId, const FString& EchoType, FVector Position);
 
-    /** Fetch echoes for a floor */
+    /**
+     * Fetch echoes for a floor. Only echoes newer than the floor's cache cursor are
+     * downloaded; they are merged into the cache (GetCachedEchoes), and OnEchoesReceived
+     * gets the server's response, which lists just those new echoes.
+     */
     UFUNCTION(BlueprintCallable, Category = "Nakama|Tower")
     void FetchFloorEchoes(int32 FloorId);
 
+    /** Every unexpired echo of a floor fetched so far; null before the first fetch */
+    const FTowerFloorEchoCache* GetCachedEchoes(int32 FloorId) const { return EchoCache.Find(FloorId); }
+
     /** Update faction standing */
     UFUNCTION(BlueprintCallable, Category = "Nakama|Tower")
     void UpdateFaction(const FString& Faction, int32 Delta);
@@ -98,14 +155,47 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Nakama|Tower")
     void HealthCheck();
 
-    /** Join or create a floor match instance */
+    /**
+     * Join or create a floor match instance. With bLatencyAwareMatches the floor's
+     * matches and the game server regions are probed first, and the closest open
+     * match (or a new one in the closest region) is asked for; the response
+     * carries the host and port of its game server.
+     */
     UFUNCTION(BlueprintCallable, Category = "Nakama|Match")
     void JoinFloorMatch(int32 FloorId);
 
-    /** List active floor matches */
+    /** List active floor matches, closest first with bLatencyAwareMatches */
     UFUNCTION(BlueprintCallable, Category = "Nakama|Match")
     void ListActiveMatches();
 
+    /**
+     * Everything entering a floor needs, in one round trip: the tower seed, the access
+     * check, the floor's echoes and the player state, on their usual delegates.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Nakama|Tower")
+    void EnterFloor(int32 FloorId);
+
+    /** Send the RPCs queued this frame now instead of at end of frame */
+    UFUNCTION(BlueprintCallable, Category = "Nakama|Tower")
+    void FlushRpcs();
+
+    /** RPCs that shared a batch round trip instead of getting their own */
+    UFUNCTION(BlueprintPure, Category = "Nakama|Tower")
+    int32 GetBatchedRpcCount() const { return BatchedRpcs; }
+
+    // ============ Leaderboards ============
+
+    /**
+     * Fetch Limit records of a leaderboard from Cursor (empty for the top).
+     * The response carries next_cursor / prev_cursor for the neighbouring pages.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Nakama|Leaderboard")
+    void FetchLeaderboardPage(const FString& LeaderboardId, int32 Limit, const FString& Cursor);
+
+    /** Fetch Limit records of a leaderboard centred on the authenticated player */
+    UFUNCTION(BlueprintCallable, Category = "Nakama|Leaderboard")
+    void FetchLeaderboardAroundPlayer(const FString& LeaderboardId, int32 Limit);
+
     // ============ Response Delegates ============
 
     UPROPERTY(BlueprintAssignable, Category = "Nakama|Events")
@@ -138,6 +228,10 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Nakama|Events")
     FOnNakamaResponse OnActiveMatchesReceived;
 
+    /** Raw Nakama leaderboard record list, from either leaderboard fetch */
+    UPROPERTY(BlueprintAssignable, Category = "Nakama|Events")
+    FOnNakamaResponse OnLeaderboardReceived;
+
     // ============ Cached State ============
 
     /** Server-provided tower seed */
@@ -152,22 +246,56 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Nakama|State")
     FString CurrentMatchId;
 
-    /** User ID from authentication */
+    /** User ID from authentication (the session token's uid claim) */
     UPROPERTY(BlueprintReadOnly, Category = "Nakama|State")
     FString UserId;
 
-    /** Username from authentication */
+    /** Username from authentication (the session token's usn claim) */
     UPROPERTY(BlueprintReadOnly, Category = "Nakama|State")
     FString Username;
 
 private:
     FString AuthToken;
 
+    /** An RPC waiting for the end-of-frame flush */
+    struct FQueuedRpc
+    {
+        FString RpcId;
+        FString PayloadJson;
+        TFunction<void(bool, const FString&)> OnResponse;
+    };
+
+    TArray<FQueuedRpc> QueuedRpcs;
+    FDelegateHandle EndFrameHandle;
+    int32 BatchedRpcs = 0;
+
+    /** Cleared once the server turns out not to have the batch RPC */
+    bool bServerSupportsBatch = true;
+
+    /** Calls per batch request, as tower_main.lua's MAX_BATCH_CALLS */
+    static constexpr int32 MaxBatchCalls = 16;
+
+    /** By floor; lives as long as the game instance, so revisits only fetch the delta */
+    TMap<int32, FTowerFloorEchoCache> EchoCache;
+
+    /** Merge a get_floor_echoes response into EchoCache */
+    void MergeFloorEchoes(int32 FloorId, const FString& ResponseJson);
+
+    /** Probe the hosts of a list_active_matches response, then rank its matches (Json is sorted in place) */
+    void RankMatches(TSharedPtr<FJsonObject> Json, TFunction<void(TSharedPtr<FJsonObject>)> OnRanked);
+
     /** Build base URL for Nakama API */
     FString GetBaseUrl() const;
 
-    /** Send an RPC call to Nakama */
+    /** Send an RPC call to Nakama (queued for the frame's batch when bBatchRpcs) */
     void CallRpc(const FString& RpcId, const FString& PayloadJson, FOnNakamaResponse& ResponseDelegate);
+    void CallRpc(const FString& RpcId, const FString& PayloadJson, TFunction<void(bool, const FString&)> OnResponse);
+
+    /** One RPC on the wire, over the match socket or HTTP; Callback gets the unwrapped payload */
+    void SendRpcNow(const FString& RpcId, const FString& PayloadJson, TFunction<void(bool, const FString&)> Callback);
+
+    /** Send Calls as one batch RPC and hand each result to its call's delegate */
+    void SendBatch(TArray<FQueuedRpc> Calls);
 
     /** Generic HTTP request helper */
     void SendHttpRequest(
@@ -177,6 +305,9 @@ private:
         TFunction<void(bool, const FString&)> Callback
     );
 
+    /** GET a leaderboard listing and broadcast it on OnLeaderboardReceived */
+    void FetchLeaderboard(const FString& Url);
+
     /** Handle auth response */
     void ProcessAuthResponse(bool bSuccess, const FString& ResponseJson);
 };
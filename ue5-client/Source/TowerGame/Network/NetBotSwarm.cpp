@@ -0,0 +1,370 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetBotSwarm.h"
+#include "ActionSender.h"
+#include "BincodeSerializer.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    // Server -> client packet types (AReplicationManager::EPacketType)
+    ETowerNetChannel GetPacketChannel(uint8 PacketType)
+    {
+        switch (PacketType)
+        {
+            case 0x00: return ETowerNetChannel::Keepalive;
+            case 0x01: return ETowerNetChannel::PlayerUpdate;
+            case 0x02: return ETowerNetChannel::MonsterUpdate;
+            case 0x03: return ETowerNetChannel::FloorTileUpdate;
+            case 0x04: return ETowerNetChannel::PlayerSpawn;
+            case 0x05: return ETowerNetChannel::PlayerDespawn;
+            case 0x06: return ETowerNetChannel::PlayerUpdate;
+            case 0x07: return ETowerNetChannel::MonsterUpdate;
+            case 0x08: return ETowerNetChannel::FloorTileUpdate;
+            default:   return ETowerNetChannel::Unknown;
+        }
+    }
+
+    const TCHAR* BotWeaponId = TEXT("starter_sword");
+}
+
+FNetBotSwarm::FNetBotSwarm(const FConfig& InConfig)
+    : Config(InConfig)
+{
+}
+
+FNetBotSwarm::~FNetBotSwarm()
+{
+    for (FBot& Bot : Bots)
+    {
+        if (Bot.Client)
+        {
+            Bot.Client->Disconnect();
+        }
+    }
+}
+
+int32 FNetBotSwarm::Start()
+{
+    StartSeconds = FPlatformTime::Seconds();
+    LastTickSeconds = StartSeconds;
+
+    // One process, many handshakes: the timestamp IDs UNetcodeClient makes up would collide
+    const int64 BaseClientId = FDateTime::UtcNow().ToUnixTimestamp() * 1000;
+
+    Bots.SetNum(FMath::Max(Config.NumBots, 0));
+    for (int32 i = 0; i < Bots.Num(); ++i)
+    {
+        FBot& Bot = Bots[i];
+        Bot.Script.Initialize(HashCombine(GetTypeHash(Config.Seed), GetTypeHash(i)));
+
+        Bot.Client = NewObject<UNetcodeClient>(GetTransientPackage());
+        Bot.Client->SetRequestedClientId(BaseClientId + i + 1);
+        if (!Bot.Client->Connect(Config.ServerIP, Config.ServerPort))
+        {
+            continue;
+        }
+        ConnectedBots++;
+
+        Bot.Sender = NewObject<UTowerActionSender>(GetTransientPackage());
+        Bot.Sender->SetNetcodeClient(Bot.Client, Bot.Client->GetClientId());
+
+        // Stagger the timers so the bots don't all send on the same frame
+        Bot.Input.Forward = 127;
+        Bot.Input.Yaw = FRotator::CompressAxisToShort(Bot.Script.FRandRange(0.0f, 360.0f));
+        Bot.NextTurnTime = StartSeconds + Bot.Script.FRandRange(0.0f, 1.0f);
+        Bot.NextAttackTime = StartSeconds + Bot.Script.FRandRange(0.5f, 2.0f);
+        Bot.NextDodgeTime = StartSeconds + Bot.Script.FRandRange(2.0f, 6.0f);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("NetBotSwarm: %d/%d bots connected to %s:%d"),
+        ConnectedBots, Bots.Num(), *Config.ServerIP, Config.ServerPort);
+    return ConnectedBots;
+}
+
+bool FNetBotSwarm::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    LastTickSeconds = Now;
+
+    for (FBot& Bot : Bots)
+    {
+        if (!Bot.Sender || !Bot.Client->IsConnected())
+        {
+            continue;
+        }
+
+        TickScript(Bot, Now);
+        TickPrediction(Bot, DeltaTime);
+        Bot.Sender->FlushOutbound();
+        Bot.Sender->PurgeTimedOutActions();
+
+        // After the actions were queued, so they share the step's bundle
+        Bot.Client->Tick(DeltaTime);
+        ReceiveUpdates(Bot);
+    }
+
+    return Config.DurationSeconds <= 0.0f || Now - StartSeconds < Config.DurationSeconds;
+}
+
+// ============ Script ============
+
+void FNetBotSwarm::TickScript(FBot& Bot, double Now)
+{
+    auto Count = [this](bool bSent) { (bSent ? ActionsSent : ActionsRefused)++; };
+
+    if (Now >= Bot.NextTurnTime)
+    {
+        Turn(Bot, Now);
+        Bot.NextTurnTime = Now + Bot.Script.FRandRange(1.5f, 4.0f);
+    }
+
+    if (Now >= Bot.NextAttackTime)
+    {
+        Count(Bot.Sender->SendAttackAction(BotWeaponId, Bot.ComboStep, GetHeading(Bot.Input)));
+        Bot.ComboStep = (Bot.ComboStep + 1) % 3;
+        Bot.NextAttackTime = Now + Bot.Script.FRandRange(0.4f, 1.5f);
+    }
+
+    if (Now >= Bot.NextDodgeTime)
+    {
+        Count(Bot.Sender->SendDodgeAction(GetHeading(Bot.Input)));
+        Bot.NextDodgeTime = Now + Bot.Script.FRandRange(3.0f, 8.0f);
+    }
+}
+
+void FNetBotSwarm::Turn(FBot& Bot, double Now)
+{
+    // Sharp enough that the old heading can't pass for the new one in the latency probe
+    const float Yaw = FRotator::DecompressAxisFromShort(Bot.Input.Yaw) + Bot.Script.FRandRange(90.0f, 270.0f);
+    Bot.Input.Yaw = FRotator::CompressAxisToShort(Yaw);
+
+    const FVector Direction = GetHeading(Bot.Input);
+    if (Bot.Sender->SendMoveAction(Direction, false))
+    {
+        ActionsSent++;
+        Bot.bAwaitingTurn = true;
+        Bot.TurnSentTime = Now;
+        Bot.TurnDirection = Direction;
+    }
+    else
+    {
+        ActionsRefused++;
+    }
+}
+
+FVector FNetBotSwarm::GetHeading(const FTowerMoveInput& Input)
+{
+    // Straight ahead along the input yaw, as FTowerMovementSim reads Forward-only input
+    double Sin, Cos;
+    FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(FRotator::DecompressAxisFromShort(Input.Yaw)));
+    return FVector(Cos, Sin, 0.0);
+}
+
+// ============ Prediction ============
+
+void FNetBotSwarm::TickPrediction(FBot& Bot, float DeltaTime)
+{
+    // Capped so a hitch doesn't turn into hundreds of steps for every bot
+    Bot.SimAccumulator = FMath::Min(Bot.SimAccumulator + DeltaTime, 0.25);
+
+    while (Bot.SimAccumulator >= FTowerMovementSim::FixedDeltaSeconds)
+    {
+        Bot.SimAccumulator -= FTowerMovementSim::FixedDeltaSeconds;
+        Bot.Predicted = Sim.Step(Bot.Predicted, Bot.Input);
+
+        Bot.PredictedHistory[Bot.HistoryHead] = Bot.Predicted.Position;
+        Bot.HistoryHead = (Bot.HistoryHead + 1) % HistoryLength;
+        Bot.HistoryCount = FMath::Min(Bot.HistoryCount + 1, HistoryLength);
+    }
+}
+
+void FNetBotSwarm::ReceiveUpdates(FBot& Bot)
+{
+    if (!Bot.Client->ReceivePackets(Bot.Received))
+    {
+        return;
+    }
+
+    const int64 OwnId = Bot.Client->GetClientId();
+    for (const FNetcodeReceivedPacket& Packet : Bot.Received)
+    {
+        if (Packet.Size == 0)
+        {
+            continue;
+        }
+
+        BytesReceived += Packet.Size;
+        const ETowerNetChannel Channel = GetPacketChannel(Packet.Data[0]);
+        PacketCounts[static_cast<int32>(Channel)]++;
+
+        FBincodeReader Reader(Packet.Data, Packet.Size);
+        const uint8 PacketType = Reader.ReadU8();
+
+        if (PacketType == 0x08)
+        {
+            const FVector Min = Reader.ReadVec3();
+            const FVector Max = Reader.ReadVec3();
+            if (Reader.IsValid())
+            {
+                QuantizeFrame = FNetQuantizeFrame(Min, Max);
+            }
+            continue;
+        }
+
+        const bool bQuantized = PacketType == 0x06;
+        if ((Channel != ETowerNetChannel::PlayerUpdate && Channel != ETowerNetChannel::PlayerSpawn)
+            || (bQuantized && !QuantizeFrame.IsValid()))
+        {
+            continue;
+        }
+
+        // The same decode AReplicationManager::ProcessPlayerData runs
+        Reader.SetQuantizeFrame(&QuantizeFrame);
+        const FPlayerData PlayerData = bQuantized ? FPlayerData::FromQuantizedBincode(Reader) : FPlayerData::FromBincode(Reader);
+        if (Reader.IsValid() && PlayerData.Id == OwnId)
+        {
+            CheckOwnUpdate(Bot, PlayerData.Position, Packet.ArrivalTime);
+        }
+    }
+}
+
+void FNetBotSwarm::CheckOwnUpdate(FBot& Bot, const FVector& ServerPosition, double ArrivalTime)
+{
+    OwnUpdates++;
+
+    if (!Bot.bHasServerPosition)
+    {
+        // The spawn point is the server's to pick; predict from there
+        Bot.bHasServerPosition = true;
+        Bot.LastServerPosition = ServerPosition;
+        Bot.Predicted.Position = ServerPosition;
+        Bot.HistoryCount = 0;
+        return;
+    }
+
+    // First update that moves along the last turn closes the latency probe
+    const FVector Moved = (ServerPosition - Bot.LastServerPosition) * FVector(1.0, 1.0, 0.0);
+    if (Bot.bAwaitingTurn && Moved.SizeSquared() > 1.0 && (Moved.GetSafeNormal() | Bot.TurnDirection) > 0.9)
+    {
+        InputLatency.Record((ArrivalTime - Bot.TurnSentTime) * 1000.0);
+        Bot.bAwaitingTurn = false;
+    }
+    Bot.LastServerPosition = ServerPosition;
+
+    // The server is a round trip behind, so anywhere on the last second of predicted path is a match
+    double BestDistSq = FVector::DistSquared2D(ServerPosition, Bot.Predicted.Position);
+    for (int32 i = 0; i < Bot.HistoryCount; ++i)
+    {
+        BestDistSq = FMath::Min(BestDistSq, FVector::DistSquared2D(ServerPosition, Bot.PredictedHistory[i]));
+    }
+
+    const double Error = FMath::Sqrt(BestDistSq);
+    if (Error > Config.CorrectionDistance)
+    {
+        Corrections++;
+        CorrectionErrorSum += Error;
+        CorrectionErrorMax = FMath::Max(CorrectionErrorMax, Error);
+
+        Bot.Predicted.Position = ServerPosition;
+        Bot.HistoryCount = 0;
+    }
+}
+
+// ============ Report ============
+
+FNetBotSwarm::FSenderTotals FNetBotSwarm::GetSenderTotals() const
+{
+    FSenderTotals Totals;
+    for (const FBot& Bot : Bots)
+    {
+        if (Bot.Sender)
+        {
+            Totals.Redundant += Bot.Sender->GetRedundantActionsSent();
+            Totals.TimedOut += Bot.Sender->GetTimedOutActionCount();
+            Totals.Pending += Bot.Sender->GetPendingActionCount();
+        }
+    }
+    return Totals;
+}
+
+double FNetBotSwarm::GetSnapshotRate(double Elapsed) const
+{
+    if (ConnectedBots == 0 || Elapsed <= 0.0)
+    {
+        return 0.0;
+    }
+
+    const int32 Snapshots = PacketCounts[static_cast<int32>(ETowerNetChannel::PlayerUpdate)]
+        + PacketCounts[static_cast<int32>(ETowerNetChannel::MonsterUpdate)];
+    return Snapshots / (ConnectedBots * Elapsed);
+}
+
+void FNetBotSwarm::LogReport(FOutputDevice& Ar) const
+{
+    const double Elapsed = LastTickSeconds - StartSeconds;
+    const FSenderTotals Senders = GetSenderTotals();
+
+    Ar.Logf(TEXT("NetBots: %d/%d bots on %s:%d for %.1f s, %.1f KB/s in"),
+        ConnectedBots, Bots.Num(), *Config.ServerIP, Config.ServerPort, Elapsed,
+        Elapsed > 0.0 ? BytesReceived / 1024.0 / Elapsed : 0.0);
+    Ar.Logf(TEXT("  actions: %d sent, %d refused, %d redundant copies, %d timed out, %d still pending"),
+        ActionsSent, ActionsRefused, Senders.Redundant, Senders.TimedOut, Senders.Pending);
+    Ar.Logf(TEXT("  snapshots: %.1f /bot/s"), GetSnapshotRate(Elapsed));
+    Ar.Logf(TEXT("  input latency: %lld samples, mean %.1f ms, p50 %.1f ms, p99 %.1f ms, max %.1f ms"),
+        InputLatency.GetCount(), InputLatency.GetMeanMs(),
+        InputLatency.GetPercentile(50.0), InputLatency.GetPercentile(99.0), InputLatency.GetMaxMs());
+    Ar.Logf(TEXT("  corrections: %d of %d own updates, mean %.0f cm, max %.0f cm"),
+        Corrections, OwnUpdates, Corrections > 0 ? CorrectionErrorSum / Corrections : 0.0, CorrectionErrorMax);
+
+    const UEnum* ChannelEnum = StaticEnum<ETowerNetChannel>();
+    for (int32 i = 0; i < UE_ARRAY_COUNT(PacketCounts); ++i)
+    {
+        if (PacketCounts[i] > 0)
+        {
+            Ar.Logf(TEXT("  %-18s %8d"), *ChannelEnum->GetDisplayNameTextByValue(i).ToString(), PacketCounts[i]);
+        }
+    }
+}
+
+void FNetBotSwarm::WriteCsv(const FString& FileName) const
+{
+    const double Elapsed = LastTickSeconds - StartSeconds;
+    const FSenderTotals Senders = GetSenderTotals();
+
+    const FString Path = FPaths::Combine(FPaths::ProfilingDir(), FileName);
+    FString Csv;
+    if (!FPaths::FileExists(Path))
+    {
+        Csv += TEXT("timestamp,server,bots,connected,seconds,actions_sent,actions_refused,redundant_actions,timed_out_actions,snapshots_per_bot_s,kb_in_per_s,latency_samples,latency_mean_ms,latency_p50_ms,latency_p99_ms,latency_max_ms,own_updates,corrections,correction_mean_cm,correction_max_cm\n");
+    }
+
+    Csv += FString::Printf(TEXT("%s,%s:%d,%d,%d,%.1f,%d,%d,%d,%d,%.2f,%.2f,%lld,%.2f,%.2f,%.2f,%.2f,%d,%d,%.1f,%.1f\n"),
+        *FDateTime::UtcNow().ToIso8601(), *Config.ServerIP, Config.ServerPort, Bots.Num(), ConnectedBots, Elapsed,
+        ActionsSent, ActionsRefused, Senders.Redundant, Senders.TimedOut,
+        GetSnapshotRate(Elapsed), Elapsed > 0.0 ? BytesReceived / 1024.0 / Elapsed : 0.0,
+        InputLatency.GetCount(), InputLatency.GetMeanMs(),
+        InputLatency.GetPercentile(50.0), InputLatency.GetPercentile(99.0), InputLatency.GetMaxMs(),
+        OwnUpdates, Corrections, Corrections > 0 ? CorrectionErrorSum / Corrections : 0.0, CorrectionErrorMax);
+
+    if (FFileHelper::SaveStringToFile(Csv, *Path, FFileHelper::EEncodingOptions::AutoDetect,
+        &IFileManager::Get(), FILEWRITE_Append))
+    {
+        UE_LOG(LogTemp, Log, TEXT("NetBotSwarm: results appended to %s"), *Path);
+    }
+}
+
+void FNetBotSwarm::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (FBot& Bot : Bots)
+    {
+        Collector.AddReferencedObject(Bot.Client);
+        Collector.AddReferencedObject(Bot.Sender);
+    }
+}
@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "Math/RandomStream.h"
+#include "NetStats.h"
+#include "NetcodeClient.h"
+#include "LatencyHistogram.h"
+#include "NetQuantize.h"
+#include "Player/TowerMovementSim.h"
+
+class UTowerActionSender;
+
+/**
+ * N headless clients in one process, for loading a Bevy server.
+ *
+ * Each bot owns a UNetcodeClient (its own socket, handshake and keepalives)
+ * and a UTowerActionSender pointed at it, so every move, attack and dodge goes
+ * out through the same bincode encoding and redundancy as a real player's.
+ * The script is seeded per bot: walk a heading, turn sharply every few
+ * seconds, attack and dodge on timers.
+ *
+ * Own-player updates are checked against a FTowerMovementSim prediction of
+ * the scripted input. Reported per swarm:
+ * - input latency: a turn being sent until the server position first moves the new way
+ * - snapshot rate: player + monster updates per bot per second
+ * - corrections: server position further than CorrectionDistance from the recent predicted path
+ *
+ * Run with 'tower.NetBots <count> [ip] [port] [seconds] [quit]', headless with -nullrhi.
+ */
+class TOWERGAME_API FNetBotSwarm : public FGCObject
+{
+public:
+    struct FConfig
+    {
+        int32 NumBots = 16;
+        FString ServerIP = TEXT("127.0.0.1");
+        int32 ServerPort = 5000;
+
+        /** <= 0 runs until stopped */
+        float DurationSeconds = 60.0f;
+
+        int32 Seed = 1;
+        float CorrectionDistance = 100.0f;
+    };
+
+    explicit FNetBotSwarm(const FConfig& InConfig);
+    virtual ~FNetBotSwarm();
+
+    /** Connect every bot; returns how many connected */
+    int32 Start();
+
+    /** Run every bot for one network step; false once DurationSeconds is up */
+    bool Tick(float DeltaTime);
+
+    void LogReport(FOutputDevice& Ar) const;
+
+    /** Append the report as one row to Saved/Profiling/<FileName> */
+    void WriteCsv(const FString& FileName) const;
+
+    // FGCObject
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override { return TEXT("FNetBotSwarm"); }
+
+private:
+    static constexpr int32 HistoryLength = 64;  // ~1 s of sim ticks
+
+    struct FBot
+    {
+        TObjectPtr<UNetcodeClient> Client;
+        TObjectPtr<UTowerActionSender> Sender;
+        FRandomStream Script;
+
+        // Scripted input, and where it should have taken us
+        FTowerMoveInput Input;
+        FTowerMoveState Predicted;
+        FVector PredictedHistory[HistoryLength];
+        int32 HistoryCount = 0;
+        int32 HistoryHead = 0;
+        double SimAccumulator = 0.0;
+
+        double NextTurnTime = 0.0;
+        double NextAttackTime = 0.0;
+        double NextDodgeTime = 0.0;
+        int32 ComboStep = 0;
+
+        // Input latency probe: the last turn, until the server shows it
+        bool bAwaitingTurn = false;
+        double TurnSentTime = 0.0;
+        FVector TurnDirection = FVector::ZeroVector;
+
+        bool bHasServerPosition = false;
+        FVector LastServerPosition = FVector::ZeroVector;
+
+        TArray<FNetcodeReceivedPacket> Received;
+    };
+
+    void TickScript(FBot& Bot, double Now);
+    void TickPrediction(FBot& Bot, float DeltaTime);
+    void ReceiveUpdates(FBot& Bot);
+    void CheckOwnUpdate(FBot& Bot, const FVector& ServerPosition, double ArrivalTime);
+
+    /** Send a move for a heading at least 90 degrees off the current one */
+    void Turn(FBot& Bot, double Now);
+
+    static FVector GetHeading(const FTowerMoveInput& Input);
+
+    /** Summed over every bot's action sender */
+    struct FSenderTotals
+    {
+        int32 Redundant = 0;
+        int32 TimedOut = 0;
+        int32 Pending = 0;
+    };
+    FSenderTotals GetSenderTotals() const;
+
+    /** Player and monster updates per connected bot per second */
+    double GetSnapshotRate(double Elapsed) const;
+
+    FConfig Config;
+    FTowerMovementSim Sim;
+    TArray<FBot> Bots;
+
+    double StartSeconds = 0.0;
+    double LastTickSeconds = 0.0;
+
+    FLatencyHistogram InputLatency;
+    double CorrectionErrorSum = 0.0;
+    double CorrectionErrorMax = 0.0;
+    int32 ConnectedBots = 0;
+    int32 ActionsSent = 0;
+    int32 ActionsRefused = 0;               // Rate limit or full pending queue
+    int32 OwnUpdates = 0;
+    int32 Corrections = 0;
+    int32 PacketCounts[static_cast<int32>(ETowerNetChannel::MAX)] = {};
+    int64 BytesReceived = 0;
+
+    /** The server's FloorBounds; one floor for every bot */
+    FNetQuantizeFrame QuantizeFrame;
+};
@@ -0,0 +1,169 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetCapture.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    void PutU16(uint8* Out, uint16 Value)
+    {
+        Out[0] = static_cast<uint8>(Value);
+        Out[1] = static_cast<uint8>(Value >> 8);
+    }
+
+    void PutU32(uint8* Out, uint32 Value)
+    {
+        for (int32 i = 0; i < 4; ++i)
+        {
+            Out[i] = static_cast<uint8>(Value >> (i * 8));
+        }
+    }
+
+    uint32 GetU32(const uint8* In)
+    {
+        return static_cast<uint32>(In[0]) | (static_cast<uint32>(In[1]) << 8) |
+            (static_cast<uint32>(In[2]) << 16) | (static_cast<uint32>(In[3]) << 24);
+    }
+}
+
+// ============================================================================
+// FNetCaptureWriter
+// ============================================================================
+
+FNetCaptureWriter::~FNetCaptureWriter()
+{
+    Close();
+}
+
+bool FNetCaptureWriter::Open(const FString& InPath)
+{
+    Close();
+
+    Archive.Reset(IFileManager::Get().CreateFileWriter(*InPath));
+    if (!Archive.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("NetCapture: cannot open %s for writing"), *InPath);
+        return false;
+    }
+
+    uint8 Header[NetCapture::HeaderSize];
+    PutU32(Header, NetCapture::Magic);
+    PutU16(Header + 4, NetCapture::Version);
+    PutU16(Header + 6, 0);
+    Archive->Serialize(Header, sizeof(Header));
+
+    Path = InPath;
+    LastArrival = 0.0;
+    RecordCount = 0;
+    BytesWritten = sizeof(Header);
+
+    UE_LOG(LogTemp, Log, TEXT("NetCapture: recording to %s"), *Path);
+    return true;
+}
+
+void FNetCaptureWriter::Close()
+{
+    if (!Archive.IsValid())
+    {
+        return;
+    }
+
+    Archive->Close();
+    Archive.Reset();
+
+    UE_LOG(LogTemp, Log, TEXT("NetCapture: wrote %d records (%lld bytes) to %s"), RecordCount, BytesWritten, *Path);
+}
+
+void FNetCaptureWriter::Write(ENetCaptureSource Source, uint8 Tag, double ArrivalSeconds, TArrayView<const uint8> Data)
+{
+    if (!Archive.IsValid())
+    {
+        return;
+    }
+
+    // Packets drained in one batch can carry slightly out-of-order receive-thread stamps
+    const double Delta = RecordCount > 0 ? FMath::Max(ArrivalSeconds - LastArrival, 0.0) : 0.0;
+    LastArrival = RecordCount > 0 ? FMath::Max(ArrivalSeconds, LastArrival) : ArrivalSeconds;
+
+    uint8 Header[NetCapture::RecordHeaderSize];
+    Header[0] = static_cast<uint8>(Source);
+    Header[1] = Tag;
+    PutU32(Header + 2, static_cast<uint32>(FMath::Min(Delta * 1e6, static_cast<double>(MAX_uint32))));
+    PutU32(Header + 6, static_cast<uint32>(Data.Num()));
+
+    Archive->Serialize(Header, sizeof(Header));
+    Archive->Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+
+    ++RecordCount;
+    BytesWritten += sizeof(Header) + Data.Num();
+}
+
+// ============================================================================
+// FNetCaptureReader
+// ============================================================================
+
+bool FNetCaptureReader::Open(const FString& Path)
+{
+    Buffer.Reset();
+    if (!FFileHelper::LoadFileToArray(Buffer, *Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("NetCapture: cannot read %s"), *Path);
+        return false;
+    }
+
+    if (Buffer.Num() < NetCapture::HeaderSize || GetU32(Buffer.GetData()) != NetCapture::Magic)
+    {
+        UE_LOG(LogTemp, Error, TEXT("NetCapture: %s is not a capture file"), *Path);
+        Buffer.Reset();
+        return false;
+    }
+
+    const uint16 FileVersion = static_cast<uint16>(Buffer[4] | (Buffer[5] << 8));
+    if (FileVersion != NetCapture::Version)
+    {
+        UE_LOG(LogTemp, Error, TEXT("NetCapture: %s has version %d, expected %d"), *Path, FileVersion, NetCapture::Version);
+        Buffer.Reset();
+        return false;
+    }
+
+    Rewind();
+    return true;
+}
+
+void FNetCaptureReader::Rewind()
+{
+    Offset = NetCapture::HeaderSize;
+    Time = 0.0;
+    RecordsRead = 0;
+    bTruncated = false;
+}
+
+bool FNetCaptureReader::Next(FNetCaptureRecord& OutRecord)
+{
+    if (Offset + NetCapture::RecordHeaderSize > Buffer.Num())
+    {
+        bTruncated = Offset < Buffer.Num();
+        return false;
+    }
+
+    const uint8* Header = Buffer.GetData() + Offset;
+    const int64 Size = GetU32(Header + 6);
+    if (Offset + NetCapture::RecordHeaderSize + Size > Buffer.Num())
+    {
+        bTruncated = true;
+        return false;
+    }
+
+    Time += GetU32(Header + 2) * 1e-6;
+
+    OutRecord.Source = static_cast<ENetCaptureSource>(Header[0]);
+    OutRecord.Tag = Header[1];
+    OutRecord.Time = Time;
+    OutRecord.Data = TArrayView<const uint8>(Header + NetCapture::RecordHeaderSize, static_cast<int32>(Size));
+
+    Offset += NetCapture::RecordHeaderSize + static_cast<int32>(Size);
+    ++RecordsRead;
+    return true;
+}
@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+
+/** Which receive path a captured message came in on */
+enum class ENetCaptureSource : uint8
+{
+    Netcode = 0,    // UDP datagram from UNetcodeClient, Tag unused
+    Match = 1,      // Nakama match payload from UMatchConnection, Tag = EMatchOpCode
+};
+
+/**
+ * Capture file layout (all little-endian):
+ *
+ *   header  u32 magic 'TNCP', u16 version, u16 reserved
+ *   record  u8 source, u8 tag, u32 microseconds since the previous record, u32 size, size bytes
+ *
+ * Payloads are stored as the game code sees them: the raw datagram, or the
+ * match payload after the Nakama envelope (JSON or protobuf) is stripped, so
+ * a capture replays the same way regardless of the envelope format.
+ */
+namespace NetCapture
+{
+    constexpr uint32 Magic = 0x50434E54;    // "TNCP"
+    constexpr uint16 Version = 1;
+    constexpr int32 HeaderSize = 8;
+    constexpr int32 RecordHeaderSize = 10;
+}
+
+/**
+ * Writes inbound network traffic to a capture file.
+ * Game thread only; both receive paths hand over their packets there.
+ */
+class TOWERGAME_API FNetCaptureWriter
+{
+public:
+    ~FNetCaptureWriter();
+
+    bool Open(const FString& Path);
+    void Close();
+
+    bool IsOpen() const { return Archive.IsValid(); }
+
+    /** ArrivalSeconds is FPlatformTime::Seconds() when the message arrived */
+    void Write(ENetCaptureSource Source, uint8 Tag, double ArrivalSeconds, TArrayView<const uint8> Data);
+
+    const FString& GetPath() const { return Path; }
+    int32 GetRecordCount() const { return RecordCount; }
+    int64 GetBytesWritten() const { return BytesWritten; }
+
+private:
+    TUniquePtr<FArchive> Archive;
+    FString Path;
+    double LastArrival = 0.0;
+    int32 RecordCount = 0;
+    int64 BytesWritten = 0;
+};
+
+/** One message from a capture; Data points into the reader's buffer */
+struct FNetCaptureRecord
+{
+    ENetCaptureSource Source = ENetCaptureSource::Netcode;
+    uint8 Tag = 0;
+
+    /** Seconds since the first record of the capture */
+    double Time = 0.0;
+
+    TArrayView<const uint8> Data;
+};
+
+/** Reads a whole capture file into memory and walks its records */
+class TOWERGAME_API FNetCaptureReader
+{
+public:
+    bool Open(const FString& Path);
+
+    /** False at the end of the capture, or if the next record is truncated */
+    bool Next(FNetCaptureRecord& OutRecord);
+
+    /** Back to the first record */
+    void Rewind();
+
+    bool IsTruncated() const { return bTruncated; }
+    int32 GetRecordsRead() const { return RecordsRead; }
+
+private:
+    TArray<uint8> Buffer;
+    int32 Offset = 0;
+    double Time = 0.0;
+    int32 RecordsRead = 0;
+    bool bTruncated = false;
+};
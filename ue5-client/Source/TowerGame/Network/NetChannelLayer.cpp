@@ -0,0 +1,425 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetChannelLayer.h"
+
+namespace
+{
+    constexpr uint8 ModeSequenced = 0;
+    constexpr uint8 ModeReliable = 1;
+    constexpr uint8 ModeAckOnly = 15;
+    constexpr uint8 FlagHasAck = 0x80;
+
+    constexpr double InitialResendTimeout = 0.2;
+    constexpr double MinResendTimeout = 0.05;
+    constexpr double MaxResendTimeout = 1.0;
+
+    /** Wrapping distance from B to A; positive when A is newer */
+    int32 SeqDiff(uint16 A, uint16 B)
+    {
+        return static_cast<int16>(static_cast<uint16>(A - B));
+    }
+
+    uint16 ReadU16(const uint8* Src) { return static_cast<uint16>(Src[0] | (Src[1] << 8)); }
+    uint32 ReadU32(const uint8* Src) { return Src[0] | (Src[1] << 8) | (Src[2] << 16) | (static_cast<uint32>(Src[3]) << 24); }
+
+    void WriteU16(uint8* Dest, uint16 Value)
+    {
+        Dest[0] = static_cast<uint8>(Value);
+        Dest[1] = static_cast<uint8>(Value >> 8);
+    }
+
+    void WriteU32(uint8* Dest, uint32 Value)
+    {
+        for (int32 i = 0; i < 4; ++i)
+        {
+            Dest[i] = static_cast<uint8>(Value >> (8 * i));
+        }
+    }
+}
+
+FNetChannelLayer::FNetChannelLayer(int32 InMaxDatagramSize)
+    : MaxDatagramSize(FMath::Max(InMaxDatagramSize, HeaderSize + 1))
+{
+}
+
+void FNetChannelLayer::Reset()
+{
+    const int32 SavedSize = MaxDatagramSize;
+    *this = FNetChannelLayer(SavedSize);
+}
+
+// ============================================================================
+// Framing
+// ============================================================================
+
+void FNetChannelLayer::WriteHeader(uint8* Dest, uint8 Mode, uint16 Sequence, uint8 FragmentIndex, uint8 FragmentCount)
+{
+    Dest[0] = FrameMarker;
+    Dest[1] = Mode;
+    WriteU16(Dest + 2, Sequence);
+    Dest[4] = FragmentIndex;
+    Dest[5] = FragmentCount;
+    StampAck(Dest);
+}
+
+void FNetChannelLayer::StampAck(uint8* Datagram)
+{
+    // Re-stamped on every (re)send so resends carry the newest acks
+    if (bHasRemoteReliable)
+    {
+        Datagram[1] |= FlagHasAck;
+        WriteU16(Datagram + 6, RemoteReliableSeq);
+        WriteU32(Datagram + 8, RemoteReliableBits);
+    }
+    else
+    {
+        Datagram[1] &= ~FlagHasAck;
+        WriteU16(Datagram + 6, 0);
+        WriteU32(Datagram + 8, 0);
+    }
+    bAckPending = false;
+}
+
+// ============================================================================
+// Sending
+// ============================================================================
+
+bool FNetChannelLayer::Send(ENetDelivery Delivery, TArrayView<const uint8> Message, ETowerNetChannel Channel, double Now, FEmitFunc Emit)
+{
+    const int32 FragmentSize = GetFragmentPayloadSize();
+    const int32 FragmentCount = FMath::Max(1, FMath::DivideAndRoundUp(Message.Num(), FragmentSize));
+    if (FragmentCount > MaxFragments)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("NetChannelLayer: %d byte message exceeds the %d byte limit"), Message.Num(), GetMaxMessageSize());
+        return false;
+    }
+
+    for (int32 Index = 0; Index < FragmentCount; ++Index)
+    {
+        const int32 Offset = Index * FragmentSize;
+        const int32 Size = FMath::Min(FragmentSize, Message.Num() - Offset);
+
+        if (Delivery == ENetDelivery::UnreliableSequenced)
+        {
+            SendScratch.SetNumUninitialized(HeaderSize + Size, false);
+            WriteHeader(SendScratch.GetData(), ModeSequenced, NextSequencedSeq++, static_cast<uint8>(Index), static_cast<uint8>(FragmentCount));
+            FMemory::Memcpy(SendScratch.GetData() + HeaderSize, Message.GetData() + Offset, Size);
+            Emit(SendScratch, Channel);
+            continue;
+        }
+
+        // Sequence numbers are assigned when a fragment enters the window, so queued ones stay contiguous
+        FPendingFragment& Pending = PendingReliable.AddDefaulted_GetRef();
+        Pending.Channel = Channel;
+        Pending.Datagram.SetNumUninitialized(HeaderSize + Size);
+        Pending.Datagram[4] = static_cast<uint8>(Index);
+        Pending.Datagram[5] = static_cast<uint8>(FragmentCount);
+        FMemory::Memcpy(Pending.Datagram.GetData() + HeaderSize, Message.GetData() + Offset, Size);
+    }
+
+    if (Delivery == ENetDelivery::ReliableOrdered)
+    {
+        FillReliableWindow(Now, Emit);
+    }
+    return true;
+}
+
+void FNetChannelLayer::FillReliableWindow(double Now, FEmitFunc Emit)
+{
+    int32 Taken = 0;
+    while (Taken < PendingReliable.Num())
+    {
+        FReliableSlot& Slot = SendWindow[NextReliableSeq % ReliableWindow];
+        if (Slot.bInUse)
+        {
+            // Sequence - ReliableWindow is still unacked; going further would outrun the ack bits
+            break;
+        }
+
+        FPendingFragment& Pending = PendingReliable[Taken++];
+        Slot.Datagram = MoveTemp(Pending.Datagram);
+        Slot.Channel = Pending.Channel;
+        Slot.Sequence = NextReliableSeq++;
+        Slot.Sends = 0;
+        Slot.bInUse = true;
+        ++ReliableInFlight;
+
+        uint8* Header = Slot.Datagram.GetData();
+        WriteHeader(Header, ModeReliable, Slot.Sequence, Header[4], Header[5]);
+        TransmitReliable(Slot, Now, Emit);
+    }
+
+    if (Taken > 0)
+    {
+        PendingReliable.RemoveAt(0, Taken, false);
+    }
+}
+
+void FNetChannelLayer::TransmitReliable(FReliableSlot& Slot, double Now, FEmitFunc Emit)
+{
+    if (Slot.Sends == 0)
+    {
+        Slot.FirstSent = Now;
+    }
+    else
+    {
+        ++ResentCount;
+        StampAck(Slot.Datagram.GetData());
+    }
+
+    Slot.LastSent = Now;
+    ++Slot.Sends;
+    Emit(Slot.Datagram, Slot.Channel);
+}
+
+double FNetChannelLayer::GetResendTimeout() const
+{
+    if (SmoothedRTT <= 0.0)
+    {
+        return InitialResendTimeout;
+    }
+
+    // RFC 6298 RTO
+    return FMath::Clamp(SmoothedRTT + 4.0 * RTTVariance, MinResendTimeout, MaxResendTimeout);
+}
+
+void FNetChannelLayer::Update(double Now, FEmitFunc Emit)
+{
+    const double Timeout = GetResendTimeout();
+    for (FReliableSlot& Slot : SendWindow)
+    {
+        if (Slot.bInUse && Now - Slot.LastSent >= Timeout * FMath::Min(Slot.Sends, 4))
+        {
+            TransmitReliable(Slot, Now, Emit);
+        }
+    }
+
+    FillReliableWindow(Now, Emit);
+
+    if (bAckPending)
+    {
+        uint8 AckFrame[HeaderSize];
+        WriteHeader(AckFrame, ModeAckOnly, 0, 0, 0);
+        Emit(TArrayView<const uint8>(AckFrame, HeaderSize), ETowerNetChannel::Keepalive);
+    }
+}
+
+void FNetChannelLayer::ProcessAcks(uint16 Ack, uint32 AckBits, double Now)
+{
+    for (FReliableSlot& Slot : SendWindow)
+    {
+        if (!Slot.bInUse)
+        {
+            continue;
+        }
+
+        const int32 Behind = SeqDiff(Ack, Slot.Sequence);
+        const bool bAcked = Behind == 0 || (Behind > 0 && Behind <= 32 && (AckBits & (1u << (Behind - 1))) != 0);
+        if (!bAcked)
+        {
+            continue;
+        }
+
+        // Karn: only fragments that went out once give an unambiguous sample
+        if (Slot.Sends == 1)
+        {
+            const double Sample = Now - Slot.FirstSent;
+            if (SmoothedRTT <= 0.0)
+            {
+                SmoothedRTT = Sample;
+                RTTVariance = Sample * 0.5;
+            }
+            else
+            {
+                RTTVariance = 0.75 * RTTVariance + 0.25 * FMath::Abs(SmoothedRTT - Sample);
+                SmoothedRTT = 0.875 * SmoothedRTT + 0.125 * Sample;
+            }
+        }
+
+        Slot.bInUse = false;
+        Slot.Datagram.Reset();
+        --ReliableInFlight;
+    }
+}
+
+// ============================================================================
+// Receiving
+// ============================================================================
+
+void FNetChannelLayer::Receive(TArrayView<const uint8> Datagram, double Now, FDeliverFunc Deliver)
+{
+    if (!IsChannelFrame(Datagram))
+    {
+        return;
+    }
+
+    const uint8* Header = Datagram.GetData();
+    const uint8 Mode = Header[1] & 0x0F;
+    const uint16 Sequence = ReadU16(Header + 2);
+    const uint8 Index = Header[4];
+    const uint8 Count = Header[5];
+
+    if (Header[1] & FlagHasAck)
+    {
+        ProcessAcks(ReadU16(Header + 6), ReadU32(Header + 8), Now);
+    }
+
+    if (Mode == ModeAckOnly)
+    {
+        return;
+    }
+
+    if (Count == 0 || Index >= Count)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("NetChannelLayer: bad fragment %d/%d"), Index, Count);
+        return;
+    }
+
+    const TArrayView<const uint8> Payload = Datagram.Slice(HeaderSize, Datagram.Num() - HeaderSize);
+    if (Mode == ModeReliable)
+    {
+        ReceiveReliable(Sequence, Index, Count, Payload, Deliver);
+    }
+    else if (Mode == ModeSequenced)
+    {
+        ReceiveSequenced(Sequence, Index, Count, Payload, Deliver);
+    }
+}
+
+void FNetChannelLayer::NoteReliableReceived(uint16 Sequence)
+{
+    bAckPending = true;
+
+    if (!bHasRemoteReliable)
+    {
+        RemoteReliableSeq = Sequence;
+        RemoteReliableBits = 0;
+        bHasRemoteReliable = true;
+        return;
+    }
+
+    const int32 Ahead = SeqDiff(Sequence, RemoteReliableSeq);
+    if (Ahead > 0)
+    {
+        // The previous newest becomes bit Ahead - 1
+        const uint64 Shifted = Ahead > 32 ? 0 : ((static_cast<uint64>(RemoteReliableBits) << 1) | 1) << (Ahead - 1);
+        RemoteReliableBits = static_cast<uint32>(Shifted);
+        RemoteReliableSeq = Sequence;
+    }
+    else if (Ahead < 0 && Ahead >= -32)
+    {
+        RemoteReliableBits |= 1u << (-Ahead - 1);
+    }
+}
+
+void FNetChannelLayer::ReceiveReliable(uint16 Sequence, uint8 Index, uint8 Count, TArrayView<const uint8> Payload, FDeliverFunc Deliver)
+{
+    // Ack even duplicates: the peer resent because our ack was lost
+    NoteReliableReceived(Sequence);
+
+    const int32 Ahead = SeqDiff(Sequence, NextExpectedReliable);
+    if (Ahead < 0 || Ahead >= ReliableWindow)
+    {
+        return;
+    }
+
+    FReceivedFragment& Fragment = ReceiveWindow[Sequence % ReliableWindow];
+    if (Fragment.bReceived)
+    {
+        return;
+    }
+    Fragment.Payload.Reset();
+    Fragment.Payload.Append(Payload.GetData(), Payload.Num());
+    Fragment.Index = Index;
+    Fragment.Count = Count;
+    Fragment.bReceived = true;
+
+    // Drain everything contiguous, completing messages as their last fragment lands
+    while (true)
+    {
+        FReceivedFragment& Next = ReceiveWindow[NextExpectedReliable % ReliableWindow];
+        if (!Next.bReceived)
+        {
+            break;
+        }
+
+        if (Next.Index == 0)
+        {
+            ReliableAssembly.Reset();
+        }
+        ReliableAssembly.Append(Next.Payload);
+
+        if (Next.Index + 1 == Next.Count)
+        {
+            Deliver(ReliableAssembly);
+        }
+
+        Next.bReceived = false;
+        ++NextExpectedReliable;
+    }
+}
+
+void FNetChannelLayer::ReceiveSequenced(uint16 Sequence, uint8 Index, uint8 Count, TArrayView<const uint8> Payload, FDeliverFunc Deliver)
+{
+    const uint16 Base = static_cast<uint16>(Sequence - Index);
+    if (bHasSequenced && SeqDiff(Base, LastSequencedBase) <= 0)
+    {
+        return;
+    }
+
+    if (Count == 1)
+    {
+        bHasSequenced = true;
+        LastSequencedBase = Base;
+        Deliver(Payload);
+        return;
+    }
+
+    if (!bHasPartial || Base != PartialBase)
+    {
+        if (bHasPartial)
+        {
+            // A fragment of something older than the partial can never be delivered now
+            if (SeqDiff(Base, PartialBase) < 0)
+            {
+                return;
+            }
+            ++AbandonedCount;
+        }
+
+        bHasPartial = true;
+        PartialBase = Base;
+        PartialReceived = 0;
+        PartialFragments.SetNum(Count, false);
+        for (FReceivedFragment& Fragment : PartialFragments)
+        {
+            Fragment.bReceived = false;
+        }
+    }
+
+    if (Count != PartialFragments.Num() || PartialFragments[Index].bReceived)
+    {
+        return;
+    }
+
+    FReceivedFragment& Fragment = PartialFragments[Index];
+    Fragment.Payload.Reset();
+    Fragment.Payload.Append(Payload.GetData(), Payload.Num());
+    Fragment.bReceived = true;
+
+    if (++PartialReceived < Count)
+    {
+        return;
+    }
+
+    SequencedAssembly.Reset();
+    for (const FReceivedFragment& Part : PartialFragments)
+    {
+        SequencedAssembly.Append(Part.Payload);
+    }
+
+    bHasSequenced = true;
+    LastSequencedBase = Base;
+    bHasPartial = false;
+    Deliver(SequencedAssembly);
+}
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetStats.h"
+
+/** How a message sent through FNetChannelLayer is delivered */
+enum class ENetDelivery : uint8
+{
+    /** Newest wins: late or partial messages are dropped (snapshots, positions) */
+    UnreliableSequenced = 0,
+
+    /** Every message arrives exactly once, in send order (events, large tile updates) */
+    ReliableOrdered = 1,
+};
+
+/**
+ * Message channels, fragmentation and selective acks on top of raw datagrams.
+ *
+ * Channel datagrams are told apart from the legacy raw packets by their first byte
+ * (FrameMarker, well above every EPacketType), so both can share one socket:
+ *
+ *   u8  marker (0xC0)
+ *   u8  flags: low nibble delivery (0 sequenced, 1 reliable, 15 ack only), 0x80 ack fields valid
+ *   u16 sequence       per delivery mode, one per fragment
+ *   u8  fragment index
+ *   u8  fragment count  (1 = unfragmented)
+ *   u16 ack            newest reliable sequence received from the peer
+ *   u32 ack bits       bit N set: ack - 1 - N was received too
+ *   ... fragment payload
+ *
+ * A message is split into up to 255 fragments with consecutive sequence numbers.
+ * Reliable fragments are kept until acked (and resent after a timeout derived
+ * from the smoothed RTT); at most ReliableWindow are in flight so every one of
+ * them is covered by the 32 ack bits. Acks ride on every outgoing datagram, with
+ * an ack-only datagram from Update() when nothing else went out.
+ *
+ * The receiving side delivers reliable messages in order once all their fragments
+ * arrived. Sequenced messages only ever move forward: fragments of a message
+ * older than the newest delivered one are dropped, and a partial message is
+ * abandoned as soon as a newer one starts arriving. Game thread only.
+ */
+class TOWERGAME_API FNetChannelLayer
+{
+public:
+    static constexpr uint8 FrameMarker = 0xC0;
+    static constexpr int32 HeaderSize = 12;
+    static constexpr int32 MaxFragments = 255;
+    static constexpr int32 ReliableWindow = 32;
+
+    /** Called with every datagram to put on the wire, and the stats channel it counts against */
+    using FEmitFunc = TFunctionRef<void(TArrayView<const uint8> Datagram, ETowerNetChannel Channel)>;
+
+    /** Called with every completed message; the view is only valid during the call */
+    using FDeliverFunc = TFunctionRef<void(TArrayView<const uint8> Message)>;
+
+    explicit FNetChannelLayer(int32 InMaxDatagramSize = 1200);
+
+    static bool IsChannelFrame(TArrayView<const uint8> Datagram)
+    {
+        return Datagram.Num() >= HeaderSize && Datagram[0] == FrameMarker;
+    }
+
+    void Reset();
+
+    /** Largest message Send() accepts */
+    int32 GetMaxMessageSize() const { return MaxFragments * GetFragmentPayloadSize(); }
+
+    /**
+     * Fragment and send one message. Reliable fragments beyond the window wait in a
+     * queue and go out from Update() as acks free it up. False if the message is too big.
+     */
+    bool Send(ENetDelivery Delivery, TArrayView<const uint8> Message, ETowerNetChannel Channel, double Now, FEmitFunc Emit);
+
+    /** Handle one channel datagram (IsChannelFrame) */
+    void Receive(TArrayView<const uint8> Datagram, double Now, FDeliverFunc Deliver);
+
+    /** Resend timed-out reliable fragments, fill the window from the queue and flush a pending ack */
+    void Update(double Now, FEmitFunc Emit);
+
+    // ============ Stats ============
+
+    int32 GetReliableInFlight() const { return ReliableInFlight; }
+    int32 GetReliableQueued() const { return PendingReliable.Num(); }
+    int32 GetResentCount() const { return ResentCount; }
+
+    /** Sequenced messages dropped incomplete because a newer one overtook them */
+    int32 GetAbandonedCount() const { return AbandonedCount; }
+
+    /** Smoothed RTT from reliable acks (s, 0 until the first sample) */
+    double GetSmoothedRTT() const { return SmoothedRTT; }
+
+private:
+    struct FReliableSlot
+    {
+        TArray<uint8> Datagram;
+        ETowerNetChannel Channel = ETowerNetChannel::Unknown;
+        double FirstSent = 0.0;
+        double LastSent = 0.0;
+        int32 Sends = 0;
+        uint16 Sequence = 0;
+        bool bInUse = false;
+    };
+
+    struct FPendingFragment
+    {
+        TArray<uint8> Datagram;
+        ETowerNetChannel Channel = ETowerNetChannel::Unknown;
+    };
+
+    struct FReceivedFragment
+    {
+        TArray<uint8> Payload;
+        uint8 Index = 0;
+        uint8 Count = 0;
+        bool bReceived = false;
+    };
+
+    int32 GetFragmentPayloadSize() const { return MaxDatagramSize - HeaderSize; }
+
+    void WriteHeader(uint8* Dest, uint8 Mode, uint16 Sequence, uint8 FragmentIndex, uint8 FragmentCount);
+    void StampAck(uint8* Datagram);
+    void TransmitReliable(FReliableSlot& Slot, double Now, FEmitFunc Emit);
+    void FillReliableWindow(double Now, FEmitFunc Emit);
+    void ProcessAcks(uint16 Ack, uint32 AckBits, double Now);
+    void NoteReliableReceived(uint16 Sequence);
+    void ReceiveReliable(uint16 Sequence, uint8 Index, uint8 Count, TArrayView<const uint8> Payload, FDeliverFunc Deliver);
+    void ReceiveSequenced(uint16 Sequence, uint8 Index, uint8 Count, TArrayView<const uint8> Payload, FDeliverFunc Deliver);
+    double GetResendTimeout() const;
+
+    int32 MaxDatagramSize;
+
+    // Sending
+    uint16 NextSequencedSeq = 0;
+    uint16 NextReliableSeq = 0;
+    FReliableSlot SendWindow[ReliableWindow];
+    int32 ReliableInFlight = 0;
+    TArray<FPendingFragment> PendingReliable;
+    TArray<uint8> SendScratch;
+
+    // Acks owed to the peer
+    uint16 RemoteReliableSeq = 0;
+    uint32 RemoteReliableBits = 0;
+    bool bHasRemoteReliable = false;
+    bool bAckPending = false;
+
+    // Reliable receive
+    uint16 NextExpectedReliable = 0;
+    FReceivedFragment ReceiveWindow[ReliableWindow];
+    TArray<uint8> ReliableAssembly;
+
+    // Sequenced receive
+    bool bHasSequenced = false;
+    uint16 LastSequencedBase = 0;
+    bool bHasPartial = false;
+    uint16 PartialBase = 0;
+    int32 PartialReceived = 0;
+    TArray<FReceivedFragment> PartialFragments;
+    TArray<uint8> SequencedAssembly;
+
+    double SmoothedRTT = 0.0;
+    double RTTVariance = 0.0;
+
+    int32 ResentCount = 0;
+    int32 AbandonedCount = 0;
+};
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetClock.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    TAutoConsoleVariable<float> CVarNetTickRate(
+        TEXT("tower.Net.TickRate"),
+        20.0f,
+        TEXT("Network steps per second; match the game server's tick_rate"),
+        ECVF_Default);
+
+    TAutoConsoleVariable<int32> CVarNetMaxCatchUpSteps(
+        TEXT("tower.Net.MaxCatchUpSteps"),
+        3,
+        TEXT("Most network steps one frame runs to catch up; the rest of a long frame is dropped"),
+        ECVF_Default);
+}
+
+FTowerNetClock::FTowerNetClock()
+{
+    TickRate = FMath::Max(CVarNetTickRate.GetValueOnGameThread(), 1.0f);
+}
+
+TStatId FTowerNetClock::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FTowerNetClock, STATGROUP_Tickables);
+}
+
+void FTowerNetClock::Advance(float DeltaTime)
+{
+    TickRate = FMath::Max(CVarNetTickRate.GetValueOnGameThread(), 1.0f);
+    const float StepSeconds = 1.0f / TickRate;
+    const int32 MaxSteps = FMath::Max(CVarNetMaxCatchUpSteps.GetValueOnGameThread(), 1);
+
+    Accumulator += FMath::Max(DeltaTime, 0.0f);
+
+    int32 Steps = 0;
+    while (Accumulator >= StepSeconds && Steps < MaxSteps)
+    {
+        Accumulator -= StepSeconds;
+        RunStep(StepSeconds);
+        ++Steps;
+    }
+
+    if (Accumulator >= StepSeconds)
+    {
+        // Don't owe the server a burst of stale steps after a hitch
+        const uint64 Dropped = static_cast<uint64>(Accumulator / StepSeconds);
+        DroppedSteps += Dropped;
+        Accumulator -= Dropped * StepSeconds;
+        UE_LOG(LogTemp, Verbose, TEXT("NetClock: dropped %llu step(s) after a %.0fms frame"),
+            Dropped, DeltaTime * 1000.0f);
+    }
+}
+
+void FTowerNetClock::RunStep(float StepSeconds)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNetClock_Step);
+
+    ++StepCount;
+    for (FOnNetStep& Phase : Phases)
+    {
+        Phase.Broadcast(StepSeconds);
+    }
+}
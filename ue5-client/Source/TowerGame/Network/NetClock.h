@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+
+/** The fixed order one network step runs in */
+enum class ETowerNetPhase : uint8
+{
+    /** Drain sockets and decode what arrived */
+    Receive,
+
+    /** Apply decoded state to the world: actors, registry, counters */
+    Apply,
+
+    /** Queue and flush outgoing traffic: requests, inputs, keepalives */
+    Send,
+
+    Num
+};
+
+/**
+ * The client's network clock. Everything that talks to a game server steps on
+ * it instead of on actor Tick, timers and private accumulators, so it runs at
+ * the server tick rate whatever the frame rate is, and in the same order every
+ * step: every Receive, then every Apply, then every Send.
+ *
+ * A frame runs as many whole steps as its delta covers, up to MaxCatchUpSteps;
+ * past that (a hitch, a breakpoint) the missed steps are dropped rather than
+ * replayed in a burst. Per-frame work such as interpolation stays on Tick and
+ * can read GetAlpha for where the frame lies between steps.
+ *
+ * Ticks with or without a world (headless bot runs too) and while paused.
+ * Owned by UTowerNetworkSubsystem; participants bind OnStep and remove their
+ * handle when they go away.
+ */
+class TOWERGAME_API FTowerNetClock : public FTickableGameObject
+{
+public:
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnNetStep, float /*StepSeconds*/);
+
+    FTowerNetClock();
+
+    FOnNetStep& OnStep(ETowerNetPhase Phase) { return Phases[static_cast<int32>(Phase)]; }
+
+    /** Run the steps DeltaTime covers; what FTickableGameObject::Tick does */
+    void Advance(float DeltaTime);
+
+    float GetTickRate() const { return TickRate; }
+    float GetStepSeconds() const { return 1.0f / TickRate; }
+
+    /** How far the frame is past the last step, in steps (0..1) */
+    float GetAlpha() const { return Accumulator * TickRate; }
+
+    uint64 GetStepCount() const { return StepCount; }
+    uint64 GetDroppedSteps() const { return DroppedSteps; }
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override { Advance(DeltaTime); }
+    virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Always; }
+    virtual bool IsTickableWhenPaused() const override { return true; }
+    virtual bool IsTickableInEditor() const override { return false; }
+    virtual TStatId GetStatId() const override;
+
+private:
+    void RunStep(float StepSeconds);
+
+    FOnNetStep Phases[static_cast<int32>(ETowerNetPhase::Num)];
+
+    /** Read from tower.Net.TickRate at the start of each frame */
+    float TickRate = 20.0f;
+
+    float Accumulator = 0.0f;
+    uint64 StepCount = 0;
+    uint64 DroppedSteps = 0;
+};
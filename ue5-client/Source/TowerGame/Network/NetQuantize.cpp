@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetQuantize.h"
+
+namespace
+{
+    constexpr uint32 RotationComponentBits = 10;
+    constexpr uint32 RotationComponentMax = (1u << RotationComponentBits) - 1;
+
+    // Components other than the largest lie within +-1/sqrt(2)
+    constexpr double RotationComponentRange = UE_DOUBLE_INV_SQRT_2;
+
+    FORCEINLINE uint16 QuantizeAxis(double Value, double Min, double Max)
+    {
+        const double Unit = FMath::Clamp((Value - Min) / (Max - Min), 0.0, 1.0);
+        return static_cast<uint16>(FMath::RoundToInt32(Unit * 65535.0));
+    }
+
+    FORCEINLINE double DequantizeAxis(uint16 Value, double Min, double Max)
+    {
+        return Min + (Max - Min) * (static_cast<double>(Value) / 65535.0);
+    }
+}
+
+void FNetQuantizeFrame::Quantize(const FVector& Position, uint16 (&Out)[3]) const
+{
+    if (!IsValid())
+    {
+        Out[0] = Out[1] = Out[2] = 0;
+        return;
+    }
+
+    Out[0] = QuantizeAxis(Position.X, Min.X, Max.X);
+    Out[1] = QuantizeAxis(Position.Y, Min.Y, Max.Y);
+    Out[2] = QuantizeAxis(Position.Z, Min.Z, Max.Z);
+}
+
+FVector FNetQuantizeFrame::Dequantize(uint16 X, uint16 Y, uint16 Z) const
+{
+    return FVector(
+        DequantizeAxis(X, Min.X, Max.X),
+        DequantizeAxis(Y, Min.Y, Max.Y),
+        DequantizeAxis(Z, Min.Z, Max.Z));
+}
+
+uint32 NetQuantize::QuantizeRotation(const FQuat& Rotation)
+{
+    const FQuat Q = Rotation.GetNormalized();
+    const double Components[4] = { Q.X, Q.Y, Q.Z, Q.W };
+
+    uint32 Largest = 0;
+    for (uint32 Index = 1; Index < 4; ++Index)
+    {
+        if (FMath::Abs(Components[Index]) > FMath::Abs(Components[Largest]))
+        {
+            Largest = Index;
+        }
+    }
+
+    // q and -q are the same rotation; flip so the dropped component is positive
+    const double Sign = Components[Largest] < 0.0 ? -1.0 : 1.0;
+
+    uint32 Packed = Largest << (RotationComponentBits * 3);
+    uint32 Shift = RotationComponentBits * 2;
+    for (uint32 Index = 0; Index < 4; ++Index)
+    {
+        if (Index == Largest)
+        {
+            continue;
+        }
+
+        const double Unit = FMath::Clamp((Components[Index] * Sign / RotationComponentRange + 1.0) * 0.5, 0.0, 1.0);
+        Packed |= static_cast<uint32>(FMath::RoundToInt32(Unit * RotationComponentMax)) << Shift;
+        Shift -= RotationComponentBits;
+    }
+
+    return Packed;
+}
+
+FQuat NetQuantize::DequantizeRotation(uint32 Packed)
+{
+    const uint32 Largest = (Packed >> (RotationComponentBits * 3)) & 0x3;
+
+    double Components[4];
+    double SumSquares = 0.0;
+    uint32 Shift = RotationComponentBits * 2;
+    for (uint32 Index = 0; Index < 4; ++Index)
+    {
+        if (Index == Largest)
+        {
+            continue;
+        }
+
+        const double Unit = static_cast<double>((Packed >> Shift) & RotationComponentMax) / RotationComponentMax;
+        Components[Index] = (Unit * 2.0 - 1.0) * RotationComponentRange;
+        SumSquares += Components[Index] * Components[Index];
+        Shift -= RotationComponentBits;
+    }
+    Components[Largest] = FMath::Sqrt(FMath::Max(0.0, 1.0 - SumSquares));
+
+    FQuat Result(Components[0], Components[1], Components[2], Components[3]);
+    Result.Normalize();
+    return Result;
+}
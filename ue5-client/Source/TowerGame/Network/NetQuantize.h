@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Box positions are quantized against: the current floor's bounds, sent by
+ * the server once per floor.
+ *
+ * Each axis is cut into 65535 steps between Min and Max, so a 200 m floor
+ * resolves to about 3 mm. Positions outside the box clamp to its faces. The
+ * frame is in whatever space the caller quantizes in; network packets use
+ * Bevy meters and convert to UE5 after dequantizing, like the f32 fields.
+ * Mirrors bevy-server/src/quantize.rs.
+ */
+struct TOWERGAME_API FNetQuantizeFrame
+{
+    FVector Min = FVector::ZeroVector;
+    FVector Max = FVector::ZeroVector;
+
+    FNetQuantizeFrame() = default;
+    FNetQuantizeFrame(const FVector& InMin, const FVector& InMax) : Min(InMin), Max(InMax) {}
+
+    /** Every axis has some extent; a zero frame (no bounds received yet) is not */
+    bool IsValid() const { return Max.X > Min.X && Max.Y > Min.Y && Max.Z > Min.Z; }
+
+    /** Distance between neighbouring values, per axis */
+    FVector GetStep() const { return (Max - Min) / 65535.0; }
+
+    void Quantize(const FVector& Position, uint16 (&Out)[3]) const;
+    FVector Dequantize(uint16 X, uint16 Y, uint16 Z) const;
+};
+
+/**
+ * Fixed-point encodings shared by the bincode and protobuf entity paths and
+ * the match JSON. Full-turn angles use 65536 steps (~0.0055 degrees), so yaw
+ * wraps for free in a u16.
+ */
+namespace NetQuantize
+{
+    constexpr float AngleStep = 360.0f / 65536.0f;
+
+    inline uint16 QuantizeYaw(float Degrees)
+    {
+        return static_cast<uint16>(FMath::RoundToInt32(Degrees / AngleStep) & 0xFFFF);
+    }
+
+    /** [0, 360) */
+    inline float DequantizeYaw(uint16 Value) { return static_cast<float>(Value) * AngleStep; }
+
+    /** Pitch in [-180, 180) as a signed step count */
+    inline int16 QuantizePitch(float Degrees)
+    {
+        return static_cast<int16>(static_cast<uint16>(FMath::RoundToInt32(FRotator::NormalizeAxis(Degrees) / AngleStep) & 0xFFFF));
+    }
+
+    inline float DequantizePitch(int16 Value) { return static_cast<float>(Value) * AngleStep; }
+
+    /** Value / Max in 1/255 steps; 0 when Max is not positive */
+    inline uint8 QuantizeFraction8(float Value, float Max)
+    {
+        return Max > 0.0f ? static_cast<uint8>(FMath::RoundToInt32(FMath::Clamp(Value / Max, 0.0f, 1.0f) * 255.0f)) : 0;
+    }
+
+    inline float DequantizeFraction8(uint8 Value) { return static_cast<float>(Value) / 255.0f; }
+
+    /**
+     * Smallest-three quaternion in 32 bits: the index of the largest component
+     * in the top two bits, the other three in 10 bits each over
+     * [-1/sqrt(2), 1/sqrt(2)]. The largest is rebuilt from unit length; its
+     * sign is forced positive, which is the same rotation.
+     */
+    TOWERGAME_API uint32 QuantizeRotation(const FQuat& Rotation);
+    TOWERGAME_API FQuat DequantizeRotation(uint32 Packed);
+
+    /** Three 16-bit position steps in one integer (x | y << 16 | z << 32), for a protobuf varint */
+    inline uint64 PackPosition(const uint16 (&Steps)[3])
+    {
+        return static_cast<uint64>(Steps[0]) | (static_cast<uint64>(Steps[1]) << 16) | (static_cast<uint64>(Steps[2]) << 32);
+    }
+
+    inline FVector UnpackPosition(const FNetQuantizeFrame& Frame, uint64 Packed)
+    {
+        return Frame.Dequantize(static_cast<uint16>(Packed), static_cast<uint16>(Packed >> 16), static_cast<uint16>(Packed >> 32));
+    }
+}
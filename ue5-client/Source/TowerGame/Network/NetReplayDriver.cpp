@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetReplayDriver.h"
+#include "ReplicationManager.h"
+#include "MatchConnection.h"
+#include "StateSynchronizer.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+FNetReplayDriver::FNetReplayDriver(UWorld* InWorld, UMatchConnection* InMatch)
+    : World(InWorld)
+    , Match(InMatch)
+{
+}
+
+FNetReplayDriver::~FNetReplayDriver()
+{
+    if (UTowerStateSynchronizer* Sync = Synchronizer.Get())
+    {
+        Sync->StopSync();
+        Sync->DestroyComponent();
+    }
+
+    // Leave nothing behind so the next replay starts from the same empty world state
+    if (AReplicationManager* Manager = Replication.Get())
+    {
+        Manager->DestroyReplicatedActors();
+        Manager->Destroy();
+    }
+}
+
+bool FNetReplayDriver::Open(const FString& Path)
+{
+    CapturePath = Path;
+    return Reader.Open(Path);
+}
+
+void FNetReplayDriver::Start(float InSpeed)
+{
+    Speed = InSpeed;
+    Reader.Rewind();
+    bHasPending = false;
+    bFinished = false;
+    FeedSeconds = 0.0;
+    for (FChannelTiming& Timing : Timings)
+    {
+        Timing = FChannelTiming();
+    }
+
+    UWorld* TargetWorld = World.Get();
+    if (TargetWorld && !Replication.IsValid())
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = MakeUniqueObjectName(TargetWorld, AReplicationManager::StaticClass(), TEXT("ReplayReplicationManager"));
+        AReplicationManager* Manager = TargetWorld->SpawnActor<AReplicationManager>(SpawnParams);
+        Replication = Manager;
+
+        if (Manager)
+        {
+            UTowerStateSynchronizer* Sync = NewObject<UTowerStateSynchronizer>(Manager, TEXT("ReplaySynchronizer"));
+            Sync->RegisterComponent();
+            Sync->BeginSync();
+            Synchronizer = Sync;
+        }
+    }
+
+    StartSeconds = FPlatformTime::Seconds();
+
+    UE_LOG(LogTemp, Log, TEXT("NetReplay: replaying %s at %s"), *CapturePath,
+        Speed > 0.0f ? *FString::Printf(TEXT("%.2fx"), Speed) : TEXT("max speed"));
+}
+
+bool FNetReplayDriver::Tick()
+{
+    if (bFinished)
+    {
+        return false;
+    }
+
+    const double CaptureNow = (FPlatformTime::Seconds() - StartSeconds) * Speed;
+
+    while (true)
+    {
+        if (!bHasPending)
+        {
+            if (!Reader.Next(Pending))
+            {
+                bFinished = true;
+                return false;
+            }
+            bHasPending = true;
+        }
+
+        if (Speed > 0.0f && Pending.Time > CaptureNow)
+        {
+            return true;
+        }
+
+        Feed(Pending);
+        bHasPending = false;
+    }
+}
+
+void FNetReplayDriver::Feed(const FNetCaptureRecord& Record)
+{
+    ETowerNetChannel Channel = ETowerNetChannel::Unknown;
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    if (Record.Source == ENetCaptureSource::Netcode)
+    {
+        AReplicationManager* Manager = Replication.Get();
+        if (!Manager || Record.Data.Num() == 0)
+        {
+            return;
+        }
+        Channel = Manager->ProcessPacket(Record.Data);
+    }
+    else if (Record.Source == ENetCaptureSource::Match)
+    {
+        UMatchConnection* Connection = Match.Get();
+        if (!Connection)
+        {
+            return;
+        }
+        const EMatchOpCode OpCode = static_cast<EMatchOpCode>(Record.Tag);
+        Connection->InjectMatchPayload(OpCode, Record.Data);
+        Channel = UMatchConnection::GetStatsChannel(OpCode);
+    }
+    else
+    {
+        return;
+    }
+
+    const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+
+    FChannelTiming& Timing = Timings[static_cast<int32>(Channel)];
+    ++Timing.Packets;
+    Timing.Bytes += Record.Data.Num();
+    Timing.Cycles += Cycles;
+    Timing.Histogram.Record(FPlatformTime::ToMilliseconds64(Cycles));
+
+    FeedSeconds += FPlatformTime::ToSeconds64(Cycles);
+}
+
+void FNetReplayDriver::LogReport(FOutputDevice& Ar) const
+{
+    Ar.Logf(TEXT("NetReplay: %s, %d records%s, %.3f s wall, %.3f ms decode+apply"),
+        *CapturePath, Reader.GetRecordsRead(), Reader.IsTruncated() ? TEXT(" (truncated)") : TEXT(""),
+        FPlatformTime::Seconds() - StartSeconds, FeedSeconds * 1000.0);
+
+    Ar.Logf(TEXT("  %-18s %8s %10s %9s %9s %9s %9s"),
+        TEXT("type"), TEXT("count"), TEXT("bytes"), TEXT("mean us"), TEXT("p50 us"), TEXT("p99 us"), TEXT("max us"));
+
+    const UEnum* ChannelEnum = StaticEnum<ETowerNetChannel>();
+    for (int32 i = 0; i < UE_ARRAY_COUNT(Timings); ++i)
+    {
+        const FChannelTiming& Timing = Timings[i];
+        if (Timing.Packets == 0)
+        {
+            continue;
+        }
+
+        const double MeanMicros = FPlatformTime::ToSeconds64(Timing.Cycles) * 1e6 / Timing.Packets;
+        Ar.Logf(TEXT("  %-18s %8d %10lld %9.2f %9.1f %9.1f %9.1f"),
+            *ChannelEnum->GetDisplayNameTextByValue(i).ToString(),
+            Timing.Packets, Timing.Bytes, MeanMicros,
+            Timing.Histogram.GetPercentile(50.0) * 1000.0,
+            Timing.Histogram.GetPercentile(99.0) * 1000.0,
+            Timing.Histogram.GetMaxMs() * 1000.0);
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetCapture.h"
+#include "NetStats.h"
+#include "LatencyHistogram.h"
+
+class AReplicationManager;
+class UMatchConnection;
+class UTowerStateSynchronizer;
+
+/**
+ * Feeds a capture back through the client's decode paths.
+ *
+ * Datagrams go through AReplicationManager::ProcessPacket on a replication
+ * manager spawned for the replay, match payloads through
+ * UMatchConnection::InjectMatchPayload, which reaches every listening
+ * UTowerStateSynchronizer (one is created and started on the replay actor so
+ * a headless run has a consumer). Each packet's decode + apply time is
+ * recorded per message type.
+ *
+ * Run with 'tower.NetReplay <file> [speed|max] [quit]', headless with -nullrhi.
+ */
+class TOWERGAME_API FNetReplayDriver
+{
+public:
+    FNetReplayDriver(UWorld* InWorld, UMatchConnection* InMatch);
+    ~FNetReplayDriver();
+
+    bool Open(const FString& Path);
+
+    /** Speed 1 = recorded timing, 2 = twice as fast; <= 0 feeds everything as fast as possible */
+    void Start(float InSpeed);
+
+    /** Feed every record that is due; false once the capture is exhausted */
+    bool Tick();
+
+    bool IsFinished() const { return bFinished; }
+
+    void LogReport(FOutputDevice& Ar) const;
+
+private:
+    struct FChannelTiming
+    {
+        int32 Packets = 0;
+        int64 Bytes = 0;
+        uint64 Cycles = 0;
+        FLatencyHistogram Histogram;
+    };
+
+    void Feed(const FNetCaptureRecord& Record);
+
+    TWeakObjectPtr<UWorld> World;
+    TWeakObjectPtr<UMatchConnection> Match;
+    TWeakObjectPtr<AReplicationManager> Replication;
+    TWeakObjectPtr<UTowerStateSynchronizer> Synchronizer;
+
+    FNetCaptureReader Reader;
+    FNetCaptureRecord Pending;
+    bool bHasPending = false;
+    bool bFinished = false;
+
+    FString CapturePath;
+    float Speed = 1.0f;
+    double StartSeconds = 0.0;
+    double FeedSeconds = 0.0;
+
+    FChannelTiming Timings[static_cast<int32>(ETowerNetChannel::MAX)];
+};
@@ -0,0 +1,278 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetStats.h"
+#include "HAL/PlatformTime.h"
+#include "Trace/Trace.inl"
+
+// Per-message metadata for Insights, off by default: -trace=default,TowerNet or 'Trace.Enable TowerNet'.
+// Every message recorded below is logged, so the events add up to the collector's counters.
+UE_TRACE_CHANNEL_DEFINE(TowerNetChannel);
+
+UE_TRACE_EVENT_BEGIN(TowerNet, Packet)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint64, DecodeCycles)
+    UE_TRACE_EVENT_FIELD(int32, Bytes)
+    UE_TRACE_EVENT_FIELD(uint8, Channel)        // ETowerNetChannel
+    UE_TRACE_EVENT_FIELD(bool, Outgoing)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TowerNet, Snapshot)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint64, ServerTick)
+    UE_TRACE_EVENT_FIELD(double, ServerTime)
+    UE_TRACE_EVENT_FIELD(double, ArrivalTime)
+    UE_TRACE_EVENT_FIELD(int32, BufferDepth)
+UE_TRACE_EVENT_END()
+
+// ============================================================================
+// FNetSequenceTracker
+// ============================================================================
+
+void FNetSequenceTracker::Reset()
+{
+    *this = FNetSequenceTracker();
+}
+
+void FNetSequenceTracker::Note(uint64 Sequence)
+{
+    if (!bHasSequence)
+    {
+        Highest = Sequence;
+        WindowMask = 1;
+        bHasSequence = true;
+        ++Received;
+        return;
+    }
+
+    if (Sequence > Highest)
+    {
+        const uint64 Step = Sequence - Highest;
+        if (Stride == 0 || Step < Stride)
+        {
+            // Learned (or refined) the stride; earlier gaps were measured too coarsely, which is fine
+            Stride = Step;
+        }
+
+        const uint64 Strides = Step / Stride;
+        if (Strides > MaxGapStrides)
+        {
+            // Server restart or tick wrap: start a fresh window
+            WindowMask = 0;
+        }
+        else
+        {
+            Lost += static_cast<int32>(Strides - 1);
+            WindowMask = Strides >= 64 ? 0 : WindowMask << Strides;
+        }
+
+        WindowMask |= 1;
+        Highest = Sequence;
+        ++Received;
+        return;
+    }
+
+    const uint64 Age = Stride > 0 ? (Highest - Sequence) / Stride : 0;
+    if (Sequence == Highest || (Age < 64 && (WindowMask & (1ull << Age)) != 0))
+    {
+        ++Duplicates;
+        return;
+    }
+
+    // Arrived after something newer: it was counted lost when the gap opened
+    if (Age < 64)
+    {
+        WindowMask |= 1ull << Age;
+    }
+    ++Reordered;
+    ++Received;
+    Lost = FMath::Max(0, Lost - 1);
+}
+
+float FNetSequenceTracker::GetLossPercent() const
+{
+    const int32 Expected = Received + Lost;
+    return Expected > 0 ? 100.0f * Lost / Expected : 0.0f;
+}
+
+float FNetSequenceTracker::GetReorderPercent() const
+{
+    return Received > 0 ? 100.0f * Reordered / Received : 0.0f;
+}
+
+// ============================================================================
+// FNetJitterEstimator
+// ============================================================================
+
+void FNetJitterEstimator::Reset()
+{
+    *this = FNetJitterEstimator();
+}
+
+void FNetJitterEstimator::Note(double SendSeconds, double ArrivalSeconds)
+{
+    // Clocks need not be synchronized: only the change in transit time matters
+    const double Transit = ArrivalSeconds - SendSeconds;
+    if (bHasTransit)
+    {
+        const double D = FMath::Abs(Transit - LastTransit);
+        Jitter += (D - Jitter) / 16.0;
+    }
+    LastTransit = Transit;
+    bHasTransit = true;
+}
+
+// ============================================================================
+// FTowerNetStatsCollector
+// ============================================================================
+
+FTowerNetStatsCollector::FTowerNetStatsCollector()
+{
+    Reset();
+}
+
+void FTowerNetStatsCollector::Reset()
+{
+    for (int32 i = 0; i < NumChannels; ++i)
+    {
+        Windows[i] = FWindow();
+        Published[i] = FNetChannelStats();
+        Published[i].Channel = static_cast<ETowerNetChannel>(i);
+    }
+
+    WindowStart = FPlatformTime::Seconds();
+    BytesInPerSec = 0.0f;
+    BytesOutPerSec = 0.0f;
+    SnapshotSequence.Reset();
+    SnapshotJitter.Reset();
+    SnapshotBufferDepth = 0;
+    SnapshotBufferCapacity = 0;
+}
+
+void FTowerNetStatsCollector::RecordIncoming(ETowerNetChannel Channel, int32 Bytes, uint64 DecodeCycles)
+{
+    UE_TRACE_LOG(TowerNet, Packet, TowerNetChannel)
+        << Packet.Cycle(FPlatformTime::Cycles64())
+        << Packet.DecodeCycles(DecodeCycles)
+        << Packet.Bytes(Bytes)
+        << Packet.Channel(static_cast<uint8>(Channel))
+        << Packet.Outgoing(false);
+
+    const int32 Index = static_cast<int32>(Channel);
+    FWindow& Window = Windows[Index];
+    ++Window.PacketsIn;
+    Window.BytesIn += Bytes;
+    ++Published[Index].TotalPacketsIn;
+    Published[Index].TotalBytesIn += Bytes;
+
+    if (DecodeCycles > 0)
+    {
+        ++Window.DecodeSamples;
+        Window.DecodeCycles += DecodeCycles;
+        Window.MaxDecodeCycles = FMath::Max(Window.MaxDecodeCycles, DecodeCycles);
+    }
+}
+
+void FTowerNetStatsCollector::RecordOutgoing(ETowerNetChannel Channel, int32 Bytes)
+{
+    UE_TRACE_LOG(TowerNet, Packet, TowerNetChannel)
+        << Packet.Cycle(FPlatformTime::Cycles64())
+        << Packet.Bytes(Bytes)
+        << Packet.Channel(static_cast<uint8>(Channel))
+        << Packet.Outgoing(true);
+
+    const int32 Index = static_cast<int32>(Channel);
+    ++Windows[Index].PacketsOut;
+    Windows[Index].BytesOut += Bytes;
+    Published[Index].TotalBytesOut += Bytes;
+}
+
+void FTowerNetStatsCollector::RecordDecompressed(ETowerNetChannel Channel, int32 CompressedBytes, int32 RawBytes)
+{
+    FNetChannelStats& Stats = Published[static_cast<int32>(Channel)];
+    Stats.TotalCompressedBytesIn += CompressedBytes;
+    Stats.TotalRawBytesIn += RawBytes;
+    Stats.CompressionRatio = Stats.TotalRawBytesIn > 0
+        ? static_cast<float>(static_cast<double>(Stats.TotalCompressedBytesIn) / Stats.TotalRawBytesIn)
+        : 1.0f;
+}
+
+float FTowerNetStatsCollector::GetCompressionRatio() const
+{
+    int64 Compressed = 0;
+    int64 Raw = 0;
+    for (const FNetChannelStats& Stats : Published)
+    {
+        Compressed += Stats.TotalCompressedBytesIn;
+        Raw += Stats.TotalRawBytesIn;
+    }
+    return Raw > 0 ? static_cast<float>(static_cast<double>(Compressed) / Raw) : 1.0f;
+}
+
+void FTowerNetStatsCollector::RecordSnapshot(uint64 ServerTick, double ServerTime, double ArrivalTime, int32 BufferDepth, int32 BufferCapacity)
+{
+    UE_TRACE_LOG(TowerNet, Snapshot, TowerNetChannel)
+        << Snapshot.Cycle(FPlatformTime::Cycles64())
+        << Snapshot.ServerTick(ServerTick)
+        << Snapshot.ServerTime(ServerTime)
+        << Snapshot.ArrivalTime(ArrivalTime)
+        << Snapshot.BufferDepth(BufferDepth);
+
+    SnapshotSequence.Note(ServerTick);
+    SnapshotJitter.Note(ServerTime, ArrivalTime);
+    SnapshotBufferDepth = BufferDepth;
+    SnapshotBufferCapacity = BufferCapacity;
+}
+
+void FTowerNetStatsCollector::RollWindow(double Now)
+{
+    const double Elapsed = Now - WindowStart;
+    if (Elapsed <= 0.0)
+    {
+        return;
+    }
+
+    const float InvElapsed = static_cast<float>(1.0 / Elapsed);
+    const double MicrosPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1e6;
+
+    BytesInPerSec = 0.0f;
+    BytesOutPerSec = 0.0f;
+
+    for (int32 i = 0; i < NumChannels; ++i)
+    {
+        const FWindow& Window = Windows[i];
+        FNetChannelStats& Stats = Published[i];
+
+        Stats.PacketsInPerSec = Window.PacketsIn * InvElapsed;
+        Stats.PacketsOutPerSec = Window.PacketsOut * InvElapsed;
+        Stats.BytesInPerSec = Window.BytesIn * InvElapsed;
+        Stats.BytesOutPerSec = Window.BytesOut * InvElapsed;
+        Stats.AvgDecodeMicros = Window.DecodeSamples > 0
+            ? static_cast<float>(Window.DecodeCycles * MicrosPerCycle / Window.DecodeSamples)
+            : 0.0f;
+        Stats.MaxDecodeMicros = static_cast<float>(Window.MaxDecodeCycles * MicrosPerCycle);
+
+        BytesInPerSec += Stats.BytesInPerSec;
+        BytesOutPerSec += Stats.BytesOutPerSec;
+
+        Windows[i] = FWindow();
+    }
+
+    WindowStart = Now;
+}
+
+void FTowerNetStatsCollector::GetActiveChannels(TArray<FNetChannelStats>& Out) const
+{
+    Out.Reset();
+    for (const FNetChannelStats& Stats : Published)
+    {
+        if (Stats.TotalBytesIn > 0 || Stats.TotalBytesOut > 0)
+        {
+            Out.Add(Stats);
+        }
+    }
+
+    Out.Sort([](const FNetChannelStats& A, const FNetChannelStats& B)
+    {
+        return A.BytesInPerSec + A.BytesOutPerSec > B.BytesInPerSec + B.BytesOutPerSec;
+    });
+}
@@ -0,0 +1,206 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NetStats.generated.h"
+
+/**
+ * Message types tracked by FTowerNetStatsCollector.
+ * The netcode entries mirror AReplicationManager::EPacketType and the client -> server
+ * datagram types; match traffic is split into snapshots and everything else.
+ */
+UENUM(BlueprintType)
+enum class ETowerNetChannel : uint8
+{
+    Keepalive       UMETA(DisplayName = "Keepalive"),
+    PlayerUpdate    UMETA(DisplayName = "Player Update"),
+    MonsterUpdate   UMETA(DisplayName = "Monster Update"),
+    FloorTileUpdate UMETA(DisplayName = "Floor Tile Update"),
+    PlayerSpawn     UMETA(DisplayName = "Player Spawn"),
+    PlayerDespawn   UMETA(DisplayName = "Player Despawn"),
+    Action          UMETA(DisplayName = "Action"),          // 0x10, client -> server
+    Interest        UMETA(DisplayName = "Interest"),        // 0x11, client -> server
+    WorldSnapshot   UMETA(DisplayName = "World Snapshot"),  // match op 13
+    Lockstep        UMETA(DisplayName = "Lockstep"),        // match op 15
+    MatchData       UMETA(DisplayName = "Match Data"),      // every other match op
+    ServiceCall     UMETA(DisplayName = "Service Call"),    // GRPCClientManager responses
+    Unknown         UMETA(DisplayName = "Unknown"),
+
+    MAX             UMETA(Hidden)
+};
+
+/** One message type over the last stats window */
+USTRUCT(BlueprintType)
+struct FNetChannelStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    ETowerNetChannel Channel = ETowerNetChannel::Unknown;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float PacketsInPerSec = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float PacketsOutPerSec = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float BytesInPerSec = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float BytesOutPerSec = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 TotalPacketsIn = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 TotalBytesIn = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 TotalBytesOut = 0;
+
+    /** Mean time spent decoding and applying one packet of this type (us) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float AvgDecodeMicros = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float MaxDecodeMicros = 0.0f;
+
+    /** Wire bytes of the compressed payloads on this channel and what they inflated to */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 TotalCompressedBytesIn = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 TotalRawBytesIn = 0;
+
+    /** TotalCompressedBytesIn / TotalRawBytesIn (1 = nothing compressed yet) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float CompressionRatio = 1.0f;
+};
+
+/**
+ * Loss and reordering from a stream of sequence numbers.
+ *
+ * Sequences may advance by a fixed stride (a server tick counter sampled every
+ * N ticks); the smallest positive step seen is taken as the stride, so only
+ * steps larger than that count as loss. A 64-entry window catches late and
+ * duplicate arrivals; a late arrival inside the window un-counts its loss.
+ */
+class TOWERGAME_API FNetSequenceTracker
+{
+public:
+    void Note(uint64 Sequence);
+    void Reset();
+
+    int32 GetReceived() const { return Received; }
+    int32 GetLost() const { return Lost; }
+    int32 GetReordered() const { return Reordered; }
+    int32 GetDuplicates() const { return Duplicates; }
+
+    float GetLossPercent() const;
+    float GetReorderPercent() const;
+
+private:
+    /** A jump this many strides ahead is treated as a restart, not loss */
+    static constexpr uint64 MaxGapStrides = 1024;
+
+    uint64 Highest = 0;
+    uint64 Stride = 0;
+    uint64 WindowMask = 0;   // bit N: Highest - N * Stride has arrived
+    bool bHasSequence = false;
+
+    int32 Received = 0;
+    int32 Lost = 0;
+    int32 Reordered = 0;
+    int32 Duplicates = 0;
+};
+
+/**
+ * RFC 3550 interarrival jitter: the smoothed mean deviation of the transit time
+ * (arrival - send) between consecutive packets.
+ */
+class TOWERGAME_API FNetJitterEstimator
+{
+public:
+    void Note(double SendSeconds, double ArrivalSeconds);
+    void Reset();
+
+    double GetJitterMs() const { return Jitter * 1000.0; }
+
+private:
+    double LastTransit = 0.0;
+    double Jitter = 0.0;
+    bool bHasTransit = false;
+};
+
+/**
+ * Per-message-type traffic counters for the game's network paths.
+ *
+ * Producers (replication, netcode sends, match connection, state sync) record
+ * into one collector owned by UTowerNetworkSubsystem. Counters accumulate into
+ * a window that RollWindow() turns into per-second rates. Game thread only.
+ */
+class TOWERGAME_API FTowerNetStatsCollector
+{
+public:
+    FTowerNetStatsCollector();
+
+    /** A packet was received and handled; DecodeCycles covers decode + apply (FPlatformTime::Cycles64) */
+    void RecordIncoming(ETowerNetChannel Channel, int32 Bytes, uint64 DecodeCycles = 0);
+
+    void RecordOutgoing(ETowerNetChannel Channel, int32 Bytes);
+
+    /** A compressed payload of CompressedBytes on the wire inflated to RawBytes */
+    void RecordDecompressed(ETowerNetChannel Channel, int32 CompressedBytes, int32 RawBytes);
+
+    /** A world snapshot arrived: its server tick / timestamp and the interpolation ring depth it found */
+    void RecordSnapshot(uint64 ServerTick, double ServerTime, double ArrivalTime, int32 BufferDepth, int32 BufferCapacity);
+
+    /** Close the current window and compute rates over it */
+    void RollWindow(double Now);
+
+    void Reset();
+
+    const FNetChannelStats& GetChannel(ETowerNetChannel Channel) const { return Published[static_cast<int32>(Channel)]; }
+
+    /** Channels that carried any traffic since the last Reset(), busiest (in + out) first */
+    void GetActiveChannels(TArray<FNetChannelStats>& Out) const;
+
+    const FNetSequenceTracker& GetSnapshotSequence() const { return SnapshotSequence; }
+    double GetSnapshotJitterMs() const { return SnapshotJitter.GetJitterMs(); }
+    int32 GetSnapshotBufferDepth() const { return SnapshotBufferDepth; }
+    int32 GetSnapshotBufferCapacity() const { return SnapshotBufferCapacity; }
+
+    float GetBytesInPerSec() const { return BytesInPerSec; }
+    float GetBytesOutPerSec() const { return BytesOutPerSec; }
+
+    /** Compressed / raw bytes over every channel since the last Reset() (1 = nothing compressed) */
+    float GetCompressionRatio() const;
+
+private:
+    static constexpr int32 NumChannels = static_cast<int32>(ETowerNetChannel::MAX);
+
+    struct FWindow
+    {
+        int32 PacketsIn = 0;
+        int32 PacketsOut = 0;
+        int64 BytesIn = 0;
+        int64 BytesOut = 0;
+        int32 DecodeSamples = 0;
+        uint64 DecodeCycles = 0;
+        uint64 MaxDecodeCycles = 0;
+    };
+
+    FWindow Windows[NumChannels];
+    FNetChannelStats Published[NumChannels];
+    double WindowStart = 0.0;
+
+    float BytesInPerSec = 0.0f;
+    float BytesOutPerSec = 0.0f;
+
+    FNetSequenceTracker SnapshotSequence;
+    FNetJitterEstimator SnapshotJitter;
+    int32 SnapshotBufferDepth = 0;
+    int32 SnapshotBufferCapacity = 0;
+};
@@ -0,0 +1,202 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "NetTimerWheel.h"
+
+FNetTimerWheel::FNetTimerWheel(double InTickSeconds)
+    : TickSeconds(FMath::Max(InTickSeconds, 0.001))
+{
+    for (int32& Head : Heads)
+    {
+        Head = INDEX_NONE;
+    }
+}
+
+FNetTimerHandle FNetTimerWheel::Add(double Now, double DelaySeconds, int64 Key)
+{
+    // Nothing to cascade, so catch up in one step rather than walking every tick since the last timer
+    if (NumActive == 0)
+    {
+        CurrentTick = FMath::Max(CurrentTick, ToTick(Now));
+    }
+
+    int32 NodeIndex = FreeHead;
+    if (NodeIndex != INDEX_NONE)
+    {
+        FreeHead = Nodes[NodeIndex].Next;
+    }
+    else
+    {
+        NodeIndex = Nodes.AddDefaulted();
+    }
+
+    FNode& Node = Nodes[NodeIndex];
+    Node.Key = Key;
+    // Rounded up so a timer never fires before its deadline
+    Node.ExpireTick = static_cast<int64>(FMath::CeilToDouble((Now + FMath::Max(DelaySeconds, 0.0)) / TickSeconds));
+    ++NumActive;
+
+    Schedule(NodeIndex);
+
+    FNetTimerHandle Handle;
+    Handle.Index = NodeIndex;
+    Handle.Generation = Node.Generation;
+    return Handle;
+}
+
+bool FNetTimerWheel::Cancel(FNetTimerHandle& Handle)
+{
+    const int32 NodeIndex = Handle.Index;
+    Handle.Invalidate();
+
+    if (!Nodes.IsValidIndex(NodeIndex))
+    {
+        return false;
+    }
+
+    const FNode& Node = Nodes[NodeIndex];
+    if (Node.Slot == INDEX_NONE || Node.Generation != Handle.Generation)
+    {
+        return false;
+    }
+
+    Release(NodeIndex);
+    return true;
+}
+
+void FNetTimerWheel::Advance(double Now, TFunctionRef<void(int64 Key)> OnExpired)
+{
+    const int64 TargetTick = ToTick(Now);
+
+    while (CurrentTick < TargetTick)
+    {
+        if (NumActive == 0)
+        {
+            CurrentTick = TargetTick;
+            break;
+        }
+
+        ++CurrentTick;
+
+        // Every 64 ticks the next level's slot comes into range, and so on up
+        const int32 Index = static_cast<int32>(CurrentTick & SlotMask);
+        if (Index == 0)
+        {
+            for (int32 Level = 1; Level < NumLevels; ++Level)
+            {
+                const int32 LevelIndex = static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask);
+                Cascade(Level, LevelIndex);
+                if (LevelIndex != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        // One node at a time: OnExpired may cancel others in this slot
+        while (Heads[Index] != INDEX_NONE)
+        {
+            const int32 NodeIndex = Heads[Index];
+            const int64 Key = Nodes[NodeIndex].Key;
+            Release(NodeIndex);
+            OnExpired(Key);
+        }
+    }
+}
+
+void FNetTimerWheel::Reset()
+{
+    // Released one by one rather than emptied, so generations keep climbing and old handles stay stale
+    for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+    {
+        if (Nodes[NodeIndex].Slot != INDEX_NONE)
+        {
+            Release(NodeIndex);
+        }
+    }
+}
+
+void FNetTimerWheel::Schedule(int32 NodeIndex)
+{
+    FNode& Node = Nodes[NodeIndex];
+
+    // Already due (deadline in the past, or added from OnExpired): next tick
+    if (Node.ExpireTick <= CurrentTick)
+    {
+        Node.ExpireTick = CurrentTick + 1;
+    }
+
+    // Beyond the top level the timer sits at the far edge and is rescheduled when that comes up
+    const int64 Delta = FMath::Min(Node.ExpireTick - CurrentTick, MaxDelayTicks);
+    const int64 SlotTick = CurrentTick + Delta;
+
+    int32 Level = 0;
+    while (Level < NumLevels - 1 && Delta >= (int64(1) << (SlotBits * (Level + 1))))
+    {
+        ++Level;
+    }
+
+    Link(NodeIndex, Level * SlotsPerLevel + static_cast<int32>((SlotTick >> (SlotBits * Level)) & SlotMask));
+}
+
+void FNetTimerWheel::Link(int32 NodeIndex, int32 Slot)
+{
+    FNode& Node = Nodes[NodeIndex];
+    Node.Slot = Slot;
+    Node.Prev = INDEX_NONE;
+    Node.Next = Heads[Slot];
+
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = NodeIndex;
+    }
+    Heads[Slot] = NodeIndex;
+}
+
+void FNetTimerWheel::Unlink(int32 NodeIndex)
+{
+    FNode& Node = Nodes[NodeIndex];
+
+    if (Node.Prev != INDEX_NONE)
+    {
+        Nodes[Node.Prev].Next = Node.Next;
+    }
+    else
+    {
+        Heads[Node.Slot] = Node.Next;
+    }
+
+    if (Node.Next != INDEX_NONE)
+    {
+        Nodes[Node.Next].Prev = Node.Prev;
+    }
+
+    Node.Prev = INDEX_NONE;
+    Node.Next = INDEX_NONE;
+    Node.Slot = INDEX_NONE;
+}
+
+void FNetTimerWheel::Release(int32 NodeIndex)
+{
+    Unlink(NodeIndex);
+
+    FNode& Node = Nodes[NodeIndex];
+    ++Node.Generation;
+    Node.Next = FreeHead;
+    FreeHead = NodeIndex;
+    --NumActive;
+}
+
+void FNetTimerWheel::Cascade(int32 Level, int32 Index)
+{
+    // Detached first: a clamped top-level timer can land back in the slot being emptied
+    const int32 Slot = Level * SlotsPerLevel + Index;
+    int32 NodeIndex = Heads[Slot];
+    Heads[Slot] = INDEX_NONE;
+
+    while (NodeIndex != INDEX_NONE)
+    {
+        const int32 Next = Nodes[NodeIndex].Next;
+        Schedule(NodeIndex);
+        NodeIndex = Next;
+    }
+}
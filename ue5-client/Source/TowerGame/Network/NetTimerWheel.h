@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** A timer in an FNetTimerWheel; stale once the timer fires or is cancelled */
+struct FNetTimerHandle
+{
+    int32 Index = INDEX_NONE;
+    uint32 Generation = 0;
+
+    bool IsValid() const { return Index != INDEX_NONE; }
+    void Invalidate() { Index = INDEX_NONE; }
+};
+
+/**
+ * Hierarchical timer wheel for network timeouts, after Varghese & Lauck.
+ *
+ * Time is cut into TickSeconds ticks. Level 0 has a slot per tick for the next
+ * 64 ticks, each higher level a slot per 64 ticks of the level below, four
+ * levels deep (~46 hours at 10 ms). Add and Cancel are O(1); Advance only
+ * touches the slot of each tick it crosses, and every 64th tick moves one
+ * higher-level slot down, so the cost doesn't grow with the number of timers
+ * outstanding. Timers fire at most one tick late.
+ *
+ * Each timer carries an int64 key (sequence number, request id) handed back
+ * when it fires. Nodes live in one pooled array and are reused. Not thread-safe.
+ */
+class TOWERGAME_API FNetTimerWheel
+{
+public:
+    explicit FNetTimerWheel(double InTickSeconds = 0.01);
+
+    /** Fire Key once Now + DelaySeconds has passed. Now is FPlatformTime::Seconds(), like Advance. */
+    FNetTimerHandle Add(double Now, double DelaySeconds, int64 Key);
+
+    /** Stop a timer before it fires; invalidates Handle. False if it already fired or was cancelled. */
+    bool Cancel(FNetTimerHandle& Handle);
+
+    /**
+     * Fire every timer due by Now, in tick order. OnExpired may add and cancel
+     * timers; ones it adds fire on a later Advance at the earliest.
+     */
+    void Advance(double Now, TFunctionRef<void(int64 Key)> OnExpired);
+
+    /** Timers outstanding */
+    int32 Num() const { return NumActive; }
+
+    /** Drop every timer; outstanding handles go stale */
+    void Reset();
+
+private:
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+    static constexpr int32 SlotMask = SlotsPerLevel - 1;
+    static constexpr int32 NumLevels = 4;
+    static constexpr int64 MaxDelayTicks = (int64(1) << (SlotBits * NumLevels)) - 1;
+
+    struct FNode
+    {
+        int64 Key = 0;
+        int64 ExpireTick = 0;
+        int32 Prev = INDEX_NONE;
+        int32 Next = INDEX_NONE;      // Free list link when unused
+        int32 Slot = INDEX_NONE;      // INDEX_NONE when unused
+        uint32 Generation = 0;
+    };
+
+    /** Link Node into the slot its ExpireTick falls in relative to CurrentTick */
+    void Schedule(int32 NodeIndex);
+    void Link(int32 NodeIndex, int32 Slot);
+    void Unlink(int32 NodeIndex);
+    void Release(int32 NodeIndex);
+
+    /** Move a level's slot down a level (or into level 0) now that its range has come up */
+    void Cascade(int32 Level, int32 Index);
+
+    int64 ToTick(double Seconds) const { return static_cast<int64>(FMath::FloorToDouble(Seconds / TickSeconds)); }
+
+    double TickSeconds;
+
+    /** Last tick Advance has processed */
+    int64 CurrentTick = 0;
+
+    TArray<FNode> Nodes;
+    int32 FreeHead = INDEX_NONE;
+    int32 NumActive = 0;
+
+    /** Head node per slot, level-major */
+    int32 Heads[NumLevels * SlotsPerLevel];
+};
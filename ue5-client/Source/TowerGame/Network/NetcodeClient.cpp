@@ -4,6 +4,143 @@
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "Misc/DateTime.h"
+#include "HAL/RunnableThread.h"
+
+// ============================================================================
+// FNetcodePacketPool
+// ============================================================================
+
+FNetcodePacketPool::FNetcodePacketPool(int32 InSlotSize, int32 InNumSlots)
+    : FreeSlots(InNumSlots + 1)
+    , SlotSize(InSlotSize)
+    , NumSlots(InNumSlots)
+{
+    Slab.SetNumUninitialized(SlotSize * NumSlots);
+
+    for (int32 Slot = 0; Slot < NumSlots; ++Slot)
+    {
+        FreeSlots.Enqueue(Slot);
+    }
+}
+
+int32 FNetcodePacketPool::Acquire()
+{
+    int32 Slot = INDEX_NONE;
+    if (!FreeSlots.Dequeue(Slot))
+    {
+        return INDEX_NONE;
+    }
+
+    // Only the acquiring side writes HighWater, so a plain compare is enough
+    const int32 NowInUse = InUse.Increment();
+    if (NowInUse > HighWater.GetValue())
+    {
+        HighWater.Set(NowInUse);
+    }
+
+    return Slot;
+}
+
+void FNetcodePacketPool::Release(int32 Slot)
+{
+    if (Slot == INDEX_NONE)
+    {
+        return;
+    }
+
+    InUse.Decrement();
+    FreeSlots.Enqueue(Slot);
+}
+
+// ============================================================================
+// FNetcodeReceiveWorker
+// ============================================================================
+
+FNetcodeReceiveWorker::FNetcodeReceiveWorker(FSocket* InSocket, ISocketSubsystem* InSocketSubsystem, FNetcodePacketPool& InPool)
+    : Socket(InSocket)
+    , SocketSubsystem(InSocketSubsystem)
+    , Pool(InPool)
+    , Queue(InPool.GetNumSlots() + 1)
+{
+    DiscardBuffer.SetNumUninitialized(InPool.GetSlotSize());
+}
+
+uint32 FNetcodeReceiveWorker::Run()
+{
+    TSharedRef<FInternetAddr> Sender = SocketSubsystem->CreateInternetAddr();
+
+    // A slot acquired but not yet filled is kept for the next datagram rather
+    // than released, since only the game thread may release
+    int32 Slot = INDEX_NONE;
+
+    while (!bStopRequested)
+    {
+        // Block until readable; the timeout bounds how long Stop() takes to be observed
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(50)))
+        {
+            continue;
+        }
+
+        while (!bStopRequested)
+        {
+            if (Slot == INDEX_NONE)
+            {
+                Slot = Pool.Acquire();
+            }
+
+            uint8* Dest = (Slot != INDEX_NONE) ? Pool.GetSlotData(Slot) : DiscardBuffer.GetData();
+
+            int32 BytesRead = 0;
+            if (!Socket->RecvFrom(Dest, Pool.GetSlotSize(), BytesRead, *Sender))
+            {
+                break;
+            }
+
+            if (BytesRead <= 0)
+            {
+                continue;
+            }
+
+            if (Slot == INDEX_NONE)
+            {
+                Pool.NoteDropped();
+                continue;
+            }
+
+            FNetcodeReceivedPacket Packet;
+            Packet.Data = Dest;
+            Packet.Size = BytesRead;
+            Packet.Slot = Slot;
+            Packet.ArrivalTime = FPlatformTime::Seconds();
+
+            if (Queue.Enqueue(Packet))
+            {
+                Slot = INDEX_NONE;
+            }
+            else
+            {
+                // Ring can't outgrow the pool, but keep the slot for reuse if it ever does
+                Pool.NoteDropped();
+            }
+        }
+    }
+
+    return 0;
+}
+
+void FNetcodeReceiveWorker::Stop()
+{
+    bStopRequested = true;
+}
+
+bool FNetcodeReceiveWorker::Dequeue(FNetcodeReceivedPacket& OutPacket)
+{
+    return Queue.Dequeue(OutPacket);
+}
+
+// ============================================================================
+// UNetcodeClient
+// ============================================================================
 
 UNetcodeClient::UNetcodeClient()
     : UdpSocket(nullptr)
@@ -13,7 +150,7 @@ UNetcodeClient::UNetcodeClient()
     , ProtocolId(0)
     , LastPacketTime(0.0)
     , ConnectionTime(0.0)
-    , TickAccumulator(0.0f)
+    , ReceiveThread(nullptr)
 {
     ReceiveBuffer.SetNum(MAX_PACKET_SIZE);
 }
@@ -55,9 +192,19 @@ bool UNetcodeClient::Connect(const FString& ServerIP, int32 Port)
     }
 
     ServerAddress = ResolvedAddress;
+    RecvSender = SocketSubsystem->CreateInternetAddr();
+
+    // Fresh pool per connection so no slot can be left stranded by the previous one
+    PacketPool = MakeUnique<FNetcodePacketPool>(MAX_PACKET_SIZE, PACKET_POOL_SLOTS);
+    HeldSlots.Reset();
+    HeldSlots.Reserve(PACKET_POOL_SLOTS);
+    ChannelLayer.Reset();
+    NumSendBundles = 0;
+    DatagramsSent = 0;
+    DatagramsCoalesced = 0;
 
     // Generate client ID (timestamp-based, similar to Bevy client)
-    ClientId = static_cast<int64>(FDateTime::Now().ToUnixTimestamp() * 1000);
+    ClientId = RequestedClientId != 0 ? RequestedClientId : static_cast<int64>(FDateTime::Now().ToUnixTimestamp() * 1000);
 
     // Send handshake
     if (!SendHandshake())
@@ -69,6 +216,12 @@ bool UNetcodeClient::Connect(const FString& ServerIP, int32 Port)
 
     bIsConnected = true;
     ConnectionTime = FPlatformTime::Seconds();
+    LastPacketTime = ConnectionTime;
+
+    if (bUseReceiveThread)
+    {
+        StartReceiveThread();
+    }
 
     UE_LOG(LogTemp, Log, TEXT("NetcodeClient: Connected! Client ID: %llu"), ClientId);
     return true;
@@ -79,10 +232,18 @@ void UNetcodeClient::Disconnect()
     if (bIsConnected)
     {
         UE_LOG(LogTemp, Log, TEXT("NetcodeClient: Disconnecting..."));
+        FlushSends();
         bIsConnected = false;
     }
+    NumSendBundles = 0;
 
+    // The worker reads from UdpSocket, so it must be gone before the socket is destroyed
+    StopReceiveThread();
     CloseSocket();
+
+    // Outstanding packet views die with the connection; the pool itself is
+    // kept so its stats can still be read, and is replaced on the next Connect()
+    HeldSlots.Reset();
 }
 
 bool UNetcodeClient::CreateSocket()
@@ -119,6 +280,42 @@ void UNetcodeClient::CloseSocket()
     }
 }
 
+void UNetcodeClient::StartReceiveThread()
+{
+    if (ReceiveThread || !UdpSocket || !PacketPool.IsValid())
+    {
+        return;
+    }
+
+    ReceiveWorker = MakeUnique<FNetcodeReceiveWorker>(UdpSocket, SocketSubsystem, *PacketPool);
+    ReceiveThread = FRunnableThread::Create(ReceiveWorker.Get(), TEXT("NetcodeReceive"), 0, TPri_AboveNormal);
+
+    if (!ReceiveThread)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("NetcodeClient: Failed to start receive thread, falling back to polling in Tick"));
+        ReceiveWorker.Reset();
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("NetcodeClient: Receive thread started"));
+}
+
+void UNetcodeClient::StopReceiveThread()
+{
+    if (ReceiveThread)
+    {
+        // Kill(true) calls Stop() on the runnable and joins
+        ReceiveThread->Kill(true);
+        delete ReceiveThread;
+        ReceiveThread = nullptr;
+
+        UE_LOG(LogTemp, Log, TEXT("NetcodeClient: Receive thread stopped (%d datagrams dropped, pool high-water %d/%d)"),
+            GetDroppedPacketCount(), GetPacketPoolHighWaterMark(), PACKET_POOL_SLOTS);
+    }
+
+    ReceiveWorker.Reset();
+}
+
 bool UNetcodeClient::SendHandshake()
 {
     // Simple handshake: just send client ID
@@ -142,19 +339,118 @@ bool UNetcodeClient::SendHandshake()
     return false;
 }
 
-bool UNetcodeClient::SendPacket(const TArray<uint8>& Data)
+bool UNetcodeClient::SendPacket(const TArray<uint8>& Data, ETowerNetChannel Channel)
 {
     if (!bIsConnected || !UdpSocket)
     {
         return false;
     }
 
+    return SendDatagram(Data, Channel);
+}
+
+bool UNetcodeClient::SendMessage(TArrayView<const uint8> Message, ENetDelivery Delivery, ETowerNetChannel Channel)
+{
+    if (!bIsConnected || !UdpSocket)
+    {
+        return false;
+    }
+
+    // A failed datagram of a reliable message is recovered by the resend timer
+    return ChannelLayer.Send(Delivery, Message, Channel, FPlatformTime::Seconds(),
+        [this](TArrayView<const uint8> Datagram, ETowerNetChannel DatagramChannel)
+        {
+            SendDatagram(Datagram, DatagramChannel);
+        });
+}
+
+bool UNetcodeClient::SendDatagram(TArrayView<const uint8> Data, ETowerNetChannel Channel)
+{
+    constexpr int32 MaxEntry = MAX_PACKET_SIZE - TowerNetBundle::HeaderSize - TowerNetBundle::EntryHeaderSize;
+    if (!bCoalesceSends || Data.Num() > MaxEntry)
+    {
+        const bool bSuccess = SendToServer(Data);
+        if (bSuccess && NetStats)
+        {
+            NetStats->RecordOutgoing(Channel, Data.Num());
+        }
+        return bSuccess;
+    }
+
+    // Into the open bundle, or a new one when it can't take the datagram
+    if (NumSendBundles == 0
+        || SendBundles[NumSendBundles - 1].Bytes.Num() + TowerNetBundle::EntryHeaderSize + Data.Num() > MAX_PACKET_SIZE)
+    {
+        if (NumSendBundles == SendBundles.Num())
+        {
+            SendBundles.AddDefaulted();
+            SendBundles.Last().Bytes.Reserve(MAX_PACKET_SIZE);
+        }
+        FSendBundle& Opened = SendBundles[NumSendBundles++];
+        Opened.Bytes.Reset();
+        Opened.Entries.Reset();
+        Opened.Bytes.Add(TowerNetBundle::Marker);
+    }
+
+    // Header and payload are written straight into the bundle; no copy per message
+    FSendBundle& Bundle = SendBundles[NumSendBundles - 1];
+    const int32 Offset = Bundle.Bytes.AddUninitialized(TowerNetBundle::EntryHeaderSize + Data.Num());
+    uint8* Dest = Bundle.Bytes.GetData() + Offset;
+    Dest[0] = static_cast<uint8>(Data.Num());
+    Dest[1] = static_cast<uint8>(Data.Num() >> 8);
+    FMemory::Memcpy(Dest + TowerNetBundle::EntryHeaderSize, Data.GetData(), Data.Num());
+    Bundle.Entries.Emplace(Channel, Data.Num());
+
+    // A queued datagram counts as sent; the step's flush reports socket failures in the log
+    return true;
+}
+
+void UNetcodeClient::FlushSends()
+{
+    if (NumSendBundles == 0)
+    {
+        return;
+    }
+
+    for (int32 i = 0; i < NumSendBundles; ++i)
+    {
+        FSendBundle& Bundle = SendBundles[i];
+
+        // One datagram: as itself, without the bundle framing
+        constexpr int32 SingleOffset = TowerNetBundle::HeaderSize + TowerNetBundle::EntryHeaderSize;
+        const TArrayView<const uint8> Datagram = Bundle.Entries.Num() == 1
+            ? TArrayView<const uint8>(Bundle.Bytes.GetData() + SingleOffset, Bundle.Bytes.Num() - SingleOffset)
+            : TArrayView<const uint8>(Bundle.Bytes);
+
+        if (!bIsConnected || !UdpSocket || !SendToServer(Datagram))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("NetcodeClient: Bundle of %d datagram(s) (%d bytes) not sent"),
+                Bundle.Entries.Num(), Datagram.Num());
+            continue;
+        }
+
+        DatagramsCoalesced += Bundle.Entries.Num() - 1;
+        if (NetStats)
+        {
+            for (const TPair<ETowerNetChannel, int32>& Entry : Bundle.Entries)
+            {
+                NetStats->RecordOutgoing(Entry.Key, Entry.Value);
+            }
+        }
+    }
+
+    NumSendBundles = 0;
+}
+
+bool UNetcodeClient::SendToServer(TArrayView<const uint8> Data)
+{
     int32 BytesSent = 0;
     bool bSuccess = UdpSocket->SendTo(Data.GetData(), Data.Num(), BytesSent, *ServerAddress);
 
     if (bSuccess)
     {
         UE_LOG(LogTemp, VeryVerbose, TEXT("NetcodeClient: Sent %d bytes"), BytesSent);
+        ++DatagramsSent;
     }
 
     return bSuccess && BytesSent == Data.Num();
@@ -162,41 +458,158 @@ bool UNetcodeClient::SendPacket(const TArray<uint8>& Data)
 
 bool UNetcodeClient::ReceivePackets(TArray<TArray<uint8>>& OutPackets)
 {
-    if (!bIsConnected || !UdpSocket)
+    TArray<FNetcodeReceivedPacket> Received;
+    const bool bAny = ReceivePackets(Received);
+
+    OutPackets.Empty(Received.Num());
+    for (const FNetcodeReceivedPacket& Packet : Received)
+    {
+        OutPackets.Emplace(Packet.Data, Packet.Size);
+    }
+
+    return bAny;
+}
+
+void UNetcodeClient::ReleaseHeldPackets()
+{
+    if (PacketPool.IsValid())
+    {
+        for (int32 Slot : HeldSlots)
+        {
+            PacketPool->Release(Slot);
+        }
+    }
+
+    HeldSlots.Reset();
+}
+
+bool UNetcodeClient::ReceivePackets(TArray<FNetcodeReceivedPacket>& OutPackets)
+{
+    OutPackets.Reset();
+
+    if (!bIsConnected || !UdpSocket || !PacketPool.IsValid())
     {
         return false;
     }
 
-    OutPackets.Empty();
+    // Last call's views are no longer referenced by the caller
+    ReleaseHeldPackets();
+
+    // Threaded mode: everything has already been read and timestamped off-thread
+    if (ReceiveWorker.IsValid())
+    {
+        FNetcodeReceivedPacket Packet;
+        while (ReceiveWorker->Dequeue(Packet))
+        {
+            LastPacketTime = Packet.ArrivalTime;
+            UE_LOG(LogTemp, VeryVerbose, TEXT("NetcodeClient: Received %d bytes"), Packet.Size);
+            HeldSlots.Add(Packet.Slot);
+            OutPackets.Add(Packet);
+        }
+
+        ProcessChannelFrames(OutPackets);
+        CapturePackets(OutPackets);
+        return OutPackets.Num() > 0;
+    }
 
     // Receive all available packets
     while (true)
     {
-        int32 BytesRead = 0;
-        TSharedRef<FInternetAddr> Sender = SocketSubsystem->CreateInternetAddr();
+        const int32 Slot = PacketPool->Acquire();
+        uint8* Dest = (Slot != INDEX_NONE) ? PacketPool->GetSlotData(Slot) : ReceiveBuffer.GetData();
 
-        if (!UdpSocket->RecvFrom(ReceiveBuffer.GetData(), ReceiveBuffer.Num(), BytesRead, *Sender))
+        int32 BytesRead = 0;
+        if (!UdpSocket->RecvFrom(Dest, MAX_PACKET_SIZE, BytesRead, *RecvSender))
         {
+            PacketPool->Release(Slot);
             break; // No more packets
         }
 
-        if (BytesRead > 0)
+        if (BytesRead <= 0 || Slot == INDEX_NONE)
         {
-            // Copy received data
-            TArray<uint8> PacketData;
-            PacketData.SetNum(BytesRead);
-            FMemory::Memcpy(PacketData.GetData(), ReceiveBuffer.GetData(), BytesRead);
+            if (Slot == INDEX_NONE)
+            {
+                PacketPool->NoteDropped();
+            }
+            PacketPool->Release(Slot);
+            continue;
+        }
 
-            OutPackets.Add(PacketData);
-            LastPacketTime = FPlatformTime::Seconds();
+        FNetcodeReceivedPacket& Packet = OutPackets.AddDefaulted_GetRef();
+        Packet.Data = Dest;
+        Packet.Size = BytesRead;
+        Packet.Slot = Slot;
+        Packet.ArrivalTime = FPlatformTime::Seconds();
+        HeldSlots.Add(Slot);
 
-            UE_LOG(LogTemp, VeryVerbose, TEXT("NetcodeClient: Received %d bytes"), BytesRead);
-        }
+        LastPacketTime = Packet.ArrivalTime;
+
+        UE_LOG(LogTemp, VeryVerbose, TEXT("NetcodeClient: Received %d bytes"), BytesRead);
     }
 
+    ProcessChannelFrames(OutPackets);
+    CapturePackets(OutPackets);
     return OutPackets.Num() > 0;
 }
 
+void UNetcodeClient::ProcessChannelFrames(TArray<FNetcodeReceivedPacket>& Packets)
+{
+    NumDeliveredMessages = 0;
+
+    bool bAnyFrames = false;
+    for (const FNetcodeReceivedPacket& Packet : Packets)
+    {
+        bAnyFrames |= FNetChannelLayer::IsChannelFrame(Packet.GetView());
+    }
+    if (!bAnyFrames)
+    {
+        return;
+    }
+
+    // Rebuild the list in arrival order with each frame replaced by the messages it completed
+    RawPackets = Packets;
+    Packets.Reset();
+
+    for (const FNetcodeReceivedPacket& Raw : RawPackets)
+    {
+        if (!FNetChannelLayer::IsChannelFrame(Raw.GetView()))
+        {
+            Packets.Add(Raw);
+            continue;
+        }
+
+        ChannelLayer.Receive(Raw.GetView(), Raw.ArrivalTime, [this, &Packets, &Raw](TArrayView<const uint8> Message)
+        {
+            if (NumDeliveredMessages == DeliveredMessages.Num())
+            {
+                DeliveredMessages.AddDefaulted();
+            }
+
+            TArray<uint8>& Storage = DeliveredMessages[NumDeliveredMessages++];
+            Storage.Reset();
+            Storage.Append(Message.GetData(), Message.Num());
+
+            FNetcodeReceivedPacket& Delivered = Packets.AddDefaulted_GetRef();
+            Delivered.Data = Storage.GetData();
+            Delivered.Size = Storage.Num();
+            Delivered.ArrivalTime = Raw.ArrivalTime;
+        });
+    }
+}
+
+void UNetcodeClient::CapturePackets(const TArray<FNetcodeReceivedPacket>& Packets)
+{
+    if (!Capture || !Capture->IsOpen())
+    {
+        return;
+    }
+
+    for (const FNetcodeReceivedPacket& Packet : Packets)
+    {
+        Capture->Write(ENetCaptureSource::Netcode, 0, Packet.ArrivalTime, Packet.GetView());
+    }
+}
+
 void UNetcodeClient::Tick(float DeltaTime)
 {
     if (!bIsConnected)
@@ -204,19 +617,22 @@ void UNetcodeClient::Tick(float DeltaTime)
         return;
     }
 
-    TickAccumulator += DeltaTime;
+    ChannelLayer.Update(FPlatformTime::Seconds(),
+        [this](TArrayView<const uint8> Datagram, ETowerNetChannel Channel)
+        {
+            SendDatagram(Datagram, Channel);
+        });
 
-    // Send keepalive every tick interval
-    if (TickAccumulator >= TICK_RATE)
+    // Send empty packet as keepalive, once a step, unless something else is going out anyway
+    if (NumSendBundles == 0)
     {
-        TickAccumulator = 0.0f;
-
-        // Send empty packet as keepalive
         TArray<uint8> KeepaliveData;
         KeepaliveData.Add(0x00); // Keepalive packet type
-        SendPacket(KeepaliveData);
+        SendPacket(KeepaliveData, ETowerNetChannel::Keepalive);
     }
 
+    FlushSends();
+
     // Check for timeout (5 seconds without packets)
     double TimeSinceLastPacket = FPlatformTime::Seconds() - LastPacketTime;
     if (TimeSinceLastPacket > 5.0)
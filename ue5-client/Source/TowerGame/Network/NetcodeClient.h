@@ -7,11 +7,130 @@
 #include "SocketSubsystem.h"
 #include "IPAddress.h"
 #include "Containers/Queue.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "NetStats.h"
+#include "NetCapture.h"
+#include "NetChannelLayer.h"
 #include "NetcodeClient.generated.h"
 
+class FRunnableThread;
+
+/**
+ * Fixed-capacity slab of MAX_PACKET_SIZE slots that datagrams are received
+ * straight into, so the receive -> decode path never touches the heap once
+ * the client is connected.
+ *
+ * Free slots circulate through a lock-free SPSC ring: the receiving side
+ * (worker thread, or the game thread when polling) is the only one that
+ * acquires, the game thread is the only one that releases.
+ */
+class FNetcodePacketPool
+{
+public:
+    FNetcodePacketPool(int32 InSlotSize, int32 InNumSlots);
+
+    /** Receiving side only. Returns INDEX_NONE when every slot is in use. */
+    int32 Acquire();
+
+    /** Game thread only: hand a slot back once its packet has been decoded */
+    void Release(int32 Slot);
+
+    uint8* GetSlotData(int32 Slot) { return Slab.GetData() + static_cast<SIZE_T>(Slot) * SlotSize; }
+
+    int32 GetSlotSize() const { return SlotSize; }
+    int32 GetNumSlots() const { return NumSlots; }
+    int32 GetInUseCount() const { return InUse.GetValue(); }
+    int32 GetHighWaterMark() const { return HighWater.GetValue(); }
+
+    /** Datagrams discarded because no slot was free */
+    int32 GetDroppedCount() const { return Dropped.GetValue(); }
+    void NoteDropped() { Dropped.Increment(); }
+
+private:
+    TArray<uint8> Slab;
+    TCircularQueue<int32> FreeSlots;
+    int32 SlotSize;
+    int32 NumSlots;
+    FThreadSafeCounter InUse;
+    FThreadSafeCounter HighWater;
+    FThreadSafeCounter Dropped;
+};
+
+/**
+ * A datagram read from the UDP socket, stamped with the time it was pulled
+ * off the wire (FPlatformTime::Seconds()).
+ *
+ * Data points into a FNetcodePacketPool slot and stays valid until the next
+ * UNetcodeClient::ReceivePackets() call or Disconnect().
+ */
+struct FNetcodeReceivedPacket
+{
+    const uint8* Data = nullptr;
+    int32 Size = 0;
+    int32 Slot = INDEX_NONE;
+    double ArrivalTime = 0.0;
+
+    TArrayView<const uint8> GetView() const { return TArrayView<const uint8>(Data, Size); }
+};
+
+/**
+ * Background receive loop for UNetcodeClient.
+ *
+ * Blocks on socket readiness, receives each datagram directly into a pool slot,
+ * timestamps it and hands it to the game thread through a lock-free
+ * single-producer / single-consumer ring (TCircularQueue). The game thread is
+ * the only consumer. If the pool is exhausted the datagram is dropped and
+ * counted, the same way the kernel would drop it if nobody drained the socket.
+ */
+class FNetcodeReceiveWorker : public FRunnable
+{
+public:
+    FNetcodeReceiveWorker(FSocket* InSocket, ISocketSubsystem* InSocketSubsystem, FNetcodePacketPool& InPool);
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+    /** Game thread only: pop the next datagram. Returns false if the ring is empty. */
+    bool Dequeue(FNetcodeReceivedPacket& OutPacket);
+
+private:
+    FSocket* Socket;
+    ISocketSubsystem* SocketSubsystem;
+    FNetcodePacketPool& Pool;
+    TCircularQueue<FNetcodeReceivedPacket> Queue;
+    FThreadSafeBool bStopRequested;
+
+    // Scratch space used to drain the socket when the pool is exhausted
+    TArray<uint8> DiscardBuffer;
+};
+
+/**
+ * Bundle datagram (client -> server): several datagrams of one network step
+ * packed back to back, each handled by the server as if it arrived alone.
+ * The first byte sets it apart from raw packets and channel frames:
+ *
+ *   u8 marker (0xC1), then { u16 length (little-endian), datagram } ...
+ */
+namespace TowerNetBundle
+{
+    constexpr uint8 Marker = 0xC1;
+    constexpr int32 HeaderSize = 1;
+    constexpr int32 EntryHeaderSize = 2;
+}
+
 /**
  * Low-level UDP client for renet netcode protocol
  * Connects to Bevy server and handles packet transmission
+ *
+ * While connected, outgoing datagrams (raw packets and channel frames alike)
+ * are queued for the step and packed into bundles of at most MAX_PACKET_SIZE
+ * as they come in; Tick sends them, one SendTo per bundle. A bundle that ends
+ * up holding one datagram goes out as that datagram, so nothing is lost
+ * against sending directly.
  */
 UCLASS(BlueprintType)
 class TOWERGAME_API UNetcodeClient : public UObject
@@ -35,13 +154,92 @@ public:
     UFUNCTION(BlueprintPure, Category = "Netcode")
     int64 GetClientId() const { return ClientId; }
 
+    /**
+     * Client ID for the next Connect() instead of the timestamp-based one, for
+     * several connections from one process (FNetBotSwarm). 0 = generate.
+     */
+    void SetRequestedClientId(int64 InClientId) { RequestedClientId = InClientId; }
+
     // Packet sending/receiving
-    bool SendPacket(const TArray<uint8>& Data);
+    /**
+     * One raw datagram of at most MAX_PACKET_SIZE, sent with the step's bundle.
+     * Channel only labels it in the traffic stats.
+     */
+    bool SendPacket(const TArray<uint8>& Data, ETowerNetChannel Channel = ETowerNetChannel::Unknown);
+
+    /**
+     * Send a message of up to GetMaxMessageSize() bytes through the channel layer,
+     * fragmented as needed. Reliable messages are resent until acked and arrive in order;
+     * sequenced ones may be dropped but never arrive out of order.
+     */
+    bool SendMessage(TArrayView<const uint8> Message, ENetDelivery Delivery, ETowerNetChannel Channel = ETowerNetChannel::Unknown);
+
+    int32 GetMaxMessageSize() const { return ChannelLayer.GetMaxMessageSize(); }
+
     bool ReceivePackets(TArray<TArray<uint8>>& OutPackets);
 
-    // Called every frame to process network
+    /**
+     * Allocation-free variant: packets are views into the packet pool and are
+     * only valid until the next call. Reuse OutPackets across calls.
+     * Channel-layer datagrams are consumed here; what comes out is the raw
+     * packets plus every message they completed, in arrival order.
+     */
+    bool ReceivePackets(TArray<FNetcodeReceivedPacket>& OutPackets);
+
+    /** Reliable fragments sent but not yet acked, and queued behind the window */
+    UFUNCTION(BlueprintPure, Category = "Netcode")
+    int32 GetReliableBacklog() const { return ChannelLayer.GetReliableInFlight() + ChannelLayer.GetReliableQueued(); }
+
+    UFUNCTION(BlueprintPure, Category = "Netcode")
+    int32 GetReliableResendCount() const { return ChannelLayer.GetResentCount(); }
+
+    /**
+     * Drain the socket on a dedicated thread instead of inside Tick.
+     * Must be set before Connect(); takes effect on the next connection.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Netcode")
+    bool bUseReceiveThread = false;
+
+    /** Queue sends for the step and bundle them; off sends every datagram on its own, at once */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Netcode")
+    bool bCoalesceSends = true;
+
+    /** Send what this step queued now instead of at the end of Tick */
+    void FlushSends();
+
+    /** Datagrams handed to the socket / queued datagrams that shared one with another, since connecting */
+    int32 GetDatagramsSent() const { return DatagramsSent; }
+    int32 GetDatagramsCoalesced() const { return DatagramsCoalesced; }
+
+    UFUNCTION(BlueprintPure, Category = "Netcode")
+    bool IsUsingReceiveThread() const { return ReceiveWorker.IsValid(); }
+
+    /** Arrival time (FPlatformTime::Seconds()) of the most recent datagram */
+    double GetLastPacketTime() const { return LastPacketTime; }
+
+    /** Datagrams dropped because the packet pool was exhausted */
+    UFUNCTION(BlueprintPure, Category = "Netcode")
+    int32 GetDroppedPacketCount() const { return PacketPool.IsValid() ? PacketPool->GetDroppedCount() : 0; }
+
+    /** Most packet pool slots ever in use at once during this connection */
+    UFUNCTION(BlueprintPure, Category = "Netcode")
+    int32 GetPacketPoolHighWaterMark() const { return PacketPool.IsValid() ? PacketPool->GetHighWaterMark() : 0; }
+
+    UFUNCTION(BlueprintPure, Category = "Netcode")
+    int32 GetPacketPoolCapacity() const { return PACKET_POOL_SLOTS; }
+
+    /**
+     * One network step (FTowerNetClock's Send phase): keepalive, channel
+     * resends and the timeout check. Call it at the server tick rate, not per frame.
+     */
     void Tick(float DeltaTime);
 
+    /** Where outgoing datagrams are counted (UTowerNetworkSubsystem's collector); may be null */
+    void SetNetStats(FTowerNetStatsCollector* InNetStats) { NetStats = InNetStats; }
+
+    /** Received datagrams are recorded here while it is open; may be null */
+    void SetCapture(FNetCaptureWriter* InCapture) { Capture = InCapture; }
+
 private:
     // Socket
     FSocket* UdpSocket;
@@ -52,23 +250,58 @@ private:
     bool bIsConnected;
     int64 ClientId;
     int64 ProtocolId;
+    int64 RequestedClientId = 0;
+
+    FTowerNetStatsCollector* NetStats = nullptr;
+    FNetCaptureWriter* Capture = nullptr;
 
     // Timing
     double LastPacketTime;
     double ConnectionTime;
-    float TickAccumulator;
 
     // Buffers
     TArray<uint8> ReceiveBuffer;
-    TQueue<TArray<uint8>> OutgoingQueue;
+
+    // Send side: this step's bundles, storage kept across steps
+    struct FSendBundle
+    {
+        TArray<uint8> Bytes;
+        TArray<TPair<ETowerNetChannel, int32>, TInlineAllocator<16>> Entries;
+    };
+    TArray<FSendBundle> SendBundles;
+    int32 NumSendBundles = 0;
+    int32 DatagramsSent = 0;
+    int32 DatagramsCoalesced = 0;
+
+    // Receive-side packet storage, created on first Connect()
+    TUniquePtr<FNetcodePacketPool> PacketPool;
+    TArray<int32> HeldSlots;               // Slots handed out by the last ReceivePackets()
+    TSharedPtr<FInternetAddr> RecvSender;  // Reused by RecvFrom when polling
+
+    // Channels, fragmentation and acks over the same socket
+    FNetChannelLayer ChannelLayer{MAX_PACKET_SIZE};
+    TArray<FNetcodeReceivedPacket> RawPackets;           // Reused by ReceivePackets()
+    TArray<TArray<uint8>> DeliveredMessages;             // Storage for reassembled messages, reused
+    int32 NumDeliveredMessages = 0;
+
+    // Receive thread (only when bUseReceiveThread)
+    TUniquePtr<FNetcodeReceiveWorker> ReceiveWorker;
+    FRunnableThread* ReceiveThread;
 
     // Internal methods
     bool CreateSocket();
     void CloseSocket();
+    void StartReceiveThread();
+    void StopReceiveThread();
+    void ReleaseHeldPackets();
+    void CapturePackets(const TArray<FNetcodeReceivedPacket>& Packets);
+    void ProcessChannelFrames(TArray<FNetcodeReceivedPacket>& Packets);
+    bool SendDatagram(TArrayView<const uint8> Data, ETowerNetChannel Channel);
+    bool SendToServer(TArrayView<const uint8> Data);
     bool SendHandshake();
     void ProcessIncomingData();
 
     // Netcode protocol constants
     static constexpr int32 MAX_PACKET_SIZE = 1200;
-    static constexpr float TICK_RATE = 0.05f; // 20 Hz
+    static constexpr int32 PACKET_POOL_SLOTS = 1024; // ~1.2 MB slab
 };
@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PayloadCompression.h"
+#include "Misc/Compression.h"
+
+namespace
+{
+    FName GetCodecFormat(EPayloadCodec Codec)
+    {
+        switch (Codec)
+        {
+            case EPayloadCodec::LZ4:   return NAME_LZ4;
+            case EPayloadCodec::Oodle: return NAME_Oodle;
+            default:                   return NAME_None;
+        }
+    }
+
+    void WriteVarint(TArray<uint8>& Out, uint32 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(static_cast<uint8>(Value | 0x80));
+            Value >>= 7;
+        }
+        Out.Add(static_cast<uint8>(Value));
+    }
+
+    bool ReadVarint(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 35 && Cursor < End; Shift += 7)
+        {
+            const uint8 Byte = *Cursor++;
+            OutValue |= static_cast<uint32>(Byte & 0x7F) << Shift;
+            if ((Byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// ============================================================================
+// PayloadCompression
+// ============================================================================
+
+const FString& PayloadCompression::GetAcceptedCodecs()
+{
+    // LZ4 first: snapshots are small and frequent, decode speed matters more than ratio.
+    // Oodle is the high-ratio option for large one-off payloads (floors, catalogs).
+    static const FString Codecs = TEXT("lz4,oodle");
+    return Codecs;
+}
+
+bool PayloadCompression::IsCompressed(TArrayView<const uint8> Payload)
+{
+    return Payload.Num() >= 4 && Payload[0] == FrameMagic;
+}
+
+bool PayloadCompression::Compress(EPayloadCodec Codec, TArrayView<const uint8> Raw, TArray<uint8>& OutFrame)
+{
+    const FName Format = GetCodecFormat(Codec);
+    if (Format.IsNone() || Raw.Num() > MaxRawSize)
+    {
+        return false;
+    }
+
+    OutFrame.Reset();
+    OutFrame.Add(FrameMagic);
+    OutFrame.Add(static_cast<uint8>(Codec));
+    OutFrame.Add(NoDictionary);
+    WriteVarint(OutFrame, static_cast<uint32>(Raw.Num()));
+
+    const int32 HeaderSize = OutFrame.Num();
+    int32 CompressedSize = FCompression::CompressMemoryBound(Format, Raw.Num());
+    OutFrame.SetNumUninitialized(HeaderSize + CompressedSize);
+
+    if (!FCompression::CompressMemory(Format, OutFrame.GetData() + HeaderSize, CompressedSize, Raw.GetData(), Raw.Num()))
+    {
+        OutFrame.Reset();
+        return false;
+    }
+
+    OutFrame.SetNum(HeaderSize + CompressedSize);
+    return true;
+}
+
+// ============================================================================
+// FPayloadDecompressor
+// ============================================================================
+
+bool FPayloadDecompressor::Decode(TArrayView<const uint8> Payload, TArrayView<const uint8>& OutRaw)
+{
+    if (!PayloadCompression::IsCompressed(Payload))
+    {
+        OutRaw = Payload;
+        return true;
+    }
+
+    const uint8* Cursor = Payload.GetData() + 1;
+    const uint8* End = Payload.GetData() + Payload.Num();
+
+    const EPayloadCodec Codec = static_cast<EPayloadCodec>(*Cursor++);
+    const uint8 Dictionary = *Cursor++;
+    uint32 RawSize = 0;
+
+    const FName Format = GetCodecFormat(Codec);
+    if (Format.IsNone() || Dictionary != PayloadCompression::NoDictionary)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PayloadCompression: unsupported frame (codec %d, dictionary %d)"),
+            static_cast<int32>(Codec), Dictionary);
+        return false;
+    }
+
+    if (!ReadVarint(Cursor, End, RawSize) || RawSize > PayloadCompression::MaxRawSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PayloadCompression: bad raw size in %d byte frame"), Payload.Num());
+        return false;
+    }
+
+    // Grow only; a snapshot after a floor download reuses the big buffer
+    Buffer.SetNumUninitialized(static_cast<int32>(RawSize), false);
+
+    const int32 CompressedSize = static_cast<int32>(End - Cursor);
+    if (!FCompression::UncompressMemory(Format, Buffer.GetData(), static_cast<int32>(RawSize), Cursor, CompressedSize))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PayloadCompression: %d -> %u byte frame failed to decompress"),
+            CompressedSize, RawSize);
+        return false;
+    }
+
+    OutRaw = TArrayView<const uint8>(Buffer.GetData(), static_cast<int32>(RawSize));
+    return true;
+}
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Codecs a compressed payload frame can carry.
+ * The numeric values are on the wire; append only.
+ */
+enum class EPayloadCodec : uint8
+{
+    None  = 0,
+    LZ4   = 1,
+    Oodle = 2,
+};
+
+/**
+ * Compressed payload framing shared by the match connection and the service transports.
+ *
+ * Servers only compress when the client advertised the codec (GetAcceptedCodecs), and
+ * a compressed payload is self-describing so uncompressed ones keep flowing unchanged:
+ *
+ *   u8 magic (0xFE), u8 codec, u8 dictionary id, varint raw size, compressed bytes
+ *
+ * 0xFE never starts a UTF-8 JSON body and is not a WorldSnapshot payload version, so a
+ * payload is either a frame or exactly what it was before.
+ */
+namespace PayloadCompression
+{
+    constexpr uint8 FrameMagic = 0xFE;
+
+    /** Dictionary id 0 means none; shared dictionaries are not supported by this client */
+    constexpr uint8 NoDictionary = 0;
+
+    /** Largest raw size we'll allocate for; anything above is treated as a corrupt frame */
+    constexpr int64 MaxRawSize = 64 * 1024 * 1024;
+
+    /** Comma-separated codec names to advertise to the server, preferred first ("lz4,oodle") */
+    TOWERGAME_API const FString& GetAcceptedCodecs();
+
+    TOWERGAME_API bool IsCompressed(TArrayView<const uint8> Payload);
+
+    /** Encode Raw as a frame (tools and tests; the client doesn't compress uploads). False if the codec failed. */
+    TOWERGAME_API bool Compress(EPayloadCodec Codec, TArrayView<const uint8> Raw, TArray<uint8>& OutFrame);
+}
+
+/**
+ * Turns received payloads back into raw bytes.
+ *
+ * Uncompressed payloads pass through untouched. Compressed frames are inflated into
+ * a buffer owned by the decompressor that only ever grows, so steady-state snapshot
+ * traffic decompresses without allocating. The returned view is valid until the
+ * next Decode() on the same instance. Game thread only.
+ */
+class TOWERGAME_API FPayloadDecompressor
+{
+public:
+    /** Point OutRaw at the raw bytes of Payload; false on a corrupt or unsupported frame */
+    bool Decode(TArrayView<const uint8> Payload, TArrayView<const uint8>& OutRaw);
+
+    /** Drop the scratch buffer, e.g. after a one-off large download */
+    void Trim() { Buffer.Empty(); }
+
+private:
+    TArray<uint8> Buffer;
+};
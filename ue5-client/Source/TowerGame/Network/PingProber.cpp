@@ -0,0 +1,264 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PingProber.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    void WriteU32(uint8* Dest, uint32 Value)
+    {
+        for (int32 i = 0; i < 4; ++i)
+        {
+            Dest[i] = static_cast<uint8>(Value >> (8 * i));
+        }
+    }
+
+    uint32 ReadU32(const uint8* Src)
+    {
+        return Src[0] | (Src[1] << 8) | (Src[2] << 16) | (static_cast<uint32>(Src[3]) << 24);
+    }
+
+    uint16 ReadU16(const uint8* Src)
+    {
+        return static_cast<uint16>(Src[0] | (Src[1] << 8));
+    }
+}
+
+FTowerPingProber::FTowerPingProber() = default;
+
+FTowerPingProber::~FTowerPingProber()
+{
+    if (Socket)
+    {
+        Socket->Close();
+        SocketSubsystem->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
+
+FString FTowerPingProber::MakeEndpoint(const FString& Host, int32 Port)
+{
+    return FString::Printf(TEXT("%s:%d"), *Host, Port > 0 ? Port : 5000);
+}
+
+bool FTowerPingProber::EnsureSocket()
+{
+    if (Socket)
+    {
+        return true;
+    }
+
+    SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!SocketSubsystem)
+    {
+        return false;
+    }
+
+    Socket = SocketSubsystem->CreateSocket(NAME_DGram, TEXT("TowerPingProber"), false);
+    if (!Socket)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PingProber: Failed to create UDP socket"));
+        return false;
+    }
+
+    Socket->SetNonBlocking(true);
+    RecvSender = SocketSubsystem->CreateInternetAddr();
+    return true;
+}
+
+TSharedPtr<FInternetAddr> FTowerPingProber::Resolve(const FString& Endpoint)
+{
+    if (const TSharedPtr<FInternetAddr>* Cached = Resolved.Find(Endpoint))
+    {
+        return *Cached;
+    }
+
+    FString Host = Endpoint;
+    int32 Port = 5000;
+    FString PortString;
+    if (Endpoint.Split(TEXT(":"), &Host, &PortString, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+    {
+        Port = FCString::Atoi(*PortString);
+    }
+
+    TSharedPtr<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+    bool bIsValid = false;
+    Address->SetIp(*Host, bIsValid);
+    if (!bIsValid)
+    {
+        // A host name: region servers usually are. Blocks once per name, then cached.
+        const FAddressInfoResult Info = SocketSubsystem->GetAddressInfo(*Host, nullptr,
+            EAddressInfoFlags::Default, NAME_None, ESocketType::SOCKTYPE_Datagram);
+        if (Info.ReturnCode != SE_NO_ERROR || Info.Results.Num() == 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PingProber: Can't resolve %s"), *Host);
+            Resolved.Add(Endpoint, nullptr);
+            return nullptr;
+        }
+        Address = Info.Results[0].Address->Clone();
+    }
+
+    Address->SetPort(Port + TowerPing::PortOffset);
+    Resolved.Add(Endpoint, Address);
+    return Address;
+}
+
+bool FTowerPingProber::Probe(const TArray<FString>& Endpoints, bool bForce)
+{
+    if (!EnsureSocket())
+    {
+        return false;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    bool bSent = false;
+    for (const FString& Endpoint : Endpoints)
+    {
+        if (Endpoint.IsEmpty() || Round.Contains(Endpoint))
+        {
+            continue;
+        }
+        const FTowerPingResult* Cached = Results.Find(Endpoint);
+        if (!bForce && Cached && Now - Cached->MeasuredAt < CacheSeconds)
+        {
+            continue;
+        }
+
+        const TSharedPtr<FInternetAddr> Address = Resolve(Endpoint);
+        if (!Address.IsValid())
+        {
+            continue;
+        }
+
+        FTowerPingResult& Result = Round.Add(Endpoint);
+        for (int32 i = 0; i < ProbesPerEndpoint; ++i)
+        {
+            const uint32 Sequence = NextSequence++;
+            const uint64 Timestamp = FPlatformTime::Cycles64();
+
+            uint8 Packet[TowerPing::ProbeSize];
+            WriteU32(Packet, TowerPing::Magic);
+            WriteU32(Packet + 4, Sequence);
+            WriteU32(Packet + 8, static_cast<uint32>(Timestamp));
+            WriteU32(Packet + 12, static_cast<uint32>(Timestamp >> 32));
+            WriteU32(Packet + TowerPing::LoadOffset, 0);
+
+            int32 BytesSent = 0;
+            if (Socket->SendTo(Packet, TowerPing::ProbeSize, BytesSent, *Address))
+            {
+                InFlight.Add(Sequence, { Endpoint, FPlatformTime::Seconds() });
+                ++Result.Sent;
+                bSent = true;
+            }
+        }
+    }
+
+    if (bSent)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("PingProber: Probing %d endpoint(s)"), Round.Num());
+    }
+    else if (InFlight.Num() == 0)
+    {
+        // Nothing went out: close what was opened, so a failed send reads as unreachable
+        FinishRound();
+    }
+    return bSent;
+}
+
+void FTowerPingProber::Tick()
+{
+    if (!Socket || InFlight.Num() == 0)
+    {
+        return;
+    }
+
+    uint8 Buffer[TowerPing::ReplySize + 1];
+    uint32 PendingSize = 0;
+    while (Socket->HasPendingData(PendingSize))
+    {
+        int32 BytesRead = 0;
+        if (!Socket->RecvFrom(Buffer, sizeof(Buffer), BytesRead, *RecvSender))
+        {
+            break;
+        }
+        if (BytesRead != TowerPing::ReplySize || ReadU32(Buffer) != TowerPing::Magic)
+        {
+            continue;
+        }
+
+        FInFlight Probe;
+        if (!InFlight.RemoveAndCopyValue(ReadU32(Buffer + 4), Probe))
+        {
+            // A reply to a probe that already timed out
+            continue;
+        }
+
+        FTowerPingResult& Result = Round.FindOrAdd(Probe.Endpoint);
+        const float RttMs = static_cast<float>((FPlatformTime::Seconds() - Probe.SentAt) * 1000.0);
+        Result.RttMs = Result.RttMs < 0.0f ? RttMs : FMath::Min(Result.RttMs, RttMs);
+        Result.Players = ReadU16(Buffer + TowerPing::LoadOffset);
+        Result.MaxPlayers = ReadU16(Buffer + TowerPing::LoadOffset + 2);
+        ++Result.Received;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    for (auto It = InFlight.CreateIterator(); It; ++It)
+    {
+        if (Now - It.Value().SentAt > TimeoutSeconds)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    if (InFlight.Num() == 0)
+    {
+        FinishRound();
+    }
+}
+
+void FTowerPingProber::FinishRound()
+{
+    const double Now = FPlatformTime::Seconds();
+    for (TPair<FString, FTowerPingResult>& Pair : Round)
+    {
+        Pair.Value.MeasuredAt = Now;
+        Results.Add(Pair.Key, Pair.Value);
+    }
+    Round.Reset();
+}
+
+float FTowerPingProber::Score(const FString& Endpoint, float LoadPenaltyMs) const
+{
+    const FTowerPingResult* Result = Results.Find(Endpoint);
+    if (!Result || !Result->IsReachable() || Result->IsFull())
+    {
+        return -1.0f;
+    }
+    return Result->RttMs + LoadPenaltyMs * Result->GetLoad();
+}
+
+FString FTowerPingProber::PickBest(const TArray<FString>& Endpoints, float LoadPenaltyMs) const
+{
+    FString Best;
+    float BestScore = TNumericLimits<float>::Max();
+    for (const FString& Endpoint : Endpoints)
+    {
+        const float EndpointScore = Score(Endpoint, LoadPenaltyMs);
+        if (EndpointScore >= 0.0f && EndpointScore < BestScore)
+        {
+            Best = Endpoint;
+            BestScore = EndpointScore;
+        }
+    }
+    return Best;
+}
+
+void FTowerPingProber::Reset()
+{
+    InFlight.Reset();
+    Round.Reset();
+    Results.Reset();
+    Resolved.Reset();
+}
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSocket;
+class ISocketSubsystem;
+class FInternetAddr;
+
+/**
+ * Probe wire format, as bevy-server's ping.rs (all little-endian). Probes go
+ * to the port next to the netcode port, which renet's transport keeps to
+ * itself:
+ *
+ *   probe  u32 magic 'TPNG', u32 sequence, u64 client timestamp, 4 bytes 0 (20 bytes)
+ *   reply  the probe, its last 4 bytes u16 connected players, u16 max players (20 bytes)
+ *
+ * The padding keeps replies no larger than probes; the server ignores unpadded ones.
+ */
+namespace TowerPing
+{
+    constexpr uint32 Magic = 0x474E5054;    // "TPNG"
+    constexpr int32 PortOffset = 1;
+    constexpr int32 LoadOffset = 16;
+    constexpr int32 ProbeSize = LoadOffset + 4;
+    constexpr int32 ReplySize = ProbeSize;
+}
+
+/** What the probes to one game server measured */
+struct FTowerPingResult
+{
+    /** Best round trip of the last probe round; negative until one came back */
+    float RttMs = -1.0f;
+
+    int32 Players = 0;
+    int32 MaxPlayers = 0;
+
+    int32 Sent = 0;
+    int32 Received = 0;
+
+    /** FPlatformTime::Seconds of the last completed round */
+    double MeasuredAt = 0.0;
+
+    bool IsReachable() const { return Received > 0; }
+    bool IsFull() const { return MaxPlayers > 0 && Players >= MaxPlayers; }
+    float GetLoad() const { return MaxPlayers > 0 ? static_cast<float>(Players) / MaxPlayers : 0.0f; }
+};
+
+/**
+ * Measures round trips to game servers with a few UDP datagrams each. Every
+ * endpoint of a Probe call is probed at once from one non-blocking socket, so a
+ * round over any number of servers takes one timeout at most; Tick drains the
+ * replies. Endpoints are the "host:port" of the netcode server.
+ *
+ * Results stay cached for the session (as long as the prober lives). Probe
+ * skips endpoints measured within CacheSeconds unless forced, so ranking a match
+ * list again is free.
+ */
+class TOWERGAME_API FTowerPingProber
+{
+public:
+    FTowerPingProber();
+    ~FTowerPingProber();
+
+    /** Send a round to Endpoints; false when every one was fresh in the cache (or no socket) */
+    bool Probe(const TArray<FString>& Endpoints, bool bForce = false);
+
+    /** Read replies and close the round once every probe came back or timed out */
+    void Tick();
+
+    bool IsProbing() const { return InFlight.Num() > 0; }
+
+    const FTowerPingResult* Find(const FString& Endpoint) const { return Results.Find(Endpoint); }
+
+    /**
+     * Lower is better: the RTT plus LoadPenaltyMs at a full server. Negative for
+     * endpoints that never answered or are full, which no one should be sent to.
+     */
+    float Score(const FString& Endpoint, float LoadPenaltyMs) const;
+
+    /** Best scoring reachable endpoint of Endpoints, or empty */
+    FString PickBest(const TArray<FString>& Endpoints, float LoadPenaltyMs) const;
+
+    void Reset();
+
+    /** "host:port" of a netcode endpoint; the port defaults to 5000 */
+    static FString MakeEndpoint(const FString& Host, int32 Port);
+
+    // ============ Config ============
+
+    int32 ProbesPerEndpoint = 3;
+    float TimeoutSeconds = 1.0f;
+    float CacheSeconds = 300.0f;
+
+private:
+    struct FInFlight
+    {
+        FString Endpoint;
+        double SentAt = 0.0;
+    };
+
+    bool EnsureSocket();
+
+    /** The echo address of an endpoint, resolved once per session */
+    TSharedPtr<FInternetAddr> Resolve(const FString& Endpoint);
+    void FinishRound();
+
+    FSocket* Socket = nullptr;
+    ISocketSubsystem* SocketSubsystem = nullptr;
+    TSharedPtr<FInternetAddr> RecvSender;
+    TMap<FString, TSharedPtr<FInternetAddr>> Resolved;
+
+    /** By sequence number */
+    TMap<uint32, FInFlight> InFlight;
+    uint32 NextSequence = 1;
+
+    /** Best RTT seen this round, by endpoint; moved into Results when it closes */
+    TMap<FString, FTowerPingResult> Round;
+    TMap<FString, FTowerPingResult> Results;
+};
@@ -1,5 +1,7 @@
 #include "PlayerSyncComponent.h"
 #include "RemotePlayer.h"
+#include "RemotePlayerInterpolationSubsystem.h"
+#include "NakamaSubsystem.h"
 #include "Player/TowerPlayerCharacter.h"
 #include "Kismet/GameplayStatics.h"
 #include "Dom/JsonObject.h"
@@ -22,7 +24,9 @@ void UPlayerSyncComponent::BeginPlay()
     UMatchConnection* Match = GetMatchConnection();
     if (Match)
     {
-        Match->OnMatchData.AddDynamic(this, &UPlayerSyncComponent::OnMatchDataReceived);
+        // Other op codes are handled elsewhere (GameMode, etc.)
+        Match->GetDispatcher().Subscribe<EMatchOpCode::PlayerPosition, EMatchOpCode::PlayerAttack, EMatchOpCode::PlayerDeath,
+            EMatchOpCode::PlayerJoined, EMatchOpCode::PlayerLeft, EMatchOpCode::ChatMessage>(this, &UPlayerSyncComponent::OnMatchDataReceived);
     }
 }
 
@@ -33,7 +37,7 @@ void UPlayerSyncComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
     UMatchConnection* Match = GetMatchConnection();
     if (Match)
     {
-        Match->OnMatchData.RemoveDynamic(this, &UPlayerSyncComponent::OnMatchDataReceived);
+        Match->GetDispatcher().Unsubscribe(this);
     }
 
     Super::EndPlay(EndPlayReason);
@@ -46,6 +50,20 @@ void UPlayerSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
     if (!bSyncing) return;
 
+    if (bAdaptiveSendRate)
+    {
+        AActor* Owner = GetOwner();
+        UMatchConnection* Match = GetMatchConnection();
+        if (!Owner || !Match || !Match->IsConnected()) return;
+
+        if (SendScheduler.Tick(DeltaTime, Owner->GetActorLocation(), Owner->GetActorRotation().Yaw,
+            IsOwnerInCombat(), GetRoundTripTime(), Match->GetQueuedMessageCount()))
+        {
+            BroadcastLocalPosition();
+        }
+        return;
+    }
+
     // Send local position at configured rate
     SendTimer += DeltaTime;
     float SendInterval = 1.0f / FMath::Max(SendRate, 1.0f);
@@ -57,10 +75,25 @@ void UPlayerSyncComponent::TickComponent(float DeltaTime, ELevelTick TickType,
     }
 }
 
+bool UPlayerSyncComponent::IsOwnerInCombat() const
+{
+    const ATowerPlayerCharacter* Character = Cast<ATowerPlayerCharacter>(GetOwner());
+    return Character && Character->IsInCombat();
+}
+
+float UPlayerSyncComponent::GetRoundTripTime() const
+{
+    const UWorld* World = GetWorld();
+    const URemotePlayerInterpolationSubsystem* Interp = World ? World->GetSubsystem<URemotePlayerInterpolationSubsystem>() : nullptr;
+    return Interp ? Interp->GetRoundTripTime() : 0.0f;
+}
+
 void UPlayerSyncComponent::StartSync()
 {
     bSyncing = true;
     SendTimer = 0.0f;
+    SendScheduler.Configure(SendSettings);
+    SendScheduler.Reset();
     UE_LOG(LogTemp, Log, TEXT("PlayerSync: started"));
 }
 
@@ -74,14 +107,31 @@ void UPlayerSyncComponent::StopSync()
 TArray<ARemotePlayer*> UPlayerSyncComponent::GetRemotePlayers() const
 {
     TArray<ARemotePlayer*> Result;
-    RemotePlayers.GenerateValueArray(Result);
+    Result.Reserve(RemotePlayerCount);
+    for (const FRemotePlayerSlot& Slot : RemotePlayerSlots)
+    {
+        if (Slot.Actor)
+        {
+            Result.Add(Slot.Actor);
+        }
+    }
     return Result;
 }
 
 ARemotePlayer* UPlayerSyncComponent::GetRemotePlayerById(const FString& UserId) const
 {
-    const ARemotePlayer* const* Found = RemotePlayers.Find(UserId);
-    return Found ? const_cast<ARemotePlayer*>(*Found) : nullptr;
+    return GetRemotePlayer(FindHandle(UserId));
+}
+
+int32 UPlayerSyncComponent::FindHandle(const FString& UserId) const
+{
+    const int32* Found = UserHandles.Find(UserId);
+    return Found ? *Found : INDEX_NONE;
+}
+
+ARemotePlayer* UPlayerSyncComponent::GetRemotePlayer(int32 Handle) const
+{
+    return RemotePlayerSlots.IsValidIndex(Handle) ? RemotePlayerSlots[Handle].Actor : nullptr;
 }
 
 UMatchConnection* UPlayerSyncComponent::GetMatchConnection() const
@@ -90,142 +140,173 @@ UMatchConnection* UPlayerSyncComponent::GetMatchConnection() const
     return GI ? GI->GetSubsystem<UMatchConnection>() : nullptr;
 }
 
-void UPlayerSyncComponent::OnMatchDataReceived(EMatchOpCode OpCode, const FString& DataJson)
+bool UPlayerSyncComponent::IsLocalUser(const FString& UserId) const
+{
+    UGameInstance* GI = GetOwner() ? GetOwner()->GetGameInstance() : nullptr;
+    const UNakamaSubsystem* Nakama = GI ? GI->GetSubsystem<UNakamaSubsystem>() : nullptr;
+    return Nakama && !Nakama->UserId.IsEmpty() && Nakama->UserId == UserId;
+}
+
+void UPlayerSyncComponent::OnMatchDataReceived(EMatchOpCode OpCode, const FJsonObject& Json)
 {
-    // Parse sender user ID from the data
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
+    // The server's periodic broadcast carries every player in one message
+    const TSharedPtr<FJsonObject>* PlayersObj = nullptr;
+    if (OpCode == EMatchOpCode::PlayerPosition && Json.TryGetObjectField(TEXT("players"), PlayersObj))
+    {
+        HandlePositionBroadcast(**PlayersObj);
+        return;
+    }
 
-    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid()) return;
+    FMatchPlayerMessage Msg;
+    Msg.UserId = Json.GetStringField(TEXT("user_id"));
+    if (Msg.UserId.IsEmpty()) return;
 
-    FString UserId = Json->GetStringField(TEXT("user_id"));
-    if (UserId.IsEmpty()) return;
+    // Skip messages about self: the local player is simulated here, not replicated
+    if (IsLocalUser(Msg.UserId)) return;
 
-    // Skip messages from self
-    // (In production, the server would filter these)
+    if (!Json.TryGetStringField(TEXT("name"), Msg.Name))
+    {
+        Json.TryGetStringField(TEXT("username"), Msg.Name);
+    }
 
     switch (OpCode)
     {
     case EMatchOpCode::PlayerPosition:
-        HandlePlayerPosition(UserId, DataJson);
+        Msg.Position.X = Json.GetNumberField(TEXT("x"));
+        Msg.Position.Y = Json.GetNumberField(TEXT("y"));
+        Msg.Position.Z = Json.GetNumberField(TEXT("z"));
+        Msg.Rotation.Yaw = Json.GetNumberField(TEXT("yaw"));
+        HandlePlayerPosition(Msg);
         break;
     case EMatchOpCode::PlayerAttack:
-        HandlePlayerAttack(UserId, DataJson);
+        Msg.ComboStep = Json.GetIntegerField(TEXT("combo_step"));
+        Json.TryGetNumberField(TEXT("weapon_type"), Msg.WeaponType);
+        HandlePlayerAttack(Msg);
         break;
     case EMatchOpCode::PlayerDeath:
-        HandlePlayerDeath(UserId, DataJson);
+        HandlePlayerDeath(Msg);
         break;
     case EMatchOpCode::PlayerJoined:
-        HandlePlayerJoined(UserId, DataJson);
+        HandlePlayerJoined(Msg);
         break;
     case EMatchOpCode::PlayerLeft:
-        HandlePlayerLeft(UserId);
+        HandlePlayerLeft(Msg);
         break;
     case EMatchOpCode::ChatMessage:
-        HandleChat(UserId, DataJson);
+        Msg.ChatText = Json.GetStringField(TEXT("message"));
+        HandleChat(Msg);
         break;
     default:
-        break; // Other op codes handled elsewhere (GameMode, etc.)
+        break;
     }
 }
 
-void UPlayerSyncComponent::HandlePlayerPosition(const FString& UserId, const FString& DataJson)
+void UPlayerSyncComponent::HandlePlayerPosition(const FMatchPlayerMessage& Msg)
 {
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
-    if (!FJsonSerializer::Deserialize(Reader, Json)) return;
-
-    FVector Position;
-    Position.X = Json->GetNumberField(TEXT("x"));
-    Position.Y = Json->GetNumberField(TEXT("y"));
-    Position.Z = Json->GetNumberField(TEXT("z"));
-
-    FRotator Rotation;
-    Rotation.Yaw = Json->GetNumberField(TEXT("yaw"));
-
-    ARemotePlayer* Remote = GetRemotePlayerById(UserId);
-    if (!Remote)
+    int32 Handle = FindHandle(Msg.UserId);
+    if (Handle == INDEX_NONE)
     {
         // Auto-spawn if we get position before join message
-        FString Name = Json->HasField(TEXT("name")) ? Json->GetStringField(TEXT("name")) : UserId;
-        Remote = SpawnRemotePlayer(UserId, Name);
+        Handle = SpawnRemotePlayer(Msg.UserId, Msg.Name.IsEmpty() ? Msg.UserId : Msg.Name);
     }
 
-    if (Remote)
+    if (ARemotePlayer* Remote = GetRemotePlayer(Handle))
     {
-        Remote->ApplyPositionUpdate(Position, Rotation);
+        Remote->ApplyPositionUpdate(Msg.Position, Msg.Rotation);
     }
 }
 
-void UPlayerSyncComponent::HandlePlayerAttack(const FString& UserId, const FString& DataJson)
+void UPlayerSyncComponent::HandlePositionBroadcast(const FJsonObject& Players)
 {
-    ARemotePlayer* Remote = GetRemotePlayerById(UserId);
-    if (!Remote) return;
+    FMatchPlayerMessage Msg;
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : Players.Values)
+    {
+        const TSharedPtr<FJsonObject>* PlayerObj = nullptr;
+        const TSharedPtr<FJsonObject>* PositionObj = nullptr;
+        if (!Entry.Value.IsValid() || !Entry.Value->TryGetObject(PlayerObj) ||
+            !(*PlayerObj)->TryGetObjectField(TEXT("position"), PositionObj))
+        {
+            continue;
+        }
+
+        // The broadcast lists every alive player, the local one included
+        if (IsLocalUser(Entry.Key))
+        {
+            continue;
+        }
+
+        Msg.UserId = Entry.Key;
+        Msg.Name.Reset();
+        (*PlayerObj)->TryGetStringField(TEXT("username"), Msg.Name);
+        Msg.Position.X = (*PositionObj)->GetNumberField(TEXT("x"));
+        Msg.Position.Y = (*PositionObj)->GetNumberField(TEXT("y"));
+        Msg.Position.Z = (*PositionObj)->GetNumberField(TEXT("z"));
+
+        // The broadcast has no rotation; keep the remote player's last yaw
+        const int32 Handle = FindHandle(Msg.UserId);
+        if (const ARemotePlayer* Existing = GetRemotePlayer(Handle))
+        {
+            Msg.Rotation = Existing->GetActorRotation();
+        }
+        else
+        {
+            Msg.Rotation = FRotator::ZeroRotator;
+        }
 
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
-    if (!FJsonSerializer::Deserialize(Reader, Json)) return;
+        HandlePlayerPosition(Msg);
+    }
+}
 
-    int32 ComboStep = Json->GetIntegerField(TEXT("combo_step"));
-    int32 WeaponType = Json->HasField(TEXT("weapon_type")) ? Json->GetIntegerField(TEXT("weapon_type")) : 0;
+void UPlayerSyncComponent::HandlePlayerAttack(const FMatchPlayerMessage& Msg)
+{
+    ARemotePlayer* Remote = GetRemotePlayer(FindHandle(Msg.UserId));
+    if (!Remote) return;
 
-    Remote->PlayAttackAnimation(ComboStep, WeaponType);
+    Remote->PlayAttackAnimation(Msg.ComboStep, Msg.WeaponType);
 }
 
-void UPlayerSyncComponent::HandlePlayerDeath(const FString& UserId, const FString& DataJson)
+void UPlayerSyncComponent::HandlePlayerDeath(const FMatchPlayerMessage& Msg)
 {
-    ARemotePlayer* Remote = GetRemotePlayerById(UserId);
+    ARemotePlayer* Remote = GetRemotePlayer(FindHandle(Msg.UserId));
     if (Remote)
     {
         Remote->ShowDeath();
     }
 }
 
-void UPlayerSyncComponent::HandlePlayerJoined(const FString& UserId, const FString& DataJson)
+void UPlayerSyncComponent::HandlePlayerJoined(const FMatchPlayerMessage& Msg)
 {
-    if (RemotePlayers.Contains(UserId)) return; // Already tracked
-
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
-
-    FString DisplayName = UserId;
-    if (FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid())
-    {
-        DisplayName = Json->GetStringField(TEXT("name"));
-    }
+    if (FindHandle(Msg.UserId) != INDEX_NONE) return; // Already tracked
 
-    SpawnRemotePlayer(UserId, DisplayName);
-    UE_LOG(LogTemp, Log, TEXT("Player joined: %s (%s)"), *DisplayName, *UserId);
+    const FString& DisplayName = Msg.Name.IsEmpty() ? Msg.UserId : Msg.Name;
+    SpawnRemotePlayer(Msg.UserId, DisplayName);
+    UE_LOG(LogTemp, Log, TEXT("Player joined: %s (%s)"), *DisplayName, *Msg.UserId);
 }
 
-void UPlayerSyncComponent::HandlePlayerLeft(const FString& UserId)
+void UPlayerSyncComponent::HandlePlayerLeft(const FMatchPlayerMessage& Msg)
 {
-    UE_LOG(LogTemp, Log, TEXT("Player left: %s"), *UserId);
-    DespawnRemotePlayer(UserId);
+    UE_LOG(LogTemp, Log, TEXT("Player left: %s"), *Msg.UserId);
+    DespawnRemotePlayer(FindHandle(Msg.UserId));
 }
 
-void UPlayerSyncComponent::HandleChat(const FString& UserId, const FString& DataJson)
+void UPlayerSyncComponent::HandleChat(const FMatchPlayerMessage& Msg)
 {
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DataJson);
-    if (!FJsonSerializer::Deserialize(Reader, Json)) return;
-
-    FString Message = Json->GetStringField(TEXT("message"));
-    FString Name = Json->HasField(TEXT("name")) ? Json->GetStringField(TEXT("name")) : UserId;
+    const FString& Name = Msg.Name.IsEmpty() ? Msg.UserId : Msg.Name;
 
-    UE_LOG(LogTemp, Log, TEXT("[Chat] %s: %s"), *Name, *Message);
+    UE_LOG(LogTemp, Log, TEXT("[Chat] %s: %s"), *Name, *Msg.ChatText);
     // TODO: Route to chat widget when implemented
 }
 
-ARemotePlayer* UPlayerSyncComponent::SpawnRemotePlayer(const FString& UserId, const FString& DisplayName)
+int32 UPlayerSyncComponent::SpawnRemotePlayer(const FString& UserId, const FString& DisplayName)
 {
-    if (RemotePlayers.Contains(UserId))
+    const int32 Existing = FindHandle(UserId);
+    if (Existing != INDEX_NONE)
     {
-        return RemotePlayers[UserId];
+        return Existing;
     }
 
     UWorld* World = GetWorld();
-    if (!World) return nullptr;
+    if (!World) return INDEX_NONE;
 
     FActorSpawnParameters SpawnParams;
     SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
@@ -240,36 +321,53 @@ ARemotePlayer* UPlayerSyncComponent::SpawnRemotePlayer(const FString& UserId, co
         Remote = World->SpawnActor<ARemotePlayer>(ARemotePlayer::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
     }
 
-    if (Remote)
+    if (!Remote)
     {
-        Remote->UserId = UserId;
-        Remote->DisplayName = DisplayName;
-        RemotePlayers.Add(UserId, Remote);
+        return INDEX_NONE;
     }
 
-    return Remote;
+    Remote->UserId = UserId;
+    Remote->DisplayName = DisplayName;
+
+    const int32 Handle = FreeHandles.Num() > 0 ? FreeHandles.Pop(false) : RemotePlayerSlots.AddDefaulted();
+    RemotePlayerSlots[Handle].Actor = Remote;
+    RemotePlayerSlots[Handle].UserId = UserId;
+    UserHandles.Add(UserId, Handle);
+    ++RemotePlayerCount;
+
+    return Handle;
 }
 
-void UPlayerSyncComponent::DespawnRemotePlayer(const FString& UserId)
+void UPlayerSyncComponent::DespawnRemotePlayer(int32 Handle)
 {
-    ARemotePlayer** Found = RemotePlayers.Find(UserId);
-    if (Found && *Found)
+    if (!RemotePlayerSlots.IsValidIndex(Handle) || !RemotePlayerSlots[Handle].Actor)
     {
-        (*Found)->Destroy();
+        return;
     }
-    RemotePlayers.Remove(UserId);
+
+    FRemotePlayerSlot& Slot = RemotePlayerSlots[Handle];
+    Slot.Actor->Destroy();
+    UserHandles.Remove(Slot.UserId);
+    Slot.Actor = nullptr;
+    Slot.UserId.Reset();
+
+    FreeHandles.Add(Handle);
+    --RemotePlayerCount;
 }
 
 void UPlayerSyncComponent::DespawnAllRemotePlayers()
 {
-    for (auto& Pair : RemotePlayers)
+    for (FRemotePlayerSlot& Slot : RemotePlayerSlots)
     {
-        if (Pair.Value)
+        if (Slot.Actor)
         {
-            Pair.Value->Destroy();
+            Slot.Actor->Destroy();
         }
     }
-    RemotePlayers.Empty();
+    RemotePlayerSlots.Reset();
+    UserHandles.Reset();
+    FreeHandles.Reset();
+    RemotePlayerCount = 0;
 }
 
 void UPlayerSyncComponent::BroadcastLocalPosition()
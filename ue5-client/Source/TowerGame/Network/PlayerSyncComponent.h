@@ -3,16 +3,46 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Network/MatchConnection.h"
+#include "Network/PositionSendScheduler.h"
 #include "PlayerSyncComponent.generated.h"
 
 class ARemotePlayer;
 class ATowerPlayerCharacter;
+class FJsonObject;
+
+/** Slot in the handle-indexed remote player table */
+USTRUCT()
+struct FRemotePlayerSlot
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    ARemotePlayer* Actor = nullptr;
+
+    FString UserId;
+};
+
+/**
+ * One incoming player message, read once in OnMatchDataReceived from the
+ * payload UMatchConnection already parsed.
+ * Only the fields relevant to the op code are filled in.
+ */
+struct FMatchPlayerMessage
+{
+    FString UserId;
+    FString Name;
+    FVector Position = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    int32 ComboStep = 0;
+    int32 WeaponType = 0;
+    FString ChatText;
+};
 
 /**
  * Manages synchronization between local player, remote players, and the match.
  *
  * Responsibilities:
- * - Periodically sends local player position to match (5Hz)
+ * - Sends local player position to match, adaptively (FPositionSendScheduler)
  * - Listens for match data events and routes them
  * - Spawns/despawns ARemotePlayer actors for other players
  * - Applies position updates to remote players with interpolation
@@ -34,10 +64,25 @@ public:
 
     // ============ Config ============
 
-    /** How often to send position updates (Hz) */
+    /** How often to send position updates (Hz) when bAdaptiveSendRate is off */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync")
     float SendRate = 5.0f;
 
+    /** Scale the send rate with speed and combat, skip unchanged positions, back off under congestion */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync")
+    bool bAdaptiveSendRate = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (EditCondition = "bAdaptiveSendRate"))
+    FPositionSendSettings SendSettings;
+
+    /** Position send rate in use right now (Hz) */
+    UFUNCTION(BlueprintPure, Category = "Sync")
+    float GetCurrentSendRate() const { return bAdaptiveSendRate ? SendScheduler.GetCurrentRate() : SendRate; }
+
+    /** Scheduled sends skipped because nothing changed */
+    UFUNCTION(BlueprintPure, Category = "Sync")
+    int32 GetSkippedSendCount() const { return SendScheduler.GetSkippedCount(); }
+
     /** Class to spawn for remote players */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync")
     TSubclassOf<ARemotePlayer> RemotePlayerClass;
@@ -54,7 +99,7 @@ public:
 
     /** Get number of players on this floor (including local) */
     UFUNCTION(BlueprintPure, Category = "Sync")
-    int32 GetPlayerCount() const { return RemotePlayers.Num() + 1; }
+    int32 GetPlayerCount() const { return RemotePlayerCount + 1; }
 
     // ============ Controls ============
 
@@ -70,31 +115,63 @@ public:
     bool IsSyncing() const { return bSyncing; }
 
 private:
+    /**
+     * Remote players indexed by a dense handle. User ids are interned to a
+     * handle when a player joins (or is first seen), so the per-message work
+     * is a single string lookup and everything after that is array indexing.
+     */
     UPROPERTY()
-    TMap<FString, ARemotePlayer*> RemotePlayers;
+    TArray<FRemotePlayerSlot> RemotePlayerSlots;
+
+    /** UserId -> index into RemotePlayerSlots */
+    TMap<FString, int32> UserHandles;
+
+    /** Released handles, reused before the table grows */
+    TArray<int32> FreeHandles;
+
+    int32 RemotePlayerCount = 0;
 
     float SendTimer = 0.0f;
     bool bSyncing = false;
 
+    FPositionSendScheduler SendScheduler;
+
+    /** Whether the owner is attacking, dodging or mid-combo */
+    bool IsOwnerInCombat() const;
+
+    /** Smoothed RTT from the shared remote player interpolation estimate (s) */
+    float GetRoundTripTime() const;
+
     UMatchConnection* GetMatchConnection() const;
 
+    /** True for the local player's own Nakama user id; the server's messages include us */
+    bool IsLocalUser(const FString& UserId) const;
+
     // ============ Event Handlers ============
 
-    UFUNCTION()
-    void OnMatchDataReceived(EMatchOpCode OpCode, const FString& DataJson);
+    /** The player op codes it subscribes to, already parsed off the game thread by UMatchConnection */
+    void OnMatchDataReceived(EMatchOpCode OpCode, const FJsonObject& Json);
+
+    void HandlePlayerPosition(const FMatchPlayerMessage& Msg);
+    void HandlePlayerAttack(const FMatchPlayerMessage& Msg);
+    void HandlePlayerDeath(const FMatchPlayerMessage& Msg);
+    void HandlePlayerJoined(const FMatchPlayerMessage& Msg);
+    void HandlePlayerLeft(const FMatchPlayerMessage& Msg);
+    void HandleChat(const FMatchPlayerMessage& Msg);
+
+    /** Server position broadcast: { players: { <user_id>: { position, username } } } */
+    void HandlePositionBroadcast(const FJsonObject& Players);
+
+    /** Handle for a user id, or INDEX_NONE if not tracked */
+    int32 FindHandle(const FString& UserId) const;
 
-    void HandlePlayerPosition(const FString& UserId, const FString& DataJson);
-    void HandlePlayerAttack(const FString& UserId, const FString& DataJson);
-    void HandlePlayerDeath(const FString& UserId, const FString& DataJson);
-    void HandlePlayerJoined(const FString& UserId, const FString& DataJson);
-    void HandlePlayerLeft(const FString& UserId);
-    void HandleChat(const FString& UserId, const FString& DataJson);
+    ARemotePlayer* GetRemotePlayer(int32 Handle) const;
 
-    /** Spawn a remote player actor */
-    ARemotePlayer* SpawnRemotePlayer(const FString& UserId, const FString& DisplayName);
+    /** Spawn a remote player actor and intern its user id. Returns its handle. */
+    int32 SpawnRemotePlayer(const FString& UserId, const FString& DisplayName);
 
-    /** Despawn a remote player actor */
-    void DespawnRemotePlayer(const FString& UserId);
+    /** Despawn a remote player actor and release its handle */
+    void DespawnRemotePlayer(int32 Handle);
 
     /** Despawn all remote players */
     void DespawnAllRemotePlayers();
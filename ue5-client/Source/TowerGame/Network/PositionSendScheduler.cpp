@@ -0,0 +1,87 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "PositionSendScheduler.h"
+
+void FPositionSendScheduler::Reset()
+{
+    const FPositionSendSettings Saved = Settings;
+    *this = FPositionSendScheduler();
+    Settings = Saved;
+}
+
+float FPositionSendScheduler::ComputeRate(bool bInCombat, float RoundTripTime, int32 QueuedMessages) const
+{
+    const float MinRate = FMath::Min(Settings.MinRate, Settings.MaxRate);
+    const float SpeedAlpha = FMath::Clamp(SmoothedSpeed / Settings.FastSpeed, 0.0f, 1.0f);
+    float Rate = FMath::Lerp(MinRate, Settings.MaxRate, SpeedAlpha);
+
+    // Congestion: sending faster than the link drains only adds queueing delay
+    if (RoundTripTime > Settings.BackoffRTT && Settings.MaxBackoffRTT > Settings.BackoffRTT)
+    {
+        const float Backoff = FMath::Clamp((RoundTripTime - Settings.BackoffRTT) / (Settings.MaxBackoffRTT - Settings.BackoffRTT), 0.0f, 1.0f);
+        Rate = FMath::Lerp(Rate, MinRate, Backoff);
+    }
+    if (QueuedMessages > Settings.BackoffQueueDepth)
+    {
+        Rate *= 0.5f;
+    }
+
+    if (bInCombat)
+    {
+        Rate = FMath::Max(Rate, Settings.CombatRate);
+    }
+
+    return FMath::Max(Rate, MinRate * 0.5f);
+}
+
+bool FPositionSendScheduler::Tick(float DeltaTime, const FVector& Position, float Yaw, bool bInCombat, float RoundTripTime, int32 QueuedMessages)
+{
+    if (bHasFrame && DeltaTime > KINDA_SMALL_NUMBER)
+    {
+        // Light smoothing so one-frame hitches don't spike the rate
+        const float FrameSpeed = FVector::Dist(Position, LastFramePosition) / DeltaTime;
+        SmoothedSpeed += (FrameSpeed - SmoothedSpeed) * FMath::Min(DeltaTime * 10.0f, 1.0f);
+    }
+    LastFramePosition = Position;
+    bHasFrame = true;
+
+    SendTimer += DeltaTime;
+    TimeSinceSend += DeltaTime;
+    CurrentRate = ComputeRate(bInCombat, RoundTripTime, QueuedMessages);
+
+    const float Interval = 1.0f / CurrentRate;
+    if (SendTimer < Interval)
+    {
+        return false;
+    }
+
+    if (bHasSent)
+    {
+        const bool bMoved = FVector::DistSquared(Position, LastSentPosition) >= FMath::Square(Settings.PositionThreshold);
+        const bool bTurned = FMath::Abs(FMath::FindDeltaAngleDegrees(LastSentYaw, Yaw)) >= Settings.YawThreshold;
+        const bool bHeartbeat = Settings.HeartbeatInterval > 0.0f && TimeSinceSend >= Settings.HeartbeatInterval;
+
+        // Came to rest short of the threshold: one last update so others see where we stopped
+        const bool bSettled = SmoothedSpeed < 1.0f && !Position.Equals(LastSentPosition, 1.0f);
+
+        if (!bMoved && !bTurned && !bHeartbeat && !bSettled)
+        {
+            // Keep the timer expired so the first frame that moves goes out at once; count one skip per interval
+            if (SendTimer - LastSkipTime >= Interval)
+            {
+                ++SkippedCount;
+                LastSkipTime = SendTimer;
+            }
+            return false;
+        }
+    }
+
+    SendTimer = 0.0f;
+    LastSkipTime = 0.0f;
+    TimeSinceSend = 0.0f;
+    LastSentPosition = Position;
+    LastSentYaw = Yaw;
+    bHasSent = true;
+    ++SentCount;
+    return true;
+}
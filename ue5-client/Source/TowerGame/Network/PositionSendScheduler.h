@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PositionSendScheduler.generated.h"
+
+/** Tunables for FPositionSendScheduler */
+USTRUCT(BlueprintType)
+struct FPositionSendSettings
+{
+    GENERATED_BODY()
+
+    /** Send rate while barely moving (Hz) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.5", ClampMax = "60.0"))
+    float MinRate = 2.0f;
+
+    /** Send rate at FastSpeed and above (Hz) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.5", ClampMax = "60.0"))
+    float MaxRate = 15.0f;
+
+    /** Floor for the rate while attacking, dodging or in a combo (Hz) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.5", ClampMax = "60.0"))
+    float CombatRate = 10.0f;
+
+    /** Speed (units/s) at which MaxRate is reached */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "1.0"))
+    float FastSpeed = 600.0f;
+
+    /** Position change (units) below which a send is skipped */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.0"))
+    float PositionThreshold = 5.0f;
+
+    /** Yaw change (degrees) below which a send is skipped */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.0"))
+    float YawThreshold = 2.0f;
+
+    /** Resend an unchanged position this often so the server knows we're still here (s, 0 = never) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.0"))
+    float HeartbeatInterval = 5.0f;
+
+    /** RTT (s) from which the rate starts backing off */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.0"))
+    float BackoffRTT = 0.15f;
+
+    /** RTT (s) at which the rate is down to MinRate */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "0.0"))
+    float MaxBackoffRTT = 0.5f;
+
+    /** Outbound messages waiting for the end-of-frame flush beyond which the rate is halved */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync", meta = (ClampMin = "1"))
+    int32 BackoffQueueDepth = 8;
+};
+
+/**
+ * Decides, per frame, whether the local player's position should go out.
+ *
+ * The rate scales with movement speed between MinRate and MaxRate, never drops
+ * below CombatRate in a fight, and backs off when RTT or the outbound queue
+ * grows (combat keeps its floor so hits stay responsive). When a send is due
+ * but the position and yaw moved less than the thresholds it is skipped, so a
+ * player standing still only sends a heartbeat.
+ *
+ * Game thread only.
+ */
+class TOWERGAME_API FPositionSendScheduler
+{
+public:
+    void Configure(const FPositionSendSettings& InSettings) { Settings = InSettings; }
+    const FPositionSendSettings& GetSettings() const { return Settings; }
+
+    /** Advance by DeltaTime; true when a position update should be sent now */
+    bool Tick(float DeltaTime, const FVector& Position, float Yaw, bool bInCombat, float RoundTripTime, int32 QueuedMessages);
+
+    void Reset();
+
+    /** Rate chosen on the last Tick (Hz) */
+    float GetCurrentRate() const { return CurrentRate; }
+
+    int32 GetSentCount() const { return SentCount; }
+    int32 GetSkippedCount() const { return SkippedCount; }
+
+private:
+    float ComputeRate(bool bInCombat, float RoundTripTime, int32 QueuedMessages) const;
+
+    FPositionSendSettings Settings;
+
+    FVector LastSentPosition = FVector::ZeroVector;
+    float LastSentYaw = 0.0f;
+    FVector LastFramePosition = FVector::ZeroVector;
+    float SmoothedSpeed = 0.0f;
+    float SendTimer = 0.0f;
+    float LastSkipTime = 0.0f;
+    float TimeSinceSend = 0.0f;
+    float CurrentRate = 0.0f;
+    bool bHasSent = false;
+    bool bHasFrame = false;
+
+    int32 SentCount = 0;
+    int32 SkippedCount = 0;
+};
@@ -0,0 +1,173 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Minimal protobuf wire-format helpers (no libprotobuf).
+ *
+ * Enough to hand-decode the handful of messages the client reads on hot paths
+ * (Nakama's realtime Envelope, tower.game.ChunkData) in a single forward pass
+ * straight out of the receive buffer, and to write them back.
+ */
+namespace ProtoWire
+{
+    enum EWireType : uint32
+    {
+        Varint          = 0,
+        Fixed64         = 1,
+        LengthDelimited = 2,
+        Fixed32         = 5,
+    };
+
+    inline void WriteVarint(TArray<uint8>& Out, uint64 Value)
+    {
+        while (Value >= 0x80)
+        {
+            Out.Add(static_cast<uint8>(Value | 0x80));
+            Value >>= 7;
+        }
+        Out.Add(static_cast<uint8>(Value));
+    }
+
+    inline void WriteTag(TArray<uint8>& Out, uint32 Field, EWireType WireType)
+    {
+        WriteVarint(Out, (static_cast<uint64>(Field) << 3) | WireType);
+    }
+
+    inline void WriteBytes(TArray<uint8>& Out, uint32 Field, TArrayView<const uint8> Bytes)
+    {
+        WriteTag(Out, Field, LengthDelimited);
+        WriteVarint(Out, static_cast<uint64>(Bytes.Num()));
+        Out.Append(Bytes.GetData(), Bytes.Num());
+    }
+
+    /** Varint field, omitted at 0 as proto3 does; int32 values must be sign-extended by the caller */
+    inline void WriteVarintField(TArray<uint8>& Out, uint32 Field, uint64 Value)
+    {
+        if (Value != 0)
+        {
+            WriteTag(Out, Field, Varint);
+            WriteVarint(Out, Value);
+        }
+    }
+
+    /** float field, omitted at 0 */
+    inline void WriteFloatField(TArray<uint8>& Out, uint32 Field, float Value)
+    {
+        if (Value != 0.0f)
+        {
+            uint32 Bits;
+            FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+            WriteTag(Out, Field, Fixed32);
+            const uint8 Bytes[4] = { static_cast<uint8>(Bits), static_cast<uint8>(Bits >> 8),
+                static_cast<uint8>(Bits >> 16), static_cast<uint8>(Bits >> 24) };
+            Out.Append(Bytes, 4);
+        }
+    }
+
+    inline int32 VarintSize(uint64 Value)
+    {
+        int32 Size = 1;
+        while (Value >= 0x80)
+        {
+            Value >>= 7;
+            ++Size;
+        }
+        return Size;
+    }
+
+    /** Forward-only reader over one message; any malformed input sets bError */
+    struct FReader
+    {
+        const uint8* Cur;
+        const uint8* End;
+        bool bError = false;
+
+        explicit FReader(TArrayView<const uint8> Bytes)
+            : Cur(Bytes.GetData()), End(Bytes.GetData() + Bytes.Num())
+        {
+        }
+
+        bool AtEnd() const { return bError || Cur >= End; }
+
+        uint64 ReadVarint()
+        {
+            uint64 Value = 0;
+            for (int32 Shift = 0; Shift < 64 && Cur < End; Shift += 7)
+            {
+                const uint8 Byte = *Cur++;
+                Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+                if ((Byte & 0x80) == 0)
+                {
+                    return Value;
+                }
+            }
+            bError = true;
+            return 0;
+        }
+
+        bool ReadTag(uint32& OutField, uint32& OutWireType)
+        {
+            const uint64 Tag = ReadVarint();
+            OutField = static_cast<uint32>(Tag >> 3);
+            OutWireType = static_cast<uint32>(Tag & 7);
+            return !bError;
+        }
+
+        TArrayView<const uint8> ReadLengthDelimited()
+        {
+            const uint64 Len = ReadVarint();
+            if (bError || Len > static_cast<uint64>(End - Cur))
+            {
+                bError = true;
+                return TArrayView<const uint8>();
+            }
+            TArrayView<const uint8> Result(Cur, static_cast<int32>(Len));
+            Cur += Len;
+            return Result;
+        }
+
+        /** Little-endian 32-bit payload (fixed32, sfixed32, float) */
+        uint32 ReadFixed32()
+        {
+            if (End - Cur < 4)
+            {
+                bError = true;
+                Cur = End;
+                return 0;
+            }
+            const uint32 Value = static_cast<uint32>(Cur[0])
+                | (static_cast<uint32>(Cur[1]) << 8)
+                | (static_cast<uint32>(Cur[2]) << 16)
+                | (static_cast<uint32>(Cur[3]) << 24);
+            Cur += 4;
+            return Value;
+        }
+
+        float ReadFloat()
+        {
+            const uint32 Bits = ReadFixed32();
+            float Value;
+            FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+            return Value;
+        }
+
+        void Skip(uint32 WireType)
+        {
+            switch (WireType)
+            {
+                case Varint:          ReadVarint(); break;
+                case Fixed64:         Cur += 8; break;
+                case LengthDelimited: ReadLengthDelimited(); break;
+                case Fixed32:         Cur += 4; break;
+                default:              bError = true; break;
+            }
+            if (Cur > End)
+            {
+                bError = true;
+            }
+        }
+    };
+}
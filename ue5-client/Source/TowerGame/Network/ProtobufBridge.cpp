@@ -3,6 +3,8 @@
 // Session 28 - FFI Integration
 
 #include "ProtobufBridge.h"
+#include "ProtoWire.h"
+#include "Core/TowerLog.h"
 #include "Misc/Base64.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
@@ -154,12 +156,239 @@ FProtoChunkData FProtoChunkData::FromJson(const FString& JsonString)
     return Result;
 }
 
+bool FProtoChunkData::ExpandPackedTiles()
+{
+    Tiles.Reserve(Tiles.Num() + PackedTiles.Num());
+    return PackedTiles.ForEachRun([this](int32 Start, int32 Count, uint8 TileType)
+    {
+        for (int32 Index = Start; Index < Start + Count; ++Index)
+        {
+            Tiles.Add(UProtobufBridge::MakePackedTile(PackedTiles, Index, TileType));
+        }
+    });
+}
+
 // ============================================================================
 // UProtobufBridge Implementation
 // ============================================================================
 
+// Field numbers from shared/proto/game_state.proto
+//   ChunkData      1 seed, 2 floor_id, 3 tiles, 4 validation_hash, 5 biome_id,
+//                  6 width, 7 height, 8 world_offset, 9 semantic_tags (skipped),
+//                  10 packed_tiles (FPackedTileGrid blob)
+//   FloorTileData  1 tile_type, 2 grid_x, 3 grid_y, 4 biome_id, 5 is_walkable, 6 has_collision
+//   Vec3           1 x, 2 y, 3 z (float)
+
+bool UProtobufBridge::DecodeFloorTile(TArrayView<const uint8> Bytes, FProtoFloorTileData& OutTile)
+{
+    ProtoWire::FReader Reader(Bytes);
+
+    // proto3 omits defaults, so start from them rather than the struct's own defaults
+    OutTile = FProtoFloorTileData();
+    OutTile.bIsWalkable = false;
+
+    uint32 Field, WireType;
+    while (!Reader.AtEnd() && Reader.ReadTag(Field, WireType))
+    {
+        if (WireType != ProtoWire::Varint)
+        {
+            Reader.Skip(WireType);
+            continue;
+        }
+
+        // int32 fields are sign-extended to 64 bits on the wire; truncation restores them
+        const uint64 Value = Reader.ReadVarint();
+        switch (Field)
+        {
+            case 1: OutTile.TileType = static_cast<int32>(Value); break;
+            case 2: OutTile.GridX = static_cast<int32>(Value); break;
+            case 3: OutTile.GridY = static_cast<int32>(Value); break;
+            case 4: OutTile.BiomeId = static_cast<int32>(Value); break;
+            case 5: OutTile.bIsWalkable = Value != 0; break;
+            case 6: OutTile.bHasCollision = Value != 0; break;
+            default: break;
+        }
+    }
+
+    return !Reader.bError;
+}
+
+bool UProtobufBridge::DecodeChunkField(ProtoWire::FReader& Reader, FProtoChunkData& OutChunk)
+{
+    uint32 Field, WireType;
+    if (!Reader.ReadTag(Field, WireType))
+    {
+        return false;
+    }
+
+    switch (Field)
+    {
+        case 1:
+            if (WireType != ProtoWire::Varint) { Reader.Skip(WireType); break; }
+            OutChunk.Seed = static_cast<int64>(Reader.ReadVarint());
+            break;
+        case 2:
+            if (WireType != ProtoWire::Varint) { Reader.Skip(WireType); break; }
+            OutChunk.FloorId = static_cast<int32>(Reader.ReadVarint());
+            break;
+        case 3:
+        {
+            if (WireType != ProtoWire::LengthDelimited) { Reader.Skip(WireType); break; }
+            const TArrayView<const uint8> TileBytes = Reader.ReadLengthDelimited();
+            if (!Reader.bError && !DecodeFloorTile(TileBytes, OutChunk.Tiles.AddDefaulted_GetRef()))
+            {
+                return false;
+            }
+            break;
+        }
+        case 4:
+        {
+            if (WireType != ProtoWire::LengthDelimited) { Reader.Skip(WireType); break; }
+            const TArrayView<const uint8> Hash = Reader.ReadLengthDelimited();
+            OutChunk.ValidationHash.Append(Hash.GetData(), Hash.Num());
+            break;
+        }
+        case 5:
+            if (WireType != ProtoWire::Varint) { Reader.Skip(WireType); break; }
+            OutChunk.BiomeId = static_cast<int32>(Reader.ReadVarint());
+            break;
+        case 6:
+            if (WireType != ProtoWire::Varint) { Reader.Skip(WireType); break; }
+            OutChunk.Width = static_cast<int32>(Reader.ReadVarint());
+            break;
+        case 7:
+            if (WireType != ProtoWire::Varint) { Reader.Skip(WireType); break; }
+            OutChunk.Height = static_cast<int32>(Reader.ReadVarint());
+            break;
+        case 8:
+        {
+            if (WireType != ProtoWire::LengthDelimited) { Reader.Skip(WireType); break; }
+            ProtoWire::FReader Offset(Reader.ReadLengthDelimited());
+            uint32 VecField, VecWireType;
+            while (!Offset.AtEnd() && Offset.ReadTag(VecField, VecWireType))
+            {
+                if (VecWireType != ProtoWire::Fixed32)
+                {
+                    Offset.Skip(VecWireType);
+                    continue;
+                }
+                const float Value = Offset.ReadFloat();
+                if (VecField == 1) OutChunk.WorldOffset.X = Value;
+                else if (VecField == 2) OutChunk.WorldOffset.Y = Value;
+                else if (VecField == 3) OutChunk.WorldOffset.Z = Value;
+            }
+            if (Offset.bError)
+            {
+                return false;
+            }
+            break;
+        }
+        case 10:
+        {
+            if (WireType != ProtoWire::LengthDelimited) { Reader.Skip(WireType); break; }
+            const TArrayView<const uint8> Packed = Reader.ReadLengthDelimited();
+            int32 Offset = 0;
+            if (!Reader.bError && (!OutChunk.PackedTiles.Deserialize(Packed, Offset) || Offset != Packed.Num()))
+            {
+                return false;
+            }
+            break;
+        }
+        default:
+            Reader.Skip(WireType);
+            break;
+    }
+
+    return !Reader.bError;
+}
+
+bool UProtobufBridge::DecodeChunkData(TArrayView<const uint8> Bytes, FProtoChunkData& OutChunk)
+{
+    ProtoWire::FReader Reader(Bytes);
+
+    OutChunk = FProtoChunkData();
+    // A tile is ~12-16 bytes on the wire; over-reserving beats regrowing a 10k-tile array
+    OutChunk.Tiles.Reserve(Bytes.Num() / 12);
+
+    while (!Reader.AtEnd())
+    {
+        if (!DecodeChunkField(Reader, OutChunk))
+        {
+            return false;
+        }
+    }
+
+    return !Reader.bError;
+}
+
+void UProtobufBridge::EncodeChunkData(const FProtoChunkData& Chunk, TArray<uint8>& OutBytes)
+{
+    using namespace ProtoWire;
+
+    OutBytes.Reset();
+
+    // int32 fields sign-extend to 64 bits, as the Rust encoder does
+    auto Int32 = [](int32 Value) { return static_cast<uint64>(static_cast<int64>(Value)); };
+
+    WriteVarintField(OutBytes, 1, static_cast<uint64>(Chunk.Seed));
+    WriteVarintField(OutBytes, 2, Int32(Chunk.FloorId));
+
+    // One scratch buffer for every nested message; Reset keeps its capacity
+    TArray<uint8> Nested;
+    for (const FProtoFloorTileData& Tile : Chunk.Tiles)
+    {
+        Nested.Reset();
+        WriteVarintField(Nested, 1, Int32(Tile.TileType));
+        WriteVarintField(Nested, 2, Int32(Tile.GridX));
+        WriteVarintField(Nested, 3, Int32(Tile.GridY));
+        WriteVarintField(Nested, 4, Int32(Tile.BiomeId));
+        WriteVarintField(Nested, 5, Tile.bIsWalkable ? 1 : 0);
+        WriteVarintField(Nested, 6, Tile.bHasCollision ? 1 : 0);
+        WriteBytes(OutBytes, 3, Nested);
+    }
+
+    if (Chunk.ValidationHash.Num() > 0)
+    {
+        WriteBytes(OutBytes, 4, Chunk.ValidationHash);
+    }
+    WriteVarintField(OutBytes, 5, Int32(Chunk.BiomeId));
+    WriteVarintField(OutBytes, 6, Int32(Chunk.Width));
+    WriteVarintField(OutBytes, 7, Int32(Chunk.Height));
+
+    Nested.Reset();
+    WriteFloatField(Nested, 1, Chunk.WorldOffset.X);
+    WriteFloatField(Nested, 2, Chunk.WorldOffset.Y);
+    WriteFloatField(Nested, 3, Chunk.WorldOffset.Z);
+    if (Nested.Num() > 0)
+    {
+        WriteBytes(OutBytes, 8, Nested);
+    }
+
+    if (!Chunk.PackedTiles.IsEmpty())
+    {
+        Nested.Reset();
+        Chunk.PackedTiles.Serialize(Nested);
+        WriteBytes(OutBytes, 10, Nested);
+    }
+}
+
 FProtoChunkData UProtobufBridge::DeserializeChunkData(const TArray<uint8>& ProtobufBytes)
 {
+    FProtoChunkData Native;
+    if (DecodeChunkData(ProtobufBytes, Native))
+    {
+        // Blueprint callers walk Tiles, so a packed grid is expanded here
+        if (Native.Tiles.Num() == 0 && !Native.PackedTiles.IsEmpty() && !Native.ExpandPackedTiles())
+        {
+            TOWER_SLOG(Protobuf, Warn, TEXT("ChunkPackedTilesMalformed"), TEXT("FloorId"), Native.FloorId);
+            Native.Tiles.Reset();
+        }
+        TOWER_SLOG(Protobuf, Debug, TEXT("ChunkDecoded"), TEXT("FloorId"), Native.FloorId, TEXT("Tiles"), Native.Tiles.Num());
+        return Native;
+    }
+
+    TOWER_SLOG(Protobuf, Warn, TEXT("ChunkNotProtobuf"), TEXT("Bytes"), ProtobufBytes.Num(), TEXT("Fallback"), TEXT("FFI"));
+
     // Use Rust FFI for Protobuf deserialization (no libprotobuf.lib needed!)
     if (!LoadBevyDll())
     {
@@ -183,7 +412,7 @@ FProtoChunkData UProtobufBridge::DeserializeChunkData(const TArray<uint8>& Proto
     FreeString(JsonCStr); // Free Rust-allocated string
 
     FProtoChunkData Result = FProtoChunkData::FromJson(JsonString);
-    UE_LOG(LogTemp, Log, TEXT("✅ Deserialized ChunkData via Rust FFI: floor_id=%d, tiles=%d"), Result.FloorId, Result.Tiles.Num());
+    TOWER_SLOG(Protobuf, Info, TEXT("ChunkDecodedFFI"), TEXT("FloorId"), Result.FloorId, TEXT("Tiles"), Result.Tiles.Num());
 
     return Result;
 }
@@ -209,8 +438,8 @@ bool UProtobufBridge::ValidateChunkHash(const FProtoChunkData& ChunkData, const
     // Simple validation - check if hashes match
     if (ChunkData.ValidationHash.Num() != ExpectedHash.Num())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Chunk hash length mismatch: %d vs %d"),
-            ChunkData.ValidationHash.Num(), ExpectedHash.Num());
+        TOWER_SLOG(Protobuf, Warn, TEXT("ChunkHashMismatch"), TEXT("Len"), ChunkData.ValidationHash.Num(),
+            TEXT("ExpectedLen"), ExpectedHash.Num());
         return false;
     }
 
@@ -218,15 +447,61 @@ bool UProtobufBridge::ValidateChunkHash(const FProtoChunkData& ChunkData, const
     {
         if (ChunkData.ValidationHash[i] != ExpectedHash[i])
         {
-            UE_LOG(LogTemp, Warning, TEXT("Chunk hash mismatch at byte %d"), i);
+            TOWER_SLOG(Protobuf, Warn, TEXT("ChunkHashMismatch"), TEXT("FloorId"), ChunkData.FloorId, TEXT("Byte"), i);
             return false;
         }
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Chunk hash validation PASSED"));
+    TOWER_SLOG(Protobuf, Debug, TEXT("ChunkHashValid"), TEXT("FloorId"), ChunkData.FloorId);
     return true;
 }
 
+void UProtobufBridge::HashTile(FSha3_256& Hasher, const FProtoFloorTileData& Tile)
+{
+    // Field order and widths follow compute_validation_hash in async_generation.rs
+    Hasher.UpdateU32(static_cast<uint32>(Tile.TileType));
+    Hasher.UpdateU32(static_cast<uint32>(Tile.GridX));
+    Hasher.UpdateU32(static_cast<uint32>(Tile.GridY));
+    Hasher.UpdateU32(static_cast<uint32>(Tile.BiomeId));
+}
+
+FProtoFloorTileData UProtobufBridge::MakePackedTile(const FPackedTileGrid& Grid, int32 Index, uint8 TileType)
+{
+    FProtoFloorTileData Tile;
+    Tile.TileType = TileType;
+    Tile.GridX = Index % Grid.Width;
+    Tile.GridY = Index / Grid.Width;
+    Tile.BiomeId = Grid.GetBiome(Tile.GridX, Tile.GridY);
+    // TileType::is_walkable / has_collision in bevy-server/src/wfc.rs
+    Tile.bIsWalkable = TileType != 0 && TileType != 2 && TileType != 11;
+    Tile.bHasCollision = TileType == 2;
+    return Tile;
+}
+
+TArray<uint8> UProtobufBridge::ComputeChunkHash(const FProtoChunkData& ChunkData)
+{
+    FSha3_256 Hasher;
+    Hasher.UpdateU64(static_cast<uint64>(ChunkData.Seed));
+    for (const FProtoFloorTileData& Tile : ChunkData.Tiles)
+    {
+        HashTile(Hasher, Tile);
+    }
+    if (ChunkData.Tiles.Num() == 0)
+    {
+        ChunkData.PackedTiles.ForEachRun([&Hasher, &ChunkData](int32 Start, int32 Count, uint8 TileType)
+        {
+            for (int32 Index = Start; Index < Start + Count; ++Index)
+            {
+                HashTile(Hasher, MakePackedTile(ChunkData.PackedTiles, Index, TileType));
+            }
+        });
+    }
+
+    TArray<uint8> Digest;
+    Hasher.Final(Digest);
+    return Digest;
+}
+
 float UProtobufBridge::GetBandwidthSavingsRatio(int32 TileCount)
 {
     // Estimate based on benchmarks:
@@ -241,6 +516,251 @@ float UProtobufBridge::GetBandwidthSavingsRatio(int32 TileCount)
     return FullMeshSize / ProceduralSize;
 }
 
+// ============================================================================
+// FChunkStreamDecoder
+// ============================================================================
+
+namespace
+{
+    enum class EFieldScan : uint8 { Complete, NeedMore, Malformed };
+
+    /** Find the end of the top-level field at the front of Bytes without decoding it */
+    EFieldScan ScanField(TArrayView<const uint8> Bytes, int32& OutSize)
+    {
+        // A varint that ran off the end of the input is unfinished, not malformed
+        auto Truncated = [](const ProtoWire::FReader& Reader)
+        {
+            return Reader.Cur >= Reader.End ? EFieldScan::NeedMore : EFieldScan::Malformed;
+        };
+
+        ProtoWire::FReader Reader(Bytes);
+        uint32 Field, WireType;
+        if (!Reader.ReadTag(Field, WireType))
+        {
+            return Truncated(Reader);
+        }
+
+        int64 Remaining = Reader.End - Reader.Cur;
+        switch (WireType)
+        {
+            case ProtoWire::Varint:
+                Reader.ReadVarint();
+                if (Reader.bError)
+                {
+                    return Truncated(Reader);
+                }
+                break;
+            case ProtoWire::Fixed64:
+                if (Remaining < 8) return EFieldScan::NeedMore;
+                Reader.Cur += 8;
+                break;
+            case ProtoWire::Fixed32:
+                if (Remaining < 4) return EFieldScan::NeedMore;
+                Reader.Cur += 4;
+                break;
+            case ProtoWire::LengthDelimited:
+            {
+                const uint64 Len = Reader.ReadVarint();
+                if (Reader.bError)
+                {
+                    return Truncated(Reader);
+                }
+                Remaining = Reader.End - Reader.Cur;
+                if (Len > static_cast<uint64>(Remaining))
+                {
+                    return EFieldScan::NeedMore;
+                }
+                Reader.Cur += Len;
+                break;
+            }
+            default:
+                return EFieldScan::Malformed;
+        }
+
+        OutSize = static_cast<int32>(Reader.Cur - Bytes.GetData());
+        return EFieldScan::Complete;
+    }
+}
+
+FChunkStreamDecoder::FChunkStreamDecoder(int32 InRowsPerBatch)
+    : RowsPerBatch(FMath::Max(1, InRowsPerBatch))
+{
+}
+
+void FChunkStreamDecoder::Reset()
+{
+    Chunk = FProtoChunkData();
+    Pending.Reset();
+    BatchStart = 0;
+    RowsInBatch = 0;
+    Hasher.Reset();
+    ComputedHash.Reset();
+    bSeedHashed = false;
+    bRehashOnFinish = false;
+    bHashValid = false;
+    bFailed = false;
+}
+
+bool FChunkStreamDecoder::Feed(TArrayView<const uint8> Bytes)
+{
+    if (bFailed)
+    {
+        return false;
+    }
+
+    // Decode straight out of the caller's buffer when nothing is carried over
+    if (Pending.Num() == 0)
+    {
+        const int32 Used = DecodeAvailable(Bytes);
+        if (Used == INDEX_NONE)
+        {
+            bFailed = true;
+            return false;
+        }
+        Pending.Append(Bytes.GetData() + Used, Bytes.Num() - Used);
+    }
+    else
+    {
+        Pending.Append(Bytes.GetData(), Bytes.Num());
+        const int32 Used = DecodeAvailable(Pending);
+        if (Used == INDEX_NONE)
+        {
+            bFailed = true;
+            return false;
+        }
+        Pending.RemoveAt(0, Used, /*bAllowShrinking=*/false);
+    }
+
+    return true;
+}
+
+int32 FChunkStreamDecoder::DecodeAvailable(TArrayView<const uint8> Bytes)
+{
+    int32 Consumed = 0;
+    while (Consumed < Bytes.Num())
+    {
+        const TArrayView<const uint8> Rest = Bytes.Slice(Consumed, Bytes.Num() - Consumed);
+
+        int32 FieldSize = 0;
+        const EFieldScan Scan = ScanField(Rest, FieldSize);
+        if (Scan == EFieldScan::NeedMore)
+        {
+            break;
+        }
+        if (Scan == EFieldScan::Malformed)
+        {
+            return INDEX_NONE;
+        }
+
+        ProtoWire::FReader Reader(Rest.Slice(0, FieldSize));
+        const int32 TilesBefore = Chunk.Tiles.Num();
+        const int64 SeedBefore = Chunk.Seed;
+        if (!UProtobufBridge::DecodeChunkField(Reader, Chunk))
+        {
+            return INDEX_NONE;
+        }
+
+        if (Chunk.Seed != SeedBefore && bSeedHashed)
+        {
+            // Out of canonical field order; the running digest started from the wrong seed
+            bRehashOnFinish = true;
+        }
+        if (Chunk.Tiles.Num() != TilesBefore)
+        {
+            AddTile(Chunk.Tiles.Last());
+        }
+        else if (!Chunk.PackedTiles.IsEmpty() && Chunk.Tiles.Num() == 0 && !AddPackedTiles())
+        {
+            return INDEX_NONE;
+        }
+
+        Consumed += FieldSize;
+    }
+
+    return Consumed;
+}
+
+void FChunkStreamDecoder::AddTile(const FProtoFloorTileData& Tile)
+{
+    if (!bSeedHashed)
+    {
+        // proto3 omits a zero seed, so the first tile is the last point it can still show up
+        Hasher.UpdateU64(static_cast<uint64>(Chunk.Seed));
+        bSeedHashed = true;
+    }
+    UProtobufBridge::HashTile(Hasher, Tile);
+
+    // Chunk.Tiles already holds Tile; a new row starts when grid_y changes
+    const int32 NewIndex = Chunk.Tiles.Num() - 1;
+    if (NewIndex > BatchStart && Chunk.Tiles[NewIndex - 1].GridY != Tile.GridY)
+    {
+        if (++RowsInBatch >= RowsPerBatch)
+        {
+            // Hand out the finished rows; Tile opens the next batch
+            const int32 End = NewIndex;
+            OnTileBatch.ExecuteIfBound(TArrayView<const FProtoFloorTileData>(Chunk.Tiles.GetData() + BatchStart, End - BatchStart));
+            BatchStart = End;
+            RowsInBatch = 0;
+        }
+    }
+}
+
+bool FChunkStreamDecoder::AddPackedTiles()
+{
+    const FPackedTileGrid& Grid = Chunk.PackedTiles;
+    Chunk.Tiles.Reserve(Grid.Num());
+    return Grid.ForEachRun([this, &Grid](int32 Start, int32 Count, uint8 TileType)
+    {
+        for (int32 Index = Start; Index < Start + Count; ++Index)
+        {
+            AddTile(Chunk.Tiles.Add_GetRef(UProtobufBridge::MakePackedTile(Grid, Index, TileType)));
+        }
+    });
+}
+
+void FChunkStreamDecoder::FlushBatch()
+{
+    if (BatchStart < Chunk.Tiles.Num())
+    {
+        OnTileBatch.ExecuteIfBound(TArrayView<const FProtoFloorTileData>(Chunk.Tiles.GetData() + BatchStart, Chunk.Tiles.Num() - BatchStart));
+        BatchStart = Chunk.Tiles.Num();
+    }
+    RowsInBatch = 0;
+}
+
+bool FChunkStreamDecoder::Finish()
+{
+    if (!bFailed && Pending.Num() > 0)
+    {
+        TOWER_SLOG(Protobuf, Warn, TEXT("ChunkStreamTruncated"), TEXT("LeftOver"), Pending.Num());
+        bFailed = true;
+    }
+
+    FlushBatch();
+
+    if (bRehashOnFinish)
+    {
+        ComputedHash = UProtobufBridge::ComputeChunkHash(Chunk);
+    }
+    else
+    {
+        if (!bSeedHashed)
+        {
+            Hasher.UpdateU64(static_cast<uint64>(Chunk.Seed));
+            bSeedHashed = true;
+        }
+        Hasher.Final(ComputedHash);
+    }
+
+    bHashValid = !bFailed && ComputedHash == Chunk.ValidationHash;
+    if (!bFailed && !bHashValid)
+    {
+        TOWER_SLOG(Protobuf, Warn, TEXT("ChunkHashMismatch"), TEXT("FloorId"), Chunk.FloorId, TEXT("Tiles"), Chunk.Tiles.Num(), TEXT("Streamed"), true);
+    }
+
+    return !bFailed;
+}
+
 // ============================================================================
 // Helper Functions (TODO: Move to separate file if this grows)
 // ============================================================================
@@ -8,8 +8,13 @@
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Sha3.h"
+#include "NetQuantize.h"
+#include "Core/PackedTileGrid.h"
 #include "ProtobufBridge.generated.h"
 
+namespace ProtoWire { struct FReader; }
+
 // Rust FFI functions (tower_bevy_server.dll)
 extern "C"
 {
@@ -52,6 +57,21 @@ struct TOWERGAME_API FProtoVec3
         FVector Meters = UE5Vec / 100.0f;
         return FProtoVec3(Meters.Y, Meters.Z, Meters.X);
     }
+
+    // EntitySnapshot.position_q: floor-local u16 steps packed in one varint (NetQuantize.h).
+    // Frame is the floor's bounds in Bevy space, the same space as X/Y/Z.
+    uint64 ToQuantized(const FNetQuantizeFrame& Frame) const
+    {
+        uint16 Steps[3];
+        Frame.Quantize(FVector(X, Y, Z), Steps);
+        return NetQuantize::PackPosition(Steps);
+    }
+
+    static FProtoVec3 FromQuantized(const FNetQuantizeFrame& Frame, uint64 Packed)
+    {
+        const FVector Bevy = NetQuantize::UnpackPosition(Frame, Packed);
+        return FProtoVec3(Bevy.X, Bevy.Y, Bevy.Z);
+    }
 };
 
 /**
@@ -114,6 +134,18 @@ struct TOWERGAME_API FProtoChunkData
     UPROPERTY(BlueprintReadWrite, Category = "Protobuf")
     FProtoVec3 WorldOffset;
 
+    /**
+     * packed_tiles: the grid run-length encoded, when the sender used it instead of
+     * Tiles. Decoded chunks keep it packed; ExpandPackedTiles fills Tiles on demand.
+     */
+    FPackedTileGrid PackedTiles;
+
+    /** Append PackedTiles' cells to Tiles (row-major, coordinates from 0,0); false if it is malformed */
+    bool ExpandPackedTiles();
+
+    /** Tiles, or the packed grid's cell count when only that is present */
+    int32 GetTileCount() const { return Tiles.Num() > 0 ? Tiles.Num() : PackedTiles.Num(); }
+
     // Serialize to JSON (fallback until Protobuf lib is integrated)
     FString ToJson() const;
 
@@ -121,6 +153,87 @@ struct TOWERGAME_API FProtoChunkData
     static FProtoChunkData FromJson(const FString& JsonString);
 };
 
+DECLARE_DELEGATE_OneParam(FOnChunkTileBatch, TArrayView<const FProtoFloorTileData> /*Tiles*/);
+
+/**
+ * Incremental ChunkData decoder for floors that arrive in pieces.
+ *
+ * Feed() takes arbitrary slices of the serialized message as they come off the wire.
+ * Every complete top-level field is decoded immediately; tiles are handed out through
+ * OnTileBatch every RowsPerBatch rows (the server emits them row-major), so the floor
+ * can be built while the rest is still downloading. The validation hash is accumulated
+ * tile by tile and compared with the chunk's validation_hash in Finish().
+ *
+ * Usage:
+ *   FChunkStreamDecoder Decoder;
+ *   Decoder.OnTileBatch.BindUObject(Renderer, ...);
+ *   Decoder.Feed(Part1); Decoder.Feed(Part2); ...
+ *   if (Decoder.Finish() && Decoder.IsHashValid()) { ... }
+ */
+class TOWERGAME_API FChunkStreamDecoder
+{
+public:
+    explicit FChunkStreamDecoder(int32 InRowsPerBatch = 4);
+
+    /** Fired with each batch of decoded tiles; the view is valid for the duration of the call */
+    FOnChunkTileBatch OnTileBatch;
+
+    /** Decode whatever complete fields Bytes finishes. Returns false once the input is malformed. */
+    bool Feed(TArrayView<const uint8> Bytes);
+
+    /** Flush the last batch and check the hash. Returns false if the input was malformed or truncated. */
+    bool Finish();
+
+    /** Start over for a new chunk; keeps the OnTileBatch binding */
+    void Reset();
+
+    /** Valid after Finish(): the hash computed from the received tiles matches validation_hash */
+    bool IsHashValid() const { return bHashValid; }
+
+    bool HasFailed() const { return bFailed; }
+
+    /** Header fields and every tile decoded so far */
+    const FProtoChunkData& GetChunk() const { return Chunk; }
+
+    /** SHA3-256 over seed + tiles, as computed by the server (valid after Finish) */
+    const TArray<uint8>& GetComputedHash() const { return ComputedHash; }
+
+    int32 GetTilesDecoded() const { return Chunk.Tiles.Num(); }
+
+private:
+    /** Decode complete fields from the front of Bytes; returns bytes consumed, or INDEX_NONE if malformed */
+    int32 DecodeAvailable(TArrayView<const uint8> Bytes);
+
+    void AddTile(const FProtoFloorTileData& Tile);
+
+    /** Expand a just-received packed_tiles grid through AddTile, so it batches and hashes like tiles */
+    bool AddPackedTiles();
+
+    void FlushBatch();
+
+    int32 RowsPerBatch;
+    FProtoChunkData Chunk;
+
+    /** Tail of the input that does not yet hold a complete field */
+    TArray<uint8> Pending;
+
+    /** Index into Chunk.Tiles where the unflushed batch starts */
+    int32 BatchStart = 0;
+    int32 RowsInBatch = 0;
+
+    FSha3_256 Hasher;
+    TArray<uint8> ComputedHash;
+
+    /** Seed has been fed to Hasher (it must precede the tiles) */
+    bool bSeedHashed = false;
+
+    /** Seed arrived after tiles had been hashed; Finish() rehashes from Chunk instead */
+    bool bRehashOnFinish = false;
+
+    bool bHashValid = false;
+    bool bFailed = false;
+};
+
 /**
  * ProtobufBridge - Utility class for Protobuf ↔ UE5 conversion
  *
@@ -146,13 +259,27 @@ public:
      * @param ProtobufBytes Raw bytes from Rust server
      * @return Deserialized ChunkData struct
      *
-     * NOTE: Currently using JSON fallback. When Protobuf lib is linked, this will use:
-     *   tower::game::ChunkData proto_chunk;
-     *   proto_chunk.ParseFromArray(ProtobufBytes.GetData(), ProtobufBytes.Num());
+     * Decodes the wire format directly (DecodeChunkData). Input that is not valid
+     * protobuf goes through the Rust protobuf_to_json / JSON fallback as before.
+     * packed_tiles is expanded into Tiles.
      */
     UFUNCTION(BlueprintCallable, Category = "Protobuf")
     static FProtoChunkData DeserializeChunkData(const TArray<uint8>& ProtobufBytes);
 
+    /**
+     * Single-pass decode of tower.game.ChunkData into OutChunk, no intermediate JSON.
+     * Unknown fields (e.g. semantic_tags) are skipped. packed_tiles stays packed in
+     * OutChunk.PackedTiles.
+     * @return False on malformed input; OutChunk is then partially filled
+     */
+    static bool DecodeChunkData(TArrayView<const uint8> Bytes, FProtoChunkData& OutChunk);
+
+    /**
+     * Wire-format encode of tower.game.ChunkData, the inverse of DecodeChunkData.
+     * OutBytes is reset first, so a caller can reuse one buffer across chunks.
+     */
+    static void EncodeChunkData(const FProtoChunkData& Chunk, TArray<uint8>& OutBytes);
+
     /**
      * Serialize ChunkData to binary Protobuf format
      * @param ChunkData UE5 chunk data struct
@@ -170,6 +297,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Protobuf")
     static bool ValidateChunkHash(const FProtoChunkData& ChunkData, const TArray<uint8>& ExpectedHash);
 
+    /**
+     * SHA3-256 over seed and each tile's (tile_type, grid_x, grid_y, biome_id), the same
+     * digest the server stores in validation_hash. FChunkStreamDecoder builds it incrementally.
+     * A chunk with only PackedTiles is hashed cell by cell without expanding it.
+     */
+    static TArray<uint8> ComputeChunkHash(const FProtoChunkData& ChunkData);
+
     /**
      * Get bandwidth savings ratio
      * @param TileCount Number of tiles in floor
@@ -179,6 +313,19 @@ public:
     static float GetBandwidthSavingsRatio(int32 TileCount);
 
 private:
+    friend class FChunkStreamDecoder;
+    friend struct FProtoChunkData;
+
+    static bool DecodeFloorTile(TArrayView<const uint8> Bytes, FProtoFloorTileData& OutTile);
+
+    /** Decode one top-level ChunkData field at Reader, appending tiles to OutChunk */
+    static bool DecodeChunkField(ProtoWire::FReader& Reader, FProtoChunkData& OutChunk);
+
+    static void HashTile(FSha3_256& Hasher, const FProtoFloorTileData& Tile);
+
+    /** One FProtoFloorTileData for cell Index of Grid */
+    static FProtoFloorTileData MakePackedTile(const FPackedTileGrid& Grid, int32 Index, uint8 TileType);
+
     // JSON fallback serialization (temporary until Protobuf lib linked)
     static FString ChunkDataToJson(const FProtoChunkData& ChunkData);
     static FProtoChunkData JsonToChunkData(const FString& JsonString);
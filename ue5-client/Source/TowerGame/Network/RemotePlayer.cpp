@@ -1,12 +1,17 @@
 #include "RemotePlayer.h"
+#include "RemotePlayerInterpolationSubsystem.h"
+#include "World/SignificanceSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/StaticMesh.h"
 
 ARemotePlayer::ARemotePlayer()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Transforms are driven by URemotePlayerInterpolationSubsystem
+    PrimaryActorTick.bCanEverTick = false;
 
     // Disable local movement — position is driven by network
     if (UCharacterMovementComponent* Movement = GetCharacterMovement())
@@ -29,42 +34,113 @@ ARemotePlayer::ARemotePlayer()
     }
     NameplateMesh->SetWorldScale3D(FVector(0.3f, 0.1f, 1.0f));
 
+    // A capsule-sized stand-in at the Impostor tier; Blueprints can swap in a proper impostor
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMesh(
+        TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+    ImpostorMesh = CylinderMesh.Succeeded() ? CylinderMesh.Object : nullptr;
+
     // No collision with local player
     GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
 }
 
-void ARemotePlayer::Tick(float DeltaTime)
+void ARemotePlayer::BeginPlay()
 {
-    Super::Tick(DeltaTime);
+    Super::BeginPlay();
 
-    if (!bHasReceivedUpdate || bIsDead) return;
+    if (URemotePlayerInterpolationSubsystem* Interp = GetInterpolation())
+    {
+        Interp->RegisterPlayer(this);
+    }
 
-    TimeSinceLastUpdate += DeltaTime;
+    // Throttles the movement and mesh component ticks and picks the LOD tier; the
+    // transform stays on the interpolation tick
+    if (UTowerSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTowerSignificanceSubsystem>())
+    {
+        Significance->Register(this, /*bAllowDisable=*/true,
+            FOnTowerSignificanceChanged::CreateUObject(this, &ARemotePlayer::HandleSignificanceChanged));
+    }
+}
+
+void ARemotePlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (URemotePlayerInterpolationSubsystem* Interp = GetInterpolation())
+    {
+        Interp->UnregisterPlayer(this);
+    }
+    if (UTowerSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTowerSignificanceSubsystem>())
+    {
+        Significance->Unregister(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+URemotePlayerInterpolationSubsystem* ARemotePlayer::GetInterpolation() const
+{
+    UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<URemotePlayerInterpolationSubsystem>() : nullptr;
+}
+
+// ============ LOD ============
+
+void ARemotePlayer::HandleSignificanceChanged(ETowerSignificance Significance, float Distance)
+{
+    switch (Significance)
+    {
+    case ETowerSignificance::Near:
+    case ETowerSignificance::Visible:
+        SetLOD(ERemotePlayerLOD::Full);
+        break;
+    case ETowerSignificance::Distant:
+        SetLOD(Distance > ImpostorDistance ? ERemotePlayerLOD::Impostor : ERemotePlayerLOD::Reduced);
+        break;
+    case ETowerSignificance::Dormant:
+    default:
+        SetLOD(ERemotePlayerLOD::Impostor);
+        break;
+    }
+}
+
+void ARemotePlayer::SetLOD(ERemotePlayerLOD NewLOD)
+{
+    if (NewLOD == LOD) return;
+    LOD = NewLOD;
+
+    const bool bFull = NewLOD == ERemotePlayerLOD::Full;
+    const bool bImpostor = NewLOD == ERemotePlayerLOD::Impostor;
 
-    // Interpolate position
-    float Distance = FVector::Dist(GetActorLocation(), TargetPosition);
+    // Position comes from the network at every tier; the movement component only
+    // feeds animation (velocity, ground state), which the lower tiers do without
+    if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+    {
+        Movement->SetComponentTickEnabled(bFull);
+    }
 
-    if (Distance > TeleportThreshold)
+    if (USkeletalMeshComponent* MeshComponent = GetMesh())
     {
-        // Too far — teleport
-        SetActorLocation(TargetPosition);
-        SetActorRotation(TargetRotation);
+        MeshComponent->SetVisibility(!bImpostor);
+        MeshComponent->SetComponentTickEnabled(!bImpostor);
+        if (NewLOD == ERemotePlayerLOD::Reduced)
+        {
+            // Never faster than the significance interval already set
+            MeshComponent->SetComponentTickInterval(
+                FMath::Max(MeshComponent->GetComponentTickInterval(), ReducedAnimTickInterval));
+        }
     }
-    else
+    if (NameplateMesh)
     {
-        // Smooth interpolation
-        FVector NewPos = FMath::VInterpTo(
-            GetActorLocation(), TargetPosition, DeltaTime, InterpSpeed);
-        FRotator NewRot = FMath::RInterpTo(
-            GetActorRotation(), TargetRotation, DeltaTime, RotInterpSpeed);
+        NameplateMesh->SetVisibility(!bImpostor);
+    }
 
-        SetActorLocationAndRotation(NewPos, NewRot);
+    if (URemotePlayerInterpolationSubsystem* Interp = GetInterpolation())
+    {
+        Interp->SetPlayerLOD(this, NewLOD);
     }
+}
 
-    // Calculate speed for animation
-    FVector Velocity = (GetActorLocation() - PreviousPosition) / FMath::Max(DeltaTime, 0.001f);
-    Speed = Velocity.Size2D();
-    PreviousPosition = GetActorLocation();
+void ARemotePlayer::AdvanceVisualState(float DeltaTime)
+{
+    TimeSinceLastUpdate += DeltaTime;
 
     // Reset attack state after brief display
     if (bIsAttacking && TimeSinceLastUpdate > 0.5f)
@@ -76,11 +152,12 @@ void ARemotePlayer::Tick(float DeltaTime)
 
 void ARemotePlayer::ApplyPositionUpdate(FVector NewPosition, FRotator NewRotation)
 {
-    PreviousPosition = GetActorLocation();
-    TargetPosition = NewPosition;
-    TargetRotation = NewRotation;
     TimeSinceLastUpdate = 0.0f;
-    bHasReceivedUpdate = true;
+
+    if (URemotePlayerInterpolationSubsystem* Interp = GetInterpolation())
+    {
+        Interp->PushSample(this, NewPosition, NewRotation);
+    }
 }
 
 void ARemotePlayer::PlayAttackAnimation(int32 ComboStep, int32 WeaponType)
@@ -119,7 +196,10 @@ void ARemotePlayer::Respawn(FVector SpawnLocation)
     CurrentComboStep = 0;
 
     SetActorLocation(SpawnLocation);
-    TargetPosition = SpawnLocation;
+    if (URemotePlayerInterpolationSubsystem* Interp = GetInterpolation())
+    {
+        Interp->ResetPlayer(this, SpawnLocation);
+    }
 
     if (GetMesh())
     {
@@ -5,16 +5,38 @@
 #include "RemotePlayer.generated.h"
 
 class UStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+enum class ETowerSignificance : uint8;
+
+/** How much of a remote player is simulated and drawn, cheapest last */
+UENUM(BlueprintType)
+enum class ERemotePlayerLOD : uint8
+{
+    /** Character, movement component and animation at full rate */
+    Full,
+    /** Character drawn; no movement simulation, animation and transform at a reduced rate */
+    Reduced,
+    /** Character hidden and not ticking; an instance of ImpostorMesh stands in */
+    Impostor,
+};
 
 /**
  * Represents another player on the same floor.
  *
  * Receives position/rotation updates from the match handler via WebSocket
- * and smoothly interpolates between them. Shows combat actions (attacks,
- * dodges, deaths) from the remote player.
+ * and hands them to URemotePlayerInterpolationSubsystem, which moves all
+ * remote players in one batched pass (the actor itself does not tick).
+ * Shows combat actions (attacks, dodges, deaths) from the remote player.
  *
  * Spawned/despawned by UPlayerSyncComponent when PlayerJoined/PlayerLeft
  * op codes are received.
+ *
+ * The LOD tier follows UTowerSignificanceSubsystem: Full while Near or
+ * Visible, Reduced when Distant within ImpostorDistance, Impostor past it (or
+ * Dormant off screen). A hub floor of dozens of players keeps full
+ * characters only for the ones around the camera.
  */
 UCLASS()
 class TOWERGAME_API ARemotePlayer : public ACharacter
@@ -24,7 +46,8 @@ class TOWERGAME_API ARemotePlayer : public ACharacter
 public:
     ARemotePlayer();
 
-    virtual void Tick(float DeltaTime) override;
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // ============ Identity ============
 
@@ -58,19 +81,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "RemotePlayer")
     void Respawn(FVector SpawnLocation);
 
-    // ============ Config ============
+    /** Called by the interpolation subsystem once per frame in place of Tick */
+    void AdvanceVisualState(float DeltaTime);
 
-    /** How fast to interpolate position (units per second) */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RemotePlayer")
-    float InterpSpeed = 15.0f;
-
-    /** Max distance before teleporting instead of interpolating */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RemotePlayer")
-    float TeleportThreshold = 500.0f;
-
-    /** Rotation interpolation speed */
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RemotePlayer")
-    float RotInterpSpeed = 10.0f;
+    /** Index of this player's track in URemotePlayerInterpolationSubsystem */
+    int32 InterpolationHandle = INDEX_NONE;
 
     // ============ Visual State ============
 
@@ -90,10 +105,42 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "RemotePlayer")
     UStaticMeshComponent* NameplateMesh;
 
+    // ============ LOD ============
+
+    UFUNCTION(BlueprintPure, Category = "RemotePlayer|LOD")
+    ERemotePlayerLOD GetLOD() const { return LOD; }
+
+    /** Switch tiers; normally driven by significance, callable for debugging */
+    UFUNCTION(BlueprintCallable, Category = "RemotePlayer|LOD")
+    void SetLOD(ERemotePlayerLOD NewLOD);
+
+    /**
+     * Beyond this camera distance a Distant player becomes an impostor. Read
+     * when the significance bucket changes, so keep it at VisibleDistance.
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RemotePlayer|LOD")
+    float ImpostorDistance = 6000.0f;
+
+    /** Animation tick interval at the Reduced tier */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RemotePlayer|LOD")
+    float ReducedAnimTickInterval = 1.0f / 15.0f;
+
+    /** Drawn instanced in place of the character at the Impostor tier; none hides the player there */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RemotePlayer|LOD")
+    UStaticMesh* ImpostorMesh;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RemotePlayer|LOD")
+    UMaterialInterface* ImpostorMaterial = nullptr;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "RemotePlayer|LOD")
+    FVector ImpostorScale = FVector(0.6f, 0.6f, 1.8f);
+
 private:
-    FVector TargetPosition;
-    FRotator TargetRotation;
-    FVector PreviousPosition;
+    class URemotePlayerInterpolationSubsystem* GetInterpolation() const;
+
+    void HandleSignificanceChanged(ETowerSignificance Significance, float Distance);
+
+    ERemotePlayerLOD LOD = ERemotePlayerLOD::Full;
+
     float TimeSinceLastUpdate = 0.0f;
-    bool bHasReceivedUpdate = false;
 };
@@ -0,0 +1,346 @@
+#include "RemotePlayerInterpolationSubsystem.h"
+#include "RemotePlayer.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+
+void URemotePlayerInterpolationSubsystem::Deinitialize()
+{
+    Tracks.Empty();
+    ImpostorBatches.Empty();
+    ImpostorBatchByMesh.Empty();
+    ImpostorComponents.Empty();
+    ImpostorOwner = nullptr;
+    Super::Deinitialize();
+}
+
+TStatId URemotePlayerInterpolationSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URemotePlayerInterpolationSubsystem, STATGROUP_Tickables);
+}
+
+// ============ Registration ============
+
+void URemotePlayerInterpolationSubsystem::RegisterPlayer(ARemotePlayer* Player)
+{
+    if (!Player || Player->InterpolationHandle != INDEX_NONE) return;
+
+    FTrack& Track = Tracks.AddDefaulted_GetRef();
+    Track.Player = Player;
+    Track.LastRendered = Player->GetActorLocation();
+    Player->InterpolationHandle = Tracks.Num() - 1;
+}
+
+void URemotePlayerInterpolationSubsystem::UnregisterPlayer(ARemotePlayer* Player)
+{
+    if (!Player || !Tracks.IsValidIndex(Player->InterpolationHandle)) return;
+
+    const int32 Index = Player->InterpolationHandle;
+    Player->InterpolationHandle = INDEX_NONE;
+    RemoveImpostor(Index);
+
+    Tracks.RemoveAtSwap(Index, 1, false);
+    if (Tracks.IsValidIndex(Index))
+    {
+        // The last track moved into the hole
+        FTrack& Moved = Tracks[Index];
+        if (ARemotePlayer* MovedPlayer = Moved.Player.Get())
+        {
+            MovedPlayer->InterpolationHandle = Index;
+        }
+        if (Moved.ImpostorBatch != INDEX_NONE)
+        {
+            ImpostorBatches[Moved.ImpostorBatch].InstanceTracks[Moved.ImpostorInstance] = Index;
+        }
+    }
+}
+
+int32 URemotePlayerInterpolationSubsystem::GetPlayerCountAtLOD(ERemotePlayerLOD LOD) const
+{
+    int32 Count = 0;
+    for (const FTrack& Track : Tracks)
+    {
+        Count += Track.LOD == LOD ? 1 : 0;
+    }
+    return Count;
+}
+
+URemotePlayerInterpolationSubsystem::FTrack* URemotePlayerInterpolationSubsystem::FindTrack(ARemotePlayer* Player)
+{
+    return (Player && Tracks.IsValidIndex(Player->InterpolationHandle)) ? &Tracks[Player->InterpolationHandle] : nullptr;
+}
+
+void URemotePlayerInterpolationSubsystem::PushSample(ARemotePlayer* Player, const FVector& Position, const FRotator& Rotation)
+{
+    FTrack* Track = FindTrack(Player);
+    if (!Track) return;
+
+    const double Now = FPlatformTime::Seconds();
+
+    // Inter-arrival statistics drive the adaptive delay
+    if (Track->Count > 0)
+    {
+        const float Interval = static_cast<float>(Now - Track->LastArrival);
+        const float Deviation = Interval - Track->MeanInterval;
+        constexpr float Smoothing = 0.1f;
+        Track->MeanInterval += Smoothing * Deviation;
+        Track->IntervalVariance = (1.0f - Smoothing) * (Track->IntervalVariance + Smoothing * Deviation * Deviation);
+    }
+    Track->LastArrival = Now;
+
+    // Approximate the server send time with the shared RTT estimate
+    FSample Sample;
+    Sample.Time = Now - 0.5 * RoundTripTime;
+    Sample.Position = Position;
+    Sample.Yaw = Rotation.Yaw;
+
+    // Big jumps restart the curve so it doesn't swing through walls
+    if (Track->Count > 0 && FVector::Dist(Track->Get(Track->Count - 1).Position, Position) > TeleportThreshold)
+    {
+        Track->Count = 0;
+        Track->Head = 0;
+    }
+
+    // Keep samples time-ordered; late ones would bend the curve backwards
+    if (Track->Count > 0 && Sample.Time <= Track->Get(Track->Count - 1).Time)
+    {
+        return;
+    }
+
+    if (Track->Count == SamplesPerPlayer)
+    {
+        Track->Head = (Track->Head + 1) % SamplesPerPlayer;
+        --Track->Count;
+    }
+    Track->Samples[(Track->Head + Track->Count) % SamplesPerPlayer] = Sample;
+    ++Track->Count;
+}
+
+void URemotePlayerInterpolationSubsystem::ResetPlayer(ARemotePlayer* Player, const FVector& Position)
+{
+    FTrack* Track = FindTrack(Player);
+    if (!Track) return;
+
+    Track->Head = 0;
+    Track->Count = 0;
+    Track->LastRendered = Position;
+}
+
+// ============ LOD ============
+
+void URemotePlayerInterpolationSubsystem::SetPlayerLOD(ARemotePlayer* Player, ERemotePlayerLOD LOD)
+{
+    FTrack* Track = FindTrack(Player);
+    if (!Track || Track->LOD == LOD) return;
+
+    const int32 TrackIndex = Player->InterpolationHandle;
+    Track->LOD = LOD;
+    switch (LOD)
+    {
+    case ERemotePlayerLOD::Reduced: Track->UpdateInterval = ReducedUpdateInterval; break;
+    case ERemotePlayerLOD::Impostor: Track->UpdateInterval = ImpostorUpdateInterval; break;
+    default: Track->UpdateInterval = 0.0f; break;
+    }
+
+    // Update on the next pass, so the new tier starts from a fresh position
+    Track->TimeSinceUpdate = Track->UpdateInterval;
+
+    if (LOD == ERemotePlayerLOD::Impostor)
+    {
+        AddImpostor(TrackIndex);
+    }
+    else
+    {
+        RemoveImpostor(TrackIndex);
+    }
+}
+
+int32 URemotePlayerInterpolationSubsystem::GetOrCreateImpostorBatch(ARemotePlayer* Player)
+{
+    UStaticMesh* Mesh = Player->ImpostorMesh;
+    if (!Mesh) return INDEX_NONE;
+
+    if (const int32* Existing = ImpostorBatchByMesh.Find(Mesh))
+    {
+        return *Existing;
+    }
+
+    UWorld* World = GetWorld();
+    if (!IsValid(ImpostorOwner))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        ImpostorOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!ImpostorOwner) return INDEX_NONE;
+        ImpostorOwner->SetRootComponent(NewObject<USceneComponent>(ImpostorOwner, TEXT("RemotePlayerImpostorRoot")));
+        ImpostorOwner->GetRootComponent()->RegisterComponent();
+    }
+
+    // Instances are placed in world space, so the owner stays at the origin
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(ImpostorOwner,
+        MakeUniqueObjectName(ImpostorOwner, UInstancedStaticMeshComponent::StaticClass(), TEXT("RemotePlayerImpostors")));
+    ISM->SetStaticMesh(Mesh);
+    if (Player->ImpostorMaterial)
+    {
+        ISM->SetMaterial(0, Player->ImpostorMaterial);
+    }
+    ISM->bSupportRemoveAtSwap = true;
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->SetCastShadow(false);
+    ISM->SetCanEverAffectNavigation(false);
+    ISM->SetupAttachment(ImpostorOwner->GetRootComponent());
+    ISM->RegisterComponent();
+
+    const int32 BatchIdx = ImpostorBatches.AddDefaulted();
+    ImpostorBatches[BatchIdx].Instances = ISM;
+    ImpostorComponents.Add(ISM);
+    ImpostorBatchByMesh.Add(Mesh, BatchIdx);
+    return BatchIdx;
+}
+
+void URemotePlayerInterpolationSubsystem::AddImpostor(int32 TrackIndex)
+{
+    FTrack& Track = Tracks[TrackIndex];
+    ARemotePlayer* Player = Track.Player.Get();
+    if (!Player || Track.ImpostorBatch != INDEX_NONE) return;
+
+    const int32 BatchIdx = GetOrCreateImpostorBatch(Player);
+    if (BatchIdx == INDEX_NONE) return;
+
+    FImpostorBatch& Batch = ImpostorBatches[BatchIdx];
+    const FTransform Transform(Player->GetActorRotation(), Player->GetActorLocation(), Player->ImpostorScale);
+    Track.ImpostorBatch = BatchIdx;
+    Track.ImpostorInstance = Batch.Instances->AddInstance(Transform, /*bWorldSpace=*/true);
+    Batch.InstanceTracks.Add(TrackIndex);
+}
+
+void URemotePlayerInterpolationSubsystem::RemoveImpostor(int32 TrackIndex)
+{
+    FTrack& Track = Tracks[TrackIndex];
+    if (Track.ImpostorBatch == INDEX_NONE) return;
+
+    // Swap-remove on both sides: the batch's last instance moves into this one's index
+    FImpostorBatch& Batch = ImpostorBatches[Track.ImpostorBatch];
+    const int32 InstIdx = Track.ImpostorInstance;
+    if (IsValid(Batch.Instances))
+    {
+        Batch.Instances->RemoveInstance(InstIdx);
+    }
+    Batch.InstanceTracks.RemoveAtSwap(InstIdx, 1, /*bAllowShrinking=*/false);
+    if (Batch.InstanceTracks.IsValidIndex(InstIdx))
+    {
+        Tracks[Batch.InstanceTracks[InstIdx]].ImpostorInstance = InstIdx;
+    }
+
+    Track.ImpostorBatch = INDEX_NONE;
+    Track.ImpostorInstance = INDEX_NONE;
+}
+
+// ============ Evaluation ============
+
+bool URemotePlayerInterpolationSubsystem::Evaluate(const FTrack& Track, double RenderTime, FVector& OutPosition, float& OutYaw) const
+{
+    if (Track.Count == 0) return false;
+
+    const FSample& Newest = Track.Get(Track.Count - 1);
+
+    if (Track.Count == 1 || RenderTime <= Track.Get(0).Time)
+    {
+        const FSample& Only = (Track.Count == 1) ? Newest : Track.Get(0);
+        OutPosition = Only.Position;
+        OutYaw = Only.Yaw;
+        return true;
+    }
+
+    if (RenderTime >= Newest.Time)
+    {
+        // Buffer ran dry: bounded extrapolation along the last segment
+        const FSample& Prev = Track.Get(Track.Count - 2);
+        const double SegmentTime = FMath::Max(Newest.Time - Prev.Time, 1e-3);
+        const FVector Velocity = (Newest.Position - Prev.Position) / SegmentTime;
+        const double Ahead = FMath::Min(RenderTime - Newest.Time, static_cast<double>(MaxExtrapolation));
+
+        OutPosition = Newest.Position + Velocity * Ahead;
+        OutYaw = Newest.Yaw;
+        return true;
+    }
+
+    // Find the segment [i, i+1] containing RenderTime (buffer is tiny, linear scan)
+    int32 i = 0;
+    while (i < Track.Count - 2 && Track.Get(i + 1).Time < RenderTime)
+    {
+        ++i;
+    }
+
+    const FSample& P1 = Track.Get(i);
+    const FSample& P2 = Track.Get(i + 1);
+    const FSample& P0 = Track.Get(FMath::Max(i - 1, 0));
+    const FSample& P3 = Track.Get(FMath::Min(i + 2, Track.Count - 1));
+
+    const double Duration = FMath::Max(P2.Time - P1.Time, 1e-3);
+    const float Alpha = static_cast<float>(FMath::Clamp((RenderTime - P1.Time) / Duration, 0.0, 1.0));
+
+    // Catmull-Rom tangents from neighbouring samples, scaled to this segment's length
+    const FVector T1 = (P2.Position - P0.Position) / FMath::Max(P2.Time - P0.Time, 1e-3) * Duration;
+    const FVector T2 = (P3.Position - P1.Position) / FMath::Max(P3.Time - P1.Time, 1e-3) * Duration;
+
+    OutPosition = FMath::CubicInterp(P1.Position, T1, P2.Position, T2, Alpha);
+    OutYaw = P1.Yaw + FMath::FindDeltaAngleDegrees(P1.Yaw, P2.Yaw) * Alpha;
+    return true;
+}
+
+// ============ Batched Update ============
+
+void URemotePlayerInterpolationSubsystem::Tick(float DeltaTime)
+{
+    if (Tracks.Num() == 0) return;
+
+    const double Now = FPlatformTime::Seconds();
+    TSet<int32, DefaultKeyFuncs<int32>, TInlineSetAllocator<8>> DirtyBatches;
+
+    for (FTrack& Track : Tracks)
+    {
+        ARemotePlayer* Player = Track.Player.Get();
+        if (!Player) continue;
+
+        // Lower tiers update less often, with the time they skipped
+        Track.TimeSinceUpdate += DeltaTime;
+        if (Track.TimeSinceUpdate < Track.UpdateInterval) continue;
+        const float StepDelta = Track.TimeSinceUpdate;
+        const float SafeDelta = FMath::Max(StepDelta, 0.001f);
+        Track.TimeSinceUpdate = 0.0f;
+
+        Player->AdvanceVisualState(StepDelta);
+        if (Player->bIsDead) continue;
+
+        const float Jitter = FMath::Sqrt(Track.IntervalVariance);
+        const float Delay = FMath::Clamp(Track.MeanInterval + JitterMargin * Jitter,
+            MinInterpolationDelay, MaxInterpolationDelay);
+
+        // Sample times are send-time estimates, so render on the same clock
+        const double RenderTime = Now - 0.5 * RoundTripTime - Delay;
+
+        FVector Position;
+        float Yaw;
+        if (!Evaluate(Track, RenderTime, Position, Yaw)) continue;
+
+        Player->Speed = FVector::Dist2D(Position, Track.LastRendered) / SafeDelta;
+        Track.LastRendered = Position;
+
+        Player->SetActorLocationAndRotation(Position, FRotator(0.0f, Yaw, 0.0f));
+
+        if (Track.ImpostorBatch != INDEX_NONE)
+        {
+            ImpostorBatches[Track.ImpostorBatch].Instances->UpdateInstanceTransform(Track.ImpostorInstance,
+                FTransform(FRotator(0.0f, Yaw, 0.0f), Position, Player->ImpostorScale),
+                /*bWorldSpace=*/true, /*bMarkRenderStateDirty=*/false, /*bTeleport=*/true);
+            DirtyBatches.Add(Track.ImpostorBatch);
+        }
+    }
+
+    // One render state update per batch, not per moved instance
+    for (const int32 BatchIdx : DirtyBatches)
+    {
+        ImpostorBatches[BatchIdx].Instances->MarkRenderStateDirty();
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RemotePlayer.h"
+#include "RemotePlayerInterpolationSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * Drives every ARemotePlayer transform from one batched tick.
+ *
+ * Each remote player gets a small timestamped jitter buffer of position
+ * samples. Rendering runs InterpolationDelay behind the newest sample and
+ * evaluates a cubic Hermite curve through the buffered points (Catmull-Rom
+ * tangents), so irregular packet arrival doesn't turn into rubber-banding.
+ * When the buffer runs dry the last velocity is extrapolated for at most
+ * MaxExtrapolation seconds, then the player holds position.
+ *
+ * The delay adapts per player: expected send interval plus a jitter margin,
+ * clamped to [MinInterpolationDelay, MaxInterpolationDelay]. Sample times
+ * are arrival times corrected by half the RTT that UTowerStateSynchronizer
+ * measures, so both share one clock and latency estimate.
+ *
+ * How often a track is evaluated follows its player's LOD tier: every frame
+ * at Full, every ReducedUpdateInterval at Reduced and every
+ * ImpostorUpdateInterval at Impostor. Impostor players hide their character
+ * and are drawn as instances of an ISM per impostor mesh, moved in the same
+ * pass, so a crowd in the distance is a draw call and no character updates.
+ */
+UCLASS()
+class TOWERGAME_API URemotePlayerInterpolationSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ============ Registration ============
+
+    void RegisterPlayer(ARemotePlayer* Player);
+    void UnregisterPlayer(ARemotePlayer* Player);
+
+    /** Queue a network position sample for a registered player */
+    void PushSample(ARemotePlayer* Player, const FVector& Position, const FRotator& Rotation);
+
+    /** Drop a player's history and snap it to Position (respawn, teleport) */
+    void ResetPlayer(ARemotePlayer* Player, const FVector& Position);
+
+    /** Change how often Player's track updates, and draw it as an impostor instance at Impostor */
+    void SetPlayerLOD(ARemotePlayer* Player, ERemotePlayerLOD LOD);
+
+    /** Latest smoothed RTT from UTowerStateSynchronizer (seconds) */
+    void SetRoundTripTime(float InRTT) { RoundTripTime = InRTT; }
+
+    float GetRoundTripTime() const { return RoundTripTime; }
+
+    int32 GetTrackedPlayerCount() const { return Tracks.Num(); }
+
+    /** Tracked players at each tier, indexed by ERemotePlayerLOD */
+    int32 GetPlayerCountAtLOD(ERemotePlayerLOD LOD) const;
+
+    // ============ Config ============
+
+    float MinInterpolationDelay = 0.1f;
+    float MaxInterpolationDelay = 0.5f;
+
+    /** Jitter margin in standard deviations of the inter-arrival time */
+    float JitterMargin = 2.0f;
+
+    float MaxExtrapolation = 0.25f;
+
+    /** Gaps larger than this snap instead of curving */
+    float TeleportThreshold = 500.0f;
+
+    /** Seconds between track updates of Reduced and Impostor players */
+    float ReducedUpdateInterval = 1.0f / 15.0f;
+    float ImpostorUpdateInterval = 0.2f;
+
+private:
+    static constexpr int32 SamplesPerPlayer = 8;
+
+    struct FSample
+    {
+        double Time;
+        FVector Position;
+        float Yaw;
+    };
+
+    struct FTrack
+    {
+        TWeakObjectPtr<ARemotePlayer> Player;
+        FSample Samples[SamplesPerPlayer];
+        int32 Head = 0;     // Oldest sample
+        int32 Count = 0;
+        double LastArrival = 0.0;
+        float MeanInterval = 0.2f;
+        float IntervalVariance = 0.0f;
+        FVector LastRendered = FVector::ZeroVector;
+
+        ERemotePlayerLOD LOD = ERemotePlayerLOD::Full;
+        float UpdateInterval = 0.0f;
+        float TimeSinceUpdate = 0.0f;
+
+        /** Impostor instance, while LOD is Impostor */
+        int32 ImpostorBatch = INDEX_NONE;
+        int32 ImpostorInstance = INDEX_NONE;
+
+        const FSample& Get(int32 Index) const { return Samples[(Head + Index) % SamplesPerPlayer]; }
+    };
+
+    /** ISM drawing the impostors of one mesh, and the track of each of its instances */
+    struct FImpostorBatch
+    {
+        UInstancedStaticMeshComponent* Instances = nullptr;
+        TArray<int32> InstanceTracks;
+    };
+
+    /** Dense track array; ARemotePlayer::InterpolationHandle indexes into it */
+    TArray<FTrack> Tracks;
+
+    TArray<FImpostorBatch> ImpostorBatches;
+    TMap<UStaticMesh*, int32> ImpostorBatchByMesh;
+
+    /** Carries the impostor components; spawned with the first impostor */
+    UPROPERTY()
+    AActor* ImpostorOwner = nullptr;
+
+    /** Keeps the impostor components alive (ImpostorBatches isn't reflected) */
+    UPROPERTY()
+    TArray<UInstancedStaticMeshComponent*> ImpostorComponents;
+
+    int32 GetOrCreateImpostorBatch(ARemotePlayer* Player);
+    void AddImpostor(int32 TrackIndex);
+    void RemoveImpostor(int32 TrackIndex);
+
+    float RoundTripTime = 0.0f;
+
+    FTrack* FindTrack(ARemotePlayer* Player);
+
+    /** Evaluate a track at RenderTime. Returns false when nothing is buffered. */
+    bool Evaluate(const FTrack& Track, double RenderTime, FVector& OutPosition, float& OutYaw) const;
+};
@@ -0,0 +1,966 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ReplayRecorder.h"
+#include "StateSynchronizer.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Containers/Queue.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogTowerReplayRing, Log, All);
+
+namespace
+{
+    /** How often the writer wakes on its own; the game thread never signals it */
+    constexpr uint32 WakeIntervalMs = 50;
+
+    enum EPlayerField : uint8
+    {
+        PlayerPosition  = 1 << 0,
+        PlayerRotation  = 1 << 1,
+        PlayerHealth    = 1 << 2,
+        PlayerResources = 1 << 3,
+        PlayerTimestamp = 1 << 4,
+        PlayerAll       = 0x1F,
+    };
+
+    enum EMonsterField : uint8
+    {
+        MonsterPosition   = 1 << 0,
+        MonsterVelocity   = 1 << 1,
+        MonsterSampleTime = 1 << 2,
+        MonsterHealth     = 1 << 3,
+        MonsterPhase      = 1 << 4,
+        MonsterStatus     = 1 << 5,
+        MonsterAll        = 0x3F,
+    };
+
+    constexpr uint32 ChunkFlagCompressed = 1;
+    constexpr uint8 InputFlagMove = 1;
+
+    class FByteWriter
+    {
+    public:
+        explicit FByteWriter(TArray<uint8>& InOut) : Out(InOut) {}
+
+        void U8(uint8 Value) { Out.Add(Value); }
+        void U16(uint16 Value) { Fixed(Value, 2); }
+        void U32(uint32 Value) { Fixed(Value, 4); }
+        void U64(uint64 Value) { Fixed(Value, 8); }
+        void F32(float Value) { U32(*reinterpret_cast<const uint32*>(&Value)); }
+        void F64(double Value) { U64(*reinterpret_cast<const uint64*>(&Value)); }
+
+        void VarUInt(uint64 Value)
+        {
+            while (Value >= 0x80)
+            {
+                Out.Add(static_cast<uint8>(Value) | 0x80);
+                Value >>= 7;
+            }
+            Out.Add(static_cast<uint8>(Value));
+        }
+
+        void VarInt(int64 Value) { VarUInt((static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63)); }
+
+        void Vec3(const FVector& Value)
+        {
+            F32(static_cast<float>(Value.X));
+            F32(static_cast<float>(Value.Y));
+            F32(static_cast<float>(Value.Z));
+        }
+
+        void Bytes(const void* Data, int32 Num) { Out.Append(static_cast<const uint8*>(Data), Num); }
+
+    private:
+        void Fixed(uint64 Value, int32 Num)
+        {
+            for (int32 i = 0; i < Num; ++i)
+            {
+                Out.Add(static_cast<uint8>(Value >> (i * 8)));
+            }
+        }
+
+        TArray<uint8>& Out;
+    };
+
+    class FByteReader
+    {
+    public:
+        FByteReader(const uint8* InData, int32 InSize, int32 InPos = 0) : Data(InData), Size(InSize), Pos(InPos) {}
+
+        uint8 U8() { return Has(1) ? Data[Pos++] : 0; }
+        uint16 U16() { return static_cast<uint16>(Fixed(2)); }
+        uint32 U32() { return static_cast<uint32>(Fixed(4)); }
+        uint64 U64() { return Fixed(8); }
+
+        float F32()
+        {
+            const uint32 Bits = U32();
+            return *reinterpret_cast<const float*>(&Bits);
+        }
+
+        double F64()
+        {
+            const uint64 Bits = U64();
+            return *reinterpret_cast<const double*>(&Bits);
+        }
+
+        uint64 VarUInt()
+        {
+            uint64 Value = 0;
+            for (int32 Shift = 0; Shift < 64; Shift += 7)
+            {
+                const uint8 Byte = U8();
+                Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+                if (!(Byte & 0x80))
+                {
+                    return Value;
+                }
+            }
+            bError = true;
+            return 0;
+        }
+
+        int64 VarInt()
+        {
+            const uint64 Value = VarUInt();
+            return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+        }
+
+        FVector Vec3()
+        {
+            const float X = F32();
+            const float Y = F32();
+            const float Z = F32();
+            return FVector(X, Y, Z);
+        }
+
+        const uint8* Bytes(int32 Num) { return Has(Num) ? Data + (Pos += Num) - Num : nullptr; }
+
+        int32 GetPos() const { return Pos; }
+        bool IsError() const { return bError; }
+
+    private:
+        bool Has(int32 Num)
+        {
+            if (Num < 0 || Pos + Num > Size)
+            {
+                bError = true;
+                Pos = Size;
+                return false;
+            }
+            return true;
+        }
+
+        uint64 Fixed(int32 Num)
+        {
+            if (!Has(Num))
+            {
+                return 0;
+            }
+            uint64 Value = 0;
+            for (int32 i = 0; i < Num; ++i)
+            {
+                Value |= static_cast<uint64>(Data[Pos + i]) << (i * 8);
+            }
+            Pos += Num;
+            return Value;
+        }
+
+        const uint8* Data;
+        int32 Size;
+        int32 Pos;
+        bool bError = false;
+    };
+
+    // Fields compare at the stored precision, so an unchanged field is exactly what the reader already has
+
+    bool SameF32(double A, double B) { return static_cast<float>(A) == static_cast<float>(B); }
+    bool SameVec3(const FVector& A, const FVector& B) { return FVector3f(A) == FVector3f(B); }
+
+    uint8 DiffPlayer(const FPlayerStateSnapshot& Snap, const FPlayerStateSnapshot* Base)
+    {
+        if (!Base) return PlayerAll;
+        uint8 Mask = 0;
+        if (!SameVec3(Snap.Position, Base->Position)) Mask |= PlayerPosition;
+        if (!SameVec3(Snap.Rotation.Euler(), Base->Rotation.Euler())) Mask |= PlayerRotation;
+        if (!SameF32(Snap.Health, Base->Health)) Mask |= PlayerHealth;
+        if (FVector4f(Snap.Resources) != FVector4f(Base->Resources)) Mask |= PlayerResources;
+        if (Snap.Timestamp != Base->Timestamp) Mask |= PlayerTimestamp;
+        return Mask;
+    }
+
+    uint8 DiffMonster(const FMonsterStateSnapshot& Snap, const FMonsterStateSnapshot* Base)
+    {
+        if (!Base) return MonsterAll;
+        uint8 Mask = 0;
+        if (!SameVec3(Snap.Position, Base->Position)) Mask |= MonsterPosition;
+        if (!SameVec3(Snap.Velocity, Base->Velocity)) Mask |= MonsterVelocity;
+        if (Snap.SampleTime != Base->SampleTime) Mask |= MonsterSampleTime;
+        if (!SameF32(Snap.Health, Base->Health)) Mask |= MonsterHealth;
+        if (Snap.CombatPhase != Base->CombatPhase) Mask |= MonsterPhase;
+        if (Snap.StatusMask != Base->StatusMask) Mask |= MonsterStatus;
+        return Mask;
+    }
+
+    void WritePlayer(FByteWriter& W, const FPlayerStateSnapshot& Snap, uint8 Mask)
+    {
+        W.U8(Mask);
+        if (Mask & PlayerPosition) W.Vec3(Snap.Position);
+        if (Mask & PlayerRotation) W.Vec3(Snap.Rotation.Euler());
+        if (Mask & PlayerHealth) W.F32(Snap.Health);
+        if (Mask & PlayerResources)
+        {
+            W.F32(static_cast<float>(Snap.Resources.X));
+            W.F32(static_cast<float>(Snap.Resources.Y));
+            W.F32(static_cast<float>(Snap.Resources.Z));
+            W.F32(static_cast<float>(Snap.Resources.W));
+        }
+        if (Mask & PlayerTimestamp) W.F64(Snap.Timestamp);
+    }
+
+    void WriteMonster(FByteWriter& W, const FMonsterStateSnapshot& Snap, uint8 Mask)
+    {
+        W.U8(Mask);
+        if (Mask & MonsterPosition) W.Vec3(Snap.Position);
+        if (Mask & MonsterVelocity) W.Vec3(Snap.Velocity);
+        if (Mask & MonsterSampleTime) W.F64(Snap.SampleTime);
+        if (Mask & MonsterHealth) W.F32(Snap.Health);
+        if (Mask & MonsterPhase) W.U8(static_cast<uint8>(Snap.CombatPhase));
+        if (Mask & MonsterStatus) W.U32(static_cast<uint32>(Snap.StatusMask));
+    }
+
+    void ReadPlayer(FByteReader& R, FPlayerStateSnapshot& Snap)
+    {
+        const uint8 Mask = R.U8();
+        if (Mask & PlayerPosition) Snap.Position = R.Vec3();
+        if (Mask & PlayerRotation) Snap.Rotation = FRotator::MakeFromEuler(R.Vec3());
+        if (Mask & PlayerHealth) Snap.Health = R.F32();
+        if (Mask & PlayerResources)
+        {
+            const float X = R.F32();
+            const float Y = R.F32();
+            const float Z = R.F32();
+            const float W = R.F32();
+            Snap.Resources = FVector4(X, Y, Z, W);
+        }
+        if (Mask & PlayerTimestamp) Snap.Timestamp = R.F64();
+    }
+
+    void ReadMonster(FByteReader& R, FMonsterStateSnapshot& Snap)
+    {
+        const uint8 Mask = R.U8();
+        if (Mask & MonsterPosition) Snap.Position = R.Vec3();
+        if (Mask & MonsterVelocity) Snap.Velocity = R.Vec3();
+        if (Mask & MonsterSampleTime) Snap.SampleTime = R.F64();
+        if (Mask & MonsterHealth) Snap.Health = R.F32();
+        if (Mask & MonsterPhase) Snap.CombatPhase = static_cast<EMonsterCombatPhase>(R.U8());
+        if (Mask & MonsterStatus) Snap.StatusMask = static_cast<int32>(R.U32());
+    }
+
+    /** Entities sorted by id, each a delta on the baseline entity with the same id */
+    template <typename TSnapshot, typename TDiff, typename TWrite>
+    void WriteEntities(FByteWriter& W, const TArray<TSnapshot>& Entities, const TArray<TSnapshot>* Base, TDiff Diff, TWrite Write)
+    {
+        W.VarUInt(Entities.Num());
+        int64 PrevId = 0;
+        int32 BaseIdx = 0;
+        for (const TSnapshot& Snap : Entities)
+        {
+            const TSnapshot* Match = nullptr;
+            if (Base)
+            {
+                while (BaseIdx < Base->Num() && (*Base)[BaseIdx].EntityId < Snap.EntityId) ++BaseIdx;
+                if (BaseIdx < Base->Num() && (*Base)[BaseIdx].EntityId == Snap.EntityId) Match = &(*Base)[BaseIdx];
+            }
+            W.VarInt(Snap.EntityId - PrevId);
+            PrevId = Snap.EntityId;
+            Write(W, Snap, Diff(Snap, Match));
+        }
+    }
+
+    template <typename TSnapshot, typename TRead>
+    bool ReadEntities(FByteReader& R, TArray<TSnapshot>& Out, const TArray<TSnapshot>& Base, TRead Read)
+    {
+        const uint64 Num = R.VarUInt();
+        if (R.IsError() || Num > 1u << 20)
+        {
+            return false;
+        }
+
+        Out.SetNum(static_cast<int32>(Num));
+        int64 PrevId = 0;
+        int32 BaseIdx = 0;
+        for (TSnapshot& Snap : Out)
+        {
+            const int64 Id = PrevId + R.VarInt();
+            PrevId = Id;
+            while (BaseIdx < Base.Num() && Base[BaseIdx].EntityId < Id) ++BaseIdx;
+            Snap = BaseIdx < Base.Num() && Base[BaseIdx].EntityId == Id ? Base[BaseIdx] : TSnapshot();
+            Snap.EntityId = Id;
+            Read(R, Snap);
+        }
+        return !R.IsError();
+    }
+
+    /** Rust InputType index of a predicted action, INDEX_NONE if replays have no such input */
+    int32 GetReplayInputType(uint8 ActionType)
+    {
+        switch (static_cast<EPredictedActionType>(ActionType))
+        {
+        case EPredictedActionType::Move:       return TowerReplay::FindInputType(TEXT("Move"));
+        case EPredictedActionType::Attack:     return TowerReplay::FindInputType(TEXT("Attack"));
+        case EPredictedActionType::Dash:
+        case EPredictedActionType::Dodge:      return TowerReplay::FindInputType(TEXT("Dodge"));
+        case EPredictedActionType::Jump:       return TowerReplay::FindInputType(TEXT("Jump"));
+        case EPredictedActionType::UseAbility: return TowerReplay::FindInputType(TEXT("UseAbility"));
+        case EPredictedActionType::Interact:   return TowerReplay::FindInputType(TEXT("Interact"));
+        default:                               return INDEX_NONE;
+        }
+    }
+
+    FString MakeInputPayload(const FTowerRecordedInput& Input)
+    {
+        const FString Pos = FString::Printf(TEXT("\"pos\":[%.1f,%.1f,%.1f],\"facing\":%.1f"),
+            Input.Position.X, Input.Position.Y, Input.Position.Z, Input.Facing);
+        if (Input.bHasMove)
+        {
+            return FString::Printf(TEXT("{\"x\":%.3f,\"y\":%.3f,\"yaw\":%.1f,%s}"),
+                Input.Right / 127.0f, Input.Forward / 127.0f, Input.Yaw * (360.0f / 65536.0f), *Pos);
+        }
+        return FString::Printf(TEXT("{%s}"), *Pos);
+    }
+}
+
+// ============================================================================
+// FTowerReplayRecorder::FWorker
+// ============================================================================
+
+class FTowerReplayRecorder::FWorker : public FRunnable
+{
+public:
+    struct FItem
+    {
+        ETowerReplayFrame Kind = ETowerReplayFrame::Snapshot;
+        double Time = 0.0;
+        FWorldStateBuffer Snapshot;
+        FTowerRecordedInput Input;
+        FString Marker;
+    };
+
+    FWorker(TUniquePtr<FArchive>&& InArchive, int32 InChunkBytes, int32 InNumChunks,
+        FThreadSafeCounter64& InBytesWritten, FThreadSafeCounter64& InChunksWritten)
+        : Archive(MoveTemp(InArchive))
+        , ChunkBytes(InChunkBytes)
+        , NumChunks(InNumChunks)
+        , BytesWritten(InBytesWritten)
+        , ChunksWritten(InChunksWritten)
+        , WorkEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    {
+    }
+
+    virtual ~FWorker()
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+
+    virtual uint32 Run() override
+    {
+        for (;;)
+        {
+            WorkEvent->Wait(WakeIntervalMs);
+            // Read before draining: everything queued before Stop() is in the queue by now
+            const bool bStopping = bStopRequested.load(std::memory_order_acquire);
+            Drain();
+            if (bStopping)
+            {
+                break;
+            }
+        }
+
+        while (ChunkItems.Num() > 0)
+        {
+            WriteChunk();
+        }
+        Archive->Close();
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopRequested.store(true, std::memory_order_release);
+        WorkEvent->Trigger();
+    }
+
+    /** Game thread only */
+    TQueue<FItem, EQueueMode::Spsc> Items;
+
+private:
+    void Drain()
+    {
+        FItem Item;
+        while (Items.Dequeue(Item))
+        {
+            Append(MoveTemp(Item));
+        }
+    }
+
+    void Append(FItem&& Item)
+    {
+        if (Item.Kind == ETowerReplayFrame::Snapshot)
+        {
+            // Buffered snapshots are sorted already; this is a check, not a sort, in the usual case
+            Item.Snapshot.PlayerSnapshots.Sort([](const FPlayerStateSnapshot& A, const FPlayerStateSnapshot& B) { return A.EntityId < B.EntityId; });
+            Item.Snapshot.MonsterSnapshots.Sort([](const FMonsterStateSnapshot& A, const FMonsterStateSnapshot& B) { return A.EntityId < B.EntityId; });
+        }
+
+        ChunkItems.Add(MoveTemp(Item));
+        EncodeFrame(ChunkItems.Num() - 1);
+        while (Raw.Num() >= GetRawLimit())
+        {
+            WriteChunk();
+        }
+    }
+
+    int32 GetCapacity() const { return ChunkBytes - TowerReplayRing::ChunkHeaderSize; }
+
+    /** Raw bytes to gather before compressing, from how well the last chunk compressed */
+    int32 GetRawLimit() const { return static_cast<int32>(GetCapacity() * ExpectedRatio); }
+
+    void ResetEncoder()
+    {
+        Raw.Reset();
+        FrameEnds.Reset();
+        LastSnapshot = INDEX_NONE;
+        PrevTime = 0.0;
+        PrevTick = 0;
+    }
+
+    void EncodeFrame(int32 Index)
+    {
+        const FItem& Item = ChunkItems[Index];
+        FByteWriter W(Raw);
+        W.U8(static_cast<uint8>(Item.Kind));
+        W.VarUInt(static_cast<uint64>(FMath::Max(Item.Time - PrevTime, 0.0) * 1e6));
+        PrevTime = FMath::Max(Item.Time, PrevTime);
+
+        switch (Item.Kind)
+        {
+        case ETowerReplayFrame::Snapshot:
+        {
+            const FWorldStateBuffer& State = Item.Snapshot;
+            const FWorldStateBuffer* Base = LastSnapshot != INDEX_NONE ? &ChunkItems[LastSnapshot].Snapshot : nullptr;
+            W.VarInt(State.ServerTick - PrevTick);
+            PrevTick = State.ServerTick;
+            W.F64(State.ServerTimestamp);
+            W.U8(static_cast<uint8>(State.WorldCyclePhase));
+            W.VarInt(State.LocalPlayerEntityId);
+            WriteEntities(W, State.PlayerSnapshots, Base ? &Base->PlayerSnapshots : nullptr, &DiffPlayer, &WritePlayer);
+            WriteEntities(W, State.MonsterSnapshots, Base ? &Base->MonsterSnapshots : nullptr, &DiffMonster, &WriteMonster);
+            LastSnapshot = Index;
+            break;
+        }
+        case ETowerReplayFrame::Input:
+        {
+            const FTowerRecordedInput& Input = Item.Input;
+            W.U8(Input.ActionType);
+            W.U8(Input.bHasMove ? InputFlagMove : 0);
+            if (Input.bHasMove)
+            {
+                W.U8(static_cast<uint8>(Input.Forward));
+                W.U8(static_cast<uint8>(Input.Right));
+                W.U16(Input.Yaw);
+            }
+            W.F32(Input.Position.X);
+            W.F32(Input.Position.Y);
+            W.F32(Input.Position.Z);
+            W.F32(Input.Facing);
+            break;
+        }
+        case ETowerReplayFrame::Marker:
+        {
+            const FTCHARToUTF8 Label(*Item.Marker, Item.Marker.Len());
+            W.VarUInt(Label.Length());
+            W.Bytes(Label.Get(), Label.Length());
+            break;
+        }
+        }
+        FrameEnds.Add(Raw.Num());
+    }
+
+    /** Compress as many of the chunk's frames as fit one slot, write them, and start the next chunk with the rest */
+    void WriteChunk()
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(TowerReplay_WriteChunk);
+        const int32 Capacity = GetCapacity();
+        int32 NumFrames = FrameEnds.Num();
+        uint32 Flags = 0;
+        int32 RawSize = 0;
+        for (;;)
+        {
+            RawSize = FrameEnds[NumFrames - 1];
+            int32 StoredSize = FCompression::CompressMemoryBound(NAME_Oodle, RawSize);
+            Stored.SetNumUninitialized(StoredSize, EAllowShrinking::No);
+            const bool bCompressed = FCompression::CompressMemory(NAME_Oodle, Stored.GetData(), StoredSize, Raw.GetData(), RawSize);
+            if (bCompressed && StoredSize < RawSize && StoredSize <= Capacity)
+            {
+                Stored.SetNum(StoredSize, EAllowShrinking::No);
+                Flags = ChunkFlagCompressed;
+                ExpectedRatio = FMath::Clamp(0.9f * RawSize / StoredSize, 1.0f, 16.0f);
+                break;
+            }
+            if (RawSize <= Capacity && (!bCompressed || StoredSize >= RawSize))
+            {
+                Stored = TArray<uint8>(Raw.GetData(), RawSize);
+                ExpectedRatio = 1.0f;
+                break;
+            }
+            if (NumFrames == 1)
+            {
+                UE_LOG(LogTowerReplayRing, Warning, TEXT("ReplayRecorder: dropping a %d byte frame larger than a chunk"), RawSize);
+                RawSize = 0;
+                break;
+            }
+            // Too big even compressed: keep the share that should fit, the rest opens the next chunk
+            const float Fit = bCompressed ? static_cast<float>(Capacity) / StoredSize : static_cast<float>(Capacity) / RawSize;
+            NumFrames = FMath::Clamp(FMath::FloorToInt(NumFrames * Fit * 0.9f), 1, NumFrames - 1);
+        }
+
+        if (RawSize > 0)
+        {
+            uint8 Header[TowerReplayRing::ChunkHeaderSize] = {};
+            TArray<uint8> HeaderBytes;
+            FByteWriter W(HeaderBytes);
+            W.U32(TowerReplayRing::ChunkMagic);
+            W.U32(Flags);
+            W.U64(++Sequence);
+            W.U32(static_cast<uint32>(NumFrames));
+            W.U32(static_cast<uint32>(RawSize));
+            W.U32(static_cast<uint32>(Stored.Num()));
+            FMemory::Memcpy(Header, HeaderBytes.GetData(), HeaderBytes.Num());
+
+            Archive->Seek(TowerReplayRing::HeaderSize + static_cast<int64>(NextSlot) * ChunkBytes);
+            Archive->Serialize(Header, sizeof(Header));
+            Archive->Serialize(Stored.GetData(), Stored.Num());
+            Archive->Flush();
+            NextSlot = (NextSlot + 1) % NumChunks;
+
+            BytesWritten.Add(sizeof(Header) + Stored.Num());
+            ChunksWritten.Increment();
+        }
+
+        // The frames left over were deltas on frames now gone; re-encode them from a keyframe
+        TArray<FItem> Rest;
+        for (int32 i = FMath::Max(NumFrames, 1); i < ChunkItems.Num(); ++i)
+        {
+            Rest.Add(MoveTemp(ChunkItems[i]));
+        }
+        ChunkItems = MoveTemp(Rest);
+        ResetEncoder();
+        for (int32 i = 0; i < ChunkItems.Num(); ++i)
+        {
+            EncodeFrame(i);
+        }
+    }
+
+    TUniquePtr<FArchive> Archive;
+    const int32 ChunkBytes;
+    const int32 NumChunks;
+    FThreadSafeCounter64& BytesWritten;
+    FThreadSafeCounter64& ChunksWritten;
+
+    FEvent* WorkEvent = nullptr;
+    std::atomic<bool> bStopRequested{ false };
+
+    int32 NextSlot = 0;
+    uint64 Sequence = 0;
+    float ExpectedRatio = 4.0f;
+
+    // The chunk being gathered: its frames as recorded and as encoded so far
+    TArray<FItem> ChunkItems;
+    TArray<uint8> Raw;
+    TArray<int32> FrameEnds;
+    TArray<uint8> Stored;
+    int32 LastSnapshot = INDEX_NONE;
+    double PrevTime = 0.0;
+    int64 PrevTick = 0;
+};
+
+// ============================================================================
+// FTowerReplayRecorder
+// ============================================================================
+
+FTowerReplayRecorder::FTowerReplayRecorder() = default;
+
+FTowerReplayRecorder::~FTowerReplayRecorder()
+{
+    Stop();
+}
+
+bool FTowerReplayRecorder::Start(const FString& InPath, uint64 Seed, int32 FloorId, int32 ChunkBytes, int32 NumChunks)
+{
+    Stop();
+
+    ChunkBytes = FMath::Max(ChunkBytes, 4096);
+    NumChunks = FMath::Max(NumChunks, 2);
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(InPath), true);
+    TUniquePtr<FArchive> Archive(IFileManager::Get().CreateFileWriter(*InPath));
+    if (!Archive.IsValid())
+    {
+        UE_LOG(LogTowerReplayRing, Error, TEXT("ReplayRecorder: cannot open %s for writing"), *InPath);
+        return false;
+    }
+
+    TArray<uint8> Header;
+    FByteWriter W(Header);
+    W.U32(TowerReplayRing::Magic);
+    W.U16(TowerReplayRing::Version);
+    W.U16(0);
+    W.U32(static_cast<uint32>(ChunkBytes));
+    W.U32(static_cast<uint32>(NumChunks));
+    W.U64(Seed);
+    W.U32(static_cast<uint32>(FloorId));
+    W.U32(0);
+    check(Header.Num() == TowerReplayRing::HeaderSize);
+    Archive->Serialize(Header.GetData(), Header.Num());
+
+    BytesWritten.Set(Header.Num());
+    ChunksWritten.Reset();
+    Worker = MakeUnique<FWorker>(MoveTemp(Archive), ChunkBytes, NumChunks, BytesWritten, ChunksWritten);
+    Thread = FRunnableThread::Create(Worker.Get(), TEXT("TowerReplayRecorder"), 0, TPri_BelowNormal);
+    if (!Thread)
+    {
+        Worker.Reset();
+        return false;
+    }
+
+    Path = InPath;
+    StartSeconds = FPlatformTime::Seconds();
+    UE_LOG(LogTowerReplayRing, Log, TEXT("ReplayRecorder: recording to %s (%d x %d KB)"), *Path, NumChunks, ChunkBytes / 1024);
+    return true;
+}
+
+void FTowerReplayRecorder::Stop()
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    Worker->Stop();
+    Thread->WaitForCompletion();
+    delete Thread;
+    Thread = nullptr;
+    Worker.Reset();
+
+    UE_LOG(LogTowerReplayRing, Log, TEXT("ReplayRecorder: wrote %lld chunks (%lld bytes) to %s"),
+        ChunksWritten.GetValue(), BytesWritten.GetValue(), *Path);
+}
+
+void FTowerReplayRecorder::RecordSnapshot(const FWorldStateBuffer& State)
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerReplay_RecordSnapshot);
+    FWorker::FItem Item;
+    Item.Kind = ETowerReplayFrame::Snapshot;
+    Item.Time = FPlatformTime::Seconds() - StartSeconds;
+    Item.Snapshot = State;
+    Worker->Items.Enqueue(MoveTemp(Item));
+}
+
+void FTowerReplayRecorder::RecordInput(EPredictedActionType ActionType, const FVector& Position, float Facing, const FTowerMoveInput* Move)
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    FWorker::FItem Item;
+    Item.Kind = ETowerReplayFrame::Input;
+    Item.Time = FPlatformTime::Seconds() - StartSeconds;
+    Item.Input.ActionType = static_cast<uint8>(ActionType);
+    Item.Input.Position = FVector3f(Position);
+    Item.Input.Facing = Facing;
+    if (Move)
+    {
+        Item.Input.bHasMove = true;
+        Item.Input.Forward = Move->Forward;
+        Item.Input.Right = Move->Right;
+        Item.Input.Yaw = Move->Yaw;
+    }
+    Worker->Items.Enqueue(MoveTemp(Item));
+}
+
+void FTowerReplayRecorder::RecordMarker(const FString& Label)
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    FWorker::FItem Item;
+    Item.Kind = ETowerReplayFrame::Marker;
+    Item.Time = FPlatformTime::Seconds() - StartSeconds;
+    Item.Marker = Label;
+    Worker->Items.Enqueue(MoveTemp(Item));
+}
+
+bool FTowerReplayRecorder::ExportContainer(const FString& RingPath, const FString& OutPath, bool bFromLastMarker, int32 KeyframeInterval)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerReplay_ExportContainer);
+    constexpr double TicksPerSecond = 10.0;
+
+    FTowerReplayRingFrame Frame;
+    FWorldStateBuffer State;
+
+    double From = 0.0;
+    if (bFromLastMarker)
+    {
+        FTowerReplayRingReader Scan;
+        if (!Scan.Open(RingPath)) return false;
+        while (Scan.Next(Frame, State))
+        {
+            if (Frame.Kind == ETowerReplayFrame::Marker)
+            {
+                From = Frame.Time;
+            }
+        }
+    }
+
+    FTowerReplayRingReader Reader;
+    if (!Reader.Open(RingPath)) return false;
+
+    FTowerReplayWriter Writer;
+    if (!Writer.Open(OutPath, Reader.GetSeed(), Reader.GetFloorId(), KeyframeInterval)) return false;
+
+    int64 LastTick = 0;
+    while (Reader.Next(Frame, State))
+    {
+        if (Frame.Time < From)
+        {
+            continue;
+        }
+        LastTick = FMath::Max(LastTick, static_cast<int64>((Frame.Time - From) * TicksPerSecond));
+
+        const int32 InputType = Frame.Kind == ETowerReplayFrame::Input ? GetReplayInputType(Frame.Input.ActionType) : INDEX_NONE;
+        if (InputType != INDEX_NONE)
+        {
+            Writer.Add(LastTick, InputType, MakeInputPayload(Frame.Input));
+        }
+    }
+
+    const int32 NumFrames = Writer.GetNumFrames();
+    if (!Writer.Close(LastTick + 1))
+    {
+        return false;
+    }
+    UE_LOG(LogTowerReplayRing, Log, TEXT("ReplayRecorder: exported %d inputs from %s to %s"), NumFrames, *RingPath, *OutPath);
+    return true;
+}
+
+// ============================================================================
+// FTowerReplayRingReader
+// ============================================================================
+
+FTowerReplayRingReader::FTowerReplayRingReader()
+    : Baseline(MakeUnique<FWorldStateBuffer>())
+{
+}
+
+FTowerReplayRingReader::~FTowerReplayRingReader() = default;
+
+bool FTowerReplayRingReader::Open(const FString& Path)
+{
+    File.Reset();
+    Chunks.Reset();
+    ChunkIndex = INDEX_NONE;
+    Raw.Reset();
+    Cursor = 0;
+
+    if (!FFileHelper::LoadFileToArray(File, *Path))
+    {
+        UE_LOG(LogTowerReplayRing, Error, TEXT("ReplayRecorder: cannot read %s"), *Path);
+        return false;
+    }
+
+    FByteReader Header(File.GetData(), File.Num());
+    const uint32 FileMagic = Header.U32();
+    const uint16 FileVersion = Header.U16();
+    Header.U16();
+    const int64 ChunkBytes = Header.U32();
+    const int64 NumChunks = Header.U32();
+    Seed = Header.U64();
+    FloorId = static_cast<int32>(Header.U32());
+    if (Header.IsError() || FileMagic != TowerReplayRing::Magic || FileVersion != TowerReplayRing::Version
+        || ChunkBytes <= TowerReplayRing::ChunkHeaderSize)
+    {
+        UE_LOG(LogTowerReplayRing, Error, TEXT("ReplayRecorder: %s is not a version %d replay ring"), *Path, TowerReplayRing::Version);
+        File.Reset();
+        return false;
+    }
+
+    for (int64 Slot = 0; Slot < NumChunks; ++Slot)
+    {
+        const int64 Offset = TowerReplayRing::HeaderSize + Slot * ChunkBytes;
+        if (Offset + TowerReplayRing::ChunkHeaderSize > File.Num())
+        {
+            break;
+        }
+
+        FByteReader R(File.GetData(), File.Num(), static_cast<int32>(Offset));
+        FChunk Chunk;
+        const uint32 Magic = R.U32();
+        Chunk.Flags = R.U32();
+        Chunk.Sequence = R.U64();
+        R.U32();
+        Chunk.RawSize = static_cast<int32>(R.U32());
+        Chunk.StoredSize = static_cast<int32>(R.U32());
+        Chunk.Offset = Offset + TowerReplayRing::ChunkHeaderSize;
+
+        // Slots never written read back as zeros
+        if (Magic == TowerReplayRing::ChunkMagic && Chunk.Sequence > 0
+            && Chunk.StoredSize <= ChunkBytes - TowerReplayRing::ChunkHeaderSize
+            && Chunk.Offset + Chunk.StoredSize <= File.Num())
+        {
+            Chunks.Add(Chunk);
+        }
+    }
+
+    Chunks.Sort([](const FChunk& A, const FChunk& B) { return A.Sequence < B.Sequence; });
+    return true;
+}
+
+bool FTowerReplayRingReader::LoadChunk(int32 Index)
+{
+    const FChunk& Chunk = Chunks[Index];
+    if (Chunk.RawSize < 0 || Chunk.RawSize > 64 * 1024 * 1024)
+    {
+        return false;
+    }
+
+    Raw.SetNumUninitialized(Chunk.RawSize);
+    if (Chunk.Flags & ChunkFlagCompressed)
+    {
+        if (!FCompression::UncompressMemory(NAME_Oodle, Raw.GetData(), Chunk.RawSize, File.GetData() + Chunk.Offset, Chunk.StoredSize))
+        {
+            return false;
+        }
+    }
+    else if (Chunk.StoredSize == Chunk.RawSize)
+    {
+        FMemory::Memcpy(Raw.GetData(), File.GetData() + Chunk.Offset, Chunk.RawSize);
+    }
+    else
+    {
+        return false;
+    }
+
+    // Every chunk starts over: absolute time and tick, and a keyframe
+    Cursor = 0;
+    Time = 0.0;
+    ServerTick = 0;
+    Baseline->PlayerSnapshots.Reset();
+    Baseline->MonsterSnapshots.Reset();
+    return true;
+}
+
+bool FTowerReplayRingReader::Next(FTowerReplayRingFrame& OutFrame, FWorldStateBuffer& OutState)
+{
+    for (;;)
+    {
+        if (ChunkIndex == INDEX_NONE || Cursor >= Raw.Num())
+        {
+            if (ChunkIndex + 1 >= Chunks.Num())
+            {
+                ChunkIndex = Chunks.Num();
+                return false;
+            }
+            if (!LoadChunk(++ChunkIndex))
+            {
+                UE_LOG(LogTowerReplayRing, Warning, TEXT("ReplayRecorder: skipping chunk %llu, it doesn't decode"), Chunks[ChunkIndex].Sequence);
+                Raw.Reset();
+                continue;
+            }
+        }
+
+        FByteReader R(Raw.GetData(), Raw.Num(), Cursor);
+        OutFrame.Kind = static_cast<ETowerReplayFrame>(R.U8());
+        Time += R.VarUInt() * 1e-6;
+        OutFrame.Time = Time;
+
+        bool bOk = true;
+        switch (OutFrame.Kind)
+        {
+        case ETowerReplayFrame::Snapshot:
+            ServerTick += R.VarInt();
+            OutState.ServerTick = ServerTick;
+            OutState.ServerTimestamp = R.F64();
+            OutState.WorldCyclePhase = static_cast<EWorldCyclePhase>(R.U8());
+            OutState.LocalPlayerEntityId = R.VarInt();
+            bOk = ReadEntities(R, OutState.PlayerSnapshots, Baseline->PlayerSnapshots, &ReadPlayer)
+                && ReadEntities(R, OutState.MonsterSnapshots, Baseline->MonsterSnapshots, &ReadMonster);
+            if (bOk)
+            {
+                Baseline->PlayerSnapshots = OutState.PlayerSnapshots;
+                Baseline->MonsterSnapshots = OutState.MonsterSnapshots;
+            }
+            break;
+
+        case ETowerReplayFrame::Input:
+        {
+            FTowerRecordedInput& Input = OutFrame.Input;
+            Input = FTowerRecordedInput();
+            Input.ActionType = R.U8();
+            Input.bHasMove = (R.U8() & InputFlagMove) != 0;
+            if (Input.bHasMove)
+            {
+                Input.Forward = static_cast<int8>(R.U8());
+                Input.Right = static_cast<int8>(R.U8());
+                Input.Yaw = R.U16();
+            }
+            Input.Position.X = R.F32();
+            Input.Position.Y = R.F32();
+            Input.Position.Z = R.F32();
+            Input.Facing = R.F32();
+            break;
+        }
+
+        case ETowerReplayFrame::Marker:
+        {
+            const int32 Len = static_cast<int32>(FMath::Min<uint64>(R.VarUInt(), MAX_int32));
+            const uint8* Label = R.Bytes(Len);
+            OutFrame.Marker = Label ? FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Label), Len)) : FString();
+            break;
+        }
+
+        default:
+            bOk = false;
+            break;
+        }
+
+        if (!bOk || R.IsError())
+        {
+            UE_LOG(LogTowerReplayRing, Warning, TEXT("ReplayRecorder: chunk %llu is corrupt past byte %d"), Chunks[ChunkIndex].Sequence, Cursor);
+            Cursor = Raw.Num();
+            continue;
+        }
+
+        Cursor = R.GetPos();
+        return true;
+    }
+}
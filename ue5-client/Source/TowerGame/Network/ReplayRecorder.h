@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "Core/ReplayArchive.h"
+
+class FRunnableThread;
+struct FWorldStateBuffer;
+struct FTowerMoveInput;
+enum class EPredictedActionType : uint8;
+
+/**
+ * Replay ring layout (all little-endian). The file is a fixed number of
+ * fixed-size chunk slots, written round-robin, so a recording left running
+ * never grows past HeaderSize + NumChunks * ChunkBytes and always holds the
+ * most recent stretch of play:
+ *
+ *   header  u32 magic 'TRRB', u16 version, u16 reserved, u32 chunk bytes,
+ *           u32 chunk count, u64 seed, i32 floor id, u32 reserved
+ *   slot    u32 magic 'TRRC', u32 flags (1 = compressed), u64 sequence,
+ *           u32 frame count, u32 raw size, u32 stored size, u32 reserved,
+ *           then stored size bytes (Oodle when compressed)
+ *
+ * A chunk decodes on its own: its first snapshot is a keyframe, later ones
+ * carry only the fields that changed since the previous snapshot of the
+ * chunk. Frames inside a chunk:
+ *
+ *   u8 kind, varint microseconds since the previous frame (the first frame
+ *   of a chunk: since the recording started), then by kind
+ *
+ *   Snapshot  varint server tick delta, f64 server time, u8 cycle phase,
+ *             varint local player id, then players and monsters as
+ *             varint count x { varint id delta, u8 changed mask, fields }
+ *   Input     u8 EPredictedActionType, u8 flags (1 = move input),
+ *             [i8 forward, i8 right, u16 yaw], f32 x3 position, f32 facing
+ *   Marker    varint length, UTF-8 label
+ *
+ * Positions, rotations and health are stored as f32; times as f64; monster
+ * status as the u32 status mask (version 2; version 1 stored an effect list).
+ */
+namespace TowerReplayRing
+{
+    constexpr uint32 Magic = 0x42525254;        // "TRRB"
+    constexpr uint32 ChunkMagic = 0x43525254;   // "TRRC"
+    constexpr uint16 Version = 2;
+    constexpr int32 HeaderSize = 32;
+    constexpr int32 ChunkHeaderSize = 32;
+
+    /** 64 x 256 KB: several minutes of a full floor's snapshots at 20 Hz */
+    constexpr int32 DefaultChunkBytes = 256 * 1024;
+    constexpr int32 DefaultNumChunks = 64;
+}
+
+enum class ETowerReplayFrame : uint8
+{
+    Snapshot = 0,
+    Input = 1,
+    Marker = 2,
+};
+
+/** One local input, as PredictAction / PredictMove saw it */
+struct FTowerRecordedInput
+{
+    uint8 ActionType = 0;   // EPredictedActionType
+    bool bHasMove = false;
+    int8 Forward = 0;
+    int8 Right = 0;
+    uint16 Yaw = 0;
+    FVector3f Position = FVector3f::ZeroVector;
+    float Facing = 0.0f;
+};
+
+/** A decoded frame; snapshots go to the state passed to FTowerReplayRingReader::Next alongside it */
+struct FTowerReplayRingFrame
+{
+    ETowerReplayFrame Kind = ETowerReplayFrame::Snapshot;
+
+    /** Seconds since the recording started */
+    double Time = 0.0;
+
+    FTowerRecordedInput Input;
+    FString Marker;
+};
+
+/**
+ * Records what the client saw and did: the snapshots UTowerStateSynchronizer
+ * buffers and the local inputs it predicts, into a replay ring file.
+ *
+ * The game thread only copies the snapshot or input into a lock-free queue
+ * (single producer, single consumer); delta encoding, compression and file
+ * writes all happen on the recorder's own thread, one chunk at a time, so a
+ * recorded frame costs the game thread a copy of the snapshot arrays.
+ *
+ * Markers label a point in the recording (UTowerNetworkSubsystem marks boss
+ * room entries); ExportContainer can start from the last one, which turns the
+ * tail of the ring into a replay container UReplayControlWidget plays.
+ */
+class TOWERGAME_API FTowerReplayRecorder
+{
+public:
+    FTowerReplayRecorder();
+    ~FTowerReplayRecorder();
+
+    /** Start writing a ring at Path, replacing it; stops any current recording first */
+    bool Start(const FString& Path, uint64 Seed = 0, int32 FloorId = 0,
+        int32 ChunkBytes = TowerReplayRing::DefaultChunkBytes, int32 NumChunks = TowerReplayRing::DefaultNumChunks);
+
+    /** Write what is queued, including the partial chunk, and close the file */
+    void Stop();
+
+    bool IsRecording() const { return Thread != nullptr; }
+    const FString& GetPath() const { return Path; }
+
+    /** Game thread only; State sorted by entity id, as buffered */
+    void RecordSnapshot(const FWorldStateBuffer& State);
+    void RecordInput(EPredictedActionType ActionType, const FVector& Position, float Facing, const FTowerMoveInput* Move = nullptr);
+    void RecordMarker(const FString& Label);
+
+    int64 GetBytesWritten() const { return BytesWritten.GetValue(); }
+    int64 GetChunksWritten() const { return ChunksWritten.GetValue(); }
+
+    /**
+     * Write the local inputs of the ring at RingPath as a replay container at
+     * OutPath, in Rust ReplayRecording ticks (10 a second) from the start of the
+     * recording, or from the last marker with bFromLastMarker.
+     */
+    static bool ExportContainer(const FString& RingPath, const FString& OutPath, bool bFromLastMarker = false,
+        int32 KeyframeInterval = TowerReplay::DefaultKeyframeInterval);
+
+private:
+    class FWorker;
+
+    TUniquePtr<FWorker> Worker;
+    FRunnableThread* Thread = nullptr;
+    FString Path;
+    double StartSeconds = 0.0;
+
+    FThreadSafeCounter64 BytesWritten;
+    FThreadSafeCounter64 ChunksWritten;
+};
+
+/** Reads a replay ring back, oldest chunk first */
+class TOWERGAME_API FTowerReplayRingReader
+{
+public:
+    FTowerReplayRingReader();
+    ~FTowerReplayRingReader();
+
+    bool Open(const FString& Path);
+
+    uint64 GetSeed() const { return Seed; }
+    int32 GetFloorId() const { return FloorId; }
+    int32 GetNumChunks() const { return Chunks.Num(); }
+
+    /**
+     * The next frame; for snapshots OutState is the whole state, rebuilt from the
+     * chunk's keyframe. False at the end, or at a chunk that doesn't decode.
+     */
+    bool Next(FTowerReplayRingFrame& OutFrame, FWorldStateBuffer& OutState);
+
+private:
+    struct FChunk
+    {
+        uint64 Sequence = 0;
+        int64 Offset = 0;
+        uint32 Flags = 0;
+        int32 RawSize = 0;
+        int32 StoredSize = 0;
+    };
+
+    bool LoadChunk(int32 Index);
+
+    TArray<uint8> File;
+    TArray<FChunk> Chunks;
+    uint64 Seed = 0;
+    int32 FloorId = 0;
+
+    int32 ChunkIndex = INDEX_NONE;
+    TArray<uint8> Raw;
+    int32 Cursor = 0;
+    double Time = 0.0;
+    int64 ServerTick = 0;
+
+    /** Previous snapshot of the chunk, which the next one is a delta on */
+    TUniquePtr<FWorldStateBuffer> Baseline;
+};
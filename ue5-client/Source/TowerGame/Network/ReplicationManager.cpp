@@ -1,18 +1,28 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ReplicationManager.h"
+#include "TowerNetworkSubsystem.h"
+#include "Core/PerfCounters.h"
+#include "Core/TowerMemory.h"
+#include "Core/TowerLog.h"
+#include "World/FloorTeardownSubsystem.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "Components/StaticMeshComponent.h"
 #include "UObject/ConstructorHelpers.h"
 
 AReplicationManager::AReplicationManager()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Stepped by the network clock, see BeginPlay
+    PrimaryActorTick.bCanEverTick = false;
     bReplicates = false; // This is client-side only
 
     PacketsReceived = 0;
     BytesReceived = 0;
     LastUpdateTime = 0.0f;
+    MaxReceiveDelayMs = 0.0f;
 
     // Create netcode client
     NetcodeClient = CreateDefaultSubobject<UNetcodeClient>(TEXT("NetcodeClient"));
@@ -22,28 +32,138 @@ void AReplicationManager::BeginPlay()
 {
     Super::BeginPlay();
 
+    SharedEntities = UTowerNetworkSubsystem::FindEntityRegistry(this);
+
+    NetClock = UTowerNetworkSubsystem::FindNetClock(this);
+    if (!NetClock)
+    {
+        OwnedNetClock = MakeUnique<FTowerNetClock>();
+        NetClock = OwnedNetClock.Get();
+    }
+    StepHandles[static_cast<int32>(ETowerNetPhase::Receive)] =
+        NetClock->OnStep(ETowerNetPhase::Receive).AddUObject(this, &AReplicationManager::StepReceive);
+    StepHandles[static_cast<int32>(ETowerNetPhase::Apply)] =
+        NetClock->OnStep(ETowerNetPhase::Apply).AddUObject(this, &AReplicationManager::StepApply);
+    StepHandles[static_cast<int32>(ETowerNetPhase::Send)] =
+        NetClock->OnStep(ETowerNetPhase::Send).AddUObject(this, &AReplicationManager::StepSend);
+
     UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Ready"));
 }
 
-void AReplicationManager::Tick(float DeltaTime)
+void AReplicationManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime);
+    if (NetClock)
+    {
+        for (int32 Phase = 0; Phase < static_cast<int32>(ETowerNetPhase::Num); ++Phase)
+        {
+            NetClock->OnStep(static_cast<ETowerNetPhase>(Phase)).Remove(StepHandles[Phase]);
+        }
+        NetClock = nullptr;
+    }
+    OwnedNetClock.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
 
+void AReplicationManager::StepReceive(float StepSeconds)
+{
     if (!NetcodeClient || !NetcodeClient->IsConnected())
     {
         return;
     }
 
-    // Update netcode client
-    NetcodeClient->Tick(DeltaTime);
-
     // Process received packets
     ProcessReceivedPackets();
 
-    LastUpdateTime += DeltaTime;
+    LastUpdateTime += StepSeconds;
+}
+
+void AReplicationManager::StepApply(float StepSeconds)
+{
+    // Tiles received this step (or fed by a replay) land together
+    FlushFloorTiles();
+
+    if (bResuming)
+    {
+        TickResume();
+        return;
+    }
+
+    // Silence: a Wi-Fi blip or NAT rebinding took the link. Keep the world and reopen it
+    if (NetcodeClient && NetcodeClient->IsConnected() && ResumeGraceSeconds > 0.0f
+        && FPlatformTime::Seconds() - NetcodeClient->GetLastPacketTime() > LinkTimeoutSeconds)
+    {
+        BeginResume();
+    }
+}
+
+void AReplicationManager::StepSend(float StepSeconds)
+{
+    if (!NetcodeClient || !NetcodeClient->IsConnected())
+    {
+        return;
+    }
+
+    // The interest cell goes out with this step's keepalive
+    if (bInterestManagement)
+    {
+        UpdateInterestViewer();
+    }
+
+    NetcodeClient->Tick(StepSeconds);
+}
+
+void AReplicationManager::BeginResume()
+{
+    UE_LOG(LogTemp, Warning, TEXT("ReplicationManager: No packets for %.1fs, resuming as client %lld for up to %.0fs"),
+        LinkTimeoutSeconds, SessionClientId, ResumeGraceSeconds);
+
+    bResuming = true;
+    ResumeStartedAt = FPlatformTime::Seconds();
+    NextResumeAttemptAt = ResumeStartedAt;
+    ResumeConnectedAt = 0.0;
+    ResumeAttempts = 0;
+}
+
+void AReplicationManager::TickResume()
+{
+    const double Now = FPlatformTime::Seconds();
+
+    // The server answers the same client id with the same player entity, so the
+    // first packet after reconnecting is an update to actors we still have
+    if (ResumeAttempts > 0 && NetcodeClient->IsConnected() && NetcodeClient->GetLastPacketTime() > ResumeConnectedAt)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Resumed after %.2fs (%d attempt(s))"),
+            Now - ResumeStartedAt, ResumeAttempts);
+        bResuming = false;
+        OnLinkResumed.Broadcast();
+        return;
+    }
+
+    if (Now - ResumeStartedAt >= ResumeGraceSeconds)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ReplicationManager: Not resumed after %d attempt(s) in %.0fs"),
+            ResumeAttempts, ResumeGraceSeconds);
+        Disconnect();
+        OnLinkLost.Broadcast();
+        return;
+    }
+
+    if (Now < NextResumeAttemptAt)
+    {
+        return;
+    }
+
+    // A fresh socket (the old one may be bound to a dead route), same identity
+    ++ResumeAttempts;
+    NetcodeClient->Disconnect();
+    NetcodeClient->SetRequestedClientId(SessionClientId);
+    NetcodeClient->Connect(ServerIP, ServerPort);
+    ResumeConnectedAt = Now;
+    NextResumeAttemptAt = Now + FMath::Min(0.25 * (1 << FMath::Min(ResumeAttempts, 3)), 2.0);
 }
 
-void AReplicationManager::ConnectToServer(const FString& ServerIP, int32 Port)
+void AReplicationManager::ConnectToServer(const FString& InServerIP, int32 Port)
 {
     if (!NetcodeClient)
     {
@@ -51,10 +171,27 @@ void AReplicationManager::ConnectToServer(const FString& ServerIP, int32 Port)
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Connecting to %s:%d"), *ServerIP, Port);
+    UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Connecting to %s:%d"), *InServerIP, Port);
+
+    NetcodeClient->bUseReceiveThread = bThreadedReceive;
+
+    UTowerNetworkSubsystem* Network = UNetworkBlueprintLibrary::GetTowerNetworkSubsystem(this);
+    NetStats = Network ? &Network->GetNetStats() : nullptr;
+    NetcodeClient->SetNetStats(NetStats);
+    NetcodeClient->SetCapture(Network ? &Network->GetNetCapture() : nullptr);
 
-    if (NetcodeClient->Connect(ServerIP, Port))
+    InterestGrid.Configure(InterestSettings);
+    InterestGrid.Reset();
+
+    // A new session: the id a resume pinned is not ours to keep
+    bResuming = false;
+    NetcodeClient->SetRequestedClientId(0);
+
+    if (NetcodeClient->Connect(InServerIP, Port))
     {
+        ServerIP = InServerIP;
+        ServerPort = Port;
+        SessionClientId = NetcodeClient->GetClientId();
         UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Connected! Client ID: %llu"), NetcodeClient->GetClientId());
     }
     else
@@ -65,40 +202,52 @@ void AReplicationManager::ConnectToServer(const FString& ServerIP, int32 Port)
 
 void AReplicationManager::Disconnect()
 {
+    bResuming = false;
     if (NetcodeClient)
     {
         NetcodeClient->Disconnect();
     }
 
-    // Clean up replicated actors
-    for (auto& Pair : ReplicatedPlayers)
+    DestroyReplicatedActors();
+    InterestGrid.Reset();
+    QuantizeFrame = FNetQuantizeFrame();
+    FMemory::Memzero(PacketTypeCounts);
+
+    UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Disconnected and cleaned up"));
+}
+
+void AReplicationManager::DestroyReplicatedActors()
+{
+    PendingTiles.Reset();
+    PendingTileIndex.Reset();
+    if (IsValid(FloorRenderer))
     {
-        if (Pair.Value)
-        {
-            Pair.Value->Destroy();
-        }
+        FloorRenderer->ClearFloor();
     }
-    ReplicatedPlayers.Empty();
 
-    for (auto& Pair : ReplicatedMonsters)
+    FReplicatedEntityRegistry& Entities = GetEntities();
+    UTowerFloorTeardownSubsystem* Teardown = GetWorld() ? GetWorld()->GetSubsystem<UTowerFloorTeardownSubsystem>() : nullptr;
+    if (!Teardown)
     {
-        if (Pair.Value)
+        for (int32 Slot = Entities.Num() - 1; Slot >= 0; --Slot)
         {
-            Pair.Value->Destroy();
+            if (Entities.GetActor(Slot))
+            {
+                ReleaseEntity(Slot);
+            }
         }
+        return;
     }
-    ReplicatedMonsters.Empty();
 
-    for (AActor* Tile : ReplicatedTiles)
+    // Hidden now, destroyed over the next frames instead of in one spike
+    for (int32 Slot = Entities.Num() - 1; Slot >= 0; --Slot)
     {
-        if (Tile)
+        if (AActor* Actor = Entities.GetActor(Slot))
         {
-            Tile->Destroy();
+            Teardown->RetireActor(Actor);
+            Entities.Remove(Slot);
         }
     }
-    ReplicatedTiles.Empty();
-
-    UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Disconnected and cleaned up"));
 }
 
 bool AReplicationManager::IsConnected() const
@@ -113,79 +262,118 @@ int64 AReplicationManager::GetClientId() const
 
 void AReplicationManager::ProcessReceivedPackets()
 {
-    TArray<TArray<uint8>> Packets;
-    if (!NetcodeClient->ReceivePackets(Packets))
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_ProcessReceivedPackets);
+    if (!NetcodeClient->ReceivePackets(ReceivedPackets))
     {
         return; // No packets
     }
 
-    for (const TArray<uint8>& PacketData : Packets)
+    const double Now = FPlatformTime::Seconds();
+
+    for (const FNetcodeReceivedPacket& Packet : ReceivedPackets)
     {
-        if (PacketData.Num() == 0)
+        if (Packet.Size == 0)
         {
             continue;
         }
 
+        MaxReceiveDelayMs = FMath::Max(MaxReceiveDelayMs, static_cast<float>((Now - Packet.ArrivalTime) * 1000.0));
+
         PacketsReceived++;
-        BytesReceived += PacketData.Num();
+        BytesReceived += Packet.Size;
 
-        // Read packet type
-        FBincodeReader Reader(PacketData);
-        uint8 PacketTypeByte = Reader.ReadU8();
-        EPacketType PacketType = static_cast<EPacketType>(PacketTypeByte);
+        // Decoded in place from the pool slot
+        const uint64 DecodeStart = FPlatformTime::Cycles64();
+        const ETowerNetChannel Channel = ProcessPacket(Packet.GetView());
 
-        // Process based on type
-        switch (PacketType)
+        if (NetStats)
         {
-            case EPacketType::Keepalive:
-                // Ignore keepalive
-                break;
+            NetStats->RecordIncoming(Channel, Packet.Size, FPlatformTime::Cycles64() - DecodeStart);
+        }
+    }
 
-            case EPacketType::PlayerUpdate:
-            case EPacketType::PlayerSpawn:
-                ProcessPlayerData(Reader);
-                break;
+    // Log stats every 5 seconds
+    if (LastUpdateTime >= 5.0f)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ReplicationManager Stats: %d packets, %d bytes, %d players, %d monsters, max receive delay %.1fms, %d dropped, pool high-water %d/%d, interest skipped %d culled %d"),
+            PacketsReceived, BytesReceived, GetReplicatedActorCount(EReplicatedEntityKind::Player), GetReplicatedActorCount(EReplicatedEntityKind::Monster),
+            MaxReceiveDelayMs, NetcodeClient->GetDroppedPacketCount(),
+            NetcodeClient->GetPacketPoolHighWaterMark(), NetcodeClient->GetPacketPoolCapacity(),
+            InterestGrid.GetSkippedCount(), InterestGrid.GetCulledCount());
+        LastUpdateTime = 0.0f;
+        MaxReceiveDelayMs = 0.0f;
+        InterestGrid.ResetStats();
+    }
+}
 
-            case EPacketType::MonsterUpdate:
-                ProcessMonsterData(Reader);
-                break;
+const AReplicationManager::FPacketRoute AReplicationManager::PacketRoutes[] =
+{
+    /* Keepalive              */ { ETowerNetChannel::Keepalive,       nullptr },
+    /* PlayerUpdate           */ { ETowerNetChannel::PlayerUpdate,    &AReplicationManager::ProcessPlayerData<false> },
+    /* MonsterUpdate          */ { ETowerNetChannel::MonsterUpdate,   &AReplicationManager::ProcessMonsterData<false> },
+    /* FloorTileUpdate        */ { ETowerNetChannel::FloorTileUpdate, &AReplicationManager::ProcessFloorTileData },
+    /* PlayerSpawn            */ { ETowerNetChannel::PlayerSpawn,     &AReplicationManager::ProcessPlayerData<false> },
+    /* PlayerDespawn          */ { ETowerNetChannel::PlayerDespawn,   &AReplicationManager::ProcessPlayerDespawn },
+    /* PlayerUpdateQuantized  */ { ETowerNetChannel::PlayerUpdate,    &AReplicationManager::ProcessPlayerData<true> },
+    /* MonsterUpdateQuantized */ { ETowerNetChannel::MonsterUpdate,   &AReplicationManager::ProcessMonsterData<true> },
+    /* FloorBounds            */ { ETowerNetChannel::FloorTileUpdate, &AReplicationManager::ProcessFloorBounds },  // Floor metadata, counted with the tiles
+};
+
+ETowerNetChannel AReplicationManager::ProcessPacket(TArrayView<const uint8> Packet)
+{
+    static_assert(UE_ARRAY_COUNT(PacketRoutes) == NumPacketTypes, "One route per EPacketType");
 
-            case EPacketType::FloorTileUpdate:
-                ProcessFloorTileData(Reader);
-                break;
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerNet_ProcessPacket);
+    TOWER_PERF_SCOPE(NetDecode);
+    LLM_SCOPE_BYTAG(Tower_Net);
 
-            case EPacketType::PlayerDespawn:
-            {
-                int64 PlayerId = Reader.ReadU64();
-                if (AActor** FoundActor = ReplicatedPlayers.Find(PlayerId))
-                {
-                    if (*FoundActor)
-                    {
-                        (*FoundActor)->Destroy();
-                    }
-                    ReplicatedPlayers.Remove(PlayerId);
-                }
-                break;
-            }
+    // Read packet type
+    FBincodeReader Reader(Packet.GetData(), Packet.Num());
+    const uint8 PacketTypeByte = Reader.ReadU8();
 
-            default:
-                UE_LOG(LogTemp, Warning, TEXT("ReplicationManager: Unknown packet type: %d"), PacketTypeByte);
-                break;
-        }
+    if (!Reader.IsValid() || PacketTypeByte >= NumPacketTypes)
+    {
+        TOWER_SLOG(Replication, Warn, TEXT("UnknownPacket"), TEXT("Type"), PacketTypeByte);
+        return ETowerNetChannel::Unknown;
     }
 
-    // Log stats every 5 seconds
-    if (LastUpdateTime >= 5.0f)
+    PacketTypeCounts[PacketTypeByte]++;
+
+    const FPacketRoute& Route = PacketRoutes[PacketTypeByte];
+    if (Route.Handler)
     {
-        UE_LOG(LogTemp, Log, TEXT("ReplicationManager Stats: %d packets, %d bytes, %d players, %d monsters"),
-            PacketsReceived, BytesReceived, ReplicatedPlayers.Num(), ReplicatedMonsters.Num());
-        LastUpdateTime = 0.0f;
+        (this->*Route.Handler)(Reader);
     }
+
+    return Route.Channel;
 }
 
+void AReplicationManager::ProcessPlayerDespawn(FBincodeReader& Reader)
+{
+    const int64 PlayerId = Reader.ReadU64();
+    if (!Reader.IsValid())
+    {
+        return;
+    }
+
+    const int32 Slot = GetEntities().Find(EReplicatedEntityKind::Player, PlayerId);
+    if (Slot != INDEX_NONE)
+    {
+        ReleaseEntity(Slot);
+    }
+    InterestGrid.Forget(PlayerId);
+}
+
+template<bool bQuantized>
 void AReplicationManager::ProcessPlayerData(FBincodeReader& Reader)
 {
-    FPlayerData PlayerData = FPlayerData::FromBincode(Reader);
+    if (bQuantized && !QuantizeFrame.IsValid())
+    {
+        return;
+    }
+
+    Reader.SetQuantizeFrame(&QuantizeFrame);
+    FPlayerData PlayerData = bQuantized ? FPlayerData::FromQuantizedBincode(Reader) : FPlayerData::FromBincode(Reader);
 
     if (!Reader.IsValid())
     {
@@ -193,25 +381,60 @@ void AReplicationManager::ProcessPlayerData(FBincodeReader& Reader)
         return;
     }
 
+    // Our own player is always relevant
+    if (bInterestManagement && PlayerData.Id != GetClientId())
+    {
+        // Player health is out of 100 on this protocol (see AReplicatedPlayerActor)
+        const bool bInCombat = PlayerData.Health < 100.0f;
+        if (!InterestGrid.ShouldApplyUpdate(PlayerData.Id, InterestGrid.GetTier(PlayerData.Position, bInCombat)))
+        {
+            return;
+        }
+    }
+
     AActor* PlayerActor = SpawnOrUpdatePlayer(PlayerData);
 
     if (PlayerActor)
     {
-        UE_LOG(LogTemp, Verbose, TEXT("ReplicationManager: Player %llu updated at %s"),
-            PlayerData.Id, *PlayerData.Position.ToString());
+        TOWER_SLOG(Replication, Trace, TEXT("PlayerUpdated"), TEXT("Id"), PlayerData.Id, TEXT("Pos"), PlayerData.Position);
     }
 }
 
+template<bool bQuantized>
 void AReplicationManager::ProcessMonsterData(FBincodeReader& Reader)
 {
-    FMonsterData MonsterData = FMonsterData::FromBincode(Reader);
+    if (bQuantized && !QuantizeFrame.IsValid())
+    {
+        return;
+    }
 
-    if (!Reader.IsValid())
+    // Decode as a view: updates of existing monsters never need the type as an FString
+    FMonsterDataView MonsterData;
+
+    Reader.SetQuantizeFrame(&QuantizeFrame);
+    const bool bDecoded = bQuantized
+        ? TBincodeQuantizedSchema<FMonsterDataView>::Decode(Reader, MonsterData)
+        : TBincodeSchema<FMonsterDataView>::Decode(Reader, MonsterData);
+    if (!bDecoded)
     {
         UE_LOG(LogTemp, Error, TEXT("ReplicationManager: Failed to parse MonsterData"));
         return;
     }
 
+    if (bInterestManagement)
+    {
+        // Damaged monsters are treated as in combat. Monsters are keyed by position
+        // until the protocol carries ids, and a moving monster's key changes every
+        // update, so they are only culled: decimation state under those keys would
+        // never be reused or forgotten.
+        const bool bInCombat = MonsterData.Health < MonsterData.MaxHealth;
+        const EInterestTier Tier = InterestGrid.GetTier(MonsterData.Position, bInCombat);
+        if (!InterestGrid.ShouldApplyUntrackedUpdate(Tier))
+        {
+            return;
+        }
+    }
+
     SpawnOrUpdateMonster(MonsterData);
 }
 
@@ -224,21 +447,90 @@ void AReplicationManager::ProcessFloorTileData(FBincodeReader& Reader)
         UE_LOG(LogTemp, Error, TEXT("ReplicationManager: Failed to parse FloorTileData"));
         return;
     }
+    if (TileData.TileType >= static_cast<uint8>(ETowerTileType::MAX))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ReplicationManager: Unknown tile type %d at (%d,%d)"),
+            TileData.TileType, TileData.GridX, TileData.GridY);
+        return;
+    }
+
+    // A cell updated twice before the flush only needs its latest type
+    int32& Index = PendingTileIndex.FindOrAdd(FIntPoint(TileData.GridX, TileData.GridY), INDEX_NONE);
+    if (Index == INDEX_NONE)
+    {
+        Index = PendingTiles.AddDefaulted();
+        PendingTiles[Index].X = TileData.GridX;
+        PendingTiles[Index].Y = TileData.GridY;
+    }
+    PendingTiles[Index].TileType = static_cast<ETowerTileType>(TileData.TileType);
+}
+
+void AReplicationManager::FlushFloorTiles()
+{
+    if (PendingTiles.Num() == 0)
+    {
+        return;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(Replication_FlushFloorTiles);
+    if (ATowerProceduralFloorRenderer* Renderer = GetOrSpawnFloorRenderer())
+    {
+        Renderer->ApplyTileUpdates(PendingTiles);
+    }
+    PendingTiles.Reset();
+    PendingTileIndex.Reset();
+}
+
+ATowerProceduralFloorRenderer* AReplicationManager::GetOrSpawnFloorRenderer()
+{
+    if (IsValid(FloorRenderer))
+    {
+        return FloorRenderer;
+    }
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    UClass* RendererClass = FloorRendererClass ? FloorRendererClass.Get() : ATowerProceduralFloorRenderer::StaticClass();
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = this;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    FloorRenderer = World->SpawnActor<ATowerProceduralFloorRenderer>(RendererClass, FTransform::Identity, SpawnParams);
+    return FloorRenderer;
+}
+
+void AReplicationManager::ProcessFloorBounds(FBincodeReader& Reader)
+{
+    const FVector Min = Reader.ReadVec3();
+    const FVector Max = Reader.ReadVec3();
+
+    if (!Reader.IsValid() || !FNetQuantizeFrame(Min, Max).IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("ReplicationManager: Failed to parse FloorBounds"));
+        return;
+    }
 
-    SpawnFloorTile(TileData);
+    QuantizeFrame = FNetQuantizeFrame(Min, Max);
+    UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Quantize frame %s - %s (step %s)"),
+        *Min.ToString(), *Max.ToString(), *QuantizeFrame.GetStep().ToString());
 }
 
 AActor* AReplicationManager::SpawnOrUpdatePlayer(const FPlayerData& PlayerData)
 {
+    FReplicatedEntityRegistry& Entities = GetEntities();
+    const int32 Slot = Entities.FindOrAdd(EReplicatedEntityKind::Player, PlayerData.Id);
+    Entities.Position(Slot) = PlayerData.Position;
+    Entities.Health(Slot) = PlayerData.Health;
+
     // Check if player already exists
-    if (AActor** ExistingActor = ReplicatedPlayers.Find(PlayerData.Id))
+    if (AActor* ExistingActor = Entities.GetActor(Slot))
     {
-        if (*ExistingActor)
-        {
-            UpdatePlayerActor(*ExistingActor, PlayerData);
-            OnPlayerUpdated.Broadcast(*ExistingActor);
-            return *ExistingActor;
-        }
+        UpdatePlayerActor(ExistingActor, PlayerData);
+        OnPlayerUpdated.Broadcast(ExistingActor);
+        return ExistingActor;
     }
 
     // Spawn new player
@@ -266,30 +558,29 @@ AActor* AReplicationManager::SpawnOrUpdatePlayer(const FPlayerData& PlayerData)
     if (NewActor)
     {
         UpdatePlayerActor(NewActor, PlayerData);
-        ReplicatedPlayers.Add(PlayerData.Id, NewActor);
+        Entities.SetActor(Slot, NewActor);
 
         OnPlayerSpawned.Broadcast(NewActor);
 
-        UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Spawned player %llu at %s"),
-            PlayerData.Id, *PlayerData.Position.ToString());
+        TOWER_SLOG(Replication, Info, TEXT("PlayerSpawned"), TEXT("Id"), PlayerData.Id, TEXT("Pos"), PlayerData.Position);
     }
 
     return NewActor;
 }
 
-AActor* AReplicationManager::SpawnOrUpdateMonster(const FMonsterData& MonsterData)
+AActor* AReplicationManager::SpawnOrUpdateMonster(const FMonsterDataView& MonsterData)
 {
-    // For monsters, use position as hash key (no unique ID from server yet)
-    // TODO: Add monster IDs to server protocol
-    int64 MonsterHash = static_cast<int64>(MonsterData.Position.X * 1000 + MonsterData.Position.Y * 100 + MonsterData.Position.Z * 10);
+    const int64 MonsterHash = GetMonsterKey(MonsterData.Position);
 
-    if (AActor** ExistingActor = ReplicatedMonsters.Find(MonsterHash))
+    FReplicatedEntityRegistry& Entities = GetEntities();
+    const int32 Slot = Entities.FindOrAdd(EReplicatedEntityKind::Monster, MonsterHash);
+    Entities.Position(Slot) = MonsterData.Position;
+    Entities.Health(Slot) = MonsterData.Health;
+
+    if (AActor* ExistingActor = Entities.GetActor(Slot))
     {
-        if (*ExistingActor)
-        {
-            UpdateMonsterActor(*ExistingActor, MonsterData);
-            return *ExistingActor;
-        }
+        UpdateMonsterActor(ExistingActor, MonsterData);
+        return ExistingActor;
     }
 
     // Spawn new monster
@@ -307,35 +598,46 @@ AActor* AReplicationManager::SpawnOrUpdateMonster(const FMonsterData& MonsterDat
     if (NewActor)
     {
         UpdateMonsterActor(NewActor, MonsterData);
-        ReplicatedMonsters.Add(MonsterHash, NewActor);
+        Entities.SetActor(Slot, NewActor);
 
-        UE_LOG(LogTemp, Log, TEXT("ReplicationManager: Spawned monster '%s' at %s"),
-            *MonsterData.MonsterType, *MonsterData.Position.ToString());
+        TOWER_SLOG(Replication, Info, TEXT("MonsterSpawned"), TEXT("Type"), MonsterData.MonsterType.ToString(),
+            TEXT("Pos"), MonsterData.Position);
     }
 
     return NewActor;
 }
 
-AActor* AReplicationManager::SpawnFloorTile(const FFloorTileData& TileData)
+void AReplicationManager::ReleaseEntity(int32 Slot)
 {
-    UWorld* World = GetWorld();
-    if (!World || !FloorTileActorClass)
+    FReplicatedEntityRegistry& Entities = GetEntities();
+    if (AActor* Actor = Entities.GetActor(Slot))
     {
-        return nullptr;
+        Actor->Destroy();
     }
+    Entities.Remove(Slot);
+}
 
-    // Calculate world position from grid coordinates
-    FVector WorldPosition(TileData.GridX * 100.0f, TileData.GridY * 100.0f, 0.0f);
-
-    FActorSpawnParameters SpawnParams;
-    AActor* NewTile = World->SpawnActor<AActor>(FloorTileActorClass, WorldPosition, FRotator::ZeroRotator, SpawnParams);
+AActor* AReplicationManager::FindReplicatedActor(EReplicatedEntityKind Kind, int64 EntityId) const
+{
+    const FReplicatedEntityRegistry& Entities = GetEntities();
+    const int32 Slot = Entities.Find(Kind, EntityId);
+    return Slot != INDEX_NONE ? Entities.GetActor(Slot) : nullptr;
+}
 
-    if (NewTile)
+void AReplicationManager::GetReplicatedActors(EReplicatedEntityKind Kind, TArray<AActor*>& OutActors) const
+{
+    OutActors.Reset();
+    GetEntities().ForEachActor(Kind, [&OutActors](int64, AActor* Actor)
     {
-        ReplicatedTiles.Add(NewTile);
-    }
+        OutActors.Add(Actor);
+    });
+}
 
-    return NewTile;
+int32 AReplicationManager::GetReplicatedActorCount(EReplicatedEntityKind Kind) const
+{
+    int32 Count = 0;
+    GetEntities().ForEachActor(Kind, [&Count](int64, AActor*) { ++Count; });
+    return Count;
 }
 
 void AReplicationManager::UpdatePlayerActor(AActor* Actor, const FPlayerData& Data)
@@ -355,7 +657,7 @@ void AReplicationManager::UpdatePlayerActor(AActor* Actor, const FPlayerData& Da
     }
 }
 
-void AReplicationManager::UpdateMonsterActor(AActor* Actor, const FMonsterData& Data)
+void AReplicationManager::UpdateMonsterActor(AActor* Actor, const FMonsterDataView& Data)
 {
     if (!Actor)
     {
@@ -366,10 +668,50 @@ void AReplicationManager::UpdateMonsterActor(AActor* Actor, const FMonsterData&
 
     if (AReplicatedMonsterActor* MonsterActor = Cast<AReplicatedMonsterActor>(Actor))
     {
-        MonsterActor->UpdateFromData(Data);
+        MonsterActor->UpdateFromView(Data);
     }
 }
 
+int64 AReplicationManager::GetMonsterKey(const FVector& Position)
+{
+    // For monsters, use position as hash key (no unique ID from server yet)
+    // TODO: Add monster IDs to server protocol
+    return static_cast<int64>(Position.X * 1000 + Position.Y * 100 + Position.Z * 10);
+}
+
+void AReplicationManager::UpdateInterestViewer()
+{
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+    if (!Pawn)
+    {
+        return;
+    }
+
+    if (InterestGrid.SetViewerPosition(Pawn->GetActorLocation()))
+    {
+        SendInterestCell();
+    }
+}
+
+void AReplicationManager::SendInterestCell()
+{
+    const FIntPoint Cell = InterestGrid.GetViewerCell();
+
+    // Cells are in UE5 space; the server converts with the same cell size
+    InterestSendBuffer.Reset();
+    FBincodeWriter Writer(InterestSendBuffer);
+    Writer.WriteU8(INTEREST_PACKET_TYPE);
+    Writer.WriteI32(Cell.X);
+    Writer.WriteI32(Cell.Y);
+    Writer.WriteU8(static_cast<uint8>(FMath::Clamp(InterestSettings.FarRadiusCells, 0, 255)));
+
+    NetcodeClient->SendPacket(InterestSendBuffer, ETowerNetChannel::Interest);
+
+    TOWER_SLOG(Replication, Debug, TEXT("InterestCell"), TEXT("X"), Cell.X, TEXT("Y"), Cell.Y);
+}
+
 // ============================================================================
 // AReplicatedPlayerActor
 // ============================================================================
@@ -437,10 +779,24 @@ AReplicatedMonsterActor::AReplicatedMonsterActor()
 
 void AReplicatedMonsterActor::UpdateFromData(const FMonsterData& Data)
 {
-    MonsterType = Data.MonsterType;
+    MonsterType = FName(*Data.MonsterType);
+    Health = Data.Health;
+    MaxHealth = Data.MaxHealth;
+
+    RefreshAppearance();
+}
+
+void AReplicatedMonsterActor::UpdateFromView(const FMonsterDataView& Data)
+{
+    MonsterType = Data.MonsterType.ToName();
     Health = Data.Health;
     MaxHealth = Data.MaxHealth;
 
+    RefreshAppearance();
+}
+
+void AReplicatedMonsterActor::RefreshAppearance()
+{
     // Color monsters red
     if (MeshComponent)
     {
@@ -6,6 +6,10 @@
 #include "GameFramework/Actor.h"
 #include "NetcodeClient.h"
 #include "BincodeSerializer.h"
+#include "InterestGrid.h"
+#include "EntityRegistry.h"
+#include "NetClock.h"
+#include "Rendering/ProceduralFloorRenderer.h"
 #include "ReplicationManager.generated.h"
 
 // Forward declarations
@@ -13,6 +17,10 @@
 /**
  * Manages replication of entities from Bevy server to UE5
  * Handles spawning, updating, and destroying replicated actors
+ *
+ * Doesn't tick: it steps on UTowerNetworkSubsystem's FTowerNetClock (its own
+ * without one), receiving and applying in the Receive phase, watching the link
+ * in Apply and sending in Send.
  */
 UCLASS(BlueprintType)
 class TOWERGAME_API AReplicationManager : public AActor
@@ -23,11 +31,11 @@ public:
     AReplicationManager();
 
     virtual void BeginPlay() override;
-    virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // Connection management
     UFUNCTION(BlueprintCallable, Category = "Replication")
-    void ConnectToServer(const FString& ServerIP, int32 Port);
+    void ConnectToServer(const FString& InServerIP, int32 Port);
 
     UFUNCTION(BlueprintCallable, Category = "Replication")
     void Disconnect();
@@ -35,9 +43,24 @@ public:
     UFUNCTION(BlueprintPure, Category = "Replication")
     bool IsConnected() const;
 
+    /**
+     * The server went quiet for LinkTimeoutSeconds and the link is being
+     * reopened with the same client id; replicated actors stay as they are
+     */
+    UFUNCTION(BlueprintPure, Category = "Replication")
+    bool IsResuming() const { return bResuming; }
+
     UFUNCTION(BlueprintPure, Category = "Replication")
     int64 GetClientId() const;
 
+    UNetcodeClient* GetNetcodeClient() const { return NetcodeClient; }
+
+    /** Decode and apply one datagram; also the entry point for FNetReplayDriver */
+    ETowerNetChannel ProcessPacket(TArrayView<const uint8> Packet);
+
+    /** Packets of one server packet type (EPacketType value) since connecting */
+    uint32 GetPacketTypeCount(uint8 PacketType) const { return PacketType < NumPacketTypes ? PacketTypeCounts[PacketType] : 0; }
+
     // Actor class configuration
     UPROPERTY(EditDefaultsOnly, Category = "Replication")
     TSubclassOf<AActor> PlayerActorClass;
@@ -45,18 +68,59 @@ public:
     UPROPERTY(EditDefaultsOnly, Category = "Replication")
     TSubclassOf<AActor> MonsterActorClass;
 
+    /** Spawned for replicated floor tiles when FloorRenderer is unset (assets live on a Blueprint of it) */
     UPROPERTY(EditDefaultsOnly, Category = "Replication")
-    TSubclassOf<AActor> FloorTileActorClass;
+    TSubclassOf<ATowerProceduralFloorRenderer> FloorRendererClass;
+
+    /**
+     * Draws the replicated floor: each step's FloorTileUpdate packets go to it as
+     * one ApplyTileUpdates batch. Spawned from FloorRendererClass on the first
+     * tile when unset; don't share one that builds floors of its own.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+    ATowerProceduralFloorRenderer* FloorRenderer = nullptr;
 
-    // Replicated actors
-    UPROPERTY(BlueprintReadOnly, Category = "Replication")
-    TMap<int64, AActor*> ReplicatedPlayers;
+    /** Receive datagrams on a dedicated thread so frame hitches don't delay them */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+    bool bThreadedReceive = true;
 
-    UPROPERTY(BlueprintReadOnly, Category = "Replication")
-    TMap<int64, AActor*> ReplicatedMonsters;
+    /** Worst time a datagram waited between arrival and processing in the last stats window (ms) */
+    UFUNCTION(BlueprintPure, Category = "Replication")
+    float GetMaxReceiveDelayMs() const { return MaxReceiveDelayMs; }
 
-    UPROPERTY(BlueprintReadOnly, Category = "Replication")
-    TArray<AActor*> ReplicatedTiles;
+    /** Seconds without a datagram before the link counts as dropped and is resumed */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication|Resume", meta = (ClampMin = "0.5"))
+    float LinkTimeoutSeconds = 2.0f;
+
+    /** How long a dropped link is retried before everything is torn down as on Disconnect(); 0 = no resume */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication|Resume", meta = (ClampMin = "0"))
+    float ResumeGraceSeconds = 10.0f;
+
+    /** Skip or thin out updates for entities far from the local pawn */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication|Interest")
+    bool bInterestManagement = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication|Interest", meta = (EditCondition = "bInterestManagement"))
+    FInterestSettings InterestSettings;
+
+    /** Relevancy cell last reported to the server */
+    UFUNCTION(BlueprintPure, Category = "Replication|Interest")
+    FIntPoint GetInterestCell() const { return InterestGrid.GetViewerCell(); }
+
+    const FInterestGrid& GetInterestGrid() const { return InterestGrid; }
+
+    // Replicated actors (players and monsters live in the shared FReplicatedEntityRegistry)
+    UFUNCTION(BlueprintPure, Category = "Replication")
+    AActor* FindReplicatedActor(EReplicatedEntityKind Kind, int64 EntityId) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Replication")
+    void GetReplicatedActors(EReplicatedEntityKind Kind, TArray<AActor*>& OutActors) const;
+
+    UFUNCTION(BlueprintPure, Category = "Replication")
+    int32 GetReplicatedActorCount(EReplicatedEntityKind Kind) const;
+
+    /** Destroy every player and monster actor this manager spawned and clear the replicated floor */
+    void DestroyReplicatedActors();
 
     // Events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlayerSpawned, AActor*, PlayerActor);
@@ -67,6 +131,15 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Replication")
     FOnPlayerUpdated OnPlayerUpdated;
 
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLinkResumed);
+    UPROPERTY(BlueprintAssignable, Category = "Replication")
+    FOnLinkResumed OnLinkResumed;
+
+    /** The grace ran out; the manager has disconnected and destroyed its actors */
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLinkLost);
+    UPROPERTY(BlueprintAssignable, Category = "Replication")
+    FOnLinkLost OnLinkLost;
+
 protected:
     // Netcode client
     UPROPERTY()
@@ -74,17 +147,43 @@ protected:
 
     // Packet processing
     void ProcessReceivedPackets();
+    template<bool bQuantized>
     void ProcessPlayerData(FBincodeReader& Reader);
+    template<bool bQuantized>
     void ProcessMonsterData(FBincodeReader& Reader);
     void ProcessFloorTileData(FBincodeReader& Reader);
+    void ProcessFloorBounds(FBincodeReader& Reader);
+    void ProcessPlayerDespawn(FBincodeReader& Reader);
 
     // Entity management
     AActor* SpawnOrUpdatePlayer(const FPlayerData& PlayerData);
-    AActor* SpawnOrUpdateMonster(const FMonsterData& MonsterData);
-    AActor* SpawnFloorTile(const FFloorTileData& TileData);
+    AActor* SpawnOrUpdateMonster(const FMonsterDataView& MonsterData);
+
+    /** Hand the tiles received since the last call to FloorRenderer in one batch */
+    void FlushFloorTiles();
+    ATowerProceduralFloorRenderer* GetOrSpawnFloorRenderer();
 
     void UpdatePlayerActor(AActor* Actor, const FPlayerData& Data);
-    void UpdateMonsterActor(AActor* Actor, const FMonsterData& Data);
+    void UpdateMonsterActor(AActor* Actor, const FMonsterDataView& Data);
+
+    // Network clock phases
+    void StepReceive(float StepSeconds);
+    void StepApply(float StepSeconds);
+    void StepSend(float StepSeconds);
+
+    FTowerNetClock* NetClock = nullptr;
+    TUniquePtr<FTowerNetClock> OwnedNetClock;
+    FDelegateHandle StepHandles[static_cast<int32>(ETowerNetPhase::Num)];
+
+    // Resume
+    void BeginResume();
+    void TickResume();
+
+    // Interest management
+    void UpdateInterestViewer();
+    void SendInterestCell();
+
+    static int64 GetMonsterKey(const FVector& Position);
 
 private:
     // Protocol packet types (must match Bevy server)
@@ -96,8 +195,40 @@ private:
         FloorTileUpdate = 0x03,
         PlayerSpawn = 0x04,
         PlayerDespawn = 0x05,
+        PlayerUpdateQuantized = 0x06,   // TBincodeQuantizedSchema layouts, against FloorBounds
+        MonsterUpdateQuantized = 0x07,
+        FloorBounds = 0x08,             // [f32; 3] min, [f32; 3] max, Bevy space; sent per floor
     };
 
+    static constexpr int32 NumPacketTypes = static_cast<int32>(EPacketType::FloorBounds) + 1;
+
+    /** Where a packet type goes: its stats channel and decoder (none for keepalives) */
+    struct FPacketRoute
+    {
+        ETowerNetChannel Channel;
+        void (AReplicationManager::*Handler)(FBincodeReader& Reader);
+    };
+
+    /** Indexed by EPacketType; ProcessPacket's only dispatch */
+    static const FPacketRoute PacketRoutes[];
+
+    /** Packets received per type since connecting */
+    uint32 PacketTypeCounts[NumPacketTypes] = {};
+
+    /** Floor tiles waiting for FlushFloorTiles, the latest per cell, and where each cell's is */
+    TArray<FTileRenderData> PendingTiles;
+    TMap<FIntPoint, int32> PendingTileIndex;
+
+    /** Last FloorBounds; quantized updates are dropped until one arrives */
+    FNetQuantizeFrame QuantizeFrame;
+
+    // Client -> server: u8 type, i32 cell x, i32 cell y, u8 radius (cells).
+    // Sits next to UTowerActionSender::ACTION_PACKET_TYPE (0x10).
+    static constexpr uint8 INTEREST_PACKET_TYPE = 0x11;
+
+    FInterestGrid InterestGrid;
+    TArray<uint8> InterestSendBuffer;
+
     // Stats
     UPROPERTY()
     int32 PacketsReceived;
@@ -107,6 +238,35 @@ private:
 
     UPROPERTY()
     float LastUpdateTime;
+
+    float MaxReceiveDelayMs;
+
+    // Where and as whom we're connected, for a resume
+    FString ServerIP;
+    int32 ServerPort = 0;
+    int64 SessionClientId = 0;
+
+    bool bResuming = false;
+    double ResumeStartedAt = 0.0;
+    double NextResumeAttemptAt = 0.0;
+    double ResumeConnectedAt = 0.0;
+    int32 ResumeAttempts = 0;
+
+    /** UTowerNetworkSubsystem's traffic stats, looked up on connect */
+    FTowerNetStatsCollector* NetStats = nullptr;
+
+    /** UTowerNetworkSubsystem's registry, looked up in BeginPlay; OwnedEntities without one */
+    FReplicatedEntityRegistry* SharedEntities = nullptr;
+    FReplicatedEntityRegistry OwnedEntities;
+
+    FReplicatedEntityRegistry& GetEntities() { return SharedEntities ? *SharedEntities : OwnedEntities; }
+    const FReplicatedEntityRegistry& GetEntities() const { return SharedEntities ? *SharedEntities : OwnedEntities; }
+
+    /** Destroy the slot's actor and remove the slot */
+    void ReleaseEntity(int32 Slot);
+
+    // Reused every tick to avoid reallocating the packet list
+    TArray<FNetcodeReceivedPacket> ReceivedPackets;
 };
 
 /**
@@ -148,7 +308,7 @@ public:
     AReplicatedMonsterActor();
 
     UPROPERTY(BlueprintReadWrite, Category = "Monster")
-    FString MonsterType;
+    FName MonsterType;
 
     UPROPERTY(BlueprintReadWrite, Category = "Monster")
     float Health;
@@ -160,4 +320,10 @@ public:
     UStaticMeshComponent* MeshComponent;
 
     void UpdateFromData(const FMonsterData& Data);
+
+    /** Same as UpdateFromData, straight from the packet without an intermediate FString */
+    void UpdateFromView(const FMonsterDataView& Data);
+
+private:
+    void RefreshAppearance();
 };
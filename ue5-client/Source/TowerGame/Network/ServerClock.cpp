@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ServerClock.h"
+
+// ============================================================================
+// FServerClockEstimator
+// ============================================================================
+
+void FServerClockEstimator::Reset()
+{
+    NumSamples = 0;
+    NextSample = 0;
+    BestTransit = 0.0;
+    RoundTrip = 0.0;
+}
+
+void FServerClockEstimator::AddSample(double ServerTime, double ArrivalTime, double InRoundTrip)
+{
+    Transits[NextSample] = ServerTime - ArrivalTime;
+    NextSample = (NextSample + 1) % WindowSize;
+    NumSamples = FMath::Min(NumSamples + 1, WindowSize);
+
+    BestTransit = Transits[0];
+    for (int32 i = 1; i < NumSamples; ++i)
+    {
+        BestTransit = FMath::Max(BestTransit, Transits[i]);
+    }
+
+    if (InRoundTrip > 0.0)
+    {
+        RoundTrip = InRoundTrip;
+    }
+}
+
+// ============================================================================
+// FInterpolationDelayController
+// ============================================================================
+
+void FInterpolationDelayController::Reset()
+{
+    *this = FInterpolationDelayController();
+}
+
+void FInterpolationDelayController::NoteArrival(double ArrivalTime)
+{
+    const double Interval = ArrivalTime - LastArrival;
+    const bool bHadArrival = LastArrival > 0.0;
+    LastArrival = ArrivalTime;
+
+    if (!bHadArrival || Interval < 0.0 || Interval > MaxInterval)
+    {
+        return;
+    }
+
+    if (Samples == 0)
+    {
+        Mean = Interval;
+        Variance = 0.0;
+    }
+    else
+    {
+        constexpr double Gain = 1.0 / 16.0;
+        const double Diff = Interval - Mean;
+        Mean += Gain * Diff;
+        Variance = (1.0 - Gain) * (Variance + Gain * Diff * Diff);
+    }
+    ++Samples;
+}
+
+double FInterpolationDelayController::GetTargetDelay(double Sigmas, double MinDelay, double MaxDelay, double Fallback) const
+{
+    if (Samples < WarmupSamples)
+    {
+        return Fallback;
+    }
+
+    return FMath::Clamp(Mean + Sigmas * GetIntervalStdDev(), MinDelay, MaxDelay);
+}
@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * NTP-style estimate of the server clock relative to FPlatformTime::Seconds().
+ *
+ * Every snapshot gives a transit sample, server_time - arrival_time, which is
+ * the clock offset minus that packet's one-way delay. Like NTP's clock filter,
+ * the least-delayed sample of the recent window is trusted (the largest
+ * transit value: it spent the least time queued), and half the smoothed RTT
+ * puts the one-way delay back to get the offset itself. The window is short
+ * enough to follow route changes and clock drift.
+ */
+class TOWERGAME_API FServerClockEstimator
+{
+public:
+    FServerClockEstimator() { Reset(); }
+
+    void AddSample(double ServerTime, double ArrivalTime, double RoundTrip);
+    void Reset();
+
+    bool IsSynced() const { return NumSamples > 0; }
+
+    /** Server time minus local time */
+    double GetOffset() const { return BestTransit + RoundTrip * 0.5; }
+
+    double ToServerTime(double LocalTime) const { return LocalTime + GetOffset(); }
+
+    /** Server time of the freshest state we can expect to have received by LocalTime */
+    double ToArrivedServerTime(double LocalTime) const { return LocalTime + BestTransit; }
+
+private:
+    static constexpr int32 WindowSize = 32;
+
+    double Transits[WindowSize];
+    int32 NumSamples;
+    int32 NextSample;
+    double BestTransit;
+    double RoundTrip;
+};
+
+/**
+ * Sizes the interpolation buffer from snapshot inter-arrival times.
+ *
+ * Rendering has to stay far enough behind the newest snapshot that the next
+ * one has normally landed before it is needed: the mean interval plus a few
+ * standard deviations. Both are exponential moving averages (RFC 3550 gain)
+ * so the target follows the link as it gets better or worse.
+ */
+class TOWERGAME_API FInterpolationDelayController
+{
+public:
+    void NoteArrival(double ArrivalTime);
+    void Reset();
+
+    /** Mean + Sigmas * stddev of the inter-arrival time clamped to [MinDelay, MaxDelay]; Fallback until warmed up */
+    double GetTargetDelay(double Sigmas, double MinDelay, double MaxDelay, double Fallback) const;
+
+    double GetMeanInterval() const { return Mean; }
+    double GetIntervalStdDev() const { return FMath::Sqrt(Variance); }
+
+private:
+    /** Intervals needed before the estimate replaces the fallback */
+    static constexpr int32 WarmupSamples = 8;
+
+    /** Gaps longer than this are stalls (hitch, tab-out), not jitter */
+    static constexpr double MaxInterval = 1.0;
+
+    double LastArrival = 0.0;
+    double Mean = 0.0;
+    double Variance = 0.0;
+    int32 Samples = 0;
+};
@@ -0,0 +1,142 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Streaming SHA3-256 (FIPS 202), matching the sha3 crate the Rust server hashes chunks with.
+ *
+ * Update() can be called any number of times with arbitrary slices, so a digest can be
+ * built up while data is still arriving instead of over a finished buffer.
+ */
+class FSha3_256
+{
+public:
+    static constexpr int32 DigestSize = 32;
+
+    FSha3_256() { Reset(); }
+
+    void Reset()
+    {
+        FMemory::Memzero(State, sizeof(State));
+        Offset = 0;
+    }
+
+    void Update(const uint8* Data, int32 Len)
+    {
+        for (int32 i = 0; i < Len; ++i)
+        {
+            State[Offset >> 3] ^= static_cast<uint64>(Data[i]) << ((Offset & 7) * 8);
+            if (++Offset == Rate)
+            {
+                Permute(State);
+                Offset = 0;
+            }
+        }
+    }
+
+    void UpdateU32(uint32 Value)
+    {
+        const uint8 Bytes[4] = {
+            static_cast<uint8>(Value), static_cast<uint8>(Value >> 8),
+            static_cast<uint8>(Value >> 16), static_cast<uint8>(Value >> 24) };
+        Update(Bytes, 4);
+    }
+
+    void UpdateU64(uint64 Value)
+    {
+        UpdateU32(static_cast<uint32>(Value));
+        UpdateU32(static_cast<uint32>(Value >> 32));
+    }
+
+    /** Pads, squeezes DigestSize bytes into OutDigest and leaves the hasher reset */
+    void Final(TArray<uint8>& OutDigest)
+    {
+        State[Offset >> 3] ^= 0x06ull << ((Offset & 7) * 8);
+        State[(Rate - 1) >> 3] ^= 0x80ull << (((Rate - 1) & 7) * 8);
+        Permute(State);
+
+        OutDigest.SetNumUninitialized(DigestSize);
+        for (int32 i = 0; i < DigestSize; ++i)
+        {
+            OutDigest[i] = static_cast<uint8>(State[i >> 3] >> ((i & 7) * 8));
+        }
+        Reset();
+    }
+
+private:
+    /** 1088-bit rate for a 256-bit digest */
+    static constexpr int32 Rate = 136;
+
+    uint64 State[25];
+    int32 Offset = 0;
+
+    static uint64 Rotl(uint64 Value, int32 Shift)
+    {
+        return (Value << Shift) | (Value >> (64 - Shift));
+    }
+
+    /** Keccak-f[1600] */
+    static void Permute(uint64* A)
+    {
+        static constexpr uint64 RoundConstants[24] = {
+            0x0000000000000001ull, 0x0000000000008082ull, 0x800000000000808Aull, 0x8000000080008000ull,
+            0x000000000000808Bull, 0x0000000080000001ull, 0x8000000080008081ull, 0x8000000000008009ull,
+            0x000000000000008Aull, 0x0000000000000088ull, 0x0000000080008009ull, 0x000000008000000Aull,
+            0x000000008000808Bull, 0x800000000000008Bull, 0x8000000000008089ull, 0x8000000000008003ull,
+            0x8000000000008002ull, 0x8000000000000080ull, 0x000000000000800Aull, 0x800000008000000Aull,
+            0x8000000080008081ull, 0x8000000000008080ull, 0x0000000080000001ull, 0x8000000080008008ull,
+        };
+        static constexpr int32 Rotations[24] = {
+            1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44,
+        };
+        static constexpr int32 PiLanes[24] = {
+            10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1,
+        };
+
+        uint64 C[5];
+        for (int32 Round = 0; Round < 24; ++Round)
+        {
+            // Theta
+            for (int32 i = 0; i < 5; ++i)
+            {
+                C[i] = A[i] ^ A[i + 5] ^ A[i + 10] ^ A[i + 15] ^ A[i + 20];
+            }
+            for (int32 i = 0; i < 5; ++i)
+            {
+                const uint64 D = C[(i + 4) % 5] ^ Rotl(C[(i + 1) % 5], 1);
+                for (int32 j = 0; j < 25; j += 5)
+                {
+                    A[j + i] ^= D;
+                }
+            }
+
+            // Rho + Pi
+            uint64 Carry = A[1];
+            for (int32 i = 0; i < 24; ++i)
+            {
+                const int32 Lane = PiLanes[i];
+                const uint64 Next = A[Lane];
+                A[Lane] = Rotl(Carry, Rotations[i]);
+                Carry = Next;
+            }
+
+            // Chi
+            for (int32 j = 0; j < 25; j += 5)
+            {
+                for (int32 i = 0; i < 5; ++i)
+                {
+                    C[i] = A[j + i];
+                }
+                for (int32 i = 0; i < 5; ++i)
+                {
+                    A[j + i] ^= (~C[(i + 1) % 5]) & C[(i + 2) % 5];
+                }
+            }
+
+            // Iota
+            A[0] ^= RoundConstants[Round];
+        }
+    }
+};
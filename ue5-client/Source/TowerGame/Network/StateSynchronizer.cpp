@@ -1,14 +1,65 @@
 #include "StateSynchronizer.h"
 #include "MatchConnection.h"
+#include "TowerNetworkSubsystem.h"
+#include "PayloadCompression.h"
+#include "BincodeSerializer.h"
+#include "NetQuantize.h"
+#include "ReplayRecorder.h"
+#include "RemotePlayerInterpolationSubsystem.h"
+#include "Core/PerfCounters.h"
+#include "Core/TowerMemory.h"
+#include "World/StatusEffectSubsystem.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Kismet/GameplayStatics.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Engine/World.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+#include "Algo/Sort.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogStateSync, Log, All);
 
+namespace
+{
+	/** WorldSnapshot payload versions (see Binary Parsing below) */
+	constexpr uint8 WorldSnapshotVersion = 1;
+	constexpr uint8 WorldDeltaVersion = 2;
+
+	/** Lockstep payload message types (see Lockstep below) */
+	enum ELockstepMessage : uint8
+	{
+		LockstepMessage_Start = 0,
+		LockstepMessage_Input = 1,
+		LockstepMessage_Hash = 2,
+		LockstepMessage_Stop = 3,
+	};
+
+	/** Ticks stepped in one frame at most, so a long stall doesn't turn into a hitch */
+	constexpr int32 MaxLockstepCatchUpTicks = 4;
+
+	/** Silence on an open subscription after which it is renewed, or given up on if never confirmed */
+	constexpr float PushStallSeconds = 0.5f;
+}
+
+// ============================================================================
+// FWorldStateBuffer
+// ============================================================================
+
+const FPlayerStateSnapshot* FWorldStateBuffer::FindPlayer(int64 EntityId) const
+{
+	const int32 Index = Algo::BinarySearchBy(PlayerSnapshots, EntityId, &FPlayerStateSnapshot::EntityId);
+	return Index != INDEX_NONE ? &PlayerSnapshots[Index] : nullptr;
+}
+
+const FMonsterStateSnapshot* FWorldStateBuffer::FindMonster(int64 EntityId) const
+{
+	const int32 Index = Algo::BinarySearchBy(MonsterSnapshots, EntityId, &FMonsterStateSnapshot::EntityId);
+	return Index != INDEX_NONE ? &MonsterSnapshots[Index] : nullptr;
+}
+
 // ============================================================================
 // Construction & Lifecycle
 // ============================================================================
@@ -16,7 +67,7 @@ DEFINE_LOG_CATEGORY_STATIC(LogStateSync, Log, All);
 UTowerStateSynchronizer::UTowerStateSynchronizer()
 {
 	PrimaryComponentTick.bCanEverTick = true;
-	// Tick every frame for smooth interpolation; polling is rate-limited internally
+	// Tick every frame for smooth interpolation; requests go out on the network clock
 	PrimaryComponentTick.TickInterval = 0.0f;
 }
 
@@ -27,8 +78,20 @@ void UTowerStateSynchronizer::BeginPlay()
 	UMatchConnection* Match = GetMatchConnection();
 	if (Match)
 	{
-		Match->OnMatchData.AddDynamic(this, &UTowerStateSynchronizer::OnMatchDataReceived);
+		FMatchDispatcher& Dispatcher = Match->GetDispatcher();
+		Dispatcher.Subscribe<EMatchOpCode::BreathSync>(this, &UTowerStateSynchronizer::OnBreathSyncReceived);
+		Dispatcher.Subscribe<EMatchOpCode::PlayerJoined, EMatchOpCode::PlayerLeft>(this, &UTowerStateSynchronizer::OnPartyChanged);
+		Dispatcher.Subscribe<EMatchOpCode::WorldSnapshot>(this, &UTowerStateSynchronizer::OnWorldSnapshotReceived);
+		Dispatcher.Subscribe<EMatchOpCode::Lockstep>(this, &UTowerStateSynchronizer::OnLockstepReceived);
 	}
+
+	NetClock = UTowerNetworkSubsystem::FindNetClock(this);
+	if (!NetClock)
+	{
+		OwnedNetClock = MakeUnique<FTowerNetClock>();
+		NetClock = OwnedNetClock.Get();
+	}
+	SendStepHandle = NetClock->OnStep(ETowerNetPhase::Send).AddUObject(this, &UTowerStateSynchronizer::StepSend);
 }
 
 void UTowerStateSynchronizer::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -38,8 +101,15 @@ void UTowerStateSynchronizer::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	UMatchConnection* Match = GetMatchConnection();
 	if (Match)
 	{
-		Match->OnMatchData.RemoveDynamic(this, &UTowerStateSynchronizer::OnMatchDataReceived);
+		Match->GetDispatcher().Unsubscribe(this);
+	}
+
+	if (NetClock)
+	{
+		NetClock->OnStep(ETowerNetPhase::Send).Remove(SendStepHandle);
+		NetClock = nullptr;
 	}
+	OwnedNetClock.Reset();
 
 	Super::EndPlay(EndPlayReason);
 }
@@ -51,21 +121,58 @@ void UTowerStateSynchronizer::EndPlay(const EEndPlayReason::Type EndPlayReason)
 void UTowerStateSynchronizer::TickComponent(float DeltaTime, ELevelTick TickType,
 	FActorComponentTickFunction* ThisTickFunction)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_Tick);
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (!bSyncing) return;
 
 	// Advance interpolation time
-	InterpolationTime += DeltaTime;
+	AdvanceInterpolationTime(DeltaTime);
+
+	// Lockstep runs its own fixed-tick sim off the frame
+	if (bLockstepActive)
+	{
+		AdvanceLockstep(DeltaTime);
+	}
+}
+
+void UTowerStateSynchronizer::StepSend(float StepSeconds)
+{
+	if (!bSyncing) return;
+
+	// Lockstep replaces polling while a session runs
+	if (bLockstepActive)
+	{
+		// Pushed states would only be dropped unread for the whole session
+		if (bSubscriptionOpen)
+		{
+			SendStateRequest(EStateRequest::Unsubscribe);
+		}
+		return;
+	}
+
+	if (bSubscribeToServerPush && !bServerPushUnsupported)
+	{
+		TickSubscription(StepSeconds);
+	}
+	else
+	{
+		// Rate-limited server polling
+		SyncTimer += StepSeconds;
+		const float SyncInterval = 1.0f / FMath::Max(SyncRate, 1.0f);
 
-	// Rate-limited server polling
-	SyncTimer += DeltaTime;
-	const float SyncInterval = 1.0f / FMath::Max(SyncRate, 1.0f);
+		if (SyncTimer >= SyncInterval)
+		{
+			// At most one poll a step: a SyncRate above the clock's rate can't build a backlog
+			SyncTimer = FMath::Min(SyncTimer - SyncInterval, SyncInterval);
+			SendStateRequest(EStateRequest::Poll);
+		}
+	}
 
-	if (SyncTimer >= SyncInterval)
+	if (bLockstepMode)
 	{
-		SyncTimer -= SyncInterval;
-		PollServerState();
+		LockstepRestartTimer = FMath::Max(LockstepRestartTimer - StepSeconds, 0.0f);
+		TryStartLockstep();
 	}
 }
 
@@ -77,6 +184,7 @@ void UTowerStateSynchronizer::BeginSync()
 {
 	if (bSyncing) return;
 
+	LLM_SCOPE_BYTAG(Tower_Net);
 	bSyncing = true;
 	SyncTimer = 0.0f;
 	NextSequenceNumber = 1;
@@ -84,24 +192,74 @@ void UTowerStateSynchronizer::BeginSync()
 	EstimatedRTT = 0.0f;
 	SmoothedRTT = 0.0f;
 	InterpolationTime = 0.0;
-
-	SnapshotBuffer.Empty();
-	SnapshotBuffer.Reserve(MaxSnapshotBufferSize);
-	PendingActions.Empty();
-	PreviousEntityStateHashes.Empty();
-
-	UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: started (rate=%.0fHz, interp=%.0fms, prediction=%s)"),
-		SyncRate, InterpolationDelay * 1000.0f, bPredictionEnabled ? TEXT("on") : TEXT("off"));
+	CurrentInterpolationDelay = InterpolationDelay;
+	ServerClock.Reset();
+	DelayController.Reset();
+	bReceivingBinarySnapshots = false;
+	bNeedFullSnapshot = false;
+	bSubscriptionOpen = false;
+	bServerPushConfirmed = false;
+	bServerPushUnsupported = false;
+	bAwaitingSubscribeReply = false;
+	DeltaSnapshotCount = 0;
+	DeltaBaselineMisses = 0;
+	NetStats = UTowerNetworkSubsystem::FindNetStats(this);
+	ReplayRecorder = UTowerNetworkSubsystem::FindReplayRecorder(this);
+	SharedEntities = UTowerNetworkSubsystem::FindEntityRegistry(this);
+	InterestGrid.Configure(InterestSettings);
+	InterestGrid.Reset();
+
+	// One spare slot so a snapshot can be parsed without touching live ones
+	SnapshotSlots.Reset();
+	SnapshotSlots.SetNum(MaxSnapshotBufferSize + 1);
+	SnapshotHead = 0;
+	SnapshotCount = 0;
+	PendingRing.Reset();
+	PendingRing.SetNum(MaxPendingActions);
+	OldestPendingSequence = NextSequenceNumber;
+	bHasPredictionBaseline = false;
+	bStateViewValid = false;
+	PendingEntityEvents.Reset();
+	GetEntities().ClearStateHashes();
+	bLockstepActive = false;
+	LockstepRestartTimer = 0.0f;
+	LockstepDesyncs = 0;
+	ReportBufferMemory();
+
+	UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: started (rate=%.0fHz, interp=%.0fms%s, prediction=%s)"),
+		SyncRate, InterpolationDelay * 1000.0f, bAdaptiveInterpolationDelay ? TEXT(" adaptive") : TEXT(""),
+		bPredictionEnabled ? TEXT("on") : TEXT("off"));
 }
 
 void UTowerStateSynchronizer::StopSync()
 {
 	if (!bSyncing) return;
 
+	if (bLockstepActive)
+	{
+		StopLockstep(TEXT("sync stopped"), true);
+	}
+
+	if (bSubscriptionOpen)
+	{
+		SendStateRequest(EStateRequest::Unsubscribe);
+	}
+
 	bSyncing = false;
-	SnapshotBuffer.Empty();
-	PendingActions.Empty();
-	PreviousEntityStateHashes.Empty();
+	SnapshotSlots.Empty();
+	SnapshotHead = 0;
+	SnapshotCount = 0;
+	PendingRing.Empty();
+	OldestPendingSequence = NextSequenceNumber;
+	bHasPredictionBaseline = false;
+	bStateViewValid = false;
+	ReportBufferMemory();
+
+	// Nothing is seen any more: every tracked entity despawns. Slots replication
+	// still has actors for stay; ours go
+	++EntitySeenStamp;
+	RemoveUnseenEntities();
+	BroadcastEntityEvents();
 
 	UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: stopped"));
 }
@@ -112,76 +270,111 @@ void UTowerStateSynchronizer::StopSync()
 
 FWorldStateBuffer UTowerStateSynchronizer::GetInterpolatedState() const
 {
-	if (SnapshotBuffer.Num() == 0)
+	FWorldStateBuffer Result;
+	EvaluateInterpolatedState(Result);
+	return Result;
+}
+
+void UTowerStateSynchronizer::EvaluateInterpolatedState(FWorldStateBuffer& OutState) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_EvaluateInterpolated);
+	if (SnapshotCount == 0)
 	{
-		return FWorldStateBuffer();
+		OutState = FWorldStateBuffer();
+		return;
 	}
 
-	if (SnapshotBuffer.Num() == 1)
+	// Already on the server clock, InterpolationDelay behind the freshest state (see AdvanceInterpolationTime)
+	const double RenderTime = InterpolationTime;
+
+	if (SnapshotCount == 1)
 	{
-		return SnapshotBuffer[0];
+		CopyWorldState(GetSnapshot(0), OutState);
+		ExtrapolateMonsters(OutState, RenderTime);
+		return;
 	}
 
-	// Render time is behind real-time by InterpolationDelay
-	const double RenderTime = InterpolationTime - static_cast<double>(InterpolationDelay);
-
 	// Find the two snapshots that bracket RenderTime
-	int32 FromIndex = -1;
-	int32 ToIndex = -1;
+	const int32 ToIndex = FindSnapshotAtOrAfter(RenderTime);
 
-	for (int32 i = SnapshotBuffer.Num() - 1; i >= 1; --i)
+	// If RenderTime is beyond all snapshots, return latest, with monsters carried on along their velocity
+	if (ToIndex >= SnapshotCount)
 	{
-		if (SnapshotBuffer[i - 1].ServerTimestamp <= RenderTime &&
-			SnapshotBuffer[i].ServerTimestamp >= RenderTime)
-		{
-			FromIndex = i - 1;
-			ToIndex = i;
-			break;
-		}
+		CopyWorldState(GetSnapshot(SnapshotCount - 1), OutState);
+		ExtrapolateMonsters(OutState, RenderTime);
+		return;
 	}
 
 	// If RenderTime is before all snapshots, return the oldest
-	if (FromIndex < 0)
+	if (ToIndex == 0)
 	{
-		// If RenderTime is beyond all snapshots, return latest
-		if (RenderTime >= SnapshotBuffer.Last().ServerTimestamp)
-		{
-			return SnapshotBuffer.Last();
-		}
-		return SnapshotBuffer[0];
+		CopyWorldState(GetSnapshot(0), OutState);
+		return;
 	}
 
-	const FWorldStateBuffer& From = SnapshotBuffer[FromIndex];
-	const FWorldStateBuffer& To = SnapshotBuffer[ToIndex];
+	const FWorldStateBuffer& From = GetSnapshot(ToIndex - 1);
+	const FWorldStateBuffer& To = GetSnapshot(ToIndex);
 
 	const double TimeDelta = To.ServerTimestamp - From.ServerTimestamp;
 	if (TimeDelta <= 0.0)
 	{
-		return To;
+		CopyWorldState(To, OutState);
+		return;
 	}
 
 	const float Alpha = static_cast<float>(
 		FMath::Clamp((RenderTime - From.ServerTimestamp) / TimeDelta, 0.0, 1.0));
 
-	return LerpWorldState(From, To, Alpha);
+	LerpWorldState(From, To, Alpha, OutState);
+}
+
+const FWorldStateBuffer& UTowerStateSynchronizer::GetStateView() const
+{
+	if (!bStateViewValid || StateViewFrame != GFrameCounter)
+	{
+		EvaluateInterpolatedState(StateView);
+		StateViewFrame = GFrameCounter;
+		bStateViewValid = true;
+	}
+	return StateView;
+}
+
+bool UTowerStateSynchronizer::GetPlayerView(int64 EntityId, FPlayerStateSnapshot& OutSnapshot) const
+{
+	if (const FPlayerStateSnapshot* Snapshot = FindPlayerView(EntityId))
+	{
+		OutSnapshot = *Snapshot;
+		return true;
+	}
+	return false;
+}
+
+bool UTowerStateSynchronizer::GetMonsterView(int64 EntityId, FMonsterStateSnapshot& OutSnapshot) const
+{
+	if (const FMonsterStateSnapshot* Snapshot = FindMonsterView(EntityId))
+	{
+		OutSnapshot = *Snapshot;
+		return true;
+	}
+	return false;
 }
 
 FWorldStateBuffer UTowerStateSynchronizer::GetLatestServerState() const
 {
-	if (SnapshotBuffer.Num() == 0)
+	if (SnapshotCount == 0)
 	{
 		return FWorldStateBuffer();
 	}
-	return SnapshotBuffer.Last();
+	return GetSnapshot(SnapshotCount - 1);
 }
 
 int64 UTowerStateSynchronizer::GetLastServerTick() const
 {
-	if (SnapshotBuffer.Num() == 0)
+	if (SnapshotCount == 0)
 	{
 		return 0;
 	}
-	return SnapshotBuffer.Last().ServerTick;
+	return GetSnapshot(SnapshotCount - 1).ServerTick;
 }
 
 // ============================================================================
@@ -191,36 +384,106 @@ int64 UTowerStateSynchronizer::GetLastServerTick() const
 int64 UTowerStateSynchronizer::PredictAction(EPredictedActionType ActionType,
 	FVector PredictedPosition, FRotator PredictedRotation, float PredictedHealth)
 {
-	if (!bPredictionEnabled)
+	if (ReplayRecorder && !bPredictingMove)
+	{
+		ReplayRecorder->RecordInput(ActionType, PredictedPosition, PredictedRotation.Yaw);
+	}
+
+	// In lockstep the party simulates our input; nothing waits on the server
+	if (bLockstepActive)
+	{
+		if (ActionType == EPredictedActionType::Attack)
+		{
+			LockstepInput.Buttons |= LockstepButton_Attack;
+		}
+		return NextSequenceNumber++;
+	}
+
+	if (!bPredictionEnabled || PendingRing.Num() == 0)
 	{
 		return -1;
 	}
 
-	if (PendingActions.Num() >= MaxPendingActions)
+	const int32 PendingCount = GetPendingActionCount();
+	if (PendingCount >= PendingRing.Num())
 	{
 		UE_LOG(LogStateSync, Warning,
 			TEXT("StateSynchronizer: pending action queue full (%d/%d), dropping prediction"),
-			PendingActions.Num(), MaxPendingActions);
+			PendingCount, PendingRing.Num());
 		return -1;
 	}
 
-	FPendingAction Action;
-	Action.SequenceNumber = NextSequenceNumber++;
+	// What this action moved us by: relative to the previous prediction, or to the
+	// last authoritative position when nothing is pending
+	FVector Previous = PredictedPosition;
+	if (PendingCount > 0)
+	{
+		Previous = GetPendingAction(NextSequenceNumber - 1).PredictedPosition;
+	}
+	else if (bHasPredictionBaseline)
+	{
+		Previous = PredictionBaseline;
+	}
+	else if (SnapshotCount > 0)
+	{
+		const FWorldStateBuffer& Latest = GetSnapshot(SnapshotCount - 1);
+		if (const FPlayerStateSnapshot* Local = Latest.FindPlayer(Latest.LocalPlayerEntityId))
+		{
+			Previous = Local->Position;
+		}
+	}
+
+	const int64 SequenceNumber = NextSequenceNumber++;
+	FPendingAction& Action = GetPendingAction(SequenceNumber);
+	Action.SequenceNumber = SequenceNumber;
 	Action.ActionType = ActionType;
 	Action.Timestamp = FPlatformTime::Seconds();
 	Action.PredictedPosition = PredictedPosition;
 	Action.PredictedRotation = PredictedRotation;
 	Action.PredictedHealth = PredictedHealth;
+	Action.PositionDelta = PredictedPosition - Previous;
 
-	PendingActions.Add(Action);
+	// Not a sim tick unless PredictMove says so; the velocity carries over for the next one
+	Action.bHasMoveInput = false;
+	Action.PredictedVelocity = PendingCount > 0 ? GetPendingAction(SequenceNumber - 1).PredictedVelocity : FVector::ZeroVector;
 
 	if (bDebugLogging)
 	{
 		UE_LOG(LogStateSync, Verbose, TEXT("StateSynchronizer: predicted action seq=%lld type=%d pos=%s"),
-			Action.SequenceNumber, static_cast<int32>(ActionType), *PredictedPosition.ToString());
+			SequenceNumber, static_cast<int32>(ActionType), *PredictedPosition.ToString());
+	}
+
+	return SequenceNumber;
+}
+
+int64 UTowerStateSynchronizer::PredictMove(const FTowerMoveInput& Input, const FTowerMoveState& Result, float PredictedHealth)
+{
+	if (ReplayRecorder)
+	{
+		ReplayRecorder->RecordInput(EPredictedActionType::Move, Result.Position, Result.Yaw, &Input);
+	}
+
+	if (bLockstepActive)
+	{
+		// The newest movement tick's input is what the next lockstep tick samples
+		LockstepInput.Move = Input;
+		return NextSequenceNumber++;
+	}
+
+	bPredictingMove = true;
+	const int64 SequenceNumber = PredictAction(EPredictedActionType::Move, Result.Position,
+		FRotator(0.0, Result.Yaw, 0.0), PredictedHealth);
+	bPredictingMove = false;
+	if (SequenceNumber < 0)
+	{
+		return SequenceNumber;
 	}
 
-	return Action.SequenceNumber;
+	FPendingAction& Action = GetPendingAction(SequenceNumber);
+	Action.bHasMoveInput = true;
+	Action.MoveInput = Input;
+	Action.PredictedVelocity = Result.Velocity;
+	return SequenceNumber;
 }
 
 // ============================================================================
@@ -229,53 +492,51 @@ int64 UTowerStateSynchronizer::PredictAction(EPredictedActionType ActionType,
 
 void UTowerStateSynchronizer::ReconcileState(const FWorldStateBuffer& AuthoritativeState)
 {
-	if (!bPredictionEnabled || PendingActions.Num() == 0)
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_Reconcile);
+	if (!bPredictionEnabled || GetPendingActionCount() == 0)
 	{
 		return;
 	}
 
-	// Find the local player's authoritative snapshot
-	// Convention: first player snapshot is the local player
-	if (AuthoritativeState.PlayerSnapshots.Num() == 0)
+	const FPlayerStateSnapshot* LocalPlayer = AuthoritativeState.FindPlayer(AuthoritativeState.LocalPlayerEntityId);
+	if (!LocalPlayer)
 	{
 		return;
 	}
+	const FPlayerStateSnapshot& ServerPlayerState = *LocalPlayer;
 
-	const FPlayerStateSnapshot& ServerPlayerState = AuthoritativeState.PlayerSnapshots[0];
-
-	// Determine which pending actions the server has acknowledged.
-	// The server state encompasses everything up to its tick, so we remove
-	// all pending actions whose timestamp is <= the server timestamp.
+	// The server state encompasses everything up to its timestamp, so every
+	// pending action issued by then is confirmed. Timestamps rise with the sequence.
 	int64 AckedUpTo = 0;
-	for (const FPendingAction& Action : PendingActions)
+	for (int64 Seq = OldestPendingSequence; Seq < NextSequenceNumber; ++Seq)
 	{
-		if (Action.Timestamp <= AuthoritativeState.ServerTimestamp)
-		{
-			AckedUpTo = Action.SequenceNumber;
-		}
-		else
+		if (GetPendingAction(Seq).Timestamp > AuthoritativeState.ServerTimestamp)
 		{
 			break;
 		}
+		AckedUpTo = Seq;
 	}
 
-	if (AckedUpTo > 0)
+	if (AckedUpTo == 0)
 	{
-		AcknowledgeActionsUpTo(AckedUpTo);
+		// Nothing confirmed yet: the server hasn't seen any of our predictions
+		return;
 	}
 
-	// Replay remaining un-acked actions on top of server state
-	const FVector ReplayedPosition = ReplayPendingActions(ServerPlayerState.Position);
+	// Compare what we predicted for the newest confirmed action against what the server says
+	const FVector AckedPredicted = GetPendingAction(AckedUpTo).PredictedPosition;
+	const FVector CurrentPredicted = GetPendingAction(NextSequenceNumber - 1).PredictedPosition;
+	AcknowledgeActionsUpTo(AckedUpTo);
 
-	// Get the latest predicted position (from the most recent pending action)
-	FVector CurrentPredicted = ServerPlayerState.Position;
-	if (PendingActions.Num() > 0)
+	const float DesyncDistance = FVector::Dist(ServerPlayerState.Position, AckedPredicted);
+	if (DesyncDistance <= KINDA_SMALL_NUMBER)
 	{
-		CurrentPredicted = PendingActions.Last().PredictedPosition;
+		// Prediction held; later actions are still valid as they are
+		return;
 	}
 
-	// Check for desync
-	const float DesyncDistance = FVector::Dist(ReplayedPosition, CurrentPredicted);
+	// Only the actions after the mismatch are replayed, onto the authoritative position
+	const FVector ReplayedPosition = ReplayPendingActions(AckedUpTo + 1, ServerPlayerState.Position);
 
 	if (DesyncDistance > DesyncThreshold)
 	{
@@ -286,11 +547,11 @@ void UTowerStateSynchronizer::ReconcileState(const FWorldStateBuffer& Authoritat
 			TEXT("StateSynchronizer: desync detected (%.1f units) at server tick %lld"),
 			DesyncDistance, AuthoritativeState.ServerTick);
 	}
-	else if (DesyncDistance > KINDA_SMALL_NUMBER && PendingActions.Num() > 0)
+	else
 	{
-		// Minor correction — notify and adjust pending predictions
+		// Minor correction — notify with the corrected and previous newest prediction
 		OnPredictionCorrected.Broadcast(
-			PendingActions[0].SequenceNumber,
+			AckedUpTo,
 			ReplayedPosition,
 			CurrentPredicted
 		);
@@ -298,34 +559,65 @@ void UTowerStateSynchronizer::ReconcileState(const FWorldStateBuffer& Authoritat
 		if (bDebugLogging)
 		{
 			UE_LOG(LogStateSync, Verbose,
-				TEXT("StateSynchronizer: prediction corrected by %.1f units"),
-				DesyncDistance);
+				TEXT("StateSynchronizer: prediction corrected by %.1f units, replayed %d actions"),
+				DesyncDistance, GetPendingActionCount());
 		}
 	}
 }
 
 void UTowerStateSynchronizer::AcknowledgeActionsUpTo(int64 SequenceNumber)
 {
-	PendingActions.RemoveAll([SequenceNumber](const FPendingAction& Action)
+	if (SequenceNumber < OldestPendingSequence)
 	{
-		return Action.SequenceNumber <= SequenceNumber;
-	});
+		return;
+	}
+
+	const int64 Last = FMath::Min(SequenceNumber, NextSequenceNumber - 1);
+	PredictionBaseline = GetPendingAction(Last).PredictedPosition;
+	bHasPredictionBaseline = true;
+	OldestPendingSequence = Last + 1;
 }
 
-FVector UTowerStateSynchronizer::ReplayPendingActions(FVector ServerPosition) const
+FVector UTowerStateSynchronizer::ReplayPendingActions(int64 FirstSequence, FVector Position)
 {
-	FVector Position = ServerPosition;
+	// The confirmed state becomes the new baseline for the remaining deltas
+	PredictionBaseline = Position;
+	bHasPredictionBaseline = true;
+
+	const int64 First = FMath::Max(FirstSequence, OldestPendingSequence);
+
+	// Moves continue from the velocity and facing predicted just before them; the
+	// confirmed action's slot is still intact, the ring only reuses it a lap later
+	FTowerMoveState SimState;
+	if (First > 1)
+	{
+		const FPendingAction& Previous = GetPendingAction(First - 1);
+		SimState.Velocity = Previous.PredictedVelocity;
+		SimState.Yaw = Previous.PredictedRotation.Yaw;
+	}
 
-	for (const FPendingAction& Action : PendingActions)
+	for (int64 Seq = First; Seq < NextSequenceNumber; ++Seq)
 	{
-		// Re-apply the delta that each pending action represents.
-		// The predicted position includes cumulative movement, so we compute
-		// the incremental offset from the previous prediction.
-		// For simplicity, we apply the full predicted position of the last action.
-		// A more sophisticated approach would store per-action deltas.
-		Position = Action.PredictedPosition;
+		FPendingAction& Action = GetPendingAction(Seq);
+		if (Action.bHasMoveInput)
+		{
+			// The sim is horizontal; the height change came from the movement component
+			SimState.Position = Position;
+			SimState = MovementSim.Step(SimState, Action.MoveInput);
+			Position = FVector(SimState.Position.X, SimState.Position.Y, Position.Z + Action.PositionDelta.Z);
+			Action.PredictedVelocity = SimState.Velocity;
+			Action.PredictedRotation.Yaw = SimState.Yaw;
+		}
+		else
+		{
+			Position += Action.PositionDelta;
+			SimState.Velocity = Action.PredictedVelocity;
+		}
+		Action.PredictedPosition = Position;
 	}
 
+	ReplayedMoveState = SimState;
+	ReplayedMoveState.Position = Position;
 	return Position;
 }
 
@@ -333,124 +625,181 @@ FVector UTowerStateSynchronizer::ReplayPendingActions(FVector ServerPosition) co
 // Interpolation
 // ============================================================================
 
-FWorldStateBuffer UTowerStateSynchronizer::LerpWorldState(
-	const FWorldStateBuffer& A, const FWorldStateBuffer& B, float Alpha) const
+void UTowerStateSynchronizer::LerpWorldState(
+	const FWorldStateBuffer& A, const FWorldStateBuffer& B, float Alpha, FWorldStateBuffer& Out) const
 {
-	FWorldStateBuffer Result;
-	Result.ServerTick = B.ServerTick;
-	Result.ServerTimestamp = FMath::Lerp(A.ServerTimestamp, B.ServerTimestamp, static_cast<double>(Alpha));
-	Result.WorldCyclePhase = (Alpha < 0.5f) ? A.WorldCyclePhase : B.WorldCyclePhase;
-
-	// Interpolate player snapshots — match by EntityId
-	for (const FPlayerStateSnapshot& SnapB : B.PlayerSnapshots)
+	Out.ServerTick = B.ServerTick;
+	Out.ServerTimestamp = FMath::Lerp(A.ServerTimestamp, B.ServerTimestamp, static_cast<double>(Alpha));
+	Out.WorldCyclePhase = (Alpha < 0.5f) ? A.WorldCyclePhase : B.WorldCyclePhase;
+	Out.LocalPlayerEntityId = B.LocalPlayerEntityId;
+
+	// Interpolate player snapshots — both arrays are sorted by EntityId, so one merge pass matches them
+	Out.PlayerSnapshots.SetNum(B.PlayerSnapshots.Num(), false);
+	for (int32 IndexA = 0, IndexB = 0; IndexB < B.PlayerSnapshots.Num(); ++IndexB)
 	{
-		const FPlayerStateSnapshot* MatchA = nullptr;
-		for (const FPlayerStateSnapshot& SnapA : A.PlayerSnapshots)
+		const FPlayerStateSnapshot& SnapB = B.PlayerSnapshots[IndexB];
+		while (IndexA < A.PlayerSnapshots.Num() && A.PlayerSnapshots[IndexA].EntityId < SnapB.EntityId)
 		{
-			if (SnapA.EntityId == SnapB.EntityId)
-			{
-				MatchA = &SnapA;
-				break;
-			}
+			++IndexA;
 		}
 
-		if (MatchA)
+		if (IndexA < A.PlayerSnapshots.Num() && A.PlayerSnapshots[IndexA].EntityId == SnapB.EntityId)
 		{
-			Result.PlayerSnapshots.Add(LerpPlayerSnapshot(*MatchA, SnapB, Alpha));
+			LerpPlayerSnapshot(A.PlayerSnapshots[IndexA], SnapB, Alpha, Out.PlayerSnapshots[IndexB]);
 		}
 		else
 		{
 			// New entity not present in A — use B directly
-			Result.PlayerSnapshots.Add(SnapB);
+			Out.PlayerSnapshots[IndexB] = SnapB;
 		}
 	}
 
-	// Interpolate monster snapshots — match by EntityId
-	for (const FMonsterStateSnapshot& SnapB : B.MonsterSnapshots)
+	// Interpolate monster snapshots — same merge
+	Out.MonsterSnapshots.SetNum(B.MonsterSnapshots.Num(), false);
+	for (int32 IndexA = 0, IndexB = 0; IndexB < B.MonsterSnapshots.Num(); ++IndexB)
 	{
-		const FMonsterStateSnapshot* MatchA = nullptr;
-		for (const FMonsterStateSnapshot& SnapA : A.MonsterSnapshots)
+		const FMonsterStateSnapshot& SnapB = B.MonsterSnapshots[IndexB];
+		while (IndexA < A.MonsterSnapshots.Num() && A.MonsterSnapshots[IndexA].EntityId < SnapB.EntityId)
 		{
-			if (SnapA.EntityId == SnapB.EntityId)
-			{
-				MatchA = &SnapA;
-				break;
-			}
+			++IndexA;
 		}
 
-		if (MatchA)
+		if (IndexA < A.MonsterSnapshots.Num() && A.MonsterSnapshots[IndexA].EntityId == SnapB.EntityId)
 		{
-			Result.MonsterSnapshots.Add(LerpMonsterSnapshot(*MatchA, SnapB, Alpha));
+			LerpMonsterSnapshot(A.MonsterSnapshots[IndexA], A.ServerTimestamp, SnapB, B.ServerTimestamp,
+				Alpha, Out.MonsterSnapshots[IndexB]);
 		}
 		else
 		{
-			Result.MonsterSnapshots.Add(SnapB);
+			Out.MonsterSnapshots[IndexB] = SnapB;
 		}
 	}
-
-	return Result;
 }
 
-FPlayerStateSnapshot UTowerStateSynchronizer::LerpPlayerSnapshot(
-	const FPlayerStateSnapshot& A, const FPlayerStateSnapshot& B, float Alpha) const
+void UTowerStateSynchronizer::LerpPlayerSnapshot(
+	const FPlayerStateSnapshot& A, const FPlayerStateSnapshot& B, float Alpha, FPlayerStateSnapshot& Out) const
 {
-	FPlayerStateSnapshot Result;
-	Result.EntityId = B.EntityId;
-	Result.Timestamp = FMath::Lerp(A.Timestamp, B.Timestamp, static_cast<double>(Alpha));
+	Out.EntityId = B.EntityId;
+	Out.Timestamp = FMath::Lerp(A.Timestamp, B.Timestamp, static_cast<double>(Alpha));
 
 	// Position: lerp or teleport
 	const float Distance = FVector::Dist(A.Position, B.Position);
 	if (Distance > TeleportThreshold)
 	{
-		Result.Position = B.Position;
+		Out.Position = B.Position;
 	}
 	else
 	{
-		Result.Position = FMath::Lerp(A.Position, B.Position, Alpha);
+		Out.Position = FMath::Lerp(A.Position, B.Position, Alpha);
 	}
 
 	// Rotation: shortest path slerp
-	Result.Rotation = FMath::Lerp(A.Rotation, B.Rotation, Alpha);
+	Out.Rotation = FMath::Lerp(A.Rotation, B.Rotation, Alpha);
 
 	// Health: lerp for smooth bar transitions
-	Result.Health = FMath::Lerp(A.Health, B.Health, Alpha);
+	Out.Health = FMath::Lerp(A.Health, B.Health, Alpha);
 
 	// Resources: lerp
-	Result.Resources = FVector4(
+	Out.Resources = FVector4(
 		FMath::Lerp(A.Resources.X, B.Resources.X, static_cast<double>(Alpha)),
 		FMath::Lerp(A.Resources.Y, B.Resources.Y, static_cast<double>(Alpha)),
 		FMath::Lerp(A.Resources.Z, B.Resources.Z, static_cast<double>(Alpha)),
 		FMath::Lerp(A.Resources.W, B.Resources.W, static_cast<double>(Alpha))
 	);
-
-	return Result;
 }
 
-FMonsterStateSnapshot UTowerStateSynchronizer::LerpMonsterSnapshot(
-	const FMonsterStateSnapshot& A, const FMonsterStateSnapshot& B, float Alpha) const
+void UTowerStateSynchronizer::LerpMonsterSnapshot(const FMonsterStateSnapshot& A, double TimeA,
+	const FMonsterStateSnapshot& B, double TimeB, float Alpha, FMonsterStateSnapshot& Out) const
 {
-	FMonsterStateSnapshot Result;
-	Result.EntityId = B.EntityId;
+	Out.EntityId = B.EntityId;
+
+	// Where each snapshot puts the monster at its own time. For a fresh sample that's
+	// its position; for a skipped one it's extrapolated, so two skipped snapshots blend
+	// along the same line and a fresh one after them pulls the error out over one interval.
+	const FVector PositionA = ReckonMonsterPosition(A, TimeA);
+	const FVector PositionB = ReckonMonsterPosition(B, TimeB);
 
 	// Position: lerp or teleport
-	const float Distance = FVector::Dist(A.Position, B.Position);
+	const float Distance = FVector::Dist(PositionA, PositionB);
 	if (Distance > TeleportThreshold)
 	{
-		Result.Position = B.Position;
+		Out.Position = PositionB;
 	}
 	else
 	{
-		Result.Position = FMath::Lerp(A.Position, B.Position, Alpha);
+		Out.Position = FMath::Lerp(PositionA, PositionB, Alpha);
 	}
+	Out.Velocity = B.Velocity;
+	Out.SampleTime = FMath::Lerp(TimeA, TimeB, static_cast<double>(Alpha));
 
 	// Health: lerp for smooth bar
-	Result.Health = FMath::Lerp(A.Health, B.Health, Alpha);
+	Out.Health = FMath::Lerp(A.Health, B.Health, Alpha);
 
 	// Combat phase and status effects: use the latest (no interpolation for discrete states)
-	Result.CombatPhase = (Alpha < 0.5f) ? A.CombatPhase : B.CombatPhase;
-	Result.StatusEffects = B.StatusEffects;
+	Out.CombatPhase = (Alpha < 0.5f) ? A.CombatPhase : B.CombatPhase;
+	Out.StatusMask = B.StatusMask;
+}
 
-	return Result;
+FVector UTowerStateSynchronizer::ReckonMonsterPosition(const FMonsterStateSnapshot& Snapshot, double Time) const
+{
+	if (!bDeadReckonMonsters)
+	{
+		return Snapshot.Position;
+	}
+	const double Elapsed = FMath::Clamp(Time - Snapshot.SampleTime, 0.0, static_cast<double>(MaxExtrapolationSeconds));
+	return Snapshot.Position + Snapshot.Velocity * Elapsed;
+}
+
+void UTowerStateSynchronizer::ExtrapolateMonsters(FWorldStateBuffer& State, double Time) const
+{
+	if (!bDeadReckonMonsters)
+	{
+		return;
+	}
+	for (FMonsterStateSnapshot& Snap : State.MonsterSnapshots)
+	{
+		if (!Snap.Velocity.IsZero())
+		{
+			Snap.Position = ReckonMonsterPosition(Snap, Time);
+			Snap.SampleTime = FMath::Max(Snap.SampleTime, Time);
+		}
+	}
+}
+
+void UTowerStateSynchronizer::CopyWorldState(const FWorldStateBuffer& Src, FWorldStateBuffer& Dst)
+{
+	Dst.ServerTick = Src.ServerTick;
+	Dst.ServerTimestamp = Src.ServerTimestamp;
+	Dst.WorldCyclePhase = Src.WorldCyclePhase;
+	Dst.LocalPlayerEntityId = Src.LocalPlayerEntityId;
+
+	Dst.PlayerSnapshots.SetNum(Src.PlayerSnapshots.Num(), false);
+	for (int32 i = 0; i < Src.PlayerSnapshots.Num(); ++i)
+	{
+		Dst.PlayerSnapshots[i] = Src.PlayerSnapshots[i];
+	}
+
+	Dst.MonsterSnapshots.SetNum(Src.MonsterSnapshots.Num(), false);
+	for (int32 i = 0; i < Src.MonsterSnapshots.Num(); ++i)
+	{
+		Dst.MonsterSnapshots[i] = Src.MonsterSnapshots[i];
+	}
+}
+
+void UTowerStateSynchronizer::SortByEntityId(FWorldStateBuffer& State)
+{
+	// Convention: the server lists the local player first
+	State.LocalPlayerEntityId = State.PlayerSnapshots.Num() > 0 ? State.PlayerSnapshots[0].EntityId : 0;
+
+	// Servers usually send entities in id order already; only sort when needed
+	if (!Algo::IsSortedBy(State.PlayerSnapshots, &FPlayerStateSnapshot::EntityId))
+	{
+		Algo::SortBy(State.PlayerSnapshots, &FPlayerStateSnapshot::EntityId);
+	}
+	if (!Algo::IsSortedBy(State.MonsterSnapshots, &FMonsterStateSnapshot::EntityId))
+	{
+		Algo::SortBy(State.MonsterSnapshots, &FMonsterStateSnapshot::EntityId);
+	}
 }
 
 // ============================================================================
@@ -463,121 +812,907 @@ UMatchConnection* UTowerStateSynchronizer::GetMatchConnection() const
 	return GI ? GI->GetSubsystem<UMatchConnection>() : nullptr;
 }
 
-void UTowerStateSynchronizer::PollServerState()
+void UTowerStateSynchronizer::SendStateRequest(EStateRequest Kind)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_SendStateRequest);
 	UMatchConnection* Match = GetMatchConnection();
 	if (!Match || !Match->IsConnected()) return;
 
+	TSharedRef<FJsonObject> Request = MakeShared<FJsonObject>();
+	FString RequestJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestJson);
+
+	if (Kind == EStateRequest::Unsubscribe)
+	{
+		Request->SetBoolField(TEXT("subscribe"), false);
+		FJsonSerializer::Serialize(Request, Writer);
+		Match->SendMatchData(EMatchOpCode::BreathSync, RequestJson);
+
+		bSubscriptionOpen = false;
+		bAwaitingSubscribeReply = false;
+		return;
+	}
+
 	// Record send time for RTT estimation
 	LastPollSentTime = FPlatformTime::Seconds();
 
 	// Build request with last confirmed tick for delta sync
-	TSharedRef<FJsonObject> Request = MakeShared<FJsonObject>();
 	Request->SetNumberField(TEXT("last_tick"), static_cast<double>(LastConfirmedServerTick));
 	Request->SetNumberField(TEXT("client_time"), LastPollSentTime);
 
 	// Include the last acknowledged sequence number so the server knows
 	// which predicted actions have been processed
-	if (PendingActions.Num() > 0)
+	if (GetPendingActionCount() > 0)
 	{
 		Request->SetNumberField(TEXT("last_acked_seq"),
-			static_cast<double>(PendingActions[0].SequenceNumber));
+			static_cast<double>(OldestPendingSequence));
+	}
+
+	// Area of interest: the server drops entities outside the radius around our cell
+	const bool bSendInterest = bRequestInterestFiltering && SnapshotCount > 0 && UpdateInterestViewer();
+	if (bSendInterest)
+	{
+		const FIntPoint Cell = InterestGrid.GetViewerCell();
+		Request->SetNumberField(TEXT("aoi_cell_x"), Cell.X);
+		Request->SetNumberField(TEXT("aoi_cell_y"), Cell.Y);
+		Request->SetNumberField(TEXT("aoi_cell_size"), InterestSettings.CellSize);
+		Request->SetNumberField(TEXT("aoi_radius"), InterestSettings.FarRadiusCells);
+	}
+
+	// Negotiate the binary snapshot format; the server replies with WorldSnapshot if it supports it
+	if (bRequestBinarySnapshots)
+	{
+		Request->SetStringField(TEXT("snapshot_format"), TEXT("bincode"));
+
+		// Baseline for delta snapshots: a tick we still hold in the ring, or 0 for a full snapshot.
+		// Pushed deltas after the first are against the previous push, as the socket is ordered.
+		if (bRequestDeltaSnapshots)
+		{
+			const int64 BaselineTick = bNeedFullSnapshot ? 0 : LastConfirmedServerTick;
+			Request->SetNumberField(TEXT("delta_baseline"), static_cast<double>(BaselineTick));
+		}
+	}
+
+	if (bAcceptCompressedSnapshots)
+	{
+		Request->SetStringField(TEXT("accept_compression"), PayloadCompression::GetAcceptedCodecs());
+	}
+
+	if (Kind == EStateRequest::Subscribe)
+	{
+		Request->SetBoolField(TEXT("subscribe"), true);
+
+		bSubscriptionOpen = true;
+		bAwaitingSubscribeReply = true;
+		SnapshotsSinceSubscribe = 0;
+		SubscriptionAge = 0.0f;
+		SubscriptionSilence = 0.0f;
+		SubscribedCell = bSendInterest ? InterestGrid.GetViewerCell() : FIntPoint(MAX_int32, MAX_int32);
+		bSubscribedForFullSnapshot = bNeedFullSnapshot;
 	}
 
-	FString RequestJson;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestJson);
 	FJsonSerializer::Serialize(Request, Writer);
 
 	Match->SendMatchData(EMatchOpCode::BreathSync, RequestJson);
 
 	if (bDebugLogging)
 	{
-		UE_LOG(LogStateSync, Verbose, TEXT("StateSynchronizer: poll sent (last_tick=%lld, pending=%d)"),
-			LastConfirmedServerTick, PendingActions.Num());
+		UE_LOG(LogStateSync, Verbose, TEXT("StateSynchronizer: %s sent (last_tick=%lld, pending=%d)"),
+			Kind == EStateRequest::Subscribe ? TEXT("subscribe") : TEXT("poll"),
+			LastConfirmedServerTick, GetPendingActionCount());
 	}
 }
 
-void UTowerStateSynchronizer::OnMatchDataReceived(EMatchOpCode OpCode, const FString& DataJson)
+void UTowerStateSynchronizer::TickSubscription(float DeltaTime)
 {
-	// We listen for BreathSync responses which carry the full world state
-	if (OpCode != EMatchOpCode::BreathSync) return;
-
-	const double ReceiveTime = FPlatformTime::Seconds();
-
-	FWorldStateBuffer NewState;
-	if (!ParseWorldStateFromJson(DataJson, NewState)) return;
-
-	// Update RTT estimate
-	UpdateRTTEstimate(LastPollSentTime, ReceiveTime);
+	UMatchConnection* Match = GetMatchConnection();
+	if (!Match || !Match->IsConnected())
+	{
+		// The server forgets subscriptions along with the socket. The ring and
+		// registry stay, so when a resume brings the socket back the subscribe
+		// below asks for a delta on LastConfirmedServerTick, not a full snapshot
+		bSubscriptionOpen = false;
+		return;
+	}
 
-	// Delta compression: check which entities actually changed
-	bool bAnyChanged = false;
-	for (const FPlayerStateSnapshot& Snap : NewState.PlayerSnapshots)
+	if (!bSubscriptionOpen)
 	{
-		const int32 Hash = ComputeEntityStateHash(Snap);
-		if (HasEntityStateChanged(Snap.EntityId, Hash))
-		{
-			PreviousEntityStateHashes.Add(Snap.EntityId, Hash);
-			bAnyChanged = true;
-		}
+		SendStateRequest(EStateRequest::Subscribe);
+		return;
 	}
-	for (const FMonsterStateSnapshot& Snap : NewState.MonsterSnapshots)
+
+	SubscriptionAge += DeltaTime;
+	SubscriptionSilence += DeltaTime;
+
+	if (SubscriptionSilence >= PushStallSeconds)
 	{
-		const int32 Hash = ComputeEntityStateHash(Snap);
-		if (HasEntityStateChanged(Snap.EntityId, Hash))
+		// A poll-only server answers a subscribe like any poll: once
+		if (!bServerPushConfirmed)
 		{
-			PreviousEntityStateHashes.Add(Snap.EntityId, Hash);
-			bAnyChanged = true;
+			UE_LOG(LogStateSync, Log,
+				TEXT("StateSynchronizer: server sent %d snapshot(s) for a subscribe and stopped, polling at %.0fHz"),
+				SnapshotsSinceSubscribe, SyncRate);
+			bServerPushUnsupported = true;
+			bSubscriptionOpen = false;
+			SyncTimer = 0.0f;
+			return;
 		}
-	}
 
-	// Always buffer the snapshot (for interpolation continuity) but only
-	// fire reconciliation and events when state actually changed
-	BufferSnapshot(NewState);
-	LastConfirmedServerTick = NewState.ServerTick;
+		// Pushes stopped (match restarted, subscription dropped server-side): ask again
+		SendStateRequest(EStateRequest::Subscribe);
+		return;
+	}
 
-	// Reconcile predictions
-	ReconcileState(NewState);
+	const bool bCellChanged = bRequestInterestFiltering && SnapshotCount > 0 && UpdateInterestViewer()
+		&& InterestGrid.GetViewerCell() != SubscribedCell;
+	const bool bNeedsFull = bNeedFullSnapshot && !bSubscribedForFullSnapshot;
 
-	if (bAnyChanged)
+	if (bCellChanged || bNeedsFull || SubscriptionAge >= SubscriptionRefreshSeconds)
 	{
-		// Broadcast the interpolated state to listeners
-		FWorldStateBuffer Interpolated = GetInterpolatedState();
-		OnStateUpdated.Broadcast(Interpolated);
+		SendStateRequest(EStateRequest::Subscribe);
 	}
+}
 
-	if (bDebugLogging)
+bool UTowerStateSynchronizer::UpdateInterestViewer()
+{
+	if (SnapshotCount > 0)
 	{
-		UE_LOG(LogStateSync, Verbose,
-			TEXT("StateSynchronizer: received tick=%lld players=%d monsters=%d rtt=%.0fms changed=%s"),
-			NewState.ServerTick, NewState.PlayerSnapshots.Num(), NewState.MonsterSnapshots.Num(),
-			EstimatedRTT * 1000.0f, bAnyChanged ? TEXT("yes") : TEXT("no"));
+		const FWorldStateBuffer& Latest = GetSnapshot(SnapshotCount - 1);
+		if (const FPlayerStateSnapshot* LocalPlayer = Latest.FindPlayer(Latest.LocalPlayerEntityId))
+		{
+			InterestGrid.SetViewerPosition(LocalPlayer->Position);
+		}
 	}
+	return InterestGrid.HasViewer();
 }
 
-// ============================================================================
-// Buffer Management
-// ============================================================================
+void UTowerStateSynchronizer::OnPartyChanged(EMatchOpCode OpCode, const FJsonObject& Data)
+{
+	// A session's party is fixed; anyone joining or leaving ends it
+	if (bLockstepActive)
+	{
+		StopLockstep(TEXT("party changed"), true);
+	}
+}
 
-void UTowerStateSynchronizer::BufferSnapshot(const FWorldStateBuffer& Snapshot)
+void UTowerStateSynchronizer::OnBreathSyncReceived(EMatchOpCode OpCode, const FJsonObject& Data)
 {
-	if (SnapshotBuffer.Num() >= MaxSnapshotBufferSize)
+	// BreathSync responses carry the full world state.
+	// Replies to polls sent before a lockstep session started are stale
+	if (!bSyncing || bLockstepActive) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_JsonSnapshot);
+	TOWER_PERF_SCOPE(NetDecode);
+	LLM_SCOPE_BYTAG(Tower_Net);
+	const double ReceiveTime = FPlatformTime::Seconds();
+
+	FWorldStateBuffer& NewState = BeginSnapshotWrite();
+	if (!ParseWorldStateFromJson(Data, NewState)) return;
+	SortByEntityId(NewState);
+
+	if (bReceivingBinarySnapshots)
 	{
-		// Circular buffer: remove the oldest snapshot
-		SnapshotBuffer.RemoveAt(0, 1);
+		UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: server fell back to JSON snapshots"));
+		bReceivingBinarySnapshots = false;
 	}
 
-	SnapshotBuffer.Add(Snapshot);
+	ApplyServerState(NewState, ReceiveTime);
 }
 
-// ============================================================================
-// Delta Compression
-// ============================================================================
-
-int32 UTowerStateSynchronizer::ComputeEntityStateHash(const FPlayerStateSnapshot& Snapshot) const
+void UTowerStateSynchronizer::OnLockstepReceived(EMatchOpCode OpCode, TArrayView<const uint8> Data)
 {
-	int32 Hash = GetTypeHash(Snapshot.EntityId);
-	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.X)));
+	// The snapshot ring only exists between BeginSync and StopSync
+	if (!bSyncing) return;
+
+	OnLockstepMessage(Data);
+}
+
+void UTowerStateSynchronizer::OnWorldSnapshotReceived(EMatchOpCode OpCode, TArrayView<const uint8> Data)
+{
+	if (!bSyncing || bLockstepActive) return;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_BinarySnapshot);
+	TOWER_PERF_SCOPE(NetDecode);
+	LLM_SCOPE_BYTAG(Tower_Net);
+	const double ReceiveTime = FPlatformTime::Seconds();
+
+	FWorldStateBuffer& NewState = BeginSnapshotWrite();
+	if (!ParseWorldStateFromBinary(Data, NewState))
+	{
+		// A delta we couldn't rebuild leaves us without a usable baseline
+		if (Data.Num() > 0 && Data[0] == WorldDeltaVersion)
+		{
+			bNeedFullSnapshot = true;
+		}
+		return;
+	}
+	bNeedFullSnapshot = false;
+
+	if (!bReceivingBinarySnapshots)
+	{
+		UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: receiving binary snapshots (%d bytes)"), Data.Num());
+		bReceivingBinarySnapshots = true;
+	}
+
+	ApplyServerState(NewState, ReceiveTime);
+}
+
+void UTowerStateSynchronizer::ApplyServerState(FWorldStateBuffer& NewState, double ReceiveTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_ApplyServerState);
+	// Lockstep states are simulated here, not received: they'd only skew the snapshot stats and RTT
+	if (NetStats && !bLockstepActive)
+	{
+		// Before the out-of-order drop so late snapshots still count as reordered
+		NetStats->RecordSnapshot(NewState.ServerTick, NewState.ServerTimestamp, ReceiveTime,
+			SnapshotCount, MaxSnapshotBufferSize);
+	}
+
+	// The ring is kept sorted by timestamp; drop anything that arrives out of order
+	if (SnapshotCount > 0 && NewState.ServerTimestamp < GetSnapshot(SnapshotCount - 1).ServerTimestamp)
+	{
+		if (bDebugLogging)
+		{
+			UE_LOG(LogStateSync, Verbose, TEXT("StateSynchronizer: dropping out-of-order snapshot tick=%lld"),
+				NewState.ServerTick);
+		}
+		return;
+	}
+
+	// Update RTT estimate. Pushed states weren't asked for, so only the reply to a subscribe is a sample
+	if (!bLockstepActive && !bSubscriptionOpen)
+	{
+		UpdateRTTEstimate(LastPollSentTime, ReceiveTime);
+	}
+	else if (!bLockstepActive)
+	{
+		if (bAwaitingSubscribeReply)
+		{
+			UpdateRTTEstimate(LastPollSentTime, ReceiveTime);
+			bAwaitingSubscribeReply = false;
+		}
+
+		SubscriptionSilence = 0.0f;
+		if (++SnapshotsSinceSubscribe > 1 && !bServerPushConfirmed)
+		{
+			UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: server is pushing snapshots, polling stopped"));
+			bServerPushConfirmed = true;
+		}
+	}
+
+	// Clock sync and jitter sampling; first contact puts the render clock straight on the timeline
+	const bool bWasSynced = ServerClock.IsSynced();
+	ServerClock.AddSample(NewState.ServerTimestamp, ReceiveTime, SmoothedRTT);
+	DelayController.NoteArrival(ReceiveTime);
+	if (!bWasSynced)
+	{
+		InterpolationTime = ServerClock.ToArrivedServerTime(FPlatformTime::Seconds()) - CurrentInterpolationDelay;
+	}
+
+	// Delta compression: check which entities actually changed
+	++EntitySeenStamp;
+	bool bAnyChanged = false;
+	for (const FPlayerStateSnapshot& Snap : NewState.PlayerSnapshots)
+	{
+		bAnyChanged |= UpdateEntityState(EReplicatedEntityKind::Player, Snap.EntityId,
+			ComputeEntityStateHash(Snap), Snap.Position, Snap.Health);
+	}
+	for (const FMonsterStateSnapshot& Snap : NewState.MonsterSnapshots)
+	{
+		bAnyChanged |= UpdateEntityState(EReplicatedEntityKind::Monster, Snap.EntityId,
+			ComputeEntityStateHash(Snap), Snap.Position, Snap.Health, static_cast<uint32>(Snap.StatusMask));
+	}
+
+	// Entities that left the snapshot (despawned or out of interest) free their slots
+	RemoveUnseenEntities();
+	bAnyChanged |= PendingEntityEvents.Num() > 0;
+
+	// Always buffer the snapshot (for interpolation continuity) but only
+	// fire reconciliation and events when state actually changed
+	CommitSnapshotWrite();
+	LastConfirmedServerTick = NewState.ServerTick;
+	if (ReplayRecorder)
+	{
+		ReplayRecorder->RecordSnapshot(NewState);
+	}
+	bStateViewValid = false;
+
+	// Reconcile predictions
+	ReconcileState(NewState);
+
+	// Listeners see the snapshot already buffered, so GetStateView() is current
+	BroadcastEntityEvents();
+
+	if (bAnyChanged && OnStateUpdated.IsBound())
+	{
+		OnStateUpdated.Broadcast(GetStateView());
+	}
+
+	if (bDebugLogging)
+	{
+		UE_LOG(LogStateSync, Verbose,
+			TEXT("StateSynchronizer: received tick=%lld players=%d monsters=%d rtt=%.0fms delay=%.0fms changed=%s"),
+			NewState.ServerTick, NewState.PlayerSnapshots.Num(), NewState.MonsterSnapshots.Num(),
+			EstimatedRTT * 1000.0f, CurrentInterpolationDelay * 1000.0f, bAnyChanged ? TEXT("yes") : TEXT("no"));
+	}
+}
+
+// ============================================================================
+// Lockstep
+// ============================================================================
+//
+// Lockstep (op code 15) payload, bincode little-endian, relayed by the match
+// to every player (senders skip their own):
+//
+//   u8   message type              ELockstepMessage
+//   u32  session
+//   i64  sender entity id
+//
+// then, by type:
+//
+//   Start  i32 input_delay, i32 hash_interval, i64 base_tick, f64 start_time,
+//          then the FLockstepSim state (layout in LockstepSim.cpp)
+//   Input  i64 tick, i8 forward, i8 right, u16 yaw, u8 buttons
+//   Hash   i64 tick, u32 hash          ComputeWorldStateHash after that tick
+//   Stop   nothing
+//
+// Input for ticks below input_delay is empty for everyone and never sent.
+
+void UTowerStateSynchronizer::TryStartLockstep()
+{
+	UMatchConnection* Match = GetMatchConnection();
+	if (LockstepRestartTimer > 0.0f || SnapshotCount == 0 || bNeedFullSnapshot || !Match || !Match->IsConnected())
+	{
+		return;
+	}
+
+	// Snapshots are sorted by id, so the leader is the first player
+	const FWorldStateBuffer& Latest = GetSnapshot(SnapshotCount - 1);
+	const int32 PartySize = Latest.PlayerSnapshots.Num();
+	if (PartySize == 0 || PartySize > LockstepSettings.MaxPartySize
+		|| Latest.PlayerSnapshots[0].EntityId != Latest.LocalPlayerEntityId)
+	{
+		return;
+	}
+
+	LockstepSim.Reset(Latest, LockstepSettings.Tuning, MovementSim);
+	LockstepLocalId = Latest.LocalPlayerEntityId;
+
+	const uint32 Session = FMath::Max(HashCombine(GetTypeHash(LockstepLocalId), GetTypeHash(Latest.ServerTick)), 1u);
+	BeginLockstepSession(Session, LockstepLocalId, LockstepSettings.InputDelayTicks,
+		FMath::Max(LockstepSettings.HashIntervalTicks, 1), Latest.ServerTick, Latest.ServerTimestamp);
+
+	FBincodeWriter Writer = BeginLockstepMessage(LockstepMessage_Start);
+	Writer.WriteI32(LockstepInputDelay);
+	Writer.WriteI32(LockstepHashInterval);
+	Writer.WriteI64(LockstepBaseTick);
+	Writer.WriteF64(LockstepStartTime);
+	LockstepSim.Serialize(Writer);
+	SendLockstepMessage();
+}
+
+void UTowerStateSynchronizer::BeginLockstepSession(uint32 Session, int64 LeaderId, int32 InputDelay, int32 HashInterval,
+	int64 BaseTick, double StartTime)
+{
+	LLM_SCOPE_BYTAG(Tower_Net);
+	bLockstepActive = true;
+	LockstepSession = Session;
+	LockstepLeaderId = LeaderId;
+	LockstepInputDelay = InputDelay;
+	LockstepHashInterval = HashInterval;
+	LockstepBaseTick = BaseTick;
+	LockstepStartTime = StartTime;
+	LockstepAccumulator = 0.0f;
+	LockstepStallTime = 0.0f;
+	LockstepInput = FLockstepInput();
+
+	const int32 NumPlayers = LockstepSim.GetNumPlayers();
+	LockstepInputs.Reset();
+	LockstepInputs.SetNum(NumPlayers * LockstepInputRingTicks);
+	LockstepStepInputs.SetNum(NumPlayers);
+	for (FLockstepHash& Hash : LockstepLocalHashes)
+	{
+		Hash = FLockstepHash();
+	}
+	LockstepRemoteHashes.Reset();
+
+	// Predictions still in flight will never be confirmed now
+	OldestPendingSequence = NextSequenceNumber;
+	bHasPredictionBaseline = false;
+
+	// Sim states continue from StartTime; anything we buffered after it would make them look out of order
+	while (SnapshotCount > 0 && GetSnapshot(SnapshotCount - 1).ServerTimestamp > StartTime)
+	{
+		--SnapshotCount;
+	}
+	bStateViewValid = false;
+	ReportBufferMemory();
+
+	UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: lockstep session %08x led by %lld (%d players, input delay %d ticks)"),
+		Session, LeaderId, NumPlayers, InputDelay);
+}
+
+void UTowerStateSynchronizer::StopLockstep(const TCHAR* Reason, bool bNotifyParty)
+{
+	if (!bLockstepActive)
+	{
+		return;
+	}
+
+	if (bNotifyParty)
+	{
+		BeginLockstepMessage(LockstepMessage_Stop);
+		SendLockstepMessage();
+	}
+
+	bLockstepActive = false;
+	bNeedFullSnapshot = true;
+	SyncTimer = 0.0f;
+	LockstepRestartTimer = LockstepSettings.RestartDelaySeconds;
+	LockstepInputs.Empty();
+	LockstepStepInputs.Empty();
+	LockstepRemoteHashes.Empty();
+	ReportBufferMemory();
+
+	UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: lockstep session %08x ended at tick %lld (%s), streaming"),
+		LockstepSession, LockstepSim.GetTick(), Reason);
+}
+
+void UTowerStateSynchronizer::AdvanceLockstep(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_Lockstep);
+	const float TickSeconds = static_cast<float>(FLockstepSim::TickSeconds);
+	LockstepAccumulator = FMath::Min(LockstepAccumulator + DeltaTime, TickSeconds * MaxLockstepCatchUpTicks);
+
+	while (LockstepAccumulator >= TickSeconds)
+	{
+		const int64 Tick = LockstepSim.GetTick();
+		if (!GatherLockstepInputs(Tick))
+		{
+			break;
+		}
+
+		// Our input for InputDelay ticks on. Peers need it before they can get there, and it
+		// depends only on what we already sent, so nobody ever waits on themselves
+		const int64 InputTick = Tick + LockstepInputDelay;
+		const int32 LocalIndex = LockstepSim.FindPlayer(LockstepLocalId);
+		FLockstepInputSlot& Own = LockstepInputs[LocalIndex * LockstepInputRingTicks + static_cast<int32>(InputTick % LockstepInputRingTicks)];
+		Own.Tick = InputTick;
+		Own.Input = LockstepInput;
+
+		FBincodeWriter Writer = BeginLockstepMessage(LockstepMessage_Input);
+		Writer.WriteI64(InputTick);
+		Writer.WriteI8(LockstepInput.Move.Forward);
+		Writer.WriteI8(LockstepInput.Move.Right);
+		Writer.WriteU16(LockstepInput.Move.Yaw);
+		Writer.WriteU8(LockstepInput.Buttons);
+		SendLockstepMessage();
+		LockstepInput.Buttons = 0;
+
+		LockstepSim.Step(LockstepStepInputs);
+		LockstepAccumulator -= TickSeconds;
+		LockstepStallTime = 0.0f;
+
+		PublishLockstepState();
+		if (!bLockstepActive)
+		{
+			// Its hash didn't match a peer's
+			return;
+		}
+	}
+
+	// Still a tick behind: a peer's input hasn't arrived
+	if (LockstepAccumulator >= TickSeconds)
+	{
+		LockstepStallTime += DeltaTime;
+		if (LockstepStallTime > LockstepSettings.MaxStallSeconds)
+		{
+			StopLockstep(TEXT("peer input stalled"), true);
+		}
+	}
+}
+
+bool UTowerStateSynchronizer::GatherLockstepInputs(int64 Tick)
+{
+	for (int32 i = 0; i < LockstepStepInputs.Num(); ++i)
+	{
+		if (Tick < LockstepInputDelay)
+		{
+			LockstepStepInputs[i] = FLockstepInput();
+			continue;
+		}
+
+		const FLockstepInputSlot& Slot = LockstepInputs[i * LockstepInputRingTicks + static_cast<int32>(Tick % LockstepInputRingTicks)];
+		if (Slot.Tick != Tick)
+		{
+			return false;
+		}
+		LockstepStepInputs[i] = Slot.Input;
+	}
+	return true;
+}
+
+void UTowerStateSynchronizer::PublishLockstepState()
+{
+	FWorldStateBuffer& State = BeginSnapshotWrite();
+	LockstepSim.WriteState(State, LockstepStartTime);
+	State.ServerTick = LockstepBaseTick;
+	State.LocalPlayerEntityId = LockstepLocalId;
+
+	const int64 Tick = LockstepSim.GetTick();
+	const bool bHashTick = Tick % LockstepHashInterval == 0;
+	const uint32 Hash = bHashTick ? ComputeWorldStateHash(State) : 0;
+
+	// Sim states keep the base tick, so the ring stays sorted by tick for delta baselines once streaming resumes
+	ApplyServerState(State, FPlatformTime::Seconds());
+
+	if (!bHashTick)
+	{
+		return;
+	}
+
+	LockstepLocalHashes[(Tick / LockstepHashInterval) % LockstepHashHistory] = { Tick, Hash };
+
+	FBincodeWriter Writer = BeginLockstepMessage(LockstepMessage_Hash);
+	Writer.WriteI64(Tick);
+	Writer.WriteU32(Hash);
+	SendLockstepMessage();
+
+	// Peers that got here first
+	for (int32 i = LockstepRemoteHashes.Num() - 1; i >= 0; --i)
+	{
+		const FLockstepHash Remote = LockstepRemoteHashes[i];
+		if (Remote.Tick <= Tick)
+		{
+			LockstepRemoteHashes.RemoveAtSwap(i);
+			CheckLockstepHash(Remote.Tick, Remote.Hash);
+			if (!bLockstepActive)
+			{
+				return;
+			}
+		}
+	}
+}
+
+void UTowerStateSynchronizer::CheckLockstepHash(int64 Tick, uint32 Hash)
+{
+	if (Tick < 0 || Tick % LockstepHashInterval != 0)
+	{
+		return;
+	}
+
+	const FLockstepHash& Local = LockstepLocalHashes[(Tick / LockstepHashInterval) % LockstepHashHistory];
+	if (Local.Tick != Tick)
+	{
+		// Ahead of us: compare once we get there. Behind the history: too late to matter
+		if (Tick > LockstepSim.GetTick() && LockstepRemoteHashes.Num() < LockstepHashHistory * LockstepStepInputs.Num())
+		{
+			LockstepRemoteHashes.Add({ Tick, Hash });
+		}
+		return;
+	}
+
+	if (Local.Hash != Hash)
+	{
+		++LockstepDesyncs;
+		UE_LOG(LogStateSync, Warning, TEXT("StateSynchronizer: lockstep desync at tick %lld (hash %08x, peer %08x)"),
+			Tick, Local.Hash, Hash);
+		OnDesyncDetected.Broadcast(0.0f, Tick);
+		StopLockstep(TEXT("desync"), true);
+	}
+}
+
+void UTowerStateSynchronizer::OnLockstepMessage(TArrayView<const uint8> Data)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_LockstepMessage);
+	FBincodeReader Reader(Data.GetData(), Data.Num());
+	const uint8 Type = Reader.ReadU8();
+	const uint32 Session = static_cast<uint32>(Reader.ReadU32());
+	const int64 Sender = Reader.ReadI64();
+
+	// Our own messages come back from the relay
+	const int64 LocalId = SnapshotCount > 0 ? GetSnapshot(SnapshotCount - 1).LocalPlayerEntityId : 0;
+	if (Reader.HasError() || LocalId == 0 || Sender == LocalId)
+	{
+		return;
+	}
+
+	if (Type == LockstepMessage_Start)
+	{
+		// Two leaders after a party change: the lower id wins
+		if (!bLockstepMode || (bLockstepActive && (Session == LockstepSession || Sender > LockstepLeaderId)))
+		{
+			return;
+		}
+
+		const int32 InputDelay = Reader.ReadI32();
+		const int32 HashInterval = Reader.ReadI32();
+		const int64 BaseTick = Reader.ReadI64();
+		const double StartTime = Reader.ReadF64();
+
+		FLockstepSim Incoming;
+		if (Reader.HasError() || InputDelay < 1 || InputDelay > LockstepInputRingTicks / 4 || HashInterval < 1
+			|| !Incoming.Deserialize(Reader) || Incoming.FindPlayer(LocalId) == INDEX_NONE)
+		{
+			UE_LOG(LogStateSync, Warning, TEXT("StateSynchronizer: ignoring lockstep start from %lld (%d bytes)"), Sender, Data.Num());
+			return;
+		}
+
+		StopLockstep(TEXT("superseded"), false);
+		LockstepSim = MoveTemp(Incoming);
+		LockstepLocalId = LocalId;
+		BeginLockstepSession(Session, Sender, InputDelay, HashInterval, BaseTick, StartTime);
+		return;
+	}
+
+	if (!bLockstepActive || Session != LockstepSession)
+	{
+		return;
+	}
+
+	switch (Type)
+	{
+	case LockstepMessage_Input:
+	{
+		const int64 Tick = Reader.ReadI64();
+		FLockstepInput Input;
+		Input.Move.Forward = Reader.ReadI8();
+		Input.Move.Right = Reader.ReadI8();
+		Input.Move.Yaw = static_cast<uint16>(Reader.ReadU16());
+		Input.Buttons = Reader.ReadU8();
+
+		// Ticks already stepped can't change any more; past the ring the sender is broken
+		const int32 PlayerIndex = LockstepSim.FindPlayer(Sender);
+		if (Reader.HasError() || PlayerIndex == INDEX_NONE
+			|| Tick < LockstepSim.GetTick() || Tick >= LockstepSim.GetTick() + LockstepInputRingTicks)
+		{
+			return;
+		}
+
+		FLockstepInputSlot& Slot = LockstepInputs[PlayerIndex * LockstepInputRingTicks + static_cast<int32>(Tick % LockstepInputRingTicks)];
+		Slot.Tick = Tick;
+		Slot.Input = Input;
+		break;
+	}
+
+	case LockstepMessage_Hash:
+	{
+		const int64 Tick = Reader.ReadI64();
+		const uint32 Hash = static_cast<uint32>(Reader.ReadU32());
+		if (!Reader.HasError())
+		{
+			CheckLockstepHash(Tick, Hash);
+		}
+		break;
+	}
+
+	case LockstepMessage_Stop:
+		StopLockstep(TEXT("stopped by a peer"), false);
+		break;
+
+	default:
+		break;
+	}
+}
+
+FBincodeWriter UTowerStateSynchronizer::BeginLockstepMessage(uint8 Type)
+{
+	LockstepSendBuffer.Reset();
+	FBincodeWriter Writer(LockstepSendBuffer);
+	Writer.WriteU8(Type);
+	Writer.WriteU32(LockstepSession);
+	Writer.WriteI64(LockstepLocalId);
+	return Writer;
+}
+
+void UTowerStateSynchronizer::SendLockstepMessage()
+{
+	if (UMatchConnection* Match = GetMatchConnection())
+	{
+		Match->SendMatchDataRaw(EMatchOpCode::Lockstep, LockstepSendBuffer);
+	}
+}
+
+uint32 UTowerStateSynchronizer::ComputeWorldStateHash(const FWorldStateBuffer& State) const
+{
+	uint32 Hash = HashCombine(GetTypeHash(State.PlayerSnapshots.Num()), GetTypeHash(State.MonsterSnapshots.Num()));
+	for (const FPlayerStateSnapshot& Snap : State.PlayerSnapshots)
+	{
+		Hash = HashCombine(Hash, static_cast<uint32>(ComputeEntityStateHash(Snap)));
+	}
+	for (const FMonsterStateSnapshot& Snap : State.MonsterSnapshots)
+	{
+		Hash = HashCombine(Hash, static_cast<uint32>(ComputeEntityStateHash(Snap)));
+	}
+	return Hash;
+}
+
+// ============================================================================
+// Lag Compensation
+// ============================================================================
+
+bool UTowerStateSynchronizer::FindEntityPosition(const FWorldStateBuffer& State, int64 EntityId, FVector& OutPosition) const
+{
+	if (const FMonsterStateSnapshot* Monster = State.FindMonster(EntityId))
+	{
+		// A monster the server skipped in this snapshot is where dead reckoning puts it
+		OutPosition = ReckonMonsterPosition(*Monster, State.ServerTimestamp);
+		return true;
+	}
+	if (const FPlayerStateSnapshot* Player = State.FindPlayer(EntityId))
+	{
+		OutPosition = Player->Position;
+		return true;
+	}
+	return false;
+}
+
+bool UTowerStateSynchronizer::RewindEntity(int64 EntityId, double RenderTime, FVector& OutPosition) const
+{
+	if (SnapshotCount == 0)
+	{
+		return false;
+	}
+
+	const FWorldStateBuffer& Newest = GetSnapshot(SnapshotCount - 1);
+	if (RenderTime >= Newest.ServerTimestamp)
+	{
+		// Same as the view: monsters carry on along their velocity
+		if (const FMonsterStateSnapshot* Monster = Newest.FindMonster(EntityId))
+		{
+			OutPosition = ReckonMonsterPosition(*Monster, RenderTime);
+			return true;
+		}
+		return FindEntityPosition(Newest, EntityId, OutPosition);
+	}
+	if (Newest.ServerTimestamp - RenderTime > MaxRewindSeconds)
+	{
+		return false;
+	}
+
+	// Snapshots are sorted by time, so this brackets RenderTime like EvaluateInterpolatedState
+	const int32 ToIndex = FindSnapshotAtOrAfter(RenderTime);
+	if (ToIndex == 0)
+	{
+		return false;
+	}
+
+	const FWorldStateBuffer& From = GetSnapshot(ToIndex - 1);
+	const FWorldStateBuffer& To = GetSnapshot(ToIndex);
+
+	FVector FromPosition;
+	FVector ToPosition;
+	if (!FindEntityPosition(From, EntityId, FromPosition) || !FindEntityPosition(To, EntityId, ToPosition))
+	{
+		return false;
+	}
+
+	const double TimeDelta = To.ServerTimestamp - From.ServerTimestamp;
+	const double Alpha = TimeDelta > 0.0
+		? FMath::Clamp((RenderTime - From.ServerTimestamp) / TimeDelta, 0.0, 1.0)
+		: 1.0;
+	OutPosition = FMath::Lerp(FromPosition, ToPosition, Alpha);
+	return true;
+}
+
+bool UTowerStateSynchronizer::ValidateHit(int64 TargetId, FVector AttackerLocation, float Range, double RenderTime) const
+{
+	FVector TargetPosition;
+	if (!RewindEntity(TargetId, RenderTime, TargetPosition))
+	{
+		return false;
+	}
+
+	const float Reach = Range + HitTolerance;
+	const bool bHit = FVector::DistSquared(AttackerLocation, TargetPosition) <= FMath::Square(Reach);
+	if (!bHit && bDebugLogging)
+	{
+		UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: hit on %lld rejected, %.0f away at t=%.3f (reach %.0f)"),
+			TargetId, FVector::Dist(AttackerLocation, TargetPosition), RenderTime, Reach);
+	}
+	return bHit;
+}
+
+// ============================================================================
+// Buffer Management
+// ============================================================================
+
+FWorldStateBuffer& UTowerStateSynchronizer::BeginSnapshotWrite()
+{
+	if (SnapshotSlots.Num() == 0)
+	{
+		// Not syncing yet; keep a single scratch slot so parsing still has a target
+		SnapshotSlots.SetNum(1);
+	}
+
+	FWorldStateBuffer& Slot = SnapshotSlots[(SnapshotHead + SnapshotCount) % SnapshotSlots.Num()];
+
+	// Keep array capacity (and each element's inner arrays) for reuse by the parsers
+	Slot.WorldCyclePhase = EWorldCyclePhase::Inhale;
+	Slot.ServerTick = 0;
+	Slot.ServerTimestamp = 0.0;
+	return Slot;
+}
+
+void UTowerStateSynchronizer::CommitSnapshotWrite()
+{
+	const int32 Capacity = SnapshotSlots.Num() - 1;
+	if (Capacity <= 0)
+	{
+		return;
+	}
+
+	if (SnapshotCount >= Capacity)
+	{
+		// Circular buffer: the oldest snapshot's slot becomes the next write slot
+		SnapshotHead = (SnapshotHead + 1) % SnapshotSlots.Num();
+	}
+	else
+	{
+		++SnapshotCount;
+	}
+	ReportBufferMemory();
+}
+
+void UTowerStateSynchronizer::ReportBufferMemory()
+{
+	// Slot arrays only grow (parsed in place), so this settles once the largest snapshot has been seen
+	int64 Bytes = SnapshotSlots.GetAllocatedSize() + PendingRing.GetAllocatedSize() + LockstepInputs.GetAllocatedSize();
+	for (const FWorldStateBuffer& Slot : SnapshotSlots)
+	{
+		Bytes += Slot.PlayerSnapshots.GetAllocatedSize() + Slot.MonsterSnapshots.GetAllocatedSize();
+	}
+	BufferMemory.Set(Bytes);
+}
+
+int32 UTowerStateSynchronizer::FindSnapshotAtOrAfter(double Time) const
+{
+	// Lower bound over the logical (oldest -> newest) order
+	int32 Low = 0;
+	int32 High = SnapshotCount;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (GetSnapshot(Mid).ServerTimestamp < Time)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low;
+}
+
+const FWorldStateBuffer* UTowerStateSynchronizer::FindSnapshotByTick(int64 Tick) const
+{
+	// Ticks increase with timestamps, so the ring is sorted by tick as well
+	int32 Low = 0;
+	int32 High = SnapshotCount;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if (GetSnapshot(Mid).ServerTick < Tick)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return (Low < SnapshotCount && GetSnapshot(Low).ServerTick == Tick) ? &GetSnapshot(Low) : nullptr;
+}
+
+// ============================================================================
+// Delta Compression
+// ============================================================================
+
+int32 UTowerStateSynchronizer::ComputeEntityStateHash(const FPlayerStateSnapshot& Snapshot) const
+{
+	int32 Hash = GetTypeHash(Snapshot.EntityId);
+	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.X)));
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.Y)));
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.Z)));
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Health * 10.0f)));
@@ -587,24 +1722,137 @@ int32 UTowerStateSynchronizer::ComputeEntityStateHash(const FPlayerStateSnapshot
 
 int32 UTowerStateSynchronizer::ComputeEntityStateHash(const FMonsterStateSnapshot& Snapshot) const
 {
+	static_assert(static_cast<int32>(EMonsterStatusEffect::SemanticFocus) <= 16, "Status bits are 16 on the wire");
+	static_assert(static_cast<int32>(EMonsterStatusEffect::SemanticFocus) == static_cast<int32>(EStatusType::SemanticFocus) + 1,
+		"StatusMask bits are EStatusType values");
+
 	int32 Hash = GetTypeHash(Snapshot.EntityId);
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.X)));
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.Y)));
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Position.Z)));
 	Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt(Snapshot.Health * 10.0f)));
 	Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Snapshot.CombatPhase)));
-	Hash = HashCombine(Hash, GetTypeHash(Snapshot.StatusEffects.Num()));
+	Hash = HashCombine(Hash, GetTypeHash(Snapshot.StatusMask));
 	return Hash;
 }
 
-bool UTowerStateSynchronizer::HasEntityStateChanged(int64 EntityId, int32 NewHash) const
+bool UTowerStateSynchronizer::UpdateEntityState(EReplicatedEntityKind Kind, int64 EntityId, int32 NewHash,
+	const FVector& Position, float Health, uint32 StatusMask)
+{
+	FReplicatedEntityRegistry& Entities = GetEntities();
+	const int32 Slot = Entities.FindOrAdd(Kind, EntityId);
+	Entities.MarkSeen(Slot, EntitySeenStamp);
+
+	// No hash yet: first time state sync sees this entity (the slot may predate it for replication)
+	if (!Entities.HasStateHash(Slot))
+	{
+		Entities.Position(Slot) = Position;
+		Entities.Health(Slot) = Health;
+		Entities.ReportedPosition(Slot) = Position;
+		Entities.StatusMask(Slot) = StatusMask;
+		Entities.UpdateStateHash(Slot, NewHash);
+
+		if (OnEntitySpawned.IsBound())
+		{
+			PendingEntityEvents.Add({ EEntityEventType::Spawned, Kind, EntityId, Position, Health, Health, StatusMask });
+		}
+		if (StatusMask != 0)
+		{
+			PendingEntityEvents.Add({ EEntityEventType::StatusChanged, Kind, EntityId, Position, Health, Health, StatusMask });
+		}
+		return true;
+	}
+
+	if (!Entities.UpdateStateHash(Slot, NewHash))
+	{
+		return false;
+	}
+
+	// Hash changed; work out which of the tracked fields it was
+	const float OldHealth = Entities.Health(Slot);
+	if (OldHealth != Health && OnEntityHealthChanged.IsBound())
+	{
+		PendingEntityEvents.Add({ EEntityEventType::HealthChanged, Kind, EntityId, Position, OldHealth, Health, StatusMask });
+	}
+
+	FVector& Reported = Entities.ReportedPosition(Slot);
+	if (FVector::DistSquared(Reported, Position) > FMath::Square(EventMoveThreshold))
+	{
+		Reported = Position;
+		if (OnEntityMoved.IsBound())
+		{
+			PendingEntityEvents.Add({ EEntityEventType::Moved, Kind, EntityId, Position, Health, Health, StatusMask });
+		}
+	}
+
+	uint32& OldMask = Entities.StatusMask(Slot);
+	if (OldMask != StatusMask)
+	{
+		// Always queued: the status effect store follows every change
+		OldMask = StatusMask;
+		PendingEntityEvents.Add({ EEntityEventType::StatusChanged, Kind, EntityId, Position, Health, Health, StatusMask });
+	}
+
+	Entities.Position(Slot) = Position;
+	Entities.Health(Slot) = Health;
+	return true;
+}
+
+void UTowerStateSynchronizer::RemoveUnseenEntities()
+{
+	const bool bBound = OnEntityDespawned.IsBound();
+	for (const EReplicatedEntityKind Kind : { EReplicatedEntityKind::Player, EReplicatedEntityKind::Monster })
+	{
+		// Monster despawns also drop the monster's status effects from the store
+		const bool bQueue = bBound || Kind == EReplicatedEntityKind::Monster;
+		GetEntities().RemoveUnseen(Kind, EntitySeenStamp, [this, Kind, bQueue](int64 EntityId)
+		{
+			if (bQueue)
+			{
+				PendingEntityEvents.Add({ EEntityEventType::Despawned, Kind, EntityId, FVector::ZeroVector, 0.0f, 0.0f, 0 });
+			}
+		});
+	}
+}
+
+void UTowerStateSynchronizer::BroadcastEntityEvents()
 {
-	const int32* OldHash = PreviousEntityStateHashes.Find(EntityId);
-	if (!OldHash)
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_BroadcastEntityEvents);
+	UWorld* World = GetWorld();
+	UTowerStatusEffectSubsystem* StatusEffects = World ? World->GetSubsystem<UTowerStatusEffectSubsystem>() : nullptr;
+
+	// By index: a listener calling StopSync() appends despawns and flushes them itself
+	for (int32 Index = 0; Index < PendingEntityEvents.Num(); ++Index)
 	{
-		return true; // New entity, always considered changed
+		const FEntityEvent Event = PendingEntityEvents[Index];
+		switch (Event.Type)
+		{
+			case EEntityEventType::Spawned:
+				OnEntitySpawned.Broadcast(Event.Kind, Event.EntityId);
+				break;
+			case EEntityEventType::Despawned:
+				if (StatusEffects && Event.Kind == EReplicatedEntityKind::Monster)
+				{
+					StatusEffects->RemoveEntity(Event.EntityId);
+				}
+				OnEntityDespawned.Broadcast(Event.Kind, Event.EntityId);
+				break;
+			case EEntityEventType::Moved:
+				OnEntityMoved.Broadcast(Event.Kind, Event.EntityId, Event.Position);
+				break;
+			case EEntityEventType::HealthChanged:
+				OnEntityHealthChanged.Broadcast(Event.Kind, Event.EntityId, Event.OldHealth, Event.NewHealth);
+				break;
+			case EEntityEventType::StatusChanged:
+				if (StatusEffects)
+				{
+					StatusEffects->SetEffectMask(Event.EntityId, Event.StatusMask);
+				}
+				OnMonsterStatusChanged.Broadcast(Event.EntityId, static_cast<int32>(Event.StatusMask));
+				break;
+		}
 	}
-	return *OldHash != NewHash;
+	PendingEntityEvents.Reset();
 }
 
 // ============================================================================
@@ -629,6 +1877,452 @@ void UTowerStateSynchronizer::UpdateRTTEstimate(double SendTime, double ReceiveT
 		SmoothedRTT = (1.0f - SmoothingFactor) * SmoothedRTT + SmoothingFactor * SampleRTT;
 	}
 	EstimatedRTT = SmoothedRTT;
+
+	// Remote player interpolation shares this latency estimate
+	if (UWorld* World = GetWorld())
+	{
+		if (URemotePlayerInterpolationSubsystem* Interp = World->GetSubsystem<URemotePlayerInterpolationSubsystem>())
+		{
+			Interp->SetRoundTripTime(SmoothedRTT);
+		}
+	}
+}
+
+void UTowerStateSynchronizer::AdvanceInterpolationTime(float DeltaTime)
+{
+	InterpolationTime += DeltaTime;
+
+	if (!ServerClock.IsSynced())
+	{
+		return;
+	}
+
+	const float TargetDelay = bAdaptiveInterpolationDelay
+		? static_cast<float>(DelayController.GetTargetDelay(InterpolationJitterSigmas,
+			MinInterpolationDelay, FMath::Max(MinInterpolationDelay, MaxInterpolationDelay), InterpolationDelay))
+		: InterpolationDelay;
+
+	// The delay moves at the slew rate; the clock correction below absorbs it
+	const float MaxStep = MaxTimeSlew * DeltaTime;
+	CurrentInterpolationDelay = FMath::Clamp(TargetDelay, CurrentInterpolationDelay - MaxStep, CurrentInterpolationDelay + MaxStep);
+
+	const double Target = ServerClock.ToArrivedServerTime(FPlatformTime::Seconds()) - CurrentInterpolationDelay;
+	const double Error = Target - InterpolationTime;
+
+	if (FMath::Abs(Error) > ClockSnapThreshold)
+	{
+		if (bDebugLogging)
+		{
+			UE_LOG(LogStateSync, Log, TEXT("StateSynchronizer: render clock off by %.0fms, snapping"), Error * 1000.0);
+		}
+		InterpolationTime = Target;
+		return;
+	}
+
+	// Run slightly fast or slow until caught up, so motion never jumps
+	InterpolationTime += FMath::Clamp(Error, -static_cast<double>(MaxStep), static_cast<double>(MaxStep));
+}
+
+// ============================================================================
+// Binary Parsing
+// ============================================================================
+//
+// WorldSnapshot (op code 13) payload, bincode little-endian:
+//
+//   u8   version (1)
+//   u64  server_tick
+//   f64  server_time
+//   u8   world_phase               EWorldCyclePhase
+//   Vec<Player>   u64 entity_id, [f32; 3] position, f32 yaw, f32 pitch,
+//                 f32 health, f64 timestamp, [f32; 4] resources
+//   Vec<Monster>  u64 entity_id, [f32; 3] position, f32 health,
+//                 u8 combat_phase, u16 status bits (bit N-1 = EMonsterStatusEffect N)
+//
+// Positions are in the same space as the JSON x/y/z fields. Both element
+// types are fixed-size, so each array is bounds-checked once.
+//
+// Version 2 is a delta against a baseline tick the client acked via
+// "delta_baseline" in its poll:
+//
+//   u8   version (2)
+//   u64  server_tick
+//   u64  baseline_tick
+//   f64  server_time
+//   u8   world_phase
+//   f32  position_quantum          world units per step of a quantized offset
+//   Vec<PlayerDelta>   u64 entity_id, u8 field mask, then the present fields
+//   Vec<u64>           removed player ids
+//   Vec<MonsterDelta>  u64 entity_id, u8 field mask, then the present fields
+//   Vec<u64>           removed monster ids
+//
+// Delta and removal lists are sorted by entity id. Entities not listed keep
+// their baseline state; a monster whose position is not in the delta keeps its
+// baseline sample time too, and is dead-reckoned from there along its velocity.
+// That lets the server send monsters far from every player at 5 Hz instead of
+// 20 Hz: it lists them every fourth tick, always with position and velocity
+// together. An entity missing from the baseline starts from
+// defaults, so the server sends every field for it. Quantized offsets are taken
+// against the baseline the client holds, so the server must diff against the
+// dequantized values it sent before, not its own exact positions.
+
+namespace
+{
+	/** Field mask bits for PlayerDelta */
+	enum EPlayerDeltaField : uint8
+	{
+		PlayerDelta_PositionOffset = 1 << 0,   // [i16; 3] offset from baseline, in position_quantum steps
+		PlayerDelta_PositionFull   = 1 << 1,   // [f32; 3] (teleports / offsets out of i16 range)
+		PlayerDelta_Rotation       = 1 << 2,   // u16 yaw, i16 pitch (360 / 65536 degree steps)
+		PlayerDelta_Health         = 1 << 3,   // f32
+		PlayerDelta_Timestamp      = 1 << 4,   // f64
+		PlayerDelta_Resources      = 1 << 5,   // [u16; 4] resource / 65535 * 100
+	};
+
+	/** Field mask bits for MonsterDelta */
+	enum EMonsterDeltaField : uint8
+	{
+		MonsterDelta_PositionOffset = 1 << 0,  // [i16; 3]
+		MonsterDelta_PositionFull   = 1 << 1,  // [f32; 3]
+		MonsterDelta_Health         = 1 << 2,  // f32
+		MonsterDelta_CombatPhase    = 1 << 3,  // u8
+		MonsterDelta_StatusEffects  = 1 << 4,  // u16 status bits
+		MonsterDelta_Velocity       = 1 << 5,  // [f32; 3] world units / second
+	};
+
+	constexpr float QuantizedResourceScale = 100.0f / 65535.0f;
+
+	FORCEINLINE void ReadDeltaPosition(FBincodeReader& Reader, uint8 Mask, uint8 OffsetBit, uint8 FullBit,
+		float Quantum, FVector& InOutPosition)
+	{
+		if (Mask & FullBit)
+		{
+			InOutPosition = Reader.ReadVec3();
+		}
+		else if (Mask & OffsetBit)
+		{
+			const float DX = static_cast<float>(Reader.ReadI16()) * Quantum;
+			const float DY = static_cast<float>(Reader.ReadI16()) * Quantum;
+			const float DZ = static_cast<float>(Reader.ReadI16()) * Quantum;
+			InOutPosition += FVector(DX, DY, DZ);
+		}
+	}
+
+	/** Read a bincode Vec length and sanity-check it against the bytes left */
+	FORCEINLINE bool ReadDeltaCount(FBincodeReader& Reader, int32 MinElementSize, int32& OutCount)
+	{
+		const int64 Count = Reader.ReadU64();
+		if (Reader.HasError() || Count < 0 || Count * MinElementSize > Reader.GetRemainingBytes())
+		{
+			return false;
+		}
+		OutCount = static_cast<int32>(Count);
+		return true;
+	}
+
+	/**
+	 * Merge one entity list: baseline entries are copied unless removed, delta
+	 * entries are applied on top of their baseline (or a default) entry.
+	 * Everything is sorted by EntityId, so this is a single pass.
+	 */
+	template<typename SnapshotT, typename ApplyFn>
+	bool MergeEntityDeltas(FBincodeReader& Reader, const TArray<SnapshotT>& Baseline, TArray<SnapshotT>& Out,
+		TArray<int64>& RemovedScratch, ApplyFn&& ApplyDelta)
+	{
+		// u64 id + u8 mask is the smallest possible entry
+		int32 DeltaCount = 0;
+		if (!ReadDeltaCount(Reader, 9, DeltaCount))
+		{
+			return false;
+		}
+
+		Out.Reset();
+		int32 BaseIndex = 0;
+		int64 PrevId = MIN_int64;
+
+		for (int32 i = 0; i < DeltaCount; ++i)
+		{
+			const int64 EntityId = Reader.ReadI64();
+			const uint8 Mask = Reader.ReadU8();
+			if (Reader.HasError() || EntityId <= PrevId)
+			{
+				return false;
+			}
+			PrevId = EntityId;
+
+			// Unchanged baseline entities before this one
+			while (BaseIndex < Baseline.Num() && Baseline[BaseIndex].EntityId < EntityId)
+			{
+				Out.Add(Baseline[BaseIndex++]);
+			}
+
+			SnapshotT& Entry = Out.AddDefaulted_GetRef();
+			if (BaseIndex < Baseline.Num() && Baseline[BaseIndex].EntityId == EntityId)
+			{
+				Entry = Baseline[BaseIndex++];
+			}
+			Entry.EntityId = EntityId;
+
+			ApplyDelta(Reader, Mask, Entry);
+			if (Reader.HasError())
+			{
+				return false;
+			}
+		}
+
+		while (BaseIndex < Baseline.Num())
+		{
+			Out.Add(Baseline[BaseIndex++]);
+		}
+
+		// Removals (sorted ids) — filter in place with a second merge
+		int32 RemovedCount = 0;
+		if (!ReadDeltaCount(Reader, 8, RemovedCount))
+		{
+			return false;
+		}
+		if (RemovedCount > 0)
+		{
+			RemovedScratch.Reset(RemovedCount);
+			for (int32 i = 0; i < RemovedCount; ++i)
+			{
+				RemovedScratch.Add(Reader.ReadI64());
+			}
+			if (Reader.HasError())
+			{
+				return false;
+			}
+
+			int32 RemovedIndex = 0;
+			int32 WriteIndex = 0;
+			for (int32 ReadIndex = 0; ReadIndex < Out.Num(); ++ReadIndex)
+			{
+				const int64 Id = Out[ReadIndex].EntityId;
+				while (RemovedIndex < RemovedScratch.Num() && RemovedScratch[RemovedIndex] < Id)
+				{
+					++RemovedIndex;
+				}
+				if (RemovedIndex < RemovedScratch.Num() && RemovedScratch[RemovedIndex] == Id)
+				{
+					continue;
+				}
+				if (WriteIndex != ReadIndex)
+				{
+					Out[WriteIndex] = MoveTemp(Out[ReadIndex]);
+				}
+				++WriteIndex;
+			}
+			Out.SetNum(WriteIndex, false);
+		}
+
+		return true;
+	}
+
+	struct FYawPitchWire
+	{
+		static constexpr bool bFixed = true;
+		static constexpr int32 Size = 8;
+
+		static FORCEINLINE void Decode(const uint8* Src, FRotator& Out)
+		{
+			Out = FRotator(Bincode::LoadLittleEndian<float>(Src + 4), Bincode::LoadLittleEndian<float>(Src), 0.0f);
+		}
+	};
+
+	struct FResourcesWire
+	{
+		static constexpr bool bFixed = true;
+		static constexpr int32 Size = 16;
+
+		static FORCEINLINE void Decode(const uint8* Src, FVector4& Out)
+		{
+			Out = FVector4(
+				Bincode::LoadLittleEndian<float>(Src),
+				Bincode::LoadLittleEndian<float>(Src + 4),
+				Bincode::LoadLittleEndian<float>(Src + 8),
+				Bincode::LoadLittleEndian<float>(Src + 12));
+		}
+	};
+
+	struct FStatusBitsWire
+	{
+		static constexpr bool bFixed = true;
+		static constexpr int32 Size = 2;
+
+		static FORCEINLINE void Decode(const uint8* Src, int32& Out)
+		{
+			Out = Bincode::LoadLittleEndian<uint16>(Src);
+		}
+	};
+}
+
+template<>
+struct TBincodeSchema<FPlayerStateSnapshot> : TBincodeFields<FPlayerStateSnapshot,
+	TBincodeField<&FPlayerStateSnapshot::EntityId,  Bincode::TRaw<uint64>>,
+	TBincodeField<&FPlayerStateSnapshot::Position,  Bincode::FVec3>,
+	TBincodeField<&FPlayerStateSnapshot::Rotation,  FYawPitchWire>,
+	TBincodeField<&FPlayerStateSnapshot::Health,    Bincode::TRaw<float>>,
+	TBincodeField<&FPlayerStateSnapshot::Timestamp, Bincode::TRaw<double>>,
+	TBincodeField<&FPlayerStateSnapshot::Resources, FResourcesWire>>
+{};
+
+template<>
+struct TBincodeSchema<FMonsterStateSnapshot> : TBincodeFields<FMonsterStateSnapshot,
+	TBincodeField<&FMonsterStateSnapshot::EntityId,      Bincode::TRaw<uint64>>,
+	TBincodeField<&FMonsterStateSnapshot::Position,      Bincode::FVec3>,
+	TBincodeField<&FMonsterStateSnapshot::Health,        Bincode::TRaw<float>>,
+	TBincodeField<&FMonsterStateSnapshot::CombatPhase,   Bincode::TRaw<uint8>>,
+	TBincodeField<&FMonsterStateSnapshot::StatusMask,    FStatusBitsWire>>
+{};
+
+bool UTowerStateSynchronizer::ParseWorldStateFromBinary(TArrayView<const uint8> Data, FWorldStateBuffer& OutState) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_ParseBinary);
+	FBincodeReader Reader(Data.GetData(), Data.Num());
+
+	const uint8 Version = Reader.ReadU8();
+	if (!Reader.HasError() && Version == WorldDeltaVersion)
+	{
+		const int64 Tick = Reader.ReadI64();
+		const int64 BaselineTick = Reader.ReadI64();
+		if (Reader.HasError())
+		{
+			return false;
+		}
+
+		const FWorldStateBuffer* Baseline = FindSnapshotByTick(BaselineTick);
+		if (!Baseline)
+		{
+			++DeltaBaselineMisses;
+			UE_LOG(LogStateSync, Warning,
+				TEXT("StateSynchronizer: delta tick=%lld references baseline %lld which is no longer buffered"),
+				Tick, BaselineTick);
+			return false;
+		}
+
+		OutState.ServerTick = Tick;
+		if (!ApplyWorldStateDelta(Reader, *Baseline, OutState))
+		{
+			UE_LOG(LogStateSync, Warning, TEXT("StateSynchronizer: malformed delta world snapshot (%d bytes)"), Data.Num());
+			return false;
+		}
+
+		++DeltaSnapshotCount;
+		return true;
+	}
+
+	if (Reader.HasError() || Version != WorldSnapshotVersion)
+	{
+		UE_LOG(LogStateSync, Warning, TEXT("StateSynchronizer: unsupported world snapshot version %d"), Version);
+		return false;
+	}
+
+	OutState.ServerTick = Reader.ReadI64();
+	OutState.ServerTimestamp = Reader.ReadF64();
+
+	const uint8 Phase = Reader.ReadU8();
+	if (Phase <= static_cast<uint8>(EWorldCyclePhase::Pause))
+	{
+		OutState.WorldCyclePhase = static_cast<EWorldCyclePhase>(Phase);
+	}
+
+	if (!Reader.ReadArray(OutState.PlayerSnapshots) || !Reader.ReadArray(OutState.MonsterSnapshots))
+	{
+		UE_LOG(LogStateSync, Warning, TEXT("StateSynchronizer: malformed binary world snapshot (%d bytes)"), Data.Num());
+		return false;
+	}
+
+	// Full snapshots carry no velocity; every monster is sampled now. Slots are reused, so clear both.
+	for (FMonsterStateSnapshot& Snap : OutState.MonsterSnapshots)
+	{
+		Snap.Velocity = FVector::ZeroVector;
+		Snap.SampleTime = OutState.ServerTimestamp;
+	}
+
+	SortByEntityId(OutState);
+	return true;
+}
+
+bool UTowerStateSynchronizer::ApplyWorldStateDelta(FBincodeReader& Reader, const FWorldStateBuffer& Baseline,
+	FWorldStateBuffer& OutState) const
+{
+	OutState.ServerTimestamp = Reader.ReadF64();
+
+	const uint8 Phase = Reader.ReadU8();
+	OutState.WorldCyclePhase = (Phase <= static_cast<uint8>(EWorldCyclePhase::Pause))
+		? static_cast<EWorldCyclePhase>(Phase)
+		: Baseline.WorldCyclePhase;
+
+	const float Quantum = Reader.ReadF32();
+	if (Reader.HasError() || !(Quantum > 0.0f))
+	{
+		return false;
+	}
+
+	// The delta only names changed entities, so the local player id carries over
+	OutState.LocalPlayerEntityId = Baseline.LocalPlayerEntityId;
+
+	TArray<int64> RemovedScratch;
+
+	const bool bPlayersOk = MergeEntityDeltas(Reader, Baseline.PlayerSnapshots, OutState.PlayerSnapshots, RemovedScratch,
+		[Quantum](FBincodeReader& R, uint8 Mask, FPlayerStateSnapshot& Snap)
+		{
+			ReadDeltaPosition(R, Mask, PlayerDelta_PositionOffset, PlayerDelta_PositionFull, Quantum, Snap.Position);
+			if (Mask & PlayerDelta_Rotation)
+			{
+				Snap.Rotation.Yaw = R.ReadYaw16();
+				Snap.Rotation.Pitch = NetQuantize::DequantizePitch(R.ReadI16());
+			}
+			if (Mask & PlayerDelta_Health)
+			{
+				Snap.Health = R.ReadF32();
+			}
+			if (Mask & PlayerDelta_Timestamp)
+			{
+				Snap.Timestamp = R.ReadF64();
+			}
+			if (Mask & PlayerDelta_Resources)
+			{
+				Snap.Resources.X = static_cast<uint16>(R.ReadU16()) * QuantizedResourceScale;
+				Snap.Resources.Y = static_cast<uint16>(R.ReadU16()) * QuantizedResourceScale;
+				Snap.Resources.Z = static_cast<uint16>(R.ReadU16()) * QuantizedResourceScale;
+				Snap.Resources.W = static_cast<uint16>(R.ReadU16()) * QuantizedResourceScale;
+			}
+		});
+	if (!bPlayersOk)
+	{
+		return false;
+	}
+
+	const double SampleTime = OutState.ServerTimestamp;
+	return MergeEntityDeltas(Reader, Baseline.MonsterSnapshots, OutState.MonsterSnapshots, RemovedScratch,
+		[Quantum, SampleTime](FBincodeReader& R, uint8 Mask, FMonsterStateSnapshot& Snap)
+		{
+			if (Mask & (MonsterDelta_PositionOffset | MonsterDelta_PositionFull))
+			{
+				ReadDeltaPosition(R, Mask, MonsterDelta_PositionOffset, MonsterDelta_PositionFull, Quantum, Snap.Position);
+				Snap.SampleTime = SampleTime;
+			}
+			if (Mask & MonsterDelta_Health)
+			{
+				Snap.Health = R.ReadF32();
+			}
+			if (Mask & MonsterDelta_CombatPhase)
+			{
+				const uint8 CombatPhase = R.ReadU8();
+				if (CombatPhase <= static_cast<uint8>(EMonsterCombatPhase::Recovery))
+				{
+					Snap.CombatPhase = static_cast<EMonsterCombatPhase>(CombatPhase);
+				}
+			}
+			if (Mask & MonsterDelta_StatusEffects)
+			{
+				Snap.StatusMask = static_cast<uint16>(R.ReadU16());
+			}
+			if (Mask & MonsterDelta_Velocity)
+			{
+				Snap.Velocity = R.ReadVec3();
+			}
+		});
 }
 
 // ============================================================================
@@ -637,6 +2331,7 @@ void UTowerStateSynchronizer::UpdateRTTEstimate(double SendTime, double ReceiveT
 
 bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FString& JsonString, FWorldStateBuffer& OutState) const
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_ParseJson);
 	TSharedPtr<FJsonObject> Root;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
 
@@ -646,12 +2341,21 @@ bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FString& JsonString,
 		return false;
 	}
 
+	return ParseWorldStateFromJson(*Root, OutState);
+}
+
+bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FJsonObject& Root, FWorldStateBuffer& OutState) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerStateSync_ReadJson);
+	OutState.PlayerSnapshots.Reset();
+	OutState.MonsterSnapshots.Reset();
+
 	// Server tick
-	OutState.ServerTick = static_cast<int64>(Root->GetNumberField(TEXT("server_tick")));
-	OutState.ServerTimestamp = Root->GetNumberField(TEXT("server_time"));
+	OutState.ServerTick = static_cast<int64>(Root.GetNumberField(TEXT("server_tick")));
+	OutState.ServerTimestamp = Root.GetNumberField(TEXT("server_time"));
 
 	// World cycle phase
-	FString PhaseStr = Root->GetStringField(TEXT("world_phase"));
+	FString PhaseStr = Root.GetStringField(TEXT("world_phase"));
 	if (PhaseStr == TEXT("Inhale"))       OutState.WorldCyclePhase = EWorldCyclePhase::Inhale;
 	else if (PhaseStr == TEXT("Hold"))    OutState.WorldCyclePhase = EWorldCyclePhase::Hold;
 	else if (PhaseStr == TEXT("Exhale"))  OutState.WorldCyclePhase = EWorldCyclePhase::Exhale;
@@ -659,7 +2363,7 @@ bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FString& JsonString,
 
 	// Player snapshots
 	const TArray<TSharedPtr<FJsonValue>>* PlayersArray = nullptr;
-	if (Root->TryGetArrayField(TEXT("players"), PlayersArray))
+	if (Root.TryGetArrayField(TEXT("players"), PlayersArray))
 	{
 		for (const TSharedPtr<FJsonValue>& PlayerVal : *PlayersArray)
 		{
@@ -691,7 +2395,7 @@ bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FString& JsonString,
 
 	// Monster snapshots
 	const TArray<TSharedPtr<FJsonValue>>* MonstersArray = nullptr;
-	if (Root->TryGetArrayField(TEXT("monsters"), MonstersArray))
+	if (Root.TryGetArrayField(TEXT("monsters"), MonstersArray))
 	{
 		for (const TSharedPtr<FJsonValue>& MonsterVal : *MonstersArray)
 		{
@@ -703,8 +2407,14 @@ bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FString& JsonString,
 			Snap.Position.X = MonsterObj->GetNumberField(TEXT("x"));
 			Snap.Position.Y = MonsterObj->GetNumberField(TEXT("y"));
 			Snap.Position.Z = MonsterObj->GetNumberField(TEXT("z"));
+			Snap.SampleTime = OutState.ServerTimestamp;
 			Snap.Health = static_cast<float>(MonsterObj->GetNumberField(TEXT("health")));
 
+			// Velocity is optional; without it the monster is only interpolated
+			MonsterObj->TryGetNumberField(TEXT("vx"), Snap.Velocity.X);
+			MonsterObj->TryGetNumberField(TEXT("vy"), Snap.Velocity.Y);
+			MonsterObj->TryGetNumberField(TEXT("vz"), Snap.Velocity.Z);
+
 			// Combat phase
 			FString CombatPhaseStr = MonsterObj->GetStringField(TEXT("combat_phase"));
 			if (CombatPhaseStr == TEXT("Idle"))           Snap.CombatPhase = EMonsterCombatPhase::Idle;
@@ -737,10 +2447,7 @@ bool UTowerStateSynchronizer::ParseWorldStateFromJson(const FString& JsonString,
 					else if (EffectStr == TEXT("Regenerating"))  Effect = EMonsterStatusEffect::Regenerating;
 					else if (EffectStr == TEXT("SemanticFocus")) Effect = EMonsterStatusEffect::SemanticFocus;
 
-					if (Effect != EMonsterStatusEffect::None)
-					{
-						Snap.StatusEffects.Add(Effect);
-					}
+					Snap.StatusMask |= FMonsterStateSnapshot::StatusBit(Effect);
 				}
 			}
 
@@ -2,9 +2,20 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "MatchConnection.h"
+#include "InterestGrid.h"
+#include "ServerClock.h"
+#include "EntityRegistry.h"
+#include "NetClock.h"
+#include "LockstepSim.h"
+#include "Player/TowerMovementSim.h"
+#include "Core/TowerMemory.h"
 #include "StateSynchronizer.generated.h"
 
 class UMatchConnection;
+class FBincodeReader;
+class FBincodeWriter;
+class FTowerReplayRecorder;
 
 // ============================================================================
 // Enums
@@ -111,10 +122,21 @@ struct FMonsterStateSnapshot
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
 	int64 EntityId = 0;
 
-	/** World position */
+	/** World position, as of SampleTime */
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
 	FVector Position = FVector::ZeroVector;
 
+	/** Movement the server intends (world units / second); dead reckoning extrapolates along it */
+	UPROPERTY(BlueprintReadOnly, Category = "Sync")
+	FVector Velocity = FVector::ZeroVector;
+
+	/**
+	 * Server time Position was sampled. Older than the snapshot's own timestamp when
+	 * the server skipped this monster (far ones are sent at a lower rate).
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Sync")
+	double SampleTime = 0.0;
+
 	/** Current health */
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
 	float Health = 0.0f;
@@ -123,9 +145,20 @@ struct FMonsterStateSnapshot
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
 	EMonsterCombatPhase CombatPhase = EMonsterCombatPhase::Idle;
 
-	/** Active status effects on this monster */
+	/** Active status effects on this monster, the server's status bits (bit N-1 = EMonsterStatusEffect N) */
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
-	TArray<EMonsterStatusEffect> StatusEffects;
+	int32 StatusMask = 0;
+
+	/** The effect's bit in StatusMask; 0 for None */
+	static constexpr uint32 StatusBit(EMonsterStatusEffect Effect)
+	{
+		return Effect == EMonsterStatusEffect::None ? 0u : 1u << (static_cast<uint32>(Effect) - 1);
+	}
+
+	bool HasStatusEffect(EMonsterStatusEffect Effect) const
+	{
+		return (static_cast<uint32>(StatusMask) & StatusBit(Effect)) != 0;
+	}
 };
 
 /** Full world state buffer containing all entity snapshots for one tick */
@@ -154,7 +187,18 @@ struct FWorldStateBuffer
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
 	double ServerTimestamp = 0.0;
 
+	/**
+	 * Entity id of the local player. The server lists the local player first;
+	 * once buffered, both snapshot arrays are sorted by EntityId instead.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Sync")
+	int64 LocalPlayerEntityId = 0;
+
 	bool IsValid() const { return ServerTick > 0; }
+
+	/** Binary search by EntityId (arrays must be sorted) */
+	const FPlayerStateSnapshot* FindPlayer(int64 EntityId) const;
+	const FMonsterStateSnapshot* FindMonster(int64 EntityId) const;
 };
 
 /** A pending client-side predicted action awaiting server confirmation */
@@ -186,6 +230,17 @@ struct FPendingAction
 	/** Client-predicted health after this action */
 	UPROPERTY(BlueprintReadOnly, Category = "Sync")
 	float PredictedHealth = 0.0f;
+
+	/** Movement this action added on top of the previous prediction; replayed onto corrected state */
+	UPROPERTY(BlueprintReadOnly, Category = "Sync")
+	FVector PositionDelta = FVector::ZeroVector;
+
+	/** Move actions from PredictMove: the sim tick's input, re-stepped on replay instead of PositionDelta */
+	bool bHasMoveInput = false;
+	FTowerMoveInput MoveInput;
+
+	/** Sim velocity after this action, where the next replayed move starts from */
+	FVector PredictedVelocity = FVector::ZeroVector;
 };
 
 // ============================================================================
@@ -195,6 +250,44 @@ struct FPendingAction
 /** Broadcast when a new authoritative world state arrives from the server */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStateUpdated, const FWorldStateBuffer&, NewState);
 
+/** Broadcast when an entity first appears in a server snapshot */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+	FOnEntitySpawned,
+	EReplicatedEntityKind, Kind,
+	int64, EntityId
+);
+
+/** Broadcast when an entity is no longer in the server snapshot (despawned or out of interest) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+	FOnEntityDespawned,
+	EReplicatedEntityKind, Kind,
+	int64, EntityId
+);
+
+/** Broadcast when an entity moved more than EventMoveThreshold since its last move event */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
+	FOnEntityMoved,
+	EReplicatedEntityKind, Kind,
+	int64, EntityId,
+	FVector, Position
+);
+
+/** Broadcast when an entity's authoritative health changes */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
+	FOnEntityHealthChanged,
+	EReplicatedEntityKind, Kind,
+	int64, EntityId,
+	float, OldHealth,
+	float, NewHealth
+);
+
+/** Broadcast when the set of status effects on a monster changes (as FMonsterStateSnapshot::StatusMask) */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
+	FOnMonsterStatusChanged,
+	int64, EntityId,
+	int32, StatusMask
+);
+
 /** Broadcast when the client prediction was wrong and a correction was applied */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
 	FOnPredictionCorrected,
@@ -203,7 +296,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(
 	FVector, PredictedPosition
 );
 
-/** Broadcast when significant desync is detected between client and server */
+/**
+ * Broadcast when significant desync is detected between client and server. In
+ * lockstep a peer's state hash differing from ours is reported the same way,
+ * with DesyncDistance 0 and ServerTick the lockstep tick.
+ */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
 	FOnDesyncDetected,
 	float, DesyncDistance,
@@ -219,7 +316,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
  * the Rust procedural core server.
  *
  * Responsibilities:
- * - Periodic state polling from the Rust server at a configurable tick rate
+ * - Server-push state subscription (or periodic polling, for servers without push) from the Rust server
  * - Client-side prediction for player movement and actions
  * - Server reconciliation when authoritative state arrives
  * - State interpolation between snapshots for smooth visual updates
@@ -229,16 +326,39 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
  * for communication with the server.
  *
  * Prediction model:
- * 1. Client issues an action (move, attack, etc.)
+ * 1. Client issues an action (move, attack, etc.); movement is one PredictMove
+ *    per FTowerMovementSim tick, carrying that tick's input
  * 2. Action is applied locally immediately for responsiveness
  * 3. Action is queued as FPendingAction with a sequence number
  * 4. When server confirms, the pending action is removed
- * 5. If server state diverges, reconciliation replays un-acked actions
+ * 5. If server state diverges, reconciliation replays un-acked actions;
+ *    moves are re-stepped through the same sim from the server position, so
+ *    the replay reproduces the local prediction exactly when the two agree
+ *
+ * Listeners:
+ * - Per-entity events (spawn, despawn, move, health, monster status) fire once
+ *   per snapshot for the entities that changed, after it is buffered
+ * - GetStateView() is the pull side: the interpolated state, evaluated at most
+ *   once per frame and only when someone asks
+ * - OnStateUpdated still hands out the whole interpolated state, but is only
+ *   evaluated while something is bound to it
  *
  * Interpolation model:
- * - Rendering runs at InterpolationDelay behind the latest server state
- * - Smooth lerp between the two most recent snapshots
+ * - The render clock follows the server clock (FServerClockEstimator), held
+ *   behind the freshest state by a delay sized from snapshot jitter
+ * - Offset and delay changes are slewed in, never stepped, unless far off
+ * - Smooth lerp between the two snapshots bracketing the render time
  * - Teleport if gap exceeds TeleportThreshold
+ * - Monsters are dead-reckoned from their last sample (bDeadReckonMonsters),
+ *   so the server can send far ones at a fraction of the snapshot rate
+ *
+ * Lockstep model (bLockstepMode):
+ * - The leader seeds FLockstepSim from its latest snapshot and sends the exact
+ *   sim state to the party; from then on only inputs and periodic hashes travel
+ * - Each tick's input is sent InputDelayTicks ahead; a tick is simulated once
+ *   every player's input for it has arrived
+ * - Every simulated tick is buffered like a server snapshot, so interpolation,
+ *   entity events and GetStateView() work unchanged; prediction is bypassed
  */
 UCLASS(ClassGroup = (Network), meta = (BlueprintSpawnableComponent))
 class TOWERGAME_API UTowerStateSynchronizer : public UActorComponent
@@ -255,34 +375,154 @@ public:
 
 	// ============ Configuration ============
 
-	/** How many state polls per second to request from the server (Hz) */
+	/** How many state polls per second to request from the server (Hz), at most one per network step; unused while subscribed */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "1", ClampMax = "60"))
 	float SyncRate = 20.0f;
 
-	/** Delay in seconds for interpolation buffer (renders behind real-time) */
+	/**
+	 * Subscribe once and let the server push snapshots at its own tick rate
+	 * instead of polling at SyncRate, saving the request half of every round trip.
+	 * A server that answers the subscribe only once is treated as poll-only.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bSubscribeToServerPush = true;
+
+	/**
+	 * Seconds between subscription refreshes, which carry the pending-action ack
+	 * and give an RTT sample. One also goes out at once when the interest cell
+	 * changes or a full snapshot is needed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (EditCondition = "bSubscribeToServerPush", ClampMin = "0.1"))
+	float SubscriptionRefreshSeconds = 1.0f;
+
+	/**
+	 * Delay in seconds for interpolation buffer (renders behind the freshest server state).
+	 * With bAdaptiveInterpolationDelay this is only used until enough snapshots have arrived.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "0.0", ClampMax = "0.5"))
 	float InterpolationDelay = 0.1f;
 
+	/** Size the delay from measured inter-arrival jitter instead of using InterpolationDelay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bAdaptiveInterpolationDelay = true;
+
+	/** Adaptive delay = mean snapshot interval + this many standard deviations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (EditCondition = "bAdaptiveInterpolationDelay", ClampMin = "0.0", ClampMax = "5.0"))
+	float InterpolationJitterSigmas = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (EditCondition = "bAdaptiveInterpolationDelay", ClampMin = "0.0", ClampMax = "0.5"))
+	float MinInterpolationDelay = 0.03f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (EditCondition = "bAdaptiveInterpolationDelay", ClampMin = "0.0", ClampMax = "1.0"))
+	float MaxInterpolationDelay = 0.3f;
+
+	/**
+	 * How much faster or slower than real time the render clock may run while
+	 * converging on a new delay or clock offset (0.05 = 5%).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float MaxTimeSlew = 0.05f;
+
+	/** Render clock errors larger than this (seconds) are corrected at once instead of slewed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "0.0"))
+	float ClockSnapThreshold = 0.25f;
+
 	/** Enable client-side prediction for local player actions */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
 	bool bPredictionEnabled = true;
 
 	/** Maximum number of unconfirmed predicted actions before stalling input */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "4", ClampMax = "128"))
-	int32 MaxPendingActions = 32;
+	int32 MaxPendingActions = 64;
 
 	/** Distance threshold to trigger a teleport instead of interpolation */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
 	float TeleportThreshold = 500.0f;
 
+	/**
+	 * Extrapolate monsters along their velocity from their last sample, so ones the
+	 * server sends at a reduced rate keep moving between updates. A fresh sample is
+	 * blended in over the next snapshot interval; errors beyond TeleportThreshold snap.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bDeadReckonMonsters = true;
+
+	/** Longest a monster is extrapolated past its last sample (seconds); it holds there after */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (EditCondition = "bDeadReckonMonsters", ClampMin = "0.0", ClampMax = "2.0"))
+	float MaxExtrapolationSeconds = 0.5f;
+
 	/** Distance threshold to consider a prediction a desync */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
 	float DesyncThreshold = 50.0f;
 
+	/** Distance an entity must move since its last OnEntityMoved before it fires again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "0.0"))
+	float EventMoveThreshold = 25.0f;
+
 	/** Maximum number of snapshots retained in the circular buffer */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (ClampMin = "8", ClampMax = "256"))
 	int32 MaxSnapshotBufferSize = 64;
 
+	/**
+	 * Ask the server for bincode WorldSnapshot replies instead of JSON.
+	 * Servers that don't understand the request keep answering with JSON BreathSync,
+	 * which is still accepted.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bRequestBinarySnapshots = true;
+
+	/**
+	 * Ask for delta WorldSnapshots against the last buffered tick (binary only).
+	 * The server then sends only changed fields; the full state is rebuilt from
+	 * the baseline snapshot still held in the ring.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bRequestDeltaSnapshots = true;
+
+	/**
+	 * Advertise the codecs in PayloadCompression::GetAcceptedCodecs() with every poll.
+	 * The server may then send large snapshots as compressed frames; MatchConnection
+	 * inflates them before they reach this component.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bAcceptCompressedSnapshots = true;
+
+	/**
+	 * Report the local player's relevancy cell with every poll so the server only
+	 * sends entities within InterestSettings.FarRadiusCells. Cells are computed in
+	 * snapshot space from the local player's last authoritative position.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config")
+	bool bRequestInterestFiltering = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Config", meta = (EditCondition = "bRequestInterestFiltering"))
+	FInterestSettings InterestSettings;
+
+	/**
+	 * For small co-op parties: stop polling and exchange only inputs, simulating
+	 * the floor locally with FLockstepSim and comparing state hashes every
+	 * LockstepSettings.HashIntervalTicks. The player with the lowest id leads and
+	 * starts a session from its latest server snapshot; a desync, a stalled peer
+	 * or a party change drops everyone back to streaming until it starts again.
+	 * Every client in the party needs this on.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Lockstep")
+	bool bLockstepMode = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|Lockstep", meta = (EditCondition = "bLockstepMode"))
+	FLockstepSettings LockstepSettings;
+
+	/**
+	 * How far behind the newest snapshot RewindEntity will look (seconds).
+	 * Matches the server's MAX_REWIND_SECS; older hits can't be validated.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|LagCompensation", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MaxRewindSeconds = 0.5f;
+
+	/** Extra reach ValidateHit allows for interpolation error (world units) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sync|LagCompensation", meta = (ClampMin = "0.0"))
+	float HitTolerance = 50.0f;
+
 	// ============ Controls ============
 
 	/** Begin synchronization with the server. Call after match connection is established. */
@@ -306,26 +546,114 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Sync")
 	FWorldStateBuffer GetInterpolatedState() const;
 
+	/** Same as GetInterpolatedState, but writes into OutState and reuses its arrays */
+	void EvaluateInterpolatedState(FWorldStateBuffer& OutState) const;
+
+	/**
+	 * The interpolated state for this frame, without a copy. Evaluated on the first
+	 * call each frame (or after a new snapshot); the reference stays valid until the
+	 * next call in a later frame, so don't hold on to it.
+	 */
+	const FWorldStateBuffer& GetStateView() const;
+
+	/** Entity in GetStateView(), or nullptr */
+	const FPlayerStateSnapshot* FindPlayerView(int64 EntityId) const { return GetStateView().FindPlayer(EntityId); }
+	const FMonsterStateSnapshot* FindMonsterView(int64 EntityId) const { return GetStateView().FindMonster(EntityId); }
+
+	/** Blueprint access to one player of GetStateView(); false if it isn't there */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	bool GetPlayerView(int64 EntityId, FPlayerStateSnapshot& OutSnapshot) const;
+
+	/** Blueprint access to one monster of GetStateView(); false if it isn't there */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	bool GetMonsterView(int64 EntityId, FMonsterStateSnapshot& OutSnapshot) const;
+
 	/** Get the latest raw (non-interpolated) server state */
 	UFUNCTION(BlueprintPure, Category = "Sync")
 	FWorldStateBuffer GetLatestServerState() const;
 
 	/** Get the current number of buffered snapshots */
 	UFUNCTION(BlueprintPure, Category = "Sync")
-	int32 GetBufferedSnapshotCount() const { return SnapshotBuffer.Num(); }
+	int32 GetBufferedSnapshotCount() const { return SnapshotCount; }
 
 	/** Get the number of pending (unconfirmed) actions */
 	UFUNCTION(BlueprintPure, Category = "Sync")
-	int32 GetPendingActionCount() const { return PendingActions.Num(); }
+	int32 GetPendingActionCount() const { return static_cast<int32>(NextSequenceNumber - OldestPendingSequence); }
 
 	/** Get current estimated round-trip time in seconds */
 	UFUNCTION(BlueprintPure, Category = "Sync")
 	float GetEstimatedRTT() const { return EstimatedRTT; }
 
+	/** Interpolation delay in effect right now (seconds); slews toward the adaptive target */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	float GetCurrentInterpolationDelay() const { return CurrentInterpolationDelay; }
+
+	/** Estimated server clock minus FPlatformTime::Seconds() */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	double GetServerClockOffset() const { return ServerClock.GetOffset(); }
+
+	/** Estimated current server time */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	double GetEstimatedServerTime() const { return ServerClock.ToServerTime(FPlatformTime::Seconds()); }
+
 	/** Get the last known server tick */
 	UFUNCTION(BlueprintPure, Category = "Sync")
 	int64 GetLastServerTick() const;
 
+	/** True while the server pushes snapshots on a subscription rather than answering polls */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	bool IsReceivingServerPush() const { return bSubscriptionOpen && bServerPushConfirmed; }
+
+	/** True once the server has answered with at least one binary snapshot */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	bool IsReceivingBinarySnapshots() const { return bReceivingBinarySnapshots; }
+
+	/** Number of delta snapshots rebuilt from a baseline since BeginSync */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	int32 GetDeltaSnapshotCount() const { return DeltaSnapshotCount; }
+
+	/** Number of delta snapshots dropped because their baseline was no longer buffered */
+	UFUNCTION(BlueprintPure, Category = "Sync")
+	int32 GetDeltaBaselineMissCount() const { return DeltaBaselineMisses; }
+
+	/** True while a lockstep session runs and polling is paused */
+	UFUNCTION(BlueprintPure, Category = "Sync|Lockstep")
+	bool IsLockstepActive() const { return bLockstepActive; }
+
+	/** Ticks simulated in the current (or last) lockstep session */
+	UFUNCTION(BlueprintPure, Category = "Sync|Lockstep")
+	int64 GetLockstepTick() const { return LockstepSim.GetTick(); }
+
+	/** Lockstep sessions ended by a state hash mismatch since BeginSync */
+	UFUNCTION(BlueprintPure, Category = "Sync|Lockstep")
+	int32 GetLockstepDesyncCount() const { return LockstepDesyncs; }
+
+	// ============ Lag Compensation ============
+
+	/**
+	 * Server time the current frame renders: what the player sees and aims at.
+	 * Send it with an attack so the hit is checked against the same poses.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sync|LagCompensation")
+	double GetRenderTime() const { return InterpolationTime; }
+
+	/**
+	 * Where a player or monster was at RenderTime (server clock), interpolated
+	 * from the buffered snapshots. Times past the newest snapshot clamp to it.
+	 * False if the entity isn't in the bracketing snapshots, or RenderTime is
+	 * older than the buffer or more than MaxRewindSeconds behind the newest.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sync|LagCompensation")
+	bool RewindEntity(int64 EntityId, double RenderTime, FVector& OutPosition) const;
+
+	/**
+	 * Would an attack of Range from AttackerLocation have reached TargetId as it
+	 * stood at RenderTime? Run before SendAttack; the server repeats the check
+	 * against its own history, so this only avoids sending hits it will reject.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Sync|LagCompensation")
+	bool ValidateHit(int64 TargetId, FVector AttackerLocation, float Range, double RenderTime) const;
+
 	// ============ Prediction ============
 
 	/**
@@ -338,18 +666,51 @@ public:
 	int64 PredictAction(EPredictedActionType ActionType, FVector PredictedPosition,
 		FRotator PredictedRotation, float PredictedHealth);
 
+	/**
+	 * Register one FTowerMovementSim tick of local movement: Input and the state it
+	 * stepped to (after the character's collision response). Replays re-step Input.
+	 */
+	int64 PredictMove(const FTowerMoveInput& Input, const FTowerMoveState& Result, float PredictedHealth);
+
+	/** Tuning replays step with; the character sets it to match its own sim */
+	void SetMovementSim(const FTowerMovementSim& Sim) { MovementSim = Sim; }
+
+	/** Velocity and yaw the last replay ended on, for OnPredictionCorrected listeners to continue from */
+	const FTowerMoveState& GetReplayedMoveState() const { return ReplayedMoveState; }
+
 	/**
 	 * Called internally when server state arrives. Compares server authority
-	 * against pending predictions and corrects if needed.
+	 * against the prediction for the newest confirmed action; on a mismatch only
+	 * the actions after it are replayed, in place, so the cost is bounded by
+	 * MaxPendingActions and never allocates.
 	 */
 	void ReconcileState(const FWorldStateBuffer& AuthoritativeState);
 
 	// ============ Events ============
 
-	/** Broadcast when a new interpolated state is available */
+	/**
+	 * Broadcast with the whole interpolated state when any entity changed. Prefer the
+	 * per-entity events below or GetStateView(); this one is only evaluated while bound.
+	 */
 	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
 	FOnStateUpdated OnStateUpdated;
 
+	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
+	FOnEntitySpawned OnEntitySpawned;
+
+	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
+	FOnEntityDespawned OnEntityDespawned;
+
+	/** Position is the authoritative snapshot position, not the interpolated one */
+	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
+	FOnEntityMoved OnEntityMoved;
+
+	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
+	FOnEntityHealthChanged OnEntityHealthChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
+	FOnMonsterStatusChanged OnMonsterStatusChanged;
+
 	/** Broadcast when a prediction was incorrect and had to be corrected */
 	UPROPERTY(BlueprintAssignable, Category = "Sync|Events")
 	FOnPredictionCorrected OnPredictionCorrected;
@@ -365,6 +726,9 @@ public:
 	bool bDebugLogging = false;
 
 private:
+	/** Times the snapshot parsers on synthetic payloads */
+	friend class ATowerSerializerBenchmark;
+
 	// ============ Internal State ============
 
 	/** Whether the synchronizer is currently active */
@@ -373,79 +737,399 @@ private:
 	/** Timer accumulator for sync polling interval */
 	float SyncTimer = 0.0f;
 
-	/** Current render interpolation time (behind real-time by InterpolationDelay) */
+	/**
+	 * Requests (polls, subscribes, unsubscribes) go out in the network clock's
+	 * Send phase; TickComponent only moves the render clock and lockstep
+	 */
+	FTowerNetClock* NetClock = nullptr;
+	TUniquePtr<FTowerNetClock> OwnedNetClock;
+	FDelegateHandle SendStepHandle;
+	void StepSend(float StepSeconds);
+
+	/** Current render time on the server clock (behind the freshest state by CurrentInterpolationDelay) */
 	double InterpolationTime = 0.0;
 
+	/** Delay the render clock is converging on / currently held at */
+	float CurrentInterpolationDelay = 0.0f;
+
+	FServerClockEstimator ServerClock;
+	FInterpolationDelayController DelayController;
+
 	/** Next sequence number for predicted actions */
 	int64 NextSequenceNumber = 1;
 
 	/** Last confirmed server tick for delta detection */
 	int64 LastConfirmedServerTick = 0;
 
+	/** UTowerNetworkSubsystem's traffic stats, looked up in BeginSync */
+	FTowerNetStatsCollector* NetStats = nullptr;
+
+	/** UTowerNetworkSubsystem's replay recorder, looked up in BeginSync; a no-op until it is started */
+	FTowerReplayRecorder* ReplayRecorder = nullptr;
+
+	/** Set while PredictMove registers its action, which it has recorded with the move input already */
+	bool bPredictingMove = false;
+
 	/** Estimated round-trip time in seconds */
 	float EstimatedRTT = 0.0f;
 
 	/** Smoothed RTT for jitter compensation */
 	float SmoothedRTT = 0.0f;
 
-	/** Timestamp of the last poll request sent */
+	/** Timestamp of the last poll (or subscribe) request sent */
 	double LastPollSentTime = 0.0;
 
+	// ============ Server Push ============
+
+	/** A subscribe went out and hasn't been closed (StopSync, lockstep) or timed out */
+	bool bSubscriptionOpen = false;
+
+	/** More than one snapshot has arrived for a single subscribe, so the server really pushes */
+	bool bServerPushConfirmed = false;
+
+	/** The server stopped after one reply to a subscribe; poll for the rest of the session */
+	bool bServerPushUnsupported = false;
+
+	/** The next snapshot answers the last subscribe and gives the RTT sample */
+	bool bAwaitingSubscribeReply = false;
+
+	/** Snapshots received since the last subscribe message */
+	int32 SnapshotsSinceSubscribe = 0;
+
+	/** Seconds since the last subscribe message / the last snapshot */
+	float SubscriptionAge = 0.0f;
+	float SubscriptionSilence = 0.0f;
+
+	/** What the last subscribe asked for, to resubscribe when it changes */
+	FIntPoint SubscribedCell = FIntPoint(MAX_int32, MAX_int32);
+	bool bSubscribedForFullSnapshot = false;
+
+	/** Whether the last world state came in the binary format */
+	bool bReceivingBinarySnapshots = false;
+
+	/** GetStateView() cache; rebuilt when the frame changes or a snapshot arrives */
+	mutable FWorldStateBuffer StateView;
+	mutable uint64 StateViewFrame = 0;
+	mutable bool bStateViewValid = false;
+
+	/** One per-entity change, queued while a snapshot is applied and broadcast afterwards */
+	enum class EEntityEventType : uint8
+	{
+		Spawned,
+		Despawned,
+		Moved,
+		HealthChanged,
+		StatusChanged,
+	};
+
+	struct FEntityEvent
+	{
+		EEntityEventType Type;
+		EReplicatedEntityKind Kind;
+		int64 EntityId;
+		FVector Position;
+		float OldHealth;
+		float NewHealth;
+		uint32 StatusMask;
+	};
+
+	/**
+	 * Reused between snapshots; only filled for events something is bound to,
+	 * except status changes and monster despawns, which the status effect store takes
+	 */
+	TArray<FEntityEvent> PendingEntityEvents;
+
+	/** Relevancy grid for the interest cell reported in polls */
+	FInterestGrid InterestGrid;
+
+	/** Set when a delta could not be rebuilt; the next poll asks for a full snapshot */
+	bool bNeedFullSnapshot = false;
+
+	/** Delta snapshot counters (reset in BeginSync, bumped by the const parse path) */
+	mutable int32 DeltaSnapshotCount = 0;
+	mutable int32 DeltaBaselineMisses = 0;
+
 	// ============ Buffers ============
 
-	/** Circular buffer of received world state snapshots for interpolation */
-	TArray<FWorldStateBuffer> SnapshotBuffer;
+	/**
+	 * Circular buffer of received world state snapshots for interpolation.
+	 * Slots are allocated once in BeginSync (capacity + 1, the spare being the
+	 * write slot) and parsed into in place, so their inner arrays are reused.
+	 * Ordered oldest -> newest by ServerTimestamp starting at SnapshotHead.
+	 */
+	TArray<FWorldStateBuffer> SnapshotSlots;
+
+	/** Slot index of the oldest buffered snapshot */
+	int32 SnapshotHead = 0;
+
+	/** Number of live snapshots (<= SnapshotSlots.Num() - 1) */
+	int32 SnapshotCount = 0;
+
+	/**
+	 * Actions predicted locally but not yet confirmed by the server, in a ring
+	 * allocated once in BeginSync (MaxPendingActions slots) and indexed by
+	 * SequenceNumber % capacity. Live sequences are [OldestPendingSequence, NextSequenceNumber).
+	 */
+	TArray<FPendingAction> PendingRing;
 
-	/** Queue of actions predicted locally but not yet confirmed by server */
-	TArray<FPendingAction> PendingActions;
+	/** Sequence number of the oldest unconfirmed action */
+	int64 OldestPendingSequence = 1;
+
+	/** What the snapshot and pending rings hold, in the Net memory bucket */
+	FTowerMemoryReport BufferMemory{ ETowerMemoryBucket::Net };
+
+	/** Steps replayed PredictMove actions */
+	FTowerMovementSim MovementSim;
+
+	/** Where the last ReplayPendingActions ended */
+	FTowerMoveState ReplayedMoveState;
+
+	/** Predicted position the oldest pending action's delta is relative to (the last confirmed state) */
+	FVector PredictionBaseline = FVector::ZeroVector;
+	bool bHasPredictionBaseline = false;
 
 	/**
-	 * Previous snapshot data for delta detection.
-	 * Key: EntityId, Value: last synced position hash.
-	 * Used to skip re-processing entities whose state has not changed.
+	 * Per-entity state for delta detection (last state hash, position, health),
+	 * shared with AReplicationManager through UTowerNetworkSubsystem and looked
+	 * up in BeginSync; OwnedEntities when there is no subsystem.
 	 */
-	TMap<int64, int32> PreviousEntityStateHashes;
+	FReplicatedEntityRegistry* SharedEntities = nullptr;
+	FReplicatedEntityRegistry OwnedEntities;
+
+	FReplicatedEntityRegistry& GetEntities() { return SharedEntities ? *SharedEntities : OwnedEntities; }
+
+	/** Counts applied snapshots so entities missing from the latest can be dropped */
+	uint32 EntitySeenStamp = 0;
+
+	// ============ Lockstep ============
+
+	/** Input ticks buffered per player; peers are never more than two input delays ahead */
+	static constexpr int32 LockstepInputRingTicks = 64;
+
+	/** Local state hashes kept for peers' hashes that arrive late */
+	static constexpr int32 LockstepHashHistory = 8;
+
+	struct FLockstepInputSlot
+	{
+		int64 Tick = -1;
+		FLockstepInput Input;
+	};
+
+	struct FLockstepHash
+	{
+		int64 Tick = -1;
+		uint32 Hash = 0;
+	};
+
+	bool bLockstepActive = false;
+	FLockstepSim LockstepSim;
+
+	/** Picked by the leader; traffic from other sessions is ignored */
+	uint32 LockstepSession = 0;
+	int64 LockstepLeaderId = 0;
+	int64 LockstepLocalId = 0;
+
+	/** The leader's settings for the session */
+	int32 LockstepInputDelay = 0;
+	int32 LockstepHashInterval = 0;
+
+	/** The snapshot the session started from; sim states keep its tick and count time from its timestamp */
+	int64 LockstepBaseTick = 0;
+	double LockstepStartTime = 0.0;
+
+	float LockstepAccumulator = 0.0f;
+	float LockstepStallTime = 0.0f;
+
+	/** Seconds until the leader may start another session */
+	float LockstepRestartTimer = 0.0f;
+
+	int32 LockstepDesyncs = 0;
+
+	/** Local input since the last tick; an attack press sticks until a tick samples it */
+	FLockstepInput LockstepInput;
+
+	/** LockstepInputRingTicks slots per session player, indexed by tick */
+	TArray<FLockstepInputSlot> LockstepInputs;
+
+	/** One input per session player for the tick being stepped */
+	TArray<FLockstepInput> LockstepStepInputs;
+
+	/** Ring by tick / LockstepHashInterval */
+	FLockstepHash LockstepLocalHashes[LockstepHashHistory];
+
+	/** Peers' hashes for ticks we haven't reached yet */
+	TArray<FLockstepHash> LockstepRemoteHashes;
+
+	TArray<uint8> LockstepSendBuffer;
 
 	// ============ Internal Methods ============
 
 	/** Get the match connection subsystem */
 	UMatchConnection* GetMatchConnection() const;
 
-	/** Poll the server for the latest world state */
-	void PollServerState();
+	enum class EStateRequest : uint8
+	{
+		Poll,           // Answer with one snapshot
+		Subscribe,      // Answer with one snapshot, then push one every server tick
+		Unsubscribe,    // Stop pushing
+	};
+
+	/** Poll, (re)subscribe or unsubscribe; every kind but Unsubscribe carries the full request */
+	void SendStateRequest(EStateRequest Kind);
+
+	/** Keep the push subscription open and current; falls back to polling if the server doesn't push */
+	void TickSubscription(float DeltaTime);
+
+	/** Move the interest grid's viewer to the local player in the newest snapshot; false if there's none */
+	bool UpdateInterestViewer();
+
+	/** Snapshot by age: 0 is the oldest, SnapshotCount - 1 the newest */
+	const FWorldStateBuffer& GetSnapshot(int32 Index) const
+	{
+		return SnapshotSlots[(SnapshotHead + Index) % SnapshotSlots.Num()];
+	}
+
+	/** Slot the next snapshot should be parsed into; not live until CommitSnapshotWrite */
+	FWorldStateBuffer& BeginSnapshotWrite();
+
+	/** Publish the write slot as the newest snapshot, evicting the oldest if full */
+	void CommitSnapshotWrite();
 
-	/** Push a new snapshot into the circular buffer, evicting the oldest if full */
-	void BufferSnapshot(const FWorldStateBuffer& Snapshot);
+	/** Re-measure the snapshot and pending rings into BufferMemory */
+	void ReportBufferMemory();
 
-	/** Interpolate between two world state buffers at the given alpha */
-	FWorldStateBuffer LerpWorldState(const FWorldStateBuffer& A, const FWorldStateBuffer& B, float Alpha) const;
+	/** Index of the first snapshot with ServerTimestamp >= Time (SnapshotCount if none) */
+	int32 FindSnapshotAtOrAfter(double Time) const;
+
+	/** Buffered snapshot for the given server tick, or nullptr if it has been evicted */
+	const FWorldStateBuffer* FindSnapshotByTick(int64 Tick) const;
+
+	/**
+	 * Interpolate between two world state buffers at the given alpha.
+	 * Entities are matched with a linear merge over the EntityId-sorted arrays.
+	 */
+	void LerpWorldState(const FWorldStateBuffer& A, const FWorldStateBuffer& B, float Alpha, FWorldStateBuffer& Out) const;
 
 	/** Interpolate a single player snapshot */
-	FPlayerStateSnapshot LerpPlayerSnapshot(const FPlayerStateSnapshot& A, const FPlayerStateSnapshot& B, float Alpha) const;
+	void LerpPlayerSnapshot(const FPlayerStateSnapshot& A, const FPlayerStateSnapshot& B, float Alpha, FPlayerStateSnapshot& Out) const;
+
+	/**
+	 * Interpolate a single monster snapshot; TimeA / TimeB are the owning snapshots'
+	 * timestamps, which the two are dead-reckoned to before blending
+	 */
+	void LerpMonsterSnapshot(const FMonsterStateSnapshot& A, double TimeA, const FMonsterStateSnapshot& B, double TimeB,
+		float Alpha, FMonsterStateSnapshot& Out) const;
 
-	/** Interpolate a single monster snapshot */
-	FMonsterStateSnapshot LerpMonsterSnapshot(const FMonsterStateSnapshot& A, const FMonsterStateSnapshot& B, float Alpha) const;
+	/** Monster position extrapolated from its sample to Time (clamped to MaxExtrapolationSeconds) */
+	FVector ReckonMonsterPosition(const FMonsterStateSnapshot& Snapshot, double Time) const;
 
-	/** Remove all pending actions with sequence number <= the given value */
+	/** Dead-reckon every monster of State to Time, past the newest snapshot */
+	void ExtrapolateMonsters(FWorldStateBuffer& State, double Time) const;
+
+	/** Monster (the usual hit target) or else player position in State at its timestamp */
+	bool FindEntityPosition(const FWorldStateBuffer& State, int64 EntityId, FVector& OutPosition) const;
+
+	/** Element-wise copy that keeps Dst's array allocations */
+	static void CopyWorldState(const FWorldStateBuffer& Src, FWorldStateBuffer& Dst);
+
+	/** Record the local player and sort both entity arrays by EntityId */
+	static void SortByEntityId(FWorldStateBuffer& State);
+
+	FPendingAction& GetPendingAction(int64 SequenceNumber)
+	{
+		return PendingRing[static_cast<int32>(SequenceNumber % PendingRing.Num())];
+	}
+
+	/** Drop all pending actions with sequence number <= the given value */
 	void AcknowledgeActionsUpTo(int64 SequenceNumber);
 
-	/** Re-apply un-acknowledged pending actions on top of server state */
-	FVector ReplayPendingActions(FVector ServerPosition) const;
+	/**
+	 * Re-apply pending actions from FirstSequence on, starting at Position: moves
+	 * are re-stepped through MovementSim, other actions re-add their deltas.
+	 * Predicted positions are rewritten in place.
+	 * @return The corrected prediction of the newest action.
+	 */
+	FVector ReplayPendingActions(int64 FirstSequence, FVector Position);
 
 	/** Compute a simple hash of an entity's mutable state for delta detection */
 	int32 ComputeEntityStateHash(const FPlayerStateSnapshot& Snapshot) const;
 	int32 ComputeEntityStateHash(const FMonsterStateSnapshot& Snapshot) const;
 
-	/** Check if an entity's state has changed since the last sync */
-	bool HasEntityStateChanged(int64 EntityId, int32 NewHash) const;
+	/**
+	 * Update the entity's registry slot and queue its change events;
+	 * true if its state changed since the last sync.
+	 */
+	bool UpdateEntityState(EReplicatedEntityKind Kind, int64 EntityId, int32 NewHash, const FVector& Position,
+		float Health, uint32 StatusMask = 0);
+
+	/** Drop registry tracking of entities not stamped EntitySeenStamp, queueing despawns */
+	void RemoveUnseenEntities();
+
+	/** Fire and clear PendingEntityEvents */
+	void BroadcastEntityEvents();
 
 	/** Parse incoming JSON state data from the match connection */
 	bool ParseWorldStateFromJson(const FString& JsonString, FWorldStateBuffer& OutState) const;
 
-	/** Handle incoming match data that contains world state */
-	UFUNCTION()
-	void OnMatchDataReceived(EMatchOpCode OpCode, const FString& DataJson);
+	/** Read world state from a payload UMatchConnection has already parsed */
+	bool ParseWorldStateFromJson(const FJsonObject& Root, FWorldStateBuffer& OutState) const;
+
+	/** Decode a bincode WorldSnapshot payload (layout documented in the .cpp) */
+	bool ParseWorldStateFromBinary(TArrayView<const uint8> Data, FWorldStateBuffer& OutState) const;
+
+	/** Rebuild OutState from a baseline snapshot plus a version 2 delta body */
+	bool ApplyWorldStateDelta(FBincodeReader& Reader, const FWorldStateBuffer& Baseline, FWorldStateBuffer& OutState) const;
+
+	/** BreathSync reply carrying the world state as JSON, parsed off the game thread */
+	void OnBreathSyncReceived(EMatchOpCode OpCode, const FJsonObject& Data);
+
+	/** PlayerJoined / PlayerLeft: ends a lockstep session */
+	void OnPartyChanged(EMatchOpCode OpCode, const FJsonObject& Data);
+
+	/** Bincode WorldSnapshot payload */
+	void OnWorldSnapshotReceived(EMatchOpCode OpCode, TArrayView<const uint8> Data);
+
+	/** Lockstep session traffic */
+	void OnLockstepReceived(EMatchOpCode OpCode, TArrayView<const uint8> Data);
+
+	/** Buffer, reconcile and broadcast a freshly parsed server state */
+	void ApplyServerState(FWorldStateBuffer& NewState, double ReceiveTime);
 
 	/** Update RTT estimate based on poll round-trip */
 	void UpdateRTTEstimate(double SendTime, double ReceiveTime);
+
+	/** Advance the render clock by DeltaTime, slewing it toward the server-aligned target */
+	void AdvanceInterpolationTime(float DeltaTime);
+
+	/** Leader only: start a session from the latest snapshot if the party qualifies */
+	void TryStartLockstep();
+
+	/** Enter the session LockstepSim was just seeded for */
+	void BeginLockstepSession(uint32 Session, int64 LeaderId, int32 InputDelay, int32 HashInterval,
+		int64 BaseTick, double StartTime);
+
+	/** Back to streaming; the next poll asks for a full snapshot */
+	void StopLockstep(const TCHAR* Reason, bool bNotifyParty);
+
+	/** Step every tick whose inputs have all arrived, up to the time accumulated */
+	void AdvanceLockstep(float DeltaTime);
+
+	/** Fill LockstepStepInputs for Tick; false while a peer's input is missing */
+	bool GatherLockstepInputs(int64 Tick);
+
+	/** Buffer the sim's state as the newest snapshot and exchange its hash on hash ticks */
+	void PublishLockstepState();
+
+	/** Decode one Lockstep op payload (layout documented in the .cpp) */
+	void OnLockstepMessage(TArrayView<const uint8> Data);
+
+	/** Compare a peer's hash with ours; a mismatch ends the session */
+	void CheckLockstepHash(int64 Tick, uint32 Hash);
+
+	/** Start a Lockstep payload in LockstepSendBuffer */
+	FBincodeWriter BeginLockstepMessage(uint8 Type);
+	void SendLockstepMessage();
+
+	/** ComputeEntityStateHash over every entity, in EntityId order */
+	uint32 ComputeWorldStateHash(const FWorldStateBuffer& State) const;
 };
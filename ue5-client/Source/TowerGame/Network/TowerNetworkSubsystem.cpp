@@ -1,43 +1,288 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TowerNetworkSubsystem.h"
+#include "Core/StartupTimeline.h"
 #include "ReplicationManager.h"
+#include "MatchConnection.h"
+#include "NetReplayDriver.h"
+#include "NetBotSwarm.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Engine/GameInstance.h"
+#include "Stats/Stats.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/Paths.h"
+
+// 'stat TowerNet': totals plus in/out bandwidth and decode cost per message type.
+// Values are published once a second from TickNetStats, so they are accumulators
+// (kept between frames) rather than per-frame counters.
+DECLARE_STATS_GROUP(TEXT("TowerNet"), STATGROUP_TowerNet, STATCAT_Advanced);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Total In (KB/s)"), STAT_TowerNet_KBInPerSec, STATGROUP_TowerNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Total Out (KB/s)"), STAT_TowerNet_KBOutPerSec, STATGROUP_TowerNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Snapshot Loss (%)"), STAT_TowerNet_LossPercent, STATGROUP_TowerNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Snapshot Reorder (%)"), STAT_TowerNet_ReorderPercent, STATGROUP_TowerNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Snapshot Jitter (ms)"), STAT_TowerNet_JitterMs, STATGROUP_TowerNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Snapshot Buffer Depth"), STAT_TowerNet_BufferDepth, STATGROUP_TowerNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pool Drops"), STAT_TowerNet_PoolDrops, STATGROUP_TowerNet);
+
+#define TOWER_NET_CHANNEL_STATS(Name) \
+    DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT(#Name " In (B/s)"), STAT_TowerNet_##Name##_In, STATGROUP_TowerNet); \
+    DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT(#Name " Out (B/s)"), STAT_TowerNet_##Name##_Out, STATGROUP_TowerNet); \
+    DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT(#Name " Decode (us)"), STAT_TowerNet_##Name##_Decode, STATGROUP_TowerNet);
+
+#define TOWER_NET_CHANNELS(X) \
+    X(Keepalive) X(PlayerUpdate) X(MonsterUpdate) X(FloorTileUpdate) X(PlayerSpawn) X(PlayerDespawn) \
+    X(Action) X(Interest) X(WorldSnapshot) X(Lockstep) X(MatchData) X(ServiceCall) X(Unknown)
+
+TOWER_NET_CHANNELS(TOWER_NET_CHANNEL_STATS)
+
+namespace
+{
+    void PublishChannelStats(const FNetChannelStats& Stats)
+    {
+#define TOWER_NET_SET_CHANNEL_STATS(Name) \
+        case ETowerNetChannel::Name: \
+            SET_FLOAT_STAT(STAT_TowerNet_##Name##_In, Stats.BytesInPerSec); \
+            SET_FLOAT_STAT(STAT_TowerNet_##Name##_Out, Stats.BytesOutPerSec); \
+            SET_FLOAT_STAT(STAT_TowerNet_##Name##_Decode, Stats.AvgDecodeMicros); \
+            break;
+
+        switch (Stats.Channel)
+        {
+            TOWER_NET_CHANNELS(TOWER_NET_SET_CHANNEL_STATS)
+            default: break;
+        }
+
+#undef TOWER_NET_SET_CHANNEL_STATS
+    }
+}
+
+#undef TOWER_NET_CHANNEL_STATS
+#undef TOWER_NET_CHANNELS
+
+namespace
+{
+    UTowerNetworkSubsystem* GetSubsystemForCommand(UWorld* World)
+    {
+        UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+        return GameInstance ? GameInstance->GetSubsystem<UTowerNetworkSubsystem>() : nullptr;
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs CmdNetCapture(
+        TEXT("tower.NetCapture"),
+        TEXT("tower.NetCapture start [file] | stop - record inbound network traffic for tower.NetReplay"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UTowerNetworkSubsystem* Subsystem = GetSubsystemForCommand(World);
+            if (!Subsystem)
+            {
+                return;
+            }
+
+            if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+            {
+                Subsystem->StopNetCapture();
+            }
+            else
+            {
+                Subsystem->StartNetCapture(Args.Num() > 1 ? Args[1] : FString());
+            }
+        }));
+
+    TAutoConsoleVariable<FString> CVarPingServers(
+        TEXT("tower.Ping.Servers"),
+        TEXT("127.0.0.1:5000"),
+        TEXT("Comma separated host:port game servers ConnectToBestServer probes and picks from"),
+        ECVF_Default);
+
+    TAutoConsoleVariable<float> CVarPingLoadPenaltyMs(
+        TEXT("tower.Ping.LoadPenaltyMs"),
+        50.0f,
+        TEXT("Milliseconds a full server counts as further away when ranking servers and matches"),
+        ECVF_Default);
+
+    TAutoConsoleVariable<float> CVarPingRefreshSeconds(
+        TEXT("tower.Ping.RefreshSeconds"),
+        5.0f,
+        TEXT("How often the connected server is probed again for GetPing; 0 = never"),
+        ECVF_Default);
+
+    FAutoConsoleCommandWithWorldAndArgs CmdPing(
+        TEXT("tower.Ping"),
+        TEXT("tower.Ping [host:port ...] - probe game servers (default tower.Ping.Servers) and log RTT and load"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UTowerNetworkSubsystem* Subsystem = GetSubsystemForCommand(World);
+            if (!Subsystem)
+            {
+                return;
+            }
+
+            TArray<FString> Endpoints = Args;
+            if (Endpoints.Num() == 0)
+            {
+                CVarPingServers.GetValueOnGameThread().ParseIntoArray(Endpoints, TEXT(","));
+            }
+            TWeakObjectPtr<UTowerNetworkSubsystem> WeakSubsystem(Subsystem);
+            Subsystem->ProbeServersThen(Endpoints, [WeakSubsystem, Endpoints]()
+            {
+                if (!WeakSubsystem.IsValid())
+                {
+                    return;
+                }
+                for (const FString& Endpoint : Endpoints)
+                {
+                    const FTowerPingResult* Result = WeakSubsystem->GetPingProber().Find(Endpoint);
+                    UE_LOG(LogTemp, Display, TEXT("Ping %s: %s"), *Endpoint, Result && Result->IsReachable()
+                        ? *FString::Printf(TEXT("%.1f ms, %d/%d players, %d/%d replies"), Result->RttMs,
+                            Result->Players, Result->MaxPlayers, Result->Received, Result->Sent)
+                        : TEXT("unreachable"));
+                }
+            }, true);
+        }));
+
+    TAutoConsoleVariable<int32> CVarReplayRecordBossFights(
+        TEXT("tower.Replay.RecordBossFights"),
+        1,
+        TEXT("Start the replay recorder when a boss room is entered, and mark every attempt"),
+        ECVF_Default);
+
+    FAutoConsoleCommandWithWorldAndArgs CmdReplayRecord(
+        TEXT("tower.ReplayRecord"),
+        TEXT("tower.ReplayRecord start [file] | stop | export [file] [all] - record snapshots and input to a replay ring"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UTowerNetworkSubsystem* Subsystem = GetSubsystemForCommand(World);
+            if (!Subsystem)
+            {
+                return;
+            }
+
+            const FString Verb = Args.Num() > 0 ? Args[0] : FString(TEXT("start"));
+            if (Verb == TEXT("stop"))
+            {
+                Subsystem->StopReplayRecording();
+            }
+            else if (Verb == TEXT("export"))
+            {
+                const bool bAll = Args.Contains(TEXT("all"));
+                const FString Path = Args.Num() > 1 && Args[1] != TEXT("all") ? Args[1] : FString();
+                Subsystem->ExportReplay(Path, !bAll);
+            }
+            else
+            {
+                Subsystem->StartReplayRecording(Args.Num() > 1 ? Args[1] : FString());
+            }
+        }));
+
+    FAutoConsoleCommandWithWorldAndArgs CmdNetReplay(
+        TEXT("tower.NetReplay"),
+        TEXT("tower.NetReplay <file> [speed|max] [quit] - replay a capture and report decode time per packet type"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UTowerNetworkSubsystem* Subsystem = GetSubsystemForCommand(World);
+            if (!Subsystem || Args.Num() == 0)
+            {
+                return;
+            }
+
+            float Speed = 1.0f;
+            bool bQuit = false;
+            for (int32 i = 1; i < Args.Num(); ++i)
+            {
+                if (Args[i] == TEXT("max"))
+                {
+                    Speed = 0.0f;
+                }
+                else if (Args[i] == TEXT("quit"))
+                {
+                    bQuit = true;
+                }
+                else
+                {
+                    Speed = FCString::Atof(*Args[i]);
+                }
+            }
+
+            Subsystem->StartNetReplay(Args[0], Speed, bQuit);
+        }));
+
+    FAutoConsoleCommandWithWorldAndArgs CmdNetBots(
+        TEXT("tower.NetBots"),
+        TEXT("tower.NetBots <count> [ip] [port] [seconds] [quit] | stop - load the server with scripted headless clients"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+        {
+            UTowerNetworkSubsystem* Subsystem = GetSubsystemForCommand(World);
+            if (!Subsystem || Args.Num() == 0)
+            {
+                return;
+            }
+
+            if (Args[0] == TEXT("stop"))
+            {
+                Subsystem->StopNetBots();
+                return;
+            }
+
+            TArray<FString> Positional;
+            bool bQuit = false;
+            for (int32 i = 1; i < Args.Num(); ++i)
+            {
+                if (Args[i] == TEXT("quit"))
+                {
+                    bQuit = true;
+                }
+                else
+                {
+                    Positional.Add(Args[i]);
+                }
+            }
+
+            Subsystem->StartNetBots(FCString::Atoi(*Args[0]),
+                Positional.Num() > 0 ? Positional[0] : FString(TEXT("127.0.0.1")),
+                Positional.Num() > 1 ? FCString::Atoi(*Positional[1]) : 5000,
+                Positional.Num() > 2 ? FCString::Atof(*Positional[2]) : 60.0f,
+                bQuit);
+        }));
+}
 
 void UTowerNetworkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+    TOWER_STARTUP_SCOPE(TowerNetworkSubsystem);
     Super::Initialize(Collection);
 
     UE_LOG(LogTemp, Log, TEXT("TowerNetworkSubsystem: Initialized"));
 
+    NetStats.Reset();
+    StatsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UTowerNetworkSubsystem::TickNetStats), 1.0f);
+
     bIsConnected = false;
     LastPlayerCount = 0;
     LastPingTime = 0.0f;
     ClientId = 0;
 
-    // Start tick timer (check network status every second)
-    if (UWorld* World = GetWorld())
-    {
-        World->GetTimerManager().SetTimer(
-            TickTimerHandle,
-            this,
-            &UTowerNetworkSubsystem::TickSubsystem,
-            1.0f, // Every 1 second
-            true  // Loop
-        );
-    }
+    // A game instance has no world yet here, so the clock ticks without one
+    NetClock = MakeUnique<FTowerNetClock>();
+    MonitorStepHandle = NetClock->OnStep(ETowerNetPhase::Apply).AddUObject(this, &UTowerNetworkSubsystem::TickSubsystem);
 }
 
 void UTowerNetworkSubsystem::Deinitialize()
 {
     DisconnectFromServer();
 
-    if (UWorld* World = GetWorld())
-    {
-        World->GetTimerManager().ClearTimer(TickTimerHandle);
-    }
+    StopNetReplay();
+    StopNetBots();
+    StopNetCapture();
+    StopReplayRecording();
+    FTSTicker::GetCoreTicker().RemoveTicker(StatsTickerHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(PingTickerHandle);
+    ProbeCallbacks.Reset();
+
+    NetClock->OnStep(ETowerNetPhase::Apply).Remove(MonitorStepHandle);
+    NetClock.Reset();
 
     Super::Deinitialize();
 
@@ -80,6 +325,7 @@ bool UTowerNetworkSubsystem::ConnectToServer(const FString& InServerIP, int32 Po
         // Bind events
         ReplicationManager->OnPlayerSpawned.AddDynamic(this, &UTowerNetworkSubsystem::HandlePlayerSpawned);
         ReplicationManager->OnPlayerUpdated.AddDynamic(this, &UTowerNetworkSubsystem::HandlePlayerUpdated);
+        ReplicationManager->OnLinkLost.AddDynamic(this, &UTowerNetworkSubsystem::HandleLinkLost);
     }
 
     // Connect
@@ -95,6 +341,43 @@ bool UTowerNetworkSubsystem::ConnectToServer(const FString& InServerIP, int32 Po
     return true;
 }
 
+void UTowerNetworkSubsystem::ConnectToBestServer()
+{
+    TArray<FString> Candidates;
+    CVarPingServers.GetValueOnGameThread().ParseIntoArray(Candidates, TEXT(","));
+    for (FString& Candidate : Candidates)
+    {
+        Candidate.TrimStartAndEndInline();
+    }
+    if (Candidates.Num() == 0)
+    {
+        ConnectToServer();
+        return;
+    }
+
+    TWeakObjectPtr<UTowerNetworkSubsystem> WeakThis(this);
+    ProbeServersThen(Candidates, [WeakThis, Candidates]()
+    {
+        UTowerNetworkSubsystem* This = WeakThis.Get();
+        if (!This || This->bIsConnected)
+        {
+            return;
+        }
+
+        FString Best = This->PickBestServer(Candidates);
+        if (Best.IsEmpty())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("TowerNetworkSubsystem: No game server answered probes, trying %s"), *Candidates[0]);
+            Best = Candidates[0];
+        }
+
+        FString Host = Best;
+        FString PortString;
+        Best.Split(TEXT(":"), &Host, &PortString, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+        This->ConnectToServer(Host, PortString.IsEmpty() ? 5000 : FCString::Atoi(*PortString));
+    });
+}
+
 void UTowerNetworkSubsystem::DisconnectFromServer()
 {
     if (!bIsConnected)
@@ -114,6 +397,7 @@ void UTowerNetworkSubsystem::DisconnectFromServer()
     bIsConnected = false;
     ClientId = 0;
     LastPlayerCount = 0;
+    LastPingTime = 0.0f;
 
     OnDisconnected.Broadcast();
 }
@@ -135,6 +419,11 @@ FString UTowerNetworkSubsystem::GetConnectionStatus() const
         return TEXT("Error: No ReplicationManager");
     }
 
+    if (ReplicationManager->IsResuming())
+    {
+        return TEXT("Resuming...");
+    }
+
     if (!ReplicationManager->IsConnected())
     {
         return TEXT("Connecting...");
@@ -144,6 +433,18 @@ FString UTowerNetworkSubsystem::GetConnectionStatus() const
         *ServerIP, ServerPort, ClientId);
 }
 
+FReplicatedEntityRegistry* UTowerNetworkSubsystem::FindEntityRegistry(const UObject* WorldContextObject)
+{
+    UTowerNetworkSubsystem* Subsystem = UNetworkBlueprintLibrary::GetTowerNetworkSubsystem(WorldContextObject);
+    return Subsystem ? &Subsystem->GetEntityRegistry() : nullptr;
+}
+
+FTowerNetClock* UTowerNetworkSubsystem::FindNetClock(const UObject* WorldContextObject)
+{
+    UTowerNetworkSubsystem* Subsystem = UNetworkBlueprintLibrary::GetTowerNetworkSubsystem(WorldContextObject);
+    return Subsystem ? Subsystem->GetNetClock() : nullptr;
+}
+
 int64 UTowerNetworkSubsystem::GetClientId() const
 {
     return ClientId;
@@ -156,7 +457,7 @@ int32 UTowerNetworkSubsystem::GetPlayerCount() const
         return 0;
     }
 
-    return ReplicationManager->ReplicatedPlayers.Num();
+    return ReplicationManager->GetReplicatedActorCount(EReplicatedEntityKind::Player);
 }
 
 int32 UTowerNetworkSubsystem::GetMonsterCount() const
@@ -166,16 +467,94 @@ int32 UTowerNetworkSubsystem::GetMonsterCount() const
         return 0;
     }
 
-    return ReplicationManager->ReplicatedMonsters.Num();
+    return ReplicationManager->GetReplicatedActorCount(EReplicatedEntityKind::Monster);
 }
 
 float UTowerNetworkSubsystem::GetPing() const
 {
-    // TODO: Implement actual ping measurement
     return LastPingTime;
 }
 
-void UTowerNetworkSubsystem::TickSubsystem()
+void UTowerNetworkSubsystem::ProbeServers(const TArray<FString>& Endpoints, bool bForce)
+{
+    ProbeServersThen(Endpoints, nullptr, bForce);
+}
+
+void UTowerNetworkSubsystem::ProbeServersThen(const TArray<FString>& Endpoints, TFunction<void()> OnComplete, bool bForce)
+{
+    if (!PingProber.Probe(Endpoints, bForce) && !PingProber.IsProbing())
+    {
+        // All cached (or nothing could be sent): the results are as good as they will get
+        if (OnComplete)
+        {
+            OnComplete();
+        }
+        OnServerProbesComplete.Broadcast();
+        return;
+    }
+
+    // Callbacks wait for the whole round, including endpoints an earlier call is still probing
+    if (OnComplete)
+    {
+        ProbeCallbacks.Add(MoveTemp(OnComplete));
+    }
+    EnsurePingTicker();
+}
+
+float UTowerNetworkSubsystem::GetServerRtt(const FString& Endpoint) const
+{
+    const FTowerPingResult* Result = PingProber.Find(Endpoint);
+    return Result && Result->IsReachable() ? Result->RttMs : -1.0f;
+}
+
+float UTowerNetworkSubsystem::GetServerScore(const FString& Endpoint) const
+{
+    return PingProber.Score(Endpoint, CVarPingLoadPenaltyMs.GetValueOnGameThread());
+}
+
+FString UTowerNetworkSubsystem::PickBestServer(const TArray<FString>& Endpoints) const
+{
+    return PingProber.PickBest(Endpoints, CVarPingLoadPenaltyMs.GetValueOnGameThread());
+}
+
+void UTowerNetworkSubsystem::EnsurePingTicker()
+{
+    if (!PingTickerHandle.IsValid())
+    {
+        // Every frame while probes are out, so the measured RTT isn't rounded up to a timer period
+        PingTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &UTowerNetworkSubsystem::TickPingProbes));
+    }
+}
+
+bool UTowerNetworkSubsystem::TickPingProbes(float DeltaTime)
+{
+    PingProber.Tick();
+    if (PingProber.IsProbing())
+    {
+        return true;
+    }
+
+    if (bIsConnected)
+    {
+        const float Rtt = GetServerRtt(FTowerPingProber::MakeEndpoint(ServerIP, ServerPort));
+        if (Rtt >= 0.0f)
+        {
+            LastPingTime = Rtt;
+        }
+    }
+
+    PingTickerHandle.Reset();
+    TArray<TFunction<void()>> Callbacks = MoveTemp(ProbeCallbacks);
+    for (TFunction<void()>& Callback : Callbacks)
+    {
+        Callback();
+    }
+    OnServerProbesComplete.Broadcast();
+    return false;
+}
+
+void UTowerNetworkSubsystem::TickSubsystem(float StepSeconds)
 {
     if (!bIsConnected || !ReplicationManager)
     {
@@ -189,9 +568,199 @@ void UTowerNetworkSubsystem::TickSubsystem()
         OnPlayerCountChanged.Broadcast(CurrentPlayerCount);
         LastPlayerCount = CurrentPlayerCount;
     }
+}
 
-    // Update ping (placeholder)
-    LastPingTime = 25.0f; // TODO: Real ping measurement
+FNetworkStats UTowerNetworkSubsystem::GetNetworkStats() const
+{
+    FNetworkStats Stats;
+    Stats.bConnected = IsConnected();
+    Stats.ClientId = ClientId;
+    Stats.PlayerCount = GetPlayerCount();
+    Stats.MonsterCount = GetMonsterCount();
+    Stats.Ping = GetPing();
+    Stats.ServerAddress = FString::Printf(TEXT("%s:%d"), *ServerIP, ServerPort);
+
+    NetStats.GetActiveChannels(Stats.Channels);
+    for (const FNetChannelStats& Channel : Stats.Channels)
+    {
+        Stats.PacketsReceived += Channel.TotalPacketsIn;
+        Stats.BytesReceived += Channel.TotalBytesIn;
+    }
+
+    Stats.BytesInPerSec = NetStats.GetBytesInPerSec();
+    Stats.BytesOutPerSec = NetStats.GetBytesOutPerSec();
+    Stats.SnapshotLossPercent = NetStats.GetSnapshotSequence().GetLossPercent();
+    Stats.SnapshotReorderPercent = NetStats.GetSnapshotSequence().GetReorderPercent();
+    Stats.JitterMs = static_cast<float>(NetStats.GetSnapshotJitterMs());
+    Stats.SnapshotBufferDepth = NetStats.GetSnapshotBufferDepth();
+    Stats.SnapshotBufferCapacity = NetStats.GetSnapshotBufferCapacity();
+    Stats.CompressionRatio = NetStats.GetCompressionRatio();
+
+    if (ReplicationManager && ReplicationManager->GetNetcodeClient())
+    {
+        Stats.PacketsDropped = ReplicationManager->GetNetcodeClient()->GetDroppedPacketCount();
+    }
+
+    return Stats;
+}
+
+void UTowerNetworkSubsystem::ResetNetworkStats()
+{
+    NetStats.Reset();
+}
+
+FTowerNetStatsCollector* UTowerNetworkSubsystem::FindNetStats(const UObject* WorldContextObject)
+{
+    UTowerNetworkSubsystem* Subsystem = UNetworkBlueprintLibrary::GetTowerNetworkSubsystem(WorldContextObject);
+    return Subsystem ? &Subsystem->GetNetStats() : nullptr;
+}
+
+bool UTowerNetworkSubsystem::StartNetCapture(const FString& Path)
+{
+    const FString CapturePath = !Path.IsEmpty() ? Path
+        : FPaths::ProjectSavedDir() / TEXT("NetCaptures") / FDateTime::Now().ToString() + TEXT(".tncap");
+
+    return NetCapture.Open(CapturePath);
+}
+
+void UTowerNetworkSubsystem::StopNetCapture()
+{
+    NetCapture.Close();
+}
+
+bool UTowerNetworkSubsystem::StartReplayRecording(const FString& Path, int64 Seed, int32 FloorId)
+{
+    const FString RingPath = !Path.IsEmpty() ? Path
+        : FPaths::ProjectSavedDir() / TEXT("Replays") / TEXT("Recording.trring");
+
+    return ReplayRecorder.Start(RingPath, static_cast<uint64>(Seed), FloorId);
+}
+
+void UTowerNetworkSubsystem::StopReplayRecording()
+{
+    ReplayRecorder.Stop();
+}
+
+void UTowerNetworkSubsystem::MarkReplay(const FString& Label)
+{
+    ReplayRecorder.RecordMarker(Label);
+}
+
+void UTowerNetworkSubsystem::NoteBossAttempt(int64 Seed, int32 FloorId)
+{
+    if (!ReplayRecorder.IsRecording() && CVarReplayRecordBossFights.GetValueOnGameThread() != 0)
+    {
+        StartReplayRecording(FString(), Seed, FloorId);
+    }
+    MarkReplay(FString::Printf(TEXT("Boss floor %d"), FloorId));
+}
+
+FString UTowerNetworkSubsystem::ExportReplay(const FString& Path, bool bFromLastMark)
+{
+    // The ring is complete once the writer has flushed its last chunk and closed it
+    const FString RingPath = ReplayRecorder.GetPath();
+    StopReplayRecording();
+    if (RingPath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TowerNetworkSubsystem: nothing recorded to export"));
+        return FString();
+    }
+
+    const FString OutPath = !Path.IsEmpty() ? Path
+        : FPaths::ProjectSavedDir() / TEXT("Replays") / FDateTime::Now().ToString() + TEXT(".trpl");
+    return FTowerReplayRecorder::ExportContainer(RingPath, OutPath, bFromLastMark) ? OutPath : FString();
+}
+
+FTowerReplayRecorder* UTowerNetworkSubsystem::FindReplayRecorder(const UObject* WorldContextObject)
+{
+    UTowerNetworkSubsystem* Subsystem = UNetworkBlueprintLibrary::GetTowerNetworkSubsystem(WorldContextObject);
+    return Subsystem ? &Subsystem->ReplayRecorder : nullptr;
+}
+
+bool UTowerNetworkSubsystem::StartNetReplay(const FString& Path, float Speed, bool bQuitWhenDone)
+{
+    if (NetCapture.IsOpen())
+    {
+        // The replayed payloads would be captured again
+        UE_LOG(LogTemp, Warning, TEXT("TowerNetworkSubsystem: stop the capture before replaying"));
+        return false;
+    }
+
+    StopNetReplay();
+
+    TSharedPtr<FNetReplayDriver> Driver = MakeShared<FNetReplayDriver>(GetWorld(), GetGameInstance()->GetSubsystem<UMatchConnection>());
+    if (!Driver->Open(Path))
+    {
+        return false;
+    }
+
+    ReplayDriver = Driver;
+    bQuitAfterReplay = bQuitWhenDone;
+    ReplayDriver->Start(Speed);
+
+    // Every frame, so recorded timing is honoured to within a frame
+    ReplayTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UTowerNetworkSubsystem::TickNetReplay));
+    return true;
+}
+
+void UTowerNetworkSubsystem::StopNetReplay()
+{
+    if (!ReplayDriver.IsValid())
+    {
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(ReplayTickerHandle);
+    ReplayDriver.Reset();
+}
+
+bool UTowerNetworkSubsystem::TickNetReplay(float DeltaTime)
+{
+    if (!ReplayDriver.IsValid() || ReplayDriver->Tick())
+    {
+        return ReplayDriver.IsValid();
+    }
+
+    ReplayDriver->LogReport(*GLog);
+    ReplayDriver.Reset();
+
+    if (bQuitAfterReplay)
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+    return false;
+}
+
+bool UTowerNetworkSubsystem::TickNetStats(float DeltaTime)
+{
+    NetStats.RollWindow(FPlatformTime::Seconds());
+
+    for (int32 i = 0; i < static_cast<int32>(ETowerNetChannel::MAX); ++i)
+    {
+        PublishChannelStats(NetStats.GetChannel(static_cast<ETowerNetChannel>(i)));
+    }
+
+    const FNetSequenceTracker& Sequence = NetStats.GetSnapshotSequence();
+    SET_FLOAT_STAT(STAT_TowerNet_KBInPerSec, NetStats.GetBytesInPerSec() / 1024.0f);
+    SET_FLOAT_STAT(STAT_TowerNet_KBOutPerSec, NetStats.GetBytesOutPerSec() / 1024.0f);
+    SET_FLOAT_STAT(STAT_TowerNet_LossPercent, Sequence.GetLossPercent());
+    SET_FLOAT_STAT(STAT_TowerNet_ReorderPercent, Sequence.GetReorderPercent());
+    SET_FLOAT_STAT(STAT_TowerNet_JitterMs, static_cast<float>(NetStats.GetSnapshotJitterMs()));
+    SET_DWORD_STAT(STAT_TowerNet_BufferDepth, NetStats.GetSnapshotBufferDepth());
+    SET_DWORD_STAT(STAT_TowerNet_PoolDrops,
+        ReplicationManager && ReplicationManager->GetNetcodeClient() ? ReplicationManager->GetNetcodeClient()->GetDroppedPacketCount() : 0);
+
+    // Keep GetPing current: the connected server's echo, bypassing the selection cache
+    const float RefreshSeconds = CVarPingRefreshSeconds.GetValueOnGameThread();
+    const double Now = FPlatformTime::Seconds();
+    if (bIsConnected && RefreshSeconds > 0.0f && Now - LastPingRefresh >= RefreshSeconds)
+    {
+        LastPingRefresh = Now;
+        ProbeServers({ FTowerPingProber::MakeEndpoint(ServerIP, ServerPort) }, true);
+    }
+
+    return true; // Keep ticking
 }
 
 void UTowerNetworkSubsystem::HandlePlayerSpawned(AActor* PlayerActor)
@@ -204,6 +773,12 @@ void UTowerNetworkSubsystem::HandlePlayerUpdated(AActor* PlayerActor)
     // Silent - happens frequently
 }
 
+void UTowerNetworkSubsystem::HandleLinkLost()
+{
+    UE_LOG(LogTemp, Warning, TEXT("TowerNetworkSubsystem: Connection to %s:%d lost"), *ServerIP, ServerPort);
+    DisconnectFromServer();
+}
+
 // ============================================================================
 // UNetworkBlueprintLibrary
 // ============================================================================
@@ -312,3 +887,56 @@ FString UNetworkBlueprintLibrary::FormatLatency(float Milliseconds)
         return FString::Printf(TEXT("%.1fms (Poor)"), Milliseconds);
     }
 }
+
+bool UTowerNetworkSubsystem::StartNetBots(int32 NumBots, const FString& BotServerIP, int32 Port, float Seconds, bool bQuitWhenDone)
+{
+    StopNetBots();
+
+    FNetBotSwarm::FConfig Config;
+    Config.NumBots = NumBots;
+    Config.ServerIP = BotServerIP;
+    Config.ServerPort = Port;
+    Config.DurationSeconds = Seconds;
+
+    TSharedPtr<FNetBotSwarm> Swarm = MakeShared<FNetBotSwarm>(Config);
+    if (Swarm->Start() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TowerNetworkSubsystem: no bot could connect to %s:%d"), *BotServerIP, Port);
+        return false;
+    }
+
+    BotSwarm = Swarm;
+    bQuitAfterBots = bQuitWhenDone;
+
+    // In the Send phase, at the rate a real client's replication steps
+    BotStepHandle = NetClock->OnStep(ETowerNetPhase::Send).AddUObject(this, &UTowerNetworkSubsystem::TickNetBots);
+    return true;
+}
+
+void UTowerNetworkSubsystem::StopNetBots()
+{
+    if (!BotSwarm.IsValid())
+    {
+        return;
+    }
+
+    NetClock->OnStep(ETowerNetPhase::Send).Remove(BotStepHandle);
+    BotSwarm->LogReport(*GLog);
+    BotSwarm->WriteCsv(TEXT("TowerNetBots.csv"));
+    BotSwarm.Reset();
+}
+
+void UTowerNetworkSubsystem::TickNetBots(float StepSeconds)
+{
+    if (!BotSwarm.IsValid() || BotSwarm->Tick(StepSeconds))
+    {
+        return;
+    }
+
+    StopNetBots();
+
+    if (bQuitAfterBots)
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+}
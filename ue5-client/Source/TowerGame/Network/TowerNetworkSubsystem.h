@@ -4,9 +4,88 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "NetStats.h"
+#include "NetCapture.h"
+#include "ReplayRecorder.h"
+#include "PingProber.h"
+#include "EntityRegistry.h"
+#include "NetClock.h"
 #include "TowerNetworkSubsystem.generated.h"
 
 class AReplicationManager;
+class FNetReplayDriver;
+class FNetBotSwarm;
+
+/**
+ * Struct for Blueprint-friendly network stats display
+ */
+USTRUCT(BlueprintType)
+struct FNetworkStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    bool bConnected = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 ClientId = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 PlayerCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 MonsterCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float Ping = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 PacketsReceived = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int64 BytesReceived = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    FString ServerAddress;
+
+    /** Per message type bandwidth and decode cost, busiest first */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    TArray<FNetChannelStats> Channels;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float BytesInPerSec = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float BytesOutPerSec = 0.0f;
+
+    /** Snapshot ticks that never arrived, from their sequence numbers */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float SnapshotLossPercent = 0.0f;
+
+    /** Snapshots that arrived after a newer one */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float SnapshotReorderPercent = 0.0f;
+
+    /** RFC 3550 interarrival jitter of world snapshots */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float JitterMs = 0.0f;
+
+    /** Snapshots buffered for interpolation */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 SnapshotBufferDepth = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 SnapshotBufferCapacity = 0;
+
+    /** Compressed / raw bytes of every compressed payload received (1 = nothing compressed) */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    float CompressionRatio = 1.0f;
+
+    /** Datagrams the netcode client dropped because its packet pool was full */
+    UPROPERTY(BlueprintReadOnly, Category = "Stats")
+    int32 PacketsDropped = 0;
+};
 
 /**
  * Game Instance Subsystem for network management
@@ -26,6 +105,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Network")
     bool ConnectToServer(const FString& ServerIP = TEXT("127.0.0.1"), int32 Port = 5000);
 
+    /**
+     * Probe the tower.Ping.Servers candidates (cached results are reused) and
+     * connect to the best reachable one by RTT and load; falls back to the first
+     * candidate when none answers.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Network")
+    void ConnectToBestServer();
+
     UFUNCTION(BlueprintCallable, Category = "Network")
     void DisconnectFromServer();
 
@@ -45,9 +132,137 @@ public:
     UFUNCTION(BlueprintPure, Category = "Network")
     int32 GetMonsterCount() const;
 
+    /** RTT to the connected server from its ping echo, refreshed every tower.Ping.RefreshSeconds; 0 before the first reply */
     UFUNCTION(BlueprintPure, Category = "Network")
     float GetPing() const;
 
+    // Server selection: UDP echo probes to "host:port" netcode endpoints, cached for the session
+
+    /** Probe Endpoints in parallel; OnServerProbesComplete fires once replies are in or timed out */
+    UFUNCTION(BlueprintCallable, Category = "Network|Ping")
+    void ProbeServers(const TArray<FString>& Endpoints, bool bForce = false);
+
+    /** As ProbeServers, then OnComplete; runs right away when every endpoint is cached */
+    void ProbeServersThen(const TArray<FString>& Endpoints, TFunction<void()> OnComplete, bool bForce = false);
+
+    /** Best RTT of the last probe round, negative when unknown or unreachable */
+    UFUNCTION(BlueprintPure, Category = "Network|Ping")
+    float GetServerRtt(const FString& Endpoint) const;
+
+    /** RTT plus tower.Ping.LoadPenaltyMs at full load; negative for unreachable or full servers */
+    UFUNCTION(BlueprintPure, Category = "Network|Ping")
+    float GetServerScore(const FString& Endpoint) const;
+
+    /** Lowest scoring reachable endpoint, or empty */
+    UFUNCTION(BlueprintPure, Category = "Network|Ping")
+    FString PickBestServer(const TArray<FString>& Endpoints) const;
+
+    FTowerPingProber& GetPingProber() { return PingProber; }
+
+    DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnServerProbesComplete);
+    UPROPERTY(BlueprintAssignable, Category = "Network|Events")
+    FOnServerProbesComplete OnServerProbesComplete;
+
+    // Instrumentation (also 'stat TowerNet' and the tower.NetOverlay HUD overlay)
+    UFUNCTION(BlueprintPure, Category = "Network|Stats")
+    FNetworkStats GetNetworkStats() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Network|Stats")
+    void ResetNetworkStats();
+
+    /** Collector that the replication, netcode, match and state sync paths record into */
+    FTowerNetStatsCollector& GetNetStats() { return NetStats; }
+
+    /** The collector of the game instance WorldContextObject lives in, if any */
+    static FTowerNetStatsCollector* FindNetStats(const UObject* WorldContextObject);
+
+    /** Every replicated player and monster, shared by replication and state sync */
+    FReplicatedEntityRegistry& GetEntityRegistry() { return EntityRegistry; }
+
+    /** The registry of the game instance WorldContextObject lives in, if any */
+    static FReplicatedEntityRegistry* FindEntityRegistry(const UObject* WorldContextObject);
+
+    /** The fixed-rate clock replication, state sync and bots step on; null before Initialize */
+    FTowerNetClock* GetNetClock() { return NetClock.Get(); }
+
+    /** The network clock of the game instance WorldContextObject lives in, if any */
+    static FTowerNetClock* FindNetClock(const UObject* WorldContextObject);
+
+    // Capture / replay (also tower.NetCapture and tower.NetReplay)
+
+    /** Record every inbound datagram and match payload to Path (default: Saved/NetCaptures/<timestamp>.tncap) */
+    UFUNCTION(BlueprintCallable, Category = "Network|Capture")
+    bool StartNetCapture(const FString& Path = TEXT(""));
+
+    UFUNCTION(BlueprintCallable, Category = "Network|Capture")
+    void StopNetCapture();
+
+    UFUNCTION(BlueprintPure, Category = "Network|Capture")
+    bool IsCapturingNet() const { return NetCapture.IsOpen(); }
+
+    /**
+     * Replay a capture through the replication and state sync decoders and log
+     * per-type decode time when done. Speed <= 0 replays as fast as possible.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Network|Capture")
+    bool StartNetReplay(const FString& Path, float Speed = 1.0f, bool bQuitWhenDone = false);
+
+    UFUNCTION(BlueprintPure, Category = "Network|Capture")
+    bool IsReplayingNet() const { return ReplayDriver.IsValid(); }
+
+    FNetCaptureWriter& GetNetCapture() { return NetCapture; }
+
+    // Replay recording (also tower.ReplayRecord)
+
+    /**
+     * Record buffered snapshots and local input to a replay ring at Path (default:
+     * Saved/Replays/Recording.trring), which keeps the most recent few minutes.
+     * Seed and FloorId go into its header and on to exported replays.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Network|Replay")
+    bool StartReplayRecording(const FString& Path = TEXT(""), int64 Seed = 0, int32 FloorId = 0);
+
+    UFUNCTION(BlueprintCallable, Category = "Network|Replay")
+    void StopReplayRecording();
+
+    UFUNCTION(BlueprintPure, Category = "Network|Replay")
+    bool IsRecordingReplay() const { return ReplayRecorder.IsRecording(); }
+
+    /** Label this point of the recording; no-op when not recording */
+    void MarkReplay(const FString& Label);
+
+    /** A boss attempt is starting: marks the recording, starting one first if tower.Replay.RecordBossFights is set */
+    void NoteBossAttempt(int64 Seed, int32 FloorId);
+
+    /**
+     * Stop recording and write the ring's inputs, from the last mark with bFromLastMark,
+     * as a replay container for UReplayControlWidget::LoadReplayFile. Path defaults to
+     * Saved/Replays/<timestamp>.trpl; returns the path written, empty on failure.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Network|Replay")
+    FString ExportReplay(const FString& Path = TEXT(""), bool bFromLastMark = true);
+
+    /** The recorder of the game instance WorldContextObject lives in, if any */
+    static FTowerReplayRecorder* FindReplayRecorder(const UObject* WorldContextObject);
+
+    // Load testing (also tower.NetBots)
+
+    /**
+     * Connect NumBots scripted headless clients to the server, each on its own
+     * socket, and log their aggregate latency, snapshot rate and corrections
+     * when Seconds is up (<= 0: until StopNetBots). Results are also appended
+     * to Saved/Profiling/TowerNetBots.csv.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Network|LoadTest")
+    bool StartNetBots(int32 NumBots, const FString& BotServerIP = TEXT("127.0.0.1"), int32 Port = 5000,
+        float Seconds = 60.0f, bool bQuitWhenDone = false);
+
+    UFUNCTION(BlueprintCallable, Category = "Network|LoadTest")
+    void StopNetBots();
+
+    UFUNCTION(BlueprintPure, Category = "Network|LoadTest")
+    bool IsRunningNetBots() const { return BotSwarm.IsValid(); }
+
     // Events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnConnected);
     UPROPERTY(BlueprintAssignable, Category = "Network|Events")
@@ -79,13 +294,47 @@ protected:
     int32 LastPlayerCount;
     float LastPingTime;
 
-    // Tick for monitoring
-    void TickSubsystem();
-    FTimerHandle TickTimerHandle;
+    TUniquePtr<FTowerNetClock> NetClock;
+
+    // Connection monitoring, in the clock's Apply phase
+    void TickSubsystem(float StepSeconds);
+    FDelegateHandle MonitorStepHandle;
+
+    // Instrumentation: rolled once a second on the core ticker so it runs without a world
+    FTowerNetStatsCollector NetStats;
+    FTSTicker::FDelegateHandle StatsTickerHandle;
+    bool TickNetStats(float DeltaTime);
+
+    FReplicatedEntityRegistry EntityRegistry;
+
+    FNetCaptureWriter NetCapture;
+    TSharedPtr<FNetReplayDriver> ReplayDriver;
+    FTSTicker::FDelegateHandle ReplayTickerHandle;
+    bool bQuitAfterReplay = false;
+    bool TickNetReplay(float DeltaTime);
+    void StopNetReplay();
+
+    TSharedPtr<FNetBotSwarm> BotSwarm;
+    FDelegateHandle BotStepHandle;
+
+    FTowerReplayRecorder ReplayRecorder;
+
+    FTowerPingProber PingProber;
+    FTSTicker::FDelegateHandle PingTickerHandle;
+    TArray<TFunction<void()>> ProbeCallbacks;
+    double LastPingRefresh = 0.0;
+    bool TickPingProbes(float DeltaTime);
+    void EnsurePingTicker();
+    bool bQuitAfterBots = false;
+    void TickNetBots(float StepSeconds);
 
 private:
     void HandlePlayerSpawned(AActor* PlayerActor);
     void HandlePlayerUpdated(AActor* PlayerActor);
+
+    /** The replication link didn't come back within its resume grace */
+    UFUNCTION()
+    void HandleLinkLost();
 };
 
 /**
@@ -125,36 +374,3 @@ public:
     UFUNCTION(BlueprintPure, Category = "Network|Debug")
     static FString FormatLatency(float Milliseconds);
 };
-
-/**
- * Struct for Blueprint-friendly network stats display
- */
-USTRUCT(BlueprintType)
-struct FNetworkStats
-{
-    GENERATED_BODY()
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    bool bConnected = false;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    int64 ClientId = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    int32 PlayerCount = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    int32 MonsterCount = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    float Ping = 0.0f;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    int32 PacketsReceived = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    int64 BytesReceived = 0;
-
-    UPROPERTY(BlueprintReadOnly, Category = "Stats")
-    FString ServerAddress;
-};
@@ -1,36 +1,81 @@
 #include "TowerAnimInstance.h"
 #include "TowerPlayerCharacter.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void FTowerAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+    FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+    // Game thread: copy what the update needs, nothing else touches the character
+    const UTowerAnimInstance* Instance = CastChecked<UTowerAnimInstance>(InAnimInstance);
+    const ACharacter* Character = Instance->OwnerCharacter;
+    const UCharacterMovementComponent* Movement = Character ? Character->GetCharacterMovement() : nullptr;
+
+    bHasCharacter = Movement != nullptr;
+    if (bHasCharacter)
+    {
+        Velocity = Character->GetVelocity();
+        ActorRotation = Character->GetActorRotation();
+        bIsFalling = Movement->IsFalling();
+    }
+
+    const ATowerPlayerCharacter* TowerCharacter = Instance->OwnerTowerCharacter;
+    bHasCombatState = TowerCharacter != nullptr;
+    if (bHasCombatState)
+    {
+        bIsAttacking = TowerCharacter->bIsAttacking;
+        ComboStep = TowerCharacter->ComboStep;
+        bIsDodging = TowerCharacter->bIsDodging;
+        bIsParrying = TowerCharacter->bIsParrying;
+        CurrentHp = TowerCharacter->CurrentHp;
+        MaxHp = TowerCharacter->MaxHp;
+    }
+}
+
+FAnimInstanceProxy* UTowerAnimInstance::CreateAnimInstanceProxy()
+{
+    return new FTowerAnimInstanceProxy(this);
+}
+
+void UTowerAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+    delete InProxy;
+}
 
 void UTowerAnimInstance::NativeInitializeAnimation()
 {
     Super::NativeInitializeAnimation();
 
-    OwnerCharacter = Cast<ATowerPlayerCharacter>(TryGetPawnOwner());
+    OwnerCharacter = Cast<ACharacter>(TryGetPawnOwner());
+    OwnerTowerCharacter = Cast<ATowerPlayerCharacter>(OwnerCharacter);
+
+    // URO goes by screen size, so characters near the camera (the local player) still update every frame
+    if (USkeletalMeshComponent* Mesh = GetSkelMeshComponent())
+    {
+        Mesh->bEnableUpdateRateOptimizations = bUseUpdateRateOptimizations;
+    }
 }
 
-void UTowerAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+void UTowerAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
 {
-    Super::NativeUpdateAnimation(DeltaSeconds);
-
-    if (!OwnerCharacter) return;
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
-    UCharacterMovementComponent* Movement = OwnerCharacter->GetCharacterMovement();
-    if (!Movement) return;
+    const FTowerAnimInstanceProxy& Proxy = GetProxyOnAnyThread<FTowerAnimInstanceProxy>();
+    if (!Proxy.bHasCharacter) return;
 
     // Movement
-    FVector Velocity = OwnerCharacter->GetVelocity();
+    const FVector& Velocity = Proxy.Velocity;
     Speed = Velocity.Size2D();
     VerticalVelocity = Velocity.Z;
-    bIsInAir = Movement->IsFalling();
+    bIsInAir = Proxy.bIsFalling;
     bIsFalling = bIsInAir && VerticalVelocity < -100.0f;
 
     // Direction relative to actor facing (for strafe blending)
     if (Speed > 10.0f)
     {
-        FRotator ActorRot = OwnerCharacter->GetActorRotation();
         FRotator VelocityRot = Velocity.Rotation();
-        FRotator Delta = (VelocityRot - ActorRot).GetNormalized();
+        FRotator Delta = (VelocityRot - Proxy.ActorRotation).GetNormalized();
         Direction = Delta.Yaw;
     }
     else
@@ -38,16 +83,20 @@ void UTowerAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
         Direction = 0.0f;
     }
 
-    // Combat state from character
-    bIsAttacking = OwnerCharacter->bIsAttacking;
-    ComboStep = OwnerCharacter->ComboStep;
-    bIsDodging = OwnerCharacter->bIsDodging;
+    if (Proxy.bHasCombatState)
+    {
+        // Combat state from character
+        bIsAttacking = Proxy.bIsAttacking;
+        ComboStep = Proxy.ComboStep;
+        bIsDodging = Proxy.bIsDodging;
+        bIsParrying = Proxy.bIsParrying;
 
-    // Health
-    HealthPercent = (OwnerCharacter->MaxHp > 0.0f)
-        ? OwnerCharacter->CurrentHp / OwnerCharacter->MaxHp
-        : 0.0f;
-    bIsDead = OwnerCharacter->CurrentHp <= 0.0f;
+        // Health
+        HealthPercent = (Proxy.MaxHp > 0.0f)
+            ? Proxy.CurrentHp / Proxy.MaxHp
+            : 0.0f;
+        bIsDead = Proxy.CurrentHp <= 0.0f;
+    }
 
     // Hurt flash timer
     if (HurtTimer > 0.0f)
@@ -2,15 +2,55 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
 #include "TowerAnimInstance.generated.h"
 
+class ACharacter;
+class ATowerPlayerCharacter;
+
+/**
+ * Game-thread snapshot of what UTowerAnimInstance animates from. PreUpdate
+ * copies it off the character before the parallel update starts; everything
+ * after that reads only this.
+ */
+USTRUCT()
+struct FTowerAnimInstanceProxy : public FAnimInstanceProxy
+{
+    GENERATED_BODY()
+
+    FTowerAnimInstanceProxy() = default;
+    explicit FTowerAnimInstanceProxy(UAnimInstance* Instance) : FAnimInstanceProxy(Instance) {}
+
+    virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+    FVector Velocity = FVector::ZeroVector;
+    FRotator ActorRotation = FRotator::ZeroRotator;
+    bool bHasCharacter = false;
+    bool bIsFalling = false;
+
+    bool bHasCombatState = false;
+    bool bIsAttacking = false;
+    int32 ComboStep = 0;
+    bool bIsDodging = false;
+    bool bIsParrying = false;
+    float CurrentHp = 0.0f;
+    float MaxHp = 0.0f;
+};
+
 /**
  * Animation instance for Tower Player Character.
  *
  * Drives the Animation Blueprint state machine with gameplay values.
  * States: Idle, Walk, Run, Jump, Fall, Attack (1-5), Dodge, Block, Parry, Death.
  *
- * Connects to ATowerPlayerCharacter for combat state and resources.
+ * Connects to ATowerPlayerCharacter for combat state and resources; other
+ * characters (remote players, monsters) get the movement values only.
+ *
+ * The update runs in NativeThreadSafeUpdateAnimation on an animation worker,
+ * from the FTowerAnimInstanceProxy snapshot taken on the game thread, so the
+ * game thread only pays for the copy. With bUseUpdateRateOptimizations the
+ * owning mesh also skips updates by screen size (URO), so a distant horde
+ * animates at a fraction of the rate.
  */
 UCLASS()
 class TOWERGAME_API UTowerAnimInstance : public UAnimInstance
@@ -19,7 +59,11 @@ class TOWERGAME_API UTowerAnimInstance : public UAnimInstance
 
 public:
     virtual void NativeInitializeAnimation() override;
-    virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+    virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+    /** Turn on the owning mesh's update rate optimizations (skip updates when small on screen) */
+    UPROPERTY(EditDefaultsOnly, Category = "Animation|Performance")
+    bool bUseUpdateRateOptimizations = true;
 
     // ============ Movement ============
 
@@ -79,7 +123,17 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Animation|Weapon")
     float AttackSpeedMultiplier = 1.0f;
 
+protected:
+    virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+    virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
 private:
+    friend struct FTowerAnimInstanceProxy;
+
+    UPROPERTY()
+    ACharacter* OwnerCharacter;
+
+    /** OwnerCharacter when it is the player character; null for everyone else */
     UPROPERTY()
-    class ATowerPlayerCharacter* OwnerCharacter;
+    ATowerPlayerCharacter* OwnerTowerCharacter;
 };
@@ -0,0 +1,40 @@
+#include "TowerInputBuffer.h"
+
+void FTowerInputBuffer::Push(ETowerBufferedAction Action, double Time, double PlatformTime)
+{
+    if (Count == Capacity)
+    {
+        PopOldest();
+    }
+
+    FTowerBufferedInput& Entry = Entries[(Head + Count) % Capacity];
+    Entry.Action = Action;
+    Entry.Time = Time;
+    Entry.PlatformTime = PlatformTime;
+    Count++;
+}
+
+const FTowerBufferedInput* FTowerInputBuffer::PeekOldest(double OldestTime)
+{
+    while (Count > 0 && Entries[Head].Time < OldestTime)
+    {
+        PopOldest();
+    }
+    return Count > 0 ? &Entries[Head] : nullptr;
+}
+
+void FTowerInputBuffer::PopOldest()
+{
+    if (Count == 0) return;
+    Head = (Head + 1) % Capacity;
+    Count--;
+}
+
+bool FTowerInputBuffer::Contains(ETowerBufferedAction Action) const
+{
+    for (int32 i = 0; i < Count; i++)
+    {
+        if (Entries[(Head + i) % Capacity].Action == Action) return true;
+    }
+    return false;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Combat presses the buffer holds until the character can act on them */
+enum class ETowerBufferedAction : uint8
+{
+    Attack,
+    Dodge,
+    Parry,
+};
+
+/** One press, stamped in the character's combat time and in FPlatformTime seconds */
+struct FTowerBufferedInput
+{
+    ETowerBufferedAction Action = ETowerBufferedAction::Attack;
+    double Time = 0.0;
+    double PlatformTime = 0.0;
+};
+
+/**
+ * Fixed ring of timestamped combat presses, oldest first. A press made while
+ * the character is still recovering waits here instead of being dropped, and
+ * the character judges it by when it was pressed rather than by the tick that
+ * gets to it. When full, the oldest press is overwritten.
+ */
+struct TOWERGAME_API FTowerInputBuffer
+{
+    static constexpr int32 Capacity = 16;
+
+    void Push(ETowerBufferedAction Action, double Time, double PlatformTime);
+
+    /** Oldest press at or after OldestTime; older ones are discarded on the way */
+    const FTowerBufferedInput* PeekOldest(double OldestTime);
+    void PopOldest();
+
+    bool Contains(ETowerBufferedAction Action) const;
+    int32 Num() const { return Count; }
+    void Reset() { Head = 0; Count = 0; }
+
+private:
+    FTowerBufferedInput Entries[Capacity];
+    int32 Head = 0;     // Oldest entry
+    int32 Count = 0;
+};
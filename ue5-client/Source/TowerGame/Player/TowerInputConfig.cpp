@@ -34,6 +34,10 @@ void UTowerInputConfig::SetupActions(UObject* Outer)
     IA_Dodge = NewObject<UInputAction>(Outer, TEXT("IA_Dodge"));
     IA_Dodge->ValueType = EInputActionValueType::Boolean;
 
+    // Parry — digital (RMB)
+    IA_Parry = NewObject<UInputAction>(Outer, TEXT("IA_Parry"));
+    IA_Parry->ValueType = EInputActionValueType::Boolean;
+
     // Interact — digital (E)
     IA_Interact = NewObject<UInputAction>(Outer, TEXT("IA_Interact"));
     IA_Interact->ValueType = EInputActionValueType::Boolean;
@@ -90,6 +94,7 @@ void UTowerInputConfig::SetupMappingContext(UObject* Outer)
     DefaultContext->MapKey(IA_Jump, EKeys::SpaceBar);
     DefaultContext->MapKey(IA_Attack, EKeys::LeftMouseButton);
     DefaultContext->MapKey(IA_Dodge, EKeys::LeftShift);
+    DefaultContext->MapKey(IA_Parry, EKeys::RightMouseButton);
     DefaultContext->MapKey(IA_Interact, EKeys::E);
     DefaultContext->MapKey(IA_Inventory, EKeys::Tab);
     DefaultContext->MapKey(IA_Pause, EKeys::Escape);
@@ -121,6 +126,7 @@ void UTowerInputConfig::SetupMappingContext(UObject* Outer)
         DefaultContext->MapKey(IA_Jump, EKeys::Gamepad_FaceButton_Bottom);      // A/Cross
         DefaultContext->MapKey(IA_Attack, EKeys::Gamepad_RightTrigger);          // RT/R2
         DefaultContext->MapKey(IA_Dodge, EKeys::Gamepad_FaceButton_Right);       // B/Circle
+        DefaultContext->MapKey(IA_Parry, EKeys::Gamepad_LeftTrigger);           // LT/L2
         DefaultContext->MapKey(IA_Interact, EKeys::Gamepad_FaceButton_Left);     // X/Square
         DefaultContext->MapKey(IA_Pause, EKeys::Gamepad_Special_Right);          // Start
     }
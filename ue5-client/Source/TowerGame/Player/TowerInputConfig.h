@@ -15,6 +15,7 @@
  *   Mouse XY   — Look (2D Axis)
  *   Space      — Jump (Digital)
  *   LMB        — Attack (Digital)
+ *   RMB        — Parry (Digital)
  *   Shift      — Dodge (Digital)
  *   E          — Interact (Digital)
  *   Tab        — Inventory (Digital)
@@ -47,6 +48,9 @@ public:
     UPROPERTY()
     UInputAction* IA_Dodge;
 
+    UPROPERTY()
+    UInputAction* IA_Parry;
+
     UPROPERTY()
     UInputAction* IA_Interact;
 
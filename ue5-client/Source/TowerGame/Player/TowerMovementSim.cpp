@@ -0,0 +1,62 @@
+#include "TowerMovementSim.h"
+
+FTowerMoveInput FTowerMoveInput::Quantize(const FVector2D& MoveAxis, float ControlYaw)
+{
+    FTowerMoveInput Input;
+    Input.Forward = static_cast<int8>(FMath::RoundToInt(FMath::Clamp(MoveAxis.Y, -1.0, 1.0) * 127.0));
+    Input.Right = static_cast<int8>(FMath::RoundToInt(FMath::Clamp(MoveAxis.X, -1.0, 1.0) * 127.0));
+    Input.Yaw = FRotator::CompressAxisToShort(ControlYaw);
+    return Input;
+}
+
+FTowerMoveState FTowerMovementSim::Step(const FTowerMoveState& State, const FTowerMoveInput& Input) const
+{
+    // Everything below reads only State, Input and the tuning: no frame time, no world
+    const double Dt = FixedDeltaSeconds;
+    FTowerMoveState Next = State;
+
+    // Wish direction in world space, from the camera yaw the input was sampled with
+    FVector Wish = FVector::ZeroVector;
+    if (Input.HasMovement())
+    {
+        double Sin, Cos;
+        FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(FRotator::DecompressAxisFromShort(Input.Yaw)));
+        const double Forward = Input.Forward / 127.0;
+        const double Right = Input.Right / 127.0;
+        Wish = FVector(Cos * Forward - Sin * Right, Sin * Forward + Cos * Right, 0.0);
+
+        const double WishSizeSq = Wish.SizeSquared();
+        if (WishSizeSq > 1.0)
+        {
+            Wish /= FMath::Sqrt(WishSizeSq);
+        }
+    }
+
+    // Accelerate toward the wish velocity, or brake to a stop
+    if (!Wish.IsZero())
+    {
+        const FVector ToTarget = Wish * MaxSpeed - State.Velocity;
+        const double Remaining = ToTarget.Size();
+        const double MaxChange = Acceleration * Dt;
+        Next.Velocity = Remaining <= MaxChange ? Wish * MaxSpeed : State.Velocity + ToTarget * (MaxChange / Remaining);
+    }
+    else
+    {
+        const double Speed = State.Velocity.Size();
+        const double Drop = BrakingDeceleration * Dt;
+        Next.Velocity = Speed <= Drop ? FVector::ZeroVector : State.Velocity * ((Speed - Drop) / Speed);
+    }
+
+    Next.Position = State.Position + Next.Velocity * Dt;
+
+    // Face the way we're moving, at RotationRate (bOrientRotationToMovement)
+    if (!Wish.IsZero())
+    {
+        const double TargetYaw = FMath::RadiansToDegrees(FMath::Atan2(Wish.Y, Wish.X));
+        const double Delta = FRotator::NormalizeAxis(TargetYaw - State.Yaw);
+        const double MaxTurn = RotationRate * Dt;
+        Next.Yaw = FRotator::NormalizeAxis(State.Yaw + FMath::Clamp(Delta, -MaxTurn, MaxTurn));
+    }
+
+    return Next;
+}
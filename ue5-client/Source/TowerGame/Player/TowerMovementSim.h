@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One sim tick of movement input, quantized so a replay steps on exactly the recorded values */
+struct FTowerMoveInput
+{
+    int8 Forward = 0;   // Move axis Y, x127
+    int8 Right = 0;     // Move axis X, x127
+    uint16 Yaw = 0;     // Control yaw, 65536 steps per turn
+
+    static FTowerMoveInput Quantize(const FVector2D& MoveAxis, float ControlYaw);
+
+    bool HasMovement() const { return Forward != 0 || Right != 0; }
+};
+
+/** What the sim carries from one tick to the next */
+struct FTowerMoveState
+{
+    FVector Position = FVector::ZeroVector;
+    FVector Velocity = FVector::ZeroVector;    // Horizontal; Z stays 0
+    double Yaw = 0.0;                          // Facing, degrees
+};
+
+/**
+ * Fixed-timestep ground movement for the local player, shared by the
+ * character (live) and UTowerStateSynchronizer (replaying unconfirmed moves):
+ * the same state and input always step to the same bits, at any frame rate.
+ *
+ * Only horizontal motion and facing are simulated. Gravity and jumps stay
+ * with the character movement component, and the character feeds collision
+ * results back into the state before the next step.
+ */
+struct TOWERGAME_API FTowerMovementSim
+{
+    static constexpr int32 TickRate = 60;
+    static constexpr double FixedDeltaSeconds = 1.0 / TickRate;
+
+    // Defaults match ATowerPlayerCharacter's movement component
+    double MaxSpeed = 600.0;
+    double Acceleration = 2048.0;
+    double BrakingDeceleration = 2048.0;
+    double RotationRate = 540.0;    // Degrees per second, toward the movement direction
+
+    FTowerMoveState Step(const FTowerMoveState& State, const FTowerMoveInput& Input) const;
+};
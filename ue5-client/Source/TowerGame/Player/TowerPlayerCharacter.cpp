@@ -1,12 +1,19 @@
 #include "TowerPlayerCharacter.h"
 #include "TowerInputConfig.h"
 #include "TowerGame/Core/TowerGameSubsystem.h"
+#include "Network/StateSynchronizer.h"
+#include "Network/ActionSender.h"
+#include "World/ProximityQuerySubsystem.h"
+#include "World/MeleeHitSubsystem.h"
+#include "World/GameplayEventSubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Kismet/GameplayStatics.h"
+#include "GameFramework/GameModeBase.h"
+#include "Components/SkeletalMeshComponent.h"
 
 ATowerPlayerCharacter::ATowerPlayerCharacter()
 {
@@ -50,8 +57,9 @@ void ATowerPlayerCharacter::BeginPlay()
         JumpAction = Config->IA_Jump;
         AttackAction = Config->IA_Attack;
         DodgeAction = Config->IA_Dodge;
+        ParryAction = Config->IA_Parry;
         InteractAction = Config->IA_Interact;
-        UE_LOG(LogTemp, Log, TEXT("Auto-created Enhanced Input config (WASD+Mouse+LMB+Shift+E)"));
+        UE_LOG(LogTemp, Log, TEXT("Auto-created Enhanced Input config (WASD+Mouse+LMB+RMB+Shift+E)"));
     }
 
     // Add input mapping context
@@ -66,6 +74,48 @@ void ATowerPlayerCharacter::BeginPlay()
             }
         }
     }
+
+    // The sim takes over walking and facing; it starts from the movement component's tuning
+    UCharacterMovementComponent* Movement = GetCharacterMovement();
+    MovementSim.MaxSpeed = Movement->MaxWalkSpeed;
+    MovementSim.Acceleration = Movement->MaxAcceleration;
+    MovementSim.BrakingDeceleration = Movement->BrakingDecelerationWalking;
+    MovementSim.RotationRate = Movement->RotationRate.Yaw;
+    SimState.Position = PrevSimPosition = GetActorLocation();
+    SimState.Yaw = GetActorRotation().Yaw;
+    BaseMeshLocation = GetMesh()->GetRelativeLocation();
+
+    if (bFixedStepMovement)
+    {
+        Movement->bOrientRotationToMovement = false;
+    }
+
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        ProximityHandle = Proximity->Register(this, EProximityChannel::Player, 0.0f);
+    }
+
+    if (UTowerGameSubsystem* Sub = GetTowerSubsystem())
+    {
+        ConfigReloadedHandle = Sub->OnConfigReloaded.AddUObject(this, &ATowerPlayerCharacter::InvalidateDamageCache);
+    }
+}
+
+void ATowerPlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->Unregister(ProximityHandle);
+    }
+    ProximityHandle = INDEX_NONE;
+
+    if (UTowerGameSubsystem* Sub = GetTowerSubsystem())
+    {
+        Sub->OnConfigReloaded.Remove(ConfigReloadedHandle);
+    }
+    ConfigReloadedHandle.Reset();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void ATowerPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
@@ -75,7 +125,10 @@ void ATowerPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInp
     if (UEnhancedInputComponent* EnhancedInput = CastChecked<UEnhancedInputComponent>(PlayerInputComponent))
     {
         if (MoveAction)
+        {
             EnhancedInput->BindAction(MoveAction, ETriggerEvent::Triggered, this, &ATowerPlayerCharacter::Move);
+            EnhancedInput->BindAction(MoveAction, ETriggerEvent::Completed, this, &ATowerPlayerCharacter::StopMove);
+        }
 
         if (LookAction)
             EnhancedInput->BindAction(LookAction, ETriggerEvent::Triggered, this, &ATowerPlayerCharacter::Look);
@@ -92,6 +145,9 @@ void ATowerPlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInp
         if (DodgeAction)
             EnhancedInput->BindAction(DodgeAction, ETriggerEvent::Started, this, &ATowerPlayerCharacter::PerformDodge);
 
+        if (ParryAction)
+            EnhancedInput->BindAction(ParryAction, ETriggerEvent::Started, this, &ATowerPlayerCharacter::PerformParry);
+
         if (InteractAction)
             EnhancedInput->BindAction(InteractAction, ETriggerEvent::Started, this, &ATowerPlayerCharacter::Interact);
     }
@@ -101,23 +157,41 @@ void ATowerPlayerCharacter::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // Combo window decay
-    if (ComboTimer > 0.0f)
+    CombatTime += DeltaTime;
+    LastTickPlatformTime = FPlatformTime::Seconds();
+    ResolveBufferedInputs();
+
+    RegenerateResources(DeltaTime);
+
+    if (UsesMovementSim())
     {
-        ComboTimer -= DeltaTime;
-        if (ComboTimer <= 0.0f)
-        {
-            ResetCombo();
-        }
+        StepMovementSim(DeltaTime);
     }
 
-    RegenerateResources(DeltaTime);
+    // Only rebuckets when we cross into another cell
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->UpdateLocation(ProximityHandle, GetActorLocation());
+    }
+
+    if (DirtyStats != ETowerPlayerStats::None)
+    {
+        const ETowerPlayerStats Changed = DirtyStats;
+        DirtyStats = ETowerPlayerStats::None;
+        OnStatsChanged.Broadcast(Changed);
+    }
 }
 
 void ATowerPlayerCharacter::Move(const FInputActionValue& Value)
 {
     FVector2D MoveInput = Value.Get<FVector2D>();
 
+    if (UsesMovementSim())
+    {
+        MoveAxis = MoveInput;
+        return;
+    }
+
     if (Controller != nullptr && !bIsAttacking)
     {
         const FRotator Rotation = Controller->GetControlRotation();
@@ -131,6 +205,11 @@ void ATowerPlayerCharacter::Move(const FInputActionValue& Value)
     }
 }
 
+void ATowerPlayerCharacter::StopMove(const FInputActionValue& Value)
+{
+    MoveAxis = FVector2D::ZeroVector;
+}
+
 void ATowerPlayerCharacter::Look(const FInputActionValue& Value)
 {
     FVector2D LookInput = Value.Get<FVector2D>();
@@ -144,65 +223,17 @@ void ATowerPlayerCharacter::Look(const FInputActionValue& Value)
 
 void ATowerPlayerCharacter::PerformAttack()
 {
-    if (bIsAttacking || bIsDodging) return;
-    if (KineticEnergy < 5.0f) return; // Not enough resource
-
-    bIsAttacking = true;
-    KineticEnergy -= 5.0f + ComboStep * 3.0f;
-
-    // Calculate damage through Rust core
-    float FinalDamage = BaseDamage;
-    UTowerGameSubsystem* Sub = GetTowerSubsystem();
-    if (Sub && Sub->IsRustCoreReady())
-    {
-        // AngleId: 0=Front, 1=Side, 2=Back (determine from target direction)
-        FinalDamage = Sub->CalculateDamage(BaseDamage, 0, ComboStep);
-    }
-    else
-    {
-        // Fallback: simple combo multiplier
-        FinalDamage = BaseDamage * (1.0f + ComboStep * 0.15f);
-    }
-
-    UE_LOG(LogTemp, Log, TEXT("Attack! Combo %d, Damage: %.1f, Kinetic: %.1f"),
-        ComboStep, FinalDamage, KineticEnergy);
-
-    // Advance combo
-    ComboStep = (ComboStep + 1) % MaxCombo;
-    ComboTimer = ComboWindow;
-
-    // Simulate attack duration
-    FTimerHandle AttackTimer;
-    GetWorldTimerManager().SetTimer(AttackTimer, [this]()
-    {
-        bIsAttacking = false;
-    }, 0.4f, false);
+    BufferInput(ETowerBufferedAction::Attack);
 }
 
 void ATowerPlayerCharacter::PerformDodge()
 {
-    if (bIsDodging || bIsAttacking) return;
-    if (KineticEnergy < 15.0f) return;
-
-    bIsDodging = true;
-    KineticEnergy -= 15.0f;
-    ResetCombo();
-
-    // Dodge movement
-    FVector DodgeDirection = GetLastMovementInputVector();
-    if (DodgeDirection.IsNearlyZero())
-    {
-        DodgeDirection = GetActorForwardVector() * -1.0f; // Backstep
-    }
-    LaunchCharacter(DodgeDirection * 800.0f + FVector(0, 0, 100.0f), true, true);
-
-    UE_LOG(LogTemp, Log, TEXT("Dodge! Kinetic: %.1f"), KineticEnergy);
+    BufferInput(ETowerBufferedAction::Dodge);
+}
 
-    FTimerHandle DodgeTimer;
-    GetWorldTimerManager().SetTimer(DodgeTimer, [this]()
-    {
-        bIsDodging = false;
-    }, 0.5f, false);
+void ATowerPlayerCharacter::PerformParry()
+{
+    BufferInput(ETowerBufferedAction::Parry);
 }
 
 void ATowerPlayerCharacter::Interact()
@@ -216,7 +247,9 @@ void ATowerPlayerCharacter::TakeCombatDamage(float Amount)
     if (bIsDodging) return; // I-frames during dodge
 
     float ActualDamage = FMath::Max(0.0f, Amount);
+    const bool bWasAlive = CurrentHp > 0.0f;
     CurrentHp -= ActualDamage;
+    DirtyStats |= ETowerPlayerStats::Health;
 
     UE_LOG(LogTemp, Log, TEXT("Player takes %.1f damage. HP: %.0f/%.0f"),
         ActualDamage, CurrentHp, MaxHp);
@@ -225,6 +258,13 @@ void ATowerPlayerCharacter::TakeCombatDamage(float Amount)
     {
         CurrentHp = 0.0f;
         UE_LOG(LogTemp, Warning, TEXT("Player defeated!"));
+
+        UTowerGameSubsystem* Sub = GetTowerSubsystem();
+        UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>();
+        if (bWasAlive && Sub && Events)
+        {
+            Events->PostFloorProgress({ Sub->CurrentFloor, ETowerFloorProgress::PlayerDied });
+        }
         // Death/echo system will handle respawn
     }
 }
@@ -238,19 +278,340 @@ UTowerGameSubsystem* ATowerPlayerCharacter::GetTowerSubsystem() const
 
 void ATowerPlayerCharacter::ResetCombo()
 {
+    if (ComboStep != 0)
+    {
+        DirtyStats |= ETowerPlayerStats::Combo;
+    }
     ComboStep = 0;
-    ComboTimer = 0.0f;
 }
 
 void ATowerPlayerCharacter::RegenerateResources(float DeltaTime)
 {
+    // Full pools are the steady state: skip them so they raise no change event
+    auto Regen = [this](float& Energy, float Rate, ETowerPlayerStats Stat)
+    {
+        if (Energy >= 100.0f) return;
+        Energy = FMath::Min(100.0f, Energy + Rate);
+        DirtyStats |= Stat;
+    };
+
     // Kinetic: 5/s passive, more from movement
     float MovementBonus = GetVelocity().Size() > 50.0f ? 10.0f : 0.0f;
-    KineticEnergy = FMath::Min(100.0f, KineticEnergy + (5.0f + MovementBonus) * DeltaTime);
+    Regen(KineticEnergy, (5.0f + MovementBonus) * DeltaTime, ETowerPlayerStats::Kinetic);
 
     // Thermal: 3/s passive
-    ThermalEnergy = FMath::Min(100.0f, ThermalEnergy + 3.0f * DeltaTime);
+    Regen(ThermalEnergy, 3.0f * DeltaTime, ETowerPlayerStats::Thermal);
 
     // Semantic: 1/s passive (boosted by analyzing tags nearby)
-    SemanticEnergy = FMath::Min(100.0f, SemanticEnergy + 1.0f * DeltaTime);
+    Regen(SemanticEnergy, 1.0f * DeltaTime, ETowerPlayerStats::Semantic);
+}
+
+// ============ Fixed-Step Movement ============
+
+FVector ATowerPlayerCharacter::GetVelocity() const
+{
+    // Walking speed lives in the sim; the movement component only carries gravity, jumps and launches
+    if (UsesMovementSim() && !bIsDodging)
+    {
+        return FVector(SimState.Velocity.X, SimState.Velocity.Y, Super::GetVelocity().Z);
+    }
+    return Super::GetVelocity();
+}
+
+void ATowerPlayerCharacter::StepMovementSim(float DeltaTime)
+{
+    const double Dt = FTowerMovementSim::FixedDeltaSeconds;
+
+    if (bIsDodging)
+    {
+        // The launch owns the dodge; walking resumes from wherever it lands
+        SimAccumulator = 0.0;
+        SimState.Position = PrevSimPosition = GetActorLocation();
+        SimState.Velocity = FVector::ZeroVector;
+        GetMesh()->SetRelativeLocation(BaseMeshLocation);
+        return;
+    }
+
+    UTowerStateSynchronizer* Sync = FindStateSynchronizer();
+
+    // A hitch runs at most a quarter second of ticks rather than spiralling
+    SimAccumulator = FMath::Min(SimAccumulator + DeltaTime, 0.25);
+    while (SimAccumulator >= Dt)
+    {
+        SimAccumulator -= Dt;
+
+        const float ControlYaw = Controller ? Controller->GetControlRotation().Yaw : 0.0f;
+        const FTowerMoveInput Input = FTowerMoveInput::Quantize(bIsAttacking ? FVector2D::ZeroVector : MoveAxis, ControlYaw);
+
+        // Launches, platforms and corrections move us outside the sim: step from where we are
+        const FVector Start = GetActorLocation();
+        SimState.Position = Start;
+        FTowerMoveState Next = MovementSim.Step(SimState, Input);
+
+        // Sweep there; what a wall blocks comes out of the state the next tick steps from
+        SweepSimMove(FVector(Next.Position.X - Start.X, Next.Position.Y - Start.Y, 0.0), Next);
+        PrevSimPosition = Start;
+        SimState = Next;
+
+        if (Sync)
+        {
+            Sync->PredictMove(Input, SimState, CurrentHp);
+        }
+    }
+
+    // Draw the mesh between the last two ticks; the capsule stays on the tick
+    const double Alpha = SimAccumulator / Dt;
+    const FVector RenderOffset = (PrevSimPosition - SimState.Position) * (1.0 - Alpha);
+    GetMesh()->SetRelativeLocation(BaseMeshLocation + GetActorQuat().UnrotateVector(FVector(RenderOffset.X, RenderOffset.Y, 0.0)));
+}
+
+void ATowerPlayerCharacter::SweepSimMove(const FVector& Delta, FTowerMoveState& State)
+{
+    UCharacterMovementComponent* Movement = GetCharacterMovement();
+    FHitResult Hit;
+    Movement->SafeMoveUpdatedComponent(Delta, FRotator(0.0, State.Yaw, 0.0), true, Hit);
+    if (Hit.IsValidBlockingHit())
+    {
+        const FVector Remaining = Delta * (1.0f - Hit.Time);
+        if (!Movement->CanStepUp(Hit) || !Movement->StepUp(-FVector::UpVector, Remaining, Hit))
+        {
+            Movement->SlideAlongSurface(Remaining, 1.0f - Hit.Time, Hit.Normal, Hit, true);
+        }
+        State.Velocity = FVector::VectorPlaneProject(State.Velocity, Hit.Normal.GetSafeNormal2D());
+        State.Velocity.Z = 0.0;
+    }
+    State.Position = GetActorLocation();
+}
+
+UTowerStateSynchronizer* ATowerPlayerCharacter::FindStateSynchronizer()
+{
+    if (UTowerStateSynchronizer* Sync = StateSync.Get())
+    {
+        return Sync;
+    }
+
+    UTowerStateSynchronizer* Sync = Controller ? Controller->FindComponentByClass<UTowerStateSynchronizer>() : nullptr;
+    if (!Sync)
+    {
+        AGameModeBase* GameMode = GetWorld()->GetAuthGameMode();
+        Sync = GameMode ? GameMode->FindComponentByClass<UTowerStateSynchronizer>() : nullptr;
+    }
+
+    if (Sync)
+    {
+        StateSync = Sync;
+        Sync->SetMovementSim(MovementSim);
+        Sync->OnPredictionCorrected.AddUniqueDynamic(this, &ATowerPlayerCharacter::HandlePredictionCorrected);
+    }
+    return Sync;
+}
+
+void ATowerPlayerCharacter::HandlePredictionCorrected(int64 SequenceNumber, FVector CorrectedPosition, FVector PredictedPosition)
+{
+    if (!UsesMovementSim()) return;
+
+    // The replay re-stepped our own inputs from the server position, without
+    // collision: continue from its velocity and facing, and sweep to its position
+    // the way a sim tick moves, so a correction against a wall slides along it
+    FTowerMoveState Corrected = SimState;
+    if (const UTowerStateSynchronizer* Sync = StateSync.Get())
+    {
+        Corrected.Velocity = Sync->GetReplayedMoveState().Velocity;
+        Corrected.Yaw = Sync->GetReplayedMoveState().Yaw;
+    }
+
+    const FVector Location = GetActorLocation();
+    SweepSimMove(FVector(CorrectedPosition.X - Location.X, CorrectedPosition.Y - Location.Y, 0.0), Corrected);
+    SimState = Corrected;
+    PrevSimPosition = SimState.Position;
+}
+
+// ============ Buffered Combat Input ============
+
+void ATowerPlayerCharacter::BufferInput(ETowerBufferedAction Action)
+{
+    // Input is dispatched before this actor ticks: the press belongs to the frame under way
+    const double Now = FPlatformTime::Seconds();
+    const double SinceTick = FMath::Clamp(Now - LastTickPlatformTime, 0.0, static_cast<double>(InputBufferWindow));
+    InputBuffer.Push(Action, CombatTime + SinceTick, Now);
+}
+
+void ATowerPlayerCharacter::ResolveBufferedInputs()
+{
+    const double Now = CombatTime;
+
+    for (;;)
+    {
+        // Presses wait out recovery; the window is measured from when recovery ends
+        const double BusyUntil = GetBusyUntil();
+        if (BusyUntil > Now) break;
+
+        const double FreeAt = BusyUntil > 0.0 ? BusyUntil : Now;
+        const FTowerBufferedInput* Oldest = InputBuffer.PeekOldest(FreeAt - InputBufferWindow);
+        if (!Oldest) break;
+
+        const FTowerBufferedInput Press = *Oldest;
+        InputBuffer.PopOldest();
+
+        // Starts when pressed or when recovery ended, whichever is later, never in the future
+        const double StartTime = FMath::Min(FMath::Max(Press.Time, BusyUntil), Now);
+        EndExpiredActions(StartTime);
+
+        switch (Press.Action)
+        {
+        case ETowerBufferedAction::Attack: StartAttack(StartTime, Press); break;
+        case ETowerBufferedAction::Dodge:  StartDodge(StartTime); break;
+        case ETowerBufferedAction::Parry:  StartParry(StartTime, Press); break;
+        }
+    }
+
+    EndExpiredActions(Now);
+
+    // A combo closes once its window has passed, unless an attack pressed inside it is still waiting
+    if (ComboStep != 0 && Now > ComboEndTime && !InputBuffer.Contains(ETowerBufferedAction::Attack))
+    {
+        ResetCombo();
+    }
+}
+
+double ATowerPlayerCharacter::GetBusyUntil() const
+{
+    double BusyUntil = 0.0;
+    if (bIsAttacking) BusyUntil = FMath::Max(BusyUntil, AttackEndTime);
+    if (bIsDodging) BusyUntil = FMath::Max(BusyUntil, DodgeEndTime);
+    if (bIsParrying) BusyUntil = FMath::Max(BusyUntil, ParryEndTime);
+    return BusyUntil;
+}
+
+void ATowerPlayerCharacter::EndExpiredActions(double Time)
+{
+    if (bIsAttacking && AttackEndTime <= Time) bIsAttacking = false;
+    if (bIsDodging && DodgeEndTime <= Time) bIsDodging = false;
+    if (bIsParrying && ParryEndTime <= Time) bIsParrying = false;
+}
+
+bool ATowerPlayerCharacter::StartAttack(double StartTime, const FTowerBufferedInput& Press)
+{
+    if (KineticEnergy < 5.0f) return false; // Not enough resource
+
+    // The combo carries on if the press was inside the window, however late the tick is
+    if (ComboStep != 0 && Press.Time > ComboEndTime)
+    {
+        ResetCombo();
+    }
+
+    bIsAttacking = true;
+    KineticEnergy -= 5.0f + ComboStep * 3.0f;
+
+    // Never cached: every swing rolls its own
+    const bool bCrit = CritChance > 0.0f && FMath::FRand() < CritChance;
+    const float CritScale = bCrit ? CritMultiplier : 1.0f;
+
+    UE_LOG(LogTemp, Log, TEXT("Attack! Combo %d, Base damage: %.1f%s, Kinetic: %.1f"),
+        ComboStep, BaseDamage * CritScale, bCrit ? TEXT(" (crit)") : TEXT(""), KineticEnergy);
+
+    // Targets are found and hit next frame, batched with every other swing of the frame
+    if (UTowerMeleeHitSubsystem* MeleeHits = GetWorld()->GetSubsystem<UTowerMeleeHitSubsystem>())
+    {
+        FTowerMeleeSweep Sweep;
+        Sweep.Instigator = this;
+        Sweep.Origin = GetActorLocation();
+        Sweep.Forward = GetActorForwardVector();
+        Sweep.Radius = AttackRange;
+        Sweep.ArcDegrees = AttackArcDegrees;
+        Sweep.BaseDamage = BaseDamage * CritScale;
+        Sweep.ComboStep = ComboStep;
+
+        // Memoized per angle, so untagged targets skip the core entirely
+        UTowerGameSubsystem* Sub = GetTowerSubsystem();
+        if (Sub && Sub->IsRustCoreReady())
+        {
+            for (int32 AngleId = 0; AngleId < static_cast<int32>(UE_ARRAY_COUNT(Sweep.AngleDamage)); ++AngleId)
+            {
+                Sweep.AngleDamage[AngleId] = GetAttackDamage(*Sub, AngleId, ComboStep) * CritScale;
+            }
+            Sweep.bHasAngleDamage = true;
+        }
+        MeleeHits->QueueSweep(Sweep);
+    }
+
+    // Advance combo
+    ComboStep = (ComboStep + 1) % MaxCombo;
+    ComboEndTime = StartTime + ComboWindow;
+    AttackEndTime = StartTime + AttackDuration;
+    DirtyStats |= ETowerPlayerStats::Kinetic | ETowerPlayerStats::Combo;
+    return true;
+}
+
+float ATowerPlayerCharacter::GetAttackDamage(UTowerGameSubsystem& Sub, int32 AngleId, int32 Step)
+{
+    const uint32 StatsHash = GetDamageStatsHash();
+    if (StatsHash != DamageStatsHash)
+    {
+        DamageCache.Reset();
+        DamageStatsHash = StatsHash;
+    }
+
+    const uint32 Key = (static_cast<uint32>(AngleId) << 16) | static_cast<uint16>(Step);
+    if (const float* Cached = DamageCache.Find(Key))
+    {
+        return *Cached;
+    }
+    return DamageCache.Add(Key, Sub.CalculateDamage(BaseDamage, AngleId, Step));
+}
+
+uint32 ATowerPlayerCharacter::GetDamageStatsHash() const
+{
+    return HashCombine(GetTypeHash(BaseDamage), GetTypeHash(DamageStatsRevision));
+}
+
+void ATowerPlayerCharacter::InvalidateDamageCache()
+{
+    DamageCache.Reset();
+    ++DamageStatsRevision;
+}
+
+bool ATowerPlayerCharacter::StartDodge(double StartTime)
+{
+    if (KineticEnergy < 15.0f) return false;
+
+    bIsDodging = true;
+    DodgeEndTime = StartTime + DodgeDuration;
+    KineticEnergy -= 15.0f;
+    DirtyStats |= ETowerPlayerStats::Kinetic;
+    ResetCombo();
+
+    // Dodge movement
+    FVector DodgeDirection = UsesMovementSim() ? SimState.Velocity.GetSafeNormal2D() : GetLastMovementInputVector();
+    if (DodgeDirection.IsNearlyZero())
+    {
+        DodgeDirection = GetActorForwardVector() * -1.0f; // Backstep
+    }
+    LaunchCharacter(DodgeDirection * 800.0f + FVector(0, 0, 100.0f), true, true);
+
+    UE_LOG(LogTemp, Log, TEXT("Dodge! Kinetic: %.1f"), KineticEnergy);
+    return true;
+}
+
+void ATowerPlayerCharacter::StartParry(double StartTime, const FTowerBufferedInput& Press)
+{
+    bIsParrying = true;
+    ParryEndTime = StartTime + ParryDuration;
+    ResetCombo();
+
+    // The server judges the parry window from the press, so send that instant on its clock
+    if (UTowerActionSender* Sender = FindActionSender())
+    {
+        const UTowerStateSynchronizer* Sync = FindStateSynchronizer();
+        const double ServerTime = Press.PlatformTime + (Sync ? Sync->GetServerClockOffset() : 0.0);
+        Sender->SendParryAction(static_cast<int64>(ServerTime * 1000.0 + 0.5));
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Parry! Pressed %.0f ms before it started"), (StartTime - Press.Time) * 1000.0);
+}
+
+UTowerActionSender* ATowerPlayerCharacter::FindActionSender() const
+{
+    UTowerActionSender* Sender = Controller ? Controller->FindComponentByClass<UTowerActionSender>() : nullptr;
+    return Sender ? Sender : FindComponentByClass<UTowerActionSender>();
 }
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "TowerMovementSim.h"
+#include "TowerInputBuffer.h"
 #include "TowerPlayerCharacter.generated.h"
 
 class UInputMappingContext;
@@ -10,11 +12,41 @@ class UInputAction;
 class UCameraComponent;
 class USpringArmComponent;
 class UTowerGameSubsystem;
+class UTowerStateSynchronizer;
+class UTowerActionSender;
+
+/** Player stats the HUD shows, as a change mask */
+enum class ETowerPlayerStats : uint8
+{
+    None     = 0,
+    Health   = 1 << 0,
+    Kinetic  = 1 << 1,
+    Thermal  = 1 << 2,
+    Semantic = 1 << 3,
+    Combo    = 1 << 4,
+    All      = Health | Kinetic | Thermal | Semantic | Combo,
+};
+ENUM_CLASS_FLAGS(ETowerPlayerStats);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPlayerStatsChanged, ETowerPlayerStats /*Changed*/);
 
 /**
  * Tower Player Character — third-person action combat character.
  * Communicates with Rust core through UTowerGameSubsystem for
  * damage calculations, semantic interactions, and combat timing.
+ *
+ * With bFixedStepMovement the local player walks by FTowerMovementSim on its
+ * fixed tick instead of AddMovementInput: the move input is sampled once per
+ * sim tick, each tick is handed to UTowerStateSynchronizer::PredictMove, and a
+ * reconciliation replays the same sim, so prediction and replay agree to the
+ * bit. The mesh is drawn between the last two ticks so motion stays smooth
+ * at any frame rate.
+ *
+ * Attack, dodge and parry presses go through FTowerInputBuffer stamped in
+ * combat time (game time, advanced each tick). Tick resolves them oldest first:
+ * a press made during recovery starts the moment recovery ends if it is within
+ * InputBufferWindow of it, and combo continuation and parry timing are judged
+ * by the press time, not by the frame that got to it.
  */
 UCLASS()
 class TOWERGAME_API ATowerPlayerCharacter : public ACharacter
@@ -26,7 +58,9 @@ public:
 
     virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
+    virtual FVector GetVelocity() const override;
 
     // ============ Components ============
 
@@ -56,6 +90,9 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
     UInputAction* DodgeAction;
 
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
+    UInputAction* ParryAction;
+
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Input")
     UInputAction* InteractAction;
 
@@ -64,24 +101,59 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Combat")
     int32 ComboStep = 0;
 
-    UPROPERTY(BlueprintReadOnly, Category = "Combat")
-    float ComboTimer = 0.0f;
-
     UPROPERTY(BlueprintReadOnly, Category = "Combat")
     bool bIsAttacking = false;
 
     UPROPERTY(BlueprintReadOnly, Category = "Combat")
     bool bIsDodging = false;
 
+    UPROPERTY(BlueprintReadOnly, Category = "Combat")
+    bool bIsParrying = false;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
     float BaseDamage = 30.0f;
 
+    /** Chance (0-1) an attack crits; rolled locally on every swing */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float CritChance = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float CritMultiplier = 1.5f;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
     float ComboWindow = 0.8f;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
     int32 MaxCombo = 3;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float AttackDuration = 0.4f;
+
+    /** Reach of a combo swing, from the capsule centre */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float AttackRange = 250.0f;
+
+    /** Full width of a combo swing's arc, centred on the facing */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float AttackArcDegrees = 120.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float DodgeDuration = 0.5f;
+
+    /** Startup, window and recovery of the server's parry (Rust PARRY_TOTAL) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float ParryDuration = 0.47f;
+
+    /** How early before recovery ends a press is kept rather than dropped */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    float InputBufferWindow = 0.25f;
+
+    // ============ Movement ============
+
+    /** Walk the local player by FTowerMovementSim's fixed tick (see class comment); read at BeginPlay */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+    bool bFixedStepMovement = true;
+
     // ============ Stats ============
 
     UPROPERTY(BlueprintReadOnly, Category = "Stats")
@@ -107,18 +179,129 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void PerformDodge();
 
+    /** Parry; the press time goes to the server with SendParryAction */
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void PerformParry();
+
+    /** Attacking, dodging, parrying or inside a combo window */
+    bool IsInCombat() const { return bIsAttacking || bIsDodging || bIsParrying || ComboStep != 0; }
+
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     void Interact();
 
     UFUNCTION(BlueprintCallable, Category = "Stats")
     void TakeCombatDamage(float Amount);
 
+    /**
+     * Forget the memoized attack damage; call when gear, mastery or specialization
+     * changes what CalculateDamage returns. Config hot reloads do this on their own.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void InvalidateDamageCache();
+
+    // ============ Change Events ============
+
+    /**
+     * Broadcast at most once a tick with every stat changed since the last
+     * one, so per-tick regen and a hit in the same frame are one event.
+     * Nothing fires while the stats hold still.
+     */
+    FOnPlayerStatsChanged OnStatsChanged;
+
+    /** Flag stats changed outside this class; they go out with the next tick's event */
+    void MarkStatsDirty(ETowerPlayerStats Stats) { DirtyStats |= Stats; }
+
 protected:
     void Move(const FInputActionValue& Value);
+    void StopMove(const FInputActionValue& Value);
     void Look(const FInputActionValue& Value);
 
 private:
     UTowerGameSubsystem* GetTowerSubsystem() const;
     void ResetCombo();
     void RegenerateResources(float DeltaTime);
+
+    // ============ Buffered Combat Input ============
+
+    void BufferInput(ETowerBufferedAction Action);
+
+    /** Start buffered actions whose time has come, then end the windows that have run out */
+    void ResolveBufferedInputs();
+
+    /** Combat time the current attack, dodge or parry recovers at */
+    double GetBusyUntil() const;
+    void EndExpiredActions(double Time);
+
+    bool StartAttack(double StartTime, const FTowerBufferedInput& Press);
+
+    /** Damage of an attack before the crit roll, from DamageCache or the Rust core */
+    float GetAttackDamage(UTowerGameSubsystem& Sub, int32 AngleId, int32 Step);
+
+    /** Everything CalculateDamage depends on that the cache key leaves out */
+    uint32 GetDamageStatsHash() const;
+    bool StartDodge(double StartTime);
+    void StartParry(double StartTime, const FTowerBufferedInput& Press);
+
+    UTowerActionSender* FindActionSender() const;
+
+    FTowerInputBuffer InputBuffer;
+
+    /** Our entry on the proximity grid's Player channel */
+    int32 ProximityHandle = INDEX_NONE;
+
+    /** Game seconds since BeginPlay, advanced at the start of each tick */
+    double CombatTime = 0.0;
+    double LastTickPlatformTime = 0.0;
+
+    double AttackEndTime = 0.0;
+    double DodgeEndTime = 0.0;
+    double ParryEndTime = 0.0;
+    double ComboEndTime = 0.0;
+
+    // ============ Fixed-Step Movement ============
+
+    bool UsesMovementSim() const { return bFixedStepMovement && IsLocallyControlled(); }
+
+    /** Run the sim ticks DeltaTime covers and place the mesh between the last two */
+    void StepMovementSim(float DeltaTime);
+
+    /**
+     * Sweep the capsule by a sim move's horizontal Delta, stepping up or sliding
+     * along what blocks it. State ends where the capsule did, less the blocked velocity.
+     */
+    void SweepSimMove(const FVector& Delta, FTowerMoveState& State);
+
+    /** On the controller or the game mode; bound on first find */
+    UTowerStateSynchronizer* FindStateSynchronizer();
+
+    UFUNCTION()
+    void HandlePredictionCorrected(int64 SequenceNumber, FVector CorrectedPosition, FVector PredictedPosition);
+
+    FTowerMovementSim MovementSim;
+    FTowerMoveState SimState;
+    FVector PrevSimPosition = FVector::ZeroVector;
+    double SimAccumulator = 0.0;
+
+    /** Latest move axis; sampled once per sim tick */
+    FVector2D MoveAxis = FVector2D::ZeroVector;
+
+    FVector BaseMeshLocation = FVector::ZeroVector;
+
+    TWeakObjectPtr<UTowerStateSynchronizer> StateSync;
+
+    ETowerPlayerStats DirtyStats = ETowerPlayerStats::None;
+
+    // ============ Damage Memo ============
+
+    /**
+     * CalculateDamage results by (angle id << 16 | combo step), valid for the stat
+     * snapshot DamageStatsHash was taken from. A few angles times MaxCombo entries.
+     */
+    TMap<uint32, float> DamageCache;
+    uint32 DamageStatsHash = 0;
+
+    /** Bumped by InvalidateDamageCache, so the next snapshot differs from any cached one */
+    uint32 DamageStatsRevision = 0;
+
+    FDelegateHandle ConfigReloadedHandle;
 };
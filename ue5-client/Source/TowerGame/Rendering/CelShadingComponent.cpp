@@ -1,6 +1,8 @@
 #include "CelShadingComponent.h"
 #include "Components/PostProcessComponent.h"
+#include "PerfScalerSubsystem.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 
 UCelShadingComponent::UCelShadingComponent()
 {
@@ -10,6 +12,10 @@ UCelShadingComponent::UCelShadingComponent()
 void UCelShadingComponent::BeginPlay()
 {
     Super::BeginPlay();
+    if (const UTowerPerfScalerSubsystem* Scaler = GetWorld()->GetSubsystem<UTowerPerfScalerSubsystem>())
+    {
+        QualityScale = Scaler->GetScales().PostProcess;
+    }
     SetupPostProcess();
     ApplySettings();
 }
@@ -37,7 +43,7 @@ void UCelShadingComponent::ApplySettings()
 
     // ===== Bloom (anime glow) =====
     PP.bOverride_BloomIntensity = true;
-    PP.BloomIntensity = BloomIntensity;
+    PP.BloomIntensity = BloomIntensity * QualityScale;
 
     PP.bOverride_BloomThreshold = true;
     PP.BloomThreshold = 0.8f;
@@ -78,8 +84,24 @@ void UCelShadingComponent::ApplySettings()
     PP.bOverride_AutoExposureMaxBrightness = true;
     PP.AutoExposureMaxBrightness = 2.0f;
 
+    // ===== Breath tint =====
+    // Overridden from the start (neutral until the first phase), so a phase change only
+    // moves a parameter and never brings in a post-process permutation mid-fight
+    if (bApplyBreathTint && !PP.bOverride_SceneColorTint)
+    {
+        PP.bOverride_SceneColorTint = true;
+        PP.SceneColorTint = FLinearColor::White;
+    }
+
     UE_LOG(LogTemp, Log, TEXT("CelShading applied: %d steps, outline %.1fpx, bloom %.1f, saturation %.1f"),
-        LightSteps, OutlineThickness, BloomIntensity, SaturationBoost);
+        LightSteps, GetEffectiveOutlineThickness(), PP.BloomIntensity, SaturationBoost);
+}
+
+void UCelShadingComponent::SetQualityScale(float Scale)
+{
+    if (QualityScale == Scale) return;
+    QualityScale = Scale;
+    ApplySettings();
 }
 
 void UCelShadingComponent::SetBreathPhaseTint(const FString& Phase)
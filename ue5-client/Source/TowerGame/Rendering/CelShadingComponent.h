@@ -70,6 +70,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "CelShading")
     void ApplySettings();
 
+    /**
+     * Scale outline thickness and bloom below their configured values (1 = as set);
+     * driven by UTowerPerfScalerSubsystem
+     */
+    void SetQualityScale(float Scale);
+
+    /** OutlineThickness at the current quality scale, for the outline material */
+    UFUNCTION(BlueprintPure, Category = "CelShading")
+    float GetEffectiveOutlineThickness() const { return OutlineThickness * QualityScale; }
+
     /** Set Breath phase tint (called from GameState) */
     UFUNCTION(BlueprintCallable, Category = "CelShading")
     void SetBreathPhaseTint(const FString& Phase);
@@ -78,5 +88,7 @@ private:
     UPROPERTY()
     UPostProcessComponent* PostProcessComp;
 
+    float QualityScale = 1.0f;
+
     void SetupPostProcess();
 };
@@ -1,6 +1,32 @@
 #include "ElementalVFXComponent.h"
+#include "VFXPoolSubsystem.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+
+namespace
+{
+    /**
+     * Per-trigger caps across every elemental component in the world. Hits are
+     * the flood in a crowded fight and only read up close; deaths and finishers
+     * matter further out, and breath shifts hit every monster at once.
+     */
+    FTowerVFXBudget GetTriggerBudget(EVFXTrigger Trigger)
+    {
+        FTowerVFXBudget Budget;
+        Budget.Group = UEnum::GetValueAsName(Trigger);
+        switch (Trigger)
+        {
+        case EVFXTrigger::OnHit:         Budget.MaxActive = 24; Budget.CullDistance = 4000.0f; break;
+        case EVFXTrigger::OnDeath:       Budget.MaxActive = 12; Budget.CullDistance = 8000.0f; break;
+        case EVFXTrigger::OnDodge:       Budget.MaxActive = 8;  Budget.CullDistance = 3000.0f; break;
+        case EVFXTrigger::OnComboFinish: Budget.MaxActive = 8;  Budget.CullDistance = 8000.0f; break;
+        case EVFXTrigger::OnBreathShift: Budget.MaxActive = 16; Budget.CullDistance = 6000.0f; break;
+        default: break;
+        }
+        return Budget;
+    }
+}
 
 UElementalVFXComponent::UElementalVFXComponent()
 {
@@ -11,8 +37,15 @@ void UElementalVFXComponent::BeginPlay()
 {
     Super::BeginPlay();
 
+    // Load everything now so the first hit doesn't wait on its system
+    if (UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>())
+    {
+        VFXPool->PreloadSystems({ AuraSystem.ToSoftObjectPath(), HitSystem.ToSoftObjectPath(),
+            DeathSystem.ToSoftObjectPath(), DodgeSystem.ToSoftObjectPath(), ComboFinishSystem.ToSoftObjectPath() });
+    }
+
     // Auto-start aura if element is set
-    if (Element != EElementalType::None && AuraSystem)
+    if (Element != EElementalType::None && !AuraSystem.IsNull())
     {
         StartAura();
     }
@@ -37,7 +70,7 @@ void UElementalVFXComponent::SetElement(EElementalType NewElement)
 
 void UElementalVFXComponent::TriggerVFX(EVFXTrigger Trigger, FVector Location, float Scale)
 {
-    UNiagaraSystem* System = nullptr;
+    TSoftObjectPtr<UNiagaraSystem> System;
 
     switch (Trigger)
     {
@@ -64,18 +97,31 @@ void UElementalVFXComponent::TriggerVFX(EVFXTrigger Trigger, FVector Location, f
         return;
     }
 
-    if (System && GetOwner())
+    UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>();
+    if (VFXPool && GetOwner())
     {
-        SpawnElementalVFX(System, Location, Scale, true);
+        SpawnElementalVFX(VFXPool->FindSystem(System), Location, Scale, false, GetTriggerBudget(Trigger));
     }
 }
 
 void UElementalVFXComponent::StartAura()
 {
-    if (!AuraSystem || !GetOwner()) return;
+    if (AuraSystem.IsNull() || !GetOwner()) return;
     if (AuraComponent && AuraComponent->IsActive()) return;
 
-    AuraComponent = SpawnElementalVFX(AuraSystem, GetOwner()->GetActorLocation(), 1.0f, false);
+    bWantsAura = true;
+    UNiagaraSystem* System = AuraSystem.Get();
+    if (!System)
+    {
+        if (UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>())
+        {
+            VFXPool->PreloadSystems({ AuraSystem.ToSoftObjectPath() },
+                FSimpleDelegate::CreateUObject(this, &UElementalVFXComponent::OnAuraSystemLoaded));
+        }
+        return;
+    }
+
+    AuraComponent = SpawnElementalVFX(System, GetOwner()->GetActorLocation(), 1.0f, true);
     if (AuraComponent)
     {
         AuraComponent->AttachToComponent(
@@ -85,8 +131,18 @@ void UElementalVFXComponent::StartAura()
     }
 }
 
+void UElementalVFXComponent::OnAuraSystemLoaded()
+{
+    // Stopped, or the owner went away, while the system loaded
+    if (bWantsAura && AuraSystem.Get() && IsRegistered())
+    {
+        StartAura();
+    }
+}
+
 void UElementalVFXComponent::StopAura()
 {
+    bWantsAura = false;
     if (AuraComponent)
     {
         AuraComponent->DeactivateImmediate();
@@ -124,18 +180,26 @@ FLinearColor UElementalVFXComponent::GetElementSecondaryColor(EElementalType InE
 }
 
 UNiagaraComponent* UElementalVFXComponent::SpawnElementalVFX(
-    UNiagaraSystem* System, FVector Location, float Scale, bool bAutoDestroy)
+    UNiagaraSystem* System, FVector Location, float Scale, bool bLooping, const FTowerVFXBudget& Budget)
 {
     if (!System || !GetOwner()) return nullptr;
 
-    UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-        GetOwner(),
-        System,
-        Location,
-        FRotator::ZeroRotator,
-        FVector(ParticleScale * Scale),
-        bAutoDestroy
-    );
+    UNiagaraComponent* NiagaraComp = nullptr;
+    if (bLooping)
+    {
+        NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+            GetOwner(),
+            System,
+            Location,
+            FRotator::ZeroRotator,
+            FVector(ParticleScale * Scale),
+            false // bAutoDestroy
+        );
+    }
+    else if (UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>())
+    {
+        NiagaraComp = VFXPool->SpawnPooled(System, Budget, Location, FRotator::ZeroRotator, FVector(ParticleScale * Scale));
+    }
 
     if (NiagaraComp)
     {
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "NiagaraComponent.h"
+#include "VFXPoolSubsystem.h"
 #include "ElementalVFXComponent.generated.h"
 
 class UNiagaraSystem;
@@ -53,6 +54,13 @@ enum class EVFXTrigger : uint8
  * - Combo finisher burst (scaled by combo step)
  * - Breath shift pulse (when Tower breath phase changes)
  *
+ * Systems are soft references, loaded asynchronously through UTowerVFXPoolSubsystem
+ * from BeginPlay; an effect triggered before its system is in is skipped. One-shots
+ * play from the pool, so they share its per-system instance cap, and each trigger
+ * also has a world-wide budget: past it, the effects furthest from the camera are
+ * culled first. Pooled components are recoloured on every spawn, so one pool per
+ * system serves every element.
+ *
  * Uses Niagara User Parameters for runtime customization:
  *   - "ElementColor" (FLinearColor)
  *   - "Intensity" (float)
@@ -92,23 +100,23 @@ public:
 
     /** Ambient aura system (looping) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Systems")
-    UNiagaraSystem* AuraSystem;
+    TSoftObjectPtr<UNiagaraSystem> AuraSystem;
 
     /** Hit impact system (burst) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Systems")
-    UNiagaraSystem* HitSystem;
+    TSoftObjectPtr<UNiagaraSystem> HitSystem;
 
     /** Death explosion system (burst) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Systems")
-    UNiagaraSystem* DeathSystem;
+    TSoftObjectPtr<UNiagaraSystem> DeathSystem;
 
     /** Dodge trail system (brief) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Systems")
-    UNiagaraSystem* DodgeSystem;
+    TSoftObjectPtr<UNiagaraSystem> DodgeSystem;
 
     /** Combo finisher system (burst, scaled) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VFX|Systems")
-    UNiagaraSystem* ComboFinishSystem;
+    TSoftObjectPtr<UNiagaraSystem> ComboFinishSystem;
 
     // ============ Controls ============
 
@@ -144,8 +152,14 @@ private:
     UPROPERTY()
     UNiagaraComponent* AuraComponent;
 
-    /** Spawn a Niagara system with element parameters applied */
-    UNiagaraComponent* SpawnElementalVFX(UNiagaraSystem* System, FVector Location, float Scale, bool bAutoDestroy);
+    /** Aura requested; it starts once AuraSystem has loaded */
+    bool bWantsAura = false;
+
+    void OnAuraSystemLoaded();
+
+    /** Spawn a Niagara system with element parameters applied; one-shots come from the VFX pool under Budget */
+    UNiagaraComponent* SpawnElementalVFX(UNiagaraSystem* System, FVector Location, float Scale, bool bLooping,
+        const FTowerVFXBudget& Budget = FTowerVFXBudget());
 
     /** Apply element color and parameters to a Niagara component */
     void ApplyElementParameters(UNiagaraComponent* NiagaraComp, float Scale);
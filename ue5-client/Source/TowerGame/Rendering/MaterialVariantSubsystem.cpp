@@ -0,0 +1,43 @@
+#include "MaterialVariantSubsystem.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/World.h"
+
+void UTowerMaterialVariantSubsystem::Deinitialize()
+{
+    Variants.Empty();
+    VariantMaterials.Empty();
+    Super::Deinitialize();
+}
+
+UMaterialInstanceDynamic* UTowerMaterialVariantSubsystem::FindOrCreate(UMaterialInterface* Base, FName Variant,
+    TFunctionRef<void(UMaterialInstanceDynamic&)> Setup)
+{
+    // Pooled actors come back wearing a variant; key on what it was made from
+    UMaterialInstanceDynamic* BaseMID = Cast<UMaterialInstanceDynamic>(Base);
+    if (BaseMID && BaseMID->GetOuter() == this)
+    {
+        Base = BaseMID->Parent;
+    }
+    if (!Base) return nullptr;
+
+    const FVariantKey Key{ Base, Variant };
+    if (UMaterialInstanceDynamic* const* Existing = Variants.Find(Key))
+    {
+        return *Existing;
+    }
+
+    UMaterialInstanceDynamic* MID = UMaterialInstanceDynamic::Create(Base, this);
+    Setup(*MID);
+    Variants.Add(Key, MID);
+    VariantMaterials.Add(MID);
+    return MID;
+}
+
+UMaterialInstanceDynamic* UTowerMaterialVariantSubsystem::FindOrCreateColored(UMaterialInterface* Base, FName Variant,
+    const FLinearColor& Color, FName Parameter)
+{
+    return FindOrCreate(Base, Variant, [&Color, Parameter](UMaterialInstanceDynamic& MID)
+    {
+        MID.SetVectorParameterValue(Parameter, Color);
+    });
+}
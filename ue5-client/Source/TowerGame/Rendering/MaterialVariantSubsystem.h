@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MaterialVariantSubsystem.generated.h"
+
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Shared dynamic material instances, one per (base material, variant).
+ *
+ * Actors that only differ by a color picked from a small table (tile type,
+ * monster element, loot rarity, destruction material) ask here instead of
+ * creating their own MID. A floor then holds a few dozen MIDs instead of one
+ * per actor, and meshes using the same variant can be drawn together.
+ *
+ * Anything that really is per actor (spawn times, fades) belongs in custom
+ * primitive data on the component, not in a variant.
+ */
+UCLASS()
+class TOWERGAME_API UTowerMaterialVariantSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /**
+     * The MID for Variant of Base, made and set up by Setup the first time it is asked for.
+     * Base may itself be a variant from here; its parent is used. Null if Base is null.
+     */
+    UMaterialInstanceDynamic* FindOrCreate(UMaterialInterface* Base, FName Variant,
+        TFunctionRef<void(UMaterialInstanceDynamic&)> Setup);
+
+    /** Variant of Base with one vector parameter set to Color */
+    UMaterialInstanceDynamic* FindOrCreateColored(UMaterialInterface* Base, FName Variant,
+        const FLinearColor& Color, FName Parameter = TEXT("BaseColor"));
+
+    int32 GetNumVariants() const { return VariantMaterials.Num(); }
+
+private:
+    struct FVariantKey
+    {
+        UMaterialInterface* Base = nullptr;
+        FName Variant;
+
+        bool operator==(const FVariantKey& Other) const { return Base == Other.Base && Variant == Other.Variant; }
+        friend uint32 GetTypeHash(const FVariantKey& Key) { return HashCombine(::GetTypeHash(Key.Base), GetTypeHash(Key.Variant)); }
+    };
+
+    TMap<FVariantKey, UMaterialInstanceDynamic*> Variants;
+
+    /** Keeps the variants alive (Variants isn't reflected); each holds its base as parent */
+    UPROPERTY()
+    TArray<UMaterialInstanceDynamic*> VariantMaterials;
+};
@@ -0,0 +1,151 @@
+#include "PSOWarmupSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Engine/World.h"
+
+void UTowerPSOWarmupSubsystem::Deinitialize()
+{
+    ReleaseComponents();
+    if (IsValid(WarmupActor))
+    {
+        WarmupActor->Destroy();
+    }
+    WarmupActor = nullptr;
+    Warmed.Empty();
+    Super::Deinitialize();
+}
+
+bool UTowerPSOWarmupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AActor* UTowerPSOWarmupSubsystem::GetOrSpawnWarmupActor()
+{
+    if (IsValid(WarmupActor))
+    {
+        return WarmupActor;
+    }
+
+    FActorSpawnParameters Params;
+    Params.ObjectFlags |= RF_Transient;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    WarmupActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+    if (WarmupActor)
+    {
+        USceneComponent* Root = NewObject<USceneComponent>(WarmupActor, TEXT("Root"));
+        WarmupActor->SetRootComponent(Root);
+        Root->RegisterComponent();
+        WarmupActor->SetActorHiddenInGame(true);
+        WarmupActor->SetActorEnableCollision(false);
+    }
+    return WarmupActor;
+}
+
+void UTowerPSOWarmupSubsystem::BeginWarmup()
+{
+    if (bWarmingUp)
+    {
+        FinishWarmup();
+    }
+    bWarmingUp = true;
+}
+
+void UTowerPSOWarmupSubsystem::AddMesh(UStaticMesh* Mesh, UMaterialInterface* Material, bool bInstanced)
+{
+    if (!bWarmingUp || !Mesh) return;
+
+    const uint32 Key = HashCombine(HashCombine(GetTypeHash(Mesh), GetTypeHash(Material)), GetTypeHash(bInstanced));
+    bool bAlreadyWarmed = false;
+    Warmed.Add(Key, &bAlreadyWarmed);
+    if (bAlreadyWarmed) return;
+
+    AActor* Owner = GetOrSpawnWarmupActor();
+    if (!Owner) return;
+
+    // Instanced tiles use a different vertex factory than the same mesh on its own
+    UStaticMeshComponent* Comp = bInstanced
+        ? NewObject<UInstancedStaticMeshComponent>(Owner)
+        : NewObject<UStaticMeshComponent>(Owner);
+    Comp->SetStaticMesh(Mesh);
+    if (Material)
+    {
+        for (int32 Slot = 0; Slot < Mesh->GetStaticMaterials().Num(); Slot++)
+        {
+            Comp->SetMaterial(Slot, Material);
+        }
+    }
+    Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Comp->SetCanEverAffectNavigation(false);
+    Comp->SetCastShadow(false);
+    Comp->SetHiddenInGame(true);
+    Comp->SetupAttachment(Owner->GetRootComponent());
+
+    // Registration kicks off the precache
+    Comp->RegisterComponent();
+    Components.Add(Comp);
+    TotalRequested++;
+}
+
+void UTowerPSOWarmupSubsystem::AddNiagaraSystem(UNiagaraSystem* System)
+{
+    if (!bWarmingUp || !System) return;
+
+    bool bAlreadyWarmed = false;
+    Warmed.Add(GetTypeHash(System), &bAlreadyWarmed);
+    if (bAlreadyWarmed) return;
+
+    AActor* Owner = GetOrSpawnWarmupActor();
+    if (!Owner) return;
+
+    // Never activated: the renderers' PSOs are precached on register, nothing is simulated
+    UNiagaraComponent* Comp = NewObject<UNiagaraComponent>(Owner);
+    Comp->SetAutoActivate(false);
+    Comp->SetAsset(System);
+    Comp->SetHiddenInGame(true);
+    Comp->SetupAttachment(Owner->GetRootComponent());
+    Comp->RegisterComponent();
+    Components.Add(Comp);
+    TotalRequested++;
+}
+
+int32 UTowerPSOWarmupSubsystem::GetNumPending() const
+{
+    int32 NumPending = 0;
+    for (const UPrimitiveComponent* Comp : Components)
+    {
+        NumPending += IsValid(Comp) && Comp->IsPSOPrecaching() ? 1 : 0;
+    }
+    return NumPending;
+}
+
+int32 UTowerPSOWarmupSubsystem::FinishWarmup()
+{
+    if (!bWarmingUp) return 0;
+    bWarmingUp = false;
+
+    const int32 NumMissed = GetNumPending();
+    TotalMissed += NumMissed;
+    UE_LOG(LogTemp, Log, TEXT("PSO warm-up: %d precached, %d still compiling at fade-in"),
+        Components.Num() - NumMissed, NumMissed);
+
+    // Finished precaches stay in the PSO cache; the components were only there to start them
+    ReleaseComponents();
+    return NumMissed;
+}
+
+void UTowerPSOWarmupSubsystem::ReleaseComponents()
+{
+    for (UPrimitiveComponent* Comp : Components)
+    {
+        if (IsValid(Comp))
+        {
+            Comp->DestroyComponent();
+        }
+    }
+    Components.Reset();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PSOWarmupSubsystem.generated.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+class UNiagaraSystem;
+class UPrimitiveComponent;
+
+/**
+ * Precaches pipeline states for what the next floor will draw, behind the
+ * loading fade, so the first biome material, monster or effect on screen
+ * doesn't hitch on a PSO compile.
+ *
+ * The floor transition calls BeginWarmup, the GameMode adds the (mesh,
+ * material) pairs and Niagara systems from the generated layout, and each one
+ * becomes a hidden, collision-free component on a transient actor. Registering
+ * a component starts the engine's PSO precache for it (r.PSOPrecaching). At
+ * fade-in FinishWarmup counts the ones still compiling as misses and drops the
+ * components. A combination is only warmed once per world.
+ */
+UCLASS()
+class TOWERGAME_API UTowerPSOWarmupSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /** Start collecting a warm-up set; drops any unfinished one */
+    void BeginWarmup();
+
+    /** Precache Mesh drawn with Material (all its slots when null), as an instanced mesh if bInstanced */
+    void AddMesh(UStaticMesh* Mesh, UMaterialInterface* Material, bool bInstanced);
+
+    void AddNiagaraSystem(UNiagaraSystem* System);
+
+    /** Components of the current set still precaching */
+    int32 GetNumPending() const;
+
+    /** End the set; returns how many precaches hadn't finished (misses) */
+    int32 FinishWarmup();
+
+    bool IsWarmingUp() const { return bWarmingUp; }
+
+    /** Precaches started and missed over the world's lifetime */
+    int32 GetTotalRequested() const { return TotalRequested; }
+    int32 GetTotalMissed() const { return TotalMissed; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    AActor* GetOrSpawnWarmupActor();
+    void ReleaseComponents();
+
+    /** Hidden owner of the warm-up components */
+    UPROPERTY()
+    AActor* WarmupActor = nullptr;
+
+    UPROPERTY()
+    TArray<UPrimitiveComponent*> Components;
+
+    /** (mesh or system, material, instanced) already warmed in this world */
+    TSet<uint32> Warmed;
+
+    bool bWarmingUp = false;
+    int32 TotalRequested = 0;
+    int32 TotalMissed = 0;
+};
@@ -0,0 +1,214 @@
+#include "PerfScalerSubsystem.h"
+#include "CelShadingComponent.h"
+#include "ProceduralFloorRenderer.h"
+#include "VFXPoolSubsystem.h"
+#include "TowerGame/World/DestructionBudgetSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameUserSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectIterator.h"
+#include "RenderCore.h"
+#include "RHI.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogTowerScaler, Log, All);
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarScalerEnable(
+        TEXT("tower.Scaler.Enable"),
+        1,
+        TEXT("Step rendering and effect budgets down when frames run over target (UTowerPerfScalerSubsystem)"),
+        ECVF_Default);
+
+    TAutoConsoleVariable<float> CVarScalerTargetFPS(
+        TEXT("tower.Scaler.TargetFPS"),
+        0.0f,
+        TEXT("Frame rate the scaler holds; 0 = the applied FPS limit (60 when unlimited)"),
+        ECVF_Default);
+
+    TAutoConsoleVariable<int32> CVarScalerStep(
+        TEXT("tower.Scaler.Step"),
+        -1,
+        TEXT("Pin the scaler to a quality step (0 = as configured .. 3 = minimum); -1 = automatic"),
+        ECVF_Default);
+
+    /** Per ETowerQualityStep: post-process, room lights, fragments, VFX, screen percentage */
+    const FTowerQualityScales StepScales[static_cast<int32>(ETowerQualityStep::MAX)] =
+    {
+        { 1.0f,  1.0f,  1.0f,  1.0f,  1.0f  },
+        { 0.75f, 0.75f, 0.66f, 0.75f, 0.9f  },
+        { 0.5f,  0.5f,  0.4f,  0.5f,  0.8f  },
+        { 0.0f,  0.25f, 0.2f,  0.33f, 0.67f },
+    };
+
+    constexpr int32 MaxStep = static_cast<int32>(ETowerQualityStep::MAX) - 1;
+}
+
+void UTowerPerfScalerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    bEnabled = CVarScalerEnable.GetValueOnGameThread() != 0;
+    const UGameUserSettings* GameSettings = GEngine ? GEngine->GetGameUserSettings() : nullptr;
+    const float FrameRateLimit = GameSettings ? GameSettings->GetFrameRateLimit() : 0.0f;
+    TargetFrameMs = 1000.0f / (FrameRateLimit > 0.0f ? FrameRateLimit : 60.0f);
+
+    if (const IConsoleVariable* ScreenPercentage = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+    {
+        RenderScale = ScreenPercentage->GetFloat() > 0.0f ? ScreenPercentage->GetFloat() : 100.0f;
+    }
+}
+
+void UTowerPerfScalerSubsystem::Deinitialize()
+{
+    // Leave the next world the player's own screen percentage; the rest goes with this world
+    if (Step != ETowerQualityStep::Configured)
+    {
+        if (IConsoleVariable* ScreenPercentage = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+        {
+            ScreenPercentage->Set(RenderScale, ECVF_SetByCode);
+        }
+    }
+    Super::Deinitialize();
+}
+
+bool UTowerPerfScalerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerPerfScalerSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerPerfScalerSubsystem, STATGROUP_Tickables);
+}
+
+void UTowerPerfScalerSubsystem::Configure(bool bInEnabled, int32 TargetFPS, float RenderScalePercent)
+{
+    bEnabled = bInEnabled;
+    TargetFrameMs = 1000.0f / (TargetFPS > 0 ? TargetFPS : 60);
+    RenderScale = FMath::Clamp(RenderScalePercent, 50.0f, 200.0f);
+    OverSeconds = UnderSeconds = SettleRemaining = 0.0f;
+
+    // The next world starts the same way
+    CVarScalerEnable->Set(bEnabled ? 1 : 0, ECVF_SetByCode);
+
+    if (!bEnabled)
+    {
+        SetStep(ETowerQualityStep::Configured);
+    }
+    // A new render scale applies at the current step
+    ApplyScales();
+}
+
+FTowerQualityScales UTowerPerfScalerSubsystem::GetStepScales(ETowerQualityStep InStep)
+{
+    return StepScales[FMath::Clamp(static_cast<int32>(InStep), 0, MaxStep)];
+}
+
+void UTowerPerfScalerSubsystem::Tick(float DeltaTime)
+{
+    const int32 PinnedStep = CVarScalerStep.GetValueOnGameThread();
+    if (PinnedStep >= 0)
+    {
+        SetStep(static_cast<ETowerQualityStep>(FMath::Min(PinnedStep, MaxStep)));
+        return;
+    }
+    if (!bEnabled || DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    // Whichever side is holding the frame back; both are the previous frame's, as stat unit shows them
+    const float GameMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+    const float GpuMs = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+    const float FrameMs = FMath::Max(GameMs, GpuMs);
+    SmoothedFrameMs = SmoothedFrameMs > 0.0f ? FMath::Lerp(SmoothedFrameMs, FrameMs, SmoothingAlpha) : FrameMs;
+
+    const float TargetMs = CVarScalerTargetFPS.GetValueOnGameThread() > 0.0f
+        ? 1000.0f / CVarScalerTargetFPS.GetValueOnGameThread() : TargetFrameMs;
+
+    if (SettleRemaining > 0.0f)
+    {
+        SettleRemaining -= DeltaTime;
+        return;
+    }
+
+    const int32 Current = static_cast<int32>(Step);
+    if (SmoothedFrameMs > TargetMs * (1.0f + DownThreshold))
+    {
+        OverSeconds += DeltaTime;
+        UnderSeconds = 0.0f;
+        if (OverSeconds >= DownHoldSeconds && Current < MaxStep)
+        {
+            SetStep(static_cast<ETowerQualityStep>(Current + 1));
+        }
+    }
+    else if (SmoothedFrameMs < TargetMs * (1.0f - UpThreshold))
+    {
+        UnderSeconds += DeltaTime;
+        OverSeconds = 0.0f;
+        if (UnderSeconds >= UpHoldSeconds && Current > 0)
+        {
+            SetStep(static_cast<ETowerQualityStep>(Current - 1));
+        }
+    }
+    else
+    {
+        // Inside the band: neither direction builds up
+        OverSeconds = UnderSeconds = 0.0f;
+    }
+}
+
+void UTowerPerfScalerSubsystem::SetStep(ETowerQualityStep NewStep)
+{
+    if (NewStep == Step)
+    {
+        return;
+    }
+
+    UE_LOG(LogTowerScaler, Log, TEXT("Quality step %d -> %d (frame %.1f ms, target %.1f ms)"),
+        static_cast<int32>(Step), static_cast<int32>(NewStep), SmoothedFrameMs, TargetFrameMs);
+    Step = NewStep;
+    Scales = GetStepScales(Step);
+    OverSeconds = UnderSeconds = 0.0f;
+    SettleRemaining = SettleSeconds;
+    ApplyScales();
+}
+
+void UTowerPerfScalerSubsystem::ApplyScales()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // Steps change every few seconds at most, so finding the components each time is fine
+    for (TObjectIterator<UCelShadingComponent> It; It; ++It)
+    {
+        if (It->GetWorld() == World)
+        {
+            It->SetQualityScale(Scales.PostProcess);
+        }
+    }
+    for (TActorIterator<ATowerProceduralFloorRenderer> It(World); It; ++It)
+    {
+        It->SetRoomLightBudgetScale(Scales.RoomLights);
+    }
+    if (UTowerDestructionBudgetSubsystem* Destruction = World->GetSubsystem<UTowerDestructionBudgetSubsystem>())
+    {
+        Destruction->BudgetScale = Scales.Fragments;
+    }
+    if (UTowerVFXPoolSubsystem* VFXPool = World->GetSubsystem<UTowerVFXPoolSubsystem>())
+    {
+        VFXPool->BudgetScale = Scales.VFX;
+    }
+
+    if (IConsoleVariable* ScreenPercentage = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+    {
+        ScreenPercentage->Set(RenderScale * Scales.ScreenPercentage, ECVF_SetByCode);
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PerfScalerSubsystem.generated.h"
+
+/** How far the scaler has stepped below the player's graphics settings */
+UENUM(BlueprintType)
+enum class ETowerQualityStep : uint8
+{
+    Configured  UMETA(DisplayName = "As Configured"),
+    Reduced     UMETA(DisplayName = "Reduced"),
+    Low         UMETA(DisplayName = "Low"),
+    Minimum     UMETA(DisplayName = "Minimum"),
+
+    MAX         UMETA(Hidden)
+};
+
+/** Multipliers a quality step applies to the configured budgets; 1 everywhere at Configured */
+struct FTowerQualityScales
+{
+    /** UCelShadingComponent outline thickness and bloom */
+    float PostProcess = 1.0f;
+
+    /** FFloorRenderConfig::MaxActiveRoomLights */
+    float RoomLights = 1.0f;
+
+    /** UTowerDestructionBudgetSubsystem::MaxActiveFragments */
+    float Fragments = 1.0f;
+
+    /** UTowerVFXPoolSubsystem group caps and instances per system */
+    float VFX = 1.0f;
+
+    /** Of the player's render scale */
+    float ScreenPercentage = 1.0f;
+};
+
+/**
+ * Frame-time governor. Watches the slower of the game thread and the GPU each
+ * frame, smoothed, against the target frame time and steps through
+ * ETowerQualityStep: cel-shading outline and bloom, the room light budget, the
+ * debris fragment budget, VFX concurrency and screen percentage all scale down
+ * together, and come back one step at a time once there is headroom again.
+ *
+ * Hysteresis keeps it from oscillating: stepping down needs the frame over
+ * target by DownThreshold for DownHoldSeconds, stepping up needs it under by
+ * UpThreshold for UpHoldSeconds, and nothing moves for SettleSeconds after a
+ * step while the new settings take effect.
+ *
+ * Each world starts from tower.Scaler.Enable, the game user settings' frame rate
+ * limit and the current r.ScreenPercentage. UGraphicsSettingsWidget reconfigures
+ * it when settings are applied: the FPS limit is the target, the render scale the
+ * screen percentage at Configured, and bDynamicQuality switches it on.
+ * tower.Scaler.TargetFPS overrides the target; tower.Scaler.Step pins a step.
+ */
+UCLASS()
+class TOWERGAME_API UTowerPerfScalerSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** From the applied graphics settings; TargetFPS <= 0 uses 60. Disabling returns to Configured. */
+    void Configure(bool bInEnabled, int32 TargetFPS, float RenderScalePercent);
+
+    UFUNCTION(BlueprintPure, Category = "Tower|Perf")
+    ETowerQualityStep GetStep() const { return Step; }
+
+    const FTowerQualityScales& GetScales() const { return Scales; }
+
+    /** Smoothed max(game thread, GPU) frame time in ms */
+    UFUNCTION(BlueprintPure, Category = "Tower|Perf")
+    float GetSmoothedFrameMs() const { return SmoothedFrameMs; }
+
+    /** Multipliers for a step, from the table in the .cpp */
+    static FTowerQualityScales GetStepScales(ETowerQualityStep InStep);
+
+    // ============ Config ============
+
+    /** Over target by this fraction (0.1 = 10%) counts toward stepping down */
+    float DownThreshold = 0.1f;
+
+    /** Under target by this fraction counts toward stepping up */
+    float UpThreshold = 0.25f;
+
+    float DownHoldSeconds = 1.0f;
+    float UpHoldSeconds = 5.0f;
+    float SettleSeconds = 2.0f;
+
+    /** Weight of the newest frame in the smoothed frame time */
+    float SmoothingAlpha = 0.1f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void SetStep(ETowerQualityStep NewStep);
+
+    /** Push Scales to everything it governs in this world */
+    void ApplyScales();
+
+    bool bEnabled = false;
+    float TargetFrameMs = 1000.0f / 60.0f;
+    float RenderScale = 100.0f;
+
+    ETowerQualityStep Step = ETowerQualityStep::Configured;
+    FTowerQualityScales Scales;
+
+    float SmoothedFrameMs = 0.0f;
+    float OverSeconds = 0.0f;
+    float UnderSeconds = 0.0f;
+    float SettleRemaining = 0.0f;
+};
@@ -1,22 +1,53 @@
 #include "ProceduralFloorRenderer.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/PointLightComponent.h"
 #include "Components/BoxComponent.h"
+#include "ProceduralMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInterface.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "UObject/ConstructorHelpers.h"
 #include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Network/ProtobufBridge.h"
+#include "Network/GRPCClientManager.h"
+#include "Core/PackedTileGrid.h"
+#include "Core/PerfCounters.h"
+#include "PSOWarmupSubsystem.h"
+#include "PerfScalerSubsystem.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogFloorRenderer, Log, All);
 
+namespace
+{
+	void ReleaseStreamable(TSharedPtr<FStreamableHandle>& Handle)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->ReleaseHandle();
+			Handle.Reset();
+		}
+	}
+}
+
 // ============================================================================
 // Constructor & Lifecycle
 // ============================================================================
 
 ATowerProceduralFloorRenderer::ATowerProceduralFloorRenderer()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// Ticks only while room lights fade (see UpdateRoomLightBudget)
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 	RootComponent = SceneRoot;
@@ -28,6 +59,20 @@ ATowerProceduralFloorRenderer::ATowerProceduralFloorRenderer()
 	{
 		FallbackCubeMesh = CubeFinder.Object;
 	}
+
+	// Starting looks for the common biome tags; tune per project in the editor
+	auto AddBiomeStyle = [this](const TCHAR* Tag, const FLinearColor& Tint, float Emissive)
+	{
+		FBiomeInstanceStyle& Style = BiomeStyles.Add(Tag);
+		Style.Tint = Tint;
+		Style.Emissive = Emissive;
+	};
+	AddBiomeStyle(TEXT("stone"),   FLinearColor(0.85f, 0.82f, 0.78f), 0.0f);
+	AddBiomeStyle(TEXT("moss"),    FLinearColor(0.55f, 0.8f, 0.45f), 0.0f);
+	AddBiomeStyle(TEXT("crystal"), FLinearColor(0.6f, 0.7f, 1.0f), 0.6f);
+	AddBiomeStyle(TEXT("void"),    FLinearColor(0.4f, 0.2f, 0.6f), 0.3f);
+	AddBiomeStyle(TEXT("fire"),    FLinearColor(1.0f, 0.6f, 0.35f), 0.5f);
+	AddBiomeStyle(TEXT("ice"),     FLinearColor(0.75f, 0.9f, 1.0f), 0.1f);
 }
 
 void ATowerProceduralFloorRenderer::BeginPlay()
@@ -39,11 +84,32 @@ void ATowerProceduralFloorRenderer::BeginPlay()
 		RenderConfig.WallHeight,
 		RenderConfig.bEnableNanite ? TEXT("ON") : TEXT("OFF"),
 		RenderConfig.bEnableLumen ? TEXT("ON") : TEXT("OFF"));
+
+	if (RenderConfig.ChunkViewDistance > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(ChunkVisibilityTimer, this, &ATowerProceduralFloorRenderer::UpdateChunkVisibility,
+			RenderConfig.ChunkVisibilityInterval, /*bLoop=*/true);
+	}
+
+	if (const UTowerPerfScalerSubsystem* Scaler = GetWorld()->GetSubsystem<UTowerPerfScalerSubsystem>())
+	{
+		RoomLightBudgetScale = Scaler->GetScales().RoomLights;
+	}
+
+	if (RenderConfig.MaxActiveRoomLights > 0)
+	{
+		GetWorldTimerManager().SetTimer(RoomLightBudgetTimer, this, &ATowerProceduralFloorRenderer::UpdateRoomLightBudget,
+			RenderConfig.RoomLightBudgetInterval, /*bLoop=*/true);
+	}
 }
 
 void ATowerProceduralFloorRenderer::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	GetWorldTimerManager().ClearTimer(ChunkVisibilityTimer);
+	GetWorldTimerManager().ClearTimer(RoomLightBudgetTimer);
 	ClearFloor();
+	ReleaseStreamable(BiomeMaterialHandle);
+	ReleaseStreamable(PrefetchedBiomeHandle);
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -55,6 +121,9 @@ void ATowerProceduralFloorRenderer::GenerateFloorFromData(
 	const TArray<FTileRenderData>& Tiles,
 	const TArray<FRoomRenderData>& Rooms)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_Generate);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	TOWER_PERF_SCOPE(FloorBuild);
 	ClearFloor();
 
 	if (Tiles.Num() == 0)
@@ -66,360 +135,1753 @@ void ATowerProceduralFloorRenderer::GenerateFloorFromData(
 	UE_LOG(LogFloorRenderer, Log, TEXT("Generating floor: %d tiles, %d rooms"), Tiles.Num(), Rooms.Num());
 
 	// Cache room data for later queries
-	CachedRooms = Rooms;
+	AssignRooms(Rooms);
 
-	// ---- Phase 1: Group tiles by type for batched instanced rendering ----
+	// ---- Phase 1-2: Group tiles by type and add them as ISM instances ----
 
-	TMap<ETowerTileType, TArray<const FTileRenderData*>> TilesByType;
-	for (const FTileRenderData& Tile : Tiles)
+	AddTileInstances(Tiles);
+
+	// ---- Phase 3: Room lighting ----
+
+	for (const FRoomRenderData& Room : Rooms)
 	{
-		if (Tile.TileType == ETowerTileType::Empty)
+		AddRoomLight(Room);
+	}
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Floor generated: %d tile instances, %d ISM components, %d room lights"),
+		TotalRenderedTiles, TileInstances.Num(), RoomLights.Num());
+
+	CompleteFloor();
+}
+
+bool ATowerProceduralFloorRenderer::GenerateFloorFromPackedGrid(const FPackedTileGrid& Grid, const TArray<FRoomRenderData>& Rooms)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_GeneratePacked);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	TOWER_PERF_SCOPE(FloorBuild);
+	ClearFloor();
+
+	if (Grid.IsEmpty())
+	{
+		UE_LOG(LogFloorRenderer, Warning, TEXT("GenerateFloorFromPackedGrid called with an empty grid"));
+		return false;
+	}
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Generating packed floor: %dx%d, %d run bytes, %d rooms"),
+		Grid.Width, Grid.Height, Grid.Runs.Num(), Rooms.Num());
+
+	AssignRooms(Rooms);
+	CellGrid.Include(FIntPoint::ZeroValue, FIntPoint(Grid.Width - 1, Grid.Height - 1));
+
+	StreamTileScratch.Reset(Grid.Num());
+	const int32 Width = Grid.Width;
+	const bool bDecoded = Grid.ForEachRun([this, Width](int32 Start, int32 Count, uint8 TileType)
+	{
+		if (TileType == static_cast<uint8>(ETowerTileType::Empty))
 		{
-			continue; // Skip empty tiles — no geometry needed
+			return;
+		}
+
+		const ETowerTileType Type = TileType < static_cast<uint8>(ETowerTileType::MAX)
+			? static_cast<ETowerTileType>(TileType)
+			: ETowerTileType::Empty;
+		for (int32 Index = Start; Index < Start + Count; ++Index)
+		{
+			FTileRenderData& Tile = StreamTileScratch.AddDefaulted_GetRef();
+			Tile.X = Index % Width;
+			Tile.Y = Index / Width;
+			Tile.TileType = Type;
 		}
+	});
+
+	if (!bDecoded)
+	{
+		UE_LOG(LogFloorRenderer, Warning, TEXT("Packed floor grid is malformed"));
+		StreamTileScratch.Reset();
+		ClearFloor();
+		return false;
+	}
 
-		TilesByType.FindOrAdd(Tile.TileType).Add(&Tile);
+	AddTileInstances(StreamTileScratch);
+	StreamTileScratch.Reset();
 
-		// Record in tile grid for runtime queries and mutations
-		int64 Key = PackGridKey(Tile.X, Tile.Y);
-		TileGrid.Add(Key, Tile.TileType);
+	for (const FRoomRenderData& Room : Rooms)
+	{
+		AddRoomLight(Room);
 	}
 
-	// ---- Phase 2: Create ISM components and add instances per type ----
+	UE_LOG(LogFloorRenderer, Log, TEXT("Floor generated: %d tile instances, %d ISM components, %d room lights"),
+		TotalRenderedTiles, TileInstances.Num(), RoomLights.Num());
+
+	CompleteFloor();
+	return true;
+}
+
+// ============================================================================
+// Time-Sliced Floors
+// ============================================================================
+
+void ATowerProceduralFloorRenderer::BeginTimeSlicedFloor(const TArray<FTileRenderData>& Tiles, const TArray<FRoomRenderData>& Rooms)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_BeginTimeSliced);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	ClearFloor();
+
+	AssignRooms(Rooms);
+	SlicedTiles = Tiles;
+	BuildPhase = ETimeSlicedFloorPhase::Instances;
+	BuildCursor = 0;
+	BuildTimings = FFloorBuildTimings();
+	bDeferCollision = true;
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Time-sliced floor: %d tiles, %d rooms"), Tiles.Num(), Rooms.Num());
+}
 
-	int32 InstanceCount = 0;
+bool ATowerProceduralFloorRenderer::TickTimeSlicedFloor(double BudgetSeconds)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_TickTimeSliced);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	TOWER_PERF_SCOPE(FloorBuild);
+	const bool bUnbounded = BudgetSeconds <= 0.0;
+	const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
 
-	for (auto& Pair : TilesByType)
+	while (BuildPhase != ETimeSlicedFloorPhase::Idle)
 	{
-		ETowerTileType TileType = Pair.Key;
-		const TArray<const FTileRenderData*>& TypeTiles = Pair.Value;
+		const ETimeSlicedFloorPhase Phase = BuildPhase;
+		const double StepStart = FPlatformTime::Seconds();
+		const bool bContinue = StepTimeSlicedFloor(bUnbounded);
+		const double StepSeconds = FPlatformTime::Seconds() - StepStart;
 
-		UInstancedStaticMeshComponent* ISM = GetOrCreateISMForType(TileType);
-		if (!ISM)
+		switch (Phase)
 		{
-			UE_LOG(LogFloorRenderer, Error, TEXT("Failed to create ISM for tile type %d"), static_cast<int32>(TileType));
-			continue;
+		case ETimeSlicedFloorPhase::Instances:  BuildTimings.InstancesSeconds += StepSeconds; break;
+		case ETimeSlicedFloorPhase::Collision:  BuildTimings.CollisionSeconds += StepSeconds; break;
+		case ETimeSlicedFloorPhase::BakeChunks: BuildTimings.BakeSeconds += StepSeconds; break;
+		case ETimeSlicedFloorPhase::Lights:     BuildTimings.LightsSeconds += StepSeconds; break;
+		case ETimeSlicedFloorPhase::Navigation: BuildTimings.NavigationSeconds += StepSeconds; break;
+		default: break;     // The wait is counted as wall time when it ends
+		}
+
+		if (!bContinue || (!bUnbounded && FPlatformTime::Seconds() >= Deadline))
+		{
+			break;
+		}
+	}
+	return BuildPhase == ETimeSlicedFloorPhase::Idle;
+}
+
+bool ATowerProceduralFloorRenderer::StepTimeSlicedFloor(bool bUnbounded)
+{
+	switch (BuildPhase)
+	{
+	case ETimeSlicedFloorPhase::Instances:
+	{
+		const int32 Count = FMath::Min(FMath::Max(TimeSlicedTilesPerStep, 1), SlicedTiles.Num() - BuildCursor);
+		AddTileInstances(TArrayView<const FTileRenderData>(SlicedTiles).Slice(BuildCursor, Count));
+		BuildCursor += Count;
+		if (BuildCursor >= SlicedTiles.Num())
+		{
+			SlicedTiles.Reset();
+			BuildPhase = ETimeSlicedFloorPhase::Collision;
+			BuildCursor = 0;
 		}
+		return true;
+	}
 
-		// Find which room each tile belongs to for biome material assignment
-		// Use the first tile's room biome as the material for the entire ISM batch.
-		// For per-room material variation, split ISMs by (type, biome) key.
-		TArray<FString> PrimaryBiomeTags;
-		if (Rooms.Num() > 0)
+	case ETimeSlicedFloorPhase::Collision:
+		if (TileInstances.IsValidIndex(BuildCursor))
 		{
-			// Use the biome from the first tile's room
-			const FTileRenderData* FirstTile = TypeTiles[0];
-			FRoomRenderData FirstRoom;
-			if (GetRoomAtGrid(FirstTile->X, FirstTile->Y, FirstRoom))
+			// A whole ISM per step: enabling collision creates the bodies of all its
+			// instances at once, which chunking keeps to one chunk's worth
+			ConfigureCollision(TileInstances[BuildCursor], ISMTileTypes[BuildCursor]);
+			if (TileInstances[BuildCursor]->CanEverAffectNavigation())
 			{
-				PrimaryBiomeTags = FirstRoom.BiomeTags;
+				// Nav geometry comes from collision, which this ISM only has now
+				DirtyNavigation(TileInstances[BuildCursor]->Bounds.GetBox());
 			}
+			BuildCursor++;
+			return true;
 		}
-
-		// Assign biome material if available
-		UMaterialInterface* BiomeMat = ResolveBiomeMaterial(PrimaryBiomeTags);
-		if (BiomeMat)
+		bDeferCollision = false;
+		BuildPhase = ETimeSlicedFloorPhase::BakeChunks;
+		BuildCursor = 0;
+		return true;
+
+	case ETimeSlicedFloorPhase::BakeChunks:
+		// One chunk per step
+		while (Chunks.IsValidIndex(BuildCursor))
 		{
-			ISM->SetMaterial(0, BiomeMat);
+			const int32 ChunkIdx = BuildCursor++;
+			if (Chunks[ChunkIdx].bCollisionDirty || Chunks[ChunkIdx].bWallMeshDirty)
+			{
+				if (Chunks[ChunkIdx].bCollisionDirty)
+				{
+					BakeChunkCollision(ChunkIdx);
+				}
+				if (Chunks[ChunkIdx].bWallMeshDirty)
+				{
+					BakeChunkWallMesh(ChunkIdx);
+				}
+				return true;
+			}
 		}
-		else if (DefaultMaterial)
+		BuildPhase = ETimeSlicedFloorPhase::Lights;
+		BuildCursor = 0;
+		return true;
+
+	case ETimeSlicedFloorPhase::Lights:
+		if (CachedRooms.IsValidIndex(BuildCursor))
 		{
-			ISM->SetMaterial(0, DefaultMaterial);
+			AddRoomLight(CachedRooms[BuildCursor]);
+			BuildCursor++;
+			return true;
 		}
+		BuildPhase = ETimeSlicedFloorPhase::Navigation;
+		return true;
 
-		// Batch-add all instances of this type
-		int32 ISMIdx = TypeToISMIndex.FindChecked(TileType);
+	case ETimeSlicedFloorPhase::Navigation:
+		if (IsNavigationDynamic())
+		{
+			// The collision phase dirtied every chunk; runtime generation rebuilds those
+			// nav tiles on worker threads. A budgeted build waits for them, an
+			// unbounded one doesn't block on async work.
+			if (!bUnbounded)
+			{
+				BuildPhase = ETimeSlicedFloorPhase::WaitForNavigation;
+				NavigationWaitStart = FPlatformTime::Seconds();
+				return false;
+			}
+		}
+		else if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_BuildNavigation);
+			NavSys->Build();
+		}
+		break;
 
-		for (const FTileRenderData* TilePtr : TypeTiles)
+	case ETimeSlicedFloorPhase::WaitForNavigation:
+	{
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+		if (NavSys && NavSys->IsNavigationBuildInProgress())
 		{
-			FTransform Transform = BuildTileTransform(TilePtr->X, TilePtr->Y, TileType);
-			int32 InstIdx = ISM->AddInstance(Transform, /*bWorldSpace=*/false);
+			return false;
+		}
+		BuildTimings.NavigationSeconds += FPlatformTime::Seconds() - NavigationWaitStart;
+		break;
+	}
+
+	default:
+		return false;
+	}
 
-			int64 Key = PackGridKey(TilePtr->X, TilePtr->Y);
-			GridToInstanceMap.Add(Key, TPair<int32, int32>(ISMIdx, InstIdx));
+	BuildPhase = ETimeSlicedFloorPhase::Idle;
+	UE_LOG(LogFloorRenderer, Log, TEXT("Time-sliced floor complete: %d tile instances, %d ISM components, %d room lights"),
+		TotalRenderedTiles, TileInstances.Num(), RoomLights.Num());
+	OnFloorGenerated.Broadcast(TotalRenderedTiles);
+	return false;
+}
 
-			InstanceCount++;
+int32 ATowerProceduralFloorRenderer::EstimateDrawCalls() const
+{
+	int32 DrawCalls = 0;
+	for (const UInstancedStaticMeshComponent* ISM : TileInstances)
+	{
+		if (ISM && ISM->GetInstanceCount() > 0)
+		{
+			DrawCalls += ISM->GetNumMaterials();
+		}
+	}
+	for (const UProceduralMeshComponent* WallMesh : ChunkWallMeshes)
+	{
+		if (WallMesh)
+		{
+			DrawCalls += WallMesh->GetNumSections();
 		}
+	}
+	return DrawCalls;
+}
 
-		UE_LOG(LogFloorRenderer, Verbose, TEXT("  Type %d: %d instances"), static_cast<int32>(TileType), TypeTiles.Num());
+float ATowerProceduralFloorRenderer::GetTimeSlicedProgress() const
+{
+	// Rough cost split: instances dominate, then collision bodies, lights, navigation
+	switch (BuildPhase)
+	{
+	case ETimeSlicedFloorPhase::Instances:
+		return 0.6f * BuildCursor / FMath::Max(SlicedTiles.Num(), 1);
+	case ETimeSlicedFloorPhase::Collision:
+		return 0.6f + 0.1f * BuildCursor / FMath::Max(TileInstances.Num(), 1);
+	case ETimeSlicedFloorPhase::BakeChunks:
+		return 0.7f + 0.1f * BuildCursor / FMath::Max(Chunks.Num(), 1);
+	case ETimeSlicedFloorPhase::Lights:
+		return 0.8f + 0.1f * BuildCursor / FMath::Max(CachedRooms.Num(), 1);
+	case ETimeSlicedFloorPhase::Navigation:
+	case ETimeSlicedFloorPhase::WaitForNavigation:
+		return 0.9f;
+	default:
+		return 1.0f;
 	}
+}
 
-	TotalRenderedTiles = InstanceCount;
+// ============================================================================
+// Streamed Floors
+// ============================================================================
 
-	// ---- Phase 3: Room lighting ----
+void ATowerProceduralFloorRenderer::BeginStreamedFloor(const TArray<FRoomRenderData>& Rooms)
+{
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	ClearFloor();
 
+	AssignRooms(Rooms);
+	bStreamingFloor = true;
+
+	// Lights go up front so the floor is lit as soon as the first rows land
 	for (const FRoomRenderData& Room : Rooms)
 	{
-		UPointLightComponent* Light = SpawnRoomLight(Room);
-		if (Light)
-		{
-			RoomLights.Add(Light);
-		}
+		AddRoomLight(Room);
 	}
 
-	UE_LOG(LogFloorRenderer, Log, TEXT("Floor generated: %d tile instances, %d ISM components, %d room lights"),
-		TotalRenderedTiles, TileInstances.Num(), RoomLights.Num());
+	UE_LOG(LogFloorRenderer, Log, TEXT("Streaming floor: %d rooms, waiting for tiles"), Rooms.Num());
+}
 
-	// Update navigation mesh
-	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-	if (NavSys)
+void ATowerProceduralFloorRenderer::AppendTileBatch(const TArray<FTileRenderData>& Tiles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_AppendTileBatch);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	if (!bStreamingFloor)
 	{
-		NavSys->Build();
+		UE_LOG(LogFloorRenderer, Warning, TEXT("AppendTileBatch called without BeginStreamedFloor"));
+		return;
 	}
 
-	OnFloorGenerated.Broadcast(TotalRenderedTiles);
+	AddTileInstances(Tiles);
 }
 
-void ATowerProceduralFloorRenderer::ClearFloor()
+void ATowerProceduralFloorRenderer::FinishStreamedFloor()
 {
-	// Destroy all ISM components
-	for (UInstancedStaticMeshComponent* ISM : TileInstances)
+	if (!bStreamingFloor)
 	{
-		if (ISM)
-		{
-			ISM->ClearInstances();
-			ISM->DestroyComponent();
-		}
+		return;
 	}
-	TileInstances.Empty();
-	TypeToISMIndex.Empty();
-	GridToInstanceMap.Empty();
+	bStreamingFloor = false;
 
-	// Destroy all room lights
-	for (UPointLightComponent* Light : RoomLights)
+	UE_LOG(LogFloorRenderer, Log, TEXT("Streamed floor complete: %d tile instances, %d ISM components, %d room lights"),
+		TotalRenderedTiles, TileInstances.Num(), RoomLights.Num());
+
+	CompleteFloor();
+}
+
+void ATowerProceduralFloorRenderer::BeginChunkStream(const TArray<FRoomRenderData>& Rooms)
+{
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	// Fresh decoder per stream so ChunkStreamRowsPerBatch edits take effect
+	ChunkStream = MakeShared<FChunkStreamDecoder>(ChunkStreamRowsPerBatch);
+	ChunkStream->OnTileBatch.BindUObject(this, &ATowerProceduralFloorRenderer::OnChunkTileBatch);
+
+	BeginStreamedFloor(Rooms);
+}
+
+bool ATowerProceduralFloorRenderer::ReceiveChunkBytes(TArrayView<const uint8> Bytes)
+{
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	if (!ChunkStream.IsValid() || !bStreamingFloor)
 	{
-		if (Light)
-		{
-			Light->DestroyComponent();
-		}
+		return false;
 	}
-	RoomLights.Empty();
-
-	// Clear state
-	TileGrid.Empty();
-	CachedRooms.Empty();
-	TotalRenderedTiles = 0;
 
-	UE_LOG(LogFloorRenderer, Log, TEXT("Floor cleared"));
+	if (!ChunkStream->Feed(Bytes))
+	{
+		UE_LOG(LogFloorRenderer, Warning, TEXT("Chunk stream malformed after %d tiles"), ChunkStream->GetTilesDecoded());
+		return false;
+	}
+	return true;
 }
 
-void ATowerProceduralFloorRenderer::UpdateTileState(int32 X, int32 Y, ETowerTileType NewType)
+bool ATowerProceduralFloorRenderer::EndChunkStream()
 {
-	int64 Key = PackGridKey(X, Y);
+	if (!ChunkStream.IsValid() || !bStreamingFloor)
+	{
+		return false;
+	}
 
-	// Remove old instance if it exists
-	if (GridToInstanceMap.Contains(Key))
+	const bool bDecoded = ChunkStream->Finish();
+	const bool bValid = bDecoded && ChunkStream->IsHashValid();
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Chunk stream ended: floor_id=%d, %d tiles, hash %s"),
+		ChunkStream->GetChunk().FloorId, ChunkStream->GetTilesDecoded(), bValid ? TEXT("OK") : TEXT("INVALID"));
+
+	FinishStreamedFloor();
+	return bValid;
+}
+
+int64 ATowerProceduralFloorRenderer::StreamFloorChunk(UTowerGRPCClientManager* Client, int64 TowerSeed, int32 FloorId,
+	const TArray<FRoomRenderData>& Rooms)
+{
+	if (!Client)
 	{
-		TPair<int32, int32> OldMapping = GridToInstanceMap[Key];
-		int32 OldISMIdx = OldMapping.Key;
-		int32 OldInstIdx = OldMapping.Value;
+		return 0;
+	}
 
-		if (TileInstances.IsValidIndex(OldISMIdx) && TileInstances[OldISMIdx])
-		{
-			UInstancedStaticMeshComponent* OldISM = TileInstances[OldISMIdx];
+	BeginChunkStream(Rooms);
+	const uint32 Serial = ++ChunkDownloadSerial;
 
-			// Remove instance — note: this swaps the last instance into this slot
-			if (OldInstIdx < OldISM->GetInstanceCount())
+	TWeakObjectPtr<ATowerProceduralFloorRenderer> WeakThis(this);
+	return Client->RequestFloorChunk(TowerSeed, FloorId,
+		FOnGRPCBytesReceived::CreateLambda([WeakThis, Serial](TArrayView<const uint8> Bytes)
+		{
+			if (WeakThis.IsValid() && WeakThis->ChunkDownloadSerial == Serial)
 			{
-				OldISM->RemoveInstance(OldInstIdx);
-				TotalRenderedTiles--;
-
-				// Fix up the mapping for the instance that was swapped in
-				// After RemoveInstance(i), instance at (Count-1) is now at i
-				int32 SwappedFromIdx = OldISM->GetInstanceCount(); // was Count-1 before removal, now at OldInstIdx
-				if (OldInstIdx < OldISM->GetInstanceCount())
-				{
-					// Find which grid key pointed to SwappedFromIdx and update it
-					for (auto& MapPair : GridToInstanceMap)
-					{
-						if (MapPair.Value.Key == OldISMIdx && MapPair.Value.Value == SwappedFromIdx)
-						{
-							MapPair.Value.Value = OldInstIdx;
-							break;
-						}
-					}
-				}
+				WeakThis->ReceiveChunkBytes(Bytes);
 			}
-		}
+		}),
+		FOnGRPCStreamComplete::CreateLambda([WeakThis, Serial, FloorId](bool bSuccess)
+		{
+			if (!WeakThis.IsValid() || WeakThis->ChunkDownloadSerial != Serial)
+			{
+				return;
+			}
+			if (!bSuccess)
+			{
+				UE_LOG(LogFloorRenderer, Warning, TEXT("Floor %d download failed, keeping the rows received"), FloorId);
+			}
+			WeakThis->EndChunkStream();
+		}));
+}
 
-		GridToInstanceMap.Remove(Key);
+void ATowerProceduralFloorRenderer::OnChunkTileBatch(TArrayView<const FProtoFloorTileData> Tiles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_ChunkTileBatch);
+	TOWER_PERF_SCOPE(FloorBuild);
+	StreamTileScratch.Reset(Tiles.Num());
+	for (const FProtoFloorTileData& ProtoTile : Tiles)
+	{
+		FTileRenderData& Tile = StreamTileScratch.AddDefaulted_GetRef();
+		Tile.X = ProtoTile.GridX;
+		Tile.Y = ProtoTile.GridY;
+		Tile.TileType = ProtoTile.TileType >= 0 && ProtoTile.TileType < static_cast<int32>(ETowerTileType::MAX)
+			? static_cast<ETowerTileType>(ProtoTile.TileType)
+			: ETowerTileType::Empty;
 	}
 
-	// Update the grid
-	if (NewType == ETowerTileType::Empty)
+	AddTileInstances(StreamTileScratch);
+}
+
+void ATowerProceduralFloorRenderer::AddTileInstances(TArrayView<const FTileRenderData> Tiles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_AddTileInstances);
+	// Grow the cell grid once for the whole batch rather than per tile
+	if (Tiles.Num() > 0)
 	{
-		TileGrid.Remove(Key);
+		FIntPoint Min(MAX_int32, MAX_int32);
+		FIntPoint Max(MIN_int32, MIN_int32);
+		for (const FTileRenderData& Tile : Tiles)
+		{
+			Min = Min.ComponentMin(FIntPoint(Tile.X, Tile.Y));
+			Max = Max.ComponentMax(FIntPoint(Tile.X, Tile.Y));
+		}
+		CellGrid.Include(Min, Max);
 	}
-	else
+
+	// Group by destination ISM, i.e. by (chunk, tile type)
+	TArray<FTileInstanceBatch, TInlineAllocator<16>> Batches;
+	TMap<int32, int32, TInlineSetAllocator<16>> BatchByISM;
+	for (const FTileRenderData& Tile : Tiles)
 	{
-		TileGrid.Add(Key, NewType);
+		if (Tile.TileType == ETowerTileType::Empty)
+		{
+			continue; // Skip empty tiles — no geometry needed
+		}
 
-		// Add new instance
-		UInstancedStaticMeshComponent* ISM = GetOrCreateISMForType(NewType);
-		if (ISM)
+		// Record in the cell grid for runtime queries and mutations
+		CellGrid.SetType(Tile.X, Tile.Y, Tile.TileType);
+
+		if (Tile.TileType == ETowerTileType::Wall && UsesGreedyWalls())
 		{
-			FTransform Transform = BuildTileTransform(X, Y, NewType);
-			int32 ISMIdx = TypeToISMIndex.FindChecked(NewType);
-			int32 InstIdx = ISM->AddInstance(Transform, /*bWorldSpace=*/false);
+			// No instance; the chunk's wall mesh is rebuilt from CellGrid
+			NoteChunkTile(GetOrCreateChunk(Tile.X, Tile.Y), Tile.X, Tile.Y, Tile.TileType);
+			continue;
+		}
 
-			GridToInstanceMap.Add(Key, TPair<int32, int32>(ISMIdx, InstIdx));
-			TotalRenderedTiles++;
+		const int32 ISMIdx = GetOrCreateISM(Tile.TileType, Tile.X, Tile.Y);
+		if (ISMIdx == INDEX_NONE)
+		{
+			UE_LOG(LogFloorRenderer, Error, TEXT("Failed to create ISM for tile type %d"), static_cast<int32>(Tile.TileType));
+			continue;
+		}
+		int32& BatchIdx = BatchByISM.FindOrAdd(ISMIdx, INDEX_NONE);
+		if (BatchIdx == INDEX_NONE)
+		{
+			BatchIdx = Batches.AddDefaulted();
+			Batches[BatchIdx].ISMIdx = ISMIdx;
 		}
+		Batches[BatchIdx].Tiles.Add(&Tile);
+		NoteChunkTile(ISMChunks[ISMIdx], Tile.X, Tile.Y, Tile.TileType);
 	}
 
-	OnTileMutated.Broadcast(X, Y, NewType);
-
-	UE_LOG(LogFloorRenderer, Verbose, TEXT("Tile (%d,%d) mutated to %d"), X, Y, static_cast<int32>(NewType));
-}
+	BuildInstanceBatches(Batches);
 
-void ATowerProceduralFloorRenderer::SpawnMonsterVisuals(const TArray<FMonsterSpawnData>& Spawns)
-{
-	for (const FMonsterSpawnData& SpawnData : Spawns)
+	for (const FTileInstanceBatch& Batch : Batches)
 	{
-		FVector WorldPos = GridToWorld(SpawnData.X, SpawnData.Y);
-		WorldPos.Z += RenderConfig.WallHeight * 0.25f; // Elevate slightly above floor
-
-		// Use the Spawner ISM or create a dedicated visual marker
-		UInstancedStaticMeshComponent* SpawnerISM = GetOrCreateISMForType(ETowerTileType::Spawner);
-		if (SpawnerISM)
+		const int32 ISMIdx = Batch.ISMIdx;
+		UInstancedStaticMeshComponent* ISM = TileInstances[ISMIdx];
+		const ETowerTileType TileType = ISMTileTypes[ISMIdx];
+
+		// One bulk add and one render state update per ISM
+		const TArray<int32> InstIndices = ISM->AddInstances(Batch.Transforms, /*bShouldReturnIndices=*/true, /*bWorldSpace=*/false);
+		TArray<int64>& InstanceKeys = InstanceGridKeys[ISMIdx];
+		InstanceKeys.Reserve(InstanceKeys.Num() + InstIndices.Num());
+		FBox NavBounds(ForceInit);
+		for (int32 i = 0; i < InstIndices.Num(); ++i)
 		{
-			FTransform Transform;
-			Transform.SetLocation(WorldPos);
+			const FTileRenderData& Tile = *Batch.Tiles[i];
+			NavBounds += GetCellBounds(Tile.X, Tile.Y);
+			CellGrid.SetInstance(Tile.X, Tile.Y, ISMIdx, InstIndices[i]);
+			InstanceKeys.Add(PackGridKey(Tile.X, Tile.Y));
 
-			// Scale by monster size
-			float Scale = 1.0f;
-			if (SpawnData.Size == TEXT("Tiny"))         Scale = 0.4f;
-			else if (SpawnData.Size == TEXT("Small"))    Scale = 0.6f;
-			else if (SpawnData.Size == TEXT("Medium"))   Scale = 1.0f;
-			else if (SpawnData.Size == TEXT("Large"))    Scale = 1.5f;
-			else if (SpawnData.Size == TEXT("Huge"))     Scale = 2.0f;
-			else if (SpawnData.Size == TEXT("Colossal")) Scale = 3.0f;
+			const TArrayView<const float> CustomData(Batch.CustomData.GetData() + i * TileCustomData::NumFloats, TileCustomData::NumFloats);
+			ISM->SetCustomData(InstIndices[i], CustomData, /*bMarkRenderStateDirty=*/false);
+		}
+		ISM->MarkRenderStateDirty();
 
-			Transform.SetScale3D(FVector(Scale * 0.5f)); // Smaller than full tile
-			SpawnerISM->AddInstance(Transform, /*bWorldSpace=*/false);
+		// One dirty area per batch instead of one per instance. With deferred
+		// collision the collision phase dirties the ISM instead.
+		if (!bDeferCollision && ISM->CanEverAffectNavigation())
+		{
+			DirtyNavigation(NavBounds.TransformBy(GetActorTransform()));
 		}
 
-		UE_LOG(LogFloorRenderer, Verbose, TEXT("Monster spawn visual: %s [%s] at (%d,%d)"),
-			*SpawnData.MonsterName, *SpawnData.Element, SpawnData.X, SpawnData.Y);
+		TotalRenderedTiles += InstIndices.Num();
+
+		UE_LOG(LogFloorRenderer, Verbose, TEXT("  Type %d chunk %d: %d instances"),
+			static_cast<int32>(TileType), ISMChunks[ISMIdx], Batch.Tiles.Num());
+	}
+
+	// The time-sliced build bakes in its own phase, after all instances are in
+	if (!bDeferCollision)
+	{
+		BakeDirtyChunks();
 	}
 }
 
-void ATowerProceduralFloorRenderer::SetBiomeAtmosphere(const FString& BiomeType)
+void ATowerProceduralFloorRenderer::BuildInstanceBatches(TArrayView<FTileInstanceBatch> Batches) const
 {
-	FLinearColor BiomeColor = GetBiomeLightColor(BiomeType);
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_BuildInstanceBatches);
+
+	// Split every batch into fixed-size spans so one big floor bucket does not
+	// serialize the build on a single worker
+	constexpr int32 SpanTiles = 512;
+	TArray<FIntPoint, TInlineAllocator<64>> Spans; // (batch, first tile)
+	int32 TotalTiles = 0;
+	for (int32 BatchIdx = 0; BatchIdx < Batches.Num(); ++BatchIdx)
+	{
+		FTileInstanceBatch& Batch = Batches[BatchIdx];
+		const int32 Count = Batch.Tiles.Num();
+		Batch.Transforms.SetNumUninitialized(Count);
+		Batch.CustomData.SetNumUninitialized(Count * TileCustomData::NumFloats);
+		for (int32 First = 0; First < Count; First += SpanTiles)
+		{
+			Spans.Add(FIntPoint(BatchIdx, First));
+		}
+		TotalTiles += Count;
+	}
+
+	// Transforms and custom data only read the config, room table and cell grid,
+	// none of which change during the build
+	ParallelFor(Spans.Num(), [this, Batches, &Spans](int32 SpanIdx)
+	{
+		FTileInstanceBatch& Batch = Batches[Spans[SpanIdx].X];
+		const ETowerTileType TileType = ISMTileTypes[Batch.ISMIdx];
+		const int32 First = Spans[SpanIdx].Y;
+		const int32 Last = FMath::Min(First + SpanTiles, Batch.Tiles.Num());
+		for (int32 i = First; i < Last; ++i)
+		{
+			const FTileRenderData& Tile = *Batch.Tiles[i];
+			Batch.Transforms[i] = BuildTileTransform(Tile.X, Tile.Y, TileType);
+			float CustomData[TileCustomData::NumFloats];
+			BuildTileCustomData(Tile.X, Tile.Y, TileType, CustomData);
+			FMemory::Memcpy(Batch.CustomData.GetData() + i * TileCustomData::NumFloats, CustomData, sizeof(CustomData));
+		}
+	}, TotalTiles >= SpanTiles * 2 ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+}
+
+void ATowerProceduralFloorRenderer::CompleteFloor()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_Complete);
+	// Dynamic navmeshes already have the new tiles' areas queued (AddTileInstances);
+	// only a static one needs the full rebuild
+	if (!IsNavigationDynamic())
+	{
+		UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+		if (NavSys)
+		{
+			NavSys->Build();
+		}
+	}
+
+	ReportFloorMemory();
+	OnFloorGenerated.Broadcast(TotalRenderedTiles);
+}
+
+void ATowerProceduralFloorRenderer::ReportFloorMemory()
+{
+	// Our own containers; instance buffers, meshes and collision are the engine's (see LLM Tower/Floor)
+	int64 Bytes = CellGrid.Types.GetAllocatedSize() + CellGrid.Rooms.GetAllocatedSize() + CellGrid.Instances.GetAllocatedSize()
+		+ Chunks.GetAllocatedSize() + ChunkIndexByCoord.GetAllocatedSize()
+		+ ISMTileTypes.GetAllocatedSize() + ISMChunks.GetAllocatedSize()
+		+ RoomLightStates.GetAllocatedSize() + CachedRooms.GetAllocatedSize() + RoomBiomeLooks.GetAllocatedSize()
+		+ StreamTileScratch.GetAllocatedSize() + SlicedTiles.GetAllocatedSize()
+		+ InstanceGridKeys.GetAllocatedSize();
+	for (const TArray<int64>& Keys : InstanceGridKeys)
+	{
+		Bytes += Keys.GetAllocatedSize();
+	}
+	FloorMemory.Set(Bytes);
+}
+
+void ATowerProceduralFloorRenderer::ClearFloor()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_Clear);
+	// Destroy all ISM components
+	for (UInstancedStaticMeshComponent* ISM : TileInstances)
+	{
+		if (ISM)
+		{
+			ISM->ClearInstances();
+			ISM->DestroyComponent();
+		}
+	}
+	TileInstances.Empty();
+	InstanceGridKeys.Empty();
+	ISMTileTypes.Empty();
+	ISMChunks.Empty();
+	Chunks.Empty();
+	ChunkIndexByCoord.Empty();
+
+	for (UProceduralMeshComponent* Collider : ChunkColliders)
+	{
+		if (Collider)
+		{
+			Collider->DestroyComponent();
+		}
+	}
+	ChunkColliders.Empty();
+
+	for (UProceduralMeshComponent* WallMesh : ChunkWallMeshes)
+	{
+		if (WallMesh)
+		{
+			WallMesh->DestroyComponent();
+		}
+	}
+	ChunkWallMeshes.Empty();
+
+	// Destroy all room lights
+	for (UPointLightComponent* Light : RoomLights)
+	{
+		if (Light)
+		{
+			Light->DestroyComponent();
+		}
+	}
+	RoomLights.Empty();
+	RoomLightStates.Empty();
+	SetActorTickEnabled(false);
+
+	// Clear state
+	CellGrid.Reset();
+	CachedRooms.Empty();
+	RoomBiomeLooks.Empty();
+	TotalRenderedTiles = 0;
+	bStreamingFloor = false;
+	SlicedTiles.Reset();
+	BuildPhase = ETimeSlicedFloorPhase::Idle;
+	BuildCursor = 0;
+	bDeferCollision = false;
+	ReportFloorMemory();
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Floor cleared"));
+}
+
+void ATowerProceduralFloorRenderer::SetFloorDormant(bool bInDormant)
+{
+	if (bDormant == bInDormant)
+	{
+		return;
+	}
+	bDormant = bInDormant;
+
+	SetActorHiddenInGame(bDormant);
+	SetActorEnableCollision(!bDormant);
+
+	FTimerManager& Timers = GetWorldTimerManager();
+	if (bDormant)
+	{
+		SetActorTickEnabled(false);
+		Timers.PauseTimer(ChunkVisibilityTimer);
+		Timers.PauseTimer(RoomLightBudgetTimer);
+
+		// The floor that replaces this one builds its navmesh in the same space
+		DormantNavComponents.Reset();
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(this);
+		for (UPrimitiveComponent* Primitive : Primitives)
+		{
+			if (Primitive->CanEverAffectNavigation())
+			{
+				Primitive->SetCanEverAffectNavigation(false);
+				DormantNavComponents.Add(Primitive);
+			}
+		}
+	}
+	else
+	{
+		Timers.UnPauseTimer(ChunkVisibilityTimer);
+		Timers.UnPauseTimer(RoomLightBudgetTimer);
+
+		// Tick turns itself off again once no room light is fading
+		SetActorTickEnabled(true);
+
+		for (UPrimitiveComponent* Primitive : DormantNavComponents)
+		{
+			if (IsValid(Primitive))
+			{
+				Primitive->SetCanEverAffectNavigation(true);
+			}
+		}
+		DormantNavComponents.Reset();
+		DirtyNavigation(GetComponentsBoundingBox());
+	}
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Floor %s"), bDormant ? TEXT("parked") : TEXT("woken"));
+}
+
+int64 ATowerProceduralFloorRenderer::EstimateFloorBytes() const
+{
+	int64 Bytes = FloorMemory.Get();
+	TInlineComponentArray<UActorComponent*> Components(this);
+	for (UActorComponent* Component : Components)
+	{
+		// Instance buffers, proc mesh sections and render data, as the engine reports them
+		Bytes += Component->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+	return Bytes;
+}
+
+void ATowerProceduralFloorRenderer::UpdateTileState(int32 X, int32 Y, ETowerTileType NewType)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_UpdateTileState);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	int64 Key = PackGridKey(X, Y);
+
+	// Greedy walls have no instance; their chunk's mesh is rebuilt instead
+	if (CellGrid.GetType(X, Y) == ETowerTileType::Wall && UsesGreedyWalls())
+	{
+		NoteChunkTile(GetOrCreateChunk(X, Y), X, Y, ETowerTileType::Wall);
+	}
+
+	// Remove old instance if it exists
+	if (const FFloorCellGrid::FInstanceRef* OldMapping = CellGrid.FindInstance(X, Y))
+	{
+		const int32 OldISMIdx = OldMapping->Component;
+		const int32 OldInstIdx = OldMapping->Instance;
+		CellGrid.ClearInstance(X, Y);
+		NoteChunkTile(ISMChunks[OldISMIdx], X, Y, ISMTileTypes[OldISMIdx]);
+		RemoveTileInstance(OldISMIdx, OldInstIdx);
+	}
+
+	// Update the grid
+	CellGrid.SetType(X, Y, NewType);
+	if (NewType != ETowerTileType::Empty)
+	{
+
+		// Add new instance to this cell's chunk
+		const bool bGreedyWall = NewType == ETowerTileType::Wall && UsesGreedyWalls();
+		const int32 ISMIdx = bGreedyWall ? INDEX_NONE : GetOrCreateISM(NewType, X, Y);
+		if (bGreedyWall)
+		{
+			NoteChunkTile(GetOrCreateChunk(X, Y), X, Y, NewType);
+		}
+		else if (ISMIdx != INDEX_NONE)
+		{
+			UInstancedStaticMeshComponent* ISM = TileInstances[ISMIdx];
+			FTransform Transform = BuildTileTransform(X, Y, NewType);
+			int32 InstIdx = ISM->AddInstance(Transform, /*bWorldSpace=*/false);
+			InstanceGridKeys[ISMIdx].Add(Key);
+
+			float CustomData[TileCustomData::NumFloats];
+			BuildTileCustomData(X, Y, NewType, CustomData);
+			ISM->SetCustomData(InstIdx, MakeArrayView(CustomData), /*bMarkRenderStateDirty=*/true);
+
+			CellGrid.SetInstance(X, Y, ISMIdx, InstIdx);
+			NoteChunkTile(ISMChunks[ISMIdx], X, Y, NewType);
+			TotalRenderedTiles++;
+		}
+	}
+
+	// Re-merge only this cell's chunk (and for walls its neighbours) if its walls or floors changed
+	if (!bDeferCollision && !bBatchingMutations)
+	{
+		BakeDirtyChunks();
+	}
+
+	// Only the nav tiles under this cell are regenerated
+	DirtyNavigation(GetCellBounds(X, Y).TransformBy(GetActorTransform()));
+
+	OnTileMutated.Broadcast(X, Y, NewType);
+
+	UE_LOG(LogFloorRenderer, Verbose, TEXT("Tile (%d,%d) mutated to %d"), X, Y, static_cast<int32>(NewType));
+}
+
+void ATowerProceduralFloorRenderer::UpdateTileStates(TConstArrayView<FIntPoint> Cells, TConstArrayView<ETowerTileType> Types)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_UpdateTileStates);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+	check(Cells.Num() == Types.Num());
+	if (Cells.Num() == 0)
+	{
+		return;
+	}
+
+	bBatchingMutations = true;
+	for (int32 i = 0; i < Cells.Num(); i++)
+	{
+		UpdateTileState(Cells[i].X, Cells[i].Y, Types[i]);
+	}
+	bBatchingMutations = false;
+
+	if (!bDeferCollision)
+	{
+		BakeDirtyChunks();
+	}
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Applied %d tile mutations"), Cells.Num());
+}
+
+void ATowerProceduralFloorRenderer::ApplyTileUpdates(TConstArrayView<FTileRenderData> Tiles)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_ApplyTileUpdates);
+	LLM_SCOPE_BYTAG(Tower_Floor);
+
+	// New cells take the bulk path; only cells that already hold a tile are mutated one by one
+	StreamTileScratch.Reset(Tiles.Num());
+	TArray<FIntPoint> MutatedCells;
+	TArray<ETowerTileType> MutatedTypes;
+	for (const FTileRenderData& Tile : Tiles)
+	{
+		const ETowerTileType Current = CellGrid.GetType(Tile.X, Tile.Y);
+		if (Current == Tile.TileType)
+		{
+			continue;
+		}
+		if (Current == ETowerTileType::Empty)
+		{
+			StreamTileScratch.Add(Tile);
+		}
+		else
+		{
+			MutatedCells.Add(FIntPoint(Tile.X, Tile.Y));
+			MutatedTypes.Add(Tile.TileType);
+		}
+	}
+
+	if (StreamTileScratch.Num() > 0)
+	{
+		AddTileInstances(StreamTileScratch);
+		ReportFloorMemory();
+	}
+	UpdateTileStates(MutatedCells, MutatedTypes);
+}
+
+void ATowerProceduralFloorRenderer::SpawnMonsterVisuals(const TArray<FMonsterSpawnData>& Spawns)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_SpawnMonsterVisuals);
+	for (const FMonsterSpawnData& SpawnData : Spawns)
+	{
+		FVector WorldPos = GridToWorld(SpawnData.X, SpawnData.Y);
+		WorldPos.Z += RenderConfig.WallHeight * 0.25f; // Elevate slightly above floor
+
+		// Use the Spawner ISM or create a dedicated visual marker
+		const int32 SpawnerISMIdx = GetOrCreateISM(ETowerTileType::Spawner, SpawnData.X, SpawnData.Y);
+		if (SpawnerISMIdx != INDEX_NONE)
+		{
+			UInstancedStaticMeshComponent* SpawnerISM = TileInstances[SpawnerISMIdx];
+			FTransform Transform;
+			Transform.SetLocation(WorldPos);
+
+			// Scale by monster size, indexed by EMonsterSize
+			static const float SizeScales[] = { 1.0f, 0.4f, 0.6f, 1.0f, 1.5f, 2.0f, 3.0f };
+			static_assert(UE_ARRAY_COUNT(SizeScales) == static_cast<int32>(EMonsterSize::Count), "One scale per EMonsterSize");
+			const float Scale = SizeScales[static_cast<uint8>(TowerMonsterTags::SanitizeSize(static_cast<uint8>(SpawnData.Size)))];
+
+			Transform.SetScale3D(FVector(Scale * 0.5f)); // Smaller than full tile
+			const int32 InstIdx = SpawnerISM->AddInstance(Transform, /*bWorldSpace=*/false);
+
+			float CustomData[TileCustomData::NumFloats];
+			BuildTileCustomData(SpawnData.X, SpawnData.Y, ETowerTileType::Spawner, CustomData);
+			SpawnerISM->SetCustomData(InstIdx, MakeArrayView(CustomData), /*bMarkRenderStateDirty=*/true);
+
+			// Markers aren't in CellGrid; their key only has to keep the
+			// reverse index in step with the ISM
+			InstanceGridKeys[SpawnerISMIdx].Add(PackGridKey(SpawnData.X, SpawnData.Y));
+		}
+
+		UE_LOG(LogFloorRenderer, Verbose, TEXT("Monster spawn visual: %s [%s] at (%d,%d)"),
+			*SpawnData.MonsterName, TowerMonsterTags::ToString(SpawnData.Element), SpawnData.X, SpawnData.Y);
+	}
+}
+
+void ATowerProceduralFloorRenderer::SetBiomeAtmosphere(const FString& BiomeType)
+{
+	FLinearColor BiomeColor = GetBiomeLightColor(BiomeType);
+
+	// Adjust all existing room lights to blend with the biome atmosphere
+	for (UPointLightComponent* Light : RoomLights)
+	{
+		if (!Light) continue;
+
+		// Blend existing light color 70% room + 30% biome atmosphere
+		FLinearColor CurrentColor = Light->GetLightColor();
+		FLinearColor BlendedColor = FLinearColor::LerpUsingHSV(CurrentColor, BiomeColor, 0.3f);
+		Light->SetLightColor(BlendedColor);
+	}
+
+	UE_LOG(LogFloorRenderer, Log, TEXT("Biome atmosphere set: %s (color: R=%.2f G=%.2f B=%.2f)"),
+		*BiomeType, BiomeColor.R, BiomeColor.G, BiomeColor.B);
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+ETowerTileType ATowerProceduralFloorRenderer::GetTileAt(int32 X, int32 Y) const
+{
+	return CellGrid.GetType(X, Y);
+}
+
+FVector ATowerProceduralFloorRenderer::GridToWorld(int32 X, int32 Y) const
+{
+	return GetActorLocation() + FVector(
+		static_cast<float>(X) * RenderConfig.TileSize,
+		static_cast<float>(Y) * RenderConfig.TileSize,
+		0.0f
+	);
+}
+
+void ATowerProceduralFloorRenderer::WorldToGrid(const FVector& WorldPos, int32& OutX, int32& OutY) const
+{
+	FVector LocalPos = WorldPos - GetActorLocation();
+	OutX = FMath::RoundToInt(LocalPos.X / RenderConfig.TileSize);
+	OutY = FMath::RoundToInt(LocalPos.Y / RenderConfig.TileSize);
+}
+
+bool ATowerProceduralFloorRenderer::GetRoomAtGrid(int32 X, int32 Y, FRoomRenderData& OutRoom) const
+{
+	if (const FRoomRenderData* Room = FindRoomAtGrid(X, Y))
+	{
+		OutRoom = *Room;
+		return true;
+	}
+	return false;
+}
+
+const FRoomRenderData* ATowerProceduralFloorRenderer::FindRoomAtGrid(int32 X, int32 Y) const
+{
+	const int32 RoomIdx = CellGrid.GetRoom(X, Y);
+	return CachedRooms.IsValidIndex(RoomIdx) ? &CachedRooms[RoomIdx] : nullptr;
+}
+
+// ============================================================================
+// Cell Grid
+// ============================================================================
+
+void FFloorCellGrid::Reset()
+{
+	Origin = FIntPoint::ZeroValue;
+	Width = 0;
+	Height = 0;
+	Types.Reset();
+	Rooms.Reset();
+	Instances.Reset();
+}
+
+void FFloorCellGrid::Include(FIntPoint Min, FIntPoint Max)
+{
+	if (Width > 0 && Height > 0)
+	{
+		if (IndexOf(Min.X, Min.Y) != INDEX_NONE && IndexOf(Max.X, Max.Y) != INDEX_NONE)
+		{
+			return;
+		}
+		Min = Min.ComponentMin(Origin);
+		Max = Max.ComponentMax(Origin + FIntPoint(Width - 1, Height - 1));
+	}
+
+	const int32 NewWidth = Max.X - Min.X + 1;
+	const int32 NewHeight = Max.Y - Min.Y + 1;
+	const int32 NewNum = NewWidth * NewHeight;
+
+	TArray<ETowerTileType> NewTypes;
+	TArray<int16> NewRooms;
+	TArray<FInstanceRef> NewInstances;
+	NewTypes.Init(ETowerTileType::Empty, NewNum);
+	NewRooms.Init(INDEX_NONE, NewNum);
+	NewInstances.SetNum(NewNum);
+
+	// Copy the old rows into place
+	for (int32 LY = 0; LY < Height; LY++)
+	{
+		const int32 Src = LY * Width;
+		const int32 Dst = (Origin.Y - Min.Y + LY) * NewWidth + (Origin.X - Min.X);
+		FMemory::Memcpy(&NewTypes[Dst], &Types[Src], Width * sizeof(ETowerTileType));
+		FMemory::Memcpy(&NewRooms[Dst], &Rooms[Src], Width * sizeof(int16));
+		FMemory::Memcpy(&NewInstances[Dst], &Instances[Src], Width * sizeof(FInstanceRef));
+	}
+
+	Origin = Min;
+	Width = NewWidth;
+	Height = NewHeight;
+	Types = MoveTemp(NewTypes);
+	Rooms = MoveTemp(NewRooms);
+	Instances = MoveTemp(NewInstances);
+}
+
+void FFloorCellGrid::SetType(int32 X, int32 Y, ETowerTileType Type)
+{
+	int32 Index = IndexOf(X, Y);
+	if (Index == INDEX_NONE)
+	{
+		if (Type == ETowerTileType::Empty)
+		{
+			return;
+		}
+		Include(FIntPoint(X, Y), FIntPoint(X, Y));
+		Index = IndexOf(X, Y);
+	}
+	Types[Index] = Type;
+}
+
+FFloorCellGrid::FInstanceRef* FFloorCellGrid::FindInstance(int32 X, int32 Y)
+{
+	const int32 Index = IndexOf(X, Y);
+	return Index != INDEX_NONE && Instances[Index].Component != INDEX_NONE ? &Instances[Index] : nullptr;
+}
+
+void FFloorCellGrid::SetInstance(int32 X, int32 Y, int32 Component, int32 Instance)
+{
+	Include(FIntPoint(X, Y), FIntPoint(X, Y));
+	FInstanceRef& Ref = Instances[IndexOf(X, Y)];
+	Ref.Component = Component;
+	Ref.Instance = Instance;
+}
+
+void FFloorCellGrid::ClearInstance(int32 X, int32 Y)
+{
+	const int32 Index = IndexOf(X, Y);
+	if (Index != INDEX_NONE)
+	{
+		Instances[Index] = FInstanceRef();
+	}
+}
+
+void FFloorCellGrid::AssignRooms(TConstArrayView<FRoomRenderData> InRooms)
+{
+	const int32 NumRooms = FMath::Min(InRooms.Num(), static_cast<int32>(MAX_int16));
+	if (NumRooms < InRooms.Num())
+	{
+		UE_LOG(LogFloorRenderer, Warning, TEXT("Floor has %d rooms, only the first %d are indexed"), InRooms.Num(), NumRooms);
+	}
+
+	for (int32 RoomIdx = 0; RoomIdx < NumRooms; RoomIdx++)
+	{
+		const FRoomRenderData& Room = InRooms[RoomIdx];
+		if (Room.Width > 0 && Room.Height > 0)
+		{
+			Include(FIntPoint(Room.X, Room.Y), FIntPoint(Room.X + Room.Width - 1, Room.Y + Room.Height - 1));
+		}
+	}
+
+	// Backwards, so the first room covering a cell is the one left in it
+	for (int32 RoomIdx = NumRooms - 1; RoomIdx >= 0; RoomIdx--)
+	{
+		const FRoomRenderData& Room = InRooms[RoomIdx];
+		for (int32 Y = Room.Y; Y < Room.Y + Room.Height; Y++)
+		{
+			for (int32 X = Room.X; X < Room.X + Room.Width; X++)
+			{
+				Rooms[IndexOf(X, Y)] = static_cast<int16>(RoomIdx);
+			}
+		}
+	}
+}
+
+// ============================================================================
+// Internal Helpers
+// ============================================================================
+
+int32 ATowerProceduralFloorRenderer::GetOrCreateChunk(int32 X, int32 Y)
+{
+	const FIntPoint ChunkCoord = GetChunkCoord(X, Y);
+	if (const int32* ExistingChunk = ChunkIndexByCoord.Find(ChunkCoord))
+	{
+		return *ExistingChunk;
+	}
+
+	const int32 ChunkIdx = Chunks.AddDefaulted();
+	Chunks[ChunkIdx].Coord = ChunkCoord;
+	ChunkIndexByCoord.Add(ChunkCoord, ChunkIdx);
+	return ChunkIdx;
+}
+
+int32 ATowerProceduralFloorRenderer::GetOrCreateISM(ETowerTileType TileType, int32 X, int32 Y)
+{
+	const FIntPoint ChunkCoord = GetChunkCoord(X, Y);
+	const int32 ChunkIdx = GetOrCreateChunk(X, Y);
+
+	// Return existing ISM if this chunk already has one for the type
+	const int32 ExistingIdx = Chunks[ChunkIdx].ISMByType[static_cast<int32>(TileType)];
+	if (TileInstances.IsValidIndex(ExistingIdx))
+	{
+		return ExistingIdx;
+	}
+
+	// Resolve mesh: editor-assigned > fallback cube
+	UStaticMesh* Mesh = nullptr;
+	if (UStaticMesh** Found = TileMeshes.Find(TileType))
+	{
+		Mesh = *Found;
+	}
+	if (!Mesh)
+	{
+		Mesh = GetDefaultMeshForType(TileType);
+	}
+	if (!Mesh)
+	{
+		UE_LOG(LogFloorRenderer, Error, TEXT("No mesh available for tile type %d"), static_cast<int32>(TileType));
+		return INDEX_NONE;
+	}
+
+	// Create new HISM component: one per type per chunk, whatever the biome, with
+	// the per-biome look in custom data. Names stay unique across floors, since
+	// destroyed components of the last floor may still be around.
+	const FName CompName = MakeUniqueObjectName(this, UHierarchicalInstancedStaticMeshComponent::StaticClass(),
+		*FString::Printf(TEXT("ISM_Chunk_%d_%d_Type_%d"), ChunkCoord.X, ChunkCoord.Y, static_cast<int32>(TileType)));
+	UInstancedStaticMeshComponent* ISM = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, CompName);
+	ISM->SetStaticMesh(Mesh);
+	ISM->NumCustomDataFloats = TileCustomData::NumFloats;
+	if (TileMasterMaterial)
+	{
+		ISM->SetMaterial(0, TileMasterMaterial);
+	}
+	else
+	{
+		// Without a master material, use the biome of the first tile's room for
+		// the whole ISM
+		const int32 FirstRoom = GetRoomIndexAt(X, Y);
+		UMaterialInterface* BiomeMat = RoomBiomeLooks.IsValidIndex(FirstRoom) ? RoomBiomeLooks[FirstRoom].Material : nullptr;
+		if (BiomeMat)
+		{
+			ISM->SetMaterial(0, BiomeMat);
+		}
+		else if (DefaultMaterial)
+		{
+			ISM->SetMaterial(0, DefaultMaterial);
+		}
+	}
+	ISM->SetVisibility(Chunks[ChunkIdx].bVisible);
+	ISM->SetMobility(EComponentMobility::Static);
+	// RemoveTileInstance relies on removal moving the last instance into the gap
+	ISM->bSupportRemoveAtSwap = true;
+	ISM->AttachToComponent(SceneRoot, FAttachmentTransformRules::KeepRelativeTransform);
+	ISM->RegisterComponent();
+
+	// Nanite: ISM automatically uses Nanite if the mesh has Nanite data enabled.
+	// No additional flag needed — Nanite is a property of the UStaticMesh asset.
+
+	// LOD: set cull distance for large floors
+	ISM->SetCullDistances(0.0f, RenderConfig.MaxLODDistance);
+
+	// Collision and navigation
+	if (bDeferCollision)
+	{
+		ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	else
+	{
+		ConfigureCollision(ISM, TileType);
+	}
+	ConfigureNavigation(ISM, TileType);
+
+	// Cast shadows (Lumen uses shadow maps for indirect bounces)
+	ISM->SetCastShadow(true);
+
+	int32 NewIdx = TileInstances.Add(ISM);
+	InstanceGridKeys.AddDefaulted();
+	ISMTileTypes.Add(TileType);
+	ISMChunks.Add(ChunkIdx);
+	Chunks[ChunkIdx].ISMByType[static_cast<int32>(TileType)] = NewIdx;
+
+	return NewIdx;
+}
+
+void ATowerProceduralFloorRenderer::NoteChunkTile(int32 ChunkIdx, int32 X, int32 Y, ETowerTileType TileType)
+{
+	FFloorRenderChunk& Chunk = Chunks[ChunkIdx];
+	const FIntPoint Cell(X, Y);
+	if (!Chunk.bHasCells)
+	{
+		Chunk.MinCell = Chunk.MaxCell = Cell;
+		Chunk.bHasCells = true;
+	}
+	else
+	{
+		Chunk.MinCell = Chunk.MinCell.ComponentMin(Cell);
+		Chunk.MaxCell = Chunk.MaxCell.ComponentMax(Cell);
+	}
+
+	if (UsesMergedCollision(TileType))
+	{
+		Chunk.bCollisionDirty = true;
+	}
+
+	if (TileType == ETowerTileType::Wall && UsesGreedyWalls())
+	{
+		Chunk.bWallMeshDirty = true;
+
+		// A wall on a chunk edge hides or exposes faces of the neighbouring chunk's walls
+		const FIntPoint Coord = Chunk.Coord;
+		for (const FIntPoint& Offset : { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) })
+		{
+			const FIntPoint NeighbourCoord = GetChunkCoord(X + Offset.X, Y + Offset.Y);
+			if (NeighbourCoord != Coord)
+			{
+				if (const int32* NeighbourIdx = ChunkIndexByCoord.Find(NeighbourCoord))
+				{
+					Chunks[*NeighbourIdx].bWallMeshDirty = true;
+				}
+			}
+		}
+	}
+}
+
+bool ATowerProceduralFloorRenderer::UsesMergedCollision(ETowerTileType TileType) const
+{
+	// Plain blocking geometry only: doors toggle and stairs are sloped, so those
+	// keep their instance collision
+	return RenderConfig.bMergeCollision
+		&& (TileType == ETowerTileType::Wall || TileType == ETowerTileType::Floor);
+}
+
+void ATowerProceduralFloorRenderer::BakeDirtyChunks()
+{
+	for (int32 ChunkIdx = 0; ChunkIdx < Chunks.Num(); ChunkIdx++)
+	{
+		if (Chunks[ChunkIdx].bCollisionDirty)
+		{
+			BakeChunkCollision(ChunkIdx);
+		}
+		if (Chunks[ChunkIdx].bWallMeshDirty)
+		{
+			BakeChunkWallMesh(ChunkIdx);
+		}
+	}
+}
+
+FName ATowerProceduralFloorRenderer::GetCellBiomeTag(int32 X, int32 Y) const
+{
+	const int32 RoomIdx = GetRoomIndexAt(X, Y);
+	return RoomBiomeLooks.IsValidIndex(RoomIdx) ? RoomBiomeLooks[RoomIdx].WallTag : NAME_None;
+}
+
+void ATowerProceduralFloorRenderer::AssignRooms(const TArray<FRoomRenderData>& Rooms)
+{
+	CachedRooms = Rooms;
+	CellGrid.AssignRooms(CachedRooms);
+	AcquireBiomeMaterials();
+
+	// Tiles only ever read the resolved look, so a floor's tag maps are searched once per room
+	RoomBiomeLooks.SetNum(CachedRooms.Num());
+	for (int32 RoomIdx = 0; RoomIdx < CachedRooms.Num(); RoomIdx++)
+	{
+		const TArray<FName>& Tags = CachedRooms[RoomIdx].BiomeTags;
+		FRoomBiomeLook& Look = RoomBiomeLooks[RoomIdx];
+		Look = FRoomBiomeLook();
+
+		for (const FName& Tag : Tags)
+		{
+			if (BiomeAtlasRegions.Contains(Tag) || BiomeStyles.Contains(Tag))
+			{
+				Look.WallTag = Tag;
+				break;
+			}
+		}
+
+		for (const FName& Tag : Tags)
+		{
+			if (const FBiomeInstanceStyle* Found = BiomeStyles.Find(Tag))
+			{
+				Look.Style = *Found;
+				break;
+			}
+		}
+
+		Look.Material = ResolveBiomeMaterial(Tags);
+	}
+}
+
+void ATowerProceduralFloorRenderer::BakeChunkWallMesh(int32 ChunkIdx)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_BakeChunkWallMesh);
+	FFloorRenderChunk& Chunk = Chunks[ChunkIdx];
+	Chunk.bWallMeshDirty = false;
+	if (!Chunk.bHasCells)
+	{
+		return;
+	}
+
+	const int32 Width = Chunk.MaxCell.X - Chunk.MinCell.X + 1;
+	const int32 Height = Chunk.MaxCell.Y - Chunk.MinCell.Y + 1;
+	const float TileSize = RenderConfig.TileSize;
+	const float HalfTile = TileSize * 0.5f;
+	const float WallTop = RenderConfig.WallHeight;
+
+	auto IsWallAt = [this](int32 X, int32 Y)
+	{
+		return CellGrid.GetType(X, Y) == ETowerTileType::Wall;
+	};
+
+	// Biome of every wall cell in the chunk as an index into Styles; quads only
+	// merge cells of the same biome. INDEX_NONE = no wall.
+	TArray<FName> Styles;
+	TArray<int32> CellStyle;
+	CellStyle.Init(INDEX_NONE, Width * Height);
+	for (int32 LY = 0; LY < Height; LY++)
+	{
+		for (int32 LX = 0; LX < Width; LX++)
+		{
+			const int32 X = Chunk.MinCell.X + LX;
+			const int32 Y = Chunk.MinCell.Y + LY;
+			if (IsWallAt(X, Y))
+			{
+				CellStyle[LY * Width + LX] = Styles.AddUnique(GetCellBiomeTag(X, Y));
+			}
+		}
+	}
+
+	TArray<FVector> Vertices;
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UV0, AtlasOffset, AtlasSize;
+	TArray<FColor> Colors;
+	TArray<FProcMeshTangent> Tangents;
+
+	// Emit one quad. Corners go A -> B along U, A -> D along V; triangles are wound
+	// so (B-A)^(C-A) points away from Normal, which UE renders as the front face.
+	auto AddQuad = [&](const FVector& A, const FVector& U, const FVector& V, float USpan, float VSpan, const FVector& Normal, int32 Style)
+	{
+		const FName Tag = Styles[Style];
+		const FBox2D* Region = BiomeAtlasRegions.Find(Tag);
+		const FVector2D RegionMin = Region ? Region->Min : FVector2D(0.0f, 0.0f);
+		const FVector2D RegionSize = Region ? Region->GetSize() : FVector2D(1.0f, 1.0f);
+		const FBiomeInstanceStyle* Look = BiomeStyles.Find(Tag);
+		FLinearColor Tint = Look ? Look->Tint : FLinearColor::White;
+		Tint.A = Look ? FMath::Clamp(Look->Emissive, 0.0f, 1.0f) : 0.0f;
+		const FColor Color = Tint.ToFColor(/*bSRGB=*/false);
+
+		const int32 Base = Vertices.Num();
+		const FVector Corners[4] = { A, A + U, A + U + V, A + V };
+		const FVector2D UVs[4] = { {0.0f, 0.0f}, {USpan, 0.0f}, {USpan, VSpan}, {0.0f, VSpan} };
+		for (int32 i = 0; i < 4; i++)
+		{
+			Vertices.Add(Corners[i]);
+			Normals.Add(Normal);
+			UV0.Add(UVs[i]);
+			AtlasOffset.Add(RegionMin);
+			AtlasSize.Add(RegionSize);
+			Colors.Add(Color);
+			Tangents.Emplace(U.GetSafeNormal(), false);
+		}
+
+		const bool bFlip = ((U ^ (U + V)) | Normal) > 0.0f;
+		const int32 Order[6] = { 0, 1, 2, 0, 2, 3 };
+		for (int32 i = 0; i < 6; i += 3)
+		{
+			Triangles.Add(Base + Order[i]);
+			Triangles.Add(Base + (bFlip ? Order[i + 2] : Order[i + 1]));
+			Triangles.Add(Base + (bFlip ? Order[i + 1] : Order[i + 2]));
+		}
+	};
+
+	auto CellMin = [&](int32 LX, int32 LY)
+	{
+		return FVector((Chunk.MinCell.X + LX) * TileSize - HalfTile, (Chunk.MinCell.Y + LY) * TileSize - HalfTile, 0.0f);
+	};
+
+	// Tops: greedy rectangles of same-biome walls, as for merged collision
+	{
+		TArray<bool> Covered;
+		Covered.SetNumZeroed(Width * Height);
+		for (int32 LY = 0; LY < Height; LY++)
+		{
+			for (int32 LX = 0; LX < Width; LX++)
+			{
+				const int32 Style = CellStyle[LY * Width + LX];
+				if (Style == INDEX_NONE || Covered[LY * Width + LX])
+				{
+					continue;
+				}
+				auto Matches = [&](int32 CX, int32 CY) { return !Covered[CY * Width + CX] && CellStyle[CY * Width + CX] == Style; };
+
+				int32 RunX = 1;
+				while (LX + RunX < Width && Matches(LX + RunX, LY))
+				{
+					RunX++;
+				}
+				int32 RunY = 1;
+				bool bRowMatches = true;
+				while (LY + RunY < Height && bRowMatches)
+				{
+					for (int32 i = 0; i < RunX && bRowMatches; i++)
+					{
+						bRowMatches = Matches(LX + i, LY + RunY);
+					}
+					if (bRowMatches)
+					{
+						RunY++;
+					}
+				}
+				for (int32 j = 0; j < RunY; j++)
+				{
+					for (int32 i = 0; i < RunX; i++)
+					{
+						Covered[(LY + j) * Width + LX + i] = true;
+					}
+				}
+
+				AddQuad(CellMin(LX, LY) + FVector(0.0f, 0.0f, WallTop), FVector(RunX * TileSize, 0.0f, 0.0f), FVector(0.0f, RunY * TileSize, 0.0f),
+					RunX, RunY, FVector::UpVector, Style);
+			}
+		}
+	}
+
+	// Sides: per facing, merge runs of exposed faces along the wall line. Faces
+	// against another wall (in any chunk) are never emitted.
+	for (const FIntPoint& Dir : { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) })
+	{
+		const bool bAlongY = Dir.X != 0; // X-facing faces run along Y
+		const int32 Lines = bAlongY ? Width : Height;
+		const int32 Length = bAlongY ? Height : Width;
+		const FVector Normal(Dir.X, Dir.Y, 0.0f);
+
+		for (int32 Line = 0; Line < Lines; Line++)
+		{
+			int32 Pos = 0;
+			while (Pos < Length)
+			{
+				auto FaceStyle = [&](int32 P)
+				{
+					const int32 LX = bAlongY ? Line : P;
+					const int32 LY = bAlongY ? P : Line;
+					const int32 Style = CellStyle[LY * Width + LX];
+					if (Style == INDEX_NONE || IsWallAt(Chunk.MinCell.X + LX + Dir.X, Chunk.MinCell.Y + LY + Dir.Y))
+					{
+						return INDEX_NONE;
+					}
+					return Style;
+				};
+
+				const int32 Style = FaceStyle(Pos);
+				if (Style == INDEX_NONE)
+				{
+					Pos++;
+					continue;
+				}
+				int32 Run = 1;
+				while (Pos + Run < Length && FaceStyle(Pos + Run) == Style)
+				{
+					Run++;
+				}
+
+				const int32 LX = bAlongY ? Line : Pos;
+				const int32 LY = bAlongY ? Pos : Line;
+				FVector Origin = CellMin(LX, LY);
+				if (Dir.X > 0) Origin.X += TileSize;
+				if (Dir.Y > 0) Origin.Y += TileSize;
+				const FVector U = bAlongY ? FVector(0.0f, Run * TileSize, 0.0f) : FVector(Run * TileSize, 0.0f, 0.0f);
+				AddQuad(Origin, U, FVector(0.0f, 0.0f, WallTop), Run, WallTop / TileSize, Normal, Style);
+
+				Pos += Run;
+			}
+		}
+	}
+
+	if (!ChunkWallMeshes.IsValidIndex(ChunkIdx))
+	{
+		ChunkWallMeshes.SetNumZeroed(Chunks.Num());
+	}
+	UProceduralMeshComponent*& WallMesh = ChunkWallMeshes[ChunkIdx];
+	if (!WallMesh)
+	{
+		if (Vertices.Num() == 0)
+		{
+			return;
+		}
+
+		const FName CompName = MakeUniqueObjectName(this, UProceduralMeshComponent::StaticClass(),
+			*FString::Printf(TEXT("WallMesh_Chunk_%d_%d"), Chunk.Coord.X, Chunk.Coord.Y));
+		WallMesh = NewObject<UProceduralMeshComponent>(this, CompName);
+		WallMesh->bUseAsyncCooking = true;
+		WallMesh->SetCastShadow(true);
+		if (UsesMergedCollision(ETowerTileType::Wall))
+		{
+			// The chunk's merged collider already blocks for these walls
+			WallMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			WallMesh->SetCanEverAffectNavigation(false);
+		}
+		else
+		{
+			WallMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+			WallMesh->SetCollisionObjectType(ECC_WorldStatic);
+			WallMesh->SetCollisionResponseToAllChannels(ECR_Block);
+		}
+		WallMesh->AttachToComponent(SceneRoot, FAttachmentTransformRules::KeepRelativeTransform);
+		WallMesh->RegisterComponent();
+		WallMesh->SetVisibility(Chunk.bVisible);
+	}
+
+	UMaterialInterface* Material = WallAtlasMaterial ? WallAtlasMaterial : (TileMasterMaterial ? TileMasterMaterial : DefaultMaterial);
+	const bool bCreateCollision = !UsesMergedCollision(ETowerTileType::Wall);
+	WallMesh->CreateMeshSection(0, Vertices, Triangles, Normals, UV0, AtlasOffset, AtlasSize, TArray<FVector2D>(),
+		Colors, Tangents, bCreateCollision);
+	if (Material)
+	{
+		WallMesh->SetMaterial(0, Material);
+	}
+	if (bCreateCollision)
+	{
+		DirtyNavigation(WallMesh->Bounds.GetBox());
+	}
+
+	UE_LOG(LogFloorRenderer, Verbose, TEXT("Chunk (%d,%d) walls: %d quads"), Chunk.Coord.X, Chunk.Coord.Y, Vertices.Num() / 4);
+}
+
+void ATowerProceduralFloorRenderer::BakeChunkCollision(int32 ChunkIdx)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_BakeChunkCollision);
+	FFloorRenderChunk& Chunk = Chunks[ChunkIdx];
+	Chunk.bCollisionDirty = false;
+	if (!Chunk.bHasCells)
+	{
+		return;
+	}
+
+	const int32 Width = Chunk.MaxCell.X - Chunk.MinCell.X + 1;
+	const int32 Height = Chunk.MaxCell.Y - Chunk.MinCell.Y + 1;
+	const float HalfTile = RenderConfig.TileSize * 0.5f;
+	const float HalfThickness = RenderConfig.FloorThickness * 0.5f;
+
+	TArray<TArray<FVector>> Boxes;
+	TArray<bool> Covered;
+
+	// Greedy merge per type: grow a run along X, then extend it along Y while
+	// every cell of the next row matches. Walls and floors have different heights.
+	for (const ETowerTileType MergedType : { ETowerTileType::Wall, ETowerTileType::Floor })
+	{
+		Covered.Reset();
+		Covered.SetNumZeroed(Width * Height);
+		auto IsOpen = [&](int32 LX, int32 LY)
+		{
+			if (Covered[LY * Width + LX])
+			{
+				return false;
+			}
+			return CellGrid.GetType(Chunk.MinCell.X + LX, Chunk.MinCell.Y + LY) == MergedType;
+		};
+
+		const float MinZ = MergedType == ETowerTileType::Wall ? 0.0f : -HalfThickness;
+		const float MaxZ = MergedType == ETowerTileType::Wall ? RenderConfig.WallHeight : HalfThickness;
+
+		for (int32 LY = 0; LY < Height; LY++)
+		{
+			for (int32 LX = 0; LX < Width; LX++)
+			{
+				if (!IsOpen(LX, LY))
+				{
+					continue;
+				}
+
+				int32 RunX = 1;
+				while (LX + RunX < Width && IsOpen(LX + RunX, LY))
+				{
+					RunX++;
+				}
+
+				int32 RunY = 1;
+				bool bRowMatches = true;
+				while (LY + RunY < Height && bRowMatches)
+				{
+					for (int32 i = 0; i < RunX && bRowMatches; i++)
+					{
+						bRowMatches = IsOpen(LX + i, LY + RunY);
+					}
+					if (bRowMatches)
+					{
+						RunY++;
+					}
+				}
+
+				for (int32 j = 0; j < RunY; j++)
+				{
+					for (int32 i = 0; i < RunX; i++)
+					{
+						Covered[(LY + j) * Width + LX + i] = true;
+					}
+				}
+
+				// Tile centers sit on multiples of TileSize
+				const FVector Min((Chunk.MinCell.X + LX) * RenderConfig.TileSize - HalfTile,
+					(Chunk.MinCell.Y + LY) * RenderConfig.TileSize - HalfTile, MinZ);
+				const FVector Max(Min.X + RunX * RenderConfig.TileSize, Min.Y + RunY * RenderConfig.TileSize, MaxZ);
+				TArray<FVector>& Corners = Boxes.AddDefaulted_GetRef();
+				Corners.Reserve(8);
+				for (int32 Corner = 0; Corner < 8; Corner++)
+				{
+					Corners.Emplace(Corner & 1 ? Max.X : Min.X, Corner & 2 ? Max.Y : Min.Y, Corner & 4 ? Max.Z : Min.Z);
+				}
+			}
+		}
+	}
 
-	// Adjust all existing room lights to blend with the biome atmosphere
-	for (UPointLightComponent* Light : RoomLights)
+	if (!ChunkColliders.IsValidIndex(ChunkIdx))
 	{
-		if (!Light) continue;
+		ChunkColliders.SetNumZeroed(Chunks.Num());
+	}
+	UProceduralMeshComponent*& Collider = ChunkColliders[ChunkIdx];
+	if (!Collider)
+	{
+		if (Boxes.Num() == 0)
+		{
+			return;
+		}
 
-		// Blend existing light color 70% room + 30% biome atmosphere
-		FLinearColor CurrentColor = Light->GetLightColor();
-		FLinearColor BlendedColor = FLinearColor::LerpUsingHSV(CurrentColor, BiomeColor, 0.3f);
-		Light->SetLightColor(BlendedColor);
+		const FName CompName = MakeUniqueObjectName(this, UProceduralMeshComponent::StaticClass(),
+			*FString::Printf(TEXT("Collision_Chunk_%d_%d"), Chunk.Coord.X, Chunk.Coord.Y));
+		Collider = NewObject<UProceduralMeshComponent>(this, CompName);
+		Collider->bUseComplexAsSimpleCollision = false;
+		Collider->bUseAsyncCooking = true;
+		Collider->SetMobility(EComponentMobility::Static);
+		Collider->SetVisibility(false);
+		Collider->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+		Collider->SetCollisionObjectType(ECC_WorldStatic);
+		Collider->SetCollisionResponseToAllChannels(ECR_Block);
+		Collider->SetCanEverAffectNavigation(true);
+		Collider->AttachToComponent(SceneRoot, FAttachmentTransformRules::KeepRelativeTransform);
+		Collider->RegisterComponent();
 	}
 
-	UE_LOG(LogFloorRenderer, Log, TEXT("Biome atmosphere set: %s (color: R=%.2f G=%.2f B=%.2f)"),
-		*BiomeType, BiomeColor.R, BiomeColor.G, BiomeColor.B);
-}
+	// One body, one convex element per merged box, cooked off the game thread
+	Collider->SetCollisionConvexMeshes(Boxes);
 
-// ============================================================================
-// Queries
-// ============================================================================
+	const FBox ChunkBounds(
+		FVector(Chunk.MinCell.X * RenderConfig.TileSize - HalfTile, Chunk.MinCell.Y * RenderConfig.TileSize - HalfTile, -HalfThickness),
+		FVector((Chunk.MaxCell.X + 1) * RenderConfig.TileSize - HalfTile, (Chunk.MaxCell.Y + 1) * RenderConfig.TileSize - HalfTile, RenderConfig.WallHeight));
+	DirtyNavigation(ChunkBounds.TransformBy(GetActorTransform()));
 
-ETowerTileType ATowerProceduralFloorRenderer::GetTileAt(int32 X, int32 Y) const
-{
-	int64 Key = PackGridKey(X, Y);
-	const ETowerTileType* Found = TileGrid.Find(Key);
-	return Found ? *Found : ETowerTileType::Empty;
+	UE_LOG(LogFloorRenderer, Verbose, TEXT("Chunk (%d,%d) collision: %d merged boxes"), Chunk.Coord.X, Chunk.Coord.Y, Boxes.Num());
 }
 
-FVector ATowerProceduralFloorRenderer::GridToWorld(int32 X, int32 Y) const
+FIntPoint ATowerProceduralFloorRenderer::GetChunkCoord(int32 X, int32 Y) const
 {
-	return GetActorLocation() + FVector(
-		static_cast<float>(X) * RenderConfig.TileSize,
-		static_cast<float>(Y) * RenderConfig.TileSize,
-		0.0f
-	);
+	const int32 Size = RenderConfig.ChunkSizeTiles;
+	if (Size <= 0)
+	{
+		return FIntPoint::ZeroValue;
+	}
+	return FIntPoint(FMath::DivideAndRoundDown(X, Size), FMath::DivideAndRoundDown(Y, Size));
 }
 
-void ATowerProceduralFloorRenderer::WorldToGrid(const FVector& WorldPos, int32& OutX, int32& OutY) const
+void ATowerProceduralFloorRenderer::UpdateChunkVisibility()
 {
-	FVector LocalPos = WorldPos - GetActorLocation();
-	OutX = FMath::RoundToInt(LocalPos.X / RenderConfig.TileSize);
-	OutY = FMath::RoundToInt(LocalPos.Y / RenderConfig.TileSize);
-}
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_UpdateChunkVisibility);
+	if (Chunks.Num() == 0 || RenderConfig.ChunkViewDistance <= 0.0f)
+	{
+		return;
+	}
 
-bool ATowerProceduralFloorRenderer::GetRoomAtGrid(int32 X, int32 Y, FRoomRenderData& OutRoom) const
-{
-	for (const FRoomRenderData& Room : CachedRooms)
+	APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PC)
 	{
-		if (X >= Room.X && X < Room.X + Room.Width &&
-			Y >= Room.Y && Y < Room.Y + Room.Height)
-		{
-			OutRoom = Room;
-			return true;
-		}
+		return;
 	}
-	return false;
-}
 
-// ============================================================================
-// Internal Helpers
-// ============================================================================
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const FVector LocalView = GetActorTransform().InverseTransformPosition(ViewLocation);
 
-UInstancedStaticMeshComponent* ATowerProceduralFloorRenderer::GetOrCreateISMForType(ETowerTileType TileType)
-{
-	// Return existing ISM if already created for this type
-	if (int32* ExistingIdx = TypeToISMIndex.Find(TileType))
+	// Chunk bounds in the actor's grid space; tile centers sit on multiples of TileSize
+	const float ChunkExtent = (RenderConfig.ChunkSizeTiles > 0 ? RenderConfig.ChunkSizeTiles : 1) * RenderConfig.TileSize;
+	const float HalfTile = RenderConfig.TileSize * 0.5f;
+	const float MaxDistSq = FMath::Square(RenderConfig.ChunkViewDistance);
+	const FVector2D View2D(LocalView.X, LocalView.Y);
+
+	for (FFloorRenderChunk& Chunk : Chunks)
 	{
-		if (TileInstances.IsValidIndex(*ExistingIdx))
+		bool bVisible = true;
+		if (RenderConfig.ChunkSizeTiles > 0)
 		{
-			return TileInstances[*ExistingIdx];
+			const FVector2D Min(Chunk.Coord.X * ChunkExtent - HalfTile, Chunk.Coord.Y * ChunkExtent - HalfTile);
+			const FBox2D Bounds(Min, Min + FVector2D(ChunkExtent, ChunkExtent));
+			bVisible = Bounds.ComputeSquaredDistanceToPoint(View2D) <= MaxDistSq;
 		}
-	}
 
-	// Resolve mesh: editor-assigned > fallback cube
-	UStaticMesh* Mesh = nullptr;
-	if (UStaticMesh** Found = TileMeshes.Find(TileType))
-	{
-		Mesh = *Found;
+		if (bVisible == Chunk.bVisible)
+		{
+			continue;
+		}
+		Chunk.bVisible = bVisible;
+		for (int32 ISMIdx : Chunk.ISMByType)
+		{
+			if (TileInstances.IsValidIndex(ISMIdx) && TileInstances[ISMIdx])
+			{
+				TileInstances[ISMIdx]->SetVisibility(bVisible);
+			}
+		}
+		const int32 ChunkIdx = static_cast<int32>(&Chunk - Chunks.GetData());
+		if (ChunkWallMeshes.IsValidIndex(ChunkIdx) && ChunkWallMeshes[ChunkIdx])
+		{
+			ChunkWallMeshes[ChunkIdx]->SetVisibility(bVisible);
+		}
 	}
-	if (!Mesh)
+}
+
+void ATowerProceduralFloorRenderer::RemoveTileInstance(int32 ISMIdx, int32 InstIdx)
+{
+	if (!TileInstances.IsValidIndex(ISMIdx) || !TileInstances[ISMIdx])
 	{
-		Mesh = GetDefaultMeshForType(TileType);
+		return;
 	}
-	if (!Mesh)
+
+	UInstancedStaticMeshComponent* ISM = TileInstances[ISMIdx];
+	TArray<int64>& InstanceKeys = InstanceGridKeys[ISMIdx];
+	if (!InstanceKeys.IsValidIndex(InstIdx) || InstIdx >= ISM->GetInstanceCount())
 	{
-		UE_LOG(LogFloorRenderer, Error, TEXT("No mesh available for tile type %d"), static_cast<int32>(TileType));
-		return nullptr;
+		return;
 	}
 
-	// Create new ISM component
-	FName CompName = *FString::Printf(TEXT("ISM_TileType_%d"), static_cast<int32>(TileType));
-	UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(this, CompName);
-	ISM->SetStaticMesh(Mesh);
-	ISM->SetMobility(EComponentMobility::Static);
-	ISM->AttachToComponent(SceneRoot, FAttachmentTransformRules::KeepRelativeTransform);
-	ISM->RegisterComponent();
-
-	// Nanite: ISM automatically uses Nanite if the mesh has Nanite data enabled.
-	// No additional flag needed — Nanite is a property of the UStaticMesh asset.
-
-	// LOD: set cull distance for large floors
-	ISM->SetCullDistances(0.0f, RenderConfig.MaxLODDistance);
-
-	// Collision and navigation
-	ConfigureCollision(ISM, TileType);
-	ConfigureNavigation(ISM, TileType);
-
-	// Cast shadows (Lumen uses shadow maps for indirect bounces)
-	ISM->SetCastShadow(true);
-
-	int32 NewIdx = TileInstances.Add(ISM);
-	TypeToISMIndex.Add(TileType, NewIdx);
+	// Swap-remove on both sides: the last instance moves into InstIdx
+	ISM->RemoveInstance(InstIdx);
+	InstanceKeys.RemoveAtSwap(InstIdx, 1, /*bAllowShrinking=*/false);
+	TotalRenderedTiles--;
 
-	return ISM;
+	if (InstanceKeys.IsValidIndex(InstIdx))
+	{
+		const int32 MovedFromIdx = InstanceKeys.Num();
+		int32 MovedX, MovedY;
+		UnpackGridKey(InstanceKeys[InstIdx], MovedX, MovedY);
+		FFloorCellGrid::FInstanceRef* Moved = CellGrid.FindInstance(MovedX, MovedY);
+		if (Moved && Moved->Component == ISMIdx && Moved->Instance == MovedFromIdx)
+		{
+			Moved->Instance = InstIdx;
+		}
+	}
 }
 
 FTransform ATowerProceduralFloorRenderer::BuildTileTransform(int32 X, int32 Y, ETowerTileType TileType) const
@@ -515,34 +1977,132 @@ FTransform ATowerProceduralFloorRenderer::BuildTileTransform(int32 X, int32 Y, E
 	return Transform;
 }
 
-UMaterialInterface* ATowerProceduralFloorRenderer::ResolveBiomeMaterial(const TArray<FString>& BiomeTags) const
+void ATowerProceduralFloorRenderer::BuildTileCustomData(int32 X, int32 Y, ETowerTileType TileType, float (&OutData)[TileCustomData::NumFloats]) const
+{
+	const int32 RoomIdx = GetRoomIndexAt(X, Y);
+	const FBiomeInstanceStyle Style = RoomBiomeLooks.IsValidIndex(RoomIdx) ? RoomBiomeLooks[RoomIdx].Style : FBiomeInstanceStyle();
+
+	// Interactive tiles glow a little regardless of biome
+	float Emissive = Style.Emissive;
+	if (TileType == ETowerTileType::Shrine || TileType == ETowerTileType::WindColumn)
+	{
+		Emissive = FMath::Max(Emissive, 1.0f);
+	}
+
+	OutData[TileCustomData::TintR] = Style.Tint.R;
+	OutData[TileCustomData::TintG] = Style.Tint.G;
+	OutData[TileCustomData::TintB] = Style.Tint.B;
+	// Stable per cell so a mutated tile keeps its wear
+	OutData[TileCustomData::Wear] = static_cast<float>(HashCombine(::GetTypeHash(X), ::GetTypeHash(Y)) & 0xFFFF) / 65535.0f;
+	OutData[TileCustomData::Emissive] = Emissive;
+}
+
+UMaterialInterface* ATowerProceduralFloorRenderer::ResolveBiomeMaterial(const TArray<FName>& BiomeTags) const
 {
 	// Try each tag in priority order — first match wins
-	for (const FString& Tag : BiomeTags)
+	for (const FName& Tag : BiomeTags)
 	{
-		if (UMaterialInterface* const* Found = BiomeMaterials.Find(Tag))
+		if (const TSoftObjectPtr<UMaterialInterface>* Found = BiomeMaterials.Find(Tag))
 		{
-			return *Found;
+			// Loaded by AcquireBiomeMaterials for this floor's rooms
+			return Found->Get();
 		}
 	}
 
 	// Try compound keys (e.g. "stone_moss")
 	if (BiomeTags.Num() >= 2)
 	{
-		FString CompoundKey = BiomeTags[0] + TEXT("_") + BiomeTags[1];
-		if (UMaterialInterface* const* Found = BiomeMaterials.Find(CompoundKey))
+		// Built on the stack; FNAME_Find means a pair nobody keyed never enters the name table
+		TStringBuilder<128> CompoundKey;
+		CompoundKey << BiomeTags[0] << TEXT("_") << BiomeTags[1];
+		const FName CompoundName(CompoundKey.ToView(), FNAME_Find);
+		if (const TSoftObjectPtr<UMaterialInterface>* Found = CompoundName.IsNone() ? nullptr : BiomeMaterials.Find(CompoundName))
 		{
-			return *Found;
+			return Found->Get();
 		}
 	}
 
 	return nullptr;
 }
 
+void ATowerProceduralFloorRenderer::CollectBiomeMaterialPaths(TConstArrayView<FRoomRenderData> Rooms, TArray<FSoftObjectPath>& OutPaths) const
+{
+	if (TileMasterMaterial || BiomeMaterials.Num() == 0)
+	{
+		return;
+	}
+
+	for (const FRoomRenderData& Room : Rooms)
+	{
+		// Every tag's entry, not just the first hit: cheap, and it matches ResolveBiomeMaterial's order whatever loads
+		for (const FName& Tag : Room.BiomeTags)
+		{
+			if (const TSoftObjectPtr<UMaterialInterface>* Found = BiomeMaterials.Find(Tag))
+			{
+				OutPaths.AddUnique(Found->ToSoftObjectPath());
+			}
+		}
+		if (Room.BiomeTags.Num() >= 2)
+		{
+			TStringBuilder<128> CompoundKey;
+			CompoundKey << Room.BiomeTags[0] << TEXT("_") << Room.BiomeTags[1];
+			const FName CompoundName(CompoundKey.ToView(), FNAME_Find);
+			if (const TSoftObjectPtr<UMaterialInterface>* Found = CompoundName.IsNone() ? nullptr : BiomeMaterials.Find(CompoundName))
+			{
+				OutPaths.AddUnique(Found->ToSoftObjectPath());
+			}
+		}
+	}
+	OutPaths.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+}
+
+void ATowerProceduralFloorRenderer::PrefetchBiomeAssets(TConstArrayView<FRoomRenderData> Rooms)
+{
+	TArray<FSoftObjectPath> Paths;
+	CollectBiomeMaterialPaths(Rooms, Paths);
+	ReleaseStreamable(PrefetchedBiomeHandle);
+	if (Paths.Num() > 0)
+	{
+		PrefetchedBiomeHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths));
+	}
+}
+
+void ATowerProceduralFloorRenderer::AcquireBiomeMaterials()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_AcquireBiomeMaterials);
+	TArray<FSoftObjectPath> Paths;
+	CollectBiomeMaterialPaths(CachedRooms, Paths);
+
+	// The new request holds what is still wanted before the old handles let go of it
+	TSharedPtr<FStreamableHandle> Handle;
+	if (Paths.Num() > 0)
+	{
+		const bool bAllLoaded = !Paths.ContainsByPredicate([](const FSoftObjectPath& Path) { return !Path.ResolveObject(); });
+		Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths);
+		if (Handle.IsValid() && !bAllLoaded)
+		{
+			UE_LOG(LogFloorRenderer, Log, TEXT("Biome materials weren't prefetched; waiting on %d"), Paths.Num());
+			Handle->WaitUntilComplete();
+		}
+	}
+
+	ReleaseStreamable(BiomeMaterialHandle);
+	ReleaseStreamable(PrefetchedBiomeHandle);
+	BiomeMaterialHandle = MoveTemp(Handle);
+}
+
 void ATowerProceduralFloorRenderer::ConfigureCollision(UInstancedStaticMeshComponent* ISM, ETowerTileType TileType)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_ConfigureCollision);
 	if (!ISM) return;
 
+	if (UsesMergedCollision(TileType))
+	{
+		// The chunk's merged collider blocks for these instead (BakeChunkCollision)
+		ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		return;
+	}
+
 	switch (TileType)
 	{
 	case ETowerTileType::Wall:
@@ -637,6 +2197,36 @@ void ATowerProceduralFloorRenderer::ConfigureNavigation(UInstancedStaticMeshComp
 	}
 }
 
+FBox ATowerProceduralFloorRenderer::GetCellBounds(int32 X, int32 Y) const
+{
+	// Tall enough for any tile type, from void pits below the floor to wind columns
+	const float CenterX = static_cast<float>(X) * RenderConfig.TileSize;
+	const float CenterY = static_cast<float>(Y) * RenderConfig.TileSize;
+	const float HalfTile = RenderConfig.TileSize * 0.5f;
+	return FBox(
+		FVector(CenterX - HalfTile, CenterY - HalfTile, -RenderConfig.TileSize * 0.5f),
+		FVector(CenterX + HalfTile, CenterY + HalfTile, RenderConfig.WallHeight * 1.5f));
+}
+
+bool ATowerProceduralFloorRenderer::IsNavigationDynamic() const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance() : nullptr;
+	return NavData && NavData->GetRuntimeGenerationMode() == ERuntimeGenerationType::Dynamic;
+}
+
+void ATowerProceduralFloorRenderer::DirtyNavigation(const FBox& WorldBounds) const
+{
+	if (!WorldBounds.IsValid || !IsNavigationDynamic())
+	{
+		return;
+	}
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+	{
+		NavSys->AddDirtyArea(WorldBounds, ENavigationDirtyFlag::All);
+	}
+}
+
 UPointLightComponent* ATowerProceduralFloorRenderer::SpawnRoomLight(const FRoomRenderData& Room)
 {
 	// Place light at room center, elevated above wall height
@@ -682,6 +2272,207 @@ UPointLightComponent* ATowerProceduralFloorRenderer::SpawnRoomLight(const FRoomR
 	return Light;
 }
 
+void ATowerProceduralFloorRenderer::AddRoomLight(const FRoomRenderData& Room)
+{
+	UPointLightComponent* Light = SpawnRoomLight(Room);
+	if (!Light)
+	{
+		return;
+	}
+
+	FRoomLightState& State = RoomLightStates.AddDefaulted_GetRef();
+	State.TargetIntensity = Light->Intensity;
+	State.Priority = GetRoomLightPriority(Room.RoomType);
+	RoomLights.Add(Light);
+
+	if (RenderConfig.MaxActiveRoomLights > 0)
+	{
+		// Starts dark; the next budget pass fades it in if it makes the cut
+		Light->SetIntensity(0.0f);
+		Light->SetVisibility(false);
+		Light->SetCastShadows(false);
+	}
+	else
+	{
+		State.bWanted = true;
+		State.Fade = 1.0f;
+	}
+}
+
+void ATowerProceduralFloorRenderer::SetRoomLightBudgetScale(float Scale)
+{
+	if (RoomLightBudgetScale == Scale)
+	{
+		return;
+	}
+	RoomLightBudgetScale = Scale;
+	UpdateRoomLightBudget();
+}
+
+int32 ATowerProceduralFloorRenderer::GetRoomLightBudget() const
+{
+	return RenderConfig.MaxActiveRoomLights > 0
+		? FMath::Max(1, FMath::RoundToInt(RenderConfig.MaxActiveRoomLights * RoomLightBudgetScale))
+		: 0;
+}
+
+void ATowerProceduralFloorRenderer::UpdateRoomLightBudget()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_UpdateRoomLightBudget);
+	const int32 Budget = GetRoomLightBudget();
+	if (RoomLights.Num() == 0 || Budget <= 0)
+	{
+		return;
+	}
+
+	APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PC)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const FVector ViewDir = ViewRotation.Vector();
+
+	// Score = effective distance; lower wins. Lights behind the camera count as
+	// twice as far unless the view is inside their radius, and room priority
+	// divides the distance so bosses and shrines stay lit from farther away.
+	struct FCandidate
+	{
+		int32 Index;
+		float Score;
+		float DistSq;
+	};
+	TArray<FCandidate, TInlineAllocator<64>> Candidates;
+	for (int32 i = 0; i < RoomLights.Num(); i++)
+	{
+		const UPointLightComponent* Light = RoomLights[i];
+		if (!Light)
+		{
+			continue;
+		}
+
+		const FVector ToLight = Light->GetComponentLocation() - ViewLocation;
+		const float DistSq = ToLight.SizeSquared();
+		const float Radius = Light->AttenuationRadius;
+		if (RenderConfig.ChunkViewDistance > 0.0f && DistSq > FMath::Square(RenderConfig.ChunkViewDistance + Radius))
+		{
+			continue; // Its room is in a hidden chunk
+		}
+
+		float Score = FMath::Sqrt(DistSq);
+		if (DistSq > FMath::Square(Radius) && (ToLight | ViewDir) < 0.0f)
+		{
+			Score *= 2.0f;
+		}
+		Score /= FMath::Max(RoomLightStates[i].Priority, KINDA_SMALL_NUMBER);
+		Candidates.Add({ i, Score, DistSq });
+	}
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Score < B.Score; });
+	const int32 NumActive = FMath::Min(Candidates.Num(), Budget);
+
+	for (FRoomLightState& State : RoomLightStates)
+	{
+		State.bWanted = false;
+	}
+
+	// Shadows go to the nearest active lights, by real distance
+	TArray<FCandidate, TInlineAllocator<64>> Active(Candidates.GetData(), NumActive);
+	Active.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistSq < B.DistSq; });
+	const float ShadowDistSq = FMath::Square(RenderConfig.RoomLightShadowDistance);
+	for (int32 Rank = 0; Rank < Active.Num(); Rank++)
+	{
+		const int32 Index = Active[Rank].Index;
+		RoomLightStates[Index].bWanted = true;
+
+		const bool bShadowed = Rank < RenderConfig.MaxShadowedRoomLights && Active[Rank].DistSq <= ShadowDistSq;
+		UPointLightComponent* Light = RoomLights[Index];
+		if (Light->CastShadows != bShadowed)
+		{
+			Light->SetCastShadows(bShadowed);
+		}
+	}
+
+	if (AdvanceRoomLightFades(0.0f))
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+bool ATowerProceduralFloorRenderer::AdvanceRoomLightFades(float DeltaSeconds)
+{
+	const float Step = RenderConfig.RoomLightFadeSeconds > 0.0f ? DeltaSeconds / RenderConfig.RoomLightFadeSeconds : 1.0f;
+
+	bool bFading = false;
+	for (int32 i = 0; i < RoomLights.Num(); i++)
+	{
+		UPointLightComponent* Light = RoomLights[i];
+		FRoomLightState& State = RoomLightStates[i];
+		const float Goal = State.bWanted ? 1.0f : 0.0f;
+		if (!Light || State.Fade == Goal)
+		{
+			continue;
+		}
+
+		State.Fade = FMath::Clamp(State.Fade + (State.bWanted ? Step : -Step), 0.0f, 1.0f);
+		Light->SetIntensity(State.TargetIntensity * State.Fade);
+		Light->SetVisibility(State.Fade > 0.0f);
+		bFading |= State.Fade != Goal;
+	}
+	return bFading;
+}
+
+void ATowerProceduralFloorRenderer::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!AdvanceRoomLightFades(DeltaSeconds))
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void ATowerProceduralFloorRenderer::AddTileWarmup(UTowerPSOWarmupSubsystem& Warmup, TConstArrayView<ETowerTileType> TileTypes) const
+{
+	// Same mesh and material choice as GetOrCreateISM, for every biome it could pick
+	TArray<UMaterialInterface*, TInlineAllocator<8>> Materials;
+	if (TileMasterMaterial)
+	{
+		Materials.Add(TileMasterMaterial);
+	}
+	else
+	{
+		// Only what is loaded; the rest isn't going to be drawn next
+		for (const TPair<FName, TSoftObjectPtr<UMaterialInterface>>& Biome : BiomeMaterials)
+		{
+			if (UMaterialInterface* Material = Biome.Value.Get())
+			{
+				Materials.AddUnique(Material);
+			}
+		}
+		Materials.AddUnique(DefaultMaterial);
+	}
+
+	for (ETowerTileType TileType : TileTypes)
+	{
+		if (TileType == ETowerTileType::Empty) continue;
+		if (TileType == ETowerTileType::Wall && UsesGreedyWalls()) continue;
+
+		UStaticMesh* Mesh = TileMeshes.FindRef(TileType);
+		if (!Mesh)
+		{
+			Mesh = GetDefaultMeshForType(TileType);
+		}
+		for (UMaterialInterface* Material : Materials)
+		{
+			Warmup.AddMesh(Mesh, Material, /*bInstanced=*/true);
+		}
+	}
+}
+
 UStaticMesh* ATowerProceduralFloorRenderer::GetDefaultMeshForType(ETowerTileType TileType) const
 {
 	// All tile types fall back to the cube primitive.
@@ -721,6 +2512,18 @@ float ATowerProceduralFloorRenderer::GetRoomLightIntensity(const FString& RoomTy
 	return 1.0f;
 }
 
+float ATowerProceduralFloorRenderer::GetRoomLightPriority(const FString& RoomType)
+{
+	if (RoomType == TEXT("boss"))        return 3.0f;   // Visible across the arena
+	if (RoomType == TEXT("shrine"))      return 1.5f;
+	if (RoomType == TEXT("treasure"))    return 1.5f;
+	if (RoomType == TEXT("entrance"))    return 1.2f;
+	if (RoomType == TEXT("corridor"))    return 0.6f;   // First to go dark
+	if (RoomType == TEXT("secret"))      return 0.5f;
+
+	return 1.0f;
+}
+
 int64 ATowerProceduralFloorRenderer::PackGridKey(int32 X, int32 Y)
 {
 	// Pack two int32 values into a single int64 for TMap key.
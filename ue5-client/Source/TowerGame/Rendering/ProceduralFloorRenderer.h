@@ -3,13 +3,22 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Core/TowerMemory.h"
+#include "Core/MonsterTags.h"
 #include "ProceduralFloorRenderer.generated.h"
 
 class UPointLightComponent;
+class UProceduralMeshComponent;
 class UBoxComponent;
 class UStaticMesh;
 class UMaterialInterface;
 class UMaterialInstanceDynamic;
+class FChunkStreamDecoder;
+class UTowerPSOWarmupSubsystem;
+class UTowerGRPCClientManager;
+struct FProtoFloorTileData;
+struct FPackedTileGrid;
+struct FStreamableHandle;
 
 // ============================================================================
 // Tile type enum — matches Rust tile_to_u8 in bridge/mod.rs
@@ -101,9 +110,9 @@ struct FRoomRenderData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
 	FString RoomType;
 
-	/** Semantic biome tags for material selection (e.g. "stone,moss,damp") */
+	/** Semantic biome tags for material selection (e.g. stone, moss, damp), in priority order */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
-	TArray<FString> BiomeTags;
+	TArray<FName> BiomeTags;
 
 	/** Ambient light color for this room */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
@@ -132,13 +141,45 @@ struct FMonsterSpawnData
 
 	/** Element type for VFX coloring */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
-	FString Element;
+	EMonsterElement Element = EMonsterElement::Neutral;
 
 	/** Size category for mesh scaling */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
-	FString Size;
+	EMonsterSize Size = EMonsterSize::Unknown;
 };
 
+/**
+ * How tiles in rooms carrying a biome tag are drawn by the master tile material.
+ */
+USTRUCT(BlueprintType)
+struct FBiomeInstanceStyle
+{
+	GENERATED_BODY()
+
+	/** Multiplied into the tile's base color */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
+	FLinearColor Tint = FLinearColor::White;
+
+	/** Emissive strength (0 = none) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor", meta = (ClampMin = "0.0"))
+	float Emissive = 0.0f;
+};
+
+/**
+ * Per-instance custom data written to every tile instance, read by the master
+ * tile material through PerInstanceCustomData[Index].
+ */
+namespace TileCustomData
+{
+	constexpr int32 TintR = 0;
+	constexpr int32 TintG = 1;
+	constexpr int32 TintB = 2;
+	/** 0-1, stable per grid cell */
+	constexpr int32 Wear = 3;
+	constexpr int32 Emissive = 4;
+	constexpr int32 NumFloats = 5;
+}
+
 /**
  * Configuration for floor rendering dimensions and defaults.
  * Sizes in Unreal Units (1 UU = 1 cm).
@@ -172,10 +213,63 @@ struct FFloorRenderConfig
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor", meta = (ClampMin = "100.0", ClampMax = "5000.0"))
 	float DefaultLightRadius = 1200.0f;
 
+	/**
+	 * Room lights switched on at once; the rest stay off until the player nears
+	 * them. Caps the dynamic light cost of big floors. 0 = every light on.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Lighting", meta = (ClampMin = "0", ClampMax = "64"))
+	int32 MaxActiveRoomLights = 8;
+
+	/** Of the active lights, how many of the nearest may cast shadows */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Lighting", meta = (ClampMin = "0", ClampMax = "64"))
+	int32 MaxShadowedRoomLights = 3;
+
+	/** Active lights farther than this from the view never cast shadows */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Lighting", meta = (ClampMin = "0.0"))
+	float RoomLightShadowDistance = 3000.0f;
+
+	/** Seconds a light takes to fade fully in or out when it enters or leaves the budget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Lighting", meta = (ClampMin = "0.0"))
+	float RoomLightFadeSeconds = 0.5f;
+
+	/** Seconds between re-picks of the active lights */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Lighting", meta = (ClampMin = "0.05"))
+	float RoomLightBudgetInterval = 0.2f;
+
 	/** Maximum LOD distance — tiles beyond this are culled from ISM */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor", meta = (ClampMin = "1000.0"))
 	float MaxLODDistance = 30000.0f;
 
+	/**
+	 * Side of a render chunk in tiles. Each chunk gets its own HISM per tile type,
+	 * so culling, collision and tile mutations stay local to it. 0 = one chunk.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor", meta = (ClampMin = "0", ClampMax = "256"))
+	int32 ChunkSizeTiles = 16;
+
+	/** Chunks farther than this from the player's view are hidden (collision stays). 0 = never hide. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor", meta = (ClampMin = "0.0"))
+	float ChunkViewDistance = 20000.0f;
+
+	/**
+	 * Collide walls and floors through a few greedy-merged boxes per chunk (one
+	 * body) instead of a box per instance. Other tile types keep per-instance collision.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
+	bool bMergeCollision = true;
+
+	/**
+	 * Draw walls as one greedy-meshed procedural mesh per chunk: only faces not
+	 * against another wall, merged into as few quads as possible. Cuts vertex and
+	 * overdraw cost on low-end GPUs; uses WallAtlasMaterial.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
+	bool bGreedyMeshWalls = false;
+
+	/** Seconds between chunk visibility updates */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor", meta = (ClampMin = "0.05"))
+	float ChunkVisibilityInterval = 0.25f;
+
 	/** Enable Nanite for instanced meshes (requires Nanite-enabled meshes) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor")
 	bool bEnableNanite = true;
@@ -192,6 +286,150 @@ struct FFloorRenderConfig
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFloorGenerated, int32, TotalTiles);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnTileMutated, int32, X, int32, Y, ETowerTileType, NewType);
 
+/** Stages of a time-sliced floor build, in the order they run */
+enum class ETimeSlicedFloorPhase : uint8
+{
+	Idle,
+	Instances,
+	Collision,
+	BakeChunks,
+	Lights,
+	Navigation,
+	WaitForNavigation,
+};
+
+/** Where the last time-sliced build spent its time; navigation includes waiting on async tiles */
+struct FFloorBuildTimings
+{
+	double InstancesSeconds = 0.0;
+	double CollisionSeconds = 0.0;
+	double BakeSeconds = 0.0;
+	double LightsSeconds = 0.0;
+	double NavigationSeconds = 0.0;
+};
+
+/** Tiles bound for one ISM in an AddTileInstances call, with their instance data built ahead of the bulk add */
+struct FTileInstanceBatch
+{
+	int32 ISMIdx = INDEX_NONE;
+	TArray<const FTileRenderData*> Tiles;
+	TArray<FTransform> Transforms;
+
+	/** TileCustomData::NumFloats per tile */
+	TArray<float> CustomData;
+};
+
+/** Light budget bookkeeping for one room light */
+struct FRoomLightState
+{
+	/** Intensity at full fade-in */
+	float TargetIntensity = 0.0f;
+
+	/** Room-type weight; higher stays in the budget from farther away */
+	float Priority = 1.0f;
+
+	/** 0 = off, 1 = full intensity */
+	float Fade = 0.0f;
+
+	/** In the active budget as of the last re-pick */
+	bool bWanted = false;
+};
+
+/**
+ * Dense per-cell floor state over the floor's bounding rectangle: tile type,
+ * owning room and HISM instance, as parallel row-major arrays. O(1) lookups with
+ * no hashing, at ~11 bytes a cell where the old per-tile maps took several times
+ * that. Grows (and repacks) when a cell lands outside the current rectangle.
+ */
+struct FFloorCellGrid
+{
+	/** Where a cell's tile instance lives; Component is INDEX_NONE for none */
+	struct FInstanceRef
+	{
+		int32 Component = INDEX_NONE;
+		int32 Instance = INDEX_NONE;
+	};
+
+	void Reset();
+
+	/** Make sure the inclusive rectangle Min..Max is addressable */
+	void Include(FIntPoint Min, FIntPoint Max);
+
+	/** Row-major index of (X,Y), or INDEX_NONE when outside the grid */
+	int32 IndexOf(int32 X, int32 Y) const
+	{
+		const int32 LX = X - Origin.X;
+		const int32 LY = Y - Origin.Y;
+		return (LX >= 0 && LX < Width && LY >= 0 && LY < Height) ? LY * Width + LX : INDEX_NONE;
+	}
+
+	ETowerTileType GetType(int32 X, int32 Y) const
+	{
+		const int32 Index = IndexOf(X, Y);
+		return Index != INDEX_NONE ? Types[Index] : ETowerTileType::Empty;
+	}
+
+	/** Grows to include (X,Y) unless Type is Empty */
+	void SetType(int32 X, int32 Y, ETowerTileType Type);
+
+	/** Instance of the tile at (X,Y), or nullptr if it has none */
+	FInstanceRef* FindInstance(int32 X, int32 Y);
+
+	/** Grows to include (X,Y) */
+	void SetInstance(int32 X, int32 Y, int32 Component, int32 Instance);
+	void ClearInstance(int32 X, int32 Y);
+
+	/** Index of the room covering (X,Y), or INDEX_NONE */
+	int32 GetRoom(int32 X, int32 Y) const
+	{
+		const int32 Index = IndexOf(X, Y);
+		return Index != INDEX_NONE ? Rooms[Index] : INDEX_NONE;
+	}
+
+	/** Stamp room indices over their rectangles; where rooms overlap the first one wins */
+	void AssignRooms(TConstArrayView<FRoomRenderData> InRooms);
+
+	FIntPoint Origin = FIntPoint::ZeroValue;
+	int32 Width = 0;
+	int32 Height = 0;
+
+	TArray<ETowerTileType> Types;
+	TArray<int16> Rooms;
+	TArray<FInstanceRef> Instances;
+};
+
+/**
+ * One ChunkSizeTiles square of a rendered floor and its HISMs.
+ */
+struct FFloorRenderChunk
+{
+	FIntPoint Coord = FIntPoint::ZeroValue;
+
+	/** Index into TileInstances per tile type, INDEX_NONE until the chunk has that type */
+	int32 ISMByType[static_cast<int32>(ETowerTileType::MAX)];
+
+	bool bVisible = true;
+
+	/** Cells this chunk has held tiles in, inclusive; valid once bHasCells */
+	FIntPoint MinCell = FIntPoint::ZeroValue;
+	FIntPoint MaxCell = FIntPoint::ZeroValue;
+	bool bHasCells = false;
+
+	/** Wall or floor cells changed since the merged collision was last baked */
+	bool bCollisionDirty = false;
+
+	/** Walls in or next to this chunk changed since its greedy wall mesh was built */
+	bool bWallMeshDirty = false;
+
+	FFloorRenderChunk()
+	{
+		for (int32& ISMIdx : ISMByType)
+		{
+			ISMIdx = INDEX_NONE;
+		}
+	}
+};
+
 // ============================================================================
 // ATowerProceduralFloorRenderer
 // ============================================================================
@@ -203,13 +441,19 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnTileMutated, int32, X, int32,
  * and creates an efficient visual representation using instanced static meshes.
  *
  * Features:
- * - Instanced rendering: tiles grouped by type into ISM components for batching
+ * - Instanced rendering: tiles grouped by type into HISM components for batching
+ *   and per-cluster culling; biome tint, wear and emissive ride along as
+ *   per-instance custom data, so multi-biome floors cost no extra draw calls
+ * - Spatial chunks: each ChunkSizeTiles square has its own HISMs, hidden beyond
+ *   ChunkViewDistance from the player
  * - Nanite-compatible: meshes use Nanite when available for massive poly counts
  * - Lumen-compatible: materials and lights configured for hardware ray-traced GI
  * - Room-based biome materials: semantic tags drive material assignment
  * - Dynamic point lights per room with biome-appropriate color
- * - Collision setup for walls, floors, and interactive objects
- * - Navigation mesh support for AI pathfinding
+ * - Collision setup for walls, floors, and interactive objects; walls and floors
+ *   collide through greedy-merged boxes per chunk (bMergeCollision)
+ * - Navigation mesh support for AI pathfinding: with a dynamic navmesh, new tiles
+ *   and mutations dirty only their own cells instead of rebuilding the floor
  * - Runtime mutation: individual tiles can change type (Seed+Delta model)
  * - LOD management for large floor layouts
  */
@@ -224,15 +468,46 @@ public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Only enabled while room lights are fading */
+	virtual void Tick(float DeltaSeconds) override;
+
 	// ============ Mesh & Material Assets ============
 
 	/** Static mesh to use for each tile type. Assign in editor or via data table. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
 	TMap<ETowerTileType, UStaticMesh*> TileMeshes;
 
-	/** Material overrides keyed by biome tag (e.g. "stone", "moss", "crystal"). */
+	/**
+	 * Material for every tile type, reading TileCustomData for biome tint, wear and
+	 * emissive. When unset, each type's ISM falls back to BiomeMaterials for the
+	 * biome of its first tile.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
+	UMaterialInterface* TileMasterMaterial;
+
+	/**
+	 * Material for greedy-meshed walls (RenderConfig.bGreedyMeshWalls). UV0 is in
+	 * tiles and repeats per tile; the biome's atlas region comes in as offset (UV1)
+	 * and size (UV2), so sample at frac(UV0) * UV2 + UV1. Vertex color is the biome
+	 * tint, with emissive in alpha.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
-	TMap<FString, UMaterialInterface*> BiomeMaterials;
+	UMaterialInterface* WallAtlasMaterial;
+
+	/** Atlas region (0-1 UVs) of each biome tag's wall texture; the whole atlas when a room has none */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
+	TMap<FName, FBox2D> BiomeAtlasRegions;
+
+	/** Per-instance look keyed by biome tag; a room uses the first tag with an entry */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
+	TMap<FName, FBiomeInstanceStyle> BiomeStyles;
+
+	/**
+	 * Material overrides keyed by biome tag (e.g. "stone", "moss", "crystal"). Only used
+	 * without TileMasterMaterial. Only the current floor's are loaded (see PrefetchBiomeAssets).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
+	TMap<FName, TSoftObjectPtr<UMaterialInterface>> BiomeMaterials;
 
 	/** Fallback material when no biome match is found */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Assets")
@@ -246,7 +521,7 @@ public:
 
 	// ============ Runtime State (Read-Only) ============
 
-	/** Active ISM components, one per tile type */
+	/** Active HISM components, one per tile type per chunk */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower|Floor|Runtime")
 	TArray<UInstancedStaticMeshComponent*> TileInstances;
 
@@ -254,14 +529,23 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower|Floor|Runtime")
 	TArray<UPointLightComponent*> RoomLights;
 
-	/** Current tile grid — 2D tile type lookup by (X,Y) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower|Floor|Runtime")
-	TMap<int64, ETowerTileType> TileGrid;
-
 	/** Current room data cache */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower|Floor|Runtime")
 	TArray<FRoomRenderData> CachedRooms;
 
+	/** What a room's biome tags resolve to, looked up once when the floor's rooms arrive */
+	struct FRoomBiomeLook
+	{
+		/** First tag with an atlas region or style, for merging walls; None if no tag has one */
+		FName WallTag;
+		FBiomeInstanceStyle Style;
+		/** ResolveBiomeMaterial of the tags; held by BiomeMaterials */
+		UMaterialInterface* Material = nullptr;
+	};
+
+	/** Parallel to CachedRooms */
+	TArray<FRoomBiomeLook> RoomBiomeLooks;
+
 	/** Total number of rendered tile instances */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower|Floor|Runtime")
 	int32 TotalRenderedTiles = 0;
@@ -291,12 +575,122 @@ public:
 		const TArray<FTileRenderData>& Tiles,
 		const TArray<FRoomRenderData>& Rooms);
 
+	/**
+	 * GenerateFloorFromData for a packed grid (ChunkData.packed_tiles, the floor
+	 * cache). The cell grid is sized once and runs are expanded straight into it;
+	 * Empty runs are skipped without visiting their cells.
+	 * @return False if Grid is malformed (the floor is left cleared)
+	 */
+	bool GenerateFloorFromPackedGrid(const FPackedTileGrid& Grid, const TArray<FRoomRenderData>& Rooms);
+
+	// ============ Streamed Floors ============
+
+	/**
+	 * Start a floor whose tiles arrive in batches. Clears the current floor,
+	 * caches the rooms and spawns their lights so batches only add instances.
+	 *
+	 * @param Rooms     Array of room render data from Rust core
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tower|Floor|Streaming")
+	void BeginStreamedFloor(const TArray<FRoomRenderData>& Rooms);
+
+	/**
+	 * Add one batch of tiles to the floor started by BeginStreamedFloor.
+	 * Tiles appear immediately; navigation is rebuilt once in FinishStreamedFloor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tower|Floor|Streaming")
+	void AppendTileBatch(const TArray<FTileRenderData>& Tiles);
+
+	/** Rebuild navigation and broadcast OnFloorGenerated for a streamed floor */
+	UFUNCTION(BlueprintCallable, Category = "Tower|Floor|Streaming")
+	void FinishStreamedFloor();
+
+	/** True between BeginStreamedFloor and FinishStreamedFloor */
+	UFUNCTION(BlueprintPure, Category = "Tower|Floor|Streaming")
+	bool IsStreamingFloor() const { return bStreamingFloor; }
+
+	/**
+	 * Begin applying a serialized tower.game.ChunkData as it downloads.
+	 * Pass each received slice to ReceiveChunkBytes; tiles are decoded and
+	 * added every ChunkStreamRowsPerBatch rows.
+	 */
+	void BeginChunkStream(const TArray<FRoomRenderData>& Rooms);
+
+	/** Feed the next slice of ChunkData bytes. Returns false once the stream is malformed. */
+	bool ReceiveChunkBytes(TArrayView<const uint8> Bytes);
+
+	/**
+	 * End the chunk stream: applies the last rows and finishes the floor.
+	 * @return True if the stream decoded cleanly and its incrementally computed hash matches
+	 */
+	bool EndChunkStream();
+
+	/**
+	 * Download a floor through Client and build it as it arrives: BeginChunkStream
+	 * now, every received slice into ReceiveChunkBytes, EndChunkStream when the
+	 * download ends. A failed download still finishes with the rows that came.
+	 * @return RequestId of the download
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tower|Floor|Streaming")
+	int64 StreamFloorChunk(UTowerGRPCClientManager* Client, int64 TowerSeed, int32 FloorId, const TArray<FRoomRenderData>& Rooms);
+
+	/** Rows of tiles decoded before a batch is handed to AppendTileBatch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|Streaming", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 ChunkStreamRowsPerBatch = 4;
+
+	// ============ Time-Sliced Floors ============
+
+	/**
+	 * Start building a floor across several frames. Clears the current floor and
+	 * queues the tiles and rooms; TickTimeSlicedFloor then adds the instances,
+	 * enables collision, spawns lights and builds navigation a step at a time.
+	 */
+	void BeginTimeSlicedFloor(const TArray<FTileRenderData>& Tiles, const TArray<FRoomRenderData>& Rooms);
+
+	/**
+	 * Work on the build started by BeginTimeSlicedFloor for about BudgetSeconds
+	 * (<= 0 finishes it in this call). The budget is checked between steps, so a
+	 * call can overrun it by one step.
+	 * @return True once the floor is complete and OnFloorGenerated has fired
+	 */
+	bool TickTimeSlicedFloor(double BudgetSeconds);
+
+	/** 0-1 through the time-sliced build; 1 when none is in progress */
+	float GetTimeSlicedProgress() const;
+
+	bool IsBuildingTimeSliced() const { return BuildPhase != ETimeSlicedFloorPhase::Idle; }
+
+	/** Per-phase cost of the last (or current) time-sliced build */
+	const FFloorBuildTimings& GetLastBuildTimings() const { return BuildTimings; }
+
+	/**
+	 * Draw calls the floor geometry issues with nothing culled: one per material
+	 * section of each non-empty HISM and of each wall mesh. Lights not included.
+	 */
+	int32 EstimateDrawCalls() const;
+
+	/** Tiles added per step of a time-sliced build */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Floor|TimeSlicing", meta = (ClampMin = "16", ClampMax = "8192"))
+	int32 TimeSlicedTilesPerStep = 256;
+
 	/**
 	 * Destroy all rendered floor geometry, lights, and collision.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
 	void ClearFloor();
 
+	/**
+	 * Park the floor (or wake it) while it stays resident behind another one in the
+	 * same space: hidden, no collision, no tick or timers, and out of the navmesh.
+	 * Waking dirties its bounds so a dynamic navmesh takes it back in.
+	 */
+	void SetFloorDormant(bool bInDormant);
+
+	bool IsFloorDormant() const { return bDormant; }
+
+	/** Rough bytes the floor holds: our containers plus the engine's estimate for its components */
+	int64 EstimateFloorBytes() const;
+
 	/**
 	 * Mutate a single tile at runtime (Seed+Delta model).
 	 * Removes the old instance and adds a new one of the target type.
@@ -308,6 +702,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Tower|Floor")
 	void UpdateTileState(int32 X, int32 Y, ETowerTileType NewType);
 
+	/**
+	 * Mutate many tiles at once, e.g. replaying a floor's delta journal. Same as calling
+	 * UpdateTileState per cell, but dirty chunks are re-merged once at the end.
+	 */
+	void UpdateTileStates(TConstArrayView<FIntPoint> Cells, TConstArrayView<ETowerTileType> Types);
+
+	/**
+	 * Apply tiles that arrive piecemeal with no floor build around them, e.g. a
+	 * server-replicated floor. Tiles on empty cells are added in bulk like a
+	 * streamed batch; the rest go through one UpdateTileStates. Tiles of the type
+	 * their cell already has are skipped. Each cell should appear at most once.
+	 */
+	void ApplyTileUpdates(TConstArrayView<FTileRenderData> Tiles);
+
+	/**
+	 * Start loading the BiomeMaterials the rooms' tags pick, ahead of the floor they
+	 * belong to. Held until the next floor's rooms are assigned; whatever that floor
+	 * doesn't use is released then, along with the last floor's materials.
+	 */
+	void PrefetchBiomeAssets(TConstArrayView<FRoomRenderData> Rooms);
+
+	/** Multiply MaxActiveRoomLights (keeping at least one) and re-pick the lit rooms; set by UTowerPerfScalerSubsystem */
+	void SetRoomLightBudgetScale(float Scale);
+
+	/** MaxActiveRoomLights after the budget scale; 0 = unbudgeted */
+	int32 GetRoomLightBudget() const;
+
+	/** Add the tile meshes and materials a floor with these tile types will draw to a PSO warm-up */
+	void AddTileWarmup(UTowerPSOWarmupSubsystem& Warmup, TConstArrayView<ETowerTileType> TileTypes) const;
+
 	/**
 	 * Place visual markers at monster spawn locations.
 	 * Spawn indicators use the Spawner tile mesh with element-based coloring.
@@ -344,6 +768,12 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Tower|Floor")
 	bool GetRoomAtGrid(int32 X, int32 Y, FRoomRenderData& OutRoom) const;
 
+	/** Cells the floor covers, Min inclusive and Max exclusive; empty with no floor */
+	FIntRect GetGridBounds() const { return FIntRect(CellGrid.Origin, CellGrid.Origin + FIntPoint(CellGrid.Width, CellGrid.Height)); }
+
+	/** Index into CachedRooms of the room covering (X,Y), or INDEX_NONE */
+	int32 GetRoomIndexAt(int32 X, int32 Y) const { return CellGrid.GetRoom(X, Y); }
+
 private:
 	// ============ Scene Root ============
 
@@ -352,14 +782,80 @@ private:
 
 	// ============ Internal Helpers ============
 
-	/** Create or retrieve the ISM component for a tile type */
-	UInstancedStaticMeshComponent* GetOrCreateISMForType(ETowerTileType TileType);
+	/** Add instances for Tiles to the ISMs, creating and texturing ISMs on first use per type */
+	void AddTileInstances(TArrayView<const FTileRenderData> Tiles);
+
+	/** Fill each batch's transforms and custom data, in parallel across spans of tiles */
+	void BuildInstanceBatches(TArrayView<FTileInstanceBatch> Batches) const;
+
+	/** Rebuild navigation and broadcast OnFloorGenerated */
+	void CompleteFloor();
+
+	/** Measure the floor state this actor holds into the Floor memory bucket */
+	void ReportFloorMemory();
+
+	/** One step of the time-sliced build; false when the rest of this frame's budget should be skipped */
+	bool StepTimeSlicedFloor(bool bUnbounded);
+
+	/** FChunkStreamDecoder callback: convert a decoded batch and append it */
+	void OnChunkTileBatch(TArrayView<const FProtoFloorTileData> Tiles);
+
+	/** Create or retrieve the ISM for a tile type in the chunk containing (X,Y); returns its TileInstances index or INDEX_NONE */
+	int32 GetOrCreateISM(ETowerTileType TileType, int32 X, int32 Y);
+
+	/** Grow the chunk's cell bounds over (X,Y) and flag it for a collision bake if the tile merges */
+	void NoteChunkTile(int32 ChunkIdx, int32 X, int32 Y, ETowerTileType TileType);
+
+	/** The chunk containing (X,Y), created on first use */
+	int32 GetOrCreateChunk(int32 X, int32 Y);
+
+	/** Rebuild the merged wall/floor collision of one chunk from CellGrid */
+	void BakeChunkCollision(int32 ChunkIdx);
+
+	/** Rebuild the greedy wall mesh of one chunk from CellGrid */
+	void BakeChunkWallMesh(int32 ChunkIdx);
+
+	/** Bake the collision and wall mesh of every chunk flagged dirty */
+	void BakeDirtyChunks();
+
+	/** True for tile types whose collision is merged per chunk when bMergeCollision is set */
+	bool UsesMergedCollision(ETowerTileType TileType) const;
+
+	/** True when walls are drawn by BakeChunkWallMesh rather than instances */
+	bool UsesGreedyWalls() const { return RenderConfig.bGreedyMeshWalls; }
+
+	/** Biome tag of the room at (X,Y) used to pick its wall look, or None */
+	FName GetCellBiomeTag(int32 X, int32 Y) const;
+
+	/** Chunk coordinates of a grid cell */
+	FIntPoint GetChunkCoord(int32 X, int32 Y) const;
+
+	/** Show chunks near the player's view point and hide the rest */
+	void UpdateChunkVisibility();
+
+	/** Remove one instance and repoint the grid cell whose instance was swapped into its slot */
+	void RemoveTileInstance(int32 ISMIdx, int32 InstIdx);
 
 	/** Build the transform for a tile at grid position */
 	FTransform BuildTileTransform(int32 X, int32 Y, ETowerTileType TileType) const;
 
+	/** The room containing a grid cell, or nullptr */
+	const FRoomRenderData* FindRoomAtGrid(int32 X, int32 Y) const;
+
+	/** Fill the TileCustomData floats for a tile instance */
+	void BuildTileCustomData(int32 X, int32 Y, ETowerTileType TileType, float (&OutData)[TileCustomData::NumFloats]) const;
+
 	/** Select material for a tile based on room biome tags */
-	UMaterialInterface* ResolveBiomeMaterial(const TArray<FString>& BiomeTags) const;
+	UMaterialInterface* ResolveBiomeMaterial(const TArray<FName>& BiomeTags) const;
+
+	/** Cache a floor's rooms, index them in CellGrid and resolve each one's RoomBiomeLooks entry */
+	void AssignRooms(const TArray<FRoomRenderData>& Rooms);
+
+	/** BiomeMaterials entries any of the rooms' tags could resolve to */
+	void CollectBiomeMaterialPaths(TConstArrayView<FRoomRenderData> Rooms, TArray<FSoftObjectPath>& OutPaths) const;
+
+	/** Load (waiting if the prefetch missed) and hold the materials CachedRooms use, dropping the rest */
+	void AcquireBiomeMaterials();
 
 	/** Configure collision profile on an ISM based on tile type */
 	void ConfigureCollision(UInstancedStaticMeshComponent* ISM, ETowerTileType TileType);
@@ -367,9 +863,30 @@ private:
 	/** Configure navigation relevance on an ISM */
 	void ConfigureNavigation(UInstancedStaticMeshComponent* ISM, ETowerTileType TileType);
 
+	/** Actor-local bounds of a grid cell, covering every tile type's geometry */
+	FBox GetCellBounds(int32 X, int32 Y) const;
+
+	/** True if the default navmesh regenerates tiles at runtime (RuntimeGeneration=Dynamic) */
+	bool IsNavigationDynamic() const;
+
+	/** Queue the nav tiles overlapping WorldBounds for async regeneration (dynamic navmeshes only) */
+	void DirtyNavigation(const FBox& WorldBounds) const;
+
 	/** Spawn a point light for a room */
 	UPointLightComponent* SpawnRoomLight(const FRoomRenderData& Room);
 
+	/** Spawn a room's light and enroll it in the light budget */
+	void AddRoomLight(const FRoomRenderData& Room);
+
+	/** Re-pick the active room lights by distance, view direction and room priority */
+	void UpdateRoomLightBudget();
+
+	/** Move light fades toward their wanted state; false once all have settled */
+	bool AdvanceRoomLightFades(float DeltaSeconds);
+
+	/** How strongly a room type holds on to its light under the budget */
+	static float GetRoomLightPriority(const FString& RoomType);
+
 	/** Get default mesh for a tile type (engine primitive fallback) */
 	UStaticMesh* GetDefaultMeshForType(ETowerTileType TileType) const;
 
@@ -379,19 +896,83 @@ private:
 	/** Get light intensity multiplier for a room type */
 	static float GetRoomLightIntensity(const FString& RoomType);
 
-	/** Pack grid coordinates into a single int64 key for TileGrid map */
+	/** Pack grid coordinates into a single int64 key */
 	static int64 PackGridKey(int32 X, int32 Y);
 
 	/** Unpack grid key back to X,Y coordinates */
 	static void UnpackGridKey(int64 Key, int32& OutX, int32& OutY);
 
-	/** Mapping from tile type to ISM component index in TileInstances */
-	TMap<ETowerTileType, int32> TypeToISMIndex;
+	/** Render chunks of the current floor, created as tiles land in them */
+	TArray<FFloorRenderChunk> Chunks;
+	TMap<FIntPoint, int32> ChunkIndexByCoord;
 
-	/** Per-instance mapping: grid key -> (ISM index, instance index within ISM) */
-	TMap<int64, TPair<int32, int32>> GridToInstanceMap;
+	/** Per ISM (same index as TileInstances): its tile type and its index in Chunks */
+	TArray<ETowerTileType> ISMTileTypes;
+	TArray<int32> ISMChunks;
+
+	/** Merged wall/floor collider per chunk (same index as Chunks), null until baked */
+	UPROPERTY()
+	TArray<UProceduralMeshComponent*> ChunkColliders;
+
+	/** Greedy wall mesh per chunk (same index as Chunks), null until built */
+	UPROPERTY()
+	TArray<UProceduralMeshComponent*> ChunkWallMeshes;
+
+	FTimerHandle ChunkVisibilityTimer;
+
+	/** Budget state per RoomLights entry (same index) */
+	TArray<FRoomLightState> RoomLightStates;
+
+	FTimerHandle RoomLightBudgetTimer;
+
+	float RoomLightBudgetScale = 1.0f;
+
+	/** Current floor cells: tile type, room and HISM instance per (X,Y) */
+	FFloorCellGrid CellGrid;
+
+	/** Reverse of CellGrid's instance refs, per ISM (same index as TileInstances): grid key of each instance */
+	TArray<TArray<int64>> InstanceGridKeys;
+
+	/** Decoder for the ChunkData stream in progress (BeginChunkStream..EndChunkStream) */
+	TSharedPtr<FChunkStreamDecoder> ChunkStream;
+
+	/** Bumped per StreamFloorChunk, so a superseded download's callbacks are dropped */
+	uint32 ChunkDownloadSerial = 0;
+
+	/** Reused conversion buffer for streamed tile batches, and for ApplyTileUpdates' new tiles */
+	TArray<FTileRenderData> StreamTileScratch;
+
+	bool bStreamingFloor = false;
+
+	/** Time-sliced build state: tiles still to place and the position within the current phase */
+	TArray<FTileRenderData> SlicedTiles;
+	ETimeSlicedFloorPhase BuildPhase = ETimeSlicedFloorPhase::Idle;
+	int32 BuildCursor = 0;
+
+	FFloorBuildTimings BuildTimings;
+	double NavigationWaitStart = 0.0;
+
+	/** Create ISMs without collision; the time-sliced build enables it one ISM per step */
+	bool bDeferCollision = false;
+
+	/** Inside UpdateTileStates: single mutations leave their chunks dirty for one bake at the end */
+	bool bBatchingMutations = false;
+
+	/** Parked by SetFloorDormant, and the components it took out of the navmesh */
+	bool bDormant = false;
+
+	UPROPERTY()
+	TArray<UPrimitiveComponent*> DormantNavComponents;
 
 	/** Cached default cube mesh for fallback rendering */
 	UPROPERTY()
 	UStaticMesh* FallbackCubeMesh;
+
+	/** Keeps the current floor's BiomeMaterials loaded */
+	TSharedPtr<FStreamableHandle> BiomeMaterialHandle;
+
+	/** PrefetchBiomeAssets for the next floor, in flight or loaded */
+	TSharedPtr<FStreamableHandle> PrefetchedBiomeHandle;
+
+	FTowerMemoryReport FloorMemory{ ETowerMemoryBucket::Floor };
 };
@@ -0,0 +1,239 @@
+#include "VFXPoolSubsystem.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+void UTowerVFXPoolSubsystem::Deinitialize()
+{
+    for (TSharedPtr<FStreamableHandle>& Handle : LoadHandles)
+    {
+        if (Handle.IsValid())
+        {
+            Handle->CancelHandle();
+        }
+    }
+    LoadHandles.Empty();
+    RequestedPaths.Empty();
+    Pools.Empty();
+    ActiveByGroup.Empty();
+    GroupByComponent.Empty();
+    PooledComponents.Empty();
+    Super::Deinitialize();
+}
+
+bool UTowerVFXPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+// ============ Loading ============
+
+void UTowerVFXPoolSubsystem::PreloadSystems(const TArray<FSoftObjectPath>& Systems, FSimpleDelegate OnLoaded)
+{
+    TArray<FSoftObjectPath> ToLoad;
+    bool bAllLoaded = true;
+    for (const FSoftObjectPath& Path : Systems)
+    {
+        if (Path.IsNull()) continue;
+        if (!Path.ResolveObject())
+        {
+            bAllLoaded = false;
+        }
+        // Paths already in flight still go in this request, so OnLoaded waits for them
+        ToLoad.AddUnique(Path);
+        RequestedPaths.Add(Path);
+    }
+
+    if (bAllLoaded)
+    {
+        OnLoaded.ExecuteIfBound();
+        return;
+    }
+
+    TSharedPtr<FStreamableHandle> Handle = Streamable.RequestAsyncLoad(ToLoad,
+        FStreamableDelegate::CreateLambda([OnLoaded]() { OnLoaded.ExecuteIfBound(); }));
+    if (Handle.IsValid())
+    {
+        LoadHandles.Add(Handle);
+    }
+}
+
+UNiagaraSystem* UTowerVFXPoolSubsystem::FindSystem(const TSoftObjectPtr<UNiagaraSystem>& System)
+{
+    if (UNiagaraSystem* Loaded = System.Get())
+    {
+        return Loaded;
+    }
+
+    const FSoftObjectPath Path = System.ToSoftObjectPath();
+    if (!Path.IsNull() && !RequestedPaths.Contains(Path))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("VFX %s wasn't preloaded, loading it now"), *Path.ToString());
+        PreloadSystems({ Path });
+    }
+    return nullptr;
+}
+
+// ============ Spawning ============
+
+UNiagaraComponent* UTowerVFXPoolSubsystem::SpawnPooled(UNiagaraSystem* System, const FVector& Location,
+    const FRotator& Rotation, const FVector& Scale)
+{
+    if (!System) return nullptr;
+
+    UWorld* World = GetWorld();
+    const double Now = World->GetTimeSeconds();
+    FSystemPool& Pool = Pools.FindOrAdd(System);
+
+    // Finished first, then a new component while under the cap, else the oldest still playing
+    int32 Reuse = INDEX_NONE;
+    for (int32 i = Pool.Components.Num() - 1; i >= 0; i--)
+    {
+        if (!IsValid(Pool.Components[i]))
+        {
+            Pool.Components.RemoveAtSwap(i);
+            Pool.StartTimes.RemoveAtSwap(i);
+            PooledComponents.RemoveAllSwap([](UNiagaraComponent* Comp) { return !IsValid(Comp); });
+            for (auto It = GroupByComponent.CreateIterator(); It; ++It)
+            {
+                if (!IsValid(It.Key())) It.RemoveCurrent();
+            }
+            continue;
+        }
+        if (!Pool.Components[i]->IsActive())
+        {
+            Reuse = i;
+        }
+    }
+
+    if (Reuse == INDEX_NONE && Pool.Components.Num() < FMath::Max(1, FMath::CeilToInt(MaxInstancesPerSystem * BudgetScale)))
+    {
+        UNiagaraComponent* NewComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+            World, System, Location, Rotation, Scale,
+            false, // bAutoDestroy
+            true,  // bAutoActivate
+            ENCPoolMethod::None);
+        if (NewComp)
+        {
+            NewComp->OnSystemFinished.AddDynamic(this, &UTowerVFXPoolSubsystem::HandleSystemFinished);
+            Pool.Components.Add(NewComp);
+            Pool.StartTimes.Add(Now);
+            PooledComponents.Add(NewComp);
+        }
+        return NewComp;
+    }
+
+    if (Reuse == INDEX_NONE)
+    {
+        if (Pool.Components.Num() == 0) return nullptr;
+
+        Reuse = 0;
+        for (int32 i = 1; i < Pool.StartTimes.Num(); i++)
+        {
+            if (Pool.StartTimes[i] < Pool.StartTimes[Reuse])
+            {
+                Reuse = i;
+            }
+        }
+    }
+
+    UNiagaraComponent* Comp = Pool.Components[Reuse];
+    // Restarting a playing component: it leaves its old group here, not through OnSystemFinished
+    ReleaseSlot(Comp);
+    Pool.StartTimes[Reuse] = Now;
+    Comp->SetWorldLocationAndRotation(Location, Rotation);
+    Comp->SetWorldScale3D(Scale);
+    Comp->Activate(/*bReset=*/true);
+    return Comp;
+}
+
+UNiagaraComponent* UTowerVFXPoolSubsystem::SpawnPooled(UNiagaraSystem* System, const FTowerVFXBudget& Budget,
+    const FVector& Location, const FRotator& Rotation, const FVector& Scale)
+{
+    if (!System) return nullptr;
+    if (Budget.Group.IsNone())
+    {
+        return SpawnPooled(System, Location, Rotation, Scale);
+    }
+
+    UWorld* World = GetWorld();
+    APlayerController* PC = World->GetFirstPlayerController();
+    const bool bHasView = PC && PC->PlayerCameraManager;
+    const FVector CameraLocation = bHasView ? PC->PlayerCameraManager->GetCameraLocation() : FVector::ZeroVector;
+    const double DistSq = bHasView ? FVector::DistSquared(CameraLocation, Location) : 0.0;
+
+    if (bHasView && Budget.CullDistance > 0.0f && DistSq > FMath::Square(Budget.CullDistance))
+    {
+        NumCulled++;
+        return nullptr;
+    }
+
+    TArray<TWeakObjectPtr<UNiagaraComponent>>& Active = ActiveByGroup.FindOrAdd(Budget.Group);
+    Active.RemoveAllSwap([](const TWeakObjectPtr<UNiagaraComponent>& Comp) { return !Comp.IsValid() || !Comp->IsActive(); });
+
+    const int32 MaxActive = Budget.MaxActive > 0 ? FMath::Max(1, FMath::CeilToInt(Budget.MaxActive * BudgetScale)) : 0;
+    if (MaxActive > 0 && Active.Num() >= MaxActive)
+    {
+        // Whichever of the new effect and the furthest playing one is further away goes
+        int32 Furthest = INDEX_NONE;
+        double FurthestDistSq = DistSq;
+        for (int32 i = 0; i < Active.Num(); i++)
+        {
+            const double ActiveDistSq = bHasView ? FVector::DistSquared(CameraLocation, Active[i]->GetComponentLocation()) : 0.0;
+            if (ActiveDistSq > FurthestDistSq)
+            {
+                Furthest = i;
+                FurthestDistSq = ActiveDistSq;
+            }
+        }
+
+        NumCulled++;
+        if (Furthest == INDEX_NONE)
+        {
+            return nullptr;
+        }
+        UNiagaraComponent* Evicted = Active[Furthest].Get();
+        ReleaseSlot(Evicted);
+        Evicted->DeactivateImmediate();
+    }
+
+    UNiagaraComponent* Comp = SpawnPooled(System, Location, Rotation, Scale);
+    if (Comp)
+    {
+        ActiveByGroup.FindOrAdd(Budget.Group).Add(Comp);
+        GroupByComponent.Add(Comp, Budget.Group);
+    }
+    return Comp;
+}
+
+int32 UTowerVFXPoolSubsystem::GetNumActive(FName Group) const
+{
+    const TArray<TWeakObjectPtr<UNiagaraComponent>>* Active = ActiveByGroup.Find(Group);
+    if (!Active) return 0;
+
+    int32 Num = 0;
+    for (const TWeakObjectPtr<UNiagaraComponent>& Comp : *Active)
+    {
+        if (Comp.IsValid() && Comp->IsActive()) Num++;
+    }
+    return Num;
+}
+
+void UTowerVFXPoolSubsystem::HandleSystemFinished(UNiagaraComponent* Component)
+{
+    ReleaseSlot(Component);
+}
+
+void UTowerVFXPoolSubsystem::ReleaseSlot(UNiagaraComponent* Component)
+{
+    FName Group;
+    if (!GroupByComponent.RemoveAndCopyValue(Component, Group)) return;
+
+    if (TArray<TWeakObjectPtr<UNiagaraComponent>>* Active = ActiveByGroup.Find(Group))
+    {
+        Active->RemoveSingleSwap(Component);
+    }
+}
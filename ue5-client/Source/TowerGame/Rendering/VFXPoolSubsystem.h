@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "VFXPoolSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+
+/**
+ * Cap shared by every one-shot spawned under the same Group, whatever its
+ * system. Callers pass it with each spawn; the pool keeps no per-group config.
+ */
+struct FTowerVFXBudget
+{
+    FName Group;
+
+    /** Concurrent effects in Group across all systems; 0 for no cap */
+    int32 MaxActive = 0;
+
+    /** Spawns further than this from the camera are dropped; 0 for no limit */
+    float CullDistance = 0.0f;
+};
+
+/**
+ * Loads Niagara systems off the hot path and recycles their components.
+ *
+ * Systems arrive through async loads. The GameMode preloads the floor's set
+ * while the floor builds, and components preload their own in BeginPlay.
+ * Until a system is in memory, FindSystem returns null and the effect is
+ * skipped. Nothing here ever loads synchronously.
+ *
+ * One-shot effects go through SpawnPooled. Each system keeps up to
+ * MaxInstancesPerSystem components. Once they are all playing, the one that
+ * started longest ago restarts at the new spot, so a big collapse can't stack
+ * dozens of systems.
+ *
+ * A spawn can also carry an FTowerVFXBudget, which caps how many effects of
+ * one kind (all hit sparks, say) play at once across every system. At the
+ * cap the effect furthest from the camera loses: either the new one is
+ * dropped, or the furthest playing one is stopped to make room. A finished
+ * component hands its slot back through OnSystemFinished.
+ */
+UCLASS()
+class TOWERGAME_API UTowerVFXPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // ============ Loading ============
+
+    /** Start loading Systems; OnLoaded runs once all are in (right away if they already are) */
+    void PreloadSystems(const TArray<FSoftObjectPath>& Systems, FSimpleDelegate OnLoaded = FSimpleDelegate());
+
+    /** The system if it's in memory; otherwise null, with a load started */
+    UNiagaraSystem* FindSystem(const TSoftObjectPtr<UNiagaraSystem>& System);
+
+    // ============ Spawning ============
+
+    /** Play a one-shot System at Location from its pool; null if System is null */
+    UNiagaraComponent* SpawnPooled(UNiagaraSystem* System, const FVector& Location,
+        const FRotator& Rotation = FRotator::ZeroRotator, const FVector& Scale = FVector(1.0f));
+
+    /** SpawnPooled under Budget; null if the effect was culled */
+    UNiagaraComponent* SpawnPooled(UNiagaraSystem* System, const FTowerVFXBudget& Budget, const FVector& Location,
+        const FRotator& Rotation = FRotator::ZeroRotator, const FVector& Scale = FVector(1.0f));
+
+    /** Effects playing under Group right now */
+    int32 GetNumActive(FName Group) const;
+
+    /** Spawns dropped by budgets since the world started */
+    int32 GetNumCulled() const { return NumCulled; }
+
+    // ============ Config ============
+
+    /** Concurrent instances of any one system */
+    int32 MaxInstancesPerSystem = 8;
+
+    /** Multiplies MaxInstancesPerSystem and every budget's MaxActive (at least 1 each); set by UTowerPerfScalerSubsystem */
+    float BudgetScale = 1.0f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FSystemPool
+    {
+        TArray<UNiagaraComponent*> Components;
+        TArray<double> StartTimes;
+    };
+
+    /** Budgeted one-shots still playing, by group */
+    TMap<FName, TArray<TWeakObjectPtr<UNiagaraComponent>>> ActiveByGroup;
+
+    /** Group each pooled component last played under, to free its slot on finish */
+    TMap<UNiagaraComponent*, FName> GroupByComponent;
+
+    int32 NumCulled = 0;
+
+    UFUNCTION()
+    void HandleSystemFinished(UNiagaraComponent* Component);
+
+    /** Take Component's slot out of whichever group holds it */
+    void ReleaseSlot(UNiagaraComponent* Component);
+
+    FStreamableManager Streamable;
+
+    /** Keep the requested systems loaded for the world's lifetime */
+    TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+    TSet<FSoftObjectPath> RequestedPaths;
+
+    TMap<UNiagaraSystem*, FSystemPool> Pools;
+
+    /** Keeps the pooled components alive (Pools isn't reflected) */
+    UPROPERTY()
+    TArray<UNiagaraComponent*> PooledComponents;
+};
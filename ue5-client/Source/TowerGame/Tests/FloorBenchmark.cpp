@@ -0,0 +1,267 @@
+// Copyright Tower Game 2026. All Rights Reserved.
+
+#include "FloorBenchmark.h"
+#include "TowerGame/Core/TowerGameMode.h"
+#include "TowerGame/Core/TowerGameSubsystem.h"
+#include "TowerGame/Bridge/ProceduralCoreBridge.h"
+#include "TowerGame/Rendering/ProceduralFloorRenderer.h"
+#include "TowerGame/World/FloorTeardownSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs CmdFloorBench(
+		TEXT("tower.FloorBench"),
+		TEXT("tower.FloorBench <first> <last> [seed] [quit] - generate and build floors first..last and append timings to Saved/Profiling/TowerFloorBench.csv"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (!World || Args.Num() < 2)
+			{
+				return;
+			}
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.bDeferConstruction = true;
+			ATowerFloorBenchmark* Benchmark = World->SpawnActor<ATowerFloorBenchmark>(FTransform::Identity, SpawnParams);
+			if (!Benchmark)
+			{
+				return;
+			}
+
+			Benchmark->FirstFloor = FMath::Max(FCString::Atoi(*Args[0]), 1);
+			Benchmark->LastFloor = FMath::Max(FCString::Atoi(*Args[1]), Benchmark->FirstFloor);
+			for (int32 i = 2; i < Args.Num(); ++i)
+			{
+				if (Args[i] == TEXT("quit"))
+				{
+					Benchmark->bQuitWhenDone = true;
+				}
+				else
+				{
+					Benchmark->Seed = FCString::Atoi64(*Args[i]);
+				}
+			}
+			Benchmark->FinishSpawning(FTransform::Identity);
+		}));
+}
+
+ATowerFloorBenchmark::ATowerFloorBenchmark()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+}
+
+void ATowerFloorBenchmark::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bAutoRun)
+	{
+		RunBenchmark();
+	}
+}
+
+// ============================================================
+// Benchmark Execution
+// ============================================================
+
+void ATowerFloorBenchmark::RunBenchmark()
+{
+	if (IsRunning())
+	{
+		return;
+	}
+
+	UTowerGameSubsystem* TowerSys = GetTowerSubsystem();
+	ATowerGameMode* GameMode = GetTowerGameMode();
+	FProceduralCoreBridge* Bridge = TowerSys ? TowerSys->GetBridge() : nullptr;
+	if (!Bridge || !Bridge->IsInitialized() || !GameMode)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Floor Benchmark: needs the Rust core and an ATowerGameMode"));
+		if (bQuitWhenDone)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+		return;
+	}
+
+	Rows.Empty();
+	RunSeed = Seed != 0 ? Seed : TowerSys->TowerSeed;
+	DllVersion = Bridge->GetVersion();
+
+	// Background generation of the neighbours would land in the next floor's numbers
+	bWasPrefetching = GameMode->bPrefetchAdjacentFloors;
+	GameMode->bPrefetchAdjacentFloors = false;
+
+	UE_LOG(LogTemp, Display, TEXT("========================================"));
+	UE_LOG(LogTemp, Display, TEXT("⏱ Floor Benchmark: floors %d-%d, seed %lld, DLL %s"),
+		FirstFloor, LastFloor, RunSeed, *DllVersion);
+	UE_LOG(LogTemp, Display, TEXT("========================================"));
+
+	CurrentFloor = FirstFloor;
+	SetActorTickEnabled(true);
+	BeginFloor();
+}
+
+void ATowerFloorBenchmark::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ATowerGameMode* GameMode = GetTowerGameMode();
+	if (!IsRunning() || !bBuilding || !GameMode)
+	{
+		return;
+	}
+
+	const double Start = FPlatformTime::Seconds();
+	const bool bDone = GameMode->TickFloorBuild(BuildBudgetSeconds);
+	BuildGameThreadSeconds += FPlatformTime::Seconds() - Start;
+
+	if (bDone)
+	{
+		FinishFloor();
+	}
+}
+
+void ATowerFloorBenchmark::BeginFloor()
+{
+	ATowerGameMode* GameMode = GetTowerGameMode();
+	UTowerGameSubsystem* TowerSys = GetTowerSubsystem();
+	FProceduralCoreBridge* Bridge = TowerSys ? TowerSys->GetBridge() : nullptr;
+	if (!GameMode || !Bridge)
+	{
+		OnBenchmarkComplete();
+		return;
+	}
+
+	// Tear the previous floor down first so its cost and memory stay out of this one
+	GameMode->ClearCurrentFloor();
+	if (UTowerFloorTeardownSubsystem* Teardown = GetWorld()->GetSubsystem<UTowerFloorTeardownSubsystem>())
+	{
+		Teardown->Flush();
+	}
+	MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+	ActorsBefore = GetWorld()->GetActorCount();
+
+	// Generation and parse timed apart, through the JSON export the fallback path uses
+	FGeneratedFloorData Floor;
+	Floor.Seed = RunSeed;
+	Floor.FloorId = CurrentFloor;
+
+	double Start = FPlatformTime::Seconds();
+	const FString LayoutJson = Bridge->GenerateFloorLayout(static_cast<uint64>(RunSeed), static_cast<uint32>(CurrentFloor));
+	LayoutGenMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	Start = FPlatformTime::Seconds();
+	const bool bParsed = Floor.Layout.ParseJson(LayoutJson);
+	ParseMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	Start = FPlatformTime::Seconds();
+	Bridge->GenerateFloorMonsterData(static_cast<uint64>(RunSeed), static_cast<uint32>(CurrentFloor),
+		static_cast<uint32>(GameMode->GetMonsterCountForFloor(CurrentFloor)), Floor.Monsters);
+	MonsterGenMs = (FPlatformTime::Seconds() - Start) * 1000.0;
+
+	NumTiles = Floor.Layout.Tiles.Num();
+	NumMonsters = Floor.Monsters.Num();
+	Floor.bSucceeded = bParsed && Floor.Layout.IsValid();
+	if (!Floor.bSucceeded)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Floor Benchmark: floor %d did not generate"), CurrentFloor);
+	}
+
+	BuildStartSeconds = FPlatformTime::Seconds();
+	GameMode->BeginBuildFloor(Floor);
+	BuildGameThreadSeconds = FPlatformTime::Seconds() - BuildStartSeconds;
+	bBuilding = true;
+}
+
+void ATowerFloorBenchmark::FinishFloor()
+{
+	bBuilding = false;
+
+	ATowerGameMode* GameMode = GetTowerGameMode();
+	const ATowerProceduralFloorRenderer* Renderer = GameMode ? GameMode->GetFloorRenderer() : nullptr;
+	const FFloorBuildTimings Timings = Renderer ? Renderer->GetLastBuildTimings() : FFloorBuildTimings();
+
+	const double WallMs = (FPlatformTime::Seconds() - BuildStartSeconds) * 1000.0;
+	const double IsmMs = (Timings.InstancesSeconds + Timings.CollisionSeconds + Timings.BakeSeconds) * 1000.0;
+	const double MemoryDeltaMB = (static_cast<double>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<double>(MemoryBefore)) / (1024.0 * 1024.0);
+	const int32 Actors = GetWorld()->GetActorCount();
+	const int32 DrawCalls = Renderer ? Renderer->EstimateDrawCalls() : 0;
+
+	Rows.Add(FString::Printf(TEXT("%s,%s,%lld,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d,%d,%.2f"),
+		*FDateTime::UtcNow().ToIso8601(), *DllVersion, RunSeed, CurrentFloor, NumTiles, NumMonsters,
+		LayoutGenMs, ParseMs, MonsterGenMs, IsmMs, Timings.LightsSeconds * 1000.0, Timings.NavigationSeconds * 1000.0,
+		BuildGameThreadSeconds * 1000.0, WallMs, Actors, Actors - ActorsBefore, DrawCalls, MemoryDeltaMB));
+
+	UE_LOG(LogTemp, Display, TEXT("  Floor %4d: gen %7.2f ms  parse %6.2f ms  ism %7.2f ms  nav %7.2f ms  %5d actors  ~%4d draws  %+7.2f MB"),
+		CurrentFloor, LayoutGenMs, ParseMs, IsmMs, Timings.NavigationSeconds * 1000.0, Actors, DrawCalls, MemoryDeltaMB);
+
+	if (++CurrentFloor > LastFloor)
+	{
+		OnBenchmarkComplete();
+		return;
+	}
+	BeginFloor();
+}
+
+void ATowerFloorBenchmark::OnBenchmarkComplete()
+{
+	CurrentFloor = INDEX_NONE;
+	bBuilding = false;
+	SetActorTickEnabled(false);
+
+	if (ATowerGameMode* GameMode = GetTowerGameMode())
+	{
+		GameMode->bPrefetchAdjacentFloors = bWasPrefetching;
+	}
+
+	const FString Path = FPaths::Combine(FPaths::ProfilingDir(), CsvFile);
+	FString Csv;
+	if (!FPaths::FileExists(Path))
+	{
+		Csv += TEXT("timestamp,dll_version,seed,floor,tiles,monsters,layout_gen_ms,parse_ms,monster_gen_ms,ism_build_ms,lights_ms,nav_build_ms,build_game_thread_ms,build_wall_ms,actors,actors_added,draw_calls_est,memory_delta_mb\n");
+	}
+	for (const FString& Row : Rows)
+	{
+		Csv += Row;
+		Csv += TEXT("\n");
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *Path, FFileHelper::EEncodingOptions::AutoDetect,
+		&IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Display, TEXT("📊 Floor Benchmark: %d floors appended to %s"), Rows.Num(), *Path);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Floor Benchmark: could not write %s"), *Path);
+	}
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+// ============================================================
+// Helper Functions
+// ============================================================
+
+UTowerGameSubsystem* ATowerFloorBenchmark::GetTowerSubsystem() const
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	return GameInstance ? GameInstance->GetSubsystem<UTowerGameSubsystem>() : nullptr;
+}
+
+ATowerGameMode* ATowerFloorBenchmark::GetTowerGameMode() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetAuthGameMode<ATowerGameMode>() : nullptr;
+}
@@ -0,0 +1,108 @@
+// Copyright Tower Game 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "FloorBenchmark.generated.h"
+
+class ATowerGameMode;
+class UTowerGameSubsystem;
+
+/**
+ * Floor generation throughput / memory benchmark
+ *
+ * Usage:
+ * 1. Place this actor on a level with ATowerGameMode, or run
+ *    tower.FloorBench <first> <last> [seed] [quit] from the console
+ * 2. Headless: -game -nullrhi -ExecCmds="tower.FloorBench 1 100 quit"
+ *
+ * Generates and builds floors FirstFloor..LastFloor one after another through
+ * the game mode's time-sliced build, and appends one CSV row per floor to
+ * Saved/Profiling/CsvFile: layout generation, JSON parse, monster generation,
+ * ISM / light / navigation build time (ATowerProceduralFloorRenderer phases),
+ * actor count, draw-call estimate and physical memory delta.
+ */
+UCLASS()
+class TOWERGAME_API ATowerFloorBenchmark : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ATowerFloorBenchmark();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	virtual void BeginPlay() override;
+
+public:
+	// ============================================================
+	// Benchmark Configuration
+	// ============================================================
+
+	/** If true, the benchmark starts on BeginPlay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	bool bAutoRun = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 FirstFloor = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 LastFloor = 50;
+
+	/** Tower seed to generate with; 0 = UTowerGameSubsystem::TowerSeed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	int64 Seed = 0;
+
+	/** Game-thread budget per frame for the floor build, as a loading screen would give it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "0.001"))
+	float BuildBudgetSeconds = 0.05f;
+
+	/** CSV under Saved/Profiling that rows are appended to (header written when new) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	FString CsvFile = TEXT("TowerFloorBench.csv");
+
+	/** Exit the process when done (headless runs) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	bool bQuitWhenDone = false;
+
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	void RunBenchmark();
+
+	UFUNCTION(BlueprintPure, Category = "Benchmark")
+	bool IsRunning() const { return CurrentFloor != INDEX_NONE; }
+
+	/** CSV rows of the last run, without the header */
+	UPROPERTY(BlueprintReadOnly, Category = "Benchmark|Results")
+	TArray<FString> Rows;
+
+private:
+	UTowerGameSubsystem* GetTowerSubsystem() const;
+	ATowerGameMode* GetTowerGameMode() const;
+
+	/** Generate CurrentFloor and start building it */
+	void BeginFloor();
+
+	/** Record the row of the floor just built and move on */
+	void FinishFloor();
+
+	void OnBenchmarkComplete();
+
+	int32 CurrentFloor = INDEX_NONE;
+	int64 RunSeed = 0;
+	FString DllVersion;
+	bool bWasPrefetching = false;
+
+	// Floor being built
+	bool bBuilding = false;
+	double BuildStartSeconds = 0.0;
+	double BuildGameThreadSeconds = 0.0;
+	uint64 MemoryBefore = 0;
+	int32 ActorsBefore = 0;
+	int32 NumTiles = 0;
+	int32 NumMonsters = 0;
+	double LayoutGenMs = 0.0;
+	double ParseMs = 0.0;
+	double MonsterGenMs = 0.0;
+};
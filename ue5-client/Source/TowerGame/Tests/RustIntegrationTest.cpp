@@ -4,6 +4,12 @@
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "TimerManager.h"
+#include "TowerGame/Bridge/ProceduralCoreBridge.h"
+#include "TowerGame/Bridge/FFIProfiler.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 
 ARustIntegrationTest::ARustIntegrationTest()
 {
@@ -14,7 +20,17 @@ void ARustIntegrationTest::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (bAutoRunTests)
+	if (bBenchmarkMode)
+	{
+		GetWorld()->GetTimerManager().SetTimer(
+			TestDelayTimer,
+			this,
+			&ARustIntegrationTest::RunBenchmarks,
+			0.5f,
+			false
+		);
+	}
+	else if (bAutoRunTests)
 	{
 		UE_LOG(LogTemp, Display, TEXT("========================================"));
 		UE_LOG(LogTemp, Display, TEXT("🧪 Rust Integration Test Suite v0.6.0"));
@@ -314,6 +330,210 @@ void ARustIntegrationTest::Test6_MonsterGeneration()
 	LogTestPass(TEXT("Monster Generation"));
 }
 
+// ============================================================
+// Benchmarks
+// ============================================================
+
+void ARustIntegrationTest::RunBenchmarks()
+{
+	BenchmarkCases.Empty();
+	BenchmarkRows.Empty();
+	CurrentBenchmarkIndex = 0;
+
+	UTowerGameSubsystem* TowerSys = GetTowerSubsystem();
+	FProceduralCoreBridge* Bridge = TowerSys ? TowerSys->GetBridge() : nullptr;
+	if (!Bridge || !Bridge->IsInitialized())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFI Benchmark: Rust Core not initialized"));
+		return;
+	}
+
+	BenchmarkDllVersion = Bridge->GetVersion();
+	UE_LOG(LogTemp, Display, TEXT("========================================"));
+	UE_LOG(LogTemp, Display, TEXT("⏱ FFI Benchmark (DLL %s, %d iterations, %d warm-up)"),
+		*BenchmarkDllVersion, BenchmarkIterations, BenchmarkWarmup);
+	UE_LOG(LogTemp, Display, TEXT("========================================"));
+
+	auto Add = [this](const TCHAR* Function, const TCHAR* Variant, TFunction<void(int32)>&& Call)
+	{
+		BenchmarkCases.Add({ Function, Variant, MoveTemp(Call) });
+	};
+
+	// Inputs are built once so only the call itself is measured
+	const FString AttackerTags = TEXT("[[\"fire\",0.8],[\"blade\",0.5]]");
+	const FString DefenderTags = TEXT("[[\"ice\",0.7]]");
+	const FString CombatJson = FString::Printf(
+		TEXT("{\"base_damage\":100.0,\"angle_id\":2,\"combo_step\":1,\"attacker_tags_json\":\"%s\",\"defender_tags_json\":\"%s\"}"),
+		*AttackerTags.ReplaceCharWithEscapedChar(), *DefenderTags.ReplaceCharWithEscapedChar());
+	const FString MasteryProfile = Bridge->MasteryCreateProfile();
+
+	// ---- Floor generation ----
+	Add(TEXT("GenerateFloorLayout"), TEXT("json"), [Bridge](int32 i) { Bridge->GenerateFloorLayout(42, 1 + i % 100); });
+	Add(TEXT("GetFloorHash"), TEXT("scalar"), [Bridge](int32 i) { Bridge->GetFloorHash(42, 1 + i % 100); });
+
+	// ---- Monsters ----
+	Add(TEXT("GenerateFloorMonsters"), TEXT("json"), [Bridge](int32 i) { Bridge->GenerateFloorMonsters(42, 1 + i % 100, 10); });
+
+	// ---- Combat ----
+	Add(TEXT("CalculateCombat"), TEXT("json"), [Bridge, CombatJson](int32) { Bridge->CalculateCombat(CombatJson); });
+
+	// ---- Loot ----
+	Add(TEXT("GenerateLoot"), TEXT("json"), [Bridge, AttackerTags](int32 i) { Bridge->GenerateLoot(AttackerTags, 5, static_cast<uint64>(i)); });
+
+	// ---- Mastery ----
+	Add(TEXT("MasteryGainXp"), TEXT("json"), [Bridge, MasteryProfile](int32) { Bridge->MasteryGainXp(MasteryProfile, 0, 10); });
+
+	// ---- Socket ----
+	Add(TEXT("SocketCreateEquipment"), TEXT("json"), [Bridge](int32) { Bridge->SocketCreateEquipment(TEXT("Bench Blade"), TEXT("[0,1,2]")); });
+	Add(TEXT("SocketGetStarterGems"), TEXT("json"), [Bridge](int32) { Bridge->SocketGetStarterGems(); });
+
+	// ---- Cosmetics ----
+	Add(TEXT("CosmeticGetAll"), TEXT("json"), [Bridge](int32) { Bridge->CosmeticGetAll(); });
+	Add(TEXT("CosmeticCreateProfile"), TEXT("json"), [Bridge](int32) { Bridge->CosmeticCreateProfile(); });
+
+	if (bCompareVariants)
+	{
+		// Same work through the binary / handle exports; each falls back to JSON on DLLs without them
+		Add(TEXT("GenerateFloorLayout"), TEXT("binary"), [Bridge](int32 i)
+		{
+			FFloorLayoutData Layout;
+			Bridge->GenerateFloorLayoutData(42, 1 + i % 100, Layout);
+		});
+		Add(TEXT("GenerateFloorMonsters"), TEXT("parsed"), [Bridge](int32 i)
+		{
+			TArray<FFloorMonsterData> Monsters;
+			Bridge->GenerateFloorMonsterData(42, 1 + i % 100, 10, Monsters);
+		});
+
+		const TArray<FString> TagSets = { AttackerTags, DefenderTags };
+		Add(TEXT("CalculateCombat"), TEXT("binary"), [Bridge, TagSets](int32)
+		{
+			FCombatBatchRequest Request;
+			Request.BaseDamage = 100.0f;
+			Request.AngleId = 2;
+			Request.ComboStep = 1;
+			Request.AttackerTagSet = 0;
+			Request.DefenderTagSet = 1;
+			TArray<FCombatBatchResult> Results;
+			Bridge->CalculateCombatBatch(MakeArrayView(&Request, 1), TagSets, Results);
+		});
+		Add(TEXT("GenerateLoot"), TEXT("binary"), [Bridge, TagSets](int32 i)
+		{
+			FLootBatchSource Source;
+			Source.TagSet = 0;
+			Source.FloorLevel = 5;
+			Source.DropHash = static_cast<uint64>(i);
+			TArray<FLootDropData> Drops;
+			Bridge->GenerateLootBatch(MakeArrayView(&Source, 1), TagSets, Drops);
+		});
+
+		BenchmarkMasteryHandle = Bridge->MasteryHandleCreate();
+		if (BenchmarkMasteryHandle != 0)
+		{
+			const uint64 Handle = BenchmarkMasteryHandle;
+			Add(TEXT("MasteryGainXp"), TEXT("handle"), [Bridge, Handle](int32) { Bridge->MasteryHandleGainXp(Handle, 0, 10); });
+		}
+		Add(TEXT("CosmeticCreateProfile"), TEXT("handle"), [Bridge](int32)
+		{
+			Bridge->CosmeticHandleRelease(Bridge->CosmeticHandleCreate());
+		});
+	}
+
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ARustIntegrationTest::RunNextBenchmark);
+}
+
+void ARustIntegrationTest::RunNextBenchmark()
+{
+	if (!BenchmarkCases.IsValidIndex(CurrentBenchmarkIndex))
+	{
+		OnAllBenchmarksComplete();
+		return;
+	}
+
+	const FBenchmarkCase& Case = BenchmarkCases[CurrentBenchmarkIndex++];
+
+	// Warm-up with the profiler's byte counters on, so timed calls pay nothing for it
+	const bool bWasProfiling = FTowerFFIProfiler::IsEnabled();
+	FTowerFFIProfiler::Reset();
+	FTowerFFIProfiler::SetEnabled(true);
+	for (int32 i = 0; i < BenchmarkWarmup; i++)
+	{
+		Case.Call(i);
+	}
+	FTowerFFIProfiler::SetEnabled(bWasProfiling);
+
+	uint64 Bytes = 0;
+	for (const FTowerFFIFunctionStats* Stats = FTowerFFIProfiler::GetHead(); Stats; Stats = Stats->Next)
+	{
+		Bytes += Stats->BytesIn.load(std::memory_order_relaxed) + Stats->BytesOut.load(std::memory_order_relaxed);
+	}
+	FTowerFFIProfiler::Reset();
+
+	TArray<uint64> Samples;
+	Samples.SetNumUninitialized(BenchmarkIterations);
+	uint64 TotalCycles = 0;
+	for (int32 i = 0; i < BenchmarkIterations; i++)
+	{
+		const uint64 Start = FPlatformTime::Cycles64();
+		Case.Call(BenchmarkWarmup + i);
+		Samples[i] = FPlatformTime::Cycles64() - Start;
+		TotalCycles += Samples[i];
+	}
+	Samples.Sort();
+
+	auto ToUs = [](uint64 Cycles) { return FPlatformTime::ToMilliseconds64(Cycles) * 1000.0; };
+	auto Percentile = [&Samples](double Q) { return Samples[FMath::Min(Samples.Num() - 1, FMath::FloorToInt(Q * Samples.Num()))]; };
+
+	const double MeanUs = ToUs(TotalCycles) / BenchmarkIterations;
+	const double P50Us = ToUs(Percentile(0.50));
+	const double P99Us = ToUs(Percentile(0.99));
+	const double MaxUs = ToUs(Samples.Last());
+	const double BytesPerCall = static_cast<double>(Bytes) / BenchmarkWarmup;
+
+	BenchmarkRows.Add(FString::Printf(TEXT("%s,%s,%s,%s,%d,%.3f,%.3f,%.3f,%.3f,%.1f"),
+		*FDateTime::UtcNow().ToIso8601(), *BenchmarkDllVersion, *Case.Function, *Case.Variant,
+		BenchmarkIterations, MeanUs, P50Us, P99Us, MaxUs, BytesPerCall));
+
+	UE_LOG(LogTemp, Display, TEXT("  %-24s %-7s mean %8.2f us  p50 %8.2f us  p99 %8.2f us  %8.0f B/call"),
+		*Case.Function, *Case.Variant, MeanUs, P50Us, P99Us, BytesPerCall);
+
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ARustIntegrationTest::RunNextBenchmark);
+}
+
+void ARustIntegrationTest::OnAllBenchmarksComplete()
+{
+	UTowerGameSubsystem* TowerSys = GetTowerSubsystem();
+	FProceduralCoreBridge* Bridge = TowerSys ? TowerSys->GetBridge() : nullptr;
+	if (Bridge && BenchmarkMasteryHandle != 0)
+	{
+		Bridge->MasteryHandleRelease(BenchmarkMasteryHandle);
+	}
+	BenchmarkMasteryHandle = 0;
+	BenchmarkCases.Empty();
+
+	const FString Path = FPaths::Combine(FPaths::ProfilingDir(), BenchmarkCsvFile);
+	FString Csv;
+	if (!FPaths::FileExists(Path))
+	{
+		Csv += TEXT("timestamp,dll_version,function,variant,iterations,mean_us,p50_us,p99_us,max_us,bytes_per_call\n");
+	}
+	for (const FString& Row : BenchmarkRows)
+	{
+		Csv += Row;
+		Csv += TEXT("\n");
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *Path, FFileHelper::EEncodingOptions::AutoDetect,
+		&IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Display, TEXT("📊 FFI Benchmark: %d cases appended to %s"), BenchmarkRows.Num(), *Path);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("FFI Benchmark: could not write %s"), *Path);
+	}
+}
+
 // ============================================================
 // Helper Functions
 // ============================================================
@@ -16,6 +16,13 @@
  * 3. Check Output Log for test results
  *
  * All tests run automatically on BeginPlay
+ *
+ * Benchmark mode (bBenchmarkMode) runs the FFI microbenchmarks instead: each
+ * FProceduralCoreBridge entry point (and its binary / handle variant, if it has
+ * one) is called BenchmarkWarmup times untimed, then BenchmarkIterations times
+ * timed one call at a time. Mean / p50 / p99 / max latency and the bytes
+ * marshalled per call (FTowerFFIProfiler) are appended as one CSV row per case,
+ * tagged with the DLL version, to Saved/Profiling/BenchmarkCsvFile.
  */
 UCLASS()
 class TOWERGAME_API ARustIntegrationTest : public AActor
@@ -70,6 +77,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Testing|Manual")
 	void Test6_MonsterGeneration();
 
+	// ============================================================
+	// Benchmark Mode
+	// ============================================================
+
+	/** If true, BeginPlay runs the FFI benchmarks instead of the tests */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Testing|Benchmark")
+	bool bBenchmarkMode = false;
+
+	/** Timed calls per case */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Testing|Benchmark", meta = (ClampMin = "1"))
+	int32 BenchmarkIterations = 1000;
+
+	/** Untimed calls before each case; bytes per call are counted over these */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Testing|Benchmark", meta = (ClampMin = "1"))
+	int32 BenchmarkWarmup = 50;
+
+	/** Also run the binary / handle variants next to the JSON entry points */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Testing|Benchmark")
+	bool bCompareVariants = true;
+
+	/** CSV under Saved/Profiling that rows are appended to (header written when new) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Testing|Benchmark")
+	FString BenchmarkCsvFile = TEXT("TowerFFIBench.csv");
+
+	/** Runs one case per tick so the editor stays responsive between them */
+	UFUNCTION(BlueprintCallable, Category = "Testing|Benchmark")
+	void RunBenchmarks();
+
 	// ============================================================
 	// Test Results
 	// ============================================================
@@ -86,6 +121,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Testing|Results")
 	TArray<FString> FailureMessages;
 
+	/** CSV rows of the last benchmark run, without the header */
+	UPROPERTY(BlueprintReadOnly, Category = "Testing|Results")
+	TArray<FString> BenchmarkRows;
+
 private:
 	// Internal helpers
 	UTowerGameSubsystem* GetTowerSubsystem();
@@ -101,4 +140,20 @@ private:
 
 	void RunNextTest();
 	void OnAllTestsComplete();
+
+	// Benchmarks
+	struct FBenchmarkCase
+	{
+		FString Function;
+		FString Variant;
+		TFunction<void(int32 Iteration)> Call;
+	};
+
+	void RunNextBenchmark();
+	void OnAllBenchmarksComplete();
+
+	TArray<FBenchmarkCase> BenchmarkCases;
+	int32 CurrentBenchmarkIndex = 0;
+	FString BenchmarkDllVersion;
+	uint64 BenchmarkMasteryHandle = 0;
 };
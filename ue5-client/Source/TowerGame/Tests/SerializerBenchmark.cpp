@@ -0,0 +1,788 @@
+// Copyright Tower Game 2026. All Rights Reserved.
+
+#include "SerializerBenchmark.h"
+#include "TowerGame/Network/ProtoWire.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTLS.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs CmdSerializerBench(
+		TEXT("tower.SerializerBench"),
+		TEXT("tower.SerializerBench [iterations] [quit] - time bincode / protobuf / JSON encode and decode and append to Saved/Profiling/TowerSerializerBench.csv"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (!World)
+			{
+				return;
+			}
+
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.bDeferConstruction = true;
+			ATowerSerializerBenchmark* Benchmark = World->SpawnActor<ATowerSerializerBenchmark>(FTransform::Identity, SpawnParams);
+			if (!Benchmark)
+			{
+				return;
+			}
+
+			for (const FString& Arg : Args)
+			{
+				if (Arg == TEXT("quit"))
+				{
+					Benchmark->bQuitWhenDone = true;
+				}
+				else
+				{
+					Benchmark->Iterations = FMath::Max(FCString::Atoi(*Arg), 10);
+				}
+			}
+			Benchmark->FinishSpawning(FTransform::Identity);
+		}));
+
+	/**
+	 * Forwards to the real allocator, counting allocations made on the thread
+	 * that installed it. Static, so a thread that read GMalloc just before
+	 * it was restored still lands on a live object.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		void Install()
+		{
+			Inner = GMalloc;
+			OwnerThread = FPlatformTLS::GetCurrentThreadId();
+			Count = 0;
+			GMalloc = this;
+		}
+
+		void Uninstall() { GMalloc = Inner; }
+
+		uint64 GetCount() const { return Count; }
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Note(); return Inner->Malloc(Size, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size != 0)
+			{
+				Note();
+			}
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("TowerCountingMalloc"); }
+
+	private:
+		void Note()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == OwnerThread)
+			{
+				++Count;
+			}
+		}
+
+		FMalloc* Inner = nullptr;
+		uint32 OwnerThread = 0;
+		uint64 Count = 0;
+	};
+
+	FCountingMalloc& GetAllocCounter()
+	{
+		static FCountingMalloc Counter;
+		return Counter;
+	}
+
+	// ============================================================
+	// Codecs
+	// ============================================================
+
+	// JSON goes on the wire as UTF-8 and is parsed from an FString, as UMatchConnection does
+	int32 ToUtf8(const FString& Json, TArray<uint8>& Out)
+	{
+		const FTCHARToUTF8 Utf8(*Json);
+		Out.Reset();
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+		return Out.Num();
+	}
+
+	FString FromUtf8(const TArray<uint8>& Utf8)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Utf8.GetData()), Utf8.Num());
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	FString SerializeJson(const TSharedRef<FJsonObject>& Json)
+	{
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Json, Writer);
+		return Output;
+	}
+
+	TSharedPtr<FJsonObject> ParseJson(const TArray<uint8>& Utf8)
+	{
+		TSharedPtr<FJsonObject> Root;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FromUtf8(Utf8));
+		FJsonSerializer::Deserialize(Reader, Root);
+		return Root;
+	}
+
+	// Bincode, as the server's PlayerData / MonsterData (TBincodeSchema in BincodeSerializer.h)
+	int32 EncodePlayerBincode(const FPlayerData& Player, TArray<uint8>& Out)
+	{
+		Out.Reset();
+		FBincodeWriter Writer(Out);
+		Writer.WriteU64(static_cast<uint64>(Player.Id));
+		Writer.WriteBevyVec3(Player.Position);
+		Writer.WriteF32(Player.Health);
+		Writer.WriteU32(static_cast<uint32>(Player.CurrentFloor));
+		return Out.Num();
+	}
+
+	int32 EncodeMonsterBincode(const FMonsterData& Monster, TArray<uint8>& Out)
+	{
+		Out.Reset();
+		FBincodeWriter Writer(Out);
+		Writer.WriteString(Monster.MonsterType);
+		Writer.WriteBevyVec3(Monster.Position);
+		Writer.WriteF32(Monster.Health);
+		Writer.WriteF32(Monster.MaxHealth);
+		return Out.Num();
+	}
+
+	// Quantized layouts (TBincodeQuantizedSchema), against the floor the sample positions fall in
+	const FNetQuantizeFrame QuantizeFrame(FVector(-50.0, -1.0, -50.0), FVector(50.0, 10.0, 50.0));
+
+	int32 EncodePlayerBincodeQuantized(const FPlayerData& Player, TArray<uint8>& Out)
+	{
+		Out.Reset();
+		FBincodeWriter Writer(Out);
+		Writer.WriteU64(static_cast<uint64>(Player.Id));
+		Writer.WriteQuantizedBevyVec3(Player.Position, QuantizeFrame);
+		Writer.WriteFraction8(Player.Health, 100.0f);
+		Writer.WriteU32(static_cast<uint32>(Player.CurrentFloor));
+		return Out.Num();
+	}
+
+	int32 EncodeMonsterBincodeQuantized(const FMonsterData& Monster, TArray<uint8>& Out)
+	{
+		Out.Reset();
+		FBincodeWriter Writer(Out);
+		Writer.WriteString(Monster.MonsterType);
+		Writer.WriteQuantizedBevyVec3(Monster.Position, QuantizeFrame);
+		Writer.WriteF32(Monster.MaxHealth);
+		Writer.WriteFraction8(Monster.Health, Monster.MaxHealth);
+		return Out.Num();
+	}
+
+	// Protobuf, the same fields under their tower.game.PlayerData / MonsterData numbers
+	void WriteProtoVec3(TArray<uint8>& Out, uint32 Field, const FVector& UE5Position, TArray<uint8>& Scratch)
+	{
+		const FProtoVec3 Vec = FProtoVec3::FromUE5Vector(UE5Position);
+		Scratch.Reset();
+		ProtoWire::WriteFloatField(Scratch, 1, Vec.X);
+		ProtoWire::WriteFloatField(Scratch, 2, Vec.Y);
+		ProtoWire::WriteFloatField(Scratch, 3, Vec.Z);
+		ProtoWire::WriteBytes(Out, Field, Scratch);
+	}
+
+	bool ReadProtoVec3(TArrayView<const uint8> Bytes, FVector& OutUE5Position)
+	{
+		ProtoWire::FReader Reader(Bytes);
+		FProtoVec3 Vec;
+		uint32 Field, WireType;
+		while (!Reader.AtEnd() && Reader.ReadTag(Field, WireType))
+		{
+			if (WireType != ProtoWire::Fixed32)
+			{
+				Reader.Skip(WireType);
+				continue;
+			}
+			const float Value = Reader.ReadFloat();
+			if (Field == 1) Vec.X = Value;
+			else if (Field == 2) Vec.Y = Value;
+			else if (Field == 3) Vec.Z = Value;
+		}
+		OutUE5Position = Vec.ToUE5Vector();
+		return !Reader.bError;
+	}
+
+	int32 EncodePlayerProto(const FPlayerData& Player, TArray<uint8>& Out)
+	{
+		TArray<uint8> Vec;
+		Out.Reset();
+		ProtoWire::WriteVarintField(Out, 1, static_cast<uint64>(Player.Id));
+		WriteProtoVec3(Out, 2, Player.Position, Vec);
+		ProtoWire::WriteFloatField(Out, 5, Player.Health);
+		ProtoWire::WriteVarintField(Out, 7, static_cast<uint64>(Player.CurrentFloor));
+		return Out.Num();
+	}
+
+	bool DecodePlayerProto(TArrayView<const uint8> Bytes, FPlayerData& Out)
+	{
+		ProtoWire::FReader Reader(Bytes);
+		Out = FPlayerData();
+		uint32 Field, WireType;
+		while (!Reader.AtEnd() && Reader.ReadTag(Field, WireType))
+		{
+			if (Field == 1 && WireType == ProtoWire::Varint) Out.Id = static_cast<int64>(Reader.ReadVarint());
+			else if (Field == 2 && WireType == ProtoWire::LengthDelimited) { if (!ReadProtoVec3(Reader.ReadLengthDelimited(), Out.Position)) return false; }
+			else if (Field == 5 && WireType == ProtoWire::Fixed32) Out.Health = Reader.ReadFloat();
+			else if (Field == 7 && WireType == ProtoWire::Varint) Out.CurrentFloor = static_cast<int32>(Reader.ReadVarint());
+			else Reader.Skip(WireType);
+		}
+		return !Reader.bError;
+	}
+
+	int32 EncodeMonsterProto(const FMonsterData& Monster, TArray<uint8>& Out)
+	{
+		TArray<uint8> Vec;
+		Out.Reset();
+		const FTCHARToUTF8 Type(*Monster.MonsterType);
+		ProtoWire::WriteBytes(Out, 2, TArrayView<const uint8>(reinterpret_cast<const uint8*>(Type.Get()), Type.Length()));
+		WriteProtoVec3(Out, 3, Monster.Position, Vec);
+		ProtoWire::WriteFloatField(Out, 6, Monster.Health);
+		ProtoWire::WriteFloatField(Out, 7, Monster.MaxHealth);
+		return Out.Num();
+	}
+
+	bool DecodeMonsterProto(TArrayView<const uint8> Bytes, FMonsterData& Out)
+	{
+		ProtoWire::FReader Reader(Bytes);
+		Out = FMonsterData();
+		uint32 Field, WireType;
+		while (!Reader.AtEnd() && Reader.ReadTag(Field, WireType))
+		{
+			if (Field == 2 && WireType == ProtoWire::LengthDelimited)
+			{
+				const TArrayView<const uint8> Type = Reader.ReadLengthDelimited();
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Type.GetData()), Type.Num());
+				Out.MonsterType = FString(Converted.Length(), Converted.Get());
+			}
+			else if (Field == 3 && WireType == ProtoWire::LengthDelimited) { if (!ReadProtoVec3(Reader.ReadLengthDelimited(), Out.Position)) return false; }
+			else if (Field == 6 && WireType == ProtoWire::Fixed32) Out.Health = Reader.ReadFloat();
+			else if (Field == 7 && WireType == ProtoWire::Fixed32) Out.MaxHealth = Reader.ReadFloat();
+			else Reader.Skip(WireType);
+		}
+		return !Reader.bError;
+	}
+
+	// JSON, with the field names state sync uses for snapshot entities
+	int32 EncodePlayerJson(const FPlayerData& Player, TArray<uint8>& Out)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetNumberField(TEXT("entity_id"), Player.Id);
+		Json->SetNumberField(TEXT("x"), Player.Position.X);
+		Json->SetNumberField(TEXT("y"), Player.Position.Y);
+		Json->SetNumberField(TEXT("z"), Player.Position.Z);
+		Json->SetNumberField(TEXT("health"), Player.Health);
+		Json->SetNumberField(TEXT("current_floor"), Player.CurrentFloor);
+		return ToUtf8(SerializeJson(Json), Out);
+	}
+
+	bool DecodePlayerJson(const TArray<uint8>& Utf8, FPlayerData& Out)
+	{
+		const TSharedPtr<FJsonObject> Json = ParseJson(Utf8);
+		if (!Json.IsValid()) return false;
+
+		Out.Id = static_cast<int64>(Json->GetNumberField(TEXT("entity_id")));
+		Out.Position.X = Json->GetNumberField(TEXT("x"));
+		Out.Position.Y = Json->GetNumberField(TEXT("y"));
+		Out.Position.Z = Json->GetNumberField(TEXT("z"));
+		Out.Health = static_cast<float>(Json->GetNumberField(TEXT("health")));
+		Out.CurrentFloor = static_cast<int32>(Json->GetNumberField(TEXT("current_floor")));
+		return true;
+	}
+
+	int32 EncodeMonsterJson(const FMonsterData& Monster, TArray<uint8>& Out)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("monster_type"), Monster.MonsterType);
+		Json->SetNumberField(TEXT("x"), Monster.Position.X);
+		Json->SetNumberField(TEXT("y"), Monster.Position.Y);
+		Json->SetNumberField(TEXT("z"), Monster.Position.Z);
+		Json->SetNumberField(TEXT("health"), Monster.Health);
+		Json->SetNumberField(TEXT("max_health"), Monster.MaxHealth);
+		return ToUtf8(SerializeJson(Json), Out);
+	}
+
+	bool DecodeMonsterJson(const TArray<uint8>& Utf8, FMonsterData& Out)
+	{
+		const TSharedPtr<FJsonObject> Json = ParseJson(Utf8);
+		if (!Json.IsValid()) return false;
+
+		Out.MonsterType = Json->GetStringField(TEXT("monster_type"));
+		Out.Position.X = Json->GetNumberField(TEXT("x"));
+		Out.Position.Y = Json->GetNumberField(TEXT("y"));
+		Out.Position.Z = Json->GetNumberField(TEXT("z"));
+		Out.Health = static_cast<float>(Json->GetNumberField(TEXT("health")));
+		Out.MaxHealth = static_cast<float>(Json->GetNumberField(TEXT("max_health")));
+		return true;
+	}
+
+	// WorldSnapshot as the server sends it: version 1 layout read by ParseWorldStateFromBinary
+	int32 EncodeSnapshotBincode(const FWorldStateBuffer& State, TArray<uint8>& Out)
+	{
+		Out.Reset();
+		FBincodeWriter Writer(Out);
+		Writer.WriteU8(1);
+		Writer.WriteI64(State.ServerTick);
+		Writer.WriteF64(State.ServerTimestamp);
+		Writer.WriteU8(static_cast<uint8>(State.WorldCyclePhase));
+
+		Writer.WriteU64(State.PlayerSnapshots.Num());
+		for (const FPlayerStateSnapshot& Snap : State.PlayerSnapshots)
+		{
+			Writer.WriteU64(static_cast<uint64>(Snap.EntityId));
+			Writer.WriteVec3(Snap.Position);
+			Writer.WriteF32(Snap.Rotation.Yaw);
+			Writer.WriteF32(Snap.Rotation.Pitch);
+			Writer.WriteF32(Snap.Health);
+			Writer.WriteF64(Snap.Timestamp);
+			Writer.WriteF32(Snap.Resources.X);
+			Writer.WriteF32(Snap.Resources.Y);
+			Writer.WriteF32(Snap.Resources.Z);
+			Writer.WriteF32(Snap.Resources.W);
+		}
+
+		Writer.WriteU64(State.MonsterSnapshots.Num());
+		for (const FMonsterStateSnapshot& Snap : State.MonsterSnapshots)
+		{
+			Writer.WriteU64(static_cast<uint64>(Snap.EntityId));
+			Writer.WriteVec3(Snap.Position);
+			Writer.WriteF32(Snap.Health);
+			Writer.WriteU8(static_cast<uint8>(Snap.CombatPhase));
+			Writer.WriteU16(static_cast<uint16>(Snap.StatusMask));
+		}
+		return Out.Num();
+	}
+
+	// ... and the JSON one ParseWorldStateFromJson reads
+	int32 EncodeSnapshotJson(const FWorldStateBuffer& State, TArray<uint8>& Out)
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("server_tick"), State.ServerTick);
+		Root->SetNumberField(TEXT("server_time"), State.ServerTimestamp);
+		Root->SetStringField(TEXT("world_phase"), StaticEnum<EWorldCyclePhase>()->GetNameStringByValue(static_cast<int64>(State.WorldCyclePhase)));
+
+		TArray<TSharedPtr<FJsonValue>> Players;
+		for (const FPlayerStateSnapshot& Snap : State.PlayerSnapshots)
+		{
+			TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+			Json->SetNumberField(TEXT("entity_id"), Snap.EntityId);
+			Json->SetNumberField(TEXT("x"), Snap.Position.X);
+			Json->SetNumberField(TEXT("y"), Snap.Position.Y);
+			Json->SetNumberField(TEXT("z"), Snap.Position.Z);
+			Json->SetNumberField(TEXT("yaw"), Snap.Rotation.Yaw);
+			Json->SetNumberField(TEXT("pitch"), Snap.Rotation.Pitch);
+			Json->SetNumberField(TEXT("health"), Snap.Health);
+			Json->SetNumberField(TEXT("timestamp"), Snap.Timestamp);
+			Json->SetNumberField(TEXT("kinetic"), Snap.Resources.X);
+			Json->SetNumberField(TEXT("thermal"), Snap.Resources.Y);
+			Json->SetNumberField(TEXT("semantic"), Snap.Resources.Z);
+			Json->SetNumberField(TEXT("rage"), Snap.Resources.W);
+			Players.Add(MakeShared<FJsonValueObject>(Json));
+		}
+		Root->SetArrayField(TEXT("players"), Players);
+
+		const UEnum* PhaseEnum = StaticEnum<EMonsterCombatPhase>();
+		const UEnum* EffectEnum = StaticEnum<EMonsterStatusEffect>();
+		TArray<TSharedPtr<FJsonValue>> Monsters;
+		for (const FMonsterStateSnapshot& Snap : State.MonsterSnapshots)
+		{
+			TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+			Json->SetNumberField(TEXT("entity_id"), Snap.EntityId);
+			Json->SetNumberField(TEXT("x"), Snap.Position.X);
+			Json->SetNumberField(TEXT("y"), Snap.Position.Y);
+			Json->SetNumberField(TEXT("z"), Snap.Position.Z);
+			Json->SetNumberField(TEXT("health"), Snap.Health);
+			Json->SetStringField(TEXT("combat_phase"), PhaseEnum->GetNameStringByValue(static_cast<int64>(Snap.CombatPhase)));
+
+			TArray<TSharedPtr<FJsonValue>> Effects;
+			for (uint32 Bits = static_cast<uint32>(Snap.StatusMask); Bits != 0; Bits &= Bits - 1)
+			{
+				const int64 Effect = FMath::CountTrailingZeros(Bits) + 1;
+				Effects.Add(MakeShared<FJsonValueString>(EffectEnum->GetNameStringByValue(Effect)));
+			}
+			Json->SetArrayField(TEXT("status_effects"), Effects);
+			Monsters.Add(MakeShared<FJsonValueObject>(Json));
+		}
+		Root->SetArrayField(TEXT("monsters"), Monsters);
+
+		return ToUtf8(SerializeJson(Root), Out);
+	}
+}
+
+ATowerSerializerBenchmark::ATowerSerializerBenchmark()
+{
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+void ATowerSerializerBenchmark::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bAutoRun)
+	{
+		RunBenchmark();
+	}
+}
+
+// ============================================================
+// Benchmark Execution
+// ============================================================
+
+void ATowerSerializerBenchmark::RunBenchmark()
+{
+	if (IsRunning())
+	{
+		return;
+	}
+
+	if (!Synchronizer)
+	{
+		Synchronizer = NewObject<UTowerStateSynchronizer>(this);
+	}
+
+	Rows.Empty();
+	BuildPayloads();
+	BuildCases();
+	CurrentCase = 0;
+
+	UE_LOG(LogTemp, Display, TEXT("📊 Serializer Benchmark: %d cases x %d iterations"), Cases.Num(), Iterations);
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ATowerSerializerBenchmark::RunNextCase);
+}
+
+void ATowerSerializerBenchmark::BuildPayloads()
+{
+	FRandomStream Random(1234);
+	auto RandomPosition = [&Random]() { return FVector(Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(0.0f, 500.0f)); };
+
+	Player = FPlayerData();
+	Player.Id = 1000000000123;
+	Player.Position = RandomPosition();
+	Player.Health = 87.5f;
+	Player.CurrentFloor = 12;
+
+	Monster = FMonsterData();
+	Monster.MonsterType = TEXT("frost_wraith");
+	Monster.Position = RandomPosition();
+	Monster.Health = 340.0f;
+	Monster.MaxHealth = 500.0f;
+
+	Chunk = FProtoChunkData();
+	Chunk.Seed = 0x5EED5EED;
+	Chunk.FloorId = 12;
+	Chunk.BiomeId = 3;
+	Chunk.Width = ChunkSize;
+	Chunk.Height = ChunkSize;
+	Chunk.WorldOffset = FProtoVec3(0.0f, 36.0f, 0.0f);
+	Chunk.Tiles.Reserve(ChunkSize * ChunkSize);
+	for (int32 Y = 0; Y < ChunkSize; Y++)
+	{
+		for (int32 X = 0; X < ChunkSize; X++)
+		{
+			FProtoFloorTileData& Tile = Chunk.Tiles.AddDefaulted_GetRef();
+			Tile.TileType = Random.RandRange(0, 5);
+			Tile.GridX = X;
+			Tile.GridY = Y;
+			Tile.BiomeId = Chunk.BiomeId;
+			Tile.bIsWalkable = Tile.TileType != 2;
+			Tile.bHasCollision = Tile.TileType == 2;
+		}
+	}
+	Chunk.ValidationHash = UProtobufBridge::ComputeChunkHash(Chunk);
+
+	// The same floor as packed_tiles
+	PackedChunk = Chunk;
+	PackedChunk.Tiles.Reset();
+	{
+		TArray<uint8> Types;
+		TArray<uint16> Biomes;
+		for (const FProtoFloorTileData& Tile : Chunk.Tiles)
+		{
+			Types.Add(static_cast<uint8>(Tile.TileType));
+			Biomes.Add(static_cast<uint16>(Tile.BiomeId));
+		}
+		PackedChunk.PackedTiles.Pack(Types, ChunkSize, ChunkSize);
+		PackedChunk.PackedTiles.SetBiomes(Biomes);
+	}
+
+	Snapshot = FWorldStateBuffer();
+	Snapshot.ServerTick = 123456;
+	Snapshot.ServerTimestamp = 2057.25;
+	Snapshot.WorldCyclePhase = EWorldCyclePhase::Hold;
+	for (int32 i = 0; i < SnapshotPlayers; i++)
+	{
+		FPlayerStateSnapshot& Snap = Snapshot.PlayerSnapshots.AddDefaulted_GetRef();
+		Snap.EntityId = 1000 + i;
+		Snap.Position = RandomPosition();
+		Snap.Rotation = FRotator(Random.FRandRange(-30.0f, 30.0f), Random.FRandRange(0.0f, 360.0f), 0.0f);
+		Snap.Health = Random.FRandRange(1.0f, 100.0f);
+		Snap.Timestamp = Snapshot.ServerTimestamp;
+		Snap.Resources = FVector4(Random.FRand() * 100.0f, Random.FRand() * 100.0f, Random.FRand() * 100.0f, Random.FRand() * 100.0f);
+	}
+	for (int32 i = 0; i < SnapshotMonsters; i++)
+	{
+		FMonsterStateSnapshot& Snap = Snapshot.MonsterSnapshots.AddDefaulted_GetRef();
+		Snap.EntityId = 500000 + i;
+		Snap.Position = RandomPosition();
+		Snap.Health = Random.FRandRange(1.0f, 500.0f);
+		Snap.CombatPhase = static_cast<EMonsterCombatPhase>(Random.RandRange(0, 3));
+		if (i % 4 == 0)
+		{
+			Snap.StatusMask |= FMonsterStateSnapshot::StatusBit(EMonsterStatusEffect::Burning);
+		}
+		if (i % 7 == 0)
+		{
+			Snap.StatusMask |= FMonsterStateSnapshot::StatusBit(EMonsterStatusEffect::Slowed);
+		}
+	}
+
+	EncodePlayerBincode(Player, PlayerBincode);
+	EncodePlayerProto(Player, PlayerProto);
+	EncodePlayerJson(Player, PlayerJson);
+	EncodePlayerBincodeQuantized(Player, PlayerBincodeQuantized);
+	EncodeMonsterBincode(Monster, MonsterBincode);
+	EncodeMonsterBincodeQuantized(Monster, MonsterBincodeQuantized);
+	EncodeMonsterProto(Monster, MonsterProto);
+	EncodeMonsterJson(Monster, MonsterJson);
+	UProtobufBridge::EncodeChunkData(Chunk, ChunkProto);
+	UProtobufBridge::EncodeChunkData(PackedChunk, ChunkPackedProto);
+	ToUtf8(Chunk.ToJson(), ChunkJson);
+	EncodeSnapshotBincode(Snapshot, SnapshotBincode);
+	EncodeSnapshotJson(Snapshot, SnapshotJson);
+}
+
+void ATowerSerializerBenchmark::BuildCases()
+{
+	Cases.Empty();
+	auto Add = [this](const TCHAR* Payload, const TCHAR* Format, const TCHAR* Op, int32 Entities, TFunction<int32()> Call)
+	{
+		FBenchmarkCase& Case = Cases.AddDefaulted_GetRef();
+		Case.Payload = Payload;
+		Case.Format = Format;
+		Case.Op = Op;
+		Case.Entities = FMath::Max(Entities, 1);
+		Case.Call = MoveTemp(Call);
+	};
+
+	// PlayerData
+	Add(TEXT("PlayerData"), TEXT("bincode"), TEXT("encode"), 1, [this]() { return EncodePlayerBincode(Player, ScratchBytes); });
+	Add(TEXT("PlayerData"), TEXT("bincode"), TEXT("decode"), 1, [this]()
+	{
+		FBincodeReader Reader(PlayerBincode);
+		FPlayerData Out = FPlayerData::FromBincode(Reader);
+		return PlayerBincode.Num();
+	});
+	Add(TEXT("PlayerData"), TEXT("bincode-quantized"), TEXT("encode"), 1, [this]() { return EncodePlayerBincodeQuantized(Player, ScratchBytes); });
+	Add(TEXT("PlayerData"), TEXT("bincode-quantized"), TEXT("decode"), 1, [this]()
+	{
+		FBincodeReader Reader(PlayerBincodeQuantized);
+		Reader.SetQuantizeFrame(&QuantizeFrame);
+		FPlayerData Out = FPlayerData::FromQuantizedBincode(Reader);
+		return PlayerBincodeQuantized.Num();
+	});
+	Add(TEXT("PlayerData"), TEXT("protobuf"), TEXT("encode"), 1, [this]() { return EncodePlayerProto(Player, ScratchBytes); });
+	Add(TEXT("PlayerData"), TEXT("protobuf"), TEXT("decode"), 1, [this]()
+	{
+		FPlayerData Out;
+		DecodePlayerProto(PlayerProto, Out);
+		return PlayerProto.Num();
+	});
+	Add(TEXT("PlayerData"), TEXT("json"), TEXT("encode"), 1, [this]() { return EncodePlayerJson(Player, ScratchBytes); });
+	Add(TEXT("PlayerData"), TEXT("json"), TEXT("decode"), 1, [this]()
+	{
+		FPlayerData Out;
+		DecodePlayerJson(PlayerJson, Out);
+		return PlayerJson.Num();
+	});
+
+	// MonsterData; bincode-view is the allocation-free decode AReplicationManager uses
+	Add(TEXT("MonsterData"), TEXT("bincode"), TEXT("encode"), 1, [this]() { return EncodeMonsterBincode(Monster, ScratchBytes); });
+	Add(TEXT("MonsterData"), TEXT("bincode"), TEXT("decode"), 1, [this]()
+	{
+		FBincodeReader Reader(MonsterBincode);
+		FMonsterData Out = FMonsterData::FromBincode(Reader);
+		return MonsterBincode.Num();
+	});
+	Add(TEXT("MonsterData"), TEXT("bincode-view"), TEXT("decode"), 1, [this]()
+	{
+		FBincodeReader Reader(MonsterBincode);
+		FMonsterDataView Out;
+		TBincodeSchema<FMonsterDataView>::Decode(Reader, Out);
+		return MonsterBincode.Num();
+	});
+	Add(TEXT("MonsterData"), TEXT("bincode-quantized"), TEXT("encode"), 1, [this]() { return EncodeMonsterBincodeQuantized(Monster, ScratchBytes); });
+	Add(TEXT("MonsterData"), TEXT("bincode-quantized"), TEXT("decode"), 1, [this]()
+	{
+		FBincodeReader Reader(MonsterBincodeQuantized);
+		Reader.SetQuantizeFrame(&QuantizeFrame);
+		FMonsterDataView Out;
+		TBincodeQuantizedSchema<FMonsterDataView>::Decode(Reader, Out);
+		return MonsterBincodeQuantized.Num();
+	});
+	Add(TEXT("MonsterData"), TEXT("protobuf"), TEXT("encode"), 1, [this]() { return EncodeMonsterProto(Monster, ScratchBytes); });
+	Add(TEXT("MonsterData"), TEXT("protobuf"), TEXT("decode"), 1, [this]()
+	{
+		FMonsterData Out;
+		DecodeMonsterProto(MonsterProto, Out);
+		return MonsterProto.Num();
+	});
+	Add(TEXT("MonsterData"), TEXT("json"), TEXT("encode"), 1, [this]() { return EncodeMonsterJson(Monster, ScratchBytes); });
+	Add(TEXT("MonsterData"), TEXT("json"), TEXT("decode"), 1, [this]()
+	{
+		FMonsterData Out;
+		DecodeMonsterJson(MonsterJson, Out);
+		return MonsterJson.Num();
+	});
+
+	// ChunkData; json is FProtoChunkData::ToJson / FromJson, what SerializeChunkData still sends
+	const int32 NumTiles = Chunk.Tiles.Num();
+	Add(TEXT("ChunkData"), TEXT("protobuf"), TEXT("encode"), NumTiles, [this]()
+	{
+		UProtobufBridge::EncodeChunkData(Chunk, ScratchBytes);
+		return ScratchBytes.Num();
+	});
+	Add(TEXT("ChunkData"), TEXT("protobuf"), TEXT("decode"), NumTiles, [this]()
+	{
+		FProtoChunkData Out;
+		UProtobufBridge::DecodeChunkData(ChunkProto, Out);
+		return ChunkProto.Num();
+	});
+	Add(TEXT("ChunkData"), TEXT("protobuf-packed"), TEXT("encode"), NumTiles, [this]()
+	{
+		UProtobufBridge::EncodeChunkData(PackedChunk, ScratchBytes);
+		return ScratchBytes.Num();
+	});
+	Add(TEXT("ChunkData"), TEXT("protobuf-packed"), TEXT("decode"), NumTiles, [this]()
+	{
+		FProtoChunkData Out;
+		UProtobufBridge::DecodeChunkData(ChunkPackedProto, Out);
+		Out.ExpandPackedTiles();
+		return ChunkPackedProto.Num();
+	});
+	Add(TEXT("ChunkData"), TEXT("json"), TEXT("encode"), NumTiles, [this]() { return ToUtf8(Chunk.ToJson(), ScratchBytes); });
+	Add(TEXT("ChunkData"), TEXT("json"), TEXT("decode"), NumTiles, [this]()
+	{
+		FProtoChunkData Out = FProtoChunkData::FromJson(FromUtf8(ChunkJson));
+		return ChunkJson.Num();
+	});
+
+	// WorldSnapshot through the state synchronizer's own parsers
+	const int32 NumEntities = Snapshot.PlayerSnapshots.Num() + Snapshot.MonsterSnapshots.Num();
+	Add(TEXT("WorldSnapshot"), TEXT("bincode"), TEXT("encode"), NumEntities, [this]() { return EncodeSnapshotBincode(Snapshot, ScratchBytes); });
+	Add(TEXT("WorldSnapshot"), TEXT("bincode"), TEXT("decode"), NumEntities, [this]()
+	{
+		Synchronizer->ParseWorldStateFromBinary(SnapshotBincode, ScratchSnapshot);
+		return SnapshotBincode.Num();
+	});
+	Add(TEXT("WorldSnapshot"), TEXT("json"), TEXT("encode"), NumEntities, [this]() { return EncodeSnapshotJson(Snapshot, ScratchBytes); });
+	Add(TEXT("WorldSnapshot"), TEXT("json"), TEXT("decode"), NumEntities, [this]()
+	{
+		Synchronizer->ParseWorldStateFromJson(FromUtf8(SnapshotJson), ScratchSnapshot);
+		return SnapshotJson.Num();
+	});
+}
+
+void ATowerSerializerBenchmark::RunNextCase()
+{
+	if (!Cases.IsValidIndex(CurrentCase))
+	{
+		OnBenchmarkComplete();
+		return;
+	}
+
+	const FBenchmarkCase& Case = Cases[CurrentCase++];
+
+	// Warm-up with the allocation counter in, so timed calls go straight to the allocator
+	FCountingMalloc& AllocCounter = GetAllocCounter();
+	int32 WireBytes = 0;
+	AllocCounter.Install();
+	for (int32 i = 0; i < Warmup; i++)
+	{
+		WireBytes = Case.Call();
+	}
+	AllocCounter.Uninstall();
+	const double AllocsPerCall = static_cast<double>(AllocCounter.GetCount()) / Warmup;
+
+	TArray<uint64> Samples;
+	Samples.SetNumUninitialized(Iterations);
+	uint64 TotalCycles = 0;
+	for (int32 i = 0; i < Iterations; i++)
+	{
+		const uint64 Start = FPlatformTime::Cycles64();
+		Case.Call();
+		Samples[i] = FPlatformTime::Cycles64() - Start;
+		TotalCycles += Samples[i];
+	}
+	Samples.Sort();
+
+	auto ToUs = [](uint64 Cycles) { return FPlatformTime::ToMilliseconds64(Cycles) * 1000.0; };
+	auto Percentile = [&Samples](double Q) { return Samples[FMath::Min(Samples.Num() - 1, FMath::FloorToInt(Q * Samples.Num()))]; };
+
+	const double MeanUs = ToUs(TotalCycles) / Iterations;
+	const double NsPerEntity = MeanUs * 1000.0 / Case.Entities;
+	const double P50Us = ToUs(Percentile(0.50));
+	const double P99Us = ToUs(Percentile(0.99));
+
+	Rows.Add(FString::Printf(TEXT("%s,%s,%s,%s,%d,%d,%.1f,%.3f,%.3f,%d,%.1f"),
+		*FDateTime::UtcNow().ToIso8601(), *Case.Payload, *Case.Format, *Case.Op, Case.Entities,
+		Iterations, NsPerEntity, P50Us, P99Us, WireBytes, AllocsPerCall));
+
+	UE_LOG(LogTemp, Display, TEXT("  %-13s %-12s %-6s %9.1f ns/entity  p50 %8.2f us  p99 %8.2f us  %7d B  %6.1f allocs"),
+		*Case.Payload, *Case.Format, *Case.Op, NsPerEntity, P50Us, P99Us, WireBytes, AllocsPerCall);
+
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &ATowerSerializerBenchmark::RunNextCase);
+}
+
+void ATowerSerializerBenchmark::OnBenchmarkComplete()
+{
+	Cases.Empty();
+
+	const FString Path = FPaths::Combine(FPaths::ProfilingDir(), CsvFile);
+	FString Csv;
+	if (!FPaths::FileExists(Path))
+	{
+		Csv += TEXT("timestamp,payload,format,op,entities,iterations,ns_per_entity,p50_us,p99_us,bytes,allocs_per_call\n");
+	}
+	for (const FString& Row : Rows)
+	{
+		Csv += Row;
+		Csv += TEXT("\n");
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *Path, FFileHelper::EEncodingOptions::AutoDetect,
+		&IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Display, TEXT("📊 Serializer Benchmark: %d cases appended to %s"), Rows.Num(), *Path);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Serializer Benchmark: could not write %s"), *Path);
+	}
+
+	if (bQuitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
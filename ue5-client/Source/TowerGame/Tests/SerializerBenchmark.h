@@ -0,0 +1,140 @@
+// Copyright Tower Game 2026. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TowerGame/Network/BincodeSerializer.h"
+#include "TowerGame/Network/ProtobufBridge.h"
+#include "TowerGame/Network/StateSynchronizer.h"
+#include "SerializerBenchmark.generated.h"
+
+/**
+ * Serializer comparison benchmark: bincode vs protobuf vs JSON
+ *
+ * Usage:
+ * 1. Place this actor on a level, or run tower.SerializerBench [iterations] [quit]
+ * 2. Headless: -game -nullrhi -ExecCmds="tower.SerializerBench 2000 quit"
+ *
+ * Encodes and decodes synthetic PlayerData, MonsterData, ChunkData and
+ * WorldSnapshot payloads through the client's own code for each format:
+ * FBincodeWriter / FBincodeReader schemas, the ProtoWire codecs behind
+ * UProtobufBridge, and the FJsonObject paths of state sync and FProtoChunkData.
+ * Where a format doesn't carry a type (PlayerData as protobuf, say) the same
+ * fields are written per the shared/proto schema so the sizes stay comparable.
+ *
+ * One CSV row per (payload, format, op) in Saved/Profiling/CsvFile: ns per
+ * entity, p50 / p99 per call, bytes on the wire and heap allocations per call
+ * (counted on the game thread during the warm-up).
+ */
+UCLASS()
+class TOWERGAME_API ATowerSerializerBenchmark : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ATowerSerializerBenchmark();
+
+protected:
+	virtual void BeginPlay() override;
+
+public:
+	// ============================================================
+	// Benchmark Configuration
+	// ============================================================
+
+	/** If true, the benchmark starts on BeginPlay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	bool bAutoRun = true;
+
+	/** Timed calls per case */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "10"))
+	int32 Iterations = 2000;
+
+	/** Untimed calls per case first; bytes and allocations are measured over these */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 Warmup = 50;
+
+	/** Players and monsters in the WorldSnapshot payload */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 SnapshotPlayers = 8;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "0"))
+	int32 SnapshotMonsters = 64;
+
+	/** ChunkData is ChunkSize x ChunkSize tiles */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark", meta = (ClampMin = "1"))
+	int32 ChunkSize = 32;
+
+	/** CSV under Saved/Profiling that rows are appended to (header written when new) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	FString CsvFile = TEXT("TowerSerializerBench.csv");
+
+	/** Exit the process when done (headless runs) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	bool bQuitWhenDone = false;
+
+	UFUNCTION(BlueprintCallable, Category = "Benchmark")
+	void RunBenchmark();
+
+	UFUNCTION(BlueprintPure, Category = "Benchmark")
+	bool IsRunning() const { return Cases.Num() > 0; }
+
+	/** CSV rows of the last run, without the header */
+	UPROPERTY(BlueprintReadOnly, Category = "Benchmark|Results")
+	TArray<FString> Rows;
+
+private:
+	struct FBenchmarkCase
+	{
+		FString Payload;
+		FString Format;
+		FString Op;
+		int32 Entities = 1;
+
+		/** One encode or decode of the payload; returns its size on the wire */
+		TFunction<int32()> Call;
+	};
+
+	/** Build the sample payloads and their encoded forms */
+	void BuildPayloads();
+	void BuildCases();
+
+	/** Time one case per tick so a long run doesn't hold a single frame */
+	void RunNextCase();
+
+	void OnBenchmarkComplete();
+
+	TArray<FBenchmarkCase> Cases;
+	int32 CurrentCase = 0;
+
+	/** Parses the snapshots; never started */
+	UPROPERTY()
+	TObjectPtr<UTowerStateSynchronizer> Synchronizer;
+
+	// Sample payloads
+	FPlayerData Player;
+	FMonsterData Monster;
+	FProtoChunkData Chunk;
+	FProtoChunkData PackedChunk;
+	FWorldStateBuffer Snapshot;
+
+	// Their encoded forms as they arrive, the decode cases' input (JSON as UTF-8)
+	TArray<uint8> PlayerBincode;
+	TArray<uint8> PlayerBincodeQuantized;
+	TArray<uint8> PlayerProto;
+	TArray<uint8> PlayerJson;
+	TArray<uint8> MonsterBincode;
+	TArray<uint8> MonsterBincodeQuantized;
+	TArray<uint8> MonsterProto;
+	TArray<uint8> MonsterJson;
+	TArray<uint8> ChunkProto;
+	TArray<uint8> ChunkPackedProto;
+	TArray<uint8> ChunkJson;
+	TArray<uint8> SnapshotBincode;
+	TArray<uint8> SnapshotJson;
+
+	// Reused across calls, as the network paths reuse their receive and send buffers
+	TArray<uint8> ScratchBytes;
+	FWorldStateBuffer ScratchSnapshot;
+};
@@ -25,13 +25,17 @@ public class TowerGame : ModuleRules
             "SlateCore",
             "WebSockets",
             "NavigationSystem",
+            "ProceduralMeshComponent",   // Merged floor collision
             "GeometryCollectionEngine",  // Chaos Destruction system
             "FieldSystemEngine",         // Field system for destruction forces
-            "ChaosSolverEngine"          // Chaos physics solver
+            "ChaosSolverEngine",         // Chaos physics solver
+            "ChaosCaching"               // Recorded destruction playback
         });
 
         PrivateDependencyModuleNames.AddRange(new string[] {
-            "Projects"
+            "Projects",
+            "RenderCore",       // Thread times for the perf capture
+            "RHI"
         });
 
         // Include paths for our module subdirectories
@@ -1,13 +1,16 @@
 #include "TowerGameModule.h"
 #include "Modules/ModuleManager.h"
+#include "Core/TowerLog.h"
 
 void FTowerGameModule::StartupModule()
 {
     UE_LOG(LogTemp, Log, TEXT("TowerGame module starting up"));
+    FTowerLog::Startup();
 }
 
 void FTowerGameModule::ShutdownModule()
 {
+    FTowerLog::Shutdown();
     UE_LOG(LogTemp, Log, TEXT("TowerGame module shutting down"));
 }
 
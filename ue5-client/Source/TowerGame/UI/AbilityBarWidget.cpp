@@ -1,4 +1,5 @@
 #include "AbilityBarWidget.h"
+#include "TowerCatalogSubsystem.h"
 #include "Components/HorizontalBox.h"
 #include "Components/HorizontalBoxSlot.h"
 #include "Components/TextBlock.h"
@@ -8,9 +9,21 @@
 #include "Components/Border.h"
 #include "Components/Button.h"
 #include "Components/Overlay.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/GameInstance.h"
+#include "Misc/App.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    const FName CooldownStartParam(TEXT("CooldownStartTime"));
+    const FName CooldownDurationParam(TEXT("CooldownDuration"));
+    const FName FlashStartParam(TEXT("FlashStartTime"));
+    const FName FlashDurationParam(TEXT("FlashDuration"));
+}
 
 // ============================================================
 // FAbilityDisplayData helpers
@@ -58,31 +71,103 @@ void UAbilityBarWidget::NativeConstruct()
     for (int32 i = 0; i < ABILITY_SLOT_COUNT; i++)
     {
         SlotStates[i] = FAbilitySlotState();
+
+        SweepMaterials[i] = nullptr;
+        UImage* Sweep = GetSlotSweep(i);
+        if (Sweep && CooldownSweepMaterial)
+        {
+            SweepMaterials[i] = UMaterialInstanceDynamic::Create(CooldownSweepMaterial, this);
+            Sweep->SetBrushFromMaterial(SweepMaterials[i]);
+        }
     }
 
     HideTooltip();
     RebuildDisplay();
 }
 
-void UAbilityBarWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UAbilityBarWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
-    UpdateCooldowns(InDeltaTime);
+void UAbilityBarWidget::TickUI(float DeltaTime)
+{
+    // Nothing to do between state changes; the sweep material animates itself
+    const double Now = GetUITime();
+    if (Now < NextSlotEventTime) return;
 
-    // Tick flash timers and update visuals
     for (int32 i = 0; i < ABILITY_SLOT_COUNT; i++)
     {
-        if (SlotStates[i].FlashTimer > 0.0f)
+        const FAbilitySlotState& State = SlotStates[i];
+        if (State.bShownOnCooldown != State.IsOnCooldown(Now) || State.bShownFlashing != State.IsFlashing(Now))
+        {
+            UpdateSlotVisuals(i);
+        }
+        else if (State.bShownOnCooldown)
         {
-            SlotStates[i].FlashTimer -= InDeltaTime;
-            if (SlotStates[i].FlashTimer < 0.0f)
+            UpdateCooldownText(i, Now);
+
+            UTextBlock* KeyLabel = nullptr;
+            UTextBlock* IconText = nullptr;
+            UTextBlock* CooldownText = nullptr;
+            UProgressBar* CooldownBar = nullptr;
+            UBorder* Border = nullptr;
+            GetSlotWidgets(i, KeyLabel, IconText, CooldownText, CooldownBar, Border);
+            if (CooldownBar && !SweepMaterials[i])
             {
-                SlotStates[i].FlashTimer = 0.0f;
+                CooldownBar->SetPercent(State.GetCooldownProgress(Now));
             }
         }
+    }
 
-        UpdateSlotVisuals(i);
+    ScheduleNextSlotEvent(Now);
+}
+
+double UAbilityBarWidget::GetUITime()
+{
+    // Slate renders UI materials with this as their Time
+    return FApp::GetCurrentTime() - GStartTime;
+}
+
+void UAbilityBarWidget::ScheduleNextSlotEvent(double Now)
+{
+    NextSlotEventTime = TNumericLimits<double>::Max();
+    for (int32 i = 0; i < ABILITY_SLOT_COUNT; i++)
+    {
+        const FAbilitySlotState& State = SlotStates[i];
+        if (State.bShownFlashing)
+        {
+            NextSlotEventTime = FMath::Min(NextSlotEventTime, State.FlashEndTime);
+        }
+        if (!State.bShownOnCooldown) continue;
+
+        // A progress bar without the sweep material needs every frame; else wake for the next whole second
+        UTextBlock* KeyLabel = nullptr;
+        UTextBlock* IconText = nullptr;
+        UTextBlock* CooldownText = nullptr;
+        UProgressBar* CooldownBar = nullptr;
+        UBorder* Border = nullptr;
+        GetSlotWidgets(i, KeyLabel, IconText, CooldownText, CooldownBar, Border);
+        if (CooldownBar && !SweepMaterials[i])
+        {
+            NextSlotEventTime = Now;
+            break;
+        }
+
+        const double Remaining = State.CooldownEndTime - Now;
+        const double NextSecond = State.CooldownEndTime - (FMath::CeilToDouble(Remaining) - 1.0);
+        NextSlotEventTime = FMath::Min(NextSlotEventTime, FMath::Min(State.CooldownEndTime, NextSecond));
+    }
+
+    // Off the UI tick entirely while every slot is settled
+    if (NextSlotEventTime < TNumericLimits<double>::Max())
+    {
+        UTowerUITickSubsystem::Start(this, this, UITickHandle);
+    }
+    else
+    {
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
     }
 }
 
@@ -118,26 +203,7 @@ void UAbilityBarWidget::LoadAbilities(const FString& AbilitiesJson)
             const TSharedPtr<FJsonObject>& AbilityObj = Pair.Value->AsObject();
             if (!AbilityObj) continue;
 
-            FAbilityDisplayData Data;
-            Data.Id = AbilityObj->GetStringField(TEXT("id"));
-            Data.Name = AbilityObj->GetStringField(TEXT("name"));
-            Data.Description = AbilityObj->GetStringField(TEXT("description"));
-            Data.IconTag = AbilityObj->GetStringField(TEXT("icon_tag"));
-            Data.Cooldown = AbilityObj->GetNumberField(TEXT("cooldown"));
-            Data.Range = AbilityObj->GetNumberField(TEXT("range"));
-            Data.Radius = AbilityObj->GetNumberField(TEXT("radius"));
-            Data.CastTime = AbilityObj->GetNumberField(TEXT("cast_time"));
-            Data.TargetType = ParseTargetType(AbilityObj->GetStringField(TEXT("target")));
-
-            // Parse cost sub-object
-            const TSharedPtr<FJsonObject>* CostObj = nullptr;
-            if (AbilityObj->TryGetObjectField(TEXT("cost"), CostObj))
-            {
-                Data.Cost = ParseCost(*CostObj);
-            }
-
-            Data.bIsReady = true;
-
+            FAbilityDisplayData Data = ParseAbility(AbilityObj);
             KnownAbilities.Add(Data.Id, Data);
         }
     }
@@ -157,9 +223,9 @@ void UAbilityBarWidget::LoadAbilities(const FString& AbilitiesJson)
             {
                 SlotStates[i].AbilityId = SlotVal->AsString();
             }
-            SlotStates[i].CooldownRemaining = 0.0f;
+            SlotStates[i].CooldownEndTime = 0.0;
             SlotStates[i].CooldownTotal = 0.0f;
-            SlotStates[i].FlashTimer = 0.0f;
+            SlotStates[i].FlashEndTime = 0.0;
         }
     }
 
@@ -169,6 +235,68 @@ void UAbilityBarWidget::LoadAbilities(const FString& AbilitiesJson)
     RebuildDisplay();
 }
 
+void UAbilityBarWidget::LoadKnownFromCatalog()
+{
+    UGameInstance* GI = GetGameInstance();
+    UTowerCatalogSubsystem* Catalogs = GI ? GI->GetSubsystem<UTowerCatalogSubsystem>() : nullptr;
+    if (!Catalogs) return;
+
+    // Slot assignments and cooldowns are kept; only the definitions change
+    KnownAbilities.Empty();
+    for (const FAbilityDisplayData& Ability : Catalogs->GetAbilities()->Items)
+    {
+        KnownAbilities.Add(Ability.Id, Ability);
+    }
+
+    RebuildDisplay();
+}
+
+FAbilityDisplayData UAbilityBarWidget::ParseAbility(const TSharedPtr<FJsonObject>& AbilityObj)
+{
+    FAbilityDisplayData Data;
+    Data.Id = AbilityObj->GetStringField(TEXT("id"));
+    Data.Name = AbilityObj->GetStringField(TEXT("name"));
+    Data.Description = AbilityObj->GetStringField(TEXT("description"));
+    AbilityObj->TryGetStringField(TEXT("icon_tag"), Data.IconTag);
+    Data.Cooldown = AbilityObj->GetNumberField(TEXT("cooldown"));
+    Data.Range = AbilityObj->GetNumberField(TEXT("range"));
+    Data.Radius = AbilityObj->GetNumberField(TEXT("radius"));
+    Data.CastTime = AbilityObj->GetNumberField(TEXT("cast_time"));
+    Data.TargetType = ParseTargetType(AbilityObj->GetStringField(TEXT("target")));
+
+    // Loadouts nest the cost; AbilityGetDefaults flattens it into cost_* fields
+    const TSharedPtr<FJsonObject>* CostObj = nullptr;
+    if (AbilityObj->TryGetObjectField(TEXT("cost"), CostObj))
+    {
+        Data.Cost = ParseCost(*CostObj);
+    }
+    else
+    {
+        AbilityObj->TryGetNumberField(TEXT("cost_kinetic"), Data.Cost.Kinetic);
+        AbilityObj->TryGetNumberField(TEXT("cost_thermal"), Data.Cost.Thermal);
+        AbilityObj->TryGetNumberField(TEXT("cost_semantic"), Data.Cost.Semantic);
+    }
+
+    Data.bIsReady = true;
+    return Data;
+}
+
+bool UAbilityBarWidget::ParseAbilities(const FString& AbilitiesJson, TArray<FAbilityDisplayData>& OutAbilities)
+{
+    TArray<TSharedPtr<FJsonValue>> AbilityArr;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(AbilitiesJson);
+    if (!FJsonSerializer::Deserialize(Reader, AbilityArr)) return false;
+
+    OutAbilities.Reserve(OutAbilities.Num() + AbilityArr.Num());
+    for (const TSharedPtr<FJsonValue>& Val : AbilityArr)
+    {
+        const TSharedPtr<FJsonObject>& AbilityObj = Val->AsObject();
+        if (!AbilityObj) continue;
+        OutAbilities.Add(ParseAbility(AbilityObj));
+    }
+    return true;
+}
+
 void UAbilityBarWidget::SetSlot(int32 SlotIndex, const FString& AbilityId)
 {
     if (SlotIndex < 0 || SlotIndex >= ABILITY_SLOT_COUNT)
@@ -194,9 +322,9 @@ void UAbilityBarWidget::SetSlot(int32 SlotIndex, const FString& AbilityId)
     }
 
     SlotStates[SlotIndex].AbilityId = AbilityId;
-    SlotStates[SlotIndex].CooldownRemaining = 0.0f;
+    SlotStates[SlotIndex].CooldownEndTime = 0.0;
     SlotStates[SlotIndex].CooldownTotal = 0.0f;
-    SlotStates[SlotIndex].FlashTimer = 0.0f;
+    SlotStates[SlotIndex].FlashEndTime = 0.0;
 
     RebuildDisplay();
 }
@@ -206,9 +334,9 @@ void UAbilityBarWidget::ClearSlot(int32 SlotIndex)
     if (SlotIndex < 0 || SlotIndex >= ABILITY_SLOT_COUNT) return;
 
     SlotStates[SlotIndex].AbilityId = TEXT("");
-    SlotStates[SlotIndex].CooldownRemaining = 0.0f;
+    SlotStates[SlotIndex].CooldownEndTime = 0.0;
     SlotStates[SlotIndex].CooldownTotal = 0.0f;
-    SlotStates[SlotIndex].FlashTimer = 0.0f;
+    SlotStates[SlotIndex].FlashEndTime = 0.0;
 
     RebuildDisplay();
 }
@@ -222,6 +350,7 @@ void UAbilityBarWidget::UseAbility(int32 SlotIndex)
     }
 
     const FAbilitySlotState& State = SlotStates[SlotIndex];
+    const double Now = GetUITime();
 
     if (!State.IsOccupied())
     {
@@ -229,10 +358,10 @@ void UAbilityBarWidget::UseAbility(int32 SlotIndex)
         return;
     }
 
-    if (State.IsOnCooldown())
+    if (State.IsOnCooldown(Now))
     {
         OnAbilityFailed.Broadcast(SlotIndex, FString::Printf(
-            TEXT("On cooldown (%.1fs)"), State.CooldownRemaining));
+            TEXT("On cooldown (%.1fs)"), State.GetCooldownRemaining(Now)));
         return;
     }
 
@@ -252,10 +381,10 @@ void UAbilityBarWidget::UseAbility(int32 SlotIndex)
     // Start cooldown
     float EffectiveCooldown = Data->Cooldown * (1.0f - CooldownReductionPercent);
     SlotStates[SlotIndex].CooldownTotal = EffectiveCooldown;
-    SlotStates[SlotIndex].CooldownRemaining = EffectiveCooldown;
+    SlotStates[SlotIndex].CooldownEndTime = Now + EffectiveCooldown;
 
     // Trigger flash animation
-    SlotStates[SlotIndex].FlashTimer = FlashDuration;
+    SlotStates[SlotIndex].FlashEndTime = Now + FlashDuration;
 
     // Broadcast
     OnAbilityUsed.Broadcast(SlotIndex, State.AbilityId);
@@ -268,15 +397,13 @@ void UAbilityBarWidget::UseAbility(int32 SlotIndex)
 
 void UAbilityBarWidget::UpdateCooldowns(float DeltaTime)
 {
+    const double Now = GetUITime();
     for (int32 i = 0; i < ABILITY_SLOT_COUNT; i++)
     {
-        if (SlotStates[i].CooldownRemaining > 0.0f)
+        if (SlotStates[i].IsOnCooldown(Now))
         {
-            SlotStates[i].CooldownRemaining -= DeltaTime;
-            if (SlotStates[i].CooldownRemaining < 0.0f)
-            {
-                SlotStates[i].CooldownRemaining = 0.0f;
-            }
+            SlotStates[i].CooldownEndTime = FMath::Max(Now, SlotStates[i].CooldownEndTime - DeltaTime);
+            UpdateSlotVisuals(i);
         }
     }
 }
@@ -312,13 +439,13 @@ bool UAbilityBarWidget::GetSlotAbility(int32 SlotIndex, FAbilityDisplayData& Out
 bool UAbilityBarWidget::IsSlotOnCooldown(int32 SlotIndex) const
 {
     if (SlotIndex < 0 || SlotIndex >= ABILITY_SLOT_COUNT) return false;
-    return SlotStates[SlotIndex].IsOnCooldown();
+    return SlotStates[SlotIndex].IsOnCooldown(GetUITime());
 }
 
 float UAbilityBarWidget::GetSlotCooldownRemaining(int32 SlotIndex) const
 {
     if (SlotIndex < 0 || SlotIndex >= ABILITY_SLOT_COUNT) return 0.0f;
-    return SlotStates[SlotIndex].CooldownRemaining;
+    return SlotStates[SlotIndex].GetCooldownRemaining(GetUITime());
 }
 
 // ============================================================
@@ -327,6 +454,7 @@ float UAbilityBarWidget::GetSlotCooldownRemaining(int32 SlotIndex) const
 
 void UAbilityBarWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_AbilityBar_RebuildDisplay);
     for (int32 i = 0; i < ABILITY_SLOT_COUNT; i++)
     {
         UTextBlock* KeyLabel = nullptr;
@@ -400,15 +528,20 @@ void UAbilityBarWidget::UpdateSlotVisuals(int32 SlotIndex)
 
     GetSlotWidgets(SlotIndex, KeyLabel, IconText, CooldownText, CooldownBar, Border);
 
-    const FAbilitySlotState& State = SlotStates[SlotIndex];
+    FAbilitySlotState& State = SlotStates[SlotIndex];
+    const double Now = GetUITime();
+    const bool bOnCooldown = State.IsOnCooldown(Now);
+    const bool bFlashing = State.IsFlashing(Now);
+    State.bShownOnCooldown = bOnCooldown;
+    State.bShownFlashing = bFlashing;
 
     // --- Cooldown overlay ---
     if (CooldownText)
     {
-        if (State.IsOnCooldown())
+        if (bOnCooldown)
         {
-            int32 SecsRemaining = FMath::CeilToInt(State.CooldownRemaining);
-            CooldownText->SetText(FText::FromString(FString::Printf(TEXT("%ds"), SecsRemaining)));
+            State.ShownSeconds = 0;
+            UpdateCooldownText(SlotIndex, Now);
             CooldownText->SetVisibility(ESlateVisibility::HitTestInvisible);
             CooldownText->SetColorAndOpacity(FSlateColor(FLinearColor(1.0f, 0.8f, 0.2f)));
         }
@@ -419,12 +552,18 @@ void UAbilityBarWidget::UpdateSlotVisuals(int32 SlotIndex)
         }
     }
 
-    // --- Cooldown progress bar (sweeps from 1.0 to 0.0 as cooldown expires) ---
+    // --- Cooldown sweep: the material animates it; a bare progress bar is driven from TickUI ---
+    UpdateSweepMaterial(SlotIndex);
+    if (UImage* Sweep = GetSlotSweep(SlotIndex))
+    {
+        Sweep->SetVisibility(bOnCooldown || bFlashing ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Hidden);
+    }
+
     if (CooldownBar)
     {
-        CooldownBar->SetPercent(State.GetCooldownProgress());
+        CooldownBar->SetPercent(SweepMaterials[SlotIndex] ? 0.0f : State.GetCooldownProgress(Now));
 
-        if (State.IsOnCooldown())
+        if (bOnCooldown && !SweepMaterials[SlotIndex])
         {
             CooldownBar->SetVisibility(ESlateVisibility::HitTestInvisible);
             CooldownBar->SetFillColorAndOpacity(FLinearColor(0.2f, 0.2f, 0.2f, 0.6f));
@@ -436,15 +575,14 @@ void UAbilityBarWidget::UpdateSlotVisuals(int32 SlotIndex)
     }
 
     // --- Tint (gray on cooldown, flash on use, normal otherwise) ---
+    // The flash holds for FlashDuration; a fade belongs in the sweep material
     if (IconText)
     {
-        if (State.IsFlashing())
+        if (bFlashing)
         {
-            float Alpha = State.FlashTimer / FlashDuration;
-            FLinearColor Lerped = FMath::Lerp(ReadyTint, FlashColor, Alpha);
-            IconText->SetColorAndOpacity(FSlateColor(Lerped));
+            IconText->SetColorAndOpacity(FSlateColor(FlashColor));
         }
-        else if (State.IsOnCooldown())
+        else if (bOnCooldown)
         {
             IconText->SetColorAndOpacity(FSlateColor(CooldownTint));
         }
@@ -457,16 +595,11 @@ void UAbilityBarWidget::UpdateSlotVisuals(int32 SlotIndex)
     // --- Border tint ---
     if (Border)
     {
-        if (State.IsFlashing())
+        if (bFlashing)
         {
-            float Alpha = State.FlashTimer / FlashDuration;
-            FLinearColor BorderFlash = FMath::Lerp(
-                FLinearColor(0.15f, 0.15f, 0.15f, 1.0f),
-                FLinearColor(1.0f, 1.0f, 1.0f, 1.0f),
-                Alpha);
-            Border->SetBrushColor(BorderFlash);
+            Border->SetBrushColor(FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
         }
-        else if (State.IsOnCooldown())
+        else if (bOnCooldown)
         {
             Border->SetBrushColor(FLinearColor(0.1f, 0.1f, 0.1f, 1.0f));
         }
@@ -479,6 +612,41 @@ void UAbilityBarWidget::UpdateSlotVisuals(int32 SlotIndex)
             Border->SetBrushColor(FLinearColor(0.08f, 0.08f, 0.08f, 0.5f));
         }
     }
+
+    ScheduleNextSlotEvent(Now);
+}
+
+void UAbilityBarWidget::UpdateCooldownText(int32 SlotIndex, double Now)
+{
+    UTextBlock* KeyLabel = nullptr;
+    UTextBlock* IconText = nullptr;
+    UTextBlock* CooldownText = nullptr;
+    UProgressBar* CooldownBar = nullptr;
+    UBorder* Border = nullptr;
+    GetSlotWidgets(SlotIndex, KeyLabel, IconText, CooldownText, CooldownBar, Border);
+
+    FAbilitySlotState& State = SlotStates[SlotIndex];
+    const int32 SecsRemaining = FMath::CeilToInt(State.GetCooldownRemaining(Now));
+    if (!CooldownText || SecsRemaining == State.ShownSeconds) return;
+
+    State.ShownSeconds = SecsRemaining;
+    CooldownText->SetText(FText::FromString(FString::Printf(TEXT("%ds"), SecsRemaining)));
+}
+
+void UAbilityBarWidget::UpdateSweepMaterial(int32 SlotIndex)
+{
+    UMaterialInstanceDynamic* Material = SweepMaterials[SlotIndex];
+    if (!Material) return;
+
+    const FAbilitySlotState& State = SlotStates[SlotIndex];
+    const double Now = GetUITime();
+    const bool bOnCooldown = State.IsOnCooldown(Now);
+
+    // As floats, UI seconds stay within a frame of error for a day of uptime
+    Material->SetScalarParameterValue(CooldownStartParam, static_cast<float>(State.CooldownEndTime - State.CooldownTotal));
+    Material->SetScalarParameterValue(CooldownDurationParam, bOnCooldown ? State.CooldownTotal : 0.0f);
+    Material->SetScalarParameterValue(FlashStartParam, static_cast<float>(State.FlashEndTime - FlashDuration));
+    Material->SetScalarParameterValue(FlashDurationParam, State.IsFlashing(Now) ? FlashDuration : 0.0f);
 }
 
 void UAbilityBarWidget::ShowTooltip(int32 SlotIndex)
@@ -631,11 +799,25 @@ void UAbilityBarWidget::GetSlotWidgets(int32 SlotIndex, UTextBlock*& OutKeyLabel
     }
 }
 
+UImage* UAbilityBarWidget::GetSlotSweep(int32 SlotIndex) const
+{
+    switch (SlotIndex)
+    {
+    case 0: return Slot0_CooldownSweep;
+    case 1: return Slot1_CooldownSweep;
+    case 2: return Slot2_CooldownSweep;
+    case 3: return Slot3_CooldownSweep;
+    case 4: return Slot4_CooldownSweep;
+    case 5: return Slot5_CooldownSweep;
+    default: return nullptr;
+    }
+}
+
 // ============================================================
 // JSON Parsing Helpers
 // ============================================================
 
-EAbilityTarget UAbilityBarWidget::ParseTargetType(const FString& Str) const
+EAbilityTarget UAbilityBarWidget::ParseTargetType(const FString& Str)
 {
     if (Str == TEXT("Melee"))           return EAbilityTarget::Melee;
     if (Str == TEXT("Ranged"))          return EAbilityTarget::Ranged;
@@ -647,7 +829,7 @@ EAbilityTarget UAbilityBarWidget::ParseTargetType(const FString& Str) const
     return EAbilityTarget::Melee;
 }
 
-FAbilityCost UAbilityBarWidget::ParseCost(const TSharedPtr<FJsonObject>& CostObj) const
+FAbilityCost UAbilityBarWidget::ParseCost(const TSharedPtr<FJsonObject>& CostObj)
 {
     FAbilityCost Cost;
     if (!CostObj) return Cost;
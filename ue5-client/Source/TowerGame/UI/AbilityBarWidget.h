@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "TowerUITickSubsystem.h"
 #include "AbilityBarWidget.generated.h"
 
 class UHorizontalBox;
@@ -12,6 +13,8 @@ class UButton;
 class UVerticalBox;
 class UBorder;
 class UOverlay;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
 
 /**
  * Targeting type for abilities — mirrors Rust AbilityTarget enum.
@@ -110,6 +113,9 @@ struct FAbilityDisplayData
 
 /**
  * Per-slot cooldown tracking state.
+ *
+ * Times are UI seconds (UAbilityBarWidget::GetUITime), the clock a UI
+ * material's Time node reads, so the cooldown sweep can animate itself.
  */
 USTRUCT()
 struct FAbilitySlotState
@@ -122,18 +128,24 @@ struct FAbilitySlotState
     /** Total cooldown duration for the current cycle */
     float CooldownTotal = 0.0f;
 
-    /** Remaining cooldown in seconds */
-    float CooldownRemaining = 0.0f;
+    /** When the current cooldown ends */
+    double CooldownEndTime = 0.0;
+
+    /** When the use-animation flash ends */
+    double FlashEndTime = 0.0;
 
-    /** Flash timer for use-animation feedback */
-    float FlashTimer = 0.0f;
+    /** State the slot's widgets were last built for; they're rebuilt when it changes */
+    bool bShownOnCooldown = false;
+    bool bShownFlashing = false;
+    int32 ShownSeconds = 0;
 
-    bool IsOnCooldown() const { return CooldownRemaining > 0.0f; }
-    bool IsFlashing() const { return FlashTimer > 0.0f; }
+    float GetCooldownRemaining(double Now) const { return FMath::Max(0.0f, static_cast<float>(CooldownEndTime - Now)); }
+    bool IsOnCooldown(double Now) const { return CooldownEndTime > Now; }
+    bool IsFlashing(double Now) const { return FlashEndTime > Now; }
     bool IsOccupied() const { return !AbilityId.IsEmpty(); }
-    float GetCooldownProgress() const
+    float GetCooldownProgress(double Now) const
     {
-        return CooldownTotal > 0.0f ? CooldownRemaining / CooldownTotal : 0.0f;
+        return CooldownTotal > 0.0f ? GetCooldownRemaining(Now) / CooldownTotal : 0.0f;
     }
 };
 
@@ -151,22 +163,33 @@ static constexpr int32 ABILITY_SLOT_COUNT = 6;
  *     - Keybind label (1-6)
  *     - Ability icon
  *     - Cooldown overlay text (remaining seconds)
- *     - Cooldown sweep progress bar
+ *     - Cooldown sweep (material image, or a progress bar)
  *
  * Slots are grayed out when on cooldown, flash white on use.
+ *
+ * Slot widgets are only touched when a slot's state changes: equip, use,
+ * ready, flash end, and the cooldown text's whole seconds. With
+ * CooldownSweepMaterial set, each slot's SlotN_CooldownSweep image gets a
+ * dynamic instance with CooldownStartTime and CooldownDuration, and the
+ * material animates the sweep from its Time node. The bar can then sit in
+ * an Invalidation Box. Slots with only a CooldownBar still have it updated
+ * each frame while cooling down.
  * Hover tooltip shows ability name, description, cost, targeting, range/radius.
  *
  * Data loaded from Rust JSON via LoadAbilities().
  * Mirrors Rust AbilityLoadout (6 slots max) and AbilityCooldownTracker.
  */
-UCLASS()
-class TOWERGAME_API UAbilityBarWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UAbilityBarWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Cooldown and flash updates, while any slot has one due (see NextSlotEventTime) */
+    virtual void TickUI(float DeltaTime) override;
 
     // ============ Ability Management ============
 
@@ -174,6 +197,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Ability")
     void LoadAbilities(const FString& AbilitiesJson);
 
+    /** Take the known abilities from the shared catalog's defaults, keeping the slot assignments */
+    UFUNCTION(BlueprintCallable, Category = "Ability")
+    void LoadKnownFromCatalog();
+
+    /** One ability of a loadout's known_abilities or of the AbilityGetDefaults catalog */
+    static FAbilityDisplayData ParseAbility(const TSharedPtr<class FJsonObject>& AbilityObj);
+
+    /** Append the abilities of an AbilityGetDefaults array; false if it doesn't parse */
+    static bool ParseAbilities(const FString& AbilitiesJson, TArray<FAbilityDisplayData>& OutAbilities);
+
     /** Assign an ability to a hotbar slot (0-5) */
     UFUNCTION(BlueprintCallable, Category = "Ability")
     void SetSlot(int32 SlotIndex, const FString& AbilityId);
@@ -186,7 +219,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Ability")
     void UseAbility(int32 SlotIndex);
 
-    /** Tick cooldowns by delta time (called automatically in NativeTick) */
+    /** Advance every running cooldown by DeltaTime on top of real time (e.g. a cooldown refund) */
     UFUNCTION(BlueprintCallable, Category = "Ability")
     void UpdateCooldowns(float DeltaTime);
 
@@ -230,6 +263,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
     FLinearColor ReadyTint = FLinearColor(1.0f, 1.0f, 1.0f, 1.0f);
 
+    /**
+     * UI material for the SlotN_CooldownSweep images. Scalar parameters:
+     * CooldownStartTime and CooldownDuration (UI seconds; duration 0 when
+     * ready), FlashStartTime and FlashDuration.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
+    UMaterialInterface* CooldownSweepMaterial = nullptr;
+
     // ============ Events ============
 
     UPROPERTY(BlueprintAssignable, Category = "Ability")
@@ -256,6 +297,8 @@ public:
     UProgressBar* Slot0_CooldownBar = nullptr;
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UBorder* Slot0_Border = nullptr;
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
+    UImage* Slot0_CooldownSweep = nullptr;
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UTextBlock* Slot1_KeyLabel = nullptr;
@@ -267,6 +310,8 @@ public:
     UProgressBar* Slot1_CooldownBar = nullptr;
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UBorder* Slot1_Border = nullptr;
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
+    UImage* Slot1_CooldownSweep = nullptr;
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UTextBlock* Slot2_KeyLabel = nullptr;
@@ -278,6 +323,8 @@ public:
     UProgressBar* Slot2_CooldownBar = nullptr;
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UBorder* Slot2_Border = nullptr;
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
+    UImage* Slot2_CooldownSweep = nullptr;
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UTextBlock* Slot3_KeyLabel = nullptr;
@@ -289,6 +336,8 @@ public:
     UProgressBar* Slot3_CooldownBar = nullptr;
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UBorder* Slot3_Border = nullptr;
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
+    UImage* Slot3_CooldownSweep = nullptr;
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UTextBlock* Slot4_KeyLabel = nullptr;
@@ -300,6 +349,8 @@ public:
     UProgressBar* Slot4_CooldownBar = nullptr;
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UBorder* Slot4_Border = nullptr;
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
+    UImage* Slot4_CooldownSweep = nullptr;
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UTextBlock* Slot5_KeyLabel = nullptr;
@@ -311,6 +362,8 @@ public:
     UProgressBar* Slot5_CooldownBar = nullptr;
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
     UBorder* Slot5_Border = nullptr;
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
+    UImage* Slot5_CooldownSweep = nullptr;
 
     /** Tooltip panel (shown on hover) */
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Ability")
@@ -337,6 +390,18 @@ protected:
     /** Update a single slot's visuals (cooldown, tint, flash) */
     void UpdateSlotVisuals(int32 SlotIndex);
 
+    /** Set the cooldown text to the whole seconds left, if that changed */
+    void UpdateCooldownText(int32 SlotIndex, double Now);
+
+    /** Push a slot's cooldown and flash timing into its sweep material */
+    void UpdateSweepMaterial(int32 SlotIndex);
+
+    /** Find the soonest time a slot's widgets need touching again */
+    void ScheduleNextSlotEvent(double Now);
+
+    /** Seconds on the clock UI materials animate by */
+    static double GetUITime();
+
     /** Show tooltip for a specific slot */
     void ShowTooltip(int32 SlotIndex);
 
@@ -347,11 +412,13 @@ protected:
     void GetSlotWidgets(int32 SlotIndex, UTextBlock*& OutKeyLabel, UTextBlock*& OutIconText,
         UTextBlock*& OutCooldownText, UProgressBar*& OutCooldownBar, UBorder*& OutBorder) const;
 
+    UImage* GetSlotSweep(int32 SlotIndex) const;
+
     /** Parse AbilityTarget enum from string */
-    EAbilityTarget ParseTargetType(const FString& Str) const;
+    static EAbilityTarget ParseTargetType(const FString& Str);
 
     /** Build cost struct from JSON object */
-    FAbilityCost ParseCost(const TSharedPtr<class FJsonObject>& CostObj) const;
+    static FAbilityCost ParseCost(const TSharedPtr<class FJsonObject>& CostObj);
 
 private:
     /** All known abilities keyed by ID */
@@ -365,4 +432,13 @@ private:
 
     /** Currently hovered slot for tooltip (-1 = none) */
     int32 HoveredSlot = -1;
+
+    /** Sweep material instance per slot (null without a sweep image or material) */
+    UPROPERTY()
+    UMaterialInstanceDynamic* SweepMaterials[ABILITY_SLOT_COUNT] = {};
+
+    /** TickUI does nothing before this UI time; off the UI tick when Max */
+    double NextSlotEventTime = TNumericLimits<double>::Max();
+
+    int32 UITickHandle = INDEX_NONE;
 };
@@ -1,10 +1,13 @@
 #include "AchievementWidget.h"
+#include "TowerGame/Core/TowerAchievementSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
 #include "Components/ScrollBox.h"
 #include "Components/HorizontalBox.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UAchievementWidget::NativeConstruct()
 {
@@ -12,6 +15,48 @@ void UAchievementWidget::NativeConstruct()
 
     bFilterActive = false;
     RebuildList();
+
+    if (UGameInstance* GI = GetGameInstance())
+    {
+        if (UTowerAchievementSubsystem* Achievements = GI->GetSubsystem<UTowerAchievementSubsystem>())
+        {
+            UnlockedHandle = Achievements->OnAchievementsUnlocked.AddUObject(
+                this, &UAchievementWidget::HandleAchievementsUnlocked);
+        }
+    }
+}
+
+void UAchievementWidget::NativeDestruct()
+{
+    if (UGameInstance* GI = GetGameInstance())
+    {
+        if (UTowerAchievementSubsystem* Achievements = GI->GetSubsystem<UTowerAchievementSubsystem>())
+        {
+            Achievements->OnAchievementsUnlocked.Remove(UnlockedHandle);
+        }
+    }
+    UnlockedHandle.Reset();
+    Super::NativeDestruct();
+}
+
+void UAchievementWidget::HandleAchievementsUnlocked(const TArray<FString>& AchievementIds)
+{
+    for (const FString& Id : AchievementIds)
+    {
+        for (auto& Ach : AllAchievements)
+        {
+            if (Ach.Id == Id)
+            {
+                Ach.bUnlocked = true;
+                Ach.Progress = 1.0f;
+                break;
+            }
+        }
+    }
+    RebuildList();
+
+    // One toast per flush; the newest unlock is the one shown
+    ShowUnlockToast(AchievementIds.Last());
 }
 
 void UAchievementWidget::LoadFromJson(const FString& AchievementsJson)
@@ -179,6 +224,7 @@ void UAchievementWidget::ShowUnlockToast(const FString& AchievementId)
 
 void UAchievementWidget::RebuildList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Achievement_RebuildList);
     // Update overall progress
     if (OverallProgressBar)
         OverallProgressBar->SetPercent(GetOverallProgress());
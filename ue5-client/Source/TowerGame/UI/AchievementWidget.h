@@ -79,6 +79,7 @@ class TOWERGAME_API UAchievementWidget : public UUserWidget
 
 public:
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
 
     // --- Data Loading ---
 
@@ -157,6 +158,10 @@ protected:
     EAchievementCategory CurrentFilter = EAchievementCategory::Combat;
     bool bFilterActive = false;
 
+    /** Mark and toast what UTowerAchievementSubsystem's latest flush unlocked */
+    void HandleAchievementsUnlocked(const TArray<FString>& AchievementIds);
+    FDelegateHandle UnlockedHandle;
+
     void RebuildList();
     FLinearColor GetCategoryColor(EAchievementCategory Category) const;
     FLinearColor GetTierColor(EAchievementTier Tier) const;
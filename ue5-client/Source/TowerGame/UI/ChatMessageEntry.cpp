@@ -0,0 +1,32 @@
+#include "ChatMessageEntry.h"
+#include "Components/TextBlock.h"
+
+void UChatMessageEntry::NativeOnInitialized()
+{
+    Super::NativeOnInitialized();
+
+    // Same look as the ScrollBox rows UChatWidget builds itself
+    if (MessageText)
+    {
+        FSlateFontInfo Font = MessageText->GetFont();
+        Font.Size = 11;
+        MessageText->SetFont(Font);
+        MessageText->SetAutoWrapText(true);
+    }
+}
+
+void UChatMessageEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+    if (const UChatMessageItem* Item = Cast<UChatMessageItem>(ListItemObject))
+    {
+        SetItem(*Item);
+    }
+}
+
+void UChatMessageEntry::SetItem(const UChatMessageItem& Item)
+{
+    if (!MessageText) return;
+
+    MessageText->SetText(Item.DisplayText);
+    MessageText->SetColorAndOpacity(FSlateColor(Item.Message.Color));
+}
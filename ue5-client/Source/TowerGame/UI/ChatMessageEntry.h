@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "ChatWidget.h"
+#include "ChatMessageEntry.generated.h"
+
+class UTextBlock;
+
+/**
+ * One chat line as a UListView item. UChatWidget owns a fixed ring of these
+ * and reuses the oldest for each new line; DisplayText is formatted once
+ * when the line is added (or when a coalesced combat line repeats).
+ */
+UCLASS()
+class TOWERGAME_API UChatMessageItem : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    FChatMessage Message;
+
+    /** Timestamp, sender and message, ready to show */
+    FText DisplayText;
+
+    /** Identical combat lines folded into this one ("x12") */
+    int32 RepeatCount = 1;
+
+    bool bCombatLog = false;
+};
+
+/**
+ * Row widget for the chat UListView. Subclass in Blueprint with a
+ * MessageText text block and set it as the list's Entry Widget Class; the
+ * list recycles rows as they scroll out.
+ */
+UCLASS(Abstract)
+class TOWERGAME_API UChatMessageEntry : public UUserWidget, public IUserObjectListEntry
+{
+    GENERATED_BODY()
+
+public:
+    /** Show Item; also called when a recycled or coalesced item changes under this row */
+    void SetItem(const UChatMessageItem& Item);
+
+    UPROPERTY(meta = (BindWidget), BlueprintReadOnly, Category = "Chat")
+    UTextBlock* MessageText;
+
+protected:
+    virtual void NativeOnInitialized() override;
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+};
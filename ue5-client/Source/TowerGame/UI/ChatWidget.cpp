@@ -1,4 +1,6 @@
 #include "ChatWidget.h"
+#include "ChatMessageEntry.h"
+#include "Components/ListView.h"
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Components/EditableTextBox.h"
@@ -17,24 +19,43 @@ void UChatWidget::NativeConstruct()
     {
         InputBox->OnTextCommitted.AddDynamic(this, &UChatWidget::OnInputCommitted);
     }
+
+    // Fades after FadeDelay even if nothing is ever said
+    UTowerUITickSubsystem::Start(this, this, UITickHandle);
 }
 
-void UChatWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UChatWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UChatWidget::TickUI(float DeltaTime)
+{
     // Auto-fade when not interacting
     if (!IsInputFocused())
     {
-        TimeSinceLastMessage += InDeltaTime;
+        TimeSinceLastMessage += DeltaTime;
         if (TimeSinceLastMessage > FadeDelay && !bFaded)
         {
             bFaded = true;
             SetRenderOpacity(FadeOpacity);
+            UTowerUITickSubsystem::Stop(this, UITickHandle);
         }
     }
 }
 
+void UChatWidget::Unfade()
+{
+    TimeSinceLastMessage = 0.0f;
+    if (bFaded)
+    {
+        bFaded = false;
+        SetRenderOpacity(1.0f);
+    }
+    UTowerUITickSubsystem::Start(this, this, UITickHandle);
+}
+
 void UChatWidget::AddPlayerMessage(const FString& SenderName, const FString& Message)
 {
     AddMessage(SenderName, Message, FLinearColor::White, false);
@@ -47,36 +68,43 @@ void UChatWidget::AddSystemMessage(const FString& Message)
 
 void UChatWidget::AddCombatLog(const FString& Message)
 {
+    const float Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+
+    // A burst of the same hit folds into the last line rather than scrolling chat away
+    const int32 NewestIdx = GetNewestIndex();
+    UChatMessageItem* Newest = NewestIdx != INDEX_NONE ? Ring[NewestIdx] : nullptr;
+    if (Newest && Newest->bCombatLog && Newest->Message.Message == Message
+        && Now - Newest->Message.Timestamp <= CombatLogCoalesceWindow)
+    {
+        Newest->RepeatCount++;
+        Newest->Message.Timestamp = Now;
+        FormatItem(*Newest);
+        RefreshRow(NewestIdx);
+        return;
+    }
+
     AddMessage(TEXT(""), Message, FLinearColor(0.5f, 0.5f, 0.5f), true);
+    Ring[GetNewestIndex()]->bCombatLog = true;
 }
 
 void UChatWidget::AddMessage(const FString& SenderName, const FString& Message,
     FLinearColor Color, bool bSystem)
 {
-    FChatMessage Msg;
-    Msg.SenderName = SenderName;
-    Msg.Message = Message;
-    Msg.Color = Color;
-    Msg.bIsSystem = bSystem;
-    Msg.Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
-
-    Messages.Add(Msg);
-
-    // Trim old messages
-    while (Messages.Num() > MaxMessages)
-    {
-        Messages.RemoveAt(0);
-    }
+    const int32 RingIdx = AppendItem();
+    UChatMessageItem& Item = *Ring[RingIdx];
+    Item.Message.SenderName = SenderName;
+    Item.Message.Message = Message;
+    Item.Message.Color = Color;
+    Item.Message.bIsSystem = bSystem;
+    Item.Message.Timestamp = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0f;
+    Item.RepeatCount = 1;
+    Item.bCombatLog = false;
+    FormatItem(Item);
+    RefreshRow(RingIdx);
 
     // Reset fade
-    TimeSinceLastMessage = 0.0f;
-    if (bFaded)
-    {
-        bFaded = false;
-        SetRenderOpacity(1.0f);
-    }
+    Unfade();
 
-    RebuildMessages();
     ScrollToBottom();
 }
 
@@ -87,12 +115,7 @@ void UChatWidget::FocusInput()
         InputBox->SetKeyboardFocus();
 
         // Unfade when focusing
-        TimeSinceLastMessage = 0.0f;
-        if (bFaded)
-        {
-            bFaded = false;
-            SetRenderOpacity(1.0f);
-        }
+        Unfade();
     }
 }
 
@@ -131,45 +154,111 @@ void UChatWidget::SendCurrentInput()
     AddPlayerMessage(TEXT("You"), Text);
 }
 
-void UChatWidget::RebuildMessages()
-{
-    if (!MessageScrollBox) return;
+// ============ History ============
 
-    MessageScrollBox->ClearChildren();
+int32 UChatWidget::AppendItem()
+{
+    const int32 Capacity = FMath::Max(MaxMessages, 1);
 
-    for (const FChatMessage& Msg : Messages)
+    int32 RingIdx;
+    if (Ring.Num() < Capacity)
     {
-        UTextBlock* MsgText = NewObject<UTextBlock>(this);
-
-        FString DisplayText;
-        if (bShowTimestamps)
+        RingIdx = Ring.Add(NewObject<UChatMessageItem>(this));
+        if (MessageScrollBox && !MessageListView)
         {
-            int32 Mins = FMath::FloorToInt(Msg.Timestamp / 60.0f);
-            int32 Secs = FMath::FloorToInt(FMath::Fmod(Msg.Timestamp, 60.0f));
-            DisplayText = FString::Printf(TEXT("[%02d:%02d] "), Mins, Secs);
+            UTextBlock* Row = NewObject<UTextBlock>(this);
+            Row->SetAutoWrapText(true);
+            FSlateFontInfo Font = Row->GetFont();
+            Font.Size = 11;
+            Row->SetFont(Font);
+            ScrollRows.SetNum(Ring.Num());
+            ScrollRows[RingIdx] = Row;
         }
-
-        if (!Msg.SenderName.IsEmpty())
+    }
+    else
+    {
+        // Full: the oldest line becomes the newest
+        RingIdx = RingHead;
+        RingHead = (RingHead + 1) % Ring.Num();
+        if (MessageListView)
+        {
+            MessageListView->RemoveItem(Ring[RingIdx]);
+        }
+        if (MessageScrollBox && ScrollRows.IsValidIndex(RingIdx))
         {
-            DisplayText += FString::Printf(TEXT("%s: "), *Msg.SenderName);
+            MessageScrollBox->RemoveChild(ScrollRows[RingIdx]);
         }
-        DisplayText += Msg.Message;
+    }
 
-        MsgText->SetText(FText::FromString(DisplayText));
-        MsgText->SetColorAndOpacity(FSlateColor(Msg.Color));
-        MsgText->SetAutoWrapText(true);
+    if (MessageListView)
+    {
+        MessageListView->AddItem(Ring[RingIdx]);
+    }
+    else if (MessageScrollBox && ScrollRows.IsValidIndex(RingIdx))
+    {
+        MessageScrollBox->AddChild(ScrollRows[RingIdx]);
+    }
+    return RingIdx;
+}
 
-        FSlateFontInfo Font = MsgText->GetFont();
-        Font.Size = 11;
-        MsgText->SetFont(Font);
+int32 UChatWidget::GetNewestIndex() const
+{
+    if (Ring.Num() == 0) return INDEX_NONE;
+    return (RingHead + Ring.Num() - 1) % Ring.Num();
+}
+
+void UChatWidget::FormatItem(UChatMessageItem& Item) const
+{
+    const FChatMessage& Msg = Item.Message;
 
-        MessageScrollBox->AddChild(MsgText);
+    FString DisplayText;
+    if (bShowTimestamps)
+    {
+        int32 Mins = FMath::FloorToInt(Msg.Timestamp / 60.0f);
+        int32 Secs = FMath::FloorToInt(FMath::Fmod(Msg.Timestamp, 60.0f));
+        DisplayText = FString::Printf(TEXT("[%02d:%02d] "), Mins, Secs);
+    }
+
+    if (!Msg.SenderName.IsEmpty())
+    {
+        DisplayText += FString::Printf(TEXT("%s: "), *Msg.SenderName);
+    }
+    DisplayText += Msg.Message;
+
+    if (Item.RepeatCount > 1)
+    {
+        DisplayText += FString::Printf(TEXT(" x%d"), Item.RepeatCount);
+    }
+
+    Item.DisplayText = FText::FromString(DisplayText);
+}
+
+void UChatWidget::RefreshRow(int32 RingIdx)
+{
+    UChatMessageItem* Item = Ring[RingIdx];
+
+    // A recycled item can keep its row, which then won't see it "set" again
+    if (MessageListView)
+    {
+        if (UChatMessageEntry* Entry = MessageListView->GetEntryWidgetFromItem<UChatMessageEntry>(Item))
+        {
+            Entry->SetItem(*Item);
+        }
+    }
+    else if (ScrollRows.IsValidIndex(RingIdx))
+    {
+        ScrollRows[RingIdx]->SetText(Item->DisplayText);
+        ScrollRows[RingIdx]->SetColorAndOpacity(FSlateColor(Item->Message.Color));
     }
 }
 
 void UChatWidget::ScrollToBottom()
 {
-    if (MessageScrollBox)
+    if (MessageListView)
+    {
+        MessageListView->ScrollToBottom();
+    }
+    else if (MessageScrollBox)
     {
         MessageScrollBox->ScrollToEnd();
     }
@@ -2,12 +2,15 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "TowerUITickSubsystem.h"
 #include "ChatWidget.generated.h"
 
 class UScrollBox;
 class UTextBlock;
 class UEditableTextBox;
 class UButton;
+class UListView;
+class UChatMessageItem;
 
 /**
  * Chat message entry.
@@ -48,15 +51,25 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnChatMessageSent, const FString&,
  * - Enter key to focus input, Enter to send
  * - Max history (50 messages)
  * - Timestamp display option
+ *
+ * History is a ring of MaxMessages items: once full, each new line reuses
+ * the oldest item (and its row), so a long fight allocates nothing. Text is
+ * formatted once per line. With MessageListView bound (entry class a
+ * UChatMessageEntry subclass) only visible rows exist; MessageScrollBox is
+ * the fallback and recycles its text blocks the same way. Identical combat
+ * log lines within CombatLogCoalesceWindow fold into one ("x12").
  */
-UCLASS()
-class TOWERGAME_API UChatWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UChatWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Counts down to the fade while unfaded */
+    virtual void TickUI(float DeltaTime) override;
 
     // ============ API ============
 
@@ -98,6 +111,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chat")
     bool bShowTimestamps = false;
 
+    /** Seconds within which an identical combat log line bumps the last one's count instead */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chat")
+    float CombatLogCoalesceWindow = 2.0f;
+
     // ============ Events ============
 
     UPROPERTY(BlueprintAssignable, Category = "Chat")
@@ -105,6 +122,10 @@ public:
 
     // ============ Bound Widgets ============
 
+    /** Virtualized message list; preferred over MessageScrollBox when bound */
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Chat")
+    UListView* MessageListView;
+
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Chat")
     UScrollBox* MessageScrollBox;
 
@@ -122,13 +143,34 @@ protected:
     void OnInputCommitted(const FText& Text, ETextCommit::Type CommitMethod);
 
     void SendCurrentInput();
-    void RebuildMessages();
     void ScrollToBottom();
 
 private:
+    /** Take the next ring slot (the oldest line once full), move it to the end of the list, return its index */
+    int32 AppendItem();
+
+    /** Ring index of the most recent line, or INDEX_NONE */
+    int32 GetNewestIndex() const;
+
+    void FormatItem(UChatMessageItem& Item) const;
+
+    /** Push an item's text into whichever row shows it */
+    void RefreshRow(int32 RingIndex);
+
+    /** History ring; oldest at RingHead once it holds MaxMessages */
     UPROPERTY()
-    TArray<FChatMessage> Messages;
+    TArray<UChatMessageItem*> Ring;
+
+    /** MessageScrollBox rows, by ring index */
+    UPROPERTY()
+    TArray<UTextBlock*> ScrollRows;
+
+    int32 RingHead = 0;
+
+    /** Back to full opacity and restart the fade countdown */
+    void Unfade();
 
     float TimeSinceLastMessage = 0.0f;
     bool bFaded = false;
+    int32 UITickHandle = INDEX_NONE;
 };
@@ -5,16 +5,20 @@
 #include "Components/VerticalBox.h"
 #include "Components/HorizontalBox.h"
 #include "Components/ProgressBar.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UCraftingWidget::NativeConstruct()
 {
     Super::NativeConstruct();
 
     MaterialSlots.SetNum(MaxMaterialSlots);
+    SimilarityCache.Empty(FMath::Max(PreviewCacheSize, 1));
 
     if (CraftButton)
     {
@@ -33,6 +37,7 @@ void UCraftingWidget::SetRecipes(const TArray<FCraftingRecipeData>& Recipes)
 {
     AvailableRecipes = Recipes;
     SelectedRecipeIndex = -1;
+    SimilarityCache.Empty(FMath::Max(PreviewCacheSize, 1));
     RebuildRecipeList();
 }
 
@@ -65,6 +70,8 @@ void UCraftingWidget::AddRecipeFromJson(const FString& RecipeJson)
         }
     }
 
+    // Keys are by recipe name; a re-sent recipe may have new tags
+    SimilarityCache.Empty(FMath::Max(PreviewCacheSize, 1));
     AvailableRecipes.Add(Recipe);
     RebuildRecipeList();
 }
@@ -172,6 +179,7 @@ void UCraftingWidget::Close()
 
 void UCraftingWidget::RebuildRecipeList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Crafting_RebuildRecipeList);
     if (!RecipeListBox) return;
     RecipeListBox->ClearChildren();
 
@@ -287,6 +295,8 @@ void UCraftingWidget::UpdatePreview()
 {
     if (SelectedRecipeIndex < 0 || SelectedRecipeIndex >= AvailableRecipes.Num())
     {
+        LatestPreviewRequest->fetch_add(1);
+        PendingPreviewKey.Empty();
         CurrentPreview = FCraftResultPreview();
         if (CraftButton) CraftButton->SetIsEnabled(false);
         return;
@@ -301,6 +311,84 @@ void UCraftingWidget::UpdatePreview()
         if (MatSlot.bOccupied) PlacedCount++;
     }
 
+    if (PlacedCount == 0)
+    {
+        LatestPreviewRequest->fetch_add(1);
+        PendingPreviewKey.Empty();
+        ApplyPreview(Recipe, PlacedCount, 0.0f);
+        return;
+    }
+
+    const FString Key = MakePreviewKey();
+    if (const float* Cached = SimilarityCache.FindAndTouch(Key))
+    {
+        // Whatever is still in flight is for another combination
+        LatestPreviewRequest->fetch_add(1);
+        PendingPreviewKey.Empty();
+        ApplyPreview(Recipe, PlacedCount, *Cached);
+        return;
+    }
+
+    // Keep showing the last preview until the score lands, but don't allow crafting on it
+    CurrentPreview.bCanCraft = false;
+    if (CraftButton) CraftButton->SetIsEnabled(false);
+    if (Key != PendingPreviewKey)
+    {
+        RequestSimilarity(Key);
+    }
+}
+
+void UCraftingWidget::RequestSimilarity(const FString& Key)
+{
+    PendingPreviewKey = Key;
+    const uint32 Request = LatestPreviewRequest->fetch_add(1) + 1;
+
+    TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe> Latest = LatestPreviewRequest;
+    TWeakObjectPtr<UCraftingWidget> WeakThis(this);
+    UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [Latest, WeakThis, Key, Request, Recipe = AvailableRecipes[SelectedRecipeIndex], Slots = MaterialSlots]()
+        {
+            // Superseded before it started
+            if (Latest->load() != Request) return;
+
+            const float Similarity = ScoreSimilarity(Recipe, Slots);
+            AsyncTask(ENamedThreads::GameThread, [Latest, WeakThis, Key, Request, Similarity]()
+            {
+                UCraftingWidget* Widget = WeakThis.Get();
+                if (!Widget) return;
+
+                // A stale answer is still right for its own combination
+                Widget->SimilarityCache.Add(Key, Similarity);
+                if (Latest->load() == Request)
+                {
+                    Widget->PendingPreviewKey.Empty();
+                    Widget->UpdatePreview();
+                }
+            });
+        });
+}
+
+FString UCraftingWidget::MakePreviewKey() const
+{
+    TArray<FString> Materials;
+    for (const FCraftMaterialSlot& MatSlot : MaterialSlots)
+    {
+        if (!MatSlot.bOccupied) continue;
+
+        FString& Material = Materials.Emplace_GetRef(MatSlot.ItemName);
+        for (int32 i = 0; i < MatSlot.TagNames.Num() && i < MatSlot.TagValues.Num(); i++)
+        {
+            Material += FString::Printf(TEXT(";%s=%g"), *MatSlot.TagNames[i], MatSlot.TagValues[i]);
+        }
+    }
+    Materials.Sort();
+
+    const FCraftingRecipeData& Recipe = AvailableRecipes[SelectedRecipeIndex];
+    return Recipe.Name + TEXT("|") + FString::Join(Materials, TEXT("|"));
+}
+
+void UCraftingWidget::ApplyPreview(const FCraftingRecipeData& Recipe, int32 PlacedCount, float Similarity)
+{
     // Check requirements
     CurrentPreview.bCanCraft = true;
     CurrentPreview.FailReason.Empty();
@@ -319,8 +407,7 @@ void UCraftingWidget::UpdatePreview()
             Recipe.ShardCost, PlayerShards);
     }
 
-    // Calculate similarity
-    CurrentPreview.Similarity = CalculateSimilarity();
+    CurrentPreview.Similarity = Similarity;
 
     if (CurrentPreview.Similarity < 0.4f && PlacedCount >= Recipe.MaterialCount)
     {
@@ -397,16 +484,13 @@ void UCraftingWidget::UpdatePreview()
     }
 }
 
-float UCraftingWidget::CalculateSimilarity() const
+float UCraftingWidget::ScoreSimilarity(const FCraftingRecipeData& Recipe, const TArray<FCraftMaterialSlot>& Slots)
 {
-    if (SelectedRecipeIndex < 0 || SelectedRecipeIndex >= AvailableRecipes.Num()) return 0.0f;
-    const FCraftingRecipeData& Recipe = AvailableRecipes[SelectedRecipeIndex];
-
     // Combine material tags (average)
     TMap<FString, float> CombinedTags;
     int32 OccupiedCount = 0;
 
-    for (const FCraftMaterialSlot& MatSlot : MaterialSlots)
+    for (const FCraftMaterialSlot& MatSlot : Slots)
     {
         if (!MatSlot.bOccupied) continue;
         OccupiedCount++;
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Containers/LruCache.h"
+#include <atomic>
 #include "CraftingWidget.generated.h"
 
 class UScrollBox;
@@ -60,6 +62,12 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCraftingClosed);
 /**
  * Crafting UI: select recipe, place materials, preview result, craft.
  * Matches Rust economy::crafting system (semantic tag matching, quality from similarity).
+ *
+ * The tag match is scored on a worker and remembered per (recipe, sorted
+ * material set) in a small LRU, so cycling back to a combination shows its
+ * preview at once and dragging materials around never scores on the game
+ * thread. Only the latest request's result updates the preview; older ones
+ * are skipped if they haven't started and only cached if they have.
  */
 UCLASS()
 class TOWERGAME_API UCraftingWidget : public UUserWidget
@@ -113,12 +121,34 @@ protected:
 
     UPROPERTY(EditDefaultsOnly) int32 MaxMaterialSlots = 6;
 
+    /** Material combinations whose tag match is remembered */
+    UPROPERTY(EditDefaultsOnly) int32 PreviewCacheSize = 16;
+
+    /** Tag match by MakePreviewKey() */
+    TLruCache<FString, float> SimilarityCache;
+
+    /** Id of the newest scoring request; workers compare against it to drop stale ones */
+    TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe> LatestPreviewRequest = MakeShared<std::atomic<uint32>, ESPMode::ThreadSafe>(0u);
+    FString PendingPreviewKey;
+
     // --- Internal ---
     void RebuildRecipeList();
     void UpdateRecipeDetail();
     void UpdateMaterialSlots();
     void UpdatePreview();
-    float CalculateSimilarity() const;
+
+    /** Fill CurrentPreview from a tag match and show it */
+    void ApplyPreview(const FCraftingRecipeData& Recipe, int32 PlacedCount, float Similarity);
+
+    /** Score the current materials on a worker; UpdatePreview runs again when it lands */
+    void RequestSimilarity(const FString& Key);
+
+    /** Recipe name plus the placed materials, sorted so slot order doesn't matter */
+    FString MakePreviewKey() const;
+
+    /** Cosine similarity of the averaged material tags to the recipe's; thread-safe */
+    static float ScoreSimilarity(const FCraftingRecipeData& Recipe, const TArray<FCraftMaterialSlot>& Slots);
+
     FLinearColor GetCategoryColor(const FString& Category) const;
     FLinearColor GetRarityColor(const FString& Rarity) const;
 
@@ -4,14 +4,14 @@
 #include "Components/ActorComponent.h"
 #include "DamageNumberComponent.generated.h"
 
-class UWidgetComponent;
-
 /**
  * Spawns floating damage numbers above actors.
  * Supports different colors for damage types, crits, healing, etc.
  *
  * Usage: Attach to any actor that can take damage.
  * Call ShowDamage() to spawn a floating number that rises and fades.
+ * The numbers themselves live in UTowerDamageNumberSubsystem, which draws
+ * every actor's in one batched Slate layer; this component only styles them.
  */
 UCLASS(ClassGroup = (UI), meta = (BlueprintSpawnableComponent))
 class TOWERGAME_API UDamageNumberComponent : public UActorComponent
@@ -21,8 +21,6 @@ class TOWERGAME_API UDamageNumberComponent : public UActorComponent
 public:
     UDamageNumberComponent();
 
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
     /** Show a damage number above the owner */
     UFUNCTION(BlueprintCallable, Category = "DamageNumbers")
     void ShowDamage(float Amount, bool bIsCrit = false, bool bIsHealing = false);
@@ -57,22 +55,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DamageNumbers")
     float CritScale = 1.5f;
 
-    /** Max simultaneous numbers */
+    /** Max simultaneous numbers over this actor */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DamageNumbers")
     int32 MaxNumbers = 8;
 
 private:
-    struct FFloatingNumber
-    {
-        FString Text;
-        FLinearColor Color;
-        float Scale;
-        FVector WorldOffset;
-        float TimeRemaining;
-        float TotalTime;
-    };
-
-    TArray<FFloatingNumber> ActiveNumbers;
-
     void SpawnNumber(const FString& Text, FLinearColor Color, float Scale);
 };
@@ -0,0 +1,197 @@
+#include "DamageNumberSubsystem.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Widgets/SLeafWidget.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Fonts/FontMeasure.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+/** Draws every active number of one UTowerDamageNumberSubsystem in a single paint */
+class SDamageNumberLayer : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SDamageNumberLayer) {}
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, UTowerDamageNumberSubsystem* InSubsystem)
+    {
+        Subsystem = InSubsystem;
+        SetVisibility(EVisibility::HitTestInvisible);
+    }
+
+    virtual FVector2D ComputeDesiredSize(float) const override { return FVector2D::ZeroVector; }
+
+    virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+private:
+    TWeakObjectPtr<UTowerDamageNumberSubsystem> Subsystem;
+};
+
+int32 SDamageNumberLayer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    UTowerDamageNumberSubsystem* Numbers = Subsystem.Get();
+    UWorld* World = Numbers ? Numbers->GetWorld() : nullptr;
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    ULocalPlayer* LocalPlayer = PC ? PC->GetLocalPlayer() : nullptr;
+    if (!LocalPlayer || !LocalPlayer->ViewportClient || !LocalPlayer->ViewportClient->Viewport) return LayerId;
+    if (Numbers->GetNumActive() == 0) return LayerId;
+
+    // One view-projection for the whole batch
+    FSceneViewProjectionData Projection;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, Projection)) return LayerId;
+    const FMatrix ViewProjection = Projection.ComputeViewProjectionMatrix();
+    const FIntRect ViewRect = Projection.GetConstrainedViewRect();
+    const FVector2D PixelToLocal = AllottedGeometry.GetLocalSize()
+        / FVector2D(LocalPlayer->ViewportClient->Viewport->GetSizeXY()).ComponentMax(FVector2D(1.0, 1.0));
+
+    const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+    const FLinearColor Tint = InWidgetStyle.GetColorAndOpacityTint();
+    const double Now = World->GetTimeSeconds();
+
+    for (UTowerDamageNumberSubsystem::FDamageNumber& Num : Numbers->Numbers)
+    {
+        if (!Num.bActive) continue;
+
+        // 0 = just spawned, 1 = about to disappear
+        const float Progress = static_cast<float>((Now - Num.SpawnTime) / FMath::Max(Num.Style.Duration, KINDA_SMALL_NUMBER));
+        if (Progress >= 1.0f)
+        {
+            Num.bActive = false;
+            continue;
+        }
+
+        if (const AActor* Owner = Num.Owner.Get())
+        {
+            Num.Anchor = Owner->GetActorLocation();
+        }
+
+        // Rise, with a slight horizontal drift so stacked numbers separate
+        const float Drift = FMath::Sin(Progress * PI) * 20.0f * Num.Drift;
+        const FVector WorldPos = Num.Anchor + FVector(Num.OffsetX + Drift, 0.0f, Num.Style.FloatHeight * Progress);
+
+        FVector2D ScreenPos;
+        if (!FSceneView::ProjectWorldToScreen(WorldPos, ViewRect, ViewProjection, ScreenPos)) continue;
+
+        // Fade out in last 30%
+        const float Alpha = (Progress > 0.7f) ? (1.0f - Progress) / 0.3f : 1.0f;
+
+        // Start big, settle to normal, shrink at end. The font size stays per style and the
+        // animation is a render scale, so the glyph cache only sees a few sizes.
+        float AnimScale = 1.0f;
+        if (Progress < 0.1f)
+        {
+            AnimScale = 1.0f + (1.0f - Progress / 0.1f) * 0.5f; // Pop in
+        }
+        else if (Progress > 0.8f)
+        {
+            AnimScale = (1.0f - Progress) / 0.2f; // Shrink out
+        }
+        if (AnimScale <= KINDA_SMALL_NUMBER) continue;
+
+        FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Bold", FMath::RoundToInt32(Numbers->BaseFontSize * Num.Style.Scale));
+        Font.OutlineSettings.OutlineSize = 1;
+
+        const FVector2D TextSize = FontMeasure->Measure(Num.Text, Font);
+        const FVector2D Centre = ScreenPos * PixelToLocal;
+        const FVector2D TopLeft = Centre - TextSize * (0.5f * AnimScale);
+
+        FLinearColor Color = Num.Style.Color * Tint;
+        Color.A *= Alpha;
+
+        FSlateDrawElement::MakeText(OutDrawElements, LayerId,
+            AllottedGeometry.ToPaintGeometry(TextSize, FSlateLayoutTransform(AnimScale, TopLeft)),
+            Num.Text, Font, ESlateDrawEffect::None, Color);
+    }
+
+    return LayerId;
+}
+
+// ============ Subsystem ============
+
+void UTowerDamageNumberSubsystem::Deinitialize()
+{
+    if (Layer.IsValid())
+    {
+        if (UGameViewportClient* Viewport = GetWorld()->GetGameViewport())
+        {
+            Viewport->RemoveViewportWidgetContent(Layer.ToSharedRef());
+        }
+        Layer.Reset();
+    }
+    Super::Deinitialize();
+}
+
+bool UTowerDamageNumberSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UTowerDamageNumberSubsystem::EnsureLayer()
+{
+    if (Layer.IsValid()) return true;
+
+    UGameViewportClient* Viewport = GetWorld()->GetGameViewport();
+    if (!Viewport) return false;
+
+    // Under the HUD widgets, over the world
+    Layer = SNew(SDamageNumberLayer, this);
+    Viewport->AddViewportWidgetContent(Layer.ToSharedRef(), -1);
+    return true;
+}
+
+void UTowerDamageNumberSubsystem::Add(AActor* Owner, const FString& Text, const FDamageNumberStyle& Style, int32 MaxPerOwner)
+{
+    if (!Owner) return;
+
+    // The pause menu writes it, so it's read per number rather than cached
+    bool bShowDamageNumbers = true;
+    GConfig->GetBool(TEXT("TowerGame.Settings"), TEXT("ShowDamageNumbers"), bShowDamageNumbers, GGameIni);
+    if (!bShowDamageNumbers || !EnsureLayer()) return;
+
+    // The owner's oldest once it has its share up, else the ring's oldest
+    int32 Slot = INDEX_NONE;
+    int32 OwnerCount = 0;
+    for (int32 i = 0; i < MaxNumbers; i++)
+    {
+        const FDamageNumber& Num = Numbers[i];
+        if (!Num.bActive || Num.Owner.Get() != Owner) continue;
+
+        OwnerCount++;
+        if (Slot == INDEX_NONE || Num.SpawnTime < Numbers[Slot].SpawnTime)
+        {
+            Slot = i;
+        }
+    }
+    if (OwnerCount < FMath::Max(MaxPerOwner, 1))
+    {
+        Slot = Head;
+        Head = (Head + 1) % MaxNumbers;
+    }
+
+    FDamageNumber& Num = Numbers[Slot];
+    Num.Owner = Owner;
+    Num.Anchor = Owner->GetActorLocation();
+    Num.OffsetX = FMath::RandRange(-10.0f, 10.0f);
+    Num.Drift = static_cast<float>(static_cast<int32>(NumSpawned++ % 3) - 1);
+    Num.Text = Text; // Reuses the slot's buffer
+    Num.Style = Style;
+    Num.SpawnTime = GetWorld()->GetTimeSeconds();
+    Num.bActive = true;
+}
+
+int32 UTowerDamageNumberSubsystem::GetNumActive() const
+{
+    int32 Num = 0;
+    for (const FDamageNumber& Number : Numbers)
+    {
+        Num += Number.bActive ? 1 : 0;
+    }
+    return Num;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DamageNumberSubsystem.generated.h"
+
+class SDamageNumberLayer;
+
+/** One floating number's look and motion, as UDamageNumberComponent configures it */
+struct FDamageNumberStyle
+{
+    FLinearColor Color = FLinearColor::White;
+    float Scale = 1.0f;
+    float Duration = 1.2f;
+    float FloatHeight = 120.0f;
+};
+
+/**
+ * Every floating damage number in the world, drawn by one Slate leaf widget
+ * over the game viewport instead of a debug message per number per frame.
+ *
+ * Numbers live in a fixed ring of MaxNumbers slots: a new one takes the slot
+ * of the oldest, or of its owner's oldest once the owner has MaxPerOwner up,
+ * so nothing is allocated or shifted while a fight is on. The layer paints
+ * them all in one pass, projecting through a single view-projection matrix
+ * rather than a ProjectWorldLocationToScreen call each. Numbers age by world
+ * time, so nothing here ticks.
+ *
+ * Honours the ShowDamageNumbers setting from the pause menu.
+ */
+UCLASS()
+class TOWERGAME_API UTowerDamageNumberSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /** Float Text up from above Owner */
+    void Add(AActor* Owner, const FString& Text, const FDamageNumberStyle& Style, int32 MaxPerOwner);
+
+    int32 GetNumActive() const;
+
+    // ============ Config ============
+
+    /** Ring size: numbers on screen at once across all actors */
+    static constexpr int32 MaxNumbers = 64;
+
+    /** Font size of a number at scale 1 */
+    int32 BaseFontSize = 24;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    friend class SDamageNumberLayer;
+
+    struct FDamageNumber
+    {
+        TWeakObjectPtr<AActor> Owner;
+        /** Owner location when last seen, so a number outlives a destroyed owner */
+        FVector Anchor = FVector::ZeroVector;
+        float OffsetX = 0.0f;
+        /** -1, 0 or 1: which way the number drifts */
+        float Drift = 0.0f;
+        FString Text;
+        FDamageNumberStyle Style;
+        double SpawnTime = 0.0;
+        bool bActive = false;
+    };
+
+    /** Add the viewport layer on first use; false where there is no viewport (servers) */
+    bool EnsureLayer();
+
+    FDamageNumber Numbers[MaxNumbers];
+    int32 Head = 0;
+    uint32 NumSpawned = 0;
+
+    TSharedPtr<SDamageNumberLayer> Layer;
+};
@@ -20,23 +20,27 @@ void UDeathScreenWidget::NativeConstruct()
     SetVisibility(ESlateVisibility::Collapsed);
 }
 
-void UDeathScreenWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UDeathScreenWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UDeathScreenWidget::TickUI(float DeltaTime)
+{
     if (!bShowing) return;
 
     // Fade in effect
     if (FadeInTimer < 1.0f)
     {
-        FadeInTimer += InDeltaTime * 0.5f; // 2 second fade
+        FadeInTimer += DeltaTime * 0.5f; // 2 second fade
         SetRenderOpacity(FMath::Clamp(FadeInTimer, 0.0f, 1.0f));
     }
 
     // Cooldown timer
     if (CooldownTimer > 0.0f)
     {
-        CooldownTimer -= InDeltaTime;
+        CooldownTimer -= DeltaTime;
 
         if (RespawnCooldownBar)
         {
@@ -53,6 +57,11 @@ void UDeathScreenWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTi
             }
         }
     }
+
+    if (FadeInTimer >= 1.0f && CooldownTimer <= 0.0f)
+    {
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
+    }
 }
 
 void UDeathScreenWidget::ShowDeathScreen(int32 FloorReached, int32 MonstersSlain,
@@ -61,6 +70,7 @@ void UDeathScreenWidget::ShowDeathScreen(int32 FloorReached, int32 MonstersSlain
     bShowing = true;
     CooldownTimer = RespawnCooldown;
     FadeInTimer = 0.0f;
+    UTowerUITickSubsystem::Start(this, this, UITickHandle);
 
     SetVisibility(ESlateVisibility::Visible);
     SetRenderOpacity(0.0f); // Start transparent
@@ -147,6 +157,7 @@ void UDeathScreenWidget::ShowDeathScreen(int32 FloorReached, int32 MonstersSlain
 void UDeathScreenWidget::HideDeathScreen()
 {
     bShowing = false;
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
     SetVisibility(ESlateVisibility::Collapsed);
 
     APlayerController* PC = GetOwningPlayer();
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "TowerUITickSubsystem.h"
 #include "DeathScreenWidget.generated.h"
 
 class UTextBlock;
@@ -29,14 +30,17 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnReturnToLobby);
  * Respawn has a configurable cooldown (3s default) with progress bar.
  * Background fades to dark red.
  */
-UCLASS()
-class TOWERGAME_API UDeathScreenWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UDeathScreenWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Fade-in and respawn cooldown, while either is running */
+    virtual void TickUI(float DeltaTime) override;
 
     // ============ API ============
 
@@ -103,4 +107,5 @@ private:
     float CooldownTimer = 0.0f;
     float FadeInTimer = 0.0f;
     bool bShowing = false;
+    int32 UITickHandle = INDEX_NONE;
 };
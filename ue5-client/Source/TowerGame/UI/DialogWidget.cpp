@@ -13,13 +13,17 @@ void UDialogWidget::NativeConstruct()
     SetVisibility(ESlateVisibility::Collapsed);
 }
 
-void UDialogWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UDialogWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UDialogWidget::TickUI(float DeltaTime)
+{
     if (!bShowing || !bTypewriting) return;
 
-    TypewriterTimer += InDeltaTime;
+    TypewriterTimer += DeltaTime;
 
     int32 CharsToShow = FMath::FloorToInt(TypewriterTimer * TypewriterSpeed);
     if (CharsToShow > RevealedChars)
@@ -34,6 +38,7 @@ void UDialogWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
         if (RevealedChars >= FullText.Len())
         {
             bTypewriting = false;
+            UTowerUITickSubsystem::Stop(this, UITickHandle);
 
             // Show continue hint
             if (ContinueHintText)
@@ -52,6 +57,7 @@ void UDialogWidget::ShowNode(const FDialogNodeData& Node)
     FullText = Node.Text;
     RevealedChars = 0;
     TypewriterTimer = 0.0f;
+    UTowerUITickSubsystem::Start(this, this, UITickHandle);
 
     SetVisibility(ESlateVisibility::Visible);
 
@@ -126,6 +132,7 @@ void UDialogWidget::CloseDialog()
 {
     bShowing = false;
     bTypewriting = false;
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
     SetVisibility(ESlateVisibility::Collapsed);
 
     APlayerController* PC = GetOwningPlayer();
@@ -143,6 +150,7 @@ void UDialogWidget::SkipTypewriter()
     if (!bTypewriting) return;
 
     bTypewriting = false;
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
     RevealedChars = FullText.Len();
 
     if (DialogText)
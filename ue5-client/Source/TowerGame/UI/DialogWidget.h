@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "TowerUITickSubsystem.h"
 #include "DialogWidget.generated.h"
 
 class UTextBlock;
@@ -78,14 +79,17 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnDialogClosed);
  * - Grayed out choices that don't meet requirements
  * - Requirement hints on unavailable choices
  */
-UCLASS()
-class TOWERGAME_API UDialogWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UDialogWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Typewriter reveal, while a line is being typed */
+    virtual void TickUI(float DeltaTime) override;
 
     // ============ API ============
 
@@ -154,4 +158,5 @@ private:
     float TypewriterTimer = 0.0f;
     bool bShowing = false;
     bool bTypewriting = false;
+    int32 UITickHandle = INDEX_NONE;
 };
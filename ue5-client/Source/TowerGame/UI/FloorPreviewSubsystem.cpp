@@ -0,0 +1,357 @@
+#include "FloorPreviewSubsystem.h"
+#include "MinimapComponent.h"
+#include "Core/TowerGameSubsystem.h"
+#include "Core/FloorDiskCache.h"
+#include "Bridge/ProceduralCoreBridge.h"
+#include "Rendering/ProceduralFloorRenderer.h"
+#include "Engine/Texture2D.h"
+#include "Async/Async.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    /** Which tile wins a texel several tiles fall in: features over walls over floor */
+    int32 GetTilePriority(uint8 Tile)
+    {
+        switch (static_cast<ETowerTileType>(Tile))
+        {
+        case ETowerTileType::Empty:      return 0;
+        case ETowerTileType::Floor:
+        case ETowerTileType::Spawner:    return 1;
+        case ETowerTileType::Wall:       return 2;
+        case ETowerTileType::Door:
+        case ETowerTileType::Trap:
+        case ETowerTileType::WindColumn:
+        case ETowerTileType::VoidPit:    return 3;
+        default:                         return 4;
+        }
+    }
+
+    /** Tint of a room's floor; Combat rooms keep the plain floor colour */
+    bool GetRoomTint(EFloorRoomType Type, FColor& OutTint)
+    {
+        switch (Type)
+        {
+        case EFloorRoomType::Treasure: OutTint = FColor(240, 200, 60); return true;
+        case EFloorRoomType::Puzzle:   OutTint = FColor(80, 170, 230); return true;
+        case EFloorRoomType::Rest:     OutTint = FColor(90, 200, 110); return true;
+        case EFloorRoomType::Boss:     OutTint = FColor(210, 50, 50); return true;
+        case EFloorRoomType::Entrance: OutTint = FColor(80, 140, 240); return true;
+        case EFloorRoomType::Exit:     OutTint = FColor(120, 230, 200); return true;
+        default:                       return false;
+        }
+    }
+
+    FColor Blend(const FColor& A, const FColor& B)
+    {
+        return FColor((A.R + B.R) / 2, (A.G + B.G) / 2, (A.B + B.B) / 2, A.A);
+    }
+}
+
+void UTowerFloorPreviewSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    UTowerGameSubsystem* Game = Collection.InitializeDependency<UTowerGameSubsystem>();
+    if (!Game) return;
+    TowerGame = Game;
+    AtlasSeed = Game->TowerSeed;
+
+    // Requests made before the core has booted wait in the queue
+    Game->WhenRustCoreBooted(FSimpleDelegate::CreateWeakLambda(this, [this]()
+    {
+        bCoreBooted = true;
+        StartJob();
+    }));
+}
+
+void UTowerFloorPreviewSubsystem::Deinitialize()
+{
+    // The worker calls into the bridge, which UTowerGameSubsystem shuts down after us
+    Job.Wait();
+
+    Atlas = nullptr;
+    SlotFloors.Empty();
+    SlotLastUsed.Empty();
+    SlotByFloor.Empty();
+    Queue.Empty();
+    Pending.Empty();
+    Super::Deinitialize();
+}
+
+// ============ Requests ============
+
+void UTowerFloorPreviewSubsystem::RequestPreview(int32 FloorId)
+{
+    if (FloorId < 1) return;
+
+    CheckSeed();
+    if (SlotByFloor.Contains(FloorId) || Pending.Contains(FloorId)) return;
+
+    Pending.Add(FloorId);
+    Queue.Add(FloorId);
+    StartJob();
+}
+
+bool UTowerFloorPreviewSubsystem::GetPreview(int32 FloorId, UTexture2D*& OutAtlas, FBox2f& OutUV)
+{
+    CheckSeed();
+    const int32* Slot = SlotByFloor.Find(FloorId);
+    if (!Slot || !Atlas) return false;
+
+    SlotLastUsed[*Slot] = ++UseCounter;
+
+    const float Cell = 1.0f / AtlasColumns;
+    const FVector2f Min((*Slot % AtlasColumns) * Cell, (*Slot / AtlasColumns) * Cell);
+    OutAtlas = Atlas;
+    OutUV = FBox2f(Min, Min + FVector2f(Cell, Cell));
+    return true;
+}
+
+void UTowerFloorPreviewSubsystem::CheckSeed()
+{
+    const UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || Game->TowerSeed == AtlasSeed) return;
+
+    // Same floor ids, different floors; a job still out for the old seed is dropped when it lands
+    AtlasSeed = Game->TowerSeed;
+    SlotByFloor.Reset();
+    for (int32 i = 0; i < SlotFloors.Num(); ++i)
+    {
+        SlotFloors[i] = INDEX_NONE;
+        SlotLastUsed[i] = 0;
+    }
+}
+
+// ============ Job ============
+
+void UTowerFloorPreviewSubsystem::StartJob()
+{
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || !bCoreBooted || bJobRunning || Queue.Num() == 0) return;
+
+    if (!Game->IsRustCoreReady())
+    {
+        // No core, no layouts: nothing queued can be drawn
+        for (const int32 FloorId : Queue)
+        {
+            Pending.Remove(FloorId);
+        }
+        Queue.Reset();
+        return;
+    }
+
+    FProceduralCoreBridge* Bridge = Game->GetBridge();
+    FFloorDiskCache* Cache = Game->GetFloorCache();
+    const int64 Seed = AtlasSeed;
+    TWeakObjectPtr<UTowerFloorPreviewSubsystem> WeakThis(this);
+
+    bJobRunning = true;
+    Job = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Bridge, Cache, Seed, WeakThis, Floors = MoveTemp(Queue)]()
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloorPreview_Job);
+
+        TArray<FReadyPreview> Ready;
+        Ready.SetNum(Floors.Num());
+        for (int32 i = 0; i < Floors.Num(); ++i)
+        {
+            FReadyPreview& Preview = Ready[i];
+            Preview.FloorId = Floors[i];
+
+            // Hash 0 means the DLL lacks get_floor_hash; don't key the cache on it
+            const uint64 FloorHash = Cache ? Bridge->GetFloorHash(static_cast<uint64>(Seed), static_cast<uint32>(Preview.FloorId)) : 0;
+            if (FloorHash != 0 && Cache->LoadPreview(FloorHash, PreviewSize, Preview.Pixels))
+            {
+                continue;
+            }
+
+            FFloorLayoutData Layout;
+            if (!Bridge->GenerateFloorLayoutData(static_cast<uint64>(Seed), static_cast<uint32>(Preview.FloorId), Layout)
+                || !Layout.IsValid())
+            {
+                continue;
+            }
+
+            Rasterize(Layout, PreviewSize, Preview.Pixels);
+            if (FloorHash != 0)
+            {
+                Cache->StorePreview(FloorHash, PreviewSize, Preview.Pixels);
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Seed, Ready = MoveTemp(Ready)]() mutable
+        {
+            UTowerFloorPreviewSubsystem* This = WeakThis.Get();
+            if (!This) return;
+
+            This->bJobRunning = false;
+            for (const FReadyPreview& Preview : Ready)
+            {
+                This->Pending.Remove(Preview.FloorId);
+            }
+
+            This->CheckSeed();
+            if (Seed == This->AtlasSeed)
+            {
+                This->Upload(Ready);
+            }
+
+            // Whatever was requested while this job ran
+            This->StartJob();
+        });
+    });
+    Queue.Reset();
+}
+
+// ============ Atlas ============
+
+bool UTowerFloorPreviewSubsystem::EnsureAtlas()
+{
+    if (Atlas) return true;
+
+    const int32 Extent = PreviewSize * AtlasColumns;
+    Atlas = UTexture2D::CreateTransient(Extent, Extent, PF_B8G8R8A8);
+    if (!Atlas) return false;
+
+    Atlas->Filter = TF_Nearest;
+    Atlas->SRGB = true;
+    Atlas->UpdateResource();
+
+    SlotFloors.Init(INDEX_NONE, AtlasColumns * AtlasColumns);
+    SlotLastUsed.Init(0, AtlasColumns * AtlasColumns);
+    return true;
+}
+
+int32 UTowerFloorPreviewSubsystem::AcquireSlot(int32 FloorId)
+{
+    // A free slot, else the one shown longest ago
+    int32 Slot = 0;
+    for (int32 i = 0; i < SlotFloors.Num(); ++i)
+    {
+        if (SlotFloors[i] == INDEX_NONE)
+        {
+            Slot = i;
+            break;
+        }
+        if (SlotLastUsed[i] < SlotLastUsed[Slot])
+        {
+            Slot = i;
+        }
+    }
+
+    if (SlotFloors[Slot] != INDEX_NONE)
+    {
+        SlotByFloor.Remove(SlotFloors[Slot]);
+    }
+    SlotFloors[Slot] = FloorId;
+    SlotLastUsed[Slot] = ++UseCounter;
+    SlotByFloor.Add(FloorId, Slot);
+    return Slot;
+}
+
+void UTowerFloorPreviewSubsystem::Upload(TArray<FReadyPreview>& Ready)
+{
+    Ready.RemoveAll([](const FReadyPreview& Preview) { return Preview.Pixels.Num() != PreviewSize * PreviewSize; });
+    // More than the atlas holds would evict its own newest entries; keep the last ones asked for
+    if (Ready.Num() > AtlasColumns * AtlasColumns)
+    {
+        Ready.RemoveAt(0, Ready.Num() - AtlasColumns * AtlasColumns);
+    }
+    if (Ready.Num() == 0 || !EnsureAtlas()) return;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloorPreview_Upload);
+
+    // Every preview of the job stacked in one buffer, one region each, one upload
+    const int32 Pitch = PreviewSize * sizeof(FColor);
+    const int32 PreviewBytes = Pitch * PreviewSize;
+    uint8* Data = new uint8[PreviewBytes * Ready.Num()];
+    FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[Ready.Num()];
+    for (int32 i = 0; i < Ready.Num(); ++i)
+    {
+        const int32 Slot = AcquireSlot(Ready[i].FloorId);
+        FMemory::Memcpy(Data + i * PreviewBytes, Ready[i].Pixels.GetData(), PreviewBytes);
+        Regions[i] = FUpdateTextureRegion2D((Slot % AtlasColumns) * PreviewSize, (Slot / AtlasColumns) * PreviewSize,
+            0, i * PreviewSize, PreviewSize, PreviewSize);
+    }
+
+    Atlas->UpdateTextureRegions(0, Ready.Num(), Regions, Pitch, sizeof(FColor), Data,
+        [](uint8* SrcData, const FUpdateTextureRegion2D* SrcRegions)
+        {
+            delete[] SrcData;
+            delete[] SrcRegions;
+        });
+
+    for (const FReadyPreview& Preview : Ready)
+    {
+        OnPreviewReady.Broadcast(Preview.FloorId);
+    }
+}
+
+// ============ Raster ============
+
+void UTowerFloorPreviewSubsystem::Rasterize(const FFloorLayoutData& Layout, int32 Size, TArray<FColor>& OutPixels)
+{
+    OutPixels.Init(FColor::Transparent, Size * Size);
+    if (!Layout.IsValid() || Size <= 0) return;
+
+    // Tiles per texel along the longer side; the shorter one is centred
+    const float TilesPerTexel = static_cast<float>(FMath::Max(Layout.Width, Layout.Height)) / Size;
+    const float OffsetX = (Size - Layout.Width / TilesPerTexel) * 0.5f;
+    const float OffsetY = (Size - Layout.Height / TilesPerTexel) * 0.5f;
+
+    for (int32 PY = 0; PY < Size; ++PY)
+    {
+        const int32 Y0 = FMath::FloorToInt32((PY - OffsetY) * TilesPerTexel);
+        const int32 Y1 = FMath::Max(FMath::CeilToInt32((PY + 1 - OffsetY) * TilesPerTexel), Y0 + 1);
+        if (Y1 <= 0 || Y0 >= Layout.Height) continue;
+
+        for (int32 PX = 0; PX < Size; ++PX)
+        {
+            const int32 X0 = FMath::FloorToInt32((PX - OffsetX) * TilesPerTexel);
+            const int32 X1 = FMath::Max(FMath::CeilToInt32((PX + 1 - OffsetX) * TilesPerTexel), X0 + 1);
+            if (X1 <= 0 || X0 >= Layout.Width) continue;
+
+            // The most telling tile under the texel, so thin walls and chests survive the downscale
+            uint8 Best = 0;
+            int32 BestPriority = -1;
+            for (int32 Y = FMath::Max(Y0, 0); Y < FMath::Min(Y1, Layout.Height); ++Y)
+            {
+                for (int32 X = FMath::Max(X0, 0); X < FMath::Min(X1, Layout.Width); ++X)
+                {
+                    const uint8 Tile = Layout.GetTile(X, Y);
+                    const int32 Priority = GetTilePriority(Tile);
+                    if (Priority > BestPriority)
+                    {
+                        Best = Tile;
+                        BestPriority = Priority;
+                    }
+                }
+            }
+            OutPixels[PY * Size + PX] = UMinimapComponent::GetTileColor(static_cast<ETowerTileType>(Best));
+        }
+    }
+
+    // Room purpose as a tint over its floor texels
+    const FColor FloorColor = UMinimapComponent::GetTileColor(ETowerTileType::Floor);
+    for (const FFloorLayoutRoom& Room : Layout.Rooms)
+    {
+        FColor Tint;
+        if (!GetRoomTint(Room.RoomType, Tint)) continue;
+
+        const int32 MinX = FMath::Clamp(FMath::FloorToInt32(Room.X / TilesPerTexel + OffsetX), 0, Size);
+        const int32 MinY = FMath::Clamp(FMath::FloorToInt32(Room.Y / TilesPerTexel + OffsetY), 0, Size);
+        const int32 MaxX = FMath::Clamp(FMath::CeilToInt32((Room.X + Room.Width) / TilesPerTexel + OffsetX), 0, Size);
+        const int32 MaxY = FMath::Clamp(FMath::CeilToInt32((Room.Y + Room.Height) / TilesPerTexel + OffsetY), 0, Size);
+        for (int32 PY = MinY; PY < MaxY; ++PY)
+        {
+            for (int32 PX = MinX; PX < MaxX; ++PX)
+            {
+                FColor& Pixel = OutPixels[PY * Size + PX];
+                if (Pixel == FloorColor)
+                {
+                    Pixel = Blend(FloorColor, Tint);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "FloorPreviewSubsystem.generated.h"
+
+class UTexture2D;
+class UTowerGameSubsystem;
+struct FFloorLayoutData;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFloorPreviewReady, int32 /*FloorId*/);
+
+/**
+ * Map previews of the tower's floors for UTowerMapWidget: each floor's tile
+ * grid and rooms drawn PreviewSize texels square on the CPU and packed into
+ * one atlas texture, so showing a floor needs no scene capture.
+ *
+ * RequestPreview queues floors. A queue goes to a worker as one job, which
+ * reads each preview from the floor cache (FFloorDiskCache::LoadPreview) or
+ * generates the layout, rasterizes it and stores it there. The job's previews
+ * are uploaded together on the game thread, one UpdateTextureRegions call per
+ * job. The atlas holds AtlasColumns x AtlasColumns previews; the floor shown
+ * least recently gives up its slot. A new tower seed empties it.
+ *
+ * Game thread only (jobs only rasterize; they install on the game thread).
+ */
+UCLASS()
+class TOWERGAME_API UTowerFloorPreviewSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    static constexpr int32 PreviewSize = 64;
+    static constexpr int32 AtlasColumns = 8;
+
+    /** Have FloorId's preview made if it isn't in the atlas; OnPreviewReady says when it is */
+    void RequestPreview(int32 FloorId);
+
+    /** The atlas and FloorId's rectangle in it (UV), if uploaded; counts as a use */
+    bool GetPreview(int32 FloorId, UTexture2D*& OutAtlas, FBox2f& OutUV);
+
+    bool HasPreview(int32 FloorId) const { return SlotByFloor.Contains(FloorId); }
+
+    /** Broadcast per floor once its preview is in the atlas */
+    FOnFloorPreviewReady OnPreviewReady;
+
+    /** Draw Layout into Size x Size texels, letterboxed, tiles coloured as the minimap; any thread */
+    static void Rasterize(const FFloorLayoutData& Layout, int32 Size, TArray<FColor>& OutPixels);
+
+private:
+    struct FReadyPreview
+    {
+        int32 FloorId = 0;
+        /** Empty if the floor couldn't be generated */
+        TArray<FColor> Pixels;
+    };
+
+    /** Send the queued floors to a worker, unless a job is already out */
+    void StartJob();
+
+    /** Copy a finished job's previews into the atlas in one upload */
+    void Upload(TArray<FReadyPreview>& Ready);
+
+    bool EnsureAtlas();
+    int32 AcquireSlot(int32 FloorId);
+
+    /** Drop every preview if the tower seed has changed since they were made */
+    void CheckSeed();
+
+    TWeakObjectPtr<UTowerGameSubsystem> TowerGame;
+
+    UPROPERTY()
+    UTexture2D* Atlas = nullptr;
+
+    /** FloorId in each atlas slot (INDEX_NONE = free), and when it was last shown */
+    TArray<int32> SlotFloors;
+    TArray<uint64> SlotLastUsed;
+    TMap<int32, int32> SlotByFloor;
+    uint64 UseCounter = 0;
+
+    /** Tower seed the atlas and the running job are for */
+    int64 AtlasSeed = 0;
+
+    /** Floors waiting for the next job, and every floor queued or in a job */
+    TArray<int32> Queue;
+    TSet<int32> Pending;
+
+    UE::Tasks::FTask Job;
+    bool bJobRunning = false;
+
+    /** Set once the core's boot load is done; IsRustCoreReady would block before then */
+    bool bCoreBooted = false;
+};
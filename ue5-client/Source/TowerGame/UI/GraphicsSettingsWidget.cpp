@@ -6,6 +6,7 @@
 #include "Components/CheckBox.h"
 #include "GameFramework/GameUserSettings.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Rendering/PerfScalerSubsystem.h"
 
 void UGraphicsSettingsWidget::NativeConstruct()
 {
@@ -70,6 +71,12 @@ void UGraphicsSettingsWidget::ApplySettings()
         GameSettings->SaveSettings();
     }
 
+    // Render scale goes through the scaler, which owns r.ScreenPercentage while it is stepped down
+    if (UTowerPerfScalerSubsystem* Scaler = GetWorld() ? GetWorld()->GetSubsystem<UTowerPerfScalerSubsystem>() : nullptr)
+    {
+        Scaler->Configure(CurrentSettings.bDynamicQuality, CurrentSettings.FPSLimit, CurrentSettings.RenderScale);
+    }
+
     OnApplied.Broadcast(CurrentSettings);
     UE_LOG(LogTemp, Log, TEXT("Graphics settings applied: %dx%d, FPS=%d, VSync=%d"),
         CurrentSettings.Resolution.X, CurrentSettings.Resolution.Y,
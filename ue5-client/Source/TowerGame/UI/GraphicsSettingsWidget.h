@@ -47,6 +47,9 @@ struct FGraphicsSettings
     UPROPERTY(BlueprintReadWrite) bool bCelShading = true;
     UPROPERTY(BlueprintReadWrite) bool bAnimeBloom = true;
     UPROPERTY(BlueprintReadWrite) float RenderScale = 100.0f;  // 50-200%
+
+    // Step quality down while frames run over the FPS limit (UTowerPerfScalerSubsystem)
+    UPROPERTY(BlueprintReadWrite) bool bDynamicQuality = true;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGraphicsApplied, const FGraphicsSettings&, Settings);
@@ -1,9 +1,11 @@
 #include "GuildWidget.h"
+#include "KeyedWidgetRows.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
 #include "Components/ScrollBox.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UGuildWidget::NativeConstruct()
 {
@@ -112,6 +114,8 @@ void UGuildWidget::SelectMember(const FString& UserId)
     // Update button states based on my rank vs selected member's rank
     if (KickButton) KickButton->SetIsEnabled(CanKick());
     if (PromoteButton) PromoteButton->SetIsEnabled(CanPromote());
+
+    UpdateMemberRows();
 }
 
 void UGuildWidget::InvitePlayer(const FString& PlayerName)
@@ -154,6 +158,7 @@ bool UGuildWidget::CanPromote() const { return MyRank >= EGuildRank::ViceLeader;
 
 void UGuildWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Guild_RebuildDisplay);
     if (GuildNameText)
         GuildNameText->SetText(FText::FromString(GuildData.Name));
     if (GuildTagText)
@@ -172,6 +177,42 @@ void UGuildWidget::RebuildDisplay()
     if (InviteButton) InviteButton->SetIsEnabled(CanInvite());
     if (KickButton) KickButton->SetIsEnabled(CanKick());
     if (PromoteButton) PromoteButton->SetIsEnabled(CanPromote());
+
+    UpdateMemberRows();
+}
+
+void UGuildWidget::UpdateMemberRows()
+{
+    if (!MemberListBox) return;
+
+    MemberRows.Init(this, MemberListBox);
+    MemberRows.BeginUpdate();
+
+    for (const FGuildMemberDisplay& Member : GuildData.Members)
+    {
+        bool bCreated = false;
+        UTextBlock* Row = MemberRows.Row<UTextBlock>(Member.UserId, bCreated);
+        if (bCreated)
+        {
+            FSlateFontInfo Font = Row->GetFont();
+            Font.Size = 11;
+            Row->SetFont(Font);
+        }
+
+        const TCHAR* Marker = Member.UserId == SelectedMemberId ? TEXT("> ") : TEXT("  ");
+        FKeyedWidgetRows::SetText(Row, FString::Printf(TEXT("%s%s  %s"), Marker, *Member.Name, *GetRankName(Member.Rank)));
+
+        // Offline members are dimmed
+        FLinearColor Color = GetRankColor(Member.Rank);
+        if (!Member.bOnline)
+        {
+            Color *= 0.5f;
+            Color.A = 1.0f;
+        }
+        FKeyedWidgetRows::SetColor(Row, Color);
+    }
+
+    MemberRows.EndUpdate();
 }
 
 FString UGuildWidget::GetRankName(EGuildRank Rank) const
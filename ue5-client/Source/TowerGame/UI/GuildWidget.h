@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
 #include "GuildWidget.generated.h"
 
 class UTextBlock;
@@ -63,6 +64,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMemberAction, const FString&, Use
  * Guild management widget.
  * Member list, rank management, guild info, MOTD.
  * Mirrors Rust social::Guild struct.
+ * Member rows are kept by user ID and recycled (FKeyedWidgetRows), so a
+ * roster reload only touches the members that changed.
  */
 UCLASS()
 class TOWERGAME_API UGuildWidget : public UUserWidget
@@ -111,7 +114,11 @@ protected:
     EGuildRank MyRank = EGuildRank::Recruit;
     FString SelectedMemberId;
 
+    UPROPERTY()
+    FKeyedWidgetRows MemberRows;
+
     void RebuildDisplay();
+    void UpdateMemberRows();
     FString GetRankName(EGuildRank Rank) const;
     FLinearColor GetRankColor(EGuildRank Rank) const;
 
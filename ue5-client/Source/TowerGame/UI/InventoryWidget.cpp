@@ -1,4 +1,5 @@
 #include "InventoryWidget.h"
+#include "Core/ItemCatalog.h"
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
@@ -7,6 +8,134 @@
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    // Filter mask layout: a bit per category in the low byte, a bit per rarity in the next
+    const TCHAR* const InventoryCategories[] = {
+        TEXT("CombatResource"), TEXT("Material"), TEXT("Consumable"),
+        TEXT("Equipment"), TEXT("Currency"), TEXT("EchoFragment"),
+    };
+    const TCHAR* const InventoryRarities[] = {
+        TEXT("Common"), TEXT("Uncommon"), TEXT("Rare"), TEXT("Epic"), TEXT("Legendary"), TEXT("Mythic"),
+    };
+    constexpr int32 NumCategories = UE_ARRAY_COUNT(InventoryCategories);
+    constexpr int32 NumRarities = UE_ARRAY_COUNT(InventoryRarities);
+    constexpr uint32 CategoryBits = 0x00FF;
+    constexpr uint32 RarityBits = 0xFF00;
+    constexpr int32 OtherCategory = 7;
+
+    int32 GetCategoryIndex(const FString& Category)
+    {
+        for (int32 i = 0; i < NumCategories; i++)
+        {
+            if (Category == InventoryCategories[i]) return i;
+        }
+        return OtherCategory;
+    }
+
+    /** Common is 0; unknown rarities count as Common */
+    int32 GetRarityIndex(const FString& Rarity)
+    {
+        for (int32 i = 0; i < NumRarities; i++)
+        {
+            if (Rarity == InventoryRarities[i]) return i;
+        }
+        return 0;
+    }
+}
+
+// ============ FInventoryItem ============
+
+FString FInventoryItem::GetItemName() const
+{
+    return IsCataloged() ? FTowerItemCatalog::Get().GetName(CatalogId) : ItemName;
+}
+
+FString FInventoryItem::GetCategoryName() const
+{
+    return IsCataloged() ? FString(FTowerItemCatalog::Get().GetCategoryName(CatalogId)) : Category;
+}
+
+TArray<TPair<FString, float>> FInventoryItem::GetSemanticTags() const
+{
+    TArray<TPair<FString, float>> Result;
+    if (IsCataloged())
+    {
+        Result.Reserve(TagNames.Num());
+        for (int32 i = 0; i < TagNames.Num() && i < TagValues.Num(); i++)
+        {
+            Result.Emplace(TagNames[i].ToString(), TagValues[i]);
+        }
+        return Result;
+    }
+
+    if (LootJson.IsEmpty()) return Result;
+
+    TSharedPtr<FJsonObject> Json;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LootJson);
+    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid()) return Result;
+
+    const TArray<TSharedPtr<FJsonValue>>* Tags;
+    if (Json->TryGetArrayField(TEXT("semantic_tags"), Tags))
+    {
+        for (const TSharedPtr<FJsonValue>& TagVal : *Tags)
+        {
+            const TArray<TSharedPtr<FJsonValue>>& TagPair = TagVal->AsArray();
+            if (TagPair.Num() >= 2)
+            {
+                Result.Emplace(TagPair[0]->AsString(), static_cast<float>(TagPair[1]->AsNumber()));
+            }
+        }
+    }
+    return Result;
+}
+
+bool FInventoryItem::FromLootJson(const FString& InLootJson, FInventoryItem& OutItem)
+{
+    TSharedPtr<FJsonObject> Json;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InLootJson);
+    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+    {
+        return false;
+    }
+
+    OutItem = FInventoryItem();
+    const FString Name = Json->GetStringField(TEXT("name"));
+    OutItem.Rarity = Json->HasField(TEXT("rarity")) ? Json->GetStringField(TEXT("rarity")) : TEXT("Common");
+    OutItem.Quantity = Json->HasField(TEXT("quantity")) ? Json->GetIntegerField(TEXT("quantity")) : 1;
+
+    OutItem.CatalogId = FTowerItemCatalog::Get().FindId(Name);
+    if (!OutItem.IsCataloged())
+    {
+        OutItem.ItemName = Name;
+        OutItem.Category = Json->HasField(TEXT("category")) ? Json->GetStringField(TEXT("category")) : TEXT("Unknown");
+        OutItem.LootJson = InLootJson;
+        return true;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Tags;
+    if (Json->TryGetArrayField(TEXT("semantic_tags"), Tags))
+    {
+        OutItem.TagNames.Reserve(Tags->Num());
+        OutItem.TagValues.Reserve(Tags->Num());
+        for (const TSharedPtr<FJsonValue>& TagVal : *Tags)
+        {
+            const TArray<TSharedPtr<FJsonValue>>& TagPair = TagVal->AsArray();
+            if (TagPair.Num() >= 2)
+            {
+                OutItem.TagNames.Add(FName(*TagPair[0]->AsString()));
+                OutItem.TagValues.Add(static_cast<float>(TagPair[1]->AsNumber()));
+            }
+        }
+    }
+    return true;
+}
+
+// ============ UInventoryWidget ============
 
 void UInventoryWidget::NativeConstruct()
 {
@@ -21,6 +150,11 @@ void UInventoryWidget::NativeConstruct()
         DropButton->OnClicked.AddDynamic(this, &UInventoryWidget::OnDropClicked);
     }
 
+    if (ItemScrollBox)
+    {
+        SlotRows.Init(this, ItemScrollBox);
+    }
+
     RebuildGrid();
     UpdateDetailPanel();
 }
@@ -28,57 +162,62 @@ void UInventoryWidget::NativeConstruct()
 void UInventoryWidget::AddItem(const FInventoryItem& Item)
 {
     // Currency items go directly to counters
-    if (Item.Category == TEXT("Currency"))
+    if (Item.GetCategoryName() == TEXT("Currency"))
     {
-        if (Item.ItemName.Contains(TEXT("Shard")))
+        const FString Name = Item.GetItemName();
+        if (Name.Contains(TEXT("Shard")))
         {
             TowerShards += Item.Quantity;
         }
-        else if (Item.ItemName.Contains(TEXT("Echo")) || Item.ItemName.Contains(TEXT("Fragment")))
+        else if (Name.Contains(TEXT("Echo")) || Name.Contains(TEXT("Fragment")))
         {
             EchoFragments += Item.Quantity;
         }
 
-        // Update currency display
-        if (ShardsText)
-        {
-            ShardsText->SetText(FText::AsNumber(TowerShards));
-        }
-        if (FragmentsText)
-        {
-            FragmentsText->SetText(FText::AsNumber(EchoFragments));
-        }
+        MarkGridDirty();
         return;
     }
 
     // Stackable check — same name+rarity
-    for (FInventoryItem& Existing : Items)
+    if (const int32* Existing = StackIndex.Find(MakeStackKey(Item)))
     {
-        if (Existing.ItemName == Item.ItemName && Existing.Rarity == Item.Rarity)
-        {
-            Existing.Quantity += Item.Quantity;
-            RebuildGrid();
-            return;
-        }
+        Items[*Existing].Quantity += Item.Quantity;
+        MarkGridDirty();
+        return;
     }
 
     // New item slot
     if (Items.Num() < MaxSlots)
     {
-        Items.Add(Item);
-        RebuildGrid();
+        AddSlot(Item);
+        MarkGridDirty();
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("Inventory full! Cannot add %s"), *Item.ItemName);
+        UE_LOG(LogTemp, Warning, TEXT("Inventory full! Cannot add %s"), *Item.GetItemName());
     }
 }
 
+void UInventoryWidget::AddSlot(const FInventoryItem& Item)
+{
+    const int32 Index = Items.Add(Item);
+    ItemStackKeys.Add(MakeStackKey(Item));
+    ItemFilterMasks.Add(MakeFilterMask(Item));
+    ItemSerials.Add(NextSerial++);
+    ItemSortKeys.Add(MakeSortKey(Index));
+    StackIndex.Add(ItemStackKeys[Index], Index);
+}
+
 void UInventoryWidget::RemoveItem(int32 Index)
 {
     if (Items.IsValidIndex(Index))
     {
         Items.RemoveAt(Index);
+        ItemStackKeys.RemoveAt(Index);
+        ItemFilterMasks.RemoveAt(Index);
+        ItemSerials.RemoveAt(Index);
+        ItemSortKeys.RemoveAt(Index);
+        ReindexStacks();
 
         if (SelectedIndex == Index)
         {
@@ -89,64 +228,113 @@ void UInventoryWidget::RemoveItem(int32 Index)
             SelectedIndex--;
         }
 
-        RebuildGrid();
+        MarkGridDirty();
         UpdateDetailPanel();
     }
 }
 
 void UInventoryWidget::AddItemFromJson(const FString& LootJson)
 {
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LootJson);
-
-    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
+    FInventoryItem Item;
+    if (!FInventoryItem::FromLootJson(LootJson, Item))
     {
         UE_LOG(LogTemp, Warning, TEXT("Failed to parse loot JSON"));
         return;
     }
 
-    FInventoryItem Item;
-    Item.ItemName = Json->GetStringField(TEXT("name"));
-    Item.Category = Json->GetStringField(TEXT("category"));
-    Item.Rarity = Json->GetStringField(TEXT("rarity"));
-    Item.Quantity = Json->GetIntegerField(TEXT("quantity"));
-    Item.LootJson = LootJson;
-
     AddItem(Item);
 }
 
-void UInventoryWidget::RebuildGrid()
+void UInventoryWidget::ReindexStacks()
 {
-    if (!ItemScrollBox) return;
+    StackIndex.Reset();
+    for (int32 i = 0; i < ItemStackKeys.Num(); i++)
+    {
+        StackIndex.Add(ItemStackKeys[i], i);
+    }
+}
 
-    ItemScrollBox->ClearChildren();
+FString UInventoryWidget::MakeStackKey(const FInventoryItem& Item)
+{
+    if (Item.IsCataloged())
+    {
+        return FString::Printf(TEXT("#%d|%s"), Item.CatalogId, *Item.Rarity);
+    }
+    return Item.ItemName + TEXT("|") + Item.Rarity;
+}
 
-    for (int32 i = 0; i < Items.Num(); i++)
+uint32 UInventoryWidget::MakeFilterMask(const FInventoryItem& Item)
+{
+    return (1u << GetCategoryIndex(Item.GetCategoryName())) | (1u << (8 + GetRarityIndex(Item.Rarity)));
+}
+
+uint64 UInventoryWidget::MakeSortKey(int32 Index) const
+{
+    // Ties keep acquisition order
+    uint64 Primary = 0;
+    switch (SortMode)
     {
-        const FInventoryItem& Item = Items[i];
+    case EInventorySortMode::Rarity:
+        Primary = NumRarities - GetRarityIndex(Items[Index].Rarity); // Rarest first
+        break;
+    case EInventorySortMode::Category:
+        Primary = GetCategoryIndex(Items[Index].GetCategoryName());
+        break;
+    case EInventorySortMode::Acquired:
+    default:
+        break;
+    }
+    return (Primary << 32) | ItemSerials[Index];
+}
 
-        // Create a text button for each item slot
-        UTextBlock* SlotText = NewObject<UTextBlock>(this);
+// ============ Sort / Filter ============
 
-        FString DisplayText = FString::Printf(TEXT("[%s] %s x%d"),
-            *Item.Rarity.Left(1), *Item.ItemName, Item.Quantity);
+void UInventoryWidget::SetSortMode(EInventorySortMode Mode)
+{
+    if (Mode == SortMode) return;
 
-        SlotText->SetText(FText::FromString(DisplayText));
+    SortMode = Mode;
+    for (int32 i = 0; i < Items.Num(); i++)
+    {
+        ItemSortKeys[i] = MakeSortKey(i);
+    }
+    MarkGridDirty();
+}
 
-        // Color by rarity
-        FSlateColor RarityColor(Item.GetRarityColor());
-        SlotText->SetColorAndOpacity(RarityColor);
+void UInventoryWidget::SetCategoryFilter(const FString& InCategory)
+{
+    const uint32 Bits = InCategory.IsEmpty() ? CategoryBits : (1u << GetCategoryIndex(InCategory));
+    FilterMask = (FilterMask & ~CategoryBits) | Bits;
+    MarkGridDirty();
+}
 
-        // Highlight selected
-        if (i == SelectedIndex)
-        {
-            FSlateFontInfo Font = SlotText->GetFont();
-            Font.Size = 14;
-            SlotText->SetFont(Font);
-        }
+void UInventoryWidget::SetMinRarity(const FString& Rarity)
+{
+    const uint32 Bits = Rarity.IsEmpty() ? RarityBits : ((RarityBits << GetRarityIndex(Rarity)) & RarityBits);
+    FilterMask = (FilterMask & ~RarityBits) | Bits;
+    MarkGridDirty();
+}
+
+// ============ Grid ============
 
-        ItemScrollBox->AddChild(SlotText);
+void UInventoryWidget::MarkGridDirty()
+{
+    if (bGridDirty) return;
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        RebuildGrid();
+        return;
     }
+    bGridDirty = true;
+    World->GetTimerManager().SetTimerForNextTick(this, &UInventoryWidget::RebuildGrid);
+}
+
+void UInventoryWidget::RebuildGrid()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Inventory_RebuildGrid);
+    bGridDirty = false;
 
     // Update currency display
     if (ShardsText)
@@ -157,6 +345,44 @@ void UInventoryWidget::RebuildGrid()
     {
         FragmentsText->SetText(FText::AsNumber(EchoFragments));
     }
+
+    if (!SlotRows.IsValid()) return;
+
+    DisplayOrder.Reset();
+    for (int32 i = 0; i < Items.Num(); i++)
+    {
+        const uint32 Mask = ItemFilterMasks[i] & FilterMask;
+        if ((Mask & CategoryBits) && (Mask & RarityBits))
+        {
+            DisplayOrder.Add(i);
+        }
+    }
+    DisplayOrder.Sort([this](int32 A, int32 B) { return ItemSortKeys[A] < ItemSortKeys[B]; });
+
+    SlotRows.BeginUpdate();
+    for (const int32 i : DisplayOrder)
+    {
+        const FInventoryItem& Item = Items[i];
+
+        // Highlight selected
+        bool bCreated = false;
+        const bool bSelected = i == SelectedIndex;
+        UTextBlock* SlotText = SlotRows.Row<UTextBlock>(ItemStackKeys[i], bCreated,
+            bSelected ? FName(TEXT("Selected")) : NAME_None);
+        if (bCreated && bSelected)
+        {
+            FSlateFontInfo Font = SlotText->GetFont();
+            Font.Size = 14;
+            SlotText->SetFont(Font);
+        }
+
+        FKeyedWidgetRows::SetText(SlotText, FString::Printf(TEXT("[%s] %s x%d"),
+            *Item.Rarity.Left(1), *Item.GetItemName(), Item.Quantity));
+
+        // Color by rarity
+        FKeyedWidgetRows::SetColor(SlotText, Item.GetRarityColor());
+    }
+    SlotRows.EndUpdate();
 }
 
 void UInventoryWidget::UpdateDetailPanel()
@@ -174,12 +400,12 @@ void UInventoryWidget::UpdateDetailPanel()
 
     if (SelectedItemName)
     {
-        SelectedItemName->SetText(FText::FromString(Item.ItemName));
+        SelectedItemName->SetText(FText::FromString(Item.GetItemName()));
         SelectedItemName->SetColorAndOpacity(FSlateColor(Item.GetRarityColor()));
     }
     if (SelectedItemCategory)
     {
-        SelectedItemCategory->SetText(FText::FromString(Item.Category));
+        SelectedItemCategory->SetText(FText::FromString(Item.GetCategoryName()));
     }
     if (SelectedItemRarity)
     {
@@ -199,7 +425,7 @@ void UInventoryWidget::SelectItem(int32 Index)
         SelectedIndex = Index;
         OnItemSelected.Broadcast(Items[Index]);
         UpdateDetailPanel();
-        RebuildGrid(); // Refresh highlight
+        MarkGridDirty(); // Refresh highlight
     }
 }
 
@@ -211,7 +437,8 @@ void UInventoryWidget::OnUseClicked()
         OnItemUsed.Broadcast(Item);
 
         // Consumables are used up
-        if (Item.Category == TEXT("Consumable") || Item.Category == TEXT("CombatResource"))
+        const FString ItemCategory = Item.GetCategoryName();
+        if (ItemCategory == TEXT("Consumable") || ItemCategory == TEXT("CombatResource"))
         {
             Items[SelectedIndex].Quantity--;
             if (Items[SelectedIndex].Quantity <= 0)
@@ -220,7 +447,7 @@ void UInventoryWidget::OnUseClicked()
             }
             else
             {
-                RebuildGrid();
+                MarkGridDirty();
                 UpdateDetailPanel();
             }
         }
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
 #include "InventoryWidget.generated.h"
 
 class UScrollBox;
@@ -14,17 +15,26 @@ class UUniformGridPanel;
 
 /**
  * Inventory item data — parsed from Rust loot JSON.
+ *
+ * Items the FTowerItemCatalog knows keep only their catalog id and what was
+ * rolled for the drop (rarity, quantity, semantic tags); name and category are
+ * read from the catalog, and ItemName, Category and LootJson stay empty. Items
+ * it doesn't know (no catalog, a newer server) keep the full loot JSON. Read
+ * through GetItemName / GetCategoryName / GetSemanticTags either way.
  */
 USTRUCT(BlueprintType)
-struct FInventoryItem
+struct TOWERGAME_API FInventoryItem
 {
     GENERATED_BODY()
 
     UPROPERTY(BlueprintReadOnly, Category = "Inventory")
-    FString ItemName;
+    int32 CatalogId = INDEX_NONE;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    FString ItemName; // Uncataloged items only
 
     UPROPERTY(BlueprintReadOnly, Category = "Inventory")
-    FString Category; // CombatResource, Material, Consumable, Equipment, Currency, EchoFragment
+    FString Category; // Uncataloged items only: CombatResource, Material, Consumable, Equipment, Currency, EchoFragment
 
     UPROPERTY(BlueprintReadOnly, Category = "Inventory")
     FString Rarity; // Common, Uncommon, Rare, Epic, Legendary, Mythic
@@ -33,7 +43,23 @@ struct FInventoryItem
     int32 Quantity = 1;
 
     UPROPERTY(BlueprintReadOnly, Category = "Inventory")
-    FString LootJson; // Raw JSON for server sync
+    FString LootJson; // Uncataloged items only: raw JSON for server sync
+
+    /** Rolled semantic tags of a cataloged item, parallel arrays */
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    TArray<FName> TagNames;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+    TArray<float> TagValues;
+
+    bool IsCataloged() const { return CatalogId != INDEX_NONE; }
+
+    FString GetItemName() const;
+    FString GetCategoryName() const;
+    TArray<TPair<FString, float>> GetSemanticTags() const;
+
+    /** Item of one generate_loot JSON object, by catalog id when the catalog has it */
+    static bool FromLootJson(const FString& LootJson, FInventoryItem& OutItem);
 
     FLinearColor GetRarityColor() const
     {
@@ -46,6 +72,15 @@ struct FInventoryItem
     }
 };
 
+/** Order of the slots in the grid */
+UENUM(BlueprintType)
+enum class EInventorySortMode : uint8
+{
+    Acquired  UMETA(DisplayName = "Acquired"),
+    Rarity    UMETA(DisplayName = "Rarity"),
+    Category  UMETA(DisplayName = "Category"),
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemSelected, const FInventoryItem&, Item);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemUsed, const FInventoryItem&, Item);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemDropped, const FInventoryItem&, Item);
@@ -60,6 +95,14 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemDropped, const FInventoryItem
  *
  * Items are stored as FInventoryItem structs parsed from Rust loot JSON.
  * Toggle visibility with Tab key (handled by PlayerCharacter input).
+ *
+ * Beside Items run parallel arrays of what sorting and filtering read: a
+ * sort key and a category/rarity bitmask per item, computed when the item
+ * is added, and a stack index so adding to an existing stack is a lookup.
+ * Adds and removals change the data at once but only mark the grid dirty;
+ * it is refreshed once on the next tick, so a loot vacuum of dozens of
+ * items costs one refresh. The refresh reuses slot rows by stack and only
+ * sets what changed.
  */
 UCLASS()
 class TOWERGAME_API UInventoryWidget : public UUserWidget
@@ -83,6 +126,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Inventory")
     void AddItemFromJson(const FString& LootJson);
 
+    /** Name of an item, cataloged or not */
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    static FString GetItemName(const FInventoryItem& Item) { return Item.GetItemName(); }
+
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    static FString GetItemCategory(const FInventoryItem& Item) { return Item.GetCategoryName(); }
+
     /** Get all items */
     UFUNCTION(BlueprintPure, Category = "Inventory")
     const TArray<FInventoryItem>& GetItems() const { return Items; }
@@ -94,6 +144,22 @@ public:
     UFUNCTION(BlueprintPure, Category = "Inventory")
     int32 GetEchoFragments() const { return EchoFragments; }
 
+    // ============ Sort / Filter ============
+
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void SetSortMode(EInventorySortMode Mode);
+
+    /** Show only this category; empty for all */
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void SetCategoryFilter(const FString& InCategory);
+
+    /** Hide items below this rarity; empty for all */
+    UFUNCTION(BlueprintCallable, Category = "Inventory")
+    void SetMinRarity(const FString& Rarity);
+
+    UFUNCTION(BlueprintPure, Category = "Inventory")
+    EInventorySortMode GetSortMode() const { return SortMode; }
+
     // ============ Config ============
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
@@ -146,7 +212,10 @@ public:
     UTextBlock* FragmentsText;
 
 protected:
-    /** Rebuild the visual grid from current Items array */
+    /** Refresh the grid on the next tick; repeated calls in a frame coalesce */
+    void MarkGridDirty();
+
+    /** Bring the visual grid up to date with the Items array */
     void RebuildGrid();
 
     /** Update detail panel from selected item */
@@ -163,9 +232,41 @@ protected:
     void OnDropClicked();
 
 private:
+    /** Append Item as a new slot with its derived fields */
+    void AddSlot(const FInventoryItem& Item);
+
+    /** Re-point StackIndex after slots moved */
+    void ReindexStacks();
+
+    uint64 MakeSortKey(int32 Index) const;
+
+    static FString MakeStackKey(const FInventoryItem& Item);
+    static uint32 MakeFilterMask(const FInventoryItem& Item);
+
     UPROPERTY()
     TArray<FInventoryItem> Items;
 
+    /** Per item, parallel to Items */
+    TArray<FString> ItemStackKeys;
+    TArray<uint32> ItemFilterMasks;
+    TArray<uint32> ItemSerials;
+    TArray<uint64> ItemSortKeys;
+
+    /** Name+rarity stack -> index into Items */
+    TMap<FString, int32> StackIndex;
+
+    /** Items the grid shows, indices into Items in display order */
+    TArray<int32> DisplayOrder;
+
+    /** Slot rows keyed by stack */
+    UPROPERTY()
+    FKeyedWidgetRows SlotRows;
+
+    EInventorySortMode SortMode = EInventorySortMode::Acquired;
+    uint32 FilterMask = MAX_uint32;
+    uint32 NextSerial = 0;
+    bool bGridDirty = false;
+
     int32 SelectedIndex = -1;
     int32 TowerShards = 0;
     int32 EchoFragments = 0;
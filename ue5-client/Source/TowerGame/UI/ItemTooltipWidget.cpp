@@ -4,103 +4,179 @@
 #include "Components/Border.h"
 #include "Components/CanvasPanelSlot.h"
 #include "Blueprint/WidgetLayoutLibrary.h"
-#include "Dom/JsonObject.h"
-#include "Dom/JsonValue.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
 
 void UItemTooltipWidget::NativeConstruct()
 {
     Super::NativeConstruct();
     SetVisibility(ESlateVisibility::Collapsed);
+    Layouts.Empty(FMath::Max(LayoutCacheSize, 1));
 }
 
 void UItemTooltipWidget::ShowForItem(const FInventoryItem& Item)
 {
     SetVisibility(ESlateVisibility::HitTestInvisible);
 
-    FLinearColor RarityColor = Item.GetRarityColor();
+    const uint32 Key = MakeLayoutKey(Item, CompareVersion);
+    FTooltipLayout* Layout = Layouts.FindAndTouch(Key);
+    if (!Layout || Layout->CatalogId != Item.CatalogId || Layout->ItemName != Item.ItemName
+        || Layout->LootJson != Item.LootJson || Layout->TagValues != Item.TagValues)
+    {
+        Layouts.Add(Key, BuildLayout(Item));
+        Layout = Layouts.FindAndTouch(Key);
+    }
+
+    ApplyLayout(*Layout);
+
+    // Measure once; later shows of the same layout reuse the size
+    if (Layout->DesiredSize.IsZero())
+    {
+        ForceLayoutPrepass();
+        Layout->DesiredSize = GetDesiredSize();
+    }
+    ShownSize = Layout->DesiredSize;
+}
+
+// ============ Layout Cache ============
+
+uint32 UItemTooltipWidget::MakeLayoutKey(const FInventoryItem& Item, uint32 InCompareVersion)
+{
+    uint32 Key = GetTypeHash(Item.CatalogId);
+    Key = HashCombine(Key, GetTypeHash(Item.ItemName));
+    Key = HashCombine(Key, GetTypeHash(Item.Category));
+    Key = HashCombine(Key, GetTypeHash(Item.Rarity));
+    Key = HashCombine(Key, GetTypeHash(Item.Quantity));
+    Key = HashCombine(Key, GetTypeHash(Item.LootJson));
+    for (const float Value : Item.TagValues)
+    {
+        Key = HashCombine(Key, GetTypeHash(Value));
+    }
+    return HashCombine(Key, InCompareVersion);
+}
+
+UItemTooltipWidget::FTooltipLayout UItemTooltipWidget::BuildLayout(const FInventoryItem& Item) const
+{
+    FTooltipLayout Layout;
+    Layout.CatalogId = Item.CatalogId;
+    Layout.ItemName = Item.ItemName;
+    Layout.LootJson = Item.LootJson;
+    Layout.TagValues = Item.TagValues;
+
+    Layout.Name = FText::FromString(Item.GetItemName());
+    Layout.Category = FText::FromString(Item.GetCategoryName());
+    Layout.Rarity = FText::FromString(Item.Rarity);
+    Layout.Quantity = FText::FromString(FString::Printf(TEXT("Quantity: %d"), Item.Quantity));
+    Layout.RarityColor = Item.GetRarityColor();
+
+    const TArray<TPair<FString, float>> Tags = Item.GetSemanticTags();
+    if (Tags.Num() > 0)
+    {
+        Layout.TagLines.Add(FText::FromString(TEXT("Semantic Tags:")));
+        Layout.TagColors.Add(FLinearColor(0.6f, 0.6f, 0.6f));
+        for (const auto& Tag : Tags)
+        {
+            Layout.TagLines.Add(FText::FromString(FString::Printf(TEXT("  %s: %.2f"), *Tag.Key, Tag.Value)));
+            Layout.TagColors.Add(GetTagColor(Tag.Key));
+        }
+    }
+
+    if (bHasCompareItem)
+    {
+        // Tags of the shown item first, then those only the compare item has
+        TArray<TPair<FString, float>, TInlineAllocator<8>> Deltas;
+        for (const auto& Tag : Tags)
+        {
+            const TPair<FString, float>* Other = CompareTags.FindByPredicate(
+                [&Tag](const TPair<FString, float>& T) { return T.Key == Tag.Key; });
+            Deltas.Emplace(Tag.Key, Tag.Value - (Other ? Other->Value : 0.0f));
+        }
+        for (const auto& Other : CompareTags)
+        {
+            if (!Tags.ContainsByPredicate([&Other](const TPair<FString, float>& T) { return T.Key == Other.Key; }))
+            {
+                Deltas.Emplace(Other.Key, -Other.Value);
+            }
+        }
 
+        for (const auto& Delta : Deltas)
+        {
+            if (FMath::IsNearlyZero(Delta.Value, 0.005f)) continue;
+            if (Layout.DeltaLines.Num() == 0)
+            {
+                Layout.DeltaLines.Add(FText::FromString(TEXT("Compared to equipped:")));
+                Layout.DeltaColors.Add(FLinearColor(0.6f, 0.6f, 0.6f));
+            }
+            Layout.DeltaLines.Add(FText::FromString(FString::Printf(TEXT("  %s: %+.2f"), *Delta.Key, Delta.Value)));
+            Layout.DeltaColors.Add(Delta.Value > 0.0f ? FLinearColor(0.3f, 0.9f, 0.3f) : FLinearColor(0.9f, 0.3f, 0.3f));
+        }
+    }
+
+    Layout.Flavor = FText::FromString(GenerateFlavorText(Item));
+    return Layout;
+}
+
+void UItemTooltipWidget::ApplyLayout(const FTooltipLayout& Layout)
+{
     // Name
     if (ItemNameText)
     {
-        ItemNameText->SetText(FText::FromString(Item.ItemName));
-        ItemNameText->SetColorAndOpacity(FSlateColor(RarityColor));
+        ItemNameText->SetText(Layout.Name);
+        ItemNameText->SetColorAndOpacity(FSlateColor(Layout.RarityColor));
     }
 
     // Category
     if (CategoryText)
     {
-        CategoryText->SetText(FText::FromString(Item.Category));
+        CategoryText->SetText(Layout.Category);
     }
 
     // Rarity
     if (RarityText)
     {
-        RarityText->SetText(FText::FromString(Item.Rarity));
-        RarityText->SetColorAndOpacity(FSlateColor(RarityColor));
+        RarityText->SetText(Layout.Rarity);
+        RarityText->SetColorAndOpacity(FSlateColor(Layout.RarityColor));
     }
 
     // Quantity
     if (QuantityText)
     {
-        QuantityText->SetText(FText::FromString(
-            FString::Printf(TEXT("Quantity: %d"), Item.Quantity)));
+        QuantityText->SetText(Layout.Quantity);
     }
 
     // Border color
     if (TooltipBorder)
     {
-        TooltipBorder->SetBrushColor(RarityColor.ToFColor(true));
+        TooltipBorder->SetBrushColor(Layout.RarityColor.ToFColor(true));
     }
 
     // Semantic tags
     if (TagsBox)
     {
-        TagsBox->ClearChildren();
+        ShowRows(TagsBox, TagRows, Layout.TagLines.Num());
+        for (int32 i = 0; i < Layout.TagLines.Num(); i++)
+        {
+            TagRows[i]->SetText(Layout.TagLines[i]);
+            TagRows[i]->SetColorAndOpacity(FSlateColor(Layout.TagColors[i]));
+        }
+    }
 
-        TArray<TPair<FString, float>> Tags = ParseSemanticTags(Item.LootJson);
-        if (Tags.Num() > 0)
+    // Deltas against the compare item
+    if (CompareBox)
+    {
+        ShowRows(CompareBox, DeltaRows, Layout.DeltaLines.Num());
+        for (int32 i = 0; i < Layout.DeltaLines.Num(); i++)
         {
-            UTextBlock* TagHeader = NewObject<UTextBlock>(this);
-            TagHeader->SetText(FText::FromString(TEXT("Semantic Tags:")));
-            TagHeader->SetColorAndOpacity(FSlateColor(FLinearColor(0.6f, 0.6f, 0.6f)));
-            FSlateFontInfo HeaderFont = TagHeader->GetFont();
-            HeaderFont.Size = 9;
-            TagHeader->SetFont(HeaderFont);
-            TagsBox->AddChild(TagHeader);
-
-            for (const auto& Tag : Tags)
-            {
-                UTextBlock* TagText = NewObject<UTextBlock>(this);
-                TagText->SetText(FText::FromString(
-                    FString::Printf(TEXT("  %s: %.2f"), *Tag.Key, Tag.Value)));
-
-                // Color tags by element
-                FLinearColor TagColor(0.7f, 0.7f, 0.7f);
-                if (Tag.Key == TEXT("fire")) TagColor = FLinearColor(1.0f, 0.4f, 0.1f);
-                else if (Tag.Key == TEXT("water")) TagColor = FLinearColor(0.2f, 0.6f, 1.0f);
-                else if (Tag.Key == TEXT("earth")) TagColor = FLinearColor(0.6f, 0.4f, 0.2f);
-                else if (Tag.Key == TEXT("wind")) TagColor = FLinearColor(0.6f, 1.0f, 0.7f);
-                else if (Tag.Key == TEXT("void")) TagColor = FLinearColor(0.5f, 0.2f, 0.8f);
-                else if (Tag.Key == TEXT("corruption")) TagColor = FLinearColor(0.3f, 0.0f, 0.2f);
-
-                TagText->SetColorAndOpacity(FSlateColor(TagColor));
-                FSlateFontInfo TagFont = TagText->GetFont();
-                TagFont.Size = 9;
-                TagText->SetFont(TagFont);
-                TagsBox->AddChild(TagText);
-            }
+            DeltaRows[i]->SetText(Layout.DeltaLines[i]);
+            DeltaRows[i]->SetColorAndOpacity(FSlateColor(Layout.DeltaColors[i]));
         }
+        CompareBox->SetVisibility(Layout.DeltaLines.Num() > 0 ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
     }
 
     // Flavor text
     if (FlavorText)
     {
-        FString Flavor = GenerateFlavorText(Item);
-        if (!Flavor.IsEmpty())
+        if (!Layout.Flavor.IsEmpty())
         {
-            FlavorText->SetText(FText::FromString(Flavor));
+            FlavorText->SetText(Layout.Flavor);
             FlavorText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.4f)));
             FlavorText->SetVisibility(ESlateVisibility::Visible);
         }
@@ -111,18 +187,52 @@ void UItemTooltipWidget::ShowForItem(const FInventoryItem& Item)
     }
 }
 
-void UItemTooltipWidget::ShowFromJson(const FString& ItemJson)
+void UItemTooltipWidget::ShowRows(UVerticalBox* Box, TArray<UTextBlock*>& Pool, int32 Count)
+{
+    while (Pool.Num() < Count)
+    {
+        UTextBlock* Row = NewObject<UTextBlock>(this);
+        FSlateFontInfo Font = Row->GetFont();
+        Font.Size = 9;
+        Row->SetFont(Font);
+        Box->AddChild(Row);
+        Pool.Add(Row);
+    }
+
+    for (int32 i = 0; i < Pool.Num(); i++)
+    {
+        Pool[i]->SetVisibility(i < Count ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+    }
+}
+
+void UItemTooltipWidget::InvalidateLayouts()
+{
+    Layouts.Empty(FMath::Max(LayoutCacheSize, 1));
+}
+
+// ============ Compare ============
+
+void UItemTooltipWidget::SetCompareItem(const FInventoryItem& Item)
 {
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ItemJson);
-    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid()) return;
+    CompareTags = Item.GetSemanticTags();
+    bHasCompareItem = true;
 
+    // Layouts built against the old item stay cached under the old version and age out
+    CompareVersion++;
+}
+
+void UItemTooltipWidget::ClearCompareItem()
+{
+    if (!bHasCompareItem) return;
+    CompareTags.Reset();
+    bHasCompareItem = false;
+    CompareVersion++;
+}
+
+void UItemTooltipWidget::ShowFromJson(const FString& ItemJson)
+{
     FInventoryItem Item;
-    Item.ItemName = Json->GetStringField(TEXT("name"));
-    Item.Category = Json->HasField(TEXT("category")) ? Json->GetStringField(TEXT("category")) : TEXT("Unknown");
-    Item.Rarity = Json->HasField(TEXT("rarity")) ? Json->GetStringField(TEXT("rarity")) : TEXT("Common");
-    Item.Quantity = Json->HasField(TEXT("quantity")) ? Json->GetIntegerField(TEXT("quantity")) : 1;
-    Item.LootJson = ItemJson;
+    if (!FInventoryItem::FromLootJson(ItemJson, Item)) return;
 
     ShowForItem(Item);
 }
@@ -134,32 +244,41 @@ void UItemTooltipWidget::HideTooltip()
 
 void UItemTooltipWidget::SetScreenPosition(FVector2D Position)
 {
+    // Flip to the other side of the cursor rather than run off the screen
+    if (!ShownSize.IsZero())
+    {
+        const FVector2D Viewport = UWidgetLayoutLibrary::GetViewportSize(this);
+        if (Position.X + ShownSize.X > Viewport.X) Position.X = FMath::Max(0.0f, Position.X - ShownSize.X);
+        if (Position.Y + ShownSize.Y > Viewport.Y) Position.Y = FMath::Max(0.0f, Position.Y - ShownSize.Y);
+    }
     SetPositionInViewport(Position);
 }
 
 FString UItemTooltipWidget::GenerateFlavorText(const FInventoryItem& Item) const
 {
-    if (Item.Category == TEXT("Currency"))
+    const FString Category = Item.GetCategoryName();
+    if (Category == TEXT("Currency"))
     {
         return TEXT("The universal currency of the Tower. Sought by all who climb.");
     }
-    if (Item.Category == TEXT("EchoFragment"))
+    if (Category == TEXT("EchoFragment"))
     {
         return TEXT("A crystallized memory from a fallen climber. Hums with fading intent.");
     }
-    if (Item.Category == TEXT("CombatResource"))
+    if (Category == TEXT("CombatResource"))
     {
-        if (Item.ItemName.Contains(TEXT("Thermal")))
+        const FString Name = Item.GetItemName();
+        if (Name.Contains(TEXT("Thermal")))
             return TEXT("Concentrated heat energy. Burns to the touch.");
-        if (Item.ItemName.Contains(TEXT("Ember")))
+        if (Name.Contains(TEXT("Ember")))
             return TEXT("A spark of elemental fire. Warm even through gloves.");
         return TEXT("Raw combat energy, waiting to be unleashed.");
     }
-    if (Item.Category == TEXT("Material"))
+    if (Category == TEXT("Material"))
     {
         return TEXT("A crafting material imbued with semantic resonance.");
     }
-    if (Item.Category == TEXT("Consumable"))
+    if (Category == TEXT("Consumable"))
     {
         return TEXT("A restorative draught. Drink wisely — supplies are scarce above floor 20.");
     }
@@ -167,30 +286,14 @@ FString UItemTooltipWidget::GenerateFlavorText(const FInventoryItem& Item) const
     return TEXT("");
 }
 
-TArray<TPair<FString, float>> UItemTooltipWidget::ParseSemanticTags(const FString& LootJson) const
+FLinearColor UItemTooltipWidget::GetTagColor(const FString& Tag)
 {
-    TArray<TPair<FString, float>> Result;
-
-    if (LootJson.IsEmpty()) return Result;
-
-    TSharedPtr<FJsonObject> Json;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LootJson);
-    if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid()) return Result;
-
-    const TArray<TSharedPtr<FJsonValue>>* Tags;
-    if (Json->TryGetArrayField(TEXT("semantic_tags"), Tags))
-    {
-        for (const TSharedPtr<FJsonValue>& TagVal : *Tags)
-        {
-            const TArray<TSharedPtr<FJsonValue>>& TagPair = TagVal->AsArray();
-            if (TagPair.Num() >= 2)
-            {
-                FString TagName = TagPair[0]->AsString();
-                float TagValue = TagPair[1]->AsNumber();
-                Result.Add(TPair<FString, float>(TagName, TagValue));
-            }
-        }
-    }
-
-    return Result;
+    // Color tags by element
+    if (Tag == TEXT("fire")) return FLinearColor(1.0f, 0.4f, 0.1f);
+    if (Tag == TEXT("water")) return FLinearColor(0.2f, 0.6f, 1.0f);
+    if (Tag == TEXT("earth")) return FLinearColor(0.6f, 0.4f, 0.2f);
+    if (Tag == TEXT("wind")) return FLinearColor(0.6f, 1.0f, 0.7f);
+    if (Tag == TEXT("void")) return FLinearColor(0.5f, 0.2f, 0.8f);
+    if (Tag == TEXT("corruption")) return FLinearColor(0.3f, 0.0f, 0.2f);
+    return FLinearColor(0.7f, 0.7f, 0.7f);
 }
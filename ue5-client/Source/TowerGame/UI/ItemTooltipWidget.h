@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "Containers/LruCache.h"
 #include "UI/InventoryWidget.h"
 #include "ItemTooltipWidget.generated.h"
 
@@ -27,6 +28,11 @@ class UBorder;
  *
  * Appears near cursor when hovering over inventory items.
  * Border color matches rarity.
+ *
+ * Each item's formatted lines, tag deltas against the compare item and
+ * measured size are built once and kept in a small LRU, and the tag rows
+ * are a pool of text blocks reused between shows, so hovering an item seen
+ * before only sets text on existing widgets.
  */
 UCLASS()
 class TOWERGAME_API UItemTooltipWidget : public UUserWidget
@@ -50,10 +56,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Tooltip")
     void HideTooltip();
 
-    /** Move tooltip to screen position */
+    /** Move tooltip to screen position, kept inside the viewport once its size is known */
     UFUNCTION(BlueprintCallable, Category = "Tooltip")
     void SetScreenPosition(FVector2D Position);
 
+    /** Compare shown items' semantic tags against this one (usually the equipped item) */
+    UFUNCTION(BlueprintCallable, Category = "Tooltip")
+    void SetCompareItem(const FInventoryItem& Item);
+
+    UFUNCTION(BlueprintCallable, Category = "Tooltip")
+    void ClearCompareItem();
+
+    /** Drop every cached layout, e.g. after a locale change */
+    UFUNCTION(BlueprintCallable, Category = "Tooltip")
+    void InvalidateLayouts();
+
     /** Is tooltip visible? */
     UFUNCTION(BlueprintPure, Category = "Tooltip")
     bool IsTooltipVisible() const { return GetVisibility() == ESlateVisibility::Visible; }
@@ -75,6 +92,10 @@ public:
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Tooltip")
     UVerticalBox* TagsBox;
 
+    /** Tag deltas against the compare item */
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Tooltip")
+    UVerticalBox* CompareBox;
+
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Tooltip")
     UTextBlock* FlavorText;
 
@@ -85,6 +106,62 @@ protected:
     /** Generate flavor text from item semantic tags */
     FString GenerateFlavorText(const FInventoryItem& Item) const;
 
-    /** Parse semantic tags from loot JSON */
-    TArray<TPair<FString, float>> ParseSemanticTags(const FString& LootJson) const;
+    /** Items whose layout is remembered */
+    UPROPERTY(EditDefaultsOnly, Category = "Tooltip")
+    int32 LayoutCacheSize = 32;
+
+private:
+    /** Everything a show sets, formatted once per item and compare item */
+    struct FTooltipLayout
+    {
+        // Source, checked on lookup so a hash collision can't show the wrong item
+        int32 CatalogId = INDEX_NONE;
+        FString ItemName;
+        FString LootJson;
+        TArray<float> TagValues;
+
+        FText Name;
+        FText Category;
+        FText Rarity;
+        FText Quantity;
+        FLinearColor RarityColor;
+
+        TArray<FText> TagLines;
+        TArray<FLinearColor> TagColors;
+
+        TArray<FText> DeltaLines;
+        TArray<FLinearColor> DeltaColors;
+
+        FText Flavor;
+
+        /** Measured after the first show; zero until then */
+        FVector2D DesiredSize = FVector2D::ZeroVector;
+    };
+
+    static uint32 MakeLayoutKey(const FInventoryItem& Item, uint32 CompareVersion);
+    FTooltipLayout BuildLayout(const FInventoryItem& Item) const;
+    void ApplyLayout(const FTooltipLayout& Layout);
+
+    /** Show the first Count rows of Pool in Box, adding rows as needed, and collapse the rest */
+    void ShowRows(UVerticalBox* Box, TArray<UTextBlock*>& Pool, int32 Count);
+
+    static FLinearColor GetTagColor(const FString& Tag);
+
+    TLruCache<uint32, FTooltipLayout> Layouts;
+
+    /** Measured size of the layout shown now */
+    FVector2D ShownSize = FVector2D::ZeroVector;
+
+    TArray<TPair<FString, float>> CompareTags;
+    bool bHasCompareItem = false;
+
+    /** Bumped by every compare item change; part of the layout key */
+    uint32 CompareVersion = 0;
+
+    /** Header then one row per tag */
+    UPROPERTY()
+    TArray<UTextBlock*> TagRows;
+
+    UPROPERTY()
+    TArray<UTextBlock*> DeltaRows;
 };
@@ -0,0 +1,122 @@
+#include "KeyedWidgetRows.h"
+#include "Components/PanelWidget.h"
+#include "Components/TextBlock.h"
+
+void FKeyedWidgetRows::Init(UObject* Owner, UPanelWidget* InPanel)
+{
+    if (Panel == InPanel) return;
+
+    Clear();
+    Outer = Owner;
+    Panel = InPanel;
+}
+
+void FKeyedWidgetRows::BeginUpdate()
+{
+    PendingRows.Reset();
+    PendingKeys.Reset();
+    PendingStyles.Reset();
+}
+
+UWidget* FKeyedWidgetRows::AcquireRow(const FString& Key, UClass* Class, FName Style, bool& bOutCreated)
+{
+    bOutCreated = false;
+
+    // Shown last time, under the same kind of widget: keep it
+    const int32 Existing = Keys.IndexOfByKey(Key);
+    if (Existing != INDEX_NONE && Rows[Existing]->GetClass() == Class && Styles[Existing] == Style
+        && !PendingRows.Contains(Rows[Existing]))
+    {
+        PendingRows.Add(Rows[Existing]);
+        PendingKeys.Add(Key);
+        PendingStyles.Add(Style);
+        return Rows[Existing];
+    }
+
+    UWidget* Widget = nullptr;
+    for (int32 i = Free.Num() - 1; i >= 0; i--)
+    {
+        if (Free[i]->GetClass() == Class && FreeStyles[i] == Style)
+        {
+            Widget = Free[i];
+            Free.RemoveAtSwap(i, 1, /*bAllowShrinking=*/false);
+            FreeStyles.RemoveAtSwap(i, 1, /*bAllowShrinking=*/false);
+            break;
+        }
+    }
+    if (!Widget)
+    {
+        Widget = NewObject<UWidget>(Outer ? Outer : GetTransientPackage(), Class);
+        bOutCreated = true;
+    }
+
+    PendingRows.Add(Widget);
+    PendingKeys.Add(Key);
+    PendingStyles.Add(Style);
+    return Widget;
+}
+
+void FKeyedWidgetRows::EndUpdate()
+{
+    // Rows nobody asked for go back to the pool
+    for (int32 i = Rows.Num() - 1; i >= 0; i--)
+    {
+        if (PendingRows.Contains(Rows[i])) continue;
+
+        if (Panel)
+        {
+            Panel->RemoveChild(Rows[i]);
+        }
+        Free.Add(Rows[i]);
+        FreeStyles.Add(Styles[i]);
+        Rows.RemoveAt(i, 1, /*bAllowShrinking=*/false);
+        Keys.RemoveAt(i, 1, /*bAllowShrinking=*/false);
+        Styles.RemoveAt(i, 1, /*bAllowShrinking=*/false);
+    }
+
+    // The kept rows are in their old order; from the first disagreement on, re-add in the new one
+    int32 Same = 0;
+    while (Same < Rows.Num() && Same < PendingRows.Num() && Rows[Same] == PendingRows[Same])
+    {
+        Same++;
+    }
+    if (Panel)
+    {
+        for (int32 i = Rows.Num() - 1; i >= Same; i--)
+        {
+            Panel->RemoveChild(Rows[i]);
+        }
+        for (int32 i = Same; i < PendingRows.Num(); i++)
+        {
+            Panel->AddChild(PendingRows[i]);
+        }
+    }
+
+    Swap(Rows, PendingRows);
+    Swap(Keys, PendingKeys);
+    Swap(Styles, PendingStyles);
+    BeginUpdate();
+}
+
+void FKeyedWidgetRows::Clear()
+{
+    BeginUpdate();
+    EndUpdate();
+}
+
+void FKeyedWidgetRows::SetText(UTextBlock* Text, const FString& Value)
+{
+    if (Text && !Text->GetText().ToString().Equals(Value, ESearchCase::CaseSensitive))
+    {
+        Text->SetText(FText::FromString(Value));
+    }
+}
+
+void FKeyedWidgetRows::SetColor(UTextBlock* Text, const FLinearColor& Color)
+{
+    const FSlateColor SlateColor(Color);
+    if (Text && Text->GetColorAndOpacity() != SlateColor)
+    {
+        Text->SetColorAndOpacity(SlateColor);
+    }
+}
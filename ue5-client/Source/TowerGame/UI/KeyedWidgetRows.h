@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "KeyedWidgetRows.generated.h"
+
+class UPanelWidget;
+class UTextBlock;
+
+/**
+ * The rows of a list panel, matched to data by key instead of rebuilt.
+ *
+ * A refresh walks the data in display order between BeginUpdate and
+ * EndUpdate, asking Row() for each entry's widget. Entries that were shown
+ * last time get their old row back; new ones take a row from the pool
+ * (created only when the pool is empty). EndUpdate removes rows whose key
+ * wasn't asked for and puts them in the pool, and appends the new rows.
+ * Panels only take children live at the end, so a reorder or a mid-list
+ * insert re-adds the rows after it; appends and removals touch nothing else.
+ *
+ * A created row comes back with bOutCreated set so the caller builds it
+ * (fonts, children) once; a reused row keeps that setup, and pooled rows
+ * are only handed out again under the same Style. SetText/SetColor skip
+ * unchanged values, so rows that didn't change don't invalidate.
+ *
+ * The panel must hold nothing but these rows. Keep an instance as a
+ * UPROPERTY of the owning widget; it holds the pool.
+ */
+USTRUCT()
+struct TOWERGAME_API FKeyedWidgetRows
+{
+    GENERATED_BODY()
+
+    /** Rows go in InPanel and are created with Owner as outer */
+    void Init(UObject* Owner, UPanelWidget* InPanel);
+
+    void BeginUpdate();
+
+    /** The row for Key: calls give the display order, one per key per update */
+    template <typename WidgetT>
+    WidgetT* Row(const FString& Key, bool& bOutCreated, FName Style = NAME_None)
+    {
+        return CastChecked<WidgetT>(AcquireRow(Key, WidgetT::StaticClass(), Style, bOutCreated));
+    }
+
+    /** The row shown for Key since the last EndUpdate, or null; for updating one row between refreshes */
+    template <typename WidgetT>
+    WidgetT* Find(const FString& Key) const
+    {
+        const int32 Index = Keys.IndexOfByKey(Key);
+        return Index != INDEX_NONE ? Cast<WidgetT>(Rows[Index]) : nullptr;
+    }
+
+    /** Drop unrequested rows to the pool and attach new ones */
+    void EndUpdate();
+
+    /** Every row back to the pool */
+    void Clear();
+
+    int32 Num() const { return Rows.Num(); }
+    bool IsValid() const { return Panel != nullptr; }
+
+    static void SetText(UTextBlock* Text, const FString& Value);
+    static void SetColor(UTextBlock* Text, const FLinearColor& Color);
+
+private:
+    UWidget* AcquireRow(const FString& Key, UClass* Class, FName Style, bool& bOutCreated);
+
+    UPROPERTY()
+    UObject* Outer = nullptr;
+
+    UPROPERTY()
+    UPanelWidget* Panel = nullptr;
+
+    /** Attached rows in panel order, with their keys and styles */
+    UPROPERTY()
+    TArray<UWidget*> Rows;
+    TArray<FString> Keys;
+    TArray<FName> Styles;
+
+    /** This update's rows so far, in display order */
+    UPROPERTY()
+    TArray<UWidget*> PendingRows;
+    TArray<FString> PendingKeys;
+    TArray<FName> PendingStyles;
+
+    /** Detached rows waiting for reuse */
+    UPROPERTY()
+    TArray<UWidget*> Free;
+    TArray<FName> FreeStyles;
+};
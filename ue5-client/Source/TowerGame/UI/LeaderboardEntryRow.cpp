@@ -0,0 +1,25 @@
+#include "LeaderboardEntryRow.h"
+#include "Components/TextBlock.h"
+
+void ULeaderboardEntryRow::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+    if (const ULeaderboardEntryItem* Item = Cast<ULeaderboardEntryItem>(ListItemObject))
+    {
+        SetItem(*Item);
+    }
+}
+
+void ULeaderboardEntryRow::SetItem(const ULeaderboardEntryItem& Item)
+{
+    if (!EntryText) return;
+
+    EntryText->SetText(Item.DisplayText);
+    EntryText->SetColorAndOpacity(FSlateColor(Item.Color));
+
+    FSlateFontInfo Font = EntryText->GetFont();
+    if (Font.Size != Item.FontSize)
+    {
+        Font.Size = Item.FontSize;
+        EntryText->SetFont(Font);
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "LeaderboardWidget.h"
+#include "LeaderboardEntryRow.generated.h"
+
+class UTextBlock;
+
+/**
+ * One leaderboard record as a UListView item. ULeaderboardWidget keeps one
+ * per player in the shown window and updates it in place when a refresh
+ * moves the player, so only changed rows redraw.
+ */
+UCLASS()
+class TOWERGAME_API ULeaderboardEntryItem : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    FLeaderboardEntry Entry;
+
+    /** Rank, name, score and rank change, ready to show */
+    FText DisplayText;
+
+    FLinearColor Color = FLinearColor::White;
+    int32 FontSize = 12;
+
+    /** Places gained (positive) or lost since the previous fetch of this window; 0 when unchanged */
+    int32 RankDelta = 0;
+};
+
+/**
+ * Row widget for the leaderboard UListView. Subclass in Blueprint with an
+ * EntryText text block and set it as the list's Entry Widget Class; the
+ * list only creates rows for what's on screen.
+ */
+UCLASS(Abstract)
+class TOWERGAME_API ULeaderboardEntryRow : public UUserWidget, public IUserObjectListEntry
+{
+    GENERATED_BODY()
+
+public:
+    /** Show Item; also called when a refresh changes the item under this row */
+    void SetItem(const ULeaderboardEntryItem& Item);
+
+    UPROPERTY(meta = (BindWidget), BlueprintReadOnly, Category = "Leaderboard")
+    UTextBlock* EntryText;
+
+protected:
+    virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+};
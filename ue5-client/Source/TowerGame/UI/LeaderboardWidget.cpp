@@ -2,10 +2,15 @@
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
+#include "Components/ListView.h"
+#include "LeaderboardEntryRow.h"
+#include "Network/NakamaSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void ULeaderboardWidget::NativeConstruct()
 {
@@ -15,6 +20,22 @@ void ULeaderboardWidget::NativeConstruct()
     {
         RefreshButton->OnClicked.AddDynamic(this, &ULeaderboardWidget::OnRefreshClicked);
     }
+    if (TopButton)
+    {
+        TopButton->OnClicked.AddDynamic(this, &ULeaderboardWidget::ShowTop);
+    }
+    if (AroundMeButton)
+    {
+        AroundMeButton->OnClicked.AddDynamic(this, &ULeaderboardWidget::ShowAroundMe);
+    }
+    if (PrevPageButton)
+    {
+        PrevPageButton->OnClicked.AddDynamic(this, &ULeaderboardWidget::ShowPrevPage);
+    }
+    if (NextPageButton)
+    {
+        NextPageButton->OnClicked.AddDynamic(this, &ULeaderboardWidget::ShowNextPage);
+    }
     if (TabHighestFloor)
     {
         TabHighestFloor->OnClicked.AddDynamic(this, &ULeaderboardWidget::OnTabHighestFloorClicked);
@@ -32,52 +53,262 @@ void ULeaderboardWidget::NativeConstruct()
         TabSpeed10->OnClicked.AddDynamic(this, &ULeaderboardWidget::OnTabSpeed10Clicked);
     }
 
+    if (EntryScrollBox && !EntryListView)
+    {
+        Rows.Init(this, EntryScrollBox);
+    }
+
+    UGameInstance* GI = GetGameInstance();
+    if (UNakamaSubsystem* Nakama = GI ? GI->GetSubsystem<UNakamaSubsystem>() : nullptr)
+    {
+        Nakama->OnLeaderboardReceived.AddDynamic(this, &ULeaderboardWidget::OnLeaderboardReceived);
+        if (LocalPlayerId.IsEmpty())
+        {
+            LocalPlayerId = Nakama->UserId;
+        }
+    }
+
     RebuildDisplay();
 }
 
-void ULeaderboardWidget::PopulateFromJson(const FString& LeaderboardJson, ELeaderboardType Type)
+void ULeaderboardWidget::NativeDestruct()
 {
-    CurrentEntries.Empty();
-    CurrentTab = Type;
+    UGameInstance* GI = GetGameInstance();
+    if (UNakamaSubsystem* Nakama = GI ? GI->GetSubsystem<UNakamaSubsystem>() : nullptr)
+    {
+        Nakama->OnLeaderboardReceived.RemoveDynamic(this, &ULeaderboardWidget::OnLeaderboardReceived);
+    }
+
+    Super::NativeDestruct();
+}
+
+FString ULeaderboardWidget::GetLeaderboardId(ELeaderboardType Type)
+{
+    switch (Type)
+    {
+    case ELeaderboardType::SpeedRunFloor1:  return TEXT("floor_1_speed");
+    case ELeaderboardType::SpeedRunFloor5:  return TEXT("floor_5_speed");
+    case ELeaderboardType::SpeedRunFloor10: return TEXT("floor_10_speed");
+    case ELeaderboardType::HighestFloor:
+    default:                                return TEXT("highest_floor");
+    }
+}
+
+// ============ Windows ============
+
+void ULeaderboardWidget::ShowTop()
+{
+    Window = ELeaderboardWindow::Top;
+    PageCursor.Empty();
+    RequestWindow();
+}
+
+void ULeaderboardWidget::ShowAroundMe()
+{
+    Window = ELeaderboardWindow::AroundMe;
+    PageCursor.Empty();
+    RequestWindow();
+}
 
+void ULeaderboardWidget::ShowNextPage()
+{
+    if (NextCursor.IsEmpty()) return;
+
+    Window = ELeaderboardWindow::Page;
+    PageCursor = NextCursor;
+    RequestWindow();
+}
+
+void ULeaderboardWidget::ShowPrevPage()
+{
+    if (PrevCursor.IsEmpty()) return;
+
+    Window = ELeaderboardWindow::Page;
+    PageCursor = PrevCursor;
+    RequestWindow();
+}
+
+void ULeaderboardWidget::Refresh()
+{
+    RequestWindow();
+}
+
+void ULeaderboardWidget::RequestWindow()
+{
+    OnRefreshRequested.Broadcast(CurrentTab);
+    if (!bFetchFromNakama) return;
+
+    UGameInstance* GI = GetGameInstance();
+    UNakamaSubsystem* Nakama = GI ? GI->GetSubsystem<UNakamaSubsystem>() : nullptr;
+    if (!Nakama || !Nakama->IsAuthenticated()) return;
+
+    const FString BoardId = GetLeaderboardId(CurrentTab);
+    switch (Window)
+    {
+    case ELeaderboardWindow::AroundMe:
+        Nakama->FetchLeaderboardAroundPlayer(BoardId, MaxDisplayEntries);
+        break;
+    case ELeaderboardWindow::Page:
+        Nakama->FetchLeaderboardPage(BoardId, MaxDisplayEntries, PageCursor);
+        break;
+    case ELeaderboardWindow::Top:
+    default:
+        Nakama->FetchLeaderboardPage(BoardId, MaxDisplayEntries, FString());
+        break;
+    }
+}
+
+void ULeaderboardWidget::OnLeaderboardReceived(bool bSuccess, const FString& ResponseJson)
+{
+    if (!bSuccess) return;
+    PopulateFromJson(ResponseJson, CurrentTab);
+}
+
+// ============ Entries ============
+
+static bool ParseLeaderboardRecord(const TSharedPtr<FJsonValue>& RecVal, const FString& LocalPlayerId, FLeaderboardEntry& OutEntry)
+{
+    const TSharedPtr<FJsonObject>& RecObj = RecVal->AsObject();
+    if (!RecObj.IsValid()) return false;
+
+    // Nakama sends int64s (rank, score) as strings
+    OutEntry.Rank = static_cast<int32>(FCString::Atoi64(*RecObj->GetStringField(TEXT("rank"))));
+    OutEntry.PlayerName = RecObj->HasField(TEXT("username")) ?
+        RecObj->GetStringField(TEXT("username")) : TEXT("Unknown");
+    OutEntry.Score = FCString::Atoi64(*RecObj->GetStringField(TEXT("score")));
+    OutEntry.PlayerId = RecObj->HasField(TEXT("owner_id")) ?
+        RecObj->GetStringField(TEXT("owner_id")) : TEXT("");
+    OutEntry.bIsLocalPlayer = (!LocalPlayerId.IsEmpty() && OutEntry.PlayerId == LocalPlayerId);
+    return true;
+}
+
+void ULeaderboardWidget::PopulateFromJson(const FString& LeaderboardJson, ELeaderboardType Type)
+{
     TSharedPtr<FJsonObject> Json;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LeaderboardJson);
     if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid()) return;
 
-    const TArray<TSharedPtr<FJsonValue>>* Records;
-    if (Json->TryGetArrayField(TEXT("records"), Records))
+    const TArray<TSharedPtr<FJsonValue>>* Records = nullptr;
+    Json->TryGetArrayField(TEXT("records"), Records);
+
+    // A reply for a tab the player has since left
+    FString BoardId;
+    if (Records && Records->Num() > 0 && (*Records)[0]->AsObject().IsValid()
+        && (*Records)[0]->AsObject()->TryGetStringField(TEXT("leaderboard_id"), BoardId)
+        && BoardId != GetLeaderboardId(Type))
+    {
+        return;
+    }
+
+    if (Type != CurrentTab)
+    {
+        ResetItems();
+        CurrentTab = Type;
+    }
+
+    NextCursor.Empty();
+    PrevCursor.Empty();
+    Json->TryGetStringField(TEXT("next_cursor"), NextCursor);
+    Json->TryGetStringField(TEXT("prev_cursor"), PrevCursor);
+
+    TArray<FLeaderboardEntry> Entries;
+    if (Records)
     {
+        Entries.Reserve(Records->Num());
         for (const TSharedPtr<FJsonValue>& RecVal : *Records)
         {
-            const TSharedPtr<FJsonObject>& RecObj = RecVal->AsObject();
-            if (!RecObj.IsValid()) continue;
+            FLeaderboardEntry Entry;
+            if (ParseLeaderboardRecord(RecVal, LocalPlayerId, Entry))
+            {
+                Entries.Add(MoveTemp(Entry));
+            }
+        }
+    }
 
+    // The player's own record comes apart from the window, so the footer shows it from any page
+    OwnerEntry = FLeaderboardEntry();
+    const TArray<TSharedPtr<FJsonValue>>* OwnerRecords = nullptr;
+    if (Json->TryGetArrayField(TEXT("owner_records"), OwnerRecords))
+    {
+        for (const TSharedPtr<FJsonValue>& RecVal : *OwnerRecords)
+        {
             FLeaderboardEntry Entry;
-            Entry.Rank = RecObj->GetIntegerField(TEXT("rank"));
-            Entry.PlayerName = RecObj->HasField(TEXT("username")) ?
-                RecObj->GetStringField(TEXT("username")) : TEXT("Unknown");
-            Entry.Score = RecObj->GetIntegerField(TEXT("score"));
-            Entry.PlayerId = RecObj->HasField(TEXT("owner_id")) ?
-                RecObj->GetStringField(TEXT("owner_id")) : TEXT("");
-            Entry.bIsLocalPlayer = (!LocalPlayerId.IsEmpty() && Entry.PlayerId == LocalPlayerId);
-
-            CurrentEntries.Add(Entry);
+            if (ParseLeaderboardRecord(RecVal, LocalPlayerId, Entry) && Entry.bIsLocalPlayer)
+            {
+                OwnerEntry = Entry;
+                break;
+            }
         }
     }
 
-    RebuildDisplay();
+    ApplyEntries(Entries);
 }
 
 void ULeaderboardWidget::SetEntries(const TArray<FLeaderboardEntry>& Entries)
 {
-    CurrentEntries = Entries;
+    OwnerEntry = FLeaderboardEntry();
+    NextCursor.Empty();
+    PrevCursor.Empty();
+    ApplyEntries(Entries);
+}
+
+void ULeaderboardWidget::ApplyEntries(const TArray<FLeaderboardEntry>& Entries)
+{
+    TMap<FString, ULeaderboardEntryItem*> Previous;
+    Previous.Reserve(Items.Num());
+    for (ULeaderboardEntryItem* Item : Items)
+    {
+        Previous.Add(Item->Entry.PlayerId.IsEmpty() ? Item->Entry.PlayerName : Item->Entry.PlayerId, Item);
+    }
+
+    Items.Reset();
+    ChangedItems.Reset();
+
+    const int32 DisplayCount = FMath::Min(Entries.Num(), MaxDisplayEntries);
+    for (int32 i = 0; i < DisplayCount; i++)
+    {
+        const FLeaderboardEntry& Entry = Entries[i];
+        const FString Key = Entry.PlayerId.IsEmpty() ? Entry.PlayerName : Entry.PlayerId;
+
+        ULeaderboardEntryItem* Item = nullptr;
+        int32 RankDelta = 0;
+        if (Previous.RemoveAndCopyValue(Key, Item))
+        {
+            RankDelta = Item->Entry.Rank - Entry.Rank;
+            const bool bSame = RankDelta == Item->RankDelta && Item->Entry.Rank == Entry.Rank
+                && Item->Entry.Score == Entry.Score && Item->Entry.PlayerName == Entry.PlayerName
+                && Item->Entry.bIsLocalPlayer == Entry.bIsLocalPlayer;
+            if (bSame)
+            {
+                Items.Add(Item);
+                continue;
+            }
+        }
+        else
+        {
+            Item = FreeItems.Num() > 0 ? FreeItems.Pop(/*bAllowShrinking=*/false) : NewObject<ULeaderboardEntryItem>(this);
+        }
+
+        Item->Entry = Entry;
+        Item->RankDelta = RankDelta;
+        FormatItem(*Item);
+        Items.Add(Item);
+        ChangedItems.Add(Item);
+    }
+
+    for (const TPair<FString, ULeaderboardEntryItem*>& Left : Previous)
+    {
+        FreeItems.Add(Left.Value);
+    }
+
     RebuildDisplay();
 }
 
-void ULeaderboardWidget::SetActiveTab(ELeaderboardType Type)
+void ULeaderboardWidget::ResetItems()
 {
-    CurrentTab = Type;
-    OnRefreshRequested.Broadcast(Type);
+    FreeItems.Append(Items);
+    Items.Reset();
+    ChangedItems.Reset();
 }
 
 void ULeaderboardWidget::OnRefreshClicked()
@@ -127,11 +358,12 @@ FString ULeaderboardWidget::FormatScore(int64 Score, ELeaderboardType Type) cons
     case ELeaderboardType::SpeedRunFloor5:
     case ELeaderboardType::SpeedRunFloor10:
     {
-        // Score is time in milliseconds (lower is better)
-        int32 TotalSecs = Score / 1000;
+        // Score is time in milliseconds (lower is better); the server writes it negated
+        const int64 TimeMs = FMath::Abs(Score);
+        int32 TotalSecs = TimeMs / 1000;
         int32 Mins = TotalSecs / 60;
         int32 Secs = TotalSecs % 60;
-        int32 Ms = Score % 1000;
+        int32 Ms = TimeMs % 1000;
         return FString::Printf(TEXT("%02d:%02d.%03d"), Mins, Secs, Ms);
     }
 
@@ -140,76 +372,121 @@ FString ULeaderboardWidget::FormatScore(int64 Score, ELeaderboardType Type) cons
     }
 }
 
-void ULeaderboardWidget::RebuildDisplay()
+void ULeaderboardWidget::FormatItem(ULeaderboardEntryItem& Item) const
 {
-    if (!EntryScrollBox) return;
+    const FLeaderboardEntry& Entry = Item.Entry;
+    FString ScoreStr = FormatScore(Entry.Score, CurrentTab);
+    FString DisplayText = FString::Printf(TEXT("#%-3d  %-20s  %s"),
+        Entry.Rank, *Entry.PlayerName, *ScoreStr);
+    if (Item.RankDelta != 0)
+    {
+        DisplayText += FString::Printf(TEXT("  %+d"), Item.RankDelta);
+    }
 
-    EntryScrollBox->ClearChildren();
+    Item.DisplayText = FText::FromString(DisplayText);
+    Item.Color = Entry.bIsLocalPlayer ? FLinearColor(0.3f, 1.0f, 0.5f) // Highlighted green
+        : GetRankColor(Entry.Rank);
+    Item.FontSize = Entry.Rank <= 3 ? 14 : 12;
+}
 
-    // Title update
-    if (TitleText)
+void ULeaderboardWidget::RebuildDisplay()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Leaderboard_RebuildDisplay);
+    UpdateTitle();
+
+    if (EntryListView)
     {
-        FString TabName;
-        switch (CurrentTab)
+        // The list keeps the rows of items it already shows; redraw only those that changed
+        EntryListView->SetListItems(Items);
+        for (ULeaderboardEntryItem* Item : ChangedItems)
         {
-        case ELeaderboardType::HighestFloor:   TabName = TEXT("Highest Floor"); break;
-        case ELeaderboardType::SpeedRunFloor1: TabName = TEXT("Floor 1 Speed"); break;
-        case ELeaderboardType::SpeedRunFloor5: TabName = TEXT("Floor 5 Speed"); break;
-        case ELeaderboardType::SpeedRunFloor10:TabName = TEXT("Floor 10 Speed"); break;
+            if (ULeaderboardEntryRow* Row = EntryListView->GetEntryWidgetFromItem<ULeaderboardEntryRow>(Item))
+            {
+                Row->SetItem(*Item);
+            }
         }
-        TitleText->SetText(FText::FromString(FString::Printf(TEXT("LEADERBOARD - %s"), *TabName)));
     }
-
-    int32 LocalRank = -1;
-    int64 LocalScore = 0;
-
-    int32 DisplayCount = FMath::Min(CurrentEntries.Num(), MaxDisplayEntries);
-    for (int32 i = 0; i < DisplayCount; i++)
+    else if (Rows.IsValid())
     {
-        const FLeaderboardEntry& Entry = CurrentEntries[i];
-
-        UTextBlock* EntryText = NewObject<UTextBlock>(this);
+        Rows.BeginUpdate();
+        for (const ULeaderboardEntryItem* Item : Items)
+        {
+            const FLeaderboardEntry& Entry = Item->Entry;
+            bool bCreated = false;
+            UTextBlock* EntryText = Rows.Row<UTextBlock>(Entry.PlayerId.IsEmpty() ? Entry.PlayerName : Entry.PlayerId,
+                bCreated, Item->FontSize > 12 ? FName(TEXT("Podium")) : NAME_None);
+            if (bCreated)
+            {
+                FSlateFontInfo Font = EntryText->GetFont();
+                Font.Size = Item->FontSize;
+                EntryText->SetFont(Font);
+            }
+            FKeyedWidgetRows::SetText(EntryText, Item->DisplayText.ToString());
+            FKeyedWidgetRows::SetColor(EntryText, Item->Color);
+        }
+        Rows.EndUpdate();
+    }
+    ChangedItems.Reset();
 
-        FString ScoreStr = FormatScore(Entry.Score, CurrentTab);
-        FString DisplayText = FString::Printf(TEXT("#%-3d  %-20s  %s"),
-            Entry.Rank, *Entry.PlayerName, *ScoreStr);
+    if (PrevPageButton)
+    {
+        PrevPageButton->SetIsEnabled(HasPrevPage());
+    }
+    if (NextPageButton)
+    {
+        NextPageButton->SetIsEnabled(HasNextPage());
+    }
 
-        EntryText->SetText(FText::FromString(DisplayText));
+    UpdateFooter();
+}
 
-        FLinearColor EntryColor;
-        if (Entry.bIsLocalPlayer)
-        {
-            EntryColor = FLinearColor(0.3f, 1.0f, 0.5f); // Highlighted green
-            LocalRank = Entry.Rank;
-            LocalScore = Entry.Score;
-        }
-        else
-        {
-            EntryColor = GetRankColor(Entry.Rank);
-        }
-        EntryText->SetColorAndOpacity(FSlateColor(EntryColor));
+void ULeaderboardWidget::UpdateTitle()
+{
+    if (!TitleText) return;
 
-        FSlateFontInfo Font = EntryText->GetFont();
-        Font.Size = Entry.Rank <= 3 ? 14 : 12;
-        EntryText->SetFont(Font);
+    FString TabName;
+    switch (CurrentTab)
+    {
+    case ELeaderboardType::HighestFloor:   TabName = TEXT("Highest Floor"); break;
+    case ELeaderboardType::SpeedRunFloor1: TabName = TEXT("Floor 1 Speed"); break;
+    case ELeaderboardType::SpeedRunFloor5: TabName = TEXT("Floor 5 Speed"); break;
+    case ELeaderboardType::SpeedRunFloor10:TabName = TEXT("Floor 10 Speed"); break;
+    }
 
-        EntryScrollBox->AddChild(EntryText);
+    FString Title = FString::Printf(TEXT("LEADERBOARD - %s"), *TabName);
+    if (Window != ELeaderboardWindow::Top && Items.Num() > 0)
+    {
+        Title += FString::Printf(TEXT("  (#%d-%d)"), Items[0]->Entry.Rank, Items.Last()->Entry.Rank);
     }
+    FKeyedWidgetRows::SetText(TitleText, Title);
+}
+
+void ULeaderboardWidget::UpdateFooter()
+{
+    if (!PlayerRankText) return;
 
-    // Player rank footer
-    if (PlayerRankText)
+    FLeaderboardEntry Local = OwnerEntry;
+    if (Local.Rank <= 0)
     {
-        if (LocalRank > 0)
+        for (const ULeaderboardEntryItem* Item : Items)
         {
-            FString ScoreStr = FormatScore(LocalScore, CurrentTab);
-            PlayerRankText->SetText(FText::FromString(
-                FString::Printf(TEXT("Your rank: #%d (%s)"), LocalRank, *ScoreStr)));
-            PlayerRankText->SetColorAndOpacity(FSlateColor(FLinearColor(0.3f, 1.0f, 0.5f)));
-        }
-        else
-        {
-            PlayerRankText->SetText(FText::FromString(TEXT("Not ranked")));
-            PlayerRankText->SetColorAndOpacity(FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f)));
+            if (Item->Entry.bIsLocalPlayer)
+            {
+                Local = Item->Entry;
+                break;
+            }
         }
     }
+
+    if (Local.Rank > 0)
+    {
+        FString ScoreStr = FormatScore(Local.Score, CurrentTab);
+        FKeyedWidgetRows::SetText(PlayerRankText, FString::Printf(TEXT("Your rank: #%d (%s)"), Local.Rank, *ScoreStr));
+        FKeyedWidgetRows::SetColor(PlayerRankText, FLinearColor(0.3f, 1.0f, 0.5f));
+    }
+    else
+    {
+        FKeyedWidgetRows::SetText(PlayerRankText, TEXT("Not ranked"));
+        FKeyedWidgetRows::SetColor(PlayerRankText, FLinearColor(0.5f, 0.5f, 0.5f));
+    }
 }
@@ -2,11 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
 #include "LeaderboardWidget.generated.h"
 
 class UScrollBox;
+class UListView;
 class UTextBlock;
 class UButton;
+class ULeaderboardEntryItem;
 
 /**
  * Leaderboard entry data.
@@ -44,6 +47,18 @@ enum class ELeaderboardType : uint8
     SpeedRunFloor10 UMETA(DisplayName = "Floor 10 Speed"),
 };
 
+/**
+ * Which slice of a leaderboard is shown. Only that slice is fetched.
+ */
+UENUM(BlueprintType)
+enum class ELeaderboardWindow : uint8
+{
+    Top       UMETA(DisplayName = "Top"),
+    AroundMe  UMETA(DisplayName = "Around Me"),
+    /** A cursor page reached with Next/Prev from the top or around-me window */
+    Page      UMETA(DisplayName = "Page"),
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLeaderboardRefresh, ELeaderboardType, Type);
 
 /**
@@ -59,10 +74,18 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLeaderboardRefresh, ELeaderboardT
  *   ...
  *   -----
  *   Your rank: #N (Score)
- *   [Refresh]
+ *   [Top] [Around Me] [<] [>] [Refresh]
  *
  * Top 3 entries are gold/silver/bronze colored.
  * Local player entry is highlighted.
+ *
+ * Only a window of MaxDisplayEntries records is fetched through
+ * UNakamaSubsystem: the top, the records around the player, or the cursor
+ * page before/after the shown one, so opening a board costs the same at any
+ * ladder size. A refresh is diffed against the shown window by player: rows
+ * that didn't change are left alone, and moved players show how many places
+ * they gained or lost ("+3"). Rows go in EntryListView when bound (the list
+ * only creates widgets for what's on screen), else in EntryScrollBox.
  */
 UCLASS()
 class TOWERGAME_API ULeaderboardWidget : public UUserWidget
@@ -71,10 +94,11 @@ class TOWERGAME_API ULeaderboardWidget : public UUserWidget
 
 public:
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
 
     // ============ API ============
 
-    /** Populate from Nakama leaderboard JSON */
+    /** Populate from a Nakama leaderboard record list (records, owner_records, cursors) */
     UFUNCTION(BlueprintCallable, Category = "Leaderboard")
     void PopulateFromJson(const FString& LeaderboardJson, ELeaderboardType Type);
 
@@ -82,7 +106,7 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Leaderboard")
     void SetEntries(const TArray<FLeaderboardEntry>& Entries);
 
-    /** Set current leaderboard tab */
+    /** Set current leaderboard tab and fetch its top window */
     UFUNCTION(BlueprintCallable, Category = "Leaderboard")
     void SetActiveTab(ELeaderboardType Type);
 
@@ -90,11 +114,45 @@ public:
     UFUNCTION(BlueprintPure, Category = "Leaderboard")
     ELeaderboardType GetActiveTab() const { return CurrentTab; }
 
+    UFUNCTION(BlueprintCallable, Category = "Leaderboard")
+    void ShowTop();
+
+    UFUNCTION(BlueprintCallable, Category = "Leaderboard")
+    void ShowAroundMe();
+
+    /** The page after / before the shown window; nothing at either end of the board */
+    UFUNCTION(BlueprintCallable, Category = "Leaderboard")
+    void ShowNextPage();
+
+    UFUNCTION(BlueprintCallable, Category = "Leaderboard")
+    void ShowPrevPage();
+
+    /** Fetch the shown window again */
+    UFUNCTION(BlueprintCallable, Category = "Leaderboard")
+    void Refresh();
+
+    UFUNCTION(BlueprintPure, Category = "Leaderboard")
+    ELeaderboardWindow GetWindow() const { return Window; }
+
+    UFUNCTION(BlueprintPure, Category = "Leaderboard")
+    bool HasNextPage() const { return !NextCursor.IsEmpty(); }
+
+    UFUNCTION(BlueprintPure, Category = "Leaderboard")
+    bool HasPrevPage() const { return !PrevCursor.IsEmpty(); }
+
+    /** Nakama leaderboard id of a tab, as the server module creates them */
+    static FString GetLeaderboardId(ELeaderboardType Type);
+
     // ============ Config ============
 
+    /** Records per window, and the fetch limit */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Leaderboard")
     int32 MaxDisplayEntries = 20;
 
+    /** Fetch windows through UNakamaSubsystem; off when something else feeds PopulateFromJson */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Leaderboard")
+    bool bFetchFromNakama = true;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Leaderboard")
     FString LocalPlayerId;
 
@@ -111,12 +169,28 @@ public:
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
     UScrollBox* EntryScrollBox;
 
+    /** Preferred over EntryScrollBox; its entry class should derive from ULeaderboardEntryRow */
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
+    UListView* EntryListView;
+
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
     UTextBlock* PlayerRankText;
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
     UButton* RefreshButton;
 
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
+    UButton* TopButton;
+
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
+    UButton* AroundMeButton;
+
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
+    UButton* PrevPageButton;
+
+    UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
+    UButton* NextPageButton;
+
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Leaderboard")
     UButton* TabHighestFloor;
 
@@ -145,13 +219,49 @@ protected:
     UFUNCTION()
     void OnTabSpeed10Clicked();
 
+    UFUNCTION()
+    void OnLeaderboardReceived(bool bSuccess, const FString& ResponseJson);
+
+    /** Ask for the current tab's Window (OnRefreshRequested, and Nakama when enabled) */
+    void RequestWindow();
+
+    /** Diff Entries against the shown rows and update what changed */
+    void ApplyEntries(const TArray<FLeaderboardEntry>& Entries);
+
+    /** Forget the shown rows (a tab switch: the ranks aren't comparable) */
+    void ResetItems();
+
     void RebuildDisplay();
+    void UpdateTitle();
+    void UpdateFooter();
+    void FormatItem(ULeaderboardEntryItem& Item) const;
     FLinearColor GetRankColor(int32 Rank) const;
     FString FormatScore(int64 Score, ELeaderboardType Type) const;
 
 private:
+    /** The shown window in rank order, one item per player */
+    UPROPERTY()
+    TArray<ULeaderboardEntryItem*> Items;
+
+    /** Items of players who left the window, for reuse */
+    UPROPERTY()
+    TArray<ULeaderboardEntryItem*> FreeItems;
+
+    /** Items whose row needs redrawing after ApplyEntries */
+    TArray<ULeaderboardEntryItem*> ChangedItems;
+
+    /** EntryScrollBox rows keyed by player */
     UPROPERTY()
-    TArray<FLeaderboardEntry> CurrentEntries;
+    FKeyedWidgetRows Rows;
+
+    /** The local player's record from the last fetch, even when outside the window */
+    FLeaderboardEntry OwnerEntry;
 
     ELeaderboardType CurrentTab = ELeaderboardType::HighestFloor;
+    ELeaderboardWindow Window = ELeaderboardWindow::Top;
+
+    /** Cursor the shown page was fetched with, and those of its neighbours */
+    FString PageCursor;
+    FString NextCursor;
+    FString PrevCursor;
 };
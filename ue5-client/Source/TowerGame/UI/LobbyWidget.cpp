@@ -1,4 +1,5 @@
 #include "LobbyWidget.h"
+#include "Core/StartupTimeline.h"
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
@@ -7,11 +8,15 @@
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void ULobbyWidget::NativeConstruct()
 {
     Super::NativeConstruct();
 
+    // The first screen a player can act on; the startup timeline ends here
+    FTowerStartupTimeline::MarkReady(TEXT("Lobby"));
+
     if (CreateButton)
     {
         CreateButton->OnClicked.AddDynamic(this, &ULobbyWidget::OnCreateClicked);
@@ -143,6 +148,7 @@ void ULobbyWidget::RequestJoinMatch(const FString& MatchId)
 
 void ULobbyWidget::RebuildMatchList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Lobby_RebuildMatchList);
     if (!MatchListBox) return;
 
     MatchListBox->ClearChildren();
@@ -6,10 +6,15 @@
 #include "Components/VerticalBox.h"
 #include "Components/HorizontalBox.h"
 #include "Bridge/ProceduralCoreBridge.h"
+#include "Core/TowerLog.h"
 #include "Kismet/GameplayStatics.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 
+static_assert(static_cast<uint8>(ELogLevel::Trace) == static_cast<uint8>(ETowerLogLevel::Trace)
+	&& static_cast<uint8>(ELogLevel::Error) == static_cast<uint8>(ETowerLogLevel::Error),
+	"ELogLevel and ETowerLogLevel must stay in the same order");
+
 void ULoggingConfigWidget::NativeConstruct()
 {
 	Super::NativeConstruct();
@@ -75,20 +80,21 @@ void ULoggingConfigWidget::NativeConstruct()
 
 void ULoggingConfigWidget::ApplyConfiguration()
 {
+	// The client's structured log takes the same config; filters naming Rust modules are ignored there
+	FTowerLog::Configure(static_cast<ETowerLogLevel>(PendingConfig.DefaultLevel), PendingConfig.ModuleFilters,
+		PendingConfig.bShowTimestamps, PendingConfig.bShowThreadIds, PendingConfig.bShowTargets, PendingConfig.bShowFileLine);
+
 	FProceduralCoreBridge* Bridge = GetBridge();
-	if (!Bridge || !Bridge->IsInitialized())
+	if (Bridge && Bridge->IsInitialized())
 	{
-		DisplayMessage(TEXT("ERROR: Bridge not initialized"), false);
-		return;
-	}
+		// Serialize config to JSON
+		FString ConfigJson = SerializeConfigToJson();
 
-	// Serialize config to JSON
-	FString ConfigJson = SerializeConfigToJson();
-
-	// Call Rust logging_init with config
-	// Note: The bridge needs to expose logging_init function
-	// For now, we'll log the JSON and assume it would be called
-	UE_LOG(LogTemp, Log, TEXT("Applying logging config: %s"), *ConfigJson);
+		// Call Rust logging_init with config
+		// Note: The bridge needs to expose logging_init function
+		// For now, we'll log the JSON and assume it would be called
+		UE_LOG(LogTemp, Log, TEXT("Applying logging config: %s"), *ConfigJson);
+	}
 
 	// Update current config
 	CurrentConfig = PendingConfig;
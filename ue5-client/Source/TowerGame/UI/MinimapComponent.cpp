@@ -1,7 +1,15 @@
 #include "MinimapComponent.h"
+#include "World/ProximityQuerySubsystem.h"
+#include "World/GameplayEventSubsystem.h"
+#include "Core/TowerGameSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "Engine/Texture2D.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "EngineUtils.h"
 
 UMinimapComponent::UMinimapComponent()
 {
@@ -11,7 +19,34 @@ UMinimapComponent::UMinimapComponent()
 void UMinimapComponent::BeginPlay()
 {
     Super::BeginPlay();
-    SetupCapture();
+    if (Mode == EMinimapMode::SceneCapture)
+    {
+        SetupCapture();
+    }
+    else
+    {
+        BindFloorRenderer();
+    }
+}
+
+void UMinimapComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (FloorRenderer)
+    {
+        FloorRenderer->OnFloorGenerated.RemoveDynamic(this, &UMinimapComponent::HandleFloorGenerated);
+        FloorRenderer->OnTileMutated.RemoveDynamic(this, &UMinimapComponent::HandleTileMutated);
+        FloorRenderer = nullptr;
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
+UTexture* UMinimapComponent::GetMinimapTexture() const
+{
+    if (Mode == EMinimapMode::SceneCapture)
+    {
+        return RenderTarget;
+    }
+    return TileTexture;
 }
 
 void UMinimapComponent::SetupCapture()
@@ -63,11 +98,26 @@ void UMinimapComponent::TickComponent(float DeltaTime, ELevelTick TickType, FAct
     if (CaptureTimer >= CaptureInterval)
     {
         CaptureTimer = 0.0f;
-        UpdateCapturePosition();
 
-        if (CaptureComponent)
+        if (Mode == EMinimapMode::SceneCapture)
         {
-            CaptureComponent->CaptureScene();
+            UpdateCapturePosition();
+
+            if (CaptureComponent)
+            {
+                CaptureComponent->CaptureScene();
+            }
+            return;
+        }
+
+        // The GameMode spawns the renderer with the first floor, possibly after us
+        if (!FloorRenderer && !BindFloorRenderer()) return;
+
+        if (TileTexture && GetOwner())
+        {
+            RevealAround(GetOwner()->GetActorLocation());
+            FlushTexture();
+            UpdateMarkers();
         }
     }
 }
@@ -98,6 +148,278 @@ void UMinimapComponent::UpdateCapturePosition()
     }
 }
 
+// ============ Tiles ============
+
+bool UMinimapComponent::BindFloorRenderer()
+{
+    TActorIterator<ATowerProceduralFloorRenderer> It(GetWorld());
+    if (!It) return false;
+
+    FloorRenderer = *It;
+    FloorRenderer->OnFloorGenerated.AddDynamic(this, &UMinimapComponent::HandleFloorGenerated);
+    FloorRenderer->OnTileMutated.AddDynamic(this, &UMinimapComponent::HandleTileMutated);
+
+    // Joined after the floor was already built
+    if (FloorRenderer->TotalRenderedTiles > 0)
+    {
+        RasterizeFloor();
+    }
+    return true;
+}
+
+void UMinimapComponent::HandleFloorGenerated(int32 TotalTiles)
+{
+    RasterizeFloor();
+}
+
+void UMinimapComponent::HandleTileMutated(int32 X, int32 Y, ETowerTileType NewType)
+{
+    if (!TileTexture) return;
+
+    if (!TileBounds.Contains(FIntPoint(X, Y)))
+    {
+        // The grid grew past the texture; start over at the new size
+        RasterizeFloor();
+        return;
+    }
+
+    const int32 LX = X - TileBounds.Min.X;
+    const int32 LY = Y - TileBounds.Min.Y;
+    const int32 Index = LY * TileBounds.Width() + LX;
+    if (!Discovered[Index]) return;
+
+    TilePixels[Index] = GetTileColor(NewType);
+    MarkDirty(LX, LY);
+}
+
+void UMinimapComponent::RasterizeFloor()
+{
+    if (!FloorRenderer) return;
+
+    TileBounds = FloorRenderer->GetGridBounds();
+    const int32 Width = TileBounds.Width();
+    const int32 Height = TileBounds.Height();
+    if (Width <= 0 || Height <= 0)
+    {
+        TileTexture = nullptr;
+        return;
+    }
+
+    if (!TileTexture || TileTexture->GetSizeX() != Width || TileTexture->GetSizeY() != Height)
+    {
+        TileTexture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
+        TileTexture->Filter = TF_Nearest;
+        TileTexture->SRGB = true;
+        TileTexture->UpdateResource();
+    }
+
+    // Everything starts under fog; the texture is only ever written from TilePixels
+    TilePixels.Init(FColor::Transparent, Width * Height);
+    Discovered.Init(false, Width * Height);
+    DiscoveredRooms.Init(false, FloorRenderer->CachedRooms.Num());
+
+    DirtyRect = FIntRect(0, 0, Width, Height);
+    bHasDirty = true;
+
+    if (GetOwner())
+    {
+        RevealAround(GetOwner()->GetActorLocation());
+    }
+    FlushTexture();
+
+    UE_LOG(LogTemp, Log, TEXT("Minimap rasterized: %dx%d tiles, %d rooms"), Width, Height, DiscoveredRooms.Num());
+}
+
+void UMinimapComponent::RevealAround(const FVector& Location)
+{
+    int32 CX, CY;
+    FloorRenderer->WorldToGrid(Location, CX, CY);
+
+    const int32 RoomIdx = FloorRenderer->GetRoomIndexAt(CX, CY);
+    if (DiscoveredRooms.IsValidIndex(RoomIdx) && !DiscoveredRooms[RoomIdx])
+    {
+        DiscoveredRooms[RoomIdx] = true;
+
+        UGameInstance* GI = GetWorld()->GetGameInstance();
+        UTowerGameSubsystem* Sub = GI ? GI->GetSubsystem<UTowerGameSubsystem>() : nullptr;
+        UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>();
+        if (Sub && Events)
+        {
+            Events->PostFloorProgress({ Sub->CurrentFloor, ETowerFloorProgress::RoomDiscovered });
+        }
+
+        // One ring past the room's rectangle so its walls show too
+        const FRoomRenderData& Room = FloorRenderer->CachedRooms[RoomIdx];
+        for (int32 Y = Room.Y - 1; Y <= Room.Y + Room.Height; Y++)
+        {
+            for (int32 X = Room.X - 1; X <= Room.X + Room.Width; X++)
+            {
+                RevealCell(X, Y);
+            }
+        }
+    }
+
+    const int32 RadiusSq = RevealRadiusTiles * RevealRadiusTiles;
+    for (int32 DY = -RevealRadiusTiles; DY <= RevealRadiusTiles; DY++)
+    {
+        for (int32 DX = -RevealRadiusTiles; DX <= RevealRadiusTiles; DX++)
+        {
+            if (DX * DX + DY * DY <= RadiusSq)
+            {
+                RevealCell(CX + DX, CY + DY);
+            }
+        }
+    }
+}
+
+void UMinimapComponent::RevealCell(int32 X, int32 Y)
+{
+    if (!TileBounds.Contains(FIntPoint(X, Y))) return;
+
+    const int32 LX = X - TileBounds.Min.X;
+    const int32 LY = Y - TileBounds.Min.Y;
+    const int32 Index = LY * TileBounds.Width() + LX;
+    if (Discovered[Index]) return;
+
+    Discovered[Index] = true;
+    TilePixels[Index] = GetTileColor(FloorRenderer->GetTileAt(X, Y));
+    MarkDirty(LX, LY);
+}
+
+void UMinimapComponent::MarkDirty(int32 LX, int32 LY)
+{
+    if (!bHasDirty)
+    {
+        DirtyRect = FIntRect(LX, LY, LX + 1, LY + 1);
+        bHasDirty = true;
+        return;
+    }
+    DirtyRect.Min = DirtyRect.Min.ComponentMin(FIntPoint(LX, LY));
+    DirtyRect.Max = DirtyRect.Max.ComponentMax(FIntPoint(LX + 1, LY + 1));
+}
+
+void UMinimapComponent::FlushTexture()
+{
+    if (!bHasDirty || !TileTexture) return;
+    bHasDirty = false;
+
+    // The upload happens on the render thread later, so it gets its own copy of the rows
+    const int32 Width = DirtyRect.Width();
+    const int32 Height = DirtyRect.Height();
+    const int32 Pitch = Width * sizeof(FColor);
+    uint8* Data = new uint8[Pitch * Height];
+    for (int32 Row = 0; Row < Height; Row++)
+    {
+        const int32 Src = (DirtyRect.Min.Y + Row) * TileBounds.Width() + DirtyRect.Min.X;
+        FMemory::Memcpy(Data + Row * Pitch, &TilePixels[Src], Pitch);
+    }
+
+    FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(DirtyRect.Min.X, DirtyRect.Min.Y, 0, 0, Width, Height);
+    TileTexture->UpdateTextureRegions(0, 1, Region, Pitch, sizeof(FColor), Data,
+        [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+        {
+            delete[] SrcData;
+            delete Regions;
+        });
+}
+
+void UMinimapComponent::UpdateMarkers()
+{
+    Markers.Reset();
+
+    AActor* Owner = GetOwner();
+    const FVector OwnerLoc = Owner->GetActorLocation();
+
+    FMinimapMarker& Self = Markers.AddDefaulted_GetRef();
+    Self.Kind = EMinimapMarkerKind::Self;
+    Self.UV = WorldToUV(OwnerLoc);
+    Self.Yaw = Owner->GetActorRotation().Yaw;
+
+    if (AGameStateBase* GameState = GetWorld()->GetGameState())
+    {
+        for (APlayerState* PlayerState : GameState->PlayerArray)
+        {
+            APawn* Pawn = PlayerState ? PlayerState->GetPawn() : nullptr;
+            if (!Pawn || Pawn == Owner) continue;
+
+            FMinimapMarker& Ally = Markers.AddDefaulted_GetRef();
+            Ally.Kind = EMinimapMarkerKind::Ally;
+            Ally.UV = WorldToUV(Pawn->GetActorLocation());
+            Ally.Yaw = Pawn->GetActorRotation().Yaw;
+        }
+    }
+
+    // Only what's near enough to be on the map, from the proximity grid, and only over explored tiles
+    UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>();
+    if (!Proximity) return;
+
+    const float ViewRadius = OrthoWidth * ZoomLevel * UE_HALF_SQRT_2;
+    TArray<AActor*> Nearby;
+    const TPair<EProximityChannel, EMinimapMarkerKind> Channels[] = {
+        { EProximityChannel::Monster, EMinimapMarkerKind::Monster },
+        { EProximityChannel::Echo, EMinimapMarkerKind::Echo } };
+    for (const TPair<EProximityChannel, EMinimapMarkerKind>& Channel : Channels)
+    {
+        Nearby.Reset();
+        Proximity->QueryRadius(OwnerLoc, ViewRadius, Channel.Key, Nearby);
+        for (AActor* Actor : Nearby)
+        {
+            int32 X, Y;
+            FloorRenderer->WorldToGrid(Actor->GetActorLocation(), X, Y);
+            if (!TileBounds.Contains(FIntPoint(X, Y))) continue;
+            if (!Discovered[(Y - TileBounds.Min.Y) * TileBounds.Width() + (X - TileBounds.Min.X)]) continue;
+
+            FMinimapMarker& Marker = Markers.AddDefaulted_GetRef();
+            Marker.Kind = Channel.Value;
+            Marker.UV = WorldToUV(Actor->GetActorLocation());
+            Marker.Yaw = Actor->GetActorRotation().Yaw;
+        }
+    }
+}
+
+FVector2D UMinimapComponent::WorldToUV(const FVector& Location) const
+{
+    if (!FloorRenderer || TileBounds.Area() <= 0) return FVector2D::ZeroVector;
+
+    // Cell (X,Y) is centred on X * TileSize, so its texel spans +-half a tile around that
+    const FVector Local = (Location - FloorRenderer->GetActorLocation()) / FloorRenderer->RenderConfig.TileSize;
+    return FVector2D(
+        (Local.X - TileBounds.Min.X + 0.5) / TileBounds.Width(),
+        (Local.Y - TileBounds.Min.Y + 0.5) / TileBounds.Height());
+}
+
+void UMinimapComponent::GetViewUV(FVector2D& OutMin, FVector2D& OutMax) const
+{
+    OutMin = FVector2D::ZeroVector;
+    OutMax = FVector2D(1.0f, 1.0f);
+    if (!FloorRenderer || TileBounds.Area() <= 0 || !GetOwner()) return;
+
+    const float HalfTiles = OrthoWidth * ZoomLevel * 0.5f / FloorRenderer->RenderConfig.TileSize;
+    const FVector2D HalfUV(HalfTiles / TileBounds.Width(), HalfTiles / TileBounds.Height());
+    const FVector2D Center = WorldToUV(GetOwner()->GetActorLocation());
+    OutMin = Center - HalfUV;
+    OutMax = Center + HalfUV;
+}
+
+FColor UMinimapComponent::GetTileColor(ETowerTileType Type)
+{
+    switch (Type)
+    {
+    case ETowerTileType::Floor:
+    case ETowerTileType::Spawner:    return FColor(96, 92, 84);
+    case ETowerTileType::Wall:       return FColor(200, 196, 186);
+    case ETowerTileType::Door:       return FColor(168, 120, 64);
+    case ETowerTileType::StairsUp:
+    case ETowerTileType::StairsDown: return FColor(80, 220, 120);
+    case ETowerTileType::Chest:      return FColor(240, 200, 60);
+    case ETowerTileType::Trap:       return FColor(200, 60, 50);
+    case ETowerTileType::Shrine:     return FColor(170, 110, 230);
+    case ETowerTileType::WindColumn: return FColor(180, 240, 210);
+    case ETowerTileType::VoidPit:    return FColor(30, 10, 45);
+    default:                         return FColor::Transparent;
+    }
+}
+
 void UMinimapComponent::ZoomIn()
 {
     ZoomLevel = FMath::Max(0.25f, ZoomLevel * 0.75f);
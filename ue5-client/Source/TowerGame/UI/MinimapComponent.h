@@ -2,25 +2,64 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Rendering/ProceduralFloorRenderer.h"
 #include "MinimapComponent.generated.h"
 
 class USceneCaptureComponent2D;
 class UTextureRenderTarget2D;
+class UTexture2D;
+
+/** How the minimap image is produced */
+UENUM(BlueprintType)
+enum class EMinimapMode : uint8
+{
+    /** The floor grid painted into a texture, one texel per tile, with fog of war */
+    Tiles        UMETA(DisplayName = "Tiles"),
+    /** A top-down scene capture re-rendered CaptureRate times a second */
+    SceneCapture UMETA(DisplayName = "Scene Capture"),
+};
+
+UENUM(BlueprintType)
+enum class EMinimapMarkerKind : uint8
+{
+    Self,
+    Ally,
+    Monster,
+    Echo,
+};
+
+/** Something drawn over the tile texture; positions are in its UV space */
+USTRUCT(BlueprintType)
+struct FMinimapMarker
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Minimap")
+    EMinimapMarkerKind Kind = EMinimapMarkerKind::Monster;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Minimap")
+    FVector2D UV = FVector2D::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Minimap")
+    float Yaw = 0.0f;
+};
 
 /**
  * Top-down minimap that renders the floor layout.
  *
- * Uses a SceneCapture2D pointing downward from above the player.
- * Shows:
- * - Floor tiles (from FloorBuilder)
- * - Player position (centered)
- * - Monster positions (red dots)
- * - Echo positions (blue/green dots)
- * - Chest/Shrine markers
- * - Stairs marker (when unlocked)
+ * In Tiles mode (the default) the floor renderer's grid is painted once per
+ * floor into a small texture, one texel per tile. Fog of war lifts around the
+ * player and a whole room at a time on first entry; only the texels that
+ * change are uploaded, and tile mutations repaint just their cell. Players,
+ * monsters and echoes aren't in the texture: GetMarkers lists them in its UV
+ * space for the widget to draw on top, and GetViewUV gives the region around
+ * the player to show at the current zoom.
  *
- * Attach to the player character. The render target can be
- * bound to a UMG Image widget for HUD display.
+ * SceneCapture mode keeps the old SceneCapture2D pointing down from above
+ * the player, for floors built without the procedural renderer.
+ *
+ * Attach to the player character. The texture can be bound to a UMG Image
+ * widget for HUD display.
  */
 UCLASS(ClassGroup = (UI), meta = (BlueprintSpawnableComponent))
 class TOWERGAME_API UMinimapComponent : public UActorComponent
@@ -31,14 +70,29 @@ public:
     UMinimapComponent();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-    /** Get the render target texture for binding to UMG */
+    /** Colour of a tile type in Tiles mode; floor previews share the palette */
+    static FColor GetTileColor(ETowerTileType Type);
+
+    /** Get the minimap texture for binding to UMG (tile texture or render target, by Mode) */
     UFUNCTION(BlueprintPure, Category = "Minimap")
-    UTextureRenderTarget2D* GetMinimapTexture() const { return RenderTarget; }
+    UTexture* GetMinimapTexture() const;
+
+    /** Players, monsters and echoes at the last update (Tiles mode) */
+    UFUNCTION(BlueprintPure, Category = "Minimap")
+    const TArray<FMinimapMarker>& GetMarkers() const { return Markers; }
+
+    /** UV rectangle of the tile texture to show, centred on the player at the current zoom (Tiles mode) */
+    UFUNCTION(BlueprintPure, Category = "Minimap")
+    void GetViewUV(FVector2D& OutMin, FVector2D& OutMax) const;
 
     // ============ Config ============
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
+    EMinimapMode Mode = EMinimapMode::Tiles;
+
     /** Capture height above player */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
     float CaptureHeight = 2000.0f;
@@ -51,10 +105,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
     int32 TextureSize = 256;
 
-    /** Update frequency (captures per second) */
+    /** Update frequency (captures, or fog and marker updates, per second) */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
     float CaptureRate = 5.0f;
 
+    /** Tiles around the player uncovered outside rooms (corridors) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap", meta = (ClampMin = "0"))
+    int32 RevealRadiusTiles = 3;
+
     /** Whether minimap rotates with player facing */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Minimap")
     bool bRotateWithPlayer = false;
@@ -85,4 +143,51 @@ private:
 
     void SetupCapture();
     void UpdateCapturePosition();
+
+    // ============ Tiles ============
+
+    UPROPERTY()
+    ATowerProceduralFloorRenderer* FloorRenderer = nullptr;
+
+    UPROPERTY()
+    UTexture2D* TileTexture = nullptr;
+
+    /** Grid rectangle TileTexture covers */
+    FIntRect TileBounds;
+
+    /** What TileTexture shows, row-major over TileBounds; fogged texels are clear */
+    TArray<FColor> TilePixels;
+    TBitArray<> Discovered;
+    TBitArray<> DiscoveredRooms;
+
+    /** Texels changed since the last upload, in TileBounds-local coordinates */
+    FIntRect DirtyRect;
+    bool bHasDirty = false;
+
+    TArray<FMinimapMarker> Markers;
+
+    /** Find the floor renderer and bind to its events; false while there is none */
+    bool BindFloorRenderer();
+
+    UFUNCTION()
+    void HandleFloorGenerated(int32 TotalTiles);
+
+    UFUNCTION()
+    void HandleTileMutated(int32 X, int32 Y, ETowerTileType NewType);
+
+    /** Size TileTexture to the renderer's grid and start the floor fogged */
+    void RasterizeFloor();
+
+    /** Lift the fog around the player, and over the room they're in on entry */
+    void RevealAround(const FVector& Location);
+    void RevealCell(int32 X, int32 Y);
+
+    /** Grow DirtyRect over the TileBounds-local texel (LX,LY) */
+    void MarkDirty(int32 LX, int32 LY);
+
+    /** Upload the DirtyRect texels of TilePixels */
+    void FlushTexture();
+
+    void UpdateMarkers();
+    FVector2D WorldToUV(const FVector& Location) const;
 };
@@ -42,13 +42,18 @@ void UMutatorWidget::NativeConstruct()
 
 	// Initialize animation state
 	AnimationTime = 0.0f;
+	UTowerUITickSubsystem::Start(this, this, UITickHandle);
 }
 
-void UMutatorWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UMutatorWidget::NativeDestruct()
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
+	UTowerUITickSubsystem::Stop(this, UITickHandle);
+	Super::NativeDestruct();
+}
 
-	UpdateAnimations(InDeltaTime);
+void UMutatorWidget::TickUI(float DeltaTime)
+{
+	UpdateAnimations(DeltaTime);
 }
 
 void UMutatorWidget::InitializeForFloor(int32 FloorNumber, int32 Seed)
@@ -10,6 +10,7 @@
 #include "Components/Image.h"
 #include "Components/Border.h"
 #include "Components/HorizontalBox.h"
+#include "TowerUITickSubsystem.h"
 #include "MutatorWidget.generated.h"
 
 /**
@@ -88,8 +89,8 @@ struct FMutatorEffects
  * - Aggregate effects summary
  * - BEGIN button to confirm and start floor
  */
-UCLASS(BlueprintType)
-class TOWERGAME_API UMutatorWidget : public UUserWidget
+UCLASS(BlueprintType, meta = (DisableNativeTick))
+class TOWERGAME_API UMutatorWidget : public UUserWidget, public ITowerUITickable
 {
 	GENERATED_BODY()
 
@@ -98,7 +99,10 @@ public:
 
 	// Widget lifecycle
 	virtual void NativeConstruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeDestruct() override;
+
+	/** Border pulse, for as long as the widget is constructed */
+	virtual void TickUI(float DeltaTime) override;
 
 	/**
 	 * Initialize the widget with floor data
@@ -171,4 +175,6 @@ private:
 
 	// Animation helpers
 	void UpdateAnimations(float DeltaTime);
+
+	int32 UITickHandle = INDEX_NONE;
 };
@@ -1,21 +1,27 @@
 #include "NotificationWidget.h"
+#include "KeyedWidgetRows.h"
 #include "Components/VerticalBox.h"
 #include "Components/TextBlock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UNotificationWidget::NativeConstruct()
 {
     Super::NativeConstruct();
 }
 
-void UNotificationWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UNotificationWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UNotificationWidget::TickUI(float DeltaTime)
+{
     bool bChanged = false;
 
     for (FNotificationEntry& Entry : ActiveNotifications)
     {
-        Entry.ElapsedTime += InDeltaTime;
+        Entry.ElapsedTime += DeltaTime;
         if (Entry.ElapsedTime >= Entry.Lifetime)
         {
             bChanged = true;
@@ -147,18 +153,45 @@ void UNotificationWidget::ClearAll()
 
 void UNotificationWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Notification_RebuildDisplay);
+    // Only ticked while something can expire
+    if (ActiveNotifications.Num() > 0)
+    {
+        UTowerUITickSubsystem::Start(this, this, UITickHandle);
+    }
+    else
+    {
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
+    }
+
     if (!NotificationBox) return;
-    NotificationBox->ClearChildren();
+    INC_DWORD_STAT(STAT_TowerUI_Rebuilds);
+    FTowerPerfCounters::Add(ETowerPerfCounter::UIRebuilds);
+    NotificationRows.Init(this, NotificationBox);
+    NotificationRows.BeginUpdate();
 
     for (int32 i = 0; i < ActiveNotifications.Num(); i++)
     {
-        const FNotificationEntry& Entry = ActiveNotifications[i];
+        FNotificationEntry& Entry = ActiveNotifications[i];
+        if (Entry.Id == 0)
+        {
+            Entry.Id = NextNotificationId++;
+        }
 
-        UTextBlock* NotifText = NewObject<UTextBlock>(this);
+        // Two sizes of row, so a pooled big one never comes back as a small one
+        const bool bLarge = Entry.Type == ENotificationType::Achievement || Entry.Type == ENotificationType::LevelUp;
+        bool bCreated = false;
+        UTextBlock* NotifText = NotificationRows.Row<UTextBlock>(FString::FromInt(Entry.Id), bCreated,
+            bLarge ? FName(TEXT("Large")) : NAME_None);
+        if (bCreated)
+        {
+            FSlateFontInfo Font = NotifText->GetFont();
+            Font.Size = bLarge ? 14 : 11;
+            NotifText->SetFont(Font);
+        }
 
         FString Prefix = GetTypePrefix(Entry.Type);
-        FString Display = FString::Printf(TEXT("%s %s: %s"), *Prefix, *Entry.Title, *Entry.Message);
-        NotifText->SetText(FText::FromString(Display));
+        FKeyedWidgetRows::SetText(NotifText, FString::Printf(TEXT("%s %s: %s"), *Prefix, *Entry.Title, *Entry.Message));
 
         FLinearColor Color = GetTypeColor(Entry.Type, Entry.ExtraData);
 
@@ -175,15 +208,10 @@ void UNotificationWidget::RebuildDisplay()
         }
 
         Color.A = Alpha;
-        NotifText->SetColorAndOpacity(FSlateColor(Color));
-
-        FSlateFontInfo Font = NotifText->GetFont();
-        Font.Size = (Entry.Type == ENotificationType::Achievement ||
-                     Entry.Type == ENotificationType::LevelUp) ? 14 : 11;
-        NotifText->SetFont(Font);
-
-        NotificationBox->AddChild(NotifText);
+        FKeyedWidgetRows::SetColor(NotifText, Color);
     }
+
+    NotificationRows.EndUpdate();
 }
 
 FLinearColor UNotificationWidget::GetTypeColor(ENotificationType Type, const FString& ExtraData) const
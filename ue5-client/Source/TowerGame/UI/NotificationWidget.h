@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
+#include "TowerUITickSubsystem.h"
 #include "NotificationWidget.generated.h"
 
 class UVerticalBox;
@@ -37,20 +39,27 @@ struct FNotificationEntry
     UPROPERTY(BlueprintReadWrite) float FadeInDuration = 0.3f;
     UPROPERTY(BlueprintReadWrite) float FadeOutDuration = 0.5f;
     UPROPERTY(BlueprintReadWrite) FString ExtraData; // Rarity, faction, etc.
+
+    /** Assigned on first display; keys the entry's row */
+    int32 Id = 0;
 };
 
 /**
  * Toast-style notification system.
  * Queued notifications stack vertically, auto-fade after duration.
+ * Rows are kept per notification and recycled (FKeyedWidgetRows).
  */
-UCLASS()
-class TOWERGAME_API UNotificationWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UNotificationWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Ages notifications and drops expired ones, while any are up */
+    virtual void TickUI(float DeltaTime) override;
 
     // --- API ---
     UFUNCTION(BlueprintCallable) void ShowNotification(const FString& Title,
@@ -73,7 +82,14 @@ protected:
 
     TArray<FNotificationEntry> ActiveNotifications;
 
+    UPROPERTY()
+    FKeyedWidgetRows NotificationRows;
+
+    int32 NextNotificationId = 1;
+
     void RebuildDisplay();
     FLinearColor GetTypeColor(ENotificationType Type, const FString& ExtraData) const;
     FString GetTypePrefix(ENotificationType Type) const;
+
+    int32 UITickHandle = INDEX_NONE;
 };
@@ -1,10 +1,12 @@
 #include "QuestTrackerWidget.h"
+#include "KeyedWidgetRows.h"
 #include "Components/VerticalBox.h"
 #include "Components/TextBlock.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UQuestTrackerWidget::NativeConstruct()
 {
@@ -12,15 +14,19 @@ void UQuestTrackerWidget::NativeConstruct()
     RebuildDisplay();
 }
 
-void UQuestTrackerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UQuestTrackerWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UQuestTrackerWidget::TickUI(float DeltaTime)
+{
     // Tick flash timers
-    TArray<int32> ExpiredKeys;
+    TArray<int32, TInlineAllocator<8>> ExpiredKeys;
     for (auto& Pair : ObjectiveFlashTimers)
     {
-        Pair.Value -= InDeltaTime;
+        Pair.Value -= DeltaTime;
         if (Pair.Value <= 0.0f)
         {
             ExpiredKeys.Add(Pair.Key);
@@ -30,6 +36,17 @@ void UQuestTrackerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaT
     {
         ObjectiveFlashTimers.Remove(Key);
     }
+
+    // Settle the flashed objectives back to their normal colour
+    if (ExpiredKeys.Num() > 0)
+    {
+        RebuildDisplay();
+    }
+
+    if (ObjectiveFlashTimers.Num() == 0)
+    {
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
+    }
 }
 
 void UQuestTrackerWidget::TrackQuest(const FTrackedQuest& Quest)
@@ -71,6 +88,7 @@ void UQuestTrackerWidget::UpdateObjective(int32 QuestId, int32 ObjectiveIndex, i
             // Flash indicator
             int32 FlashKey = QuestId * 100 + ObjectiveIndex;
             ObjectiveFlashTimers.Add(FlashKey, 2.0f);
+            UTowerUITickSubsystem::Start(this, this, UITickHandle);
 
             OnObjectiveUpdated.Broadcast(QuestId, ObjectiveIndex);
 
@@ -151,37 +169,52 @@ FLinearColor UQuestTrackerWidget::GetFactionColor(const FString& Faction) const
 
 void UQuestTrackerWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_QuestTracker_RebuildDisplay);
     if (!QuestListBox) return;
+    INC_DWORD_STAT(STAT_TowerUI_Rebuilds);
+    FTowerPerfCounters::Add(ETowerPerfCounter::UIRebuilds);
 
-    QuestListBox->ClearChildren();
+    QuestRows.Init(this, QuestListBox);
+    QuestRows.BeginUpdate();
+
+    static const FName ObjectiveStyle(TEXT("Objective"));
 
     for (const FTrackedQuest& Quest : TrackedQuests)
     {
         // Quest name header
-        UTextBlock* NameText = NewObject<UTextBlock>(this);
+        bool bCreated = false;
+        UTextBlock* NameText = QuestRows.Row<UTextBlock>(FString::Printf(TEXT("%d"), Quest.QuestId), bCreated);
+        if (bCreated)
+        {
+            FSlateFontInfo NameFont = NameText->GetFont();
+            NameFont.Size = 12;
+            NameText->SetFont(NameFont);
+        }
+
         FString NameDisplay = Quest.bComplete ? FString::Printf(TEXT("[Done] %s"), *Quest.QuestName) : Quest.QuestName;
-        NameText->SetText(FText::FromString(NameDisplay));
+        FKeyedWidgetRows::SetText(NameText, NameDisplay);
 
         FLinearColor QuestColor = Quest.bComplete ?
             FLinearColor(0.5f, 1.0f, 0.5f) : GetFactionColor(Quest.GiverFaction);
-        NameText->SetColorAndOpacity(FSlateColor(QuestColor));
-
-        FSlateFontInfo NameFont = NameText->GetFont();
-        NameFont.Size = 12;
-        NameText->SetFont(NameFont);
-
-        QuestListBox->AddChild(NameText);
+        FKeyedWidgetRows::SetColor(NameText, QuestColor);
 
         // Objectives
         for (int32 i = 0; i < Quest.Objectives.Num(); i++)
         {
             const FQuestObjectiveData& Obj = Quest.Objectives[i];
 
-            UTextBlock* ObjText = NewObject<UTextBlock>(this);
+            UTextBlock* ObjText = QuestRows.Row<UTextBlock>(FString::Printf(TEXT("%d.%d"), Quest.QuestId, i), bCreated, ObjectiveStyle);
+            if (bCreated)
+            {
+                FSlateFontInfo ObjFont = ObjText->GetFont();
+                ObjFont.Size = 10;
+                ObjText->SetFont(ObjFont);
+            }
+
             FString ObjDisplay = FString::Printf(TEXT("  %s %s"),
                 Obj.bComplete ? TEXT("[x]") : TEXT("[ ]"),
                 *Obj.GetProgressText());
-            ObjText->SetText(FText::FromString(ObjDisplay));
+            FKeyedWidgetRows::SetText(ObjText, ObjDisplay);
 
             // Flash effect for recently updated objectives
             int32 FlashKey = Quest.QuestId * 100 + i;
@@ -189,21 +222,17 @@ void UQuestTrackerWidget::RebuildDisplay()
             if (FlashTimer && *FlashTimer > 0.0f)
             {
                 float Flash = FMath::Sin(*FlashTimer * 5.0f) * 0.5f + 0.5f;
-                ObjText->SetColorAndOpacity(FSlateColor(
-                    FLinearColor::LerpUsingHSV(FLinearColor::White, FLinearColor(1.0f, 1.0f, 0.0f), Flash)));
+                FKeyedWidgetRows::SetColor(ObjText,
+                    FLinearColor::LerpUsingHSV(FLinearColor::White, FLinearColor(1.0f, 1.0f, 0.0f), Flash));
             }
             else
             {
                 FLinearColor ObjColor = Obj.bComplete ?
                     FLinearColor(0.4f, 0.7f, 0.4f) : FLinearColor(0.8f, 0.8f, 0.8f);
-                ObjText->SetColorAndOpacity(FSlateColor(ObjColor));
+                FKeyedWidgetRows::SetColor(ObjText, ObjColor);
             }
-
-            FSlateFontInfo ObjFont = ObjText->GetFont();
-            ObjFont.Size = 10;
-            ObjText->SetFont(ObjFont);
-
-            QuestListBox->AddChild(ObjText);
         }
     }
+
+    QuestRows.EndUpdate();
 }
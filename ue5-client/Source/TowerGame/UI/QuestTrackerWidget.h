@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
+#include "TowerUITickSubsystem.h"
 #include "QuestTrackerWidget.generated.h"
 
 class UVerticalBox;
@@ -89,15 +91,19 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnObjectiveUpdated, int32, QuestId
  *
  * Max tracked quests: 3 (rest visible in quest log via inventory).
  * Objectives flash when updated, quests glow on completion.
+ * Quest and objective rows are kept by ID and recycled (FKeyedWidgetRows).
  */
-UCLASS()
-class TOWERGAME_API UQuestTrackerWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UQuestTrackerWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Counts down objective flashes, while any are lit */
+    virtual void TickUI(float DeltaTime) override;
 
     // ============ Quest Management ============
 
@@ -158,4 +164,9 @@ private:
 
     // Flash animation state
     TMap<int32, float> ObjectiveFlashTimers; // QuestId*100+ObjIndex -> timer
+
+    UPROPERTY()
+    FKeyedWidgetRows QuestRows;
+
+    int32 UITickHandle = INDEX_NONE;
 };
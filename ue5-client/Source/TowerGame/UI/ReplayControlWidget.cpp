@@ -6,8 +6,8 @@
 #include "Components/ProgressBar.h"
 #include "Bridge/ProceduralCoreBridge.h"
 #include "Kismet/GameplayStatics.h"
-#include "Json.h"
-#include "JsonUtilities.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
 
 void UReplayControlWidget::NativeConstruct()
 {
@@ -67,21 +67,26 @@ void UReplayControlWidget::NativeConstruct()
     UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget constructed"));
 }
 
-void UReplayControlWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UReplayControlWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UReplayControlWidget::TickUI(float DeltaTime)
+{
     // Only update playback if playing
     if (CurrentState != EReplayState::Playing)
     {
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
         return;
     }
 
     // Accumulate delta time and advance frames
-    AccumulatedDeltaTime += InDeltaTime * PlaybackSpeed;
+    AccumulatedDeltaTime += DeltaTime * PlaybackSpeed;
     float FrameDuration = 1.0f / FramesPerSecond;
 
-    while (AccumulatedDeltaTime >= FrameDuration)
+    while (AccumulatedDeltaTime >= FrameDuration && CurrentFrameIndex < TotalFrames)
     {
         AccumulatedDeltaTime -= FrameDuration;
         AdvanceFrame();
@@ -114,29 +119,52 @@ bool UReplayControlWidget::LoadReplayFromJson(const FString& RecordingJson)
         return false;
     }
 
-    // Store the raw replay JSON
-    CurrentReplayJson = RecordingJson;
-
-    // Try to parse metadata
-    if (!ParseReplayMetadata(RecordingJson))
+    // Convert once; playback reads the container, not the JSON. Unmap first in
+    // case the previous replay is the file being replaced.
+    Reader.Close();
+    const FString Dir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Replays"));
+    IFileManager::Get().MakeDirectory(*Dir, true);
+    FString ReplayId;
+    const FString TempPath = FPaths::Combine(Dir, TEXT("Converting.trpl"));
+    if (!FTowerReplayWriter::ConvertRecordingJson(RecordingJson, TempPath, KeyframeInterval, &ReplayId))
     {
-        UE_LOG(LogTemp, Error, TEXT("ReplayControlWidget: Failed to parse replay metadata"));
+        UE_LOG(LogTemp, Error, TEXT("ReplayControlWidget: Failed to convert replay recording"));
         CurrentState = EReplayState::Error;
         return false;
     }
 
-    // Call replay_create_playback on Rust side
-    if (Bridge)
+    FString Path = TempPath;
+    if (!ReplayId.IsEmpty())
+    {
+        Path = FPaths::Combine(Dir, FPaths::MakeValidFileName(ReplayId) + TEXT(".trpl"));
+        if (!IFileManager::Get().Move(*Path, *TempPath, true, true))
+        {
+            Path = TempPath;
+        }
+    }
+    return LoadReplayFile(Path);
+}
+
+bool UReplayControlWidget::LoadReplayFile(const FString& Path)
+{
+    if (!Reader.Open(Path))
     {
-        // Note: In a real implementation, we'd need to expose replay_create_playback
-        // For now, we'll store the JSON and note that this would call the bridge
-        PlaybackJson = RecordingJson;
-        UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Loaded replay with %d frames"), TotalFrames);
+        CurrentState = EReplayState::Error;
+        TotalFrames = 0;
+        TotalTicks = 0;
+        UpdateUI();
+        return false;
     }
 
+    TotalFrames = Reader.GetNumFrames();
+    TotalTicks = Reader.GetDurationTicks();
+    UE_LOG(LogTemp, Log, TEXT("ReplayControlWidget: Loaded replay with %d frames, %lld ticks"), TotalFrames, TotalTicks);
+
     CurrentState = EReplayState::Idle;
     CurrentFrameIndex = 0;
+    CurrentTick = 0;
     AccumulatedDeltaTime = 0.0f;
+    Reader.Seek(0, ReplayState);
 
     UpdateUI();
     return true;
@@ -144,7 +172,7 @@ bool UReplayControlWidget::LoadReplayFromJson(const FString& RecordingJson)
 
 void UReplayControlWidget::Play()
 {
-    if (CurrentReplayJson.IsEmpty())
+    if (!Reader.IsOpen())
     {
         UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Cannot play - no replay loaded"));
         return;
@@ -157,6 +185,7 @@ void UReplayControlWidget::Play()
 
     CurrentState = EReplayState::Playing;
     AccumulatedDeltaTime = 0.0f;
+    UTowerUITickSubsystem::Start(this, this, UITickHandle);
     UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Play started"));
     UpdateUI();
 }
@@ -173,44 +202,42 @@ void UReplayControlWidget::Pause()
 
 void UReplayControlWidget::Stop()
 {
+    SeekToFrame(0);
     CurrentState = EReplayState::Idle;
-    CurrentFrameIndex = 0;
-    CurrentTick = 0;
-    AccumulatedDeltaTime = 0.0f;
     UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Stopped"));
     UpdateUI();
 }
 
 void UReplayControlWidget::SeekToFrame(int32 FrameIndex)
 {
-    if (FrameIndex >= TotalFrames)
-    {
-        CurrentFrameIndex = TotalFrames - 1;
-    }
-    else
-    {
-        CurrentFrameIndex = FrameIndex;
-    }
+    if (!Reader.IsOpen()) return;
 
-    // Update tick based on frame index
-    if (TotalFrames > 0 && TotalTicks > 0)
+    // Nearest keyframe, then at most KeyframeInterval frames
+    Reader.Seek(FMath::Clamp(FrameIndex, 0, TotalFrames), ReplayState);
+    CurrentFrameIndex = Reader.GetFrameIndex();
+    CurrentTick = 0;
+    for (const FTowerReplayInput& Input : ReplayState.Latest)
     {
-        CurrentTick = (uint64)((float)CurrentFrameIndex / (float)TotalFrames * (float)TotalTicks);
+        CurrentTick = FMath::Max(CurrentTick, Input.Tick);
     }
 
     AccumulatedDeltaTime = 0.0f;
-    UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Seeked to frame %d (tick %llu)"),
-           CurrentFrameIndex, CurrentTick);
+    UE_LOG(LogTemp, Verbose, TEXT("ReplayControlWidget: Seeked to frame %d (tick %lld)"), CurrentFrameIndex, CurrentTick);
+    OnReplaySeeked.Broadcast(CurrentFrameIndex);
     UpdateUI();
 }
 
 void UReplayControlWidget::SeekToTick(int64 Tick)
 {
-    if (TotalTicks > 0)
-    {
-        uint32 NewFrame = (uint32)((float)Tick / (float)TotalTicks * (float)TotalFrames);
-        SeekToFrame(NewFrame);
-    }
+    if (!Reader.IsOpen()) return;
+
+    Reader.SeekToTick(Tick, ReplayState);
+    CurrentFrameIndex = Reader.GetFrameIndex();
+    CurrentTick = FMath::Clamp<int64>(Tick, 0, FMath::Max<int64>(TotalTicks, 0));
+
+    AccumulatedDeltaTime = 0.0f;
+    OnReplaySeeked.Broadcast(CurrentFrameIndex);
+    UpdateUI();
 }
 
 FString UReplayControlWidget::GetStateDisplayText() const
@@ -232,6 +259,15 @@ FString UReplayControlWidget::GetStateDisplayText() const
     }
 }
 
+FString UReplayControlWidget::GetLatestInputPayload(int32 InputType) const
+{
+    if (InputType < 0 || InputType >= TowerReplay::NumInputTypes || !ReplayState.bHas[InputType])
+    {
+        return FString();
+    }
+    return ReplayState.Latest[InputType].Payload;
+}
+
 void UReplayControlWidget::OnPlayClicked()
 {
     Play();
@@ -322,7 +358,7 @@ void UReplayControlWidget::UpdateUI()
     // Update button states
     if (PlayButton)
     {
-        PlayButton->SetIsEnabled(CurrentState != EReplayState::Playing && !CurrentReplayJson.IsEmpty());
+        PlayButton->SetIsEnabled(CurrentState != EReplayState::Playing && Reader.IsOpen());
     }
     if (PauseButton)
     {
@@ -334,66 +370,6 @@ void UReplayControlWidget::UpdateUI()
     }
 }
 
-bool UReplayControlWidget::ParseReplayMetadata(const FString& ReplayJson)
-{
-    // Parse JSON to extract replay metadata
-    TSharedPtr<FJsonObject> JsonObject;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ReplayJson);
-
-    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-    {
-        UE_LOG(LogTemp, Error, TEXT("ReplayControlWidget: Failed to parse replay JSON"));
-        return false;
-    }
-
-    // Extract frame count
-    if (JsonObject->HasField(TEXT("total_frames")))
-    {
-        TotalFrames = JsonObject->GetIntegerField(TEXT("total_frames"));
-    }
-    else if (JsonObject->HasField(TEXT("frames")))
-    {
-        // Try to get length of frames array as fallback
-        TArray<TSharedPtr<FJsonValue>> Frames = JsonObject->GetArrayField(TEXT("frames"));
-        TotalFrames = Frames.Num();
-    }
-    else
-    {
-        UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Could not determine total frame count"));
-        TotalFrames = 100; // Default fallback
-    }
-
-    // Extract tick count
-    if (JsonObject->HasField(TEXT("total_ticks")))
-    {
-        TotalTicks = JsonObject->GetIntegerField(TEXT("total_ticks"));
-    }
-    else
-    {
-        TotalTicks = TotalFrames * 100; // Estimate based on frames
-    }
-
-    UE_LOG(LogTemp, Warning, TEXT("ReplayControlWidget: Parsed metadata - %d frames, %llu ticks"),
-           TotalFrames, TotalTicks);
-
-    return true;
-}
-
-bool UReplayControlWidget::UpdatePlaybackStatus()
-{
-    if (!Bridge || PlaybackJson.IsEmpty())
-    {
-        return false;
-    }
-
-    // In a real implementation, would call:
-    // FString StatusJson = Bridge->ReplayGetSnapshot();
-    // And parse current_frame_idx, current_tick, playback_state from response
-
-    // For now, we manage state locally
-    return true;
-}
-
 FString UReplayControlWidget::FormatProgressText() const
 {
     return FString::Printf(TEXT("%d / %d frames"), CurrentFrameIndex, TotalFrames);
@@ -401,25 +377,22 @@ FString UReplayControlWidget::FormatProgressText() const
 
 FString UReplayControlWidget::FormatTickText() const
 {
-    return FString::Printf(TEXT("Tick: %llu / %llu"), CurrentTick, TotalTicks);
+    return FString::Printf(TEXT("Tick: %lld / %lld"), CurrentTick, TotalTicks);
 }
 
 void UReplayControlWidget::AdvanceFrame()
 {
-    if (CurrentFrameIndex < TotalFrames)
+    FTowerReplayInput Input;
+    if (CurrentFrameIndex >= TotalFrames || !Reader.Next(Input))
     {
-        CurrentFrameIndex++;
-
-        // Update tick based on frame progression
-        if (TotalFrames > 0 && TotalTicks > 0)
-        {
-            CurrentTick = (uint64)((float)CurrentFrameIndex / (float)TotalFrames * (float)TotalTicks);
-        }
-
-        // In a real implementation, would call:
-        // FString InputEvent = Bridge->ReplayGetInput(CurrentFrameIndex);
-        // And apply the input event to the game state
+        CurrentFrameIndex = TotalFrames;
+        return;
     }
+
+    ReplayState.Apply(Input);
+    CurrentFrameIndex = Reader.GetFrameIndex();
+    CurrentTick = Input.Tick;
+    OnReplayInput.Broadcast(Input.Tick, Input.InputType, Input.Payload);
 }
 
 FProceduralCoreBridge* UReplayControlWidget::GetBridge()
@@ -7,6 +7,8 @@
 #include "Components/CheckBox.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
+#include "Core/ReplayArchive.h"
+#include "TowerUITickSubsystem.h"
 #include "ReplayControlWidget.generated.h"
 
 class FProceduralCoreBridge;
@@ -24,6 +26,9 @@ enum class EReplayState : uint8
     Error = 4          // Error state
 };
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnReplayInput, int64, Tick, int32, InputType, const FString&, Payload);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnReplaySeeked, int32, FrameIndex);
+
 /**
  * Replay control widget for playback management.
  *
@@ -34,8 +39,15 @@ enum class EReplayState : uint8
  *   - Progress bar (current_frame_idx / total_frames)
  *   - Timeline scrubber
  *   - State display (Idle/Playing/Paused/Finished/Error)
- *   - LoadReplayFromJson() to load recording
- *   - NativeTick() to update playback
+ *   - LoadReplayFromJson() / LoadReplayFile() to load recording
+ *   - TickUI() to update playback (UTowerUITickSubsystem, while playing)
+ *
+ * Recordings are converted to the binary replay container (FTowerReplayWriter)
+ * under Saved/Replays and played from a memory-mapped FTowerReplayReader, so
+ * the recording JSON isn't kept and a seek loads the nearest keyframe and
+ * applies at most KeyframeInterval frames. Each frame played is broadcast by
+ * OnReplayInput; after a seek, OnReplaySeeked fires and GetLatestInputPayload
+ * gives the state to restore.
  *
  * Layout:
  *   [Replay Title]
@@ -46,20 +58,23 @@ enum class EReplayState : uint8
  *
  * All FFI calls to Rust procedural core are made via ProceduralCoreBridge.
  */
-UCLASS()
-class TOWERGAME_API UReplayControlWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UReplayControlWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Advances playback; registered by Play() and dropped once not playing */
+    virtual void TickUI(float DeltaTime) override;
 
     // ============ Replay Loading ============
 
     /**
-     * Load a replay from JSON recording data.
-     * Calls replay_create_playback(recording_json) on Rust side.
+     * Load a replay from JSON recording data (Rust ReplayRecording).
+     * Converts it to a replay container under Saved/Replays and plays that.
      *
      * @param RecordingJson  Raw recording JSON from Rust
      * @return               true if successfully loaded, false if error
@@ -67,6 +82,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Replay")
     bool LoadReplayFromJson(const FString& RecordingJson);
 
+    /** Load a replay container written by FTowerReplayWriter, e.g. by UTowerNetworkSubsystem::ExportReplay */
+    UFUNCTION(BlueprintCallable, Category = "Replay")
+    bool LoadReplayFile(const FString& Path);
+
     // ============ Playback Controls ============
 
     /** Start playback */
@@ -109,6 +128,20 @@ public:
     UFUNCTION(BlueprintPure, Category = "Replay")
     FString GetStateDisplayText() const;
 
+    /** Payload of the latest input of InputType at the current frame, empty if none yet */
+    UFUNCTION(BlueprintPure, Category = "Replay")
+    FString GetLatestInputPayload(int32 InputType) const;
+
+    // ============ Events ============
+
+    /** A frame was played; apply its input */
+    UPROPERTY(BlueprintAssignable, Category = "Replay")
+    FOnReplayInput OnReplayInput;
+
+    /** Playback jumped; restore from GetLatestInputPayload */
+    UPROPERTY(BlueprintAssignable, Category = "Replay")
+    FOnReplaySeeked OnReplaySeeked;
+
     // ============ Config Properties ============
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replay")
@@ -120,6 +153,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replay")
     float FramesPerSecond = 30.0f;
 
+    /** Frames between keyframes in converted recordings; a seek applies at most this many */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replay", meta = (ClampMin = "1"))
+    int32 KeyframeInterval = TowerReplay::DefaultKeyframeInterval;
+
     // ============ Bound Widgets ============
 
     UPROPERTY(meta = (BindWidgetOptional), BlueprintReadOnly, Category = "Replay")
@@ -181,12 +218,6 @@ protected:
     /** Update all UI elements from current state */
     void UpdateUI();
 
-    /** Parse replay JSON and extract metadata */
-    bool ParseReplayMetadata(const FString& ReplayJson);
-
-    /** Get current playback status from Rust via FFI */
-    bool UpdatePlaybackStatus();
-
     /** Format frame/tick information for display */
     FString FormatProgressText() const;
     FString FormatTickText() const;
@@ -194,8 +225,8 @@ protected:
 private:
     // Playback state
     EReplayState CurrentState = EReplayState::Idle;
-    FString CurrentReplayJson;
-    FString PlaybackJson;  // JSON returned from replay_create_playback
+    FTowerReplayReader Reader;
+    FTowerReplayState ReplayState;
 
     // Playback parameters
     int32 CurrentFrameIndex = 0;
@@ -217,4 +248,6 @@ private:
 
     /** Advance playback by one frame */
     void AdvanceFrame();
+
+    int32 UITickHandle = INDEX_NONE;
 };
@@ -6,6 +6,8 @@
 #include "Components/ProgressBar.h"
 #include "Components/VerticalBox.h"
 #include "Components/Border.h"
+#include "Core/TowerSaveGame.h"
+#include "Engine/GameInstance.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 
@@ -50,6 +52,24 @@ void USaveMigrationWidget::NativeConstruct()
 	{
 		ErrorText->SetVisibility(ESlateVisibility::Collapsed);
 	}
+
+	// Follow async loads of the local save
+	UGameInstance* GI = GetGameInstance();
+	if (UTowerSaveSubsystem* Saves = GI ? GI->GetSubsystem<UTowerSaveSubsystem>() : nullptr)
+	{
+		Saves->OnLoadProgress.AddUniqueDynamic(this, &USaveMigrationWidget::ShowLoadProgress);
+	}
+}
+
+void USaveMigrationWidget::NativeDestruct()
+{
+	UGameInstance* GI = GetGameInstance();
+	if (UTowerSaveSubsystem* Saves = GI ? GI->GetSubsystem<UTowerSaveSubsystem>() : nullptr)
+	{
+		Saves->OnLoadProgress.RemoveDynamic(this, &USaveMigrationWidget::ShowLoadProgress);
+	}
+
+	Super::NativeDestruct();
 }
 
 void USaveMigrationWidget::InitializeMigration(const FString& SaveJson)
@@ -196,6 +216,36 @@ void USaveMigrationWidget::DisplayMigrationResult(bool bSuccess, int32 OriginalV
 	OnMigrationComplete.Broadcast(bSuccess);
 }
 
+void USaveMigrationWidget::ShowLoadProgress(int32 SlotIndex, float Progress, const FString& Stage)
+{
+	const bool bFailed = Stage == TEXT("Failed");
+	const bool bDone = Progress >= 1.0f;
+
+	if (bFailed) SetErrorState();
+	else if (bDone) SetSuccessState();
+	else SetProgressState();
+
+	if (MigrationProgressBar)
+	{
+		MigrationProgressBar->SetVisibility(ESlateVisibility::Visible);
+		MigrationProgressBar->SetPercent(FMath::Clamp(Progress, 0.0f, 1.0f));
+	}
+
+	if (StatusText)
+	{
+		FString Status;
+		if (bFailed) Status = FString::Printf(TEXT("Could not load save slot %d"), SlotIndex);
+		else if (bDone) Status = FString::Printf(TEXT("Save slot %d loaded"), SlotIndex);
+		else Status = FString::Printf(TEXT("Loading save slot %d: %s..."), SlotIndex, *Stage);
+		StatusText->SetText(FText::FromString(Status));
+	}
+
+	if (ContinueButton)
+	{
+		ContinueButton->SetIsEnabled(bDone);
+	}
+}
+
 void USaveMigrationWidget::OnContinueClicked()
 {
 	// Remove from parent or hide
@@ -25,6 +25,7 @@ public:
 	USaveMigrationWidget(const FObjectInitializer& ObjectInitializer);
 
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	/**
 	 * Initialize the widget with save data to migrate
@@ -46,6 +47,14 @@ public:
 	void DisplayMigrationResult(bool bSuccess, int32 OriginalVersion, int32 FinalVersion,
 		const TArray<FString>& StepsApplied, const FString& ErrorMessage);
 
+	/**
+	 * Show an async save load in progress (bound to UTowerSaveSubsystem::OnLoadProgress)
+	 * @param Progress 0..1
+	 * @param Stage Reading, Decompressing, Restoring, Done or Failed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save Migration")
+	void ShowLoadProgress(int32 SlotIndex, float Progress, const FString& Stage);
+
 protected:
 	// Widget Components
 	UPROPERTY(meta = (BindWidget))
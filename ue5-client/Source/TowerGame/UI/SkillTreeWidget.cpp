@@ -7,6 +7,7 @@
 #include "Components/HorizontalBox.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void USkillTreeWidget::NativeConstruct()
 {
@@ -135,6 +136,7 @@ TArray<FMasteryProgressDisplay> USkillTreeWidget::GetDomainsInCategory(EMasteryC
 
 void USkillTreeWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_SkillTree_RebuildDisplay);
     FMasteryProgressDisplay* Current = AllMasteries.Find(CurrentDomain);
     if (!Current) return;
 
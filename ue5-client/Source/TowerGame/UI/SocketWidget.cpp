@@ -1,4 +1,5 @@
 #include "SocketWidget.h"
+#include "TowerCatalogSubsystem.h"
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
@@ -6,10 +7,12 @@
 #include "Components/HorizontalBox.h"
 #include "Components/Border.h"
 #include "Components/Image.h"
+#include "Engine/GameInstance.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void USocketWidget::NativeConstruct()
 {
@@ -107,10 +110,42 @@ void USocketWidget::LoadAvailableGems(const FString& GemsJson)
 {
     AvailableGems.Empty();
     SelectedGemIndex = -1;
+    if (!ParseGems(GemsJson, AvailableGems)) return;
 
+    UE_LOG(LogTemp, Log, TEXT("SocketWidget: Loaded %d available gems"), AvailableGems.Num());
+    RebuildGemList();
+}
+
+void USocketWidget::LoadAvailableRunes(const FString& RunesJson)
+{
+    AvailableRunes.Empty();
+    SelectedRuneIndex = -1;
+    if (!ParseRunes(RunesJson, AvailableRunes)) return;
+
+    UE_LOG(LogTemp, Log, TEXT("SocketWidget: Loaded %d available runes"), AvailableRunes.Num());
+    RebuildRuneList();
+}
+
+void USocketWidget::LoadStarterFromCatalog()
+{
+    UGameInstance* GI = GetGameInstance();
+    UTowerCatalogSubsystem* Catalogs = GI ? GI->GetSubsystem<UTowerCatalogSubsystem>() : nullptr;
+    if (!Catalogs) return;
+
+    AvailableGems = Catalogs->GetGems()->Items;
+    AvailableRunes = Catalogs->GetRunes()->Items;
+    SelectedGemIndex = -1;
+    SelectedRuneIndex = -1;
+
+    RebuildGemList();
+    RebuildRuneList();
+}
+
+bool USocketWidget::ParseGems(const FString& GemsJson, TArray<FGemDisplay>& OutGems)
+{
     TSharedPtr<FJsonValue> Parsed;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(GemsJson);
-    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return;
+    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return false;
 
     const TArray<TSharedPtr<FJsonValue>>* GemArray = nullptr;
     if (Parsed->AsObject() && Parsed->AsObject()->TryGetArrayField(TEXT("gems"), GemArray))
@@ -123,9 +158,10 @@ void USocketWidget::LoadAvailableGems(const FString& GemsJson)
     }
     else
     {
-        return;
+        return false;
     }
 
+    OutGems.Reserve(OutGems.Num() + GemArray->Num());
     for (const TSharedPtr<FJsonValue>& Val : *GemArray)
     {
         const TSharedPtr<FJsonObject>& GObj = Val->AsObject();
@@ -140,21 +176,16 @@ void USocketWidget::LoadAvailableGems(const FString& GemsJson)
             ? GObj->GetStringField(TEXT("bonus_description"))
             : TEXT("");
 
-        AvailableGems.Add(Gem);
+        OutGems.Add(MoveTemp(Gem));
     }
-
-    UE_LOG(LogTemp, Log, TEXT("SocketWidget: Loaded %d available gems"), AvailableGems.Num());
-    RebuildGemList();
+    return true;
 }
 
-void USocketWidget::LoadAvailableRunes(const FString& RunesJson)
+bool USocketWidget::ParseRunes(const FString& RunesJson, TArray<FRuneDisplay>& OutRunes)
 {
-    AvailableRunes.Empty();
-    SelectedRuneIndex = -1;
-
     TSharedPtr<FJsonValue> Parsed;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(RunesJson);
-    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return;
+    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return false;
 
     const TArray<TSharedPtr<FJsonValue>>* RuneArray = nullptr;
     if (Parsed->AsObject() && Parsed->AsObject()->TryGetArrayField(TEXT("runes"), RuneArray))
@@ -167,9 +198,10 @@ void USocketWidget::LoadAvailableRunes(const FString& RunesJson)
     }
     else
     {
-        return;
+        return false;
     }
 
+    OutRunes.Reserve(OutRunes.Num() + RuneArray->Num());
     for (const TSharedPtr<FJsonValue>& Val : *RuneArray)
     {
         const TSharedPtr<FJsonObject>& RObj = Val->AsObject();
@@ -186,11 +218,9 @@ void USocketWidget::LoadAvailableRunes(const FString& RunesJson)
             ? RObj->GetStringField(TEXT("effect_description"))
             : TEXT("");
 
-        AvailableRunes.Add(Rune);
+        OutRunes.Add(MoveTemp(Rune));
     }
-
-    UE_LOG(LogTemp, Log, TEXT("SocketWidget: Loaded %d available runes"), AvailableRunes.Num());
-    RebuildRuneList();
+    return true;
 }
 
 // =============================================================================
@@ -489,6 +519,7 @@ FLinearColor USocketWidget::GetGemTierColor(EGemTier Tier)
 
 void USocketWidget::RebuildSocketDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Socket_RebuildSocketDisplay);
     if (!SocketSlotsBox) return;
     SocketSlotsBox->ClearChildren();
 
@@ -640,6 +671,7 @@ void USocketWidget::UpdateSocketDetail()
 
 void USocketWidget::RebuildGemList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Socket_RebuildGemList);
     if (!GemListScrollBox) return;
     GemListScrollBox->ClearChildren();
 
@@ -682,6 +714,7 @@ void USocketWidget::RebuildGemList()
 
 void USocketWidget::RebuildRuneList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Socket_RebuildRuneList);
     if (!RuneListScrollBox) return;
     RuneListScrollBox->ClearChildren();
 
@@ -825,7 +858,7 @@ FString USocketWidget::GetGemTierName(EGemTier Tier) const
     }
 }
 
-ESocketColor USocketWidget::ParseSocketColor(const FString& Str) const
+ESocketColor USocketWidget::ParseSocketColor(const FString& Str)
 {
     if (Str == TEXT("Red"))       return ESocketColor::Red;
     if (Str == TEXT("Blue"))      return ESocketColor::Blue;
@@ -834,7 +867,7 @@ ESocketColor USocketWidget::ParseSocketColor(const FString& Str) const
     return ESocketColor::Red;
 }
 
-EGemTier USocketWidget::ParseGemTier(const FString& Str) const
+EGemTier USocketWidget::ParseGemTier(const FString& Str)
 {
     if (Str == TEXT("Chipped"))  return EGemTier::Chipped;
     if (Str == TEXT("Flawed"))   return EGemTier::Flawed;
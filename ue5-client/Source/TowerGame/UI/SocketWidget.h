@@ -116,6 +116,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Sockets")
     void LoadAvailableRunes(const FString& RunesJson);
 
+    /** Load the starter gems and runes from the shared catalog */
+    UFUNCTION(BlueprintCallable, Category = "Sockets")
+    void LoadStarterFromCatalog();
+
+    /** Append the gems of a Rust Gem array (or { "gems": [...] }); false if it doesn't parse */
+    static bool ParseGems(const FString& GemsJson, TArray<FGemDisplay>& OutGems);
+
+    /** Append the runes of a Rust Rune array (or { "runes": [...] }); false if it doesn't parse */
+    static bool ParseRunes(const FString& RunesJson, TArray<FRuneDisplay>& OutRunes);
+
     // ============ Socket Interaction ============
 
     /** Select a socket by index to view details */
@@ -220,8 +230,8 @@ protected:
 
     FString GetSocketColorName(ESocketColor Color) const;
     FString GetGemTierName(EGemTier Tier) const;
-    ESocketColor ParseSocketColor(const FString& Str) const;
-    EGemTier ParseGemTier(const FString& Str) const;
+    static ESocketColor ParseSocketColor(const FString& Str);
+    static EGemTier ParseGemTier(const FString& Str);
 
     void SelectGem(int32 Index);
     void SelectRune(int32 Index);
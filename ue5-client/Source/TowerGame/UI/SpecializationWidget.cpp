@@ -1,4 +1,5 @@
 #include "SpecializationWidget.h"
+#include "TowerCatalogSubsystem.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
 #include "Components/ScrollBox.h"
@@ -6,8 +7,11 @@
 #include "Components/HorizontalBox.h"
 #include "Components/ComboBoxString.h"
 #include "Components/Image.h"
+#include "Engine/GameInstance.h"
+#include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void USpecializationWidget::NativeConstruct()
 {
@@ -62,40 +66,11 @@ void USpecializationWidget::LoadFromJson(const FString& SpecJson)
             const TSharedPtr<FJsonObject>& BObj = BVal->AsObject();
             if (!BObj) continue;
 
-            FSpecBranchDisplay Branch;
-            Branch.Id = BObj->GetStringField(TEXT("id"));
-            Branch.Name = BObj->GetStringField(TEXT("name"));
-            Branch.Domain = ParseDomainString(BObj->GetStringField(TEXT("domain")));
-            Branch.Description = BObj->HasField(TEXT("description")) ?
-                BObj->GetStringField(TEXT("description")) : TEXT("");
-            Branch.RoleAffinity = ParseRole(BObj->GetStringField(TEXT("role_affinity")));
-
-            // Passives array
-            const TArray<TSharedPtr<FJsonValue>>* PassivesArr;
-            if (BObj->TryGetArrayField(TEXT("passives"), PassivesArr))
-            {
-                for (const auto& PVal : *PassivesArr)
-                {
-                    Branch.Passives.Add(PVal->AsString());
-                }
-            }
-
-            // Ultimate
-            Branch.bHasUltimate = BObj->HasField(TEXT("ultimate_name"));
-            if (Branch.bHasUltimate)
-            {
-                Branch.UltimateName = BObj->GetStringField(TEXT("ultimate_name"));
-                Branch.UltimateDescription = BObj->HasField(TEXT("ultimate_description")) ?
-                    BObj->GetStringField(TEXT("ultimate_description")) : TEXT("");
-            }
-
-            // Selection state
-            Branch.bIsChosen = BObj->HasField(TEXT("is_chosen")) && BObj->GetBoolField(TEXT("is_chosen"));
-            Branch.bCanChoose = !BObj->HasField(TEXT("can_choose")) || BObj->GetBoolField(TEXT("can_choose"));
+            FSpecBranchDisplay Branch = ParseBranch(BObj);
 
             // Add to domain map
             TArray<FSpecBranchDisplay>& DomainArr = DomainBranches.FindOrAdd(Branch.Domain);
-            DomainArr.Add(Branch);
+            DomainArr.Add(MoveTemp(Branch));
         }
     }
 
@@ -130,6 +105,80 @@ void USpecializationWidget::LoadFromJson(const FString& SpecJson)
     UpdateButtonStates();
 }
 
+void USpecializationWidget::LoadBranchesFromCatalog(const TArray<FString>& ChosenBranchIds)
+{
+    UGameInstance* GI = GetGameInstance();
+    UTowerCatalogSubsystem* Catalogs = GI ? GI->GetSubsystem<UTowerCatalogSubsystem>() : nullptr;
+    if (!Catalogs) return;
+
+    DomainBranches.Empty();
+    PendingBranchId.Empty();
+
+    const TSet<FString> Chosen(ChosenBranchIds);
+    for (const FSpecBranchDisplay& CatalogBranch : Catalogs->GetSpecBranches()->Items)
+    {
+        FSpecBranchDisplay& Branch = DomainBranches.FindOrAdd(CatalogBranch.Domain).Add_GetRef(CatalogBranch);
+        Branch.bIsChosen = Chosen.Contains(Branch.Id);
+    }
+
+    PopulateDomainCombo();
+    RebuildBranchCards();
+    RebuildSynergyList();
+    UpdateRoleIndicators();
+    UpdateButtonStates();
+}
+
+FSpecBranchDisplay USpecializationWidget::ParseBranch(const TSharedPtr<FJsonObject>& BObj)
+{
+    FSpecBranchDisplay Branch;
+    Branch.Id = BObj->GetStringField(TEXT("id"));
+    Branch.Name = BObj->GetStringField(TEXT("name"));
+    Branch.Domain = ParseDomainString(BObj->GetStringField(TEXT("domain")));
+    Branch.Description = BObj->HasField(TEXT("description")) ?
+        BObj->GetStringField(TEXT("description")) : TEXT("");
+    Branch.RoleAffinity = ParseRole(BObj->GetStringField(TEXT("role_affinity")));
+
+    // Passives array
+    const TArray<TSharedPtr<FJsonValue>>* PassivesArr;
+    if (BObj->TryGetArrayField(TEXT("passives"), PassivesArr))
+    {
+        for (const auto& PVal : *PassivesArr)
+        {
+            Branch.Passives.Add(PVal->AsString());
+        }
+    }
+
+    // Ultimate
+    Branch.bHasUltimate = BObj->HasField(TEXT("ultimate_name"));
+    if (Branch.bHasUltimate)
+    {
+        Branch.UltimateName = BObj->GetStringField(TEXT("ultimate_name"));
+        Branch.UltimateDescription = BObj->HasField(TEXT("ultimate_description")) ?
+            BObj->GetStringField(TEXT("ultimate_description")) : TEXT("");
+    }
+
+    // Selection state
+    Branch.bIsChosen = BObj->HasField(TEXT("is_chosen")) && BObj->GetBoolField(TEXT("is_chosen"));
+    Branch.bCanChoose = !BObj->HasField(TEXT("can_choose")) || BObj->GetBoolField(TEXT("can_choose"));
+    return Branch;
+}
+
+bool USpecializationWidget::ParseBranches(const FString& BranchesJson, TArray<FSpecBranchDisplay>& OutBranches)
+{
+    TArray<TSharedPtr<FJsonValue>> BranchesArr;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BranchesJson);
+    if (!FJsonSerializer::Deserialize(Reader, BranchesArr)) return false;
+
+    OutBranches.Reserve(OutBranches.Num() + BranchesArr.Num());
+    for (const auto& BVal : BranchesArr)
+    {
+        const TSharedPtr<FJsonObject>& BObj = BVal->AsObject();
+        if (!BObj) continue;
+        OutBranches.Add(ParseBranch(BObj));
+    }
+    return true;
+}
+
 // ---------------------------------------------------------------------------
 // Branch Selection
 // ---------------------------------------------------------------------------
@@ -325,6 +374,7 @@ void USpecializationWidget::PopulateDomainCombo()
 
 void USpecializationWidget::RebuildBranchCards()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Specialization_RebuildBranchCards);
     const TArray<FSpecBranchDisplay>* Branches = DomainBranches.Find(SelectedDomain);
 
     // --- Left branch (index 0) ---
@@ -466,6 +516,7 @@ void USpecializationWidget::RebuildBranchCards()
 
 void USpecializationWidget::RebuildPassiveList(UScrollBox* ListBox, const FSpecBranchDisplay& Branch)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Specialization_RebuildPassiveList);
     if (!ListBox) return;
     ListBox->ClearChildren();
 
@@ -492,6 +543,7 @@ void USpecializationWidget::RebuildPassiveList(UScrollBox* ListBox, const FSpecB
 
 void USpecializationWidget::RebuildSynergyList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Specialization_RebuildSynergyList);
     if (!SynergyListBox) return;
     SynergyListBox->ClearChildren();
 
@@ -596,7 +648,7 @@ void USpecializationWidget::UpdateButtonStates()
 // Parsing Helpers
 // ---------------------------------------------------------------------------
 
-EMasteryDomain USpecializationWidget::ParseDomainString(const FString& Str) const
+EMasteryDomain USpecializationWidget::ParseDomainString(const FString& Str)
 {
     if (Str == TEXT("SwordMastery")) return EMasteryDomain::SwordMastery;
     if (Str == TEXT("GreatswordMastery")) return EMasteryDomain::GreatswordMastery;
@@ -622,7 +674,7 @@ EMasteryDomain USpecializationWidget::ParseDomainString(const FString& Str) cons
     return EMasteryDomain::SwordMastery;
 }
 
-ECombatRole USpecializationWidget::ParseRole(const FString& Str) const
+ECombatRole USpecializationWidget::ParseRole(const FString& Str)
 {
     if (Str == TEXT("Vanguard")) return ECombatRole::Vanguard;
     if (Str == TEXT("Striker")) return ECombatRole::Striker;
@@ -87,6 +87,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Specialization")
     void LoadFromJson(const FString& SpecJson);
 
+    /** Load every branch from the shared catalog, marking the given ids chosen; synergies are kept */
+    UFUNCTION(BlueprintCallable, Category = "Specialization")
+    void LoadBranchesFromCatalog(const TArray<FString>& ChosenBranchIds);
+
+    /** One branch of a specialization profile or of the SpecGetAllBranches catalog */
+    static FSpecBranchDisplay ParseBranch(const TSharedPtr<class FJsonObject>& BranchObj);
+
+    /** Append the branches of a SpecGetAllBranches array; false if it doesn't parse */
+    static bool ParseBranches(const FString& BranchesJson, TArray<FSpecBranchDisplay>& OutBranches);
+
     // --- Branch Selection ---
     UFUNCTION(BlueprintCallable, Category = "Specialization")
     void SelectBranch(const FString& BranchId);
@@ -172,8 +182,8 @@ protected:
     void UpdateRoleIndicators();
     void UpdateButtonStates();
 
-    EMasteryDomain ParseDomainString(const FString& Str) const;
-    ECombatRole ParseRole(const FString& Str) const;
+    static EMasteryDomain ParseDomainString(const FString& Str);
+    static ECombatRole ParseRole(const FString& Str);
     ECombatRole ComputeRole(bool bPrimary) const;
 
     UFUNCTION() void OnDomainChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
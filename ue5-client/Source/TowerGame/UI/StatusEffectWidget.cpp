@@ -1,4 +1,6 @@
 #include "StatusEffectWidget.h"
+#include "KeyedWidgetRows.h"
+#include "TowerUITickSubsystem.h"
 #include "Components/HorizontalBox.h"
 #include "Components/HorizontalBoxSlot.h"
 #include "Components/TextBlock.h"
@@ -6,6 +8,8 @@
 #include "Components/Image.h"
 #include "Components/VerticalBox.h"
 #include "Components/Border.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 FLinearColor FActiveStatusEffect::GetColor() const
 {
@@ -87,121 +91,172 @@ FString FActiveStatusEffect::GetIconChar() const
 void UStatusEffectWidget::NativeConstruct()
 {
     Super::NativeConstruct();
-    RebuildDisplay();
+
+    if (UTowerStatusEffectSubsystem* Store = GetStore())
+    {
+        ChangedHandle = Store->OnChanged.AddUObject(this, &UStatusEffectWidget::HandleEffectsChanged);
+    }
+    if (Entity == 0)
+    {
+        Entity = UTowerStatusEffectSubsystem::GetActorHandle(GetOwningPlayerPawn());
+    }
+    RefreshEffects();
 }
 
-void UStatusEffectWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UStatusEffectWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
-
-    // Tick down all effects
-    bool bNeedsRebuild = false;
-    for (int32 i = ActiveEffects.Num() - 1; i >= 0; i--)
+    if (UTowerStatusEffectSubsystem* Store = GetStore())
     {
-        ActiveEffects[i].RemainingTime -= InDeltaTime;
-        if (ActiveEffects[i].RemainingTime <= 0.0f)
-        {
-            ActiveEffects.RemoveAt(i);
-            bNeedsRebuild = true;
-        }
+        Store->OnChanged.Remove(ChangedHandle);
     }
+    ChangedHandle.Reset();
+    Super::NativeDestruct();
+}
+
+UTowerStatusEffectSubsystem* UStatusEffectWidget::GetStore() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UTowerStatusEffectSubsystem>() : nullptr;
+}
+
+void UStatusEffectWidget::SetEntity(int64 InEntity)
+{
+    if (Entity == InEntity) return;
+    Entity = InEntity;
+    RefreshEffects();
+}
 
-    if (bNeedsRebuild)
+void UStatusEffectWidget::HandleEffectsChanged(int64 ChangedEntity, uint32 OldMask, uint32 NewMask)
+{
+    if (ChangedEntity == Entity)
     {
-        RebuildDisplay();
+        RefreshEffects();
     }
 }
 
 void UStatusEffectWidget::AddEffect(EStatusType Type, float Duration, float Strength, int32 Stacks)
 {
-    // Check if already exists — refresh/stack
-    for (FActiveStatusEffect& Existing : ActiveEffects)
-    {
-        if (Existing.Type == Type)
-        {
-            Existing.RemainingTime = FMath::Max(Existing.RemainingTime, Duration);
-            Existing.TotalDuration = Duration;
-            Existing.Strength = FMath::Max(Existing.Strength, Strength);
-            Existing.Stacks = FMath::Min(Existing.Stacks + Stacks, 5); // Max 5 stacks
-            RebuildDisplay();
-            return;
-        }
-    }
-
-    // New effect
-    if (ActiveEffects.Num() >= MaxDisplayedEffects) return;
-
-    FActiveStatusEffect NewEffect;
-    NewEffect.Type = Type;
-    NewEffect.RemainingTime = Duration;
-    NewEffect.TotalDuration = Duration;
-    NewEffect.Strength = Strength;
-    NewEffect.Stacks = Stacks;
-
-    ActiveEffects.Add(NewEffect);
-    RebuildDisplay();
+    if (UTowerStatusEffectSubsystem* Store = GetStore())
+    {
+        Store->ApplyEffect(Entity, Type, Duration, Strength, Stacks);
+    }
 }
 
 void UStatusEffectWidget::RemoveEffect(EStatusType Type)
 {
-    ActiveEffects.RemoveAll([Type](const FActiveStatusEffect& E) { return E.Type == Type; });
-    RebuildDisplay();
+    if (UTowerStatusEffectSubsystem* Store = GetStore())
+    {
+        Store->RemoveEffect(Entity, Type);
+    }
 }
 
 void UStatusEffectWidget::ClearAllEffects()
 {
-    ActiveEffects.Empty();
-    RebuildDisplay();
+    if (UTowerStatusEffectSubsystem* Store = GetStore())
+    {
+        Store->RemoveEntity(Entity);
+    }
 }
 
 bool UStatusEffectWidget::HasEffect(EStatusType Type) const
 {
-    return ActiveEffects.ContainsByPredicate([Type](const FActiveStatusEffect& E) {
-        return E.Type == Type;
-    });
+    const UTowerStatusEffectSubsystem* Store = GetStore();
+    return Store && Store->HasEffect(Entity, Type);
+}
+
+void UStatusEffectWidget::RefreshEffects()
+{
+    ActiveEffects.Reset();
+
+    const UTowerStatusEffectSubsystem* Store = GetStore();
+    const uint32 Mask = Store ? Store->GetEffectMask(Entity) : 0;
+    for (uint32 Bits = Mask; Bits && ActiveEffects.Num() < MaxDisplayedEffects; Bits &= Bits - 1)
+    {
+        const EStatusType Type = static_cast<EStatusType>(FMath::CountTrailingZeros(Bits));
+        FTowerStatusEffectState State;
+        if (!Store->GetEffect(Entity, Type, State)) continue;
+
+        FActiveStatusEffect& Effect = ActiveEffects.AddDefaulted_GetRef();
+        Effect.Type = Type;
+        Effect.RemainingTime = State.RemainingTime;
+        Effect.TotalDuration = State.TotalDuration;
+        Effect.Strength = State.Strength;
+        Effect.Stacks = State.Stacks;
+    }
+
+    RebuildDisplay();
 }
 
 void UStatusEffectWidget::RebuildDisplay()
 {
-    if (BuffBox) BuffBox->ClearChildren();
-    if (DebuffBox) DebuffBox->ClearChildren();
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_StatusEffect_RebuildDisplay);
+    INC_DWORD_STAT(STAT_TowerUI_Rebuilds);
+    FTowerPerfCounters::Add(ETowerPerfCounter::UIRebuilds);
+
+    if (BuffBox)
+    {
+        BuffRows.Init(this, BuffBox);
+        BuffRows.BeginUpdate();
+    }
+    if (DebuffBox)
+    {
+        DebuffRows.Init(this, DebuffBox);
+        DebuffRows.BeginUpdate();
+    }
 
     for (const FActiveStatusEffect& Effect : ActiveEffects)
     {
         UHorizontalBox* TargetBox = Effect.IsBuff() ? BuffBox : DebuffBox;
         if (!TargetBox) continue;
 
-        // Create a vertical box for each effect: icon + timer
-        UVerticalBox* EffectBox = NewObject<UVerticalBox>(this);
+        UpdateEffectBox(Effect.IsBuff() ? BuffRows : DebuffRows, Effect);
+    }
 
-        // Effect label (abbreviation + stacks)
-        UTextBlock* Label = NewObject<UTextBlock>(this);
-        FString LabelText = Effect.GetDisplayName();
-        if (Effect.Stacks > 1)
-        {
-            LabelText += FString::Printf(TEXT("x%d"), Effect.Stacks);
-        }
-        Label->SetText(FText::FromString(LabelText));
-        Label->SetColorAndOpacity(FSlateColor(Effect.GetColor()));
+    if (BuffBox) BuffRows.EndUpdate();
+    if (DebuffBox) DebuffRows.EndUpdate();
+}
 
-        FSlateFontInfo Font = Label->GetFont();
+void UStatusEffectWidget::UpdateEffectBox(FKeyedWidgetRows& Rows, const FActiveStatusEffect& Effect)
+{
+    // A vertical box for each effect: icon + timer
+    bool bCreated = false;
+    UVerticalBox* EffectBox = Rows.Row<UVerticalBox>(FString::FromInt(static_cast<int32>(Effect.Type)), bCreated);
+    if (bCreated)
+    {
+        UTextBlock* NewLabel = NewObject<UTextBlock>(this);
+        FSlateFontInfo Font = NewLabel->GetFont();
         Font.Size = 10;
-        Label->SetFont(Font);
+        NewLabel->SetFont(Font);
+        EffectBox->AddChild(NewLabel);
 
-        EffectBox->AddChild(Label);
-
-        // Timer text
-        UTextBlock* Timer = NewObject<UTextBlock>(this);
-        int32 SecsRemaining = FMath::CeilToInt(Effect.RemainingTime);
-        Timer->SetText(FText::FromString(FString::Printf(TEXT("%ds"), SecsRemaining)));
-
-        FSlateFontInfo SmallFont = Timer->GetFont();
+        UTextBlock* NewTimer = NewObject<UTextBlock>(this);
+        FSlateFontInfo SmallFont = NewTimer->GetFont();
         SmallFont.Size = 8;
-        Timer->SetFont(SmallFont);
-        Timer->SetColorAndOpacity(FSlateColor(FLinearColor(0.7f, 0.7f, 0.7f)));
+        NewTimer->SetFont(SmallFont);
+        NewTimer->SetColorAndOpacity(FSlateColor(FLinearColor(0.7f, 0.7f, 0.7f)));
+        EffectBox->AddChild(NewTimer);
+    }
 
-        EffectBox->AddChild(Timer);
+    UTextBlock* Label = Cast<UTextBlock>(EffectBox->GetChildAt(0));
+    UTextBlock* Timer = Cast<UTextBlock>(EffectBox->GetChildAt(1));
 
-        TargetBox->AddChild(EffectBox);
+    // Effect label (abbreviation + stacks)
+    FString LabelText = Effect.GetDisplayName();
+    if (Effect.Stacks > 1)
+    {
+        LabelText += FString::Printf(TEXT("x%d"), Effect.Stacks);
+    }
+    FKeyedWidgetRows::SetText(Label, LabelText);
+    FKeyedWidgetRows::SetColor(Label, Effect.GetColor());
+
+    // Timer text; effects the server set last until it drops them and show none
+    if (Effect.TotalDuration > 0.0f)
+    {
+        int32 SecsRemaining = FMath::CeilToInt(Effect.RemainingTime);
+        FKeyedWidgetRows::SetText(Timer, FString::Printf(TEXT("%ds"), SecsRemaining));
+    }
+    else
+    {
+        FKeyedWidgetRows::SetText(Timer, FString());
     }
 }
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
+#include "TowerGame/World/StatusEffectSubsystem.h"
 #include "StatusEffectWidget.generated.h"
 
 class UHorizontalBox;
@@ -9,36 +11,6 @@ class UImage;
 class UTextBlock;
 class UProgressBar;
 
-/**
- * Status effect types matching Rust combat/status.rs
- */
-UENUM(BlueprintType)
-enum class EStatusType : uint8
-{
-    // DoT
-    Burning         UMETA(DisplayName = "Burning"),
-    Poisoned        UMETA(DisplayName = "Poisoned"),
-    Bleeding        UMETA(DisplayName = "Bleeding"),
-
-    // CC
-    Stunned         UMETA(DisplayName = "Stunned"),
-    Frozen          UMETA(DisplayName = "Frozen"),
-    Silenced        UMETA(DisplayName = "Silenced"),
-
-    // Debuffs
-    Weakened        UMETA(DisplayName = "Weakened"),
-    Slowed          UMETA(DisplayName = "Slowed"),
-    Exposed         UMETA(DisplayName = "Exposed"),
-    Corrupted       UMETA(DisplayName = "Corrupted"),
-
-    // Buffs
-    Empowered       UMETA(DisplayName = "Empowered"),
-    Hastened        UMETA(DisplayName = "Hastened"),
-    Shielded        UMETA(DisplayName = "Shielded"),
-    Regenerating    UMETA(DisplayName = "Regenerating"),
-    SemanticFocus   UMETA(DisplayName = "Semantic Focus"),
-};
-
 /**
  * Active status effect data for UI display.
  */
@@ -113,31 +85,44 @@ struct FActiveStatusEffect
  *
  * Position: Below HP bar (configurable via Blueprint).
  * Max display: 10 effects (5 buffs + 5 debuffs).
+ *
+ * Icons are kept per effect type and recycled (FKeyedWidgetRows), so an
+ * expiry or refresh touches only that icon.
+ *
+ * Shows one entity's effects from UTowerStatusEffectSubsystem and redraws
+ * when the store says they changed; the widget keeps no timers of its own.
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class TOWERGAME_API UStatusEffectWidget : public UUserWidget
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
 
     // ============ API ============
 
-    /** Add or refresh a status effect */
+    /** Show this entity's effects (a replicated EntityId or GetActorHandle); the owning pawn's until set */
+    UFUNCTION(BlueprintCallable, Category = "StatusEffect")
+    void SetEntity(int64 InEntity);
+
+    UFUNCTION(BlueprintPure, Category = "StatusEffect")
+    int64 GetEntity() const { return Entity; }
+
+    /** Add or refresh a status effect on the entity */
     UFUNCTION(BlueprintCallable, Category = "StatusEffect")
     void AddEffect(EStatusType Type, float Duration, float Strength, int32 Stacks = 1);
 
-    /** Remove a status effect */
+    /** Remove a status effect from the entity */
     UFUNCTION(BlueprintCallable, Category = "StatusEffect")
     void RemoveEffect(EStatusType Type);
 
-    /** Remove all effects */
+    /** Remove all of the entity's effects */
     UFUNCTION(BlueprintCallable, Category = "StatusEffect")
     void ClearAllEffects();
 
-    /** Get active effects */
+    /** Get active effects, as of the last change */
     UFUNCTION(BlueprintPure, Category = "StatusEffect")
     const TArray<FActiveStatusEffect>& GetActiveEffects() const { return ActiveEffects; }
 
@@ -162,6 +147,26 @@ protected:
     void RebuildDisplay();
 
 private:
+    /** Re-read the entity's effects from the store and redraw */
+    void RefreshEffects();
+
+    void HandleEffectsChanged(int64 ChangedEntity, uint32 OldMask, uint32 NewMask);
+
+    UTowerStatusEffectSubsystem* GetStore() const;
+
+    /** Fill one effect's icon: label over timer */
+    void UpdateEffectBox(FKeyedWidgetRows& Rows, const FActiveStatusEffect& Effect);
+
     UPROPERTY()
     TArray<FActiveStatusEffect> ActiveEffects;
+
+    UPROPERTY()
+    FKeyedWidgetRows BuffRows;
+
+    UPROPERTY()
+    FKeyedWidgetRows DebuffRows;
+
+    int64 Entity = 0;
+
+    FDelegateHandle ChangedHandle;
 };
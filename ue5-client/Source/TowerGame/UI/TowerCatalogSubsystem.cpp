@@ -0,0 +1,230 @@
+#include "TowerCatalogSubsystem.h"
+#include "Core/TowerGameSubsystem.h"
+#include "Core/StartupTimeline.h"
+#include "Async/Async.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+void UTowerCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    TOWER_STARTUP_SCOPE(TowerCatalogSubsystem);
+    Super::Initialize(Collection);
+
+    UTowerGameSubsystem* Game = Collection.InitializeDependency<UTowerGameSubsystem>();
+    if (!Game) return;
+    TowerGame = Game;
+
+    // Cosmetics and dyes are cosmetics config, abilities and spec branches abilities config,
+    // starter gems and runes loot config; monsters have no catalog here
+    for (const ETowerConfigDomain Domain : { ETowerConfigDomain::Cosmetics, ETowerConfigDomain::Abilities, ETowerConfigDomain::Loot })
+    {
+        DomainHandles[static_cast<int32>(Domain)] = Game->GetConfigCaches().Subscribe(Domain,
+            FSimpleDelegate::CreateUObject(this, &UTowerCatalogSubsystem::HandleDomainInvalidated, Domain));
+    }
+
+    Game->WhenRustCoreBooted(FSimpleDelegate::CreateUObject(this, &UTowerCatalogSubsystem::WarmUp));
+}
+
+void UTowerCatalogSubsystem::Deinitialize()
+{
+    // The worker calls into the bridge, which UTowerGameSubsystem shuts down after us
+    WarmUpTask.Wait();
+
+    if (UTowerGameSubsystem* Game = TowerGame.Get())
+    {
+        for (int32 i = 0; i < TowerConfigDomainCount; i++)
+        {
+            if (DomainHandles[i].IsValid())
+            {
+                Game->GetConfigCaches().Unsubscribe(static_cast<ETowerConfigDomain>(i), DomainHandles[i]);
+                DomainHandles[i].Reset();
+            }
+        }
+    }
+    TowerGame.Reset();
+
+    Cosmetics.Reset();
+    Dyes.Reset();
+    Gems.Reset();
+    Runes.Reset();
+    SpecBranches.Reset();
+    Abilities.Reset();
+    Super::Deinitialize();
+}
+
+// ============ Catalogs ============
+
+TSharedRef<const TTowerCatalog<FCosmeticItemDisplay>> UTowerCatalogSubsystem::GetCosmetics()
+{
+    return GetOrBuild(Cosmetics, &FProceduralCoreBridge::CosmeticGetAll, &UTransmogWidget::ParseCosmetics, TEXT("cosmetics"));
+}
+
+TSharedRef<const TTowerCatalog<FDyeDisplay>> UTowerCatalogSubsystem::GetDyes()
+{
+    return GetOrBuild(Dyes, &FProceduralCoreBridge::CosmeticGetAllDyes, &UTransmogWidget::ParseDyes, TEXT("dyes"));
+}
+
+TSharedRef<const TTowerCatalog<FGemDisplay>> UTowerCatalogSubsystem::GetGems()
+{
+    return GetOrBuild(Gems, &FProceduralCoreBridge::SocketGetStarterGems, &USocketWidget::ParseGems, TEXT("gems"));
+}
+
+TSharedRef<const TTowerCatalog<FRuneDisplay>> UTowerCatalogSubsystem::GetRunes()
+{
+    return GetOrBuild(Runes, &FProceduralCoreBridge::SocketGetStarterRunes, &USocketWidget::ParseRunes, TEXT("runes"));
+}
+
+TSharedRef<const TTowerCatalog<FSpecBranchDisplay>> UTowerCatalogSubsystem::GetSpecBranches()
+{
+    return GetOrBuild(SpecBranches, &FProceduralCoreBridge::SpecGetAllBranches, &USpecializationWidget::ParseBranches, TEXT("spec branches"));
+}
+
+TSharedRef<const TTowerCatalog<FAbilityDisplayData>> UTowerCatalogSubsystem::GetAbilities()
+{
+    return GetOrBuild(Abilities, &FProceduralCoreBridge::AbilityGetDefaults, &UAbilityBarWidget::ParseAbilities, TEXT("abilities"));
+}
+
+template <typename T>
+TSharedRef<const TTowerCatalog<T>> UTowerCatalogSubsystem::GetOrBuild(TSharedPtr<const TTowerCatalog<T>>& Cached,
+    FString (FProceduralCoreBridge::*Fetch)(), bool (*Parse)(const FString&, TArray<T>&), const TCHAR* Name)
+{
+    if (Cached.IsValid()) return Cached.ToSharedRef();
+
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || !Game->IsRustCoreReady())
+    {
+        // Empty for now, and asked again next time
+        return MakeShared<TTowerCatalog<T>>();
+    }
+
+    TSharedRef<TTowerCatalog<T>> Catalog = BuildCatalog(*Game->GetBridge(), Fetch, Parse, Name);
+    Cached = Catalog;
+    ReportCatalogMemory();
+    return Catalog;
+}
+
+template <typename T>
+TSharedRef<TTowerCatalog<T>> UTowerCatalogSubsystem::BuildCatalog(FProceduralCoreBridge& Bridge,
+    FString (FProceduralCoreBridge::*Fetch)(), bool (*Parse)(const FString&, TArray<T>&), const TCHAR* Name)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_BuildCatalog);
+    LLM_SCOPE_BYTAG(Tower_UI);
+    TSharedRef<TTowerCatalog<T>> Catalog = MakeShared<TTowerCatalog<T>>();
+    if (!Parse((Bridge.*Fetch)(), Catalog->Items))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("TowerCatalog: Failed to parse the %s catalog"), Name);
+    }
+
+    Catalog->IndexById.Reserve(Catalog->Items.Num());
+    for (int32 i = 0; i < Catalog->Items.Num(); i++)
+    {
+        Catalog->IndexById.Add(Catalog->Items[i].Id, i);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("TowerCatalog: Parsed %d %s"), Catalog->Items.Num(), Name);
+    return Catalog;
+}
+
+// ============ Warm-up ============
+
+void UTowerCatalogSubsystem::WarmUp()
+{
+    UTowerGameSubsystem* Game = TowerGame.Get();
+    if (!Game || !Game->IsRustCoreReady()) return;
+
+    struct FWarmCatalogs
+    {
+        TSharedPtr<const TTowerCatalog<FCosmeticItemDisplay>> Cosmetics;
+        TSharedPtr<const TTowerCatalog<FDyeDisplay>> Dyes;
+        TSharedPtr<const TTowerCatalog<FGemDisplay>> Gems;
+        TSharedPtr<const TTowerCatalog<FRuneDisplay>> Runes;
+        TSharedPtr<const TTowerCatalog<FSpecBranchDisplay>> SpecBranches;
+        TSharedPtr<const TTowerCatalog<FAbilityDisplayData>> Abilities;
+    };
+
+    FProceduralCoreBridge* Bridge = Game->GetBridge();
+    const uint32 Generation = CatalogGeneration;
+    TWeakObjectPtr<UTowerCatalogSubsystem> WeakThis(this);
+    WarmUpTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Bridge, Generation, WeakThis]()
+    {
+        TSharedRef<FWarmCatalogs, ESPMode::ThreadSafe> Warm = MakeShared<FWarmCatalogs, ESPMode::ThreadSafe>();
+        {
+            TOWER_STARTUP_SCOPE(CatalogWarmUp);
+            Warm->Cosmetics = BuildCatalog(*Bridge, &FProceduralCoreBridge::CosmeticGetAll, &UTransmogWidget::ParseCosmetics, TEXT("cosmetics"));
+            Warm->Dyes = BuildCatalog(*Bridge, &FProceduralCoreBridge::CosmeticGetAllDyes, &UTransmogWidget::ParseDyes, TEXT("dyes"));
+            Warm->Gems = BuildCatalog(*Bridge, &FProceduralCoreBridge::SocketGetStarterGems, &USocketWidget::ParseGems, TEXT("gems"));
+            Warm->Runes = BuildCatalog(*Bridge, &FProceduralCoreBridge::SocketGetStarterRunes, &USocketWidget::ParseRunes, TEXT("runes"));
+            Warm->SpecBranches = BuildCatalog(*Bridge, &FProceduralCoreBridge::SpecGetAllBranches, &USpecializationWidget::ParseBranches, TEXT("spec branches"));
+            Warm->Abilities = BuildCatalog(*Bridge, &FProceduralCoreBridge::AbilityGetDefaults, &UAbilityBarWidget::ParseAbilities, TEXT("abilities"));
+        }
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Warm]()
+        {
+            UTowerCatalogSubsystem* This = WeakThis.Get();
+            if (!This || This->CatalogGeneration != Generation) return;
+
+            // A Get that ran meanwhile built its own; keep that one
+            if (!This->Cosmetics.IsValid()) This->Cosmetics = Warm->Cosmetics;
+            if (!This->Dyes.IsValid()) This->Dyes = Warm->Dyes;
+            if (!This->Gems.IsValid()) This->Gems = Warm->Gems;
+            if (!This->Runes.IsValid()) This->Runes = Warm->Runes;
+            if (!This->SpecBranches.IsValid()) This->SpecBranches = Warm->SpecBranches;
+            if (!This->Abilities.IsValid()) This->Abilities = Warm->Abilities;
+            This->ReportCatalogMemory();
+        });
+    });
+}
+
+// ============ Invalidation ============
+
+void UTowerCatalogSubsystem::InvalidateAll()
+{
+    Invalidate(Cosmetics, ETowerCatalog::Cosmetics);
+    Invalidate(Dyes, ETowerCatalog::Dyes);
+    Invalidate(Gems, ETowerCatalog::Gems);
+    Invalidate(Runes, ETowerCatalog::Runes);
+    Invalidate(SpecBranches, ETowerCatalog::SpecBranches);
+    Invalidate(Abilities, ETowerCatalog::Abilities);
+}
+
+template <typename T>
+void UTowerCatalogSubsystem::Invalidate(TSharedPtr<const TTowerCatalog<T>>& Cached, ETowerCatalog Catalog)
+{
+    CatalogGeneration++;
+    if (!Cached.IsValid()) return;
+    Cached.Reset();
+    ReportCatalogMemory();
+    OnCatalogInvalidated.Broadcast(Catalog);
+}
+
+void UTowerCatalogSubsystem::ReportCatalogMemory()
+{
+    int64 Bytes = 0;
+    if (Cosmetics.IsValid()) Bytes += Cosmetics->GetAllocatedSize();
+    if (Dyes.IsValid()) Bytes += Dyes->GetAllocatedSize();
+    if (Gems.IsValid()) Bytes += Gems->GetAllocatedSize();
+    if (Runes.IsValid()) Bytes += Runes->GetAllocatedSize();
+    if (SpecBranches.IsValid()) Bytes += SpecBranches->GetAllocatedSize();
+    if (Abilities.IsValid()) Bytes += Abilities->GetAllocatedSize();
+    CatalogMemory.Set(Bytes);
+}
+
+void UTowerCatalogSubsystem::HandleDomainInvalidated(ETowerConfigDomain Domain)
+{
+    switch (Domain)
+    {
+    case ETowerConfigDomain::Cosmetics:
+        Invalidate(Cosmetics, ETowerCatalog::Cosmetics);
+        Invalidate(Dyes, ETowerCatalog::Dyes);
+        break;
+    case ETowerConfigDomain::Abilities:
+        Invalidate(SpecBranches, ETowerCatalog::SpecBranches);
+        Invalidate(Abilities, ETowerCatalog::Abilities);
+        break;
+    case ETowerConfigDomain::Loot:
+        Invalidate(Gems, ETowerCatalog::Gems);
+        Invalidate(Runes, ETowerCatalog::Runes);
+        break;
+    default:
+        break;
+    }
+}
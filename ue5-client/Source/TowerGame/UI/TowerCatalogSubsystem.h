@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Bridge/ProceduralCoreBridge.h"
+#include "Core/TowerMemory.h"
+#include "Tasks/Task.h"
+#include "TransmogWidget.h"
+#include "SocketWidget.h"
+#include "SpecializationWidget.h"
+#include "AbilityBarWidget.h"
+#include "TowerCatalogSubsystem.generated.h"
+
+class UTowerGameSubsystem;
+
+/** The static catalogs UTowerCatalogSubsystem holds */
+enum class ETowerCatalog : uint8
+{
+    Cosmetics,
+    Dyes,
+    Gems,
+    Runes,
+    SpecBranches,
+    Abilities,
+};
+
+/** One parsed catalog: entries in bridge order plus an index by id. Never changed once built. */
+template <typename T>
+struct TTowerCatalog
+{
+    TArray<T> Items;
+    TMap<FString, int32> IndexById;
+
+    const T* Find(const FString& Id) const
+    {
+        const int32* Index = IndexById.Find(Id);
+        return Index ? &Items[*Index] : nullptr;
+    }
+
+    /** Container bytes held (strings inside the items not included) */
+    SIZE_T GetAllocatedSize() const { return Items.GetAllocatedSize() + IndexById.GetAllocatedSize(); }
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTowerCatalogInvalidated, ETowerCatalog);
+
+/**
+ * The bridge's static catalogs (cosmetics, dyes, starter gems and runes,
+ * specialization branches, default abilities), each fetched and parsed once
+ * into display structs and shared by every widget that shows them.
+ *
+ * A catalog is built on first Get and handed out as a shared snapshot, so a
+ * widget opening is a copy instead of a DLL call plus a JSON parse. Once the
+ * Rust core has booted, every catalog is also warmed on a worker, so the first
+ * Get usually finds it built. A hot
+ * reload that moves the catalog's config domain drops it (see
+ * FTowerConfigCacheRegistry) and the next Get rebuilds it; snapshots already
+ * handed out stay valid. Nothing is cached while the Rust core isn't loaded.
+ *
+ * Game thread only (the warm-up worker only builds; it installs on the game thread).
+ */
+UCLASS()
+class TOWERGAME_API UTowerCatalogSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    TSharedRef<const TTowerCatalog<FCosmeticItemDisplay>> GetCosmetics();
+    TSharedRef<const TTowerCatalog<FDyeDisplay>> GetDyes();
+    TSharedRef<const TTowerCatalog<FGemDisplay>> GetGems();
+    TSharedRef<const TTowerCatalog<FRuneDisplay>> GetRunes();
+    TSharedRef<const TTowerCatalog<FSpecBranchDisplay>> GetSpecBranches();
+    TSharedRef<const TTowerCatalog<FAbilityDisplayData>> GetAbilities();
+
+    /** Drop every catalog; they are rebuilt on next use */
+    void InvalidateAll();
+
+    /** A catalog was dropped; open widgets showing it may reload */
+    FOnTowerCatalogInvalidated OnCatalogInvalidated;
+
+private:
+    template <typename T>
+    TSharedRef<const TTowerCatalog<T>> GetOrBuild(TSharedPtr<const TTowerCatalog<T>>& Cached,
+        FString (FProceduralCoreBridge::*Fetch)(), bool (*Parse)(const FString&, TArray<T>&), const TCHAR* Name);
+
+    /** Fetch, parse and index one catalog; any thread (the catalog getters are pure bridge calls) */
+    template <typename T>
+    static TSharedRef<TTowerCatalog<T>> BuildCatalog(FProceduralCoreBridge& Bridge,
+        FString (FProceduralCoreBridge::*Fetch)(), bool (*Parse)(const FString&, TArray<T>&), const TCHAR* Name);
+
+    /** Build every catalog on a worker and install the ones still missing; after the core has booted */
+    void WarmUp();
+
+    /** Bumped by every invalidation, so a warm-up that raced a hot reload is dropped */
+    uint32 CatalogGeneration = 0;
+    UE::Tasks::FTask WarmUpTask;
+
+    template <typename T>
+    void Invalidate(TSharedPtr<const TTowerCatalog<T>>& Cached, ETowerCatalog Catalog);
+
+    void HandleDomainInvalidated(ETowerConfigDomain Domain);
+
+    /** Re-measure the cached catalogs into CatalogMemory */
+    void ReportCatalogMemory();
+
+    TWeakObjectPtr<UTowerGameSubsystem> TowerGame;
+    FDelegateHandle DomainHandles[TowerConfigDomainCount];
+
+    TSharedPtr<const TTowerCatalog<FCosmeticItemDisplay>> Cosmetics;
+    TSharedPtr<const TTowerCatalog<FDyeDisplay>> Dyes;
+    TSharedPtr<const TTowerCatalog<FGemDisplay>> Gems;
+    TSharedPtr<const TTowerCatalog<FRuneDisplay>> Runes;
+    TSharedPtr<const TTowerCatalog<FSpecBranchDisplay>> SpecBranches;
+    TSharedPtr<const TTowerCatalog<FAbilityDisplayData>> Abilities;
+
+    FTowerMemoryReport CatalogMemory{ ETowerMemoryBucket::UI };
+};
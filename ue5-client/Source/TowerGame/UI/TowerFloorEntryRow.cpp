@@ -0,0 +1,21 @@
+#include "TowerFloorEntryRow.h"
+#include "TowerMapWidget.h"
+
+void UTowerFloorEntryRow::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	Item = Cast<UTowerFloorListItem>(ListItemObject);
+	Refresh();
+}
+
+void UTowerFloorEntryRow::Refresh()
+{
+	const UTowerMapWidget* Map = Item ? Item->Map.Get() : nullptr;
+	const FTowerFloorEntry* Entry = Map ? Map->FindFloor(Item->FloorId) : nullptr;
+	if (!Entry)
+	{
+		return;
+	}
+
+	UTowerMapWidget::FillFloorRow(*Entry, FloorIdText, TierText, ClearedText,
+		CompletionBar, CompletionText, BestTimeText, DeathsText);
+}
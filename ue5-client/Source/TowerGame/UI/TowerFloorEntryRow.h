@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "TowerFloorEntryRow.generated.h"
+
+class UTextBlock;
+class UProgressBar;
+class UTowerMapWidget;
+
+/// One discovered floor as a UListView item. UTowerMapWidget keeps one per
+/// floor it has listed; the entry itself stays in the map widget.
+UCLASS()
+class TOWERGAME_API UTowerFloorListItem : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	int32 FloorId = 0;
+
+	TWeakObjectPtr<UTowerMapWidget> Map;
+};
+
+/// Row widget for the tower map UListView. Subclass in Blueprint with any of
+/// the optional children below and set it as the list's Entry Widget Class;
+/// the list only creates rows for the floors on screen.
+UCLASS(Abstract)
+class TOWERGAME_API UTowerFloorEntryRow : public UUserWidget, public IUserObjectListEntry
+{
+	GENERATED_BODY()
+
+public:
+	/// Show the floor's current progress; also called when it changes under this row
+	void Refresh();
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* FloorIdText = nullptr;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* TierText = nullptr;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* ClearedText = nullptr;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UProgressBar* CompletionBar = nullptr;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* CompletionText = nullptr;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* BestTimeText = nullptr;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* DeathsText = nullptr;
+
+protected:
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+
+private:
+	UPROPERTY()
+	UTowerFloorListItem* Item = nullptr;
+};
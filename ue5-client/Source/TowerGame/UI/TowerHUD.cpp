@@ -1,6 +1,16 @@
 #include "TowerHUD.h"
 #include "TowerHUDWidget.h"
+#include "Network/TowerNetworkSubsystem.h"
 #include "Blueprint/UserWidget.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarTowerNetOverlay(
+    TEXT("tower.NetOverlay"),
+    0,
+    TEXT("Draw network stats on the HUD. 0: off, 1: totals, 2: totals and per message type"),
+    ECVF_Cheat);
 
 ATowerHUD::ATowerHUD()
 {
@@ -24,3 +34,61 @@ void ATowerHUD::BeginPlay()
         UE_LOG(LogTemp, Warning, TEXT("No HUD widget class assigned — using C++ fallback"));
     }
 }
+
+void ATowerHUD::DrawHUD()
+{
+    Super::DrawHUD();
+
+    if (CVarTowerNetOverlay.GetValueOnGameThread() > 0)
+    {
+        DrawNetOverlay();
+    }
+}
+
+void ATowerHUD::DrawNetOverlay()
+{
+    UTowerNetworkSubsystem* Network = UNetworkBlueprintLibrary::GetTowerNetworkSubsystem(this);
+    if (!Network || !Canvas)
+    {
+        return;
+    }
+
+    const FNetworkStats Stats = Network->GetNetworkStats();
+    UFont* Font = GEngine->GetSmallFont();
+    const float LineHeight = Font->GetMaxCharHeight() + 2.0f;
+    const float X = 16.0f;
+    float Y = Canvas->ClipY * 0.25f;
+
+    auto DrawLine = [&](const FString& Line, const FLinearColor& Color)
+    {
+        DrawText(Line, Color, X, Y, Font);
+        Y += LineHeight;
+    };
+
+    DrawLine(FString::Printf(TEXT("Net %s  in %.1f KB/s  out %.1f KB/s  pool drops %d  compression %.0f%%"),
+        Stats.bConnected ? TEXT("connected") : TEXT("offline"),
+        Stats.BytesInPerSec / 1024.0f, Stats.BytesOutPerSec / 1024.0f, Stats.PacketsDropped,
+        Stats.CompressionRatio * 100.0f), FLinearColor::White);
+
+    // Amber once loss or jitter is high enough to show up as visible correction
+    const bool bDegraded = Stats.SnapshotLossPercent > 2.0f || Stats.JitterMs > 30.0f;
+    DrawLine(FString::Printf(TEXT("Snapshots  loss %.1f%%  reorder %.1f%%  jitter %.1f ms  buffer %d/%d"),
+        Stats.SnapshotLossPercent, Stats.SnapshotReorderPercent, Stats.JitterMs,
+        Stats.SnapshotBufferDepth, Stats.SnapshotBufferCapacity),
+        bDegraded ? FLinearColor(1.0f, 0.6f, 0.1f) : FLinearColor::White);
+
+    if (CVarTowerNetOverlay.GetValueOnGameThread() < 2)
+    {
+        return;
+    }
+
+    const UEnum* ChannelEnum = StaticEnum<ETowerNetChannel>();
+    for (const FNetChannelStats& Channel : Stats.Channels)
+    {
+        DrawLine(FString::Printf(TEXT("  %-18s in %6.1f/s %7.2f KB/s  out %6.1f/s %7.2f KB/s  decode %.1f us (max %.1f)"),
+            *ChannelEnum->GetDisplayNameTextByValue(static_cast<int64>(Channel.Channel)).ToString(),
+            Channel.PacketsInPerSec, Channel.BytesInPerSec / 1024.0f,
+            Channel.PacketsOutPerSec, Channel.BytesOutPerSec / 1024.0f,
+            Channel.AvgDecodeMicros, Channel.MaxDecodeMicros), FLinearColor(0.7f, 0.85f, 1.0f));
+    }
+}
@@ -20,6 +20,7 @@ public:
     ATowerHUD();
 
     virtual void BeginPlay() override;
+    virtual void DrawHUD() override;
 
     /** The main HUD widget class to spawn */
     UPROPERTY(EditDefaultsOnly, Category = "Tower|UI")
@@ -28,4 +29,8 @@ public:
     /** Reference to the spawned widget */
     UPROPERTY()
     UTowerHUDWidget* HUDWidget;
+
+protected:
+    /** Bandwidth / loss / jitter readout, toggled with tower.NetOverlay */
+    void DrawNetOverlay();
 };
@@ -4,114 +4,231 @@
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
 #include "Kismet/GameplayStatics.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    /** Bar fill steps finer than this aren't visible, so they don't invalidate the bar */
+    constexpr float BarPercentStep = 0.001f;
+
+    /** SetPercent only when the fill moved a visible amount; returns whether it did */
+    bool SetBarPercent(UProgressBar* Bar, float Pct, float& ShownPct)
+    {
+        Pct = FMath::Clamp(Pct, 0.0f, 1.0f);
+        if (!Bar || FMath::Abs(Pct - ShownPct) < BarPercentStep) return false;
+        ShownPct = Pct;
+        Bar->SetPercent(Pct);
+        return true;
+    }
+}
 
 void UTowerHUDWidget::NativeConstruct()
 {
     Super::NativeConstruct();
+
+    // Resource colours never change; set them once rather than per update
+    if (KineticBar) KineticBar->SetFillColorAndOpacity(FLinearColor(1.0f, 0.6f, 0.1f));   // Orange
+    if (ThermalBar) ThermalBar->SetFillColorAndOpacity(FLinearColor(0.2f, 0.6f, 1.0f));   // Blue
+    if (SemanticBar) SemanticBar->SetFillColorAndOpacity(FLinearColor(0.6f, 0.2f, 0.9f)); // Purple
+
+    if (APlayerController* PC = GetOwningPlayer())
+    {
+        PC->OnPossessedPawnChanged.AddUniqueDynamic(this, &UTowerHUDWidget::HandlePossessedPawnChanged);
+    }
+    BindPlayer(GetPlayerCharacter());
+    BindGameState();
     RefreshHUD();
 }
 
-void UTowerHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UTowerHUDWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    if (APlayerController* PC = GetOwningPlayer())
+    {
+        PC->OnPossessedPawnChanged.RemoveDynamic(this, &UTowerHUDWidget::HandlePossessedPawnChanged);
+    }
+    BindPlayer(nullptr);
+    if (ATowerGameState* GS = BoundGameState.Get())
+    {
+        GS->OnTowerStateChanged.Remove(TowerStateChangedHandle);
+    }
+    BoundGameState.Reset();
+
+    Super::NativeDestruct();
+}
+
+// ============ Bindings ============
+
+void UTowerHUDWidget::BindPlayer(ATowerPlayerCharacter* Player)
+{
+    if (BoundPlayer.Get() == Player) return;
+
+    if (ATowerPlayerCharacter* Old = BoundPlayer.Get())
+    {
+        Old->OnStatsChanged.Remove(StatsChangedHandle);
+    }
+    BoundPlayer = Player;
+    if (Player)
+    {
+        StatsChangedHandle = Player->OnStatsChanged.AddUObject(this, &UTowerHUDWidget::HandleStatsChanged);
+    }
+}
+
+void UTowerHUDWidget::BindGameState()
+{
+    ATowerGameState* GS = GetGameState();
+    if (!GS || BoundGameState.Get() == GS) return;
+
+    if (ATowerGameState* Old = BoundGameState.Get())
+    {
+        Old->OnTowerStateChanged.Remove(TowerStateChangedHandle);
+    }
+    TowerStateChangedHandle = GS->OnTowerStateChanged.AddUObject(this, &UTowerHUDWidget::HandleTowerStateChanged);
+    BoundGameState = GS;
+}
+
+void UTowerHUDWidget::HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn)
+{
+    BindPlayer(Cast<ATowerPlayerCharacter>(NewPawn));
+    // The game state replicates in after the HUD on a late join
+    BindGameState();
     RefreshHUD();
 }
 
+void UTowerHUDWidget::HandleStatsChanged(ETowerPlayerStats Changed)
+{
+    const ATowerPlayerCharacter* Player = BoundPlayer.Get();
+    if (!Player) return;
+
+    if (EnumHasAnyFlags(Changed, ETowerPlayerStats::Health)) UpdateHealth(*Player);
+    UpdateResources(*Player, Changed);
+    if (EnumHasAnyFlags(Changed, ETowerPlayerStats::Combo)) UpdateCombo(*Player);
+}
+
+void UTowerHUDWidget::HandleTowerStateChanged()
+{
+    if (const ATowerGameState* GS = BoundGameState.Get())
+    {
+        UpdateWorldState(*GS);
+    }
+}
+
+// ============ Elements ============
+
 void UTowerHUDWidget::RefreshHUD()
 {
-    ATowerPlayerCharacter* Player = GetPlayerCharacter();
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_TowerHUD_RefreshHUD);
+    if (const ATowerPlayerCharacter* Player = GetPlayerCharacter())
+    {
+        UpdateHealth(*Player);
+        UpdateResources(*Player, ETowerPlayerStats::All);
+        UpdateCombo(*Player);
+    }
 
-    // ---- Health ----
-    if (Player && HealthBar)
+    if (const ATowerGameState* GS = GetGameState())
     {
-        float Pct = Player->MaxHp > 0.0f ? Player->CurrentHp / Player->MaxHp : 0.0f;
-        HealthBar->SetPercent(Pct);
+        UpdateWorldState(*GS);
+    }
+}
 
+void UTowerHUDWidget::UpdateHealth(const ATowerPlayerCharacter& Player)
+{
+    const float Pct = Player.MaxHp > 0.0f ? Player.CurrentHp / Player.MaxHp : 0.0f;
+    if (SetBarPercent(HealthBar, Pct, ShownHealthPct))
+    {
         // Color: green > yellow > red
         FLinearColor BarColor;
-        if (Pct > 0.5f)
-            BarColor = FLinearColor::LerpUsingHSV(FLinearColor::Yellow, FLinearColor::Green, (Pct - 0.5f) * 2.0f);
+        if (ShownHealthPct > 0.5f)
+            BarColor = FLinearColor::LerpUsingHSV(FLinearColor::Yellow, FLinearColor::Green, (ShownHealthPct - 0.5f) * 2.0f);
         else
-            BarColor = FLinearColor::LerpUsingHSV(FLinearColor::Red, FLinearColor::Yellow, Pct * 2.0f);
+            BarColor = FLinearColor::LerpUsingHSV(FLinearColor::Red, FLinearColor::Yellow, ShownHealthPct * 2.0f);
         HealthBar->SetFillColorAndOpacity(BarColor);
     }
-    if (Player && HealthText)
+
+    // The text shows whole points, so fractional damage doesn't rebuild it
+    const int32 Hp = FMath::RoundToInt32(Player.CurrentHp);
+    const int32 MaxHpShown = FMath::RoundToInt32(Player.MaxHp);
+    if (HealthText && (Hp != ShownHp || MaxHpShown != ShownMaxHp))
     {
-        HealthText->SetText(FText::FromString(
-            FString::Printf(TEXT("%.0f / %.0f"), Player->CurrentHp, Player->MaxHp)));
+        ShownHp = Hp;
+        ShownMaxHp = MaxHpShown;
+        HealthText->SetText(FText::FromString(FString::Printf(TEXT("%d / %d"), Hp, MaxHpShown)));
     }
+}
 
-    // ---- Resources ----
-    if (Player)
+void UTowerHUDWidget::UpdateResources(const ATowerPlayerCharacter& Player, ETowerPlayerStats Changed)
+{
+    if (EnumHasAnyFlags(Changed, ETowerPlayerStats::Kinetic))
     {
-        if (KineticBar)
-        {
-            KineticBar->SetPercent(Player->KineticEnergy / 100.0f);
-            KineticBar->SetFillColorAndOpacity(FLinearColor(1.0f, 0.6f, 0.1f)); // Orange
-        }
-        if (ThermalBar)
-        {
-            ThermalBar->SetPercent(Player->ThermalEnergy / 100.0f);
-            ThermalBar->SetFillColorAndOpacity(FLinearColor(0.2f, 0.6f, 1.0f)); // Blue
-        }
-        if (SemanticBar)
-        {
-            SemanticBar->SetPercent(Player->SemanticEnergy / 100.0f);
-            SemanticBar->SetFillColorAndOpacity(FLinearColor(0.6f, 0.2f, 0.9f)); // Purple
-        }
+        SetBarPercent(KineticBar, Player.KineticEnergy / 100.0f, ShownKineticPct);
     }
-
-    // ---- Combo ----
-    if (Player && ComboText)
+    if (EnumHasAnyFlags(Changed, ETowerPlayerStats::Thermal))
     {
-        if (Player->ComboStep > 0)
-        {
-            ComboText->SetText(FText::FromString(
-                FString::Printf(TEXT("COMBO x%d"), Player->ComboStep)));
-            ComboText->SetVisibility(ESlateVisibility::Visible);
-        }
-        else
-        {
-            ComboText->SetVisibility(ESlateVisibility::Hidden);
-        }
+        SetBarPercent(ThermalBar, Player.ThermalEnergy / 100.0f, ShownThermalPct);
     }
+    if (EnumHasAnyFlags(Changed, ETowerPlayerStats::Semantic))
+    {
+        SetBarPercent(SemanticBar, Player.SemanticEnergy / 100.0f, ShownSemanticPct);
+    }
+}
 
-    // ---- World State ----
-    ATowerGameState* GS = GetGameState();
+void UTowerHUDWidget::UpdateCombo(const ATowerPlayerCharacter& Player)
+{
+    if (!ComboText || Player.ComboStep == ShownCombo) return;
+    ShownCombo = Player.ComboStep;
 
-    if (GS && FloorText)
+    if (ShownCombo > 0)
     {
-        FloorText->SetText(FText::FromString(
-            FString::Printf(TEXT("Floor %d"), GS->ActiveFloor)));
+        ComboText->SetText(FText::FromString(FString::Printf(TEXT("COMBO x%d"), ShownCombo)));
+        ComboText->SetVisibility(ESlateVisibility::Visible);
+    }
+    else
+    {
+        ComboText->SetVisibility(ESlateVisibility::Hidden);
+    }
+}
+
+void UTowerHUDWidget::UpdateWorldState(const ATowerGameState& GS)
+{
+    if (FloorText && GS.ActiveFloor != ShownFloor)
+    {
+        ShownFloor = GS.ActiveFloor;
+        FloorText->SetText(FText::FromString(FString::Printf(TEXT("Floor %d"), ShownFloor)));
     }
 
-    if (GS && BreathText)
+    const int32 BreathPercent = FMath::RoundToInt32(GS.BreathProgress * 100.0f);
+    if (BreathText && (BreathPercent != ShownBreathPercent || GS.BreathPhase != ShownBreathPhase))
     {
-        FString BreathDisplay = FString::Printf(TEXT("%s (%.0f%%)"),
-            *GS->BreathPhase, GS->BreathProgress * 100.0f);
-        BreathText->SetText(FText::FromString(BreathDisplay));
+        const bool bPhaseChanged = GS.BreathPhase != ShownBreathPhase;
+        ShownBreathPercent = BreathPercent;
+        ShownBreathPhase = GS.BreathPhase;
+        BreathText->SetText(FText::FromString(FString::Printf(TEXT("%s (%d%%)"), *ShownBreathPhase, BreathPercent)));
 
         // Color based on phase
-        FSlateColor PhaseColor;
-        if (GS->BreathPhase == TEXT("Inhale"))
-            PhaseColor = FSlateColor(FLinearColor(0.3f, 0.8f, 0.3f)); // Green
-        else if (GS->BreathPhase == TEXT("Hold"))
-            PhaseColor = FSlateColor(FLinearColor(1.0f, 0.8f, 0.2f)); // Gold
-        else if (GS->BreathPhase == TEXT("Exhale"))
-            PhaseColor = FSlateColor(FLinearColor(0.8f, 0.3f, 0.3f)); // Red
-        else
-            PhaseColor = FSlateColor(FLinearColor(0.5f, 0.5f, 0.7f)); // Gray-blue
-        BreathText->SetColorAndOpacity(PhaseColor);
+        if (bPhaseChanged)
+        {
+            FSlateColor PhaseColor;
+            if (ShownBreathPhase == TEXT("Inhale"))
+                PhaseColor = FSlateColor(FLinearColor(0.3f, 0.8f, 0.3f)); // Green
+            else if (ShownBreathPhase == TEXT("Hold"))
+                PhaseColor = FSlateColor(FLinearColor(1.0f, 0.8f, 0.2f)); // Gold
+            else if (ShownBreathPhase == TEXT("Exhale"))
+                PhaseColor = FSlateColor(FLinearColor(0.8f, 0.3f, 0.3f)); // Red
+            else
+                PhaseColor = FSlateColor(FLinearColor(0.5f, 0.5f, 0.7f)); // Gray-blue
+            BreathText->SetColorAndOpacity(PhaseColor);
+        }
     }
 
-    if (GS && MonstersText)
+    const int32 Stairs = GS.bStairsUnlocked ? 1 : 0;
+    if (MonstersText && (GS.MonstersRemaining != ShownMonsters || Stairs != ShownStairs))
     {
-        if (GS->MonstersRemaining > 0)
+        ShownMonsters = GS.MonstersRemaining;
+        ShownStairs = Stairs;
+        if (ShownMonsters > 0)
         {
-            MonstersText->SetText(FText::FromString(
-                FString::Printf(TEXT("Monsters: %d"), GS->MonstersRemaining)));
+            MonstersText->SetText(FText::FromString(FString::Printf(TEXT("Monsters: %d"), ShownMonsters)));
         }
-        else if (GS->bStairsUnlocked)
+        else if (GS.bStairsUnlocked)
         {
             MonstersText->SetText(FText::FromString(TEXT("Stairs Unlocked!")));
         }
@@ -2,13 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "TowerGame/Player/TowerPlayerCharacter.h"
 #include "TowerHUDWidget.generated.h"
 
 class UProgressBar;
 class UTextBlock;
 class UVerticalBox;
-class ATowerPlayerCharacter;
 class ATowerGameState;
+class APawn;
 
 /**
  * Main HUD widget — bound to player character stats.
@@ -19,15 +20,20 @@ class ATowerGameState;
  *   [Top-Right]  Monsters remaining
  *   [Bottom-Left] HP bar + Resource bars
  *   [Bottom-Center] Combo counter
+ *
+ * Doesn't tick: elements update from ATowerPlayerCharacter::OnStatsChanged
+ * and ATowerGameState::OnTowerStateChanged, and each skips the widget call
+ * when its displayed value is unchanged, so a still HUD costs nothing and
+ * can sit in an Invalidation Box.
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class TOWERGAME_API UTowerHUDWidget : public UUserWidget
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
 
     // ============ Health ============
 
@@ -70,4 +76,39 @@ protected:
 
     ATowerPlayerCharacter* GetPlayerCharacter() const;
     ATowerGameState* GetGameState() const;
+
+private:
+    void BindPlayer(ATowerPlayerCharacter* Player);
+    void BindGameState();
+
+    UFUNCTION()
+    void HandlePossessedPawnChanged(APawn* OldPawn, APawn* NewPawn);
+
+    void HandleStatsChanged(ETowerPlayerStats Changed);
+    void HandleTowerStateChanged();
+
+    void UpdateHealth(const ATowerPlayerCharacter& Player);
+    void UpdateResources(const ATowerPlayerCharacter& Player, ETowerPlayerStats Changed);
+    void UpdateCombo(const ATowerPlayerCharacter& Player);
+    void UpdateWorldState(const ATowerGameState& GS);
+
+    TWeakObjectPtr<ATowerPlayerCharacter> BoundPlayer;
+    FDelegateHandle StatsChangedHandle;
+
+    TWeakObjectPtr<ATowerGameState> BoundGameState;
+    FDelegateHandle TowerStateChangedHandle;
+
+    // What the widgets show now; INDEX_NONE until first set
+    int32 ShownHp = INDEX_NONE;
+    int32 ShownMaxHp = INDEX_NONE;
+    float ShownHealthPct = -1.0f;
+    float ShownKineticPct = -1.0f;
+    float ShownThermalPct = -1.0f;
+    float ShownSemanticPct = -1.0f;
+    int32 ShownCombo = INDEX_NONE;
+    int32 ShownFloor = INDEX_NONE;
+    FString ShownBreathPhase;
+    int32 ShownBreathPercent = INDEX_NONE;
+    int32 ShownMonsters = INDEX_NONE;
+    int32 ShownStairs = INDEX_NONE;
 };
@@ -7,11 +7,19 @@
 #include "Components/ProgressBar.h"
 #include "Components/Image.h"
 #include "Components/ComboBoxString.h"
+#include "Components/ListView.h"
+#include "TowerFloorEntryRow.h"
+#include "FloorPreviewSubsystem.h"
+#include "World/GameplayEventSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
+#include "Algo/BinarySearch.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Bridge/ProceduralCoreBridge.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 // Forward declare the bridge (singleton)
 static FProceduralCoreBridge* GetBridge()
@@ -42,12 +50,35 @@ void UTowerMapWidget::NativeConstruct()
 		TierFilterBox->OnSelectionChanged.AddDynamic(this, &UTowerMapWidget::OnTierFilterChanged);
 	}
 
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UTowerFloorPreviewSubsystem* Previews = GI->GetSubsystem<UTowerFloorPreviewSubsystem>())
+		{
+			PreviewReadyHandle = Previews->OnPreviewReady.AddUObject(this, &UTowerMapWidget::HandlePreviewReady);
+		}
+	}
+
+	if (UTowerGameplayEventSubsystem* Events = GetWorld() ? GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>() : nullptr)
+	{
+		GameplayEventsHandle = Events->OnEvents.AddUObject(this, &UTowerMapWidget::HandleGameplayEvents);
+	}
+
 	// Detail close button
 	if (DetailCloseButton)
 	{
 		DetailCloseButton->OnClicked.AddDynamic(this, &UTowerMapWidget::OnDetailCloseClicked);
 	}
 
+	// Floor list
+	if (FloorListView)
+	{
+		FloorListView->OnItemClicked().AddUObject(this, &UTowerMapWidget::HandleFloorItemClicked);
+	}
+	else if (FloorListBox)
+	{
+		FloorRows.Init(this, FloorListBox);
+	}
+
 	// Hide detail panel initially
 	if (DetailPanel)
 	{
@@ -60,6 +91,21 @@ void UTowerMapWidget::NativeConstruct()
 
 void UTowerMapWidget::NativeDestruct()
 {
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UTowerFloorPreviewSubsystem* Previews = GI->GetSubsystem<UTowerFloorPreviewSubsystem>())
+		{
+			Previews->OnPreviewReady.Remove(PreviewReadyHandle);
+		}
+	}
+	PreviewReadyHandle.Reset();
+
+	if (UTowerGameplayEventSubsystem* Events = GetWorld() ? GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>() : nullptr)
+	{
+		Events->OnEvents.Remove(GameplayEventsHandle);
+	}
+	GameplayEventsHandle.Reset();
+
 	Super::NativeDestruct();
 }
 
@@ -76,7 +122,9 @@ void UTowerMapWidget::CreateEmptyMap()
 	FString MapJson = Bridge->GenerateFloor(0, 0); // Placeholder: need towermap_create wrapper
 	// For now, create empty JSON
 	CurrentMapJson = TEXT("{}");
-	CachedFloors.Empty();
+	Floors.Empty();
+	FloorItems.Empty();
+	RebuildIndex();
 	CurrentOverview = FTowerMapOverview();
 
 	if (bAutoRefreshUI)
@@ -102,13 +150,33 @@ void UTowerMapWidget::LoadMapFromJson(const FString& MapJson)
 	OnMapUpdated.Broadcast();
 }
 
+static ETowerTier ParseTier(const TSharedPtr<FJsonObject>& FloorObj, int32 FloorId)
+{
+	FString TierName;
+	if (FloorObj->TryGetStringField(TEXT("tier"), TierName))
+	{
+		if (TierName == TEXT("Echelon1")) return ETowerTier::Echelon1;
+		if (TierName == TEXT("Echelon2")) return ETowerTier::Echelon2;
+		if (TierName == TEXT("Echelon3")) return ETowerTier::Echelon3;
+		if (TierName == TEXT("Echelon4")) return ETowerTier::Echelon4;
+	}
+
+	// Same split as FloorTier::from_floor_id
+	if (FloorId <= 100) return ETowerTier::Echelon1;
+	if (FloorId <= 300) return ETowerTier::Echelon2;
+	if (FloorId <= 500) return ETowerTier::Echelon3;
+	return ETowerTier::Echelon4;
+}
+
 void UTowerMapWidget::ParseMapJson()
 {
-	CachedFloors.Empty();
+	Floors.Empty();
+	FloorItems.Empty();
+	CurrentOverview = FTowerMapOverview();
 
 	if (CurrentMapJson.IsEmpty())
 	{
-		CurrentOverview = FTowerMapOverview();
+		RebuildIndex();
 		return;
 	}
 
@@ -118,43 +186,60 @@ void UTowerMapWidget::ParseMapJson()
 	if (!FJsonSerializer::Deserialize(Reader, Json) || !Json.IsValid())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Failed to parse tower map JSON"));
+		RebuildIndex();
 		return;
 	}
 
-	// Parse floors array
+	// Floors come as an array, or as the Rust TowerMap's map keyed by floor id
+	TArray<TSharedPtr<FJsonObject>> FloorObjects;
 	const TArray<TSharedPtr<FJsonValue>>* FloorsArray = nullptr;
+	const TSharedPtr<FJsonObject>* FloorsMap = nullptr;
 	if (Json->TryGetArrayField(TEXT("floors"), FloorsArray))
 	{
 		for (const TSharedPtr<FJsonValue>& FloorValue : *FloorsArray)
 		{
-			const TSharedPtr<FJsonObject> FloorObj = FloorValue->AsObject();
-			if (!FloorObj.IsValid()) continue;
-
-			FTowerFloorEntry Entry;
-			Entry.FloorId = FloorObj->GetIntegerField(TEXT("floor_id"));
-			Entry.Tier = ETowerTier::Echelon1; // Parse from JSON (TODO: parse actual tier from JSON)
-			Entry.bDiscovered = FloorObj->GetBoolField(TEXT("discovered"));
-			Entry.bCleared = FloorObj->GetBoolField(TEXT("cleared"));
-			Entry.CompletionPercent = FloorObj->GetNumberField(TEXT("completion_percent"));
-			Entry.DeathCount = FloorObj->GetIntegerField(TEXT("death_count"));
-			Entry.DiscoveredRooms = FloorObj->GetIntegerField(TEXT("discovered_rooms"));
-			Entry.TotalRooms = FloorObj->GetIntegerField(TEXT("total_rooms"));
-			Entry.DiscoveredSecrets = FloorObj->GetIntegerField(TEXT("discovered_secrets"));
-			Entry.TotalSecrets = FloorObj->GetIntegerField(TEXT("total_secrets"));
-			Entry.MonstersKilled = FloorObj->GetIntegerField(TEXT("monsters_killed"));
-			Entry.TotalMonsters = FloorObj->GetIntegerField(TEXT("total_monsters"));
-			Entry.ChestsOpened = FloorObj->GetIntegerField(TEXT("chests_opened"));
-			Entry.TotalChests = FloorObj->GetIntegerField(TEXT("total_chests"));
-
-			if (FloorObj->HasField(TEXT("best_clear_time_secs")))
-			{
-				Entry.BestClearTimeSecs = FloorObj->GetNumberField(TEXT("best_clear_time_secs"));
-			}
+			FloorObjects.Add(FloorValue->AsObject());
+		}
+	}
+	else if (Json->TryGetObjectField(TEXT("floors"), FloorsMap))
+	{
+		for (const auto& Pair : (*FloorsMap)->Values)
+		{
+			FloorObjects.Add(Pair.Value->AsObject());
+		}
+	}
 
-			CachedFloors.Add(Entry.FloorId, Entry);
+	Floors.Reserve(FloorObjects.Num());
+	for (const TSharedPtr<FJsonObject>& FloorObj : FloorObjects)
+	{
+		if (!FloorObj.IsValid()) continue;
+
+		FTowerFloorEntry& Entry = Floors.AddDefaulted_GetRef();
+		Entry.FloorId = FloorObj->GetIntegerField(TEXT("floor_id"));
+		Entry.Tier = ParseTier(FloorObj, Entry.FloorId);
+		Entry.bDiscovered = FloorObj->GetBoolField(TEXT("discovered"));
+		Entry.bCleared = FloorObj->GetBoolField(TEXT("cleared"));
+		Entry.CompletionPercent = FloorObj->GetNumberField(TEXT("completion_percent"));
+		Entry.DeathCount = FloorObj->GetIntegerField(TEXT("death_count"));
+		Entry.DiscoveredRooms = FloorObj->GetIntegerField(TEXT("discovered_rooms"));
+		Entry.TotalRooms = FloorObj->GetIntegerField(TEXT("total_rooms"));
+		Entry.DiscoveredSecrets = FloorObj->GetIntegerField(TEXT("discovered_secrets"));
+		Entry.TotalSecrets = FloorObj->GetIntegerField(TEXT("total_secrets"));
+		Entry.MonstersKilled = FloorObj->GetIntegerField(TEXT("monsters_killed"));
+		Entry.TotalMonsters = FloorObj->GetIntegerField(TEXT("total_monsters"));
+		Entry.ChestsOpened = FloorObj->GetIntegerField(TEXT("chests_opened"));
+		Entry.TotalChests = FloorObj->GetIntegerField(TEXT("total_chests"));
+
+		double BestTime = 0.0;
+		if (FloorObj->TryGetNumberField(TEXT("best_clear_time_secs"), BestTime))
+		{
+			Entry.BestClearTimeSecs = BestTime;
 		}
 	}
 
+	Floors.Sort([](const FTowerFloorEntry& A, const FTowerFloorEntry& B) { return A.FloorId < B.FloorId; });
+	RebuildIndex();
+
 	// Parse overview stats
 	if (Json->HasField(TEXT("highest_floor_reached")))
 	{
@@ -177,21 +262,94 @@ void UTowerMapWidget::ParseMapJson()
 		float PlaytimeSecs = Json->GetNumberField(TEXT("total_playtime_secs"));
 		CurrentOverview.TotalPlaytimeHours = PlaytimeSecs / 3600.0f;
 	}
+}
+
+void UTowerMapWidget::RebuildIndex()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_TowerMap_RebuildIndex);
+	FloorIndex.Reset();
+	for (TArray<int32>& Tier : TierFloors)
+	{
+		Tier.Reset();
+	}
+	CompletionSum = 0.0f;
+
+	for (int32 i = 0; i < Floors.Num(); i++)
+	{
+		const FTowerFloorEntry& Entry = Floors[i];
+		FloorIndex.Add(Entry.FloorId, i);
+		CompletionSum += Entry.CompletionPercent;
+		if (Entry.bDiscovered)
+		{
+			TierFloors[TierEnumToIndex(Entry.Tier)].Add(Entry.FloorId);
+		}
+	}
 
-	// Calculate average completion
-	if (CachedFloors.Num() > 0)
+	CurrentOverview.AverageCompletion = Floors.Num() > 0 ? CompletionSum / Floors.Num() : 0.0f;
+}
+
+FTowerFloorEntry& UTowerMapWidget::FindOrAddFloor(int32 FloorId)
+{
+	if (const int32* Index = FloorIndex.Find(FloorId))
 	{
-		float TotalCompletion = 0.0f;
-		for (const auto& Pair : CachedFloors)
+		return Floors[*Index];
+	}
+
+	// New floors are usually the highest so far: an append, else re-index behind the insert
+	const int32 Insert = Algo::LowerBoundBy(Floors, FloorId, &FTowerFloorEntry::FloorId);
+	Floors.InsertDefaulted(Insert);
+	Floors[Insert].FloorId = FloorId;
+	if (Insert == Floors.Num() - 1)
+	{
+		FloorIndex.Add(FloorId, Insert);
+	}
+	else
+	{
+		for (int32 i = Insert; i < Floors.Num(); i++)
 		{
-			TotalCompletion += Pair.Value.CompletionPercent;
+			FloorIndex.Add(Floors[i].FloorId, i);
 		}
-		CurrentOverview.AverageCompletion = TotalCompletion / CachedFloors.Num();
 	}
+	CurrentOverview.AverageCompletion = CompletionSum / Floors.Num();
+	return Floors[Insert];
+}
+
+bool UTowerMapWidget::IndexDiscoveredFloor(FTowerFloorEntry& Entry, ETowerTier Tier)
+{
+	if (Entry.bDiscovered && Entry.Tier == Tier)
+	{
+		return false;
+	}
+	if (Entry.bDiscovered)
+	{
+		TierFloors[TierEnumToIndex(Entry.Tier)].RemoveSingle(Entry.FloorId);
+	}
+
+	TArray<int32>& TierList = TierFloors[TierEnumToIndex(Tier)];
+	TierList.Insert(Entry.FloorId, Algo::LowerBound(TierList, Entry.FloorId));
+	Entry.Tier = Tier;
+	Entry.bDiscovered = true;
+	return true;
+}
+
+void UTowerMapWidget::UpdateCompletion(FTowerFloorEntry& Entry, float NewCompletion)
+{
+	CompletionSum += NewCompletion - Entry.CompletionPercent;
+	Entry.CompletionPercent = NewCompletion;
+	CurrentOverview.AverageCompletion = Floors.Num() > 0 ? CompletionSum / Floors.Num() : 0.0f;
+}
+
+float UTowerMapWidget::ComputeCompletion(const FTowerFloorEntry& Entry)
+{
+	auto Ratio = [](int32 Done, int32 Total) { return Total > 0 ? Done / static_cast<float>(Total) : 0.0f; };
+	return Ratio(Entry.DiscoveredRooms, Entry.TotalRooms) * 0.3f +
+	       Ratio(Entry.MonstersKilled, Entry.TotalMonsters) * 0.4f +
+	       Ratio(Entry.ChestsOpened, Entry.TotalChests) * 0.2f;
 }
 
 void UTowerMapWidget::RebuildOverviewPanel()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_TowerMap_RebuildOverviewPanel);
 	// Highest Floor
 	if (HighestFloorText)
 	{
@@ -255,38 +413,76 @@ void UTowerMapWidget::RebuildOverviewPanel()
 	}
 }
 
-void UTowerMapWidget::RebuildFloorList()
+static void FillButtonRow(UButton* Row, const FTowerFloorEntry& Entry)
 {
-	if (!FloorListBox)
+	const UHorizontalBox* EntryBox = Cast<UHorizontalBox>(Row->GetContent());
+	if (!EntryBox)
 	{
 		return;
 	}
 
-	FloorListBox->ClearChildren();
+	UTowerMapWidget::FillFloorRow(Entry,
+		Cast<UTextBlock>(EntryBox->GetChildAt(0)),
+		Cast<UTextBlock>(EntryBox->GetChildAt(1)),
+		Cast<UTextBlock>(EntryBox->GetChildAt(2)),
+		Cast<UProgressBar>(EntryBox->GetChildAt(3)),
+		Cast<UTextBlock>(EntryBox->GetChildAt(4)),
+		Cast<UTextBlock>(EntryBox->GetChildAt(5)),
+		Cast<UTextBlock>(EntryBox->GetChildAt(6)));
+}
+
+void UTowerMapWidget::RebuildFloorList()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_TowerMap_RebuildFloorList);
+	if (!FloorListView && !FloorRows.IsValid())
+	{
+		return;
+	}
 
-	// Filter and sort floors
+	// Discovered floors of the filtered tier, in floor order
 	TArray<int32> FloorIds;
-	for (const auto& Pair : CachedFloors)
+	if (CurrentTierFilter > 0)
+	{
+		FloorIds = TierFloors[FMath::Clamp(CurrentTierFilter - 1, 0, 3)];
+	}
+	else
 	{
-		// Apply tier filter
-		if (CurrentTierFilter > 0)
+		for (const FTowerFloorEntry& Entry : Floors)
 		{
-			ETowerTier FilterTier = TierIndexToEnum(CurrentTierFilter);
-			if (Pair.Value.Tier != FilterTier)
+			if (Entry.bDiscovered)
 			{
-				continue;
+				FloorIds.Add(Entry.FloorId);
 			}
 		}
+	}
 
-		// Only show discovered floors
-		if (Pair.Value.bDiscovered)
+	if (FloorListView)
+	{
+		// The list only builds rows for what's on screen, so every floor goes in
+		VisibleItems.Reset(FloorIds.Num());
+		for (int32 FloorId : FloorIds)
 		{
-			FloorIds.Add(Pair.Key);
+			UTowerFloorListItem*& Item = FloorItems.FindOrAdd(FloorId);
+			if (!Item)
+			{
+				Item = NewObject<UTowerFloorListItem>(this);
+				Item->FloorId = FloorId;
+				Item->Map = this;
+			}
+			VisibleItems.Add(Item);
 		}
-	}
+		FloorListView->SetListItems(VisibleItems);
 
-	// Sort by floor ID
-	FloorIds.Sort();
+		// Rows kept for items still listed show what they did before
+		for (UUserWidget* Row : FloorListView->GetDisplayedEntryWidgets())
+		{
+			if (UTowerFloorEntryRow* FloorRow = Cast<UTowerFloorEntryRow>(Row))
+			{
+				FloorRow->Refresh();
+			}
+		}
+		return;
+	}
 
 	// Limit displayed floors
 	if (FloorIds.Num() > MaxFloorsDisplayed)
@@ -294,106 +490,96 @@ void UTowerMapWidget::RebuildFloorList()
 		FloorIds.SetNum(MaxFloorsDisplayed);
 	}
 
-	// Create floor entries
+	FloorRows.BeginUpdate();
 	for (int32 FloorId : FloorIds)
 	{
-		const FTowerFloorEntry& Entry = CachedFloors[FloorId];
-
-		// Create entry container
-		UHorizontalBox* EntryBox = NewObject<UHorizontalBox>(this);
-		if (!EntryBox) continue;
-
-		// Floor ID text
-		UTextBlock* IdText = NewObject<UTextBlock>(this);
-		if (IdText)
+		bool bCreated = false;
+		UButton* FloorButton = FloorRows.Row<UButton>(LexToString(FloorId), bCreated);
+		if (bCreated)
 		{
-			IdText->SetText(FText::Format(FText::FromString(TEXT("Floor {0}")), FText::AsNumber(FloorId)));
-			EntryBox->AddChild(IdText);
+			// Id, tier, cleared mark, completion bar and %, best time, deaths
+			UHorizontalBox* EntryBox = NewObject<UHorizontalBox>(this);
+			EntryBox->AddChild(NewObject<UTextBlock>(this));
+			EntryBox->AddChild(NewObject<UTextBlock>(this));
+			EntryBox->AddChild(NewObject<UTextBlock>(this));
+			EntryBox->AddChild(NewObject<UProgressBar>(this));
+			EntryBox->AddChild(NewObject<UTextBlock>(this));
+			EntryBox->AddChild(NewObject<UTextBlock>(this));
+			EntryBox->AddChild(NewObject<UTextBlock>(this));
+			// TODO: Bind click event - need to use FSimpleDelegate with FloorId capture
+			FloorButton->AddChild(EntryBox);
 		}
+		FillButtonRow(FloorButton, Floors[FloorIndex[FloorId]]);
+	}
+	FloorRows.EndUpdate();
+}
 
-		// Tier badge
-		UTextBlock* TierText = NewObject<UTextBlock>(this);
-		if (TierText)
-		{
-			TierText->SetText(FText::FromString(GetTierName(Entry.Tier)));
-			TierText->SetColorAndOpacity(GetTierColor(Entry.Tier));
-			EntryBox->AddChild(TierText);
-		}
+void UTowerMapWidget::RefreshFloorRow(int32 FloorId)
+{
+	const FTowerFloorEntry* Entry = FindFloor(FloorId);
+	if (!Entry)
+	{
+		return;
+	}
 
-		// Cleared checkmark
-		if (Entry.bCleared)
+	if (FloorListView)
+	{
+		UTowerFloorListItem* Item = FloorItems.FindRef(FloorId);
+		if (UTowerFloorEntryRow* Row = Item ? FloorListView->GetEntryWidgetFromItem<UTowerFloorEntryRow>(Item) : nullptr)
 		{
-			UTextBlock* CheckText = NewObject<UTextBlock>(this);
-			if (CheckText)
-			{
-				CheckText->SetText(FText::FromString(TEXT("✓")));
-				EntryBox->AddChild(CheckText);
-			}
+			Row->Refresh();
 		}
+	}
+	else if (UButton* Row = FloorRows.Find<UButton>(LexToString(FloorId)))
+	{
+		FillButtonRow(Row, *Entry);
+	}
+}
 
-		// Completion %
-		UProgressBar* CompletionBar = NewObject<UProgressBar>(this);
-		if (CompletionBar)
+void UTowerMapWidget::FillFloorRow(const FTowerFloorEntry& Entry, UTextBlock* IdText, UTextBlock* TierText,
+	UTextBlock* ClearedText, UProgressBar* CompletionBar, UTextBlock* CompletionText,
+	UTextBlock* TimeText, UTextBlock* DeathText)
+{
+	auto SetShown = [](UWidget* Widget, bool bShown)
+	{
+		const ESlateVisibility Visibility = bShown ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed;
+		if (Widget && Widget->GetVisibility() != Visibility)
 		{
-			CompletionBar->SetPercent(Entry.CompletionPercent);
-			EntryBox->AddChild(CompletionBar);
+			Widget->SetVisibility(Visibility);
 		}
+	};
 
-		UTextBlock* CompletionText = NewObject<UTextBlock>(this);
-		if (CompletionText)
-		{
-			CompletionText->SetText(FText::Format(
-				FText::FromString(TEXT("{0}%")),
-				FText::AsNumber(static_cast<int32>(Entry.CompletionPercent * 100.0f))
-			));
-			EntryBox->AddChild(CompletionText);
-		}
+	// Floor ID text
+	FKeyedWidgetRows::SetText(IdText, FString::Printf(TEXT("Floor %d"), Entry.FloorId));
 
-		// Best time
-		if (Entry.BestClearTimeSecs > 0.0f)
-		{
-			int32 Minutes = static_cast<int32>(Entry.BestClearTimeSecs) / 60;
-			int32 Seconds = static_cast<int32>(Entry.BestClearTimeSecs) % 60;
+	// Tier badge
+	FKeyedWidgetRows::SetText(TierText, GetTierName(Entry.Tier));
+	FKeyedWidgetRows::SetColor(TierText, GetTierColor(Entry.Tier));
 
-			UTextBlock* TimeText = NewObject<UTextBlock>(this);
-			if (TimeText)
-			{
-				TimeText->SetText(FText::Format(
-					FText::FromString(TEXT("{0}:{1:02d}")),
-					FText::AsNumber(Minutes),
-					FText::AsNumber(Seconds)
-				));
-				EntryBox->AddChild(TimeText);
-			}
-		}
+	// Cleared checkmark
+	FKeyedWidgetRows::SetText(ClearedText, TEXT("✓"));
+	SetShown(ClearedText, Entry.bCleared);
 
-		// Deaths
-		if (Entry.DeathCount > 0)
-		{
-			UTextBlock* DeathText = NewObject<UTextBlock>(this);
-			if (DeathText)
-			{
-				DeathText->SetText(FText::Format(
-					FText::FromString(TEXT("Deaths: {0}")),
-					FText::AsNumber(Entry.DeathCount)
-				));
-				EntryBox->AddChild(DeathText);
-			}
-		}
+	// Completion %
+	if (CompletionBar && !FMath::IsNearlyEqual(CompletionBar->GetPercent(), Entry.CompletionPercent))
+	{
+		CompletionBar->SetPercent(Entry.CompletionPercent);
+	}
+	FKeyedWidgetRows::SetText(CompletionText,
+		FString::Printf(TEXT("%d%%"), static_cast<int32>(Entry.CompletionPercent * 100.0f)));
 
-		// Make clickable button
-		UButton* FloorButton = NewObject<UButton>(this);
-		if (FloorButton)
-		{
-			FloorButton->AddChild(EntryBox);
-			// TODO: Bind click event - need to use FSimpleDelegate with FloorId capture
-			FloorListBox->AddChild(FloorButton);
-		}
-		else
-		{
-			FloorListBox->AddChild(EntryBox);
-		}
+	// Best time
+	if (Entry.BestClearTimeSecs > 0.0f)
+	{
+		int32 Minutes = static_cast<int32>(Entry.BestClearTimeSecs) / 60;
+		int32 Seconds = static_cast<int32>(Entry.BestClearTimeSecs) % 60;
+		FKeyedWidgetRows::SetText(TimeText, FString::Printf(TEXT("%d:%02d"), Minutes, Seconds));
 	}
+	SetShown(TimeText, Entry.BestClearTimeSecs > 0.0f);
+
+	// Deaths
+	FKeyedWidgetRows::SetText(DeathText, FString::Printf(TEXT("Deaths: %d"), Entry.DeathCount));
+	SetShown(DeathText, Entry.DeathCount > 0);
 }
 
 void UTowerMapWidget::UpdateDetailPanel()
@@ -403,7 +589,7 @@ void UTowerMapWidget::UpdateDetailPanel()
 		return;
 	}
 
-	const FTowerFloorEntry* Entry = CachedFloors.Find(SelectedFloorId);
+	const FTowerFloorEntry* Entry = FindFloor(SelectedFloorId);
 	if (!Entry)
 	{
 		return;
@@ -504,9 +690,50 @@ void UTowerMapWidget::UpdateDetailPanel()
 			DetailBestTimeText->SetText(FText::FromString(TEXT("Best Time: Not cleared")));
 		}
 	}
+
+	UpdateDetailPreview();
 }
 
-FLinearColor UTowerMapWidget::GetTierColor(ETowerTier Tier) const
+void UTowerMapWidget::UpdateDetailPreview()
+{
+	if (!DetailPreviewImage)
+	{
+		return;
+	}
+
+	UTowerFloorPreviewSubsystem* Previews = nullptr;
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		Previews = GI->GetSubsystem<UTowerFloorPreviewSubsystem>();
+	}
+
+	const FTowerFloorEntry* Entry = FindFloor(SelectedFloorId);
+	UTexture2D* Atlas = nullptr;
+	FBox2f UV;
+	if (!Previews || !Entry || !Entry->bDiscovered || !Previews->GetPreview(SelectedFloorId, Atlas, UV))
+	{
+		DetailPreviewImage->SetVisibility(ESlateVisibility::Collapsed);
+		return;
+	}
+
+	// Its rectangle of the shared atlas; nothing is captured or rendered for it
+	FSlateBrush Brush;
+	Brush.SetResourceObject(Atlas);
+	Brush.SetUVRegion(UV);
+	Brush.ImageSize = FVector2D(UTowerFloorPreviewSubsystem::PreviewSize * 3, UTowerFloorPreviewSubsystem::PreviewSize * 3);
+	DetailPreviewImage->SetBrush(Brush);
+	DetailPreviewImage->SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UTowerMapWidget::HandlePreviewReady(int32 FloorId)
+{
+	if (FloorId == SelectedFloorId)
+	{
+		UpdateDetailPreview();
+	}
+}
+
+FLinearColor UTowerMapWidget::GetTierColor(ETowerTier Tier)
 {
 	switch (Tier)
 	{
@@ -523,7 +750,7 @@ FLinearColor UTowerMapWidget::GetTierColor(ETowerTier Tier) const
 	}
 }
 
-FString UTowerMapWidget::GetTierName(ETowerTier Tier) const
+FString UTowerMapWidget::GetTierName(ETowerTier Tier)
 {
 	switch (Tier)
 	{
@@ -564,27 +791,28 @@ int32 UTowerMapWidget::TierEnumToIndex(ETowerTier Tier) const
 
 void UTowerMapWidget::UpdateFloorProgress(int32 FloorId)
 {
-	FProceduralCoreBridge* Bridge = GetBridge();
-	if (!Bridge || !Bridge->IsInitialized())
+	// Local progress is already in Floors: touch only this floor's row
+	if (!FindFloor(FloorId))
 	{
 		return;
 	}
 
-	// Parse current map, update floor, refresh
-	FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
-	if (Entry)
+	if (bDeferFloorProgress)
 	{
-		// In real implementation, would call towermap_get_floor to get latest
-		if (bAutoRefreshUI)
+		DeferredFloors.AddUnique(FloorId);
+		return;
+	}
+
+	if (bAutoRefreshUI)
+	{
+		RefreshFloorRow(FloorId);
+		RebuildOverviewPanel();
+		if (SelectedFloorId == FloorId)
 		{
-			RebuildFloorList();
-			if (SelectedFloorId == FloorId)
-			{
-				UpdateDetailPanel();
-			}
+			UpdateDetailPanel();
 		}
-		OnMapUpdated.Broadcast();
 	}
+	OnMapUpdated.Broadcast();
 }
 
 void UTowerMapWidget::DiscoverFloor(int32 FloorId, ETowerTier Tier, int32 TotalRooms,
@@ -602,32 +830,59 @@ void UTowerMapWidget::DiscoverFloor(int32 FloorId, ETowerTier Tier, int32 TotalR
 	// LoadMapFromJson(UpdatedMapJson);
 
 	// Fallback: update locally
-	FTowerFloorEntry& Entry = CachedFloors.FindOrAdd(FloorId);
-	Entry.FloorId = FloorId;
-	Entry.Tier = Tier;
-	Entry.bDiscovered = true;
+	FTowerFloorEntry& Entry = FindOrAddFloor(FloorId);
+	const bool bWasDiscovered = Entry.bDiscovered;
+	const bool bListChanged = IndexDiscoveredFloor(Entry, Tier);
 	Entry.TotalRooms = TotalRooms;
 	Entry.TotalMonsters = TotalMonsters;
 	Entry.TotalChests = TotalChests;
 
+	if (!bWasDiscovered)
+	{
+		CurrentOverview.TotalDiscovered++;
+		CurrentOverview.HighestFloor = FMath::Max(CurrentOverview.HighestFloor, FloorId);
+	}
+
+	// Only a floor joining (or changing tier in) the list needs the list rebuilt
+	if (bListChanged && bAutoRefreshUI)
+	{
+		RebuildFloorList();
+	}
 	UpdateFloorProgress(FloorId);
+
+	// Drawn (and cached) in the background, so opening its detail later finds it ready
+	if (!bWasDiscovered)
+	{
+		if (UGameInstance* GI = GetGameInstance())
+		{
+			if (UTowerFloorPreviewSubsystem* Previews = GI->GetSubsystem<UTowerFloorPreviewSubsystem>())
+			{
+				Previews->RequestPreview(FloorId);
+			}
+		}
+	}
 }
 
 void UTowerMapWidget::ClearFloor(int32 FloorId, float ClearTimeSecs)
 {
-	FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
+	FTowerFloorEntry* Entry = FindFloorMutable(FloorId);
 	if (Entry)
 	{
+		if (!Entry->bCleared)
+		{
+			CurrentOverview.TotalCleared++;
+		}
 		Entry->bCleared = true;
-		Entry->BestClearTimeSecs = ClearTimeSecs;
-		Entry->CompletionPercent = 1.0f;
+		Entry->BestClearTimeSecs = Entry->BestClearTimeSecs > 0.0f ?
+			FMath::Min(Entry->BestClearTimeSecs, ClearTimeSecs) : ClearTimeSecs;
+		UpdateCompletion(*Entry, 1.0f);
 		UpdateFloorProgress(FloorId);
 	}
 }
 
 void UTowerMapWidget::RecordDeath(int32 FloorId)
 {
-	FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
+	FTowerFloorEntry* Entry = FindFloorMutable(FloorId);
 	if (Entry)
 	{
 		Entry->DeathCount++;
@@ -638,30 +893,73 @@ void UTowerMapWidget::RecordDeath(int32 FloorId)
 
 void UTowerMapWidget::DiscoverRoom(int32 FloorId)
 {
-	FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
+	FTowerFloorEntry* Entry = FindFloorMutable(FloorId);
 	if (Entry && Entry->DiscoveredRooms < Entry->TotalRooms)
 	{
 		Entry->DiscoveredRooms++;
-		Entry->CompletionPercent = (Entry->DiscoveredRooms / static_cast<float>(Entry->TotalRooms)) * 0.3f +
-		                            (Entry->MonstersKilled / static_cast<float>(Entry->TotalMonsters)) * 0.4f +
-		                            (Entry->ChestsOpened / static_cast<float>(Entry->TotalChests)) * 0.2f;
+		UpdateCompletion(*Entry, ComputeCompletion(*Entry));
 		UpdateFloorProgress(FloorId);
 	}
 }
 
 void UTowerMapWidget::KillMonster(int32 FloorId)
 {
-	FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
-	if (Entry && Entry->MonstersKilled < Entry->TotalMonsters)
+	KillMonsters(FloorId, 1);
+}
+
+void UTowerMapWidget::KillMonsters(int32 FloorId, int32 Count)
+{
+	FTowerFloorEntry* Entry = FindFloorMutable(FloorId);
+	if (Entry && Count > 0 && Entry->MonstersKilled < Entry->TotalMonsters)
 	{
-		Entry->MonstersKilled++;
-		Entry->CompletionPercent = (Entry->DiscoveredRooms / static_cast<float>(Entry->TotalRooms)) * 0.3f +
-		                            (Entry->MonstersKilled / static_cast<float>(Entry->TotalMonsters)) * 0.4f +
-		                            (Entry->ChestsOpened / static_cast<float>(Entry->TotalChests)) * 0.2f;
+		Entry->MonstersKilled = FMath::Min(Entry->MonstersKilled + Count, Entry->TotalMonsters);
+		UpdateCompletion(*Entry, ComputeCompletion(*Entry));
 		UpdateFloorProgress(FloorId);
 	}
 }
 
+void UTowerMapWidget::HandleGameplayEvents(const FTowerGameplayEventBatch& Batch)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_TowerMap_GameplayEvents);
+
+	{
+		TGuardValue<bool> Defer(bDeferFloorProgress, true);
+		for (const TPair<int32, int32>& Floor : Batch.KillsPerFloor)
+		{
+			KillMonsters(Floor.Key, Floor.Value);
+		}
+		for (const FTowerFloorProgressEvent& Progress : Batch.FloorProgress)
+		{
+			switch (Progress.Kind)
+			{
+			case ETowerFloorProgress::RoomDiscovered: DiscoverRoom(Progress.FloorId); break;
+			case ETowerFloorProgress::Cleared:        ClearFloor(Progress.FloorId, Progress.Seconds); break;
+			case ETowerFloorProgress::PlayerDied:     RecordDeath(Progress.FloorId); break;
+			}
+		}
+	}
+
+	if (DeferredFloors.Num() == 0)
+	{
+		return;
+	}
+
+	if (bAutoRefreshUI)
+	{
+		for (const int32 FloorId : DeferredFloors)
+		{
+			RefreshFloorRow(FloorId);
+		}
+		RebuildOverviewPanel();
+		if (DeferredFloors.Contains(SelectedFloorId))
+		{
+			UpdateDetailPanel();
+		}
+	}
+	DeferredFloors.Reset();
+	OnMapUpdated.Broadcast();
+}
+
 FString UTowerMapWidget::GetMapAsJson() const
 {
 	return CurrentMapJson;
@@ -674,7 +972,7 @@ FTowerMapOverview UTowerMapWidget::GetOverview() const
 
 bool UTowerMapWidget::GetFloorEntry(int32 FloorId, FTowerFloorEntry& OutEntry) const
 {
-	const FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
+	const FTowerFloorEntry* Entry = FindFloor(FloorId);
 	if (Entry)
 	{
 		OutEntry = *Entry;
@@ -683,6 +981,18 @@ bool UTowerMapWidget::GetFloorEntry(int32 FloorId, FTowerFloorEntry& OutEntry) c
 	return false;
 }
 
+const FTowerFloorEntry* UTowerMapWidget::FindFloor(int32 FloorId) const
+{
+	const int32* Index = FloorIndex.Find(FloorId);
+	return Index ? &Floors[*Index] : nullptr;
+}
+
+FTowerFloorEntry* UTowerMapWidget::FindFloorMutable(int32 FloorId)
+{
+	const int32* Index = FloorIndex.Find(FloorId);
+	return Index ? &Floors[*Index] : nullptr;
+}
+
 void UTowerMapWidget::SetTierFilter(int32 TierFilter)
 {
 	if (CurrentTierFilter != TierFilter)
@@ -694,6 +1004,7 @@ void UTowerMapWidget::SetTierFilter(int32 TierFilter)
 
 void UTowerMapWidget::RefreshFloorList()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_TowerMap_RefreshFloorList);
 	RebuildFloorList();
 }
 
@@ -708,8 +1019,26 @@ void UTowerMapWidget::ShowFloorDetail(int32 FloorId)
 
 	UpdateDetailPanel();
 
-	FTowerFloorEntry* Entry = CachedFloors.Find(FloorId);
-	if (Entry)
+	if (UGameInstance* GI = GetGameInstance())
+	{
+		if (UTowerFloorPreviewSubsystem* Previews = GI->GetSubsystem<UTowerFloorPreviewSubsystem>())
+		{
+			// The shown floor first, then its neighbours; only discovered floors are drawn
+			for (int32 Offset = 0; Offset <= PreviewPrefetchRadius; Offset++)
+			{
+				for (const int32 Neighbour : { FloorId - Offset, FloorId + Offset })
+				{
+					const FTowerFloorEntry* NeighbourEntry = FindFloor(Neighbour);
+					if (NeighbourEntry && NeighbourEntry->bDiscovered)
+					{
+						Previews->RequestPreview(Neighbour);
+					}
+				}
+			}
+		}
+	}
+
+	if (const FTowerFloorEntry* Entry = FindFloor(FloorId))
 	{
 		OnFloorSelected.Broadcast(*Entry);
 	}
@@ -749,3 +1078,11 @@ void UTowerMapWidget::OnFloorListItemClicked(int32 FloorId)
 {
 	ShowFloorDetail(FloorId);
 }
+
+void UTowerMapWidget::HandleFloorItemClicked(UObject* Item)
+{
+	if (const UTowerFloorListItem* FloorItem = Cast<UTowerFloorListItem>(Item))
+	{
+		ShowFloorDetail(FloorItem->FloorId);
+	}
+}
@@ -10,9 +10,13 @@
 #include "Components/ProgressBar.h"
 #include "Components/Image.h"
 #include "Components/ComboBoxString.h"
+#include "KeyedWidgetRows.h"
 #include "TowerMapWidget.generated.h"
 
 class UProceduralCoreBridge;
+class UListView;
+class UTowerFloorListItem;
+struct FTowerGameplayEventBatch;
 
 /// Floor tier enumeration matching Rust
 UENUM(BlueprintType)
@@ -77,6 +81,19 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnMapUpdated);
  * - Floor filtering by tier (Echelon1/2/3/4)
  * - Death count indicator with skull icon
  * - Integration with ProceduralCoreBridge for towermap_* FFI functions
+ *
+ * Floors are kept in one array in floor order, with a FloorId index and a
+ * per-tier list of discovered floors, so a tier filter doesn't scan the
+ * map. FloorListView, when bound, only builds rows for the floors on screen;
+ * otherwise FloorListBox keeps one row per floor (up to MaxFloorsDisplayed)
+ * and reuses it. Progress events (DiscoverRoom, KillMonster, ...) update the
+ * one floor's row and the overview in place; only a newly discovered floor
+ * changes the list. In game they come from UTowerGameplayEventSubsystem, one
+ * batch a frame, and the floors a batch touched are refreshed once each.
+ *
+ * The detail view shows the floor's layout from UTowerFloorPreviewSubsystem's
+ * atlas (CPU-drawn off the game thread, cached with the floor cache); a newly
+ * discovered floor has its preview made in the background.
  */
 UCLASS()
 class TOWERGAME_API UTowerMapWidget : public UUserWidget
@@ -122,6 +139,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TowerMap")
 	void KillMonster(int32 FloorId);
 
+	/// Record Count monsters killed on floor, refreshing it once
+	UFUNCTION(BlueprintCallable, Category = "TowerMap")
+	void KillMonsters(int32 FloorId, int32 Count);
+
 	/// Get current tower map as JSON (for saving)
 	UFUNCTION(BlueprintCallable, Category = "TowerMap")
 	FString GetMapAsJson() const;
@@ -134,6 +155,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TowerMap")
 	bool GetFloorEntry(int32 FloorId, FTowerFloorEntry& OutEntry) const;
 
+	/// Floor entry by ID, or null
+	const FTowerFloorEntry* FindFloor(int32 FloorId) const;
+
+	/// Show Entry in a row's widgets; any of them may be null
+	static void FillFloorRow(const FTowerFloorEntry& Entry, UTextBlock* IdText, UTextBlock* TierText,
+		UTextBlock* ClearedText, UProgressBar* CompletionBar, UTextBlock* CompletionText,
+		UTextBlock* TimeText, UTextBlock* DeathText);
+
 	// --- UI Interactions ---
 
 	/// Set filter tier (0=All, 1=Echelon1, 2=Echelon2, etc)
@@ -195,6 +224,10 @@ protected:
 	UPROPERTY(meta = (BindWidgetOptional))
 	UScrollBox* FloorListBox = nullptr;
 
+	/// Preferred over FloorListBox; its entry class should derive from UTowerFloorEntryRow
+	UPROPERTY(meta = (BindWidgetOptional))
+	UListView* FloorListView = nullptr;
+
 	// Detail View
 	UPROPERTY(meta = (BindWidgetOptional))
 	UVerticalBox* DetailPanel = nullptr;
@@ -229,6 +262,10 @@ protected:
 	UPROPERTY(meta = (BindWidgetOptional))
 	UTextBlock* DetailBestTimeText = nullptr;
 
+	/// The floor's layout from UTowerFloorPreviewSubsystem; collapsed until it is ready
+	UPROPERTY(meta = (BindWidgetOptional))
+	UImage* DetailPreviewImage = nullptr;
+
 	UPROPERTY(meta = (BindWidgetOptional))
 	UButton* DetailCloseButton = nullptr;
 
@@ -236,8 +273,29 @@ protected:
 	UPROPERTY()
 	FString CurrentMapJson;
 
+	/// Every floor in the map, in floor order
+	UPROPERTY()
+	TArray<FTowerFloorEntry> Floors;
+
+	/// FloorId -> index into Floors
+	TMap<int32, int32> FloorIndex;
+
+	/// Discovered floor IDs of each tier, in floor order
+	TArray<int32> TierFloors[4];
+
+	/// Sum of CompletionPercent over Floors, for the overview average
+	float CompletionSum = 0.0f;
+
+	/// List items of the floors FloorListView has been given, by FloorId
+	UPROPERTY()
+	TMap<int32, UTowerFloorListItem*> FloorItems;
+
 	UPROPERTY()
-	TMap<int32, FTowerFloorEntry> CachedFloors;
+	TArray<UTowerFloorListItem*> VisibleItems;
+
+	/// FloorListBox rows keyed by FloorId
+	UPROPERTY()
+	FKeyedWidgetRows FloorRows;
 
 	UPROPERTY()
 	FTowerMapOverview CurrentOverview;
@@ -246,20 +304,59 @@ protected:
 
 	int32 SelectedFloorId = 0;
 
+	FDelegateHandle PreviewReadyHandle;
+	FDelegateHandle GameplayEventsHandle;
+
+	/// While set, UpdateFloorProgress only collects floors into DeferredFloors
+	bool bDeferFloorProgress = false;
+	TArray<int32, TInlineAllocator<4>> DeferredFloors;
+
 	// --- Configuration ---
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TowerMap|Config")
 	bool bAutoRefreshUI = true;
 
+	/// Floors either side of the one shown whose previews are made too, so paging through is instant
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TowerMap|Config")
+	int32 PreviewPrefetchRadius = 2;
+
+	/// Rows in FloorListBox; FloorListView lists every floor
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "TowerMap|Config")
 	int32 MaxFloorsDisplayed = 100;
 
 	// --- Internal Methods ---
 	void ParseMapJson();
+
+	/// Rebuild FloorIndex, TierFloors and CompletionSum from Floors
+	void RebuildIndex();
+
+	FTowerFloorEntry* FindFloorMutable(int32 FloorId);
+
+	/// The entry for FloorId, inserted in floor order if new
+	FTowerFloorEntry& FindOrAddFloor(int32 FloorId);
+
+	/// Mark a floor discovered under Tier, keeping TierFloors in step; true if it wasn't listed before
+	bool IndexDiscoveredFloor(FTowerFloorEntry& Entry, ETowerTier Tier);
+
+	/// Recompute a floor's completion from its counters, keeping CompletionSum in step
+	void UpdateCompletion(FTowerFloorEntry& Entry, float NewCompletion);
+
 	void RebuildOverviewPanel();
 	void RebuildFloorList();
+
+	/// Update the one floor's row, if it is shown
+	void RefreshFloorRow(int32 FloorId);
+
 	void UpdateDetailPanel();
-	FLinearColor GetTierColor(ETowerTier Tier) const;
-	FString GetTierName(ETowerTier Tier) const;
+
+	/// Show the selected floor's preview in DetailPreviewImage, or hide it until it's made
+	void UpdateDetailPreview();
+	void HandlePreviewReady(int32 FloorId);
+
+	/// Apply a frame's kills and floor progress, then refresh each floor they touched once
+	void HandleGameplayEvents(const FTowerGameplayEventBatch& Batch);
+	static float ComputeCompletion(const FTowerFloorEntry& Entry);
+	static FLinearColor GetTierColor(ETowerTier Tier);
+	static FString GetTierName(ETowerTier Tier);
 	ETowerTier TierIndexToEnum(int32 Index) const;
 	int32 TierEnumToIndex(ETowerTier Tier) const;
 
@@ -271,4 +368,6 @@ protected:
 
 	UFUNCTION()
 	void OnFloorListItemClicked(int32 FloorId);
+
+	void HandleFloorItemClicked(UObject* Item);
 };
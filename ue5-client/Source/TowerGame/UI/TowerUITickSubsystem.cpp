@@ -0,0 +1,94 @@
+#include "TowerUITickSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DEFINE_STAT(STAT_TowerUI_Ticks);
+DEFINE_STAT(STAT_TowerUI_Rebuilds);
+DEFINE_STAT(STAT_TowerUI_ActiveTickers);
+
+void UTowerUITickSubsystem::Deinitialize()
+{
+    Entries.Empty();
+    FreeSlots.Empty();
+    SET_DWORD_STAT(STAT_TowerUI_ActiveTickers, 0);
+    Super::Deinitialize();
+}
+
+bool UTowerUITickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerUITickSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerUITickSubsystem, STATGROUP_TowerUI);
+}
+
+// ============ Registration ============
+
+void UTowerUITickSubsystem::Start(UUserWidget* Widget, ITowerUITickable* Tickable, int32& Handle)
+{
+    if (Handle != INDEX_NONE || !Widget) return;
+
+    UWorld* World = Widget->GetWorld();
+    if (UTowerUITickSubsystem* Subsystem = World ? World->GetSubsystem<UTowerUITickSubsystem>() : nullptr)
+    {
+        Handle = Subsystem->Register(Widget, Tickable);
+    }
+}
+
+void UTowerUITickSubsystem::Stop(UUserWidget* Widget, int32& Handle)
+{
+    if (Handle == INDEX_NONE) return;
+
+    UWorld* World = Widget ? Widget->GetWorld() : nullptr;
+    if (UTowerUITickSubsystem* Subsystem = World ? World->GetSubsystem<UTowerUITickSubsystem>() : nullptr)
+    {
+        Subsystem->Unregister(Handle);
+    }
+    Handle = INDEX_NONE;
+}
+
+int32 UTowerUITickSubsystem::Register(UUserWidget* Widget, ITowerUITickable* Tickable)
+{
+    if (!Widget || !Tickable) return INDEX_NONE;
+
+    const int32 Handle = FreeSlots.Num() > 0 ? FreeSlots.Pop(/*bAllowShrinking=*/false) : Entries.AddDefaulted();
+    Entries[Handle].Widget = Widget;
+    Entries[Handle].Tickable = Tickable;
+    SET_DWORD_STAT(STAT_TowerUI_ActiveTickers, GetNumActive());
+    return Handle;
+}
+
+void UTowerUITickSubsystem::Unregister(int32 Handle)
+{
+    if (!Entries.IsValidIndex(Handle) || !Entries[Handle].Tickable) return;
+
+    Entries[Handle] = FEntry();
+    FreeSlots.Add(Handle);
+    SET_DWORD_STAT(STAT_TowerUI_ActiveTickers, GetNumActive());
+}
+
+// ============ Tick ============
+
+void UTowerUITickSubsystem::Tick(float DeltaTime)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Tick);
+    // By index, and nothing held across the call: a ticker may start or stop others
+    for (int32 Handle = 0; Handle < Entries.Num(); Handle++)
+    {
+        ITowerUITickable* Tickable = Entries[Handle].Tickable;
+        if (!Tickable) continue;
+
+        if (!Entries[Handle].Widget.IsValid())
+        {
+            // Collected without stopping; its handle dies with it
+            Unregister(Handle);
+            continue;
+        }
+
+        Tickable->TickUI(DeltaTime);
+        INC_DWORD_STAT(STAT_TowerUI_Ticks);
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Stats/Stats.h"
+#include "Core/PerfCounters.h"
+#include "TowerUITickSubsystem.generated.h"
+
+class UUserWidget;
+
+// 'stat TowerUI': per-frame widget ticks driven by UTowerUITickSubsystem and
+// display rebuilds counted by the widgets themselves (INC_DWORD_STAT(STAT_TowerUI_Rebuilds),
+// and ETowerPerfCounter::UIRebuilds for perf captures)
+DECLARE_STATS_GROUP(TEXT("TowerUI"), STATGROUP_TowerUI, STATCAT_Advanced);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widget Ticks"), STAT_TowerUI_Ticks, STATGROUP_TowerUI, TOWERGAME_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widget Rebuilds"), STAT_TowerUI_Rebuilds, STATGROUP_TowerUI, TOWERGAME_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Tickers"), STAT_TowerUI_ActiveTickers, STATGROUP_TowerUI, TOWERGAME_API);
+
+/** A widget animated by UTowerUITickSubsystem */
+class ITowerUITickable
+{
+public:
+    virtual ~ITowerUITickable() = default;
+
+    /** Advance timers and animations; called once a frame while registered */
+    virtual void TickUI(float DeltaTime) = 0;
+};
+
+/**
+ * One tick for every animated HUD widget.
+ *
+ * Widgets don't override NativeTick (their UCLASS carries DisableNativeTick,
+ * so Slate never ticks them); instead they Start() here when a timer or
+ * animation begins and Stop() once it settles, so a widget with nothing
+ * moving costs nothing per frame and the ones that are moving share one
+ * pass. Tickers run while the game is paused, as widget ticks did.
+ *
+ * Panels that only change on events (stat blocks, headers, lists between
+ * rebuilds) should sit under an InvalidationBox in their Blueprint, with the
+ * animated parts (timer bars, typewriter text) outside it or marked
+ * volatile, so Slate reuses their cached layout and paint between changes.
+ * 'stat TowerUI' shows the ticks and rebuilds a frame costs.
+ */
+UCLASS()
+class TOWERGAME_API UTowerUITickSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickableWhenPaused() const override { return true; }
+
+    // ============ Registration ============
+
+    /** Tick Tickable (implemented by Widget) from now on; Handle is set, and left alone if already running */
+    static void Start(UUserWidget* Widget, ITowerUITickable* Tickable, int32& Handle);
+
+    /** Stop ticking; Handle is reset. Safe to call from inside TickUI. */
+    static void Stop(UUserWidget* Widget, int32& Handle);
+
+    int32 Register(UUserWidget* Widget, ITowerUITickable* Tickable);
+    void Unregister(int32 Handle);
+
+    int32 GetNumActive() const { return Entries.Num() - FreeSlots.Num(); }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<UUserWidget> Widget;
+        ITowerUITickable* Tickable = nullptr;
+    };
+
+    TArray<FEntry> Entries;
+    TArray<int32> FreeSlots;
+};
@@ -2,6 +2,7 @@
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
 #include "Components/VerticalBox.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UTradeWidget::NativeConstruct()
 {
@@ -131,6 +132,7 @@ void UTradeWidget::SetTradeState(ETradeState NewState)
 
 void UTradeWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Trade_RebuildDisplay);
     // My items count
     if (MyShardsText)
         MyShardsText->SetText(FText::FromString(FString::Printf(TEXT("%lld Shards"), MyShards)));
@@ -1,14 +1,17 @@
 #include "TransmogWidget.h"
+#include "TowerCatalogSubsystem.h"
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Components/Button.h"
 #include "Components/Image.h"
 #include "Components/Border.h"
 #include "Components/UniformGridPanel.h"
+#include "Engine/GameInstance.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UTransmogWidget::NativeConstruct()
 {
@@ -53,10 +56,50 @@ void UTransmogWidget::NativeConstruct()
 void UTransmogWidget::LoadUnlockedCosmetics(const FString& CosmeticsJson)
 {
     AllCosmetics.Empty();
+    if (!ParseCosmetics(CosmeticsJson, AllCosmetics)) return;
 
+    UE_LOG(LogTemp, Log, TEXT("TransmogWidget: Loaded %d cosmetics"), AllCosmetics.Num());
+    RebuildCosmeticList();
+}
+
+void UTransmogWidget::LoadUnlockedDyes(const FString& DyesJson)
+{
+    AllDyes.Empty();
+    if (!ParseDyes(DyesJson, AllDyes)) return;
+
+    UE_LOG(LogTemp, Log, TEXT("TransmogWidget: Loaded %d dyes"), AllDyes.Num());
+    RebuildDyeList();
+}
+
+void UTransmogWidget::LoadFromCatalog(const TArray<FString>& UnlockedCosmeticIds, const TArray<FString>& UnlockedDyeIds)
+{
+    UGameInstance* GI = GetGameInstance();
+    UTowerCatalogSubsystem* Catalogs = GI ? GI->GetSubsystem<UTowerCatalogSubsystem>() : nullptr;
+    if (!Catalogs) return;
+
+    const TSet<FString> UnlockedCosmetics(UnlockedCosmeticIds);
+    AllCosmetics = Catalogs->GetCosmetics()->Items;
+    for (FCosmeticItemDisplay& Item : AllCosmetics)
+    {
+        Item.bUnlocked = UnlockedCosmetics.Contains(Item.Id);
+    }
+
+    const TSet<FString> UnlockedDyes(UnlockedDyeIds);
+    AllDyes = Catalogs->GetDyes()->Items;
+    for (FDyeDisplay& Dye : AllDyes)
+    {
+        Dye.bUnlocked = UnlockedDyes.Contains(Dye.Id);
+    }
+
+    RebuildCosmeticList();
+    RebuildDyeList();
+}
+
+bool UTransmogWidget::ParseCosmetics(const FString& CosmeticsJson, TArray<FCosmeticItemDisplay>& OutCosmetics)
+{
     TSharedPtr<FJsonValue> Parsed;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CosmeticsJson);
-    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return;
+    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return false;
 
     const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
     // Support both root array and { "cosmetics": [...] } wrapper
@@ -70,9 +113,10 @@ void UTransmogWidget::LoadUnlockedCosmetics(const FString& CosmeticsJson)
     }
     else
     {
-        return;
+        return false;
     }
 
+    OutCosmetics.Reserve(OutCosmetics.Num() + Items->Num());
     for (const TSharedPtr<FJsonValue>& Val : *Items)
     {
         const TSharedPtr<FJsonObject>& Obj = Val->AsObject();
@@ -104,20 +148,16 @@ void UTransmogWidget::LoadUnlockedCosmetics(const FString& CosmeticsJson)
             Item.SourceDescription = Obj->GetStringField(TEXT("source_description"));
         }
 
-        AllCosmetics.Add(Item);
+        OutCosmetics.Add(MoveTemp(Item));
     }
-
-    UE_LOG(LogTemp, Log, TEXT("TransmogWidget: Loaded %d cosmetics"), AllCosmetics.Num());
-    RebuildCosmeticList();
+    return true;
 }
 
-void UTransmogWidget::LoadUnlockedDyes(const FString& DyesJson)
+bool UTransmogWidget::ParseDyes(const FString& DyesJson, TArray<FDyeDisplay>& OutDyes)
 {
-    AllDyes.Empty();
-
     TSharedPtr<FJsonValue> Parsed;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DyesJson);
-    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return;
+    if (!FJsonSerializer::Deserialize(Reader, Parsed)) return false;
 
     const TArray<TSharedPtr<FJsonValue>>* Items = nullptr;
     if (Parsed->Type == EJson::Array)
@@ -130,9 +170,10 @@ void UTransmogWidget::LoadUnlockedDyes(const FString& DyesJson)
     }
     else
     {
-        return;
+        return false;
     }
 
+    OutDyes.Reserve(OutDyes.Num() + Items->Num());
     for (const TSharedPtr<FJsonValue>& Val : *Items)
     {
         const TSharedPtr<FJsonObject>& Obj = Val->AsObject();
@@ -167,11 +208,9 @@ void UTransmogWidget::LoadUnlockedDyes(const FString& DyesJson)
                 Obj->GetNumberField(TEXT("glossiness")) : 0.5f;
         }
 
-        AllDyes.Add(Dye);
+        OutDyes.Add(Dye);
     }
-
-    UE_LOG(LogTemp, Log, TEXT("TransmogWidget: Loaded %d dyes"), AllDyes.Num());
-    RebuildDyeList();
+    return true;
 }
 
 // ============================================================================
@@ -477,6 +516,7 @@ FString UTransmogWidget::GetActiveTransmog(ECosmeticSlot SlotType) const
 
 void UTransmogWidget::RebuildSlotGrid()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Transmog_RebuildSlotGrid);
     if (!SlotButtonGrid) return;
     SlotButtonGrid->ClearChildren();
 
@@ -536,6 +576,7 @@ void UTransmogWidget::RebuildSlotGrid()
 
 void UTransmogWidget::RebuildCosmeticList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Transmog_RebuildCosmeticList);
     if (!CosmeticListBox) return;
     CosmeticListBox->ClearChildren();
 
@@ -677,6 +718,7 @@ void UTransmogWidget::UpdateCosmeticDetail()
 
 void UTransmogWidget::RebuildDyeList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Transmog_RebuildDyeList);
     if (!DyeListBox) return;
     DyeListBox->ClearChildren();
 
@@ -733,6 +775,7 @@ void UTransmogWidget::UpdateDyeSwatches()
 
 void UTransmogWidget::RebuildPresetList()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_Transmog_RebuildPresetList);
     if (!PresetListBox) return;
     PresetListBox->ClearChildren();
 
@@ -131,6 +131,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Transmog")
     void LoadUnlockedDyes(const FString& DyesJson);
 
+    /** Load cosmetics and dyes from the shared catalog, marking the given ids unlocked */
+    UFUNCTION(BlueprintCallable, Category = "Transmog")
+    void LoadFromCatalog(const TArray<FString>& UnlockedCosmeticIds, const TArray<FString>& UnlockedDyeIds);
+
+    /** Append the cosmetics of a Rust CosmeticItem array (or { "cosmetics": [...] }); false if it doesn't parse */
+    static bool ParseCosmetics(const FString& CosmeticsJson, TArray<FCosmeticItemDisplay>& OutCosmetics);
+
+    /** Append the dyes of a Rust Dye array (or { "dyes": [...] }); false if it doesn't parse */
+    static bool ParseDyes(const FString& DyesJson, TArray<FDyeDisplay>& OutDyes);
+
     // ============ Slot Selection ============
 
     /** Select a cosmetic slot to browse available cosmetics for it */
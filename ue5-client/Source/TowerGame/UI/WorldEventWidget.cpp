@@ -1,4 +1,5 @@
 #include "WorldEventWidget.h"
+#include "KeyedWidgetRows.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
 #include "Components/VerticalBox.h"
@@ -6,6 +7,7 @@
 #include "Dom/JsonValue.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 void UWorldEventWidget::NativeConstruct()
 {
@@ -13,16 +15,20 @@ void UWorldEventWidget::NativeConstruct()
     SetVisibility(ESlateVisibility::Collapsed);
 }
 
-void UWorldEventWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UWorldEventWidget::NativeDestruct()
 {
-    Super::NativeTick(MyGeometry, InDeltaTime);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
+    Super::NativeDestruct();
+}
 
+void UWorldEventWidget::TickUI(float DeltaTime)
+{
     bool bChanged = false;
 
     for (FWorldEventDisplay& Event : ActiveEvents)
     {
-        Event.RemainingTime -= InDeltaTime;
-        Event.FlashTimer -= InDeltaTime;
+        Event.RemainingTime -= DeltaTime;
+        Event.FlashTimer -= DeltaTime;
 
         if (Event.RemainingTime <= 0.0f)
         {
@@ -58,6 +64,7 @@ void UWorldEventWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
     if (ActiveEvents.Num() == 0)
     {
         SetVisibility(ESlateVisibility::Collapsed);
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
     }
 }
 
@@ -144,10 +151,24 @@ void UWorldEventWidget::ClearAll()
 {
     ActiveEvents.Empty();
     SetVisibility(ESlateVisibility::Collapsed);
+    UTowerUITickSubsystem::Stop(this, UITickHandle);
 }
 
 void UWorldEventWidget::RebuildDisplay()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerUI_WorldEvent_RebuildDisplay);
+    // Only ticked while something can expire
+    if (ActiveEvents.Num() > 0)
+    {
+        UTowerUITickSubsystem::Start(this, this, UITickHandle);
+    }
+    else
+    {
+        UTowerUITickSubsystem::Stop(this, UITickHandle);
+    }
+    INC_DWORD_STAT(STAT_TowerUI_Rebuilds);
+    FTowerPerfCounters::Add(ETowerPerfCounter::UIRebuilds);
+
     // Primary event (biggest/most severe)
     if (ActiveEvents.Num() > 0)
     {
@@ -196,27 +217,31 @@ void UWorldEventWidget::RebuildDisplay()
 
     // Secondary events list
     if (!EventListBox) return;
-    EventListBox->ClearChildren();
+    EventRows.Init(this, EventListBox);
+    EventRows.BeginUpdate();
 
     for (int32 i = 1; i < ActiveEvents.Num(); i++)
     {
         const FWorldEventDisplay& Event = ActiveEvents[i];
 
-        UTextBlock* EntryText = NewObject<UTextBlock>(this);
+        bool bCreated = false;
+        UTextBlock* EntryText = EventRows.Row<UTextBlock>(Event.Name, bCreated);
+        if (bCreated)
+        {
+            FSlateFontInfo Font = EntryText->GetFont();
+            Font.Size = 10;
+            EntryText->SetFont(Font);
+        }
 
         FString Icon = GetTriggerIcon(Event.TriggerType);
         int32 SecsRemain = FMath::CeilToInt(Event.RemainingTime);
         FString Display = FString::Printf(TEXT("%s %s (%ds)"),
             *Icon, *Event.Name, SecsRemain);
-        EntryText->SetText(FText::FromString(Display));
-        EntryText->SetColorAndOpacity(FSlateColor(GetTriggerColor(Event.TriggerType)));
-
-        FSlateFontInfo Font = EntryText->GetFont();
-        Font.Size = 10;
-        EntryText->SetFont(Font);
-
-        EventListBox->AddChild(EntryText);
+        FKeyedWidgetRows::SetText(EntryText, Display);
+        FKeyedWidgetRows::SetColor(EntryText, GetTriggerColor(Event.TriggerType));
     }
+
+    EventRows.EndUpdate();
 }
 
 FLinearColor UWorldEventWidget::GetTriggerColor(EEventTriggerType Type) const
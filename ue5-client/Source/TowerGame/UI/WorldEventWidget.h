@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "KeyedWidgetRows.h"
+#include "TowerUITickSubsystem.h"
 #include "WorldEventWidget.generated.h"
 
 class UTextBlock;
@@ -50,15 +52,19 @@ struct FWorldEventDisplay
  * Displays active procedural world events.
  * Shows event name, description, severity indicator, and remaining duration.
  * Matches Rust events module (7 trigger types, 4 severities).
+ * Secondary event rows are kept by event name and recycled (FKeyedWidgetRows).
  */
-UCLASS()
-class TOWERGAME_API UWorldEventWidget : public UUserWidget
+UCLASS(meta = (DisableNativeTick))
+class TOWERGAME_API UWorldEventWidget : public UUserWidget, public ITowerUITickable
 {
     GENERATED_BODY()
 
 public:
     virtual void NativeConstruct() override;
-    virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+    virtual void NativeDestruct() override;
+
+    /** Counts events down and drives the primary timer bar, while any are active */
+    virtual void TickUI(float DeltaTime) override;
 
     // --- API ---
     UFUNCTION(BlueprintCallable) void ShowEvent(const FString& Name, const FString& Description,
@@ -79,6 +85,9 @@ protected:
 
     TArray<FWorldEventDisplay> ActiveEvents;
 
+    UPROPERTY()
+    FKeyedWidgetRows EventRows;
+
     void RebuildDisplay();
     FLinearColor GetTriggerColor(EEventTriggerType Type) const;
     FLinearColor GetSeverityColor(EEventSeverity Severity) const;
@@ -87,4 +96,6 @@ protected:
 
     EEventTriggerType ParseTriggerType(const FString& TypeStr) const;
     EEventSeverity ParseSeverity(const FString& SeverityStr) const;
+
+    int32 UITickHandle = INDEX_NONE;
 };
@@ -1,9 +1,23 @@
 #include "DestructibleComponent.h"
+#include "DestructionBudgetSubsystem.h"
+#include "Rendering/VFXPoolSubsystem.h"
+#include "Rendering/MaterialVariantSubsystem.h"
+#include "Core/TowerGameSubsystem.h"
+#include "Engine/GameInstance.h"
 #include "GeometryCollection/GeometryCollectionComponent.h"
 #include "Components/StaticMeshComponent.h"
-#include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/AssetManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Chaos/CacheManagerActor.h"
+#include "Chaos/CacheCollection.h"
+#include "Chaos/ChaosCache.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "UObject/ConstructorHelpers.h"
 
 // ============================================================================
@@ -12,8 +26,8 @@
 
 UTowerDestructibleComponent::UTowerDestructibleComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.TickInterval = 0.1f; // 10 Hz tick for LOD updates
+	// Debris LOD and cleanup run in UTowerDestructionBudgetSubsystem
+	PrimaryComponentTick.bCanEverTick = false;
 	GeometryCollectionComp = nullptr;
 }
 
@@ -26,26 +40,30 @@ void UTowerDestructibleComponent::BeginPlay()
 	{
 		GeometryCollectionComp = Owner->FindComponentByClass<UGeometryCollectionComponent>();
 	}
+
+	if (GeometryCollectionComp)
+	{
+		AuthoredResponses = GeometryCollectionComp->GetCollisionResponseToChannels();
+		AuthoredCollision = GeometryCollectionComp->GetCollisionEnabled();
+	}
 }
 
-void UTowerDestructibleComponent::TickComponent(
-	float DeltaTime,
-	ELevelTick TickType,
-	FActorComponentTickFunction* ThisTickFunction)
+void UTowerDestructibleComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (UTowerDestructionBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UTowerDestructionBudgetSubsystem>())
+	{
+		Budget->Unregister(this);
+	}
 
-	// Debris cleanup timer
-	if (bCollapsed)
+	if (CachePlayer)
 	{
-		DebrisCleanupTimer += DeltaTime;
-		if (DebrisCleanupTimer >= DebrisLifetime && GeometryCollectionComp)
-		{
-			// Fade out debris fragments after lifetime expires
-			GeometryCollectionComp->SetVisibility(false);
-			SetComponentTickEnabled(false);
-		}
+		CachePlayer->Destroy();
+		CachePlayer = nullptr;
 	}
+	CollapseCacheHandle.Reset();
+	FragmentMemory.Set(0);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UTowerDestructibleComponent::InitFromServerState(
@@ -58,6 +76,13 @@ void UTowerDestructibleComponent::InitFromServerState(
 	const TArray<uint8>& InFragmentMask,
 	int32 FragmentCount)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_InitFromServerState);
+	LLM_SCOPE_BYTAG(Tower_Destruction);
+	// A snapshot replaces anything still queued
+	PendingClusters = TStaticBitArray<256>();
+	bPendingCollapse = false;
+	PendingImpulse = FVector::ZeroVector;
+
 	ServerEntityID = InEntityID;
 	TemplateID = InTemplateID;
 	Material = InMaterial;
@@ -66,6 +91,8 @@ void UTowerDestructibleComponent::InitFromServerState(
 	bCollapsed = bInCollapsed;
 	FragmentMask = InFragmentMask;
 
+	LoadCollapseCache();
+
 	// Initialize fragment array
 	Fragments.Empty();
 	Fragments.Reserve(FragmentCount);
@@ -94,11 +121,22 @@ void UTowerDestructibleComponent::InitFromServerState(
 				DestroyedClusters.Add(static_cast<uint8>(i));
 			}
 		}
-		if (DestroyedClusters.Num() > 0)
+		if (bInCollapsed && ShouldPlayRecordedCollapse())
+		{
+			// Already lying where the recording ends
+			PlayRecordedCollapse(/*bSkipToEnd=*/true);
+		}
+		else if (DestroyedClusters.Num() > 0)
 		{
+			if (UTowerDestructionBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UTowerDestructionBudgetSubsystem>())
+			{
+				Budget->NoteDebris(this);
+			}
 			ApplyVisualDestruction(DestroyedClusters, bInCollapsed, FVector::ZeroVector);
 		}
 	}
+
+	FragmentMemory.Set(Fragments.GetAllocatedSize() + FragmentMask.GetAllocatedSize());
 }
 
 void UTowerDestructibleComponent::ApplyDestructionDelta(
@@ -107,26 +145,61 @@ void UTowerDestructibleComponent::ApplyDestructionDelta(
 	bool bStructuralCollapse,
 	FVector CollapseImpulse)
 {
-	// Update fragment mask
-	FragmentMask = NewFragmentMask;
-
-	// Update individual fragment states
-	for (uint8 ClusterID : DestroyedClusters)
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_ApplyDelta);
+	LLM_SCOPE_BYTAG(Tower_Destruction);
+	// State updates now; visuals and events wait for the merged flush
+	bool bAnyNew = false;
+	auto MarkDestroyed = [this, &bAnyNew](int32 ClusterID)
 	{
+		const int32 ByteIndex = ClusterID / 8;
+		if (ByteIndex >= FragmentMask.Num())
+		{
+			FragmentMask.SetNumZeroed(ByteIndex + 1);
+		}
+		FragmentMask[ByteIndex] |= 1 << (ClusterID % 8);
+
 		if (ClusterID < Fragments.Num())
 		{
 			Fragments[ClusterID].bDestroyed = true;
 			Fragments[ClusterID].HP = 0.0f;
 		}
+		PendingClusters[ClusterID] = true;
+		bAnyNew = true;
+	};
+
+	for (uint8 ClusterID : DestroyedClusters)
+	{
+		if (!IsFragmentDestroyed(ClusterID))
+		{
+			MarkDestroyed(ClusterID);
+		}
 	}
 
-	// Update collapse state
-	if (bStructuralCollapse)
+	// The server's mask covers clusters whose delta may not have reached us yet;
+	// its new bits break the same way. Cluster ids are uint8, so 32 bytes cover them all
+	const int32 MaskBytes = FMath::Min(NewFragmentMask.Num(), 32);
+	for (int32 ByteIndex = 0; ByteIndex < MaskBytes; ByteIndex++)
+	{
+		const uint8 Local = FragmentMask.IsValidIndex(ByteIndex) ? FragmentMask[ByteIndex] : 0;
+		const uint8 NewBits = NewFragmentMask[ByteIndex] & ~Local;
+		for (int32 Bit = 0; Bit < 8; Bit++)
+		{
+			if (NewBits & (1 << Bit))
+			{
+				MarkDestroyed(ByteIndex * 8 + Bit);
+			}
+		}
+	}
+
+	const bool bNewCollapse = bStructuralCollapse && !bCollapsed;
+	if (bNewCollapse)
 	{
 		bCollapsed = true;
-		DebrisCleanupTimer = 0.0f;
+		bPendingCollapse = true;
 	}
 
+	if (!bAnyNew && !bNewCollapse) return;
+
 	// Recalculate total HP
 	TotalHP = 0.0f;
 	for (const FDestructionFragment& Frag : Fragments)
@@ -134,11 +207,71 @@ void UTowerDestructibleComponent::ApplyDestructionDelta(
 		TotalHP += Frag.HP;
 	}
 
-	// Apply visual destruction
-	ApplyVisualDestruction(DestroyedClusters, bStructuralCollapse, CollapseImpulse);
+	if (!CollapseImpulse.IsNearlyZero())
+	{
+		PendingImpulse += CollapseImpulse;
+	}
+
+	if (!bFlushQueued)
+	{
+		bFlushQueued = true;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTowerDestructibleComponent::FlushPendingDestruction);
+	}
+}
+
+void UTowerDestructibleComponent::FlushPendingDestruction()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_FlushPending);
+	LLM_SCOPE_BYTAG(Tower_Destruction);
+	bFlushQueued = false;
+
+	TArray<uint8> DestroyedClusters;
+	for (int32 ClusterID = 0; ClusterID < PendingClusters.Num(); ClusterID++)
+	{
+		if (PendingClusters[ClusterID])
+		{
+			DestroyedClusters.Add(static_cast<uint8>(ClusterID));
+		}
+	}
+	const bool bCollapse = bPendingCollapse;
+	const FVector Impulse = PendingImpulse;
+
+	PendingClusters = TStaticBitArray<256>();
+	bPendingCollapse = false;
+	PendingImpulse = FVector::ZeroVector;
+
+	if (DestroyedClusters.Num() == 0 && !bCollapse) return;
+
+	if (bCollapse && ShouldPlayRecordedCollapse())
+	{
+		// Cosmetic collapse: replay the recording, which costs the solver nothing, so no budget entry
+		for (uint8 ClusterID : DestroyedClusters)
+		{
+			const FVector Offset = ClusterID < Fragments.Num() ? Fragments[ClusterID].PositionOffset : FVector::ZeroVector;
+			SpawnDestructionVFX(ClusterID, GetOwner()->GetActorLocation() + Offset, Material);
+		}
+		PlayRecordedCollapse(/*bSkipToEnd=*/false);
+	}
+	else
+	{
+		// New debris gets full physics until the budget reassesses it
+		if (UTowerDestructionBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UTowerDestructionBudgetSubsystem>())
+		{
+			Budget->NoteDebris(this);
+		}
+
+		// Apply visual destruction
+		ApplyVisualDestruction(DestroyedClusters, bCollapse, Impulse);
+	}
+
+	// Remember the merged state so a revisit rebuilds this object already broken
+	if (UTowerGameSubsystem* Sub = UGameInstance::GetSubsystem<UTowerGameSubsystem>(GetWorld()->GetGameInstance()))
+	{
+		Sub->GetDeltaJournal().RecordFragments(Sub->CurrentFloor, ServerEntityID, FragmentMask, bCollapsed);
+	}
 
 	// Fire events
-	OnDestructionStateChanged.Broadcast(DestroyedClusters, bStructuralCollapse);
+	OnDestructionStateChanged.Broadcast(DestroyedClusters, bCollapse);
 
 	for (uint8 ClusterID : DestroyedClusters)
 	{
@@ -228,49 +361,88 @@ bool UTowerDestructibleComponent::IsFragmentDestroyed(uint8 ClusterID) const
 	return false;
 }
 
+int32 UTowerDestructibleComponent::GetNumLooseFragments() const
+{
+	if (bCollapsed) return Fragments.Num();
+
+	int32 NumLoose = 0;
+	for (const FDestructionFragment& Frag : Fragments)
+	{
+		NumLoose += Frag.bDestroyed ? 1 : 0;
+	}
+	return NumLoose;
+}
+
+void UTowerDestructibleComponent::SetDebrisTier(ETowerDebrisTier Tier)
+{
+	if (!GeometryCollectionComp || Tier == DebrisTier) return;
+	DebrisTier = Tier;
+
+	GeometryCollectionComp->SetVisibility(Tier != ETowerDebrisTier::Hidden);
+	GeometryCollectionComp->SetCollisionEnabled(Tier == ETowerDebrisTier::Hidden ? ECollisionEnabled::NoCollision : AuthoredCollision);
+	GeometryCollectionComp->SetSimulatePhysics(Tier == ETowerDebrisTier::Full || Tier == ETowerDebrisTier::Simplified);
+
+	// Debris-on-debris and debris-on-pawn contacts are most of a collapsed pile's solver cost
+	GeometryCollectionComp->SetCollisionResponseToChannels(AuthoredResponses);
+	if (Tier == ETowerDebrisTier::Simplified)
+	{
+		GeometryCollectionComp->SetCollisionResponseToChannel(ECC_PhysicsBody, ECR_Ignore);
+		GeometryCollectionComp->SetCollisionResponseToChannel(ECC_Destructible, ECR_Ignore);
+		GeometryCollectionComp->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+	}
+}
+
 void UTowerDestructibleComponent::ApplyVisualDestruction(
 	const TArray<uint8>& DestroyedClusters,
 	bool bCollapse,
 	FVector Impulse)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_ApplyVisual);
+	LLM_SCOPE_BYTAG(Tower_Destruction);
 	if (!GeometryCollectionComp) return;
 
-	// Apply physics break on Chaos Geometry Collection
-	// Each destroyed cluster maps to a transform index in the Geometry Collection
-	for (uint8 ClusterID : DestroyedClusters)
+	if (DestroyedClusters.Num() > 0)
 	{
-		// Apply break strain to the specific cluster
-		// This triggers Chaos Destruction's fracture simulation
-		FVector FragImpulse = Impulse;
-		if (FragImpulse.IsNearlyZero())
+		// One strain for the whole batch: centered on the broken clusters, wide enough
+		// to reach all of them, so an explosion is a single Chaos update
+		const FVector Origin = GetOwner()->GetActorLocation();
+		FVector Center = FVector::ZeroVector;
+		for (uint8 ClusterID : DestroyedClusters)
+		{
+			Center += ClusterID < Fragments.Num() ? Fragments[ClusterID].PositionOffset : FVector::ZeroVector;
+		}
+		Center = Origin + Center / DestroyedClusters.Num();
+
+		float StrainRadius = 1.0f;
+		for (uint8 ClusterID : DestroyedClusters)
+		{
+			const FVector ClusterWorldPos = Origin + (ClusterID < Fragments.Num() ? Fragments[ClusterID].PositionOffset : FVector::ZeroVector);
+			StrainRadius = FMath::Max(StrainRadius, FVector::Dist(Center, ClusterWorldPos) + 1.0f);
+
+			// Spawn VFX per fragment
+			SpawnDestructionVFX(ClusterID, ClusterWorldPos, Material);
+		}
+
+		FVector BreakImpulse = Impulse;
+		if (BreakImpulse.IsNearlyZero())
 		{
 			// Default outward impulse if no direction specified
-			FragImpulse = FVector(
+			BreakImpulse = FVector(
 				FMath::RandRange(-100.0f, 100.0f),
 				FMath::RandRange(-100.0f, 100.0f),
 				FMath::RandRange(50.0f, 200.0f)
 			);
 		}
 
-		// Apply force to geometry collection at cluster location
-		FVector ClusterWorldPos = GetOwner()->GetActorLocation();
-		if (ClusterID < Fragments.Num())
-		{
-			ClusterWorldPos += Fragments[ClusterID].PositionOffset;
-		}
-
 		// Apply internal strain to trigger Chaos break
 		GeometryCollectionComp->ApplyExternalStrain(
-			ClusterID,
-			FVector(ClusterWorldPos),
-			FVector(FragImpulse.GetSafeNormal()),
-			FragImpulse.Size(),
+			DestroyedClusters[0],
+			FVector(Center),
+			FVector(BreakImpulse.GetSafeNormal()),
+			BreakImpulse.Size(),
 			1, // num iterations
-			1.0f // radius
+			StrainRadius
 		);
-
-		// Spawn VFX per fragment
-		SpawnDestructionVFX(ClusterID, ClusterWorldPos, Material);
 	}
 
 	// Full collapse: apply massive force to all remaining pieces
@@ -292,19 +464,12 @@ void UTowerDestructibleComponent::SpawnDestructionVFX(
 	FVector WorldPos,
 	ETowerDestructionMaterial Mat)
 {
-	UNiagaraSystem* VFXSystem = GetDestructionVFXForMaterial(Mat);
-	if (!VFXSystem) return;
-
-	UNiagaraComponent* VFXComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-		GetWorld(),
-		VFXSystem,
-		WorldPos,
-		FRotator::ZeroRotator,
-		FVector(1.0f),
-		true, // bAutoDestroy
-		true, // bAutoActivate
-		ENCPoolMethod::AutoRelease
-	);
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_SpawnVFX);
+	UTowerVFXPoolSubsystem* VFXPool = GetWorld()->GetSubsystem<UTowerVFXPoolSubsystem>();
+	if (!VFXPool) return;
+
+	const TSoftObjectPtr<UNiagaraSystem> VFXSystem(GetDestructionVFXPath(Mat));
+	UNiagaraComponent* VFXComp = VFXPool->SpawnPooled(VFXPool->FindSystem(VFXSystem), WorldPos);
 
 	if (VFXComp)
 	{
@@ -333,43 +498,111 @@ void UTowerDestructibleComponent::SpawnDestructionVFX(
 	}
 }
 
-UNiagaraSystem* UTowerDestructibleComponent::GetDestructionVFXForMaterial(ETowerDestructionMaterial Mat) const
+FSoftObjectPath UTowerDestructibleComponent::GetDestructionVFXPath(ETowerDestructionMaterial Mat)
 {
-	// Load VFX asset based on material type
 	// These paths reference Niagara systems that should be created in Content
-	FString AssetPath;
 	switch (Mat)
 	{
 	case ETowerDestructionMaterial::Wood:
-		AssetPath = TEXT("/Game/VFX/Destruction/NS_WoodDestruction.NS_WoodDestruction");
-		break;
+		return FSoftObjectPath(TEXT("/Game/VFX/Destruction/NS_WoodDestruction.NS_WoodDestruction"));
 	case ETowerDestructionMaterial::Stone:
-		AssetPath = TEXT("/Game/VFX/Destruction/NS_StoneDestruction.NS_StoneDestruction");
-		break;
+		return FSoftObjectPath(TEXT("/Game/VFX/Destruction/NS_StoneDestruction.NS_StoneDestruction"));
 	case ETowerDestructionMaterial::Metal:
-		AssetPath = TEXT("/Game/VFX/Destruction/NS_MetalDestruction.NS_MetalDestruction");
-		break;
+		return FSoftObjectPath(TEXT("/Game/VFX/Destruction/NS_MetalDestruction.NS_MetalDestruction"));
 	case ETowerDestructionMaterial::Crystal:
-		AssetPath = TEXT("/Game/VFX/Destruction/NS_CrystalDestruction.NS_CrystalDestruction");
-		break;
+		return FSoftObjectPath(TEXT("/Game/VFX/Destruction/NS_CrystalDestruction.NS_CrystalDestruction"));
 	case ETowerDestructionMaterial::Ice:
-		AssetPath = TEXT("/Game/VFX/Destruction/NS_IceDestruction.NS_IceDestruction");
-		break;
+		return FSoftObjectPath(TEXT("/Game/VFX/Destruction/NS_IceDestruction.NS_IceDestruction"));
 	case ETowerDestructionMaterial::Organic:
-		AssetPath = TEXT("/Game/VFX/Destruction/NS_OrganicDestruction.NS_OrganicDestruction");
-		break;
+		return FSoftObjectPath(TEXT("/Game/VFX/Destruction/NS_OrganicDestruction.NS_OrganicDestruction"));
+	}
+	return FSoftObjectPath();
+}
+
+FSoftObjectPath UTowerDestructibleComponent::GetCollapseCachePath(const FString& InTemplateID)
+{
+	if (InTemplateID.IsEmpty()) return FSoftObjectPath();
+
+	// Recorded in the editor with a Chaos Cache Manager on the template's geometry collection
+	const FString AssetName = FString::Printf(TEXT("CC_%s"), *InTemplateID);
+	return FSoftObjectPath(FString::Printf(TEXT("/Game/Destruction/Caches/%s.%s"), *AssetName, *AssetName));
+}
+
+// ========== Recorded Collapse ==========
+
+void UTowerDestructibleComponent::LoadCollapseCache()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_LoadCollapseCache);
+	LLM_SCOPE_BYTAG(Tower_Destruction);
+	// Most templates have no recording; only adopt the conventional path if the asset exists
+	if (CollapseCache.IsNull())
+	{
+		const FSoftObjectPath Path = GetCollapseCachePath(TemplateID);
+		IAssetRegistry* AssetRegistry = IAssetRegistry::Get();
+		if (Path.IsValid() && AssetRegistry && AssetRegistry->GetAssetByObjectPath(Path).IsValid())
+		{
+			CollapseCache = TSoftObjectPtr<UChaosCacheCollection>(Path);
+		}
+	}
+
+	if (!CollapseCache.IsNull() && !CollapseCache.IsValid() && !CollapseCacheHandle.IsValid())
+	{
+		CollapseCacheHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(CollapseCache.ToSoftObjectPath());
+	}
+}
+
+bool UTowerDestructibleComponent::ShouldPlayRecordedCollapse() const
+{
+	// Not loaded yet: simulate rather than hitch on a synchronous load
+	if (!GeometryCollectionComp || !CollapseCache.IsValid() || CachePlayer) return false;
+	if (!bDebrisAffectsGameplay) return true;
+
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->PlayerCameraManager) return true;
+
+	return FVector::Dist(PC->PlayerCameraManager->GetCameraLocation(), GeometryCollectionComp->Bounds.Origin) > LiveCollapseDistance;
+}
+
+void UTowerDestructibleComponent::PlayRecordedCollapse(bool bSkipToEnd)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_PlayRecordedCollapse);
+	LLM_SCOPE_BYTAG(Tower_Destruction);
+	UChaosCacheCollection* Cache = CollapseCache.Get();
+	AActor* Owner = GetOwner();
+	if (!Cache || !Owner || !GeometryCollectionComp) return;
+
+	FName TrackName = CollapseCacheName;
+	if (TrackName.IsNone() && Cache->Caches.Num() > 0 && Cache->Caches[0])
+	{
+		TrackName = Cache->Caches[0]->GetFName();
+	}
+
+	// Fragments already loose from earlier breaks join the recording and leave the budget
+	if (UTowerDestructionBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UTowerDestructionBudgetSubsystem>())
+	{
+		Budget->Unregister(this);
 	}
 
-	if (!AssetPath.IsEmpty())
+	// The manager drives the geometry collection kinematically from the recorded frames
+	const FTransform Transform = Owner->GetActorTransform();
+	CachePlayer = GetWorld()->SpawnActorDeferred<AChaosCacheManager>(
+		AChaosCacheManager::StaticClass(), Transform, Owner, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!CachePlayer) return;
+
+	CachePlayer->CacheCollection = Cache;
+	CachePlayer->CacheMode = ECacheMode::Play;
+	CachePlayer->StartMode = EStartMode::Timed;
+	FObservedComponent& Observed = CachePlayer->AddNewObservedComponent(GeometryCollectionComp);
+	Observed.CacheName = TrackName;
+	CachePlayer->FinishSpawning(Transform);
+
+	if (bSkipToEnd)
 	{
-		return Cast<UNiagaraSystem>(StaticLoadObject(
-			UNiagaraSystem::StaticClass(),
-			nullptr,
-			*AssetPath
-		));
+		CachePlayer->SetCurrentTime(Cache->GetMaxDuration());
 	}
 
-	return nullptr;
+	UE_LOG(LogTemp, Verbose, TEXT("Destructible %llu (%s): replaying recorded collapse '%s'"),
+		ServerEntityID, *TemplateID, *TrackName.ToString());
 }
 
 // ============================================================================
@@ -406,23 +639,36 @@ void ATowerDestructibleActor::InitFromSpawnData(
 	float InMaxTotalHP,
 	int32 FragmentCount)
 {
-	TArray<uint8> EmptyMask;
+	// Fresh spawns start intact unless this floor was visited and broken before
+	TArray<uint8> Mask;
+	bool bWasCollapsed = false;
+	if (UTowerGameSubsystem* Sub = UGameInstance::GetSubsystem<UTowerGameSubsystem>(GetGameInstance()))
+	{
+		if (const FTowerFloorDeltaJournal::FFloorState* Journal = Sub->GetDeltaJournal().Find(Sub->CurrentFloor))
+		{
+			if (const FTowerFloorDeltaJournal::FFragmentState* Recorded = Journal->Fragments.Find(EntityID))
+			{
+				Mask = Recorded->Mask;
+				bWasCollapsed = Recorded->bCollapsed;
+			}
+		}
+	}
+
 	DestructibleComp->InitFromServerState(
 		EntityID,
 		InTemplateID,
 		InMaterial,
 		InTotalHP,
 		InMaxTotalHP,
-		false, // not collapsed
-		EmptyMask,
+		bWasCollapsed,
+		Mask,
 		FragmentCount
 	);
 
-	// Set mesh color based on material for placeholder visual
-	UMaterialInterface* BaseMat = IntactMesh->GetMaterial(0);
-	if (BaseMat)
+	// Set mesh color based on material for placeholder visual, shared per material
+	UTowerMaterialVariantSubsystem* Variants = GetWorld()->GetSubsystem<UTowerMaterialVariantSubsystem>();
+	if (Variants)
 	{
-		UMaterialInstanceDynamic* DynMat = UMaterialInstanceDynamic::Create(BaseMat, this);
 		FLinearColor Color;
 		switch (InMaterial)
 		{
@@ -434,8 +680,11 @@ void ATowerDestructibleActor::InitFromSpawnData(
 		case ETowerDestructionMaterial::Organic: Color = FLinearColor(0.3f, 0.6f, 0.2f); break;
 		default:                                Color = FLinearColor(1.0f, 1.0f, 1.0f); break;
 		}
-		DynMat->SetVectorParameterValue(TEXT("BaseColor"), Color);
-		IntactMesh->SetMaterial(0, DynMat);
+		if (UMaterialInstanceDynamic* DynMat = Variants->FindOrCreateColored(IntactMesh->GetMaterial(0),
+			FName(TEXT("Destruction"), static_cast<int32>(InMaterial)), Color))
+		{
+			IntactMesh->SetMaterial(0, DynMat);
+		}
 	}
 
 #if WITH_EDITOR
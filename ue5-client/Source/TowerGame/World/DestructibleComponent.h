@@ -2,8 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Containers/StaticBitArray.h"
+#include "Core/TowerMemory.h"
 #include "DestructibleComponent.generated.h"
 
+class UChaosCacheCollection;
+
 /**
  * Material types for destruction (maps to Rust DestructionMaterial enum).
  * Affects damage resistance, fracture pattern, and VFX.
@@ -48,6 +52,19 @@ enum class ETowerDestructibleCategory : uint8
 	Corruption	UMETA(DisplayName = "Corruption")
 };
 
+/**
+ * How much simulation a destructible's loose fragments get.
+ * Assigned by UTowerDestructionBudgetSubsystem.
+ */
+UENUM(BlueprintType)
+enum class ETowerDebrisTier : uint8
+{
+	Full		UMETA(DisplayName = "Full Physics"),	// Chaos with authored collision
+	Simplified	UMETA(DisplayName = "Simplified"),		// Chaos against the level only
+	Frozen		UMETA(DisplayName = "Frozen"),			// Stopped where it lies
+	Hidden		UMETA(DisplayName = "Hidden")			// Removed
+};
+
 /**
  * State of a single fragment within the destructible.
  * Synced from Bevy server via DestructionDelta.
@@ -157,19 +174,44 @@ public:
 	TArray<uint8> FragmentMask;
 
 	// ========== LOD Settings ==========
+	// Read by UTowerDestructionBudgetSubsystem, which also caps debris across the world
 
 	/** Distance at which full Chaos physics is used (close range) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|LOD")
 	float FullPhysicsDistance = 2000.0f;
 
-	/** Distance at which simplified animation is used (medium range) */
+	/** Distance at which simplified physics is used (medium range); frozen beyond */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|LOD")
 	float SimplifiedAnimDistance = 5000.0f;
 
-	/** Maximum active physics fragments on screen */
+	/** Loose fragments above which this object never gets full physics */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|LOD")
 	int32 MaxActivePhysicsFragments = 200;
 
+	/** Current debris tier */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower|Destruction|LOD")
+	ETowerDebrisTier DebrisTier = ETowerDebrisTier::Full;
+
+	// ========== Recorded Collapse ==========
+	// Full collapses can replay a Chaos cache recorded for the template instead of simulating:
+	// no solver cost, and every client sees the same rubble. Partial breaks always simulate.
+
+	/** Cache to replay on collapse; when unset, GetCollapseCachePath(TemplateID) is used if that asset exists */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|Recorded Collapse")
+	TSoftObjectPtr<UChaosCacheCollection> CollapseCache;
+
+	/** Track of CollapseCache recorded for this geometry collection; the first one if None */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|Recorded Collapse")
+	FName CollapseCacheName;
+
+	/** The rubble matters to gameplay (cover, blocked paths), so it simulates live when near the camera */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|Recorded Collapse")
+	bool bDebrisAffectsGameplay = false;
+
+	/** Camera distance within which gameplay debris simulates live */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Destruction|Recorded Collapse")
+	float LiveCollapseDistance = 1500.0f;
+
 	// ========== Events ==========
 
 	/** Fired when destruction state changes (from server delta) */
@@ -184,7 +226,8 @@ public:
 
 	/**
 	 * Apply a destruction delta received from the server.
-	 * Updates fragment states and triggers Chaos Destruction visuals.
+	 * Updates fragment states at once; Chaos Destruction visuals and events for
+	 * every delta received in a frame are merged and applied once, on the next tick.
 	 *
 	 * @param DestroyedClusters  Cluster IDs newly destroyed this update
 	 * @param NewFragmentMask    Updated bitmask of all destroyed fragments
@@ -238,27 +281,68 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Tower|Destruction")
 	bool IsFragmentDestroyed(uint8 ClusterID) const;
 
+	/** Fragments broken off and loose (all of them once collapsed) */
+	int32 GetNumLooseFragments() const;
+
+	/** Switch the geometry collection's simulation and collision to Tier */
+	void SetDebrisTier(ETowerDebrisTier Tier);
+
+	class UGeometryCollectionComponent* GetGeometryCollection() const { return GeometryCollectionComp; }
+
+	/** Niagara system for this material's destruction (preloaded by the GameMode) */
+	static FSoftObjectPath GetDestructionVFXPath(ETowerDestructionMaterial Mat);
+
+	/** Where a template's recorded collapse lives by convention */
+	static FSoftObjectPath GetCollapseCachePath(const FString& InTemplateID);
+
+	/** The last collapse is being replayed from CollapseCache rather than simulated */
+	bool IsPlayingRecordedCollapse() const { return CachePlayer != nullptr; }
+
 protected:
 	virtual void BeginPlay() override;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	/** Apply the visuals and events of the deltas queued since the last flush */
+	void FlushPendingDestruction();
+
 	/** Apply visual destruction to the Geometry Collection */
 	void ApplyVisualDestruction(const TArray<uint8>& DestroyedClusters, bool bCollapse, FVector Impulse);
 
-	/** Spawn destruction VFX based on material type */
+	/** Spawn destruction VFX based on material type, from the VFX pool; skipped until the system is loaded */
 	void SpawnDestructionVFX(uint8 ClusterID, FVector WorldPos, ETowerDestructionMaterial Mat);
 
-	/** Get the appropriate Niagara system for this material's destruction */
-	class UNiagaraSystem* GetDestructionVFXForMaterial(ETowerDestructionMaterial Mat) const;
+	/** Start loading the template's recorded collapse, if it has one */
+	void LoadCollapseCache();
+
+	/** Cosmetic collapse with a loaded cache: replay it instead of simulating */
+	bool ShouldPlayRecordedCollapse() const;
+
+	/** Replay the recorded collapse, from its end for objects that arrive already collapsed */
+	void PlayRecordedCollapse(bool bSkipToEnd);
 
 	/** Cached reference to GeometryCollection on parent actor */
 	UPROPERTY()
 	class UGeometryCollectionComponent* GeometryCollectionComp;
 
-	/** Timer for debris cleanup (fading out old fragments) */
-	float DebrisCleanupTimer = 0.0f;
-	static constexpr float DebrisLifetime = 10.0f;
+	/** Newly destroyed clusters waiting for FlushPendingDestruction */
+	TStaticBitArray<256> PendingClusters;
+	bool bPendingCollapse = false;
+	FVector PendingImpulse = FVector::ZeroVector;
+	bool bFlushQueued = false;
+
+	TSharedPtr<struct FStreamableHandle> CollapseCacheHandle;
+
+	/** Plays the recorded collapse back onto GeometryCollectionComp */
+	UPROPERTY()
+	class AChaosCacheManager* CachePlayer = nullptr;
+
+	/** Collision as authored, restored when debris returns to full physics */
+	FCollisionResponseContainer AuthoredResponses;
+	ECollisionEnabled::Type AuthoredCollision = ECollisionEnabled::QueryAndPhysics;
+
+	/** Fragments and FragmentMask, in the Destruction memory bucket */
+	FTowerMemoryReport FragmentMemory{ ETowerMemoryBucket::Destruction };
 };
 
 // ============================================================================
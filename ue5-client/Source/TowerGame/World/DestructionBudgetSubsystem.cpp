@@ -0,0 +1,165 @@
+#include "DestructionBudgetSubsystem.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+void UTowerDestructionBudgetSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	Super::Deinitialize();
+}
+
+bool UTowerDestructionBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerDestructionBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerDestructionBudgetSubsystem, STATGROUP_Tickables);
+}
+
+// ========== Registration ==========
+
+void UTowerDestructionBudgetSubsystem::NoteDebris(UTowerDestructibleComponent* Destructible)
+{
+	if (!Destructible || !Destructible->GetGeometryCollection()) return;
+
+	// A fresh break makes the pile the newest again
+	Unregister(Destructible);
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Destructible = Destructible;
+	Entry.BreakTime = GetWorld()->GetTimeSeconds();
+
+	Destructible->SetDebrisTier(ETowerDebrisTier::Full);
+}
+
+void UTowerDestructionBudgetSubsystem::Unregister(UTowerDestructibleComponent* Destructible)
+{
+	const int32 Index = Entries.IndexOfByPredicate([Destructible](const FEntry& Entry)
+	{
+		return Entry.Destructible.Get() == Destructible;
+	});
+	if (Index != INDEX_NONE)
+	{
+		Entries.RemoveAt(Index, 1, false);
+	}
+}
+
+// ========== Budget ==========
+
+void UTowerDestructionBudgetSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceEvaluation += DeltaTime;
+	if (TimeSinceEvaluation < EvaluationInterval || Entries.Num() == 0) return;
+	TimeSinceEvaluation = 0.0f;
+
+	Evaluate();
+}
+
+namespace
+{
+	float GetTierCost(ETowerDebrisTier Tier, int32 NumFragments, float SimplifiedCost)
+	{
+		switch (Tier)
+		{
+		case ETowerDebrisTier::Full:		return static_cast<float>(NumFragments);
+		case ETowerDebrisTier::Simplified:	return NumFragments * SimplifiedCost;
+		default:							return 0.0f;
+		}
+	}
+}
+
+void UTowerDestructionBudgetSubsystem::Evaluate()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(TowerDestruction_EvaluateBudget);
+	UWorld* World = GetWorld();
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PC || !PC->PlayerCameraManager) return;
+
+	const FVector CameraLocation = PC->PlayerCameraManager->GetCameraLocation();
+	const float TanHalfFov = FMath::Tan(FMath::DegreesToRadians(PC->PlayerCameraManager->GetFOVAngle() * 0.5f));
+	const double Now = World->GetTimeSeconds();
+
+	struct FCandidate
+	{
+		UTowerDestructibleComponent* Destructible;
+		ETowerDebrisTier Tier;
+		int32 NumFragments;
+	};
+	TArray<FCandidate, TInlineAllocator<32>> Candidates;
+	float TotalCost = 0.0f;
+
+	// Desired tier per pile, oldest first; expired piles go straight away
+	for (int32 i = 0; i < Entries.Num();)
+	{
+		UTowerDestructibleComponent* Destructible = Entries[i].Destructible.Get();
+		UGeometryCollectionComponent* GC = Destructible ? Destructible->GetGeometryCollection() : nullptr;
+		if (!GC)
+		{
+			Entries.RemoveAt(i, 1, false);
+			continue;
+		}
+		if (Now - Entries[i].BreakTime >= DebrisLifetime)
+		{
+			Destructible->SetDebrisTier(ETowerDebrisTier::Hidden);
+			Entries.RemoveAt(i, 1, false);
+			continue;
+		}
+
+		const float Distance = FVector::Dist(CameraLocation, GC->Bounds.Origin);
+		const float ScreenSize = GC->Bounds.SphereRadius / FMath::Max(Distance * TanHalfFov, 1.0f);
+		const int32 NumFragments = Destructible->GetNumLooseFragments();
+
+		ETowerDebrisTier Tier = ETowerDebrisTier::Frozen;
+		if (ScreenSize >= MinPhysicsScreenSize)
+		{
+			if (Distance <= Destructible->FullPhysicsDistance && NumFragments <= Destructible->MaxActivePhysicsFragments)
+			{
+				Tier = ETowerDebrisTier::Full;
+			}
+			else if (Distance <= Destructible->SimplifiedAnimDistance)
+			{
+				Tier = ETowerDebrisTier::Simplified;
+			}
+		}
+
+		Candidates.Add(FCandidate{ Destructible, Tier, NumFragments });
+		TotalCost += GetTierCost(Tier, NumFragments, SimplifiedFragmentCost);
+		i++;
+	}
+
+	// Over budget: step the oldest piles down, Full -> Simplified, then Simplified -> Frozen
+	const float Budget = MaxActiveFragments * BudgetScale;
+	for (int32 Pass = 0; Pass < 2 && TotalCost > Budget; Pass++)
+	{
+		for (FCandidate& Candidate : Candidates)
+		{
+			if (TotalCost <= Budget) break;
+			if (Candidate.Tier != ETowerDebrisTier::Full && Candidate.Tier != ETowerDebrisTier::Simplified) continue;
+
+			TotalCost -= GetTierCost(Candidate.Tier, Candidate.NumFragments, SimplifiedFragmentCost);
+			Candidate.Tier = Candidate.Tier == ETowerDebrisTier::Full ? ETowerDebrisTier::Simplified : ETowerDebrisTier::Frozen;
+			TotalCost += GetTierCost(Candidate.Tier, Candidate.NumFragments, SimplifiedFragmentCost);
+		}
+	}
+
+	// Too many piles: remove the oldest
+	for (int32 i = 0; i < Candidates.Num() - MaxVisibleDebris; i++)
+	{
+		Candidates[i].Tier = ETowerDebrisTier::Hidden;
+	}
+
+	ActiveFragmentCost = 0.0f;
+	for (int32 i = Candidates.Num() - 1; i >= 0; i--)
+	{
+		Candidates[i].Destructible->SetDebrisTier(Candidates[i].Tier);
+		ActiveFragmentCost += GetTierCost(Candidates[i].Tier, Candidates[i].NumFragments, SimplifiedFragmentCost);
+		if (Candidates[i].Tier == ETowerDebrisTier::Hidden)
+		{
+			Entries.RemoveAt(i, 1, false);
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DestructibleComponent.h"
+#include "DestructionBudgetSubsystem.generated.h"
+
+/**
+ * UTowerDestructionBudgetSubsystem — World-wide budget for loose Chaos debris.
+ *
+ * Each UTowerDestructibleComponent reports here when it releases fragments.
+ * Every EvaluationInterval the debris piles are tiered by camera distance
+ * (the component's FullPhysicsDistance / SimplifiedAnimDistance) and screen
+ * size, then held to MaxActiveFragments across the world:
+ *
+ *   Full       -> all fragments cost 1
+ *   Simplified -> collide with the level only, cost SimplifiedFragmentCost
+ *   Frozen     -> stop where they lie, free
+ *   Hidden     -> removed
+ *
+ * When the total is over budget the oldest piles are stepped down first, so a
+ * room collapsing at once keeps the freshest, closest breaks simulated. Piles
+ * older than DebrisLifetime, or beyond the MaxVisibleDebris newest, are removed.
+ */
+UCLASS()
+class TOWERGAME_API UTowerDestructionBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ========== Registration ==========
+
+	/** Destructible released fragments; they simulate fully until the next evaluation */
+	void NoteDebris(UTowerDestructibleComponent* Destructible);
+	void Unregister(UTowerDestructibleComponent* Destructible);
+
+	int32 GetNumDebrisPiles() const { return Entries.Num(); }
+
+	/** Fragment cost being simulated as of the last evaluation */
+	float GetActiveFragmentCost() const { return Entries.Num() > 0 ? ActiveFragmentCost : 0.0f; }
+
+	// ========== Config ==========
+
+	/** Fragment cost simulated at once across the world */
+	float MaxActiveFragments = 300.0f;
+
+	/** Multiplies MaxActiveFragments; lowered by UTowerPerfScalerSubsystem on slow frames */
+	float BudgetScale = 1.0f;
+
+	/** Cost of a simplified fragment relative to a fully simulated one */
+	float SimplifiedFragmentCost = 0.25f;
+
+	/** Bounds radius over view half-width below which a pile isn't worth simulating */
+	float MinPhysicsScreenSize = 0.02f;
+
+	/** Seconds after its last break a pile is removed */
+	float DebrisLifetime = 10.0f;
+
+	/** Piles kept visible; older ones beyond this are removed early */
+	int32 MaxVisibleDebris = 24;
+
+	float EvaluationInterval = 0.25f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UTowerDestructibleComponent> Destructible;
+		double BreakTime = 0.0;
+	};
+
+	void Evaluate();
+
+	/** Oldest break first */
+	TArray<FEntry> Entries;
+
+	float TimeSinceEvaluation = 0.0f;
+	float ActiveFragmentCost = 0.0f;
+};
@@ -1,13 +1,12 @@
 #include "EchoGhost.h"
+#include "EchoGhostSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "UObject/ConstructorHelpers.h"
-#include "Materials/MaterialInstanceDynamic.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/Character.h"
 
 AEchoGhost::AEchoGhost()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Drawn and driven by UEchoGhostSubsystem
+    PrimaryActorTick.bCanEverTick = false;
 
     GhostMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("GhostMesh"));
     RootComponent = GhostMesh;
@@ -20,8 +19,10 @@ AEchoGhost::AEchoGhost()
         GhostMesh->SetStaticMesh(SphereMesh.Object);
     }
 
-    GhostMesh->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
-    GhostMesh->SetGenerateOverlapEvents(true);
+    // The batch instance is what's seen; this component only places the echo
+    GhostMesh->SetHiddenInGame(true);
+    GhostMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    GhostMesh->SetCastShadow(false);
 
     // Scale for humanoid silhouette
     SetActorScale3D(FVector(0.8f, 0.8f, 1.6f));
@@ -30,49 +31,21 @@ AEchoGhost::AEchoGhost()
 void AEchoGhost::BeginPlay()
 {
     Super::BeginPlay();
-    OriginalPosition = GetActorLocation();
-    UpdateGhostMaterial();
-}
-
-void AEchoGhost::Tick(float DeltaTime)
-{
-    Super::Tick(DeltaTime);
-
-    TimeAlive += DeltaTime;
 
-    // Lifetime check
-    if (TimeAlive >= LifetimeSeconds)
+    if (UEchoGhostSubsystem* Echoes = GetWorld()->GetSubsystem<UEchoGhostSubsystem>())
     {
-        Destroy();
-        return;
+        Echoes->RegisterEcho(this);
     }
+}
 
-    // Bobbing motion
-    float BobOffset = FMath::Sin(TimeAlive * BobSpeed) * BobHeight;
-    FVector NewPos = OriginalPosition;
-    NewPos.Z += BobOffset;
-    SetActorLocation(NewPos);
-
-    // Slow rotation
-    FRotator CurrentRot = GetActorRotation();
-    CurrentRot.Yaw += 30.0f * DeltaTime;
-    SetActorRotation(CurrentRot);
-
-    // Pulsing opacity
-    if (UMaterialInstanceDynamic* Mat = Cast<UMaterialInstanceDynamic>(GhostMesh->GetMaterial(0)))
+void AEchoGhost::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UEchoGhostSubsystem* Echoes = GetWorld()->GetSubsystem<UEchoGhostSubsystem>())
     {
-        float Pulse = 0.3f + 0.2f * FMath::Sin(TimeAlive * PulseSpeed);
-        // Fade out in last 20% of lifetime
-        float FadeProgress = TimeAlive / LifetimeSeconds;
-        if (FadeProgress > 0.8f)
-        {
-            Pulse *= (1.0f - FadeProgress) / 0.2f;
-        }
-        Mat->SetScalarParameterValue(TEXT("Opacity"), Pulse);
+        Echoes->UnregisterEcho(this);
     }
 
-    // Apply echo type effects to nearby players
-    ApplyEchoEffect(DeltaTime);
+    Super::EndPlay(EndPlayReason);
 }
 
 void AEchoGhost::InitFromData(const FString& PlayerName, EEchoType Type, FVector SpawnPosition)
@@ -80,7 +53,6 @@ void AEchoGhost::InitFromData(const FString& PlayerName, EEchoType Type, FVector
     OriginalPlayerName = PlayerName;
     EchoType = Type;
     SetActorLocation(SpawnPosition);
-    OriginalPosition = SpawnPosition;
 
     // Set scale based on echo type
     switch (EchoType)
@@ -100,7 +72,10 @@ void AEchoGhost::InitFromData(const FString& PlayerName, EEchoType Type, FVector
         break;
     }
 
-    UpdateGhostMaterial();
+    if (UEchoGhostSubsystem* Echoes = GetWorld()->GetSubsystem<UEchoGhostSubsystem>())
+    {
+        Echoes->RefreshEcho(this);
+    }
 
     UE_LOG(LogTemp, Log, TEXT("Echo spawned: %s (%s) at (%.0f, %.0f, %.0f)"),
         *PlayerName,
@@ -124,53 +99,3 @@ FLinearColor AEchoGhost::GetEchoColor() const
         return FLinearColor(0.5f, 0.5f, 0.5f, 0.3f);
     }
 }
-
-void AEchoGhost::UpdateGhostMaterial()
-{
-    if (!GhostMesh) return;
-
-    UMaterialInstanceDynamic* Mat = GhostMesh->CreateAndSetMaterialInstanceDynamic(0);
-    if (Mat)
-    {
-        FLinearColor Color = GetEchoColor();
-        Mat->SetVectorParameterValue(TEXT("BaseColor"), Color);
-        Mat->SetScalarParameterValue(TEXT("Opacity"), Color.A);
-        // Emissive glow
-        Mat->SetVectorParameterValue(TEXT("EmissiveColor"), Color * 2.0f);
-    }
-}
-
-void AEchoGhost::ApplyEchoEffect(float DeltaTime)
-{
-    // Only helpful and aggressive echoes interact with players
-    if (EchoType != EEchoType::Aggressive && EchoType != EEchoType::Helpful)
-        return;
-
-    ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
-    if (!Player) return;
-
-    float Distance = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-    if (Distance > EffectRadius) return;
-
-    float Strength = 1.0f - (Distance / EffectRadius); // 1.0 at center, 0.0 at edge
-
-    if (EchoType == EEchoType::Helpful)
-    {
-        // Heal nearby player
-        // In production, call TowerPlayerCharacter::Heal()
-        UE_LOG(LogTemp, Verbose, TEXT("Echo heal: +%.1f HP (strength: %.2f)"),
-            HelpfulHealPerSecond * Strength * DeltaTime, Strength);
-    }
-    else if (EchoType == EEchoType::Aggressive)
-    {
-        // Damage nearby player (once per second approximation)
-        static float DamageAccum = 0.0f;
-        DamageAccum += DeltaTime;
-        if (DamageAccum >= 1.0f)
-        {
-            DamageAccum = 0.0f;
-            UE_LOG(LogTemp, Verbose, TEXT("Echo damage: %.1f (strength: %.2f)"),
-                AggressiveDamage * Strength, Strength);
-        }
-    }
-}
@@ -18,6 +18,11 @@ class UNiagaraComponent;
  *
  * Echoes appear translucent with an ethereal glow.
  * They fade out after their server-side TTL expires (24h default).
+ *
+ * The actor only carries the echo's data and placement: UEchoGhostSubsystem
+ * draws it as an instance of its GhostMesh (GhostMesh itself stays hidden),
+ * animates it on the GPU and applies its effect. Blueprint subclasses pick the
+ * look by setting GhostMesh's mesh and material.
  */
 UENUM(BlueprintType)
 enum class EEchoType : uint8
@@ -37,7 +42,7 @@ public:
     AEchoGhost();
 
     virtual void BeginPlay() override;
-    virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     /** Initialize echo from server data */
     UFUNCTION(BlueprintCallable, Category = "Echo")
@@ -82,11 +87,9 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Echo")
     UStaticMeshComponent* GhostMesh;
 
-private:
-    float TimeAlive = 0.0f;
-    FVector OriginalPosition;
-
+    /** Tint (RGB) and base opacity (A) for this echo's type */
     FLinearColor GetEchoColor() const;
-    void UpdateGhostMaterial();
-    void ApplyEchoEffect(float DeltaTime);
+
+    /** Index of this echo's slot in UEchoGhostSubsystem */
+    int32 EchoSlot = INDEX_NONE;
 };
@@ -0,0 +1,329 @@
+#include "EchoGhostSubsystem.h"
+#include "EchoGhost.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Network/NakamaSubsystem.h"
+#include "ProximityQuerySubsystem.h"
+
+void UEchoGhostSubsystem::Deinitialize()
+{
+    Echoes.Empty();
+    Positions.Empty();
+    DespawnAt.Empty();
+    DamageTimers.Empty();
+    SlotBatch.Empty();
+    SlotInstance.Empty();
+    FreeSlots.Empty();
+    EffectSlots.Empty();
+    Batches.Empty();
+    BatchByMesh.Empty();
+    BatchComponents.Empty();
+    ProximityHandles.Empty();
+    PlayerScratch.Empty();
+    PendingSpawns.Empty();
+    SpawnedEchoIds.Empty();
+    BatchOwner = nullptr;
+    NumLive = 0;
+    Super::Deinitialize();
+}
+
+bool UEchoGhostSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEchoGhostSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UEchoGhostSubsystem, STATGROUP_Tickables);
+}
+
+// ============ Registration ============
+
+void UEchoGhostSubsystem::RegisterEcho(AEchoGhost* Echo)
+{
+    if (!Echo || Echo->EchoSlot != INDEX_NONE) return;
+
+    const int32 BatchIdx = GetOrCreateBatch(Echo);
+    if (BatchIdx == INDEX_NONE) return;
+
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(/*bAllowShrinking=*/false);
+    }
+    else
+    {
+        Slot = Echoes.AddDefaulted();
+        Positions.AddUninitialized();
+        DespawnAt.AddUninitialized();
+        DamageTimers.AddUninitialized();
+        SlotBatch.AddUninitialized();
+        SlotInstance.AddUninitialized();
+        ProximityHandles.AddUninitialized();
+    }
+
+    Echoes[Slot] = Echo;
+    DespawnAt[Slot] = GetWorld()->GetTimeSeconds() + Echo->LifetimeSeconds;
+    DamageTimers[Slot] = 0.0f;
+
+    FEchoBatch& Batch = Batches[BatchIdx];
+    SlotBatch[Slot] = BatchIdx;
+    SlotInstance[Slot] = Batch.Instances->AddInstance(Echo->GetActorTransform(), /*bWorldSpace=*/true);
+    Batch.InstanceSlots.Add(Slot);
+
+    UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>();
+    ProximityHandles[Slot] = Proximity ? Proximity->Register(Echo, EProximityChannel::Echo, Echo->EffectRadius,
+        FOnProximityChanged(), Slot) : INDEX_NONE;
+
+    Echo->EchoSlot = Slot;
+    NumLive++;
+    WriteInstance(Slot, Echo, /*bMarkRenderStateDirty=*/true);
+}
+
+void UEchoGhostSubsystem::UnregisterEcho(AEchoGhost* Echo)
+{
+    if (!Echo || !Echoes.IsValidIndex(Echo->EchoSlot)) return;
+
+    const int32 Slot = Echo->EchoSlot;
+    Echo->EchoSlot = INDEX_NONE;
+
+    // Swap-remove on both sides: the batch's last instance moves into this one's index
+    FEchoBatch& Batch = Batches[SlotBatch[Slot]];
+    const int32 InstIdx = SlotInstance[Slot];
+    if (IsValid(Batch.Instances))
+    {
+        Batch.Instances->RemoveInstance(InstIdx);
+    }
+    Batch.InstanceSlots.RemoveAtSwap(InstIdx, 1, /*bAllowShrinking=*/false);
+    if (Batch.InstanceSlots.IsValidIndex(InstIdx))
+    {
+        SlotInstance[Batch.InstanceSlots[InstIdx]] = InstIdx;
+    }
+
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->Unregister(ProximityHandles[Slot]);
+    }
+    ProximityHandles[Slot] = INDEX_NONE;
+
+    EffectSlots.RemoveSingleSwap(Slot, /*bAllowShrinking=*/false);
+    Echoes[Slot].Reset();
+    FreeSlots.Add(Slot);
+    NumLive--;
+}
+
+void UEchoGhostSubsystem::RefreshEcho(AEchoGhost* Echo)
+{
+    if (!Echo || !Echoes.IsValidIndex(Echo->EchoSlot)) return;
+
+    const int32 Slot = Echo->EchoSlot;
+    Batches[SlotBatch[Slot]].Instances->UpdateInstanceTransform(SlotInstance[Slot], Echo->GetActorTransform(),
+        /*bWorldSpace=*/true, /*bMarkRenderStateDirty=*/false, /*bTeleport=*/true);
+    WriteInstance(Slot, Echo, /*bMarkRenderStateDirty=*/true);
+}
+
+int32 UEchoGhostSubsystem::GetOrCreateBatch(AEchoGhost* Echo)
+{
+    UStaticMesh* Mesh = Echo->GhostMesh ? Echo->GhostMesh->GetStaticMesh() : nullptr;
+    if (!Mesh) return INDEX_NONE;
+
+    if (const int32* Existing = BatchByMesh.Find(Mesh))
+    {
+        return *Existing;
+    }
+
+    UWorld* World = GetWorld();
+    if (!IsValid(BatchOwner))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        BatchOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!BatchOwner) return INDEX_NONE;
+        BatchOwner->SetRootComponent(NewObject<USceneComponent>(BatchOwner, TEXT("EchoBatchRoot")));
+        BatchOwner->GetRootComponent()->RegisterComponent();
+    }
+
+    // Instances are placed in world space, so the owner stays at the origin
+    UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(BatchOwner,
+        MakeUniqueObjectName(BatchOwner, UInstancedStaticMeshComponent::StaticClass(), TEXT("EchoBatch")));
+    ISM->SetStaticMesh(Mesh);
+    ISM->SetMaterial(0, Echo->GhostMesh->GetMaterial(0));
+    ISM->NumCustomDataFloats = EchoCustomData::NumFloats;
+    ISM->bSupportRemoveAtSwap = true;
+    ISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ISM->SetCastShadow(false);
+    ISM->SetCanEverAffectNavigation(false);
+    ISM->SetupAttachment(BatchOwner->GetRootComponent());
+    ISM->RegisterComponent();
+
+    const int32 BatchIdx = Batches.AddDefaulted();
+    Batches[BatchIdx].Instances = ISM;
+    BatchComponents.Add(ISM);
+    BatchByMesh.Add(Mesh, BatchIdx);
+    return BatchIdx;
+}
+
+void UEchoGhostSubsystem::WriteInstance(int32 Slot, AEchoGhost* Echo, bool bMarkRenderStateDirty)
+{
+    Positions[Slot] = Echo->GetActorLocation();
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->UpdateLocation(ProximityHandles[Slot], Positions[Slot]);
+    }
+
+    const FLinearColor Color = Echo->GetEchoColor();
+    float CustomData[EchoCustomData::NumFloats];
+    CustomData[EchoCustomData::ColorR] = Color.R;
+    CustomData[EchoCustomData::ColorG] = Color.G;
+    CustomData[EchoCustomData::ColorB] = Color.B;
+    CustomData[EchoCustomData::Opacity] = Color.A;
+    CustomData[EchoCustomData::PulseSpeed] = Echo->PulseSpeed;
+    CustomData[EchoCustomData::SpawnTime] = static_cast<float>(DespawnAt[Slot] - Echo->LifetimeSeconds);
+    CustomData[EchoCustomData::Lifetime] = Echo->LifetimeSeconds;
+    CustomData[EchoCustomData::BobHeight] = Echo->BobHeight;
+    CustomData[EchoCustomData::BobSpeed] = Echo->BobSpeed;
+    Batches[SlotBatch[Slot]].Instances->SetCustomData(SlotInstance[Slot], MakeArrayView(CustomData), bMarkRenderStateDirty);
+
+    // Only helpful and aggressive echoes interact with players
+    const bool bHasEffect = Echo->EchoType == EEchoType::Aggressive || Echo->EchoType == EEchoType::Helpful;
+    if (bHasEffect)
+    {
+        EffectSlots.AddUnique(Slot);
+    }
+    else
+    {
+        EffectSlots.RemoveSingleSwap(Slot, /*bAllowShrinking=*/false);
+    }
+}
+
+// ============ Spawning ============
+
+void UEchoGhostSubsystem::SpawnFloorEchoes(int32 FloorId, FVector SpawnPoint, TSubclassOf<AEchoGhost> EchoClass)
+{
+    UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+    UNakamaSubsystem* Nakama = GameInstance ? GameInstance->GetSubsystem<UNakamaSubsystem>() : nullptr;
+    const FTowerFloorEchoCache* Cache = Nakama ? Nakama->GetCachedEchoes(FloorId) : nullptr;
+    if (!Cache || !EchoClass) return;
+
+    const UEnum* TypeEnum = StaticEnum<EEchoType>();
+    for (const FTowerEchoRecord& Record : Cache->Echoes)
+    {
+        bool bAlreadySpawned = false;
+        SpawnedEchoIds.Add(Record.Id, &bAlreadySpawned);
+        if (bAlreadySpawned) continue;
+
+        const int64 TypeValue = TypeEnum->GetValueByNameString(Record.EchoType);
+
+        FPendingEchoSpawn& Spawn = PendingSpawns.AddDefaulted_GetRef();
+        Spawn.PlayerName = Record.PlayerName;
+        Spawn.Type = TypeValue == INDEX_NONE ? EEchoType::Lingering : static_cast<EEchoType>(TypeValue);
+        Spawn.Position = Record.Position;
+        Spawn.DistSq = FVector::DistSquared(Record.Position, SpawnPoint);
+        Spawn.EchoClass = EchoClass;
+    }
+
+    PendingSpawns.Sort([](const FPendingEchoSpawn& A, const FPendingEchoSpawn& B) { return A.DistSq > B.DistSq; });
+}
+
+void UEchoGhostSubsystem::SpawnPending()
+{
+    UWorld* World = GetWorld();
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    for (int32 Spawned = 0; Spawned < MaxSpawnsPerFrame && PendingSpawns.Num() > 0; Spawned++)
+    {
+        const FPendingEchoSpawn Spawn = PendingSpawns.Pop(/*bAllowShrinking=*/false);
+        if (AEchoGhost* Echo = World->SpawnActor<AEchoGhost>(Spawn.EchoClass, Spawn.Position, FRotator::ZeroRotator, Params))
+        {
+            Echo->InitFromData(Spawn.PlayerName, Spawn.Type, Spawn.Position);
+        }
+    }
+}
+
+// ============ Update ============
+
+void UEchoGhostSubsystem::Tick(float DeltaTime)
+{
+    if (PendingSpawns.Num() > 0)
+    {
+        SpawnPending();
+    }
+
+    if (NumLive == 0) return;
+
+    ExpireEchoes(GetWorld()->GetTimeSeconds());
+
+    TimeSinceEffects += DeltaTime;
+    if (TimeSinceEffects >= EffectInterval && EffectSlots.Num() > 0)
+    {
+        ApplyEffects(TimeSinceEffects);
+        TimeSinceEffects = 0.0f;
+    }
+}
+
+void UEchoGhostSubsystem::ExpireEchoes(double Now)
+{
+    TArray<AEchoGhost*, TInlineAllocator<16>> Expired;
+    for (int32 Slot = 0; Slot < Echoes.Num(); Slot++)
+    {
+        if (DespawnAt[Slot] <= Now)
+        {
+            if (AEchoGhost* Echo = Echoes[Slot].Get())
+            {
+                Expired.Add(Echo);
+            }
+        }
+    }
+
+    // Destroying unregisters, so not while walking the slots
+    for (AEchoGhost* Echo : Expired)
+    {
+        UnregisterEcho(Echo);
+        Echo->Destroy();
+    }
+}
+
+void UEchoGhostSubsystem::ApplyEffects(float DeltaTime)
+{
+    UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>();
+    if (!Proximity || Proximity->GetNumEntries(EProximityChannel::Player) == 0) return;
+
+    for (int32 Slot : EffectSlots)
+    {
+        AEchoGhost* Echo = Echoes[Slot].Get();
+        if (!Echo) continue;
+
+        const FVector& EchoLocation = Positions[Slot];
+        const float Radius = Echo->EffectRadius;
+
+        DamageTimers[Slot] += DeltaTime;
+        const bool bDamageTick = DamageTimers[Slot] >= 1.0f;
+        if (bDamageTick)
+        {
+            DamageTimers[Slot] = 0.0f;
+        }
+
+        PlayerScratch.Reset();
+        Proximity->QueryRadius(EchoLocation, Radius, EProximityChannel::Player, PlayerScratch);
+        for (int32 Handle : PlayerScratch)
+        {
+            const float Distance = FVector::Dist(EchoLocation, Proximity->GetLocation(Handle));
+            const float Strength = 1.0f - (Distance / Radius); // 1.0 at center, 0.0 at edge
+            if (Echo->EchoType == EEchoType::Helpful)
+            {
+                // In production, call TowerPlayerCharacter::Heal()
+                UE_LOG(LogTemp, Verbose, TEXT("Echo heal: +%.1f HP (strength: %.2f)"),
+                    Echo->HelpfulHealPerSecond * Strength * DeltaTime, Strength);
+            }
+            else if (bDamageTick)
+            {
+                // Once per second per echo
+                UE_LOG(LogTemp, Verbose, TEXT("Echo damage: %.1f (strength: %.2f)"),
+                    Echo->AggressiveDamage * Strength, Strength);
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EchoGhostSubsystem.generated.h"
+
+class AEchoGhost;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+enum class EEchoType : uint8;
+
+/** Per-instance custom data floats of echo ISMs, read by the echo material */
+namespace EchoCustomData
+{
+    enum : int32
+    {
+        ColorR = 0,
+        ColorG,
+        ColorB,
+        Opacity,     // Base opacity before pulse and fade
+        PulseSpeed,  // rad/s
+        SpawnTime,   // World seconds
+        Lifetime,    // Seconds; fade over the last 20%
+        BobHeight,
+        BobSpeed,    // rad/s
+
+        NumFloats
+    };
+}
+
+/**
+ * Draws and drives every AEchoGhost from one place. Echoes don't tick or render
+ * themselves: each gets an instance in an ISM per ghost mesh, with its color and
+ * animation parameters in per-instance custom data (EchoCustomData), and the
+ * material does pulse, bob, spin and end-of-life fade from the world time. A
+ * floor of a few hundred echoes is a handful of draw calls and no per-frame
+ * game-thread work per echo.
+ *
+ * Echoes go on the proximity grid's Echo channel. Helpful and aggressive
+ * effects run every EffectInterval as one pass, each effect echo asking the
+ * grid's Player channel for the players within its EffectRadius.
+ *
+ * SpawnFloorEchoes places a floor's echoes from UNakamaSubsystem's echo cache,
+ * nearest the spawn point first and MaxSpawnsPerFrame a frame, so a crowded
+ * floor fills in around the player without a spawn hitch.
+ */
+UCLASS()
+class TOWERGAME_API UEchoGhostSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ============ Registration ============
+
+    void RegisterEcho(AEchoGhost* Echo);
+    void UnregisterEcho(AEchoGhost* Echo);
+
+    /** Re-read a registered echo's transform, type and tuning (after InitFromData) */
+    void RefreshEcho(AEchoGhost* Echo);
+
+    int32 GetNumEchoes() const { return NumLive; }
+
+    // ============ Spawning ============
+
+    /**
+     * Spawn EchoClass for every cached echo of FloorId not yet spawned in this world,
+     * nearest SpawnPoint first, over the next frames. Call again after a
+     * FetchFloorEchoes to add the ones it brought.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Echo")
+    void SpawnFloorEchoes(int32 FloorId, FVector SpawnPoint, TSubclassOf<AEchoGhost> EchoClass);
+
+    /** Echoes queued by SpawnFloorEchoes and not spawned yet */
+    int32 GetNumPendingSpawns() const { return PendingSpawns.Num(); }
+
+    // ============ Config ============
+
+    /** Seconds between effect passes */
+    float EffectInterval = 0.1f;
+
+    /** Echo actors SpawnFloorEchoes creates per frame */
+    int32 MaxSpawnsPerFrame = 8;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** ISM drawing every echo of one mesh, and the slot of each of its instances */
+    struct FEchoBatch
+    {
+        UInstancedStaticMeshComponent* Instances = nullptr;
+        TArray<int32> InstanceSlots;
+    };
+
+    int32 GetOrCreateBatch(AEchoGhost* Echo);
+    void WriteInstance(int32 Slot, AEchoGhost* Echo, bool bMarkRenderStateDirty);
+
+    void ExpireEchoes(double Now);
+    void ApplyEffects(float DeltaTime);
+
+    void SpawnPending();
+
+    struct FPendingEchoSpawn
+    {
+        FString PlayerName;
+        EEchoType Type;
+        FVector Position;
+        float DistSq;
+        TSubclassOf<AEchoGhost> EchoClass;
+    };
+
+    /** Farthest first, so the nearest pops off the end */
+    TArray<FPendingEchoSpawn> PendingSpawns;
+
+    /** Server ids of the echoes queued or spawned in this world */
+    TSet<FString> SpawnedEchoIds;
+
+    // Per slot; a free slot has a null Echo
+    TArray<TWeakObjectPtr<AEchoGhost>> Echoes;
+    TArray<FVector> Positions;
+    TArray<double> DespawnAt;
+    TArray<float> DamageTimers;
+    TArray<int32> SlotBatch;
+    TArray<int32> SlotInstance;
+    TArray<int32> ProximityHandles;
+    TArray<int32> FreeSlots;
+    int32 NumLive = 0;
+
+    /** Slots of the echoes that have an effect (aggressive / helpful) */
+    TArray<int32> EffectSlots;
+
+    TArray<FEchoBatch> Batches;
+    TMap<UStaticMesh*, int32> BatchByMesh;
+
+    /** Carries the batch components; spawned with the first echo */
+    UPROPERTY()
+    AActor* BatchOwner = nullptr;
+
+    /** Keeps the batch components alive (Batches isn't reflected) */
+    UPROPERTY()
+    TArray<UInstancedStaticMeshComponent*> BatchComponents;
+
+    float TimeSinceEffects = 0.0f;
+
+    /** Reused per effect echo */
+    TArray<int32> PlayerScratch;
+};
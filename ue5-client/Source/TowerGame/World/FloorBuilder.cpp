@@ -2,6 +2,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Rendering/MaterialVariantSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
 
 // ============ AFloorBuilder ============
@@ -119,14 +120,12 @@ void ATowerTile::InitTile(int32 InTileType, float InTileSize, float InWallHeight
 
     MeshComponent->SetWorldScale3D(FVector(BaseScale, BaseScale, HeightScale));
 
-    // Create dynamic material with tile color
-    UMaterialInterface* BaseMat = MeshComponent->GetMaterial(0);
-    if (BaseMat)
+    // Tile color from the material shared by every tile of this type
+    UTowerMaterialVariantSubsystem* Variants = GetWorld()->GetSubsystem<UTowerMaterialVariantSubsystem>();
+    if (UMaterialInstanceDynamic* TileMat = Variants ? Variants->FindOrCreateColored(MeshComponent->GetMaterial(0),
+        FName(TEXT("Tile"), InTileType), AFloorBuilder::GetTileColor(InTileType)) : nullptr)
     {
-        UMaterialInstanceDynamic* DynMat = UMaterialInstanceDynamic::Create(BaseMat, this);
-        FLinearColor Color = AFloorBuilder::GetTileColor(InTileType);
-        DynMat->SetVectorParameterValue(TEXT("BaseColor"), Color);
-        MeshComponent->SetMaterial(0, DynMat);
+        MeshComponent->SetMaterial(0, TileMat);
     }
 
 #if WITH_EDITOR
@@ -0,0 +1,95 @@
+#include "FloorTeardownSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+void UTowerFloorTeardownSubsystem::Deinitialize()
+{
+    // The world takes whatever is left down with it
+    Pending.Empty();
+    Cursor = 0;
+    bGarbageCollectionRequested = false;
+    Super::Deinitialize();
+}
+
+bool UTowerFloorTeardownSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerFloorTeardownSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerFloorTeardownSubsystem, STATGROUP_Tickables);
+}
+
+void UTowerFloorTeardownSubsystem::RetireActors(TArray<AActor*>& Actors)
+{
+    Pending.Reserve(Pending.Num() + Actors.Num());
+    for (AActor* Actor : Actors)
+    {
+        RetireActor(Actor);
+    }
+    Actors.Reset();
+}
+
+void UTowerFloorTeardownSubsystem::RetireActor(AActor* Actor)
+{
+    if (!IsValid(Actor))
+    {
+        return;
+    }
+
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+    Pending.Add(Actor);
+}
+
+void UTowerFloorTeardownSubsystem::Tick(float DeltaTime)
+{
+    if (GetNumPending() > 0)
+    {
+        TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_Teardown);
+        const double Deadline = FPlatformTime::Seconds() + DestroyBudgetMs * 0.001;
+        int32 Destroyed = 0;
+        while (Cursor < Pending.Num()
+            && (Destroyed < MinDestroysPerTick || FPlatformTime::Seconds() < Deadline))
+        {
+            if (AActor* Actor = Pending[Cursor++].Get())
+            {
+                Actor->Destroy();
+                ++Destroyed;
+            }
+        }
+
+        if (Cursor == Pending.Num())
+        {
+            Pending.Reset();
+            Cursor = 0;
+        }
+        return;
+    }
+
+    if (bGarbageCollectionRequested)
+    {
+        // Not a full purge: unreachable objects are purged incrementally over the next frames
+        bGarbageCollectionRequested = false;
+        GEngine->ForceGarbageCollection(false);
+    }
+}
+
+void UTowerFloorTeardownSubsystem::Flush()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerFloor_TeardownFlush);
+    for (; Cursor < Pending.Num(); ++Cursor)
+    {
+        if (AActor* Actor = Pending[Cursor].Get())
+        {
+            Actor->Destroy();
+        }
+    }
+    Pending.Reset();
+    Cursor = 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FloorTeardownSubsystem.generated.h"
+
+/**
+ * Owns everything a floor leaves behind once it is cleared. Retired actors are
+ * hidden, stripped of collision and tick on the spot, so gameplay sees them gone,
+ * and destroyed a few at a time within DestroyBudgetMs per frame instead of all in
+ * the frame the floor unloads.
+ *
+ * RequestGarbageCollection runs one GC pass as soon as the queue has drained;
+ * UFloorTransitionComponent asks for it during the loading screen and waits for
+ * IsIdle before fading in, so the floor's garbage is collected while nothing is
+ * on screen rather than by the periodic GC in the middle of the next floor.
+ */
+UCLASS()
+class TOWERGAME_API UTowerFloorTeardownSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Take Actors off the floor now and destroy them over the next frames; Actors is emptied */
+    void RetireActors(TArray<AActor*>& Actors);
+    void RetireActor(AActor* Actor);
+
+    /** Collect garbage once every retired actor is destroyed */
+    void RequestGarbageCollection() { bGarbageCollectionRequested = true; }
+
+    /** Destroy everything still queued in this frame */
+    void Flush();
+
+    int32 GetNumPending() const { return Pending.Num() - Cursor; }
+
+    /** Nothing left to destroy and no GC waiting to be started */
+    bool IsIdle() const { return GetNumPending() == 0 && !bGarbageCollectionRequested; }
+
+    // ============ Config ============
+
+    /** Game-thread milliseconds per frame spent destroying retired actors */
+    float DestroyBudgetMs = 1.0f;
+
+    /** Destroyed per frame regardless of the budget, so a slow frame still makes progress */
+    int32 MinDestroysPerTick = 4;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Destroyed in order from Cursor; reset once it catches up */
+    TArray<TWeakObjectPtr<AActor>> Pending;
+    int32 Cursor = 0;
+
+    bool bGarbageCollectionRequested = false;
+};
@@ -1,8 +1,17 @@
 #include "FloorTransitionComponent.h"
 #include "Core/TowerGameMode.h"
 #include "Core/TowerGameSubsystem.h"
+#include "Rendering/PSOWarmupSubsystem.h"
+#include "World/FloorTeardownSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Camera/PlayerCameraManager.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+namespace
+{
+    // Share of the load bar covered by generation; building the floor covers the rest
+    constexpr float GenerationProgressShare = 0.5f;
+}
 
 UFloorTransitionComponent::UFloorTransitionComponent()
 {
@@ -36,8 +45,11 @@ void UFloorTransitionComponent::TransitionToFloor(int32 NewFloor)
 
     TargetFloor = NewFloor;
     bFloorGenerated = false;
+    bBuildingFloor = false;
+    bTeardownRequested = false;
 
     UE_LOG(LogTemp, Log, TEXT("Floor transition: -> floor %d"), NewFloor);
+    TRACE_BOOKMARK(TEXT("Floor transition -> %d"), NewFloor);
 
     OnTransitionStart.Broadcast(NewFloor);
     BeginFadeOut();
@@ -56,8 +68,11 @@ void UFloorTransitionComponent::UpdateFadeOut(float DeltaTime)
     float Alpha = FMath::Clamp(StateTimer / FadeOutDuration, 0.0f, 1.0f);
     SetScreenFade(Alpha);
 
-    LoadProgress = Alpha * 0.1f; // 0-10% during fade out
-    OnLoadProgress.Broadcast(LoadProgress);
+    // Spread the next floor's extra monster spawns over the fade
+    if (ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this)))
+    {
+        GM->PrewarmMonsters(TargetFloor, MonsterPrewarmPerTick);
+    }
 
     if (StateTimer >= FadeOutDuration)
     {
@@ -70,18 +85,15 @@ void UFloorTransitionComponent::BeginLoading()
     State = ETransitionState::Loading;
     StateTimer = 0.0f;
 
-    // Destroy old floor
-    ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this));
-    if (GM)
+    LoadProgress = 0.0f;
+    OnLoadProgress.Broadcast(LoadProgress);
+
+    if (UTowerPSOWarmupSubsystem* Warmup = GetWorld()->GetSubsystem<UTowerPSOWarmupSubsystem>())
     {
-        // GameMode handles destroying old tiles and monsters
-        UE_LOG(LogTemp, Log, TEXT("Destroying old floor..."));
+        Warmup->BeginWarmup();
     }
 
-    LoadProgress = 0.2f;
-    OnLoadProgress.Broadcast(LoadProgress);
-
-    // Generate new floor via Rust core
+    // Generate new floor via Rust core, off the game thread
     UTowerGameSubsystem* Subsystem = nullptr;
     UGameInstance* GI = UGameplayStatics::GetGameInstance(this);
     if (GI)
@@ -89,17 +101,32 @@ void UFloorTransitionComponent::BeginLoading()
         Subsystem = GI->GetSubsystem<UTowerGameSubsystem>();
     }
 
-    if (Subsystem)
+    ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this));
+    if (GM && GM->ActivateResidentFloor(TargetFloor))
     {
-        LoadProgress = 0.5f;
-        OnLoadProgress.Broadcast(LoadProgress);
-
-        // Floor generation is synchronous (fast — handled by DLL)
-        UE_LOG(LogTemp, Log, TEXT("Generating floor %d via Rust core..."), TargetFloor);
+        // Still built from the last visit; swapped in while the screen is dark
+        bFloorGenerated = true;
+    }
+    else if (Subsystem && Subsystem->IsRustCoreReady() && GM)
+    {
+        // Usually prefetched when the previous floor loaded or the stairs came in range
+        const int32 MonsterCount = GM->GetMonsterCountForFloor(TargetFloor);
+        PendingFloor = Subsystem->TakePrefetchedFloor(Subsystem->TowerSeed, TargetFloor, MonsterCount);
+        if (PendingFloor.IsValid() && PendingFloor->IsComplete() && PendingFloor->GetResult().bSucceeded)
+        {
+            // Start the floor's assets streaming while the loading screen comes up
+            GM->PrefetchFloorAssets(PendingFloor->GetResult());
+        }
+        if (!PendingFloor.IsValid())
+        {
+            UE_LOG(LogTemp, Log, TEXT("Generating floor %d via Rust core..."), TargetFloor);
+            PendingFloor = Subsystem->RequestFloorAsync(Subsystem->TowerSeed, TargetFloor, MonsterCount);
+        }
+    }
+    else
+    {
+        // Nothing to generate with; just run the fade
         bFloorGenerated = true;
-
-        LoadProgress = 0.8f;
-        OnLoadProgress.Broadcast(LoadProgress);
     }
 }
 
@@ -107,8 +134,52 @@ void UFloorTransitionComponent::UpdateLoading(float DeltaTime)
 {
     StateTimer += DeltaTime;
 
-    // Ensure minimum load time
-    if (StateTimer >= MinLoadTime && bFloorGenerated)
+    if (PendingFloor.IsValid())
+    {
+        ReportProgress(PendingFloor->GetProgress() * GenerationProgressShare);
+
+        if (PendingFloor->IsComplete())
+        {
+            // GameMode destroys the old tiles and monsters now and builds the new
+            // floor over the next ticks
+            const FGeneratedFloorData& Floor = PendingFloor->GetResult();
+            ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this));
+            if (GM && Floor.bSucceeded)
+            {
+                // Meshes stream and precaches compile on worker threads while the floor builds
+                GM->PrefetchFloorAssets(Floor);
+                GM->WarmupFloorPSOs(Floor);
+                GM->BeginBuildFloor(Floor);
+                bBuildingFloor = GM->IsBuildingFloor();
+            }
+            else
+            {
+                UE_LOG(LogTemp, Error, TEXT("Floor %d generation failed"), TargetFloor);
+            }
+
+            PendingFloor.Reset();
+            bFloorGenerated = !bBuildingFloor;
+            ReportProgress(GenerationProgressShare);
+        }
+        return;
+    }
+
+    if (bBuildingFloor)
+    {
+        ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this));
+        if (!GM || GM->TickFloorBuild(FloorBuildBudgetMs * 0.001))
+        {
+            bBuildingFloor = false;
+            bFloorGenerated = true;
+        }
+        else
+        {
+            ReportProgress(GenerationProgressShare + GM->GetFloorBuildProgress() * (1.0f - GenerationProgressShare));
+        }
+    }
+
+    // Ensure minimum load time; the old floor finishes tearing down while it's still dark
+    if (StateTimer >= MinLoadTime && bFloorGenerated && IsTeardownDone())
     {
         LoadProgress = 1.0f;
         OnLoadProgress.Broadcast(LoadProgress);
@@ -116,10 +187,49 @@ void UFloorTransitionComponent::UpdateLoading(float DeltaTime)
     }
 }
 
+bool UFloorTransitionComponent::IsTeardownDone()
+{
+    UTowerFloorTeardownSubsystem* Teardown = GetWorld()->GetSubsystem<UTowerFloorTeardownSubsystem>();
+    if (!Teardown || StateTimer >= MinLoadTime + MaxTeardownWait)
+    {
+        return true;
+    }
+
+    // The old floor is retired by now; collect it once its actors are gone
+    if (!bTeardownRequested)
+    {
+        bTeardownRequested = true;
+        if (bCollectGarbageWhileLoading)
+        {
+            Teardown->RequestGarbageCollection();
+        }
+    }
+    return Teardown->IsIdle();
+}
+
+void UFloorTransitionComponent::ReportProgress(float Progress)
+{
+    if (Progress > LoadProgress)
+    {
+        LoadProgress = Progress;
+        OnLoadProgress.Broadcast(LoadProgress);
+    }
+}
+
 void UFloorTransitionComponent::BeginFadeIn()
 {
     State = ETransitionState::FadingIn;
     StateTimer = 0.0f;
+
+    // Whatever is still compiling now will be drawn before it is ready
+    if (UTowerPSOWarmupSubsystem* Warmup = GetWorld()->GetSubsystem<UTowerPSOWarmupSubsystem>())
+    {
+        LastPrecacheMisses = Warmup->FinishWarmup();
+        if (LastPrecacheMisses > 0)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Floor %d: %d PSO precaches missed the fade-in"), TargetFloor, LastPrecacheMisses);
+        }
+    }
 }
 
 void UFloorTransitionComponent::UpdateFadeIn(float DeltaTime)
@@ -143,6 +253,7 @@ void UFloorTransitionComponent::FinishTransition()
     SetScreenFade(0.0f);
 
     UE_LOG(LogTemp, Log, TEXT("Floor transition complete: floor %d"), TargetFloor);
+    TRACE_BOOKMARK(TEXT("Floor transition complete: %d"), TargetFloor);
     OnTransitionEnd.Broadcast(TargetFloor);
 }
 
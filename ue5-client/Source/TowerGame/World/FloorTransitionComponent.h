@@ -5,6 +5,7 @@
 #include "FloorTransitionComponent.generated.h"
 
 class ATowerGameMode;
+class FFloorGenerationRequest;
 
 /**
  * Floor transition states.
@@ -26,12 +27,18 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFloorLoadProgress, float, Progres
  * Manages floor-to-floor transitions with visual effects.
  *
  * Sequence:
- * 1. Fade to black (0.5s)
- * 2. Destroy old floor tiles/monsters
- * 3. Generate new floor via Rust core (tower_core.dll)
- * 4. Spawn new tiles and monsters
+ * 1. Fade to black (0.5s), topping up the monster pool meanwhile
+ * 2. Retire old floor tiles (hidden now, destroyed a few per frame), park its monsters in the pool
+ * 3. Generate new floor via Rust core (tower_core.dll) on a worker task, then
+ *    start PSO precaches for its tiles, monsters and VFX (UTowerPSOWarmupSubsystem)
+ * 4. Build its tiles, collision, lights and navigation a few milliseconds per
+ *    frame (FloorBuildBudgetMs), then spawn the monsters
  * 5. Position player at entrance
- * 6. Fade in from black (0.5s)
+ * 6. Wait for the old floor's actors to be destroyed (UTowerFloorTeardownSubsystem)
+ *    and run a GC pass over them
+ * 7. Fade in from black (0.5s)
+ *
+ * OnLoadProgress reports steps 3 and 4 as they actually advance.
  *
  * Attach to GameMode or PlayerController.
  */
@@ -64,6 +71,10 @@ public:
     UFUNCTION(BlueprintPure, Category = "FloorTransition")
     float GetProgress() const { return LoadProgress; }
 
+    /** PSO precaches of the last transition still compiling when it faded in (each a possible hitch) */
+    UFUNCTION(BlueprintPure, Category = "FloorTransition")
+    int32 GetLastPrecacheMisses() const { return LastPrecacheMisses; }
+
     // ============ Config ============
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FloorTransition")
@@ -76,6 +87,22 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FloorTransition")
     float MinLoadTime = 0.5f;
 
+    /** Game-thread milliseconds per frame spent building the new floor (<= 0 builds it in one frame) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FloorTransition", meta = (ClampMin = "0.0"))
+    float FloorBuildBudgetMs = 4.0f;
+
+    /** Collect garbage behind the loading screen once the old floor is torn down, instead of mid-floor */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FloorTransition")
+    bool bCollectGarbageWhileLoading = true;
+
+    /** Seconds past MinLoadTime the fade-in waits for the teardown before giving up on it */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FloorTransition", meta = (ClampMin = "0.0"))
+    float MaxTeardownWait = 2.0f;
+
+    /** Monsters spawned into the pool per tick of the fade-out, so the next floor reuses instead of spawning */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FloorTransition", meta = (ClampMin = "0"))
+    int32 MonsterPrewarmPerTick = 2;
+
     // ============ Events ============
 
     UPROPERTY(BlueprintAssignable, Category = "FloorTransition")
@@ -94,6 +121,17 @@ private:
     int32 TargetFloor = 0;
     bool bFloorGenerated = false;
 
+    /** The game mode is building TargetFloor; pumped with FloorBuildBudgetMs each tick */
+    bool bBuildingFloor = false;
+
+    /** The teardown has been asked for its GC pass this transition */
+    bool bTeardownRequested = false;
+
+    /** Async generation of TargetFloor, polled while Loading */
+    TSharedPtr<FFloorGenerationRequest, ESPMode::ThreadSafe> PendingFloor;
+
+    int32 LastPrecacheMisses = 0;
+
     void BeginFadeOut();
     void UpdateFadeOut(float DeltaTime);
     void BeginLoading();
@@ -102,6 +140,12 @@ private:
     void UpdateFadeIn(float DeltaTime);
     void FinishTransition();
 
+    /** Whether the old floor is destroyed and collected (or MaxTeardownWait ran out); requests the GC pass on first call */
+    bool IsTeardownDone();
+
+    /** Raise LoadProgress to Progress and broadcast it; the bar never moves backwards */
+    void ReportProgress(float Progress);
+
     /** Set screen fade via camera manager */
     void SetScreenFade(float Alpha);
 };
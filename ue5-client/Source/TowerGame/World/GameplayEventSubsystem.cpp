@@ -0,0 +1,68 @@
+#include "GameplayEventSubsystem.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+int32 FTowerGameplayEventBatch::GetNumKills(int32 FloorId) const
+{
+    for (const TPair<int32, int32>& Floor : KillsPerFloor)
+    {
+        if (Floor.Key == FloorId) return Floor.Value;
+    }
+    return 0;
+}
+
+void FTowerGameplayEventBatch::Reset()
+{
+    Kills.Reset();
+    Pickups.Reset();
+    FloorProgress.Reset();
+    KillsPerFloor.Reset();
+}
+
+void UTowerGameplayEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(
+        this, &UTowerGameplayEventSubsystem::HandlePostActorTick);
+}
+
+void UTowerGameplayEventSubsystem::Deinitialize()
+{
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+    PostActorTickHandle.Reset();
+    Pending.Reset();
+    OnEvents.Clear();
+    Super::Deinitialize();
+}
+
+bool UTowerGameplayEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTowerGameplayEventSubsystem::HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != GetWorld() || Pending.IsEmpty()) return;
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerGameplayEvents_Dispatch);
+
+    Swap(Pending, Dispatching);
+
+    // A batch rarely spans more than one floor, so a linear scan beats a map
+    for (const FTowerKillEvent& Kill : Dispatching.Kills)
+    {
+        TPair<int32, int32>* Floor = Dispatching.KillsPerFloor.FindByPredicate(
+            [&Kill](const TPair<int32, int32>& Entry) { return Entry.Key == Kill.FloorId; });
+        if (Floor)
+        {
+            ++Floor->Value;
+        }
+        else
+        {
+            Dispatching.KillsPerFloor.Emplace(Kill.FloorId, 1);
+        }
+    }
+
+    OnEvents.Broadcast(Dispatching);
+    Dispatching.Reset();
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/MonsterTags.h"
+#include "LootPickup.h"
+#include "GameplayEventSubsystem.generated.h"
+
+/** A monster died: an ATowerMonster actor or a horde record */
+struct FTowerKillEvent
+{
+    int32 FloorId = 0;
+    EMonsterElement Element = EMonsterElement::Neutral;
+    FVector Location = FVector::ZeroVector;
+};
+
+/** A player picked up an ALootPickup */
+struct FTowerPickupEvent
+{
+    TWeakObjectPtr<AActor> Collector;
+    FString ItemName;
+    ELootRarity Rarity = ELootRarity::Common;
+};
+
+enum class ETowerFloorProgress : uint8
+{
+    RoomDiscovered,
+    /** Every monster on the floor is dead */
+    Cleared,
+    PlayerDied,
+};
+
+struct FTowerFloorProgressEvent
+{
+    int32 FloorId = 0;
+    ETowerFloorProgress Kind = ETowerFloorProgress::RoomDiscovered;
+    /** Cleared: seconds since the floor loaded */
+    float Seconds = 0.0f;
+};
+
+/** One frame's gameplay events, in the order they were posted within each kind */
+struct FTowerGameplayEventBatch
+{
+    TArray<FTowerKillEvent> Kills;
+    TArray<FTowerPickupEvent> Pickups;
+    TArray<FTowerFloorProgressEvent> FloorProgress;
+
+    /** Kills summed per floor, for consumers that only count them */
+    TArray<TPair<int32, int32>, TInlineAllocator<2>> KillsPerFloor;
+
+    int32 GetNumKills(int32 FloorId) const;
+
+    bool IsEmpty() const { return Kills.Num() == 0 && Pickups.Num() == 0 && FloorProgress.Num() == 0; }
+
+    void Reset();
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTowerGameplayEvents, const FTowerGameplayEventBatch&);
+
+/**
+ * The world's gameplay event bus. Kills, pickups and floor progress are
+ * posted as they happen and handed out once per frame, after every actor and
+ * tickable has ticked, as one batch: a consumer (the GameMode's floor count,
+ * the tower map, analytics, quests, achievements) binds OnEvents once and
+ * gets a single call per frame however many events there were, so a 20-kill
+ * AoE is one update for each of them, not twenty.
+ *
+ * Events posted while a batch is being handed out go in the next frame's.
+ * Frames with no events broadcast nothing. Game thread only.
+ */
+UCLASS()
+class TOWERGAME_API UTowerGameplayEventSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    void PostKill(const FTowerKillEvent& Event) { Pending.Kills.Add(Event); }
+    void PostPickup(const FTowerPickupEvent& Event) { Pending.Pickups.Add(Event); }
+    void PostFloorProgress(const FTowerFloorProgressEvent& Event) { Pending.FloorProgress.Add(Event); }
+
+    /** This frame's batch, at end of frame */
+    FOnTowerGameplayEvents OnEvents;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    void HandlePostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+    FTowerGameplayEventBatch Pending;
+
+    /** The batch being broadcast; swapped with Pending so both keep their allocations */
+    FTowerGameplayEventBatch Dispatching;
+
+    FDelegateHandle PostActorTickHandle;
+};
@@ -1,23 +1,20 @@
 #include "Interactable.h"
+#include "ProximityQuerySubsystem.h"
 #include "Components/StaticMeshComponent.h"
-#include "Components/SphereComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Materials/MaterialInstanceDynamic.h"
-#include "GameFramework/Character.h"
+#include "GameFramework/Pawn.h"
 #include "Kismet/GameplayStatics.h"
+#include "Core/TowerGameMode.h"
 
 // ============ Base Interactable ============
 
 AInteractable::AInteractable()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Range comes from UProximityQuerySubsystem and the cooldown is a timestamp
+    PrimaryActorTick.bCanEverTick = false;
 
-    // Interaction zone
-    InteractionZone = CreateDefaultSubobject<USphereComponent>(TEXT("InteractionZone"));
-    InteractionZone->SetSphereRadius(InteractionRadius);
-    InteractionZone->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
-    InteractionZone->SetGenerateOverlapEvents(true);
-    RootComponent = InteractionZone;
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 
     // Visual mesh
     BaseMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BaseMesh"));
@@ -29,28 +26,32 @@ void AInteractable::BeginPlay()
 {
     Super::BeginPlay();
 
-    InteractionZone->SetSphereRadius(InteractionRadius);
-    InteractionZone->OnComponentBeginOverlap.AddDynamic(this, &AInteractable::OnOverlapBegin);
-    InteractionZone->OnComponentEndOverlap.AddDynamic(this, &AInteractable::OnOverlapEnd);
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        ProximityHandle = Proximity->Register(this, EProximityChannel::Interactable, InteractionRadius,
+            FOnProximityChanged::CreateUObject(this, &AInteractable::OnProximityChanged));
+    }
 }
 
-void AInteractable::Tick(float DeltaTime)
+void AInteractable::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime);
-
-    if (CooldownTimer > 0.0f)
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
     {
-        CooldownTimer -= DeltaTime;
+        Proximity->Unregister(ProximityHandle);
     }
+    ProximityHandle = INDEX_NONE;
+
+    Super::EndPlay(EndPlayReason);
 }
 
 bool AInteractable::TryInteract(AActor* Interactor)
 {
     if (!bPlayerInRange) return false;
-    if (CooldownTimer > 0.0f) return false;
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now < CooldownEndTime) return false;
     if (bSingleUse && bUsed) return false;
 
-    CooldownTimer = CooldownSeconds;
+    CooldownEndTime = Now + CooldownSeconds;
     bUsed = true;
 
     ExecuteInteraction(Interactor);
@@ -65,33 +66,19 @@ void AInteractable::ExecuteInteraction(AActor* Interactor)
         *GetName(), *Interactor->GetName());
 }
 
-void AInteractable::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
-    bool bFromSweep, const FHitResult& SweepResult)
+void AInteractable::OnProximityChanged(APawn* Player, bool bInRange)
 {
-    if (Cast<ACharacter>(OtherActor))
-    {
-        bPlayerInRange = true;
+    bPlayerInRange = bInRange;
 
-        // Visual highlight
-        if (UMaterialInstanceDynamic* Mat = Cast<UMaterialInstanceDynamic>(BaseMesh->GetMaterial(0)))
-        {
-            Mat->SetScalarParameterValue(TEXT("Highlight"), 1.0f);
-        }
+    // Visual highlight
+    if (UMaterialInstanceDynamic* Mat = Cast<UMaterialInstanceDynamic>(BaseMesh->GetMaterial(0)))
+    {
+        Mat->SetScalarParameterValue(TEXT("Highlight"), bInRange ? 1.0f : 0.0f);
     }
-}
 
-void AInteractable::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-    if (Cast<ACharacter>(OtherActor))
+    if (bInRange)
     {
-        bPlayerInRange = false;
-
-        if (UMaterialInstanceDynamic* Mat = Cast<UMaterialInstanceDynamic>(BaseMesh->GetMaterial(0)))
-        {
-            Mat->SetScalarParameterValue(TEXT("Highlight"), 0.0f);
-        }
+        OnPlayerEnteredRange(Player);
     }
 }
 
@@ -111,6 +98,20 @@ ATowerChest::ATowerChest()
     BaseMesh->SetWorldScale3D(FVector(0.8f, 0.6f, 0.5f));
 }
 
+void ATowerChest::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Opened on an earlier visit to this floor: come back open, without loot or events
+    ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this));
+    if (GM && GM->WasChestOpened(GetActorLocation()))
+    {
+        bOpened = true;
+        bUsed = true;
+        BaseMesh->SetWorldScale3D(FVector(0.8f, 0.6f, 0.2f));
+    }
+}
+
 void ATowerChest::ExecuteInteraction(AActor* Interactor)
 {
     if (bOpened) return;
@@ -119,6 +120,11 @@ void ATowerChest::ExecuteInteraction(AActor* Interactor)
     UE_LOG(LogTemp, Log, TEXT("Chest opened on floor %d by %s"),
         FloorLevel, *Interactor->GetName());
 
+    if (ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this)))
+    {
+        GM->RecordChestOpened(GetActorLocation());
+    }
+
     // Generate loot via Rust core (done through GameMode)
     // The GameMode listens to OnInteracted and calls GenerateLoot
 
@@ -176,3 +182,12 @@ void ATowerStairs::ExecuteInteraction(AActor* Interactor)
 
     // Floor transition handled by GameMode::GoToNextFloor/GoToPreviousFloor
 }
+
+void ATowerStairs::OnPlayerEnteredRange(AActor* Player)
+{
+    if (ATowerGameMode* GM = Cast<ATowerGameMode>(UGameplayStatics::GetGameMode(this)))
+    {
+        // Already-prefetched floors are a no-op
+        GM->PrefetchFloor(GM->CurrentFloorId + (bGoingUp ? 1 : -1));
+    }
+}
@@ -4,7 +4,6 @@
 #include "GameFramework/Actor.h"
 #include "Interactable.generated.h"
 
-class USphereComponent;
 class UStaticMeshComponent;
 class UWidgetComponent;
 
@@ -16,7 +15,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInteracted, AActor*, Interactor,
  * Subclasses: ATowerChest, ATowerShrine, ATowerStairs
  *
  * Features:
- * - Proximity detection (shows "Press E" prompt)
+ * - Proximity detection via UProximityQuerySubsystem (shows "Press E" prompt)
  * - Interaction cooldown
  * - Visual highlight when in range
  * - Blueprint-assignable interaction event
@@ -30,7 +29,7 @@ public:
     AInteractable();
 
     virtual void BeginPlay() override;
-    virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     /** Attempt interaction. Returns true if successful. */
     UFUNCTION(BlueprintCallable, Category = "Interaction")
@@ -67,28 +66,25 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
     UStaticMeshComponent* BaseMesh;
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-    USphereComponent* InteractionZone;
-
 protected:
     /** Override in subclasses for specific behavior */
     virtual void ExecuteInteraction(AActor* Interactor);
 
+    /** A player entered InteractionRadius */
+    virtual void OnPlayerEnteredRange(AActor* Player) {}
+
     UPROPERTY(BlueprintReadOnly, Category = "Interaction")
     bool bUsed = false;
 
 private:
     bool bPlayerInRange = false;
-    float CooldownTimer = 0.0f;
 
-    UFUNCTION()
-    void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
-        bool bFromSweep, const FHitResult& SweepResult);
+    /** World time the cooldown ends at */
+    double CooldownEndTime = 0.0;
+
+    int32 ProximityHandle = INDEX_NONE;
 
-    UFUNCTION()
-    void OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+    void OnProximityChanged(APawn* Player, bool bInRange);
 };
 
 // ============ Chest ============
@@ -107,6 +103,8 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Chest")
     bool bOpened = false;
 
+    virtual void BeginPlay() override;
+
 protected:
     virtual void ExecuteInteraction(AActor* Interactor) override;
 };
@@ -146,4 +144,7 @@ public:
 
 protected:
     virtual void ExecuteInteraction(AActor* Interactor) override;
+
+    /** Make sure the destination floor is prefetched before the player commits */
+    virtual void OnPlayerEnteredRange(AActor* Player) override;
 };
@@ -1,10 +1,12 @@
 #include "LootPickup.h"
+#include "LootPickupSubsystem.h"
+#include "GameplayEventSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SphereComponent.h"
 #include "Components/PointLightComponent.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Materials/MaterialInstanceDynamic.h"
-#include "Kismet/GameplayStatics.h"
+#include "Rendering/MaterialVariantSubsystem.h"
 #include "GameFramework/Character.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
@@ -12,7 +14,8 @@
 
 ALootPickup::ALootPickup()
 {
-    PrimaryActorTick.bCanEverTick = true;
+    // Driven by ULootPickupSubsystem
+    PrimaryActorTick.bCanEverTick = false;
 
     // Collection sphere (trigger)
     CollectionSphere = CreateDefaultSubobject<USphereComponent>(TEXT("CollectionSphere"));
@@ -46,7 +49,8 @@ void ALootPickup::BeginPlay()
 {
     Super::BeginPlay();
 
-    SpawnPosition = GetActorLocation();
+    // Float above ground; the material bobs it from here
+    AddActorWorldOffset(FVector(0.0f, 0.0f, 30.0f));
 
     // Setup overlap
     CollectionSphere->OnComponentBeginOverlap.AddDynamic(this, &ALootPickup::OnOverlapBegin);
@@ -54,69 +58,55 @@ void ALootPickup::BeginPlay()
     // Apply rarity visuals
     FLinearColor Color = GetRarityColor();
 
-    UMaterialInstanceDynamic* Mat = LootMesh->CreateAndSetMaterialInstanceDynamic(0);
+    // Colors are shared per rarity; motion differs per pickup, so it goes in custom primitive data
+    UTowerMaterialVariantSubsystem* Variants = GetWorld()->GetSubsystem<UTowerMaterialVariantSubsystem>();
+    UMaterialInstanceDynamic* Mat = Variants ? Variants->FindOrCreate(LootMesh->GetMaterial(0),
+        FName(TEXT("Rarity"), static_cast<int32>(Rarity)), [&Color](UMaterialInstanceDynamic& MID)
+        {
+            MID.SetVectorParameterValue(TEXT("BaseColor"), Color);
+            MID.SetVectorParameterValue(TEXT("EmissiveColor"), Color * 3.0f);
+        }) : nullptr;
     if (Mat)
     {
-        Mat->SetVectorParameterValue(TEXT("BaseColor"), Color);
-        Mat->SetVectorParameterValue(TEXT("EmissiveColor"), Color * 3.0f);
+        LootMesh->SetMaterial(0, Mat);
     }
+    LootMesh->SetScalarParameterForCustomPrimitiveData(TEXT("BobHeight"), BobHeight);
+    LootMesh->SetScalarParameterForCustomPrimitiveData(TEXT("BobSpeed"), BobSpeed);
+    LootMesh->SetScalarParameterForCustomPrimitiveData(TEXT("SpinSpeed"), RotateSpeed);
+    LootMesh->SetScalarParameterForCustomPrimitiveData(TEXT("SpawnTime"), GetWorld()->GetTimeSeconds());
 
     LootMesh->SetWorldScale3D(FVector(GetRarityScale() * 0.3f));
     RarityGlow->SetLightColor(Color.ToFColor(true));
     RarityGlow->SetIntensity(GetRarityGlowIntensity());
-}
-
-void ALootPickup::Tick(float DeltaTime)
-{
-    Super::Tick(DeltaTime);
-
-    if (bCollected) return;
-
-    TimeAlive += DeltaTime;
 
-    // Despawn check
-    if (TimeAlive >= DespawnTime)
+    if (ULootPickupSubsystem* Loot = GetWorld()->GetSubsystem<ULootPickupSubsystem>())
     {
-        Destroy();
-        return;
+        Loot->RegisterPickup(this);
     }
+}
 
-    // Bobbing
-    float BobOffset = FMath::Sin(TimeAlive * 3.0f) * BobHeight;
-    FVector NewPos = SpawnPosition;
-    NewPos.Z += BobOffset + 30.0f; // Float above ground
-
-    // Rotation
-    FRotator NewRot = GetActorRotation();
-    NewRot.Yaw += RotateSpeed * DeltaTime;
-
-    SetActorLocationAndRotation(NewPos, NewRot);
-
-    // Magnet: pull toward nearby player
-    ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
-    if (Player)
+void ALootPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (ULootPickupSubsystem* Loot = GetWorld()->GetSubsystem<ULootPickupSubsystem>())
     {
-        float Dist = FVector::Dist(GetActorLocation(), Player->GetActorLocation());
-        if (Dist < MagnetRadius && Dist > 10.0f)
-        {
-            FVector Dir = (Player->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-            float MagnetStrength = 1.0f - (Dist / MagnetRadius);
-            SpawnPosition += Dir * MagnetSpeed * MagnetStrength * DeltaTime;
-        }
+        Loot->UnregisterPickup(this);
     }
 
-    // Fade out glow in last 20% of lifetime
-    float LifeProgress = TimeAlive / DespawnTime;
-    if (LifeProgress > 0.8f && RarityGlow)
+    Super::EndPlay(EndPlayReason);
+}
+
+void ALootPickup::SetGlowFade(float Fade)
+{
+    if (RarityGlow)
     {
-        float Fade = (1.0f - LifeProgress) / 0.2f;
-        RarityGlow->SetIntensity(GetRarityGlowIntensity() * Fade);
+        RarityGlow->SetIntensity(GetRarityGlowIntensity() * FMath::Clamp(Fade, 0.0f, 1.0f));
     }
 }
 
 void ALootPickup::InitFromJson(const FString& LootJson)
 {
     LootDataJson = LootJson;
+    PendingDrop.Reset();
 
     TSharedPtr<FJsonObject> Json;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LootJson);
@@ -134,6 +124,46 @@ void ALootPickup::InitFromJson(const FString& LootJson)
     }
 }
 
+void ALootPickup::InitFromDrop(const FLootDropData& Drop)
+{
+    ItemName = Drop.Name;
+    // ItemRarity and ELootRarity list the same tiers in the same order
+    Rarity = Drop.Rarity <= static_cast<uint8>(ELootRarity::Mythic)
+        ? static_cast<ELootRarity>(Drop.Rarity) : ELootRarity::Common;
+
+    LootDataJson.Reset();
+    PendingDrop = Drop;
+}
+
+TArray<ALootPickup*> ALootPickup::SpawnDrops(UWorld* World, TConstArrayView<FLootDropData> Drops,
+    TConstArrayView<FVector> SourceLocations)
+{
+    TArray<ALootPickup*> Spawned;
+    if (!World) return Spawned;
+    Spawned.Reserve(Drops.Num());
+
+    int32 PreviousSource = INDEX_NONE;
+    int32 IndexInSource = 0;
+    for (const FLootDropData& Drop : Drops)
+    {
+        if (!SourceLocations.IsValidIndex(Drop.SourceIndex)) continue;
+
+        IndexInSource = Drop.SourceIndex == PreviousSource ? IndexInSource + 1 : 0;
+        PreviousSource = Drop.SourceIndex;
+
+        // Same spread as process_loot_drops: 0.5 m apart, half a metre up
+        const FVector Location = SourceLocations[Drop.SourceIndex] + FVector(IndexInSource * 50.0f, 0.0f, 50.0f);
+        ALootPickup* Pickup = World->SpawnActorDeferred<ALootPickup>(ALootPickup::StaticClass(),
+            FTransform(Location), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+        if (!Pickup) continue;
+
+        Pickup->InitFromDrop(Drop);
+        Pickup->FinishSpawning(FTransform(Location));
+        Spawned.Add(Pickup);
+    }
+    return Spawned;
+}
+
 void ALootPickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
     UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
     bool bFromSweep, const FHitResult& SweepResult)
@@ -145,10 +175,26 @@ void ALootPickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* Ot
 
     bCollected = true;
 
+    // No more magnet or despawn for this one
+    if (ULootPickupSubsystem* Loot = GetWorld()->GetSubsystem<ULootPickupSubsystem>())
+    {
+        Loot->UnregisterPickup(this);
+    }
+
     UE_LOG(LogTemp, Log, TEXT("Loot collected: %s (%s)"),
         *ItemName, *UEnum::GetValueAsString(Rarity));
 
+    if (PendingDrop.IsSet())
+    {
+        LootDataJson = PendingDrop->ToJson();
+        PendingDrop.Reset();
+    }
+
     OnLootCollected.Broadcast(OtherActor, LootDataJson);
+    if (UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>())
+    {
+        Events->PostPickup({ OtherActor, ItemName, Rarity });
+    }
 
     // Despawn after brief delay (for pickup VFX)
     SetLifeSpan(0.2f);
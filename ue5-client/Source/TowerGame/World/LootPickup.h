@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Bridge/ProceduralCoreBridge.h"
 #include "LootPickup.generated.h"
 
 class UStaticMeshComponent;
@@ -19,6 +20,14 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLootCollected, AActor*, Collecto
  * - Auto-magnet: pulls toward nearby player
  * - Despawn after timeout
  * - Overlap-based collection
+ *
+ * Pickups don't tick: ULootPickupSubsystem runs despawn, glow fade and magnet
+ * for all of them. Bob and spin are the material's job, in world position
+ * offset, from the scalar parameters BobHeight, BobSpeed (rad/s), SpinSpeed
+ * (deg/s) and SpawnTime (world seconds), e.g. height
+ * sin((Time - SpawnTime) * BobSpeed) * BobHeight and yaw (Time - SpawnTime) * SpinSpeed
+ * about the object pivot. Those four are custom primitive data, so every pickup
+ * of a rarity shares one material instance.
  */
 UENUM(BlueprintType)
 enum class ELootRarity : uint8
@@ -40,12 +49,23 @@ public:
     ALootPickup();
 
     virtual void BeginPlay() override;
-    virtual void Tick(float DeltaTime) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     /** Initialize from Rust loot JSON */
     UFUNCTION(BlueprintCallable, Category = "Loot")
     void InitFromJson(const FString& LootJson);
 
+    /** Initialize from a drop decoded by FProceduralCoreBridge::GenerateLootBatch, without JSON */
+    void InitFromDrop(const FLootDropData& Drop);
+
+    /**
+     * Spawn one pickup per drop near its source (SourceLocations is indexed by
+     * FLootDropData::SourceIndex), initialized before BeginPlay so the rarity
+     * visuals apply. Drops of one source are spread out like the Rust loot system does.
+     */
+    static TArray<ALootPickup*> SpawnDrops(UWorld* World, TConstArrayView<FLootDropData> Drops,
+        TConstArrayView<FVector> SourceLocations);
+
     // ============ Loot Data ============
 
     UPROPERTY(BlueprintReadOnly, Category = "Loot")
@@ -54,6 +74,7 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Loot")
     ELootRarity Rarity = ELootRarity::Common;
 
+    /** Rust loot JSON; for InitFromDrop pickups it is built when collected */
     UPROPERTY(BlueprintReadOnly, Category = "Loot")
     FString LootDataJson;
 
@@ -71,6 +92,9 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loot")
     float BobHeight = 15.0f;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loot")
+    float BobSpeed = 3.0f;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loot")
     float RotateSpeed = 90.0f;
 
@@ -90,11 +114,18 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Loot")
     UPointLightComponent* RarityGlow;
 
+    /** Scale the rarity glow (1 = full); ULootPickupSubsystem fades it out near despawn */
+    void SetGlowFade(float Fade);
+
+    /** Index of this pickup's slot in ULootPickupSubsystem */
+    int32 LootSlot = INDEX_NONE;
+
 private:
-    float TimeAlive = 0.0f;
-    FVector SpawnPosition;
     bool bCollected = false;
 
+    /** Set by InitFromDrop until LootDataJson has been built from it */
+    TOptional<FLootDropData> PendingDrop;
+
     UFUNCTION()
     void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
         UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
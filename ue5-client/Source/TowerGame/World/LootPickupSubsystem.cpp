@@ -0,0 +1,228 @@
+#include "LootPickupSubsystem.h"
+#include "LootPickup.h"
+#include "ProximityQuerySubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "Kismet/GameplayStatics.h"
+
+void ULootPickupSubsystem::Deinitialize()
+{
+    Pickups.Empty();
+    PosX.Empty();
+    PosY.Empty();
+    PosZ.Empty();
+    SpawnedAt.Empty();
+    DespawnAt.Empty();
+    MagnetRadius.Empty();
+    MagnetSpeed.Empty();
+    ProximityHandles.Empty();
+    FreeSlots.Empty();
+    NumLive = 0;
+    Super::Deinitialize();
+}
+
+bool ULootPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId ULootPickupSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(ULootPickupSubsystem, STATGROUP_Tickables);
+}
+
+// ============ Registration ============
+
+void ULootPickupSubsystem::RegisterPickup(ALootPickup* Pickup)
+{
+    if (!Pickup || Pickup->LootSlot != INDEX_NONE) return;
+
+    int32 Slot;
+    if (FreeSlots.Num() > 0)
+    {
+        Slot = FreeSlots.Pop(/*bAllowShrinking=*/false);
+    }
+    else
+    {
+        Slot = Pickups.AddDefaulted();
+        PosX.AddUninitialized();
+        PosY.AddUninitialized();
+        PosZ.AddUninitialized();
+        SpawnedAt.AddUninitialized();
+        DespawnAt.AddUninitialized();
+        MagnetRadius.AddUninitialized();
+        MagnetSpeed.AddUninitialized();
+        ProximityHandles.AddUninitialized();
+    }
+
+    const FVector Location = Pickup->GetActorLocation();
+    const double Now = GetWorld()->GetTimeSeconds();
+    Pickups[Slot] = Pickup;
+    PosX[Slot] = static_cast<float>(Location.X);
+    PosY[Slot] = static_cast<float>(Location.Y);
+    PosZ[Slot] = static_cast<float>(Location.Z);
+    SpawnedAt[Slot] = Now;
+    DespawnAt[Slot] = Now + Pickup->DespawnTime;
+    MagnetRadius[Slot] = Pickup->MagnetRadius;
+    MagnetSpeed[Slot] = Pickup->MagnetSpeed;
+    MaxMagnetRadius = FMath::Max(MaxMagnetRadius, Pickup->MagnetRadius);
+
+    UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>();
+    ProximityHandles[Slot] = Proximity ? Proximity->Register(Pickup, EProximityChannel::Loot, Pickup->MagnetRadius,
+        FOnProximityChanged(), Slot) : INDEX_NONE;
+
+    Pickup->LootSlot = Slot;
+    NumLive++;
+}
+
+void ULootPickupSubsystem::UnregisterPickup(ALootPickup* Pickup)
+{
+    if (!Pickup || !Pickups.IsValidIndex(Pickup->LootSlot)) return;
+
+    const int32 Slot = Pickup->LootSlot;
+    Pickup->LootSlot = INDEX_NONE;
+
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->Unregister(ProximityHandles[Slot]);
+    }
+    ProximityHandles[Slot] = INDEX_NONE;
+    Pickups[Slot].Reset();
+    FreeSlots.Add(Slot);
+    NumLive--;
+}
+
+// ============ Update ============
+
+void ULootPickupSubsystem::Tick(float DeltaTime)
+{
+    if (NumLive == 0) return;
+
+    UWorld* World = GetWorld();
+    UpdateLifetimes(World->GetTimeSeconds());
+
+    // One player lookup for every pickup
+    if (NumLive > 0)
+    {
+        if (ACharacter* Player = UGameplayStatics::GetPlayerCharacter(World, 0))
+        {
+            UpdateMagnets(Player->GetActorLocation(), DeltaTime);
+        }
+    }
+}
+
+void ULootPickupSubsystem::UpdateLifetimes(double Now)
+{
+    TimeSinceGlowFade += GetWorld()->GetDeltaSeconds();
+    const bool bFadeGlows = TimeSinceGlowFade >= GlowFadeInterval;
+    if (bFadeGlows)
+    {
+        TimeSinceGlowFade = 0.0f;
+    }
+
+    ExpiredScratch.Reset();
+    for (int32 Slot = 0; Slot < Pickups.Num(); Slot++)
+    {
+        if (DespawnAt[Slot] > Now)
+        {
+            if (bFadeGlows)
+            {
+                // Fade the glow over the last GlowFadeShare of the lifetime
+                const double Lifetime = DespawnAt[Slot] - SpawnedAt[Slot];
+                const double Remaining = DespawnAt[Slot] - Now;
+                if (Remaining < Lifetime * GlowFadeShare)
+                {
+                    if (ALootPickup* Pickup = Pickups[Slot].Get())
+                    {
+                        Pickup->SetGlowFade(static_cast<float>(Remaining / (Lifetime * GlowFadeShare)));
+                    }
+                }
+            }
+        }
+        else if (ALootPickup* Pickup = Pickups[Slot].Get())
+        {
+            ExpiredScratch.Add(Pickup);
+        }
+    }
+
+    // Destroying unregisters, so not while walking the slots
+    for (ALootPickup* Pickup : ExpiredScratch)
+    {
+        UnregisterPickup(Pickup);
+        Pickup->Destroy();
+    }
+}
+
+void ULootPickupSubsystem::UpdateMagnets(const FVector& PlayerLocation, float DeltaTime)
+{
+    const float PlayerX = static_cast<float>(PlayerLocation.X);
+    const float PlayerY = static_cast<float>(PlayerLocation.Y);
+    const float PlayerZ = static_cast<float>(PlayerLocation.Z);
+
+    UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>();
+    if (!Proximity) return;
+
+    // Slots the largest magnet can reach
+    HandleScratch.Reset();
+    Proximity->QueryRadius(PlayerLocation, MaxMagnetRadius, EProximityChannel::Loot, HandleScratch);
+    CandidateScratch.Reset();
+    for (int32 Handle : HandleScratch)
+    {
+        CandidateScratch.Add(Proximity->GetUserIndex(Handle));
+    }
+    if (CandidateScratch.Num() == 0) return;
+
+    // Gather offsets into lanes of four; padding lanes get a zero radius and never pass
+    const int32 Padded = Align(CandidateScratch.Num(), 4);
+    DxScratch.SetNumUninitialized(Padded, /*bAllowShrinking=*/false);
+    DyScratch.SetNumUninitialized(Padded, /*bAllowShrinking=*/false);
+    DzScratch.SetNumUninitialized(Padded, /*bAllowShrinking=*/false);
+    RadiusSqScratch.SetNumUninitialized(Padded, /*bAllowShrinking=*/false);
+    for (int32 i = 0; i < CandidateScratch.Num(); i++)
+    {
+        const int32 Slot = CandidateScratch[i];
+        DxScratch[i] = PlayerX - PosX[Slot];
+        DyScratch[i] = PlayerY - PosY[Slot];
+        DzScratch[i] = PlayerZ - PosZ[Slot];
+        RadiusSqScratch[i] = MagnetRadius[Slot] * MagnetRadius[Slot];
+    }
+    for (int32 i = CandidateScratch.Num(); i < Padded; i++)
+    {
+        DxScratch[i] = DyScratch[i] = DzScratch[i] = RadiusSqScratch[i] = 0.0f;
+    }
+
+    const VectorRegister4Float MinDistSq = VectorSetFloat1(MinMagnetDistance * MinMagnetDistance);
+    for (int32 Lane = 0; Lane < Padded; Lane += 4)
+    {
+        const VectorRegister4Float Dx = VectorLoad(&DxScratch[Lane]);
+        const VectorRegister4Float Dy = VectorLoad(&DyScratch[Lane]);
+        const VectorRegister4Float Dz = VectorLoad(&DzScratch[Lane]);
+        const VectorRegister4Float DistSq = VectorMultiplyAdd(Dz, Dz, VectorMultiplyAdd(Dy, Dy, VectorMultiply(Dx, Dx)));
+        const VectorRegister4Float InRange = VectorBitwiseAnd(
+            VectorCompareLT(DistSq, VectorLoad(&RadiusSqScratch[Lane])), VectorCompareGT(DistSq, MinDistSq));
+
+        int32 Mask = VectorMaskBits(InRange);
+        if (Mask == 0) continue; // Nothing in this group is being pulled
+
+        float DistSqLanes[4];
+        VectorStore(DistSq, DistSqLanes);
+        for (; Mask; Mask &= Mask - 1)
+        {
+            const int32 i = Lane + FMath::CountTrailingZeros(static_cast<uint32>(Mask));
+            const int32 Slot = CandidateScratch[i];
+            ALootPickup* Pickup = Pickups[Slot].Get();
+            if (!Pickup) continue;
+
+            // Same pull as before: stronger the closer it is
+            const float Dist = FMath::Sqrt(DistSqLanes[i - Lane]);
+            const float Strength = 1.0f - Dist / MagnetRadius[Slot];
+            const float Step = MagnetSpeed[Slot] * Strength * DeltaTime / Dist;
+            PosX[Slot] += DxScratch[i] * Step;
+            PosY[Slot] += DyScratch[i] * Step;
+            PosZ[Slot] += DzScratch[i] * Step;
+            const FVector Location(PosX[Slot], PosY[Slot], PosZ[Slot]);
+            Pickup->SetActorLocation(Location);
+            Proximity->UpdateLocation(ProximityHandles[Slot], Location);
+        }
+    }
+}
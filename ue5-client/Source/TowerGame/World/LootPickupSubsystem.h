@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LootPickupSubsystem.generated.h"
+
+class ALootPickup;
+
+/**
+ * Drives every ALootPickup from one batched tick, so a boss's worth of drops
+ * costs one player lookup and a handful of grid cells instead of 100+ actor ticks.
+ *
+ * Pickups live in stable slots of structure-of-arrays state (position, despawn
+ * time, magnet tuning); ALootPickup::LootSlot indexes them. They are also on the
+ * proximity grid's Loot channel, so the magnet only gets the slots around the
+ * player, and the distance tests over those candidates run four at a time.
+ *
+ * Idle bobbing and spinning are not done here: the pickup's material animates
+ * them in world position offset (see ALootPickup), so idle loot never moves its
+ * transform. Only magnet pulls write actor locations.
+ */
+UCLASS()
+class TOWERGAME_API ULootPickupSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ============ Registration ============
+
+    void RegisterPickup(ALootPickup* Pickup);
+    void UnregisterPickup(ALootPickup* Pickup);
+
+    int32 GetNumPickups() const { return NumLive; }
+
+    // ============ Config ============
+
+    /** Seconds between glow fade updates for expiring pickups */
+    float GlowFadeInterval = 0.1f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Share of the lifetime, at the end, over which the glow fades out */
+    static constexpr float GlowFadeShare = 0.2f;
+
+    /** Pulls stop this close, so a pickup on the player doesn't jitter */
+    static constexpr float MinMagnetDistance = 10.0f;
+
+    void UpdateLifetimes(double Now);
+    void UpdateMagnets(const FVector& PlayerLocation, float DeltaTime);
+
+    // Per slot; a free slot has a null Pickup
+    TArray<TWeakObjectPtr<ALootPickup>> Pickups;
+    TArray<float> PosX;
+    TArray<float> PosY;
+    TArray<float> PosZ;
+    TArray<double> SpawnedAt;
+    TArray<double> DespawnAt;
+    TArray<float> MagnetRadius;
+    TArray<float> MagnetSpeed;
+    TArray<int32> ProximityHandles;
+    TArray<int32> FreeSlots;
+    int32 NumLive = 0;
+
+    /** Largest MagnetRadius registered, the radius the magnet queries */
+    float MaxMagnetRadius = 0.0f;
+
+    float TimeSinceGlowFade = 0.0f;
+
+    // Reused per tick
+    TArray<int32> HandleScratch;
+    TArray<int32> CandidateScratch;
+    TArray<float> DxScratch;
+    TArray<float> DyScratch;
+    TArray<float> DzScratch;
+    TArray<float> RadiusSqScratch;
+    TArray<ALootPickup*> ExpiredScratch;
+};
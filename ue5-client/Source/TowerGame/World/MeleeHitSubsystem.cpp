@@ -0,0 +1,297 @@
+#include "MeleeHitSubsystem.h"
+#include "MonsterSpawner.h"
+#include "ProximityQuerySubsystem.h"
+#include "Core/TowerGameSubsystem.h"
+#include "Core/MonsterTags.h"
+#include "Bridge/ProceduralCoreBridge.h"
+#include "Network/MatchConnection.h"
+#include "Network/StateSynchronizer.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+static TAutoConsoleVariable<int32> CVarMeleeOcclusion(
+    TEXT("tower.Melee.Occlusion"),
+    1,
+    TEXT("Trace from each melee sweep to its targets so walls block hits. 0 = off, 1 = on"),
+    ECVF_Default);
+
+void UTowerMeleeHitSubsystem::Deinitialize()
+{
+    Queued.Empty();
+    InFlightSweeps.Empty();
+    InFlight.Empty();
+    Super::Deinitialize();
+}
+
+bool UTowerMeleeHitSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerMeleeHitSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerMeleeHitSubsystem, STATGROUP_Tickables);
+}
+
+void UTowerMeleeHitSubsystem::QueueSweep(const FTowerMeleeSweep& Sweep)
+{
+    if (Sweep.Radius <= 0.0f || Sweep.MaxTargets <= 0) return;
+    Queued.Add(Sweep);
+}
+
+void UTowerMeleeHitSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Last frame's traces are only readable this frame, so resolve before submitting more
+    if (InFlight.Num() > 0)
+    {
+        ResolveInFlight();
+    }
+    if (Queued.Num() > 0)
+    {
+        SubmitQueued();
+    }
+}
+
+// ============ Submit ============
+
+void UTowerMeleeHitSubsystem::SubmitQueued()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerMeleeHit_Submit);
+
+    UWorld* World = GetWorld();
+    UProximityQuerySubsystem* Proximity = World->GetSubsystem<UProximityQuerySubsystem>();
+    if (!Proximity)
+    {
+        Queued.Reset();
+        return;
+    }
+
+    const bool bOcclusion = CVarMeleeOcclusion.GetValueOnGameThread() != 0;
+    const FCollisionObjectQueryParams WallQuery(ECC_WorldStatic);
+
+    InFlightSweeps = MoveTemp(Queued);
+    Queued.Reset();
+
+    for (int32 SweepIndex = 0; SweepIndex < InFlightSweeps.Num(); ++SweepIndex)
+    {
+        const FTowerMeleeSweep& Sweep = InFlightSweeps[SweepIndex];
+        const FVector Forward = Sweep.Forward.GetSafeNormal2D();
+        const bool bAllRound = Sweep.ArcDegrees >= 360.0f || Forward.IsNearlyZero();
+        const float MinDot = FMath::Cos(FMath::DegreesToRadians(Sweep.ArcDegrees * 0.5f));
+
+        HandleScratch.Reset();
+        Proximity->QueryRadius(Sweep.Origin, Sweep.Radius, EProximityChannel::Monster, HandleScratch);
+
+        TargetScratch.Reset();
+        for (const int32 Handle : HandleScratch)
+        {
+            ATowerMonster* Monster = Cast<ATowerMonster>(Proximity->GetActor(Handle));
+            if (!Monster || !Monster->bIsAlive || Monster == Sweep.Instigator.Get()) continue;
+
+            const FVector ToTarget = Proximity->GetLocation(Handle) - Sweep.Origin;
+            if (!bAllRound && (ToTarget.GetSafeNormal2D() | Forward) < MinDot) continue;
+
+            TargetScratch.Emplace(ToTarget.SizeSquared(), Monster);
+        }
+
+        if (TargetScratch.Num() > Sweep.MaxTargets)
+        {
+            TargetScratch.Sort([](const TPair<float, ATowerMonster*>& A, const TPair<float, ATowerMonster*>& B)
+            {
+                return A.Key < B.Key;
+            });
+            TargetScratch.SetNum(Sweep.MaxTargets);
+        }
+
+        FCollisionQueryParams Params(SCENE_QUERY_STAT(TowerMeleeOcclusion), false, Sweep.Instigator.Get());
+        for (const TPair<float, ATowerMonster*>& Target : TargetScratch)
+        {
+            FCandidate& Candidate = InFlight.AddDefaulted_GetRef();
+            Candidate.Sweep = SweepIndex;
+            Candidate.Target = Target.Value;
+            if (bOcclusion)
+            {
+                Candidate.Trace = World->AsyncLineTraceByObjectType(EAsyncTraceType::Single,
+                    Sweep.Origin, Target.Value->GetActorLocation(), WallQuery, Params);
+            }
+        }
+    }
+}
+
+// ============ Resolve ============
+
+uint32 UTowerMeleeHitSubsystem::GetAngleId(const ATowerMonster& Target, const FVector& AttackerLocation)
+{
+    const FVector ToAttacker = (AttackerLocation - Target.GetActorLocation()).GetSafeNormal2D();
+    const float Dot = Target.GetActorForwardVector().GetSafeNormal2D() | ToAttacker;
+    if (Dot > 0.5f) return 0;
+    if (Dot < -0.5f) return 2;
+    return 1;
+}
+
+const UTowerStateSynchronizer* UTowerMeleeHitSubsystem::FindStateSynchronizer(const AActor* Instigator)
+{
+    const APawn* Pawn = Cast<APawn>(Instigator);
+    const AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+    if (const UTowerStateSynchronizer* Sync = Controller ? Controller->FindComponentByClass<UTowerStateSynchronizer>() : nullptr)
+    {
+        return Sync;
+    }
+
+    const AGameModeBase* GameMode = Instigator ? Instigator->GetWorld()->GetAuthGameMode() : nullptr;
+    return GameMode ? GameMode->FindComponentByClass<UTowerStateSynchronizer>() : nullptr;
+}
+
+void UTowerMeleeHitSubsystem::ResolveInFlight()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerMeleeHit_Resolve);
+
+    UWorld* World = GetWorld();
+
+    TArray<FCombatBatchRequest> Requests;
+    TArray<int32> RequestTargets;
+    TArray<ATowerMonster*> Targets;
+    TArray<int32> TargetSweeps;
+    TArray<float> TargetDamage;
+    Requests.Reserve(InFlight.Num());
+    RequestTargets.Reserve(InFlight.Num());
+    Targets.Reserve(InFlight.Num());
+    TargetSweeps.Reserve(InFlight.Num());
+    TargetDamage.Reserve(InFlight.Num());
+
+    // One tag set per distinct attacker tag list and per defender element, shared across the batch
+    TArray<FString> TagSets;
+    TMap<FString, uint32> AttackerTagSets;
+    uint32 ElementTagSets[static_cast<int32>(EMonsterElement::Count)];
+    for (uint32& TagSet : ElementTagSets) TagSet = CombatBatchNoTags;
+
+    for (const FCandidate& Candidate : InFlight)
+    {
+        ATowerMonster* Target = Candidate.Target.Get();
+        if (!Target || !Target->bIsAlive) continue;
+
+        if (World->IsTraceHandleValid(Candidate.Trace, false))
+        {
+            FTraceDatum Datum;
+            if (World->QueryTraceData(Candidate.Trace, Datum)
+                && Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; }))
+            {
+                continue;
+            }
+        }
+
+        const FTowerMeleeSweep& Sweep = InFlightSweeps[Candidate.Sweep];
+        const uint32 AngleId = GetAngleId(*Target, Sweep.Origin);
+        const EMonsterElement Element = TowerMonsterTags::SanitizeElement(static_cast<uint8>(Target->Element));
+
+        Targets.Add(Target);
+        TargetSweeps.Add(Candidate.Sweep);
+
+        // No tags on either side: the attacker's memoized damage is what the batch would return
+        if (Sweep.bHasAngleDamage && Sweep.AttackerTagsJson.IsEmpty() && Element == EMonsterElement::Neutral)
+        {
+            TargetDamage.Add(Sweep.AngleDamage[AngleId]);
+            continue;
+        }
+        TargetDamage.Add(0.0f);
+        RequestTargets.Add(Targets.Num() - 1);
+
+        FCombatBatchRequest& Request = Requests.AddDefaulted_GetRef();
+        Request.BaseDamage = Sweep.BaseDamage;
+        Request.AngleId = AngleId;
+        Request.ComboStep = static_cast<uint32>(FMath::Max(Sweep.ComboStep, 0));
+
+        if (!Sweep.AttackerTagsJson.IsEmpty())
+        {
+            if (const uint32* Existing = AttackerTagSets.Find(Sweep.AttackerTagsJson))
+            {
+                Request.AttackerTagSet = *Existing;
+            }
+            else
+            {
+                Request.AttackerTagSet = TagSets.Add(Sweep.AttackerTagsJson);
+                AttackerTagSets.Add(Sweep.AttackerTagsJson, Request.AttackerTagSet);
+            }
+        }
+
+        if (Element != EMonsterElement::Neutral)
+        {
+            uint32& ElementTagSet = ElementTagSets[static_cast<int32>(Element)];
+            if (ElementTagSet == CombatBatchNoTags)
+            {
+                ElementTagSet = TagSets.Add(FString::Printf(TEXT("[[\"%s\",1.0]]"),
+                    *FString(TowerMonsterTags::ToString(Element)).ToLower()));
+            }
+            Request.DefenderTagSet = ElementTagSet;
+        }
+    }
+
+    UGameInstance* GI = World->GetGameInstance();
+    TArray<FCombatBatchResult> Results;
+    if (Requests.Num() > 0)
+    {
+        UTowerGameSubsystem* Sub = GI ? GI->GetSubsystem<UTowerGameSubsystem>() : nullptr;
+        FProceduralCoreBridge* Bridge = Sub && Sub->IsRustCoreReady() ? Sub->GetBridge() : nullptr;
+        if (!Bridge || !Bridge->CalculateCombatBatch(Requests, TagSets, Results) || Results.Num() != Requests.Num())
+        {
+            // Fallback: simple combo multiplier
+            Results.SetNum(Requests.Num());
+            for (int32 i = 0; i < Requests.Num(); ++i)
+            {
+                Results[i] = FCombatBatchResult();
+                Results[i].FinalDamage = Requests[i].BaseDamage * (1.0f + Requests[i].ComboStep * 0.15f);
+            }
+        }
+        for (int32 i = 0; i < Requests.Num(); ++i)
+        {
+            TargetDamage[RequestTargets[i]] = Results[i].FinalDamage;
+        }
+    }
+
+    // In a match the server owns monster HP, so hits are sent rather than applied
+    UMatchConnection* Match = GI ? GI->GetSubsystem<UMatchConnection>() : nullptr;
+    const bool bInMatch = Match && Match->IsConnected();
+
+    for (int32 i = 0; i < Targets.Num(); ++i)
+    {
+        ATowerMonster* Target = Targets[i];
+        const FTowerMeleeSweep& Sweep = InFlightSweeps[TargetSweeps[i]];
+
+        // An earlier hit in the batch may have finished it
+        if (!Target->bIsAlive) continue;
+
+        // Monsters the match didn't spawn (MatchMonsterId 0) only exist here, so they take the hit locally
+        if (bInMatch && Target->MatchMonsterId > 0)
+        {
+            const UTowerStateSynchronizer* Sync = FindStateSynchronizer(Sweep.Instigator.Get());
+            const double RenderTime = Sync ? Sync->GetRenderTime() : 0.0;
+
+            // Only entities the synchronizer replicates can be rewound; the rest go to the server unchecked
+            FMonsterStateSnapshot View;
+            if (Sync && Sync->GetMonsterView(Target->MatchMonsterId, View)
+                && !Sync->ValidateHit(Target->MatchMonsterId, Sweep.Origin, Sweep.Radius, RenderTime))
+            {
+                continue;
+            }
+
+            // The server applies the angle and combo multipliers itself, so it takes the base
+            Match->SendAttack(Target->MatchMonsterId, Sweep.BaseDamage,
+                static_cast<int32>(GetAngleId(*Target, Sweep.Origin)), Sweep.ComboStep, RenderTime);
+        }
+        else
+        {
+            Target->TakeDamageFromPlayer(TargetDamage[i]);
+        }
+        OnMeleeHit.Broadcast(Sweep.Instigator.Get(), Target, TargetDamage[i]);
+    }
+
+    InFlight.Reset();
+    InFlightSweeps.Reset();
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "MeleeHitSubsystem.generated.h"
+
+class ATowerMonster;
+class UTowerStateSynchronizer;
+
+/** One attack shape for the next hit batch: a combo swing's arc or an ability's AoE */
+struct FTowerMeleeSweep
+{
+    TWeakObjectPtr<AActor> Instigator;
+    FVector Origin = FVector::ZeroVector;
+    /** Facing the arc is centred on; only its horizontal part is used */
+    FVector Forward = FVector::ForwardVector;
+    float Radius = 250.0f;
+    /** Full width of the arc; 360 hits all round (AoE) */
+    float ArcDegrees = 120.0f;
+
+    /** Before angle and combo multipliers (crit already applied) */
+    float BaseDamage = 0.0f;
+    int32 ComboStep = 0;
+
+    /**
+     * Final damage by angle id (0=Front, 1=Side, 2=Back), crit applied, when the
+     * attacker already has it memoized; used for targets with no element tags,
+     * which then skip the combat batch. Ignored unless bHasAngleDamage.
+     */
+    float AngleDamage[3] = { 0.0f, 0.0f, 0.0f };
+    bool bHasAngleDamage = false;
+
+    /** Attacker semantic tags as the core takes them, e.g. [["fire",0.8]]; empty = none */
+    FString AttackerTagsJson;
+
+    /** Nearest targets first, at most this many */
+    int32 MaxTargets = 8;
+};
+
+/** A batch resolved: Damage (before the target's defense) was dealt to Target, or sent to the match server for it */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnTowerMeleeHit, AActor* /*Instigator*/, ATowerMonster* /*Target*/, float /*Damage*/);
+
+/**
+ * Resolves melee hits in one batch per frame instead of a trace and an FFI call
+ * per swing. Attacks queue their sweep shapes; on the next tick every queued
+ * sweep takes its candidates from the proximity grid's Monster channel (radius
+ * and arc, no collision) and submits one async line trace per candidate
+ * against static geometry, so walls still block. A frame later the trace
+ * results are read, the unblocked hits of every sweep go to the core in a
+ * single CalculateCombatBatch call, and damage is applied. In a match the
+ * server owns monster HP: each hit goes out through UMatchConnection::SendAttack
+ * instead, after a lag-compensated UTowerStateSynchronizer::ValidateHit check.
+ *
+ * Hits therefore land one frame after the swing. A multi-hit ability queues a
+ * sweep per hit; each hits a target at most once. Pooled horde records aren't
+ * actors on the grid and aren't hit here.
+ */
+UCLASS()
+class TOWERGAME_API UTowerMeleeHitSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Add a sweep to the batch submitted on the next tick */
+    void QueueSweep(const FTowerMeleeSweep& Sweep);
+
+    int32 GetNumQueued() const { return Queued.Num(); }
+    int32 GetNumInFlight() const { return InFlight.Num(); }
+
+    /** Broadcast per hit, after damage is applied or sent */
+    FOnTowerMeleeHit OnMeleeHit;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** A target inside a submitted sweep, waiting on its occlusion trace */
+    struct FCandidate
+    {
+        int32 Sweep = INDEX_NONE;
+        TWeakObjectPtr<ATowerMonster> Target;
+        FTraceHandle Trace;
+    };
+
+    /** Broad phase and trace submission for every queued sweep */
+    void SubmitQueued();
+
+    /** Read last frame's traces and deal the damage in one combat batch */
+    void ResolveInFlight();
+
+    /** 0=Front, 1=Side, 2=Back, from where the attacker stands relative to Target's facing */
+    static uint32 GetAngleId(const ATowerMonster& Target, const FVector& AttackerLocation);
+
+    /** The synchronizer on the instigator's controller or the game mode, as ATowerPlayerCharacter finds it */
+    static const UTowerStateSynchronizer* FindStateSynchronizer(const AActor* Instigator);
+
+    TArray<FTowerMeleeSweep> Queued;
+
+    /** Sweeps submitted last tick; FCandidate::Sweep indexes them */
+    TArray<FTowerMeleeSweep> InFlightSweeps;
+    TArray<FCandidate> InFlight;
+
+    // Reused per tick
+    TArray<int32> HandleScratch;
+    TArray<TPair<float, ATowerMonster*>> TargetScratch;
+};
@@ -0,0 +1,327 @@
+#include "MonsterAISubsystem.h"
+#include "MonsterSpawner.h"
+#include "ProximityQuerySubsystem.h"
+#include "SignificanceSubsystem.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Engine/World.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+    /** FFloorMonsterData::Speed is metres a second, as the horde simulates it */
+    constexpr float MonsterSpeedToUnits = 100.0f;
+
+    /** A monster that hasn't thought for this long moves no further than this much time */
+    constexpr double MaxThinkDelta = 0.5;
+
+    constexpr float PathPurgeInterval = 1.0f;
+}
+
+void UTowerMonsterAISubsystem::Deinitialize()
+{
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        for (const TPair<uint64, FSharedPath>& Pair : Paths)
+        {
+            if (Pair.Value.bPending)
+            {
+                NavSys->AbortAsyncFindPathRequest(Pair.Value.QueryId);
+            }
+        }
+    }
+
+    for (FAgent& Agent : Agents)
+    {
+        if (ATowerMonster* Monster = Agent.Monster.Get())
+        {
+            Monster->AISlot = INDEX_NONE;
+        }
+    }
+    Agents.Empty();
+    Paths.Empty();
+    NumQueriesInFlight = 0;
+    Super::Deinitialize();
+}
+
+bool UTowerMonsterAISubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerMonsterAISubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerMonsterAISubsystem, STATGROUP_Tickables);
+}
+
+// ============ Registration ============
+
+void UTowerMonsterAISubsystem::Register(ATowerMonster* Monster)
+{
+    if (!Monster || Monster->AISlot != INDEX_NONE) return;
+
+    Monster->AISlot = Agents.Num();
+    FAgent& Agent = Agents.AddDefaulted_GetRef();
+    Agent.Monster = Monster;
+    Agent.Home = Monster->GetActorLocation();
+    // Spread a pack registered together over the idle slice
+    Agent.LastThinkFrame = Frame - (Monster->AISlot % FMath::Max(IdleFrames, 1));
+    Agent.ThinkFrames = IdleFrames;
+}
+
+void UTowerMonsterAISubsystem::Unregister(ATowerMonster* Monster)
+{
+    if (!Monster || !Agents.IsValidIndex(Monster->AISlot)) return;
+
+    const int32 Slot = Monster->AISlot;
+    Monster->AISlot = INDEX_NONE;
+    Agents.RemoveAtSwap(Slot, 1, /*bAllowShrinking=*/false);
+    if (Agents.IsValidIndex(Slot))
+    {
+        if (ATowerMonster* Moved = Agents[Slot].Monster.Get())
+        {
+            Moved->AISlot = Slot;
+        }
+    }
+}
+
+int32 UTowerMonsterAISubsystem::GetNumEngaged() const
+{
+    int32 Count = 0;
+    for (const FAgent& Agent : Agents)
+    {
+        Count += Agent.Target.IsValid() ? 1 : 0;
+    }
+    return Count;
+}
+
+// ============ Think ============
+
+void UTowerMonsterAISubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerMonsterAI_Tick);
+
+    ++Frame;
+    QueriesThisFrame = 0;
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    TimeSincePathPurge += DeltaTime;
+    if (TimeSincePathPurge >= PathPurgeInterval)
+    {
+        TimeSincePathPurge = 0.0f;
+        const double Expiry = PathLifetime * 2.0;
+        for (auto It = Paths.CreateIterator(); It; ++It)
+        {
+            if (!It.Value().bPending && Now - It.Value().CreatedAt > Expiry)
+            {
+                It.RemoveCurrent();
+            }
+        }
+    }
+
+    const int32 NumAgents = Agents.Num();
+    if (NumAgents == 0) return;
+
+    // Round robin from where the budget ran out last frame, so nobody waits twice
+    Cursor %= NumAgents;
+    int32 Thinks = 0;
+    int32 Visited = 0;
+    for (; Visited < NumAgents && Thinks < MaxThinksPerFrame; ++Visited)
+    {
+        FAgent& Agent = Agents[(Cursor + Visited) % NumAgents];
+        if (Frame - Agent.LastThinkFrame < static_cast<uint64>(Agent.ThinkFrames)) continue;
+
+        ATowerMonster* Monster = Agent.Monster.Get();
+        if (!Monster) continue;
+
+        Think(Agent, *Monster, Now);
+        ++Thinks;
+    }
+    Cursor = (Cursor + Visited) % NumAgents;
+}
+
+void UTowerMonsterAISubsystem::Think(FAgent& Agent, ATowerMonster& Monster, double Now)
+{
+    UWorld* World = GetWorld();
+    const double DeltaTime = Agent.LastThinkTime > 0.0 ? FMath::Min(Now - Agent.LastThinkTime, MaxThinkDelta) : 0.0;
+    Agent.LastThinkFrame = Frame;
+    Agent.LastThinkTime = Now;
+
+    const FVector Location = Monster.GetActorLocation();
+    const UProximityQuerySubsystem* Proximity = World->GetSubsystem<UProximityQuerySubsystem>();
+    AActor* Target = Proximity ? Proximity->FindNearest(Location, AggroDistance, EProximityChannel::Player) : nullptr;
+    Agent.Target = Target;
+
+    const FVector Goal = Target ? Target->GetActorLocation() : Agent.Home;
+    const double StopDistance = Target ? ChaseStopDistance : 1.0;
+    const double Distance = FVector::Dist2D(Location, Goal);
+
+    const bool bMoving = Distance > StopDistance;
+    if (bMoving && DeltaTime > 0.0)
+    {
+        const FVector Next = Steer(Agent, Location, Goal, Now);
+        const FVector Direction = FVector(Next.X - Location.X, Next.Y - Location.Y, 0.0).GetSafeNormal();
+        if (!Direction.IsNearlyZero())
+        {
+            const double Step = FMath::Min(static_cast<double>(Monster.Speed * MonsterSpeedToUnits) * DeltaTime, Distance - StopDistance);
+            Monster.SetActorLocationAndRotation(Location + Direction * Step, FRotator(0.0, Direction.Rotation().Yaw, 0.0));
+            Monster.UpdateProximity(true);
+        }
+    }
+    else if (!bMoving)
+    {
+        Agent.PathKey = 0;
+        Agent.PathPoint = INDEX_NONE;
+    }
+
+    ETowerSignificance Significance = ETowerSignificance::Near;
+    if (const UTowerSignificanceSubsystem* SignificanceSub = World->GetSubsystem<UTowerSignificanceSubsystem>())
+    {
+        Significance = SignificanceSub->GetSignificance(&Monster);
+    }
+
+    if (Significance == ETowerSignificance::Dormant)
+    {
+        Agent.ThinkFrames = DormantFrames;
+    }
+    else if (!bMoving)
+    {
+        Agent.ThinkFrames = IdleFrames;
+    }
+    else if (Significance == ETowerSignificance::Near || Significance == ETowerSignificance::Visible)
+    {
+        Agent.ThinkFrames = 1;
+    }
+    else
+    {
+        Agent.ThinkFrames = EngagedDistantFrames;
+    }
+    Agent.ThinkFrames = FMath::Max(Agent.ThinkFrames, 1);
+}
+
+// ============ Paths ============
+
+uint64 UTowerMonsterAISubsystem::GetPathKey(const FVector& Start, const FVector& Goal) const
+{
+    const float InvCell = 1.0f / FMath::Max(PathCellSize, 1.0f);
+    const uint16 StartX = static_cast<uint16>(FMath::FloorToInt32(Start.X * InvCell));
+    const uint16 StartY = static_cast<uint16>(FMath::FloorToInt32(Start.Y * InvCell));
+    const uint16 GoalX = static_cast<uint16>(FMath::FloorToInt32(Goal.X * InvCell));
+    const uint16 GoalY = static_cast<uint16>(FMath::FloorToInt32(Goal.Y * InvCell));
+    return static_cast<uint64>(StartX) | (static_cast<uint64>(StartY) << 16)
+        | (static_cast<uint64>(GoalX) << 32) | (static_cast<uint64>(GoalY) << 48);
+}
+
+FVector UTowerMonsterAISubsystem::Steer(FAgent& Agent, const FVector& Location, const FVector& Goal, double Now)
+{
+    const uint64 Key = GetPathKey(Location, Goal);
+
+    // Same cell as the goal: nothing to path around at this scale
+    if (static_cast<uint32>(Key) == static_cast<uint32>(Key >> 32))
+    {
+        Agent.PathKey = 0;
+        Agent.PathPoint = INDEX_NONE;
+        return Goal;
+    }
+
+    // Keep following the path we're on until it runs out or goes stale, even across cells
+    FSharedPath* Path = Agent.PathKey != 0 ? Paths.Find(Agent.PathKey) : nullptr;
+    if (!Path || (!Path->bPending && Now - Path->CreatedAt > PathLifetime)
+        || (Path->Points.Num() > 0 && Agent.PathPoint >= Path->Points.Num()))
+    {
+        Agent.PathPoint = INDEX_NONE;
+        Path = Paths.Find(Key);
+        if (!Path || (!Path->bPending && Now - Path->CreatedAt > PathLifetime))
+        {
+            Path = RequestPath(Key, Location, Goal, Now) ? Paths.Find(Key) : nullptr;
+        }
+        Agent.PathKey = Path ? Key : 0;
+    }
+
+    if (!Path || Path->Points.Num() < 2)
+    {
+        return Goal;
+    }
+
+    if (Agent.PathPoint == INDEX_NONE || Agent.PathRevision != Path->Revision)
+    {
+        // A shared path starts where its first asker stood: join it at the nearest point ahead
+        Agent.PathRevision = Path->Revision;
+        Agent.PathPoint = 1;
+        double BestSq = TNumericLimits<double>::Max();
+        for (int32 i = 1; i < Path->Points.Num(); ++i)
+        {
+            const double DistSq = FVector::DistSquared2D(Location, Path->Points[i]);
+            if (DistSq < BestSq)
+            {
+                BestSq = DistSq;
+                Agent.PathPoint = i;
+            }
+        }
+    }
+
+    const double ReachedSq = FMath::Square(PathPointRadius);
+    while (Agent.PathPoint < Path->Points.Num() && FVector::DistSquared2D(Location, Path->Points[Agent.PathPoint]) < ReachedSq)
+    {
+        ++Agent.PathPoint;
+    }
+
+    // Past the last point the target has moved on from where the path ends: head for it
+    return Agent.PathPoint < Path->Points.Num() ? Path->Points[Agent.PathPoint] : Goal;
+}
+
+bool UTowerMonsterAISubsystem::RequestPath(uint64 Key, const FVector& Start, const FVector& Goal, double Now)
+{
+    if (QueriesThisFrame >= MaxPathQueriesPerFrame) return false;
+
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+
+    FSharedPath& Path = Paths.FindOrAdd(Key);
+    Path.CreatedAt = Now;
+    if (!NavData)
+    {
+        // No navmesh on this floor: an empty path, so askers steer straight until it expires
+        Path.Points.Reset();
+        ++Path.Revision;
+        return true;
+    }
+
+    FPathFindingQuery Query(this, *NavData, Start, Goal, UNavigationQueryFilter::GetQueryFilter(*NavData, this, nullptr));
+    const uint32 QueryId = NavSys->FindPathAsync(NavData->GetConfig(), Query,
+        FNavPathQueryDelegate::CreateUObject(this, &UTowerMonsterAISubsystem::OnPathFound, Key), EPathFindingMode::Regular);
+    if (QueryId == INVALID_NAVQUERYID)
+    {
+        Path.Points.Reset();
+        ++Path.Revision;
+        return true;
+    }
+
+    // Followers of the old points keep them until the new ones arrive
+    Path.QueryId = QueryId;
+    Path.bPending = true;
+    ++QueriesThisFrame;
+    ++NumQueriesInFlight;
+    return true;
+}
+
+void UTowerMonsterAISubsystem::OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath, uint64 Key)
+{
+    NumQueriesInFlight = FMath::Max(NumQueriesInFlight - 1, 0);
+
+    FSharedPath* Path = Paths.Find(Key);
+    if (!Path || !Path->bPending || Path->QueryId != QueryId) return;
+
+    Path->bPending = false;
+    Path->CreatedAt = GetWorld()->GetTimeSeconds();
+    ++Path->Revision;
+    Path->Points.Reset();
+    if (Result == ENavigationQueryResult::Success && NavPath.IsValid())
+    {
+        for (const FNavPathPoint& Point : NavPath->GetPathPoints())
+        {
+            Path->Points.Add(Point.Location);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NavigationData.h"
+#include "MonsterAISubsystem.generated.h"
+
+class ATowerMonster;
+
+/**
+ * Thinks for every ATowerMonster actor from one time-sliced tick: chasing the
+ * nearest player within AggroDistance, walking home otherwise. Monsters
+ * register while they are alive and awake (not pooled, not dormant); records
+ * still in UTowerMonsterHordeSubsystem are simulated there.
+ *
+ * A monster thinks (picks its target, follows its path and moves by the time
+ * since it last thought) every so many frames by its state: every frame while
+ * it is moving (chasing or walking home) and Near or Visible,
+ * EngagedDistantFrames while moving further off, IdleFrames when it has
+ * nowhere to go and DormantFrames when UTowerSignificanceSubsystem has it
+ * Dormant. At most MaxThinksPerFrame think in one frame, so a pack
+ * aggroing together spreads over a few frames; the rest are first next frame.
+ *
+ * Paths come from async navigation queries, at most MaxPathQueriesPerFrame
+ * started a frame, and are shared: a path is keyed by the PathCellSize cells
+ * it starts and ends in, so a pack running at the same player makes one
+ * query and every member follows its result. While a query is out, or where
+ * there is no navmesh, monsters steer straight at their target.
+ */
+UCLASS()
+class TOWERGAME_API UTowerMonsterAISubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ============ Registration ============
+
+    /** Start thinking for Monster, with its current location as home; ATowerMonster calls these */
+    void Register(ATowerMonster* Monster);
+    void Unregister(ATowerMonster* Monster);
+
+    int32 GetNumAgents() const { return Agents.Num(); }
+    int32 GetNumEngaged() const;
+    int32 GetNumPaths() const { return Paths.Num(); }
+    int32 GetNumPathQueriesInFlight() const { return NumQueriesInFlight; }
+
+    // ============ Config ============
+
+    /** A monster chases the nearest player within this */
+    float AggroDistance = 3000.0f;
+
+    /** Chasers stop this short of the player */
+    float ChaseStopDistance = 200.0f;
+
+    /** Frames between thinks, by state (see the class comment) */
+    int32 EngagedDistantFrames = 4;
+    int32 IdleFrames = 10;
+    int32 DormantFrames = 30;
+
+    int32 MaxThinksPerFrame = 48;
+    int32 MaxPathQueriesPerFrame = 8;
+
+    /** Paths starting and ending in the same cells of this size are shared */
+    float PathCellSize = 400.0f;
+
+    /** Seconds a path is followed before it's asked for again */
+    float PathLifetime = 1.5f;
+
+    /** A path point counts as reached this close (2D) */
+    float PathPointRadius = 60.0f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FAgent
+    {
+        TWeakObjectPtr<ATowerMonster> Monster;
+        FVector Home = FVector::ZeroVector;
+        TWeakObjectPtr<AActor> Target;
+
+        /** Key into Paths of the path being followed, and the point it's heading for */
+        uint64 PathKey = 0;
+        int32 PathPoint = INDEX_NONE;
+        /** FSharedPath::Revision PathPoint was picked on */
+        uint32 PathRevision = 0;
+
+        uint64 LastThinkFrame = 0;
+        double LastThinkTime = 0.0;
+        int32 ThinkFrames = 1;
+    };
+
+    struct FSharedPath
+    {
+        TArray<FVector> Points;
+        double CreatedAt = 0.0;
+        uint32 QueryId = 0;
+        /** Bumped whenever Points are replaced */
+        uint32 Revision = 0;
+        bool bPending = false;
+    };
+
+    void Think(FAgent& Agent, ATowerMonster& Monster, double Now);
+
+    /** Where Agent should head next along its path toward Goal; Goal itself if there is no path yet */
+    FVector Steer(FAgent& Agent, const FVector& Location, const FVector& Goal, double Now);
+
+    uint64 GetPathKey(const FVector& Start, const FVector& Goal) const;
+    bool RequestPath(uint64 Key, const FVector& Start, const FVector& Goal, double Now);
+    void OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, uint64 Key);
+
+    /** Dense, swap-removed; ATowerMonster::AISlot indexes it */
+    TArray<FAgent> Agents;
+
+    TMap<uint64, FSharedPath> Paths;
+
+    uint64 Frame = 0;
+    int32 Cursor = 0;
+    int32 QueriesThisFrame = 0;
+    int32 NumQueriesInFlight = 0;
+    float TimeSincePathPurge = 0.0f;
+};
@@ -0,0 +1,498 @@
+#include "MonsterHordeSubsystem.h"
+#include "MonsterSpawner.h"
+#include "MonsterPool.h"
+#include "GameplayEventSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Async/ParallelFor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+namespace
+{
+    /** FFloorMonsterData::Speed is metres a second */
+    constexpr float HordeSpeedToUnits = 100.0f;
+}
+
+void UTowerMonsterHordeSubsystem::Deinitialize()
+{
+    Records.Empty();
+    Motion.Empty();
+    Health.Empty();
+    Status.Empty();
+    Clip.Empty();
+    DrawnClip.Empty();
+    TransformScratch.Empty();
+    InstanceRecords.Empty();
+    PromotedActors.Empty();
+    Instances = nullptr;
+    InstanceOwner = nullptr;
+    NumPromoted = 0;
+    Super::Deinitialize();
+}
+
+bool UTowerMonsterHordeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerMonsterHordeSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerMonsterHordeSubsystem, STATGROUP_Tickables);
+}
+
+void UTowerMonsterHordeSubsystem::Configure(UStaticMesh* InMesh, UMaterialInterface* InMaterial)
+{
+    // Instances already drawn keep the old look until the next floor
+    Mesh = InMesh;
+    Material = InMaterial;
+}
+
+// ============ Records ============
+
+void UTowerMonsterHordeSubsystem::AddMonsters(const TArray<FFloorMonsterData>& Monsters,
+    const TArray<FVector>& SpawnPoints, int32 FloorLevel)
+{
+    if (!EnsureInstances()) return;
+
+    const int32 Total = Records.Num() + Monsters.Num();
+    Records.Reserve(Total);
+    Motion.Reserve(Total);
+    Health.Reserve(Total);
+    Status.Reserve(Total);
+    Clip.Reserve(Total);
+    DrawnClip.Reserve(Total);
+    for (int32 i = 0; i < Monsters.Num(); i++)
+    {
+        const int32 RecordIdx = Records.AddDefaulted();
+        FHordeRecord& Record = Records[RecordIdx];
+        Record.Data = Monsters[i];
+        Record.FloorLevel = FloorLevel;
+        Record.MatchMonsterId = i + 1;
+
+        FHordeMotion& RecordMotion = Motion.AddDefaulted_GetRef();
+        RecordMotion.Scale = ATowerMonster::GetSizeScale(Record.Data.Size);
+        RecordMotion.Location = AMonsterSpawner::GetSpawnLocation(i, Monsters.Num(), SpawnPoints, FloorLevel);
+        // Sit on the ground, as ATowerMonster::InitFromData does
+        RecordMotion.Location.Z = RecordMotion.Scale * 50.0f;
+        RecordMotion.Home = RecordMotion.Location;
+        RecordMotion.Yaw = FMath::FRandRange(0.0f, 360.0f);
+        RecordMotion.Speed = Record.Data.Speed * HordeSpeedToUnits;
+
+        Health.Add(FHordeHealth{ Monsters[i].MaxHp, Monsters[i].MaxHp });
+        Status.AddDefaulted();
+        Clip.Add(EHordeAnimClip::Idle);
+        DrawnClip.Add(EHordeAnimClip::Idle);
+        AddInstance(RecordIdx);
+    }
+
+    Instances->MarkRenderStateDirty();
+    UE_LOG(LogTemp, Log, TEXT("Horde: %d monster records for floor %d"), Monsters.Num(), FloorLevel);
+
+    // Whoever starts next to a monster shouldn't see it pop in a pass later
+    Evaluate();
+}
+
+void UTowerMonsterHordeSubsystem::Clear()
+{
+    UTowerMonsterPool* Pool = GetWorld()->GetSubsystem<UTowerMonsterPool>();
+    for (ATowerMonster* Monster : PromotedActors)
+    {
+        if (!IsValid(Monster)) continue;
+        if (Pool)
+        {
+            Pool->Release(Monster);
+        }
+        else
+        {
+            Monster->Destroy();
+        }
+    }
+    PromotedActors.Reset();
+    NumPromoted = 0;
+
+    if (IsValid(Instances))
+    {
+        Instances->ClearInstances();
+    }
+    InstanceRecords.Reset();
+    Records.Reset();
+    Motion.Reset();
+    Health.Reset();
+    Status.Reset();
+    Clip.Reset();
+    DrawnClip.Reset();
+}
+
+void UTowerMonsterHordeSubsystem::ApplyStatusInRadius(const FVector& Center, float Radius, float DamagePerSecond, float Duration)
+{
+    const double RadiusSq = FMath::Square(Radius);
+    for (int32 RecordIdx = 0; RecordIdx < Records.Num(); RecordIdx++)
+    {
+        if (Records[RecordIdx].Actor || Health[RecordIdx].Hp <= 0.0f) continue;
+        if (FVector::DistSquared(Center, Motion[RecordIdx].Location) > RadiusSq) continue;
+
+        FHordeStatus& RecordStatus = Status[RecordIdx];
+        if (RecordStatus.Remaining <= 0.0f || DamagePerSecond >= RecordStatus.DamagePerSecond)
+        {
+            RecordStatus.DamagePerSecond = DamagePerSecond;
+            RecordStatus.Remaining = Duration;
+        }
+    }
+}
+
+int32 UTowerMonsterHordeSubsystem::GetNumAlive() const
+{
+    int32 Alive = 0;
+    for (int32 RecordIdx = 0; RecordIdx < Records.Num(); RecordIdx++)
+    {
+        const ATowerMonster* Actor = Records[RecordIdx].Actor;
+        const bool bAlive = Actor ? Actor->bIsAlive : Health[RecordIdx].Hp > 0.0f;
+        Alive += bAlive ? 1 : 0;
+    }
+    return Alive;
+}
+
+// ============ Instances ============
+
+bool UTowerMonsterHordeSubsystem::EnsureInstances()
+{
+    if (IsValid(Instances)) return true;
+
+    UWorld* World = GetWorld();
+    if (!IsValid(InstanceOwner))
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        InstanceOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!InstanceOwner) return false;
+        InstanceOwner->SetRootComponent(NewObject<USceneComponent>(InstanceOwner, TEXT("HordeRoot")));
+        InstanceOwner->GetRootComponent()->RegisterComponent();
+    }
+
+    const UStaticMeshComponent* DefaultMesh = GetDefault<ATowerMonster>()->MeshComponent;
+
+    // Instances are placed in world space, so the owner stays at the origin
+    Instances = NewObject<UInstancedStaticMeshComponent>(InstanceOwner, TEXT("HordeInstances"));
+    Instances->SetStaticMesh(Mesh ? Mesh : DefaultMesh->GetStaticMesh());
+    Instances->SetMaterial(0, Material ? Material : DefaultMesh->GetMaterial(0));
+    Instances->NumCustomDataFloats = HordeCustomData::NumFloats;
+    Instances->bSupportRemoveAtSwap = true;
+    Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Instances->SetCastShadow(false);
+    Instances->SetCanEverAffectNavigation(false);
+    Instances->SetupAttachment(InstanceOwner->GetRootComponent());
+    Instances->RegisterComponent();
+    return true;
+}
+
+void UTowerMonsterHordeSubsystem::AddInstance(int32 RecordIdx)
+{
+    FHordeRecord& Record = Records[RecordIdx];
+    const FHordeMotion& RecordMotion = Motion[RecordIdx];
+    const FTransform Transform(FRotator(0.0f, RecordMotion.Yaw, 0.0f), RecordMotion.Location, FVector(RecordMotion.Scale));
+
+    Record.Instance = Instances->AddInstance(Transform, /*bWorldSpace=*/true);
+    InstanceRecords.Add(RecordIdx);
+
+    // Random start phase, so a room of monsters doesn't idle in lockstep
+    const FLinearColor Tint = ATowerMonster::GetElementColor(Record.Data.Element);
+    float CustomData[HordeCustomData::NumFloats];
+    Clip[RecordIdx] = DrawnClip[RecordIdx] = EHordeAnimClip::Idle;
+    CustomData[HordeCustomData::AnimClip] = static_cast<float>(EHordeAnimClip::Idle);
+    CustomData[HordeCustomData::AnimStartTime] = static_cast<float>(GetWorld()->GetTimeSeconds()) - FMath::FRand() * 10.0f;
+    CustomData[HordeCustomData::AnimRate] = FMath::FRandRange(0.9f, 1.1f);
+    CustomData[HordeCustomData::TintR] = Tint.R;
+    CustomData[HordeCustomData::TintG] = Tint.G;
+    CustomData[HordeCustomData::TintB] = Tint.B;
+    Instances->SetCustomData(Record.Instance, MakeArrayView(CustomData), /*bMarkRenderStateDirty=*/false);
+}
+
+void UTowerMonsterHordeSubsystem::RemoveInstance(int32 RecordIdx)
+{
+    const int32 InstIdx = Records[RecordIdx].Instance;
+    if (InstIdx == INDEX_NONE) return;
+    Records[RecordIdx].Instance = INDEX_NONE;
+
+    // Swap-remove on both sides: the last instance moves into this one's index
+    Instances->RemoveInstance(InstIdx);
+    InstanceRecords.RemoveAtSwap(InstIdx, 1, /*bAllowShrinking=*/false);
+    if (InstanceRecords.IsValidIndex(InstIdx))
+    {
+        Records[InstanceRecords[InstIdx]].Instance = InstIdx;
+    }
+}
+
+// ============ Promotion ============
+
+void UTowerMonsterHordeSubsystem::Tick(float DeltaTime)
+{
+    if (Records.Num() == 0) return;
+
+    TimeSinceSimulation += DeltaTime;
+    if (TimeSinceSimulation >= SimulationInterval)
+    {
+        Simulate(TimeSinceSimulation);
+        TimeSinceSimulation = 0.0f;
+    }
+
+    TimeSinceEvaluation += DeltaTime;
+    if (TimeSinceEvaluation >= EvaluationInterval)
+    {
+        TimeSinceEvaluation = 0.0f;
+        Evaluate();
+    }
+}
+
+void UTowerMonsterHordeSubsystem::Evaluate()
+{
+    UWorld* World = GetWorld();
+    TArray<FVector, TInlineAllocator<4>> Players;
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        if (APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+        {
+            Players.Add(Pawn->GetActorLocation());
+        }
+    }
+    if (Players.Num() == 0) return;
+
+    const double Now = World->GetTimeSeconds();
+    const double PromoteSq = FMath::Square(PromoteDistance);
+    const double DemoteSq = FMath::Square(FMath::Max(DemoteDistance, PromoteDistance));
+
+    // Demote first so the freed slots go to the records that want them this pass
+    TArray<TPair<double, int32>, TInlineAllocator<16>> Wanted;
+    const int32 NumInstancesBefore = InstanceRecords.Num();
+    for (int32 RecordIdx = 0; RecordIdx < Records.Num(); RecordIdx++)
+    {
+        FHordeRecord& Record = Records[RecordIdx];
+        if (Record.Actor && !IsValid(Record.Actor))
+        {
+            // Destroyed out from under us (level teardown, a cheat): count it as dead
+            PromotedActors.RemoveSingleSwap(Record.Actor, /*bAllowShrinking=*/false);
+            Record.Actor = nullptr;
+            Health[RecordIdx].Hp = 0.0f;
+            NumPromoted--;
+            continue;
+        }
+        const FVector Location = Record.Actor ? Record.Actor->GetActorLocation() : Motion[RecordIdx].Location;
+
+        double NearestSq = TNumericLimits<double>::Max();
+        for (const FVector& Player : Players)
+        {
+            NearestSq = FMath::Min(NearestSq, FVector::DistSquared(Location, Player));
+        }
+
+        if (Record.Actor)
+        {
+            const bool bInCombat = Now - Record.Actor->LastDamagedTime < CombatMemorySeconds;
+            if (Record.Actor->bIsAlive && !bInCombat && NearestSq > DemoteSq)
+            {
+                Demote(RecordIdx);
+            }
+        }
+        else if (Health[RecordIdx].Hp > 0.0f && NearestSq < PromoteSq)
+        {
+            Wanted.Emplace(NearestSq, RecordIdx);
+        }
+    }
+
+    Wanted.Sort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+    bool bPromoted = false;
+    for (const TPair<double, int32>& Entry : Wanted)
+    {
+        if (NumPromoted >= MaxPromoted) break;
+        Promote(Entry.Value);
+        bPromoted = true;
+    }
+
+    if (bPromoted || InstanceRecords.Num() != NumInstancesBefore)
+    {
+        Instances->MarkRenderStateDirty();
+    }
+}
+
+void UTowerMonsterHordeSubsystem::Promote(int32 RecordIdx)
+{
+    FHordeRecord& Record = Records[RecordIdx];
+    UWorld* World = GetWorld();
+
+    ATowerMonster* Monster = nullptr;
+    if (UTowerMonsterPool* Pool = World->GetSubsystem<UTowerMonsterPool>())
+    {
+        Monster = Pool->Acquire(Motion[RecordIdx].Location);
+    }
+    else
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+        Monster = World->SpawnActor<ATowerMonster>(ATowerMonster::StaticClass(), Motion[RecordIdx].Location, FRotator::ZeroRotator, SpawnParams);
+    }
+    if (!Monster) return;
+
+    const FFloorMonsterData& Data = Record.Data;
+    Monster->InitFromData(Data.Name, Data.Size, Data.Element, Data.MaxHp, Data.Damage, Data.Armor, Data.Speed, Record.FloorLevel);
+    Monster->CurrentHp = Health[RecordIdx].Hp;
+    Monster->MatchMonsterId = Record.MatchMonsterId;
+    Status[RecordIdx] = FHordeStatus();
+
+    RemoveInstance(RecordIdx);
+    Record.Actor = Monster;
+    PromotedActors.Add(Monster);
+    NumPromoted++;
+}
+
+void UTowerMonsterHordeSubsystem::Demote(int32 RecordIdx)
+{
+    FHordeRecord& Record = Records[RecordIdx];
+    ATowerMonster* Monster = Record.Actor;
+
+    Motion[RecordIdx].Location = Monster->GetActorLocation();
+    Motion[RecordIdx].Yaw = Monster->GetActorRotation().Yaw;
+    Health[RecordIdx].Hp = Monster->CurrentHp;
+    Record.Actor = nullptr;
+    PromotedActors.RemoveSingleSwap(Monster, /*bAllowShrinking=*/false);
+    NumPromoted--;
+
+    if (UTowerMonsterPool* Pool = GetWorld()->GetSubsystem<UTowerMonsterPool>())
+    {
+        Pool->Release(Monster);
+    }
+    else
+    {
+        Monster->Destroy();
+    }
+
+    AddInstance(RecordIdx);
+}
+
+// ============ Simulation ============
+
+void UTowerMonsterHordeSubsystem::Simulate(float DeltaTime)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerHorde_Simulate);
+    if (InstanceRecords.Num() == 0 || !IsValid(Instances)) return;
+
+    SimPlayers.Reset();
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        if (APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+        {
+            SimPlayers.Add(Pawn->GetActorLocation());
+        }
+    }
+
+    // Chunks own disjoint record ranges, so the processors need no locking
+    const int32 ChunkSize = FMath::Max(SimulationChunkSize, 1);
+    const int32 NumChunks = FMath::DivideAndRoundUp(Records.Num(), ChunkSize);
+    ParallelFor(NumChunks, [this, ChunkSize, DeltaTime](int32 Chunk)
+    {
+        const int32 First = Chunk * ChunkSize;
+        const int32 Last = FMath::Min(First + ChunkSize, Records.Num());
+        StepStatus(First, Last, DeltaTime);
+        StepMotion(First, Last, DeltaTime);
+    }, NumChunks > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    // Deaths and clip changes touch the ISM, so they're applied here
+    const float Now = static_cast<float>(GetWorld()->GetTimeSeconds());
+    UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>();
+    bool bAnyMoving = false;
+    bool bDirty = false;
+    for (int32 RecordIdx = 0; RecordIdx < Records.Num(); RecordIdx++)
+    {
+        const int32 InstIdx = Records[RecordIdx].Instance;
+        if (InstIdx == INDEX_NONE) continue;
+
+        if (Health[RecordIdx].Hp <= 0.0f)
+        {
+            if (Events)
+            {
+                Events->PostKill({ Records[RecordIdx].FloorLevel, Records[RecordIdx].Data.Element, Motion[RecordIdx].Location });
+            }
+            RemoveInstance(RecordIdx);
+            bDirty = true;
+            continue;
+        }
+
+        bAnyMoving |= Clip[RecordIdx] == EHordeAnimClip::Walk;
+        if (Clip[RecordIdx] != DrawnClip[RecordIdx])
+        {
+            DrawnClip[RecordIdx] = Clip[RecordIdx];
+            Instances->SetCustomDataValue(InstIdx, HordeCustomData::AnimClip, static_cast<float>(Clip[RecordIdx]), false);
+            Instances->SetCustomDataValue(InstIdx, HordeCustomData::AnimStartTime, Now, false);
+            bDirty = true;
+        }
+    }
+
+    // Whole-range batch: one render state update for the horde however many moved
+    if (bAnyMoving && InstanceRecords.Num() > 0)
+    {
+        TransformScratch.SetNumUninitialized(InstanceRecords.Num(), /*bAllowShrinking=*/false);
+        for (int32 InstIdx = 0; InstIdx < InstanceRecords.Num(); InstIdx++)
+        {
+            const FHordeMotion& RecordMotion = Motion[InstanceRecords[InstIdx]];
+            TransformScratch[InstIdx] = FTransform(FRotator(0.0f, RecordMotion.Yaw, 0.0f), RecordMotion.Location, FVector(RecordMotion.Scale));
+        }
+        Instances->BatchUpdateInstancesTransforms(0, TransformScratch, /*bWorldSpace=*/true,
+            /*bMarkRenderStateDirty=*/true, /*bTeleport=*/true);
+    }
+    else if (bDirty)
+    {
+        Instances->MarkRenderStateDirty();
+    }
+}
+
+void UTowerMonsterHordeSubsystem::StepStatus(int32 First, int32 Last, float DeltaTime)
+{
+    for (int32 RecordIdx = First; RecordIdx < Last; RecordIdx++)
+    {
+        FHordeStatus& RecordStatus = Status[RecordIdx];
+        if (RecordStatus.Remaining <= 0.0f || Records[RecordIdx].Instance == INDEX_NONE) continue;
+
+        FHordeHealth& RecordHealth = Health[RecordIdx];
+        RecordHealth.Hp = FMath::Max(RecordHealth.Hp - RecordStatus.DamagePerSecond * FMath::Min(DeltaTime, RecordStatus.Remaining), 0.0f);
+        RecordStatus.Remaining -= DeltaTime;
+    }
+}
+
+void UTowerMonsterHordeSubsystem::StepMotion(int32 First, int32 Last, float DeltaTime)
+{
+    const double AggroSq = FMath::Square(AggroDistance);
+    for (int32 RecordIdx = First; RecordIdx < Last; RecordIdx++)
+    {
+        if (Records[RecordIdx].Instance == INDEX_NONE || Health[RecordIdx].Hp <= 0.0f) continue;
+
+        FHordeMotion& RecordMotion = Motion[RecordIdx];
+        double NearestSq = AggroSq;
+        const FVector* Nearest = nullptr;
+        for (const FVector& Player : SimPlayers)
+        {
+            const double DistSq = FVector::DistSquared2D(RecordMotion.Location, Player);
+            if (DistSq < NearestSq)
+            {
+                NearestSq = DistSq;
+                Nearest = &Player;
+            }
+        }
+
+        const FVector Goal = Nearest ? *Nearest : RecordMotion.Home;
+        const double StopDistance = Nearest ? ChaseStopDistance : 1.0;
+        const FVector ToGoal = FVector(Goal.X - RecordMotion.Location.X, Goal.Y - RecordMotion.Location.Y, 0.0);
+        const double Distance = ToGoal.Size();
+        if (Distance <= StopDistance)
+        {
+            Clip[RecordIdx] = EHordeAnimClip::Idle;
+            continue;
+        }
+
+        const double Step = FMath::Min(static_cast<double>(RecordMotion.Speed) * DeltaTime, Distance - StopDistance);
+        RecordMotion.Location += ToGoal * (Step / Distance);
+        RecordMotion.Yaw = FMath::RadiansToDegrees(FMath::Atan2(ToGoal.Y, ToGoal.X));
+        Clip[RecordIdx] = EHordeAnimClip::Walk;
+    }
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Bridge/ProceduralCoreBridge.h"
+#include "MonsterHordeSubsystem.generated.h"
+
+class ATowerMonster;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+/**
+ * Per-instance custom data of horde monsters. The horde material plays a
+ * vertex animation texture: row AnimClip, from AnimStartTime (world seconds)
+ * at AnimRate, tinted by the element colour.
+ */
+namespace HordeCustomData
+{
+    constexpr int32 AnimClip = 0;
+    constexpr int32 AnimStartTime = 1;
+    constexpr int32 AnimRate = 2;
+    constexpr int32 TintR = 3;
+    constexpr int32 TintG = 4;
+    constexpr int32 TintB = 5;
+    constexpr int32 NumFloats = 6;
+}
+
+/** Rows of the horde vertex animation texture */
+enum class EHordeAnimClip : uint8
+{
+    Idle = 0,
+    Walk = 1,
+};
+
+/**
+ * Draws a floor's far-off monsters as instances of one mesh instead of one
+ * ATowerMonster each, so a floor can hold a horde.
+ *
+ * Each monster is a record (its spawn data, location and HP) plus an ISM
+ * instance animated on the GPU from its custom data; nothing ticks per
+ * monster. Every EvaluationInterval the records near a player become real
+ * monsters from UTowerMonsterPool, and their instance is removed. A promoted
+ * monster goes back to being a record once every player is beyond
+ * DemoteDistance and it hasn't been hit for CombatMemorySeconds. Dead
+ * monsters stay actors until the floor is cleared.
+ *
+ * Records are simulated as fragments, not objects: motion (location, home,
+ * facing, speed), health, status (damage over time) and the clip each
+ * instance plays sit in parallel arrays indexed like Records. Every
+ * SimulationInterval the movement and status processors step them in chunks
+ * of SimulationChunkSize across the task graph, and the instance transforms
+ * go to the ISM in one batch, so the game thread pays a copy per record and
+ * nothing per monster object. A record walks toward the nearest player
+ * within AggroDistance, which brings a horde in until it's promoted, and
+ * drifts home otherwise. A promoted monster thinks in UTowerMonsterAISubsystem.
+ *
+ * The GameMode hands a floor's monsters here instead of to AMonsterSpawner
+ * when bUseHordeRendering is set, and clears it with the floor.
+ */
+UCLASS()
+class TOWERGAME_API UTowerMonsterHordeSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** Mesh and vertex-animated material for instances; null for the ATowerMonster defaults */
+    void Configure(UStaticMesh* InMesh, UMaterialInterface* InMaterial);
+
+    /** Add a floor's monsters as records, placed like AMonsterSpawner::SpawnMonsters places actors */
+    void AddMonsters(const TArray<FFloorMonsterData>& Monsters, const TArray<FVector>& SpawnPoints, int32 FloorLevel);
+
+    /** Drop every record and hand the promoted monsters back to the pool */
+    void Clear();
+
+    /**
+     * Damage over time on every living record within Radius of Center, replacing
+     * a weaker one; promoted monsters are left to their actor
+     */
+    void ApplyStatusInRadius(const FVector& Center, float Radius, float DamagePerSecond, float Duration);
+
+    int32 GetNumRecords() const { return Records.Num(); }
+    int32 GetNumPromoted() const { return NumPromoted; }
+    int32 GetNumAlive() const;
+
+    // ============ Config ============
+
+    /** A record within this of a player becomes an actor */
+    float PromoteDistance = 2500.0f;
+
+    /** An actor beyond this from every player may become a record again; above PromoteDistance so it doesn't flap */
+    float DemoteDistance = 3500.0f;
+
+    /** Seconds after its last hit that a monster stays an actor regardless of distance */
+    float CombatMemorySeconds = 5.0f;
+
+    /** Actors at once; nearer records wait for a slot */
+    int32 MaxPromoted = 32;
+
+    /** Seconds between promotion passes */
+    float EvaluationInterval = 0.25f;
+
+    /** Seconds between movement and status steps of the records */
+    float SimulationInterval = 0.1f;
+
+    /** A record walks toward the nearest player within this, else back home */
+    float AggroDistance = 6000.0f;
+
+    /** Records walking toward a player stop this short of them */
+    float ChaseStopDistance = 200.0f;
+
+    /** Records per processor task */
+    int32 SimulationChunkSize = 256;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** Cold per-record state: what it spawned from and how it's drawn */
+    struct FHordeRecord
+    {
+        FFloorMonsterData Data;
+        int32 FloorLevel = 1;
+        /** Index into this AddMonsters batch plus one, as ATowerMonster::MatchMonsterId */
+        int32 MatchMonsterId = 0;
+        /** ISM index while drawn as an instance, else INDEX_NONE */
+        int32 Instance = INDEX_NONE;
+        ATowerMonster* Actor = nullptr;
+    };
+
+    // Fragments, indexed like Records
+
+    struct FHordeMotion
+    {
+        FVector Location = FVector::ZeroVector;
+        FVector Home = FVector::ZeroVector;
+        float Yaw = 0.0f;
+        /** World units per second */
+        float Speed = 0.0f;
+        float Scale = 1.0f;
+    };
+
+    struct FHordeHealth
+    {
+        float Hp = 0.0f;
+        float MaxHp = 0.0f;
+    };
+
+    struct FHordeStatus
+    {
+        float DamagePerSecond = 0.0f;
+        float Remaining = 0.0f;
+    };
+
+    bool EnsureInstances();
+    void AddInstance(int32 RecordIdx);
+    void RemoveInstance(int32 RecordIdx);
+
+    void Promote(int32 RecordIdx);
+    void Demote(int32 RecordIdx);
+
+    void Evaluate();
+
+    /** Run the processors over every record drawn as an instance, then draw the result */
+    void Simulate(float DeltaTime);
+
+    // Processors; each touches only records [First, Last) and may run on any thread
+    void StepMotion(int32 First, int32 Last, float DeltaTime);
+    void StepStatus(int32 First, int32 Last, float DeltaTime);
+
+    TArray<FHordeRecord> Records;
+    TArray<FHordeMotion> Motion;
+    TArray<FHordeHealth> Health;
+    TArray<FHordeStatus> Status;
+
+    /** EHordeAnimClip the processors picked, and the one the instance plays */
+    TArray<EHordeAnimClip> Clip;
+    TArray<EHordeAnimClip> DrawnClip;
+
+    /** Record of each ISM instance, swap-removed alongside it */
+    TArray<int32> InstanceRecords;
+
+    int32 NumPromoted = 0;
+    float TimeSinceEvaluation = 0.0f;
+    float TimeSinceSimulation = 0.0f;
+
+    /** Player locations for this step's processors */
+    TArray<FVector, TInlineAllocator<4>> SimPlayers;
+
+    /** Reused per simulation step, one per instance */
+    TArray<FTransform> TransformScratch;
+
+    UPROPERTY()
+    UStaticMesh* Mesh = nullptr;
+
+    UPROPERTY()
+    UMaterialInterface* Material = nullptr;
+
+    /** Carries Instances; spawned with the first record */
+    UPROPERTY()
+    AActor* InstanceOwner = nullptr;
+
+    UPROPERTY()
+    UInstancedStaticMeshComponent* Instances = nullptr;
+
+    /** Keeps the promoted actors alive (Records isn't reflected) */
+    UPROPERTY()
+    TArray<ATowerMonster*> PromotedActors;
+};
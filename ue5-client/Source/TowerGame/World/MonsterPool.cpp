@@ -0,0 +1,92 @@
+#include "MonsterPool.h"
+#include "MonsterSpawner.h"
+#include "Engine/World.h"
+
+/** Where parked monsters wait, out of sight and out of the way of traces */
+static const FVector PooledMonsterLocation(0.0f, 0.0f, -100000.0f);
+
+void UTowerMonsterPool::Deinitialize()
+{
+    Idle.Empty();
+    NumActive = 0;
+    Super::Deinitialize();
+}
+
+bool UTowerMonsterPool::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+ATowerMonster* UTowerMonsterPool::Acquire(const FVector& Location)
+{
+    ATowerMonster* Monster = nullptr;
+    while (!Monster && Idle.Num() > 0)
+    {
+        // Parked actors can still be destroyed by level teardown or a cheat
+        ATowerMonster* Candidate = Idle.Pop(/*bAllowShrinking=*/false);
+        if (IsValid(Candidate))
+        {
+            Monster = Candidate;
+        }
+    }
+
+    if (Monster)
+    {
+        Monster->SetActorLocation(Location, /*bSweep=*/false, nullptr, ETeleportType::ResetPhysics);
+        Monster->SetPooledActive(true);
+    }
+    else
+    {
+        Monster = SpawnMonster(Location);
+        if (!Monster)
+        {
+            return nullptr;
+        }
+    }
+
+    NumActive++;
+    return Monster;
+}
+
+void UTowerMonsterPool::Release(ATowerMonster* Monster)
+{
+    if (!IsValid(Monster))
+    {
+        return;
+    }
+
+    Monster->SetPooledActive(false);
+    Monster->SetActorLocation(PooledMonsterLocation, /*bSweep=*/false, nullptr, ETeleportType::ResetPhysics);
+    Idle.Add(Monster);
+    NumActive = FMath::Max(NumActive - 1, 0);
+}
+
+int32 UTowerMonsterPool::Prewarm(int32 TotalWanted, int32 MaxSpawns)
+{
+    int32 Missing = TotalWanted - Idle.Num() - NumActive;
+    for (int32 i = 0; i < MaxSpawns && Missing > 0; i++)
+    {
+        ATowerMonster* Monster = SpawnMonster(PooledMonsterLocation);
+        if (!Monster)
+        {
+            break;
+        }
+        Monster->SetPooledActive(false);
+        Idle.Add(Monster);
+        Missing--;
+    }
+    return FMath::Max(Missing, 0);
+}
+
+ATowerMonster* UTowerMonsterPool::SpawnMonster(const FVector& Location)
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+    return World->SpawnActor<ATowerMonster>(ATowerMonster::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+}
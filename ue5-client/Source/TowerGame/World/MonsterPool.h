@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MonsterPool.generated.h"
+
+class ATowerMonster;
+
+/**
+ * Reuses ATowerMonster actors across floors. Clearing a floor parks its monsters
+ * here (hidden, no collision, no tick) instead of destroying them, and the next
+ * floor's spawn takes them back and re-runs InitFromData, so floor transitions
+ * don't pay actor construction, component registration and the GC pass after.
+ *
+ * Prewarm tops the pool up a few actors per call; UFloorTransitionComponent
+ * calls it during the fade-out so a bigger floor doesn't spawn them all in one frame.
+ */
+UCLASS()
+class TOWERGAME_API UTowerMonsterPool : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /** A monster at Location, taken from the pool or spawned; call InitFromData on it next */
+    ATowerMonster* Acquire(const FVector& Location);
+
+    /** Park a monster for reuse. It must not be used again until the next Acquire. */
+    void Release(ATowerMonster* Monster);
+
+    /**
+     * Spawn parked monsters until TotalWanted are in the pool or in use, at most
+     * MaxSpawns this call. Returns how many are still missing.
+     */
+    int32 Prewarm(int32 TotalWanted, int32 MaxSpawns);
+
+    int32 GetNumIdle() const { return Idle.Num(); }
+    int32 GetNumActive() const { return NumActive; }
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    ATowerMonster* SpawnMonster(const FVector& Location);
+
+    UPROPERTY()
+    TArray<ATowerMonster*> Idle;
+
+    /** Handed out by Acquire and not yet released */
+    int32 NumActive = 0;
+};
@@ -1,10 +1,13 @@
 #include "MonsterSpawner.h"
+#include "MonsterPool.h"
+#include "MonsterAISubsystem.h"
+#include "SignificanceSubsystem.h"
+#include "ProximityQuerySubsystem.h"
+#include "GameplayEventSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Rendering/MaterialVariantSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
-#include "Dom/JsonObject.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
 
 // ============ AMonsterSpawner ============
 
@@ -19,76 +22,89 @@ TArray<AActor*> AMonsterSpawner::SpawnMonstersFromJson(
     const TArray<FVector>& SpawnPoints,
     int32 FloorLevel)
 {
-    TArray<AActor*> SpawnedMonsters;
-
     if (!World || MonstersJson.IsEmpty())
     {
-        return SpawnedMonsters;
+        return TArray<AActor*>();
     }
 
-    // Parse the JSON array
-    TArray<TSharedPtr<FJsonValue>> MonstersArray;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(MonstersJson);
-    if (!FJsonSerializer::Deserialize(Reader, MonstersArray))
+    TArray<FFloorMonsterData> Monsters;
+    if (!FFloorMonsterData::ParseJsonArray(MonstersJson, Monsters))
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to parse monsters JSON"));
-        return SpawnedMonsters;
+        return TArray<AActor*>();
     }
 
-    UE_LOG(LogTemp, Log, TEXT("Spawning %d monsters for floor %d"), MonstersArray.Num(), FloorLevel);
+    return SpawnMonsters(World, Monsters, SpawnPoints, FloorLevel);
+}
+
+TArray<AActor*> AMonsterSpawner::SpawnMonsters(
+    UWorld* World,
+    const TArray<FFloorMonsterData>& Monsters,
+    const TArray<FVector>& SpawnPoints,
+    int32 FloorLevel)
+{
+    TArray<AActor*> SpawnedMonsters;
 
-    for (int32 i = 0; i < MonstersArray.Num(); i++)
+    if (!World)
     {
-        TSharedPtr<FJsonObject> MonsterObj = MonstersArray[i]->AsObject();
-        if (!MonsterObj.IsValid()) continue;
+        return SpawnedMonsters;
+    }
 
-        // Extract data from Rust MonsterInfo JSON (flat structure)
-        FString Name = MonsterObj->GetStringField(TEXT("name"));
-        FString Size = MonsterObj->GetStringField(TEXT("size"));
-        FString Element = MonsterObj->GetStringField(TEXT("element"));
+    UE_LOG(LogTemp, Log, TEXT("Spawning %d monsters for floor %d"), Monsters.Num(), FloorLevel);
 
-        // Stats are flat fields in MonsterInfo from Rust
-        float Hp = MonsterObj->GetNumberField(TEXT("max_hp"));
-        float Atk = MonsterObj->GetNumberField(TEXT("damage"));
-        float Def = MonsterObj->GetNumberField(TEXT("armor"));
-        float Spd = MonsterObj->GetNumberField(TEXT("speed"));
+    UTowerMonsterPool* Pool = World->GetSubsystem<UTowerMonsterPool>();
+    SpawnedMonsters.Reserve(Monsters.Num());
 
-        // Calculate spawn location
-        FVector SpawnLoc;
-        if (SpawnPoints.Num() > 0)
+    for (int32 i = 0; i < Monsters.Num(); i++)
+    {
+        const FFloorMonsterData& Data = Monsters[i];
+
+        const FVector SpawnLoc = GetSpawnLocation(i, Monsters.Num(), SpawnPoints, FloorLevel);
+
+        ATowerMonster* Monster = nullptr;
+        if (Pool)
         {
-            // Distribute among spawn points with some randomization
-            int32 PointIdx = i % SpawnPoints.Num();
-            SpawnLoc = SpawnPoints[PointIdx];
-            // Add random offset within room (+-150 UU)
-            SpawnLoc.X += FMath::FRandRange(-150.0f, 150.0f);
-            SpawnLoc.Y += FMath::FRandRange(-150.0f, 150.0f);
+            Monster = Pool->Acquire(SpawnLoc);
         }
         else
         {
-            // Fallback: spread in a circle
-            float Angle = (float)i / (float)FMath::Max(1, MonstersArray.Num()) * 2.0f * PI;
-            float Radius = 500.0f + FloorLevel * 50.0f;
-            SpawnLoc = FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 50.0f);
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+            Monster = World->SpawnActor<ATowerMonster>(
+                ATowerMonster::StaticClass(), SpawnLoc, FRotator::ZeroRotator, SpawnParams);
         }
 
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-        ATowerMonster* Monster = World->SpawnActor<ATowerMonster>(
-            ATowerMonster::StaticClass(), SpawnLoc, FRotator::ZeroRotator, SpawnParams);
-
         if (Monster)
         {
-            Monster->InitFromData(Name, Size, Element, Hp, Atk, Def, Spd, FloorLevel);
+            Monster->InitFromData(Data.Name, Data.Size, Data.Element, Data.MaxHp, Data.Damage, Data.Armor, Data.Speed, FloorLevel);
+            // tower_match.lua numbers the floor's monsters the same way
+            Monster->MatchMonsterId = i + 1;
             SpawnedMonsters.Add(Monster);
-            UE_LOG(LogTemp, Verbose, TEXT("  Spawned: %s (HP=%.0f ATK=%.0f)"), *Name, Hp, Atk);
+            UE_LOG(LogTemp, Verbose, TEXT("  Spawned: %s (HP=%.0f ATK=%.0f)"), *Data.Name, Data.MaxHp, Data.Damage);
         }
     }
 
     return SpawnedMonsters;
 }
 
+FVector AMonsterSpawner::GetSpawnLocation(int32 Index, int32 NumMonsters, const TArray<FVector>& SpawnPoints, int32 FloorLevel)
+{
+    if (SpawnPoints.Num() > 0)
+    {
+        // Distribute among spawn points with some randomization
+        FVector SpawnLoc = SpawnPoints[Index % SpawnPoints.Num()];
+        // Add random offset within room (+-150 UU)
+        SpawnLoc.X += FMath::FRandRange(-150.0f, 150.0f);
+        SpawnLoc.Y += FMath::FRandRange(-150.0f, 150.0f);
+        return SpawnLoc;
+    }
+
+    // Fallback: spread in a circle
+    float Angle = (float)Index / (float)FMath::Max(1, NumMonsters) * 2.0f * PI;
+    float Radius = 500.0f + FloorLevel * 50.0f;
+    return FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 50.0f);
+}
+
 // ============ ATowerMonster ============
 
 ATowerMonster::ATowerMonster()
@@ -110,10 +126,35 @@ ATowerMonster::ATowerMonster()
     MeshComponent->SetCollisionObjectType(ECC_Pawn);
 }
 
+void ATowerMonster::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Pooled monsters stay registered; the pool switches their tick off itself
+    if (UTowerSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTowerSignificanceSubsystem>())
+    {
+        Significance->Register(this);
+    }
+    UpdateProximity(true);
+    UpdateAI(true);
+}
+
+void ATowerMonster::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UTowerSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UTowerSignificanceSubsystem>())
+    {
+        Significance->Unregister(this);
+    }
+    UpdateProximity(false);
+    UpdateAI(false);
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ATowerMonster::InitFromData(
     const FString& InName,
-    const FString& InSize,
-    const FString& InElement,
+    EMonsterSize InSize,
+    EMonsterElement InElement,
     float InHp,
     float InAttack,
     float InDefense,
@@ -121,6 +162,9 @@ void ATowerMonster::InitFromData(
     int32 InFloorLevel)
 {
     MonsterName = InName;
+    bIsAlive = true;
+    MatchMonsterId = 0;
+    LastDamagedTime = -1.0e9;
     Size = InSize;
     Element = InElement;
     MaxHp = InHp;
@@ -138,15 +182,15 @@ void ATowerMonster::InitFromData(
     FVector Loc = GetActorLocation();
     Loc.Z = Scale * 50.0f; // Half height
     SetActorLocation(Loc);
+    UpdateProximity(true);
+    UpdateAI(true);
 
-    // Color based on element
-    UMaterialInterface* BaseMat = MeshComponent->GetMaterial(0);
-    if (BaseMat)
+    // Color based on element, from the material shared by every monster of that element
+    UTowerMaterialVariantSubsystem* Variants = GetWorld()->GetSubsystem<UTowerMaterialVariantSubsystem>();
+    if (UMaterialInstanceDynamic* ElementMat = Variants ? Variants->FindOrCreateColored(MeshComponent->GetMaterial(0),
+        TowerMonsterTags::GetElementName(InElement), GetElementColor(InElement)) : nullptr)
     {
-        UMaterialInstanceDynamic* DynMat = UMaterialInstanceDynamic::Create(BaseMat, this);
-        FLinearColor Color = GetElementColor(InElement);
-        DynMat->SetVectorParameterValue(TEXT("BaseColor"), Color);
-        MeshComponent->SetMaterial(0, DynMat);
+        MeshComponent->SetMaterial(0, ElementMat);
     }
 
 #if WITH_EDITOR
@@ -154,7 +198,7 @@ void ATowerMonster::InitFromData(
 #endif
 
     UE_LOG(LogTemp, Log, TEXT("Monster initialized: %s [%s/%s] HP=%.0f ATK=%.0f DEF=%.0f SPD=%.0f"),
-        *MonsterName, *Size, *Element, MaxHp, Attack, Defense, Speed);
+        *MonsterName, TowerMonsterTags::ToString(Size), TowerMonsterTags::ToString(Element), MaxHp, Attack, Defense, Speed);
 }
 
 void ATowerMonster::TakeDamageFromPlayer(float DamageAmount)
@@ -163,6 +207,7 @@ void ATowerMonster::TakeDamageFromPlayer(float DamageAmount)
 
     float ActualDamage = FMath::Max(0.0f, DamageAmount - Defense * 0.3f);
     CurrentHp -= ActualDamage;
+    LastDamagedTime = GetWorld()->GetTimeSeconds();
 
     UE_LOG(LogTemp, Log, TEXT("%s takes %.1f damage (%.1f mitigated). HP: %.0f/%.0f"),
         *MonsterName, ActualDamage, DamageAmount - ActualDamage, CurrentHp, MaxHp);
@@ -171,32 +216,105 @@ void ATowerMonster::TakeDamageFromPlayer(float DamageAmount)
     {
         CurrentHp = 0.0f;
         bIsAlive = false;
+        UpdateProximity(false);
+        UpdateAI(false);
         OnMonsterDeath.Broadcast(this);
+        if (UTowerGameplayEventSubsystem* Events = GetWorld()->GetSubsystem<UTowerGameplayEventSubsystem>())
+        {
+            Events->PostKill({ FloorLevel, Element, GetActorLocation() });
+        }
         UE_LOG(LogTemp, Log, TEXT("%s defeated!"), *MonsterName);
     }
 }
 
-FLinearColor ATowerMonster::GetElementColor(const FString& InElement)
+void ATowerMonster::SetPooledActive(bool bActive)
+{
+    SetActorHiddenInGame(!bActive);
+    SetActorEnableCollision(bActive);
+    SetActorTickEnabled(bActive);
+
+    // Parked monsters aren't on the grid, so targeting and the minimap never see them
+    UpdateProximity(bActive);
+    UpdateAI(bActive);
+
+    if (!bActive)
+    {
+        // Listeners were bound for the floor this monster just left
+        OnMonsterDeath.Clear();
+    }
+}
+
+void ATowerMonster::SetDormant(bool bDormant)
 {
-    if (InElement == TEXT("Fire"))       return FLinearColor(1.0f, 0.3f, 0.1f);
-    if (InElement == TEXT("Ice"))        return FLinearColor(0.3f, 0.7f, 1.0f);
-    if (InElement == TEXT("Lightning"))  return FLinearColor(1.0f, 1.0f, 0.2f);
-    if (InElement == TEXT("Poison"))     return FLinearColor(0.3f, 0.9f, 0.2f);
-    if (InElement == TEXT("Void"))       return FLinearColor(0.4f, 0.1f, 0.6f);
-    if (InElement == TEXT("Stone"))      return FLinearColor(0.5f, 0.45f, 0.4f);
-    if (InElement == TEXT("Wind"))       return FLinearColor(0.7f, 0.9f, 0.7f);
-    if (InElement == TEXT("Arcane"))     return FLinearColor(0.6f, 0.3f, 0.9f);
-    // Neutral
-    return FLinearColor(0.6f, 0.6f, 0.6f);
+    SetActorHiddenInGame(bDormant);
+    SetActorEnableCollision(!bDormant);
+    SetActorTickEnabled(!bDormant);
+
+    // The dead left the grid when they died
+    UpdateProximity(!bDormant && bIsAlive);
+    UpdateAI(!bDormant && bIsAlive);
 }
 
-float ATowerMonster::GetSizeScale(const FString& InSize)
+void ATowerMonster::UpdateProximity(bool bOnGrid)
 {
-    if (InSize == TEXT("Tiny"))      return 0.5f;
-    if (InSize == TEXT("Small"))     return 0.8f;
-    if (InSize == TEXT("Medium"))    return 1.2f;
-    if (InSize == TEXT("Large"))     return 1.8f;
-    if (InSize == TEXT("Huge"))      return 2.5f;
-    if (InSize == TEXT("Colossal"))  return 3.5f;
-    return 1.0f;
+    UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>();
+    if (!Proximity) return;
+
+    if (!bOnGrid)
+    {
+        Proximity->Unregister(ProximityHandle);
+        ProximityHandle = INDEX_NONE;
+    }
+    else if (ProximityHandle == INDEX_NONE)
+    {
+        ProximityHandle = Proximity->Register(this, EProximityChannel::Monster, 0.0f);
+    }
+    else
+    {
+        Proximity->UpdateLocation(ProximityHandle, GetActorLocation());
+    }
+}
+
+void ATowerMonster::UpdateAI(bool bThinking)
+{
+    UTowerMonsterAISubsystem* AI = GetWorld()->GetSubsystem<UTowerMonsterAISubsystem>();
+    if (!AI) return;
+
+    if (bThinking)
+    {
+        AI->Register(this);
+    }
+    else
+    {
+        AI->Unregister(this);
+    }
+}
+
+FLinearColor ATowerMonster::GetElementColor(EMonsterElement InElement)
+{
+    // Indexed by EMonsterElement
+    static const FLinearColor Colors[] =
+    {
+        FLinearColor(0.6f, 0.6f, 0.6f),     // Neutral
+        FLinearColor(1.0f, 0.3f, 0.1f),     // Fire
+        FLinearColor(0.3f, 0.7f, 1.0f),     // Ice
+        FLinearColor(1.0f, 1.0f, 0.2f),     // Lightning
+        FLinearColor(0.3f, 0.9f, 0.2f),     // Poison
+        FLinearColor(0.4f, 0.1f, 0.6f),     // Void
+        FLinearColor(0.5f, 0.45f, 0.4f),    // Stone
+        FLinearColor(0.7f, 0.9f, 0.7f),     // Wind
+        FLinearColor(0.6f, 0.3f, 0.9f),     // Arcane
+    };
+    static_assert(UE_ARRAY_COUNT(Colors) == static_cast<int32>(EMonsterElement::Count), "One color per EMonsterElement");
+
+    return Colors[static_cast<uint8>(TowerMonsterTags::SanitizeElement(static_cast<uint8>(InElement)))];
+}
+
+float ATowerMonster::GetSizeScale(EMonsterSize InSize)
+{
+    // Indexed by EMonsterSize
+    static const float Scales[] = { 1.0f, 0.5f, 0.8f, 1.2f, 1.8f, 2.5f, 3.5f };
+    static_assert(UE_ARRAY_COUNT(Scales) == static_cast<int32>(EMonsterSize::Count), "One scale per EMonsterSize");
+
+    return Scales[static_cast<uint8>(TowerMonsterTags::SanitizeSize(static_cast<uint8>(InSize)))];
 }
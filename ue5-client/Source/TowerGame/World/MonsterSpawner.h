@@ -2,11 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Bridge/ProceduralCoreBridge.h"
 #include "MonsterSpawner.generated.h"
 
 /**
  * Static utility for spawning monsters from Rust JSON data.
- * Monsters are placed at spawn points derived from room locations.
+ * Monsters are placed at spawn points derived from room locations, and come
+ * from the world's UTowerMonsterPool when it has one.
  */
 UCLASS()
 class TOWERGAME_API AMonsterSpawner : public AActor
@@ -25,6 +27,16 @@ public:
         const FString& MonstersJson,
         const TArray<FVector>& SpawnPoints,
         int32 FloorLevel);
+
+    /** Spawn already-parsed monsters (e.g. from an async floor generation) */
+    static TArray<AActor*> SpawnMonsters(
+        UWorld* World,
+        const TArray<FFloorMonsterData>& Monsters,
+        const TArray<FVector>& SpawnPoints,
+        int32 FloorLevel);
+
+    /** Where the Index-th of NumMonsters goes: round-robin over SpawnPoints with jitter, else a circle */
+    static FVector GetSpawnLocation(int32 Index, int32 NumMonsters, const TArray<FVector>& SpawnPoints, int32 FloorLevel);
 };
 
 /**
@@ -40,11 +52,14 @@ class TOWERGAME_API ATowerMonster : public AActor
 public:
     ATowerMonster();
 
-    /** Initialize from parsed JSON data */
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** Initialize from parsed JSON data; also resets a monster reused from the pool */
     void InitFromData(
         const FString& InName,
-        const FString& InSize,
-        const FString& InElement,
+        EMonsterSize InSize,
+        EMonsterElement InElement,
         float InHp,
         float InAttack,
         float InDefense,
@@ -57,10 +72,10 @@ public:
     FString MonsterName;
 
     UPROPERTY(BlueprintReadOnly, Category = "Monster")
-    FString Size;
+    EMonsterSize Size = EMonsterSize::Unknown;
 
     UPROPERTY(BlueprintReadOnly, Category = "Monster")
-    FString Element;
+    EMonsterElement Element = EMonsterElement::Neutral;
 
     UPROPERTY(BlueprintReadOnly, Category = "Monster")
     float MaxHp = 100.0f;
@@ -83,6 +98,13 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "Monster")
     bool bIsAlive = true;
 
+    /** Key the match server holds this monster under, its 1-based spawn index; 0 = local only */
+    UPROPERTY(BlueprintReadOnly, Category = "Monster")
+    int32 MatchMonsterId = 0;
+
+    /** World time of the last hit taken; the horde keeps a monster in combat as an actor a while after */
+    double LastDamagedTime = -1.0e9;
+
     // ============ Components ============
 
     UPROPERTY(VisibleAnywhere, Category = "Monster")
@@ -93,15 +115,38 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Monster")
     void TakeDamageFromPlayer(float DamageAmount);
 
+    /** Wake up from or park in UTowerMonsterPool: visibility, collision and tick together */
+    void SetPooledActive(bool bActive);
+
+    /**
+     * Park on (or wake with) a floor ATowerGameMode keeps resident: visibility,
+     * collision, tick and the proximity grid like SetPooledActive, but listeners
+     * and combat state are kept for when the floor comes back
+     */
+    void SetDormant(bool bDormant);
+
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMonsterDeath, ATowerMonster*, Monster);
 
     UPROPERTY(BlueprintAssignable, Category = "Monster")
     FOnMonsterDeath OnMonsterDeath;
 
-private:
     /** Get color based on monster element */
-    static FLinearColor GetElementColor(const FString& InElement);
+    static FLinearColor GetElementColor(EMonsterElement InElement);
 
     /** Get scale based on monster size */
-    static float GetSizeScale(const FString& InSize);
+    static float GetSizeScale(EMonsterSize InSize);
+
+private:
+    friend class UTowerMonsterAISubsystem;
+
+    /** Put living, active monsters on the proximity grid's Monster channel (at the current location) or take them off */
+    void UpdateProximity(bool bOnGrid);
+
+    /** Hand the monster's thinking to UTowerMonsterAISubsystem while it's alive and awake, or take it back */
+    void UpdateAI(bool bThinking);
+
+    int32 ProximityHandle = INDEX_NONE;
+
+    /** Slot in UTowerMonsterAISubsystem, or INDEX_NONE */
+    int32 AISlot = INDEX_NONE;
 };
@@ -0,0 +1,412 @@
+#include "ProximityQuerySubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+void UProximityQuerySubsystem::Deinitialize()
+{
+    Entries.Empty();
+    FreeSlots.Empty();
+    for (FChannelGrid& Grid : Grids)
+    {
+        Grid = FChannelGrid();
+    }
+    InRange.Empty();
+    Super::Deinitialize();
+}
+
+bool UProximityQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UProximityQuerySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UProximityQuerySubsystem, STATGROUP_Tickables);
+}
+
+// ============ Registration ============
+
+int32 UProximityQuerySubsystem::Register(AActor* Actor, EProximityChannel Channel, float Radius,
+    FOnProximityChanged OnChanged, int32 UserIndex)
+{
+    if (!Actor || Channel >= EProximityChannel::MAX) return INDEX_NONE;
+
+    const int32 Handle = FreeSlots.Num() > 0 ? FreeSlots.Pop(/*bAllowShrinking=*/false) : Entries.AddDefaulted();
+
+    FEntry& Entry = Entries[Handle];
+    Entry = FEntry();
+    Entry.Actor = Actor;
+    Entry.Location = Actor->GetActorLocation();
+    Entry.Radius = Radius;
+    Entry.UserIndex = UserIndex;
+    Entry.Channel = Channel;
+    Entry.OnChanged = MoveTemp(OnChanged);
+    Entry.bLive = true;
+
+    FChannelGrid& Grid = Grids[static_cast<int32>(Channel)];
+    Grid.NumEntries++;
+    if (Entry.OnChanged.IsBound())
+    {
+        Grid.MaxTrackedRadius = FMath::Max(Grid.MaxTrackedRadius, Radius);
+    }
+    AddToCell(Handle);
+    return Handle;
+}
+
+void UProximityQuerySubsystem::Unregister(int32 Handle)
+{
+    if (!Entries.IsValidIndex(Handle) || !Entries[Handle].bLive) return;
+
+    RemoveFromCell(Handle);
+    InRange.RemoveSingleSwap(Handle, /*bAllowShrinking=*/false);
+    Grids[static_cast<int32>(Entries[Handle].Channel)].NumEntries--;
+
+    Entries[Handle] = FEntry();
+    FreeSlots.Add(Handle);
+}
+
+void UProximityQuerySubsystem::UpdateLocation(int32 Handle, const FVector& Location)
+{
+    if (!Entries.IsValidIndex(Handle) || !Entries[Handle].bLive) return;
+
+    FEntry& Entry = Entries[Handle];
+    Entry.Location = Location;
+    if (GetCell(Location) == Entry.Cell)
+    {
+        Grids[static_cast<int32>(Entry.Channel)].Cells.FindChecked(Entry.Cell).Locations[Entry.CellIndex] = FVector3f(Location);
+    }
+    else
+    {
+        RemoveFromCell(Handle);
+        AddToCell(Handle);
+    }
+}
+
+bool UProximityQuerySubsystem::IsPlayerInRange(int32 Handle) const
+{
+    return Entries.IsValidIndex(Handle) && Entries[Handle].InRangePlayer.IsValid();
+}
+
+void UProximityQuerySubsystem::SetCellSize(float InCellSize)
+{
+    if (InCellSize <= 0.0f || InCellSize == CellSize) return;
+
+    CellSize = InCellSize;
+    for (FChannelGrid& Grid : Grids)
+    {
+        Grid.Cells.Reset();
+    }
+    for (int32 Handle = 0; Handle < Entries.Num(); Handle++)
+    {
+        if (Entries[Handle].bLive)
+        {
+            AddToCell(Handle);
+        }
+    }
+}
+
+// ============ Entries ============
+
+AActor* UProximityQuerySubsystem::GetActor(int32 Handle) const
+{
+    return Entries.IsValidIndex(Handle) ? Entries[Handle].Actor.Get() : nullptr;
+}
+
+FVector UProximityQuerySubsystem::GetLocation(int32 Handle) const
+{
+    return Entries.IsValidIndex(Handle) ? Entries[Handle].Location : FVector::ZeroVector;
+}
+
+int32 UProximityQuerySubsystem::GetUserIndex(int32 Handle) const
+{
+    return Entries.IsValidIndex(Handle) ? Entries[Handle].UserIndex : INDEX_NONE;
+}
+
+// ============ Grid ============
+
+FIntPoint UProximityQuerySubsystem::GetCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UProximityQuerySubsystem::AddToCell(int32 Handle)
+{
+    FEntry& Entry = Entries[Handle];
+    Entry.Cell = GetCell(Entry.Location);
+
+    FCell& Cell = Grids[static_cast<int32>(Entry.Channel)].Cells.FindOrAdd(Entry.Cell);
+    Entry.CellIndex = Cell.Handles.Add(Handle);
+    Cell.Locations.Add(FVector3f(Entry.Location));
+}
+
+void UProximityQuerySubsystem::RemoveFromCell(int32 Handle)
+{
+    FEntry& Entry = Entries[Handle];
+    TMap<FIntPoint, FCell>& Cells = Grids[static_cast<int32>(Entry.Channel)].Cells;
+    if (FCell* Cell = Cells.Find(Entry.Cell))
+    {
+        // The cell's last entry moves into this one's index
+        const int32 Index = Entry.CellIndex;
+        Cell->Handles.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/false);
+        Cell->Locations.RemoveAtSwap(Index, 1, /*bAllowShrinking=*/false);
+        if (Cell->Handles.IsValidIndex(Index))
+        {
+            Entries[Cell->Handles[Index]].CellIndex = Index;
+        }
+        else if (Cell->Handles.Num() == 0)
+        {
+            Cells.Remove(Entry.Cell);
+        }
+    }
+    Entry.CellIndex = INDEX_NONE;
+}
+
+template <typename FunctionType>
+void UProximityQuerySubsystem::ForEachCell(const FChannelGrid& Grid, const FIntPoint& MinCell, const FIntPoint& MaxCell,
+    FunctionType&& Function) const
+{
+    // A wide query over a sparse channel is cheaper as a walk over the cells there are
+    const int64 Area = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+    if (Area > Grid.Cells.Num())
+    {
+        for (const TPair<FIntPoint, FCell>& Pair : Grid.Cells)
+        {
+            if (Pair.Key.X >= MinCell.X && Pair.Key.X <= MaxCell.X && Pair.Key.Y >= MinCell.Y && Pair.Key.Y <= MaxCell.Y)
+            {
+                Function(Pair.Value);
+            }
+        }
+        return;
+    }
+
+    for (int32 CY = MinCell.Y; CY <= MaxCell.Y; CY++)
+    {
+        for (int32 CX = MinCell.X; CX <= MaxCell.X; CX++)
+        {
+            if (const FCell* Cell = Grid.Cells.Find(FIntPoint(CX, CY)))
+            {
+                Function(*Cell);
+            }
+        }
+    }
+}
+
+template <typename FunctionType>
+void UProximityQuerySubsystem::ForEachInRadius(const FChannelGrid& Grid, const FVector& Location, float Radius,
+    FunctionType&& Function) const
+{
+    const FVector3f Center(Location);
+    const float RadiusSq = Radius * Radius;
+
+    ForEachCell(Grid, GetCell(Location - FVector(Radius)), GetCell(Location + FVector(Radius)),
+        [&Center, RadiusSq, &Function](const FCell& Cell)
+        {
+            for (int32 i = 0; i < Cell.Locations.Num(); i++)
+            {
+                const float DistSq = FVector3f::DistSquared(Center, Cell.Locations[i]);
+                if (DistSq <= RadiusSq)
+                {
+                    Function(Cell.Handles[i], DistSq);
+                }
+            }
+        });
+}
+
+// ============ Queries ============
+
+void UProximityQuerySubsystem::QueryRadius(const FVector& Location, float Radius, EProximityChannel Channel,
+    TArray<int32>& OutHandles) const
+{
+    ForEachInRadius(Grids[static_cast<int32>(Channel)], Location, Radius, [&OutHandles](int32 Handle, float DistSq)
+    {
+        OutHandles.Add(Handle);
+    });
+}
+
+void UProximityQuerySubsystem::QueryRadius(const FVector& Location, float Radius, EProximityChannel Channel,
+    TArray<AActor*>& OutActors) const
+{
+    ForEachInRadius(Grids[static_cast<int32>(Channel)], Location, Radius, [this, &OutActors](int32 Handle, float DistSq)
+    {
+        if (AActor* Actor = Entries[Handle].Actor.Get())
+        {
+            OutActors.Add(Actor);
+        }
+    });
+}
+
+void UProximityQuerySubsystem::QueryBox(const FBox& Box, EProximityChannel Channel, TArray<int32>& OutHandles) const
+{
+    const FVector3f Min(Box.Min);
+    const FVector3f Max(Box.Max);
+    ForEachCell(Grids[static_cast<int32>(Channel)], GetCell(Box.Min), GetCell(Box.Max),
+        [&Min, &Max, &OutHandles](const FCell& Cell)
+        {
+            for (int32 i = 0; i < Cell.Locations.Num(); i++)
+            {
+                const FVector3f& P = Cell.Locations[i];
+                if (P.X >= Min.X && P.X <= Max.X && P.Y >= Min.Y && P.Y <= Max.Y && P.Z >= Min.Z && P.Z <= Max.Z)
+                {
+                    OutHandles.Add(Cell.Handles[i]);
+                }
+            }
+        });
+}
+
+void UProximityQuerySubsystem::QueryNearest(const FVector& Location, float Radius, int32 K, EProximityChannel Channel,
+    TArray<int32>& OutHandles) const
+{
+    OutHandles.Reset();
+    const FChannelGrid& Grid = Grids[static_cast<int32>(Channel)];
+    if (K <= 0 || Grid.NumEntries == 0) return;
+
+    // The best K so far as (DistSq, Handle), farthest on top
+    TArray<TPair<float, int32>, TInlineAllocator<16>> Best;
+    const auto FarthestFirst = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; };
+
+    const FVector3f Center(Location);
+    const float RadiusSq = Radius * Radius;
+    const auto VisitCell = [&](const FCell& Cell)
+    {
+        for (int32 i = 0; i < Cell.Locations.Num(); i++)
+        {
+            const float DistSq = FVector3f::DistSquared(Center, Cell.Locations[i]);
+            if (DistSq > RadiusSq) continue;
+
+            if (Best.Num() < K)
+            {
+                Best.HeapPush(TPair<float, int32>(DistSq, Cell.Handles[i]), FarthestFirst);
+            }
+            else if (DistSq < Best.HeapTop().Key)
+            {
+                Best.HeapPopDiscard(FarthestFirst, /*bAllowShrinking=*/false);
+                Best.HeapPush(TPair<float, int32>(DistSq, Cell.Handles[i]), FarthestFirst);
+            }
+        }
+    };
+
+    const FIntPoint Home = GetCell(Location);
+    const int32 MaxRing = FMath::CeilToInt(Radius / CellSize);
+    const int64 Side = 2 * int64(MaxRing) + 1;
+    if (Side * Side > Grid.Cells.Num())
+    {
+        // Sparse channel: fewer cells in all than in the square
+        ForEachCell(Grid, Home - FIntPoint(MaxRing), Home + FIntPoint(MaxRing), VisitCell);
+    }
+    else
+    {
+        // Rings of cells outward; everything past ring R is more than R cells away
+        for (int32 Ring = 0; Ring <= MaxRing; Ring++)
+        {
+            const auto VisitAt = [&](int32 CX, int32 CY)
+            {
+                if (const FCell* Cell = Grid.Cells.Find(FIntPoint(CX, CY)))
+                {
+                    VisitCell(*Cell);
+                }
+            };
+            for (int32 CX = Home.X - Ring; CX <= Home.X + Ring; CX++)
+            {
+                VisitAt(CX, Home.Y - Ring);
+                if (Ring > 0) VisitAt(CX, Home.Y + Ring);
+            }
+            for (int32 CY = Home.Y - Ring + 1; CY <= Home.Y + Ring - 1; CY++)
+            {
+                VisitAt(Home.X - Ring, CY);
+                VisitAt(Home.X + Ring, CY);
+            }
+
+            if (Best.Num() == K && Best.HeapTop().Key <= FMath::Square(Ring * CellSize)) break;
+        }
+    }
+
+    Best.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+    for (const TPair<float, int32>& Pair : Best)
+    {
+        OutHandles.Add(Pair.Value);
+    }
+}
+
+AActor* UProximityQuerySubsystem::FindNearest(const FVector& Location, float Radius, EProximityChannel Channel) const
+{
+    TArray<int32> Nearest;
+    QueryNearest(Location, Radius, 1, Channel, Nearest);
+    return Nearest.Num() > 0 ? Entries[Nearest[0]].Actor.Get() : nullptr;
+}
+
+// ============ Update ============
+
+void UProximityQuerySubsystem::Tick(float DeltaTime)
+{
+    TimeSinceUpdate += DeltaTime;
+    if (TimeSinceUpdate < UpdateInterval) return;
+    TimeSinceUpdate = 0.0f;
+
+    UpdateTracked();
+}
+
+void UProximityQuerySubsystem::UpdateTracked()
+{
+    struct FChange
+    {
+        int32 Handle;
+        TWeakObjectPtr<AActor> Actor;
+        APawn* Player;
+        bool bInRange;
+    };
+    TArray<FChange, TInlineAllocator<8>> Changes;
+
+    Pass++;
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        APlayerController* PC = It->Get();
+        APawn* Player = PC ? PC->GetPawn() : nullptr;
+        if (!Player) continue;
+
+        const FVector PlayerLocation = Player->GetActorLocation();
+        for (const FChannelGrid& Grid : Grids)
+        {
+            if (Grid.MaxTrackedRadius <= 0.0f) continue;
+
+            ForEachInRadius(Grid, PlayerLocation, Grid.MaxTrackedRadius, [this, Player, &Changes](int32 Handle, float DistSq)
+            {
+                FEntry& Entry = Entries[Handle];
+                if (!Entry.OnChanged.IsBound() || Entry.SeenPass == Pass) return;
+                if (DistSq > Entry.Radius * Entry.Radius) return;
+
+                Entry.SeenPass = Pass;
+                if (!Entry.InRangePlayer.IsValid())
+                {
+                    InRange.Add(Handle);
+                    Changes.Add(FChange{ Handle, Entry.Actor, Player, true });
+                }
+                Entry.InRangePlayer = Player;
+            });
+        }
+    }
+
+    for (int32 i = InRange.Num() - 1; i >= 0; i--)
+    {
+        FEntry& Entry = Entries[InRange[i]];
+        if (Entry.SeenPass != Pass)
+        {
+            Changes.Add(FChange{ InRange[i], Entry.Actor, Entry.InRangePlayer.Get(), false });
+            Entry.InRangePlayer.Reset();
+            InRange.RemoveAtSwap(i, 1, /*bAllowShrinking=*/false);
+        }
+    }
+
+    // Handlers may register or unregister, so they run after the grid walk and
+    // are skipped if their entry went away (or its slot was reused) meanwhile
+    for (const FChange& Change : Changes)
+    {
+        const FEntry& Entry = Entries[Change.Handle];
+        if (Entry.bLive && Entry.Actor == Change.Actor && Change.Actor.IsValid())
+        {
+            // Copied: a Register from the handler can reallocate Entries
+            FOnProximityChanged OnChanged = Entry.OnChanged;
+            OnChanged.ExecuteIfBound(Change.Player, Change.bInRange);
+        }
+    }
+}
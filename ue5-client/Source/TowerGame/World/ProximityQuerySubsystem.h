@@ -0,0 +1,171 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProximityQuerySubsystem.generated.h"
+
+/** What a proximity entry is, so queries only walk the kind they ask for */
+UENUM()
+enum class EProximityChannel : uint8
+{
+    Interactable,
+    NPC,
+    Monster,
+    Loot,
+    Echo,
+    Player,
+
+    MAX UMETA(Hidden)
+};
+
+/** A player came within (bInRange) or left a tracked entry's radius */
+DECLARE_DELEGATE_TwoParams(FOnProximityChanged, APawn* /*Player*/, bool /*bInRange*/);
+
+/**
+ * The world's spatial index: a uniform grid over the floor answering radius,
+ * box and nearest-K queries without collision. Players, monsters, loot,
+ * echoes, NPCs and interactables all register here, so gameplay proximity
+ * runs against one structure that is kept up to date as things move. The
+ * cell size follows the floor tile size (the GameMode sets it), so a query
+ * visits a few cells and the entries in them.
+ *
+ * Every channel has its own grid, and a cell keeps its entries' positions
+ * packed next to their handles, so a query only walks contiguous memory of
+ * the kind it asks for. Handles are dense slot indices (reused after
+ * Unregister). Handle queries return them, and owners with their own per-slot
+ * state map them back through the UserIndex given to Register. A move inside
+ * a cell is one write; a move across cells is a swap-remove and an append.
+ *
+ * Entries with an OnChanged delegate are tracked: every UpdateInterval the
+ * player pawns look up the cells around them and tracked entries hear about
+ * players entering and leaving their radius. This replaces per-actor overlap
+ * spheres and ticks for interaction prompts. Untracked entries (monsters,
+ * loot, echoes, players) only answer queries.
+ *
+ * Entries are static unless their owner calls UpdateLocation.
+ */
+UCLASS()
+class TOWERGAME_API UProximityQuerySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ============ Registration ============
+
+    /**
+     * Add Actor at its current location; returns the handle to pass back.
+     * UserIndex is the owner's own slot for the entry, see GetUserIndex.
+     */
+    int32 Register(AActor* Actor, EProximityChannel Channel, float Radius,
+        FOnProximityChanged OnChanged = FOnProximityChanged(), int32 UserIndex = INDEX_NONE);
+    void Unregister(int32 Handle);
+
+    void UpdateLocation(int32 Handle, const FVector& Location);
+
+    /** Whether a player was within the tracked entry's radius at the last update */
+    bool IsPlayerInRange(int32 Handle) const;
+
+    // ============ Entries ============
+
+    /** Null if the handle is free or its actor is gone */
+    AActor* GetActor(int32 Handle) const;
+    FVector GetLocation(int32 Handle) const;
+    int32 GetUserIndex(int32 Handle) const;
+
+    int32 GetNumEntries(EProximityChannel Channel) const { return Grids[static_cast<int32>(Channel)].NumEntries; }
+
+    // ============ Queries ============
+
+    /** Appends the handles of the Channel entries within Radius of Location */
+    void QueryRadius(const FVector& Location, float Radius, EProximityChannel Channel, TArray<int32>& OutHandles) const;
+
+    /** Appends the Channel entries within Radius of Location to OutActors */
+    void QueryRadius(const FVector& Location, float Radius, EProximityChannel Channel, TArray<AActor*>& OutActors) const;
+
+    /** Appends the handles of the Channel entries inside Box */
+    void QueryBox(const FBox& Box, EProximityChannel Channel, TArray<int32>& OutHandles) const;
+
+    /** Replaces OutHandles with the (up to) K nearest Channel entries within Radius of Location, nearest first */
+    void QueryNearest(const FVector& Location, float Radius, int32 K, EProximityChannel Channel,
+        TArray<int32>& OutHandles) const;
+
+    /** Closest Channel entry within Radius of Location, or null */
+    AActor* FindNearest(const FVector& Location, float Radius, EProximityChannel Channel) const;
+
+    // ============ Config ============
+
+    /** Re-bucket every entry; call with the floor tile size */
+    void SetCellSize(float InCellSize);
+    float GetCellSize() const { return CellSize; }
+
+    /** Seconds between tracked-entry updates */
+    float UpdateInterval = 0.1f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FVector Location = FVector::ZeroVector;
+        float Radius = 0.0f;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+        /** Position in the cell's arrays */
+        int32 CellIndex = INDEX_NONE;
+        int32 UserIndex = INDEX_NONE;
+        EProximityChannel Channel = EProximityChannel::Interactable;
+        FOnProximityChanged OnChanged;
+
+        /** Player currently in range (tracked entries) */
+        TWeakObjectPtr<APawn> InRangePlayer;
+        /** Last update pass a player was found in range */
+        uint32 SeenPass = 0;
+        bool bLive = false;
+    };
+
+    /** Entries bucketed in one cell; Locations[i] is Handles[i]'s */
+    struct FCell
+    {
+        TArray<FVector3f, TInlineAllocator<8>> Locations;
+        TArray<int32, TInlineAllocator<8>> Handles;
+    };
+
+    struct FChannelGrid
+    {
+        TMap<FIntPoint, FCell> Cells;
+        int32 NumEntries = 0;
+
+        /** Largest tracked Radius, bounds the cells each player visits */
+        float MaxTrackedRadius = 0.0f;
+    };
+
+    FIntPoint GetCell(const FVector& Location) const;
+    void AddToCell(int32 Handle);
+    void RemoveFromCell(int32 Handle);
+
+    /** Every cell of Grid overlapping [MinCell, MaxCell], or all of them if that's fewer */
+    template <typename FunctionType>
+    void ForEachCell(const FChannelGrid& Grid, const FIntPoint& MinCell, const FIntPoint& MaxCell, FunctionType&& Function) const;
+
+    template <typename FunctionType>
+    void ForEachInRadius(const FChannelGrid& Grid, const FVector& Location, float Radius, FunctionType&& Function) const;
+
+    void UpdateTracked();
+
+    float CellSize = 300.0f;
+
+    TArray<FEntry> Entries;
+    TArray<int32> FreeSlots;
+    FChannelGrid Grids[static_cast<int32>(EProximityChannel::MAX)];
+
+    /** Handles of tracked entries with a player in range */
+    TArray<int32> InRange;
+
+    float TimeSinceUpdate = 0.0f;
+    uint32 Pass = 0;
+};
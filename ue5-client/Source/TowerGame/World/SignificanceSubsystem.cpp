@@ -0,0 +1,154 @@
+#include "SignificanceSubsystem.h"
+#include "Components/ActorComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void UTowerSignificanceSubsystem::Deinitialize()
+{
+    Entries.Empty();
+    IndexByActor.Empty();
+    Super::Deinitialize();
+}
+
+bool UTowerSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+// ============ Registration ============
+
+void UTowerSignificanceSubsystem::Register(AActor* Actor, bool bAllowDisable, FOnTowerSignificanceChanged OnChanged)
+{
+    if (!Actor || IndexByActor.Contains(Actor)) return;
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Actor = Actor;
+    Entry.Key = Actor;
+    Entry.bAllowDisable = bAllowDisable;
+    Entry.OnChanged = MoveTemp(OnChanged);
+    IndexByActor.Add(Actor, Entries.Num() - 1);
+}
+
+void UTowerSignificanceSubsystem::Unregister(AActor* Actor)
+{
+    int32 Index = INDEX_NONE;
+    if (!Actor || !IndexByActor.RemoveAndCopyValue(Actor, Index)) return;
+
+    // Hand the actor back at full rate in case it lives on (e.g. pooled)
+    Apply(Entries[Index], ETowerSignificance::Near, 0.0f);
+
+    Entries.RemoveAtSwap(Index, 1, false);
+    if (Entries.IsValidIndex(Index))
+    {
+        // The last entry moved into the hole
+        IndexByActor.Add(Entries[Index].Key, Index);
+    }
+}
+
+ETowerSignificance UTowerSignificanceSubsystem::GetSignificance(const AActor* Actor) const
+{
+    const int32* Index = IndexByActor.Find(Actor);
+    return Index ? Entries[*Index].Significance : ETowerSignificance::Near;
+}
+
+// ============ Evaluation ============
+
+void UTowerSignificanceSubsystem::Tick(float DeltaTime)
+{
+    TimeSinceEvaluation += DeltaTime;
+    if (TimeSinceEvaluation < EvaluationInterval || Entries.Num() == 0) return;
+    TimeSinceEvaluation = 0.0f;
+
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    if (!PC || !PC->PlayerCameraManager) return;
+
+    const FVector CameraLocation = PC->PlayerCameraManager->GetCameraLocation();
+    const float NearDistSq = FMath::Square(NearDistance);
+    const float VisibleDistSq = FMath::Square(VisibleDistance);
+
+    for (int32 i = Entries.Num() - 1; i >= 0; --i)
+    {
+        FEntry& Entry = Entries[i];
+        AActor* Actor = Entry.Actor.Get();
+        if (!Actor)
+        {
+            // Destroyed without EndPlay reaching us (world teardown)
+            IndexByActor.Remove(Entry.Key);
+            Entries.RemoveAtSwap(i, 1, false);
+            if (Entries.IsValidIndex(i))
+            {
+                IndexByActor.Add(Entries[i].Key, i);
+            }
+            continue;
+        }
+
+        const float DistSq = FVector::DistSquared(Actor->GetActorLocation(), CameraLocation);
+        ETowerSignificance Significance;
+        if (DistSq <= NearDistSq)
+        {
+            Significance = ETowerSignificance::Near;
+        }
+        else
+        {
+            const bool bOnScreen = Actor->WasRecentlyRendered(OnScreenTime);
+            const bool bInRange = DistSq <= VisibleDistSq;
+            Significance = bOnScreen && bInRange ? ETowerSignificance::Visible
+                : (bOnScreen || bInRange) ? ETowerSignificance::Distant
+                : ETowerSignificance::Dormant;
+        }
+
+        if (Significance != Entry.Significance)
+        {
+            Apply(Entry, Significance, FMath::Sqrt(DistSq));
+        }
+    }
+}
+
+void UTowerSignificanceSubsystem::Apply(FEntry& Entry, ETowerSignificance Significance, float Distance)
+{
+    Entry.Significance = Significance;
+    AActor* Actor = Entry.Actor.Get();
+    if (!Actor) return;
+
+    float Interval = 0.0f;
+    switch (Significance)
+    {
+    case ETowerSignificance::Distant: Interval = DistantTickInterval; break;
+    case ETowerSignificance::Dormant: Interval = DormantTickInterval; break;
+    default: break;
+    }
+
+    const bool bSleep = Significance == ETowerSignificance::Dormant && Entry.bAllowDisable;
+    if (bSleep != Entry.bSleeping)
+    {
+        // Only undo our own switch-off; a pooled or finished actor stays off
+        if (bSleep && Actor->IsActorTickEnabled())
+        {
+            Actor->SetActorTickEnabled(false);
+            Entry.bSleeping = true;
+        }
+        else if (!bSleep)
+        {
+            Actor->SetActorTickEnabled(true);
+            Entry.bSleeping = false;
+        }
+    }
+
+    Actor->SetActorTickInterval(Interval);
+    for (UActorComponent* Component : Actor->GetComponents())
+    {
+        if (Component && Component->PrimaryComponentTick.bCanEverTick)
+        {
+            Component->SetComponentTickInterval(Interval);
+        }
+    }
+
+    Entry.OnChanged.ExecuteIfBound(Significance, Distance);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SignificanceSubsystem.generated.h"
+
+/** How much an actor matters to the local view right now, most significant first */
+UENUM(BlueprintType)
+enum class ETowerSignificance : uint8
+{
+    /** Within NearDistance of the camera, seen or not: full rate */
+    Near,
+    /** On screen within VisibleDistance: full rate */
+    Visible,
+    /** On screen beyond VisibleDistance, or off screen within it */
+    Distant,
+    /** Off screen beyond VisibleDistance */
+    Dormant,
+};
+
+/** Bucket change of one actor, with its distance to the camera at the time */
+DECLARE_DELEGATE_TwoParams(FOnTowerSignificanceChanged, ETowerSignificance /*Significance*/, float /*Distance*/);
+
+/**
+ * Throttles the ticks of world actors (remote players, monsters; loot and
+ * echoes are batched by ULootPickupSubsystem and UEchoGhostSubsystem, and
+ * interaction range comes from UProximityQuerySubsystem) by distance to the
+ * camera and whether they were rendered recently. Actors register in
+ * BeginPlay; every EvaluationInterval each one is bucketed and, when its
+ * bucket changes, its actor and component tick intervals are set from that
+ * bucket. Dormant actors that allow it stop ticking entirely; the rest tick at
+ * DormantTickInterval so lifetimes keep counting down.
+ *
+ * Tick intervals hand the elapsed time to Tick as DeltaTime, so timers stay
+ * correct at any rate; only the smoothness of the motion drops. Actors that do
+ * more than that per bucket (remote player LOD tiers) pass OnChanged, called
+ * after the intervals are set.
+ */
+UCLASS()
+class TOWERGAME_API UTowerSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // ============ Registration ============
+
+    /**
+     * Start managing Actor's tick rate. bAllowDisable lets Dormant switch its
+     * tick off instead of slowing it, for actors with no time-based state.
+     */
+    void Register(AActor* Actor, bool bAllowDisable = false, FOnTowerSignificanceChanged OnChanged = FOnTowerSignificanceChanged());
+    void Unregister(AActor* Actor);
+
+    /** Bucket Actor was last put in (Near if it isn't registered) */
+    ETowerSignificance GetSignificance(const AActor* Actor) const;
+
+    int32 GetNumRegistered() const { return Entries.Num(); }
+
+    // ============ Config ============
+
+    float NearDistance = 1500.0f;
+    float VisibleDistance = 6000.0f;
+
+    /** Seconds since last render for an actor to still count as on screen */
+    float OnScreenTime = 0.25f;
+
+    /** Seconds between re-bucketing passes */
+    float EvaluationInterval = 0.2f;
+
+    float DistantTickInterval = 0.2f;
+    float DormantTickInterval = 1.0f;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FEntry
+    {
+        TWeakObjectPtr<AActor> Actor;
+        /** IndexByActor key, still valid once Actor is gone */
+        TObjectKey<AActor> Key;
+        ETowerSignificance Significance = ETowerSignificance::Near;
+        bool bAllowDisable = false;
+        /** Tick was switched off by us (Dormant) and must be switched back on */
+        bool bSleeping = false;
+        FOnTowerSignificanceChanged OnChanged;
+    };
+
+    /** Put the actor's ticks at the rate of Significance */
+    void Apply(FEntry& Entry, ETowerSignificance Significance, float Distance);
+
+    TArray<FEntry> Entries;
+    TMap<TObjectKey<AActor>, int32> IndexByActor;
+
+    float TimeSinceEvaluation = 0.0f;
+};
@@ -0,0 +1,264 @@
+#include "StatusEffectSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+static_assert(TowerStatus::NumTypes <= UTowerStatusEffectSubsystem::Lanes, "A slot has a lane per effect type");
+static_assert(UTowerStatusEffectSubsystem::Lanes % 4 == 0, "Lanes are swept four at a time");
+
+namespace
+{
+    constexpr uint32 AllTypesMask = (1u << TowerStatus::NumTypes) - 1;
+}
+
+void UTowerStatusEffectSubsystem::Deinitialize()
+{
+    SlotByEntity.Empty();
+    SlotEntities.Empty();
+    ActiveMasks.Empty();
+    Expiries.Empty();
+    Durations.Empty();
+    Strengths.Empty();
+    Stacks.Empty();
+    OnChanged.Clear();
+    Super::Deinitialize();
+}
+
+bool UTowerStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTowerStatusEffectSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTowerStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+int64 UTowerStatusEffectSubsystem::GetActorHandle(const AActor* Actor)
+{
+    return Actor ? static_cast<int64>(Actor->GetUniqueID()) : 0;
+}
+
+float UTowerStatusEffectSubsystem::GetNow() const
+{
+    const UWorld* World = GetWorld();
+    return World ? static_cast<float>(World->GetTimeSeconds()) : 0.0f;
+}
+
+void UTowerStatusEffectSubsystem::Tick(float DeltaTime)
+{
+    const float Now = GetNow();
+    if (Now >= NextExpiry)
+    {
+        Sweep(Now);
+    }
+}
+
+// ============ Mutation ============
+
+void UTowerStatusEffectSubsystem::ApplyEffect(int64 Entity, EStatusType Type, float Duration, float Strength, int32 InStacks)
+{
+    if (Duration <= 0.0f || InStacks <= 0) return;
+
+    const int32 Slot = FindOrAddSlot(Entity);
+    const int32 Lane = Slot * Lanes + static_cast<int32>(Type);
+    const uint32 Bit = TowerStatus::Bit(Type);
+    const float Expiry = GetNow() + Duration;
+
+    if (ActiveMasks[Slot] & Bit)
+    {
+        // Refresh/stack; an effect that lasts until removed keeps doing so
+        Expiries[Lane] = FMath::Max(Expiries[Lane], Expiry);
+        Strengths[Lane] = FMath::Max(Strengths[Lane], Strength);
+        Stacks[Lane] = static_cast<uint8>(FMath::Min<int32>(Stacks[Lane] + InStacks, MaxStacks));
+    }
+    else
+    {
+        Expiries[Lane] = Expiry;
+        Strengths[Lane] = Strength;
+        Stacks[Lane] = static_cast<uint8>(FMath::Min(InStacks, MaxStacks));
+    }
+    Durations[Lane] = Duration;
+    NextExpiry = FMath::Min(NextExpiry, Expiries[Lane]);
+
+    SetMask(Slot, ActiveMasks[Slot] | Bit);
+}
+
+void UTowerStatusEffectSubsystem::RemoveEffect(int64 Entity, EStatusType Type)
+{
+    const int32* Slot = SlotByEntity.Find(Entity);
+    const uint32 Bit = TowerStatus::Bit(Type);
+    if (!Slot || !(ActiveMasks[*Slot] & Bit)) return;
+
+    Expiries[*Slot * Lanes + static_cast<int32>(Type)] = MAX_flt;
+    SetMask(*Slot, ActiveMasks[*Slot] & ~Bit);
+}
+
+void UTowerStatusEffectSubsystem::SetEffectMask(int64 Entity, uint32 Mask)
+{
+    Mask &= AllTypesMask;
+    const int32* Found = SlotByEntity.Find(Entity);
+    if (!Found && Mask == 0) return;
+
+    const int32 Slot = Found ? *Found : FindOrAddSlot(Entity);
+    const uint32 Old = ActiveMasks[Slot];
+    if (Old == Mask) return;
+
+    const int32 Base = Slot * Lanes;
+    for (uint32 Gained = Mask & ~Old; Gained; Gained &= Gained - 1)
+    {
+        const int32 Lane = Base + FMath::CountTrailingZeros(Gained);
+        Expiries[Lane] = MAX_flt;
+        Durations[Lane] = 0.0f;
+        Strengths[Lane] = 1.0f;
+        Stacks[Lane] = 1;
+    }
+    for (uint32 Lost = Old & ~Mask; Lost; Lost &= Lost - 1)
+    {
+        Expiries[Base + FMath::CountTrailingZeros(Lost)] = MAX_flt;
+    }
+
+    SetMask(Slot, Mask);
+}
+
+void UTowerStatusEffectSubsystem::RemoveEntity(int64 Entity)
+{
+    const int32* Slot = SlotByEntity.Find(Entity);
+    if (!Slot) return;
+
+    const uint32 Old = ActiveMasks[*Slot];
+    RemoveSlot(*Slot);
+    OnChanged.Broadcast(Entity, Old, 0);
+}
+
+// ============ Queries ============
+
+uint32 UTowerStatusEffectSubsystem::GetEffectMask(int64 Entity) const
+{
+    const int32* Slot = SlotByEntity.Find(Entity);
+    return Slot ? ActiveMasks[*Slot] : 0;
+}
+
+bool UTowerStatusEffectSubsystem::GetEffect(int64 Entity, EStatusType Type, FTowerStatusEffectState& OutState) const
+{
+    const int32* Slot = SlotByEntity.Find(Entity);
+    if (!Slot || !(ActiveMasks[*Slot] & TowerStatus::Bit(Type))) return false;
+
+    const int32 Lane = *Slot * Lanes + static_cast<int32>(Type);
+    OutState.RemainingTime = Expiries[Lane] == MAX_flt ? MAX_flt : FMath::Max(Expiries[Lane] - GetNow(), 0.0f);
+    OutState.TotalDuration = Durations[Lane];
+    OutState.Strength = Strengths[Lane];
+    OutState.Stacks = Stacks[Lane];
+    return true;
+}
+
+// ============ Storage ============
+
+int32 UTowerStatusEffectSubsystem::FindOrAddSlot(int64 Entity)
+{
+    if (const int32* Found = SlotByEntity.Find(Entity))
+    {
+        return *Found;
+    }
+
+    const int32 Slot = SlotEntities.Add(Entity);
+    ActiveMasks.Add(0);
+    const int32 First = Expiries.AddUninitialized(Lanes);
+    for (int32 Lane = First; Lane < First + Lanes; ++Lane)
+    {
+        Expiries[Lane] = MAX_flt;
+    }
+    Durations.AddZeroed(Lanes);
+    Strengths.AddZeroed(Lanes);
+    Stacks.AddZeroed(Lanes);
+    SlotByEntity.Add(Entity, Slot);
+    return Slot;
+}
+
+void UTowerStatusEffectSubsystem::RemoveSlot(int32 Slot)
+{
+    const int32 Last = SlotEntities.Num() - 1;
+    SlotByEntity.Remove(SlotEntities[Slot]);
+    if (Slot != Last)
+    {
+        SlotEntities[Slot] = SlotEntities[Last];
+        ActiveMasks[Slot] = ActiveMasks[Last];
+        FMemory::Memcpy(&Expiries[Slot * Lanes], &Expiries[Last * Lanes], Lanes * sizeof(float));
+        FMemory::Memcpy(&Durations[Slot * Lanes], &Durations[Last * Lanes], Lanes * sizeof(float));
+        FMemory::Memcpy(&Strengths[Slot * Lanes], &Strengths[Last * Lanes], Lanes * sizeof(float));
+        FMemory::Memcpy(&Stacks[Slot * Lanes], &Stacks[Last * Lanes], Lanes * sizeof(uint8));
+        SlotByEntity[SlotEntities[Slot]] = Slot;
+    }
+
+    SlotEntities.Pop(EAllowShrinking::No);
+    ActiveMasks.Pop(EAllowShrinking::No);
+    Expiries.SetNum(Last * Lanes, EAllowShrinking::No);
+    Durations.SetNum(Last * Lanes, EAllowShrinking::No);
+    Strengths.SetNum(Last * Lanes, EAllowShrinking::No);
+    Stacks.SetNum(Last * Lanes, EAllowShrinking::No);
+}
+
+void UTowerStatusEffectSubsystem::SetMask(int32 Slot, uint32 NewMask)
+{
+    const int64 Entity = SlotEntities[Slot];
+    const uint32 Old = ActiveMasks[Slot];
+    ActiveMasks[Slot] = NewMask;
+    if (NewMask == 0)
+    {
+        RemoveSlot(Slot);
+    }
+
+    // Listeners see the store as it is after the change
+    OnChanged.Broadcast(Entity, Old, NewMask);
+}
+
+void UTowerStatusEffectSubsystem::Sweep(float Now)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(TowerStatusEffects_Sweep);
+
+    const VectorRegister4Float NowVec = VectorSetFloat1(Now);
+    VectorRegister4Float Earliest = VectorSetFloat1(MAX_flt);
+    SweepChanges.Reset();
+
+    // Backwards, so a slot swapped into an emptied one has already been swept
+    for (int32 Slot = SlotEntities.Num() - 1; Slot >= 0; --Slot)
+    {
+        float* Row = Expiries.GetData() + Slot * Lanes;
+        uint32 Expired = 0;
+        for (int32 Lane = 0; Lane < Lanes; Lane += 4)
+        {
+            const VectorRegister4Float Expiry = VectorLoadAligned(Row + Lane);
+            Expired |= static_cast<uint32>(VectorMaskBits(VectorCompareLE(Expiry, NowVec))) << Lane;
+        }
+
+        for (uint32 Bits = Expired; Bits; Bits &= Bits - 1)
+        {
+            Row[FMath::CountTrailingZeros(Bits)] = MAX_flt;
+        }
+        for (int32 Lane = 0; Lane < Lanes; Lane += 4)
+        {
+            Earliest = VectorMin(Earliest, VectorLoadAligned(Row + Lane));
+        }
+
+        if (Expired != 0)
+        {
+            const uint32 Old = ActiveMasks[Slot];
+            const uint32 New = Old & ~Expired;
+            SweepChanges.Emplace(SlotEntities[Slot], Old, New);
+            ActiveMasks[Slot] = New;
+            if (New == 0)
+            {
+                RemoveSlot(Slot);
+            }
+        }
+    }
+
+    float EarliestLanes[4];
+    VectorStore(Earliest, EarliestLanes);
+    NextExpiry = FMath::Min(FMath::Min(EarliestLanes[0], EarliestLanes[1]), FMath::Min(EarliestLanes[2], EarliestLanes[3]));
+
+    for (const TTuple<int64, uint32, uint32>& Change : SweepChanges)
+    {
+        OnChanged.Broadcast(Change.Get<0>(), Change.Get<1>(), Change.Get<2>());
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusEffectSubsystem.generated.h"
+
+/**
+ * Status effect types matching Rust combat/status.rs. The value is the
+ * effect's bit in a status mask, the server's status bits layout (bit N-1 =
+ * EMonsterStatusEffect N).
+ */
+UENUM(BlueprintType)
+enum class EStatusType : uint8
+{
+    // DoT
+    Burning         UMETA(DisplayName = "Burning"),
+    Poisoned        UMETA(DisplayName = "Poisoned"),
+    Bleeding        UMETA(DisplayName = "Bleeding"),
+
+    // CC
+    Stunned         UMETA(DisplayName = "Stunned"),
+    Frozen          UMETA(DisplayName = "Frozen"),
+    Silenced        UMETA(DisplayName = "Silenced"),
+
+    // Debuffs
+    Weakened        UMETA(DisplayName = "Weakened"),
+    Slowed          UMETA(DisplayName = "Slowed"),
+    Exposed         UMETA(DisplayName = "Exposed"),
+    Corrupted       UMETA(DisplayName = "Corrupted"),
+
+    // Buffs
+    Empowered       UMETA(DisplayName = "Empowered"),
+    Hastened        UMETA(DisplayName = "Hastened"),
+    Shielded        UMETA(DisplayName = "Shielded"),
+    Regenerating    UMETA(DisplayName = "Regenerating"),
+    SemanticFocus   UMETA(DisplayName = "Semantic Focus"),
+};
+
+namespace TowerStatus
+{
+    constexpr int32 NumTypes = static_cast<int32>(EStatusType::SemanticFocus) + 1;
+
+    constexpr uint32 Bit(EStatusType Type) { return 1u << static_cast<uint32>(Type); }
+}
+
+/** One active effect on one entity */
+struct FTowerStatusEffectState
+{
+    /** Seconds left; MAX_flt for effects that last until removed (TotalDuration 0) */
+    float RemainingTime = 0.0f;
+    float TotalDuration = 0.0f;
+    float Strength = 1.0f;
+    int32 Stacks = 1;
+};
+
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnStatusEffectsChanged, int64 /*Entity*/, uint32 /*OldMask*/, uint32 /*NewMask*/);
+
+/**
+ * Every status effect on every monster and player in the world, in one place:
+ * UI and VFX read it and bind OnChanged instead of each counting effects down
+ * themselves.
+ *
+ * Entities are int64 handles: a replicated entity's EntityId, or GetActorHandle
+ * for a local actor. Each entity with effects has a slot in structure-of-arrays
+ * storage: its mask of active effects and, per effect type, its expiry (world
+ * seconds, packed Lanes to a slot so a slot's expiries are four vector
+ * compares), duration, strength and stacks. Effects set by mask (the server
+ * sends no timings) never expire here; a later mask drops them.
+ *
+ * The expiry sweep runs only once the earliest expiry has passed. OnChanged is
+ * broadcast for every gain, loss and refresh (masks equal); the sweep's after
+ * it has finished. Game thread only.
+ */
+UCLASS()
+class TOWERGAME_API UTowerStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    /** The handle a local actor's effects are kept under (its object id; server entity ids are hashes) */
+    static int64 GetActorHandle(const AActor* Actor);
+
+    // ============ Mutation ============
+
+    /** Add or refresh an effect: the later expiry and the stronger strength win, stacks add up to MaxStacks */
+    void ApplyEffect(int64 Entity, EStatusType Type, float Duration, float Strength = 1.0f, int32 Stacks = 1);
+
+    void RemoveEffect(int64 Entity, EStatusType Type);
+
+    /**
+     * Make Mask the entity's effects, as the server reports them: effects it
+     * gains last until a later mask drops them, effects it keeps are untouched
+     */
+    void SetEffectMask(int64 Entity, uint32 Mask);
+
+    /** Drop all of the entity's effects, e.g. when it despawns */
+    void RemoveEntity(int64 Entity);
+
+    // ============ Queries ============
+
+    uint32 GetEffectMask(int64 Entity) const;
+
+    bool HasEffect(int64 Entity, EStatusType Type) const { return (GetEffectMask(Entity) & TowerStatus::Bit(Type)) != 0; }
+
+    /** The effect's state; false if the entity doesn't have it */
+    bool GetEffect(int64 Entity, EStatusType Type, FTowerStatusEffectState& OutState) const;
+
+    int32 GetNumEntities() const { return SlotEntities.Num(); }
+
+    /** Gains, losses and refreshes, per entity */
+    FOnStatusEffectsChanged OnChanged;
+
+    /** Stacks an effect can build up to */
+    int32 MaxStacks = 5;
+
+    /** Per-slot stride of the lane arrays: NumTypes rounded up to whole vectors */
+    static constexpr int32 Lanes = 16;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    int32 FindOrAddSlot(int64 Entity);
+    void RemoveSlot(int32 Slot);
+
+    /** Set the slot's mask and broadcast the change (also when equal: a refresh) */
+    void SetMask(int32 Slot, uint32 NewMask);
+
+    /** Expire everything due by Now and find the next expiry */
+    void Sweep(float Now);
+
+    float GetNow() const;
+
+    TMap<int64, int32> SlotByEntity;
+
+    // Per slot
+    TArray<int64> SlotEntities;
+    TArray<uint32> ActiveMasks;
+
+    // Per slot x Lanes; lanes of inactive or untimed effects keep MAX_flt expiries
+    TArray<float, TAlignedHeapAllocator<16>> Expiries;
+    TArray<float> Durations;
+    TArray<float> Strengths;
+    TArray<uint8> Stacks;
+
+    /** No expiry is earlier than this; removals leave it early, which only costs a sweep */
+    float NextExpiry = MAX_flt;
+
+    /** Sweep results, broadcast after it: entity, old mask, new mask */
+    TArray<TTuple<int64, uint32, uint32>> SweepChanges;
+};
@@ -1,5 +1,5 @@
 #include "TowerNPC.h"
-#include "Components/SphereComponent.h"
+#include "ProximityQuerySubsystem.h"
 #include "Components/WidgetComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -9,14 +9,9 @@
 
 ATowerNPC::ATowerNPC()
 {
+    // Only ticks during a conversation, to face the player
     PrimaryActorTick.bCanEverTick = true;
-
-    // Interaction sphere
-    InteractionZone = CreateDefaultSubobject<USphereComponent>(TEXT("InteractionZone"));
-    InteractionZone->SetupAttachment(RootComponent);
-    InteractionZone->SetSphereRadius(InteractionRadius);
-    InteractionZone->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
-    InteractionZone->SetGenerateOverlapEvents(true);
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     // Nameplate widget above head
     NameplateWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("Nameplate"));
@@ -36,37 +31,36 @@ void ATowerNPC::BeginPlay()
 {
     Super::BeginPlay();
 
-    // Bind overlaps
-    InteractionZone->OnComponentBeginOverlap.AddDynamic(this, &ATowerNPC::OnOverlapBegin);
-    InteractionZone->OnComponentEndOverlap.AddDynamic(this, &ATowerNPC::OnOverlapEnd);
-
-    // Update interaction zone radius
-    InteractionZone->SetSphereRadius(InteractionRadius);
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        ProximityHandle = Proximity->Register(this, EProximityChannel::NPC, InteractionRadius,
+            FOnProximityChanged::CreateUObject(this, &ATowerNPC::OnProximityChanged));
+    }
 
     UE_LOG(LogTemp, Log, TEXT("NPC '%s' (%s) spawned"),
         *NPCName, *GetFactionDisplayName());
 }
 
+void ATowerNPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UProximityQuerySubsystem* Proximity = GetWorld()->GetSubsystem<UProximityQuerySubsystem>())
+    {
+        Proximity->Unregister(ProximityHandle);
+    }
+    ProximityHandle = INDEX_NONE;
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ATowerNPC::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // Slowly look at player when in conversation
+    // Slowly look at player when in conversation; idle look-around is Blueprint animation
     if (bPlayerInRange && IsInConversation())
     {
         LookAtPlayer(DeltaTime);
     }
-
-    // Idle look around behavior
-    if (!IsInConversation())
-    {
-        IdleLookTimer += DeltaTime;
-        if (IdleLookTimer > 5.0f)
-        {
-            IdleLookTimer = 0.0f;
-            // Slight head turn effect — Blueprints handle actual animation
-        }
-    }
 }
 
 bool ATowerNPC::TryInteract(AActor* Interactor)
@@ -76,6 +70,7 @@ bool ATowerNPC::TryInteract(AActor* Interactor)
 
     DialogState = ENPCDialogState::Greeting;
     CurrentDialogNodeId = 0;
+    SetActorTickEnabled(true);
 
     OnInteracted.Broadcast(this, Interactor);
 
@@ -87,6 +82,7 @@ void ATowerNPC::EndInteraction()
 {
     DialogState = ENPCDialogState::Idle;
     CurrentDialogNodeId = 0;
+    SetActorTickEnabled(false);
 
     UE_LOG(LogTemp, Log, TEXT("Ended interaction with NPC '%s'"), *NPCName);
 }
@@ -300,29 +296,13 @@ void ATowerNPC::LookAtPlayer(float DeltaTime)
     SetActorRotation(Smoothed);
 }
 
-void ATowerNPC::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
-    bool bFromSweep, const FHitResult& SweepResult)
+void ATowerNPC::OnProximityChanged(APawn* Player, bool bInRange)
 {
-    APawn* PlayerPawn = Cast<APawn>(OtherActor);
-    if (PlayerPawn && PlayerPawn->IsPlayerControlled())
-    {
-        bPlayerInRange = true;
-    }
-}
+    bPlayerInRange = bInRange;
 
-void ATowerNPC::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-    UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-    APawn* PlayerPawn = Cast<APawn>(OtherActor);
-    if (PlayerPawn && PlayerPawn->IsPlayerControlled())
+    // Auto-end conversation if player walks away
+    if (!bInRange && IsInConversation())
     {
-        bPlayerInRange = false;
-
-        // Auto-end conversation if player walks away
-        if (IsInConversation())
-        {
-            EndInteraction();
-        }
+        EndInteraction();
     }
 }
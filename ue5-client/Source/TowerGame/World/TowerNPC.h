@@ -4,7 +4,6 @@
 #include "GameFramework/Character.h"
 #include "TowerNPC.generated.h"
 
-class USphereComponent;
 class UWidgetComponent;
 
 /// NPC faction — matches Rust Faction enum
@@ -92,7 +91,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnQuestAccepted, const FNPCQuest&,
  * - Faction affiliation with visual tint
  * - Dialog tree navigation via JSON from Rust
  * - Quest offering and tracking
- * - Proximity-based interaction prompt
+ * - Proximity-based interaction prompt (UProximityQuerySubsystem)
  * - Idle animation state
  * - Semantic tags for procedural personality
  */
@@ -105,6 +104,7 @@ public:
     ATowerNPC();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
     // --- Interaction ---
@@ -179,9 +179,6 @@ public:
 
     // --- Components ---
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NPC")
-    USphereComponent* InteractionZone;
-
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "NPC")
     UWidgetComponent* NameplateWidget;
 
@@ -195,19 +192,12 @@ protected:
     TArray<FNPCQuest> AvailableQuests;
 
     bool bPlayerInRange = false;
-    float IdleLookTimer = 0.0f;
+    int32 ProximityHandle = INDEX_NONE;
 
     FLinearColor GetFactionColor() const;
     FString GetFactionDisplayName() const;
 
     void LookAtPlayer(float DeltaTime);
 
-    UFUNCTION()
-    void OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
-        bool bFromSweep, const FHitResult& SweepResult);
-
-    UFUNCTION()
-    void OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
-        UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+    void OnProximityChanged(APawn* Player, bool bInRange);
 };